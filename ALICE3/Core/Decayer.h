@@ -23,6 +23,7 @@
 #include "ALICE3/Core/TrackUtilities.h"
 
 #include <CommonConstants/PhysicsConstants.h>
+#include <Framework/Logger.h>
 #include <MathUtils/Primitive2D.h>
 #include <ReconstructionDataFormats/Track.h>
 
@@ -33,6 +34,7 @@
 
 #include <cmath>
 #include <cstddef>
+#include <unordered_map>
 #include <vector>
 
 namespace o2
@@ -49,16 +51,26 @@ class Decayer
   template <typename TDatabase>
   std::vector<o2::upgrade::OTFParticle> decayParticle(const TDatabase& pdgDB, const OTFParticle& particle)
   {
-    const auto& particleInfo = pdgDB->GetParticle(particle.pdgCode());
-    if (!particleInfo) {
-      return {};
+    std::vector<o2::upgrade::OTFParticle> decayProducts;
+    decayParticle(pdgDB, particle, decayProducts);
+    return decayProducts;
+  }
+
+  /// Decays the particle and appends the decay products to decayProducts
+  /// \return the number of decay products, 0 if the particle was not decayed
+  template <typename TDatabase>
+  std::size_t decayParticle(const TDatabase& pdgDB, const OTFParticle& particle, std::vector<o2::upgrade::OTFParticle>& decayProducts)
+  {
+    const DecayTable& table = getDecayTable(pdgDB, particle.pdgCode());
+    if (!table.known) {
+      return 0;
     }
 
-    const int charge = particleInfo->Charge() / 3;
-    const double mass = particleInfo->Mass();
+    const int charge = table.charge;
+    const double mass = table.mass;
 
     const double u = mRand3.Uniform(0.001, 0.999);
-    const double ctau = o2::constants::physics::LightSpeedCm2S * particleInfo->Lifetime(); // cm
+    const double ctau = table.ctau; // cm
     const double betaGamma = particle.p() / mass;
     const double rxyz = -betaGamma * ctau * std::log(1 - u);
     double px, py, e;
@@ -87,50 +99,37 @@ class Decayer
       py = particle.py() * std::cos(theta) + particle.px() * std::sin(theta);
     }
 
-    double brTotal = 0.;
     e = std::sqrt(mass * mass + px * px + py * py + particle.pz() * particle.pz());
-    for (int ch = 0; ch < particleInfo->NDecayChannels(); ++ch) {
-      brTotal += particleInfo->DecayChannel(ch)->BranchingRatio();
-    }
 
-    double brSum = 0.;
-    std::vector<double> dauMasses;
-    std::vector<int> pdgCodesDaughters;
-    const double randomChannel = mRand3.Uniform(0., brTotal);
-    for (int ch = 0; ch < particleInfo->NDecayChannels(); ++ch) {
-      brSum += particleInfo->DecayChannel(ch)->BranchingRatio();
-      if (randomChannel < brSum) {
-        for (int dau = 0; dau < particleInfo->DecayChannel(ch)->NDaughters(); ++dau) {
-          const int pdgDau = particleInfo->DecayChannel(ch)->DaughterPdgCode(dau);
-          pdgCodesDaughters.push_back(pdgDau);
-          const auto& dauInfo = pdgDB->GetParticle(pdgDau);
-          dauMasses.push_back(dauInfo->Mass());
-        }
+    const DecayChannel* channel = nullptr;
+    const double randomChannel = mRand3.Uniform(0., table.brTotal);
+    for (const auto& candidate : table.channels) {
+      if (randomChannel < candidate.brSum) {
+        channel = &candidate;
         break;
       }
     }
 
-    if (dauMasses.empty()) {
-      return {};
+    if (channel == nullptr || channel->masses.empty()) {
+      return 0;
     }
 
     TLorentzVector tlv(px, py, particle.pz(), e);
     TGenPhaseSpace decay;
-    decay.SetDecay(tlv, dauMasses.size(), dauMasses.data());
+    decay.SetDecay(tlv, channel->masses.size(), channel->masses.data());
     decay.Generate();
 
-    std::vector<o2::upgrade::OTFParticle> decayProducts;
-    for (size_t i = 0; i < dauMasses.size(); ++i) {
+    for (size_t i = 0; i < channel->masses.size(); ++i) {
       o2::upgrade::OTFParticle particle;
       TLorentzVector dau = *decay.GetDecay(i);
-      particle.setPDG(pdgCodesDaughters[i]);
+      particle.setPDG(channel->pdgCodes[i]);
       particle.setVxVyVz(mVx, mVy, mVz);
       particle.setPxPyPzE(dau.Px(), dau.Py(), dau.Pz(), dau.E());
       particle.setBitOn(o2::upgrade::DecayerBits::ProducedByDecayer);
       decayProducts.push_back(particle);
     }
 
-    return decayProducts;
+    return channel->masses.size();
   }
 
   // Setters
@@ -148,9 +147,62 @@ class Decayer
   float getDecayRadius() const { return static_cast<float>(std::hypot(mVx, mVy)); }
 
  private:
+  struct DecayChannel {
+    double brSum = 0.; // sum of the branching ratios up to this channel
+    std::vector<int> pdgCodes;
+    std::vector<double> masses;
+  };
+
+  // decay properties of a species, read once from the PDG database
+  struct DecayTable {
+    bool known = false;
+    int charge = 0;
+    double mass = 0.;
+    double ctau = 0.; // cm
+    double brTotal = 0.;
+    std::vector<DecayChannel> channels;
+  };
+
+  template <typename TDatabase>
+  const DecayTable& getDecayTable(const TDatabase& pdgDB, const int pdgCode)
+  {
+    auto [entry, isNew] = mDecayTables.try_emplace(pdgCode);
+    DecayTable& table = entry->second;
+    if (!isNew) {
+      return table;
+    }
+    const auto& particleInfo = pdgDB->GetParticle(pdgCode);
+    if (!particleInfo) {
+      return table;
+    }
+    table.known = true;
+    table.charge = particleInfo->Charge() / 3;
+    table.mass = particleInfo->Mass();
+    table.ctau = o2::constants::physics::LightSpeedCm2S * particleInfo->Lifetime();
+    for (int ch = 0; ch < particleInfo->NDecayChannels(); ++ch) {
+      table.brTotal += particleInfo->DecayChannel(ch)->BranchingRatio();
+      DecayChannel& channel = table.channels.emplace_back();
+      channel.brSum = table.brTotal;
+      for (int dau = 0; dau < particleInfo->DecayChannel(ch)->NDaughters(); ++dau) {
+        const int pdgDau = particleInfo->DecayChannel(ch)->DaughterPdgCode(dau);
+        channel.pdgCodes.push_back(pdgDau);
+        const auto& dauInfo = pdgDB->GetParticle(pdgDau);
+        if (!dauInfo) {
+          LOG(error) << "Decayer: daughter " << pdgDau << " of " << pdgCode << " not found in the PDG database, the decay channel is skipped";
+          channel.pdgCodes.clear();
+          channel.masses.clear();
+          break;
+        }
+        channel.masses.push_back(dauInfo->Mass());
+      }
+    }
+    return table;
+  }
+
   double mBz{20.}; // kG
   double mVx{-1.}, mVy{-1.}, mVz{-1.};
   TRandom3 mRand3{};
+  std::unordered_map<int, DecayTable> mDecayTables;
 };
 
 } // namespace upgrade
@@ -30,18 +30,23 @@
 #include <TMatrixDfwd.h>
 #include <TObject.h>
 #include <TRandom.h>
+#include <TRandom3.h>
 #include <TString.h>
 #include <TVectorDfwd.h>
 
 #include <Rtypes.h>
 #include <RtypesCore.h>
 
+#include <algorithm>
 #include <array>
+#include <atomic>
 #include <cmath>
 #include <cstddef>
 #include <cstdint>
 #include <cstdlib>
+#include <span>
 #include <string>
+#include <thread>
 #include <vector>
 
 namespace o2
@@ -71,6 +76,7 @@ DetLayer* FastTracker::AddLayer(TString name, float r, float z, float x0, float
   }
   // Add the new layer to the layers vector
   layers.push_back(newLayer);
+  ResetLayerCache();
   // Return the last added layer
   return &layers.back();
 }
@@ -154,7 +160,7 @@ void FastTracker::AddTPC(float phiResMean, float zResMean)
   }
 }
 
-void FastTracker::AddGenericDetector(o2::fastsim::GeometryEntry configMap, o2::ccdb::BasicCCDBManager* ccdbManager)
+void FastTracker::AddGenericDetector(const o2::fastsim::GeometryEntry& configMap, o2::ccdb::BasicCCDBManager* ccdbManager)
 {
   // Layers
   for (const auto& layer : configMap.getLayerNames()) {
@@ -206,7 +212,7 @@ void FastTracker::AddGenericDetector(o2::fastsim::GeometryEntry configMap, o2::c
   }
 }
 
-float FastTracker::Dist(float z, float r)
+float FastTracker::Dist(float z, float r) const
 {
   // porting of DetektorK::Dist
   // see here:
@@ -229,7 +235,7 @@ float FastTracker::Dist(float z, float r)
   return dist;
 }
 
-float FastTracker::OneEventHitDensity(float multiplicity, float radius)
+float FastTracker::OneEventHitDensity(float multiplicity, float radius) const
 {
   // porting of DetektorK::OneEventHitDensity
   // see here:
@@ -240,7 +246,7 @@ float FastTracker::OneEventHitDensity(float multiplicity, float radius)
   return den;
 }
 
-float FastTracker::IntegratedHitDensity(float multiplicity, float radius)
+float FastTracker::IntegratedHitDensity(float multiplicity, float radius) const
 {
   // porting of DetektorK::IntegratedHitDensity
   // see here:
@@ -252,7 +258,7 @@ float FastTracker::IntegratedHitDensity(float multiplicity, float radius)
   return den;
 }
 
-float FastTracker::UpcHitDensity(float radius)
+float FastTracker::UpcHitDensity(float radius) const
 {
   // porting of DetektorK::UpcHitDensity
   // see here:
@@ -266,14 +272,14 @@ float FastTracker::UpcHitDensity(float radius)
   return mUPCelectrons;
 }
 
-float FastTracker::HitDensity(float radius)
+float FastTracker::HitDensity(float radius, int dNdEta) const
 {
   // porting of DetektorK::HitDensity
   // see here:
   // https://github.com/AliceO2Group/DelphesO2/blob/master/src/DetectorK/DetectorK.cxx#L663
   float arealDensity = 0.;
   if (radius > maxRadiusSlowDet) {
-    arealDensity = OneEventHitDensity(dNdEtaCent, radius);
+    arealDensity = OneEventHitDensity(dNdEta, radius);
     arealDensity += otherBackground * OneEventHitDensity(dNdEtaMinB, radius);
   }
 
@@ -281,20 +287,20 @@ float FastTracker::HitDensity(float radius)
   // Look-up tables, UpcHitDensity(radius) always returns 0,
   // hence it is left commented out for now
   if (radius < maxRadiusSlowDet) {
-    arealDensity = OneEventHitDensity(dNdEtaCent, radius);
+    arealDensity = OneEventHitDensity(dNdEta, radius);
     arealDensity += otherBackground * OneEventHitDensity(dNdEtaMinB, radius) + IntegratedHitDensity(dNdEtaMinB, radius);
     // +UpcHitDensity(radius);
   }
   return arealDensity;
 }
 
-float FastTracker::ProbGoodChiSqHit(float radius, float searchRadiusRPhi, float searchRadiusZ)
+float FastTracker::ProbGoodChiSqHit(float radius, float searchRadiusRPhi, float searchRadiusZ, int dNdEta) const
 {
   // porting of DetektorK::ProbGoodChiSqHit
   // see here:
   // https://github.com/AliceO2Group/DelphesO2/blob/master/src/DetectorK/DetectorK.cxx#L629
   float sx, goodHit;
-  sx = o2::constants::math::TwoPI * searchRadiusRPhi * searchRadiusZ * HitDensity(radius);
+  sx = o2::constants::math::TwoPI * searchRadiusRPhi * searchRadiusZ * HitDensity(radius, dNdEta);
   goodHit = 1. / (1 + sx);
   return goodHit;
 }
@@ -304,20 +310,88 @@ float FastTracker::ProbGoodChiSqHit(float radius, float searchRadiusRPhi, float
 int FastTracker::FastTrack(o2::track::TrackParCov inputTrack, o2::track::TrackParCov& outputTrack, const float nch, const float maxRadius)
 {
   dNdEtaCent = nch; // set the number of charged particles per unit rapidity
-  hits.clear();
-  nIntercepts = 0;
-  nSiliconPoints = 0;
-  nGasPoints = 0;
+  SetEventMultiplicity(nch);
+  return FastTrack(inputTrack, outputTrack, nch, lastResult, *gRandom, maxRadius);
+}
+
+int FastTracker::FastTrack(o2::track::TrackParCov inputTrack, o2::track::TrackParCov& outputTrack, const float nch, FastTrackResult& result, TRandom& random, const float maxRadius) const
+{
+  result.clear();
+  result.status = FastTrackImpl(inputTrack, outputTrack, nch, result, random, maxRadius);
+  return result.status;
+}
+
+void FastTracker::FastTrackBatch(std::span<const o2::track::TrackParCov> inputTracks, std::span<o2::track::TrackParCov> outputTracks, std::span<FastTrackResult> results, const float nch, const int nThreads, const uint32_t seed, const float maxRadius)
+{
+  SetEventMultiplicity(nch); // before starting the threads, which only read the cache
+  if (outputTracks.size() < inputTracks.size() || results.size() < inputTracks.size()) {
+    LOG(fatal) << "FastTrackBatch: output spans are smaller than the input (" << inputTracks.size() << " tracks)";
+  }
+  const std::size_t nChunks = (inputTracks.size() + kBatchChunkSize - 1) / kBatchChunkSize;
+  std::atomic<std::size_t> nextChunk{0};
+  auto worker = [&]() {
+    TRandom3 random;
+    for (std::size_t chunk = nextChunk++; chunk < nChunks; chunk = nextChunk++) {
+      random.SetSeed(seed + chunk + 1); // 0 would pick a time-based seed
+      const std::size_t last = std::min(inputTracks.size(), (chunk + 1) * kBatchChunkSize);
+      for (std::size_t i = chunk * kBatchChunkSize; i < last; i++) {
+        FastTrack(inputTracks[i], outputTracks[i], nch, results[i], random, maxRadius);
+      }
+    }
+  };
+
+  const int nWorkers = std::min<std::size_t>(std::max(nThreads, 1), nChunks);
+  std::vector<std::thread> threads;
+  for (int iw = 1; iw < nWorkers; iw++) {
+    threads.emplace_back(worker);
+  }
+  worker(); // the calling thread takes part as well
+  for (auto& thread : threads) {
+    thread.join();
+  }
+}
+
+void FastTracker::SetEventMultiplicity(const float nch)
+{
+  const int dNdEta = nch; // truncated as dNdEtaCent
+  if (cachedDNdEta >= 0 && dNdEta == cachedDNdEta && cachedHitDensity.size() == layers.size()) {
+    return;
+  }
+  cachedHitDensity.resize(layers.size());
+  cachedFirstActiveLayer = -1;
+  for (size_t il = 0; il < layers.size(); ++il) {
+    // same radius as used for the good hit probability in FastTrack
+    cachedHitDensity[il] = HitDensity(layers[il].getRadius() * 100, dNdEta);
+    if (cachedFirstActiveLayer < 0 && !layers[il].isInert()) {
+      cachedFirstActiveLayer = il;
+    }
+  }
+  cachedDNdEta = dNdEta;
+}
+
+int FastTracker::FastTrackImpl(o2::track::TrackParCov& inputTrack, o2::track::TrackParCov& outputTrack, const float nch, FastTrackResult& result, TRandom& random, const float maxRadius) const
+{
+  const int dNdEta = nch; // number of charged particles per unit rapidity, truncated as dNdEtaCent
+  auto& hits = result.hits;
+  auto& nIntercepts = result.nIntercepts;
+  auto& nSiliconPoints = result.nSiliconPoints;
+  auto& nGasPoints = result.nGasPoints;
+  auto& goodHitProbability = result.goodHitProbability;
   std::array<float, 3> posIni; // provision for != PV
   inputTrack.getXYZGlo(posIni);
   const float initialRadius = std::hypot(posIni[0], posIni[1]);
   const float kTrackingMargin = 0.1;
 
+  const bool useCache = (cachedDNdEta >= 0 && dNdEta == cachedDNdEta && cachedHitDensity.size() == layers.size());
   int firstActiveLayer = -1; // first layer that is not inert
-  for (size_t i = 0; i < layers.size(); ++i) {
-    if (!layers[i].isInert()) {
-      firstActiveLayer = i;
-      break;
+  if (useCache) {
+    firstActiveLayer = cachedFirstActiveLayer;
+  } else {
+    for (size_t i = 0; i < layers.size(); ++i) {
+      if (!layers[i].isInert()) {
+        firstActiveLayer = i;
+        break;
+      }
     }
   }
   if (firstActiveLayer < 0) {
@@ -457,7 +531,6 @@ int FastTracker::FastTrack(o2::track::TrackParCov inputTrack, o2::track::TrackPa
     // get perfect data point position
     std::array<float, 3> spacePoint;
     inputTrack.getXYZGlo(spacePoint);
-    std::vector<float> thisHit = {spacePoint[0], spacePoint[1], spacePoint[2]};
 
     // towards adding cluster: move to track alpha
     float alpha = inwardTrack.getAlpha();
@@ -506,11 +579,14 @@ int FastTracker::FastTrack(o2::track::TrackParCov inputTrack, o2::track::TrackPa
       nGasPoints++; // count TPC/gas hits
     }
 
-    hits.push_back(thisHit);
+    hits.push_back(spacePoint);
     if (!layers[il].isInert()) { // good hit probability calculation
       float sigYCmb = o2::math_utils::sqrt(inwardTrack.getSigmaY2() + layers[il].getResolutionRPhi() * layers[il].getResolutionRPhi());
       float sigZCmb = o2::math_utils::sqrt(inwardTrack.getSigmaZ2() + layers[il].getResolutionZ() * layers[il].getResolutionZ());
-      goodHitProbability[il] = ProbGoodChiSqHit(layers[il].getRadius() * 100, sigYCmb * 100, sigZCmb * 100);
+      // same as ProbGoodChiSqHit(layers[il].getRadius() * 100, sigYCmb * 100, sigZCmb * 100), with the hit density cached for the event
+      const float hitDensity = useCache ? cachedHitDensity[il] : HitDensity(layers[il].getRadius() * 100, dNdEta);
+      const float sx = o2::constants::math::TwoPI * (sigYCmb * 100) * (sigZCmb * 100) * hitDensity;
+      goodHitProbability[il] = 1. / (1 + sx);
       goodHitProbability[0] *= goodHitProbability[il];
     }
   }
@@ -543,7 +619,7 @@ int FastTracker::FastTrack(o2::track::TrackParCov inputTrack, o2::track::TrackPa
     eff *= iGoodHit;
   }
   if (mApplyEffCorrection) {
-    if (gRandom->Uniform() > eff) {
+    if (random.Uniform() > eff) {
       return -8;
     }
   }
@@ -614,7 +690,7 @@ int FastTracker::FastTrack(o2::track::TrackParCov inputTrack, o2::track::TrackPa
     for (int j = 0; j < 5; ++j)
       val += eigVec[j][ii] * outputTrack.getParam(j);
     // smear parameters according to eigenvalues
-    params_[ii] = gRandom->Gaus(val, sqrt(eigVal[ii]));
+    params_[ii] = random.Gaus(val, sqrt(eigVal[ii]));
   }
 
   // invert eigenvector matrix
@@ -22,11 +22,16 @@
 
 #include <Rtypes.h>
 
+#include <array>
+#include <atomic>
 #include <cstddef>
 #include <cstdint>
+#include <span>
 #include <string>
 #include <vector>
 
+class TRandom;
+
 namespace o2
 {
 namespace fastsim
@@ -34,6 +39,26 @@ namespace fastsim
 
 // +-~-<*>-~-+-~-<*>-~-+-~-<*>-~-+-~-<*>-~-+-~-<*>-~-+-~-<*>-~-+-~-<*>-~-+-~-<*>-~-+
 
+// bookkeeping of a single FastTrack call
+struct FastTrackResult {
+  int status = 0;                         /// value returned by FastTrack
+  int nIntercepts = 0;                    /// found in first outward propagation
+  int nSiliconPoints = 0;                 /// silicon-based space points added to track
+  int nGasPoints = 0;                     /// tpc-based space points added to track
+  std::vector<std::array<float, 3>> hits; /// added hits
+  std::vector<float> goodHitProbability;  /// per layer, layer zero holds the product
+
+  void clear()
+  {
+    status = 0;
+    nIntercepts = 0;
+    nSiliconPoints = 0;
+    nGasPoints = 0;
+    hits.clear();
+    goodHitProbability.clear();
+  }
+};
+
 // this class implements a synthetic smearer that allows
 // for on-demand smearing of TrackParCovs in a certain flexible t
 // detector layout.
@@ -58,9 +83,17 @@ class FastTracker
   int GetLayerIndex(const std::string& name) const;
   size_t GetNLayers() const { return layers.size(); }
   bool IsLayerInert(const int layer) const { return layers[layer].isInert(); }
-  void ClearLayers() { layers.clear(); }
+  void ClearLayers()
+  {
+    layers.clear();
+    ResetLayerCache();
+  }
   void SetRadiationLength(const std::string layerName, float x0) { layers[GetLayerIndex(layerName)].setRadiationLength(x0); }
-  void SetRadius(const std::string layerName, float r) { layers[GetLayerIndex(layerName)].setRadius(r); }
+  void SetRadius(const std::string layerName, float r)
+  {
+    layers[GetLayerIndex(layerName)].setRadius(r);
+    ResetLayerCache();
+  }
   void SetResolutionRPhi(const std::string layerName, float resRPhi) { layers[GetLayerIndex(layerName)].setResolutionRPhi(resRPhi); }
   void SetResolutionZ(const std::string layerName, float resZ) { layers[GetLayerIndex(layerName)].setResolutionZ(resZ); }
   void SetResolution(const std::string layerName, float resRPhi, float resZ)
@@ -80,7 +113,7 @@ class FastTracker
    *
    * @param configMap Configuration map describing the detector.
    */
-  void AddGenericDetector(o2::fastsim::GeometryEntry configMap, o2::ccdb::BasicCCDBManager* ccdbManager = nullptr);
+  void AddGenericDetector(const o2::fastsim::GeometryEntry& configMap, o2::ccdb::BasicCCDBManager* ccdbManager = nullptr);
 
   void Print();
 
@@ -97,20 +130,66 @@ class FastTracker
    */
   int FastTrack(o2::track::TrackParCov inputTrack, o2::track::TrackParCov& outputTrack, const float nch, const float maxRadius = 100.f);
 
+  /**
+   * @brief Reentrant version of FastTrack.
+   *
+   * Same as above, but the bookkeeping of the track is stored in result and the random
+   * numbers are drawn from random, so that it can be called concurrently on the same tracker.
+   * The getters for the last track are not updated.
+   */
+  int FastTrack(o2::track::TrackParCov inputTrack, o2::track::TrackParCov& outputTrack, const float nch, FastTrackResult& result, TRandom& random, const float maxRadius = 100.f) const;
+
+  /**
+   * @brief Performs fast tracking on a batch of tracks using nThreads threads.
+   *
+   * The batch is split in chunks of kBatchChunkSize tracks, each one smeared with its own
+   * random generator seeded from seed and the chunk index: the output only depends on seed,
+   * not on the number of threads.
+   */
+  void FastTrackBatch(std::span<const o2::track::TrackParCov> inputTracks, std::span<o2::track::TrackParCov> outputTracks, std::span<FastTrackResult> results, const float nch, const int nThreads, const uint32_t seed, const float maxRadius = 100.f);
+  static constexpr std::size_t kBatchChunkSize = 32;
+
+  /**
+   * @brief Caches the hit density at each layer for the multiplicity of the event.
+   *
+   * The hit density only depends on the layer radius and on the multiplicity, so it is computed
+   * once per event instead of once per track and layer. The reentrant FastTrack uses the cache if
+   * called with the cached multiplicity; FastTrackBatch and the other FastTrack refresh it if needed.
+   */
+  void SetEventMultiplicity(const float nch);
+
   // For efficiency calculation
-  float Dist(float z, float radius);
-  float OneEventHitDensity(float multiplicity, float radius);
-  float IntegratedHitDensity(float multiplicity, float radius);
-  float UpcHitDensity(float radius);
-  float HitDensity(float radius);
-  float ProbGoodChiSqHit(float radius, float searchRadiusRPhi, float searchRadiusZ);
+  float Dist(float z, float radius) const;
+  float OneEventHitDensity(float multiplicity, float radius) const;
+  float IntegratedHitDensity(float multiplicity, float radius) const;
+  float UpcHitDensity(float radius) const;
+  float HitDensity(float radius) const { return HitDensity(radius, dNdEtaCent); }
+  float HitDensity(float radius, int dNdEta) const;
+  float ProbGoodChiSqHit(float radius, float searchRadiusRPhi, float searchRadiusZ) const { return ProbGoodChiSqHit(radius, searchRadiusRPhi, searchRadiusZ, dNdEtaCent); }
+  float ProbGoodChiSqHit(float radius, float searchRadiusRPhi, float searchRadiusZ, int dNdEta) const;
 
   // Setters and getters for configuration
-  void SetIntegrationTime(float t) { integrationTime = t; }
-  void SetMaxRadiusOfSlowDetectors(float r) { maxRadiusSlowDet = r; }
-  void SetAvgRapidity(float y) { avgRapidity = y; }
+  void SetIntegrationTime(float t)
+  {
+    integrationTime = t;
+    ResetLayerCache();
+  }
+  void SetMaxRadiusOfSlowDetectors(float r)
+  {
+    maxRadiusSlowDet = r;
+    ResetLayerCache();
+  }
+  void SetAvgRapidity(float y)
+  {
+    avgRapidity = y;
+    ResetLayerCache();
+  }
   void SetdNdEtaCent(int d) { dNdEtaCent = d; }
-  void SetLhcUPCscale(float s) { lhcUPCScale = s; }
+  void SetLhcUPCscale(float s)
+  {
+    lhcUPCScale = s;
+    ResetLayerCache();
+  }
   void SetBField(float b) { magneticField = b; }
   void SetMinRadTrack(float r) { fMinRadTrack = r; }
   void SetMagneticField(float b) { magneticField = b; }
@@ -120,24 +199,27 @@ class FastTracker
   void SetApplyEffCorrection(bool b) { mApplyEffCorrection = b; }
 
   // Getters for the last track
-  int GetNIntercepts() const { return nIntercepts; }
-  int GetNSiliconPoints() const { return nSiliconPoints; }
-  int GetNGasPoints() const { return nGasPoints; }
+  const FastTrackResult& GetLastResult() const { return lastResult; }
+  int GetNIntercepts() const { return lastResult.nIntercepts; }
+  int GetNSiliconPoints() const { return lastResult.nSiliconPoints; }
+  int GetNGasPoints() const { return lastResult.nGasPoints; }
   float GetGoodHitProb(int layer) const
   {
-    return (layer >= 0 && static_cast<size_t>(layer) < goodHitProbability.size()) ? goodHitProbability[layer] : 0.0f;
+    return (layer >= 0 && static_cast<size_t>(layer) < lastResult.goodHitProbability.size()) ? lastResult.goodHitProbability[layer] : 0.0f;
   }
-  std::size_t GetNHits() const { return hits.size(); }
-  float GetHitX(const int i) const { return hits[i][0]; }
-  float GetHitY(const int i) const { return hits[i][1]; }
-  float GetHitZ(const int i) const { return hits[i][2]; }
+  std::size_t GetNHits() const { return lastResult.hits.size(); }
+  float GetHitX(const int i) const { return lastResult.hits[i][0]; }
+  float GetHitY(const int i) const { return lastResult.hits[i][1]; }
+  float GetHitZ(const int i) const { return lastResult.hits[i][2]; }
   uint64_t GetCovMatOK() const { return covMatOK; }
   uint64_t GetCovMatNotOK() const { return covMatNotOK; }
 
  private:
+  int FastTrackImpl(o2::track::TrackParCov& inputTrack, o2::track::TrackParCov& outputTrack, const float nch, FastTrackResult& result, TRandom& random, const float maxRadius) const;
+  void ResetLayerCache() { cachedDNdEta = -1; }
+
   // Definition of detector layers
   std::vector<DetLayer> layers;
-  std::vector<std::vector<float>> hits; // bookkeep last added hits
 
   /// configuration parameters
   bool mApplyZacceptance = false;       /// check z acceptance or not
@@ -160,17 +242,19 @@ class FastTracker
   float upcBackgroundMultiplier = 1.0f; /// multiplier for UPC background
   float fMinRadTrack = 132.f;           /// minimum radius for track propagation in cm
 
-  /// counters for covariance matrix statuses
-  uint64_t covMatOK = 0;    /// cov mat has positive eigenvals
-  uint64_t covMatNotOK = 0; /// cov mat has negative eigenvals
+  /// counters for covariance matrix statuses, shared by concurrent FastTrack calls
+  mutable std::atomic<uint64_t> covMatOK{0};    //! cov mat has positive eigenvals
+  mutable std::atomic<uint64_t> covMatNotOK{0}; //! cov mat has negative eigenvals
 
   /// last track information
-  int nIntercepts = 0;    /// found in first outward propagation
-  int nSiliconPoints = 0; /// silicon-based space points added to track
-  int nGasPoints = 0;     /// tpc-based space points added to track
-  std::vector<float> goodHitProbability;
+  FastTrackResult lastResult; //!
+
+  /// per-event cache of the layer-dependent terms
+  int cachedDNdEta = -1;               //! multiplicity of the cache, -1 if not valid
+  int cachedFirstActiveLayer = -1;     //! first layer that is not inert
+  std::vector<float> cachedHitDensity; //! hit density at each layer
 
-  ClassDef(FastTracker, 1);
+  ClassDef(FastTracker, 2);
 };
 
 // +-~-<*>-~-+-~-<*>-~-+-~-<*>-~-+-~-<*>-~-+-~-<*>-~-+-~-<*>-~-+-~-<*>-~-+-~-<*>-~-+
@@ -14,13 +14,24 @@
 #include <Framework/Logger.h>
 #include <Framework/RuntimeError.h>
 
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cerrno>
 #include <cmath>
 #include <cstddef>
 #include <cstdint>
 #include <cstring>
 #include <fstream>
 #include <ios>
+#include <map>
+#include <memory>
+#include <mutex>
 #include <span>
+#include <string>
+#include <utility>
 
 namespace o2::delphes
 {
@@ -158,6 +169,7 @@ void FlatLutData::resetDimensions()
 
 void FlatLutData::adopt(const uint8_t* buffer, size_t size)
 {
+  mMapping.reset();
   mData.resize(size);
   std::memcpy(mData.data(), buffer, size);
   updateRef();
@@ -166,6 +178,7 @@ void FlatLutData::adopt(const uint8_t* buffer, size_t size)
 
 void FlatLutData::view(const uint8_t* buffer, size_t size)
 {
+  mMapping.reset();
   mData.clear();
   mDataRef = std::span{buffer, size};
   cacheDimensions();
@@ -266,8 +279,78 @@ FlatLutData FlatLutData::loadFromFile(std::ifstream& file, const char* filename)
   return data;
 }
 
+FlatLutData FlatLutData::MapFromFile(const char* filename)
+{
+  auto mapping = FlatLutMapping::get(filename);
+  auto data = ViewFromBuffer(mapping->span().data(), mapping->span().size());
+  data.mMapping = std::move(mapping);
+  LOGF(info, "Successfully mapped LUT from %s: %zu bytes", filename, data.bytes());
+  return data;
+}
+
+namespace
+{
+std::mutex gMappingMutex;
+std::map<std::string, std::weak_ptr<const FlatLutMapping>> gMappings;
+} // namespace
+
+FlatLutMapping::FlatLutMapping(const uint8_t* address, size_t size, std::string key) : mAddress(address), mSize(size), mKey(std::move(key))
+{
+}
+
+FlatLutMapping::~FlatLutMapping()
+{
+  munmap(const_cast<uint8_t*>(mAddress), mSize);
+}
+
+std::shared_ptr<const FlatLutMapping> FlatLutMapping::get(const char* filename)
+{
+  const int fd = open(filename, O_RDONLY);
+  if (fd == -1) {
+    throw framework::runtime_error_f("Cannot open LUT file %s: %s", filename, std::strerror(errno));
+  }
+  struct stat fileStat;
+  if (fstat(fd, &fileStat) != 0) {
+    close(fd);
+    throw framework::runtime_error_f("Cannot stat LUT file %s: %s", filename, std::strerror(errno));
+  }
+  const size_t size = fileStat.st_size;
+  // A file replaced on disk (e.g. a new CCDB snapshot) gets a new key
+  const std::string key = std::string(filename) + "#" + std::to_string(fileStat.st_ino) + "#" + std::to_string(size) + "#" + std::to_string(fileStat.st_mtime);
+
+  std::lock_guard<std::mutex> lock(gMappingMutex);
+  auto& cached = gMappings[key];
+  if (auto mapping = cached.lock()) {
+    close(fd);
+    return mapping;
+  }
+  if (size == 0) {
+    close(fd);
+    throw framework::runtime_error_f("LUT file %s is empty", filename);
+  }
+  void* address = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+  close(fd); // the mapping stays valid after closing the descriptor
+  if (address == MAP_FAILED) {
+    throw framework::runtime_error_f("Cannot map LUT file %s: %s", filename, std::strerror(errno));
+  }
+  std::shared_ptr<const FlatLutMapping> mapping(new FlatLutMapping(static_cast<const uint8_t*>(address), size, key));
+  cached = mapping;
+  return mapping;
+}
+
+size_t FlatLutMapping::getNMapped()
+{
+  std::lock_guard<std::mutex> lock(gMappingMutex);
+  size_t nMapped = 0;
+  for (auto const& [key, mapping] : gMappings) {
+    nMapped += !mapping.expired();
+  }
+  return nMapped;
+}
+
 void FlatLutData::reset()
 {
+  mMapping.reset();
   mData.clear();
   updateRef();
   resetDimensions();
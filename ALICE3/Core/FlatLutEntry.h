@@ -16,7 +16,9 @@
 #include <cstddef>
 #include <cstdint>
 #include <fstream>
+#include <memory>
 #include <span>
+#include <string>
 #include <vector>
 
 #define LUTCOVM_VERSION 20210801
@@ -84,6 +86,40 @@ struct lutHeader_t {
   void print() const;
 };
 
+/**
+ * @brief Read-only memory mapping of a LUT file
+ * Mappings are cached per process, keyed by file path, inode, size and modification time,
+ * so that the same file is mapped only once. The pages are backed by the page cache and
+ * shared with all the other processes on the node mapping the same file.
+ */
+class FlatLutMapping
+{
+ public:
+  FlatLutMapping(const FlatLutMapping&) = delete;
+  FlatLutMapping& operator=(const FlatLutMapping&) = delete;
+  ~FlatLutMapping();
+
+  /**
+   * @brief Get the mapping of a file, mapping it if not already done in this process
+   */
+  static std::shared_ptr<const FlatLutMapping> get(const char* filename);
+
+  /**
+   * @brief Number of files currently mapped in this process
+   */
+  static size_t getNMapped();
+
+  std::span<uint8_t const> span() const { return {mAddress, mSize}; }
+  const std::string& key() const { return mKey; }
+
+ private:
+  FlatLutMapping(const uint8_t* address, size_t size, std::string key);
+
+  const uint8_t* mAddress = nullptr;
+  size_t mSize = 0;
+  std::string mKey;
+};
+
 /**
  * @brief Flat LUT data container - single contiguous buffer
  * Memory layout: [header][entry_0][entry_1]...[entry_N]
@@ -155,6 +191,12 @@ class FlatLutData
    */
   static FlatLutData loadFromFile(std::ifstream& file, const char* filename);
 
+  /**
+   * @brief Construct a new FlatLutData as a view of a read-only memory-mapped file
+   * The mapping is kept alive by the returned object
+   */
+  static FlatLutData MapFromFile(const char* filename);
+
   /**
    * @brief Preview buffer header for version and other compatibility checks
    */
@@ -209,6 +251,7 @@ class FlatLutData
 
   std::vector<uint8_t> mData;
   std::span<uint8_t const> mDataRef;
+  std::shared_ptr<const FlatLutMapping> mMapping; // set if mDataRef points to a mapped file
 
   // Cache dimensions for quick access
   int mNchBins = 0;
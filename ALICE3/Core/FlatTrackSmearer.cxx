@@ -20,6 +20,8 @@
 
 #include <TRandom.h>
 
+#include <algorithm>
+#include <array>
 #include <cmath>
 #include <cstddef>
 #include <cstdint>
@@ -30,6 +32,21 @@
 
 namespace o2::delphes
 {
+namespace
+{
+// same binning as map_t::find, evaluated over a column of values
+void findBins(const map_t& map, const float* values, int* bins, int n)
+{
+  const float width = (map.max - map.min) / map.nbins;
+  const int lastBin = map.nbins - 1;
+  for (int k = 0; k < n; ++k) {
+    const float val = map.log ? std::log10(values[k]) : values[k];
+    const int bin = static_cast<int>((val - map.min) / width);
+    bins[k] = std::clamp(bin, 0, lastBin);
+  }
+}
+} // namespace
+
 int TrackSmearer::getIndexPDG(int pdg)
 {
   switch (std::abs(pdg)) {
@@ -107,13 +124,20 @@ bool TrackSmearer::loadTable(int pdg, const char* filename, bool forceReload)
   LOGF(info, "Loading %s LUT file: '%s'", getParticleName(pdg), filename);
   const std::string localFilename = o2::fastsim::GeometryEntry::accessFile(filename, "./.ALICE3/LUTs/", mCcdbManager, 10);
 
-  std::ifstream lutFile(localFilename, std::ifstream::binary);
-  if (!lutFile.is_open()) {
-    throw framework::runtime_error_f("Cannot open LUT file: %s", localFilename.c_str());
+  std::ifstream lutFile;
+  if (!mUseMappedTables) {
+    lutFile.open(localFilename, std::ifstream::binary);
+    if (!lutFile.is_open()) {
+      throw framework::runtime_error_f("Cannot open LUT file: %s", localFilename.c_str());
+    }
   }
 
   try {
-    mLUTData[ipdg] = FlatLutData::loadFromFile(lutFile, localFilename.c_str());
+    if (mUseMappedTables) {
+      mLUTData[ipdg] = FlatLutData::MapFromFile(localFilename.c_str());
+    } else {
+      mLUTData[ipdg] = FlatLutData::loadFromFile(lutFile, localFilename.c_str());
+    }
 
     // Validate header
     auto header = mLUTData[ipdg].getHeader();
@@ -381,6 +405,190 @@ bool TrackSmearer::smearTrack(O2Track& o2track, int pdg, float nch)
   return smearTrack(o2track, lutEntry, interpolatedEff);
 }
 
+int TrackSmearer::smearTracks(std::span<O2Track> tracks, std::span<const int> pdgs, float nch, std::span<uint8_t> reconstructed)
+{
+  if (pdgs.size() != tracks.size() || reconstructed.size() < tracks.size()) {
+    throw framework::runtime_error_f("smearTracks: inconsistent sizes, %zu tracks, %zu PDG codes, %zu flags", tracks.size(), pdgs.size(), reconstructed.size());
+  }
+
+  // Group the tracks by LUT (counting sort, keeps the original order within a group)
+  std::array<uint32_t, nLUTs + 1> offsets{};
+  for (const auto pdg : pdgs) {
+    ++offsets[getIndexPDG(pdg) + 1];
+  }
+  for (unsigned int ilut = 0; ilut < nLUTs; ++ilut) {
+    offsets[ilut + 1] += offsets[ilut];
+  }
+  mBatchIndices.resize(tracks.size());
+  auto next = offsets;
+  for (uint32_t i = 0; i < pdgs.size(); ++i) {
+    mBatchIndices[next[getIndexPDG(pdgs[i])]++] = i;
+  }
+
+  int nReconstructed = 0;
+  const std::span<const uint32_t> indices{mBatchIndices};
+  for (unsigned int ilut = 0; ilut < nLUTs; ++ilut) {
+    if (offsets[ilut + 1] == offsets[ilut]) {
+      continue;
+    }
+    const auto group = indices.subspan(offsets[ilut], offsets[ilut + 1] - offsets[ilut]);
+    nReconstructed += smearTrackGroup(pdgs[group.front()], nch, group, tracks, reconstructed);
+  }
+  return nReconstructed;
+}
+
+int TrackSmearer::smearTracks(std::span<O2Track> tracks, int pdg, float nch, std::span<uint8_t> reconstructed)
+{
+  if (reconstructed.size() < tracks.size()) {
+    throw framework::runtime_error_f("smearTracks: inconsistent sizes, %zu tracks, %zu flags", tracks.size(), reconstructed.size());
+  }
+  mBatchIndices.resize(tracks.size());
+  for (uint32_t i = 0; i < tracks.size(); ++i) {
+    mBatchIndices[i] = i;
+  }
+  return smearTrackGroup(pdg, nch, mBatchIndices, tracks, reconstructed);
+}
+
+int TrackSmearer::smearTrackGroup(const int pdg, const float nch, std::span<const uint32_t> indices, std::span<O2Track> tracks, std::span<uint8_t> reconstructed)
+{
+  // All the tracks in indices share the same LUT
+  const int ipdg = getIndexPDG(pdg);
+  if (!mLUTData[ipdg].isLoaded()) {
+    for (const auto i : indices) {
+      reconstructed[i] = false;
+    }
+    return 0;
+  }
+  const auto& lut = mLUTData[ipdg];
+  const auto& header = lut.getHeaderRef();
+  const bool isHelium3 = (std::abs(pdg) == o2::constants::physics::kHelium3);
+
+  // nch and radius are the same for the whole batch, and so is the efficiency interpolation along nch
+  const int inch = header.nchmap.find(nch);
+  const int irad = header.radmap.find(0.f);
+  int inchOther = inch;
+  float weightCurr = 1.f;
+  float weightOther = 0.f;
+  if (mInterpolateEfficiency) {
+    const auto fraction = header.nchmap.fracPositionWithinBin(nch);
+    static constexpr float kFractionThreshold = 0.5f;
+    if (fraction > kFractionThreshold) {
+      if (inch < header.nchmap.nbins - 1) {
+        inchOther = inch + 1;
+        weightCurr = 1.5f - fraction;
+        weightOther = -0.5f + fraction;
+      }
+    } else {
+      const float comparisonValue = header.nchmap.log ? std::log10(nch) : nch;
+      if (inch > 0 && comparisonValue < header.nchmap.max) {
+        inchOther = inch - 1;
+        weightCurr = 0.5f + fraction;
+        weightOther = 0.5f - fraction;
+      }
+    }
+  }
+  auto getEff = [this](const lutEntry_t* entry) {
+    switch (mWhatEfficiency) {
+      case 1:
+        return entry->eff;
+      case 2:
+        return entry->eff2;
+    }
+    return 0.f;
+  };
+
+  static constexpr int kParSize = 5;
+  static constexpr int kCovMatSize = 15;
+  float ptColumn[kSmearBlock];
+  float etaColumn[kSmearBlock];
+  int ptBins[kSmearBlock];
+  int etaBins[kSmearBlock];
+  double uniform[kSmearBlock];
+  int toSmear[kSmearBlock];
+  double gaus[kParSize][kSmearBlock];
+
+  int nReconstructed = 0;
+  for (size_t first = 0; first < indices.size(); first += kSmearBlock) {
+    const int n = std::min<size_t>(kSmearBlock, indices.size() - first);
+    const auto block = indices.subspan(first, n);
+
+    // LUT bins over the pt and eta columns
+    for (int k = 0; k < n; ++k) {
+      const auto& track = tracks[block[k]];
+      ptColumn[k] = isHelium3 ? track.getPt() * 2.f : track.getPt();
+      etaColumn[k] = track.getEta();
+    }
+    findBins(header.ptmap, ptColumn, ptBins, n);
+    findBins(header.etamap, etaColumn, etaBins, n);
+
+    // Efficiency, with one uniform draw per track
+    if (mUseEfficiency) {
+      gRandom->RndmArray(n, uniform); // FIXME: use a fixed RNG instead of whatever ROOT has as a default
+    }
+    int nSmear = 0;
+    for (int k = 0; k < n; ++k) {
+      const auto* entry = lut.getEntryRef(inch, irad, etaBins[k], ptBins[k]);
+      if (!entry->valid) {
+        reconstructed[block[k]] = false;
+        continue;
+      }
+      bool isReconstructed = true;
+      if (mUseEfficiency) {
+        float eff = getEff(entry);
+        if (inchOther != inch) {
+          eff = weightCurr * eff + weightOther * getEff(lut.getEntryRef(inchOther, irad, etaBins[k], ptBins[k]));
+        }
+        isReconstructed = !(uniform[k] > eff);
+      }
+      reconstructed[block[k]] = isReconstructed;
+      nReconstructed += isReconstructed;
+      if (!isReconstructed && mSkipUnreconstructed) {
+        continue;
+      }
+      toSmear[nSmear++] = k;
+    }
+
+    // Standard normal deviates for all the smeared parameters, drawn as one stream
+    for (int i = 0; i < kParSize; ++i) {
+      for (int m = 0; m < nSmear; ++m) {
+        gaus[i][m] = gRandom->Gaus();
+      }
+    }
+
+    // Transform params vector to the eigen basis, smear and transform back, as in smearTrack
+    for (int m = 0; m < nSmear; ++m) {
+      const int k = toSmear[m];
+      auto& o2track = tracks[block[k]];
+      const auto* entry = lut.getEntryRef(inch, irad, etaBins[k], ptBins[k]);
+      double params[kParSize];
+      for (int i = 0; i < kParSize; ++i) {
+        double val = 0.;
+        for (int j = 0; j < kParSize; ++j) {
+          val += entry->eigvec[j][i] * o2track.getParam(j);
+        }
+        params[i] = val + std::sqrt(entry->eigval[i]) * gaus[i][m];
+      }
+      for (int i = 0; i < kParSize; ++i) {
+        double val = 0.;
+        for (int j = 0; j < kParSize; ++j) {
+          val += entry->eiginv[j][i] * params[j];
+        }
+        o2track.setParam(val, i);
+      }
+
+      // Sanity check that par[2] sin(phi) is in [-1, 1]
+      if (std::fabs(o2track.getParam(2)) > 1.) {
+        LOGF(warn, "smearTracks failed sin(phi) sanity check: %f", o2track.getParam(2));
+      }
+
+      for (int i = 0; i < kCovMatSize; ++i) {
+        o2track.setCov(entry->covm[i], i);
+      }
+    }
+  }
+  return nReconstructed;
+}
+
 double TrackSmearer::getPtRes(const int pdg, const float nch, const float eta, const float pt) const
 {
   float dummy = 0.0f;
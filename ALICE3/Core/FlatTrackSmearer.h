@@ -20,6 +20,7 @@
 #include <cstddef>
 #include <cstdint>
 #include <span>
+#include <vector>
 
 namespace o2::delphes
 {
@@ -42,6 +43,7 @@ class TrackSmearer
   void useEfficiency(bool val) { mUseEfficiency = val; }
   void interpolateEfficiency(bool val) { mInterpolateEfficiency = val; }
   void skipUnreconstructed(bool val) { mSkipUnreconstructed = val; }
+  void useMappedTables(bool val) { mUseMappedTables = val; }
   void setWhatEfficiency(int val);
 
   const lutHeader_t* getLUTHeader(int pdg) const;
@@ -50,6 +52,16 @@ class TrackSmearer
   bool smearTrack(O2Track& o2track, const lutEntry_t* lutEntry, float interpolatedEff);
   bool smearTrack(O2Track& o2track, int pdg, float nch);
 
+  /**
+   * @brief Smear a batch of tracks in place
+   * Tracks are grouped by LUT, the LUT bins are looked up over the whole group and the
+   * random numbers are drawn in blocks. reconstructed[i] is set to what smearTrack(tracks[i], pdgs[i], nch)
+   * would return, the random sequence differs from the one of the single-track version.
+   * @return number of reconstructed tracks
+   */
+  int smearTracks(std::span<O2Track> tracks, std::span<const int> pdgs, float nch, std::span<uint8_t> reconstructed);
+  int smearTracks(std::span<O2Track> tracks, int pdg, float nch, std::span<uint8_t> reconstructed);
+
   double getPtRes(const int pdg, const float nch, const float eta, const float pt) const;
   double getEtaRes(const int pdg, const float nch, const float eta, const float pt) const;
   double getAbsPtRes(const int pdg, const float nch, const float eta, const float pt) const;
@@ -69,13 +81,18 @@ class TrackSmearer
   bool mUseEfficiency = true;
   bool mInterpolateEfficiency = false;
   bool mSkipUnreconstructed = true; // don't smear tracks that are not reco'ed
+  bool mUseMappedTables = false;    // map the LUT files read-only instead of reading them in memory
   int mWhatEfficiency = 1;
   float mdNdEta = 1600.f;
 
  private:
   o2::ccdb::BasicCCDBManager* mCcdbManager = nullptr;
 
+  static constexpr int kSmearBlock = 64; // number of tracks processed together in batch smearing
+  std::vector<uint32_t> mBatchIndices;   // track indices of the current batch, grouped by LUT
+
   static bool checkSpecialCase(int pdg, lutHeader_t const& header);
+  int smearTrackGroup(int pdg, float nch, std::span<const uint32_t> indices, std::span<O2Track> tracks, std::span<uint8_t> reconstructed);
 };
 
 } // namespace o2::delphes
@@ -37,6 +37,7 @@
 #include <cstdio>
 #include <fstream>
 #include <map>
+#include <mutex>
 #include <string>
 #include <thread>
 #include <vector>
@@ -113,17 +114,29 @@ void GeometryContainer::addEntry(const std::string& filename)
   if (!mCcdb) {
     LOG(fatal) << " --- ccdb is not set";
   }
-  mEntries.emplace_back(filename, mCcdb);
+  // The same configuration files are read by all the on-the-fly devices of a workflow: the first one parses the
+  // file (and retrieves it from CCDB if needed), the other ones get a copy of the parsed entry
+  static std::mutex cacheMutex;
+  static std::map<std::string, GeometryEntry> parsedEntries;
+  std::lock_guard<std::mutex> lock(cacheMutex);
+  auto found = parsedEntries.find(filename);
+  if (found == parsedEntries.end()) {
+    found = parsedEntries.emplace(filename, GeometryEntry(filename, mCcdb)).first;
+  } else {
+    LOG(info) << " --- Geometry configuration " << filename << " already parsed, reusing it";
+  }
+  mEntries.push_back(found->second);
 }
 
-std::map<std::string, std::string> GeometryEntry::getConfiguration(const std::string& layerName) const
+const std::map<std::string, std::string>& GeometryEntry::getConfiguration(const std::string& layerName) const
 {
+  static const std::map<std::string, std::string> emptyConfiguration;
   auto it = mConfigurations.find(layerName);
   if (it != mConfigurations.end()) {
     return it->second;
   } else {
     LOG(fatal) << "Layer " << layerName << " not found in geometry configurations.";
-    return {};
+    return emptyConfiguration;
   }
 }
 
@@ -139,10 +152,10 @@ bool GeometryEntry::hasValue(const std::string& layerName, const std::string& ke
 
 std::string GeometryEntry::getValue(const std::string& layerName, const std::string& key, bool require) const
 {
-  auto layer = getConfiguration(layerName);
+  const auto& layer = getConfiguration(layerName);
   auto entry = layer.find(key);
   if (entry != layer.end()) {
-    return layer.at(key);
+    return entry->second;
   } else if (require) {
     LOG(fatal) << "Key " << key << " not found in layer " << layerName << " configurations.";
     return "";
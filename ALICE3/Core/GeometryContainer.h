@@ -61,9 +61,9 @@ struct GeometryEntry {
    */
   static std::string accessFile(const std::string& path, const std::string downloadPath = "/tmp/GeometryContainer/", o2::ccdb::BasicCCDBManager* ccdb = nullptr, int timeoutSeconds = 0);
 
-  std::map<std::string, std::map<std::string, std::string>> getConfigurations() const { return mConfigurations; }
-  std::map<std::string, std::string> getConfiguration(const std::string& layerName) const;
-  std::vector<std::string> getLayerNames() const { return mLayerNames; }
+  const std::map<std::string, std::map<std::string, std::string>>& getConfigurations() const { return mConfigurations; }
+  const std::map<std::string, std::string>& getConfiguration(const std::string& layerName) const;
+  const std::vector<std::string>& getLayerNames() const { return mLayerNames; }
   bool hasValue(const std::string& layerName, const std::string& key) const;
   std::string getValue(const std::string& layerName, const std::string& key, bool require = true) const;
   void setValue(const std::string& layerName, const std::string& key, const std::string& value) { mConfigurations[layerName][key] = value; }
@@ -88,7 +88,7 @@ class GeometryContainer
    **/
   void init(o2::framework::InitContext& initContext);
 
-  // Add a geometry entry from a configuration file
+  // Add a geometry entry from a configuration file, parsed once per process and shared by the devices of the process
   void addEntry(const std::string& filename);
   static void setLutCleanupSetting(const bool cleanLutWhenLoaded) { mCleanLutWhenLoaded = cleanLutWhenLoaded; }
   void setCcdbManager(o2::ccdb::BasicCCDBManager* mgr) { mCcdb = mgr; }
@@ -101,8 +101,8 @@ class GeometryContainer
   static bool cleanLutWhenLoaded() { return mCleanLutWhenLoaded; }
 
   // Get configuration maps
-  std::map<std::string, std::map<std::string, std::string>> getConfigurations(const int id) const { return mEntries.at(id).getConfigurations(); }
-  std::map<std::string, std::string> getConfiguration(const int id, const std::string& layerName) const { return mEntries.at(id).getConfiguration(layerName); }
+  const std::map<std::string, std::map<std::string, std::string>>& getConfigurations(const int id) const { return mEntries.at(id).getConfigurations(); }
+  const std::map<std::string, std::string>& getConfiguration(const int id, const std::string& layerName) const { return mEntries.at(id).getConfiguration(layerName); }
 
   // Get specific values
   std::string getValue(const int id, const std::string& layerName, const std::string& key, bool require = true) const { return mEntries.at(id).getValue(layerName, key, require); }
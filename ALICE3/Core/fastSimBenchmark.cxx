@@ -0,0 +1,249 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file   fastSimBenchmark.cxx
+/// \brief  exec to benchmark the hot paths of the ALICE3 fast simulation
+///         (FastTrack, LUT smearing and decayer) on canned pp and Pb-Pb samples
+///
+/// Usage: o2-alice3-fastsim-benchmark [geometry file] [events per sample] [seed]
+/// The layers and the LUTs (global.lut* entries) are taken from the geometry file.
+///
+
+#include "ALICE3/Core/Decayer.h"
+#include "ALICE3/Core/FastTracker.h"
+#include "ALICE3/Core/FlatTrackSmearer.h"
+#include "ALICE3/Core/GeometryContainer.h"
+#include "ALICE3/Core/OTFParticle.h"
+#include "ALICE3/Core/TrackUtilities.h"
+
+#include <CCDB/BasicCCDBManager.h>
+#include <Framework/Logger.h>
+#include <ReconstructionDataFormats/Track.h>
+
+#include <TDatabasePDG.h>
+#include <TLorentzVector.h>
+#include <TRandom.h>
+#include <TRandom3.h>
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <map>
+#include <new>
+#include <string>
+#include <vector>
+
+// all the allocations of the executable are counted, to see how many of them are done per track
+namespace
+{
+std::atomic<std::size_t> nAllocations{0};
+}
+
+void* operator new(std::size_t size)
+{
+  nAllocations.fetch_add(1, std::memory_order_relaxed);
+  if (void* ptr = std::malloc(size > 0 ? size : 1)) {
+    return ptr;
+  }
+  throw std::bad_alloc();
+}
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+void operator delete(void* ptr, std::size_t) noexcept { std::free(ptr); }
+
+namespace
+{
+struct Sample {
+  std::string name;
+  float dNdEta; // charged particles per unit of pseudorapidity
+  int nEvents;
+};
+
+constexpr float EtaMax = 1.5f;
+constexpr float MeanPt = 0.5f;                                        // GeV/c, slope of the pT spectrum
+constexpr std::array<int, 3> ChargedSpecies{211, 321, 2212};          // pi, K, p
+constexpr std::array<float, 3> SpeciesFractions{0.80f, 0.92f, 1.00f}; // cumulative
+constexpr std::array<int, 4> DecayingSpecies{310, 3122, 3312, 3334};  // K0S, Lambda, Xi, Omega
+
+struct Timer {
+  std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+  std::size_t allocationsAtStart = nAllocations.load();
+  double seconds() const { return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count(); }
+  std::size_t allocations() const { return nAllocations.load() - allocationsAtStart; }
+};
+
+void report(const std::string& sample, const std::string& what, const std::size_t nItems, const Timer& timer)
+{
+  const double seconds = timer.seconds();
+  const std::size_t allocations = timer.allocations();
+  LOGF(info, "%-6s %-28s %10zu items in %8.3f s: %12.0f items/s, %8.2f allocations/item", sample, what, nItems, seconds,
+       seconds > 0. ? nItems / seconds : 0., nItems > 0 ? static_cast<double>(allocations) / nItems : 0.);
+}
+
+// one event of perfect tracks from the origin, pT exponential, uniform in eta and phi
+void generateEvent(const Sample& sample, TRandom& random, const TDatabasePDG* pdgDB, std::vector<o2::track::TrackParCov>& tracks, std::vector<int>& pdgs)
+{
+  tracks.clear();
+  pdgs.clear();
+  const int nTracks = random.Poisson(sample.dNdEta * 2.f * EtaMax);
+  for (int i = 0; i < nTracks; i++) {
+    const float species = random.Rndm();
+    int pdg = ChargedSpecies.back();
+    for (std::size_t s = 0; s < ChargedSpecies.size(); s++) {
+      if (species < SpeciesFractions[s]) {
+        pdg = ChargedSpecies[s];
+        break;
+      }
+    }
+    if (random.Rndm() < 0.5) {
+      pdg = -pdg;
+    }
+    const double mass = pdgDB->GetParticle(pdg)->Mass();
+    TLorentzVector particle;
+    particle.SetPtEtaPhiM(0.1 + random.Exp(MeanPt), random.Uniform(-EtaMax, EtaMax), random.Uniform(0., 2. * M_PI), mass);
+    tracks.emplace_back();
+    o2::upgrade::convertTLorentzVectorToO2Track(pdg, particle, {0., 0., 0.}, tracks.back(), pdgDB);
+    pdgs.push_back(pdg);
+  }
+}
+
+std::map<int, std::string> getLutFiles(const o2::fastsim::GeometryEntry& geometry)
+{
+  static const std::map<std::string, int> LutNames{{"lutEl", 11}, {"lutMu", 13}, {"lutPi", 211}, {"lutKa", 321}, {"lutPr", 2212}};
+  std::map<int, std::string> lutFiles;
+  for (const auto& [key, pdg] : LutNames) {
+    if (geometry.hasValue("global", key)) {
+      lutFiles[pdg] = geometry.getValue("global", key);
+    }
+  }
+  return lutFiles;
+}
+} // namespace
+
+int main(int argc, char* argv[])
+{
+  const std::string geometryFile = argc > 1 ? argv[1] : "ALICE3/Macros/Configuration/a3geometry_v3.ini";
+  const int nEvents = argc > 2 ? std::atoi(argv[2]) : 100;
+  const uint32_t seed = argc > 3 ? std::atoi(argv[3]) : 42;
+
+  // pp and central Pb-Pb multiplicities, the Pb-Pb events are much larger and fewer
+  const std::vector<Sample> samples{{"pp", 7.f, nEvents * 100}, {"PbPb", 1600.f, nEvents}};
+
+  auto& ccdb = o2::ccdb::BasicCCDBManager::instance();
+  ccdb.setURL("http://alice-ccdb.cern.ch");
+  const o2::fastsim::GeometryEntry geometry(geometryFile, &ccdb);
+  const float magneticField = geometry.getFloatValue("global", "magneticfield");
+  const TDatabasePDG* pdgDB = TDatabasePDG::Instance();
+
+  o2::fastsim::FastTracker fastTracker;
+  fastTracker.SetMagneticField(magneticField);
+  fastTracker.AddGenericDetector(geometry, &ccdb);
+
+  o2::delphes::TrackSmearer smearer;
+  smearer.setCcdbManager(&ccdb);
+  int nLuts = 0;
+  for (const auto& [pdg, lutFile] : getLutFiles(geometry)) {
+    nLuts += smearer.loadTable(pdg, lutFile.c_str());
+  }
+  if (nLuts == 0) {
+    LOG(warning) << "No LUT found in " << geometryFile << ", the smearing is not benchmarked";
+  }
+
+  o2::upgrade::Decayer decayer;
+
+  TRandom3 random(seed);
+  gRandom->SetSeed(seed);
+  std::vector<o2::track::TrackParCov> smearedTracks;
+  std::vector<uint8_t> reconstructed;
+  std::vector<o2::upgrade::OTFParticle> decayProducts;
+  o2::fastsim::FastTrackResult result;
+
+  LOGF(info, "Geometry %s: %zu layers, B = %.1f kG, %d LUTs", geometryFile, fastTracker.GetNLayers(), magneticField, nLuts);
+  for (const auto& sample : samples) {
+    // the events are generated once and reused for all the benchmarks of the sample
+    std::vector<std::vector<o2::track::TrackParCov>> events(sample.nEvents);
+    std::vector<std::vector<int>> eventPdgs(sample.nEvents);
+    std::size_t nTracks = 0;
+    for (int iEvent = 0; iEvent < sample.nEvents; iEvent++) {
+      generateEvent(sample, random, pdgDB, events[iEvent], eventPdgs[iEvent]);
+      nTracks += events[iEvent].size();
+    }
+
+    {
+      Timer timer;
+      std::size_t nIntercepts = 0;
+      std::size_t nTracked = 0;
+      o2::track::TrackParCov outputTrack;
+      for (const auto& event : events) {
+        fastTracker.SetEventMultiplicity(sample.dNdEta);
+        for (const auto& track : event) {
+          if (fastTracker.FastTrack(track, outputTrack, sample.dNdEta, result, random) > 0) {
+            nTracked++;
+          }
+          nIntercepts += result.nIntercepts;
+        }
+      }
+      const double seconds = timer.seconds();
+      report(sample.name, "FastTrack", nTracks, timer);
+      LOGF(info, "%-6s %-28s %10zu tracked, %6.2f layers/track, %8.1f ns/layer", sample.name, "FastTrack", nTracked,
+           nTracks > 0 ? static_cast<double>(nIntercepts) / nTracks : 0., nIntercepts > 0 ? 1.e9 * seconds / nIntercepts : 0.);
+    }
+
+    if (nLuts > 0) {
+      {
+        Timer timer;
+        for (std::size_t iEvent = 0; iEvent < events.size(); iEvent++) {
+          smearedTracks = events[iEvent];
+          for (std::size_t i = 0; i < smearedTracks.size(); i++) {
+            smearer.smearTrack(smearedTracks[i], eventPdgs[iEvent][i], sample.dNdEta);
+          }
+        }
+        report(sample.name, "smearTrack (flat LUT)", nTracks, timer);
+      }
+      {
+        Timer timer;
+        for (std::size_t iEvent = 0; iEvent < events.size(); iEvent++) {
+          smearedTracks = events[iEvent];
+          reconstructed.resize(smearedTracks.size());
+          smearer.smearTracks(smearedTracks, eventPdgs[iEvent], sample.dNdEta, reconstructed);
+        }
+        report(sample.name, "smearTracks (flat LUT batch)", nTracks, timer);
+      }
+    }
+
+    {
+      // one strange hadron per 20 charged particles, with the momentum of the track
+      Timer timer;
+      std::size_t nDecays = 0;
+      for (const auto& event : events) {
+        for (std::size_t i = 0; i < event.size(); i += 20) {
+          const int pdg = DecayingSpecies[(i / 20) % DecayingSpecies.size()];
+          const double mass = pdgDB->GetParticle(pdg)->Mass();
+          std::array<float, 3> momentum;
+          event[i].getPxPyPzGlo(momentum);
+          o2::upgrade::OTFParticle particle;
+          particle.setPDG(pdg);
+          particle.setVxVyVz(0.f, 0.f, 0.f);
+          particle.setPxPyPzE(momentum[0], momentum[1], momentum[2], std::sqrt(event[i].getP2() + mass * mass));
+          decayProducts.clear();
+          decayer.decayParticle(pdgDB, particle, decayProducts);
+          nDecays++;
+        }
+      }
+      report(sample.name, "decayParticle", nDecays, timer);
+    }
+  }
+  return 0;
+}
@@ -119,6 +119,7 @@ struct OnTheFlyDecayer {
   }
 
   std::vector<o2::upgrade::OTFParticle> allParticles;
+  std::vector<o2::upgrade::OTFParticle> decayStack; // decay products of the current particle
   void decayParticles(const int start, const int stop)
   {
     if (start >= stop) {
@@ -138,7 +139,8 @@ struct OnTheFlyDecayer {
       }
 
       particle.setBitOff(o2::upgrade::DecayerBits::IsAlive);
-      std::vector<o2::upgrade::OTFParticle> decayStack = decayer.decayParticle(pdgDB, particle);
+      decayStack.clear();
+      decayer.decayParticle(pdgDB, particle, decayStack);
       if (decayStack.empty()) {
         continue;
       }
@@ -160,9 +162,11 @@ struct OnTheFlyDecayer {
 
       const float trackTimeNS = trackLength / trackVelocity * PicoToNano;
       particle.setIndicesDaughter(particlesInDataframe - indexOffset + allParticles.size(), particlesInDataframe - indexOffset + allParticles.size() + (decayStack.size() - 1));
+      // particle refers to an element of allParticles, which may be reallocated when the daughters are added
+      const auto collisionId = particle.collisionId();
       for (auto& daughter : decayStack) {
         daughter.setIndicesMother(particlesInDataframe - indexOffset + i, particlesInDataframe - indexOffset + i);
-        daughter.setCollisionId(particle.collisionId());
+        daughter.setCollisionId(collisionId);
         daughter.setBitOn(o2::upgrade::DecayerBits::IsAlive);
         daughter.setBitOff(o2::upgrade::DecayerBits::IsPrimary);
         daughter.setProductionTime(trackTimeNS);
@@ -153,6 +153,7 @@ struct OnTheFlyRichPid {
   std::vector<float> aerogelRindex;
   std::vector<float> photodetrctorLength;
   std::vector<float> gapThickness;
+  bool sectorsOrderedInTheta = false; // sectors sorted by decreasing polar angle without overlaps, see findSector
 
   // Update projective geometry
   void updateProjectiveParameters()
@@ -274,6 +275,13 @@ struct OnTheFlyRichPid {
       photodetrctorLength[i] = lDetectorZ[i];
       gapThickness[i] = (detCenters[i] - radCenters[i]).Mag() - bRichRadiatorThickness / 2.0;
     }
+    // The sectors are adjacent and their polar angle decreases with the index, so that the sector of a track can be found by binary search
+    sectorsOrderedInTheta = true;
+    for (int i = 1; i < numberOfSectorsInZ; i++) {
+      if (thetaMax[i] > thetaMax[i - 1] || thetaMin[i] > thetaMax[i - 1]) {
+        sectorsOrderedInTheta = false;
+      }
+    }
     // DEBUG
     // std::cout << std::endl << std::endl;
     // for (int i = 0; i < numberOfSectorsInZ; i++) {
@@ -456,6 +464,23 @@ struct OnTheFlyRichPid {
   int findSector(const float eta)
   {
     float polar = 2.0 * std::atan(std::exp(-eta));
+    if (sectorsOrderedInTheta) {
+      // first sector below the polar angle of the track, the only one which can contain it
+      int lower = 0;
+      int upper = thetaMax.size();
+      while (lower < upper) {
+        const int middle = (lower + upper) / 2;
+        if (thetaMax[middle] < polar) {
+          upper = middle;
+        } else {
+          lower = middle + 1;
+        }
+      }
+      if (lower < static_cast<int>(thetaMin.size()) && polar < thetaMin[lower]) {
+        return lower;
+      }
+      return -1;
+    }
     for (int jSector = 0; jSector < bRichNumberOfSectors; jSector++) {
       if (polar > thetaMax[jSector] && polar < thetaMin[jSector]) {
         return jSector;
@@ -571,15 +596,9 @@ struct OnTheFlyRichPid {
   float fractionPhotonsProjectiveRICH(float eta, float tileZlength, float radius)
   {
     const float polar = 2.0 * std::atan(std::exp(-eta));
-    int iSecor = 0;
-    bool flagSector = false;
-    for (int jSector = 0; jSector < bRichNumberOfSectors; jSector++) {
-      if (polar > thetaMax[jSector] && polar < thetaMin[jSector]) {
-        flagSector = true;
-        iSecor = jSector;
-      }
-    }
-    if (flagSector == false) {
+    // the sectors do not overlap, a track is in one sector at most
+    const int iSecor = findSector(eta);
+    if (iSecor < 0) {
       return kErrorValue; // <-- Returning negative value
     }
     float rSecRich = radCenters[iSecor].X();
@@ -854,26 +873,32 @@ struct OnTheFlyRichPid {
                                                            o2::track::pid_constants::sMasses[o2::track::PID::Helium3],
                                                            o2::track::pid_constants::sMasses[o2::track::PID::Alpha]};
 
+      // track quantities which do not depend on the hypothesis
+      const float recoMomentum = recoTrack.getP();
+      const float recoEta = recoTrack.getEta();
+      const float transverseMomentum = recoMomentum / std::cosh(recoEta);
+      const double defaultPtResolution = transverseMomentum * transverseMomentum * std::sqrt(recoTrack.getSigma1Pt2());
+      const double defaultEtaResolution = std::fabs(std::sin(2.0 * std::atan(std::exp(-recoEta)))) * std::sqrt(recoTrack.getSigmaTgl2());
+
       for (int ii = 0; ii < kNspecies; ii++) { // Loop on the particle hypotheses
 
         float hypothesisAngleBarrelRich = kErrorValue;
-        const bool hypothesisAngleBarrelRichOk = cherenkovAngle(recoTrack.getP(), kParticleMasses[ii], aerogelRindex[iSecor], hypothesisAngleBarrelRich);
+        const bool hypothesisAngleBarrelRichOk = cherenkovAngle(recoMomentum, kParticleMasses[ii], aerogelRindex[iSecor], hypothesisAngleBarrelRich);
         signalBarrelRich[ii] = hypothesisAngleBarrelRichOk; // Particle is above the threshold and enough photons
 
         // Evaluate total sigma (layer + tracking resolution)
         float barrelTotalAngularReso = barrelRICHAngularResolution;
         if (flagIncludeTrackAngularRes) {
-          const float transverseMomentum = recoTrack.getP() / std::cosh(recoTrack.getEta());
-          double ptResolution = transverseMomentum * transverseMomentum * std::sqrt(recoTrack.getSigma1Pt2());
-          double etaResolution = std::fabs(std::sin(2.0 * std::atan(std::exp(-recoTrack.getEta())))) * std::sqrt(recoTrack.getSigmaTgl2());
+          double ptResolution = defaultPtResolution;
+          double etaResolution = defaultEtaResolution;
           if (flagRICHLoadDelphesLUTs) {
             if (mSmearer[collision.lutConfigId()]->hasTable(kParticlePdgs[ii])) {
-              ptResolution = mSmearer[collision.lutConfigId()]->getAbsPtRes(kParticlePdgs[ii], dNdEta, recoTrack.getEta(), transverseMomentum);
-              etaResolution = mSmearer[collision.lutConfigId()]->getAbsEtaRes(kParticlePdgs[ii], dNdEta, recoTrack.getEta(), transverseMomentum);
+              ptResolution = mSmearer[collision.lutConfigId()]->getAbsPtRes(kParticlePdgs[ii], dNdEta, recoEta, transverseMomentum);
+              etaResolution = mSmearer[collision.lutConfigId()]->getAbsEtaRes(kParticlePdgs[ii], dNdEta, recoEta, transverseMomentum);
             }
           }
           // cout << endl <<  "Pt resolution: " << ptResolution << ", Eta resolution: " << etaResolution << endl << endl;
-          const float barrelTrackAngularReso = calculateTrackAngularResolutionAdvanced(recoTrack.getP() / std::cosh(recoTrack.getEta()), recoTrack.getEta(), ptResolution, etaResolution, kParticleMasses[ii], aerogelRindex[iSecor]);
+          const float barrelTrackAngularReso = calculateTrackAngularResolutionAdvanced(transverseMomentum, recoEta, ptResolution, etaResolution, kParticleMasses[ii], aerogelRindex[iSecor]);
           barrelTotalAngularReso = std::hypot(barrelRICHAngularResolution, barrelTrackAngularReso);
           if (doQAplots &&
               hypothesisAngleBarrelRich > kErrorValue + 1. &&
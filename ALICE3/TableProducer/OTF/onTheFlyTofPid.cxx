@@ -786,6 +786,10 @@ struct OnTheFlyTofPid {
         }
       }
 
+      // track quantities which do not depend on the hypothesis
+      const float coshEta = std::cosh(pseudorapidity);
+      const double defaultEtaResolution = std::fabs(std::sin(2.0 * std::atan(std::exp(-pseudorapidity)))) * std::sqrt(trkWithTime.mPseudorapidity.second);
+
       // For every mass hypothesis compute the expected time, the delta with respect to it and the nsigma
       for (int ii = 0; ii < kParticles; ii++) {
         expectedTimeInnerTOF[ii] = -100;
@@ -808,9 +812,9 @@ struct OnTheFlyTofPid {
         float innerTotalTimeReso = simConfig.innerTOFTimeReso;
         float outerTotalTimeReso = simConfig.outerTOFTimeReso;
         if (simConfig.flagIncludeTrackTimeRes) {
-          const float transverseMomentum = momentumHypotheses[ii] / std::cosh(pseudorapidity);
+          const float transverseMomentum = momentumHypotheses[ii] / coshEta;
           double ptResolution = transverseMomentum * transverseMomentum * std::sqrt(trkWithTime.mMomentum.second);
-          double etaResolution = std::fabs(std::sin(2.0 * std::atan(std::exp(-pseudorapidity)))) * std::sqrt(trkWithTime.mPseudorapidity.second);
+          double etaResolution = defaultEtaResolution;
           if (simConfig.flagTOFLoadDelphesLUTs) {
             if (mSmearer[collision.lutConfigId()]->hasTable(kParticlePdgs[ii])) { // Only if the LUT for this particle was loaded
               ptResolution = mSmearer[collision.lutConfigId()]->getAbsPtRes(kParticlePdgs[ii], dNdEta, pseudorapidity, transverseMomentum);
@@ -94,6 +94,7 @@
 #include <cstddef>
 #include <cstdint>
 #include <cstdlib>
+#include <limits>
 #include <map>
 #include <memory>
 #include <string>
@@ -160,6 +161,7 @@ struct OnTheFlyTracker {
   Configurable<bool> enablePrimaryVertexing{"enablePrimaryVertexing", true, "Enable primary vertexing"};
   Configurable<std::string> primaryVertexOption{"primaryVertexOption", "pvertexer.maxChi2TZDebris=10;pvertexer.acceptableScale2=9;pvertexer.minScale2=2;pvertexer.timeMarginVertexTime=1.3;;pvertexer.maxChi2TZDebris=40;pvertexer.maxChi2Mean=12;pvertexer.maxMultRatDebris=1.;pvertexer.addTimeSigma2Debris=1e-2;pvertexer.meanVertexExtraErrSelection=0.03;", "Option for the primary vertexer"};
   Configurable<bool> interpolateLutEfficiencyVsNch{"interpolateLutEfficiencyVsNch", true, "interpolate LUT efficiency as f(Nch)"};
+  Configurable<bool> useMappedLuts{"useMappedLuts", false, "map the local LUT files read-only, sharing one copy across devices and geometries"};
 
   Configurable<bool> populateTracksDCA{"populateTracksDCA", true, "populate TracksDCA table"};
   Configurable<bool> populateTracksDCACov{"populateTracksDCACov", false, "populate TracksDCACov table"};
@@ -206,6 +208,7 @@ struct OnTheFlyTracker {
     Configurable<bool> applyZacceptance{"applyZacceptance", false, "apply z limits to detector layers or not"};
     Configurable<bool> applyMSCorrection{"applyMSCorrection", true, "apply ms corrections for secondaries or not"};
     Configurable<bool> applyElossCorrection{"applyElossCorrection", true, "apply eloss corrections for secondaries or not"};
+    Configurable<int> nThreads{"nThreads", 1, "number of threads for the fast tracking of the particles of an event (decayer workflow)"};
   } fastTrackerSettings; // allows for gap between peak and bg in case someone wants to
 
   struct : ConfigurableGroup {
@@ -264,6 +267,22 @@ struct OnTheFlyTracker {
   // FastTracker machinery
   std::vector<std::unique_ptr<o2::fastsim::FastTracker>> fastTracker;
 
+  // particles of the event waiting for the batched fast tracking (decayer workflow)
+  struct PendingTrack {
+    o2::track::TrackParCov trackParCov;
+    int64_t mcLabel;
+    int pdgCode;
+    float time;
+    bool isDecayDaughter;
+    bool reconstructed;
+    int nTrkHits;
+    int fastTrackSlot; // index in the fast tracking batch, -1 if not fast tracked
+  };
+  std::vector<PendingTrack> pendingTracks;
+  std::vector<o2::track::TrackParCov> fastTrackInputs;
+  std::vector<o2::track::TrackParCov> fastTrackOutputs;
+  std::vector<o2::fastsim::FastTrackResult> fastTrackResults;
+
   // V0 names for filling histograms
   static constexpr int NtypesV0 = 3;
   static constexpr std::string_view NameV0s[NtypesV0] = {"K0", "Lambda", "AntiLambda"};
@@ -397,6 +416,8 @@ struct OnTheFlyTracker {
   // Configuration defined at init time
   o2::fastsim::GeometryContainer mGeoContainer;
   float mMagneticField = 0.0f;
+  // x0 of the non-global layers per configuration, in the order of the geometry file, for the bremsstrahlung
+  std::vector<std::vector<float>> mLayerX0;
   // Time resolution constants
   const float timeResolutionNs = 100.f; // ns
   const float nsToMus = 1e-3f;
@@ -415,10 +436,21 @@ struct OnTheFlyTracker {
 
     const int nGeometries = mGeoContainer.getNumberOfConfigurations();
     mMagneticField = mGeoContainer.getFloatValue(0, "global", "magneticfield");
+    mLayerX0.resize(nGeometries);
     for (int icfg = 0; icfg < nGeometries; ++icfg) {
       const std::string histPath = "Configuration_" + std::to_string(icfg) + "/";
+      if (brSettings.radiateBR) {
+        const auto& geoEntry = mGeoContainer.getEntry(icfg);
+        for (auto const& layerName : geoEntry.getLayerNames()) {
+          if (layerName.find("global") != std::string::npos) { // Layers with global tag are skipped
+            continue;
+          }
+          mLayerX0[icfg].push_back(geoEntry.getFloatValue(layerName, "x0"));
+        }
+      }
       mSmearer.emplace_back(std::make_unique<o2::delphes::TrackSmearer>());
       mSmearer[icfg]->setCcdbManager(ccdb.operator->());
+      mSmearer[icfg]->useMappedTables(useMappedLuts.value);
       std::map<std::string, std::string> globalConfiguration = mGeoContainer.getConfiguration(icfg, "global");
       if (enablePrimarySmearing) {
         // load LUTs for primaries
@@ -1773,13 +1805,7 @@ struct OnTheFlyTracker {
   void computeBremsstrahlungLoss(const int icfg, const auto& mcParticle, o2::track::TrackParCov& trackParCov)
   {
     if (brSettings.radiateBR) {
-      const o2::fastsim::GeometryEntry geoEntry = mGeoContainer.getEntry(icfg);
-
-      for (auto const& layerName : geoEntry.getLayerNames()) {
-        if (layerName.find("global") != std::string::npos) { // Layers with global tag are skipped
-          continue;
-        }
-
+      for (const float layerX0 : mLayerX0[icfg]) {
         float mass = o2::constants::physics::MassElectron;
 
         switch (std::abs(mcParticle.pdgCode())) {
@@ -1802,7 +1828,7 @@ struct OnTheFlyTracker {
             break;
         }
 
-        float lambda = brSettings.radiationStrength * mcParticle.e() * geoEntry.getFloatValue(layerName, "x0") / (mass * mass);
+        float lambda = brSettings.radiationStrength * mcParticle.e() * layerX0 / (mass * mass);
         ULong64_t nPhotons = gRandom->Poisson(lambda);
 
         double initialMomentum = trackParCov.getP();
@@ -2022,6 +2048,8 @@ struct OnTheFlyTracker {
     bcData.clear();
     cascadesAlice3.clear();
     v0sAlice3.clear();
+    pendingTracks.clear();
+    fastTrackInputs.clear();
 
     // generate collision time
     auto ir = irSampler.generateCollisionTime();
@@ -2075,29 +2103,45 @@ struct OnTheFlyTracker {
       }
 
       multiplicityCounter++;
-      o2::track::TrackParCov trackParCov;
-      const bool isDecayDaughter = (mcParticle.getProcess() == TMCProcess::kPDecay);
-      const float time = (eventCollisionTimeNS + gRandom->Gaus(0., timeResolutionNs)) * nsToMus;
+      PendingTrack& pending = pendingTracks.emplace_back();
+      pending.mcLabel = mcParticle.globalIndex();
+      pending.pdgCode = mcParticle.pdgCode();
+      pending.isDecayDaughter = (mcParticle.getProcess() == TMCProcess::kPDecay);
+      pending.time = (eventCollisionTimeNS + gRandom->Gaus(0., timeResolutionNs)) * nsToMus;
+      pending.reconstructed = false;
+      pending.nTrkHits = 0;
+      pending.fastTrackSlot = -1;
 
-      bool reconstructed = false;
-      int nTrkHits = 0;
       if (enablePrimarySmearing && otfParticle.checkBit(o2::upgrade::DecayerBits::IsPrimary)) {
-        o2::upgrade::convertMCParticleToO2Track(mcParticle, trackParCov, pdgDB);
-        computeBremsstrahlungLoss(icfg, mcParticle, trackParCov);
-        reconstructed = mSmearer[icfg]->smearTrack(trackParCov, mcParticle.pdgCode(), dNdEta);
-        nTrkHits = fastTrackerSettings.minSiliconHits;
+        o2::upgrade::convertMCParticleToO2Track(mcParticle, pending.trackParCov, pdgDB);
+        computeBremsstrahlungLoss(icfg, mcParticle, pending.trackParCov);
+        pending.reconstructed = mSmearer[icfg]->smearTrack(pending.trackParCov, mcParticle.pdgCode(), dNdEta);
+        pending.nTrkHits = fastTrackerSettings.minSiliconHits;
       } else if (enableSecondarySmearing && !otfParticle.checkBit(o2::upgrade::DecayerBits::IsPrimary) && otfParticle.checkBit(o2::upgrade::DecayerBits::ProducedByDecayer) && otfParticle.checkBit(o2::upgrade::DecayerBits::IsAlive)) {
-        o2::track::TrackParCov perfectTrackParCov;
+        o2::track::TrackParCov& perfectTrackParCov = fastTrackInputs.emplace_back();
         o2::upgrade::convertMCParticleToO2Track(mcParticle, perfectTrackParCov, pdgDB);
         computeBremsstrahlungLoss(icfg, mcParticle, perfectTrackParCov);
         perfectTrackParCov.setPID(pdgCodeToPID(mcParticle.pdgCode()));
-        nTrkHits = fastTracker[icfg]->FastTrack(perfectTrackParCov, trackParCov, dNdEta);
-        if (nTrkHits < fastTrackerSettings.minSiliconHits) {
-          reconstructed = false;
-        } else {
-          reconstructed = true;
-        }
+        pending.fastTrackSlot = fastTrackInputs.size() - 1;
       }
+    }
+
+    // Fast tracking of all the secondaries of the event at once, spread over the configured threads
+    if (!fastTrackInputs.empty()) {
+      fastTrackOutputs.resize(fastTrackInputs.size());
+      fastTrackResults.resize(fastTrackInputs.size());
+      const auto seed = static_cast<uint32_t>(gRandom->Integer(std::numeric_limits<uint32_t>::max()));
+      fastTracker[icfg]->FastTrackBatch(fastTrackInputs, fastTrackOutputs, fastTrackResults, dNdEta, fastTrackerSettings.nThreads, seed);
+    }
+
+    for (auto& pending : pendingTracks) {
+      if (pending.fastTrackSlot >= 0) {
+        pending.trackParCov = fastTrackOutputs[pending.fastTrackSlot];
+        pending.nTrkHits = fastTrackResults[pending.fastTrackSlot].status;
+        pending.reconstructed = (pending.nTrkHits >= fastTrackerSettings.minSiliconHits);
+      }
+      const auto& trackParCov = pending.trackParCov;
+      const bool reconstructed = pending.reconstructed;
 
       if (!reconstructed && processUnreconstructedTracks) {
         continue; // failed to reconstruct track
@@ -2111,20 +2155,20 @@ struct OnTheFlyTracker {
       histos.fill(HIST("hNaNBookkeeping"), 0.0f, 1.0f);
       if (enablePrimarySmearing) {
         getHist(TH1, histPath + "hPtReconstructed")->Fill(trackParCov.getPt());
-        if (std::abs(mcParticle.pdgCode()) == kElectron)
+        if (std::abs(pending.pdgCode) == kElectron)
           getHist(TH1, histPath + "hPtReconstructedEl")->Fill(trackParCov.getPt());
-        if (std::abs(mcParticle.pdgCode()) == kPiPlus)
+        if (std::abs(pending.pdgCode) == kPiPlus)
           getHist(TH1, histPath + "hPtReconstructedPi")->Fill(trackParCov.getPt());
-        if (std::abs(mcParticle.pdgCode()) == kKPlus)
+        if (std::abs(pending.pdgCode) == kKPlus)
           getHist(TH1, histPath + "hPtReconstructedKa")->Fill(trackParCov.getPt());
-        if (std::abs(mcParticle.pdgCode()) == kProton)
+        if (std::abs(pending.pdgCode) == kProton)
           getHist(TH1, histPath + "hPtReconstructedPr")->Fill(trackParCov.getPt());
       }
 
       if (reconstructed) {
-        tracksAlice3.push_back(TrackAlice3{trackParCov, mcParticle.globalIndex(), time, timeResolutionUs, isDecayDaughter, false, 0, nTrkHits, kRecoPrimary});
+        tracksAlice3.push_back(TrackAlice3{trackParCov, pending.mcLabel, pending.time, timeResolutionUs, pending.isDecayDaughter, false, 0, pending.nTrkHits, kRecoPrimary});
       } else {
-        ghostTracksAlice3.push_back(TrackAlice3{trackParCov, mcParticle.globalIndex(), time, timeResolutionUs, isDecayDaughter, false, 0, nTrkHits, kGhostPrimary});
+        ghostTracksAlice3.push_back(TrackAlice3{trackParCov, pending.mcLabel, pending.time, timeResolutionUs, pending.isDecayDaughter, false, 0, pending.nTrkHits, kGhostPrimary});
       }
     }
 
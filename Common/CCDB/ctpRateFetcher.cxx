@@ -23,6 +23,7 @@
 #include <cstdint>
 #include <map>
 #include <ostream>
+#include <span>
 #include <string>
 #include <vector>
 
@@ -60,10 +61,24 @@ double ctpRateFetcher::fetch(o2::ccdb::BasicCCDBManager* ccdb, uint64_t timeStam
   return -1.;
 }
 
-double ctpRateFetcher::fetchCTPratesClasses(o2::ccdb::BasicCCDBManager* /*ccdb*/, uint64_t timeStamp, int /*runNumber*/, const std::string& className, int inputType)
+void ctpRateFetcher::fetch(o2::ccdb::BasicCCDBManager* ccdb, std::span<const uint64_t> timeStamps, int runNumber, const std::string& sourceName, std::span<double> rates, bool fCrashOnNull)
+{
+  if (rates.size() != timeStamps.size()) {
+    LOG(fatal) << "ctpRateFetcher: " << timeStamps.size() << " timestamps for " << rates.size() << " rates";
+  }
+  for (size_t i = 0; i < timeStamps.size(); i++) {
+    rates[i] = fetch(ccdb, timeStamps[i], runNumber, sourceName, fCrashOnNull);
+  }
+}
+
+int ctpRateFetcher::getClassIndex(const std::string& className)
 {
-  std::vector<ctp::CTPClass> ctpcls = mConfig->getCTPClasses();
-  std::vector<int> clslist = mConfig->getTriggerClassList();
+  auto cached = mClassIndices.find(className);
+  if (cached != mClassIndices.end()) {
+    return cached->second;
+  }
+  const std::vector<ctp::CTPClass>& ctpcls = mConfig->getCTPClasses();
+  const std::vector<int> clslist = mConfig->getTriggerClassList();
   int classIndex = -1;
   for (size_t i = 0; i < clslist.size(); i++) {
     if (ctpcls[i].name.find(className) != std::string::npos) {
@@ -71,6 +86,13 @@ double ctpRateFetcher::fetchCTPratesClasses(o2::ccdb::BasicCCDBManager* /*ccdb*/
       break;
     }
   }
+  mClassIndices.emplace(className, classIndex);
+  return classIndex;
+}
+
+double ctpRateFetcher::fetchCTPratesClasses(o2::ccdb::BasicCCDBManager* /*ccdb*/, uint64_t timeStamp, int /*runNumber*/, const std::string& className, int inputType)
+{
+  int classIndex = getClassIndex(className);
   if (classIndex == -1) {
     LOG(warn) << "Trigger class " << className << " not found in CTPConfiguration";
     return -1.;
@@ -81,8 +103,7 @@ double ctpRateFetcher::fetchCTPratesClasses(o2::ccdb::BasicCCDBManager* /*ccdb*/
 
 double ctpRateFetcher::fetchCTPratesInputs(o2::ccdb::BasicCCDBManager* /*ccdb*/, uint64_t timeStamp, int /*runNumber*/, int input)
 {
-  std::vector<ctp::CTPScalerRecordO2> recs = mScalers->getScalerRecordO2();
-  if (recs[0].scalersInps.size() == 48) {
+  if (mHasInputScalers) {
     return pileUpCorrection(mScalers->getRateGivenT(timeStamp * 1.e-3, input, 7, 1).second);
   } else {
     LOG(error) << "Inputs not available";
@@ -95,7 +116,7 @@ double ctpRateFetcher::pileUpCorrection(double triggerRate)
   if (mLHCIFdata == nullptr) {
     LOG(fatal) << "No filling" << std::endl;
   }
-  double nbc = mLHCIFdata->getBunchFilling().getPattern().count();
+  double nbc = mFilledBunches;
   double nTriggersPerFilledBC = triggerRate / nbc / constants::lhc::LHCRevFreq;
   double mu = -std::log(1 - nTriggersPerFilledBC);
   return mu * nbc * constants::lhc::LHCRevFreq;
@@ -128,6 +149,10 @@ void ctpRateFetcher::setupRun(int runNumber, o2::ccdb::BasicCCDBManager* ccdb, u
     LOG(fatal) << "CTPRunScalers not in database, timestamp:" << timeStamp;
   }
   mScalers->convertRawToO2();
+
+  mClassIndices.clear();
+  mHasInputScalers = mScalers->getScalerRecordO2()[0].scalersInps.size() == 48;
+  mFilledBunches = mLHCIFdata->getBunchFilling().getPattern().count();
 }
 
 } // namespace o2
@@ -15,6 +15,8 @@
 #include <CCDB/BasicCCDBManager.h>
 
 #include <cstdint>
+#include <map>
+#include <span>
 #include <string>
 
 namespace o2
@@ -36,6 +38,8 @@ class ctpRateFetcher
  public:
   ctpRateFetcher() = default;
   double fetch(o2::ccdb::BasicCCDBManager* ccdb, uint64_t timeStamp, int runNumber, const std::string& sourceName, bool fCrashOnNull = true);
+  // rates[i] = fetch(ccdb, timeStamps[i], runNumber, sourceName, fCrashOnNull), timeStamps and rates of the same size
+  void fetch(o2::ccdb::BasicCCDBManager* ccdb, std::span<const uint64_t> timeStamps, int runNumber, const std::string& sourceName, std::span<double> rates, bool fCrashOnNull = true);
 
   void setManualCleanup(bool manualCleanup = true) { mManualCleanup = manualCleanup; }
 
@@ -44,12 +48,18 @@ class ctpRateFetcher
   double fetchCTPratesClasses(o2::ccdb::BasicCCDBManager* ccdb, uint64_t timeStamp, int runNumber, const std::string& className, int inputType = 1);
   double pileUpCorrection(double rate);
   void setupRun(int runNumber, o2::ccdb::BasicCCDBManager* ccdb, uint64_t timeStamp);
+  int getClassIndex(const std::string& className);
 
   bool mManualCleanup = false;
   int mRunNumber = -1;
   ctp::CTPConfiguration* mConfig = nullptr;
   ctp::CTPRunScalers* mScalers = nullptr;
   parameters::GRPLHCIFData* mLHCIFdata = nullptr;
+
+  // per run quantities, computed from the CCDB objects above when the run changes or at first use
+  std::map<std::string, int> mClassIndices; // index of the first trigger class matching a class name, -1 if none
+  bool mHasInputScalers = false;
+  double mFilledBunches = 0.;
 };
 } // namespace o2
 
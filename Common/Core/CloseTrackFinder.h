@@ -0,0 +1,180 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file CloseTrackFinder.h
+/// \brief Search of the pairs of tracks close in (eta, phi), e.g. split or duplicated tracks, without testing all the pairs
+///
+/// The kinematics of the tracks are copied once into arrays. The tracks are sorted in (phi, eta) cells as large as the
+/// search window, so that a track is only compared with the tracks of its own cell and of the neighbouring cells.
+/// The pairs found are returned as a flat list of indices in the order in which the tracks were added.
+
+#ifndef COMMON_CORE_CLOSETRACKFINDER_H_
+#define COMMON_CORE_CLOSETRACKFINDER_H_
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <numeric>
+#include <vector>
+
+namespace o2::common::core
+{
+
+class CloseTrackFinder
+{
+ public:
+  /// indices of the two tracks of a pair, first < second
+  struct Pair {
+    int first;
+    int second;
+  };
+
+  /// the pairs with |delta eta| < maxDeltaEta and |delta phi| < maxDeltaPhi (phi is periodic) are searched
+  void setWindow(float maxDeltaEta, float maxDeltaPhi)
+  {
+    mMaxDeltaEta = maxDeltaEta;
+    mMaxDeltaPhi = maxDeltaPhi;
+  }
+
+  void clear()
+  {
+    mEta.clear();
+    mPhi.clear();
+    mPt.clear();
+  }
+
+  void add(float eta, float phi, float pt)
+  {
+    mEta.push_back(eta);
+    mPhi.push_back(phi);
+    mPt.push_back(pt);
+  }
+
+  /// replaces the content with the given tracks (or particles), with eta, phi in [0, 2pi) and pt
+  template <typename T>
+  void fill(T const& tracks)
+  {
+    clear();
+    for (auto const& track : tracks) {
+      add(track.eta(), track.phi(), track.pt());
+    }
+  }
+
+  std::size_t size() const { return mEta.size(); }
+  float eta(int i) const { return mEta[i]; }
+  float phi(int i) const { return mPhi[i]; }
+  float pt(int i) const { return mPt[i]; }
+
+  /// |phi1 - phi2| folded in [0, pi]
+  static float deltaPhi(float phi1, float phi2)
+  {
+    constexpr float TwoPi = 2.f * static_cast<float>(M_PI);
+    float delta = std::fabs(phi1 - phi2);
+    delta = std::fmod(delta, TwoPi);
+    return delta > static_cast<float>(M_PI) ? TwoPi - delta : delta;
+  }
+
+  /// pairs of the tracks added within the window, valid until the next call
+  std::vector<Pair> const& findPairs()
+  {
+    mPairs.clear();
+    const int nTracks = size();
+    if (nTracks < 2 || !(mMaxDeltaEta > 0.f) || !(mMaxDeltaPhi > 0.f)) {
+      return mPairs;
+    }
+
+    // cells at least as large as the window, with fewer than 3 phi cells all the phi range is a single cell
+    constexpr double TwoPi = 2. * M_PI;
+    int nPhiCells = static_cast<int>(TwoPi / mMaxDeltaPhi);
+    if (nPhiCells < 3) {
+      nPhiCells = 1;
+    }
+    const float etaMin = *std::min_element(mEta.begin(), mEta.end());
+    mCell.resize(nTracks);
+    for (int i = 0; i < nTracks; i++) {
+      double phi = std::fmod(static_cast<double>(mPhi[i]), TwoPi);
+      if (phi < 0.) {
+        phi += TwoPi;
+      }
+      const int64_t phiCell = std::min(static_cast<int>(phi * nPhiCells / TwoPi), nPhiCells - 1);
+      const int64_t etaCell = static_cast<int64_t>((mEta[i] - etaMin) / mMaxDeltaEta);
+      mCell[i] = phiCell * EtaCellStride + etaCell;
+    }
+    mOrder.resize(nTracks);
+    std::iota(mOrder.begin(), mOrder.end(), 0);
+    std::sort(mOrder.begin(), mOrder.end(), [this](int a, int b) { return mCell[a] < mCell[b] || (mCell[a] == mCell[b] && a < b); });
+    mSortedCell.resize(nTracks);
+    for (int i = 0; i < nTracks; i++) {
+      mSortedCell[i] = mCell[mOrder[i]];
+    }
+
+    // each pair of neighbouring cells is visited once: the cell itself and its forward neighbours
+    for (int begin = 0; begin < nTracks;) {
+      const int64_t cell = mSortedCell[begin];
+      const int end = std::upper_bound(mSortedCell.begin() + begin, mSortedCell.end(), cell) - mSortedCell.begin();
+      for (int i = begin; i < end; i++) {
+        for (int j = i + 1; j < end; j++) {
+          testPair(mOrder[i], mOrder[j]);
+        }
+      }
+      const int64_t phiCell = cell / EtaCellStride;
+      const int64_t etaCell = cell % EtaCellStride;
+      compareCells(begin, end, phiCell * EtaCellStride + etaCell + 1);
+      if (nPhiCells > 1) {
+        const int64_t nextPhiCell = (phiCell + 1) % nPhiCells;
+        for (int64_t dEta = -1; dEta <= 1; dEta++) {
+          if (etaCell + dEta >= 0) {
+            compareCells(begin, end, nextPhiCell * EtaCellStride + etaCell + dEta);
+          }
+        }
+      }
+      begin = end;
+    }
+    return mPairs;
+  }
+
+ private:
+  static constexpr int64_t EtaCellStride = int64_t{1} << 32;
+
+  void testPair(int a, int b)
+  {
+    if (std::fabs(mEta[a] - mEta[b]) < mMaxDeltaEta && deltaPhi(mPhi[a], mPhi[b]) < mMaxDeltaPhi) {
+      mPairs.push_back({std::min(a, b), std::max(a, b)});
+    }
+  }
+
+  // compares the tracks of the sorted range [begin, end) with the tracks of the cell
+  void compareCells(int begin, int end, int64_t cell)
+  {
+    const auto range = std::equal_range(mSortedCell.begin(), mSortedCell.end(), cell);
+    for (auto it = range.first; it != range.second; ++it) {
+      const int j = mOrder[it - mSortedCell.begin()];
+      for (int i = begin; i < end; i++) {
+        testPair(mOrder[i], j);
+      }
+    }
+  }
+
+  float mMaxDeltaEta = 0.f;
+  float mMaxDeltaPhi = 0.f;
+  std::vector<float> mEta;
+  std::vector<float> mPhi;
+  std::vector<float> mPt;
+  std::vector<int64_t> mCell;
+  std::vector<int64_t> mSortedCell;
+  std::vector<int> mOrder;
+  std::vector<Pair> mPairs;
+};
+
+} // namespace o2::common::core
+
+#endif // COMMON_CORE_CLOSETRACKFINDER_H_
@@ -27,10 +27,12 @@
 
 #include <Rtypes.h>
 
+#include <algorithm>
+#include <atomic>
 #include <cmath>
 #include <cstdint>
 #include <cstdlib>
-#include <memory>
+#include <thread>
 #include <utility>
 #include <vector>
 
@@ -70,6 +72,7 @@ class CollisionAssociation
   void setFillTableOfCollIdsPerTrack(bool fill = true) { mFillTableOfCollIdsPerTrack = fill; }
   void setBcWindow(int bcWindow = 115) { mBcWindowForOneSigma = bcWindow; }
   void setMaxPvContributorsForLowMultReassoc(int pvContributorsMax) { mMaxPvContributorsForLowMultReassoc = pvContributorsMax; }
+  void setNumThreads(int nThreads = 1) { mNumThreads = nThreads; }
 
   template <typename TTracks, typename Slice, typename Assoc, typename RevIndices>
   void runStandardAssoc(o2::aod::Collisions const& collisions,
@@ -143,6 +146,7 @@ class CollisionAssociation
     std::vector<int64_t> globalBC;
     std::vector<int64_t> trackBCCache;
     std::vector<std::pair<typename TTracks::iterator, typename TTracks::iterator>> trackIterationWindows; // continous regions in which we can count on increasing globalBC numbers
+    std::vector<std::pair<int64_t, int64_t>> trackWindowIndices;                                         // first and last + 1 filtered index of each iteration window
     globalBC.reserve(tracks.size());
     trackBCCache.reserve(tracks.size());
     auto trackBegin = tracks.begin();
@@ -151,7 +155,9 @@ class CollisionAssociation
       lastCollisionId = trackBegin.collisionId();
     }
     auto track = trackBegin;
-    for (; track != tracks.end(); ++track) {
+    int64_t trackIndex = 0;
+    int64_t trackBeginIndex = 0;
+    for (; track != tracks.end(); ++track, ++trackIndex) {
       int64_t trackBC = -1;
       if (track.has_collision()) {
         trackBC = track.collision().bc().globalBC();
@@ -185,8 +191,10 @@ class CollisionAssociation
         if (lastCollisionId >= 0 || mIncludeUnassigned) {
           LOGP(debug, "Found track block from {} to {}, current id {}, last id {}", trackBegin.filteredIndex(), track.filteredIndex() - 1, track.collisionId(), lastCollisionId);
           trackIterationWindows.push_back(std::make_pair(trackBegin, track));
+          trackWindowIndices.push_back(std::make_pair(trackBeginIndex, trackIndex));
         }
         trackBegin = track;
+        trackBeginIndex = trackIndex;
       }
       lastCollisionId = track.collisionId();
     }
@@ -194,122 +202,220 @@ class CollisionAssociation
     if (lastCollisionId >= 0 || mIncludeUnassigned) {
       LOGP(debug, "Found track block from {} to {}", trackBegin.filteredIndex(), tracks.size() - 1);
       trackIterationWindows.push_back(std::make_pair(trackBegin, track));
+      trackWindowIndices.push_back(std::make_pair(trackBeginIndex, trackIndex));
     }
 
-    // define vector of vectors to store indices of compatible collisions per track
-    std::vector<std::unique_ptr<std::vector<int>>> collsPerTrack(tracksUnfiltered.size());
-
     // loop over collisions to find time-compatible tracks
+    // the compatible (collision, track) pairs are collected in the order of the sequential loop over collisions
     int64_t bcOffsetMax = mBcWindowForOneSigma * mNumSigmaForTimeCompat + mTimeMargin / o2::constants::lhc::LHCBunchSpacingNS;
-    for (const auto& collision : collisions) {
-      const float collTime = collision.collisionTime();
-      const float collTimeRes2 = collision.collisionTimeRes() * collision.collisionTimeRes();
-      uint64_t collBC = collision.bc().globalBC();
+    std::vector<std::pair<int, int>> compatiblePairs;
+    if (mNumThreads <= 1) {
+      for (const auto& collision : collisions) {
+        findTimeCompatibleTracks<TTracks>(collision, trackIterationWindows, globalBC, trackBCCache, bcOffsetMax, compatiblePairs);
+      }
+    } else {
+      runTimeSlabs<TTracks>(collisions, trackIterationWindows, trackWindowIndices, globalBC, trackBCCache, bcOffsetMax, compatiblePairs);
+    }
+    for (const auto& [collIdx, trackIdx] : compatiblePairs) {
+      association(collIdx, trackIdx);
+    }
 
-      // This is done per block to allow optimization below. Within each block the globalBC increase continously
-      for (auto& iterationWindow : trackIterationWindows) { // o2-linter: disable=const-ref-in-for-loop (iterationWindow is modified)
-        bool iteratorMoved = false;
-        const bool isAssignedTrackWindow = (iterationWindow.first != iterationWindow.second) ? iterationWindow.first.has_collision() : false;
-        for (auto trackInWindow = iterationWindow.first; trackInWindow != iterationWindow.second; ++trackInWindow) {
-          int64_t trackBC = globalBC[trackInWindow.filteredIndex()];
-          if (trackBC < 0) {
-            continue;
-          }
+    // create reverse index track to collisions if enabled
+    if (mFillTableOfCollIdsPerTrack) {
+      // compatible collisions per track in CSR layout: the collisions of track i are collIdsFlat[collIdsOffsets[i]] to collIdsFlat[collIdsOffsets[i + 1] - 1]
+      std::vector<int> collIdsOffsets(tracksUnfiltered.size() + 1, 0);
+      for (const auto& pair : compatiblePairs) {
+        collIdsOffsets[pair.second + 1]++;
+      }
+      for (int64_t iTrack = 0; iTrack < tracksUnfiltered.size(); iTrack++) {
+        collIdsOffsets[iTrack + 1] += collIdsOffsets[iTrack];
+      }
+      std::vector<int> collIdsFlat(compatiblePairs.size());
+      std::vector<int> fillPosition(collIdsOffsets.begin(), collIdsOffsets.end() - 1);
+      for (const auto& [collIdx, trackIdx] : compatiblePairs) {
+        collIdsFlat[fillPosition[trackIdx]++] = collIdx;
+      }
+      std::vector<int> collIds{};
+      for (const auto& trackUnfiltered : tracksUnfiltered) {
+        const auto trackId = trackUnfiltered.globalIndex();
+        collIds.assign(collIdsFlat.begin() + collIdsOffsets[trackId], collIdsFlat.begin() + collIdsOffsets[trackId + 1]);
+        reverseIndices(collIds);
+      }
+    }
+  }
 
-          // Optimization to avoid looping over the full track list each time. This builds on that tracks are sorted by BCs (which they should be because collisions are sorted by BCs)
-          const int64_t bcOffset = trackBC - static_cast<int64_t>(collBC);
-          if constexpr (isCentralBarrel) {
-            // only for blocks with collision association
-            if (isAssignedTrackWindow) {
-              constexpr int margin = 200;
-              if (!iteratorMoved && bcOffset > -bcOffsetMax - margin) {
-                iterationWindow.first.setCursor(trackInWindow.filteredIndex());
-                iteratorMoved = true;
-                LOGP(debug, "Moving iterator begin {}", trackInWindow.filteredIndex());
-              } else if (bcOffset > bcOffsetMax + margin) {
-                LOGP(debug, "Stopping iterator {}", trackInWindow.filteredIndex());
-                break;
-              }
+ private:
+  static constexpr int IterationMarginBc = 200;    // BC margin used to move the begin of the track iteration windows
+  static constexpr int CollisionsPerTimeSlab = 32; // number of consecutive collisions processed together in the multi-threaded association
+
+  // Find the tracks which are time-compatible with one collision and append the (collision, track) pairs
+  // The begin of the track iteration windows with collision association is moved forward along the collisions
+  template <typename TTracks, typename TCollision, typename TWindows>
+  void findTimeCompatibleTracks(TCollision const& collision,
+                                TWindows& trackIterationWindows,
+                                std::vector<int64_t> const& globalBC,
+                                std::vector<int64_t> const& trackBCCache,
+                                int64_t bcOffsetMax,
+                                std::vector<std::pair<int, int>>& compatiblePairs) const
+  {
+    const float collTime = collision.collisionTime();
+    const float collTimeRes2 = collision.collisionTimeRes() * collision.collisionTimeRes();
+    uint64_t collBC = collision.bc().globalBC();
+
+    // This is done per block to allow optimization below. Within each block the globalBC increase continously
+    for (auto& iterationWindow : trackIterationWindows) { // o2-linter: disable=const-ref-in-for-loop (iterationWindow is modified)
+      bool iteratorMoved = false;
+      const bool isAssignedTrackWindow = (iterationWindow.first != iterationWindow.second) ? iterationWindow.first.has_collision() : false;
+      for (auto trackInWindow = iterationWindow.first; trackInWindow != iterationWindow.second; ++trackInWindow) {
+        int64_t trackBC = globalBC[trackInWindow.filteredIndex()];
+        if (trackBC < 0) {
+          continue;
+        }
+
+        // Optimization to avoid looping over the full track list each time. This builds on that tracks are sorted by BCs (which they should be because collisions are sorted by BCs)
+        const int64_t bcOffset = trackBC - static_cast<int64_t>(collBC);
+        if constexpr (isCentralBarrel) {
+          // only for blocks with collision association
+          if (isAssignedTrackWindow) {
+            if (!iteratorMoved && bcOffset > -bcOffsetMax - IterationMarginBc) {
+              iterationWindow.first.setCursor(trackInWindow.filteredIndex());
+              iteratorMoved = true;
+              LOGP(debug, "Moving iterator begin {}", trackInWindow.filteredIndex());
+            } else if (bcOffset > bcOffsetMax + IterationMarginBc) {
+              LOGP(debug, "Stopping iterator {}", trackInWindow.filteredIndex());
+              break;
             }
           }
+        }
 
-          int64_t bcOffsetWindow = trackBCCache[trackInWindow.filteredIndex()] - static_cast<int64_t>(collBC);
-          if (std::abs(bcOffsetWindow) > bcOffsetMax) {
-            continue;
-          }
+        int64_t bcOffsetWindow = trackBCCache[trackInWindow.filteredIndex()] - static_cast<int64_t>(collBC);
+        if (std::abs(bcOffsetWindow) > bcOffsetMax) {
+          continue;
+        }
 
-          float trackTime = 0;
-          float trackTimeRes = 0;
-          if constexpr (isCentralBarrel) {
-            if ((mUsePvAssociation == o2::aod::track_association::PVContrReassocOpt::OnlySameBc && trackInWindow.isPVContributor()) || (mUsePvAssociation == o2::aod::track_association::PVContrReassocOpt::SameBcAndLowMult && trackInWindow.isPVContributor() && trackInWindow.collision().numContrib() > mMaxPvContributorsForLowMultReassoc)) {
-              trackTime = trackInWindow.collision().collisionTime(); // if PV contributor, we assume the time to be the one of the collision
-              trackTimeRes = o2::constants::lhc::LHCBunchSpacingNS;  // 1 BC
-            } else {
-              trackTime = trackInWindow.trackTime();
-              trackTimeRes = trackInWindow.trackTimeRes();
-            }
+        float trackTime = 0;
+        float trackTimeRes = 0;
+        if constexpr (isCentralBarrel) {
+          if ((mUsePvAssociation == o2::aod::track_association::PVContrReassocOpt::OnlySameBc && trackInWindow.isPVContributor()) || (mUsePvAssociation == o2::aod::track_association::PVContrReassocOpt::SameBcAndLowMult && trackInWindow.isPVContributor() && trackInWindow.collision().numContrib() > mMaxPvContributorsForLowMultReassoc)) {
+            trackTime = trackInWindow.collision().collisionTime(); // if PV contributor, we assume the time to be the one of the collision
+            trackTimeRes = o2::constants::lhc::LHCBunchSpacingNS;  // 1 BC
           } else {
             trackTime = trackInWindow.trackTime();
             trackTimeRes = trackInWindow.trackTimeRes();
           }
+        } else {
+          trackTime = trackInWindow.trackTime();
+          trackTimeRes = trackInWindow.trackTimeRes();
+        }
 
-          const float deltaTime = trackTime - collTime + bcOffset * o2::constants::lhc::LHCBunchSpacingNS;
-          float sigmaTimeRes2 = collTimeRes2 + trackTimeRes * trackTimeRes;
-          LOGP(debug, "collision time={}, collision time res={}, track time={}, track time res={}, bc collision={}, bc track={}, delta time={}", collTime, collision.collisionTimeRes(), trackInWindow.trackTime(), trackInWindow.trackTimeRes(), collBC, trackBC, deltaTime);
+        const float deltaTime = trackTime - collTime + bcOffset * o2::constants::lhc::LHCBunchSpacingNS;
+        float sigmaTimeRes2 = collTimeRes2 + trackTimeRes * trackTimeRes;
+        LOGP(debug, "collision time={}, collision time res={}, track time={}, track time res={}, bc collision={}, bc track={}, delta time={}", collTime, collision.collisionTimeRes(), trackInWindow.trackTime(), trackInWindow.trackTimeRes(), collBC, trackBC, deltaTime);
 
-          float thresholdTime = 0.;
-          if constexpr (isCentralBarrel) {
-            if ((mUsePvAssociation == o2::aod::track_association::PVContrReassocOpt::OnlySameBc && trackInWindow.isPVContributor()) || (mUsePvAssociation == o2::aod::track_association::PVContrReassocOpt::SameBcAndLowMult && trackInWindow.isPVContributor() && trackInWindow.collision().numContrib() > mMaxPvContributorsForLowMultReassoc)) {
-              thresholdTime = trackTimeRes;
-            } else if (TESTBIT(trackInWindow.flags(), o2::aod::track::TrackTimeResIsRange)) {
-              // the track time resolution is a range, not a gaussian resolution
-              thresholdTime = trackTimeRes + mNumSigmaForTimeCompat * std::sqrt(collTimeRes2) + mTimeMargin;
-            } else {
-              thresholdTime = mNumSigmaForTimeCompat * std::sqrt(sigmaTimeRes2) + mTimeMargin;
-            }
+        float thresholdTime = 0.;
+        if constexpr (isCentralBarrel) {
+          if ((mUsePvAssociation == o2::aod::track_association::PVContrReassocOpt::OnlySameBc && trackInWindow.isPVContributor()) || (mUsePvAssociation == o2::aod::track_association::PVContrReassocOpt::SameBcAndLowMult && trackInWindow.isPVContributor() && trackInWindow.collision().numContrib() > mMaxPvContributorsForLowMultReassoc)) {
+            thresholdTime = trackTimeRes;
+          } else if (TESTBIT(trackInWindow.flags(), o2::aod::track::TrackTimeResIsRange)) {
+            // the track time resolution is a range, not a gaussian resolution
+            thresholdTime = trackTimeRes + mNumSigmaForTimeCompat * std::sqrt(collTimeRes2) + mTimeMargin;
           } else {
-            // the track is not a central track
-            if constexpr (TTracks::template contains<o2::aod::MFTTracks>()) {
-              // then the track is an MFT track, or an MFT track with additionnal joined info
-              // in this case TrackTimeResIsRange
-              thresholdTime = trackTimeRes + mNumSigmaForTimeCompat * std::sqrt(collTimeRes2) + mTimeMargin;
-            } else if constexpr (TTracks::template contains<o2::aod::FwdTracks>()) {
-              // the track is a fwd track, with a gaussian time resolution
-              thresholdTime = mNumSigmaForTimeCompat * std::sqrt(sigmaTimeRes2) + mTimeMargin;
-            }
+            thresholdTime = mNumSigmaForTimeCompat * std::sqrt(sigmaTimeRes2) + mTimeMargin;
+          }
+        } else {
+          // the track is not a central track
+          if constexpr (TTracks::template contains<o2::aod::MFTTracks>()) {
+            // then the track is an MFT track, or an MFT track with additionnal joined info
+            // in this case TrackTimeResIsRange
+            thresholdTime = trackTimeRes + mNumSigmaForTimeCompat * std::sqrt(collTimeRes2) + mTimeMargin;
+          } else if constexpr (TTracks::template contains<o2::aod::FwdTracks>()) {
+            // the track is a fwd track, with a gaussian time resolution
+            thresholdTime = mNumSigmaForTimeCompat * std::sqrt(sigmaTimeRes2) + mTimeMargin;
           }
+        }
 
-          if (std::abs(deltaTime) < thresholdTime) {
-            const auto collIdx = collision.globalIndex();
-            const auto trackIdx = trackInWindow.globalIndex();
-            LOGP(debug, "Filling track id {} for coll id {}", trackIdx, collIdx);
-            association(collIdx, trackIdx);
-            if (mFillTableOfCollIdsPerTrack) {
-              if (collsPerTrack[trackIdx] == nullptr) {
-                collsPerTrack[trackIdx] = std::make_unique<std::vector<int>>();
+        if (std::abs(deltaTime) < thresholdTime) {
+          const auto collIdx = collision.globalIndex();
+          const auto trackIdx = trackInWindow.globalIndex();
+          LOGP(debug, "Filling track id {} for coll id {}", trackIdx, collIdx);
+          compatiblePairs.emplace_back(collIdx, trackIdx);
+        }
+      }
+    }
+  }
+
+  // Split the collisions in slabs of consecutive collisions, processed in parallel with mNumThreads threads
+  // Each slab starts with its own copy of the track iteration windows, whose begin is placed where the sequential loop
+  // would have left it after the previous collision, assuming the tracks of these windows are sorted by BC
+  // The pairs are merged in the slab order, so the output does not depend on the number of threads
+  template <typename TTracks, typename TWindows>
+  void runTimeSlabs(o2::aod::Collisions const& collisions,
+                    TWindows const& trackIterationWindows,
+                    std::vector<std::pair<int64_t, int64_t>> const& trackWindowIndices,
+                    std::vector<int64_t> const& globalBC,
+                    std::vector<int64_t> const& trackBCCache,
+                    int64_t bcOffsetMax,
+                    std::vector<std::pair<int, int>>& compatiblePairs) const
+  {
+    const int64_t nCollisions = collisions.size();
+    std::vector<int64_t> collisionBCs(nCollisions);
+    for (const auto& collision : collisions) {
+      collisionBCs[collision.globalIndex()] = collision.bc().globalBC();
+    }
+    const int64_t nSlabs = (nCollisions + CollisionsPerTimeSlab - 1) / CollisionsPerTimeSlab;
+    std::vector<std::vector<std::pair<int, int>>> slabPairs(nSlabs);
+    std::atomic<int64_t> nextSlab{0};
+    auto worker = [&]() {
+      for (int64_t slab = nextSlab++; slab < nSlabs; slab = nextSlab++) {
+        const int64_t firstCollision = slab * CollisionsPerTimeSlab;
+        const int64_t lastCollision = std::min(nCollisions, firstCollision + CollisionsPerTimeSlab);
+        auto slabWindows = trackIterationWindows;
+        if constexpr (isCentralBarrel) {
+          if (firstCollision > 0) {
+            const int64_t previousBC = collisionBCs[firstCollision - 1];
+            for (size_t iWindow = 0; iWindow < slabWindows.size(); iWindow++) {
+              auto& iterationWindow = slabWindows[iWindow];
+              const bool isAssignedTrackWindow = (iterationWindow.first != iterationWindow.second) ? iterationWindow.first.has_collision() : false;
+              if (!isAssignedTrackWindow) {
+                continue;
+              }
+              const auto windowBegin = globalBC.begin() + trackWindowIndices[iWindow].first;
+              const auto windowEnd = globalBC.begin() + trackWindowIndices[iWindow].second;
+              const auto cursor = std::partition_point(windowBegin, windowEnd, [&](int64_t trackBC) { return trackBC - previousBC <= -bcOffsetMax - IterationMarginBc; });
+              if (cursor == windowEnd) {
+                iterationWindow.first = iterationWindow.second;
+              } else {
+                iterationWindow.first.setCursor(cursor - globalBC.begin());
               }
-              collsPerTrack[trackIdx].get()->push_back(collIdx);
             }
           }
         }
+        for (int64_t iCollision = firstCollision; iCollision < lastCollision; iCollision++) {
+          findTimeCompatibleTracks<TTracks>(collisions.rawIteratorAt(iCollision), slabWindows, globalBC, trackBCCache, bcOffsetMax, slabPairs[slab]);
+        }
       }
+    };
+
+    const int nWorkers = std::min<int64_t>(mNumThreads, nSlabs);
+    std::vector<std::thread> threads;
+    for (int iWorker = 1; iWorker < nWorkers; iWorker++) {
+      threads.emplace_back(worker);
+    }
+    worker(); // the calling thread takes part as well
+    for (auto& thread : threads) {
+      thread.join();
     }
-    // create reverse index track to collisions if enabled
-    if (mFillTableOfCollIdsPerTrack) {
-      std::vector<int> empty{};
-      for (const auto& trackUnfiltered : tracksUnfiltered) {
 
-        const auto trackId = trackUnfiltered.globalIndex();
-        if (collsPerTrack[trackId] == nullptr) {
-          reverseIndices(empty);
-        } else {
-          reverseIndices(*collsPerTrack[trackId].get());
-        }
-      }
+    size_t nPairs = 0;
+    for (const auto& pairs : slabPairs) {
+      nPairs += pairs.size();
+    }
+    compatiblePairs.reserve(nPairs);
+    for (const auto& pairs : slabPairs) {
+      compatiblePairs.insert(compatiblePairs.end(), pairs.begin(), pairs.end());
     }
   }
 
- private:
   float mNumSigmaForTimeCompat{4.};                                                  // number of sigma for time compatibility
   float mTimeMargin{500.};                                                           // additional time margin in ns
   int mTrackSelection{o2::aod::track_association::TrackSelection::GlobalTrackWoDCA}; // track selection for central barrel tracks (standard association only)
@@ -318,6 +424,7 @@ class CollisionAssociation
   bool mIncludeUnassigned{true};                                                     // include tracks that were originally not assigned to any collision
   bool mFillTableOfCollIdsPerTrack{false};                                           // fill additional table with vectors of compatible collisions per track
   int mBcWindowForOneSigma{115};                                                     // BC window to be multiplied by the number of sigmas to define maximum window to be considered
+  int mNumThreads{1};                                                                // number of threads for the time-compatible association (1: sequential loop over collisions)
 };
 
 #endif // COMMON_CORE_COLLISIONASSOCIATION_H_
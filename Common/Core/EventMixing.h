@@ -12,6 +12,12 @@
 #ifndef COMMON_CORE_EVENTMIXING_H_
 #define COMMON_CORE_EVENTMIXING_H_
 
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <span>
+#include <vector>
+
 namespace eventmixing
 {
 /// Calculate hash for an element based on 2 properties and their bins.
@@ -26,25 +32,177 @@ template <typename T1, typename T2>
 static int getMixingBin(const T1& vtxBins, const T1& multBins, const T2& vtx, const T2& mult)
 {
   // underflow
-  if (vtx < vtxBins.at(0)) {
+  if (vtxBins.empty() || vtx < vtxBins[0]) {
     return -1;
   }
-  if (mult < multBins.at(0)) {
+  if (multBins.empty() || mult < multBins[0]) {
     return -1;
   }
 
-  for (unsigned int i = 1; i < vtxBins.size(); i++) {
-    if (vtx < vtxBins.at(i)) {
-      for (unsigned int j = 1; j < multBins.size(); j++) {
-        if (mult < multBins.at(j)) {
-          return i + j * (vtxBins.size() + 1);
+  // index of the first bin edge above the value
+  auto i = std::upper_bound(vtxBins.begin(), vtxBins.end(), vtx) - vtxBins.begin();
+  auto j = std::upper_bound(multBins.begin(), multBins.end(), mult) - multBins.begin();
+  // overflow
+  if (i == static_cast<decltype(i)>(vtxBins.size()) || j == static_cast<decltype(j)>(multBins.size())) {
+    return -1;
+  }
+  return i + j * (vtxBins.size() + 1);
+}
+
+/// \class MixingBinner
+/// Flat bin index of a collision in an N-dimensional mixing binning (e.g. z-vertex, multiplicity, centrality, event-plane angle).
+/// Each axis is defined by its bin edges; the bin of an equidistant axis is found with one multiplication,
+/// otherwise a binary search over the edges is used. The flat index is bin0 + n0 * (bin1 + n1 * (bin2 + ...)),
+/// and -1 is returned if the value on any axis is outside of the binning.
+class MixingBinner
+{
+ public:
+  /// Add an axis defined by its bin edges, which must be sorted in increasing order
+  /// \param edges Bin edges, nBins + 1 values
+  void addAxis(const std::vector<float>& edges)
+  {
+    Axis axis;
+    axis.edges = edges;
+    axis.nBins = edges.size() > 1 ? edges.size() - 1 : 0;
+    if (axis.nBins > 0) {
+      axis.min = edges.front();
+      axis.max = edges.back();
+      float width = (edges.back() - edges.front()) / axis.nBins;
+      axis.isUniform = width > 0.f;
+      for (int i = 1; i <= axis.nBins && axis.isUniform; i++) {
+        axis.isUniform = std::abs(edges[i] - (axis.min + i * width)) <= 1.e-5f * std::abs(width) * axis.nBins;
+      }
+      axis.invWidth = axis.isUniform ? 1.f / width : 0.f;
+    }
+    axis.stride = mNBins;
+    mNBins *= axis.nBins;
+    mAxes.push_back(axis);
+  }
+  /// Add an axis with nBins equidistant bins between min and max
+  void addAxis(int nBins, float min, float max)
+  {
+    std::vector<float> edges(nBins + 1);
+    for (int i = 0; i <= nBins; i++) {
+      edges[i] = min + i * (max - min) / nBins;
+    }
+    addAxis(edges);
+  }
+
+  /// \return Number of axes
+  int getNAxes() const { return mAxes.size(); }
+  /// \return Total number of bins, i.e. the upper limit of the flat bin index
+  int getNBins() const { return mAxes.empty() ? 0 : mNBins; }
+
+  /// Bin index along one axis
+  /// \param iAxis Index of the axis
+  /// \param value Value along that axis
+  /// \return Bin index, or -1 if outside of the axis range
+  int getAxisBin(int iAxis, float value) const
+  {
+    const Axis& axis = mAxes[iAxis];
+    if (!(value >= axis.min && value < axis.max)) { // also rejects NaN
+      return -1;
+    }
+    int bin;
+    if (axis.isUniform) {
+      bin = static_cast<int>((value - axis.min) * axis.invWidth);
+      // correct for the rounding close to the bin edges, such that the result is the same as with the binary search
+      if (bin >= axis.nBins || value < axis.edges[bin]) {
+        bin--;
+      } else if (value >= axis.edges[bin + 1]) {
+        bin++;
+      }
+    } else {
+      bin = std::upper_bound(axis.edges.begin(), axis.edges.end(), value) - axis.edges.begin() - 1;
+    }
+    return bin;
+  }
+
+  /// Flat bin index for one collision
+  /// \param values Values along each axis, in the order in which the axes were added
+  /// \return Flat bin index, or -1 if outside of the binning
+  template <typename... Ts>
+  int getBin(Ts... values) const
+  {
+    const float v[] = {static_cast<float>(values)...};
+    return getBin(std::span<const float>(v, sizeof...(Ts)));
+  }
+  int getBin(std::span<const float> values) const
+  {
+    if (mAxes.empty() || values.size() != mAxes.size()) {
+      return -1;
+    }
+    int index = 0;
+    for (std::size_t i = 0; i < mAxes.size(); i++) {
+      int bin = getAxisBin(i, values[i]);
+      if (bin < 0) {
+        return -1;
+      }
+      index += bin * mAxes[i].stride;
+    }
+    return index;
+  }
+
+  /// Flat bin index for a set of collisions given as columns, one per axis
+  /// \param columns Values of all collisions for each axis, in the order in which the axes were added
+  /// \param bins Output flat bin indices, of the same size as the columns
+  void getBins(std::span<const std::span<const float>> columns, std::span<int> bins) const
+  {
+    if (mAxes.empty() || columns.size() != mAxes.size()) {
+      std::fill(bins.begin(), bins.end(), -1);
+      return;
+    }
+    std::fill(bins.begin(), bins.end(), 0);
+    // process one axis at a time over all the collisions, such that each axis setup is used for the full column
+    for (std::size_t i = 0; i < mAxes.size(); i++) {
+      for (std::size_t iCol = 0; iCol < bins.size(); iCol++) {
+        if (bins[iCol] < 0) {
+          continue;
         }
+        int bin = getAxisBin(i, columns[i][iCol]);
+        bins[iCol] = bin < 0 ? -1 : bins[iCol] + bin * mAxes[i].stride;
       }
     }
   }
-  // overflow
-  return -1;
-}
+
+  /// Flat bin index for all the collisions of a table
+  /// \param collisions Table of collisions
+  /// \param getters One callable per axis, returning the value of a collision along that axis (e.g. [](auto const& col) { return col.posZ(); })
+  /// \return Flat bin indices, one per collision, in table order
+  template <typename TCollisions, typename... TGetters>
+  std::vector<int> getCollisionBins(TCollisions const& collisions, TGetters const&... getters) const
+  {
+    constexpr std::size_t NAxes = sizeof...(TGetters);
+    std::vector<float> values(NAxes * collisions.size());
+    std::size_t iCol = 0;
+    std::size_t nCols = collisions.size();
+    for (auto const& collision : collisions) {
+      std::size_t iAxis = 0;
+      ((values[iAxis++ * nCols + iCol] = static_cast<float>(getters(collision))), ...);
+      iCol++;
+    }
+    std::vector<std::span<const float>> columns;
+    for (std::size_t iAxis = 0; iAxis < NAxes; iAxis++) {
+      columns.emplace_back(values.data() + iAxis * nCols, nCols);
+    }
+    std::vector<int> bins(nCols);
+    getBins(columns, bins);
+    return bins;
+  }
+
+ private:
+  struct Axis {
+    std::vector<float> edges;
+    int nBins = 0;
+    int stride = 1;         // factor of this axis bin in the flat index
+    bool isUniform = false; // equidistant bins
+    float min = 0.f;        // lower edge of the first bin
+    float max = 0.f;        // upper edge of the last bin
+    float invWidth = 0.f;   // inverse of the bin width, for equidistant bins
+  };
+  std::vector<Axis> mAxes;
+  int mNBins = 1;
+};
 }; // namespace eventmixing
 
 #endif // COMMON_CORE_EVENTMIXING_H_
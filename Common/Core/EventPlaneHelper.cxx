@@ -30,6 +30,7 @@
 
 #include <algorithm>
 #include <cmath>
+#include <cstddef>
 #include <cstdio>
 #include <iterator>
 #include <memory>
@@ -107,6 +108,55 @@ void EventPlaneHelper::SumQvectors(int det, int chno, float ampl, int nmod, TCom
   sum += ampl;
 }
 
+void EventPlaneHelper::SetChannelHarmonics(const std::vector<int>& nmods, const o2::ft0::Geometry& ft0geom, o2::fv0::Geometry* fv0geom)
+{
+  /* Fill the tables of cos(n*phi) and sin(n*phi) of all the channels for each of the
+    provided harmonics, with the offsets currently set. */
+  mHarmonics = nmods;
+  mCosPhiFT0.assign(nmods.size(), std::vector<double>(NChannelsFT0));
+  mSinPhiFT0.assign(nmods.size(), std::vector<double>(NChannelsFT0));
+  mCosPhiFV0.assign(nmods.size(), std::vector<double>(NChannelsFV0));
+  mSinPhiFV0.assign(nmods.size(), std::vector<double>(NChannelsFV0));
+
+  for (std::size_t i = 0; i < nmods.size(); i++) {
+    const int nmod = nmods[i];
+    for (int iCh = 0; iCh < NChannelsFT0; iCh++) {
+      const double phi = GetPhiFT0(iCh, ft0geom);
+      mCosPhiFT0[i][iCh] = TMath::Cos(phi * nmod);
+      mSinPhiFT0[i][iCh] = TMath::Sin(phi * nmod);
+    }
+    for (int iCh = 0; iCh < NChannelsFV0; iCh++) {
+      const double phi = GetPhiFV0(iCh, fv0geom);
+      mCosPhiFV0[i][iCh] = TMath::Cos(phi * nmod);
+      mSinPhiFV0[i][iCh] = TMath::Sin(phi * nmod);
+    }
+  }
+}
+
+int EventPlaneHelper::GetHarmonicIndex(int nmod) const
+{
+  auto it = std::find(mHarmonics.begin(), mHarmonics.end(), nmod);
+  return it == mHarmonics.end() ? -1 : static_cast<int>(std::distance(mHarmonics.begin(), it));
+}
+
+void EventPlaneHelper::SumQvectorsFromTable(int det, int chno, float ampl, int imod, TComplex& Qvec, float& sum) const
+{
+  /* Add the complex Q-vector of the provided detector and channel number to the total
+    Q-vector given as argument, using the tables filled by SetChannelHarmonics. */
+  switch (det) {
+    case 0: // FT0.
+      Qvec += TComplex(ampl * mCosPhiFT0[imod][chno], ampl * mSinPhiFT0[imod][chno]);
+      break;
+    case 1: // FV0.
+      Qvec += TComplex(ampl * mCosPhiFV0[imod][chno], ampl * mSinPhiFV0[imod][chno]);
+      break;
+    default:
+      printf("'int det' value does not correspond to any accepted case.\n");
+      return;
+  }
+  sum += ampl;
+}
+
 int EventPlaneHelper::GetCentBin(float cent)
 {
   const float centClasses[] = {0., 5., 10., 20., 30., 40., 50., 60., 80.};
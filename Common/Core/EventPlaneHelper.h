@@ -67,6 +67,22 @@ class EventPlaneHelper
   // the detector and amplitude.
   void SumQvectors(int det, int chno, float ampl, int nmod, TComplex& Qvec, float& sum, const o2::ft0::Geometry& ft0geom, o2::fv0::Geometry* fv0geom);
 
+  // Method to compute once cos(n*phi) and sin(n*phi) of all the FT0 and FV0 channels for
+  // the harmonics nmods. It must be called again when the offsets change (e.g. new run).
+  void SetChannelHarmonics(const std::vector<int>& nmods, const o2::ft0::Geometry& ft0geom, o2::fv0::Geometry* fv0geom);
+
+  // Index of the harmonic nmod in the ones given to SetChannelHarmonics, -1 if not there.
+  int GetHarmonicIndex(int nmod) const;
+
+  // Tables of cos(n*phi) and sin(n*phi) per channel for the harmonic of index imod.
+  const std::vector<double>& GetCosPhiFT0(int imod) const { return mCosPhiFT0[imod]; }
+  const std::vector<double>& GetSinPhiFT0(int imod) const { return mSinPhiFT0[imod]; }
+  const std::vector<double>& GetCosPhiFV0(int imod) const { return mCosPhiFV0[imod]; }
+  const std::vector<double>& GetSinPhiFV0(int imod) const { return mSinPhiFV0[imod]; }
+
+  // Same as SumQvectors, with the harmonic of index imod taken from the channel tables.
+  void SumQvectorsFromTable(int det, int chno, float ampl, int imod, TComplex& Qvec, float& sum) const;
+
   // Method to get the bin corresponding to a centrality percentile, according to the
   // centClasses[] array defined in Tasks/qVectorsQA.cxx.
   // Note: Any change in one task should be reflected in the other.
@@ -107,7 +123,16 @@ class EventPlaneHelper
   double mOffsetFV0rightX = 0.; // X-coordinate of the offset of FV0-A right.
   double mOffsetFV0rightY = 0.; // Y-coordinate of the offset of FV0-A right.
 
-  ClassDefNV(EventPlaneHelper, 2)
+  static constexpr int NChannelsFT0 = 208; // Number of channels of FT0-A and FT0-C.
+  static constexpr int NChannelsFV0 = 48;  // Number of channels of FV0-A.
+
+  std::vector<int> mHarmonics;                 //! Harmonics of the channel tables.
+  std::vector<std::vector<double>> mCosPhiFT0; //! cos(n*phi) of the FT0 channels, [harmonic][channel].
+  std::vector<std::vector<double>> mSinPhiFT0; //! sin(n*phi) of the FT0 channels, [harmonic][channel].
+  std::vector<std::vector<double>> mCosPhiFV0; //! cos(n*phi) of the FV0 channels, [harmonic][channel].
+  std::vector<std::vector<double>> mSinPhiFV0; //! sin(n*phi) of the FV0 channels, [harmonic][channel].
+
+  ClassDefNV(EventPlaneHelper, 3)
 };
 
 #endif // COMMON_CORE_EVENTPLANEHELPER_H_
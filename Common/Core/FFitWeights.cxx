@@ -30,8 +30,11 @@
 #include <Rtypes.h>
 #include <RtypesCore.h>
 
+#include <algorithm>
+#include <cstddef>
 #include <cstdio>
 #include <string>
+#include <utility>
 #include <vector>
 
 ClassImp(FFitWeights)
@@ -130,6 +133,7 @@ Long64_t FFitWeights::Merge(TCollection* collist)
     fW_data->SetName("FFitWeights_Data");
     fW_data->SetOwner(kTRUE);
   }
+  clearSplineHandles();
   FFitWeights* lW = 0;
   TIter allW(collist);
   while ((lW = (reinterpret_cast<FFitWeights*>(allW())))) {
@@ -173,6 +177,7 @@ void FFitWeights::mptSel()
     return;
   }
 
+  clearSplineHandles();
   TH1D* tmp{nullptr};
   TGraph* tmpgr{nullptr};
   for (int iSP{0}; iSP < NumberSp; iSP++) {
@@ -196,6 +201,7 @@ void FFitWeights::qSelection(const std::vector<int>& nhv, const std::vector<std:
   if (!tar)
     return;
 
+  clearSplineHandles();
   for (const auto& pf : stv) {
     for (const auto& nh : nhv) {
       TH2D* th2{reinterpret_cast<TH2D*>(tar->FindObject(this->getQName(nh, pf.c_str())))};
@@ -221,25 +227,72 @@ void FFitWeights::qSelection(const std::vector<int>& nhv, const std::vector<std:
     }
   }
 };
-float FFitWeights::internalEval(float centr, const float& val, const char* name)
+int FFitWeights::resolveSplines(const char* name)
 {
   if (!fW_data) {
     return -1;
   }
+  const std::string pattern{name};
+  for (std::size_t i{0}; i < fSplineNames.size(); i++) {
+    if (fSplineNames[i] == pattern) {
+      return static_cast<int>(i);
+    }
+  }
+
+  std::vector<SplineTable> tables(NumberSp + 1);
+  for (int isp{0}; isp <= NumberSp; isp++) {
+    auto* graph = dynamic_cast<TGraph*>(fW_data->FindObject(Form(pattern.c_str(), isp)));
+    tables[isp].graph = graph;
+    tables[isp].isSorted = graph && std::is_sorted(graph->GetX(), graph->GetX() + graph->GetN());
+  }
+  fSplineNames.push_back(pattern);
+  fSplines.push_back(std::move(tables));
+  return static_cast<int>(fSplines.size()) - 1;
+}
+
+double FFitWeights::evalSpline(const SplineTable& table, double x)
+{
+  const TGraph* graph = table.graph;
+  const int n = graph->GetN();
+  const double* xs = graph->GetX();
+  const double* ys = graph->GetY();
+  // outside the points (or unsorted points) the extrapolation of TGraph::Eval is kept as is
+  if (!table.isSorted || n < 2 || !(x >= xs[0] && x <= xs[n - 1])) {
+    return graph->Eval(x);
+  }
+  // same linear interpolation as TGraph::Eval, between the first points of the abscissa just below and above x
+  const int up = std::lower_bound(xs, xs + n, x) - xs;
+  if (xs[up] == x) {
+    return ys[up];
+  }
+  const int low = std::lower_bound(xs, xs + up, xs[up - 1]) - xs;
+  return ys[up] + (x - xs[up]) * (ys[low] - ys[up]) / (xs[low] - xs[up]);
+}
+
+float FFitWeights::evalHandle(int handle, float centr, const float& val)
+{
+  if (!fW_data || handle < 0 || handle >= static_cast<int>(fSplines.size())) {
+    return -1;
+  }
   int isp = static_cast<int>(centr);
   if (isp < 0 || isp > NumberSp) {
     return -1;
   }
 
-  auto* spline = dynamic_cast<TGraph*>(fW_data->FindObject(Form(name, isp)));
-  if (!spline) {
+  const auto& table = fSplines[handle][isp];
+  if (!table.graph) {
     return -1;
   }
 
-  float perc = 100.f * spline->Eval(val);
+  float perc = 100.f * evalSpline(table, val);
   return (perc < 0 || perc > MaxTol) ? -1 : perc;
 };
 
+float FFitWeights::internalEval(float centr, const float& val, const char* name)
+{
+  return evalHandle(resolveSplines(name), centr, val);
+};
+
 float FFitWeights::eval(float centr, const float& dqn, int nh, const char* pf)
 {
   return internalEval(centr, dqn, Form("sp_q%i%s_%%i", nh, pf));
@@ -19,6 +19,7 @@
 
 #include <TAxis.h>
 #include <TCollection.h>
+#include <TGraph.h>
 #include <TH2.h>
 #include <TNamed.h>
 #include <TObjArray.h>
@@ -63,6 +64,11 @@ class FFitWeights : public TNamed
   void qSelection(const std::vector<int>& nhv, const std::vector<std::string>& stv);
   float eval(float centr, const float& dqn, const int nh, const char* pf = "");
   float evalPt(float centr, const float& mpt);
+  // Handles of the q_n (or mean pT) percentile splines, resolved once for all the centrality bins,
+  // -1 if the calibration has no splines. evalHandle then needs no name lookup.
+  int getQnHandle(const int nh, const char* pf = "") { return resolveSplines(Form("sp_q%i%s_%%i", nh, pf)); }
+  int getMptHandle() { return resolveSplines("sp_mpt_%i"); }
+  float evalHandle(int handle, float centr, const float& val);
   void setResolution(int res) { nResolution = res; }
   int getResolution() const { return nResolution; }
   void setQnType(const std::vector<std::pair<int, std::string>>& qninp) { qnTYPE = qninp; }
@@ -97,6 +103,21 @@ class FFitWeights : public TNamed
 
   float internalEval(float centr, const float& val, const char* name);
 
+  struct SplineTable {
+    TGraph* graph{nullptr}; // percentile vs q_n of one centrality bin
+    bool isSorted{false};   // abscissa sorted, linear interpolation with a binary search
+  };
+  std::vector<std::string> fSplineNames;          //! name patterns of the resolved splines, index = handle
+  std::vector<std::vector<SplineTable>> fSplines; //! splines of each handle per centrality bin
+
+  int resolveSplines(const char* name);
+  void clearSplineHandles()
+  {
+    fSplineNames.clear();
+    fSplines.clear();
+  }
+  static double evalSpline(const SplineTable& table, double x);
+
   ClassDef(FFitWeights, 1); // calibration class
 };
 #endif // COMMON_CORE_FFITWEIGHTS_H_
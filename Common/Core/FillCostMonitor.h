@@ -0,0 +1,148 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file FillCostMonitor.h
+/// \brief Opt-in measurement of the number of fills and of the time spent per histogram and per process function
+///
+/// The fills go through fill(registry, HIST("name"), values...), which calls registry.fill directly when the monitor
+/// is switched off. When a report file is given, the fills and their time are counted per histogram name, and the
+/// process functions are timed with the scope returned by measure("processName"). At the end of the job (when the
+/// monitor is destroyed) the histograms and the process functions are written to the report file as JSON, ranked
+/// by the time spent.
+
+#ifndef COMMON_CORE_FILLCOSTMONITOR_H_
+#define COMMON_CORE_FILLCOSTMONITOR_H_
+
+#include <Framework/Logger.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace o2::common::core
+{
+
+class FillCostMonitor
+{
+ public:
+  using Clock = std::chrono::steady_clock;
+
+  struct Cost {
+    uint64_t calls = 0;
+    Clock::duration time{};
+  };
+
+  /// times the lifetime of the scope, e.g. the body of a process function
+  class Scope
+  {
+   public:
+    Scope(Cost* cost) : mCost(cost), mStart(cost ? Clock::now() : Clock::time_point{}) {}
+    Scope(Scope const&) = delete;
+    Scope& operator=(Scope const&) = delete;
+    ~Scope()
+    {
+      if (mCost) {
+        mCost->calls++;
+        mCost->time += Clock::now() - mStart;
+      }
+    }
+
+   private:
+    Cost* mCost;
+    Clock::time_point mStart;
+  };
+
+  FillCostMonitor() = default;
+  FillCostMonitor(FillCostMonitor const&) = delete;
+  FillCostMonitor& operator=(FillCostMonitor const&) = delete;
+  ~FillCostMonitor() { writeReport(); }
+
+  /// switches the monitor on, the report is written to fileName at the end of the job; an empty name keeps it off
+  void setReport(std::string const& fileName)
+  {
+    mFileName = fileName;
+    mEnabled = !fileName.empty();
+  }
+
+  bool isEnabled() const { return mEnabled; }
+
+  /// registry.fill(histName, values...), counted and timed per histogram name when the monitor is on
+  template <typename R, typename H, typename... Ts>
+  void fill(R& registry, H const& histName, Ts&&... values)
+  {
+    if (!mEnabled) {
+      registry.fill(histName, std::forward<Ts>(values)...);
+      return;
+    }
+    const auto start = Clock::now();
+    registry.fill(histName, std::forward<Ts>(values)...);
+    auto& cost = mHistograms[histName.str];
+    cost.time += Clock::now() - start;
+    cost.calls++;
+  }
+
+  /// scope measuring the time spent in a process function, name must outlive the monitor (e.g. a literal)
+  Scope measure(const char* name) { return Scope(mEnabled ? &mProcesses[name] : nullptr); }
+
+  /// writes the report, only once, called by the destructor
+  void writeReport()
+  {
+    if (!mEnabled || mWritten) {
+      return;
+    }
+    mWritten = true;
+    std::ofstream out(mFileName);
+    if (!out) {
+      LOGF(error, "FillCostMonitor: cannot write the report to %s", mFileName);
+      return;
+    }
+    out << "{\n";
+    writeCosts(out, "processes", mProcesses);
+    out << ",\n";
+    writeCosts(out, "histograms", mHistograms);
+    out << "\n}\n";
+    LOGF(info, "FillCostMonitor: costs of %zu histograms and %zu process functions written to %s", mHistograms.size(), mProcesses.size(), mFileName);
+  }
+
+ private:
+  // the names are the literals of the histograms and of the process functions, their address is a unique key
+  using CostMap = std::unordered_map<const char*, Cost>;
+
+  static void writeCosts(std::ofstream& out, const char* what, CostMap const& costs)
+  {
+    std::vector<std::pair<const char*, Cost>> ranked(costs.begin(), costs.end());
+    std::sort(ranked.begin(), ranked.end(), [](auto const& a, auto const& b) { return a.second.time > b.second.time; });
+    out << "  \"" << what << "\": [";
+    for (std::size_t i = 0; i < ranked.size(); i++) {
+      const double seconds = std::chrono::duration<double>(ranked[i].second.time).count();
+      const uint64_t calls = ranked[i].second.calls;
+      out << (i > 0 ? ",\n" : "\n") << "    {\"name\": \"" << ranked[i].first << "\", \"calls\": " << calls
+          << ", \"seconds\": " << seconds << ", \"nsPerCall\": " << (calls > 0 ? 1.e9 * seconds / calls : 0.) << "}";
+    }
+    out << (ranked.empty() ? "]" : "\n  ]");
+  }
+
+  bool mEnabled = false;
+  bool mWritten = false;
+  std::string mFileName;
+  CostMap mHistograms;
+  CostMap mProcesses;
+};
+
+} // namespace o2::common::core
+
+#endif // COMMON_CORE_FILLCOSTMONITOR_H_
@@ -30,12 +30,15 @@
 #include <TGraph.h>
 #include <TString.h>
 
+#include <algorithm>
 #include <array>
 #include <cmath>
+#include <cstddef>
 #include <cstdint>
 #include <cstdlib>
 #include <string>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 namespace o2::pid::tof
@@ -100,9 +103,10 @@ class TOFResoParamsV2 : public o2::tof::Parameters<13>
       // LOG(info) << "TOFResoParamsV2 shift: no correction mEtaN is " << mEtaN;
       return 0.f;
     }
-    const int& etaIndex = (eta <= mEtaStart) ? 0 : (eta >= mEtaStop ? (mEtaN - 1) : (eta - mEtaStart) * mInvEtaWidth);
+    // the index is clamped to the valid range, the comparison with mEtaStart also catches a NaN eta
+    const int etaIndex = !(eta > mEtaStart) ? 0 : (eta >= mEtaStop ? (mEtaN - 1) : std::min(static_cast<int>((eta - mEtaStart) * mInvEtaWidth), mEtaN - 1));
     // LOG(info) << "TOFResoParamsV2 shift: correction for eta " << eta << " is for index " << etaIndex << " = " << shift;
-    return mContent.at(etaIndex);
+    return mContent[etaIndex];
   }
   // To remove
   float getShift(float eta) const
@@ -220,9 +224,10 @@ class TOFResoParamsV3 : public o2::tof::Parameters<13>
       // LOG(info) << "TOFResoParamsV3 shift: no correction mEtaN is " << mEtaN;
       return 0.f;
     }
-    const int& etaIndex = (eta <= mEtaStart) ? 0 : (eta >= mEtaStop ? (mEtaN - 1) : (eta - mEtaStart) * mInvEtaWidth);
+    // the index is clamped to the valid range, the comparison with mEtaStart also catches a NaN eta
+    const int etaIndex = !(eta > mEtaStart) ? 0 : (eta >= mEtaStop ? (mEtaN - 1) : std::min(static_cast<int>((eta - mEtaStart) * mInvEtaWidth), mEtaN - 1));
     // LOG(info) << "TOFResoParamsV3 shift: correction for eta " << eta << " is for index " << etaIndex << " = " << shift;
-    return mContent.at(etaIndex);
+    return mContent[etaIndex];
   }
 
   void printMomentumChargeShiftParameters() const
@@ -434,6 +439,71 @@ class TOFMass
   }
 };
 
+/// \brief Class to compute the beta, its expected uncertainty and the TOF mass of all the tracks of a table
+/// The inputs are copied in contiguous columns and the outputs are written in preallocated columns, to be used to fill the tables directly.
+/// The results are identical to the ones of Beta::GetBeta, Beta::GetExpectedSigma and TOFMass::GetTOFMass
+class BetaMassColumns
+{
+ public:
+  BetaMassColumns() = default;
+  ~BetaMassColumns() = default;
+
+  /// Computes the columns for the tracks of the table
+  /// \param tracks Table of tracks, with the TOF signal and event time
+  /// \param expectedResolution Expected time resolution used for the uncertainty on the beta
+  /// \param computeMass Flag to compute the TOF mass column
+  /// \param massMomentum Function giving the momentum used for the TOF mass of a track
+  /// \param massRequiresTOF Flag to set the TOF mass of the tracks without TOF to the default value
+  template <typename TracksType, typename MomentumFunction>
+  void compute(const TracksType& tracks, const float expectedResolution, const bool computeMass, MomentumFunction&& massMomentum, const bool massRequiresTOF)
+  {
+    const std::size_t n = tracks.size();
+    resize(n);
+    std::size_t i = 0;
+    for (const auto& track : tracks) {
+      mHasTOF[i] = track.hasTOF();
+      mLength[i] = track.length();
+      mTOFSignal[i] = track.tofSignal();
+      mEvTime[i] = track.tofEvTime();
+      if (computeMass) {
+        mMomentum[i] = massMomentum(track);
+      }
+      i++;
+    }
+    for (i = 0; i < n; i++) {
+      const float betaNoCheck = Beta::GetBeta(mLength[i], mTOFSignal[i], mEvTime[i]);
+      beta[i] = mHasTOF[i] ? betaNoCheck : defaultReturnValue;
+      betaSigma[i] = betaNoCheck / (mTOFSignal[i] - mEvTime[i]) * expectedResolution;
+    }
+    if (!computeMass) {
+      return;
+    }
+    for (i = 0; i < n; i++) {
+      const float m = TOFMass::GetTOFMass(mMomentum[i], beta[i]);
+      mass[i] = (massRequiresTOF && !mHasTOF[i]) ? defaultReturnValue : m;
+    }
+  }
+
+  std::vector<float> beta;      /// Measured beta
+  std::vector<float> betaSigma; /// Expected uncertainty on the measured beta
+  std::vector<float> mass;      /// TOF mass
+
+ private:
+  void resize(const std::size_t n)
+  {
+    for (auto* column : {&mLength, &mTOFSignal, &mEvTime, &mMomentum, &beta, &betaSigma, &mass}) {
+      column->resize(n);
+    }
+    mHasTOF.resize(n);
+  }
+
+  std::vector<uint8_t> mHasTOF;
+  std::vector<float> mLength;
+  std::vector<float> mTOFSignal;
+  std::vector<float> mEvTime;
+  std::vector<float> mMomentum;
+};
+
 /// \brief Class to handle the the TOF detector response for the expected time
 template <typename TrackType, o2::track::PID::ID id>
 class ExpTimes
@@ -485,8 +555,18 @@ class ExpTimes
   template <typename ParamType>
   static float GetExpectedSigma(const ParamType& parameters, const TrackType& track, const float tofSignal, const float collisionTimeRes)
   {
-    const float& mom = track.p();
-    const float& etaTrack = track.eta();
+    return ComputeExpectedSigma(parameters, track.p(), track.eta(), tofSignal, collisionTimeRes);
+  }
+
+  /// Computes the expected resolution of the t-texp-t0 given the momentum and pseudorapidity of the track
+  /// \param parameters Detector response parameters
+  /// \param mom Momentum of the track of interest
+  /// \param etaTrack Pseudorapidity of the track of interest
+  /// \param tofSignal TOF signal of the track of interest
+  /// \param collisionTimeRes Collision time resolution of the track of interest
+  template <typename ParamType>
+  static float ComputeExpectedSigma(const ParamType& parameters, const float mom, const float etaTrack, const float tofSignal, const float collisionTimeRes)
+  {
     if (mom <= 0) {
       return -999.f;
     }
@@ -559,6 +639,117 @@ class ExpTimes
   }
 };
 
+/// \brief TOF response of one track for all the mass hypotheses, indexed with the PID index
+struct TOFTrackResponse {
+  static constexpr int NSpecies = 9;
+  float beta = defaultReturnValue;              /// Measured beta
+  std::array<float, NSpecies> expectedSignal{}; /// Expected times, corrected for the momentum and time shifts
+  std::array<float, NSpecies> expectedSigma{};  /// Expected resolutions of t-texp-t0
+  std::array<float, NSpecies> separation{};     /// Number of sigmas with respect to the expected times
+};
+
+/// \brief Class to compute the TOF response of a track for all the mass hypotheses in one pass
+/// The terms which do not depend on the mass hypothesis (shifted expected momentum, time shift, event time) are evaluated once per track.
+/// The results are identical to the ones of ExpTimes::GetCorrectedExpectedSignal, ExpTimes::GetExpectedSigma and ExpTimes::GetSeparation
+template <typename TrackType>
+class ExpTimesAllSpecies
+{
+ public:
+  ExpTimesAllSpecies() = default;
+  ~ExpTimesAllSpecies() = default;
+
+  /// Computes the response of the track for the mass hypotheses enabled in speciesMask (bit i for the PID index i)
+  /// The entries of the mass hypotheses which are not enabled are left untouched
+  /// \param parameters Detector response parameters
+  /// \param track Track of interest
+  /// \param speciesMask Mask of the mass hypotheses to compute
+  /// \param response Output response of the track
+  template <typename ParamType>
+  static void Compute(const ParamType& parameters, const TrackType& track, const uint32_t speciesMask, TOFTrackResponse& response)
+  {
+    TrackTerms terms;
+    terms.hasTOF = track.hasTOF();
+    terms.mom = track.p();
+    terms.eta = track.eta();
+    terms.tofSignal = track.tofSignal();
+    terms.evTime = track.tofEvTime();
+    terms.evTimeErr = track.tofEvTimeErr();
+    response.beta = terms.hasTOF ? Beta::GetBeta(track.length(), terms.tofSignal, terms.evTime) : defaultReturnValue;
+    if (terms.hasTOF) {
+      terms.length = track.length();
+      const float shift = (1.f + track.sign() * parameters.getMomentumChargeShift(terms.eta));
+      if (track.trackType() == o2::aod::track::Run2Track) {
+        terms.expMom = track.tofExpMom() * o2::constants::physics::invLightSpeedCm2PS / shift;
+      } else {
+        terms.expMom = track.tofExpMom() / shift;
+        terms.timeShift = parameters.getTimeShift(terms.eta, track.sign());
+        terms.applyTimeShift = true;
+      }
+      terms.measuredTime = terms.tofSignal - terms.evTime;
+    }
+    computeAllSpecies(parameters, terms, speciesMask, response, std::make_index_sequence<TOFTrackResponse::NSpecies>{});
+  }
+
+  /// Computes the response of all the tracks of a table, the output has one entry per track
+  /// \param parameters Detector response parameters
+  /// \param tracks Table of tracks, with the TOF signal and event time
+  /// \param speciesMask Mask of the mass hypotheses to compute
+  /// \param responses Output responses, resized to the number of tracks
+  template <typename ParamType, typename TracksType>
+  static void ComputeBatch(const ParamType& parameters, const TracksType& tracks, const uint32_t speciesMask, std::vector<TOFTrackResponse>& responses)
+  {
+    responses.resize(tracks.size());
+    std::size_t i = 0;
+    for (const auto& track : tracks) {
+      Compute(parameters, track, speciesMask, responses[i++]);
+    }
+  }
+
+ private:
+  /// Terms of the track shared by all the mass hypotheses
+  struct TrackTerms {
+    bool hasTOF = false;
+    bool applyTimeShift = false;
+    float mom = 0.f;
+    float eta = 0.f;
+    float tofSignal = 0.f;
+    float evTime = 0.f;
+    float evTimeErr = 0.f;
+    float length = 0.f;
+    float expMom = 0.f;
+    float timeShift = 0.f;
+    float measuredTime = 0.f;
+  };
+
+  template <typename ParamType, std::size_t... ids>
+  static void computeAllSpecies(const ParamType& parameters, const TrackTerms& terms, const uint32_t speciesMask, TOFTrackResponse& response, std::index_sequence<ids...>)
+  {
+    (computeSpecies<static_cast<o2::track::PID::ID>(ids)>(parameters, terms, speciesMask, response), ...);
+  }
+
+  template <o2::track::PID::ID id, typename ParamType>
+  static void computeSpecies(const ParamType& parameters, const TrackTerms& terms, const uint32_t speciesMask, TOFTrackResponse& response)
+  {
+    if (!(speciesMask & (1u << id))) {
+      return;
+    }
+    using Response = ExpTimes<TrackType, id>;
+    const float sigma = Response::ComputeExpectedSigma(parameters, terms.mom, terms.eta, terms.tofSignal, terms.evTimeErr);
+    response.expectedSigma[id] = sigma;
+    if (!terms.hasTOF) {
+      response.expectedSignal[id] = defaultReturnValue;
+      response.separation[id] = defaultReturnValue;
+      return;
+    }
+    float expTime = Response::ComputeExpectedTime(terms.expMom, terms.length);
+    if (terms.applyTimeShift) {
+      expTime += terms.timeShift;
+    }
+    response.expectedSignal[id] = expTime;
+    response.separation[id] = (terms.measuredTime - expTime) / sigma;
+  }
+};
+
 /// \brief Class to convert the trackTime to the tofSignal used for PID
 template <typename TrackType>
 class TOFSignal
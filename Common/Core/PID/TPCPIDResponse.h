@@ -25,6 +25,8 @@
 
 #include <array>
 #include <cmath>
+#include <cstddef>
+#include <span>
 #include <vector>
 
 namespace o2::pid::tpc
@@ -40,7 +42,11 @@ class Response
   ~Response() = default;
 
   /// Setter and Getter for the private parameters
-  void SetBetheBlochParams(const std::array<float, 5>& betheBlochParams) { mBetheBlochParams = betheBlochParams; }
+  void SetBetheBlochParams(const std::array<float, 5>& betheBlochParams)
+  {
+    mBetheBlochParams = betheBlochParams;
+    ClearBetheBlochTable();
+  }
   void SetResolutionParamsDefault(const std::array<float, 2>& resolutionParamsDefault) { mResolutionParamsDefault = resolutionParamsDefault; }
   void SetResolutionParams(const std::vector<double>& resolutionParams) { mResolutionParams = resolutionParams; }
   void SetMIP(const float mip) { mMIP = mip; }
@@ -58,6 +64,7 @@ class Response
     mChargeFactor = response->GetChargeFactor();
     mMultNormalization = response->GetMultiplicityNormalization();
     mUseDefaultResolutionParam = response->GetUseDefaultResolutionParam();
+    ClearBetheBlochTable();
   }
 
   const std::array<float, 5> GetBetheBlochParams() const { return mBetheBlochParams; }
@@ -94,6 +101,22 @@ class Response
   /// Gets relative dEdx resolution contribution due to relative pt resolution
   float GetRelativeResolutiondEdx(const float p, const float mass, const float charge, const float resol) const;
 
+  /// Tabulates the Bethe-Bloch parametrisation with nPoints points equally spaced in log(beta*gamma) between bgMin and bgMax.
+  /// Once built, the expected signals are linearly interpolated in the table instead of evaluating the parametrisation;
+  /// outside the tabulated range the parametrisation is still evaluated. The table is dropped when the Bethe-Bloch parameters change.
+  void BuildBetheBlochTable(const int nPoints = 4096, const float bgMin = 0.01f, const float bgMax = 1.e4f);
+  void ClearBetheBlochTable() { mBetheBlochTable.clear(); }
+  bool HasBetheBlochTable() const { return !mBetheBlochTable.empty(); }
+  /// Bethe-Bloch parametrisation (without MIP and charge factors) at the given beta*gamma, from the table if available
+  float GetBetheBloch(const float bg) const;
+
+  /// Gets the expected signal for a given TPC inner momentum, without any check on the track
+  float GetExpectedSignalAtRigidity(const float tpcInnerParam, const o2::track::PID::ID id) const;
+  /// Gets the expected signals for a column of TPC inner momenta
+  void GetExpectedSignals(std::span<const float> tpcInnerParam, const o2::track::PID::ID id, std::span<float> expectedSignal) const;
+  /// Gets the expected resolution given a pre-computed expected signal and the track properties
+  float GetExpectedSigmaFromSignal(const float expectedSignal, const long multTPC, const float tpcInnerParam, const float tpcNClsFound, const float tgl, const float signed1Pt, const o2::track::PID::ID id) const;
+
   void PrintAll() const;
 
  private:
@@ -110,6 +133,10 @@ class Response
   bool mUseDefaultResolutionParam = true;
   float nClNorm = 152.f;
 
+  std::vector<float> mBetheBlochTable; //! Bethe-Bloch parametrisation tabulated in log(beta*gamma)
+  float mTableLogBGMin = 0.f;          //! log(beta*gamma) of the first point of the table
+  float mTableInvStep = 0.f;           //! inverse of the log(beta*gamma) distance between two points of the table
+
   ClassDefNV(Response, 3);
 
 }; // class Response
@@ -121,8 +148,7 @@ inline float Response::GetExpectedSignal(const TrackType& track, const o2::track
   if (!track.hasTPC()) {
     return -999.f;
   }
-  const float bethe = mMIP * o2::common::BetheBlochAleph(track.tpcInnerParam() / o2::track::pid_constants::sMasses[id], mBetheBlochParams[0], mBetheBlochParams[1], mBetheBlochParams[2], mBetheBlochParams[3], mBetheBlochParams[4]) * std::pow(static_cast<float>(o2::track::pid_constants::sCharges[id]), mChargeFactor);
-  return bethe >= 0.f ? bethe : -999.f;
+  return GetExpectedSignalAtRigidity(track.tpcInnerParam(), id);
 }
 
 /// Gets the expected resolution of the measurement
@@ -146,24 +172,7 @@ inline float Response::GetExpectedSigmaAtMultiplicity(const long multTPC, const
 template <typename TrackType>
 inline float Response::sigmaFromSignal(float expectedSignal, const long multTPC, const TrackType& track, const o2::track::PID::ID id) const
 {
-  float resolution = 0.f;
-  if (mUseDefaultResolutionParam) {
-    const float reso = expectedSignal * mResolutionParamsDefault[0] * (static_cast<float>(track.tpcNClsFound()) > 0 ? std::sqrt(1. + mResolutionParamsDefault[1] / static_cast<float>(track.tpcNClsFound())) : 1.f);
-    reso >= 0.f ? resolution = reso : resolution = -999.f;
-  } else {
-    const double ncl = nClNorm / track.tpcNClsFound();
-    const double p = track.tpcInnerParam();
-    const double mass = o2::track::pid_constants::sMasses[id];
-    const double bg = p / mass;
-    const double dEdx = o2::common::BetheBlochAleph(static_cast<float>(bg), mBetheBlochParams[0], mBetheBlochParams[1], mBetheBlochParams[2], mBetheBlochParams[3], mBetheBlochParams[4]) * std::pow(static_cast<float>(o2::track::pid_constants::sCharges[id]), mChargeFactor);
-    const double relReso = GetRelativeResolutiondEdx(p, mass, o2::track::pid_constants::sCharges[id], mResolutionParams[3]);
-
-    const std::vector<double> values{1.f / dEdx, track.tgl(), std::sqrt(ncl), relReso, track.signed1Pt(), multTPC / mMultNormalization};
-
-    const float reso = sqrt(pow(mResolutionParams[0], 2) * values[0] + pow(mResolutionParams[1], 2) * (values[2] * mResolutionParams[5]) * pow(values[0] / sqrt(1 + pow(values[1], 2)), mResolutionParams[2]) + values[2] * pow(values[3], 2) + pow(mResolutionParams[4] * values[4], 2) + pow(values[5] * mResolutionParams[6], 2) + pow(values[5] * (values[0] / sqrt(1 + pow(values[1], 2))) * mResolutionParams[7], 2)) * dEdx * mMIP;
-    reso >= 0.f ? resolution = reso : resolution = -999.f;
-  }
-  return resolution;
+  return GetExpectedSigmaFromSignal(expectedSignal, multTPC, track.tpcInnerParam(), static_cast<float>(track.tpcNClsFound()), track.tgl(), track.signed1Pt(), id);
 }
 
 /// Gets the number of sigma between the actual signal and the expected signal
@@ -216,14 +225,84 @@ inline float Response::GetSignalDelta(const TrackType& trk, const o2::track::PID
 inline float Response::GetRelativeResolutiondEdx(const float p, const float mass, const float charge, const float resol) const
 {
   const float bg = p / mass;
-  const float dEdx = o2::common::BetheBlochAleph(bg, mBetheBlochParams[0], mBetheBlochParams[1], mBetheBlochParams[2], mBetheBlochParams[3], mBetheBlochParams[4]) * std::pow(charge, mChargeFactor);
+  const float dEdx = GetBetheBloch(bg) * std::pow(charge, mChargeFactor);
   const float deltaP = resol * std::sqrt(dEdx);
   const float bgDelta = p * (1 + deltaP) / mass;
-  const float dEdx2 = o2::common::BetheBlochAleph(bgDelta, mBetheBlochParams[0], mBetheBlochParams[1], mBetheBlochParams[2], mBetheBlochParams[3], mBetheBlochParams[4]) * std::pow(charge, mChargeFactor);
+  const float dEdx2 = GetBetheBloch(bgDelta) * std::pow(charge, mChargeFactor);
   const float deltaRel = std::abs(dEdx2 - dEdx) / dEdx;
   return deltaRel;
 }
 
+inline void Response::BuildBetheBlochTable(const int nPoints, const float bgMin, const float bgMax)
+{
+  mBetheBlochTable.clear();
+  if (nPoints < 2 || !(bgMin > 0.f) || !(bgMax > bgMin)) {
+    LOGP(error, "Invalid Bethe-Bloch table settings: nPoints = {}, bgMin = {}, bgMax = {}. The parametrisation will be evaluated for each track", nPoints, bgMin, bgMax);
+    return;
+  }
+  mTableLogBGMin = std::log(bgMin);
+  const double step = (static_cast<double>(std::log(bgMax)) - mTableLogBGMin) / (nPoints - 1);
+  mTableInvStep = 1. / step;
+  mBetheBlochTable.resize(nPoints);
+  for (int i = 0; i < nPoints; i++) {
+    const float bg = std::exp(mTableLogBGMin + i * step);
+    mBetheBlochTable[i] = o2::common::BetheBlochAleph(bg, mBetheBlochParams[0], mBetheBlochParams[1], mBetheBlochParams[2], mBetheBlochParams[3], mBetheBlochParams[4]);
+  }
+}
+
+inline float Response::GetBetheBloch(const float bg) const
+{
+  if (!mBetheBlochTable.empty() && bg > 0.f) {
+    const float pos = (std::log(bg) - mTableLogBGMin) * mTableInvStep;
+    if (pos >= 0.f) {
+      const auto bin = static_cast<std::size_t>(pos);
+      if (bin + 1 < mBetheBlochTable.size()) {
+        const float frac = pos - bin;
+        return mBetheBlochTable[bin] + frac * (mBetheBlochTable[bin + 1] - mBetheBlochTable[bin]);
+      }
+    }
+  }
+  return o2::common::BetheBlochAleph(bg, mBetheBlochParams[0], mBetheBlochParams[1], mBetheBlochParams[2], mBetheBlochParams[3], mBetheBlochParams[4]);
+}
+
+inline float Response::GetExpectedSignalAtRigidity(const float tpcInnerParam, const o2::track::PID::ID id) const
+{
+  const float bethe = mMIP * GetBetheBloch(tpcInnerParam / o2::track::pid_constants::sMasses[id]) * std::pow(static_cast<float>(o2::track::pid_constants::sCharges[id]), mChargeFactor);
+  return bethe >= 0.f ? bethe : -999.f;
+}
+
+inline void Response::GetExpectedSignals(std::span<const float> tpcInnerParam, const o2::track::PID::ID id, std::span<float> expectedSignal) const
+{
+  const float mass = o2::track::pid_constants::sMasses[id];
+  const float chargeFactor = std::pow(static_cast<float>(o2::track::pid_constants::sCharges[id]), mChargeFactor);
+  for (std::size_t i = 0; i < tpcInnerParam.size(); i++) {
+    const float bethe = mMIP * GetBetheBloch(tpcInnerParam[i] / mass) * chargeFactor;
+    expectedSignal[i] = bethe >= 0.f ? bethe : -999.f;
+  }
+}
+
+inline float Response::GetExpectedSigmaFromSignal(const float expectedSignal, const long multTPC, const float tpcInnerParam, const float tpcNClsFound, const float tgl, const float signed1Pt, const o2::track::PID::ID id) const
+{
+  float resolution = 0.f;
+  if (mUseDefaultResolutionParam) {
+    const float reso = expectedSignal * mResolutionParamsDefault[0] * (tpcNClsFound > 0 ? std::sqrt(1. + mResolutionParamsDefault[1] / tpcNClsFound) : 1.f);
+    reso >= 0.f ? resolution = reso : resolution = -999.f;
+  } else {
+    const double ncl = nClNorm / tpcNClsFound;
+    const double p = tpcInnerParam;
+    const double mass = o2::track::pid_constants::sMasses[id];
+    const double bg = p / mass;
+    const double dEdx = GetBetheBloch(static_cast<float>(bg)) * std::pow(static_cast<float>(o2::track::pid_constants::sCharges[id]), mChargeFactor);
+    const double relReso = GetRelativeResolutiondEdx(p, mass, o2::track::pid_constants::sCharges[id], mResolutionParams[3]);
+
+    const std::array<double, 6> values{1.f / dEdx, tgl, std::sqrt(ncl), relReso, signed1Pt, multTPC / mMultNormalization};
+
+    const float reso = sqrt(pow(mResolutionParams[0], 2) * values[0] + pow(mResolutionParams[1], 2) * (values[2] * mResolutionParams[5]) * pow(values[0] / sqrt(1 + pow(values[1], 2)), mResolutionParams[2]) + values[2] * pow(values[3], 2) + pow(mResolutionParams[4] * values[4], 2) + pow(values[5] * mResolutionParams[6], 2) + pow(values[5] * (values[0] / sqrt(1 + pow(values[1], 2))) * mResolutionParams[7], 2)) * dEdx * mMIP;
+    reso >= 0.f ? resolution = reso : resolution = -999.f;
+  }
+  return resolution;
+}
+
 inline void Response::PrintAll() const
 {
   LOGP(info, "==== TPC PID response parameters: ====");
@@ -1235,6 +1235,86 @@ struct RecoDecay {
   }
 };
 
+/// Cache of the origin of the MC particles of a table
+///
+/// The origins given by RecoDecay::getCharmHadronOrigin and RecoDecay::getParticleOrigin (with searchUpToQuark = false) depend only on the particle.
+/// They are computed with the mother chain walk at the first request for a particle and read back for the next ones, e.g. when the same particle
+/// is matched to several reconstructed candidates and at the generated level. The b-hadron mother found by the walk is stored as well.
+/// The particles are identified by their global index, the cache has to be reset for each new table of MC particles.
+class RecoDecayMcAncestry
+{
+ public:
+  /// Clears the cache for a table of MC particles
+  /// \param nParticles  number of MC particles of the table
+  void reset(std::size_t nParticles)
+  {
+    mCharmHadronOrigin.assign(nParticles, NotComputed);
+    mParticleOrigin.assign(nParticles, NotComputed);
+    mBhadMotherCharmHadron.assign(nParticles, -1);
+    mBhadMotherParticle.assign(nParticles, -1);
+  }
+
+  /// Same as RecoDecay::getCharmHadronOrigin with searchUpToQuark = false
+  /// \param particlesMC  table with MC particles
+  /// \param particle  MC particle
+  /// \param idxBhadMothers optional vector where the index of the b-hadron mother is added for non-prompt particles
+  /// \return an integer corresponding to the origin (0: none, 1: prompt, 2: nonprompt) as in OriginType
+  template <typename T>
+  int getCharmHadronOrigin(const T& particlesMC,
+                           const typename T::iterator& particle,
+                           std::vector<int>* idxBhadMothers = nullptr)
+  {
+    return getOrigin(particlesMC, particle, idxBhadMothers, mCharmHadronOrigin, mBhadMotherCharmHadron, [](auto const& particles, auto const& part, std::vector<int>* idx) { return RecoDecay::getCharmHadronOrigin(particles, part, false, idx); });
+  }
+
+  /// Same as RecoDecay::getParticleOrigin with searchUpToQuark = false
+  /// \param particlesMC  table with MC particles
+  /// \param particle  MC particle
+  /// \param idxBhadMothers optional vector where the index of the b-hadron mother is added for particles from beauty
+  /// \return an integer corresponding to the origin (0: none(others), 1: charm, 2: beauty) as in OriginType
+  template <typename T>
+  int getParticleOrigin(const T& particlesMC,
+                        const typename T::iterator& particle,
+                        std::vector<int>* idxBhadMothers = nullptr)
+  {
+    return getOrigin(particlesMC, particle, idxBhadMothers, mParticleOrigin, mBhadMotherParticle, [](auto const& particles, auto const& part, std::vector<int>* idx) { return RecoDecay::getParticleOrigin(particles, part, false, idx); });
+  }
+
+ private:
+  static constexpr int8_t NotComputed{-1};
+
+  // Without searchUpToQuark, the walk adds at most one b hadron to idxBhadMothers, just before returning NonPrompt.
+  template <typename T, typename F>
+  static int getOrigin(const T& particlesMC,
+                       const typename T::iterator& particle,
+                       std::vector<int>* idxBhadMothers,
+                       std::vector<int8_t>& origins,
+                       std::vector<int>& bHadMothers,
+                       F&& computeOrigin)
+  {
+    const auto index = static_cast<std::size_t>(particle.globalIndex());
+    if (index >= origins.size()) {
+      return computeOrigin(particlesMC, particle, idxBhadMothers);
+    }
+    if (origins[index] == NotComputed) {
+      std::vector<int> bHadMother{};
+      origins[index] = static_cast<int8_t>(computeOrigin(particlesMC, particle, &bHadMother));
+      if (!bHadMother.empty()) {
+        bHadMothers[index] = bHadMother.front();
+      }
+    }
+    if (idxBhadMothers && bHadMothers[index] > -1) {
+      idxBhadMothers->push_back(bHadMothers[index]);
+    }
+    return origins[index];
+  }
+
+  std::vector<int8_t> mCharmHadronOrigin;  ///< origin from RecoDecay::getCharmHadronOrigin, NotComputed if not requested yet
+  std::vector<int8_t> mParticleOrigin;     ///< origin from RecoDecay::getParticleOrigin, NotComputed if not requested yet
+  std::vector<int> mBhadMotherCharmHadron; ///< index of the b-hadron mother found by RecoDecay::getCharmHadronOrigin, -1 if none
+  std::vector<int> mBhadMotherParticle;    ///< index of the b-hadron mother found by RecoDecay::getParticleOrigin, -1 if none
+};
+
 /// Calculations using (pT, η, φ) coordinates, aka (transverse momentum, pseudorapidity, azimuth)
 /// \tparam indexPt  index of pT element
 /// \tparam indexEta  index of η element
@@ -20,8 +20,13 @@
 #include <ReconstructionDataFormats/Track.h>
 #include <ReconstructionDataFormats/TrackParametrization.h>
 
+#include <cstddef>
 #include <cstdint>
+#include <limits>
 #include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
 
 namespace o2::aod::common
 {
@@ -29,6 +34,9 @@ namespace o2::aod::common
 // Thin wrapper for vdrift ccdb queries should partially mirror VDriftHelper class.
 // Allows to move TPC standalone tracks under the assumption of a different
 // collision than the track is associated to.
+// With cacheDataFrame called at the beginning of each data frame, the global BCs
+// of the collisions are resolved once and the correction of a track for a given
+// collision is computed once, then reused for all the candidates sharing the track.
 class TPCVDriftManager
 {
  public:
@@ -56,11 +64,29 @@ class TPCVDriftManager
 
     // Update factors
     mTPCVDriftNS = mVD->refVDrift * mVD->corrFact * 1e-3;
+    mTrackShifts.clear(); // computed with the previous drift velocity
 
     mValid = true;
     LOGP(info, "Updated VDrift for timestamp {} with vdrift={:.7f} (cm/ns)", mVD->creationTime, mTPCVDriftNS);
   }
 
+  // Cache the global BCs of the collisions of the data frame and reset the corrections of the tracks of the previous one.
+  // Once called, it has to be called for each data frame before moving the tracks.
+  template <typename BCs, typename Collisions>
+  void cacheDataFrame(const Collisions& collisions)
+  {
+    mIsDataFrameCached = true;
+    mCollisionBCs.clear();
+    mTrackShifts.clear();
+    for (const auto& collision : collisions) {
+      const auto id = static_cast<std::size_t>(collision.globalIndex());
+      if (id >= mCollisionBCs.size()) {
+        mCollisionBCs.resize(id + 1, NoBC);
+      }
+      mCollisionBCs[id] = collision.template foundBC_as<BCs>().globalBC();
+    }
+  }
+
   template <typename BCs, typename Collisions, typename Collision, typename TrackExtra, typename Track>
   [[nodiscard]] bool moveTPCTrack(const Collision& col, const TrackExtra& trackExtra, Track& track) noexcept
   {
@@ -84,6 +110,22 @@ class TPCVDriftManager
       return true;
     }
 
+    // track already moved for this collision in the data frame
+    uint64_t shiftKey{0};
+    if (mIsDataFrameCached) {
+      shiftKey = (static_cast<uint64_t>(trackExtra.globalIndex()) << 32) | static_cast<uint32_t>(col.globalIndex());
+      if (const auto shift = mTrackShifts.find(shiftKey); shift != mTrackShifts.end()) {
+        ++mCacheHits;
+        if (!shift->second.isInside) {
+          ++mOutside;
+          return false;
+        }
+        applyShift(track, shift->second.dDrift, shift->second.dDriftErr);
+        ++mMovedTrks;
+        return true;
+      }
+    }
+
     // TPC time is given relative to the closest BC in ns
     float tTB, tTBErr;
     if (col.collisionTimeRes() < 0.f) { // use track data
@@ -96,8 +138,8 @@ class TPCVDriftManager
       ++mColResPos;
       // The TPC track can be associated to a different BC than the one the collision under assumption is;
       // we need to calculate the difference and subtract this from the trackTime()
-      const auto trackBC = trackExtra.template collision_as<Collisions>().template foundBC_as<BCs>().globalBC();
-      const auto colBC = col.template foundBC_as<BCs>().globalBC();
+      const auto trackBC = trackCollisionBC<BCs, Collisions>(trackExtra);
+      const auto colBC = collisionBC<BCs>(col);
       float sign{1.f};
       uint64_t diffBC{0};
       if (colBC < trackBC) {
@@ -114,10 +156,13 @@ class TPCVDriftManager
     float dDrift = dTime * mTPCVDriftNS;
     float dDriftErr = tTBErr * mTPCVDriftNS;
     if (dDriftErr < 0.f || dDrift > 250.f) { // we cannot move a track outside the drift volume
+      if (mIsDataFrameCached) {
+        mTrackShifts.emplace(shiftKey, TrackShift{false, dDrift, dDriftErr});
+      }
       if (mOutside < mWarningLimit) {
         LOGP(warn, "Skipping correction outside of tpc volume with dDrift={} +- {}", dDrift, dDriftErr);
-        const auto trackBC = trackExtra.template collision_as<Collisions>().template foundBC_as<BCs>().globalBC();
-        const auto colBC = col.template foundBC_as<BCs>().globalBC();
+        const auto trackBC = trackCollisionBC<BCs, Collisions>(trackExtra);
+        const auto colBC = collisionBC<BCs>(col);
         int diffBC = colBC - trackBC;
         LOGP(info, "ct={}; ctr={}; tTB={}; t0={}; dTime={}; dDrift={}; tgl={}:   colBC={}   trackBC={}  diffBC={}", col.collisionTime(), col.collisionTimeRes(), tTB, trackExtra.trackTime(), dTime, dDrift, track.getTgl(), colBC, trackBC, diffBC);
         if (mOutside == mWarningLimit - 1) {
@@ -128,11 +173,10 @@ class TPCVDriftManager
       return false;
     }
 
-    // impose new Z coordinate
-    track.setZ(track.getZ() + ((track.getTgl() < 0.) ? -dDrift : dDrift));
-    if constexpr (std::is_base_of_v<o2::track::TrackParCov, Track>) {
-      track.setCov(track.getSigmaZ2() + dDriftErr * dDriftErr, o2::track::kSigZ2);
+    if (mIsDataFrameCached) {
+      mTrackShifts.emplace(shiftKey, TrackShift{true, dDrift, dDriftErr});
     }
+    applyShift(track, dDrift, dDriftErr);
 
     ++mMovedTrks;
 
@@ -141,10 +185,50 @@ class TPCVDriftManager
 
   void print() noexcept
   {
-    LOGP(info, "TPC corrections called: {}; Moved Tracks: {}; Constrained Tracks={}; No Flag: {}; NULL: {}; Outside: {}; ColResPos {}; ColResNeg {};", mCalls, mMovedTrks, mConstrained, mNoFlag, mInvalid, mOutside, mColResPos, mColResNeg);
+    LOGP(info, "TPC corrections called: {}; Moved Tracks: {}; Constrained Tracks={}; No Flag: {}; NULL: {}; Outside: {}; ColResPos {}; ColResNeg {}; Cached {};", mCalls, mMovedTrks, mConstrained, mNoFlag, mInvalid, mOutside, mColResPos, mColResNeg, mCacheHits);
   }
 
  private:
+  // Correction of a track for a given collision
+  struct TrackShift {
+    bool isInside;   // the moved track is inside the drift volume
+    float dDrift;    // drift length correction (cm)
+    float dDriftErr; // error of the drift length correction (cm)
+  };
+
+  template <typename Track>
+  static void applyShift(Track& track, float dDrift, float dDriftErr) noexcept
+  {
+    // impose new Z coordinate
+    track.setZ(track.getZ() + ((track.getTgl() < 0.) ? -dDrift : dDrift));
+    if constexpr (std::is_base_of_v<o2::track::TrackParCov, Track>) {
+      track.setCov(track.getSigmaZ2() + dDriftErr * dDriftErr, o2::track::kSigZ2);
+    }
+  }
+
+  [[nodiscard]] bool isCollisionBCCached(int64_t collisionId) const noexcept
+  {
+    return mIsDataFrameCached && collisionId >= 0 && static_cast<std::size_t>(collisionId) < mCollisionBCs.size() && mCollisionBCs[collisionId] != NoBC;
+  }
+
+  template <typename BCs, typename Collision>
+  [[nodiscard]] uint64_t collisionBC(const Collision& col) const
+  {
+    if (isCollisionBCCached(col.globalIndex())) {
+      return mCollisionBCs[col.globalIndex()];
+    }
+    return col.template foundBC_as<BCs>().globalBC();
+  }
+
+  template <typename BCs, typename Collisions, typename TrackExtra>
+  [[nodiscard]] uint64_t trackCollisionBC(const TrackExtra& trackExtra) const
+  {
+    if (isCollisionBCCached(trackExtra.collisionId())) {
+      return mCollisionBCs[trackExtra.collisionId()];
+    }
+    return trackExtra.template collision_as<Collisions>().template foundBC_as<BCs>().globalBC();
+  }
+
   bool mValid{false};
   // Factors
   float mTPCVDriftNS{0.f}; // drift velocity in cm/ns
@@ -155,6 +239,12 @@ class TPCVDriftManager
 
   static constexpr unsigned int mWarningLimit{10};
 
+  // Data frame cache
+  static constexpr uint64_t NoBC{std::numeric_limits<uint64_t>::max()};
+  bool mIsDataFrameCached{false};                        // cacheDataFrame is called for each data frame
+  std::vector<uint64_t> mCollisionBCs;                   // global BC of the collisions, by collision index
+  std::unordered_map<uint64_t, TrackShift> mTrackShifts; // corrections of the tracks, by (track index, collision index)
+
   // Counters
   unsigned int mCalls{0};       // total number of calls
   unsigned int mMovedTrks{0};   // number of moved tracks
@@ -164,6 +254,7 @@ class TPCVDriftManager
   unsigned int mNoFlag{0};      // number of tracks without flag set
   unsigned int mOutside{0};     // number of tracks moved but outside of sensible volume
   unsigned int mConstrained{0}; // number of constrained tracks
+  unsigned int mCacheHits{0};   // number of tracks moved with the correction already computed for the collision
 };
 
 } // namespace o2::aod::common
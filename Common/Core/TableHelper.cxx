@@ -17,11 +17,54 @@
 
 #include "Common/Core/TableHelper.h"
 
+#include <Framework/ConfigParamSpec.h>
 #include <Framework/InitContext.h>
 #include <Framework/Logger.h>
 #include <Framework/RunningWorkflowInfo.h>
 
+#include <mutex>
 #include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace
+{
+/// Index of the tables consumed and of the options of the devices of the running workflow.
+/// It is built on the first query and shared by all the tasks of the process, the auto-detection
+/// done in the init of the producers then does not scan all the devices, their inputs and options at each call.
+struct WorkflowIndex {
+  const o2::framework::RunningWorkflowInfo* workflow = nullptr;
+  std::unordered_map<std::string, std::vector<std::string>> tableConsumers;                                              // table -> devices requiring it
+  std::unordered_map<std::string, std::unordered_map<std::string, const o2::framework::ConfigParamSpec*>> deviceOptions; // device -> option name -> option
+};
+
+const WorkflowIndex& getWorkflowIndex(o2::framework::InitContext& initContext)
+{
+  static WorkflowIndex index;
+  static std::mutex indexMutex;
+  const auto& workflows = initContext.services().get<o2::framework::RunningWorkflowInfo const>();
+  std::lock_guard<std::mutex> lock(indexMutex);
+  if (index.workflow == &workflows) {
+    return index;
+  }
+  index = WorkflowIndex{};
+  index.workflow = &workflows;
+  for (auto const& device : workflows.devices) {
+    for (auto const& input : device.inputs) {
+      index.tableConsumers[input.matcher.binding].push_back(device.name);
+    }
+    // only the first device with a given name and its first option with a given name are kept, as in a linear search
+    auto [deviceOptions, isNewDevice] = index.deviceOptions.try_emplace(device.name);
+    if (!isNewDevice) {
+      continue;
+    }
+    for (auto const& option : device.options) {
+      deviceOptions->second.try_emplace(option.name, &option);
+    }
+  }
+  return index;
+}
+} // namespace
 
 /// Function to print the table required in the full workflow
 /// @param initContext initContext of the init function
@@ -41,17 +84,30 @@ void o2::common::core::printTablesInWorkflow(o2::framework::InitContext& initCon
 bool o2::common::core::isTableRequiredInWorkflow(o2::framework::InitContext& initContext, const std::string& table)
 {
   LOG(debug) << "Checking if table " << table << " is needed";
-  bool tableNeeded = false;
-  const auto& workflows = initContext.services().get<o2::framework::RunningWorkflowInfo const>();
-  for (auto const& device : workflows.devices) {
-    for (auto const& input : device.inputs) {
-      if (input.matcher.binding == table) {
-        LOG(debug) << "Table: " << input.matcher.binding << " is needed in device: " << device.name;
-        tableNeeded = true;
-      }
-    }
+  const auto& index = getWorkflowIndex(initContext);
+  const auto consumers = index.tableConsumers.find(table);
+  if (consumers == index.tableConsumers.end()) {
+    return false;
+  }
+  for (auto const& deviceName : consumers->second) {
+    LOG(debug) << "Table: " << table << " is needed in device: " << deviceName;
+  }
+  return true;
+}
+
+/// Function to find a configurable of a task in the current workflow
+/// @param initContext initContext of the init function
+/// @param taskName name of the task to check for
+/// @param optName name of the option to check for
+const o2::framework::ConfigParamSpec* o2::common::core::findTaskOption(o2::framework::InitContext& initContext, const std::string& taskName, const std::string& optName)
+{
+  const auto& index = getWorkflowIndex(initContext);
+  const auto deviceOptions = index.deviceOptions.find(taskName);
+  if (deviceOptions == index.deviceOptions.end()) {
+    return nullptr;
   }
-  return tableNeeded;
+  const auto option = deviceOptions->second.find(optName);
+  return option == deviceOptions->second.end() ? nullptr : option->second;
 }
 
 /// Function to enable or disable a configurable flag, depending on the fact that a table is needed or not
@@ -61,6 +61,13 @@ void enableFlagIfTableRequired(o2::framework::InitContext& initContext, const st
   enableFlagIfTableRequired(initContext, table, flag.value);
 }
 
+/// Function to find a configurable of a task in the current workflow, from the workflow index shared by all the tasks of the process
+/// @param initContext initContext of the init function
+/// @param taskName name of the task to check for
+/// @param optName name of the option to check for
+/// @return the option, nullptr if the task or the option is not in the workflow
+const o2::framework::ConfigParamSpec* findTaskOption(o2::framework::InitContext& initContext, const std::string& taskName, const std::string& optName);
+
 /// Function to check for a specific configurable from another task in the current workflow and fetch its value. Useful for tasks that need to know the value of a configurable in another task.
 /// @param initContext initContext of the init function
 /// @param taskName name of the task to check for
@@ -70,9 +77,16 @@ void enableFlagIfTableRequired(o2::framework::InitContext& initContext, const st
 template <typename ValueType>
 bool getTaskOptionValue(o2::framework::InitContext& initContext, const std::string& taskName, const std::string& optName, ValueType& value, const bool verbose = true)
 {
-  if (verbose) {
-    LOG(info) << "Checking for option '" << optName << "' in task '" << taskName << "'";
+  if (!verbose) {
+    const o2::framework::ConfigParamSpec* option = findTaskOption(initContext, taskName, optName);
+    if (option == nullptr) {
+      return false;
+    }
+    value = option->defaultValue.get<ValueType>();
+    return true;
   }
+  // verbose mode, all the devices and their options are listed
+  LOG(info) << "Checking for option '" << optName << "' in task '" << taskName << "'";
   const auto& workflows = initContext.services().get<o2::framework::RunningWorkflowInfo const>();
   int deviceCounter = 0;
   bool found = false;
@@ -19,11 +19,13 @@
 #include <Framework/Logger.h>
 
 #include <algorithm>
+#include <cstddef>
 #include <cstdint>
 #include <functional>
 #include <set>
 #include <string>
 #include <utility>
+#include <vector>
 
 bool TrackSelection::FulfillsITSHitRequirements(uint8_t itsClusterMap) const
 {
@@ -42,90 +44,107 @@ const std::string TrackSelection::mCutNames[static_cast<int>(TrackSelection::Tra
 
 void TrackSelection::SetTrackType(o2::aod::track::TrackTypeEnum trackType)
 {
+  mIsCompiled = false;
   mTrackType = trackType;
   LOG(info) << "Track selection, set track type: " << static_cast<int>(mTrackType);
 }
 void TrackSelection::SetPtRange(float minPt, float maxPt)
 {
+  mIsCompiled = false;
   mMinPt = minPt;
   mMaxPt = maxPt;
   LOG(info) << "Track selection, set pt range: " << mMinPt << " - " << mMaxPt;
 }
 void TrackSelection::SetEtaRange(float minEta, float maxEta)
 {
+  mIsCompiled = false;
   mMinEta = minEta;
   mMaxEta = maxEta;
   LOG(info) << "Track selection, set eta range: " << mMinEta << " - " << mMaxEta;
 }
 void TrackSelection::SetRequireITSRefit(bool requireITSRefit)
 {
+  mIsCompiled = false;
   mRequireITSRefit = requireITSRefit;
   LOG(info) << "Track selection, set require ITS refit: " << mRequireITSRefit;
 }
 void TrackSelection::SetRequireTPCRefit(bool requireTPCRefit)
 {
+  mIsCompiled = false;
   mRequireTPCRefit = requireTPCRefit;
   LOG(info) << "Track selection, set require TPC refit: " << mRequireTPCRefit;
 }
 void TrackSelection::SetRequireGoldenChi2(bool requireGoldenChi2)
 {
+  mIsCompiled = false;
   mRequireGoldenChi2 = requireGoldenChi2;
   LOG(info) << "Track selection, set require golden chi2: " << mRequireGoldenChi2;
 }
 void TrackSelection::SetMinNClustersTPC(int minNClustersTPC)
 {
+  mIsCompiled = false;
   mMinNClustersTPC = minNClustersTPC;
   LOG(info) << "Track selection, set min N clusters TPC: " << mMinNClustersTPC;
 }
 void TrackSelection::SetMinNCrossedRowsTPC(int minNCrossedRowsTPC)
 {
+  mIsCompiled = false;
   mMinNCrossedRowsTPC = minNCrossedRowsTPC;
   LOG(info) << "Track selection, set min N crossed rows TPC: " << mMinNCrossedRowsTPC;
 }
 void TrackSelection::SetMinNCrossedRowsOverFindableClustersTPC(float minNCrossedRowsOverFindableClustersTPC)
 {
+  mIsCompiled = false;
   mMinNCrossedRowsOverFindableClustersTPC = minNCrossedRowsOverFindableClustersTPC;
   LOG(info) << "Track selection, set min N crossed rows over findable clusters TPC: " << mMinNCrossedRowsOverFindableClustersTPC;
 }
 void TrackSelection::SetMaxTPCFractionSharedCls(float maxTPCFractionSharedCls)
 {
+  mIsCompiled = false;
   mMaxTPCFractionSharedCls = maxTPCFractionSharedCls;
   LOG(info) << "Track selection, set max fraction of shared clusters TPC: " << mMaxTPCFractionSharedCls;
 }
 void TrackSelection::SetMinNClustersITS(int minNClustersITS)
 {
+  mIsCompiled = false;
   mMinNClustersITS = minNClustersITS;
   LOG(info) << "Track selection, set min N clusters ITS: " << mMinNClustersITS;
 }
 void TrackSelection::SetMaxChi2PerClusterTPC(float maxChi2PerClusterTPC)
 {
+  mIsCompiled = false;
   mMaxChi2PerClusterTPC = maxChi2PerClusterTPC;
   LOG(info) << "Track selection, set max chi2 per cluster TPC: " << mMaxChi2PerClusterTPC;
 }
 void TrackSelection::SetMaxChi2PerClusterITS(float maxChi2PerClusterITS)
 {
+  mIsCompiled = false;
   mMaxChi2PerClusterITS = maxChi2PerClusterITS;
   LOG(info) << "Track selection, set max chi2 per cluster ITS: " << mMaxChi2PerClusterITS;
 }
 void TrackSelection::SetMaxDcaXY(float maxDcaXY)
 {
+  mIsCompiled = false;
   mMaxDcaXY = maxDcaXY;
   LOG(info) << "Track selection, set max DCA xy: " << mMaxDcaXY;
 }
 void TrackSelection::SetMaxDcaZ(float maxDcaZ)
 {
+  mIsCompiled = false;
   mMaxDcaZ = maxDcaZ;
   LOG(info) << "Track selection, set max DCA z: " << mMaxDcaZ;
 }
 
 void TrackSelection::SetMaxDcaXYPtDep(std::function<float(float)> ptDepCut)
 {
+  mIsCompiled = false;
   mMaxDcaXYPtDep = ptDepCut;
   LOG(info) << "Track selection, set max DCA xy pt dep: " << mMaxDcaXYPtDep(1.0);
 }
 
 void TrackSelection::SetRequireHitsInITSLayers(int8_t minNRequiredHits, std::set<uint8_t> requiredLayers)
 {
+  mIsCompiled = false;
   // layer 0 corresponds to the the innermost ITS layer
   uint8_t mask = 0;
   for (const auto& layer : requiredLayers) {
@@ -136,6 +155,7 @@ void TrackSelection::SetRequireHitsInITSLayers(int8_t minNRequiredHits, std::set
 }
 void TrackSelection::SetRequireNoHitsInITSLayers(std::set<uint8_t> excludedLayers)
 {
+  mIsCompiled = false;
   uint8_t mask = 0;
   for (const auto& layer : excludedLayers) {
     mask |= (1u << layer);
@@ -144,6 +164,102 @@ void TrackSelection::SetRequireNoHitsInITSLayers(std::set<uint8_t> excludedLayer
   LOG(info) << "Track selection, set require no hits in ITS layers";
 }
 
+bool TrackSelection::CanReject(TrackCuts cut) const
+{
+  switch (cut) {
+    case TrackCuts::kTPCRefit:
+      return mRequireTPCRefit;
+    case TrackCuts::kITSNCls:
+      return mMinNClustersITS > 0; // the number of ITS clusters is unsigned
+    case TrackCuts::kITSRefit:
+      return mRequireITSRefit;
+    case TrackCuts::kITSHits:
+      return !mRequiredITSHits.empty();
+    case TrackCuts::kGoldenChi2:
+      return mRequireGoldenChi2;
+    default:
+      // the floating point cuts also reject NaN values, so they are kept even with the default limits
+      return true;
+  }
+}
+
+void TrackSelection::CompileSelection(const std::vector<uint64_t>& nRejected)
+{
+  mCompiledCuts.clear();
+  for (int i = 0; i < static_cast<int>(TrackCuts::kNCuts); i++) {
+    if (CanReject(static_cast<TrackCuts>(i))) {
+      mCompiledCuts.push_back(static_cast<TrackCuts>(i));
+    }
+  }
+  if (nRejected.size() == static_cast<std::size_t>(TrackCuts::kNCuts)) {
+    // the cuts rejecting most tracks first, ties keep the enum order
+    std::stable_sort(mCompiledCuts.begin(), mCompiledCuts.end(), [&nRejected](TrackCuts a, TrackCuts b) {
+      return nRejected[static_cast<int>(a)] > nRejected[static_cast<int>(b)];
+    });
+  } else if (!nRejected.empty()) {
+    LOG(warning) << "Track selection, " << nRejected.size() << " rejection counters given instead of " << static_cast<int>(TrackCuts::kNCuts) << ", keeping the default order";
+  }
+  mIsCompiled = true;
+  std::string order;
+  for (const auto& cut : mCompiledCuts) {
+    order += " " + mCutNames[static_cast<int>(cut)];
+  }
+  LOG(info) << "Track selection, compiled " << mCompiledCuts.size() << " cuts:" << order;
+}
+
+uint64_t TrackSelection::GetConfigurationHash() const
+{
+  // FNV-1a over the canonical list of the cut values
+  uint64_t hash = 14695981039346656037ull;
+  auto addBytes = [&hash](const void* data, std::size_t size) {
+    const auto* bytes = static_cast<const uint8_t*>(data);
+    for (std::size_t i = 0; i < size; i++) {
+      hash = (hash ^ bytes[i]) * 1099511628211ull;
+    }
+  };
+  auto addInt = [&addBytes](int64_t value) { addBytes(&value, sizeof(value)); };
+  auto addFloat = [&addBytes](float value) {
+    if (value == 0.f) {
+      value = 0.f; // same hash for -0 and +0
+    }
+    addBytes(&value, sizeof(value));
+  };
+
+  addInt(static_cast<int64_t>(mTrackType));
+  addFloat(mMinPt);
+  addFloat(mMaxPt);
+  addFloat(mMinEta);
+  addFloat(mMaxEta);
+  addInt(mMinNClustersTPC);
+  addInt(mMinNCrossedRowsTPC);
+  addInt(mMinNClustersITS);
+  addFloat(mMaxChi2PerClusterTPC);
+  addFloat(mMaxChi2PerClusterITS);
+  addFloat(mMinNCrossedRowsOverFindableClustersTPC);
+  addFloat(mMaxTPCFractionSharedCls);
+  addInt(mRequireITSRefit);
+  addInt(mRequireTPCRefit);
+  addInt(mRequireGoldenChi2);
+  addFloat(mMaxDcaZ);
+  if (mMaxDcaXYPtDep) {
+    for (const float pt : {0.1f, 0.2f, 0.5f, 1.f, 2.f, 5.f, 10.f, 50.f}) {
+      addFloat(mMaxDcaXYPtDep(pt));
+    }
+  } else {
+    addFloat(mMaxDcaXY);
+  }
+  // the ITS requirements are all applied, so their order does not matter
+  auto itsHits = mRequiredITSHits;
+  std::sort(itsHits.begin(), itsHits.end());
+  itsHits.erase(std::unique(itsHits.begin(), itsHits.end()), itsHits.end());
+  addInt(itsHits.size());
+  for (const auto& [minHits, layerMask] : itsHits) {
+    addInt(minHits);
+    addInt(layerMask);
+  }
+  return hash;
+}
+
 void TrackSelection::print() const
 {
   LOG(info) << "Track selection:";
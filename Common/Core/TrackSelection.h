@@ -21,6 +21,7 @@
 #include <Rtypes.h>
 
 #include <cmath>
+#include <cstddef>
 #include <cstdint>
 #include <functional>
 #include <set>
@@ -74,6 +75,14 @@ class TrackSelection
   template <typename T>
   bool IsSelected(T const& track) const
   {
+    if (mIsCompiled) {
+      for (const auto& cut : mCompiledCuts) {
+        if (!IsSelected(track, cut)) {
+          return false;
+        }
+      }
+      return true;
+    }
     if (!IsSelected(track, TrackCuts::kTrackType)) {
       return false;
     }
@@ -157,6 +166,50 @@ class TrackSelection
     return flag;
   }
 
+  // Fills the IsSelectedMask() of all the tracks of the table, one cut at a time over the whole table,
+  // so that every pass only reads the columns of its cut. masks[i] corresponds to the i-th row.
+  template <typename TTracks>
+  void IsSelectedMask(TTracks const& tracks, std::vector<uint16_t>& masks) const
+  {
+    masks.assign(tracks.size(), 0);
+    for (int i = 0; i < static_cast<int>(TrackCuts::kNCuts); i++) {
+      const auto cut = static_cast<TrackCuts>(i);
+      const uint16_t bit = 1UL << i;
+      if (!CanReject(cut)) {
+        for (auto& mask : masks) {
+          mask |= bit;
+        }
+        continue;
+      }
+      std::size_t iTrack = 0;
+      for (const auto& track : tracks) {
+        if (IsSelected(track, cut)) {
+          masks[iTrack] |= bit;
+        }
+        iTrack++;
+      }
+    }
+  }
+
+  // Increments nRejected[cut] for every cut the track fails, to be given to CompileSelection()
+  template <typename T>
+  void CountRejections(T const& track, std::vector<uint64_t>& nRejected) const
+  {
+    nRejected.resize(static_cast<int>(TrackCuts::kNCuts), 0);
+    const uint16_t mask = IsSelectedMask(track);
+    for (int i = 0; i < static_cast<int>(TrackCuts::kNCuts); i++) {
+      if (!(mask & (1UL << i))) {
+        nRejected[i]++;
+      }
+    }
+  }
+
+  /// @brief Switch IsSelected(track) to the list of cuts which can reject a track, in the enum order or,
+  /// if rejection counters (see CountRejections()) are given, from the most to the least rejecting one.
+  /// The decision is unchanged, only the number of checks per track. Any setter switches back to the full list.
+  void CompileSelection(const std::vector<uint64_t>& nRejected = {});
+  bool IsCompiled() const { return mIsCompiled; }
+
   // Temporary function to check if track passes a given selection criteria. To be replaced by framework filters.
   template <typename T>
   bool IsSelected(T const& track, const TrackCuts& cut) const
@@ -235,14 +288,24 @@ class TrackSelection
   void SetRequireHitsInITSLayers(int8_t minNRequiredHits, std::set<uint8_t> requiredLayers);
   void SetRequireNoHitsInITSLayers(std::set<uint8_t> excludedLayers);
   /// @brief Reset ITS requirements
-  void ResetITSRequirements() { mRequiredITSHits.clear(); }
+  void ResetITSRequirements()
+  {
+    mRequiredITSHits.clear();
+    mIsCompiled = false;
+  }
   void SetMaxTPCFractionSharedCls(float maxTPCFractionSharedCls);
 
+  /// @brief Hash of the cut values, equal for two selections with the same cuts whatever the order of the setters.
+  /// The pT dependent DCAxy cut is taken into account through its values at a fixed set of pT points
+  uint64_t GetConfigurationHash() const;
+
   /// @brief Print the track selection
   void print() const;
 
  private:
   bool FulfillsITSHitRequirements(uint8_t itsClusterMap) const;
+  // false if the cut passes for any track with the current settings
+  bool CanReject(TrackCuts cut) const;
 
   o2::aod::track::TrackTypeEnum mTrackType{o2::aod::track::TrackTypeEnum::Track};
 
@@ -271,6 +334,10 @@ class TrackSelection
   // vector of ITS requirements (minNRequiredHits, bitmask of requiredLayers)
   std::vector<std::pair<int8_t, uint8_t>> mRequiredITSHits{};
 
+  // compiled selection, see CompileSelection()
+  std::vector<TrackCuts> mCompiledCuts{}; //!
+  bool mIsCompiled{false};                //!
+
   ClassDefNV(TrackSelection, 2);
 };
 
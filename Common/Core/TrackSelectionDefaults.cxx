@@ -23,6 +23,8 @@
 #include <Framework/Logger.h>
 
 #include <cmath>
+#include <cstdint>
+#include <string>
 
 // Default track selection requiring one hit in the SPD
 TrackSelection getGlobalTrackSelection()
@@ -149,3 +151,85 @@ TrackSelection getJEGlobalTrackSelectionRun2()
 
   return selectedTracks;
 }
+
+namespace trackselectionregistry
+{
+static_assert(kNSelections <= 32, "the registered selections are stored in a 32-bit column");
+
+const char* selectionNames[kNSelections] = {
+  "GlobalTrack",
+  "GlobalTrackSDD",
+  "GlobalTrackRun3ITSibAny",
+  "GlobalTrackRun3ITSallAny",
+  "GlobalTrackRun3ITSall7Layers",
+  "GlobalTrackRun3ITSibTwo",
+  "GlobalTrackRun3ITSibFirst",
+  "GlobalTrackRun3ITSibAnyPPPass3",
+  "GlobalTrackRun3ITSallAnyPPPass3",
+  "GlobalTrackRun3ITSall7LayersPPPass3",
+  "GlobalTrackRun3ITSibTwoPPPass3",
+  "GlobalTrackRun3ITSibFirstPPPass3",
+  "GlobalTrackRun3HF",
+  "GlobalTrackRun3Nuclei",
+  "JEGlobalTrackRun2"};
+
+TrackSelection getSelection(int selection)
+{
+  switch (selection) {
+    case kGlobalTrack:
+      return getGlobalTrackSelection();
+    case kGlobalTrackSDD:
+      return getGlobalTrackSelectionSDD();
+    case kGlobalTrackRun3ITSibAny:
+      return getGlobalTrackSelectionRun3ITSMatch(TrackSelection::GlobalTrackRun3ITSMatching::Run3ITSibAny);
+    case kGlobalTrackRun3ITSallAny:
+      return getGlobalTrackSelectionRun3ITSMatch(TrackSelection::GlobalTrackRun3ITSMatching::Run3ITSallAny);
+    case kGlobalTrackRun3ITSall7Layers:
+      return getGlobalTrackSelectionRun3ITSMatch(TrackSelection::GlobalTrackRun3ITSMatching::Run3ITSall7Layers);
+    case kGlobalTrackRun3ITSibTwo:
+      return getGlobalTrackSelectionRun3ITSMatch(TrackSelection::GlobalTrackRun3ITSMatching::Run3ITSibTwo);
+    case kGlobalTrackRun3ITSibFirst:
+      return getGlobalTrackSelectionRun3ITSMatch(TrackSelection::GlobalTrackRun3ITSMatching::Run3ITSibFirst);
+    case kGlobalTrackRun3ITSibAnyPPPass3:
+      return getGlobalTrackSelectionRun3ITSMatch(TrackSelection::GlobalTrackRun3ITSMatching::Run3ITSibAny, TrackSelection::GlobalTrackRun3DCAxyCut::ppPass3);
+    case kGlobalTrackRun3ITSallAnyPPPass3:
+      return getGlobalTrackSelectionRun3ITSMatch(TrackSelection::GlobalTrackRun3ITSMatching::Run3ITSallAny, TrackSelection::GlobalTrackRun3DCAxyCut::ppPass3);
+    case kGlobalTrackRun3ITSall7LayersPPPass3:
+      return getGlobalTrackSelectionRun3ITSMatch(TrackSelection::GlobalTrackRun3ITSMatching::Run3ITSall7Layers, TrackSelection::GlobalTrackRun3DCAxyCut::ppPass3);
+    case kGlobalTrackRun3ITSibTwoPPPass3:
+      return getGlobalTrackSelectionRun3ITSMatch(TrackSelection::GlobalTrackRun3ITSMatching::Run3ITSibTwo, TrackSelection::GlobalTrackRun3DCAxyCut::ppPass3);
+    case kGlobalTrackRun3ITSibFirstPPPass3:
+      return getGlobalTrackSelectionRun3ITSMatch(TrackSelection::GlobalTrackRun3ITSMatching::Run3ITSibFirst, TrackSelection::GlobalTrackRun3DCAxyCut::ppPass3);
+    case kGlobalTrackRun3HF:
+      return getGlobalTrackSelectionRun3HF();
+    case kGlobalTrackRun3Nuclei:
+      return getGlobalTrackSelectionRun3Nuclei();
+    case kJEGlobalTrackRun2:
+      return getJEGlobalTrackSelectionRun2();
+    default:
+      LOG(fatal) << "trackselectionregistry::getSelection with undefined selection " << selection;
+      return TrackSelection();
+  }
+}
+
+int findSelection(const std::string& name)
+{
+  for (int i = 0; i < kNSelections; i++) {
+    if (name == selectionNames[i]) {
+      return i;
+    }
+  }
+  return -1;
+}
+
+int findSelection(const TrackSelection& trackSelection)
+{
+  const uint64_t hash = trackSelection.GetConfigurationHash();
+  for (int i = 0; i < kNSelections; i++) {
+    if (getSelection(i).GetConfigurationHash() == hash) {
+      return i;
+    }
+  }
+  return -1;
+}
+} // namespace trackselectionregistry
@@ -20,6 +20,8 @@
 
 #include "Common/Core/TrackSelection.h"
 
+#include <string>
+
 // Default track selection requiring one hit in the SPD
 TrackSelection getGlobalTrackSelection();
 
@@ -40,4 +42,41 @@ TrackSelection getGlobalTrackSelectionRun3HF();
 // Global track selection for Run2 JE Hybrid tracks requiring one hit in the SPD and reduced set of cuts
 TrackSelection getJEGlobalTrackSelectionRun2();
 
+// Registry of the standard selections evaluated once per data frame by the track-selection task and published
+// as bits of the TrackSelectionBits table: bit i corresponds to the i-th registered selection.
+// Selections with the same cuts share the configuration hash, the lookup by hash returns the first of them.
+namespace trackselectionregistry
+{
+enum Selection : int {
+  kGlobalTrack = 0,
+  kGlobalTrackSDD,
+  kGlobalTrackRun3ITSibAny,
+  kGlobalTrackRun3ITSallAny,
+  kGlobalTrackRun3ITSall7Layers,
+  kGlobalTrackRun3ITSibTwo,
+  kGlobalTrackRun3ITSibFirst,
+  kGlobalTrackRun3ITSibAnyPPPass3,
+  kGlobalTrackRun3ITSallAnyPPPass3,
+  kGlobalTrackRun3ITSall7LayersPPPass3,
+  kGlobalTrackRun3ITSibTwoPPPass3,
+  kGlobalTrackRun3ITSibFirstPPPass3,
+  kGlobalTrackRun3HF,
+  kGlobalTrackRun3Nuclei,
+  kJEGlobalTrackRun2,
+  kNSelections
+};
+
+extern const char* selectionNames[kNSelections];
+
+// Selection registered with the given index
+TrackSelection getSelection(int selection);
+
+// Index of the selection with the given name, or -1 if not registered
+int findSelection(const std::string& name);
+
+// Index of the first registered selection with the same cuts, or -1 if not registered.
+// A task can then read the bit instead of calling IsSelected(), and fall back to it for -1
+int findSelection(const TrackSelection& trackSelection);
+} // namespace trackselectionregistry
+
 #endif // COMMON_CORE_TRACKSELECTIONDEFAULTS_H_
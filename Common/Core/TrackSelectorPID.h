@@ -23,7 +23,9 @@
 
 #include <TPDGCode.h>
 
+#include <cstddef>
 #include <cstdint>
+#include <vector>
 
 /// Class for track selection using PID detectors
 
@@ -689,6 +691,67 @@ class TrackSelectorPidBase
   }
 };
 
+/// Cache of the PID selection status of the tracks of a table, with 2 bits per track.
+/// The status of a track is computed at the first request and read back for the other candidates sharing the same track.
+/// The tracks are identified by their global index, the cache has to be reset for each new table of tracks.
+class TrackSelectorPidStatusCache
+{
+ public:
+  /// Clears the cache for a table of tracks
+  /// \param nTracks  number of tracks of the table
+  void reset(std::size_t nTracks)
+  {
+    mStatus.assign((nTracks + NTracksPerWord - 1) / NTracksPerWord, 0);
+    mCached.assign((nTracks + NBitsPerWord - 1) / NBitsPerWord, 0);
+    mNTracks = nTracks;
+  }
+
+  /// Computes the status of all the tracks of the table at once
+  /// \param tracks  table of tracks
+  /// \param getStatus  function returning the status of a track
+  template <typename TTracks, typename TGetStatus>
+  void fill(const TTracks& tracks, TGetStatus&& getStatus)
+  {
+    reset(tracks.size());
+    for (const auto& track : tracks) {
+      store(track.globalIndex(), getStatus(track));
+    }
+  }
+
+  /// Returns the status of a track, computed with getStatus if the track is not in the cache yet
+  /// \param track  track
+  /// \param getStatus  function returning the status of a track
+  /// \return PID selection status (see TrackSelectorPID::Status)
+  template <typename T, typename TGetStatus>
+  TrackSelectorPID::Status status(const T& track, TGetStatus&& getStatus)
+  {
+    const auto index = static_cast<std::size_t>(track.globalIndex());
+    if (index >= mNTracks) {
+      return getStatus(track);
+    }
+    if (!((mCached[index / NBitsPerWord] >> (index % NBitsPerWord)) & 1u)) {
+      store(index, getStatus(track));
+    }
+    return static_cast<TrackSelectorPID::Status>((mStatus[index / NTracksPerWord] >> (2 * (index % NTracksPerWord))) & 3u);
+  }
+
+ private:
+  static constexpr std::size_t NBitsPerWord = 64;
+  static constexpr std::size_t NTracksPerWord = NBitsPerWord / 2;
+
+  void store(std::size_t index, TrackSelectorPID::Status status)
+  {
+    const auto shift = 2 * (index % NTracksPerWord);
+    auto& word = mStatus[index / NTracksPerWord];
+    word = (word & ~(uint64_t{3} << shift)) | (static_cast<uint64_t>(status) << shift);
+    mCached[index / NBitsPerWord] |= uint64_t{1} << (index % NBitsPerWord);
+  }
+
+  std::size_t mNTracks = 0;
+  std::vector<uint64_t> mStatus; ///< 2 bits per track with the status
+  std::vector<uint64_t> mCached; ///< 1 bit per track, set once the status is stored
+};
+
 // Predefined types
 using TrackSelectorEl = TrackSelectorPidBase<PDG_t::kElectron>;                       // El
 using TrackSelectorMu = TrackSelectorPidBase<PDG_t::kMuonMinus>;                      // Mu
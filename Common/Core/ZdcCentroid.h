@@ -0,0 +1,65 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file ZdcCentroid.h
+/// \brief Centroid of the spectator neutrons on the front face of the ZN calorimeters, used for the spectator plane
+///
+/// The centroid is the mean position of the 4 towers of a ZN weighted with their energies to the power alpha
+/// (saturation correction) and scaled with a correction depending on the number of spectator nucleons,
+/// estimated from the common PM energy.
+///
+///          | 3 | 4 |
+/// beam out | 1 | 2 | --> x       (ZNC)
+///
+///          | 3 | 4 |
+///    <-- x | 1 | 2 |   beam in   (ZNA)
+
+#ifndef COMMON_CORE_ZDCCENTROID_H_
+#define COMMON_CORE_ZDCCENTROID_H_
+
+#include <array>
+#include <cmath>
+
+namespace o2::common::zdc
+{
+
+constexpr int NTowers = 4;                                                // towers of one ZN
+constexpr float BeamEnergy = 5.36 * 0.5;                                  // energy per nucleon (TeV) of the LHC Run 3 Pb-Pb collisions
+constexpr float SaturationAlpha = 0.395;                                  // exponent of the tower energies in the weights
+constexpr std::array<float, NTowers> TowerX = {-1.75, 1.75, -1.75, 1.75}; // x of the tower centres (cm)
+constexpr std::array<float, NTowers> TowerY = {-1.75, -1.75, 1.75, 1.75}; // y of the tower centres (cm)
+constexpr float NoCentroid = 999.;                                        // centroid of a ZN without energy in the towers
+
+/// centroid (x, y) in cm of one ZN from the energies of its towers and its common energy,
+/// the x axis of ZNC is flipped as the calorimeter faces the other way
+template <typename T>
+inline std::array<float, 2> znCentroid(T const& towerEnergies, float commonEnergy, bool isZNC)
+{
+  float numX = 0., numY = 0., den = 0.;
+  for (int i = 0; i < NTowers; i++) {
+    if (towerEnergies[i] > 0.) {
+      float w = std::pow(towerEnergies[i], SaturationAlpha);
+      numX += (isZNC ? -TowerX[i] : TowerX[i]) * w;
+      numY += TowerY[i] * w;
+      den += w;
+    }
+  }
+  if (den == 0.) {
+    return {NoCentroid, NoCentroid};
+  }
+  float nSpec = commonEnergy / BeamEnergy;
+  float c = 1.89358 - 0.71262 / (nSpec + 0.71789);
+  return {c * numX / den, c * numY / den};
+}
+
+} // namespace o2::common::zdc
+
+#endif // COMMON_CORE_ZDCCENTROID_H_
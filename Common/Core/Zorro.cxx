@@ -16,8 +16,6 @@
 
 #include <CCDB/BasicCCDBManager.h>
 #include <CommonConstants/LHCConstants.h>
-#include <CommonDataFormat/IRFrame.h>
-#include <CommonDataFormat/InteractionRecord.h>
 #include <CommonUtils/StringUtils.h>
 #include <Framework/HistogramRegistry.h>
 #include <Framework/HistogramSpec.h>
@@ -37,8 +35,6 @@
 #include <string>
 #include <vector>
 
-using o2::InteractionRecord;
-
 namespace
 {
 int findBin(TH1* hist, const std::string& label)
@@ -192,13 +188,18 @@ std::vector<int> Zorro::initCCDB(o2::ccdb::BasicCCDBManager* ccdb, int runNumber
   setupHelpers(timestamp);
   mLastBCglobalId = 0;
   mLastSelectedIdx = 0;
+  mLastResultValid = false;
   mTOIs.clear();
   mTOIidx.clear();
+  mTOImask.reset();
   std::vector<std::string> tokens = o2::utils::Str::tokenize(tois, ','); // tokens are trimmed
   for (auto const& token : tokens) {
     int bin = findBin(mSelections, token) - 2;
     mTOIs.push_back(token);
     mTOIidx.push_back(bin);
+    if (bin >= 0 && bin < static_cast<int>(mTOImask.size())) {
+      mTOImask.set(bin);
+    }
   }
   mTOIcounts.resize(mTOIs.size(), 0);
   mATcounts.resize(mSelections->GetNbinsX() - 2, 0);
@@ -216,40 +217,62 @@ std::vector<int> Zorro::initCCDB(o2::ccdb::BasicCCDBManager* ccdb, int runNumber
   return mTOIidx;
 }
 
+size_t Zorro::findFirstCandidate(size_t start, uint64_t bcMin) const
+{ // First range at or after start which does not end before bcMin, all the previous ones are ending before it
+  if (start >= mBCmaxPrefix.size() || mBCmaxPrefix[start] >= bcMin) {
+    return start;
+  }
+  if (start + 1 < mBCmaxPrefix.size() && mBCmaxPrefix[start + 1] >= bcMin) { /// Monotonic cursor: most of the queries land on the next range
+    return start + 1;
+  }
+  return std::lower_bound(mBCmaxPrefix.begin() + start, mBCmaxPrefix.end(), bcMin) - mBCmaxPrefix.begin();
+}
+
 std::bitset<128> Zorro::fetch(uint64_t bcGlobalId, uint64_t tolerance)
 {
+  if (mLastResultValid && bcGlobalId == mLastBCglobalId && tolerance == mLastTolerance) { /// Repeated query, e.g. from isSelected and getTriggerOfInterestResults on the same collision
+    return mLastResult;
+  }
   mLastResult.reset();
-  if (bcGlobalId < mBCranges.front().getMin().toLong() - tolerance || bcGlobalId > mBCranges.back().getMax().toLong() + tolerance) {
+  if (bcGlobalId < mBCmin.front() - tolerance || bcGlobalId > mBCmax.back() + tolerance) {
     setupHelpers((mOrbitResetTimestamp + static_cast<int64_t>(bcGlobalId * o2::constants::lhc::LHCBunchSpacingNS * 1e-3)) / 1000);
   }
 
-  o2::dataformats::IRFrame bcFrame{InteractionRecord::long2IR(bcGlobalId) - tolerance, InteractionRecord::long2IR(bcGlobalId) + tolerance};
+  const uint64_t frameMin = bcGlobalId > tolerance ? bcGlobalId - tolerance : 0;
+  const uint64_t frameMax = bcGlobalId + tolerance;
   if (bcGlobalId < mLastBCglobalId) { /// Handle the possible discontinuity in the BC processed by the analyses
     mLastSelectedIdx = 0;
   }
-  uint64_t lastSelectedIdx = mLastSelectedIdx;
   mLastBCglobalId = bcGlobalId;
-  for (size_t i = mLastSelectedIdx; i < mBCranges.size(); i++) {
-    if (!mBCranges[i].isOutside(bcFrame)) {
-      for (int iMask{0}; iMask < 2; ++iMask) {
-        for (int iTOI{0}; iTOI < 64; ++iTOI) {
-          if (mZorroHelpers->at(i).selMask[iMask] & (1ull << iTOI)) {
-            mLastResult.set(iMask * 64 + iTOI, 1);
-            if (!mAccountedBCranges[i]) {
-              mATcounts[iMask * 64 + iTOI]++;
-              if (mAnalysedTriggers) {
-                mAnalysedTriggers->Fill(iMask * 64 + iTOI);
-              }
+  mLastTolerance = tolerance;
+  mLastResultValid = true;
+
+  uint64_t lastSelectedIdx = mLastSelectedIdx;
+  /// All the ranges before the first candidate end before the BC frame, the cursor moves to the last of them
+  size_t first = findFirstCandidate(mLastSelectedIdx, frameMin);
+  if (first > mLastSelectedIdx) {
+    mLastSelectedIdx = first - 1;
+  }
+  for (size_t i = first; i < mBCmin.size(); i++) {
+    if (mBCmin[i] > frameMax) {
+      break;
+    } else if (mBCmax[i] >= frameMin) {
+      const auto& selMask = mSelMasks[i];
+      mLastResult |= selMask;
+      if (!mAccountedBCranges[i]) {
+        for (size_t iBit{0}; iBit < selMask.size(); ++iBit) {
+          if (selMask.test(iBit)) {
+            mATcounts[iBit]++;
+            if (mAnalysedTriggers) {
+              mAnalysedTriggers->Fill(iBit);
             }
           }
         }
       }
       mAccountedBCranges[i] = true;
       mLastSelectedIdx = mLastSelectedIdx == lastSelectedIdx-- ? i : mLastSelectedIdx; /// Decrease lastSelectedIdx to make sure this check is valid only in its first instance
-    } else if (mBCranges[i].getMax() < bcFrame.getMin()) {
+    } else {
       mLastSelectedIdx = i;
-    } else if (mBCranges[i].getMin() > bcFrame.getMax()) {
-      break;
     }
   }
   return mLastResult;
@@ -259,6 +282,9 @@ bool Zorro::isSelected(uint64_t bcGlobalId, uint64_t tolerance, TH2* ToiHisto)
 {
   uint64_t lastSelectedIdx = mLastSelectedIdx;
   fetch(bcGlobalId, tolerance);
+  if ((mLastResult & mTOImask).none()) {
+    return false;
+  }
   bool retVal{false};
   for (size_t i{0}; i < mTOIidx.size(); ++i) {
     if (mTOIidx[i] < 0) {
@@ -315,10 +341,18 @@ void Zorro::setupHelpers(int64_t timestamp)
   }
   mZorroHelpers = mCCDB->getSpecific<std::vector<ZorroHelper>>(mBaseCCDBPath + "ZorroHelpers", timestamp, {{"runNumber", std::to_string(mRunNumber)}});
   std::sort(mZorroHelpers->begin(), mZorroHelpers->end(), [](const auto& a, const auto& b) { return std::min(a.bcAOD, a.bcEvSel) < std::min(b.bcAOD, b.bcEvSel); });
-  mBCranges.clear();
-  mAccountedBCranges.clear();
-  for (const auto& helper : *mZorroHelpers) {
-    mBCranges.emplace_back(InteractionRecord::long2IR(std::min(helper.bcAOD, helper.bcEvSel)), InteractionRecord::long2IR(std::max(helper.bcAOD, helper.bcEvSel)));
+  const size_t nRanges = mZorroHelpers->size();
+  mBCmin.resize(nRanges);
+  mBCmax.resize(nRanges);
+  mBCmaxPrefix.resize(nRanges);
+  mSelMasks.resize(nRanges);
+  for (size_t i{0}; i < nRanges; ++i) {
+    const auto& helper = (*mZorroHelpers)[i];
+    mBCmin[i] = std::min(helper.bcAOD, helper.bcEvSel);
+    mBCmax[i] = std::max(helper.bcAOD, helper.bcEvSel);
+    mBCmaxPrefix[i] = i ? std::max(mBCmaxPrefix[i - 1], mBCmax[i]) : mBCmax[i];
+    mSelMasks[i] = (std::bitset<128>(helper.selMask[1]) << 64) | std::bitset<128>(helper.selMask[0]);
   }
-  mAccountedBCranges.resize(mBCranges.size(), false);
+  mAccountedBCranges.assign(nRanges, false);
+  mLastResultValid = false;
 }
@@ -22,7 +22,6 @@
 #include "ZorroHelper.h"
 #include "ZorroSummary.h"
 
-#include <CommonDataFormat/IRFrame.h>
 #include <Framework/HistogramRegistry.h>
 
 #include <TH1.h>
@@ -72,6 +71,7 @@ class Zorro
 
  private:
   void setupHelpers(int64_t timestamp);
+  size_t findFirstCandidate(size_t start, uint64_t bcMin) const;
 
   ZorroSummary mZorroSummary{"ZorroSummary", "ZorroSummary"};
 
@@ -89,12 +89,18 @@ class Zorro
   int mBCtolerance = 100;
   uint64_t mLastBCglobalId = 0;
   uint64_t mLastSelectedIdx = 0;
+  uint64_t mLastTolerance = 0;
+  bool mLastResultValid = false; /// mLastResult refers to mLastBCglobalId and mLastTolerance
   TH1D* mScalers = nullptr;
   TH1D* mSelections = nullptr;
   TH1D* mInspectedTVX = nullptr;
   std::bitset<128> mLastResult;
-  std::vector<bool> mAccountedBCranges; /// Avoid double accounting of inspected BC ranges
-  std::vector<o2::dataformats::IRFrame> mBCranges;
+  std::vector<bool> mAccountedBCranges;    /// Avoid double accounting of inspected BC ranges
+  std::vector<uint64_t> mBCmin;            /// Lower edges of the selected BC ranges, sorted
+  std::vector<uint64_t> mBCmax;            /// Upper edges of the selected BC ranges
+  std::vector<uint64_t> mBCmaxPrefix;      /// Running maximum of the upper edges, for the binary search
+  std::vector<std::bitset<128>> mSelMasks; /// Selection mask of each BC range
+  std::bitset<128> mTOImask;               /// Bits of the triggers of interest
   std::vector<ZorroHelper>* mZorroHelpers = nullptr;
   std::vector<std::string> mTOIs;
   std::vector<int> mTOIidx;
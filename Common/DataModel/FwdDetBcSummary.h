@@ -0,0 +1,91 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file FwdDetBcSummary.h
+/// \brief Per BC summary of the forward detectors (FT0, FV0, FDD, ZDC), joinable with the BCs table
+///
+/// The summed amplitudes per side, the times, the trigger masks and the ZN energies and times of the
+/// detector signals matched to the BC, together with the FDD coincidences and the bunch filling pattern
+/// of the BC, see fwd-det-bc-summary-table.
+
+#ifndef COMMON_DATAMODEL_FWDDETBCSUMMARY_H_
+#define COMMON_DATAMODEL_FWDDETBCSUMMARY_H_
+
+#include <Framework/AnalysisDataModel.h>
+
+#include <cstdint>
+
+namespace o2::aod
+{
+namespace fwdbcsummary
+{
+enum FwdBcFlags {
+  kHasFT0 = 0,      // FT0 signal in the BC
+  kHasFV0A,         // FV0A signal in the BC
+  kHasFDD,          // FDD signal in the BC
+  kHasZDC,          // ZDC signal in the BC
+  kFDDCoincidenceA, // two opposite FDDA channels (i, i + 4) with charge
+  kFDDCoincidenceC, // two opposite FDDC channels (i, i + 4) with charge
+  kHasBcPattern,    // the bunch filling pattern of the run was found
+  kIsBcColliding,   // both beams, B
+  kIsBcBeamAOnly,   // beam A only, A
+  kIsBcBeamCOnly,   // beam C only, C
+  kIsBcEmpty,       // no beam, E
+  kNFwdBcFlags
+};
+
+DECLARE_SOA_COLUMN(FwdAmpFT0A, fwdAmpFT0A, float);                   //! summed FT0A amplitude, -1 if no FT0
+DECLARE_SOA_COLUMN(FwdAmpFT0C, fwdAmpFT0C, float);                   //! summed FT0C amplitude, -1 if no FT0
+DECLARE_SOA_COLUMN(FwdAmpFV0A, fwdAmpFV0A, float);                   //! summed FV0A amplitude, -1 if no FV0A
+DECLARE_SOA_COLUMN(FwdAmpFDDA, fwdAmpFDDA, float);                   //! summed FDDA charge, -1 if no FDD
+DECLARE_SOA_COLUMN(FwdAmpFDDC, fwdAmpFDDC, float);                   //! summed FDDC charge, -1 if no FDD
+DECLARE_SOA_COLUMN(FwdTimeFT0A, fwdTimeFT0A, float);                 //! FT0A time, -999 if no FT0
+DECLARE_SOA_COLUMN(FwdTimeFT0C, fwdTimeFT0C, float);                 //! FT0C time, -999 if no FT0
+DECLARE_SOA_COLUMN(FwdTimeFV0A, fwdTimeFV0A, float);                 //! FV0A time, -999 if no FV0A
+DECLARE_SOA_COLUMN(FwdTimeFDDA, fwdTimeFDDA, float);                 //! FDDA time, -999 if no FDD
+DECLARE_SOA_COLUMN(FwdTimeFDDC, fwdTimeFDDC, float);                 //! FDDC time, -999 if no FDD
+DECLARE_SOA_COLUMN(FwdTriggerMaskFT0, fwdTriggerMaskFT0, uint8_t);   //! FT0 trigger mask, 0 if no FT0
+DECLARE_SOA_COLUMN(FwdTriggerMaskFV0A, fwdTriggerMaskFV0A, uint8_t); //! FV0A trigger mask, 0 if no FV0A
+DECLARE_SOA_COLUMN(FwdTriggerMaskFDD, fwdTriggerMaskFDD, uint8_t);   //! FDD trigger mask, 0 if no FDD
+DECLARE_SOA_COLUMN(FwdEnergyZNA, fwdEnergyZNA, float);               //! ZNA common energy, -999 if no ZDC
+DECLARE_SOA_COLUMN(FwdEnergyZNC, fwdEnergyZNC, float);               //! ZNC common energy, -999 if no ZDC
+DECLARE_SOA_COLUMN(FwdTimeZNA, fwdTimeZNA, float);                   //! ZNA time, -999 if no ZDC
+DECLARE_SOA_COLUMN(FwdTimeZNC, fwdTimeZNC, float);                   //! ZNC time, -999 if no ZDC
+DECLARE_SOA_COLUMN(FwdFlags, fwdFlags, uint16_t);                    //! bits of FwdBcFlags
+DECLARE_SOA_DYNAMIC_COLUMN(FwdFlagBit, fwdFlagBit, //! check a bit of FwdBcFlags
+                           [](uint16_t flags, int bit) -> bool { return (flags & (static_cast<uint16_t>(1) << bit)) > 0; });
+
+// opposite channels (i, i + 4) of one side of FDD both with charge, the coincidence used by the luminosity tasks
+template <typename T>
+inline bool hasFDDCoincidence(T const& charges)
+{
+  constexpr int NChannelPairs = 4;
+  for (int i = 0; i < NChannelPairs; i++) {
+    if (charges[i] > 0 && charges[i + NChannelPairs] > 0) {
+      return true;
+    }
+  }
+  return false;
+}
+} // namespace fwdbcsummary
+
+DECLARE_SOA_TABLE(FwdBcSummaries, "AOD", "FWDBCSUMMARY", //! forward detector summary of the BCs, joinable with the BCs table
+                  fwdbcsummary::FwdAmpFT0A, fwdbcsummary::FwdAmpFT0C, fwdbcsummary::FwdAmpFV0A, fwdbcsummary::FwdAmpFDDA, fwdbcsummary::FwdAmpFDDC,
+                  fwdbcsummary::FwdTimeFT0A, fwdbcsummary::FwdTimeFT0C, fwdbcsummary::FwdTimeFV0A, fwdbcsummary::FwdTimeFDDA, fwdbcsummary::FwdTimeFDDC,
+                  fwdbcsummary::FwdTriggerMaskFT0, fwdbcsummary::FwdTriggerMaskFV0A, fwdbcsummary::FwdTriggerMaskFDD,
+                  fwdbcsummary::FwdEnergyZNA, fwdbcsummary::FwdEnergyZNC, fwdbcsummary::FwdTimeZNA, fwdbcsummary::FwdTimeZNC,
+                  fwdbcsummary::FwdFlags,
+                  fwdbcsummary::FwdFlagBit<fwdbcsummary::FwdFlags>);
+
+using FwdBcSummary = FwdBcSummaries::iterator;
+} // namespace o2::aod
+
+#endif // COMMON_DATAMODEL_FWDDETBCSUMMARY_H_
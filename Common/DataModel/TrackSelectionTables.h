@@ -137,6 +137,11 @@ DECLARE_SOA_COLUMN(PassedDCAz, passedDCAz, bool);
 DECLARE_SOA_COLUMN(PassedITSHitsFB1, passedITSHitsFB1, bool);                         //! Passed the track cut: kITSHits defined for FB1
 DECLARE_SOA_COLUMN(PassedITSHitsFB2, passedITSHitsFB2, bool);                         //! Passed the track cut: kITSHits defined for FB2
 
+// Decisions of the registered selections (see trackselectionregistry in TrackSelectionDefaults.h)
+DECLARE_SOA_COLUMN(RegisteredSelectionBits, registeredSelectionBits, uint32_t); //! Bit i set if the track passed the i-th registered selection
+DECLARE_SOA_DYNAMIC_COLUMN(PassedRegisteredSelection, passedRegisteredSelection,  //! Checks the bit of a registered selection
+                           [](uint32_t bits, int selection) -> bool { return selection >= 0 && selection < 32 && ((bits >> selection) & 1u); });
+
 // Combo selections (not yet implemented, being thinking about it)
 // DECLARE_SOA_DYNAMIC_COLUMN(IsQualityTrack, isQualityTrack,
 //                          [](bool passedTrackType, bool passedTPCNCls, bool passedITSChi2NDF) -> bool { return (passedTrackType && passedTPCNCls && passedITSChi2NDF); }); //! Passed the combined track cut: kQualityTracks
@@ -188,6 +193,10 @@ DECLARE_SOA_TABLE(TrackSelectionExtension, "AOD", "TRACKSELEXTRA", //! Informati
                   track::PassedITSHitsFB1,
                   track::PassedITSHitsFB2);
 
+DECLARE_SOA_TABLE(TrackSelectionBits, "AOD", "TRACKSELBITS", //! Decisions of the registered track selections, evaluated once by the track-selection task
+                  track::RegisteredSelectionBits,
+                  track::PassedRegisteredSelection<track::RegisteredSelectionBits>);
+
 DECLARE_SOA_TABLE(FwdTracksDCA, "AOD", "FWDTRACKDCA", //! DCA information for the forward track
                   fwdtrack::FwdDcaX,
                   fwdtrack::FwdDcaY);
@@ -0,0 +1,356 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file aodConverter.cxx
+/// \brief Converts the BCs, TracksExtra, TracksQA, MFTTracks and McParticles tables to their latest version in one device
+
+/// Older AO2Ds need several converters to be analysed with the current data model, each of them running in its own device.
+/// This workflow converts all the tables in one device: the version of each input table is given once with the workflow
+/// options (e.g. --tracksExtraVersion 0 --tracksQAVersion 1), -1 meaning that the table does not need to be converted,
+/// and the process functions converting these versions directly to the latest one are enabled. The extended tables of
+/// the converted TracksExtra and MFTTracks are spawned as in tracks-extra-v002-converter and mft-tracks-converter.
+
+#include <Framework/AnalysisDataModel.h>
+#include <Framework/AnalysisHelpers.h>
+#include <Framework/AnalysisTask.h>
+#include <Framework/ConfigContext.h>
+#include <Framework/ConfigParamSpec.h>
+#include <Framework/Configurable.h>
+#include <Framework/InitContext.h>
+#include <Framework/Logger.h>
+#include <Framework/Variant.h>
+
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace o2;
+using namespace o2::framework;
+
+void customize(std::vector<ConfigParamSpec>& workflowOptions)
+{
+  workflowOptions.push_back(ConfigParamSpec{"bcsVersion", VariantType::Int, -1, {"version of the input BCs table to convert to 001 (0), -1 for no conversion"}});
+  workflowOptions.push_back(ConfigParamSpec{"tracksExtraVersion", VariantType::Int, -1, {"version of the input TracksExtra table to convert to 002 (0, 1), -1 for no conversion"}});
+  workflowOptions.push_back(ConfigParamSpec{"tracksQAVersion", VariantType::Int, -1, {"version of the input TracksQA table to convert to 003 (0, 1, 2), -1 for no conversion"}});
+  workflowOptions.push_back(ConfigParamSpec{"mftTracksVersion", VariantType::Int, -1, {"version of the input MFTTracks table to convert to 001 (0), -1 for no conversion"}});
+  workflowOptions.push_back(ConfigParamSpec{"mcParticlesVersion", VariantType::Int, -1, {"version of the input McParticles table to convert to 001 (0), -1 for no conversion"}});
+}
+
+#include <Framework/runDataProcessing.h>
+
+namespace
+{
+uint32_t itsClusterSizesFromMap(uint8_t itsClusterMap)
+{
+  // dummy cluster sizes, filled with overflows if a hit in the layer is present
+  uint32_t itsClusterSizes = 0;
+  for (int layer = 0; layer < 7; layer++) {
+    if (itsClusterMap & (1 << layer)) {
+      itsClusterSizes |= (0xf << (layer * 4));
+    }
+  }
+  return itsClusterSizes;
+}
+} // namespace
+
+struct AodConverter {
+  Produces<aod::BCs_001> bc_001;
+  Produces<aod::StoredTracksExtra_002> tracksExtra_002;
+  Produces<aod::TracksQA_003> tracksQA_003;
+  Produces<aod::StoredMFTTracks_001> mftTracks_001;
+  Produces<aod::StoredMcParticles_001> mcParticles_001;
+
+  void init(InitContext const&)
+  {
+    if (doprocessTracksExtraV000 && doprocessTracksExtraV001) {
+      LOGF(fatal, "Both processTracksExtraV000 and processTracksExtraV001 are enabled. Please choose only one!");
+    }
+    if (static_cast<int>(doprocessTracksQAV000) + static_cast<int>(doprocessTracksQAV001) + static_cast<int>(doprocessTracksQAV002) > 1) {
+      LOGF(fatal, "More than one of processTracksQAV000, processTracksQAV001 and processTracksQAV002 is enabled. Please choose only one!");
+    }
+  }
+
+  void processBCsV000(aod::BCs_000 const& bcTable)
+  {
+    bc_001.reserve(bcTable.size());
+    for (const auto& bc : bcTable) {
+      constexpr uint64_t EmptyTriggerInputs = 0;
+      bc_001(bc.runNumber(), bc.globalBC(), bc.triggerMask(), EmptyTriggerInputs);
+    }
+  }
+  PROCESS_SWITCH(AodConverter, processBCsV000, "process BCs v000-to-v001 conversion", false);
+
+  void processTracksExtraV000(aod::TracksExtra_000 const& tracksExtra_000)
+  {
+    tracksExtra_002.reserve(tracksExtra_000.size());
+    for (const auto& track0 : tracksExtra_000) {
+      int8_t TPCNClsFindableMinusPID = 0;
+      tracksExtra_002(track0.tpcInnerParam(),
+                      track0.flags(),
+                      itsClusterSizesFromMap(track0.itsClusterMap()),
+                      track0.tpcNClsFindable(),
+                      track0.tpcNClsFindableMinusFound(),
+                      TPCNClsFindableMinusPID,
+                      track0.tpcNClsFindableMinusCrossedRows(),
+                      track0.tpcNClsShared(),
+                      track0.trdPattern(),
+                      track0.itsChi2NCl(),
+                      track0.tpcChi2NCl(),
+                      track0.trdChi2(),
+                      track0.tofChi2(),
+                      track0.tpcSignal(),
+                      track0.trdSignal(),
+                      track0.length(),
+                      track0.tofExpMom(),
+                      track0.trackEtaEmcal(),
+                      track0.trackPhiEmcal(),
+                      track0.trackTime(),
+                      track0.trackTimeRes());
+    }
+  }
+  PROCESS_SWITCH(AodConverter, processTracksExtraV000, "process TracksExtra v000-to-v002 conversion", false);
+
+  void processTracksExtraV001(aod::TracksExtra_001 const& tracksExtra_001)
+  {
+    tracksExtra_002.reserve(tracksExtra_001.size());
+    for (const auto& track1 : tracksExtra_001) {
+      int8_t TPCNClsFindableMinusPID = 0;
+      tracksExtra_002(track1.tpcInnerParam(),
+                      track1.flags(),
+                      track1.itsClusterSizes(),
+                      track1.tpcNClsFindable(),
+                      track1.tpcNClsFindableMinusFound(),
+                      TPCNClsFindableMinusPID,
+                      track1.tpcNClsFindableMinusCrossedRows(),
+                      track1.tpcNClsShared(),
+                      track1.trdPattern(),
+                      track1.itsChi2NCl(),
+                      track1.tpcChi2NCl(),
+                      track1.trdChi2(),
+                      track1.tofChi2(),
+                      track1.tpcSignal(),
+                      track1.trdSignal(),
+                      track1.length(),
+                      track1.tofExpMom(),
+                      track1.trackEtaEmcal(),
+                      track1.trackPhiEmcal(),
+                      track1.trackTime(),
+                      track1.trackTimeRes());
+    }
+  }
+  PROCESS_SWITCH(AodConverter, processTracksExtraV001, "process TracksExtra v001-to-v002 conversion", false);
+
+  void processTracksQAV000(aod::TracksQA_000 const& tracksQA_000)
+  {
+    tracksQA_003.reserve(tracksQA_000.size());
+    for (const auto& trackQA : tracksQA_000) {
+      tracksQA_003(
+        trackQA.trackId(),
+        trackQA.tpcTime0(),
+        0.f, // dummy, not available in _000
+        trackQA.tpcdcaR(),
+        trackQA.tpcdcaZ(),
+        trackQA.tpcClusterByteMask(),
+        trackQA.tpcdEdxMax0R(),
+        trackQA.tpcdEdxMax1R(),
+        trackQA.tpcdEdxMax2R(),
+        trackQA.tpcdEdxMax3R(),
+        trackQA.tpcdEdxTot0R(),
+        trackQA.tpcdEdxTot1R(),
+        trackQA.tpcdEdxTot2R(),
+        trackQA.tpcdEdxTot3R(),
+        // dummy values, not available in _000
+        std::numeric_limits<int8_t>::min(),  // deltaRefContParamY
+        std::numeric_limits<int8_t>::min(),  // deltaRefContParamZ
+        std::numeric_limits<int8_t>::min(),  // deltaRefContParamSnp
+        std::numeric_limits<int8_t>::min(),  // deltaRefContParamTgl
+        std::numeric_limits<int8_t>::min(),  // deltaRefContParamQ2Pt
+        std::numeric_limits<int8_t>::min(),  // deltaRefGloParamY
+        std::numeric_limits<int8_t>::min(),  // deltaRefGloParamZ
+        std::numeric_limits<int8_t>::min(),  // deltaRefGloParamSnp
+        std::numeric_limits<int8_t>::min(),  // deltaRefGloParamTgl
+        std::numeric_limits<int8_t>::min(),  // deltaRefGloParamQ2Pt
+        std::numeric_limits<int8_t>::min(),  // dTofdX
+        std::numeric_limits<int8_t>::min()); // dTofdY
+    }
+  }
+  PROCESS_SWITCH(AodConverter, processTracksQAV000, "process TracksQA v000-to-v003 conversion", false);
+
+  void processTracksQAV001(aod::TracksQA_001 const& tracksQA_001)
+  {
+    tracksQA_003.reserve(tracksQA_001.size());
+    for (const auto& trackQA : tracksQA_001) {
+      tracksQA_003(
+        trackQA.trackId(),
+        trackQA.tpcTime0(),
+        0.f, // dummy, not available in _001
+        trackQA.tpcdcaR(),
+        trackQA.tpcdcaZ(),
+        trackQA.tpcClusterByteMask(),
+        trackQA.tpcdEdxMax0R(),
+        trackQA.tpcdEdxMax1R(),
+        trackQA.tpcdEdxMax2R(),
+        trackQA.tpcdEdxMax3R(),
+        trackQA.tpcdEdxTot0R(),
+        trackQA.tpcdEdxTot1R(),
+        trackQA.tpcdEdxTot2R(),
+        trackQA.tpcdEdxTot3R(),
+        trackQA.deltaRefContParamY(),
+        trackQA.deltaRefITSParamZ(),
+        trackQA.deltaRefContParamSnp(),
+        trackQA.deltaRefContParamTgl(),
+        trackQA.deltaRefContParamQ2Pt(),
+        trackQA.deltaRefGloParamY(),
+        trackQA.deltaRefGloParamZ(),
+        trackQA.deltaRefGloParamSnp(),
+        trackQA.deltaRefGloParamTgl(),
+        trackQA.deltaRefGloParamQ2Pt(),
+        // dummy values, not available in _001
+        std::numeric_limits<int8_t>::min(),  // dTofdX
+        std::numeric_limits<int8_t>::min()); // dTofdY
+    }
+  }
+  PROCESS_SWITCH(AodConverter, processTracksQAV001, "process TracksQA v001-to-v003 conversion", false);
+
+  void processTracksQAV002(aod::TracksQA_002 const& tracksQA_002)
+  {
+    tracksQA_003.reserve(tracksQA_002.size());
+    for (const auto& trackQA : tracksQA_002) {
+      tracksQA_003(
+        trackQA.trackId(),
+        trackQA.tpcTime0(),
+        0.f, // dummy, not available in _002
+        trackQA.tpcdcaR(),
+        trackQA.tpcdcaZ(),
+        trackQA.tpcClusterByteMask(),
+        trackQA.tpcdEdxMax0R(),
+        trackQA.tpcdEdxMax1R(),
+        trackQA.tpcdEdxMax2R(),
+        trackQA.tpcdEdxMax3R(),
+        trackQA.tpcdEdxTot0R(),
+        trackQA.tpcdEdxTot1R(),
+        trackQA.tpcdEdxTot2R(),
+        trackQA.tpcdEdxTot3R(),
+        trackQA.deltaRefContParamY(),
+        trackQA.deltaRefITSParamZ(),
+        trackQA.deltaRefContParamSnp(),
+        trackQA.deltaRefContParamTgl(),
+        trackQA.deltaRefContParamQ2Pt(),
+        trackQA.deltaRefGloParamY(),
+        trackQA.deltaRefGloParamZ(),
+        trackQA.deltaRefGloParamSnp(),
+        trackQA.deltaRefGloParamTgl(),
+        trackQA.deltaRefGloParamQ2Pt(),
+        trackQA.deltaTOFdX(),
+        trackQA.deltaTOFdZ());
+    }
+  }
+  PROCESS_SWITCH(AodConverter, processTracksQAV002, "process TracksQA v002-to-v003 conversion", false);
+
+  void processMFTTracksV000(aod::MFTTracks_000 const& mftTracks_000)
+  {
+    mftTracks_001.reserve(mftTracks_000.size());
+    for (const auto& track0 : mftTracks_000) {
+      uint64_t mftClusterSizesAndTrackFlags = 0;
+      int8_t nClusters = track0.nClusters();
+      for (int layer = 0; layer < 10; ++layer) {
+        mftClusterSizesAndTrackFlags &= ~(0x3fULL << (layer * 6));
+        mftClusterSizesAndTrackFlags |= (layer < nClusters) ? (1ULL << (layer * 6)) : 0;
+      }
+      mftTracks_001(track0.collisionId(),
+                    track0.x(),
+                    track0.y(),
+                    track0.z(),
+                    track0.phi(),
+                    track0.tgl(),
+                    track0.signed1Pt(),
+                    mftClusterSizesAndTrackFlags,
+                    track0.chi2(),
+                    track0.trackTime(),
+                    track0.trackTimeRes());
+    }
+  }
+  PROCESS_SWITCH(AodConverter, processMFTTracksV000, "process MFTTracks v000-to-v001 conversion", false);
+
+  void processMcParticlesV000(aod::StoredMcParticles_000 const& mcParticles_000)
+  {
+    mcParticles_001.reserve(mcParticles_000.size());
+    std::vector<int> mothers;
+    for (const auto& p : mcParticles_000) {
+      mothers.clear();
+      if (p.mother0Id() >= 0) {
+        mothers.push_back(p.mother0Id());
+      }
+      if (p.mother1Id() >= 0) {
+        mothers.push_back(p.mother1Id());
+      }
+
+      int daughters[2] = {-1, -1};
+      if (p.daughter0Id() >= 0 && p.daughter1Id() >= 0) {
+        daughters[0] = p.daughter0Id();
+        daughters[1] = p.daughter1Id();
+      } else if (p.daughter0Id() >= 0) {
+        daughters[0] = p.daughter0Id();
+        daughters[1] = p.daughter0Id();
+      }
+
+      mcParticles_001(p.mcCollisionId(), p.pdgCode(), p.statusCode(), p.flags(),
+                      mothers, daughters, p.weight(), p.px(), p.py(), p.pz(), p.e(),
+                      p.vx(), p.vy(), p.vz(), p.vt());
+    }
+  }
+  PROCESS_SWITCH(AodConverter, processMcParticlesV000, "process McParticles v000-to-v001 conversion", false);
+};
+
+/// Spawn the extended tables of the converted tables to avoid the call to the internal spawner and a consequent circular dependency
+struct AodConverterTracksExtraSpawner {
+  Spawns<aod::TracksExtra_002> tracksExtra_002;
+};
+
+struct AodConverterMFTTracksSpawner {
+  Spawns<aod::MFTTracks_001> mftTracks_001;
+};
+
+WorkflowSpec defineDataProcessing(ConfigContext const& cfgc)
+{
+  const int bcsVersion = cfgc.options().get<int>("bcsVersion");
+  const int tracksExtraVersion = cfgc.options().get<int>("tracksExtraVersion");
+  const int tracksQAVersion = cfgc.options().get<int>("tracksQAVersion");
+  const int mftTracksVersion = cfgc.options().get<int>("mftTracksVersion");
+  const int mcParticlesVersion = cfgc.options().get<int>("mcParticlesVersion");
+  if (bcsVersion > 0 || tracksExtraVersion > 1 || tracksQAVersion > 2 || mftTracksVersion > 0 || mcParticlesVersion > 0) {
+    LOGF(fatal, "aod-converter: no conversion for the requested input versions (BCs %d, TracksExtra %d, TracksQA %d, MFTTracks %d, McParticles %d)", bcsVersion, tracksExtraVersion, tracksQAVersion, mftTracksVersion, mcParticlesVersion);
+  }
+  if (bcsVersion < 0 && tracksExtraVersion < 0 && tracksQAVersion < 0 && mftTracksVersion < 0 && mcParticlesVersion < 0) {
+    LOGF(fatal, "aod-converter: no table to convert, please give the version of at least one input table");
+  }
+
+  std::vector<std::pair<std::string, bool>> processes{
+    {"processBCsV000", bcsVersion == 0},
+    {"processTracksExtraV000", tracksExtraVersion == 0},
+    {"processTracksExtraV001", tracksExtraVersion == 1},
+    {"processTracksQAV000", tracksQAVersion == 0},
+    {"processTracksQAV001", tracksQAVersion == 1},
+    {"processTracksQAV002", tracksQAVersion == 2},
+    {"processMFTTracksV000", mftTracksVersion == 0},
+    {"processMcParticlesV000", mcParticlesVersion == 0}};
+
+  WorkflowSpec workflow{adaptAnalysisTask<AodConverter>(cfgc, SetDefaultProcesses{processes})};
+  if (tracksExtraVersion >= 0) {
+    workflow.push_back(adaptAnalysisTask<AodConverterTracksExtraSpawner>(cfgc));
+  }
+  if (mftTracksVersion >= 0) {
+    workflow.push_back(adaptAnalysisTask<AodConverterMFTTracksSpawner>(cfgc));
+  }
+  return workflow;
+}
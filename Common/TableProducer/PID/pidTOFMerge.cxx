@@ -49,6 +49,7 @@
 
 #include <array>
 #include <cmath>
+#include <cstddef>
 #include <cstdint>
 #include <cstdlib>
 #include <memory>
@@ -620,8 +621,10 @@ struct tofPidMerge {
   HistogramRegistry histos{"Histos", {}, OutputObjHandlingPolicy::AnalysisObject};
 
   // Running variables
-  std::vector<int> mEnabledParticles;     // Vector of enabled PID hypotheses to loop on when making tables
-  std::vector<int> mEnabledParticlesFull; // Vector of enabled PID hypotheses to loop on when making full tables
+  std::vector<int> mEnabledParticles;                          // Vector of enabled PID hypotheses to loop on when making tables
+  std::vector<int> mEnabledParticlesFull;                      // Vector of enabled PID hypotheses to loop on when making full tables
+  uint32_t mEnabledSpeciesMask = 0;                            // Mask of the PID hypotheses enabled in tiny or full tables
+  std::vector<o2::pid::tof::TOFTrackResponse> mTrackResponses; // TOF response of the tracks of the current data frame
   void init(o2::framework::InitContext& initContext)
   {
     LOG(debug) << "Initializing the TOF PID Merge task";
@@ -633,6 +636,7 @@ struct tofPidMerge {
       o2::common::core::enableFlagIfTableRequired(initContext, "pidTOF" + particleNames[i], f);
       if (f == 1) {
         mEnabledParticles.push_back(i);
+        mEnabledSpeciesMask |= (1u << i);
       }
 
       // Then checking full tables
@@ -640,6 +644,7 @@ struct tofPidMerge {
       o2::common::core::enableFlagIfTableRequired(initContext, "pidTOFFull" + particleNames[i], f);
       if (f == 1) {
         mEnabledParticlesFull.push_back(i);
+        mEnabledSpeciesMask |= (1u << i);
       }
     }
     if (mEnabledParticlesFull.size() == 0 && mEnabledParticles.size() == 0) {
@@ -803,99 +808,89 @@ struct tofPidMerge {
     }
   }
 
-  // Makes the table empty for the given particle ID, filling it with dummy values
-  void makeTableEmpty(const int id, bool fullTable = false)
+  // Fills the table for the given particle ID with the given resolution and number of sigmas (only the latter for tiny tables)
+  void makeTable(const int id, bool fullTable, const float resolution, const float nsigma)
   {
     switch (id) {
       case kIdxEl:
         if (fullTable) {
-          tablePIDFullEl(-999.f, -999.f);
+          tablePIDFullEl(resolution, nsigma);
         } else {
-          aod::pidtof_tiny::binning::packInTable(-999.f, tablePIDEl);
+          aod::pidtof_tiny::binning::packInTable(nsigma, tablePIDEl);
         }
         break;
       case kIdxMu:
         if (fullTable) {
-          tablePIDFullMu(-999.f, -999.f);
+          tablePIDFullMu(resolution, nsigma);
         } else {
-          aod::pidtof_tiny::binning::packInTable(-999.f, tablePIDMu);
+          aod::pidtof_tiny::binning::packInTable(nsigma, tablePIDMu);
         }
         break;
       case kIdxPi:
         if (fullTable) {
-          tablePIDFullPi(-999.f, -999.f);
+          tablePIDFullPi(resolution, nsigma);
         } else {
-          aod::pidtof_tiny::binning::packInTable(-999.f, tablePIDPi);
+          aod::pidtof_tiny::binning::packInTable(nsigma, tablePIDPi);
         }
         break;
       case kIdxKa:
         if (fullTable) {
-          tablePIDFullKa(-999.f, -999.f);
+          tablePIDFullKa(resolution, nsigma);
         } else {
-          aod::pidtof_tiny::binning::packInTable(-999.f, tablePIDKa);
+          aod::pidtof_tiny::binning::packInTable(nsigma, tablePIDKa);
         }
         break;
       case kIdxPr:
         if (fullTable) {
-          tablePIDFullPr(-999.f, -999.f);
+          tablePIDFullPr(resolution, nsigma);
         } else {
-          aod::pidtof_tiny::binning::packInTable(-999.f, tablePIDPr);
+          aod::pidtof_tiny::binning::packInTable(nsigma, tablePIDPr);
         }
         break;
       case kIdxDe:
         if (fullTable) {
-          tablePIDFullDe(-999.f, -999.f);
+          tablePIDFullDe(resolution, nsigma);
         } else {
-          aod::pidtof_tiny::binning::packInTable(-999.f, tablePIDDe);
+          aod::pidtof_tiny::binning::packInTable(nsigma, tablePIDDe);
         }
         break;
       case kIdxTr:
         if (fullTable) {
-          tablePIDFullTr(-999.f, -999.f);
+          tablePIDFullTr(resolution, nsigma);
         } else {
-          aod::pidtof_tiny::binning::packInTable(-999.f, tablePIDTr);
+          aod::pidtof_tiny::binning::packInTable(nsigma, tablePIDTr);
         }
         break;
       case kIdxHe:
         if (fullTable) {
-          tablePIDFullHe(-999.f, -999.f);
+          tablePIDFullHe(resolution, nsigma);
         } else {
-          aod::pidtof_tiny::binning::packInTable(-999.f, tablePIDHe);
+          aod::pidtof_tiny::binning::packInTable(nsigma, tablePIDHe);
         }
         break;
       case kIdxAl:
         if (fullTable) {
-          tablePIDFullAl(-999.f, -999.f);
+          tablePIDFullAl(resolution, nsigma);
         } else {
-          aod::pidtof_tiny::binning::packInTable(-999.f, tablePIDAl);
+          aod::pidtof_tiny::binning::packInTable(nsigma, tablePIDAl);
         }
         break;
       default:
-        LOG(fatal) << "Wrong particle ID in makeTableEmpty() for " << (fullTable ? "full" : "tiny") << " tables";
+        LOG(fatal) << "Wrong particle ID in makeTable() for " << (fullTable ? "full" : "tiny") << " tables";
         break;
     }
   }
 
-  void process(aod::BCs const&) {}
-
-  template <o2::track::PID::ID pid>
-  using ResponseImplementation = o2::pid::tof::ExpTimes<Run3TrksWtofWevTime::iterator, pid>;
-  void processRun3(Run3TrksWtofWevTime const& tracks,
-                   aod::Collisions const&,
-                   aod::BCsWithTimestamps const& bcs)
+  // Makes the table empty for the given particle ID, filling it with dummy values
+  void makeTableEmpty(const int id, bool fullTable = false)
   {
-    constexpr auto responseEl = ResponseImplementation<PID::Electron>();
-    constexpr auto responseMu = ResponseImplementation<PID::Muon>();
-    constexpr auto responsePi = ResponseImplementation<PID::Pion>();
-    constexpr auto responseKa = ResponseImplementation<PID::Kaon>();
-    constexpr auto responsePr = ResponseImplementation<PID::Proton>();
-    constexpr auto responseDe = ResponseImplementation<PID::Deuteron>();
-    constexpr auto responseTr = ResponseImplementation<PID::Triton>();
-    constexpr auto responseHe = ResponseImplementation<PID::Helium3>();
-    constexpr auto responseAl = ResponseImplementation<PID::Alpha>();
-
-    tofResponse->processSetup(bcs.iteratorAt(0)); // Update the calibration parameters
+    makeTable(id, fullTable, -999.f, -999.f);
+  }
 
+  // Fills all the enabled tables, with the TOF response of all the mass hypotheses computed in one pass per track
+  template <typename TrackType, typename TTracks>
+  void makeTables(TTracks const& tracks)
+  {
     for (auto const& pidId : mEnabledParticles) {
       reserveTable(pidId, tracks.size(), false);
     }
@@ -904,10 +899,12 @@ struct tofPidMerge {
       reserveTable(pidId, tracks.size(), true);
     }
 
-    float resolution = 1.f; // Last resolution assigned
-    float nsigma = 0;
+    o2::pid::tof::ExpTimesAllSpecies<TrackType>::ComputeBatch(tofResponse->parameters, tracks, mEnabledSpeciesMask, mTrackResponses);
+
+    std::size_t iTrack = 0;
     for (auto const& trk : tracks) { // Loop on all tracks
-      if (!trk.has_collision()) {    // Track was not assigned, cannot compute NSigma (no event time) -> filling with empty table
+      const auto& response = mTrackResponses[iTrack++];
+      if (!trk.has_collision()) { // Track was not assigned, cannot compute NSigma (no event time) -> filling with empty table
         for (auto const& pidId : mEnabledParticles) {
           makeTableEmpty(pidId, false);
         }
@@ -918,289 +915,63 @@ struct tofPidMerge {
       }
 
       for (auto const& pidId : mEnabledParticles) { // Loop on enabled particle hypotheses
-        switch (pidId) {
-          case kIdxEl: {
-            nsigma = responseEl.GetSeparation(tofResponse->parameters, trk);
-            aod::pidtof_tiny::binning::packInTable(nsigma, tablePIDEl);
-            break;
-          }
-          case kIdxMu: {
-            nsigma = responseMu.GetSeparation(tofResponse->parameters, trk);
-            aod::pidtof_tiny::binning::packInTable(nsigma, tablePIDMu);
-            break;
-          }
-          case kIdxPi: {
-            nsigma = responsePi.GetSeparation(tofResponse->parameters, trk);
-            aod::pidtof_tiny::binning::packInTable(nsigma, tablePIDPi);
-            break;
-          }
-          case kIdxKa: {
-            nsigma = responseKa.GetSeparation(tofResponse->parameters, trk);
-            aod::pidtof_tiny::binning::packInTable(nsigma, tablePIDKa);
-            break;
-          }
-          case kIdxPr: {
-            nsigma = responsePr.GetSeparation(tofResponse->parameters, trk);
-            aod::pidtof_tiny::binning::packInTable(nsigma, tablePIDPr);
-            break;
-          }
-          case kIdxDe: {
-            nsigma = responseDe.GetSeparation(tofResponse->parameters, trk);
-            aod::pidtof_tiny::binning::packInTable(nsigma, tablePIDDe);
-            break;
-          }
-          case kIdxTr: {
-            nsigma = responseTr.GetSeparation(tofResponse->parameters, trk);
-            aod::pidtof_tiny::binning::packInTable(nsigma, tablePIDTr);
-            break;
-          }
-          case kIdxHe: {
-            nsigma = responseHe.GetSeparation(tofResponse->parameters, trk);
-            aod::pidtof_tiny::binning::packInTable(nsigma, tablePIDHe);
-            break;
-          }
-          case kIdxAl: {
-            nsigma = responseAl.GetSeparation(tofResponse->parameters, trk);
-            aod::pidtof_tiny::binning::packInTable(nsigma, tablePIDAl);
-            break;
-          }
-          default:
-            LOG(fatal) << "Wrong particle ID for standard tables";
-            break;
-        }
+        makeTable(pidId, false, response.expectedSigma[pidId], response.separation[pidId]);
         if (enableQaHistograms) {
-          hnsigma[pidId]->Fill(trk.p(), nsigma);
+          hnsigma[pidId]->Fill(trk.p(), response.separation[pidId]);
         }
       }
       for (auto const& pidId : mEnabledParticlesFull) { // Loop on enabled particle hypotheses with full tables
-        switch (pidId) {
-          case kIdxEl: {
-            resolution = responseEl.GetExpectedSigma(tofResponse->parameters, trk);
-            nsigma = responseEl.GetSeparation(tofResponse->parameters, trk, resolution);
-            tablePIDFullEl(resolution, nsigma);
-            break;
-          }
-          case kIdxMu: {
-            resolution = responseMu.GetExpectedSigma(tofResponse->parameters, trk);
-            nsigma = responseMu.GetSeparation(tofResponse->parameters, trk, resolution);
-            tablePIDFullMu(resolution, nsigma);
-            break;
-          }
-          case kIdxPi: {
-            resolution = responsePi.GetExpectedSigma(tofResponse->parameters, trk);
-            nsigma = responsePi.GetSeparation(tofResponse->parameters, trk);
-            tablePIDFullPi(resolution, nsigma);
-            break;
-          }
-          case kIdxKa: {
-            resolution = responseKa.GetExpectedSigma(tofResponse->parameters, trk);
-            nsigma = responseKa.GetSeparation(tofResponse->parameters, trk, resolution);
-            tablePIDFullKa(resolution, nsigma);
-            break;
-          }
-          case kIdxPr: {
-            resolution = responsePr.GetExpectedSigma(tofResponse->parameters, trk);
-            nsigma = responsePr.GetSeparation(tofResponse->parameters, trk, resolution);
-            tablePIDFullPr(resolution, nsigma);
-            break;
-          }
-          case kIdxDe: {
-            resolution = responseDe.GetExpectedSigma(tofResponse->parameters, trk);
-            nsigma = responseDe.GetSeparation(tofResponse->parameters, trk, resolution);
-            tablePIDFullDe(resolution, nsigma);
-            break;
-          }
-          case kIdxTr: {
-            resolution = responseTr.GetExpectedSigma(tofResponse->parameters, trk);
-            nsigma = responseTr.GetSeparation(tofResponse->parameters, trk, resolution);
-            tablePIDFullTr(resolution, nsigma);
-            break;
-          }
-          case kIdxHe: {
-            resolution = responseHe.GetExpectedSigma(tofResponse->parameters, trk);
-            nsigma = responseHe.GetSeparation(tofResponse->parameters, trk, resolution);
-            tablePIDFullHe(resolution, nsigma);
-            break;
-          }
-          case kIdxAl: {
-            resolution = responseAl.GetExpectedSigma(tofResponse->parameters, trk);
-            nsigma = responseAl.GetSeparation(tofResponse->parameters, trk, resolution);
-            tablePIDFullAl(resolution, nsigma);
-            break;
-          }
-          default:
-            LOG(fatal) << "Wrong particle ID for full tables";
-            break;
-        }
+        makeTable(pidId, true, response.expectedSigma[pidId], response.separation[pidId]);
         if (enableQaHistograms) {
-          hnsigmaFull[pidId]->Fill(trk.p(), nsigma);
+          hnsigmaFull[pidId]->Fill(trk.p(), response.separation[pidId]);
         }
       }
     }
   }
+
+  void process(aod::BCs const&) {}
+
+  void processRun3(Run3TrksWtofWevTime const& tracks,
+                   aod::Collisions const&,
+                   aod::BCsWithTimestamps const& bcs)
+  {
+    tofResponse->processSetup(bcs.iteratorAt(0)); // Update the calibration parameters
+    makeTables<Run3TrksWtofWevTime::iterator>(tracks);
+  }
   PROCESS_SWITCH(tofPidMerge, processRun3, "Produce Run 3 Nsigma table. Set to off if the tables are not required, or autoset is on", false);
 
-  template <o2::track::PID::ID pid>
-  using ResponseImplementationRun2 = o2::pid::tof::ExpTimes<Run2TrksWtofWevTime::iterator, pid>;
   void processRun2(Run2TrksWtofWevTime const& tracks,
                    aod::Collisions const&,
                    aod::BCsWithTimestamps const& bcs)
   {
-    constexpr auto responseEl = ResponseImplementationRun2<PID::Electron>();
-    constexpr auto responseMu = ResponseImplementationRun2<PID::Muon>();
-    constexpr auto responsePi = ResponseImplementationRun2<PID::Pion>();
-    constexpr auto responseKa = ResponseImplementationRun2<PID::Kaon>();
-    constexpr auto responsePr = ResponseImplementationRun2<PID::Proton>();
-    constexpr auto responseDe = ResponseImplementationRun2<PID::Deuteron>();
-    constexpr auto responseTr = ResponseImplementationRun2<PID::Triton>();
-    constexpr auto responseHe = ResponseImplementationRun2<PID::Helium3>();
-    constexpr auto responseAl = ResponseImplementationRun2<PID::Alpha>();
-
     tofResponse->processSetup(bcs.iteratorAt(0)); // Update the calibration parameters
+    makeTables<Run2TrksWtofWevTime::iterator>(tracks);
+  }
+  PROCESS_SWITCH(tofPidMerge, processRun2, "Produce Run 2 Nsigma table. Set to off if the tables are not required, or autoset is on", false);
 
-    for (auto const& pidId : mEnabledParticles) {
-      reserveTable(pidId, tracks.size(), false);
-    }
-
-    for (auto const& pidId : mEnabledParticlesFull) {
-      reserveTable(pidId, tracks.size(), true);
+  o2::pid::tof::BetaMassColumns betaMass;
+  template <typename TrksType>
+  void fillBetaMass(TrksType const& tracks, o2::pid::tof::Beta const& response)
+  {
+    if (enableTOFParamsForBetaMass) {
+      betaMass.compute(tracks, response.mExpectedResolution, enableTableMass, [this](const auto& trk) { return trk.tofExpMom() / (1.f + trk.sign() * tofResponse->parameters.getMomentumChargeShift(trk.eta())); }, false);
+    } else {
+      betaMass.compute(tracks, response.mExpectedResolution, enableTableMass, [](const auto& trk) { return trk.p(); }, true);
     }
-
-    float resolution = 1.f; // Last resolution assigned
-    float nsigma = 0;
-    for (auto const& trk : tracks) { // Loop on all tracks
-      if (!trk.has_collision()) {    // Track was not assigned, cannot compute NSigma (no event time) -> filling with empty table
-        for (auto const& pidId : mEnabledParticles) {
-          makeTableEmpty(pidId, false);
-        }
-        for (auto const& pidId : mEnabledParticlesFull) {
-          makeTableEmpty(pidId, true);
-        }
-        continue;
-      }
-
-      for (auto const& pidId : mEnabledParticles) { // Loop on enabled particle hypotheses
-        switch (pidId) {
-          case kIdxEl: {
-            nsigma = responseEl.GetSeparation(tofResponse->parameters, trk);
-            aod::pidtof_tiny::binning::packInTable(nsigma, tablePIDEl);
-            break;
-          }
-          case kIdxMu: {
-            nsigma = responseMu.GetSeparation(tofResponse->parameters, trk);
-            aod::pidtof_tiny::binning::packInTable(nsigma, tablePIDMu);
-            break;
-          }
-          case kIdxPi: {
-            nsigma = responsePi.GetSeparation(tofResponse->parameters, trk);
-            aod::pidtof_tiny::binning::packInTable(nsigma, tablePIDPi);
-            break;
-          }
-          case kIdxKa: {
-            nsigma = responseKa.GetSeparation(tofResponse->parameters, trk);
-            aod::pidtof_tiny::binning::packInTable(nsigma, tablePIDKa);
-            break;
-          }
-          case kIdxPr: {
-            nsigma = responsePr.GetSeparation(tofResponse->parameters, trk);
-            aod::pidtof_tiny::binning::packInTable(nsigma, tablePIDPr);
-            break;
-          }
-          case kIdxDe: {
-            nsigma = responseDe.GetSeparation(tofResponse->parameters, trk);
-            aod::pidtof_tiny::binning::packInTable(nsigma, tablePIDDe);
-            break;
-          }
-          case kIdxTr: {
-            nsigma = responseTr.GetSeparation(tofResponse->parameters, trk);
-            aod::pidtof_tiny::binning::packInTable(nsigma, tablePIDTr);
-            break;
-          }
-          case kIdxHe: {
-            nsigma = responseHe.GetSeparation(tofResponse->parameters, trk);
-            aod::pidtof_tiny::binning::packInTable(nsigma, tablePIDHe);
-            break;
-          }
-          case kIdxAl: {
-            nsigma = responseAl.GetSeparation(tofResponse->parameters, trk);
-            aod::pidtof_tiny::binning::packInTable(nsigma, tablePIDAl);
-            break;
-          }
-          default:
-            LOG(fatal) << "Wrong particle ID for standard tables";
-            break;
-        }
-        if (enableQaHistograms) {
-          hnsigma[pidId]->Fill(trk.p(), nsigma);
-        }
+    const std::size_t nTracks = tracks.size();
+    if (enableTableBeta) {
+      tablePIDBeta.reserve(nTracks);
+      for (std::size_t i = 0; i < nTracks; i++) {
+        tablePIDBeta(betaMass.beta[i], betaMass.betaSigma[i]);
       }
-      for (auto const& pidId : mEnabledParticlesFull) { // Loop on enabled particle hypotheses with full tables
-        switch (pidId) {
-          case kIdxEl: {
-            resolution = responseEl.GetExpectedSigma(tofResponse->parameters, trk);
-            nsigma = responseEl.GetSeparation(tofResponse->parameters, trk, resolution);
-            tablePIDFullEl(resolution, nsigma);
-            break;
-          }
-          case kIdxMu: {
-            resolution = responseMu.GetExpectedSigma(tofResponse->parameters, trk);
-            nsigma = responseMu.GetSeparation(tofResponse->parameters, trk, resolution);
-            tablePIDFullMu(resolution, nsigma);
-            break;
-          }
-          case kIdxPi: {
-            resolution = responsePi.GetExpectedSigma(tofResponse->parameters, trk);
-            nsigma = responsePi.GetSeparation(tofResponse->parameters, trk);
-            tablePIDFullPi(resolution, nsigma);
-            break;
-          }
-          case kIdxKa: {
-            resolution = responseKa.GetExpectedSigma(tofResponse->parameters, trk);
-            nsigma = responseKa.GetSeparation(tofResponse->parameters, trk, resolution);
-            tablePIDFullKa(resolution, nsigma);
-            break;
-          }
-          case kIdxPr: {
-            resolution = responsePr.GetExpectedSigma(tofResponse->parameters, trk);
-            nsigma = responsePr.GetSeparation(tofResponse->parameters, trk, resolution);
-            tablePIDFullPr(resolution, nsigma);
-            break;
-          }
-          case kIdxDe: {
-            resolution = responseDe.GetExpectedSigma(tofResponse->parameters, trk);
-            nsigma = responseDe.GetSeparation(tofResponse->parameters, trk, resolution);
-            tablePIDFullDe(resolution, nsigma);
-            break;
-          }
-          case kIdxTr: {
-            resolution = responseTr.GetExpectedSigma(tofResponse->parameters, trk);
-            nsigma = responseTr.GetSeparation(tofResponse->parameters, trk, resolution);
-            tablePIDFullTr(resolution, nsigma);
-            break;
-          }
-          case kIdxHe: {
-            resolution = responseHe.GetExpectedSigma(tofResponse->parameters, trk);
-            nsigma = responseHe.GetSeparation(tofResponse->parameters, trk, resolution);
-            tablePIDFullHe(resolution, nsigma);
-            break;
-          }
-          case kIdxAl: {
-            resolution = responseAl.GetExpectedSigma(tofResponse->parameters, trk);
-            nsigma = responseAl.GetSeparation(tofResponse->parameters, trk, resolution);
-            tablePIDFullAl(resolution, nsigma);
-            break;
-          }
-          default:
-            LOG(fatal) << "Wrong particle ID for full tables";
-            break;
-        }
-        if (enableQaHistograms) {
-          hnsigmaFull[pidId]->Fill(trk.p(), nsigma);
-        }
+    }
+    if (enableTableMass) {
+      tablePIDTOFMass.reserve(nTracks);
+      for (std::size_t i = 0; i < nTracks; i++) {
+        tablePIDTOFMass(betaMass.mass[i]);
       }
     }
   }
-  PROCESS_SWITCH(tofPidMerge, processRun2, "Produce Run 2 Nsigma table. Set to off if the tables are not required, or autoset is on", false);
 
   o2::pid::tof::Beta responseBetaRun2;
   void processRun2BetaM(Run2TrksWtofWevTime const& tracks)
@@ -1208,21 +979,7 @@ struct tofPidMerge {
     if (!enableTableBeta && !enableTableMass) {
       return;
     }
-    float beta = 0.f;
-    tablePIDBeta.reserve(tracks.size());
-    for (auto const& trk : tracks) {
-      beta = responseBetaRun2.GetBeta(trk);
-      if (enableTableBeta) {
-        tablePIDBeta(beta, responseBetaRun2.GetExpectedSigma(trk));
-      }
-      if (enableTableMass) {
-        if (enableTOFParamsForBetaMass) {
-          tablePIDTOFMass(o2::pid::tof::TOFMass::GetTOFMass(trk.tofExpMom() / (1.f + trk.sign() * tofResponse->parameters.getMomentumChargeShift(trk.eta())), beta));
-        } else {
-          tablePIDTOFMass(o2::pid::tof::TOFMass::GetTOFMass(trk, beta));
-        }
-      }
-    }
+    fillBetaMass(tracks, responseBetaRun2);
   }
   PROCESS_SWITCH(tofPidMerge, processRun2BetaM, "Produce Run 2 Beta and Mass table. Set to off if the tables are not required, or autoset is on", false);
 
@@ -1232,22 +989,7 @@ struct tofPidMerge {
     if (!enableTableBeta && !enableTableMass) {
       return;
     }
-    float beta = 0.f;
-    tablePIDBeta.reserve(tracks.size());
-    for (auto const& trk : tracks) {
-      beta = responseBeta.GetBeta(trk);
-      if (enableTableBeta) {
-        tablePIDBeta(beta,
-                     responseBeta.GetExpectedSigma(trk));
-      }
-      if (enableTableMass) {
-        if (enableTOFParamsForBetaMass) {
-          tablePIDTOFMass(o2::pid::tof::TOFMass::GetTOFMass(trk.tofExpMom() / (1.f + trk.sign() * tofResponse->parameters.getMomentumChargeShift(trk.eta())), beta));
-        } else {
-          tablePIDTOFMass(o2::pid::tof::TOFMass::GetTOFMass(trk, beta));
-        }
-      }
-    }
+    fillBetaMass(tracks, responseBeta);
   }
   PROCESS_SWITCH(tofPidMerge, processRun3BetaM, "Produce Run 3 Beta and Mass table. Set to off if the tables are not required, or autoset is on", false);
 };
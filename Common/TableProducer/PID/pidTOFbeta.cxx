@@ -31,6 +31,7 @@
 #include <ReconstructionDataFormats/PID.h>
 
 #include <chrono>
+#include <cstddef>
 #include <cstdint>
 #include <string>
 #include <utility>
@@ -136,6 +137,7 @@ struct tofPidBeta {
 
   using Trks = soa::Join<aod::Tracks, aod::TracksExtra, aod::TOFSignal, aod::TOFEvTime, aod::pidEvTimeFlags>;
   o2::pid::tof::Beta responseBeta;
+  o2::pid::tof::BetaMassColumns betaMass;
   template <o2::track::PID::ID pid>
   using ResponseImplementation = o2::pid::tof::ExpTimes<Trks::iterator, pid>;
   void process(Trks const& tracks)
@@ -143,20 +145,22 @@ struct tofPidBeta {
     if (!enableTableBeta && !enableTableMass) {
       return;
     }
-    float beta = 0.f;
-    tablePIDBeta.reserve(tracks.size());
-    for (auto const& trk : tracks) {
-      beta = responseBeta.GetBeta(trk);
-      if (enableTableBeta) {
-        tablePIDBeta(beta,
-                     responseBeta.GetExpectedSigma(trk));
+    if (enableTOFParams) {
+      betaMass.compute(tracks, responseBeta.mExpectedResolution, enableTableMass, [this](const auto& trk) { return trk.tofExpMom() / (1.f + trk.sign() * mRespParamsV2.getShift(trk.eta())); }, false);
+    } else {
+      betaMass.compute(tracks, responseBeta.mExpectedResolution, enableTableMass, [](const auto& trk) { return trk.p(); }, true);
+    }
+    const std::size_t nTracks = tracks.size();
+    if (enableTableBeta) {
+      tablePIDBeta.reserve(nTracks);
+      for (std::size_t i = 0; i < nTracks; i++) {
+        tablePIDBeta(betaMass.beta[i], betaMass.betaSigma[i]);
       }
-      if (enableTableMass) {
-        if (enableTOFParams) {
-          tablePIDTOFMass(o2::pid::tof::TOFMass::GetTOFMass(trk.tofExpMom() / (1.f + trk.sign() * mRespParamsV2.getShift(trk.eta())), beta));
-        } else {
-          tablePIDTOFMass(o2::pid::tof::TOFMass::GetTOFMass(trk, beta));
-        }
+    }
+    if (enableTableMass) {
+      tablePIDTOFMass.reserve(nTracks);
+      for (std::size_t i = 0; i < nTracks; i++) {
+        tablePIDTOFMass(betaMass.mass[i]);
       }
     }
   }
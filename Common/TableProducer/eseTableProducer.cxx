@@ -106,6 +106,7 @@ struct EseTableProducer {
     {"TPCall", DetID::TPCall}};
 
   FFitWeights* eventShape{nullptr};
+  std::vector<int> qnSplineHandles{}; // spline handles of eventShape, [detector * nHarmonics + harmonic] of cfgDetectors and cfgLoopHarmonics
 
   Service<o2::ccdb::BasicCCDBManager> ccdb;
 
@@ -281,6 +282,12 @@ struct EseTableProducer {
       if (!eventShape)
         LOGF(fatal, "failed loading qSelection with ese flag");
       LOGF(info, "successfully loaded qSelection");
+      qnSplineHandles.clear();
+      for (const auto& det : cfgDetectors.value) {
+        for (const auto& nHarm : cfgLoopHarmonics.value) {
+          qnSplineHandles.push_back(eventShape->getQnHandle(nHarm, det.c_str()));
+        }
+      }
     }
     if (!cfgEfficiency.value.empty()) {
       cfg.mEfficiency = ccdb->getForTimeStamp<TH1D>(cfgEfficiency, timestamp);
@@ -323,13 +330,13 @@ struct EseTableProducer {
     return -1;
   }
 
-  void doSpline(float& splineVal, const float& centr, const float& nHarm, const char* pf, const auto& QX, const auto& QY, const auto& sumAmpl)
+  void doSpline(float& splineVal, const float& centr, const float& nHarm, const char* pf, const int splineHandle, const auto& QX, const auto& QY, const auto& sumAmpl)
   {
     if (sumAmpl > ThresholdAmplitude) {
       float qnval = calcRedqn(QX * sumAmpl, QY * sumAmpl, sumAmpl);
       weightsFFit->fillWeights(centr, qnval, nHarm, pf);
       if (cfgESE) {
-        splineVal = eventShape->eval(centr, qnval, nHarm, pf);
+        splineVal = eventShape->evalHandle(splineHandle, centr, qnval);
       }
     }
   }
@@ -375,7 +382,8 @@ struct EseTableProducer {
         for (std::size_t i{0}; i < cfgLoopHarmonics->size(); i++) {
           const int nHarm{cfgLoopHarmonics->at(i)};
           const auto [qxt, qyt, st] = getVectors(collision, nHarm, iter->second);
-          doSpline(splineVal, centrality, nHarm, det.c_str(), qxt, qyt, st);
+          const int splineHandle{cfgESE ? qnSplineHandles[j * cfgLoopHarmonics->size() + i] : -1};
+          doSpline(splineVal, centrality, nHarm, det.c_str(), splineHandle, qxt, qyt, st);
           if (i == 0)
             registry.fill(HIST("hESEstat"), counter++);
 
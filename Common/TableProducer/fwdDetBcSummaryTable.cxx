@@ -0,0 +1,175 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file fwdDetBcSummaryTable.cxx
+/// \brief Producer of the per BC summary of the forward detectors, aod::FwdBcSummaries
+///
+/// The channels of FT0, FV0 and FDD matched to a BC are reduced once per data frame to the summed amplitudes
+/// per side, the FDD coincidences are evaluated and the ZN energies and times are copied, together with the
+/// bunch filling pattern of the BC. The luminosity, FIT QA and UD tasks can read these columns joined to the
+/// BCs table instead of looping over the channels of the detectors.
+
+#include "Common/DataModel/FwdDetBcSummary.h"
+
+#include <CCDB/BasicCCDBManager.h>
+#include <CommonConstants/LHCConstants.h>
+#include <CommonDataFormat/BunchFilling.h>
+#include <DataFormatsParameters/GRPLHCIFData.h>
+#include <Framework/ASoA.h>
+#include <Framework/AnalysisDataModel.h>
+#include <Framework/AnalysisHelpers.h>
+#include <Framework/AnalysisTask.h>
+#include <Framework/Configurable.h>
+#include <Framework/InitContext.h>
+#include <Framework/Logger.h>
+#include <Framework/runDataProcessing.h>
+
+#include <bitset>
+#include <cstdint>
+#include <iterator>
+#include <numeric>
+#include <string>
+
+using namespace o2;
+using namespace o2::framework;
+using namespace o2::aod::fwdbcsummary;
+
+struct FwdDetBcSummaryTable {
+  Produces<aod::FwdBcSummaries> fwdBcSummaries;
+
+  Configurable<std::string> ccdbUrl{"ccdbUrl", "http://alice-ccdb.cern.ch", "url of the ccdb repository"};
+  Configurable<std::string> ccdbPathGrpLhcIf{"ccdbPathGrpLhcIf", "GLO/Config/GRPLHCIF", "Path on the CCDB of the GRPLHCIF object with the bunch filling"};
+  Configurable<bool> fillBcPattern{"fillBcPattern", true, "Fill the bunch filling pattern flags of the BCs from the CCDB"};
+
+  Service<o2::ccdb::BasicCCDBManager> ccdb;
+
+  static constexpr float NoAmplitude = -1.f;
+  static constexpr float NoTime = -999.f;
+
+  int lastRunNumber = -1;
+  bool hasBcPattern = false;
+  std::bitset<o2::constants::lhc::LHCMaxBunches> beamPatternA;
+  std::bitset<o2::constants::lhc::LHCMaxBunches> beamPatternC;
+
+  using BCs = soa::Join<aod::BCsWithTimestamps, aod::Run3MatchedToBCSparse>;
+
+  void init(InitContext&)
+  {
+    ccdb->setURL(ccdbUrl);
+    ccdb->setCaching(true);
+    ccdb->setLocalObjectValidityChecking();
+  }
+
+  template <typename B>
+  void initBcPattern(B const& bc)
+  {
+    if (bc.runNumber() == lastRunNumber) {
+      return;
+    }
+    lastRunNumber = bc.runNumber();
+    hasBcPattern = false;
+    const auto* grplhcif = ccdb->getForTimeStamp<o2::parameters::GRPLHCIFData>(ccdbPathGrpLhcIf, bc.timestamp());
+    if (grplhcif == nullptr) {
+      LOGF(warning, "No GRPLHCIF object for run %d, the BC pattern flags are not filled", lastRunNumber);
+      return;
+    }
+    beamPatternA = grplhcif->getBunchFilling().getBeamPattern(0);
+    beamPatternC = grplhcif->getBunchFilling().getBeamPattern(1);
+    hasBcPattern = true;
+  }
+
+  template <typename T>
+  static float sumAmplitudes(T const& amplitudes)
+  {
+    return std::accumulate(std::begin(amplitudes), std::end(amplitudes), 0.f);
+  }
+
+  void process(BCs const& bcs, aod::FT0s const&, aod::FV0As const&, aod::FDDs const&, aod::Zdcs const&)
+  {
+    fwdBcSummaries.reserve(bcs.size());
+    for (auto const& bc : bcs) {
+      uint16_t flags = 0;
+      auto setFlag = [&flags](int bit) { flags |= static_cast<uint16_t>(1) << bit; };
+
+      float ampFT0A = NoAmplitude, ampFT0C = NoAmplitude, timeFT0A = NoTime, timeFT0C = NoTime;
+      uint8_t triggerMaskFT0 = 0;
+      if (bc.has_ft0()) {
+        auto ft0 = bc.ft0();
+        ampFT0A = sumAmplitudes(ft0.amplitudeA());
+        ampFT0C = sumAmplitudes(ft0.amplitudeC());
+        timeFT0A = ft0.timeA();
+        timeFT0C = ft0.timeC();
+        triggerMaskFT0 = ft0.triggerMask();
+        setFlag(kHasFT0);
+      }
+
+      float ampFV0A = NoAmplitude, timeFV0A = NoTime;
+      uint8_t triggerMaskFV0A = 0;
+      if (bc.has_fv0a()) {
+        auto fv0a = bc.fv0a();
+        ampFV0A = sumAmplitudes(fv0a.amplitude());
+        timeFV0A = fv0a.time();
+        triggerMaskFV0A = fv0a.triggerMask();
+        setFlag(kHasFV0A);
+      }
+
+      float ampFDDA = NoAmplitude, ampFDDC = NoAmplitude, timeFDDA = NoTime, timeFDDC = NoTime;
+      uint8_t triggerMaskFDD = 0;
+      if (bc.has_fdd()) {
+        auto fdd = bc.fdd();
+        ampFDDA = sumAmplitudes(fdd.chargeA());
+        ampFDDC = sumAmplitudes(fdd.chargeC());
+        timeFDDA = fdd.timeA();
+        timeFDDC = fdd.timeC();
+        triggerMaskFDD = fdd.triggerMask();
+        setFlag(kHasFDD);
+        if (hasFDDCoincidence(fdd.chargeA())) {
+          setFlag(kFDDCoincidenceA);
+        }
+        if (hasFDDCoincidence(fdd.chargeC())) {
+          setFlag(kFDDCoincidenceC);
+        }
+      }
+
+      float energyZNA = NoTime, energyZNC = NoTime, timeZNA = NoTime, timeZNC = NoTime;
+      if (bc.has_zdc()) {
+        auto zdc = bc.zdc();
+        energyZNA = zdc.energyCommonZNA();
+        energyZNC = zdc.energyCommonZNC();
+        timeZNA = zdc.timeZNA();
+        timeZNC = zdc.timeZNC();
+        setFlag(kHasZDC);
+      }
+
+      if (fillBcPattern && bc.timestamp() > 0) {
+        initBcPattern(bc);
+        if (hasBcPattern) {
+          const int localBC = bc.globalBC() % o2::constants::lhc::LHCMaxBunches;
+          const bool beamA = beamPatternA[localBC];
+          const bool beamC = beamPatternC[localBC];
+          setFlag(kHasBcPattern);
+          setFlag(beamA ? (beamC ? kIsBcColliding : kIsBcBeamAOnly) : (beamC ? kIsBcBeamCOnly : kIsBcEmpty));
+        }
+      }
+
+      fwdBcSummaries(ampFT0A, ampFT0C, ampFV0A, ampFDDA, ampFDDC,
+                     timeFT0A, timeFT0C, timeFV0A, timeFDDA, timeFDDC,
+                     triggerMaskFT0, triggerMaskFV0A, triggerMaskFDD,
+                     energyZNA, energyZNC, timeZNA, timeZNC,
+                     flags);
+    }
+  }
+};
+
+WorkflowSpec defineDataProcessing(ConfigContext const& cfgc)
+{
+  return WorkflowSpec{adaptAnalysisTask<FwdDetBcSummaryTable>(cfgc)};
+}
@@ -46,6 +46,7 @@
 #include <map>
 #include <string>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 using namespace std;
@@ -84,6 +85,32 @@ unordered_map<int, bool> map_has_muontracks_collisions;
 unordered_map<int, float> map_vtxz;
 unordered_map<int, int> map_nmfttrack;
 
+// tracks propagated once per data frame and shared by all the pairs they enter: the muons at the PV and at the
+// matching plane (when the plane does not depend on the MFT track), the MFT tracks at the DCA to a collision
+struct FwdPropagationCache {
+  map<pair<int64_t, int64_t>, o2::dataformats::GlobalFwdTrack> muonAtPV;      // (muon, collision)
+  unordered_map<int64_t, o2::dataformats::GlobalFwdTrack> muonAtMatchingPlane; // muon
+  map<pair<int64_t, int64_t>, o2::track::TrackParCovFwd> mftAtDCA;             // (MFT track, collision)
+
+  template <typename M, typename K, typename F>
+  static typename M::mapped_type const& getOrPropagate(M& cache, K const& key, F&& propagate)
+  {
+    auto it = cache.find(key);
+    if (it == cache.end()) {
+      it = cache.emplace(key, propagate()).first;
+    }
+    return it->second;
+  }
+
+  void clear()
+  {
+    muonAtPV.clear();
+    muonAtMatchingPlane.clear();
+    mftAtDCA.clear();
+  }
+};
+FwdPropagationCache fwdPropagationCache;
+
 struct match_mft_mch_data_mc {
 
   ////  Variables for matching method
@@ -171,6 +198,12 @@ struct match_mft_mch_data_mc {
     }
 
     inline o2::dataformats::GlobalFwdTrack propagateMUONtoPV(MUON const& muontrack) const
+    {
+      return FwdPropagationCache::getOrPropagate(fwdPropagationCache.muonAtPV, make_pair(muontrack.globalIndex(), collision.globalIndex()),
+                                                 [&]() { return extrapMUONtoPV(muontrack); });
+    }
+
+    inline o2::dataformats::GlobalFwdTrack extrapMUONtoPV(MUON const& muontrack) const
     {
       const double mz = muontrack.z();
       const double mchi2 = muontrack.chi2();
@@ -290,6 +323,16 @@ struct match_mft_mch_data_mc {
     }
 
     inline o2::dataformats::GlobalFwdTrack propagateMUONtoMatchingPlane()
+    {
+      // at the last MFT cluster the plane depends on the MFT track, otherwise the muon is propagated once
+      if (mMatchingType == MFT_LAST_CLUSTR) {
+        return extrapMUONtoMatchingPlane();
+      }
+      return FwdPropagationCache::getOrPropagate(fwdPropagationCache.muonAtMatchingPlane, muontrack.globalIndex(),
+                                                 [&]() { return extrapMUONtoMatchingPlane(); });
+    }
+
+    inline o2::dataformats::GlobalFwdTrack extrapMUONtoMatchingPlane()
     {
       float cov[15] = {
         muontrack.cXX(), muontrack.cXY(), muontrack.cYY(),
@@ -329,6 +372,12 @@ struct match_mft_mch_data_mc {
     }
 
     inline o2::track::TrackParCovFwd propagateMFTtoDCA()
+    {
+      return FwdPropagationCache::getOrPropagate(fwdPropagationCache.mftAtDCA, make_pair(mfttrack.globalIndex(), collision.globalIndex()),
+                                                 [&]() { return extrapMFTtoDCA(); });
+    }
+
+    inline o2::track::TrackParCovFwd extrapMFTtoDCA()
     {
       double covArr[15]{0.0};
       SMatrix55 tmftcovs(covArr, covArr + 15);
@@ -348,6 +397,12 @@ struct match_mft_mch_data_mc {
     }
 
     inline o2::dataformats::GlobalFwdTrack propagateMUONtoPV()
+    {
+      return FwdPropagationCache::getOrPropagate(fwdPropagationCache.muonAtPV, make_pair(muontrack.globalIndex(), collision.globalIndex()),
+                                                 [&]() { return extrapMUONtoPV(); });
+    }
+
+    inline o2::dataformats::GlobalFwdTrack extrapMUONtoPV()
     {
       float cov[15] = {
         muontrack.cXX(), muontrack.cXY(), muontrack.cYY(),
@@ -559,7 +614,8 @@ struct match_mft_mch_data_mc {
     for (auto muontrack : muontracks) {
       if (!isGoodMuonQuality(muontrack))
         continue;
-      o2::dataformats::GlobalFwdTrack muontrack_at_pv = propagateMUONtoPV(muontrack, collisions);
+      o2::dataformats::GlobalFwdTrack const& muontrack_at_pv = FwdPropagationCache::getOrPropagate(fwdPropagationCache.muonAtPV, make_pair(muontrack.globalIndex(), static_cast<int64_t>(muontrack.collisionId())),
+                                                                                                    [&]() { return propagateMUONtoPV(muontrack, collisions); });
       if (!isGoodMuonKine(muontrack_at_pv))
         continue;
 
@@ -667,6 +723,7 @@ struct match_mft_mch_data_mc {
     map_collisions.clear();
     map_has_muontracks_collisions.clear();
     map_has_mfttracks_collisions.clear();
+    fwdPropagationCache.clear();
 
     initCCDB(bcs.begin());
     setMUONs(muontracks, collisions);
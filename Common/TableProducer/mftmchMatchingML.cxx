@@ -41,6 +41,8 @@
 #include <memory>
 #include <regex>
 #include <string>
+#include <tuple>
+#include <utility>
 #include <vector>
 
 #include <math.h> // FIXME: Replace M_PI
@@ -85,12 +87,12 @@ struct mftmchMatchingML {
   std::shared_ptr<Ort::Session> onnx_session = nullptr;
   OnnxModel model;
 
+  static constexpr Double_t MatchingPlaneZ = -77.5;
+
   template <typename F, typename M>
   std::vector<float> getVariables(F const& fwdtrack, M const& mfttrack)
   {
 
-    static constexpr Double_t MatchingPlaneZ = -77.5;
-
     // propagate muontrack to matching position
     double muonchi2 = fwdtrack.chi2();
     SMatrix5 muonpars(fwdtrack.x(), fwdtrack.y(), fwdtrack.phi(), fwdtrack.tgl(), fwdtrack.signed1Pt());
@@ -151,60 +153,153 @@ struct mftmchMatchingML {
     return input_tensor_values;
   }
 
-  template <typename F, typename M>
-  double matchONNX(F const& fwdtrack, M const& mfttrack)
-  {
-    std::vector<std::string> input_names;
-    std::vector<std::vector<int64_t>> input_shapes;
-    std::vector<std::string> output_names;
-    std::vector<std::vector<int64_t>> output_shapes;
+  // names and shapes of the model inputs and outputs, read once when the session is created
+  std::vector<std::string> inputNames;
+  std::vector<std::string> outputNames;
+  std::vector<const char*> inputNamesChar;
+  std::vector<const char*> outputNamesChar;
+  std::vector<int64_t> inputShape;
+  bool batchedInference = false; // the model accepts a dynamic number of rows
+
+  // MFT tracks sorted by collision and (x, y) cell at the matching plane, the cells are as large as the XY window
+  struct MftCell {
+    int64_t collisionId;
+    int64_t cellX;
+    int64_t cellY;
+    bool operator<(MftCell const& other) const
+    {
+      return std::tie(collisionId, cellX, cellY) < std::tie(other.collisionId, other.cellX, other.cellY);
+    }
+  };
+  std::vector<std::pair<MftCell, int>> mftCells;
+  std::vector<int> candidates;
+  std::vector<float> batchInputs;
 
+  void initSessionIO()
+  {
     Ort::AllocatorWithDefaultOptions tmpAllocator;
     for (size_t i = 0; i < onnx_session->GetInputCount(); ++i) {
-      input_names.push_back(onnx_session->GetInputNameAllocated(i, tmpAllocator).get());
-    }
-    for (size_t i = 0; i < onnx_session->GetInputCount(); ++i) {
-      input_shapes.emplace_back(onnx_session->GetInputTypeInfo(i).GetTensorTypeAndShapeInfo().GetShape());
+      inputNames.push_back(onnx_session->GetInputNameAllocated(i, tmpAllocator).get());
     }
     for (size_t i = 0; i < onnx_session->GetOutputCount(); ++i) {
-      output_names.push_back(onnx_session->GetOutputNameAllocated(i, tmpAllocator).get());
+      outputNames.push_back(onnx_session->GetOutputNameAllocated(i, tmpAllocator).get());
     }
-    for (size_t i = 0; i < onnx_session->GetOutputCount(); ++i) {
-      output_shapes.emplace_back(onnx_session->GetOutputTypeInfo(i).GetTensorTypeAndShapeInfo().GetShape());
+    for (auto const& name : inputNames) {
+      inputNamesChar.push_back(name.c_str());
     }
+    for (auto const& name : outputNames) {
+      outputNamesChar.push_back(name.c_str());
+    }
+    inputShape = onnx_session->GetInputTypeInfo(0).GetTensorTypeAndShapeInfo().GetShape();
+    batchedInference = inputShape[0] < 0;
+  }
 
-    auto input_shape = input_shapes[0];
-    input_shape[0] = 1;
+  // x, y of the MFT track linearly propagated to the matching plane, as in getVariables
+  template <typename M>
+  static std::pair<float, float> mftXYAtMatchingPlane(M const& mfttrack)
+  {
+    double mftchi2 = mfttrack.chi2();
+    SMatrix5 mftpars(mfttrack.x(), mfttrack.y(), mfttrack.phi(), mfttrack.tgl(), mfttrack.signed1Pt());
+    std::vector<double> mftv1;
+    SMatrix55 mftcovs(mftv1.begin(), mftv1.end());
+    o2::track::TrackParCovFwd mftpars1{mfttrack.z(), mftpars, mftcovs, mftchi2};
+    mftpars1.propagateToZlinear(MatchingPlaneZ);
+    return {static_cast<float>(mftpars1.getX()), static_cast<float>(mftpars1.getY())};
+  }
 
-    std::vector<float> input_tensor_values;
-    input_tensor_values = getVariables(fwdtrack, mfttrack);
+  int64_t xyCell(float xy) const { return static_cast<int64_t>(std::floor(xy / cfgXYWindow)); }
 
-    if (input_tensor_values[8] < cfgXYWindow) {
-      std::vector<Ort::Value> input_tensors;
-      Ort::MemoryInfo mem_info =
-        Ort::MemoryInfo::CreateCpu(OrtAllocatorType::OrtArenaAllocator, OrtMemType::OrtMemTypeDefault);
-      input_tensors.push_back(Ort::Value::CreateTensor<float>(mem_info, input_tensor_values.data(), input_tensor_values.size(), input_shape.data(), input_shape.size()));
+  template <typename M>
+  void fillMftCells(M const& mfttracks)
+  {
+    mftCells.clear();
+    if (!(cfgXYWindow > 0.f)) {
+      return;
+    }
+    mftCells.reserve(mfttracks.size());
+    for (auto const& mfttrack : mfttracks) {
+      if (!mfttrack.has_collision()) {
+        continue;
+      }
+      auto [x, y] = mftXYAtMatchingPlane(mfttrack);
+      if (!std::isfinite(x) || !std::isfinite(y)) { // never within the XY window
+        continue;
+      }
+      mftCells.push_back({{mfttrack.collisionId(), xyCell(x), xyCell(y)}, static_cast<int>(mfttrack.globalIndex())});
+    }
+    std::sort(mftCells.begin(), mftCells.end(), [](auto const& a, auto const& b) { return a.first < b.first || (!(b.first < a.first) && a.second < b.second); });
+  }
 
-      Ort::RunOptions runOptions;
-      std::vector<const char*> inputNamesChar(input_names.size(), nullptr);
-      std::transform(std::begin(input_names), std::end(input_names), std::begin(inputNamesChar),
-                     [&](const std::string& str) { return str.c_str(); });
+  // MFT tracks within the collision window and in the (x, y) cells around the muon at the matching plane, in the table order
+  template <typename F>
+  void findCandidates(F const& fwdtrack)
+  {
+    candidates.clear();
+    if (!fwdtrack.has_collision() || mftCells.empty()) {
+      return;
+    }
+    SMatrix5 muonpars(fwdtrack.x(), fwdtrack.y(), fwdtrack.phi(), fwdtrack.tgl(), fwdtrack.signed1Pt());
+    std::vector<double> muonv1;
+    SMatrix55 muoncovs(muonv1.begin(), muonv1.end());
+    o2::track::TrackParCovFwd muonpars1{fwdtrack.z(), muonpars, muoncovs, fwdtrack.chi2()};
+    muonpars1.propagateToZlinear(MatchingPlaneZ);
+    if (!std::isfinite(muonpars1.getX()) || !std::isfinite(muonpars1.getY())) {
+      return;
+    }
+    const int64_t cellX = xyCell(muonpars1.getX());
+    const int64_t cellY = xyCell(muonpars1.getY());
+    auto cellLess = [](auto const& entry, MftCell const& cell) { return entry.first < cell; };
+    for (int64_t collisionId = fwdtrack.collisionId() - cfgColWindow + 1; collisionId <= fwdtrack.collisionId(); collisionId++) {
+      for (int64_t dX = -1; dX <= 1; dX++) {
+        const MftCell first{collisionId, cellX + dX, cellY - 1};
+        const MftCell last{collisionId, cellX + dX, cellY + 1};
+        for (auto it = std::lower_bound(mftCells.begin(), mftCells.end(), first, cellLess); it != mftCells.end() && !(last < it->first); ++it) {
+          candidates.push_back(it->second);
+        }
+      }
+    }
+    std::sort(candidates.begin(), candidates.end());
+  }
 
-      std::vector<const char*> outputNamesChar(output_names.size(), nullptr);
-      std::transform(std::begin(output_names), std::end(output_names), std::begin(outputNamesChar),
-                     [&](const std::string& str) { return str.c_str(); });
+  // scores of all the candidates of a muon, in one inference call when the model takes a dynamic number of rows;
+  // the candidates outside the XY window get a score 0
+  template <typename F, typename M>
+  std::vector<float> matchONNX(F const& fwdtrack, M const& mfttracks)
+  {
+    std::vector<float> scores(candidates.size(), 0.f);
+    std::vector<int> inWindow;
+    batchInputs.clear();
+    for (size_t i = 0; i < candidates.size(); i++) {
+      std::vector<float> input_tensor_values = getVariables(fwdtrack, mfttracks.rawIteratorAt(candidates[i]));
+      if (input_tensor_values[8] < cfgXYWindow) {
+        batchInputs.insert(batchInputs.end(), input_tensor_values.begin(), input_tensor_values.end());
+        inWindow.push_back(i);
+      }
+    }
+    if (inWindow.empty()) {
+      return scores;
+    }
+
+    const size_t nVariables = batchInputs.size() / inWindow.size();
+    const size_t batchSize = batchedInference ? inWindow.size() : 1;
+    Ort::MemoryInfo mem_info =
+      Ort::MemoryInfo::CreateCpu(OrtAllocatorType::OrtArenaAllocator, OrtMemType::OrtMemTypeDefault);
+    Ort::RunOptions runOptions;
+    auto input_shape = inputShape;
+    for (size_t first = 0; first < inWindow.size(); first += batchSize) {
+      input_shape[0] = batchSize;
+      std::vector<Ort::Value> input_tensors;
+      input_tensors.push_back(Ort::Value::CreateTensor<float>(mem_info, batchInputs.data() + first * nVariables, batchSize * nVariables, input_shape.data(), input_shape.size()));
 
       std::vector<Ort::Value> output_tensors = onnx_session->Run(runOptions, inputNamesChar.data(), input_tensors.data(), input_tensors.size(), outputNamesChar.data(), outputNamesChar.size());
 
       const float* output_value = output_tensors[0].GetTensorData<float>();
-
-      auto score = output_value[0];
-
-      return score;
-    } else {
-      auto score = 0;
-      return score;
+      const size_t stride = output_tensors[0].GetTensorTypeAndShapeInfo().GetElementCount() / batchSize;
+      for (size_t i = 0; i < batchSize; i++) {
+        scores[inWindow[first + i]] = output_value[i * stride];
+      }
     }
+    return scores;
   };
 
   void init(o2::framework::InitContext&)
@@ -225,6 +320,7 @@ struct mftmchMatchingML {
                 << "/" << cfgModelName.value;
       model.initModel(cfgModelName, false, 1, strtoul(headers["Valid-From"].c_str(), NULL, 0), strtoul(headers["Valid-Until"].c_str(), NULL, 0));
       onnx_session = model.getSession();
+      initSessionIO();
     } else {
       LOG(info) << "Failed to retrieve Network file";
     }
@@ -232,39 +328,35 @@ struct mftmchMatchingML {
 
   void process(aod::Collisions const&, soa::Filtered<aod::FwdTracks> const& fwdtracks, aod::MFTTracks const& mfttracks)
   {
+    fillMftCells(mfttracks);
     for (auto& fwdtrack : fwdtracks) {
       if (fwdtrack.trackType() == aod::fwdtrack::ForwardTrackTypeEnum::MuonStandaloneTrack) {
         double bestscore = 0;
         int bestmfttrackid = -1;
-        for (auto& mfttrack : mfttracks) {
-          if (fwdtrack.has_collision() && mfttrack.has_collision()) {
-            if (0 <= fwdtrack.collisionId() - mfttrack.collisionId() && fwdtrack.collisionId() - mfttrack.collisionId() < cfgColWindow) {
-              double result = matchONNX(fwdtrack, mfttrack);
-              if (result > cfgThrScore) {
-                bestscore = result;
-                bestmfttrackid = mfttrack.globalIndex();
-              }
-            }
+        findCandidates(fwdtrack);
+        std::vector<float> scores = matchONNX(fwdtrack, mfttracks);
+        // as before, the last candidate in the table order above the threshold is kept
+        for (size_t i = 0; i < candidates.size(); i++) {
+          if (scores[i] > cfgThrScore) {
+            bestscore = scores[i];
+            bestmfttrackid = candidates[i];
           }
         }
         if (bestmfttrackid != -1) {
-          for (auto& mfttrack : mfttracks) {
-            if (mfttrack.globalIndex() == bestmfttrackid) {
-              double mftchi2 = mfttrack.chi2();
-              SMatrix5 mftpars(mfttrack.x(), mfttrack.y(), mfttrack.phi(), mfttrack.tgl(), mfttrack.signed1Pt());
-              std::vector<double> mftv1;
-              SMatrix55 mftcovs(mftv1.begin(), mftv1.end());
-              o2::track::TrackParCovFwd mftpars1{mfttrack.z(), mftpars, mftcovs, mftchi2};
-              mftpars1.propagateToZlinear(mfttrack.collision().posZ());
-
-              float dcaX = (mftpars1.getX() - mfttrack.collision().posX());
-              float dcaY = (mftpars1.getY() - mfttrack.collision().posY());
-              double px = fwdtrack.p() * sin(M_PI / 2 - atan(mfttrack.tgl())) * cos(mfttrack.phi());
-              double py = fwdtrack.p() * sin(M_PI / 2 - atan(mfttrack.tgl())) * sin(mfttrack.phi());
-              double pz = fwdtrack.p() * cos(M_PI / 2 - atan(mfttrack.tgl()));
-              fwdtrackml(fwdtrack.collisionId(), 0, mfttrack.x(), mfttrack.y(), mfttrack.z(), mfttrack.phi(), mfttrack.tgl(), fwdtrack.sign() / std::sqrt(std::pow(px, 2) + std::pow(py, 2)), fwdtrack.nClusters(), fwdtrack.pDca(), fwdtrack.rAtAbsorberEnd(), 0, 0, 0, bestscore, mfttrack.globalIndex(), fwdtrack.globalIndex(), fwdtrack.mchBitMap(), fwdtrack.midBitMap(), fwdtrack.midBoards(), mfttrack.trackTime(), mfttrack.trackTimeRes(), mfttrack.eta(), std::sqrt(std::pow(px, 2) + std::pow(py, 2)), std::sqrt(std::pow(px, 2) + std::pow(py, 2) + std::pow(pz, 2)), dcaX, dcaY);
-            }
-          }
+          auto mfttrack = mfttracks.rawIteratorAt(bestmfttrackid);
+          double mftchi2 = mfttrack.chi2();
+          SMatrix5 mftpars(mfttrack.x(), mfttrack.y(), mfttrack.phi(), mfttrack.tgl(), mfttrack.signed1Pt());
+          std::vector<double> mftv1;
+          SMatrix55 mftcovs(mftv1.begin(), mftv1.end());
+          o2::track::TrackParCovFwd mftpars1{mfttrack.z(), mftpars, mftcovs, mftchi2};
+          mftpars1.propagateToZlinear(mfttrack.collision().posZ());
+
+          float dcaX = (mftpars1.getX() - mfttrack.collision().posX());
+          float dcaY = (mftpars1.getY() - mfttrack.collision().posY());
+          double px = fwdtrack.p() * sin(M_PI / 2 - atan(mfttrack.tgl())) * cos(mfttrack.phi());
+          double py = fwdtrack.p() * sin(M_PI / 2 - atan(mfttrack.tgl())) * sin(mfttrack.phi());
+          double pz = fwdtrack.p() * cos(M_PI / 2 - atan(mfttrack.tgl()));
+          fwdtrackml(fwdtrack.collisionId(), 0, mfttrack.x(), mfttrack.y(), mfttrack.z(), mfttrack.phi(), mfttrack.tgl(), fwdtrack.sign() / std::sqrt(std::pow(px, 2) + std::pow(py, 2)), fwdtrack.nClusters(), fwdtrack.pDca(), fwdtrack.rAtAbsorberEnd(), 0, 0, 0, bestscore, mfttrack.globalIndex(), fwdtrack.globalIndex(), fwdtrack.mchBitMap(), fwdtrack.midBitMap(), fwdtrack.midBoards(), mfttrack.trackTime(), mfttrack.trackTimeRes(), mfttrack.eta(), std::sqrt(std::pow(px, 2) + std::pow(py, 2)), std::sqrt(std::pow(px, 2) + std::pow(py, 2) + std::pow(pz, 2)), dcaX, dcaY);
         }
       }
     }
@@ -47,6 +47,7 @@
 #include <iterator>
 #include <map>
 #include <string>
+#include <vector>
 
 using namespace std;
 using namespace o2;
@@ -97,6 +98,7 @@ struct MuonRealignment {
   geo::TransformationCreator transformation;
   map<int, math_utils::Transform3D> transformRef; // reference geometry w.r.t track data
   map<int, math_utils::Transform3D> transformNew; // new geometry
+  std::vector<mch::Cluster> alignedClusters;      // re-aligned clusters of the data frame, indexed as FwdTrkCls, the refitted tracks point to them
   globaltracking::MatchGlobalFwd mMatching;
   int fCurrentRun;        // needed to detect if the run changed and trigger update of calibrations etc.
   double mImproveCutChi2; // Chi2 cut for track improvement.
@@ -232,6 +234,25 @@ struct MuonRealignment {
     realignFwdTrks.reserve(muons.size());
     realignFwdTrksCov.reserve(muons.size());
 
+    // Re-align all the clusters of the data frame at once, the transformations only depend on the detection element
+    alignedClusters.assign(clusters.size(), mch::Cluster());
+    for (auto const& cluster : clusters) {
+      math_utils::Point3D<double> local;
+      math_utils::Point3D<double> master;
+      master.SetXYZ(cluster.x(), cluster.y(), cluster.z());
+
+      // Transformation from reference geometry frame to new geometry frame
+      transformRef[cluster.deId()].MasterToLocal(master, local);
+      transformNew[cluster.deId()].LocalToMaster(local, master);
+
+      auto& clusterMCH = alignedClusters[cluster.globalIndex()];
+      clusterMCH.x = master.x();
+      clusterMCH.y = master.y();
+      clusterMCH.z = master.z();
+      clusterMCH.ex = cluster.isGoodX() ? 0.2 : 10.0;
+      clusterMCH.ey = cluster.isGoodY() ? 0.2 : 10.0;
+    }
+
     // Loop over forward tracks using association indices
     FwdTrkCovRealignInfo fwdTrkCovRealignInfo;
     for (auto const& muon : muons) {
@@ -245,29 +266,15 @@ struct MuonRealignment {
         for (auto const& cluster : clustersSliced) {
           clIndex += 1;
 
-          mch::Cluster* clusterMCH = new mch::Cluster();
-
-          math_utils::Point3D<double> local;
-          math_utils::Point3D<double> master;
-          master.SetXYZ(cluster.x(), cluster.y(), cluster.z());
-
-          // Transformation from reference geometry frame to new geometry frame
-          transformRef[cluster.deId()].MasterToLocal(master, local);
-          transformNew[cluster.deId()].LocalToMaster(local, master);
-
-          clusterMCH->x = master.x();
-          clusterMCH->y = master.y();
-          clusterMCH->z = master.z();
+          auto& clusterMCH = alignedClusters[cluster.globalIndex()];
 
           uint32_t ClUId = mch::Cluster::buildUniqueId(static_cast<int>(cluster.deId() / 100) - 1, cluster.deId(), clIndex);
-          clusterMCH->uid = ClUId;
-          clusterMCH->ex = cluster.isGoodX() ? 0.2 : 10.0;
-          clusterMCH->ey = cluster.isGoodY() ? 0.2 : 10.0;
+          clusterMCH.uid = ClUId;
 
           // Add transformed cluster into temporary variable
-          convertedTrack.createParamAtCluster(*clusterMCH);
+          convertedTrack.createParamAtCluster(clusterMCH);
           LOGF(debug, "Track %d, cluster DE%d:  x:%g  y:%g  z:%g", muon.globalIndex(), cluster.deId(), cluster.x(), cluster.y(), cluster.z());
-          LOGF(debug, "Track %d, re-aligned cluster DE%d:  x:%g  y:%g  z:%g", muonRealignId, cluster.deId(), clusterMCH->getX(), clusterMCH->getY(), clusterMCH->getZ());
+          LOGF(debug, "Track %d, re-aligned cluster DE%d:  x:%g  y:%g  z:%g", muonRealignId, cluster.deId(), clusterMCH.getX(), clusterMCH.getY(), clusterMCH.getZ());
         }
 
         // Refit the re-aligned track
@@ -43,6 +43,7 @@
 #include <sstream>
 #include <string>
 #include <string_view>
+#include <utility>
 #include <vector>
 
 using namespace o2;
@@ -311,35 +312,39 @@ struct OccupancyTableProducer {
     std::vector<std::array<int, 2>>& medianPosVec,
     const Vecs&... vectors)
   {
-    const int n = sizeof...(Vecs);                             // Number of vectors
+    constexpr int n = sizeof...(Vecs);                         // Number of vectors
     const int size = std::get<0>(std::tie(vectors...)).size(); // Size of the first vector
 
+    auto byValue = [](const std::pair<double, int>& a, const std::pair<double, int>& b) {
+      return a.first < b.first;
+    };
+    std::array<std::pair<double, int>, n> data; // first element is entry, second is index
     for (int i = 0; i < size; i++) {
-      std::vector<std::array<double, 2>> data; // first element is entry, second is index
       int iEntry = 0;
 
       // Lambda to iterate over all vectors
       auto collect = [&](const auto& vec) {
-        data.push_back({vec[i], static_cast<double>(iEntry)});
+        data[iEntry] = {vec[i], iEntry};
         iEntry++;
       };
       (collect(vectors), ...); // Unpack variadic arguments and apply lambda
 
-      // Sort the data
-      std::sort(data.begin(), data.end(), [](const std::array<double, 2>& a, const std::array<double, 2>& b) {
-        return a[0] < b[0];
-      });
+      // Select the median entries, no full sort needed
+      const int mid = (n - 1) / 2;
+      std::nth_element(data.begin(), data.begin() + mid, data.end(), byValue);
 
       double median;
       int two = 2;
       // Find the median
       if (n % two == 0) {
-        median = (data[(n - 1) / 2][0] + data[(n - 1) / 2 + 1][0]) / 2;
-        medianPosVec[i][0] = static_cast<int>(data[(n - 1) / 2][1] + 0.001);
-        medianPosVec[i][1] = static_cast<int>(data[(n - 1) / 2 + 1][1] + 0.001);
+        // the next entry is the smallest one above the lower median
+        auto upper = std::min_element(data.begin() + mid + 1, data.end(), byValue);
+        median = (data[mid].first + upper->first) / 2;
+        medianPosVec[i][0] = data[mid].second;
+        medianPosVec[i][1] = upper->second;
       } else {
-        median = data[n / 2][0];
-        medianPosVec[i][0] = static_cast<int>(data[n / 2][1] + 0.001);
+        median = data[mid].first;
+        medianPosVec[i][0] = data[mid].second;
         medianPosVec[i][1] = -10; // For odd entries, only one value can be the median
       }
       medianVector[i] = median;
@@ -1289,6 +1294,8 @@ struct TrackMeanOccTableProducer {
   Configurable<bool> buildPointerTrackQAToTMOTable{"buildPointerTrackQAToTMOTable", true, "buildPointerTrackQAToTMOTable"};
   Configurable<bool> buildPointerTMOToTrackQATable{"buildPointerTMOToTrackQATable", true, "buildPointerTMOToTrackQATable"};
 
+  Configurable<bool> cfgUsePrefixSums{"cfgUsePrefixSums", false, "Mean occupancy of the track time window from the per TF prefix sums of the occupancy"};
+
   // vectors to be used for occupancy estimation
   std::vector<float> occPrimUnfm80;
 
@@ -1325,6 +1332,10 @@ struct TrackMeanOccTableProducer {
   std::vector<float> occRobustNtrackDetUnfm80;
   std::vector<float> occRobustMultTableUnfm80;
 
+  // cumulative occupancy of the current TF, one row of nBins + 1 entries per estimator (OccNamesEnum)
+  std::vector<double> occPrefixSums;
+  int occPrefixStride = 0;
+
   std::vector<bool> processStatus;
   std::vector<bool> processInThisBlock;
   void init(InitContext const&)
@@ -1333,6 +1344,11 @@ struct TrackMeanOccTableProducer {
     processStatus.resize(11);
     processInThisBlock.resize(11);
 
+    if (cfgUsePrefixSums) {
+      occPrefixStride = nBCinTF / bcGrouping + 1;
+      occPrefixSums.assign(static_cast<size_t>(kOccRobustMultTableUnfm80 + 1) * occPrefixStride, 0.);
+    }
+
     for (uint i = 0; i < processStatus.size(); i++) {
       processStatus[i] = false;
       processInThisBlock[i] = false;
@@ -1633,6 +1649,42 @@ struct TrackMeanOccTableProducer {
     bcInTF = (bc.globalBC() - bcSOR) % nBCsPerTF;
   }
 
+  // fills the prefix sums of all the estimators from the occupancy vectors of the current TF
+  void buildPrefixSums()
+  {
+    // in the order of OccNamesEnum
+    const std::vector<float>* occVectors[] = {
+      &occPrimUnfm80, &occFV0AUnfm80, &occFV0CUnfm80, &occFT0AUnfm80, &occFT0CUnfm80, &occFDDAUnfm80, &occFDDCUnfm80,
+      &occNTrackITSUnfm80, &occNTrackTPCUnfm80, &occNTrackTRDUnfm80, &occNTrackTOFUnfm80, &occNTrackSizeUnfm80,
+      &occNTrackTPCAUnfm80, &occNTrackTPCCUnfm80, &occNTrackITSTPCUnfm80, &occNTrackITSTPCAUnfm80, &occNTrackITSTPCCUnfm80,
+      &occMultNTracksHasITSUnfm80, &occMultNTracksHasTPCUnfm80, &occMultNTracksHasTOFUnfm80, &occMultNTracksHasTRDUnfm80,
+      &occMultNTracksITSOnlyUnfm80, &occMultNTracksTPCOnlyUnfm80, &occMultNTracksITSTPCUnfm80, &occMultAllTracksTPCOnlyUnfm80,
+      &occRobustT0V0PrimUnfm80, &occRobustFDDT0V0PrimUnfm80, &occRobustNtrackDetUnfm80, &occRobustMultTableUnfm80};
+    static_assert(std::size(occVectors) == kOccRobustMultTableUnfm80 + 1);
+    for (int occName = 0; occName <= kOccRobustMultTableUnfm80; occName++) {
+      auto row = occPrefixSums.begin() + static_cast<size_t>(occName) * occPrefixStride;
+      const auto& occVector = *occVectors[occName];
+      const int nBins = std::min<int>(occVector.size(), occPrefixStride - 1);
+      row[0] = 0.;
+      for (int i = 0; i < nBins; i++) {
+        row[i + 1] = row[i] + occVector[i];
+      }
+      std::fill(row + nBins + 1, row + occPrefixStride, row[nBins]);
+    }
+  }
+
+  float getMeanOccupancy(int bcBegin, int bcEnd, const std::vector<float>& OccVector, int occName)
+  {
+    if (!cfgUsePrefixSums) {
+      return getMeanOccupancy(bcBegin, bcEnd, OccVector);
+    }
+    // same range as the loop, limited to the bins of the TF
+    const int binStart = std::clamp(std::min(bcBegin, bcEnd), 0, occPrefixStride - 2);
+    const int binEnd = std::clamp(std::max(bcBegin, bcEnd), 0, occPrefixStride - 2);
+    auto row = occPrefixSums.begin() + static_cast<size_t>(occName) * occPrefixStride;
+    return static_cast<float>((row[binEnd + 1] - row[binStart]) / (binEnd - binStart + 1));
+  }
+
   float getMeanOccupancy(int bcBegin, int bcEnd, const std::vector<float>& OccVector)
   {
     float sumOfBins = 0;
@@ -2029,6 +2081,9 @@ struct TrackMeanOccTableProducer {
           if constexpr (processMode == kProcessFullOccTableProducer || processMode == kProcessOnlyRobustMultExtra) {
             std::copy(occsList.occRobustMultExtraTableUnfm80().begin(), occsList.occRobustMultExtraTableUnfm80().end(), occRobustMultTableUnfm80.begin());
           }
+          if (cfgUsePrefixSums) {
+            buildPrefixSums();
+          }
         }
 
         // Timebc = TGlobalBC+ΔTdrift
@@ -2072,7 +2127,7 @@ struct TrackMeanOccTableProducer {
 
         if constexpr (qaMode == fillOccRobustT0V0dependentQA) {
           if constexpr (meanTableMode == fillMeanOccTable) {
-            meanOccRobustT0V0PrimUnfm80 = getMeanOccupancy(binBCbegin, binBCend, occRobustT0V0PrimUnfm80);
+            meanOccRobustT0V0PrimUnfm80 = getMeanOccupancy(binBCbegin, binBCend, occRobustT0V0PrimUnfm80, kOccRobustT0V0PrimUnfm80);
           }
           if constexpr (weightMeanTableMode == fillWeightMeanOccTable) {
             weightMeanOccRobustT0V0PrimUnfm80 = getWeightedMeanOccupancy(binBCbegin, binBCend, occRobustT0V0PrimUnfm80);
@@ -2081,7 +2136,7 @@ struct TrackMeanOccTableProducer {
 
         if constexpr (processMode == kProcessFullOccTableProducer || processMode == kProcessOnlyOccPrim) {
           if constexpr (meanTableMode == fillMeanOccTable) {
-            meanOccPrimUnfm80 = getMeanOccupancy(binBCbegin, binBCend, occPrimUnfm80);
+            meanOccPrimUnfm80 = getMeanOccupancy(binBCbegin, binBCend, occPrimUnfm80, kOccPrimUnfm80);
             genTmoPrim(meanOccPrimUnfm80);
             fillQAInfo<kMean, kRobustT0V0Prim, kOccPrimUnfm80>(meanOccPrimUnfm80, meanOccRobustT0V0PrimUnfm80);
           }
@@ -2095,10 +2150,10 @@ struct TrackMeanOccTableProducer {
 
         if constexpr (processMode == kProcessFullOccTableProducer || processMode == kProcessOnlyOccT0V0) {
           if constexpr (meanTableMode == fillMeanOccTable) {
-            meanOccFV0AUnfm80 = getMeanOccupancy(binBCbegin, binBCend, occFV0AUnfm80);
-            meanOccFV0CUnfm80 = getMeanOccupancy(binBCbegin, binBCend, occFV0CUnfm80);
-            meanOccFT0AUnfm80 = getMeanOccupancy(binBCbegin, binBCend, occFT0AUnfm80);
-            meanOccFT0CUnfm80 = getMeanOccupancy(binBCbegin, binBCend, occFT0CUnfm80);
+            meanOccFV0AUnfm80 = getMeanOccupancy(binBCbegin, binBCend, occFV0AUnfm80, kOccFV0AUnfm80);
+            meanOccFV0CUnfm80 = getMeanOccupancy(binBCbegin, binBCend, occFV0CUnfm80, kOccFV0CUnfm80);
+            meanOccFT0AUnfm80 = getMeanOccupancy(binBCbegin, binBCend, occFT0AUnfm80, kOccFT0AUnfm80);
+            meanOccFT0CUnfm80 = getMeanOccupancy(binBCbegin, binBCend, occFT0CUnfm80, kOccFT0CUnfm80);
             genTmoT0V0(meanOccFV0AUnfm80,
                        meanOccFV0CUnfm80,
                        meanOccFT0AUnfm80,
@@ -2131,8 +2186,8 @@ struct TrackMeanOccTableProducer {
 
         if constexpr (processMode == kProcessFullOccTableProducer || processMode == kProcessOnlyOccFDD) {
           if constexpr (meanTableMode == fillMeanOccTable) {
-            meanOccFDDAUnfm80 = getMeanOccupancy(binBCbegin, binBCend, occFDDAUnfm80);
-            meanOccFDDCUnfm80 = getMeanOccupancy(binBCbegin, binBCend, occFDDCUnfm80);
+            meanOccFDDAUnfm80 = getMeanOccupancy(binBCbegin, binBCend, occFDDAUnfm80, kOccFDDAUnfm80);
+            meanOccFDDCUnfm80 = getMeanOccupancy(binBCbegin, binBCend, occFDDCUnfm80, kOccFDDCUnfm80);
             genTmoFDD(meanOccFDDAUnfm80,
                       meanOccFDDCUnfm80);
             fillQAInfo<kMean, kRobustT0V0Prim, kOccFDDAUnfm80>(meanOccFDDAUnfm80, meanOccRobustT0V0PrimUnfm80);
@@ -2153,16 +2208,16 @@ struct TrackMeanOccTableProducer {
 
         if constexpr (processMode == kProcessFullOccTableProducer || processMode == kProcessOnlyOccNtrackDet) {
           if constexpr (meanTableMode == fillMeanOccTable) {
-            meanOccNTrackITSUnfm80 = getMeanOccupancy(binBCbegin, binBCend, occNTrackITSUnfm80);
-            meanOccNTrackTPCUnfm80 = getMeanOccupancy(binBCbegin, binBCend, occNTrackTPCUnfm80);
-            meanOccNTrackTRDUnfm80 = getMeanOccupancy(binBCbegin, binBCend, occNTrackTRDUnfm80);
-            meanOccNTrackTOFUnfm80 = getMeanOccupancy(binBCbegin, binBCend, occNTrackTOFUnfm80);
-            meanOccNTrackSizeUnfm80 = getMeanOccupancy(binBCbegin, binBCend, occNTrackSizeUnfm80);
-            meanOccNTrackTPCAUnfm80 = getMeanOccupancy(binBCbegin, binBCend, occNTrackTPCAUnfm80);
-            meanOccNTrackTPCCUnfm80 = getMeanOccupancy(binBCbegin, binBCend, occNTrackTPCCUnfm80);
-            meanOccNTrackITSTPCUnfm80 = getMeanOccupancy(binBCbegin, binBCend, occNTrackITSTPCUnfm80);
-            meanOccNTrackITSTPCAUnfm80 = getMeanOccupancy(binBCbegin, binBCend, occNTrackITSTPCAUnfm80);
-            meanOccNTrackITSTPCCUnfm80 = getMeanOccupancy(binBCbegin, binBCend, occNTrackITSTPCCUnfm80);
+            meanOccNTrackITSUnfm80 = getMeanOccupancy(binBCbegin, binBCend, occNTrackITSUnfm80, kOccNTrackITSUnfm80);
+            meanOccNTrackTPCUnfm80 = getMeanOccupancy(binBCbegin, binBCend, occNTrackTPCUnfm80, kOccNTrackTPCUnfm80);
+            meanOccNTrackTRDUnfm80 = getMeanOccupancy(binBCbegin, binBCend, occNTrackTRDUnfm80, kOccNTrackTRDUnfm80);
+            meanOccNTrackTOFUnfm80 = getMeanOccupancy(binBCbegin, binBCend, occNTrackTOFUnfm80, kOccNTrackTOFUnfm80);
+            meanOccNTrackSizeUnfm80 = getMeanOccupancy(binBCbegin, binBCend, occNTrackSizeUnfm80, kOccNTrackSizeUnfm80);
+            meanOccNTrackTPCAUnfm80 = getMeanOccupancy(binBCbegin, binBCend, occNTrackTPCAUnfm80, kOccNTrackTPCAUnfm80);
+            meanOccNTrackTPCCUnfm80 = getMeanOccupancy(binBCbegin, binBCend, occNTrackTPCCUnfm80, kOccNTrackTPCCUnfm80);
+            meanOccNTrackITSTPCUnfm80 = getMeanOccupancy(binBCbegin, binBCend, occNTrackITSTPCUnfm80, kOccNTrackITSTPCUnfm80);
+            meanOccNTrackITSTPCAUnfm80 = getMeanOccupancy(binBCbegin, binBCend, occNTrackITSTPCAUnfm80, kOccNTrackITSTPCAUnfm80);
+            meanOccNTrackITSTPCCUnfm80 = getMeanOccupancy(binBCbegin, binBCend, occNTrackITSTPCCUnfm80, kOccNTrackITSTPCCUnfm80);
             genTmoNTrackDet(meanOccNTrackITSUnfm80,
                             meanOccNTrackTPCUnfm80,
                             meanOccNTrackTRDUnfm80,
@@ -2233,14 +2288,14 @@ struct TrackMeanOccTableProducer {
 
         if constexpr (processMode == kProcessFullOccTableProducer || processMode == kProcessOnlyOccMultExtra) {
           if constexpr (meanTableMode == fillMeanOccTable) {
-            meanOccMultNTracksHasITSUnfm80 = getMeanOccupancy(binBCbegin, binBCend, occMultNTracksHasITSUnfm80);
-            meanOccMultNTracksHasTPCUnfm80 = getMeanOccupancy(binBCbegin, binBCend, occMultNTracksHasTPCUnfm80);
-            meanOccMultNTracksHasTOFUnfm80 = getMeanOccupancy(binBCbegin, binBCend, occMultNTracksHasTOFUnfm80);
-            meanOccMultNTracksHasTRDUnfm80 = getMeanOccupancy(binBCbegin, binBCend, occMultNTracksHasTRDUnfm80);
-            meanOccMultNTracksITSOnlyUnfm80 = getMeanOccupancy(binBCbegin, binBCend, occMultNTracksITSOnlyUnfm80);
-            meanOccMultNTracksTPCOnlyUnfm80 = getMeanOccupancy(binBCbegin, binBCend, occMultNTracksTPCOnlyUnfm80);
-            meanOccMultNTracksITSTPCUnfm80 = getMeanOccupancy(binBCbegin, binBCend, occMultNTracksITSTPCUnfm80);
-            meanOccMultAllTracksTPCOnlyUnfm80 = getMeanOccupancy(binBCbegin, binBCend, occMultAllTracksTPCOnlyUnfm80);
+            meanOccMultNTracksHasITSUnfm80 = getMeanOccupancy(binBCbegin, binBCend, occMultNTracksHasITSUnfm80, kOccMultNTracksHasITSUnfm80);
+            meanOccMultNTracksHasTPCUnfm80 = getMeanOccupancy(binBCbegin, binBCend, occMultNTracksHasTPCUnfm80, kOccMultNTracksHasTPCUnfm80);
+            meanOccMultNTracksHasTOFUnfm80 = getMeanOccupancy(binBCbegin, binBCend, occMultNTracksHasTOFUnfm80, kOccMultNTracksHasTOFUnfm80);
+            meanOccMultNTracksHasTRDUnfm80 = getMeanOccupancy(binBCbegin, binBCend, occMultNTracksHasTRDUnfm80, kOccMultNTracksHasTRDUnfm80);
+            meanOccMultNTracksITSOnlyUnfm80 = getMeanOccupancy(binBCbegin, binBCend, occMultNTracksITSOnlyUnfm80, kOccMultNTracksITSOnlyUnfm80);
+            meanOccMultNTracksTPCOnlyUnfm80 = getMeanOccupancy(binBCbegin, binBCend, occMultNTracksTPCOnlyUnfm80, kOccMultNTracksTPCOnlyUnfm80);
+            meanOccMultNTracksITSTPCUnfm80 = getMeanOccupancy(binBCbegin, binBCend, occMultNTracksITSTPCUnfm80, kOccMultNTracksITSTPCUnfm80);
+            meanOccMultAllTracksTPCOnlyUnfm80 = getMeanOccupancy(binBCbegin, binBCend, occMultAllTracksTPCOnlyUnfm80, kOccMultAllTracksTPCOnlyUnfm80);
             genTmoMultExtra(meanOccMultNTracksHasITSUnfm80,
                             meanOccMultNTracksHasTPCUnfm80,
                             meanOccMultNTracksHasTOFUnfm80,
@@ -2299,7 +2354,7 @@ struct TrackMeanOccTableProducer {
 
         if constexpr (processMode == kProcessFullOccTableProducer || processMode == kProcessOnlyRobustT0V0Prim) {
           if constexpr (meanTableMode == fillMeanOccTable) {
-            meanOccRobustT0V0PrimUnfm80 = getMeanOccupancy(binBCbegin, binBCend, occRobustT0V0PrimUnfm80);
+            meanOccRobustT0V0PrimUnfm80 = getMeanOccupancy(binBCbegin, binBCend, occRobustT0V0PrimUnfm80, kOccRobustT0V0PrimUnfm80);
             genTmoRT0V0Prim(meanOccRobustT0V0PrimUnfm80);
             fillQAInfo<kMean, kRobustT0V0Prim, kOccRobustT0V0PrimUnfm80>(meanOccRobustT0V0PrimUnfm80, meanOccRobustT0V0PrimUnfm80);
           }
@@ -2313,7 +2368,7 @@ struct TrackMeanOccTableProducer {
 
         if constexpr (processMode == kProcessFullOccTableProducer || processMode == kProcessOnlyRobustFDDT0V0Prim) {
           if constexpr (meanTableMode == fillMeanOccTable) {
-            meanOccRobustFDDT0V0PrimUnfm80 = getMeanOccupancy(binBCbegin, binBCend, occRobustFDDT0V0PrimUnfm80);
+            meanOccRobustFDDT0V0PrimUnfm80 = getMeanOccupancy(binBCbegin, binBCend, occRobustFDDT0V0PrimUnfm80, kOccRobustFDDT0V0PrimUnfm80);
             genTmoRFDDT0V0Prim(meanOccRobustFDDT0V0PrimUnfm80);
             fillQAInfo<kMean, kRobustT0V0Prim, kOccRobustFDDT0V0PrimUnfm80>(meanOccRobustFDDT0V0PrimUnfm80, meanOccRobustT0V0PrimUnfm80);
           }
@@ -2327,7 +2382,7 @@ struct TrackMeanOccTableProducer {
 
         if constexpr (processMode == kProcessFullOccTableProducer || processMode == kProcessOnlyRobustNtrackDet) {
           if constexpr (meanTableMode == fillMeanOccTable) {
-            meanOccRobustNtrackDetUnfm80 = getMeanOccupancy(binBCbegin, binBCend, occRobustNtrackDetUnfm80);
+            meanOccRobustNtrackDetUnfm80 = getMeanOccupancy(binBCbegin, binBCend, occRobustNtrackDetUnfm80, kOccRobustNtrackDetUnfm80);
             genTmoRNtrackDet(meanOccRobustNtrackDetUnfm80);
             fillQAInfo<kMean, kRobustT0V0Prim, kOccRobustNtrackDetUnfm80>(meanOccRobustNtrackDetUnfm80, meanOccRobustT0V0PrimUnfm80);
           }
@@ -2341,7 +2396,7 @@ struct TrackMeanOccTableProducer {
 
         if constexpr (processMode == kProcessFullOccTableProducer || processMode == kProcessOnlyRobustMultExtra) {
           if constexpr (meanTableMode == fillMeanOccTable) {
-            meanOccRobustMultTableUnfm80 = getMeanOccupancy(binBCbegin, binBCend, occRobustMultTableUnfm80);
+            meanOccRobustMultTableUnfm80 = getMeanOccupancy(binBCbegin, binBCend, occRobustMultTableUnfm80, kOccRobustMultTableUnfm80);
             genTmoRMultExtra(meanOccRobustMultTableUnfm80);
             fillQAInfo<kMean, kRobustT0V0Prim, kOccRobustMultTableUnfm80>(meanOccRobustMultTableUnfm80, meanOccRobustT0V0PrimUnfm80);
           }
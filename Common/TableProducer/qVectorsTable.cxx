@@ -167,6 +167,15 @@ struct qVectorsTable {
   std::vector<float> FT0RelGainConst{};
   std::vector<float> FV0RelGainConst{};
 
+  // TPC tracks passing the track selection, collected once per collision for all the harmonics
+  struct SelectedTrack {
+    float pt;
+    float eta;
+    float phi;
+    int globalIndex;
+  };
+  std::vector<SelectedTrack> selectedTracks{};
+
   // Enable access to the CCDB for the offset and correction constants and save them
   // in dedicated variables.
   Service<o2::ccdb::BasicCCDBManager> ccdb;
@@ -294,6 +303,10 @@ struct qVectorsTable {
       LOGF(fatal, "Could not get the alignment parameters for FV0.");
     }
 
+    // cos(n phi) and sin(n phi) of the FT0 and FV0 channels for each harmonic of cfgnMods,
+    // computed for each run once the alignment offsets are known
+    helperEP.SetChannelHarmonics(cfgnMods.value, ft0geom, fv0geom);
+
     corrsQvecSp.clear();
     for (std::size_t i = 0; i < cfgnMods->size(); i++) {
       int ind = cfgnMods->at(i);
@@ -564,17 +577,18 @@ struct qVectorsTable {
   }
 
   /// Function to calculate the un-normalized q-vectors
+  /// \param iMode is the index of the harmonic in cfgnMods
   /// \param nMode is the harmonic number of the q-vector
   /// \param coll is the collision object
-  /// \param tracks are the tracks associated to the collision
+  /// \param tracks are the tracks associated to the collision passing the track selection
   /// \param qVecRe is the vector with the real part of the q-vector for each detector
   /// \param qVecIm is the vector with the imaginary part of the q-vector for each detector
   /// \param qVecAmp is the vector with the amplitude of the signal in each detector
   /// \param trkTPCPosLabel is the vector with the number of TPC tracks with positive eta
   /// \param trkTPCNegLabel is the vector with the number of TPC tracks with negative eta
   /// \param trkTPCAllLabel is the vector with the number of TPC tracks with any eta
-  template <typename Nmode, typename CollType, typename TrackType>
-  void calcQVec(const Nmode nMode, const CollType& coll, const TrackType& tracks, std::vector<float>& qVecRe, std::vector<float>& qVecIm, std::vector<float>& qVecAmp, std::vector<int>& trkTPCPosLabel, std::vector<int>& trkTPCNegLabel, std::vector<int>& trkTPCAllLabel)
+  template <typename Nmode, typename CollType>
+  void calcQVec(const std::size_t iMode, const Nmode nMode, const CollType& coll, std::vector<SelectedTrack> const& tracks, std::vector<float>& qVecRe, std::vector<float>& qVecIm, std::vector<float>& qVecAmp, std::vector<int>& trkTPCPosLabel, std::vector<int>& trkTPCNegLabel, std::vector<int>& trkTPCAllLabel)
   {
     float qVectFT0A[2] = {-999., -999.};
     float qVectFT0C[2] = {-999., -999.};
@@ -586,6 +600,10 @@ struct qVectorsTable {
 
     TComplex qVecDet(0);
     TComplex qVecFT0M(0);
+    const auto& cosFT0 = helperEP.GetCosPhiFT0(iMode);
+    const auto& sinFT0 = helperEP.GetSinPhiFT0(iMode);
+    const auto& cosFV0 = helperEP.GetCosPhiFV0(iMode);
+    const auto& sinFV0 = helperEP.GetSinPhiFV0(iMode);
     float sumAmplFT0A = 0.;
     float sumAmplFT0C = 0.;
     float sumAmplFT0M = 0.;
@@ -602,8 +620,11 @@ struct qVectorsTable {
           histosQA.fill(HIST("FT0Amp"), ampl, FT0AchId);
           histosQA.fill(HIST("FT0AmpCor"), ampl / FT0RelGainConst[FT0AchId], FT0AchId);
 
-          helperEP.SumQvectors(0, FT0AchId, ampl / FT0RelGainConst[FT0AchId], nMode, qVecDet, sumAmplFT0A, ft0geom, fv0geom);
-          helperEP.SumQvectors(0, FT0AchId, ampl / FT0RelGainConst[FT0AchId], nMode, qVecFT0M, sumAmplFT0M, ft0geom, fv0geom);
+          float amplCor = ampl / FT0RelGainConst[FT0AchId];
+          qVecDet += TComplex(amplCor * cosFT0[FT0AchId], amplCor * sinFT0[FT0AchId]);
+          sumAmplFT0A += amplCor;
+          qVecFT0M += TComplex(amplCor * cosFT0[FT0AchId], amplCor * sinFT0[FT0AchId]);
+          sumAmplFT0M += amplCor;
         }
         if (sumAmplFT0A > minAmplitude) {
           qVectFT0A[0] = qVecDet.Re();
@@ -620,8 +641,11 @@ struct qVectorsTable {
           histosQA.fill(HIST("FT0Amp"), ampl, FT0CchId);
           histosQA.fill(HIST("FT0AmpCor"), ampl / FT0RelGainConst[FT0CchId], FT0CchId);
 
-          helperEP.SumQvectors(0, FT0CchId, ampl / FT0RelGainConst[FT0CchId], nMode, qVecDet, sumAmplFT0C, ft0geom, fv0geom);
-          helperEP.SumQvectors(0, FT0CchId, ampl / FT0RelGainConst[FT0CchId], nMode, qVecFT0M, sumAmplFT0M, ft0geom, fv0geom);
+          float amplCor = ampl / FT0RelGainConst[FT0CchId];
+          qVecDet += TComplex(amplCor * cosFT0[FT0CchId], amplCor * sinFT0[FT0CchId]);
+          sumAmplFT0C += amplCor;
+          qVecFT0M += TComplex(amplCor * cosFT0[FT0CchId], amplCor * sinFT0[FT0CchId]);
+          sumAmplFT0M += amplCor;
         }
 
         if (sumAmplFT0C > minAmplitude) {
@@ -645,7 +669,9 @@ struct qVectorsTable {
           histosQA.fill(HIST("FV0Amp"), ampl, FV0AchId);
           histosQA.fill(HIST("FV0AmpCor"), ampl / FV0RelGainConst[FV0AchId], FV0AchId);
 
-          helperEP.SumQvectors(1, FV0AchId, ampl / FV0RelGainConst[FV0AchId], nMode, qVecDet, sumAmplFV0A, ft0geom, fv0geom);
+          float amplCor = ampl / FV0RelGainConst[FV0AchId];
+          qVecDet += TComplex(amplCor * cosFV0[FV0AchId], amplCor * sinFV0[FV0AchId]);
+          sumAmplFV0A += amplCor;
         }
 
         if (sumAmplFV0A > minAmplitude) {
@@ -659,33 +685,34 @@ struct qVectorsTable {
     int nTrkTPCNeg = 0;
     int nTrkTPCAll = 0;
 
+    const bool useTPCPos = useDetector["QvectorTPCposs"] || useDetector["QvectorBPoss"];
+    const bool useTPCNeg = useDetector["QvectorTPCnegs"] || useDetector["QvectorBNegs"];
     for (auto const& trk : tracks) {
-      if (!selTrack(trk)) {
-        continue;
-      }
-      histosQA.fill(HIST("ChTracks"), trk.pt(), trk.eta(), trk.phi(), cent);
-      if (trk.eta() > cfgEtaMax) {
+      histosQA.fill(HIST("ChTracks"), trk.pt, trk.eta, trk.phi, cent);
+      if (trk.eta > cfgEtaMax) {
         continue;
       }
-      if (trk.eta() < cfgEtaMin) {
+      if (trk.eta < cfgEtaMin) {
         continue;
       }
-      qVectTPCAll[0] += trk.pt() * std::cos(trk.phi() * nMode);
-      qVectTPCAll[1] += trk.pt() * std::sin(trk.phi() * nMode);
-      trkTPCAllLabel.push_back(trk.globalIndex());
+      const float cosPhi = std::cos(trk.phi * nMode);
+      const float sinPhi = std::sin(trk.phi * nMode);
+      qVectTPCAll[0] += trk.pt * cosPhi;
+      qVectTPCAll[1] += trk.pt * sinPhi;
+      trkTPCAllLabel.push_back(trk.globalIndex);
       nTrkTPCAll++;
-      if (std::abs(trk.eta()) < 0.1) {
+      if (std::abs(trk.eta) < 0.1) {
         continue;
       }
-      if (trk.eta() > 0 && (useDetector["QvectorTPCposs"] || useDetector["QvectorBPoss"])) {
-        qVectTPCPos[0] += trk.pt() * std::cos(trk.phi() * nMode);
-        qVectTPCPos[1] += trk.pt() * std::sin(trk.phi() * nMode);
-        trkTPCPosLabel.push_back(trk.globalIndex());
+      if (trk.eta > 0 && useTPCPos) {
+        qVectTPCPos[0] += trk.pt * cosPhi;
+        qVectTPCPos[1] += trk.pt * sinPhi;
+        trkTPCPosLabel.push_back(trk.globalIndex);
         nTrkTPCPos++;
-      } else if (trk.eta() < 0 && (useDetector["QvectorTPCnegs"] || useDetector["QvectorBNegs"])) {
-        qVectTPCNeg[0] += trk.pt() * std::cos(trk.phi() * nMode);
-        qVectTPCNeg[1] += trk.pt() * std::sin(trk.phi() * nMode);
-        trkTPCNegLabel.push_back(trk.globalIndex());
+      } else if (trk.eta < 0 && useTPCNeg) {
+        qVectTPCNeg[0] += trk.pt * cosPhi;
+        qVectTPCNeg[1] += trk.pt * sinPhi;
+        trkTPCNegLabel.push_back(trk.globalIndex);
         nTrkTPCNeg++;
       }
     }
@@ -772,13 +799,21 @@ struct qVectorsTable {
       isCalibrated = false;
     }
 
+    // the track selection is the same for all the harmonics
+    selectedTracks.clear();
+    for (auto const& trk : tracks) {
+      if (selTrack(trk)) {
+        selectedTracks.push_back({trk.pt(), trk.eta(), trk.phi(), static_cast<int>(trk.globalIndex())});
+      }
+    }
+
     for (std::size_t id = 0; id < cfgnMods->size(); id++) {
       int nMode = cfgnMods->at(id);
 
       // Raw Q-vectors, no multiplicity normalization and no corrections
       std::vector<float> qVecReRaw{};
       std::vector<float> qVecImRaw{};
-      calcQVec(nMode, coll, tracks, qVecReRaw, qVecImRaw, qVecAmp, trkTPCPosLabel, trkTPCNegLabel, trkTPCAllLabel);
+      calcQVec(id, nMode, coll, selectedTracks, qVecReRaw, qVecImRaw, qVecAmp, trkTPCPosLabel, trkTPCNegLabel, trkTPCAllLabel);
 
       // Scalar Product Q-vectors, normalization by multiplicity/amplitude
       std::vector<float> nModeQVecReSp{};
@@ -78,9 +78,9 @@ struct TimestampTask {
     }
   }
 
-  void process(aod::BC const& bc)
+  // sets orbitResetTimestamp and runDuration for runNumber
+  void setRun(int runNumber)
   {
-    int runNumber = bc.runNumber();
     // We need to set the orbit-reset timestamp for the run number.
     // This is done with caching if the run number was already processed before.
     // If not the orbit-reset timestamp for the run number is queried from CCDB and added to the cache
@@ -122,19 +122,31 @@ struct TimestampTask {
       mapRunToRunDuration[runNumber] = runDuration;
       LOGF(info, "Add new run number %i with orbit-reset timestamp %llu, SOR: %llu, EOR: %llu to cache", runNumber, orbitResetTimestamp, runDuration.first, runDuration.second);
     }
+    lastRunNumber = runNumber;
+  }
 
-    if (verbose.value) {
-      LOGF(info, "Orbit-reset timestamp for run number %i found: %llu us", runNumber, orbitResetTimestamp);
-    }
-    int64_t timestamp{(orbitResetTimestamp + int64_t(bc.globalBC() * o2::constants::lhc::LHCBunchSpacingNS * 1e-3)) / 1000}; // us -> ms
-    if (timestamp < runDuration.first || timestamp > runDuration.second) {
-      if (fatalOnInvalidTimestamp.value) {
-        LOGF(fatal, "Timestamp %llu us is out of run duration [%llu, %llu] ms", timestamp, runDuration.first, runDuration.second);
-      } else {
-        LOGF(debug, "Timestamp %llu us is out of run duration [%llu, %llu] ms", timestamp, runDuration.first, runDuration.second);
+  void process(aod::BCs const& bcs)
+  {
+    timestampTable.reserve(bcs.size());
+    for (auto const& bc : bcs) {
+      int runNumber = bc.runNumber();
+      if (runNumber != lastRunNumber) {
+        setRun(runNumber);
+      }
+
+      if (verbose.value) {
+        LOGF(info, "Orbit-reset timestamp for run number %i found: %llu us", runNumber, orbitResetTimestamp);
+      }
+      int64_t timestamp{(orbitResetTimestamp + int64_t(bc.globalBC() * o2::constants::lhc::LHCBunchSpacingNS * 1e-3)) / 1000}; // us -> ms
+      if (timestamp < runDuration.first || timestamp > runDuration.second) {
+        if (fatalOnInvalidTimestamp.value) {
+          LOGF(fatal, "Timestamp %llu us is out of run duration [%llu, %llu] ms", timestamp, runDuration.first, runDuration.second);
+        } else {
+          LOGF(debug, "Timestamp %llu us is out of run duration [%llu, %llu] ms", timestamp, runDuration.first, runDuration.second);
+        }
       }
+      timestampTable(timestamp);
     }
-    timestampTable(timestamp);
   }
 };
 
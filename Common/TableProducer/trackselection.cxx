@@ -31,7 +31,11 @@
 #include <Framework/InitContext.h>
 #include <Framework/runDataProcessing.h>
 
+#include <algorithm>
+#include <cstddef>
 #include <cstdint>
+#include <string>
+#include <vector>
 
 using namespace o2;
 using namespace o2::framework;
@@ -54,9 +58,12 @@ struct TrackSelectionTask {
   Configurable<float> ptMax{"ptMax", 1e10f, "Upper cut on pt for the track selected"};
   Configurable<float> etaMin{"etaMin", -0.8, "Lower cut on eta for the track selected"};
   Configurable<float> etaMax{"etaMax", 0.8, "Upper cut on eta for the track selected"};
+  Configurable<int> produceRegistryTable{"produceRegistryTable", -1, "option to produce the table with the decisions of the registered selections. -1 autosetup, 0 dislabled, 1 enabled"};
+  Configurable<std::vector<std::string>> registeredSelections{"registeredSelections", {}, "names of the registered selections to evaluate (see trackselectionregistry), empty for all of them"};
 
   Produces<aod::TrackSelection> filterTable;
   Produces<aod::TrackSelectionExtension> filterTableDetail;
+  Produces<aod::TrackSelectionBits> registryTable;
   TrackSelection globalTracks;
   TrackSelection globalTracksSDD;
   TrackSelection filtBit1;
@@ -64,12 +71,23 @@ struct TrackSelectionTask {
   TrackSelection filtBit3;
   TrackSelection filtBit4;
   TrackSelection filtBit5;
+  std::vector<uint16_t> globalTrackMasks; // per-track mask of globalTracks, filled column-wise per data frame
+
+  // registered selections with distinct cuts, each evaluated once per track
+  struct DistinctSelection {
+    TrackSelection selection;
+    uint32_t bits = 0;              // registered selections with these cuts
+    bool sameAsGlobalTracks = false; // decision taken from the globalTracks mask
+  };
+  std::vector<DistinctSelection> distinctSelections;
+  std::vector<uint32_t> registeredBits; // per-track decisions of the registered selections
 
   void init(InitContext& initContext)
   {
     // Check which tables are used
     o2::common::core::enableFlagIfTableRequired(initContext, "TrackSelection", produceTable);
     o2::common::core::enableFlagIfTableRequired(initContext, "TrackSelectionExtension", produceFBextendedTable);
+    o2::common::core::enableFlagIfTableRequired(initContext, "TrackSelectionBits", produceRegistryTable);
 
     // Set up the track cuts
     switch (itsMatching) {
@@ -142,6 +160,74 @@ struct TrackSelectionTask {
 
     LOG(info) << "setting up filtBit5 = getJEGlobalTrackSelectionRun2();";
     filtBit5 = getJEGlobalTrackSelectionRun2(); // Jet validation requires reduced set of cuts
+
+    // only the mask is needed from globalTracks, the other selections are boolean
+    globalTracksSDD.CompileSelection();
+    filtBit1.CompileSelection();
+    filtBit2.CompileSelection();
+    filtBit3.CompileSelection();
+    filtBit4.CompileSelection();
+    filtBit5.CompileSelection();
+
+    if (produceRegistryTable == 1) {
+      std::vector<int> selections;
+      for (const auto& name : registeredSelections.value) {
+        const int selection = trackselectionregistry::findSelection(name);
+        if (selection < 0) {
+          LOG(fatal) << "Track selection " << name << " is not registered";
+        }
+        selections.push_back(selection);
+      }
+      if (selections.empty()) {
+        for (int selection = 0; selection < trackselectionregistry::kNSelections; selection++) {
+          selections.push_back(selection);
+        }
+      }
+      const uint64_t globalTracksHash = globalTracks.GetConfigurationHash();
+      for (const auto& selection : selections) {
+        TrackSelection trackSelection = trackselectionregistry::getSelection(selection);
+        const uint64_t hash = trackSelection.GetConfigurationHash();
+        auto sameCuts = std::find_if(distinctSelections.begin(), distinctSelections.end(), [hash](const DistinctSelection& distinct) {
+          return distinct.selection.GetConfigurationHash() == hash;
+        });
+        if (sameCuts != distinctSelections.end()) {
+          sameCuts->bits |= 1u << selection;
+          continue;
+        }
+        trackSelection.CompileSelection();
+        distinctSelections.push_back({trackSelection, 1u << selection, hash == globalTracksHash});
+      }
+      LOG(info) << "Evaluating " << selections.size() << " registered track selections with " << distinctSelections.size() << " distinct sets of cuts";
+    }
+  }
+
+  template <typename TTracks>
+  void fillRegisteredSelections(TTracks const& tracks)
+  {
+    constexpr uint16_t AllCuts = (1u << static_cast<int>(TrackSelection::TrackCuts::kNCuts)) - 1;
+    registeredBits.assign(tracks.size(), 0);
+    for (const auto& distinct : distinctSelections) {
+      std::size_t iTrack = 0;
+      if (distinct.sameAsGlobalTracks) {
+        for (const auto& mask : globalTrackMasks) {
+          if (mask == AllCuts) {
+            registeredBits[iTrack] |= distinct.bits;
+          }
+          iTrack++;
+        }
+        continue;
+      }
+      for (const auto& track : tracks) {
+        if (distinct.selection.IsSelected(track)) {
+          registeredBits[iTrack] |= distinct.bits;
+        }
+        iTrack++;
+      }
+    }
+    registryTable.reserve(tracks.size());
+    for (const auto& bits : registeredBits) {
+      registryTable(bits);
+    }
   }
 
   void process(soa::Join<aod::FullTracks, aod::TracksDCA> const& tracks)
@@ -152,15 +238,24 @@ struct TrackSelectionTask {
     if (produceFBextendedTable == 1) {
       filterTableDetail.reserve(tracks.size());
     }
+    if (produceTable == 0 && produceFBextendedTable == 0 && produceRegistryTable == 0) {
+      return;
+    }
+    globalTracks.IsSelectedMask(tracks, globalTrackMasks);
+    if (produceRegistryTable == 1) {
+      fillRegisteredSelections(tracks);
+    }
     if (produceTable == 0 && produceFBextendedTable == 0) {
       return;
     }
+    std::size_t iTrack = 0;
     if (isRun3) {
       for (const auto& track : tracks) {
+        const o2::aod::track::TrackSelectionFlags::flagtype trackflagGlob = globalTrackMasks[iTrack++];
 
         if (produceTable == 1) {
           filterTable((uint8_t)0,
-                      globalTracks.IsSelectedMask(track),
+                      trackflagGlob,
                       filtBit1.IsSelected(track),
                       filtBit2.IsSelected(track),
                       filtBit3.IsSelected(track),
@@ -168,7 +263,6 @@ struct TrackSelectionTask {
                       filtBit5.IsSelected(track));
         }
         if (produceFBextendedTable == 1) {
-          o2::aod::track::TrackSelectionFlags::flagtype trackflagGlob = globalTracks.IsSelectedMask(track);
           o2::aod::track::TrackSelectionFlags::flagtype trackflagFB1 = filtBit1.IsSelectedMask(track);
           o2::aod::track::TrackSelectionFlags::flagtype trackflagFB2 = filtBit2.IsSelectedMask(track);
           // o2::aod::track::TrackSelectionFlags::flagtype trackflagFB3 = filtBit3.IsSelectedMask(track); // only temporarily commented, will be used
@@ -198,10 +292,10 @@ struct TrackSelectionTask {
     }
 
     for (const auto& track : tracks) {
-      o2::aod::track::TrackSelectionFlags::flagtype trackflagGlob = globalTracks.IsSelectedMask(track);
+      const o2::aod::track::TrackSelectionFlags::flagtype trackflagGlob = globalTrackMasks[iTrack++];
       if (produceTable == 1) {
         filterTable((uint8_t)globalTracksSDD.IsSelected(track),
-                    globalTracks.IsSelectedMask(track),
+                    trackflagGlob,
                     filtBit1.IsSelected(track),
                     filtBit2.IsSelected(track),
                     filtBit3.IsSelected(track),
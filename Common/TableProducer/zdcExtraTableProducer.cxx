@@ -15,6 +15,7 @@
 /// \author Uliana Dmitrieva <uliana.dmitrieva@cern.ch>, INFN Torino
 
 #include "Common/CCDB/EventSelectionParams.h"
+#include "Common/Core/ZdcCentroid.h"
 #include "Common/DataModel/Centrality.h"
 #include "Common/DataModel/EventSelection.h"
 #include "Common/DataModel/ZDCExtra.h"
@@ -33,6 +34,7 @@
 #include <TH2.h>
 #include <TRandom3.h>
 
+#include <array>
 #include <cmath>
 #include <cstdint>
 
@@ -187,7 +189,7 @@ struct ZdcExtraTableProducer {
   {
 
     // collision-based event selection
-    constexpr int NTowers = 4; // number of ZDC towers
+    constexpr int NTowers = o2::common::zdc::NTowers; // number of ZDC towers
 
     for (auto const& collision : cols) {
       const auto& foundBC = collision.foundBC_as<BCsRun3>();
@@ -252,8 +254,8 @@ struct ZdcExtraTableProducer {
         //
         double sumZNC = 0;
         double sumZNA = 0;
-        double pmqZNC[4] = {};
-        double pmqZNA[4] = {};
+        std::array<double, NTowers> pmqZNC = {};
+        std::array<double, NTowers> pmqZNA = {};
         //
         if (isZNChit) {
           for (int it = 0; it < NTowers; it++) {
@@ -287,34 +289,6 @@ struct ZdcExtraTableProducer {
         }
 
         // Q-vectors (centroid) calculation
-        // kBeamEne --  LHC Run 3 Pb-Pb collision energy (5.36 TeV per nucleon pair)
-        constexpr float kBeamEne = 5.36 * 0.5;
-
-        // Provide coordinates of centroid over ZN (side C) front face
-        constexpr float X[4] = {-1.75, 1.75, -1.75, 1.75};
-        constexpr float Y[4] = {-1.75, -1.75, 1.75, 1.75};
-        constexpr float kAlpha = 0.395; // saturation correction
-
-        float numXZNC = 0., numYZNC = 0., denZNC = 0.;
-        float numXZNA = 0., numYZNA = 0., denZNA = 0.;
-
-        // Calculate weighted sums of the x and y coordinates
-        for (int i = 0; i < NTowers; i++) {
-          if (pmqZNC[i] > 0.) {
-            float wZNC = std::pow(pmqZNC[i], kAlpha);
-            numXZNC -= X[i] * wZNC; // numerator x (minus sign due to opposite orientation of ZNC)
-            numYZNC += Y[i] * wZNC; // numerator y
-            denZNC += wZNC;         // denominator
-          }
-          if (pmqZNA[i] > 0.) {
-            float wZNA = std::pow(pmqZNA[i], kAlpha);
-            numXZNA += X[i] * wZNA; // numerator x
-            numYZNA += Y[i] * wZNA; // numerator y
-            denZNA += wZNA;         // denominator
-          }
-        }
-        // Calculate centroid coordinates (in cm) with correction factor c depending on the number of spectator nucleons (nSpec)
-
         float zncCommon = 0;
         float znaCommon = 0;
 
@@ -327,27 +301,8 @@ struct ZdcExtraTableProducer {
           znaCommon = sumZNA;
         }
 
-        float centroidZNC[2], centroidZNA[2];
-
-        if (denZNC != 0.) {
-          float nSpecnC = zncCommon / kBeamEne;
-          float cZNC = 1.89358 - 0.71262 / (nSpecnC + 0.71789);
-          centroidZNC[0] = cZNC * numXZNC / denZNC;
-          centroidZNC[1] = cZNC * numYZNC / denZNC;
-        } else {
-          centroidZNC[0] = 999.;
-          centroidZNC[1] = 999.;
-        }
-        //
-        if (denZNA != 0.) {
-          float nSpecnA = znaCommon / kBeamEne;
-          float cZNA = 1.89358 - 0.71262 / (nSpecnA + 0.71789);
-          centroidZNA[0] = cZNA * numXZNA / denZNA;
-          centroidZNA[1] = cZNA * numYZNA / denZNA;
-        } else {
-          centroidZNA[0] = 999.;
-          centroidZNA[1] = 999.;
-        }
+        const auto centroidZNC = o2::common::zdc::znCentroid(pmqZNC, zncCommon, true);
+        const auto centroidZNA = o2::common::zdc::znCentroid(pmqZNA, znaCommon, false);
         if (cfgSaveQaHistos) {
           if (isZNChit) {
             registry.get<TH2>(HIST("ZNCCentroid"))->Fill(centroidZNC[0], centroidZNC[1]);
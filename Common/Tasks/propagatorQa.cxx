@@ -37,12 +37,20 @@
 #include <MathUtils/Primitive2D.h>
 #include <ReconstructionDataFormats/Track.h>
 
+#include <TH1.h>
+#include <TH2.h>
 #include <TMath.h>
 #include <TMathBase.h>
+#include <TProfile.h>
+#include <TString.h>
 
 #include <array>
+#include <chrono>
 #include <cmath>
+#include <cstddef>
+#include <memory>
 #include <string>
+#include <vector>
 
 using namespace o2;
 using namespace o2::framework;
@@ -87,19 +95,56 @@ struct propagatorQa {
 
   Configurable<int> useMatCorrType{"useMatCorrType", 0, "0: none, 1: TGeo, 2: LUT"};
 
+  // Benchmark of the propagation settings (processBenchmark)
+  struct : ConfigurableGroup {
+    Configurable<int> sampling{"benchmarkSampling", 10, "propagate one track out of sampling with all the configurations"};
+    Configurable<std::vector<int>> matCorrTypes{"benchmarkMatCorrTypes", {0, 1, 2}, "material corrections to compare, 0: none, 1: TGeo, 2: LUT"};
+    Configurable<std::vector<float>> maxSteps{"benchmarkMaxSteps", {2.0f, 5.0f}, "max propagation steps to compare (cm)"};
+    Configurable<float> maxTime{"benchmarkMaxTime", 500.f, "upper limit of the propagation time axis (#mus)"};
+    Configurable<int> nBinsTime{"benchmarkNBinsTime", 500, "binning of the propagation time"};
+  } benchmark;
+
   HistogramRegistry histos{"Histos", {}, OutputObjHandlingPolicy::AnalysisObject};
 
   o2::track::TrackPar lTrackParametrization;
 
+  // one propagation setting of the benchmark, with its histograms
+  struct BenchmarkConfig {
+    o2::base::Propagator::MatCorrType matCorr;
+    float maxStep;
+    std::shared_ptr<TH2> hDeltaDCAVsPt;
+    std::shared_ptr<TH2> hDeltaPtVsPt;
+    std::shared_ptr<TH2> hTimeVsPt;
+  };
+  std::vector<BenchmarkConfig> benchmarkConfigs;
+  std::shared_ptr<TProfile> hBenchmarkMeanTime;
+  std::shared_ptr<TH1> hBenchmarkFailures;
+  int benchmarkTrackCounter = 0;
+
+  bool needsMatCorrType(int type)
+  {
+    if (useMatCorrType == type) {
+      return true;
+    }
+    if (doprocessBenchmark) {
+      for (const auto& benchmarkType : benchmark.matCorrTypes.value) {
+        if (benchmarkType == type) {
+          return true;
+        }
+      }
+    }
+    return false;
+  }
+
   void init(InitContext&)
   {
-    if (useMatCorrType == 1) {
+    if (needsMatCorrType(1)) {
       LOGF(info, "TGeo correction requested, loading geometry");
       if (!o2::base::GeometryManager::isGeometryLoaded()) {
         ccdb->get<TGeoManager>(geoPath);
       }
     }
-    if (useMatCorrType == 2) {
+    if (needsMatCorrType(2)) {
       LOGF(info, "LUT correction requested, loading LUT");
       lut = o2::base::MatLayerCylSet::rectifyPtrFromFile(ccdb->get<o2::base::MatLayerCylSet>(lutPath));
     }
@@ -171,6 +216,45 @@ struct propagatorQa {
       matCorr = o2::base::Propagator::MatCorrType::USEMatCorrTGeo;
     if (useMatCorrType == 2)
       matCorr = o2::base::Propagator::MatCorrType::USEMatCorrLUT;
+
+    if (doprocessBenchmark) {
+      initBenchmark(axisPt, axisDCAxy, axisDeltaPt);
+    }
+  }
+
+  void initBenchmark(const AxisSpec& axisPt, const AxisSpec& axisDCAxy, const AxisSpec& axisDeltaPt)
+  {
+    static constexpr std::array<const char*, 3> MatCorrNames = {"NoMat", "TGeo", "LUT"};
+    static constexpr std::array<o2::base::Propagator::MatCorrType, 3> MatCorrTypes = {o2::base::Propagator::MatCorrType::USEMatCorrNONE,
+                                                                                      o2::base::Propagator::MatCorrType::USEMatCorrTGeo,
+                                                                                      o2::base::Propagator::MatCorrType::USEMatCorrLUT};
+    const AxisSpec axisTime{benchmark.nBinsTime, 0.f, benchmark.maxTime, "propagation time (#mus)"};
+    for (const auto& type : benchmark.matCorrTypes.value) {
+      if (type < 0 || type >= static_cast<int>(MatCorrTypes.size())) {
+        LOGF(fatal, "Unknown material correction %d in benchmarkMatCorrTypes", type);
+      }
+      for (const auto& maxStep : benchmark.maxSteps.value) {
+        const std::string name = Form("Benchmark/%s_Step%.1f/", MatCorrNames[type], maxStep);
+        BenchmarkConfig config{MatCorrTypes[type], maxStep, nullptr, nullptr, nullptr};
+        config.hDeltaDCAVsPt = histos.add<TH2>((name + "hDeltaDCAVsPt").c_str(), "DCA_{xy} - propagated DCA_{xy}", kTH2F, {axisPt, axisDCAxy});
+        config.hDeltaPtVsPt = histos.add<TH2>((name + "hDeltaPtVsPt").c_str(), "#it{p}_{T} - propagated #it{p}_{T}", kTH2F, {axisPt, axisDeltaPt});
+        config.hTimeVsPt = histos.add<TH2>((name + "hTimeVsPt").c_str(), "CPU time of the propagation to the DCA", kTH2F, {axisPt, axisTime});
+        benchmarkConfigs.push_back(config);
+      }
+    }
+    const int nConfigs = benchmarkConfigs.size();
+    const AxisSpec axisConfig{nConfigs, -0.5f, nConfigs - 0.5f, "configuration"};
+    hBenchmarkMeanTime = histos.add<TProfile>("Benchmark/hMeanTime", "mean CPU time of the propagation;;time (#mus)", kTProfile, {axisConfig});
+    hBenchmarkFailures = histos.add<TH1>("Benchmark/hFailures", "failed propagations to the DCA", kTH1D, {axisConfig});
+    int iConfig = 0;
+    for (const auto& type : benchmark.matCorrTypes.value) {
+      for (const auto& maxStep : benchmark.maxSteps.value) {
+        const char* label = Form("%s, step %.1f", MatCorrNames[type], maxStep);
+        hBenchmarkMeanTime->GetXaxis()->SetBinLabel(iConfig + 1, label);
+        hBenchmarkFailures->GetXaxis()->SetBinLabel(iConfig + 1, label);
+        iConfig++;
+      }
+    }
   }
 
   void initCCDB(aod::BCsWithTimestamps::iterator const& bc)
@@ -211,7 +295,7 @@ struct propagatorQa {
     }
     mRunNumber = bc.runNumber();
 
-    if (useMatCorrType == 2) {
+    if (needsMatCorrType(2)) {
       o2::base::Propagator::Instance()->setMatLUT(lut);
     }
   }
@@ -483,6 +567,50 @@ struct propagatorQa {
     }
   }
   PROCESS_SWITCH(propagatorQa, processMatLUTTest, "process mat lut test", false);
+
+  // propagates a sample of the tracks with all the benchmark configurations: residuals w.r.t. the tracks at the DCA and CPU time
+  void processBenchmark(aod::Collision const& collision, soa::Join<aod::Tracks, aod::TracksExtra, aod::TracksDCA> const& tracks, soa::Join<aod::TracksIU, aod::TracksCovIU, aod::TracksExtra> const& tracksIU, aod::BCsWithTimestamps const&)
+  {
+    auto bc = collision.bc_as<aod::BCsWithTimestamps>();
+    initCCDB(bc);
+    std::array<float, 2> dcaInfo;
+
+    for (const auto& trackIU : tracksIU) {
+      if (trackIU.tpcNClsFound() < minTPCClustersRequired)
+        continue;
+
+      if (trackIU.trackType() != aod::track::TrackIU && trackIU.x() > maxXtoConsider)
+        continue;
+
+      if (benchmark.sampling > 1 && (benchmarkTrackCounter++ % benchmark.sampling) != 0)
+        continue;
+
+      const o2::track::TrackParCov trackParCovIU = getTrackParCov(trackIU);
+      auto track = tracks.iteratorAt(trackIU.globalIndex() - tracksIU.offset());
+
+      for (std::size_t iConfig = 0; iConfig < benchmarkConfigs.size(); iConfig++) {
+        const auto& config = benchmarkConfigs[iConfig];
+        o2::track::TrackParCov trackParCov = trackParCovIU;
+        dcaInfo[0] = 999;
+        dcaInfo[1] = 999;
+
+        const auto start = std::chrono::steady_clock::now();
+        const bool isPropagated = o2::base::Propagator::Instance()->propagateToDCABxByBz({collision.posX(), collision.posY(), collision.posZ()}, trackParCov, config.maxStep, config.matCorr, &dcaInfo);
+        const auto stop = std::chrono::steady_clock::now();
+        const float time = std::chrono::duration<float, std::micro>(stop - start).count();
+
+        config.hTimeVsPt->Fill(track.pt(), time);
+        hBenchmarkMeanTime->Fill(iConfig, time);
+        if (!isPropagated) {
+          hBenchmarkFailures->Fill(iConfig);
+          continue;
+        }
+        config.hDeltaDCAVsPt->Fill(track.pt(), track.dcaXY() - dcaInfo[0]);
+        config.hDeltaPtVsPt->Fill(track.pt(), track.pt() - trackParCov.getPt());
+      }
+    }
+  }
+  PROCESS_SWITCH(propagatorQa, processBenchmark, "propagate a sample of the tracks with several propagation settings, residuals and CPU time", false);
 };
 
 WorkflowSpec defineDataProcessing(ConfigContext const& cfgc)
@@ -21,6 +21,7 @@
 #include "Common/CCDB/TriggerAliases.h"
 #include "Common/Core/TableHelper.h"
 #include "Common/DataModel/EventSelection.h"
+#include "Common/Tools/RunContext.h"
 
 #include <CCDB/BasicCCDBManager.h>
 #include <CommonConstants/LHCConstants.h>
@@ -227,8 +228,7 @@ class BcSelectionModule
         // duration of TF in bcs
         nBCsPerTF = 32; // hard-coded for Run3 MC (no info from ccdb at the moment)
       } else {
-        auto runInfo = (!isMC) ? o2::parameters::AggregatedRunInfo::buildAggregatedRunInfo(o2::ccdb::BasicCCDBManager::instance(), run)
-                               : o2::parameters::AggregatedRunInfo::buildAggregatedRunInfo(o2::ccdb::BasicCCDBManager::instance(), run, strLPMProductionTag);
+        auto runInfo = o2::common::RunContextCache::instance().getAggregatedRunInfo(run, isMC, strLPMProductionTag);
         LOGP(info, "BcSelectionModule: isMC = {}, NumberOfOrbitsPerTF extracted from AggregatedRunInfo = {}", isMC, runInfo.orbitsPerTF);
 
         // SOR and EOR timestamps
@@ -558,11 +558,11 @@ class BcSelectionModule
         if (isEnd)
           it--;
         nextOrbitForInactiveChips = isEnd ? orbit : it->first; // setting current orbit in case we reached the end of mapInactiveChips
-        auto vNextInactiveChips = it->second;
+        const auto& vNextInactiveChips = it->second;
         if (it != mapInactiveChips.begin() && !isEnd)
           it--;
         prevOrbitForInactiveChips = it->first;
-        auto vPrevInactiveChips = it->second;
+        const auto& vPrevInactiveChips = it->second;
         LOGP(debug, "orbit: {}, previous orbit: {}, next orbit: {} ", orbit, prevOrbitForInactiveChips, nextOrbitForInactiveChips);
         LOGP(debug, "next inactive chips: {} {} {} {} {} {} {}", vNextInactiveChips[0], vNextInactiveChips[1], vNextInactiveChips[2], vNextInactiveChips[3], vNextInactiveChips[4], vNextInactiveChips[5], vNextInactiveChips[6]);
         LOGP(debug, "prev inactive chips: {} {} {} {} {} {} {}", vPrevInactiveChips[0], vPrevInactiveChips[1], vPrevInactiveChips[2], vPrevInactiveChips[3], vPrevInactiveChips[4], vPrevInactiveChips[5], vPrevInactiveChips[6]);
@@ -706,6 +706,19 @@ class EventSelectionModule
     return wOccup;
   }
 
+  // calls f for the collisions in range = [first, last] except colIndex: the ones before colIndex from the
+  // closest one, then the ones after it, in the order of the scans which found the range
+  template <typename F>
+  static void forEachInRange(int32_t colIndex, std::pair<int32_t, int32_t> const& range, F&& f)
+  {
+    for (int32_t i = colIndex - 1; i >= range.first; i--) {
+      f(i);
+    }
+    for (int32_t i = colIndex + 1; i <= range.second; i++) {
+      f(i);
+    }
+  }
+
   // declaration of structs here
   // (N.B.: will be invisible to the outside, create your own copies)
   o2::common::eventselection::EvselConfigurables evselOpts;
@@ -754,8 +767,7 @@ class EventSelectionModule
     // extract bc pattern from CCDB for data or anchored MC only
     if (run != lastRun && run >= run3min) {
       lastRun = run;
-      auto runInfo = (!evselOpts.isMC) ? o2::parameters::AggregatedRunInfo::buildAggregatedRunInfo(o2::ccdb::BasicCCDBManager::instance(), run)
-                                       : o2::parameters::AggregatedRunInfo::buildAggregatedRunInfo(o2::ccdb::BasicCCDBManager::instance(), run, strLPMProductionTag);
+      auto runInfo = o2::common::RunContextCache::instance().getAggregatedRunInfo(run, evselOpts.isMC, strLPMProductionTag);
       LOGP(info, "EventSelectionModule: isMC = {}, NumberOfOrbitsPerTF extracted from AggregatedRunInfo = {}", (bool)evselOpts.isMC, runInfo.orbitsPerTF);
 
       // first bc of the first orbit
@@ -1175,11 +1187,20 @@ class EventSelectionModule
       }
     }
 
-    // save indices of collisions for occupancy calculation (both in ROF and in time range)
-    std::vector<std::vector<int>> vCollsInSameITSROF;
-    std::vector<std::vector<int>> vCollsInPrevITSROF;
-    std::vector<std::vector<int>> vCollsInTimeWin;
-    std::vector<std::vector<float>> vTimeDeltaForColls; // delta time wrt a given collision
+    // TF and ITS ROF of each collision
+    std::vector<int64_t> vTFid(cols.size(), 0);
+    std::vector<int64_t> vRofId(cols.size(), 0);
+    for (size_t colIndex = 0; colIndex < cols.size(); colIndex++) {
+      vTFid[colIndex] = (vFoundGlobalBC[colIndex] - bcSOR) / nBCsPerTF;
+      vRofId[colIndex] = (vFoundGlobalBC[colIndex] + nBCsPerOrbit - rofOffset) / rofLength;
+    }
+
+    // ranges of collisions for occupancy calculation (both in ROF and in time range), found by scans
+    // before and after a given collision: [first, last] in the table, the given collision excluded
+    std::vector<std::pair<int32_t, int32_t>> vRangeSameITSROF(cols.size());
+    std::vector<int32_t> vFirstForPrevITSROF(cols.size()); // [first, colIndex), only the ones in the previous ROF are used
+    std::vector<std::pair<int32_t, int32_t>> vRangeTimeWin(cols.size());
+    std::vector<std::pair<float, float>> pairsDeltaTimeMult; // delta time wrt a given collision and mult of associated collisions, for the median time calc
     for (const auto& col : cols) {
       int32_t colIndex = col.globalIndex();
       int64_t foundGlobalBC = vFoundGlobalBC[colIndex];
@@ -1190,116 +1211,71 @@ class EventSelectionModule
         vAmpFT0CperColl[colIndex] = foundFT0.sumAmpC();
       }
 
-      int64_t tfId = (foundGlobalBC - bcSOR) / nBCsPerTF;
-      int64_t rofId = (foundGlobalBC + nBCsPerOrbit - rofOffset) / rofLength;
+      int64_t tfId = vTFid[colIndex];
+      int64_t rofId = vRofId[colIndex];
 
       // ### for in-ROF occupancy
-      std::vector<int> vAssocCollInSameROF;
       // find all collisions in the same ROF before a given collision
       int32_t minColIndex = colIndex - 1;
-      while (minColIndex >= 0) {
-        int64_t thisBC = vFoundGlobalBC[minColIndex];
-        // check if this is still the same TF
-        int64_t thisTFid = (thisBC - bcSOR) / nBCsPerTF;
-        if (thisTFid != tfId)
-          break;
-        // int thisRofIdInTF = (thisBC - rofOffset) / rofLength;
-        int64_t thisRofId = (thisBC + nBCsPerOrbit - rofOffset) / rofLength;
-
-        // check if we are within the same ROF
-        if (thisRofId != rofId)
-          break;
-        vAssocCollInSameROF.push_back(minColIndex);
+      while (minColIndex >= 0 && vTFid[minColIndex] == tfId && vRofId[minColIndex] == rofId) {
         minColIndex--;
       }
       // find all collisions in the same ROF after the current one
       int32_t maxColIndex = colIndex + 1;
-      while (maxColIndex < cols.size()) {
-        int64_t thisBC = vFoundGlobalBC[maxColIndex];
-        int64_t thisTFid = (thisBC - bcSOR) / nBCsPerTF;
-        if (thisTFid != tfId)
-          break;
-        int64_t thisRofId = (thisBC + nBCsPerOrbit - rofOffset) / rofLength;
-        if (thisRofId != rofId)
-          break;
-        vAssocCollInSameROF.push_back(maxColIndex);
+      while (maxColIndex < cols.size() && vTFid[maxColIndex] == tfId && vRofId[maxColIndex] == rofId) {
         maxColIndex++;
       }
-      vCollsInSameITSROF.push_back(vAssocCollInSameROF);
+      vRangeSameITSROF[colIndex] = {minColIndex + 1, maxColIndex - 1};
 
       // ### bookkeep collisions in previous ROF
-      std::vector<int> vAssocCollInPrevROF;
       minColIndex = colIndex - 1;
-      while (minColIndex >= 0) {
-        int64_t thisBC = vFoundGlobalBC[minColIndex];
-        // check if this is still the same TF
-        int64_t thisTFid = (thisBC - bcSOR) / nBCsPerTF;
-        if (thisTFid != tfId)
-          break;
-        int64_t thisRofId = (thisBC + nBCsPerOrbit - rofOffset) / rofLength;
-        if (thisRofId == rofId - 1)
-          vAssocCollInPrevROF.push_back(minColIndex);
-        else if (thisRofId < rofId - 1)
-          break;
+      while (minColIndex >= 0 && vTFid[minColIndex] == tfId && vRofId[minColIndex] >= rofId - 1) {
         minColIndex--;
       }
-      vCollsInPrevITSROF.push_back(vAssocCollInPrevROF);
+      vFirstForPrevITSROF[colIndex] = minColIndex + 1;
 
       // ### for occupancy in time windows
-      std::vector<int> vAssocToThisCol;
-      std::vector<float> vCollsTimeDeltaWrtGivenColl;
-      std::vector<float> vProxyNtracksAssocColls; // mult of associated collisions, for the median time calc
       // find all collisions in time window before the current one
       minColIndex = colIndex - 1;
-      while (minColIndex >= 0) {
-        int64_t thisBC = vFoundGlobalBC[minColIndex];
-        // check if this is still the same TF
-        int64_t thisTFid = (thisBC - bcSOR) / nBCsPerTF;
-        if (thisTFid != tfId)
-          break;
-        float dt = (thisBC - foundGlobalBC) * bcNS; // ns
+      while (minColIndex >= 0 && vTFid[minColIndex] == tfId) {
+        float dt = (vFoundGlobalBC[minColIndex] - foundGlobalBC) * bcNS; // ns
         // check if we are within the chosen time range
         if (dt < timeWinOccupancyCalcMinNS)
           break;
-        vAssocToThisCol.push_back(minColIndex);
-        vCollsTimeDeltaWrtGivenColl.push_back(dt);
-        vProxyNtracksAssocColls.push_back(vProxyForCollNtracks[minColIndex]);
         minColIndex--;
       }
       // find all collisions in time window after the current one
       maxColIndex = colIndex + 1;
-      while (maxColIndex < cols.size()) {
-        int64_t thisBC = vFoundGlobalBC[maxColIndex];
-        int64_t thisTFid = (thisBC - bcSOR) / nBCsPerTF;
-        if (thisTFid != tfId)
-          break;
-        float dt = (thisBC - foundGlobalBC) * bcNS; // ns
+      while (maxColIndex < cols.size() && vTFid[maxColIndex] == tfId) {
+        float dt = (vFoundGlobalBC[maxColIndex] - foundGlobalBC) * bcNS; // ns
         if (dt > timeWinOccupancyCalcMaxNS)
           break;
-        vAssocToThisCol.push_back(maxColIndex);
-        vCollsTimeDeltaWrtGivenColl.push_back(dt);
-        vProxyNtracksAssocColls.push_back(vProxyForCollNtracks[maxColIndex]);
         maxColIndex++;
       }
-      vCollsInTimeWin.push_back(vAssocToThisCol);
-      vTimeDeltaForColls.push_back(vCollsTimeDeltaWrtGivenColl);
+      vRangeTimeWin[colIndex] = {minColIndex + 1, maxColIndex - 1};
 
       // calculation of the median time for the occupancy in a given time window
-      std::vector<std::pair<float, float>> pairsDeltaTimeMult;
-      for (size_t iCol = 0; iCol < vCollsTimeDeltaWrtGivenColl.size(); iCol++)
-        pairsDeltaTimeMult.emplace_back(vCollsTimeDeltaWrtGivenColl[iCol], vProxyNtracksAssocColls[iCol]);
-      std::sort(pairsDeltaTimeMult.begin(), pairsDeltaTimeMult.end()); // sorts by first element by default
-      int proxyTotalMultInTimeWin = std::accumulate(vProxyNtracksAssocColls.begin(), vProxyNtracksAssocColls.end(), 0);
+      pairsDeltaTimeMult.clear();
+      int proxyTotalMultInTimeWin = 0;
+      forEachInRange(colIndex, vRangeTimeWin[colIndex], [&](int32_t thisColIndex) {
+        pairsDeltaTimeMult.emplace_back((vFoundGlobalBC[thisColIndex] - foundGlobalBC) * bcNS, vProxyForCollNtracks[thisColIndex]);
+        proxyTotalMultInTimeWin += vProxyForCollNtracks[thisColIndex];
+      });
+      // the collisions come in time order, so usually the window only needs to be reversed before the current collision
+      std::reverse(pairsDeltaTimeMult.begin(), pairsDeltaTimeMult.begin() + (colIndex - vRangeTimeWin[colIndex].first));
+      if (!std::is_sorted(pairsDeltaTimeMult.begin(), pairsDeltaTimeMult.end())) {
+        std::sort(pairsDeltaTimeMult.begin(), pairsDeltaTimeMult.end()); // sorts by first element by default
+      }
 
       float sumMult = 0.0;
-      for (size_t iCol = 0; iCol < vCollsTimeDeltaWrtGivenColl.size(); iCol++) {
+      for (size_t iCol = 0; iCol < pairsDeltaTimeMult.size(); iCol++) {
         sumMult += pairsDeltaTimeMult[iCol].second;
         if (sumMult > proxyTotalMultInTimeWin / 2.0) {
           vMedianTimeForOccupancy[colIndex] = pairsDeltaTimeMult[iCol].first / 1e3; // ns -> us
           break;
         }
       }
-      for (size_t iCol = 0; iCol < vCollsTimeDeltaWrtGivenColl.size(); iCol++) {
+      for (size_t iCol = 0; iCol < pairsDeltaTimeMult.size(); iCol++) {
         LOGP(debug, "dt={} mult={}", pairsDeltaTimeMult[iCol].first, pairsDeltaTimeMult[iCol].second);
       }
       LOGP(debug, "   --> median time = {}", vMedianTimeForOccupancy[colIndex]);
@@ -1323,45 +1299,39 @@ class EventSelectionModule
       float vZ = col.posZ();
 
       // ### in-ROF occupancy
-      std::vector<int> vAssocCollInSameROF = vCollsInSameITSROF[colIndex];
       int nITS567tracksForSameRofVetoStrict = 0;    // to veto events with other collisions in the same ITS ROF
       int nCollsInRofWithFT0CAboveVetoStandard = 0; // to veto events with other collisions in the same ITS ROF, with per-collision multiplicity above threshold
       int nITS567tracksForRofVetoOnCloseVz = 0;     // to veto events with nearby collisions with close vZ
-      for (uint32_t iCol = 0; iCol < vAssocCollInSameROF.size(); iCol++) {
-        int thisColIndex = vAssocCollInSameROF[iCol];
+      forEachInRange(colIndex, vRangeSameITSROF[colIndex], [&](int32_t thisColIndex) {
         nITS567tracksForSameRofVetoStrict += vTracksITS567perColl[thisColIndex];
         if (vAmpFT0CperColl[thisColIndex] > evselOpts.confFT0CamplCutVetoOnCollInROF)
           nCollsInRofWithFT0CAboveVetoStandard++;
         if (std::fabs(vCollVz[thisColIndex] - vZ) < evselOpts.confEpsilonVzDiffVetoInROF)
           nITS567tracksForRofVetoOnCloseVz += vTracksITS567perColl[thisColIndex];
-      }
+      });
       // in-ROF occupancy flags
       vNoCollInSameRofStrict[colIndex] = (nITS567tracksForSameRofVetoStrict == 0);
       vNoCollInSameRofStandard[colIndex] = (nCollsInRofWithFT0CAboveVetoStandard == 0);
       vNoCollInSameRofWithCloseVz[colIndex] = (nITS567tracksForRofVetoOnCloseVz == 0);
 
       // ### occupancy in previous ROF
-      std::vector<int> vAssocCollInPrevROF = vCollsInPrevITSROF[colIndex];
       float totalFT0amplInPrevROF = 0;
-      for (uint32_t iCol = 0; iCol < vAssocCollInPrevROF.size(); iCol++) {
-        int thisColIndex = vAssocCollInPrevROF[iCol];
-        totalFT0amplInPrevROF += vAmpFT0CperColl[thisColIndex];
+      for (int32_t thisColIndex = colIndex - 1; thisColIndex >= vFirstForPrevITSROF[colIndex]; thisColIndex--) {
+        if (vRofId[thisColIndex] == vRofId[colIndex] - 1)
+          totalFT0amplInPrevROF += vAmpFT0CperColl[thisColIndex];
       }
       // veto events if FT0C amplitude in previous ITS ROF is above threshold
       vNoHighMultCollInPrevRof[colIndex] = (totalFT0amplInPrevROF < evselOpts.confFT0CamplCutVetoOnCollInROF);
 
       // ### occupancy in time windows
-      std::vector<int> vAssocToThisCol = vCollsInTimeWin[colIndex];
-      std::vector<float> vCollsTimeDeltaWrtGivenColl = vTimeDeltaForColls[colIndex];
       int nITS567tracksInFullTimeWindow = 0;
       float sumAmpFT0CInFullTimeWindow = 0;
       int nITS567tracksForVetoNarrow = 0;      // to veto events with nearby collisions (narrow range) with per-collision multiplicity above threshold
       int nITS567tracksForVetoStrict = 0;      // to veto events with nearby collisions
       int nCollsWithFT0CAboveVetoStandard = 0; // to veto events with nearby collisions that have per-collision multiplicity above threshold
       int colIndexFirstRejectedByTFborderCut = -1;
-      for (uint32_t iCol = 0; iCol < vAssocToThisCol.size(); iCol++) {
-        int thisColIndex = vAssocToThisCol[iCol];
-        float dt = vCollsTimeDeltaWrtGivenColl[iCol] / 1e3; // ns -> us
+      forEachInRange(colIndex, vRangeTimeWin[colIndex], [&](int32_t thisColIndex) {
+        float dt = static_cast<float>((vFoundGlobalBC[thisColIndex] - vFoundGlobalBC[colIndex]) * bcNS) / 1e3; // ns -> us
         // counting tracks from other collisions in fixed time windows
         if (std::fabs(dt) < evselOpts.confTimeRangeVetoOnCollNarrow)
           nITS567tracksForVetoNarrow += vProxyForCollNtracks[thisColIndex];
@@ -1377,7 +1347,7 @@ class EventSelectionModule
         if (vIsCollRejectedByTFborderCut[thisColIndex]) {
           if (colIndexFirstRejectedByTFborderCut == -1)
             colIndexFirstRejectedByTFborderCut = thisColIndex;
-          continue;
+          return;
         }
 
         // weighted occupancy calc:
@@ -1390,7 +1360,7 @@ class EventSelectionModule
           nITS567tracksInFullTimeWindow += wOccup * vProxyForCollNtracks[thisColIndex];
           sumAmpFT0CInFullTimeWindow += wOccup * vAmpFT0CperColl[thisColIndex];
         }
-      }
+      });
 
       // if some associated collisions are close to TF border - take FT0C amplitude instead of nTracks, using BC table
       if (vIsFullInfoForOccupancy[colIndex] && vCanHaveAssocCollsWithinLastDriftTime[colIndex] && colIndexFirstRejectedByTFborderCut >= 0) {
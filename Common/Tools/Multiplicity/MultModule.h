@@ -36,6 +36,7 @@
 #include <TProfile.h>
 #include <TString.h>
 
+#include <algorithm>
 #include <cmath>
 #include <cstdint>
 #include <cstdlib>
@@ -369,10 +370,63 @@ class MultModule
   TProfile* hVtxZNMFTTracks;    // non-legacy, added August/2025
   TProfile* hVtxZNGlobalTracks; // non-legacy, added August/2025
 
+  // groups of barrel track counters needed by the enabled tables, decided once in init
+  bool mCountTPCTracks = false;      // TPCMults, MultsExtra
+  bool mCountPVContributors = false; // PVMults, PVMultZeqs, CentNTPVs
+  bool mCountExtraTracks = false;    // MultsExtra with doNTrackStudies
+  bool mCountGlobalTracks = false;   // MultsGlobal, GlobalMultZeqs
+
   // declaration of structs here
   // (N.B.: will be invisible to the outside, create your own copies)
   o2::common::multiplicity::standardConfigurables internalOpts;
 
+  //_________________________________________________
+  // flat copy of a calibration histogram, built once when the calibration is loaded:
+  // value(x) is the same as h->GetBinContent(h->FindFixBin(x)), without the TH1 calls per collision
+  struct BinLookup {
+    int nBins = 0;
+    double xMin = 0., xMax = 0.;
+    std::vector<double> edges;    // only for variable bin widths
+    std::vector<double> contents; // under- and overflow included
+
+    void build(const TH1* h)
+    {
+      edges.clear();
+      contents.clear();
+      if (h == nullptr) {
+        nBins = 0;
+        return;
+      }
+      const TAxis* axis = h->GetXaxis();
+      nBins = axis->GetNbins();
+      xMin = axis->GetXmin();
+      xMax = axis->GetXmax();
+      if (axis->GetXbins()->GetSize() > 0) {
+        edges.assign(axis->GetXbins()->GetArray(), axis->GetXbins()->GetArray() + axis->GetXbins()->GetSize());
+      }
+      contents.resize(nBins + 2);
+      for (int i = 0; i < nBins + 2; i++) {
+        contents[i] = h->GetBinContent(i);
+      }
+    }
+
+    double value(double x) const
+    {
+      // same bin as TAxis::FindFixBin: 0 for underflow, nBins + 1 for overflow (and NaN)
+      int bin;
+      if (x < xMin) {
+        bin = 0;
+      } else if (!(x < xMax)) {
+        bin = nBins + 1;
+      } else if (edges.empty()) {
+        bin = 1 + static_cast<int>(nBins * (x - xMin) / (xMax - xMin));
+      } else {
+        bin = std::upper_bound(edges.begin(), edges.end(), x) - edges.begin();
+      }
+      return contents[bin];
+    }
+  };
+
   //_________________________________________________
   // centrality-related objects
   struct TagRun2V0MCalibration {
@@ -382,37 +436,44 @@ class MultModule
     TH1* mhVtxAmpCorrV0A = nullptr;
     TH1* mhVtxAmpCorrV0C = nullptr;
     TH1* mhMultSelCalib = nullptr;
+    BinLookup mVtxAmpCorrV0A, mVtxAmpCorrV0C, mMultSelCalib;
   } Run2V0MInfo;
   struct TagRun2V0ACalibration {
     bool mCalibrationStored = false;
     TH1* mhVtxAmpCorrV0A = nullptr;
     TH1* mhMultSelCalib = nullptr;
+    BinLookup mVtxAmpCorrV0A, mMultSelCalib;
   } Run2V0AInfo;
   struct TagRun2SPDTrackletsCalibration {
     bool mCalibrationStored = false;
     TH1* mhVtxAmpCorr = nullptr;
     TH1* mhMultSelCalib = nullptr;
+    BinLookup mVtxAmpCorr, mMultSelCalib;
   } Run2SPDTksInfo;
   struct TagRun2SPDClustersCalibration {
     bool mCalibrationStored = false;
     TH1* mhVtxAmpCorrCL0 = nullptr;
     TH1* mhVtxAmpCorrCL1 = nullptr;
     TH1* mhMultSelCalib = nullptr;
+    BinLookup mVtxAmpCorrCL0, mVtxAmpCorrCL1, mMultSelCalib;
   } Run2SPDClsInfo;
   struct TagRun2CL0Calibration {
     bool mCalibrationStored = false;
     TH1* mhVtxAmpCorr = nullptr;
     TH1* mhMultSelCalib = nullptr;
+    BinLookup mVtxAmpCorr, mMultSelCalib;
   } Run2CL0Info;
   struct TagRun2CL1Calibration {
     bool mCalibrationStored = false;
     TH1* mhVtxAmpCorr = nullptr;
     TH1* mhMultSelCalib = nullptr;
+    BinLookup mVtxAmpCorr, mMultSelCalib;
   } Run2CL1Info;
   struct CalibrationInfo {
     std::string name = "";
     bool mCalibrationStored = false;
     TH1* mhMultSelCalib = nullptr;
+    BinLookup mMultSelCalib; // built from mhMultSelCalib when the calibration is stored
     float mMCScalePars[6] = {0.0};
     TFormula* mMCScale = nullptr;
     explicit CalibrationInfo(std::string name)
@@ -526,6 +587,13 @@ class MultModule
       listOfRequestors[kPVMults].Append(Form("%s ", "dependency check"));
     }
 
+    // track counters: only the ones used by an enabled table are computed, the track loop is skipped if none is
+    // (the MultsExtra track counters are stored as zero without doNTrackStudies)
+    mCountExtraTracks = internalOpts.mEnabledTables[kMultsExtra] && internalOpts.doNTrackStudies;
+    mCountTPCTracks = internalOpts.mEnabledTables[kTPCMults] || mCountExtraTracks;
+    mCountPVContributors = internalOpts.mEnabledTables[kPVMults] || internalOpts.mEnabledTables[kPVMultZeqs] || internalOpts.mEnabledTables[kCentNTPVs];
+    mCountGlobalTracks = internalOpts.mEnabledTables[kMultsGlobal] || internalOpts.mEnabledTables[kGlobalMultZeqs];
+
     // list enabled tables
     for (int i = 0; i < nTablesConst; i++) {
       // printout to be improved in the future
@@ -820,10 +888,10 @@ class MultModule
 
     //_______________________________________________________________________
     // determine if barrel track loop is required, do it (once!) if so but save CPU if not
-    if (internalOpts.mEnabledTables[kTPCMults] || internalOpts.mEnabledTables[kPVMults] || internalOpts.mEnabledTables[kMultsExtra] || internalOpts.mEnabledTables[kPVMultZeqs] || internalOpts.mEnabledTables[kMultsGlobal] || internalOpts.mEnabledTables[kGlobalMultZeqs]) {
-      // single loop to calculate all
+    if (mCountTPCTracks || mCountPVContributors || mCountExtraTracks || mCountGlobalTracks) {
+      // single loop to calculate all the counters in use
       for (const auto& track : tracks) {
-        if (track.hasTPC()) {
+        if (mCountTPCTracks && track.hasTPC()) {
           mults.multTPC++;
           if (track.hasITS()) {
             mults.multAllTracksITSTPC++; // multsextra
@@ -832,7 +900,7 @@ class MultModule
           }
         }
         // PV contributor checked explicitly
-        if (track.isPVContributor()) {
+        if ((mCountPVContributors || mCountExtraTracks) && track.isPVContributor()) {
           if (std::abs(track.eta()) < 1.0) {
             mults.multNContribsEta1++; // pvmults
             if (std::abs(track.eta()) < 0.8) {
@@ -842,7 +910,7 @@ class MultModule
               }
             }
           }
-          if (track.hasITS()) {
+          if (mCountExtraTracks && track.hasITS()) {
             mults.multHasITS++; // multsextra
             if (track.hasTPC())
               mults.multITSTPC++; // multsextra
@@ -850,22 +918,25 @@ class MultModule
               mults.multITSOnly++; // multsextra
             }
           }
-          if (track.hasTPC()) {
+          if (mCountExtraTracks && track.hasTPC()) {
             mults.multHasTPC++; // multsextra
             if (!track.hasITS() && !track.hasTOF() && !track.hasTRD()) {
               mults.multTPCOnly++; // multsextra
             }
           }
-          if (track.hasTOF()) {
+          if (mCountExtraTracks && track.hasTOF()) {
             mults.multHasTOF++; // multsextra
           }
-          if (track.hasTRD()) {
+          if (mCountExtraTracks && track.hasTRD()) {
             mults.multHasTRD++; // multsextra
           }
         }
 
         // global counters: do them only in case information is provided in tracks table
         if constexpr (requires { track.isQualityTrack(); }) {
+          if (!mCountGlobalTracks) {
+            continue;
+          }
           if (track.pt() < internalOpts.maxPtGlobalTrack.value && track.pt() > internalOpts.minPtGlobalTrack.value && std::fabs(track.eta()) < 1.0f && track.isPVContributor() && track.isQualityTrack()) {
             if (track.itsNCls() < internalOpts.minNclsITSGlobalTrack || track.itsNClsInnerBarrel() < internalOpts.minNclsITSibGlobalTrack) {
               continue;
@@ -887,12 +958,16 @@ class MultModule
         } // end constexpr requires track selection stuff
       }
 
-      cursors.multsGlobal(mults.multGlobalTracks, mults.multNbrContribsEta08GlobalTrackWoDCA, mults.multNbrContribsEta10GlobalTrackWoDCA, mults.multNbrContribsEta05GlobalTrackWoDCA);
+      if (internalOpts.mEnabledTables[kMultsGlobal]) {
+        cursors.multsGlobal(mults.multGlobalTracks, mults.multNbrContribsEta08GlobalTrackWoDCA, mults.multNbrContribsEta10GlobalTrackWoDCA, mults.multNbrContribsEta05GlobalTrackWoDCA);
+      }
 
-      if (!hVtxZNGlobalTracks || std::fabs(collision.posZ()) > 15.0f) {
-        mults.multGlobalTracksZeq = mults.multGlobalTracks; // if no equalization available, don't do it
-      } else {
-        mults.multGlobalTracksZeq = hVtxZNGlobalTracks->Interpolate(0.0) * mults.multGlobalTracks / hVtxZNGlobalTracks->Interpolate(collision.posZ());
+      if (mCountGlobalTracks) {
+        if (!hVtxZNGlobalTracks || std::fabs(collision.posZ()) > 15.0f) {
+          mults.multGlobalTracksZeq = mults.multGlobalTracks; // if no equalization available, don't do it
+        } else {
+          mults.multGlobalTracksZeq = hVtxZNGlobalTracks->Interpolate(0.0) * mults.multGlobalTracks / hVtxZNGlobalTracks->Interpolate(collision.posZ());
+        }
       }
 
       // provide vertex-Z equalized Nglobals (or non-equalized if missing or beyond range)
@@ -1096,6 +1171,9 @@ class MultModule
                 LOGF(info, "MC Scale information from V0M for run %d not available", bc.runNumber());
               }
             }
+            Run2V0MInfo.mVtxAmpCorrV0A.build(Run2V0MInfo.mhVtxAmpCorrV0A);
+            Run2V0MInfo.mVtxAmpCorrV0C.build(Run2V0MInfo.mhVtxAmpCorrV0C);
+            Run2V0MInfo.mMultSelCalib.build(Run2V0MInfo.mhMultSelCalib);
             Run2V0MInfo.mCalibrationStored = true;
           } else {
             // continue filling with non-valid values (105)
@@ -1107,6 +1185,8 @@ class MultModule
           Run2V0AInfo.mhVtxAmpCorrV0A = getccdb("hVtx_fAmplitude_V0A_Normalized");
           Run2V0AInfo.mhMultSelCalib = getccdb("hMultSelCalib_V0A");
           if ((Run2V0AInfo.mhVtxAmpCorrV0A != nullptr) && (Run2V0AInfo.mhMultSelCalib != nullptr)) {
+            Run2V0AInfo.mVtxAmpCorrV0A.build(Run2V0AInfo.mhVtxAmpCorrV0A);
+            Run2V0AInfo.mMultSelCalib.build(Run2V0AInfo.mhMultSelCalib);
             Run2V0AInfo.mCalibrationStored = true;
           } else {
             // continue filling with non-valid values (105)
@@ -1118,6 +1198,8 @@ class MultModule
           Run2SPDTksInfo.mhVtxAmpCorr = getccdb("hVtx_fnTracklets_Normalized");
           Run2SPDTksInfo.mhMultSelCalib = getccdb("hMultSelCalib_SPDTracklets");
           if ((Run2SPDTksInfo.mhVtxAmpCorr != nullptr) && (Run2SPDTksInfo.mhMultSelCalib != nullptr)) {
+            Run2SPDTksInfo.mVtxAmpCorr.build(Run2SPDTksInfo.mhVtxAmpCorr);
+            Run2SPDTksInfo.mMultSelCalib.build(Run2SPDTksInfo.mhMultSelCalib);
             Run2SPDTksInfo.mCalibrationStored = true;
           } else {
             // continue filling with non-valid values (105)
@@ -1130,6 +1212,9 @@ class MultModule
           Run2SPDClsInfo.mhVtxAmpCorrCL1 = getccdb("hVtx_fnSPDClusters1_Normalized");
           Run2SPDClsInfo.mhMultSelCalib = getccdb("hMultSelCalib_SPDClusters");
           if ((Run2SPDClsInfo.mhVtxAmpCorrCL0 != nullptr) && (Run2SPDClsInfo.mhVtxAmpCorrCL1 != nullptr) && (Run2SPDClsInfo.mhMultSelCalib != nullptr)) {
+            Run2SPDClsInfo.mVtxAmpCorrCL0.build(Run2SPDClsInfo.mhVtxAmpCorrCL0);
+            Run2SPDClsInfo.mVtxAmpCorrCL1.build(Run2SPDClsInfo.mhVtxAmpCorrCL1);
+            Run2SPDClsInfo.mMultSelCalib.build(Run2SPDClsInfo.mhMultSelCalib);
             Run2SPDClsInfo.mCalibrationStored = true;
           } else {
             // continue filling with non-valid values (105)
@@ -1141,6 +1226,8 @@ class MultModule
           Run2CL0Info.mhVtxAmpCorr = getccdb("hVtx_fnSPDClusters0_Normalized");
           Run2CL0Info.mhMultSelCalib = getccdb("hMultSelCalib_CL0");
           if ((Run2CL0Info.mhVtxAmpCorr != nullptr) && (Run2CL0Info.mhMultSelCalib != nullptr)) {
+            Run2CL0Info.mVtxAmpCorr.build(Run2CL0Info.mhVtxAmpCorr);
+            Run2CL0Info.mMultSelCalib.build(Run2CL0Info.mhMultSelCalib);
             Run2CL0Info.mCalibrationStored = true;
           } else {
             // continue filling with non-valid values (105)
@@ -1152,6 +1239,8 @@ class MultModule
           Run2CL1Info.mhVtxAmpCorr = getccdb("hVtx_fnSPDClusters1_Normalized");
           Run2CL1Info.mhMultSelCalib = getccdb("hMultSelCalib_CL1");
           if ((Run2CL1Info.mhVtxAmpCorr != nullptr) && (Run2CL1Info.mhMultSelCalib != nullptr)) {
+            Run2CL1Info.mVtxAmpCorr.build(Run2CL1Info.mhVtxAmpCorr);
+            Run2CL1Info.mMultSelCalib.build(Run2CL1Info.mhMultSelCalib);
             Run2CL1Info.mCalibrationStored = true;
           } else {
             // continue filling with non-valid values (105)
@@ -1237,6 +1326,7 @@ class MultModule
                 LOGF(warning, "MC Scale information from %s for run %d not available", estimator.name.c_str(), bc.runNumber());
               }
             }
+            estimator.mMultSelCalib.build(estimator.mhMultSelCalib);
             estimator.mCalibrationStored = true;
             estimator.isSane();
           } else {
@@ -1316,7 +1406,7 @@ class MultModule
             scaledMultiplicity = scaleMC(multiplicity, estimator.mMCScalePars);
             LOGF(debug, "Unscaled %s multiplicity: %f, scaled %s multiplicity: %f", estimator.name.c_str(), multiplicity, estimator.name.c_str(), scaledMultiplicity);
           }
-          percentile = estimator.mhMultSelCalib->GetBinContent(estimator.mhMultSelCalib->FindFixBin(scaledMultiplicity));
+          percentile = estimator.mMultSelCalib.value(scaledMultiplicity);
           if (assignOutOfRange)
             percentile = 100.5f;
         }
@@ -1410,10 +1500,10 @@ class MultModule
               v0m = scaleMC(mults[iEv].multFV0A + mults[iEv].multFV0C, Run2V0MInfo.mMCScalePars);
               LOGF(debug, "Unscaled v0m: %f, scaled v0m: %f", mults[iEv].multFV0A + mults[iEv].multFV0C, v0m);
             } else {
-              v0m = mults[iEv].multFV0A * Run2V0MInfo.mhVtxAmpCorrV0A->GetBinContent(Run2V0MInfo.mhVtxAmpCorrV0A->FindFixBin(mults[iEv].posZ)) +
-                    mults[iEv].multFV0C * Run2V0MInfo.mhVtxAmpCorrV0C->GetBinContent(Run2V0MInfo.mhVtxAmpCorrV0C->FindFixBin(mults[iEv].posZ));
+              v0m = mults[iEv].multFV0A * Run2V0MInfo.mVtxAmpCorrV0A.value(mults[iEv].posZ) +
+                    mults[iEv].multFV0C * Run2V0MInfo.mVtxAmpCorrV0C.value(mults[iEv].posZ);
             }
-            cV0M = Run2V0MInfo.mhMultSelCalib->GetBinContent(Run2V0MInfo.mhMultSelCalib->FindFixBin(v0m));
+            cV0M = Run2V0MInfo.mMultSelCalib.value(v0m);
           }
           LOGF(debug, "centRun2V0M=%.0f", cV0M);
           // fill centrality columns
@@ -1422,8 +1512,8 @@ class MultModule
         if (internalOpts.mEnabledTables[kCentRun2V0As]) {
           float cV0A = 105.0f;
           if (Run2V0AInfo.mCalibrationStored) {
-            float v0a = mults[iEv].multFV0A * Run2V0AInfo.mhVtxAmpCorrV0A->GetBinContent(Run2V0AInfo.mhVtxAmpCorrV0A->FindFixBin(mults[iEv].posZ));
-            cV0A = Run2V0AInfo.mhMultSelCalib->GetBinContent(Run2V0AInfo.mhMultSelCalib->FindFixBin(v0a));
+            float v0a = mults[iEv].multFV0A * Run2V0AInfo.mVtxAmpCorrV0A.value(mults[iEv].posZ);
+            cV0A = Run2V0AInfo.mMultSelCalib.value(v0a);
           }
           LOGF(debug, "centRun2V0A=%.0f", cV0A);
           // fill centrality columns
@@ -1432,8 +1522,8 @@ class MultModule
         if (internalOpts.mEnabledTables[kCentRun2SPDTrks]) {
           float cSPD = 105.0f;
           if (Run2SPDTksInfo.mCalibrationStored) {
-            float spdm = mults[iEv].multTracklets * Run2SPDTksInfo.mhVtxAmpCorr->GetBinContent(Run2SPDTksInfo.mhVtxAmpCorr->FindFixBin(mults[iEv].posZ));
-            cSPD = Run2SPDTksInfo.mhMultSelCalib->GetBinContent(Run2SPDTksInfo.mhMultSelCalib->FindFixBin(spdm));
+            float spdm = mults[iEv].multTracklets * Run2SPDTksInfo.mVtxAmpCorr.value(mults[iEv].posZ);
+            cSPD = Run2SPDTksInfo.mMultSelCalib.value(spdm);
           }
           LOGF(debug, "centSPDTracklets=%.0f", cSPD);
           cursors.centRun2SPDTracklets(cSPD);
@@ -1441,9 +1531,9 @@ class MultModule
         if (internalOpts.mEnabledTables[kCentRun2SPDClss]) {
           float cSPD = 105.0f;
           if (Run2SPDClsInfo.mCalibrationStored) {
-            float spdm = mults[iEv].spdClustersL0 * Run2SPDClsInfo.mhVtxAmpCorrCL0->GetBinContent(Run2SPDClsInfo.mhVtxAmpCorrCL0->FindFixBin(mults[iEv].posZ)) +
-                         mults[iEv].spdClustersL1 * Run2SPDClsInfo.mhVtxAmpCorrCL1->GetBinContent(Run2SPDClsInfo.mhVtxAmpCorrCL1->FindFixBin(mults[iEv].posZ));
-            cSPD = Run2SPDClsInfo.mhMultSelCalib->GetBinContent(Run2SPDClsInfo.mhMultSelCalib->FindFixBin(spdm));
+            float spdm = mults[iEv].spdClustersL0 * Run2SPDClsInfo.mVtxAmpCorrCL0.value(mults[iEv].posZ) +
+                         mults[iEv].spdClustersL1 * Run2SPDClsInfo.mVtxAmpCorrCL1.value(mults[iEv].posZ);
+            cSPD = Run2SPDClsInfo.mMultSelCalib.value(spdm);
           }
           LOGF(debug, "centSPDClusters=%.0f", cSPD);
           cursors.centRun2SPDClusters(cSPD);
@@ -1451,8 +1541,8 @@ class MultModule
         if (internalOpts.mEnabledTables[kCentRun2CL0s]) {
           float cCL0 = 105.0f;
           if (Run2CL0Info.mCalibrationStored) {
-            float cl0m = mults[iEv].spdClustersL0 * Run2CL0Info.mhVtxAmpCorr->GetBinContent(Run2CL0Info.mhVtxAmpCorr->FindFixBin(mults[iEv].posZ));
-            cCL0 = Run2CL0Info.mhMultSelCalib->GetBinContent(Run2CL0Info.mhMultSelCalib->FindFixBin(cl0m));
+            float cl0m = mults[iEv].spdClustersL0 * Run2CL0Info.mVtxAmpCorr.value(mults[iEv].posZ);
+            cCL0 = Run2CL0Info.mMultSelCalib.value(cl0m);
           }
           LOGF(debug, "centCL0=%.0f", cCL0);
           cursors.centRun2CL0(cCL0);
@@ -1460,8 +1550,8 @@ class MultModule
         if (internalOpts.mEnabledTables[kCentRun2CL1s]) {
           float cCL1 = 105.0f;
           if (Run2CL1Info.mCalibrationStored) {
-            float cl1m = mults[iEv].spdClustersL1 * Run2CL1Info.mhVtxAmpCorr->GetBinContent(Run2CL1Info.mhVtxAmpCorr->FindFixBin(mults[iEv].posZ));
-            cCL1 = Run2CL1Info.mhMultSelCalib->GetBinContent(Run2CL1Info.mhMultSelCalib->FindFixBin(cl1m));
+            float cl1m = mults[iEv].spdClustersL1 * Run2CL1Info.mVtxAmpCorr.value(mults[iEv].posZ);
+            cCL1 = Run2CL1Info.mMultSelCalib.value(cl1m);
           }
           LOGF(debug, "centCL1=%.0f", cCL1);
           cursors.centRun2CL1(cCL1);
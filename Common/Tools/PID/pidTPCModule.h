@@ -43,6 +43,7 @@
 #include <TMatrixDfwd.h>
 #include <TRandom.h>
 
+#include <algorithm>
 #include <chrono>
 #include <cstddef>
 #include <cstdint>
@@ -50,6 +51,7 @@
 #include <map>
 #include <memory>
 #include <ratio>
+#include <span>
 #include <string>
 #include <vector>
 
@@ -102,9 +104,14 @@ struct pidTPCConfigurables : o2::framework::ConfigurableGroup {
   o2::framework::Configurable<std::string> networkPathCCDB{"networkPathCCDB", "Analysis/PID/TPC/ML", "Path on CCDB"};
   o2::framework::Configurable<bool> enableNetworkOptimizations{"enableNetworkOptimizations", 1, "(bool) If the neural network correction is used, this enables GraphOptimizationLevel::ORT_ENABLE_EXTENDED in the ONNX session"};
   o2::framework::Configurable<int> networkSetNumThreads{"networkSetNumThreads", 0, "Especially important for running on a SLURM cluster. Sets the number of threads used for execution."};
+  o2::framework::Configurable<int> networkMaxBatchSize{"networkMaxBatchSize", 0, "Maximum number of rows (tracks x mass hypotheses) evaluated at once by the network, to limit the memory usage. 0: all the rows of a data frame in one evaluation"};
   // Configuration flags to include and exclude particle hypotheses
   o2::framework::Configurable<int> savedEdxsCorrected{"savedEdxsCorrected", -1, {"Save table with corrected dE/dx calculated on the spot. 0: off, 1: on, -1: auto"}};
   o2::framework::Configurable<bool> useCorrecteddEdx{"useCorrecteddEdx", false, "(bool) If true, use corrected dEdx value in Nsigma calculation instead of the one in the AO2D"};
+  // Evaluation strategy of the expected signals
+  o2::framework::Configurable<bool> useBetheBlochTable{"useBetheBlochTable", false, "(bool) Tabulate the Bethe-Bloch parametrisation in log(beta*gamma) and interpolate it instead of evaluating it for each track and mass hypothesis"};
+  o2::framework::Configurable<int> betheBlochTablePoints{"betheBlochTablePoints", 4096, "Number of points of the Bethe-Bloch table (4096 points take 16 kB)"};
+  o2::framework::Configurable<bool> fillTablesColumnWise{"fillTablesColumnWise", false, "(bool) Buffer the track properties and evaluate each mass hypothesis for all the tracks at once before filling the PID tables"};
 
   o2::framework::Configurable<int> pidFullEl{"pid-full-el", -1, {"Produce PID information for the Electron mass hypothesis, overrides the automatic setup: the corresponding table can be set off (0) or on (1)"}};
   o2::framework::Configurable<int> pidFullMu{"pid-full-mu", -1, {"Produce PID information for the Muon mass hypothesis, overrides the automatic setup: the corresponding table can be set off (0) or on (1)"}};
@@ -216,6 +223,10 @@ class pidTPCModule
   std::map<std::string, std::string> headers;
   std::vector<int> speciesNetworkFlags = std::vector<int>(9);
   std::string networkVersion;
+  // Buffers of the network evaluation, reused between data frames
+  std::vector<float> networkTrackProperties;
+  std::vector<float> networkInput;
+  std::vector<float> networkOutput;
 
   // To get automatically the proper Hadronic Rate
   std::string irSource = "";
@@ -228,6 +239,43 @@ class pidTPCModule
   ctpRateFetcher mRateFetcher;
   Str_dEdx_correction str_dedx_correction;
 
+  // Track properties buffered for the column-wise filling of the PID tables
+  struct TrackColumns {
+    std::vector<float> tpcSignal;
+    std::vector<float> tpcInnerParam;
+    std::vector<float> tpcNClsFound;
+    std::vector<float> tgl;
+    std::vector<float> signed1Pt;
+    std::vector<int64_t> multTPC;
+    std::vector<uint64_t> networkIndex; // index of the track in the network predictions
+    std::vector<uint8_t> isValid;       // track has TPC, a valid signal and is not a skipped TPC-only track
+    std::vector<uint8_t> hasCollision;
+
+    std::size_t size() const { return tpcSignal.size(); }
+    void clear()
+    {
+      tpcSignal.clear();
+      tpcInnerParam.clear();
+      tpcNClsFound.clear();
+      tgl.clear();
+      signed1Pt.clear();
+      multTPC.clear();
+      networkIndex.clear();
+      isValid.clear();
+      hasCollision.clear();
+    }
+  } trackColumns;
+  std::vector<float> expSignalColumn;
+
+  //__________________________________________________
+  // Tabulate the Bethe-Bloch parametrisation of the current response object, if requested
+  void setupResponseTable()
+  {
+    if (pidTPCopts.useBetheBlochTable && response) {
+      response->BuildBetheBlochTable(pidTPCopts.betheBlochTablePoints.value);
+    }
+  }
+
   //__________________________________________________
   template <typename TCCDB, typename TContext, typename TpidTPCOpts, typename TMetadataInfo>
   void init(TCCDB& ccdb, TContext& context, TpidTPCOpts const& external_pidtpcopts, TMetadataInfo const& metadataInfo)
@@ -365,6 +413,7 @@ class pidTPCModule
         LOGF(fatal, "Loading the TPC PID Response from file {} failed!", fname.Data());
       }
       response->PrintAll();
+      setupResponseTable();
     } else {
       useCCDBParam = true;
       const std::string path = pidTPCopts.ccdbPath.value;
@@ -396,6 +445,7 @@ class pidTPCModule
           LOGF(info, "No grpo object found. irSource will remain undefined.");
         }
         response->PrintAll();
+        setupResponseTable();
       }
     }
 
@@ -479,6 +529,7 @@ class pidTPCModule
           LOGF(info, "No grpo object found. irSource will remain undefined.");
         }
         response->PrintAll();
+        setupResponseTable();
       }
 
       if (bc.timestamp() < network.getValidityFrom() || bc.timestamp() > network.getValidityUntil()) { // fetches network only if the runnumbers change
@@ -497,19 +548,14 @@ class pidTPCModule
     }
 
     // Defining some network parameters
-    int input_dimensions = network.getNumInputNodes();
-    int output_dimensions = network.getNumOutputNodes();
-    const uint64_t track_prop_size = input_dimensions * size;
+    const int input_dimensions = network.getNumInputNodes();
+    const int output_dimensions = network.getNumOutputNodes();
     const uint64_t prediction_size = output_dimensions * size;
 
     network_prediction = std::vector<float>(prediction_size * 9); // For each mass hypotheses
     const float nNclNormalization = response->GetNClNormalization();
     float duration_network = 0;
 
-    std::vector<float> track_properties(track_prop_size);
-    uint64_t counter_track_props = 0;
-    int loop_counter = 0;
-
     // To load the Hadronic rate once for each collision
     float hadronicRateBegin = 0.;
     std::vector<float> hadronicRateForCollision(collisions.size(), 0.0f);
@@ -530,95 +576,136 @@ class pidTPCModule
       hadronicRateBegin = 0.0f;
     }
 
-    // Filling a std::vector<float> to be evaluated by the network
-    // Evaluation on single tracks brings huge overhead: Thus evaluation is done on one large vector
+    // Only the mass hypotheses for which the network is applied are evaluated
     static constexpr int NParticleTypes = 9;
+    std::vector<int> networkSpecies;
+    for (int j = 0; j < NParticleTypes; j++) {
+      if (speciesNetworkFlags[j]) {
+        networkSpecies.push_back(j);
+      }
+    }
+    if (networkSpecies.empty() || size == 0) {
+      return network_prediction;
+    }
+
+    // Filling the track properties, which do not depend on the mass hypothesis, once per track
+    constexpr int MassColumn = 3;
     constexpr int ExpectedInputDimensionsNNV2 = 7;
     constexpr int ExpectedInputDimensionsNNV3 = 8;
     constexpr int ExpectedInputDimensionsNNV4 = 9;
     constexpr auto NetworkVersionV2 = "2";
     constexpr auto NetworkVersionV3 = "3";
     constexpr auto NetworkVersionV4 = "4";
-    for (int j = 0; j < NParticleTypes; j++) { // Loop over particle number for which network correction is used
-      for (auto const& trk : tracks) {
-        if (!trk.hasTPC()) {
+    networkTrackProperties.assign(input_dimensions * size, 0.f);
+    uint64_t counter_track_props = 0;
+    for (auto const& trk : tracks) {
+      if (!trk.hasTPC()) {
+        continue;
+      }
+      if (pidTPCopts.skipTPCOnly) {
+        if (!trk.hasITS() && !trk.hasTRD() && !trk.hasTOF()) {
           continue;
         }
-        if (pidTPCopts.skipTPCOnly) {
-          if (!trk.hasITS() && !trk.hasTRD() && !trk.hasTOF()) {
-            continue;
+      }
+      float* track_properties = networkTrackProperties.data() + counter_track_props;
+      track_properties[0] = trk.tpcInnerParam();
+      track_properties[1] = trk.tgl();
+      track_properties[2] = trk.signed1Pt();
+      track_properties[MassColumn] = 0.f; // set for each mass hypothesis
+      track_properties[4] = trk.has_collision() ? mults[trk.collisionId()] / 11000. : 1.;
+      track_properties[5] = std::sqrt(nNclNormalization / trk.tpcNClsFound());
+      if (input_dimensions == ExpectedInputDimensionsNNV2 && networkVersion == NetworkVersionV2) {
+        track_properties[6] = trk.has_collision() ? collisions.iteratorAt(trk.collisionId()).ft0cOccupancyInTimeRange() / 60000. : 1.;
+      }
+      if ((input_dimensions == ExpectedInputDimensionsNNV3 && networkVersion == NetworkVersionV3) || (input_dimensions == ExpectedInputDimensionsNNV4 && networkVersion == NetworkVersionV4)) {
+        track_properties[6] = trk.has_collision() ? collisions.iteratorAt(trk.collisionId()).ft0cOccupancyInTimeRange() / 60000. : 1.;
+        if (trk.has_collision()) {
+          if (collsys == CollisionSystemType::kCollSyspp) {
+            track_properties[7] = hadronicRateForCollision[trk.collisionId()] / 1500.;
+          } else {
+            track_properties[7] = hadronicRateForCollision[trk.collisionId()] / 50.;
           }
-        }
-        track_properties[counter_track_props] = trk.tpcInnerParam();
-        track_properties[counter_track_props + 1] = trk.tgl();
-        track_properties[counter_track_props + 2] = trk.signed1Pt();
-        track_properties[counter_track_props + 3] = o2::track::pid_constants::sMasses[j];
-        track_properties[counter_track_props + 4] = trk.has_collision() ? mults[trk.collisionId()] / 11000. : 1.;
-        track_properties[counter_track_props + 5] = std::sqrt(nNclNormalization / trk.tpcNClsFound());
-        if (input_dimensions == ExpectedInputDimensionsNNV2 && networkVersion == NetworkVersionV2) {
-          track_properties[counter_track_props + 6] = trk.has_collision() ? collisions.iteratorAt(trk.collisionId()).ft0cOccupancyInTimeRange() / 60000. : 1.;
-        }
-        if (input_dimensions == ExpectedInputDimensionsNNV3 && networkVersion == NetworkVersionV3) {
-          track_properties[counter_track_props + 6] = trk.has_collision() ? collisions.iteratorAt(trk.collisionId()).ft0cOccupancyInTimeRange() / 60000. : 1.;
-          if (trk.has_collision()) {
-            if (collsys == CollisionSystemType::kCollSyspp) {
-              track_properties[counter_track_props + 7] = hadronicRateForCollision[trk.collisionId()] / 1500.;
-            } else {
-              track_properties[counter_track_props + 7] = hadronicRateForCollision[trk.collisionId()] / 50.;
-            }
+        } else {
+          // asign Hadronic Rate at beginning of run  if track does not belong to a collision
+          if (collsys == CollisionSystemType::kCollSyspp) {
+            track_properties[7] = hadronicRateBegin / 1500.;
           } else {
-            // asign Hadronic Rate at beginning of run  if track does not belong to a collision
-            if (collsys == CollisionSystemType::kCollSyspp) {
-              track_properties[counter_track_props + 7] = hadronicRateBegin / 1500.;
-            } else {
-              track_properties[counter_track_props + 7] = hadronicRateBegin / 50.;
-            }
+            track_properties[7] = hadronicRateBegin / 50.;
           }
         }
+      }
+      if (input_dimensions == ExpectedInputDimensionsNNV4 && networkVersion == NetworkVersionV4) {
+        track_properties[8] = std::fmod(std::fmod(trk.phi(), 2 * M_PI) + 2 * M_PI, M_PI / 9.0);
+      }
+      counter_track_props += input_dimensions;
+    }
 
-        if (input_dimensions == ExpectedInputDimensionsNNV4 && networkVersion == NetworkVersionV4) {
-          track_properties[counter_track_props + 6] = trk.has_collision() ? collisions.iteratorAt(trk.collisionId()).ft0cOccupancyInTimeRange() / 60000. : 1.;
-          if (trk.has_collision()) {
-            if (collsys == CollisionSystemType::kCollSyspp) {
-              track_properties[counter_track_props + 7] = hadronicRateForCollision[trk.collisionId()] / 1500.;
-            } else {
-              track_properties[counter_track_props + 7] = hadronicRateForCollision[trk.collisionId()] / 50.;
-            }
-          } else {
-            // asign Hadronic Rate at beginning of run  if track does not belong to a collision
-            if (collsys == CollisionSystemType::kCollSyspp) {
-              track_properties[counter_track_props + 7] = hadronicRateBegin / 1500.;
-            } else {
-              track_properties[counter_track_props + 7] = hadronicRateBegin / 50.;
-            }
-          }
-          track_properties[counter_track_props + 8] = std::fmod(std::fmod(trk.phi(), 2 * M_PI) + 2 * M_PI, M_PI / 9.0);
+    // The rows of all the mass hypotheses are stacked into one input and evaluated with a single call.
+    // If the number of rows exceeds networkMaxBatchSize, the tracks are evaluated in chunks to limit the memory usage
+    const uint64_t nSpecies = networkSpecies.size();
+    const uint64_t maxRows = pidTPCopts.networkMaxBatchSize.value > 0 ? static_cast<uint64_t>(pidTPCopts.networkMaxBatchSize.value) : nSpecies * size;
+    const uint64_t tracksPerChunk = std::min<uint64_t>(size, std::max<uint64_t>(1, maxRows / nSpecies));
+    networkInput.resize(nSpecies * tracksPerChunk * input_dimensions);
+    networkOutput.resize(nSpecies * tracksPerChunk * output_dimensions);
+    for (uint64_t firstTrack = 0; firstTrack < size; firstTrack += tracksPerChunk) {
+      const uint64_t nTracks = std::min<uint64_t>(tracksPerChunk, size - firstTrack);
+      float* input = networkInput.data();
+      for (const int pid : networkSpecies) {
+        std::copy_n(networkTrackProperties.data() + firstTrack * input_dimensions, nTracks * input_dimensions, input);
+        for (uint64_t k = 0; k < nTracks; k++) {
+          input[k * input_dimensions + MassColumn] = o2::track::pid_constants::sMasses[pid];
         }
-        counter_track_props += input_dimensions;
+        input += nTracks * input_dimensions;
       }
 
       auto start_network_eval = std::chrono::high_resolution_clock::now();
-      float* output_network = network.evalModel(track_properties);
+      if (!network.evalModelBound(networkInput.data(), nSpecies * nTracks, networkOutput.data())) {
+        LOGF(fatal, "Evaluation of the network for the TPC PID response correction failed!");
+      }
       auto stop_network_eval = std::chrono::high_resolution_clock::now();
       duration_network += std::chrono::duration<float, std::ratio<1, 1000000000>>(stop_network_eval - start_network_eval).count();
-      for (uint64_t k = 0; k < prediction_size; k += output_dimensions) {
-        for (int l = 0; l < output_dimensions; l++) {
-          network_prediction[k + l + prediction_size * loop_counter] = output_network[k + l];
-        }
-      }
 
-      counter_track_props = 0;
-      loop_counter += 1;
+      for (uint64_t s = 0; s < nSpecies; s++) {
+        std::copy_n(networkOutput.data() + s * nTracks * output_dimensions, nTracks * output_dimensions, network_prediction.data() + output_dimensions * (firstTrack + size * networkSpecies[s]));
+      }
     }
-    track_properties.clear();
 
     auto stop_network_total = std::chrono::high_resolution_clock::now();
-    LOG(debug) << "Neural Network for the TPC PID response correction: Time per track (eval ONNX): " << duration_network / (size * 9) << "ns ; Total time (eval ONNX): " << duration_network / 1000000000 << " s";
-    LOG(debug) << "Neural Network for the TPC PID response correction: Time per track (eval + overhead): " << std::chrono::duration<float, std::ratio<1, 1000000000>>(stop_network_total - start_network_total).count() / (size * 9) << "ns ; Total time (eval + overhead): " << std::chrono::duration<float, std::ratio<1, 1000000000>>(stop_network_total - start_network_total).count() / 1000000000 << " s";
+    LOG(debug) << "Neural Network for the TPC PID response correction: Time per track (eval ONNX): " << duration_network / (size * nSpecies) << "ns ; Total time (eval ONNX): " << duration_network / 1000000000 << " s";
+    LOG(debug) << "Neural Network for the TPC PID response correction: Time per track (eval + overhead): " << std::chrono::duration<float, std::ratio<1, 1000000000>>(stop_network_total - start_network_total).count() / (size * nSpecies) << "ns ; Total time (eval + overhead): " << std::chrono::duration<float, std::ratio<1, 1000000000>>(stop_network_total - start_network_total).count() / 1000000000 << " s";
 
     return network_prediction;
   }
 
+  //__________________________________________________
+  // Number of sigmas corrected by the network; expSigma is updated with the corrected resolution
+  template <typename TSigma>
+  float networkNSigma(const o2::track::PID::ID pid, const float tpcSignal, const float expSignal, TSigma& expSigma, const std::vector<float>& network_prediction, const uint64_t count_tracks, const uint64_t tracksForNet_size)
+  {
+    constexpr int NumOutputNodesSymmetricSigma = 2;
+    constexpr int NumOutputNodesAsymmetricSigma = 3;
+    float nSigma = -999.f;
+    // Here comes the application of the network. The output--dimensions of the network determine the application: 1: mean, 2: sigma, 3: sigma asymmetric
+    // For now only the option 2: sigma will be used. The other options are kept if there would be demand later on
+    if (network.getNumOutputNodes() == 1) { // Expected mean correction; no sigma correction
+      nSigma = (tpcSignal - network_prediction[count_tracks + tracksForNet_size * pid] * expSignal) / expSigma;
+    } else if (network.getNumOutputNodes() == NumOutputNodesSymmetricSigma) { // Symmetric sigma correction
+      expSigma = (network_prediction[NumOutputNodesSymmetricSigma * (count_tracks + tracksForNet_size * pid) + 1] - network_prediction[NumOutputNodesSymmetricSigma * (count_tracks + tracksForNet_size * pid)]) * expSignal;
+      nSigma = (tpcSignal / expSignal - network_prediction[NumOutputNodesSymmetricSigma * (count_tracks + tracksForNet_size * pid)]) / (network_prediction[NumOutputNodesSymmetricSigma * (count_tracks + tracksForNet_size * pid) + 1] - network_prediction[NumOutputNodesSymmetricSigma * (count_tracks + tracksForNet_size * pid)]);
+    } else if (network.getNumOutputNodes() == NumOutputNodesAsymmetricSigma) { // Asymmetric sigma corection
+      if (tpcSignal / expSignal >= network_prediction[NumOutputNodesAsymmetricSigma * (count_tracks + tracksForNet_size * pid)]) {
+        expSigma = (network_prediction[NumOutputNodesAsymmetricSigma * (count_tracks + tracksForNet_size * pid) + 1] - network_prediction[NumOutputNodesAsymmetricSigma * (count_tracks + tracksForNet_size * pid)]) * expSignal;
+        nSigma = (tpcSignal / expSignal - network_prediction[NumOutputNodesAsymmetricSigma * (count_tracks + tracksForNet_size * pid)]) / (network_prediction[NumOutputNodesAsymmetricSigma * (count_tracks + tracksForNet_size * pid) + 1] - network_prediction[NumOutputNodesAsymmetricSigma * (count_tracks + tracksForNet_size * pid)]);
+      } else {
+        expSigma = (network_prediction[NumOutputNodesAsymmetricSigma * (count_tracks + tracksForNet_size * pid)] - network_prediction[NumOutputNodesAsymmetricSigma * (count_tracks + tracksForNet_size * pid) + 2]) * expSignal;
+        nSigma = (tpcSignal / expSignal - network_prediction[NumOutputNodesAsymmetricSigma * (count_tracks + tracksForNet_size * pid)]) / (network_prediction[NumOutputNodesAsymmetricSigma * (count_tracks + tracksForNet_size * pid)] - network_prediction[NumOutputNodesAsymmetricSigma * (count_tracks + tracksForNet_size * pid) + 2]);
+      }
+    } else {
+      LOGF(fatal, "Network output dimensions incompatible!");
+    }
+    return nSigma;
+  }
+
   //__________________________________________________
   template <typename T, typename NSF, typename NST>
   void makePidTables(const int flagFull, NSF& tableFull, const int flagTiny, NST& tableTiny, const o2::track::PID::ID pid, const float tpcSignal, const T& trk, const int64_t multTPC, const std::vector<float>& network_prediction, const int& count_tracks, const int& tracksForNet_size)
@@ -654,28 +741,8 @@ class pidTPCModule
 
     float nSigma = -999.f;
     float bg = trk.tpcInnerParam() / o2::track::pid_constants::sMasses[pid]; // estimated beta-gamma for network cutoff
-    constexpr int NumOutputNodesSymmetricSigma = 2;
-    constexpr int NumOutputNodesAsymmetricSigma = 3;
     if (pidTPCopts.useNetworkCorrection && speciesNetworkFlags[pid] && trk.has_collision() && bg > pidTPCopts.networkBetaGammaCutoff) {
-
-      // Here comes the application of the network. The output--dimensions of the network determine the application: 1: mean, 2: sigma, 3: sigma asymmetric
-      // For now only the option 2: sigma will be used. The other options are kept if there would be demand later on
-      if (network.getNumOutputNodes() == 1) { // Expected mean correction; no sigma correction
-        nSigma = (tpcSignal - network_prediction[count_tracks + tracksForNet_size * pid] * expSignal) / expSigma;
-      } else if (network.getNumOutputNodes() == NumOutputNodesSymmetricSigma) { // Symmetric sigma correction
-        expSigma = (network_prediction[NumOutputNodesSymmetricSigma * (count_tracks + tracksForNet_size * pid) + 1] - network_prediction[NumOutputNodesSymmetricSigma * (count_tracks + tracksForNet_size * pid)]) * expSignal;
-        nSigma = (tpcSignal / expSignal - network_prediction[NumOutputNodesSymmetricSigma * (count_tracks + tracksForNet_size * pid)]) / (network_prediction[NumOutputNodesSymmetricSigma * (count_tracks + tracksForNet_size * pid) + 1] - network_prediction[NumOutputNodesSymmetricSigma * (count_tracks + tracksForNet_size * pid)]);
-      } else if (network.getNumOutputNodes() == NumOutputNodesAsymmetricSigma) { // Asymmetric sigma corection
-        if (tpcSignal / expSignal >= network_prediction[NumOutputNodesAsymmetricSigma * (count_tracks + tracksForNet_size * pid)]) {
-          expSigma = (network_prediction[NumOutputNodesAsymmetricSigma * (count_tracks + tracksForNet_size * pid) + 1] - network_prediction[NumOutputNodesAsymmetricSigma * (count_tracks + tracksForNet_size * pid)]) * expSignal;
-          nSigma = (tpcSignal / expSignal - network_prediction[NumOutputNodesAsymmetricSigma * (count_tracks + tracksForNet_size * pid)]) / (network_prediction[NumOutputNodesAsymmetricSigma * (count_tracks + tracksForNet_size * pid) + 1] - network_prediction[NumOutputNodesAsymmetricSigma * (count_tracks + tracksForNet_size * pid)]);
-        } else {
-          expSigma = (network_prediction[NumOutputNodesAsymmetricSigma * (count_tracks + tracksForNet_size * pid)] - network_prediction[NumOutputNodesAsymmetricSigma * (count_tracks + tracksForNet_size * pid) + 2]) * expSignal;
-          nSigma = (tpcSignal / expSignal - network_prediction[NumOutputNodesAsymmetricSigma * (count_tracks + tracksForNet_size * pid)]) / (network_prediction[NumOutputNodesAsymmetricSigma * (count_tracks + tracksForNet_size * pid)] - network_prediction[NumOutputNodesAsymmetricSigma * (count_tracks + tracksForNet_size * pid) + 2]);
-        }
-      } else {
-        LOGF(fatal, "Network output dimensions incompatible!");
-      }
+      nSigma = networkNSigma(pid, tpcSignal, expSignal, expSigma, network_prediction, count_tracks, tracksForNet_size);
     } else {
       nSigma = response->GetNumberOfSigmaMCTunedAtMultiplicity(multTPC, trk, pid, tpcSignal);
     }
@@ -685,6 +752,66 @@ class pidTPCModule
       aod::pidtpc_tiny::binning::packInTable(nSigma, tableTiny);
   };
 
+  //__________________________________________________
+  // Column-wise version of makePidTables: evaluates one mass hypothesis for all the buffered tracks
+  template <typename NSF, typename NST>
+  void makePidTableColumns(const int flagFull, NSF& tableFull, const int flagTiny, NST& tableTiny, const o2::track::PID::ID pid, const std::vector<float>& network_prediction, const uint64_t tracksForNet_size)
+  {
+    if (flagFull != 1 && flagTiny != 1) {
+      return;
+    }
+    const std::size_t nTracks = trackColumns.size();
+    expSignalColumn.resize(nTracks);
+    response->GetExpectedSignals(trackColumns.tpcInnerParam, pid, expSignalColumn);
+    const float mass = o2::track::pid_constants::sMasses[pid];
+    for (std::size_t i = 0; i < nTracks; i++) {
+      const float tpcSignal = trackColumns.tpcSignal[i];
+      const float expSignal = expSignalColumn[i];
+      // resolution at the track multiplicity, used for the number of sigmas
+      const float sigmaAtMult = trackColumns.isValid[i] ? response->GetExpectedSigmaFromSignal(expSignal, trackColumns.multTPC[i], trackColumns.tpcInnerParam[i], trackColumns.tpcNClsFound[i], trackColumns.tgl[i], trackColumns.signed1Pt[i], pid) : -999.f;
+      double expSigma = trackColumns.hasCollision[i] ? sigmaAtMult : 0.07 * expSignal; // use default sigma value of 7% if no collision information to estimate resolution
+      if (!trackColumns.isValid[i] || expSignal < 0. || expSigma < 0.) {
+        if (flagFull)
+          tableFull(-999.f, -999.f);
+        if (flagTiny)
+          tableTiny(aod::pidtpc_tiny::binning::underflowBin);
+        continue;
+      }
+
+      float nSigma = -999.f;
+      float bg = trackColumns.tpcInnerParam[i] / mass; // estimated beta-gamma for network cutoff
+      if (pidTPCopts.useNetworkCorrection && speciesNetworkFlags[pid] && trackColumns.hasCollision[i] && bg > pidTPCopts.networkBetaGammaCutoff) {
+        nSigma = networkNSigma(pid, tpcSignal, expSignal, expSigma, network_prediction, trackColumns.networkIndex[i], tracksForNet_size);
+      } else if (sigmaAtMult >= 0.f) {
+        nSigma = (tpcSignal - expSignal) / sigmaAtMult;
+      }
+      if (flagFull)
+        tableFull(expSigma, nSigma);
+      if (flagTiny)
+        aod::pidtpc_tiny::binning::packInTable(nSigma, tableTiny);
+    }
+  }
+
+  //__________________________________________________
+  // Fill the PID tables of all the enabled mass hypotheses for the buffered tracks
+  template <typename TProducts>
+  void fillPidTables(TProducts& products, const std::vector<float>& network_prediction, const uint64_t tracksForNet_size)
+  {
+    if (trackColumns.size() == 0) {
+      return;
+    }
+    makePidTableColumns(pidTPCopts.pidFullEl, products.tablePIDFullEl, pidTPCopts.pidTinyEl, products.tablePIDTinyEl, o2::track::PID::Electron, network_prediction, tracksForNet_size);
+    makePidTableColumns(pidTPCopts.pidFullMu, products.tablePIDFullMu, pidTPCopts.pidTinyMu, products.tablePIDTinyMu, o2::track::PID::Muon, network_prediction, tracksForNet_size);
+    makePidTableColumns(pidTPCopts.pidFullPi, products.tablePIDFullPi, pidTPCopts.pidTinyPi, products.tablePIDTinyPi, o2::track::PID::Pion, network_prediction, tracksForNet_size);
+    makePidTableColumns(pidTPCopts.pidFullKa, products.tablePIDFullKa, pidTPCopts.pidTinyKa, products.tablePIDTinyKa, o2::track::PID::Kaon, network_prediction, tracksForNet_size);
+    makePidTableColumns(pidTPCopts.pidFullPr, products.tablePIDFullPr, pidTPCopts.pidTinyPr, products.tablePIDTinyPr, o2::track::PID::Proton, network_prediction, tracksForNet_size);
+    makePidTableColumns(pidTPCopts.pidFullDe, products.tablePIDFullDe, pidTPCopts.pidTinyDe, products.tablePIDTinyDe, o2::track::PID::Deuteron, network_prediction, tracksForNet_size);
+    makePidTableColumns(pidTPCopts.pidFullTr, products.tablePIDFullTr, pidTPCopts.pidTinyTr, products.tablePIDTinyTr, o2::track::PID::Triton, network_prediction, tracksForNet_size);
+    makePidTableColumns(pidTPCopts.pidFullHe, products.tablePIDFullHe, pidTPCopts.pidTinyHe, products.tablePIDTinyHe, o2::track::PID::Helium3, network_prediction, tracksForNet_size);
+    makePidTableColumns(pidTPCopts.pidFullAl, products.tablePIDFullAl, pidTPCopts.pidTinyAl, products.tablePIDTinyAl, o2::track::PID::Alpha, network_prediction, tracksForNet_size);
+    trackColumns.clear();
+  }
+
   //__________________________________________________
   template <typename TCCDB, typename TBCs, typename TTracks, typename TTracksQA, typename TProducts>
   void process(TCCDB& ccdb, TBCs const& bcs, soa::Join<aod::Collisions, aod::EvSels> const& cols, TTracks const& tracks, TTracksQA const& tracksQA, TProducts& products)
@@ -755,6 +882,19 @@ class pidTPCModule
 
     uint64_t count_tracks = 0;
 
+    if (pidTPCopts.fillTablesColumnWise) {
+      trackColumns.clear();
+      trackColumns.tpcSignal.reserve(outTable_size);
+      trackColumns.tpcInnerParam.reserve(outTable_size);
+      trackColumns.tpcNClsFound.reserve(outTable_size);
+      trackColumns.tgl.reserve(outTable_size);
+      trackColumns.signed1Pt.reserve(outTable_size);
+      trackColumns.multTPC.reserve(outTable_size);
+      trackColumns.networkIndex.reserve(outTable_size);
+      trackColumns.isValid.reserve(outTable_size);
+      trackColumns.hasCollision.reserve(outTable_size);
+    }
+
     //_______________________________________
     // process tracksQA in case present
     std::vector<int64_t> indexTrack2TrackQA(outTable_size, -1);
@@ -880,6 +1020,9 @@ class pidTPCModule
         } else {
           LOGP(info, "Retrieving TPC Response for timestamp {} and recoPass {}:", bc.timestamp(), pidTPCopts.recoPass.value);
         }
+        if (pidTPCopts.fillTablesColumnWise) {
+          fillPidTables(products, network_prediction, tracksForNet_size); // the buffered tracks are evaluated with the previous response
+        }
         response = ccdb->template getSpecific<o2::pid::tpc::Response>(pidTPCopts.ccdbPath.value, bc.timestamp(), metadata, &headers);
         if (!response) {
           LOGP(warning, "!! Could not find a valid TPC response object for specific pass name {}! Falling back to latest uploaded object.", metadata["RecoPassName"]);
@@ -902,6 +1045,7 @@ class pidTPCModule
           LOGF(info, "No grpo object found. irSource will remain undefined.");
         }
         response->PrintAll();
+        setupResponseTable();
       }
 
       // if this is a MC process function, go for MC tune on data processing
@@ -947,24 +1091,40 @@ class pidTPCModule
         }
       }
 
-      auto makePidTablesDefault = [&trk, &tpcSignalToEvaluatePID, &multTPC, &network_prediction, &count_tracks, &tracksForNet_size, this](const int flagFull, auto& tableFull, const int flagTiny, auto& tableTiny, const o2::track::PID::ID pid) {
-        this->makePidTables(flagFull, tableFull, flagTiny, tableTiny, pid, tpcSignalToEvaluatePID, trk, multTPC, network_prediction, count_tracks, tracksForNet_size);
-      };
-
-      makePidTablesDefault(pidTPCopts.pidFullEl, products.tablePIDFullEl, pidTPCopts.pidTinyEl, products.tablePIDTinyEl, o2::track::PID::Electron);
-      makePidTablesDefault(pidTPCopts.pidFullMu, products.tablePIDFullMu, pidTPCopts.pidTinyMu, products.tablePIDTinyMu, o2::track::PID::Muon);
-      makePidTablesDefault(pidTPCopts.pidFullPi, products.tablePIDFullPi, pidTPCopts.pidTinyPi, products.tablePIDTinyPi, o2::track::PID::Pion);
-      makePidTablesDefault(pidTPCopts.pidFullKa, products.tablePIDFullKa, pidTPCopts.pidTinyKa, products.tablePIDTinyKa, o2::track::PID::Kaon);
-      makePidTablesDefault(pidTPCopts.pidFullPr, products.tablePIDFullPr, pidTPCopts.pidTinyPr, products.tablePIDTinyPr, o2::track::PID::Proton);
-      makePidTablesDefault(pidTPCopts.pidFullDe, products.tablePIDFullDe, pidTPCopts.pidTinyDe, products.tablePIDTinyDe, o2::track::PID::Deuteron);
-      makePidTablesDefault(pidTPCopts.pidFullTr, products.tablePIDFullTr, pidTPCopts.pidTinyTr, products.tablePIDTinyTr, o2::track::PID::Triton);
-      makePidTablesDefault(pidTPCopts.pidFullHe, products.tablePIDFullHe, pidTPCopts.pidTinyHe, products.tablePIDTinyHe, o2::track::PID::Helium3);
-      makePidTablesDefault(pidTPCopts.pidFullAl, products.tablePIDFullAl, pidTPCopts.pidTinyAl, products.tablePIDTinyAl, o2::track::PID::Alpha);
+      if (pidTPCopts.fillTablesColumnWise) {
+        trackColumns.tpcSignal.push_back(tpcSignalToEvaluatePID);
+        trackColumns.tpcInnerParam.push_back(trk.tpcInnerParam());
+        trackColumns.tpcNClsFound.push_back(static_cast<float>(trk.tpcNClsFound()));
+        trackColumns.tgl.push_back(trk.tgl());
+        trackColumns.signed1Pt.push_back(trk.signed1Pt());
+        trackColumns.multTPC.push_back(multTPC);
+        trackColumns.networkIndex.push_back(count_tracks);
+        trackColumns.isValid.push_back(trk.hasTPC() && !(tpcSignalToEvaluatePID < 0.f) && (!pidTPCopts.skipTPCOnly || trk.hasITS() || trk.hasTRD() || trk.hasTOF()));
+        trackColumns.hasCollision.push_back(trk.has_collision());
+      } else {
+        auto makePidTablesDefault = [&trk, &tpcSignalToEvaluatePID, &multTPC, &network_prediction, &count_tracks, &tracksForNet_size, this](const int flagFull, auto& tableFull, const int flagTiny, auto& tableTiny, const o2::track::PID::ID pid) {
+          this->makePidTables(flagFull, tableFull, flagTiny, tableTiny, pid, tpcSignalToEvaluatePID, trk, multTPC, network_prediction, count_tracks, tracksForNet_size);
+        };
+
+        makePidTablesDefault(pidTPCopts.pidFullEl, products.tablePIDFullEl, pidTPCopts.pidTinyEl, products.tablePIDTinyEl, o2::track::PID::Electron);
+        makePidTablesDefault(pidTPCopts.pidFullMu, products.tablePIDFullMu, pidTPCopts.pidTinyMu, products.tablePIDTinyMu, o2::track::PID::Muon);
+        makePidTablesDefault(pidTPCopts.pidFullPi, products.tablePIDFullPi, pidTPCopts.pidTinyPi, products.tablePIDTinyPi, o2::track::PID::Pion);
+        makePidTablesDefault(pidTPCopts.pidFullKa, products.tablePIDFullKa, pidTPCopts.pidTinyKa, products.tablePIDTinyKa, o2::track::PID::Kaon);
+        makePidTablesDefault(pidTPCopts.pidFullPr, products.tablePIDFullPr, pidTPCopts.pidTinyPr, products.tablePIDTinyPr, o2::track::PID::Proton);
+        makePidTablesDefault(pidTPCopts.pidFullDe, products.tablePIDFullDe, pidTPCopts.pidTinyDe, products.tablePIDTinyDe, o2::track::PID::Deuteron);
+        makePidTablesDefault(pidTPCopts.pidFullTr, products.tablePIDFullTr, pidTPCopts.pidTinyTr, products.tablePIDTinyTr, o2::track::PID::Triton);
+        makePidTablesDefault(pidTPCopts.pidFullHe, products.tablePIDFullHe, pidTPCopts.pidTinyHe, products.tablePIDTinyHe, o2::track::PID::Helium3);
+        makePidTablesDefault(pidTPCopts.pidFullAl, products.tablePIDFullAl, pidTPCopts.pidTinyAl, products.tablePIDTinyAl, o2::track::PID::Alpha);
+      }
 
       if (trk.hasTPC() && (!pidTPCopts.skipTPCOnly || trk.hasITS() || trk.hasTRD() || trk.hasTOF())) {
         count_tracks++; // Increment network track counter only if track has TPC, and (not skipping TPConly) or (is not TPConly)
       }
     }
+
+    if (pidTPCopts.fillTablesColumnWise) {
+      fillPidTables(products, network_prediction, tracksForNet_size);
+    }
   } // end process function
 };
 
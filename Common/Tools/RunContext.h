@@ -0,0 +1,79 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file RunContext.h
+/// \brief Run-wise information shared by the modules of a process
+/// \author ALICE
+
+#ifndef COMMON_TOOLS_RUNCONTEXT_H_
+#define COMMON_TOOLS_RUNCONTEXT_H_
+
+#include <CCDB/BasicCCDBManager.h>
+#include <DataFormatsParameters/AggregatedRunInfo.h>
+#include <Framework/Logger.h>
+
+#include <cstddef>
+#include <map>
+#include <mutex>
+#include <string>
+#include <tuple>
+
+namespace o2
+{
+namespace common
+{
+
+//__________________________________________
+// The aggregated run information (SOR, EOR, orbits per TF, ...) needs several
+// CCDB round trips and depends only on the run number (and on the production
+// tag for MC). Several modules of the same workflow need it whenever the run
+// changes: the first one asking for a run builds it, the other ones get the
+// cached copy. The CCDB manager is not thread safe, so the queries themselves
+// stay synchronous.
+class RunContextCache
+{
+ public:
+  static RunContextCache& instance()
+  {
+    static RunContextCache cache;
+    return cache;
+  }
+
+  // the production tag is used for MC only
+  o2::parameters::AggregatedRunInfo getAggregatedRunInfo(int run, bool isMC, std::string const& productionTag)
+  {
+    std::lock_guard<std::mutex> lock(mMutex);
+    auto key = std::make_tuple(run, isMC, isMC ? productionTag : std::string{});
+    auto found = mRunInfos.find(key);
+    if (found != mRunInfos.end()) {
+      return found->second;
+    }
+    if (mRunInfos.size() >= MaxRuns) {
+      mRunInfos.clear();
+    }
+    auto runInfo = !isMC ? o2::parameters::AggregatedRunInfo::buildAggregatedRunInfo(o2::ccdb::BasicCCDBManager::instance(), run)
+                         : o2::parameters::AggregatedRunInfo::buildAggregatedRunInfo(o2::ccdb::BasicCCDBManager::instance(), run, productionTag);
+    LOGP(debug, "RunContextCache: aggregated run info of run {} retrieved from CCDB", run);
+    mRunInfos.emplace(key, runInfo);
+    return runInfo;
+  }
+
+ private:
+  static constexpr std::size_t MaxRuns = 16;
+
+  std::mutex mMutex;
+  std::map<std::tuple<int, bool, std::string>, o2::parameters::AggregatedRunInfo> mRunInfos;
+};
+
+} // namespace common
+} // namespace o2
+
+#endif // COMMON_TOOLS_RUNCONTEXT_H_
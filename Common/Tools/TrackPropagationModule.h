@@ -33,6 +33,7 @@
 #include <Framework/Logger.h>
 #include <Framework/RunningWorkflowInfo.h>
 #include <ReconstructionDataFormats/DCA.h>
+#include <ReconstructionDataFormats/TrackLTIntegral.h>
 #include <ReconstructionDataFormats/TrackParametrization.h>
 #include <ReconstructionDataFormats/TrackParametrizationWithError.h>
 
@@ -41,9 +42,15 @@
 
 #include <array>
 #include <cmath>
+#include <cstddef>
+#include <cstdint>
 #include <cstdlib>
+#include <iterator>
+#include <list>
 #include <memory>
 #include <string>
+#include <unordered_map>
+#include <utility>
 
 //__________________________________________
 // track propagation module
@@ -55,11 +62,95 @@
 // reduce overhead and make it easier to pipeline / parallelize
 // bottlenecks in core services
 
+namespace o2::aod
+{
+namespace track_at_ref
+{
+DECLARE_SOA_COLUMN(X, x, float);                 //! x of the track parameters at the reference X
+DECLARE_SOA_COLUMN(Alpha, alpha, float);         //! local frame angle
+DECLARE_SOA_COLUMN(Y, y, float);                 //! local y
+DECLARE_SOA_COLUMN(Z, z, float);                 //! local z
+DECLARE_SOA_COLUMN(Snp, snp, float);             //! sine of the local phi
+DECLARE_SOA_COLUMN(Tgl, tgl, float);             //! tangent of the dip angle
+DECLARE_SOA_COLUMN(Signed1Pt, signed1Pt, float); //! charge over pT
+DECLARE_SOA_COLUMN(X2X0, x2X0, float);           //! material budget crossed from the IU position, in radiation lengths
+DECLARE_SOA_COLUMN(XRho, xRho, float);           //! material budget crossed from the IU position, in g/cm2
+} // namespace track_at_ref
+
+// joinable with TracksIU: the IU track parameters brought to the reference X, so that a re-propagation
+// to a vertex does not have to go again through the material between the IU position and the reference X
+DECLARE_SOA_TABLE(TracksAtRefRadius, "AOD", "TRACKATREF", //!
+                  track_at_ref::X, track_at_ref::Alpha, track_at_ref::Y, track_at_ref::Z,
+                  track_at_ref::Snp, track_at_ref::Tgl, track_at_ref::Signed1Pt,
+                  track_at_ref::X2X0, track_at_ref::XRho);
+} // namespace o2::aod
+
 namespace o2
 {
 namespace common
 {
 
+// least recently used cache of the tracks propagated to the DCA of a collision, keyed by (track, collision)
+// the indices are the ones of the current data frame, so the cache has to be cleared for each of them
+class TrackPropagationCache
+{
+ public:
+  struct Entry {
+    o2::track::TrackParametrizationWithError<float> trackParCov;
+    o2::dataformats::DCA dca;
+    bool isPropagationOK = false;
+  };
+
+  void setCapacity(std::size_t capacity)
+  {
+    mCapacity = capacity;
+    clear();
+    mIndex.reserve(capacity);
+  }
+  std::size_t capacity() const { return mCapacity; }
+
+  void clear()
+  {
+    mEntries.clear();
+    mIndex.clear();
+  }
+
+  /// returns the cached entry, or nullptr if the pair is not cached
+  const Entry* find(int64_t trackId, int64_t collisionId)
+  {
+    auto it = mIndex.find(key(trackId, collisionId));
+    if (it == mIndex.end()) {
+      return nullptr;
+    }
+    mEntries.splice(mEntries.begin(), mEntries, it->second); // most recently used first
+    return &it->second->second;
+  }
+
+  /// adds an entry for the pair, dropping the least recently used one if the cache is full
+  Entry& insert(int64_t trackId, int64_t collisionId)
+  {
+    if (mEntries.size() >= mCapacity) {
+      mIndex.erase(mEntries.back().first);
+      mEntries.splice(mEntries.begin(), mEntries, std::prev(mEntries.end())); // reuse the node
+      mEntries.front().first = key(trackId, collisionId);
+    } else {
+      mEntries.emplace_front(key(trackId, collisionId), Entry{});
+    }
+    mIndex[mEntries.front().first] = mEntries.begin();
+    return mEntries.front().second;
+  }
+
+ private:
+  static uint64_t key(int64_t trackId, int64_t collisionId)
+  {
+    return (static_cast<uint64_t>(trackId) << 32) | static_cast<uint32_t>(collisionId);
+  }
+
+  std::size_t mCapacity = 0;
+  std::list<std::pair<uint64_t, Entry>> mEntries;
+  std::unordered_map<uint64_t, std::list<std::pair<uint64_t, Entry>>::iterator> mIndex;
+};
+
 struct TrackPropagationProducts : o2::framework::ProducesGroup {
   o2::framework::Produces<aod::StoredTracks> tracksParPropagated;
   o2::framework::Produces<aod::TracksExtension> tracksParExtensionPropagated;
@@ -68,11 +159,14 @@ struct TrackPropagationProducts : o2::framework::ProducesGroup {
   o2::framework::Produces<aod::TracksDCA> tracksDCA;
   o2::framework::Produces<aod::TracksDCACov> tracksDCACov;
   o2::framework::Produces<aod::TrackTunerTable> tunertable;
+  o2::framework::Produces<aod::TracksAtRefRadius> tracksAtRefRadius;
 };
 
 struct TrackPropagationConfigurables : o2::framework::ConfigurableGroup {
   std::string prefix = "trackPropagation";
   o2::framework::Configurable<float> minPropagationRadius{"minPropagationDistance", o2::constants::geom::XTPCInnerRef + 0.1, "Only tracks which are at a smaller radius will be propagated, defaults to TPC inner wall"};
+  o2::framework::Configurable<float> refRadius{"refRadius", o2::constants::geom::XBeamPipeOuterRef, "X to which the IU tracks are brought for the TracksAtRefRadius table"};
+  o2::framework::Configurable<int> propagationCacheSize{"propagationCacheSize", 0, "Number of (track, collision) pairs kept by propagateToDCA(), 0 disables the cache"};
   // for TrackTuner only (MC smearing)
   o2::framework::Configurable<bool> useTrackTuner{"useTrackTuner", false, "Apply track tuner corrections to MC"};
   o2::framework::Configurable<bool> useTrkPid{"useTrkPid", false, "use pid in tracking"};
@@ -95,6 +189,7 @@ class TrackPropagationModule
   bool fillTracksCov = false;
   bool fillTracksDCA = false;
   bool fillTracksDCACov = false;
+  bool fillTracksAtRefRadius = false;
   o2::base::Propagator::MatCorrType matCorr = o2::base::Propagator::MatCorrType::USEMatCorrLUT;
 
   // pointers to objs needed for operation
@@ -106,8 +201,12 @@ class TrackPropagationModule
   o2::dataformats::VertexBase mVtx;
   o2::track::TrackParametrization<float> mTrackPar;
   o2::track::TrackParametrizationWithError<float> mTrackParCov;
+  o2::track::TrackParametrization<float> mTrackParAtRef;
+  o2::track::TrackLTIntegral mLTIntegral;
   bool autoDetectDcaCalib = false; // track tuner setting
 
+  TrackPropagationCache propagationCache;
+
   template <typename TConfigurableGroup, typename TInitContext, typename THistoRegistry>
   void init(TConfigurableGroup const& cGroup, TrackTuner& trackTunerObj, THistoRegistry& registry, TInitContext& initContext)
   {
@@ -116,6 +215,10 @@ class TrackPropagationModule
     fillTracksCov = o2::common::core::isTableRequiredInWorkflow(initContext, "TracksCov");
     fillTracksDCA = o2::common::core::isTableRequiredInWorkflow(initContext, "TracksDCA");
     fillTracksDCACov = o2::common::core::isTableRequiredInWorkflow(initContext, "TracksDCACov");
+    fillTracksAtRefRadius = o2::common::core::isTableRequiredInWorkflow(initContext, "TracksAtRefRadius");
+    if (cGroup.propagationCacheSize.value > 0) {
+      propagationCache.setCapacity(cGroup.propagationCacheSize.value);
+    }
 
     // enable Tracks in case Tracks have been requested
     if (fillTracksDCA && !fillTracks) {
@@ -147,6 +250,9 @@ class TrackPropagationModule
     if (fillTracksDCACov) {
       LOGF(info, " ---> Will generate TracksDCACov table.");
     }
+    if (fillTracksAtRefRadius) {
+      LOGF(info, " ---> Will generate TracksAtRefRadius table.");
+    }
     if (fillTracksCov) {
       LOGF(info, "**************************************************************");
       LOGF(info, " Warning: TracksCov has been requested due to a subscription!");
@@ -230,6 +336,11 @@ class TrackPropagationModule
       trackTunerObj.getDcaGraphs();
     }
 
+    propagationCache.clear(); // indices of the previous data frame
+    if (fillTracksAtRefRadius) {
+      fillTrackAtRefRadiusTable(cGroup, tracks, cursors);
+    }
+
     if (!fillTracks) {
       return; // suppress everything
     }
@@ -363,6 +474,59 @@ class TrackPropagationModule
       }
     }
   }
+
+  template <typename TConfigurableGroup, typename TTracks, typename TOutputGroup>
+  void fillTrackAtRefRadiusTable(TConfigurableGroup const& cGroup, TTracks const& tracks, TOutputGroup& cursors)
+  {
+    cursors.tracksAtRefRadius.reserve(tracks.size());
+    for (const auto& track : tracks) {
+      setTrackPar(track, mTrackParAtRef);
+      mLTIntegral.clearFast();
+      mLTIntegral.setTimeNotNeeded();
+      // tracks already inside the reference X, or not to be propagated, are kept as they are with no material
+      if (track.trackType() == o2::aod::track::TrackIU && track.x() < cGroup.minPropagationRadius.value && track.x() > cGroup.refRadius.value) {
+        if (!o2::base::Propagator::Instance()->PropagateToXBxByBz(mTrackParAtRef, cGroup.refRadius.value, o2::base::Propagator::MAX_SIN_PHI, o2::base::Propagator::MAX_STEP, matCorr, &mLTIntegral)) {
+          setTrackPar(track, mTrackParAtRef);
+          mLTIntegral.clearFast();
+        }
+      }
+      cursors.tracksAtRefRadius(mTrackParAtRef.getX(), mTrackParAtRef.getAlpha(), mTrackParAtRef.getY(), mTrackParAtRef.getZ(), mTrackParAtRef.getSnp(), mTrackParAtRef.getTgl(), mTrackParAtRef.getQ2Pt(),
+                                mLTIntegral.getX2X0(), mLTIntegral.getXRho());
+    }
+  }
+
+  /// Propagates the IU track to the DCA of the collision vertex, with the module material correction.
+  /// With propagationCacheSize > 0 the result is cached per (track, collision) pair for the current data frame,
+  /// so that reassociated tracks tested against the same collision several times are propagated once
+  template <typename TTrack, typename TCollision>
+  bool propagateToDCA(TTrack const& track, TCollision const& collision, o2::track::TrackParametrizationWithError<float>& trackParCov, o2::dataformats::DCA* dca = nullptr)
+  {
+    const bool useCache = propagationCache.capacity() > 0;
+    if (useCache) {
+      if (const auto* cached = propagationCache.find(track.globalIndex(), collision.globalIndex())) {
+        trackParCov = cached->trackParCov;
+        if (dca) {
+          *dca = cached->dca;
+        }
+        return cached->isPropagationOK;
+      }
+    }
+    setTrackParCov(track, trackParCov);
+    mVtx.setPos({collision.posX(), collision.posY(), collision.posZ()});
+    mVtx.setCov(collision.covXX(), collision.covXY(), collision.covYY(), collision.covXZ(), collision.covYZ(), collision.covZZ());
+    mDcaInfoCov.set(999, 999, 999, 999, 999);
+    const bool isPropagationOK = o2::base::Propagator::Instance()->propagateToDCABxByBz(mVtx, trackParCov, 2.f, matCorr, &mDcaInfoCov);
+    if (useCache) {
+      auto& entry = propagationCache.insert(track.globalIndex(), collision.globalIndex());
+      entry.trackParCov = trackParCov;
+      entry.dca = mDcaInfoCov;
+      entry.isPropagationOK = isPropagationOK;
+    }
+    if (dca) {
+      *dca = mDcaInfoCov;
+    }
+    return isPropagationOK;
+  }
 };
 
 } // namespace common
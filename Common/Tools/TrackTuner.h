@@ -29,6 +29,7 @@
 
 #include <TDirectory.h>
 #include <TFile.h>
+#include <TGraph.h>
 #include <TGraphErrors.h>
 #include <TObject.h>
 
@@ -125,6 +126,69 @@ struct TrackTuner : o2::framework::ConfigurableGroup {
   std::vector<std::unique_ptr<TGraphErrors>> grDcaZPullVsPtPionMC;
   std::vector<std::unique_ptr<TGraphErrors>> grDcaZPullVsPtPionData;
 
+  /// @brief Points of a graph copied in plain arrays, evaluated as evalGraph does (linear interpolation, x clamped to the graph range)
+  struct GraphTable {
+    /// position of a pt value between two points of the graphs: the lower point and the fraction to the upper one
+    struct Segment {
+      int low = 0;
+      double fraction = 0.;
+    };
+
+    std::vector<double> x;
+    std::vector<double> y;
+
+    void set(const TGraph* graph)
+    {
+      const int nPoints = graph->GetN();
+      std::vector<int> order(nPoints);
+      for (int i = 0; i < nPoints; ++i) {
+        order[i] = i;
+      }
+      std::stable_sort(order.begin(), order.end(), [graph](int a, int b) { return graph->GetX()[a] < graph->GetX()[b]; });
+      x.resize(nPoints);
+      y.resize(nPoints);
+      for (int i = 0; i < nPoints; ++i) {
+        x[i] = graph->GetX()[order[i]];
+        y[i] = graph->GetY()[order[i]];
+      }
+    }
+
+    Segment locate(double value) const
+    {
+      Segment segment;
+      if (x.size() < 2) {
+        return segment;
+      }
+      value = std::clamp(value, x.front(), x.back());
+      segment.low = std::min(static_cast<int>(std::upper_bound(x.begin(), x.end(), value) - x.begin()) - 1, static_cast<int>(x.size()) - 2);
+      const double width = x[segment.low + 1] - x[segment.low];
+      segment.fraction = width > 0. ? (value - x[segment.low]) / width : 0.;
+      return segment;
+    }
+
+    double eval(Segment const& segment) const
+    {
+      if (x.size() < 2) {
+        return y.empty() ? 0. : y.front();
+      }
+      return y[segment.low] + segment.fraction * (y[segment.low + 1] - y[segment.low]);
+    }
+
+    double eval(double value) const { return eval(locate(value)); }
+
+    bool hasSamePoints(GraphTable const& other) const { return x == other.x; }
+  };
+
+  /// @brief the correction graphs of one phi bin, the pt segment is computed once when all the graphs share the same points
+  struct PhiBinTables {
+    GraphTable dcaXYResMC, dcaXYResData, dcaZResMC, dcaZResData;
+    GraphTable dcaXYMeanMC, dcaXYMeanData, dcaXYPullMC, dcaXYPullData, dcaZPullMC, dcaZPullData;
+    bool samePoints = false;
+  };
+  std::vector<PhiBinTables> graphTables;
+  GraphTable tabOneOverPtPionMC;
+  GraphTable tabOneOverPtPionData;
+
   /// @brief Function to initialize the run number to that of the 1st considered bunch crossing (useful only if autoDetectDcaCalib = true)
   void setRunNumber(int n)
   {
@@ -713,6 +777,31 @@ struct TrackTuner : o2::framework::ConfigurableGroup {
       grOneOverPtPionData.reset(dynamic_cast<TGraphErrors*>(ccdb_object_qoverpt->FindObject(grOneOverPtPionNameData.c_str())));
     }
 
+    /// copy the graphs in plain arrays, evaluated for every track
+    graphTables.assign(nPhiBins, PhiBinTables{});
+    for (int iPhiBin = 0; iPhiBin < nPhiBins; ++iPhiBin) {
+      auto& tables = graphTables[iPhiBin];
+      tables.dcaXYResMC.set(grDcaXYResVsPtPionMC[iPhiBin].get());
+      tables.dcaXYResData.set(grDcaXYResVsPtPionData[iPhiBin].get());
+      tables.dcaZResMC.set(grDcaZResVsPtPionMC[iPhiBin].get());
+      tables.dcaZResData.set(grDcaZResVsPtPionData[iPhiBin].get());
+      tables.dcaXYMeanMC.set(grDcaXYMeanVsPtPionMC[iPhiBin].get());
+      tables.dcaXYMeanData.set(grDcaXYMeanVsPtPionData[iPhiBin].get());
+      tables.dcaXYPullMC.set(grDcaXYPullVsPtPionMC[iPhiBin].get());
+      tables.dcaXYPullData.set(grDcaXYPullVsPtPionData[iPhiBin].get());
+      tables.dcaZPullMC.set(grDcaZPullVsPtPionMC[iPhiBin].get());
+      tables.dcaZPullData.set(grDcaZPullVsPtPionData[iPhiBin].get());
+      tables.samePoints = true;
+      for (const auto* table : {&tables.dcaXYResData, &tables.dcaZResMC, &tables.dcaZResData, &tables.dcaXYMeanMC, &tables.dcaXYMeanData,
+                                &tables.dcaXYPullMC, &tables.dcaXYPullData, &tables.dcaZPullMC, &tables.dcaZPullData}) {
+        tables.samePoints = tables.samePoints && tables.dcaXYResMC.hasSamePoints(*table);
+      }
+    }
+    if (grOneOverPtPionMC.get() && grOneOverPtPionData.get()) {
+      tabOneOverPtPionMC.set(grOneOverPtPionMC.get());
+      tabOneOverPtPionData.set(grOneOverPtPionData.get());
+    }
+
     /// if we arrive here, it means that the graphs are all set
     areGraphsConfigured = true;
 
@@ -748,11 +837,16 @@ struct TrackTuner : o2::framework::ConfigurableGroup {
       phiMC += o2::constants::math::TwoPI;                                    // 2 * std::numbers::pi;//
     int phiBin = phiMC / (o2::constants::math::TwoPI + 0.0000001) * nPhiBins; // 0.0000001 just a numerical protection
 
-    dcaXYResMC = evalGraph(ptMC, grDcaXYResVsPtPionMC[phiBin].get());
-    dcaXYResData = evalGraph(ptMC, grDcaXYResVsPtPionData[phiBin].get());
+    // the graphs are evaluated from their copies in plain arrays, with a single pt search when they share the same points
+    const auto& tables = graphTables[phiBin];
+    const auto segment = tables.dcaXYResMC.locate(ptMC);
+    auto evalTable = [&](GraphTable const& table) { return tables.samePoints ? table.eval(segment) : table.eval(ptMC); };
+
+    dcaXYResMC = evalTable(tables.dcaXYResMC);
+    dcaXYResData = evalTable(tables.dcaXYResData);
 
-    dcaZResMC = evalGraph(ptMC, grDcaZResVsPtPionMC[phiBin].get());
-    dcaZResData = evalGraph(ptMC, grDcaZResVsPtPionData[phiBin].get());
+    dcaZResMC = evalTable(tables.dcaZResMC);
+    dcaZResData = evalTable(tables.dcaZResData);
 
     // Local Q/Pt resolution: either the constant configurable value, or evaluated per-track from graphs
     double smearQOverPtMC = qOverPtMC;
@@ -763,8 +857,8 @@ struct TrackTuner : o2::framework::ConfigurableGroup {
         if (!grOneOverPtPionData.get() || !grOneOverPtPionMC.get()) {
           LOG(fatal) << "### q/pt smearing: input graphs not correctly retrieved. Aborting.";
         }
-        smearQOverPtMC = std::max(0.0, evalGraph(ptMC, grOneOverPtPionMC.get()));
-        smearQOverPtData = std::max(0.0, evalGraph(ptMC, grOneOverPtPionData.get()));
+        smearQOverPtMC = std::max(0.0, tabOneOverPtPionMC.eval(ptMC));
+        smearQOverPtData = std::max(0.0, tabOneOverPtPionData.eval(ptMC));
         if (debugInfo) {
           LOG(info) << "### q/pt graph-based smearing: pT=" << ptMC
                     << " sigma(1/pT)_MC=" << smearQOverPtMC
@@ -776,14 +870,14 @@ struct TrackTuner : o2::framework::ConfigurableGroup {
 
     if (updateTrackDCAs) {
 
-      dcaXYMeanMC = evalGraph(ptMC, grDcaXYMeanVsPtPionMC[phiBin].get());
-      dcaXYMeanData = evalGraph(ptMC, grDcaXYMeanVsPtPionData[phiBin].get());
+      dcaXYMeanMC = evalTable(tables.dcaXYMeanMC);
+      dcaXYMeanData = evalTable(tables.dcaXYMeanData);
 
-      dcaXYPullMC = evalGraph(ptMC, grDcaXYPullVsPtPionMC[phiBin].get());
-      dcaXYPullData = evalGraph(ptMC, grDcaXYPullVsPtPionData[phiBin].get());
+      dcaXYPullMC = evalTable(tables.dcaXYPullMC);
+      dcaXYPullData = evalTable(tables.dcaXYPullData);
 
-      dcaZPullMC = evalGraph(ptMC, grDcaZPullVsPtPionMC[phiBin].get());
-      dcaZPullData = evalGraph(ptMC, grDcaZPullVsPtPionData[phiBin].get());
+      dcaZPullMC = evalTable(tables.dcaZPullMC);
+      dcaZPullData = evalTable(tables.dcaZPullData);
     }
     //  Unit conversion, is it required ??
     dcaXYResMC *= 1.e-4;
@@ -84,64 +84,86 @@ class TimestampModule
     }
   }
 
+  // sets the orbit-reset timestamp and the run duration of runNumber, from the cache or from CCDB:
+  // to be called when the run changes, before getTimestamp
+  template <typename Tccdb>
+  void setRun(int runNumber, Tccdb const& ccdb)
+  {
+    // We need to set the orbit-reset timestamp for the run number.
+    // This is done with caching if the run number was already processed before.
+    // If not the orbit-reset timestamp for the run number is queried from CCDB and added to the cache
+    if (runNumber == lastRunNumber) { // The run number coincides to the last run processed
+      LOGF(debug, "Using orbit-reset timestamp from last call");
+      return;
+    }
+    auto cached = mapRunToOrbitReset.find(runNumber);
+    if (cached != mapRunToOrbitReset.end()) { // The run number was already requested before: getting it from cache!
+      LOGF(debug, "Getting orbit-reset timestamp from cache");
+      orbitResetTimestamp = cached->second;
+      runDuration = mapRunToRunDuration[runNumber];
+    } else { // The run was not requested before: need to acccess CCDB!
+      LOGF(debug, "Getting start-of-run and end-of-run timestamps from CCDB");
+      runDuration = ccdb->getRunDuration(runNumber, true); /// fatalise if timestamps are not found
+      int64_t sorTimestamp = runDuration.first;            // timestamp of the SOR/SOX/STF in ms
+      int64_t eorTimestamp = runDuration.second;           // timestamp of the EOR/EOX/ETF in ms
+
+      // clear cache to prevent interference with orbit reset queries from other code
+      // FIXME this should not have been a problem, to be investigated
+      ccdb->clearCache(timestampOpts.orbitResetPath.value.data());
+
+      const int maxRunNumberUnanchored = 499999;
+      const int minRunNumberUnanchored = 300000;
+      const bool isUnanchoredRun3MC = runNumber >= minRunNumberUnanchored && runNumber <= maxRunNumberUnanchored;
+      if (timestampOpts.isRun2MC.value == 1 || isUnanchoredRun3MC) {
+        // isRun2MC: bc/orbit distributions are not simulated in Run2 MC. All bcs are set to 0.
+        // isUnanchoredRun3MC: assuming orbit-reset is done in the beginning of each run
+        // Setting orbit-reset timestamp to start-of-run timestamp
+        orbitResetTimestamp = sorTimestamp * 1000;     // from ms to us
+      } else if (runNumber < minRunNumberUnanchored) { // Run 2
+        LOGF(debug, "Getting orbit-reset timestamp using start-of-run timestamp from CCDB");
+        auto ctp = ccdb->template getSpecific<std::vector<int64_t>>(timestampOpts.orbitResetPath.value.data(), sorTimestamp);
+        orbitResetTimestamp = (*ctp)[0];
+      } else {
+        // sometimes orbit is reset after SOR. Using EOR timestamps for orbitReset query is more reliable
+        LOGF(debug, "Getting orbit-reset timestamp using end-of-run timestamp from CCDB");
+        auto ctp = ccdb->template getSpecific<std::vector<int64_t>>(timestampOpts.orbitResetPath.value.data(), eorTimestamp / 2 + sorTimestamp / 2);
+        orbitResetTimestamp = (*ctp)[0];
+      }
+
+      // Adding the timestamp to the cache map
+      std::pair<std::map<int, int64_t>::iterator, bool> check;
+      check = mapRunToOrbitReset.insert(std::pair<int, int64_t>(runNumber, orbitResetTimestamp));
+      if (!check.second) {
+        LOGF(fatal, "Run number %i already existed with a orbit-reset timestamp of %llu", runNumber, check.first->second);
+      }
+      mapRunToRunDuration[runNumber] = runDuration;
+      LOGF(info, "Add new run number %i with orbit-reset timestamp %llu, SOR: %llu, EOR: %llu to cache", runNumber, orbitResetTimestamp, runDuration.first, runDuration.second);
+    }
+    lastRunNumber = runNumber;
+  }
+
+  // timestamp in ms of a BC of the run given to setRun
+  int64_t getTimestamp(uint64_t globalBC) const
+  {
+    return (orbitResetTimestamp + static_cast<int64_t>(globalBC * o2::constants::lhc::LHCBunchSpacingNS * 1e-3)) / 1000; // us -> ms
+  }
+
   template <typename TBCs, typename Tccdb, typename TTimestampBuffer, typename TCursor>
   void process(TBCs const& bcs, Tccdb const& ccdb, TTimestampBuffer& timestampbuffer, TCursor& timestampTable)
   {
     timestampbuffer.clear();
+    timestampbuffer.reserve(bcs.size());
+    timestampTable.reserve(bcs.size());
     for (auto const& bc : bcs) {
       int runNumber = bc.runNumber();
-      // We need to set the orbit-reset timestamp for the run number.
-      // This is done with caching if the run number was already processed before.
-      // If not the orbit-reset timestamp for the run number is queried from CCDB and added to the cache
-      if (runNumber == lastRunNumber) { // The run number coincides to the last run processed
-        LOGF(debug, "Using orbit-reset timestamp from last call");
-      } else if (mapRunToOrbitReset.count(runNumber)) { // The run number was already requested before: getting it from cache!
-        LOGF(debug, "Getting orbit-reset timestamp from cache");
-        orbitResetTimestamp = mapRunToOrbitReset[runNumber];
-        runDuration = mapRunToRunDuration[runNumber];
-      } else { // The run was not requested before: need to acccess CCDB!
-        LOGF(debug, "Getting start-of-run and end-of-run timestamps from CCDB");
-        runDuration = ccdb->getRunDuration(runNumber, true); /// fatalise if timestamps are not found
-        int64_t sorTimestamp = runDuration.first;            // timestamp of the SOR/SOX/STF in ms
-        int64_t eorTimestamp = runDuration.second;           // timestamp of the EOR/EOX/ETF in ms
-
-        // clear cache to prevent interference with orbit reset queries from other code
-        // FIXME this should not have been a problem, to be investigated
-        ccdb->clearCache(timestampOpts.orbitResetPath.value.data());
-
-        const int maxRunNumberUnanchored = 499999;
-        const int minRunNumberUnanchored = 300000;
-        const bool isUnanchoredRun3MC = runNumber >= minRunNumberUnanchored && runNumber <= maxRunNumberUnanchored;
-        if (timestampOpts.isRun2MC.value == 1 || isUnanchoredRun3MC) {
-          // isRun2MC: bc/orbit distributions are not simulated in Run2 MC. All bcs are set to 0.
-          // isUnanchoredRun3MC: assuming orbit-reset is done in the beginning of each run
-          // Setting orbit-reset timestamp to start-of-run timestamp
-          orbitResetTimestamp = sorTimestamp * 1000;     // from ms to us
-        } else if (runNumber < minRunNumberUnanchored) { // Run 2
-          LOGF(debug, "Getting orbit-reset timestamp using start-of-run timestamp from CCDB");
-          auto ctp = ccdb->template getSpecific<std::vector<int64_t>>(timestampOpts.orbitResetPath.value.data(), sorTimestamp);
-          orbitResetTimestamp = (*ctp)[0];
-        } else {
-          // sometimes orbit is reset after SOR. Using EOR timestamps for orbitReset query is more reliable
-          LOGF(debug, "Getting orbit-reset timestamp using end-of-run timestamp from CCDB");
-          auto ctp = ccdb->template getSpecific<std::vector<int64_t>>(timestampOpts.orbitResetPath.value.data(), eorTimestamp / 2 + sorTimestamp / 2);
-          orbitResetTimestamp = (*ctp)[0];
-        }
-
-        // Adding the timestamp to the cache map
-        std::pair<std::map<int, int64_t>::iterator, bool> check;
-        check = mapRunToOrbitReset.insert(std::pair<int, int64_t>(runNumber, orbitResetTimestamp));
-        if (!check.second) {
-          LOGF(fatal, "Run number %i already existed with a orbit-reset timestamp of %llu", runNumber, check.first->second);
-        }
-        mapRunToRunDuration[runNumber] = runDuration;
-        LOGF(info, "Add new run number %i with orbit-reset timestamp %llu, SOR: %llu, EOR: %llu to cache", runNumber, orbitResetTimestamp, runDuration.first, runDuration.second);
+      if (runNumber != lastRunNumber) {
+        setRun(runNumber, ccdb);
       }
 
       if (timestampOpts.verbose) {
         LOGF(info, "Orbit-reset timestamp for run number %i found: %llu us", runNumber, orbitResetTimestamp);
       }
-      int64_t timestamp{(orbitResetTimestamp + static_cast<int64_t>(bc.globalBC() * o2::constants::lhc::LHCBunchSpacingNS * 1e-3)) / 1000}; // us -> ms
+      int64_t timestamp = getTimestamp(bc.globalBC());
       if (timestamp < runDuration.first || timestamp > runDuration.second) {
         if (timestampOpts.fatalOnInvalidTimestamp.value) {
           LOGF(fatal, "Timestamp %llu us is out of run duration [%llu, %llu] ms", timestamp, runDuration.first, runDuration.second);
@@ -109,6 +109,9 @@ struct qaEventTrack {
   // options to check the track variables only for PV contributors
   Configurable<bool> checkOnlyPVContributor{"checkOnlyPVContributor", false, "check the track variables only for primary vertex contributors"};
 
+  // option to fill the track histograms only for a subset of the collisions, the event histograms are filled for all of them
+  Configurable<int> trackQaSamplingFactor{"trackQaSamplingFactor", 1, "fill the track histograms only for 1/N of the selected collisions, chosen by hashing their BC (1: all the collisions)"};
+
   // options to force or not the presence of TRD (debug)
   struct : ConfigurableGroup {
     Configurable<bool> activateChecksTRD{"activateChecksTRD", false, "Activate the checks wityh TRD - force the track to have or not have TRD"};
@@ -285,6 +288,10 @@ struct qaEventTrack {
 
     histos.add("Events/nFilteredTracks", ";n filtered tracks", kTH1D, {axisTrackMultiplicity});
     histos.add("Events/nTracks", ";track multiplicity", kTH1D, {axisTrackMultiplicity});
+    if (trackQaSamplingFactor > 1) {
+      // normalisation of the track histograms
+      histos.add("Events/nCollisionsTrackQa", ";;collisions with track QA", kTH1D, {{1, 0.5, 1.5}});
+    }
 
     if (doprocessMC || doprocessRun2ConvertedMC) {
       histos.add<TH2>("Events/resoX", ";X_{Rec} - X_{Gen} [cm]", kTH2D, {axisVertexPosReso, axisVertexNumContrib});
@@ -739,6 +746,21 @@ struct qaEventTrack {
     return true;
   }
 
+  // Deterministic choice of the collisions with track QA: the BC index is hashed (splitmix64 finaliser) so that
+  // the sampled collisions do not follow the filling scheme
+  template <typename C>
+  bool isSampledForTrackQa(const C& collision)
+  {
+    if (trackQaSamplingFactor <= 1) {
+      return true;
+    }
+    uint64_t hash = static_cast<uint64_t>(collision.bcId());
+    hash = (hash ^ (hash >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    hash = (hash ^ (hash >> 27)) * 0x94d049bb133111ebULL;
+    hash ^= hash >> 31;
+    return hash % static_cast<uint64_t>(trackQaSamplingFactor) == 0;
+  }
+
   // General functions to fill data and MC histograms
   template <bool IS_MC, bool FILL_FILTERED, typename T>
   void fillRecoHistogramsAllTracks(const T& tracks, const aod::AmbiguousTracks& tracksAmbiguous);
@@ -1313,6 +1335,11 @@ void qaEventTrack::fillRecoHistogramsGroupedTracks(const C& collision, const T&
   if (!isSelectedCollision<true>(collision)) {
     return;
   }
+  // in the non-sampled collisions the tracks are only counted for the event histograms
+  const bool fillTrackQa = isSampledForTrackQa(collision);
+  if (fillTrackQa && trackQaSamplingFactor > 1) {
+    histos.fill(HIST("Events/nCollisionsTrackQa"), 1);
+  }
 
   int nFilteredTracks = 0;
   int atLeastITSTracks = 0;
@@ -1320,15 +1347,20 @@ void qaEventTrack::fillRecoHistogramsGroupedTracks(const C& collision, const T&
     if (checkOnlyPVContributor && !track.isPVContributor()) {
       continue;
     }
-    histos.fill(HIST("Tracks/selection"), 1.f);
+    if (fillTrackQa) {
+      histos.fill(HIST("Tracks/selection"), 1.f);
+    }
     if (track.hasITS()) {
       atLeastITSTracks++;
     }
     if (!isSelectedTrack<IS_MC>(track)) {
       continue;
     }
-    histos.fill(HIST("Tracks/selection"), 2.f);
     ++nFilteredTracks;
+    if (!fillTrackQa) {
+      continue;
+    }
+    histos.fill(HIST("Tracks/selection"), 2.f);
     if (track.passedTrackType()) {
       histos.fill(HIST("Tracks/selection"), 3.f);
     }
@@ -1502,28 +1534,30 @@ void qaEventTrack::fillRecoHistogramsGroupedTracks(const C& collision, const T&
   int nPvContrWithTOF = 0;
   int nPvContrWithTRD = 0;
   for (const auto& trackUnfiltered : tracksUnfiltered) {
-    // fill unfiltered track pt
-    if (trackUnfiltered.sign() > 0) {
-      histos.fill(HIST("Tracks/Kine/ptUnfilteredPositive"), trackUnfiltered.pt());
-    } else {
-      histos.fill(HIST("Tracks/Kine/ptUnfilteredNegative"), trackUnfiltered.pt());
-    }
-    // fill ITS variables
-    int itsNhits = 0;
-    for (unsigned int i = 0; i < 7; i++) {
-      if (trackUnfiltered.itsClusterMap() & (1 << i)) {
-        itsNhits += 1;
+    if (fillTrackQa) {
+      // fill unfiltered track pt
+      if (trackUnfiltered.sign() > 0) {
+        histos.fill(HIST("Tracks/Kine/ptUnfilteredPositive"), trackUnfiltered.pt());
+      } else {
+        histos.fill(HIST("Tracks/Kine/ptUnfilteredNegative"), trackUnfiltered.pt());
       }
-    }
-    bool trkHasITS = false;
-    for (unsigned int i = 0; i < 7; i++) {
-      if (trackUnfiltered.itsClusterMap() & (1 << i)) {
-        trkHasITS = true;
-        histos.fill(HIST("Tracks/ITS/itsHitsUnfiltered"), i, itsNhits);
+      // fill ITS variables
+      int itsNhits = 0;
+      for (unsigned int i = 0; i < 7; i++) {
+        if (trackUnfiltered.itsClusterMap() & (1 << i)) {
+          itsNhits += 1;
+        }
+      }
+      bool trkHasITS = false;
+      for (unsigned int i = 0; i < 7; i++) {
+        if (trackUnfiltered.itsClusterMap() & (1 << i)) {
+          trkHasITS = true;
+          histos.fill(HIST("Tracks/ITS/itsHitsUnfiltered"), i, itsNhits);
+        }
+      }
+      if (!trkHasITS) {
+        histos.fill(HIST("Tracks/ITS/itsHitsUnfiltered"), -1, itsNhits);
       }
-    }
-    if (!trkHasITS) {
-      histos.fill(HIST("Tracks/ITS/itsHitsUnfiltered"), -1, itsNhits);
     }
 
     /// look for PV contributors and check correlation between TRD and TOF
@@ -1540,6 +1574,10 @@ void qaEventTrack::fillRecoHistogramsGroupedTracks(const C& collision, const T&
   histos.fill(HIST("Events/nContribWithTOFvsWithTRD"), nPvContrWithTOF, nPvContrWithTRD);
   histos.fill(HIST("Events/nContribAllvsWithTRD"), collision.numContrib(), nPvContrWithTRD);
 
+  if (!fillTrackQa) {
+    return;
+  }
+
   // track related histograms
   for (const auto& track : tracks) {
     if (checkOnlyPVContributor && !track.isPVContributor()) {
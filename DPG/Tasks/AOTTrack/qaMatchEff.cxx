@@ -52,7 +52,9 @@
 #include <RtypesCore.h>
 
 #include <algorithm>
+#include <array>
 #include <cmath>
+#include <cstddef>
 #include <cstdint>
 #include <iterator>
 #include <set>
@@ -204,6 +206,15 @@ struct qaMatchEff {
   Configurable<bool> isPIDKaonRequired{"isPIDKaonRequired", false, "choose if apply kaon PID"};
   Configurable<bool> isPIDProtonRequired{"isPIDProtonRequired", false, "choose if apply proton PID"};
   //
+  // nSigma windows of pions, kaons and protons (in this order) read from nSigmaPID once in init, not per track
+  struct NSigmaWindow {
+    float min;
+    float max;
+    bool contains(float nSigma) const { return min < nSigma && nSigma < max; }
+  };
+  std::array<NSigmaWindow, 3> nSigmaWindowsTPC;
+  std::array<NSigmaWindow, 3> nSigmaWindowsTOF;
+  //
   // limit for z position of primary vertex
   Configurable<float> zPrimVtxMax{"zPrimVtxax", 999.f, "Maximum asbolute value of z of primary vertex"};
   //
@@ -253,6 +264,21 @@ struct qaMatchEff {
     if (doprocessTrkIUData && makethn) {
       LOGF(fatal, "No DCA for IU tracks. Put makethn = false.");
     }
+    // all the data (MC) process functions fill the same histograms, each enabled one loops again over the tracks
+    const int nDataProcesses = doprocessData + doprocessDataPbPbCent + doprocessTrkIUData + doprocessDataNoColl;
+    const int nMCProcesses = doprocessMC + doprocessMCPbPbCent + doprocessTrkIUMC + doprocessMCNoColl;
+    if (nDataProcesses > 1 || nMCProcesses > 1) {
+      LOGF(warning, "%d data and %d MC process functions enabled: the tracks are looped over and the same histograms filled once per enabled function", nDataProcesses, nMCProcesses);
+    }
+    //
+    /// resolve the PID nSigma windows
+    const std::array<std::string, 3> pidSpecies = {"Pion", "Kaon", "Proton"};
+    for (std::size_t i = 0; i < pidSpecies.size(); i++) {
+      const std::string nameMin = "nSig" + pidSpecies[i] + "Min";
+      const std::string nameMax = "nSig" + pidSpecies[i] + "Max";
+      nSigmaWindowsTPC[i] = {nSigmaPID->get("TPC", nameMin.c_str()), nSigmaPID->get("TPC", nameMax.c_str())};
+      nSigmaWindowsTOF[i] = {nSigmaPID->get("TOF", nameMin.c_str()), nSigmaPID->get("TOF", nameMax.c_str())};
+    }
     //
     /// initialize the track selections
     if (isUseTrackSelections) {
@@ -1597,12 +1623,15 @@ struct qaMatchEff {
       const bool trkWTOF = track.hasTOF();
       const bool trkWTPC = track.hasTPC();
       const bool trkWITS = track.hasITS();
-      bool pionPIDwithTPC = (nSigmaPID->get("TPC", "nSigPionMin") < tpcNSigmaPion && tpcNSigmaPion < nSigmaPID->get("TPC", "nSigPionMax"));
-      bool pionPIDwithTOF = (nSigmaPID->get("TOF", "nSigPionMin") < tofNSigmaPion && tofNSigmaPion < nSigmaPID->get("TOF", "nSigPionMax"));
-      bool kaonPIDwithTPC = (nSigmaPID->get("TPC", "nSigKaonMin") < tpcNSigmaKaon && tpcNSigmaKaon < nSigmaPID->get("TPC", "nSigKaonMax"));
-      bool kaonPIDwithTOF = (nSigmaPID->get("TOF", "nSigKaonMin") < tofNSigmaKaon && tofNSigmaKaon < nSigmaPID->get("TOF", "nSigKaonMax"));
-      bool protonPIDwithTPC = (nSigmaPID->get("TPC", "nSigProtonMin") < tpcNSigmaProton && tpcNSigmaProton < nSigmaPID->get("TPC", "nSigProtonMax"));
-      bool protonPIDwithTOF = (nSigmaPID->get("TOF", "nSigProtonMin") < tofNSigmaProton && tofNSigmaProton < nSigmaPID->get("TOF", "nSigProtonMax"));
+      // detector matching with the ITS and TPC track selections, evaluated once for all the histogram sets below
+      const bool trkSelITS = trkWITS && isTrackSelectedITSCuts(track);
+      const bool trkSelTPC = trkWTPC && isTrackSelectedTPCCuts(track);
+      bool pionPIDwithTPC = nSigmaWindowsTPC[0].contains(tpcNSigmaPion);
+      bool pionPIDwithTOF = nSigmaWindowsTOF[0].contains(tofNSigmaPion);
+      bool kaonPIDwithTPC = nSigmaWindowsTPC[1].contains(tpcNSigmaKaon);
+      bool kaonPIDwithTOF = nSigmaWindowsTOF[1].contains(tofNSigmaKaon);
+      bool protonPIDwithTPC = nSigmaWindowsTPC[2].contains(tpcNSigmaProton);
+      bool protonPIDwithTOF = nSigmaWindowsTOF[2].contains(tofNSigmaProton);
       // isPion
       bool isPion = false;
       if (isPIDPionRequired && pionPIDwithTPC && ((!trkWTOF) || pionPIDwithTOF))
@@ -1696,7 +1725,7 @@ struct qaMatchEff {
       //***************************************************************************************************************************************************************************
       //  MIND!!!!   THESE SETS OVERLAP!!!  ___M__U__S__T___ select one of the conditions in the analysis
       hasdet = 0;
-      if (trkWITS && isTrackSelectedITSCuts(track)) { // ITS at least
+      if (trkSelITS) { // ITS at least
         hasdet = 1;
         //
         //
@@ -1713,7 +1742,7 @@ struct qaMatchEff {
           }
         }
       }
-      if (trkWTPC && isTrackSelectedTPCCuts(track)) { // TPC at least
+      if (trkSelTPC) { // TPC at least
         hasdet = 2;
         //
         //
@@ -1730,7 +1759,7 @@ struct qaMatchEff {
           }
         }
       }
-      if (trkWITS && trkWTPC && isTrackSelectedTPCCuts(track) && isTrackSelectedITSCuts(track)) { // ITS + TPC at least
+      if (trkSelITS && trkSelTPC) { // ITS + TPC at least
         hasdet = 3;
         //
         //
@@ -1747,7 +1776,7 @@ struct qaMatchEff {
           }
         }
       }
-      if (trkWTOF && trkWTPC && isTrackSelectedTPCCuts(track)) { // TOF + TPC at least
+      if (trkWTOF && trkSelTPC) { // TOF + TPC at least
         hasdet = 4;
         //
         //
@@ -1764,7 +1793,7 @@ struct qaMatchEff {
           }
         }
       }
-      if (trkWITS && isTrackSelectedITSCuts(track) && trkWTOF) { // TOF + ITS at least
+      if (trkSelITS && trkWTOF) { // TOF + ITS at least
         hasdet = 5;
         //
         //
@@ -1781,7 +1810,7 @@ struct qaMatchEff {
           }
         }
       }
-      if (trkWITS && trkWTOF && trkWTPC && isTrackSelectedTPCCuts(track) && isTrackSelectedITSCuts(track)) { // TOF + TPC +ITS at least
+      if (trkSelITS && trkWTOF && trkSelTPC) { // TOF + TPC +ITS at least
         hasdet = 6;
         //
         //
@@ -1798,7 +1827,7 @@ struct qaMatchEff {
           }
         }
       }
-      if (trkWITS && isTrackSelectedITSCuts(track) && !trkWTPC) { // ITS at least, NO TPC
+      if (trkSelITS && !trkWTPC) { // ITS at least, NO TPC
         hasdet = 7;
         //
         //
@@ -1815,7 +1844,7 @@ struct qaMatchEff {
           }
         }
       }
-      if (trkWTPC && isTrackSelectedTPCCuts(track) && !trkWITS) { // TPC at least, NO ITS
+      if (trkSelTPC && !trkWITS) { // TPC at least, NO ITS
         hasdet = 8;
         //
         //
@@ -1832,7 +1861,7 @@ struct qaMatchEff {
           }
         }
       }
-      if (trkWITS && isTrackSelectedITSCuts(track) && trkWTRD) { // ITS + TRD at least
+      if (trkSelITS && trkWTRD) { // ITS + TRD at least
         hasdet = 9;
         //
         //
@@ -1849,7 +1878,7 @@ struct qaMatchEff {
           }
         }
       }
-      if (trkWITS && isTrackSelectedITSCuts(track) && trkWTRD && trkWTOF) { // ITS + TRD + TOF at least
+      if (trkSelITS && trkWTRD && trkWTOF) { // ITS + TRD + TOF at least
         hasdet = 10;
         //
         //
@@ -1866,7 +1895,7 @@ struct qaMatchEff {
           }
         }
       }
-      if (trkWITS && isTrackSelectedITSCuts(track) && !trkWTRD && !trkWTOF && !trkWTPC) { // ITS ONLY!
+      if (trkSelITS && !trkWTRD && !trkWTOF && !trkWTPC) { // ITS ONLY!
         hasdet = 11;
         //
         //
@@ -1979,7 +2008,7 @@ struct qaMatchEff {
       //
       // all tracks w/TPC
       //
-      if (trkWTPC && isTrackSelectedTPCCuts(track)) {
+      if (trkSelTPC) {
         if constexpr (IS_MC) { ////////////////////////   MC
           //
           // TPC clusters
@@ -2396,7 +2425,7 @@ struct qaMatchEff {
           } // not pions, nor kaons, nor protons
         } // end if DATA
         //
-        if (trkWITS && isTrackSelectedITSCuts(track)) { ////////////////////////////////////////////   ITS tag inside TPC tagged
+        if (trkSelITS) { ////////////////////////////////////////////   ITS tag inside TPC tagged
           if constexpr (IS_MC) {                        ////////////////////////   MC
             //
             // TPC clusters
@@ -2840,7 +2869,7 @@ struct qaMatchEff {
       //
       // positive only
       if (track.signed1Pt() > 0) {
-        if (trkWTPC && isTrackSelectedTPCCuts(track)) {
+        if (trkSelTPC) {
           if constexpr (IS_MC) {
             histos.get<TH1>(HIST("MC/pthist_tpc_pos"))->Fill(trackPt);
             histos.get<TH1>(HIST("MC/phihist_tpc_pos"))->Fill(track.phi());
@@ -2850,7 +2879,7 @@ struct qaMatchEff {
             histos.get<TH1>(HIST("data/phihist_tpc_pos"))->Fill(track.phi());
             histos.get<TH1>(HIST("data/etahist_tpc_pos"))->Fill(track.eta());
           }
-          if (trkWITS && isTrackSelectedITSCuts(track)) {
+          if (trkSelITS) {
             if constexpr (IS_MC) {
               histos.get<TH1>(HIST("MC/pthist_tpcits_pos"))->Fill(trackPt);
               histos.get<TH1>(HIST("MC/phihist_tpcits_pos"))->Fill(track.phi());
@@ -2867,7 +2896,7 @@ struct qaMatchEff {
       //
       // negative only
       if (track.signed1Pt() < 0) {
-        if (trkWTPC && isTrackSelectedTPCCuts(track)) {
+        if (trkSelTPC) {
           if constexpr (IS_MC) {
             histos.get<TH1>(HIST("MC/pthist_tpc_neg"))->Fill(trackPt);
             histos.get<TH1>(HIST("MC/phihist_tpc_neg"))->Fill(track.phi());
@@ -2877,7 +2906,7 @@ struct qaMatchEff {
             histos.get<TH1>(HIST("data/phihist_tpc_neg"))->Fill(track.phi());
             histos.get<TH1>(HIST("data/etahist_tpc_neg"))->Fill(track.eta());
           }
-          if (trkWITS && isTrackSelectedITSCuts(track)) {
+          if (trkSelITS) {
             if constexpr (IS_MC) {
               histos.get<TH1>(HIST("MC/pthist_tpcits_neg"))->Fill(trackPt);
               histos.get<TH1>(HIST("MC/phihist_tpcits_neg"))->Fill(track.phi());
@@ -2897,7 +2926,7 @@ struct qaMatchEff {
         //
         // only primaries
         if (mcpart.isPhysicalPrimary()) {
-          if (trkWTPC && isTrackSelectedTPCCuts(track)) {
+          if (trkSelTPC) {
             // histos.get<TH1>(HIST("MC/primsec/zDCA_tpc_prim"))->Fill(track.dcaZ());
             // histos.get<TH1>(HIST("MC/primsec/xyDCA_tpc_prim"))->Fill(track.dcaXY());
             //
@@ -2905,7 +2934,7 @@ struct qaMatchEff {
             histos.get<TH1>(HIST("MC/primsec/pthist_tpc_prim"))->Fill(trackPt);
             histos.get<TH1>(HIST("MC/primsec/phihist_tpc_prim"))->Fill(track.phi());
             histos.get<TH1>(HIST("MC/primsec/etahist_tpc_prim"))->Fill(track.eta());
-            if (trkWITS && isTrackSelectedITSCuts(track)) {
+            if (trkSelITS) {
               // histos.get<TH1>(HIST("MC/primsec/zDCA_tpcits_prim"))->Fill(track.dcaZ());
               // histos.get<TH1>(HIST("MC/primsec/xyDCA_tpcits_prim"))->Fill(track.dcaXY());
               //
@@ -2919,7 +2948,7 @@ struct qaMatchEff {
         } else if (mcpart.getProcess() == 4) {
           //
           // only secondaries from decay
-          if (trkWTPC && isTrackSelectedTPCCuts(track)) {
+          if (trkSelTPC) {
             // histos.get<TH1>(HIST("MC/primsec/zDCA_tpc_secd"))->Fill(track.dcaZ());
             // histos.get<TH1>(HIST("MC/primsec/xyDCA_tpc_secd"))->Fill(track.dcaXY());
             //
@@ -2927,7 +2956,7 @@ struct qaMatchEff {
             histos.get<TH1>(HIST("MC/primsec/pthist_tpc_secd"))->Fill(trackPt);
             histos.get<TH1>(HIST("MC/primsec/phihist_tpc_secd"))->Fill(track.phi());
             histos.get<TH1>(HIST("MC/primsec/etahist_tpc_secd"))->Fill(track.eta());
-            if (trkWITS && isTrackSelectedITSCuts(track)) {
+            if (trkSelITS) {
               // histos.get<TH1>(HIST("MC/primsec/zDCA_tpcits_secd"))->Fill(track.dcaZ());
               // histos.get<TH1>(HIST("MC/primsec/xyDCA_tpcits_secd"))->Fill(track.dcaXY());
               //
@@ -2941,7 +2970,7 @@ struct qaMatchEff {
         } else {
           //
           // only secondaries from material
-          if (trkWTPC && isTrackSelectedTPCCuts(track)) {
+          if (trkSelTPC) {
             // histos.get<TH1>(HIST("MC/primsec/zDCA_tpc_secm"))->Fill(track.dcaZ());
             // histos.get<TH1>(HIST("MC/primsec/xyDCA_tpc_secm"))->Fill(track.dcaXY());
             //
@@ -2949,7 +2978,7 @@ struct qaMatchEff {
             histos.get<TH1>(HIST("MC/primsec/pthist_tpc_secm"))->Fill(trackPt);
             histos.get<TH1>(HIST("MC/primsec/phihist_tpc_secm"))->Fill(track.phi());
             histos.get<TH1>(HIST("MC/primsec/etahist_tpc_secm"))->Fill(track.eta());
-            if (trkWITS && isTrackSelectedITSCuts(track)) {
+            if (trkSelITS) {
               // histos.get<TH1>(HIST("MC/primsec/zDCA_tpcits_secm"))->Fill(track.dcaZ());
               // histos.get<TH1>(HIST("MC/primsec/xyDCA_tpcits_secm"))->Fill(track.dcaXY());
               //
@@ -2963,7 +2992,7 @@ struct qaMatchEff {
         //
         // protons only
         if (tpPDGCode == 2212) {
-          if (trkWTPC && isTrackSelectedTPCCuts(track)) {
+          if (trkSelTPC) {
             //
             // TPC clusters
             histos.get<TH1>(HIST("MC/TPCclust/tpcNClsFound_prMC_tpc"))->Fill(clustpc);
@@ -2994,7 +3023,7 @@ struct qaMatchEff {
               histos.get<TH1>(HIST("MC/PID/phihist_tpc_prminus"))->Fill(track.phi());
               histos.get<TH1>(HIST("MC/PID/etahist_tpc_prminus"))->Fill(track.eta());
             }
-            if (trkWITS && isTrackSelectedITSCuts(track)) {
+            if (trkSelITS) {
               //
               // TPC clusters
               histos.get<TH1>(HIST("MC/TPCclust/tpcNClsFound_prMC_tpcits"))->Fill(clustpc);
@@ -3031,7 +3060,7 @@ struct qaMatchEff {
         //
         // pions only
         if (tpPDGCode == 211) {
-          if (trkWTPC && isTrackSelectedTPCCuts(track)) {
+          if (trkSelTPC) {
             //
             // TPC clusters
             histos.get<TH1>(HIST("MC/TPCclust/tpcNClsFound_piMC_tpc"))->Fill(clustpc);
@@ -3062,7 +3091,7 @@ struct qaMatchEff {
               histos.get<TH1>(HIST("MC/PID/phihist_tpc_piminus"))->Fill(track.phi());
               histos.get<TH1>(HIST("MC/PID/etahist_tpc_piminus"))->Fill(track.eta());
             }
-            if (trkWITS && isTrackSelectedITSCuts(track)) {
+            if (trkSelITS) {
               //
               // TPC clusters
               histos.get<TH1>(HIST("MC/TPCclust/tpcNClsFound_piMC_tpcits"))->Fill(clustpc);
@@ -3098,11 +3127,11 @@ struct qaMatchEff {
           //
           // only primary pions
           if (mcpart.isPhysicalPrimary()) {
-            if (trkWTPC && isTrackSelectedTPCCuts(track)) {
+            if (trkSelTPC) {
               histos.get<TH1>(HIST("MC/PID/pthist_tpc_pi_prim"))->Fill(trackPt);
               histos.get<TH1>(HIST("MC/PID/phihist_tpc_pi_prim"))->Fill(track.phi());
               histos.get<TH1>(HIST("MC/PID/etahist_tpc_pi_prim"))->Fill(track.eta());
-              if (trkWITS && isTrackSelectedITSCuts(track)) {
+              if (trkSelITS) {
                 histos.get<TH1>(HIST("MC/PID/pthist_tpcits_pi_prim"))->Fill(trackPt);
                 histos.get<TH1>(HIST("MC/PID/phihist_tpcits_pi_prim"))->Fill(track.phi());
                 histos.get<TH1>(HIST("MC/PID/etahist_tpcits_pi_prim"))->Fill(track.eta());
@@ -3112,11 +3141,11 @@ struct qaMatchEff {
           } else if (mcpart.getProcess() == 4) {
             //
             // only secondary pions from decay
-            if (trkWTPC && isTrackSelectedTPCCuts(track)) {
+            if (trkSelTPC) {
               histos.get<TH1>(HIST("MC/PID/pthist_tpc_pi_secd"))->Fill(trackPt);
               histos.get<TH1>(HIST("MC/PID/phihist_tpc_pi_secd"))->Fill(track.phi());
               histos.get<TH1>(HIST("MC/PID/etahist_tpc_pi_secd"))->Fill(track.eta());
-              if (trkWITS && isTrackSelectedITSCuts(track)) {
+              if (trkSelITS) {
                 histos.get<TH1>(HIST("MC/PID/pthist_tpcits_pi_secd"))->Fill(trackPt);
                 histos.get<TH1>(HIST("MC/PID/phihist_tpcits_pi_secd"))->Fill(track.phi());
                 histos.get<TH1>(HIST("MC/PID/etahist_tpcits_pi_secd"))->Fill(track.eta());
@@ -3126,11 +3155,11 @@ struct qaMatchEff {
           } else {
             //
             // only secondary pions from material
-            if (trkWTPC && isTrackSelectedTPCCuts(track)) {
+            if (trkSelTPC) {
               histos.get<TH1>(HIST("MC/PID/pthist_tpc_pi_secm"))->Fill(trackPt);
               histos.get<TH1>(HIST("MC/PID/phihist_tpc_pi_secm"))->Fill(track.phi());
               histos.get<TH1>(HIST("MC/PID/etahist_tpc_pi_secm"))->Fill(track.eta());
-              if (trkWITS && isTrackSelectedITSCuts(track)) {
+              if (trkSelITS) {
                 histos.get<TH1>(HIST("MC/PID/pthist_tpcits_pi_secm"))->Fill(trackPt);
                 histos.get<TH1>(HIST("MC/PID/phihist_tpcits_pi_secm"))->Fill(track.phi());
                 histos.get<TH1>(HIST("MC/PID/etahist_tpcits_pi_secm"))->Fill(track.eta());
@@ -3150,12 +3179,12 @@ struct qaMatchEff {
           else
             pdg_fill = -10.0;
           //
-          if (trkWTPC && isTrackSelectedTPCCuts(track)) {
+          if (trkSelTPC) {
             histos.get<TH1>(HIST("MC/PID/pthist_tpc_nopi"))->Fill(trackPt);
             histos.get<TH1>(HIST("MC/PID/phihist_tpc_nopi"))->Fill(track.phi());
             histos.get<TH1>(HIST("MC/PID/etahist_tpc_nopi"))->Fill(track.eta());
             histos.get<TH1>(HIST("MC/PID/pdghist_den"))->Fill(pdg_fill);
-            if (trkWITS && isTrackSelectedITSCuts(track)) {
+            if (trkSelITS) {
               histos.get<TH1>(HIST("MC/PID/pthist_tpcits_nopi"))->Fill(trackPt);
               histos.get<TH1>(HIST("MC/PID/phihist_tpcits_nopi"))->Fill(track.phi());
               histos.get<TH1>(HIST("MC/PID/etahist_tpcits_nopi"))->Fill(track.eta());
@@ -3166,7 +3195,7 @@ struct qaMatchEff {
         //
         // kaons only
         if (tpPDGCode == 321) {
-          if (trkWTPC && isTrackSelectedTPCCuts(track)) {
+          if (trkSelTPC) {
             //
             // TPC clusters
             histos.get<TH1>(HIST("MC/TPCclust/tpcNClsFound_kaMC_tpc"))->Fill(clustpc);
@@ -3197,7 +3226,7 @@ struct qaMatchEff {
               histos.get<TH1>(HIST("MC/PID/phihist_tpc_kaminus"))->Fill(track.phi());
               histos.get<TH1>(HIST("MC/PID/etahist_tpc_kaminus"))->Fill(track.eta());
             }
-            if (trkWITS && isTrackSelectedITSCuts(track)) {
+            if (trkSelITS) {
               //
               // TPC clusters
               histos.get<TH1>(HIST("MC/TPCclust/tpcNClsFound_kaMC_tpcits"))->Fill(clustpc);
@@ -3234,11 +3263,11 @@ struct qaMatchEff {
         //
         // pions and kaons together
         if (tpPDGCode == 211 || tpPDGCode == 321) {
-          if (trkWTPC && isTrackSelectedTPCCuts(track)) {
+          if (trkSelTPC) {
             histos.get<TH1>(HIST("MC/PID/pthist_tpc_piK"))->Fill(trackPt);
             histos.get<TH1>(HIST("MC/PID/phihist_tpc_piK"))->Fill(track.phi());
             histos.get<TH1>(HIST("MC/PID/etahist_tpc_piK"))->Fill(track.eta());
-            if (trkWITS && isTrackSelectedITSCuts(track)) {
+            if (trkSelITS) {
               histos.get<TH1>(HIST("MC/PID/pthist_tpcits_piK"))->Fill(trackPt);
               histos.get<TH1>(HIST("MC/PID/phihist_tpcits_piK"))->Fill(track.phi());
               histos.get<TH1>(HIST("MC/PID/etahist_tpcits_piK"))->Fill(track.eta());
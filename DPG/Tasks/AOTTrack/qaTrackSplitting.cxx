@@ -17,10 +17,13 @@
 
 #include "TrackSelection.h"
 
+#include "Common/Core/CloseTrackFinder.h"
+#include "Common/Core/RecoDecay.h"
 #include "Common/Core/TrackSelectionDefaults.h"
 #include "Common/DataModel/EventSelection.h"
 #include "Common/DataModel/TrackSelectionTables.h"
 
+#include <CommonConstants/MathConstants.h>
 #include <Framework/ASoA.h>
 #include <Framework/AnalysisDataModel.h>
 #include <Framework/AnalysisTask.h>
@@ -67,9 +70,13 @@ struct qaTrackSplitting {
 
   } cfgCustomTrackCuts;
 
+  Configurable<float> closePairMaxDeltaEta{"closePairMaxDeltaEta", 0.05f, "Maximum |#Delta #eta| of the close track pairs"};
+  Configurable<float> closePairMaxDeltaPhi{"closePairMaxDeltaPhi", 0.05f, "Maximum |#Delta #varphi| of the close track pairs"};
+
   // Histograms
   HistogramRegistry histos{"Histos", {}, OutputObjHandlingPolicy::AnalysisObject};
   TrackSelection customTrackCuts;
+  o2::common::core::CloseTrackFinder closeTrackFinder;
 
   void init(InitContext&)
   {
@@ -78,6 +85,8 @@ struct qaTrackSplitting {
     histos.add("map", "map", kTH3D, {{100, -1, 1, "#Delta #eta"}, {100, -1, 1, "#Delta #varphi"}, {100, -1, 1, "#Delta #it{p}_{T}"}});
     histos.add("deltaPt", "deltaPt", kTH2D, {{100, 0, 5, "#it{p}_{T}"}, {100, -1, 1, "#Delta #it{p}_{T}"}});
     histos.add("mapMC", "mapMC", kTH3D, {{100, -1, 1, "#Delta #eta"}, {100, -1, 1, "#Delta #varphi"}, {100, -1, 1, "#Delta #it{p}_{T}"}});
+    histos.add("mapClosePairs", "mapClosePairs", kTH3D, {{100, -closePairMaxDeltaEta, closePairMaxDeltaEta, "#Delta #eta"}, {100, -closePairMaxDeltaPhi, closePairMaxDeltaPhi, "#Delta #varphi"}, {100, -1, 1, "#Delta #it{p}_{T}"}});
+    closeTrackFinder.setWindow(closePairMaxDeltaEta, closePairMaxDeltaPhi);
 
     customTrackCuts = getGlobalTrackSelectionRun3ITSMatch(cfgCustomTrackCuts.itsPattern);
     LOG(info) << "Customizing track cuts:";
@@ -106,6 +115,15 @@ struct qaTrackSplitting {
   void processData(CollisionCandidates const& collisions,
                    soa::Filtered<TrackCandidates> const& filteredTracks)
   {
+    // candidates of split tracks: pairs of tracks close in (eta, phi), searched in the neighbouring cells only
+    closeTrackFinder.fill(filteredTracks);
+    for (const auto& pair : closeTrackFinder.findPairs()) {
+      const float deltaPhi = RecoDecay::constrainAngle(closeTrackFinder.phi(pair.second) - closeTrackFinder.phi(pair.first), -o2::constants::math::PI);
+      histos.fill(HIST("mapClosePairs"),
+                  closeTrackFinder.eta(pair.second) - closeTrackFinder.eta(pair.first),
+                  deltaPhi,
+                  closeTrackFinder.pt(pair.second) - closeTrackFinder.pt(pair.first));
+    }
     for (const auto& coll1 : collisions) {
       for (const auto& coll2 : collisions) {
         if (coll1.globalIndex() == coll2.globalIndex()) {
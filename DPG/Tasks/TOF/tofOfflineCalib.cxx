@@ -26,6 +26,7 @@
 #include "Common/DataModel/TrackSelectionTables.h"
 #include "Common/TableProducer/PID/pidTOFBase.h"
 
+#include <CommonConstants/MathConstants.h>
 #include <Framework/ASoA.h>
 #include <Framework/AnalysisDataModel.h>
 #include <Framework/AnalysisHelpers.h>
@@ -42,6 +43,7 @@
 
 #include <TH1.h>
 #include <TH2.h>
+#include <TH3.h>
 #include <TString.h>
 
 #include <chrono>
@@ -79,6 +81,8 @@ struct tofOfflineCalib {
   Configurable<float> pRefMax{"pRefMax", 0.7, "Reference momentum maximum"};
   Configurable<float> maxTOFChi2{"maxTOFChi2", 5.f, "Maximum TOF Chi2 to accept tracks"};
   Configurable<float> deltatTh{"deltatTh", 500, "Threshold in DeltaT to accept reference tracks"};
+  Configurable<bool> fillCellResiduals{"fillCellResiduals", false, "Accumulate per run the low chi2 residuals per TOF sector and eta cell, instead of relying on the per couple table"};
+  Configurable<int> nEtaCells{"nEtaCells", 91, "Number of eta cells per TOF sector for the accumulated residuals (91 strips per sector)"};
 
   std::shared_ptr<TH2> deltaVsP;
   std::shared_ptr<TH2> deltaVsPHighChi2;
@@ -86,6 +90,7 @@ struct tofOfflineCalib {
   std::shared_ptr<TH1> hBad;
   std::shared_ptr<TH1> hGoodRefWithTRD;
   std::shared_ptr<TH1> hBadRefWithTRD;
+  std::shared_ptr<TH3> deltaVsCell;
 
   unsigned int randomSeed = 0;
   void init(o2::framework::InitContext&)
@@ -172,6 +177,13 @@ struct tofOfflineCalib {
       hBadRefWithTRD = histos.add<TH1>(Form("Run%i/hBadRefWithTRD", lastRun), "Bad", kTH1D, {doubleDeltaAxis});
       deltaVsP = histos.add<TH2>(Form("Run%i/deltaVsP", lastRun), "Low Chi2", kTH2F, {pTAxis, doubleDeltaAxis});
       deltaVsPHighChi2 = histos.add<TH2>(Form("Run%i/deltaVsPHighChi2", lastRun), "High Chi2", kTH2F, {pTAxis, doubleDeltaAxis});
+      if (fillCellResiduals) {
+        // the cells are defined from the track direction at the vertex, the TOF channel is not available in the AO2Ds
+        const AxisSpec sectorAxis{18, 0, o2::constants::math::TwoPI, "#varphi (sectors)"};
+        const AxisSpec etaCellAxis{nEtaCells, -0.9, 0.9, "#eta"};
+        const AxisSpec cellDeltaAxis{300, -3000, 3000, "#Deltat_{#pi} - #Deltat_{#pi}^{ref} (ps)"};
+        deltaVsCell = histos.add<TH3>(Form("Run%i/deltaVsCell", lastRun), "Low Chi2 per cell", kTH3F, {sectorAxis, etaCellAxis, cellDeltaAxis});
+      }
     }
 
     int8_t lastTRDLayer = -1;
@@ -200,6 +212,9 @@ struct tofOfflineCalib {
         const float& delta2Pi = track2.tofSignal() - texp2Pi;
         if (track2.tofChi2() < maxTOFChi2) {
           deltaVsP->Fill(track2.p(), delta2Pi - delta1Pi);
+          if (fillCellResiduals) {
+            deltaVsCell->Fill(track2.phi(), track2.eta(), delta2Pi - delta1Pi);
+          }
         } else if (track2.tofChi2() > maxTOFChi2) {
           deltaVsPHighChi2->Fill(track2.p(), delta2Pi - delta1Pi);
         }
@@ -197,18 +197,20 @@ struct TreeWriterTpcV0 {
     }
   }
 
-  template <bool IsCorrectedDeDx, typename V0Casc, typename T>
-  V0Daughter createV0Daughter(const V0Casc& v0Casc, const T& track, const int motherId, const int daughterId, const bool isPositive = true)
+  /// Selection and downsampling parameters of the daughter; the TPC and ITS PID variables of the track are only
+  /// evaluated with setV0DaughterPid for the daughters which are kept
+  template <typename V0Casc>
+  V0Daughter createV0Daughter(const V0Casc& v0Casc, const int motherId, const int daughterId, const bool isPositive = true)
   {
     switch (daughterId) {
       case DaughterElectron:
-        return V0Daughter{downsamplingTsalisElectrons, MassElectron, maxPt4dwnsmplTsalisElectrons, track.tpcNSigmaEl(), getStrangenessTofNSigma(v0Casc, motherId, daughterId, isPositive), track.itsNSigmaEl(), track.tpcExpSignalEl(tpcSignalGeneric<IsCorrectedDeDx>(track)), PidElectron, dwnSmplFactorEl, NSigmaTofElectorn + 1.f, false};
+        return V0Daughter{downsamplingTsalisElectrons, MassElectron, maxPt4dwnsmplTsalisElectrons, UndefValueDouble, getStrangenessTofNSigma(v0Casc, motherId, daughterId, isPositive), UndefValueDouble, UndefValueDouble, PidElectron, dwnSmplFactorEl, NSigmaTofElectorn + 1.f, false};
       case DaughterPion:
-        return V0Daughter{downsamplingTsalisPions, MassPiPlus, maxPt4dwnsmplTsalisPions, track.tpcNSigmaPi(), getStrangenessTofNSigma(v0Casc, motherId, daughterId, isPositive), track.itsNSigmaPi(), track.tpcExpSignalPi(tpcSignalGeneric<IsCorrectedDeDx>(track)), PidPion, dwnSmplFactorPi, nSigmaTofDauTrackPi, rejectNoTofDauTrackPi};
+        return V0Daughter{downsamplingTsalisPions, MassPiPlus, maxPt4dwnsmplTsalisPions, UndefValueDouble, getStrangenessTofNSigma(v0Casc, motherId, daughterId, isPositive), UndefValueDouble, UndefValueDouble, PidPion, dwnSmplFactorPi, nSigmaTofDauTrackPi, rejectNoTofDauTrackPi};
       case DaughterProton:
-        return V0Daughter{downsamplingTsalisProtons, MassProton, maxPt4dwnsmplTsalisProtons, track.tpcNSigmaPr(), getStrangenessTofNSigma(v0Casc, motherId, daughterId, isPositive), track.itsNSigmaPr(), track.tpcExpSignalPr(tpcSignalGeneric<IsCorrectedDeDx>(track)), PidProton, dwnSmplFactorPr, nSigmaTofDauTrackPr, rejectNoTofDauTrackPr};
+        return V0Daughter{downsamplingTsalisProtons, MassProton, maxPt4dwnsmplTsalisProtons, UndefValueDouble, getStrangenessTofNSigma(v0Casc, motherId, daughterId, isPositive), UndefValueDouble, UndefValueDouble, PidProton, dwnSmplFactorPr, nSigmaTofDauTrackPr, rejectNoTofDauTrackPr};
       case DaughterKaon:
-        return V0Daughter{downsamplingTsalisKaons, MassKPlus, maxPt4dwnsmplTsalisKaons, track.tpcNSigmaKa(), getStrangenessTofNSigma(v0Casc, motherId, daughterId, isPositive), track.itsNSigmaKa(), track.tpcExpSignalKa(tpcSignalGeneric<IsCorrectedDeDx>(track)), PidKaon, dwnSmplFactorKa, nSigmaTofDauTrackKa, rejectNoTofDauTrackKa};
+        return V0Daughter{downsamplingTsalisKaons, MassKPlus, maxPt4dwnsmplTsalisKaons, UndefValueDouble, getStrangenessTofNSigma(v0Casc, motherId, daughterId, isPositive), UndefValueDouble, UndefValueDouble, PidKaon, dwnSmplFactorKa, nSigmaTofDauTrackKa, rejectNoTofDauTrackKa};
       default: {
         LOGP(fatal, "createV0Daughter: unknown daughterId");
         return V0Daughter();
@@ -216,6 +218,35 @@ struct TreeWriterTpcV0 {
     }
   }
 
+  template <bool IsCorrectedDeDx, typename T>
+  void setV0DaughterPid(V0Daughter& daughter, const T& track, const int daughterId)
+  {
+    switch (daughterId) {
+      case DaughterElectron:
+        daughter.tpcNSigma = track.tpcNSigmaEl();
+        daughter.itsNSigma = track.itsNSigmaEl();
+        daughter.tpcExpSignal = track.tpcExpSignalEl(tpcSignalGeneric<IsCorrectedDeDx>(track));
+        break;
+      case DaughterPion:
+        daughter.tpcNSigma = track.tpcNSigmaPi();
+        daughter.itsNSigma = track.itsNSigmaPi();
+        daughter.tpcExpSignal = track.tpcExpSignalPi(tpcSignalGeneric<IsCorrectedDeDx>(track));
+        break;
+      case DaughterProton:
+        daughter.tpcNSigma = track.tpcNSigmaPr();
+        daughter.itsNSigma = track.itsNSigmaPr();
+        daughter.tpcExpSignal = track.tpcExpSignalPr(tpcSignalGeneric<IsCorrectedDeDx>(track));
+        break;
+      case DaughterKaon:
+        daughter.tpcNSigma = track.tpcNSigmaKa();
+        daughter.itsNSigma = track.itsNSigmaKa();
+        daughter.tpcExpSignal = track.tpcExpSignalKa(tpcSignalGeneric<IsCorrectedDeDx>(track));
+        break;
+      default:
+        LOGP(fatal, "setV0DaughterPid: unknown daughterId");
+    }
+  }
+
   V0Mother createV0Mother(const int motherId)
   {
     switch (motherId) {
@@ -273,7 +304,7 @@ struct TreeWriterTpcV0 {
   }
 
   template <bool DoUseCorrectedDeDx, int ModeId, typename T, typename C, typename V0Casc>
-  void fillSkimmedV0Table(V0Casc const& v0casc, T const& track, aod::TracksQA const& trackQA, const bool existTrkQA, C const& collision, const float nSigmaTPC, const float nSigmaTOF, const float nSigmaITS, const float dEdxExp, const o2::track::PID::ID id, const int runnumber, const double dwnSmplFactor, const float hadronicRate, const int bcGlobalIndex, const int bcTimeFrameId, const int bcBcInTimeFrame, const OccupancyValues& occValues, const bool isGoodRctEvent)
+  void fillSkimmedV0Table(V0Casc const& v0casc, T const& track, aod::TracksQA const& trackQA, const bool existTrkQA, C const& collision, const float nSigmaTPC, const float nSigmaTOF, const float nSigmaITS, const float dEdxExp, const o2::track::PID::ID id, const int runnumber, const float hadronicRate, const int bcGlobalIndex, const int bcTimeFrameId, const int bcBcInTimeFrame, const OccupancyValues& occValues, const bool isGoodRctEvent)
   {
     const double ncl = track.tpcNClsFound();
     const double nclPID = track.tpcNClsPID();
@@ -292,98 +323,95 @@ struct TreeWriterTpcV0 {
     const float v0radius = getRadius(v0casc);
     const float gammapsipair = v0casc.psipair();
 
-    const double pseudoRndm = track.pt() * 1000. - static_cast<int64_t>(track.pt() * 1000);
-    if (pseudoRndm < dwnSmplFactor) {
-      const float usedDedx = tpcSignalGeneric<DoUseCorrectedDeDx>(track);
-      float tpcdEdxNorm{UndefValueFloat};
-      if constexpr (ModeId != ModeStandard) {
-        tpcdEdxNorm = existTrkQA ? trackQA.tpcdEdxNorm() : UndefValueFloat;
-      }
-      if constexpr (ModeId == ModeStandard || ModeId == ModeWithdEdxTrkQA) {
-        rowTPCTree(isGoodRctEvent,
-                   usedDedx,
-                   1. / dEdxExp,
-                   track.tpcInnerParam(),
-                   track.tgl(),
-                   track.signed1Pt(),
-                   track.eta(),
-                   track.phi(),
-                   track.y(),
-                   mass,
-                   bg,
-                   multTPC / MultiplicityNorm,
-                   std::sqrt(nClNorm / ncl),
-                   nclPID,
-                   id,
-                   nSigmaTPC,
-                   nSigmaTOF,
-                   nSigmaITS,
-                   runnumber,
-                   trackOcc,
-                   ft0Occ,
-                   occMedianTime,
-                   hadronicRate,
-                   tpcdEdxNorm,
-                   alpha,
-                   qt,
-                   cosPA,
-                   pT,
-                   v0radius,
-                   gammapsipair);
-      } else {
-        rowTPCTreeWithTrkQA(isGoodRctEvent,
-                            usedDedx,
-                            1. / dEdxExp,
-                            track.tpcInnerParam(),
-                            track.tgl(),
-                            track.signed1Pt(),
-                            track.eta(),
-                            track.phi(),
-                            track.y(),
-                            mass,
-                            bg,
-                            multTPC / MultiplicityNorm,
-                            std::sqrt(nClNorm / ncl),
-                            nclPID,
-                            id,
-                            nSigmaTPC,
-                            nSigmaTOF,
-                            nSigmaITS,
-                            runnumber,
-                            trackOcc,
-                            ft0Occ,
-                            occMedianTime,
-                            hadronicRate,
-                            tpcdEdxNorm,
-                            alpha,
-                            qt,
-                            cosPA,
-                            pT,
-                            v0radius,
-                            gammapsipair,
-                            bcGlobalIndex,
-                            bcTimeFrameId,
-                            bcBcInTimeFrame,
-                            existTrkQA ? trackQA.tpcClusterByteMask() : UndefValueInt,
-                            existTrkQA ? trackQA.tpcdEdxMax0R() : UndefValueInt,
-                            existTrkQA ? trackQA.tpcdEdxMax1R() : UndefValueInt,
-                            existTrkQA ? trackQA.tpcdEdxMax2R() : UndefValueInt,
-                            existTrkQA ? trackQA.tpcdEdxMax3R() : UndefValueInt,
-                            existTrkQA ? trackQA.tpcdEdxTot0R() : UndefValueInt,
-                            existTrkQA ? trackQA.tpcdEdxTot1R() : UndefValueInt,
-                            existTrkQA ? trackQA.tpcdEdxTot2R() : UndefValueInt,
-                            existTrkQA ? trackQA.tpcdEdxTot3R() : UndefValueInt,
-                            occValues.tmoPrimUnfm80,
-                            occValues.tmoFV0AUnfm80,
-                            occValues.tmoFT0AUnfm80,
-                            occValues.tmoFT0CUnfm80,
-                            occValues.tmoRT0V0PrimUnfm80,
-                            occValues.twmoPrimUnfm80,
-                            occValues.twmoFV0AUnfm80,
-                            occValues.twmoFT0AUnfm80,
-                            occValues.twmoFT0CUnfm80,
-                            occValues.twmoRT0V0PrimUnfm80);
-      }
+    const float usedDedx = tpcSignalGeneric<DoUseCorrectedDeDx>(track);
+    float tpcdEdxNorm{UndefValueFloat};
+    if constexpr (ModeId != ModeStandard) {
+      tpcdEdxNorm = existTrkQA ? trackQA.tpcdEdxNorm() : UndefValueFloat;
+    }
+    if constexpr (ModeId == ModeStandard || ModeId == ModeWithdEdxTrkQA) {
+      rowTPCTree(isGoodRctEvent,
+                 usedDedx,
+                 1. / dEdxExp,
+                 track.tpcInnerParam(),
+                 track.tgl(),
+                 track.signed1Pt(),
+                 track.eta(),
+                 track.phi(),
+                 track.y(),
+                 mass,
+                 bg,
+                 multTPC / MultiplicityNorm,
+                 std::sqrt(nClNorm / ncl),
+                 nclPID,
+                 id,
+                 nSigmaTPC,
+                 nSigmaTOF,
+                 nSigmaITS,
+                 runnumber,
+                 trackOcc,
+                 ft0Occ,
+                 occMedianTime,
+                 hadronicRate,
+                 tpcdEdxNorm,
+                 alpha,
+                 qt,
+                 cosPA,
+                 pT,
+                 v0radius,
+                 gammapsipair);
+    } else {
+      rowTPCTreeWithTrkQA(isGoodRctEvent,
+                          usedDedx,
+                          1. / dEdxExp,
+                          track.tpcInnerParam(),
+                          track.tgl(),
+                          track.signed1Pt(),
+                          track.eta(),
+                          track.phi(),
+                          track.y(),
+                          mass,
+                          bg,
+                          multTPC / MultiplicityNorm,
+                          std::sqrt(nClNorm / ncl),
+                          nclPID,
+                          id,
+                          nSigmaTPC,
+                          nSigmaTOF,
+                          nSigmaITS,
+                          runnumber,
+                          trackOcc,
+                          ft0Occ,
+                          occMedianTime,
+                          hadronicRate,
+                          tpcdEdxNorm,
+                          alpha,
+                          qt,
+                          cosPA,
+                          pT,
+                          v0radius,
+                          gammapsipair,
+                          bcGlobalIndex,
+                          bcTimeFrameId,
+                          bcBcInTimeFrame,
+                          existTrkQA ? trackQA.tpcClusterByteMask() : UndefValueInt,
+                          existTrkQA ? trackQA.tpcdEdxMax0R() : UndefValueInt,
+                          existTrkQA ? trackQA.tpcdEdxMax1R() : UndefValueInt,
+                          existTrkQA ? trackQA.tpcdEdxMax2R() : UndefValueInt,
+                          existTrkQA ? trackQA.tpcdEdxMax3R() : UndefValueInt,
+                          existTrkQA ? trackQA.tpcdEdxTot0R() : UndefValueInt,
+                          existTrkQA ? trackQA.tpcdEdxTot1R() : UndefValueInt,
+                          existTrkQA ? trackQA.tpcdEdxTot2R() : UndefValueInt,
+                          existTrkQA ? trackQA.tpcdEdxTot3R() : UndefValueInt,
+                          occValues.tmoPrimUnfm80,
+                          occValues.tmoFV0AUnfm80,
+                          occValues.tmoFT0AUnfm80,
+                          occValues.tmoFT0CUnfm80,
+                          occValues.tmoRT0V0PrimUnfm80,
+                          occValues.twmoPrimUnfm80,
+                          occValues.twmoFV0AUnfm80,
+                          occValues.twmoFT0AUnfm80,
+                          occValues.twmoFT0CUnfm80,
+                          occValues.twmoRT0V0PrimUnfm80);
     }
   } /// fillSkimmedV0Table
 
@@ -491,24 +519,24 @@ struct TreeWriterTpcV0 {
       };
 
       auto fillDaughterTrack = [&](const auto& mother, const TrksType::iterator& dauTrack, const auto& v0, const bool isPositive) {
-        const auto [trackQAInstance, existTrkQA] = getTrackQA(dauTrack);
-        const auto trackId = dauTrack.globalIndex();
-        const auto dauTrackWithITSPid = tracksWithITSPid.rawIteratorAt(trackId);
         const auto v0Id = getAddId(v0);
         const V0Mother v0Mother = createV0Mother(v0Id);
         const auto daughterId = isPositive ? v0Mother.posDaughterId : v0Mother.negDaughterId;
-        const V0Daughter daughter = createV0Daughter<IsCorrectedDeDx>(v0, dauTrackWithITSPid, v0Id, daughterId, isPositive);
+        V0Daughter daughter = createV0Daughter(v0, v0Id, daughterId, isPositive);
 
-        const bool passTrackSelection = isTrackSelected(dauTrack, trackSelection);
-        const bool passDownsamplig = downsampleTsalisCharged(fRndm, dauTrack.pt(), daughter.downsamplingTsalis, daughter.mass, sqrtSNN, daughter.maxPt4dwnsmplTsalis);
+        // the cheap selections and the downsampling come first, the track variables are evaluated only for the kept daughters
         const bool passNSigmaTofCut = std::fabs(daughter.tofNSigma) < daughter.nSigmaTofDauTrack || std::fabs(daughter.tofNSigma - NSigmaTofUnmatched) < nSigmaTofUnmatchedEqualityTolerance;
         const bool passMatchTofRequirement = !daughter.rejectNoTofDauTrack || std::fabs(daughter.tofNSigma - NSigmaTofUnmatched) > nSigmaTofUnmatchedEqualityTolerance;
-        if (passTrackSelection && passDownsamplig && passNSigmaTofCut && passMatchTofRequirement) {
+        if (passDwnSmplFactor(dauTrack.pt(), daughter.dwnSmplFactor) && passNSigmaTofCut && passMatchTofRequirement && isTrackSelected(dauTrack, trackSelection) &&
+            downsampleTsalisCharged(fRndm, dauTrack.pt(), daughter.downsamplingTsalis, daughter.mass, sqrtSNN, daughter.maxPt4dwnsmplTsalis)) {
+          const auto [trackQAInstance, existTrkQA] = getTrackQA(dauTrack);
+          const auto dauTrackWithITSPid = tracksWithITSPid.rawIteratorAt(dauTrack.globalIndex());
+          setV0DaughterPid<IsCorrectedDeDx>(daughter, dauTrackWithITSPid, daughterId);
           OccupancyValues occValues{};
           if constexpr (ModeId == ModeWithTrkQA) {
             evaluateOccupancyVariables(dauTrack, occValues);
           }
-          fillSkimmedV0Table<IsCorrectedDeDx, ModeId>(mother, dauTrack, trackQAInstance, existTrkQA, collision, daughter.tpcNSigma, daughter.tofNSigma, daughter.itsNSigma, daughter.tpcExpSignal, daughter.id, runnumber, daughter.dwnSmplFactor, hadronicRate, bcGlobalIndex, bcTimeFrameId, bcBcInTimeFrame, occValues, isGoodRctEvent);
+          fillSkimmedV0Table<IsCorrectedDeDx, ModeId>(mother, dauTrack, trackQAInstance, existTrkQA, collision, daughter.tpcNSigma, daughter.tofNSigma, daughter.itsNSigma, daughter.tpcExpSignal, daughter.id, runnumber, hadronicRate, bcGlobalIndex, bcTimeFrameId, bcBcInTimeFrame, occValues, isGoodRctEvent);
           return true;
         }
         return false;
@@ -708,6 +736,36 @@ struct TreeWriterTpcTof {
     double nSigmaTpcTpctof;
   };
 
+  /// ITS PID and expected TPC signal of the species, evaluated only for the kept species
+  template <bool IsCorrectedDeDx, typename T>
+  void setTofTrackPid(TofTrack& tofTrack, const T& track)
+  {
+    switch (tofTrack.pid) {
+      case PidTriton:
+        tofTrack.itsNSigma = track.itsNSigmaTr();
+        tofTrack.tpcExpSignal = track.tpcExpSignalTr(tpcSignalGeneric<IsCorrectedDeDx>(track));
+        break;
+      case PidDeuteron:
+        tofTrack.itsNSigma = track.itsNSigmaDe();
+        tofTrack.tpcExpSignal = track.tpcExpSignalDe(tpcSignalGeneric<IsCorrectedDeDx>(track));
+        break;
+      case PidProton:
+        tofTrack.itsNSigma = track.itsNSigmaPr();
+        tofTrack.tpcExpSignal = track.tpcExpSignalPr(tpcSignalGeneric<IsCorrectedDeDx>(track));
+        break;
+      case PidKaon:
+        tofTrack.itsNSigma = track.itsNSigmaKa();
+        tofTrack.tpcExpSignal = track.tpcExpSignalKa(tpcSignalGeneric<IsCorrectedDeDx>(track));
+        break;
+      case PidPion:
+        tofTrack.itsNSigma = track.itsNSigmaPi();
+        tofTrack.tpcExpSignal = track.tpcExpSignalPi(tpcSignalGeneric<IsCorrectedDeDx>(track));
+        break;
+      default:
+        LOGP(fatal, "setTofTrackPid: unknown species");
+    }
+  }
+
   Service<o2::ccdb::BasicCCDBManager> ccdb{};
 
   ctpRateFetcher mRateFetcher{};
@@ -752,7 +810,7 @@ struct TreeWriterTpcTof {
   }
 
   template <bool DoCorrectDeDx, int ModeId, typename T, typename C>
-  void fillSkimmedTpcTofTable(T const& track, aod::TracksQA const& trackQA, const bool existTrkQA, C const& collision, const float nSigmaTPC, const float nSigmaTOF, const float nSigmaITS, const float dEdxExp, const o2::track::PID::ID id, const int runnumber, const double dwnSmplFactor, const double hadronicRate, const int bcGlobalIndex, const int bcTimeFrameId, const int bcBcInTimeFrame, const OccupancyValues& occValues, const bool isGoodRctEvent)
+  void fillSkimmedTpcTofTable(T const& track, aod::TracksQA const& trackQA, const bool existTrkQA, C const& collision, const float nSigmaTPC, const float nSigmaTOF, const float nSigmaITS, const float dEdxExp, const o2::track::PID::ID id, const int runnumber, const double hadronicRate, const int bcGlobalIndex, const int bcTimeFrameId, const int bcBcInTimeFrame, const OccupancyValues& occValues, const bool isGoodRctEvent)
   {
     const double ncl = track.tpcNClsFound();
     const double nclPID = track.tpcNClsPID();
@@ -764,86 +822,83 @@ struct TreeWriterTpcTof {
     const auto ft0Occ = collision.ft0cOccupancyInTimeRange();
     const auto occMedianTime = collision.occupancyMedianTime();
 
-    const double pseudoRndm = track.pt() * 1000. - static_cast<int64_t>(track.pt() * 1000);
-    if (pseudoRndm < dwnSmplFactor) {
-      const float usedEdx = tpcSignalGeneric<DoCorrectDeDx>(track);
-      float tpcdEdxNorm{UndefValueFloat};
-      if constexpr (ModeId != ModeStandard) {
-        tpcdEdxNorm = existTrkQA ? trackQA.tpcdEdxNorm() : UndefValueFloat;
-      }
-      if (ModeId == ModeStandard || ModeId == ModeWithdEdxTrkQA) {
-        rowTPCTOFTree(isGoodRctEvent,
-                      usedEdx,
-                      1. / dEdxExp,
-                      track.tpcInnerParam(),
-                      track.tgl(),
-                      track.signed1Pt(),
-                      track.eta(),
-                      track.phi(),
-                      track.y(),
-                      mass,
-                      bg,
-                      multTPC / MultiplicityNorm,
-                      std::sqrt(nClNorm / ncl),
-                      nclPID,
-                      id,
-                      nSigmaTPC,
-                      nSigmaTOF,
-                      nSigmaITS,
-                      runnumber,
-                      trackOcc,
-                      ft0Occ,
-                      occMedianTime,
-                      hadronicRate,
-                      tpcdEdxNorm);
-      } else {
-        rowTPCTOFTreeWithTrkQA(isGoodRctEvent,
-                               usedEdx,
-                               1. / dEdxExp,
-                               track.tpcInnerParam(),
-                               track.tgl(),
-                               track.signed1Pt(),
-                               track.eta(),
-                               track.phi(),
-                               track.y(),
-                               mass,
-                               bg,
-                               multTPC / MultiplicityNorm,
-                               std::sqrt(nClNorm / ncl),
-                               nclPID,
-                               id,
-                               nSigmaTPC,
-                               nSigmaTOF,
-                               nSigmaITS,
-                               runnumber,
-                               trackOcc,
-                               ft0Occ,
-                               occMedianTime,
-                               hadronicRate,
-                               tpcdEdxNorm,
-                               bcGlobalIndex,
-                               bcTimeFrameId,
-                               bcBcInTimeFrame,
-                               existTrkQA ? trackQA.tpcClusterByteMask() : UndefValueInt,
-                               existTrkQA ? trackQA.tpcdEdxMax0R() : UndefValueInt,
-                               existTrkQA ? trackQA.tpcdEdxMax1R() : UndefValueInt,
-                               existTrkQA ? trackQA.tpcdEdxMax2R() : UndefValueInt,
-                               existTrkQA ? trackQA.tpcdEdxMax3R() : UndefValueInt,
-                               existTrkQA ? trackQA.tpcdEdxTot0R() : UndefValueInt,
-                               existTrkQA ? trackQA.tpcdEdxTot1R() : UndefValueInt,
-                               existTrkQA ? trackQA.tpcdEdxTot2R() : UndefValueInt,
-                               existTrkQA ? trackQA.tpcdEdxTot3R() : UndefValueInt,
-                               occValues.tmoPrimUnfm80,
-                               occValues.tmoFV0AUnfm80,
-                               occValues.tmoFT0AUnfm80,
-                               occValues.tmoFT0CUnfm80,
-                               occValues.tmoRT0V0PrimUnfm80,
-                               occValues.twmoPrimUnfm80,
-                               occValues.twmoFV0AUnfm80,
-                               occValues.twmoFT0AUnfm80,
-                               occValues.twmoFT0CUnfm80,
-                               occValues.twmoRT0V0PrimUnfm80);
-      }
+    const float usedEdx = tpcSignalGeneric<DoCorrectDeDx>(track);
+    float tpcdEdxNorm{UndefValueFloat};
+    if constexpr (ModeId != ModeStandard) {
+      tpcdEdxNorm = existTrkQA ? trackQA.tpcdEdxNorm() : UndefValueFloat;
+    }
+    if (ModeId == ModeStandard || ModeId == ModeWithdEdxTrkQA) {
+      rowTPCTOFTree(isGoodRctEvent,
+                    usedEdx,
+                    1. / dEdxExp,
+                    track.tpcInnerParam(),
+                    track.tgl(),
+                    track.signed1Pt(),
+                    track.eta(),
+                    track.phi(),
+                    track.y(),
+                    mass,
+                    bg,
+                    multTPC / MultiplicityNorm,
+                    std::sqrt(nClNorm / ncl),
+                    nclPID,
+                    id,
+                    nSigmaTPC,
+                    nSigmaTOF,
+                    nSigmaITS,
+                    runnumber,
+                    trackOcc,
+                    ft0Occ,
+                    occMedianTime,
+                    hadronicRate,
+                    tpcdEdxNorm);
+    } else {
+      rowTPCTOFTreeWithTrkQA(isGoodRctEvent,
+                             usedEdx,
+                             1. / dEdxExp,
+                             track.tpcInnerParam(),
+                             track.tgl(),
+                             track.signed1Pt(),
+                             track.eta(),
+                             track.phi(),
+                             track.y(),
+                             mass,
+                             bg,
+                             multTPC / MultiplicityNorm,
+                             std::sqrt(nClNorm / ncl),
+                             nclPID,
+                             id,
+                             nSigmaTPC,
+                             nSigmaTOF,
+                             nSigmaITS,
+                             runnumber,
+                             trackOcc,
+                             ft0Occ,
+                             occMedianTime,
+                             hadronicRate,
+                             tpcdEdxNorm,
+                             bcGlobalIndex,
+                             bcTimeFrameId,
+                             bcBcInTimeFrame,
+                             existTrkQA ? trackQA.tpcClusterByteMask() : UndefValueInt,
+                             existTrkQA ? trackQA.tpcdEdxMax0R() : UndefValueInt,
+                             existTrkQA ? trackQA.tpcdEdxMax1R() : UndefValueInt,
+                             existTrkQA ? trackQA.tpcdEdxMax2R() : UndefValueInt,
+                             existTrkQA ? trackQA.tpcdEdxMax3R() : UndefValueInt,
+                             existTrkQA ? trackQA.tpcdEdxTot0R() : UndefValueInt,
+                             existTrkQA ? trackQA.tpcdEdxTot1R() : UndefValueInt,
+                             existTrkQA ? trackQA.tpcdEdxTot2R() : UndefValueInt,
+                             existTrkQA ? trackQA.tpcdEdxTot3R() : UndefValueInt,
+                             occValues.tmoPrimUnfm80,
+                             occValues.tmoFV0AUnfm80,
+                             occValues.tmoFT0AUnfm80,
+                             occValues.tmoFT0CUnfm80,
+                             occValues.tmoRT0V0PrimUnfm80,
+                             occValues.twmoPrimUnfm80,
+                             occValues.twmoFV0AUnfm80,
+                             occValues.twmoFT0AUnfm80,
+                             occValues.twmoFT0CUnfm80,
+                             occValues.twmoRT0V0PrimUnfm80);
     }
   } /// fillSkimmedTpcTofTable
 
@@ -919,29 +974,36 @@ struct TreeWriterTpcTof {
           trackQA = tracksQA.iteratorAt(trkIndex);
         }
 
-        TofTrack tofTriton(true, maxMomHardCutOnlyTr, maxMomTPCOnlyTr, trk.tpcNSigmaTr(), nSigmaTPCOnlyTr, downsamplingTsalisTritons, MassTriton, trk.tofNSigmaTr(), trk.itsNSigmaTr(), trk.tpcExpSignalTr(tpcSignalGeneric<IsCorrectedDeDx>(trk)), PidTriton, dwnSmplFactorTr, nSigmaTofTpctofTr, nSigmaTpcTpctofTr);
+        TofTrack tofTriton(true, maxMomHardCutOnlyTr, maxMomTPCOnlyTr, trk.tpcNSigmaTr(), nSigmaTPCOnlyTr, downsamplingTsalisTritons, MassTriton, trk.tofNSigmaTr(), UndefValueDouble, UndefValueDouble, PidTriton, dwnSmplFactorTr, nSigmaTofTpctofTr, nSigmaTpcTpctofTr);
 
-        TofTrack tofDeuteron(true, maxMomHardCutOnlyDe, maxMomTPCOnlyDe, trk.tpcNSigmaDe(), nSigmaTPCOnlyDe, downsamplingTsalisDeuterons, MassDeuteron, trk.tofNSigmaDe(), trk.itsNSigmaDe(), trk.tpcExpSignalDe(tpcSignalGeneric<IsCorrectedDeDx>(trk)), PidDeuteron, dwnSmplFactorDe, nSigmaTofTpctofDe, nSigmaTpcTpctofDe);
+        TofTrack tofDeuteron(true, maxMomHardCutOnlyDe, maxMomTPCOnlyDe, trk.tpcNSigmaDe(), nSigmaTPCOnlyDe, downsamplingTsalisDeuterons, MassDeuteron, trk.tofNSigmaDe(), UndefValueDouble, UndefValueDouble, PidDeuteron, dwnSmplFactorDe, nSigmaTofTpctofDe, nSigmaTpcTpctofDe);
 
-        TofTrack tofProton(false, UndefValueDouble, maxMomTPCOnlyPr, trk.tpcNSigmaPr(), nSigmaTPCOnlyPr, downsamplingTsalisProtons, MassProton, trk.tofNSigmaPr(), trk.itsNSigmaPr(), trk.tpcExpSignalPr(tpcSignalGeneric<IsCorrectedDeDx>(trk)), PidProton, dwnSmplFactorPr, nSigmaTofTpctofPr, nSigmaTpcTpctofPr);
+        TofTrack tofProton(false, UndefValueDouble, maxMomTPCOnlyPr, trk.tpcNSigmaPr(), nSigmaTPCOnlyPr, downsamplingTsalisProtons, MassProton, trk.tofNSigmaPr(), UndefValueDouble, UndefValueDouble, PidProton, dwnSmplFactorPr, nSigmaTofTpctofPr, nSigmaTpcTpctofPr);
 
-        TofTrack tofKaon(true, maxMomHardCutOnlyKa, maxMomTPCOnlyKa, trk.tpcNSigmaKa(), nSigmaTPCOnlyKa, downsamplingTsalisKaons, MassKPlus, trk.tofNSigmaKa(), trk.itsNSigmaKa(), trk.tpcExpSignalKa(tpcSignalGeneric<IsCorrectedDeDx>(trk)), PidKaon, dwnSmplFactorKa, nSigmaTofTpctofKa, nSigmaTpcTpctofKa);
+        TofTrack tofKaon(true, maxMomHardCutOnlyKa, maxMomTPCOnlyKa, trk.tpcNSigmaKa(), nSigmaTPCOnlyKa, downsamplingTsalisKaons, MassKPlus, trk.tofNSigmaKa(), UndefValueDouble, UndefValueDouble, PidKaon, dwnSmplFactorKa, nSigmaTofTpctofKa, nSigmaTpcTpctofKa);
 
-        TofTrack tofPion(false, UndefValueDouble, maxMomTPCOnlyPi, trk.tpcNSigmaPi(), nSigmaTPCOnlyPi, downsamplingTsalisPions, MassPiPlus, trk.tofNSigmaPi(), trk.itsNSigmaPi(), trk.tpcExpSignalPi(tpcSignalGeneric<IsCorrectedDeDx>(trk)), PidPion, dwnSmplFactorPi, nSigmaTofTpctofPi, nSigmaTpcTpctofPi);
+        TofTrack tofPion(false, UndefValueDouble, maxMomTPCOnlyPi, trk.tpcNSigmaPi(), nSigmaTPCOnlyPi, downsamplingTsalisPions, MassPiPlus, trk.tofNSigmaPi(), UndefValueDouble, UndefValueDouble, PidPion, dwnSmplFactorPi, nSigmaTofTpctofPi, nSigmaTpcTpctofPi);
 
         OccupancyValues occValues{};
-        if constexpr (ModeId == ModeWithTrkQA) {
-          evaluateOccupancyVariables(trk, occValues);
-        }
+        bool isOccupancyEvaluated{false};
 
         for (const auto& tofTrack : {&tofTriton, &tofDeuteron, &tofProton, &tofKaon, &tofPion}) {
+          // the cheap selections and the downsampling come first, the PID and occupancy variables are evaluated only for the kept species
           const bool passMomHardCut = !tofTrack->isApplyHardCutOnly || trk.tpcInnerParam() < tofTrack->maxMomHardCutOnly;
           const bool passMomTpcOnly = trk.tpcInnerParam() <= tofTrack->maxMomTPCOnly && std::fabs(tofTrack->tpcNSigma) < tofTrack->nSigmaTPCOnly;
           const bool passMomTpcTof = trk.tpcInnerParam() > tofTrack->maxMomTPCOnly && std::fabs(tofTrack->tofNSigma) < tofTrack->nSigmaTofTpctof && std::fabs(tofTrack->tpcNSigma) < tofTrack->nSigmaTpcTpctof;
-          const bool passDownsamplig = downsampleTsalisCharged(fRndm, trk.pt(), tofTrack->downsamplingTsalis, tofTrack->mass, sqrtSNN);
-          if (passMomHardCut && (passMomTpcOnly || passMomTpcTof) && passDownsamplig) {
-            fillSkimmedTpcTofTable<IsCorrectedDeDx, ModeId>(trk, trackQA, existTrkQA, collision, tofTrack->tpcNSigma, tofTrack->tofNSigma, tofTrack->itsNSigma, tofTrack->tpcExpSignal, tofTrack->pid, runnumber, tofTrack->dwnSmplFactor, hadronicRate, bcGlobalIndex, bcTimeFrameId, bcBcInTimeFrame, occValues, isGoodRctEvent);
+          if (!passMomHardCut || !(passMomTpcOnly || passMomTpcTof) || !passDwnSmplFactor(trk.pt(), tofTrack->dwnSmplFactor) ||
+              !downsampleTsalisCharged(fRndm, trk.pt(), tofTrack->downsamplingTsalis, tofTrack->mass, sqrtSNN)) {
+            continue;
+          }
+          if constexpr (ModeId == ModeWithTrkQA) {
+            if (!isOccupancyEvaluated) {
+              evaluateOccupancyVariables(trk, occValues);
+              isOccupancyEvaluated = true;
+            }
           }
+          setTofTrackPid<IsCorrectedDeDx>(*tofTrack, trk);
+          fillSkimmedTpcTofTable<IsCorrectedDeDx, ModeId>(trk, trackQA, existTrkQA, collision, tofTrack->tpcNSigma, tofTrack->tofNSigma, tofTrack->itsNSigma, tofTrack->tpcExpSignal, tofTrack->pid, runnumber, hadronicRate, bcGlobalIndex, bcTimeFrameId, bcBcInTimeFrame, occValues, isGoodRctEvent);
         }
       } /// Loop tracks
     }
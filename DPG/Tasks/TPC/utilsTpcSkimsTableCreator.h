@@ -34,6 +34,7 @@
 #include <TRandom3.h>
 
 #include <cmath>
+#include <cstdint>
 #include <string>
 
 namespace o2::dpg_tpcskimstablecreator
@@ -92,6 +93,14 @@ inline bool downsampleTsalisCharged(TRandom3* fRndm, const double pt, const doub
   }
 };
 
+/// Deterministic downsampling with the sub-MeV digits of the track pT as pseudo-random number: the fraction
+/// dwnSmplFactor of the tracks is kept. It only needs the pT, so it is applied before evaluating the track variables
+inline bool passDwnSmplFactor(const double pt, const double dwnSmplFactor)
+{
+  const double pseudoRndm = pt * 1000. - static_cast<int64_t>(pt * 1000);
+  return pseudoRndm < dwnSmplFactor;
+}
+
 // Track selection
 template <typename TrackType>
 bool isTrackSelected(const TrackType& track, const int trackSelection)
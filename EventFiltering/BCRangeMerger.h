@@ -0,0 +1,148 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+// Merging of the BC ranges of the selected collisions into sorted, disjoint intervals
+
+#ifndef EVENTFILTERING_BCRANGEMERGER_H_
+#define EVENTFILTERING_BCRANGEMERGER_H_
+
+#include <MathUtils/Primitive2D.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace o2::eventfiltering
+{
+
+using BCRange = o2::math_utils::Bracket<uint64_t>;
+
+/// Collects BC ranges and coalesces them with a sort and a single linear sweep.
+/// With setStreaming(true) the last range of the previous data frame is remembered, and the
+/// part of the new ranges already covered by it is dropped, so that no BC is written twice.
+class BCRangeMerger
+{
+ public:
+  /// number of BCs added on both sides of every range
+  void setPadding(uint64_t padding) { mPadding = padding; }
+  /// whether ranges which only touch (max + 1 == next min) are merged as well
+  void setMergeAdjacent(bool mergeAdjacent) { mMergeAdjacent = mergeAdjacent; }
+  void setStreaming(bool streaming) { mStreaming = streaming; }
+
+  /// starts a new data frame
+  void clear() { mRanges.clear(); }
+
+  void add(uint64_t bcMin, uint64_t bcMax)
+  {
+    bcMin = bcMin > mPadding ? bcMin - mPadding : 0;
+    bcMax = bcMax + mPadding;
+    mRanges.emplace_back(bcMin, bcMax);
+  }
+
+  /// sorts and merges the ranges added since the last clear(), the result is in getRanges()
+  void merge()
+  {
+    if (mRanges.empty()) {
+      return;
+    }
+    std::sort(mRanges.begin(), mRanges.end(), [](const BCRange& a, const BCRange& b) {
+      return a.getMin() < b.getMin();
+    });
+    std::size_t nMerged{0};
+    for (std::size_t iR{1}; iR < mRanges.size(); ++iR) {
+      auto& last = mRanges[nMerged];
+      if (overlaps(last.getMax(), mRanges[iR].getMin())) {
+        last.setMax(std::max(last.getMax(), mRanges[iR].getMax()));
+      } else {
+        mRanges[++nMerged] = mRanges[iR];
+      }
+    }
+    mRanges.erase(mRanges.begin() + nMerged + 1, mRanges.end());
+
+    if (mStreaming) {
+      if (mHasPrevious) {
+        // drop what the previous data frame already wrote
+        std::size_t nKept{0};
+        for (auto& range : mRanges) {
+          if (range.getMax() <= mPreviousMax) {
+            continue;
+          }
+          if (range.getMin() <= mPreviousMax) {
+            range.setMin(mPreviousMax + 1);
+          }
+          mRanges[nKept++] = range;
+        }
+        mRanges.erase(mRanges.begin() + nKept, mRanges.end());
+      }
+      if (!mRanges.empty()) {
+        mPreviousMax = std::max(mHasPrevious ? mPreviousMax : 0, mRanges.back().getMax());
+        mHasPrevious = true;
+      }
+    }
+  }
+
+  const std::vector<BCRange>& getRanges() const { return mRanges; }
+
+  /// Appends the merged ranges of the data frame to a binary file as one bitmap block:
+  ///   uint64_t firstBC, uint64_t nBCs, then (nBCs + 63) / 64 words where bit i flags firstBC + i
+  /// Blocks have a fixed layout, so the file can be memory-mapped and scanned block by block
+  bool writeBitmap(const std::string& fileName) const
+  {
+    if (mRanges.empty()) {
+      return true;
+    }
+    uint64_t firstBC{mRanges.front().getMin()};
+    uint64_t nBCs{mRanges.back().getMax() - firstBC + 1};
+    std::vector<uint64_t> words((nBCs + 63) / 64, 0ull);
+    for (const auto& range : mRanges) {
+      uint64_t first{range.getMin() - firstBC};
+      uint64_t last{range.getMax() - firstBC};
+      uint64_t firstWord{first / 64};
+      uint64_t lastWord{last / 64};
+      uint64_t firstMask{~0ull << (first % 64)};
+      uint64_t lastMask{~0ull >> (63 - last % 64)};
+      if (firstWord == lastWord) {
+        words[firstWord] |= firstMask & lastMask;
+        continue;
+      }
+      words[firstWord] |= firstMask;
+      std::fill(words.begin() + firstWord + 1, words.begin() + lastWord, ~0ull);
+      words[lastWord] |= lastMask;
+    }
+    std::ofstream out(fileName, std::ios::binary | std::ios::app);
+    if (!out) {
+      return false;
+    }
+    out.write(reinterpret_cast<const char*>(&firstBC), sizeof(firstBC));
+    out.write(reinterpret_cast<const char*>(&nBCs), sizeof(nBCs));
+    out.write(reinterpret_cast<const char*>(words.data()), words.size() * sizeof(uint64_t));
+    return static_cast<bool>(out);
+  }
+
+ private:
+  bool overlaps(uint64_t lastMax, uint64_t nextMin) const
+  {
+    return mMergeAdjacent ? lastMax + 1 >= nextMin : lastMax >= nextMin;
+  }
+
+  std::vector<BCRange> mRanges;
+  uint64_t mPadding{0};
+  bool mMergeAdjacent{false};
+  bool mStreaming{false};
+  bool mHasPrevious{false};
+  uint64_t mPreviousMax{0};
+};
+
+} // namespace o2::eventfiltering
+
+#endif // EVENTFILTERING_BCRANGEMERGER_H_
@@ -264,6 +264,9 @@ struct HfFilter { // Main struct for HF triggers
   // helper object
   HfFilterHelper helper;
 
+  // per-track quantities of the current collision, shared by all the trigger branches
+  std::vector<TrackFeatures> trackFeatures{};
+
   HistogramRegistry registry{"registry"};
 
   void init(InitContext& initContext)
@@ -535,6 +538,10 @@ struct HfFilter { // Main struct for HF triggers
         currentRun = bc.runNumber();
       }
 
+      // propagate and select once all the tracks associated to this collision
+      auto trackIdsThisCollision = trackIndices.sliceBy(trackIndicesPerCollision, thisCollId);
+      helper.fillTrackFeatures(trackIdsThisCollision, tracks, collision, noMatCorr, trackFeatures);
+
       std::vector<std::vector<int64_t>> indicesDau2Prong{}, indicesDau2ProngPrompt{};
 
       auto cand2ProngsThisColl = cand2Prongs.sliceBy(hf2ProngPerCollision, thisCollId);
@@ -640,26 +647,20 @@ struct HfFilter { // Main struct for HF triggers
           massD0BarCand = RecoDecay::m(std::array{pVecPos, pVecNeg}, std::array{massKa, massPi});
         }
 
-        auto trackIdsThisCollision = trackIndices.sliceBy(trackIndicesPerCollision, thisCollId);
         auto tracksWithItsPid = soa::Attach<BigTracksPID, aod::pidits::ITSNSigmaPr, aod::pidits::ITSNSigmaDe>(tracks);
-        for (const auto& trackId : trackIdsThisCollision) { // start loop over tracks
-          auto track = tracksWithItsPid.rawIteratorAt(trackId.trackId());
-
-          if (track.globalIndex() == trackPos.globalIndex() || track.globalIndex() == trackNeg.globalIndex()) {
+        for (const auto& featuresThird : trackFeatures) { // start loop over tracks
+          if (featuresThird.globalIndex == trackPos.globalIndex() || featuresThird.globalIndex == trackNeg.globalIndex()) {
             continue;
           }
+          auto track = tracksWithItsPid.rawIteratorAt(featuresThird.globalIndex);
 
-          auto trackParThird = getTrackParCov(track);
-          std::array<float, 2> dcaThird{track.dcaXY(), track.dcaZ()};
-          std::array<float, 3> pVecThird = track.pVector();
-          if (track.collisionId() != thisCollId) {
-            o2::base::Propagator::Instance()->propagateToDCABxByBz({collision.posX(), collision.posY(), collision.posZ()}, trackParThird, 2.f, noMatCorr, &dcaThird);
-            getPxPyPz(trackParThird, pVecThird);
-          }
+          const auto& trackParThird = featuresThird.trackPar;
+          const auto& dcaThird = featuresThird.dca;
+          const auto& pVecThird = featuresThird.pVec;
 
           // Beauty with D0
           if (!keepEvent[kBeauty3P] && isD0BeautyTagged) {
-            int16_t isTrackSelected = helper.isSelectedTrackForSoftPionOrBeauty<kBeauty3P>(track, trackParThird, dcaThird);
+            int16_t isTrackSelected = featuresThird.selBeauty3P;
             if (TESTBIT(isTrackSelected, kForBeauty) && ((TESTBIT(selD0InMass, 0) && track.sign() < 0) || (TESTBIT(selD0InMass, 1) && track.sign() > 0))) { // D0 pi-/K- and D0bar pi+/K+
               auto massCandD0Pi = RecoDecay::m(std::array{pVec2Prong, pVecThird}, std::array{massD0, massPi});
               auto massCandD0K = RecoDecay::m(std::array{pVec2Prong, pVecThird}, std::array{massD0, massKa});
@@ -766,20 +767,16 @@ struct HfFilter { // Main struct for HF triggers
                 if (activateQA) {
                   hMassVsPtC[kNCharmParticles]->Fill(ptCand, massDiffDstar);
                 }
-                for (const auto& trackIdB : trackIdsThisCollision) { // start loop over tracks
-                  auto trackB = tracks.rawIteratorAt(trackIdB.trackId());
-                  if (track.globalIndex() == trackB.globalIndex()) {
+                for (const auto& featuresFourth : trackFeatures) { // start loop over tracks
+                  if (track.globalIndex() == featuresFourth.globalIndex) {
                     continue;
                   }
-                  auto trackParFourth = getTrackParCov(trackB);
-                  std::array<float, 2> dcaFourth{trackB.dcaXY(), trackB.dcaZ()};
-                  std::array<float, 3> pVecFourth = trackB.pVector();
-                  if (trackB.collisionId() != thisCollId) {
-                    o2::base::Propagator::Instance()->propagateToDCABxByBz({collision.posX(), collision.posY(), collision.posZ()}, trackParFourth, 2.f, noMatCorr, &dcaFourth);
-                    getPxPyPz(trackParFourth, pVecFourth);
-                  }
+                  auto trackB = tracks.rawIteratorAt(featuresFourth.globalIndex);
+                  const auto& trackParFourth = featuresFourth.trackPar;
+                  const auto& dcaFourth = featuresFourth.dca;
+                  const auto& pVecFourth = featuresFourth.pVec;
 
-                  auto isTrackFourthSelected = helper.isSelectedTrackForSoftPionOrBeauty<kBeauty3P>(trackB, trackParFourth, dcaFourth);
+                  auto isTrackFourthSelected = featuresFourth.selBeauty3P;
                   if (track.sign() * trackB.sign() < 0 && TESTBIT(isTrackFourthSelected, kForBeauty)) {
                     auto massCandB0 = RecoDecay::m(std::array{pVecBeauty3Prong, pVecFourth}, std::array{massDStar, massPi});
                     auto pVecBeauty4Prong = RecoDecay::pVec(pVec2Prong, pVecThird, pVecFourth);
@@ -886,7 +883,7 @@ struct HfFilter { // Main struct for HF triggers
 
           // Beauty with JPsi
           if (preselJPsiToMuMu) {
-            if (!TESTBIT(helper.isSelectedTrackForSoftPionOrBeauty<kBtoJPsiKa>(track, trackParThird, dcaThird), kForBeauty)) { // same for all channels
+            if (!TESTBIT(featuresThird.selBeautyToJPsi, kForBeauty)) { // same for all channels
               continue;
             }
             std::array<float, 3> pVecPosVtx{}, pVecNegVtx{}, pVecThirdVtx{}, pVecFourthVtx{};
@@ -915,24 +912,19 @@ struct HfFilter { // Main struct for HF triggers
             }
             // 4-prong vertices
             if (!keepEvent[kBtoJPsiKstar] || !keepEvent[kBtoJPsiPhi] || !keepEvent[kBtoJPsiPrKa]) {
-              for (const auto& trackIdB : trackIdsThisCollision) { // start loop over tracks
+              for (const auto& featuresFourth : trackFeatures) { // start loop over tracks
                 if (keepEvent[kBtoJPsiKstar] && keepEvent[kBtoJPsiPhi] && keepEvent[kBtoJPsiPrKa]) {
                   break;
                 }
-                auto trackFourth = tracksWithItsPid.rawIteratorAt(trackIdB.trackId());
-                if (trackFourth.globalIndex() == track.globalIndex() || trackFourth.globalIndex() == trackPos.globalIndex() || trackFourth.globalIndex() == trackNeg.globalIndex() || trackFourth.sign() * track.sign() > 0) {
+                if (!TESTBIT(featuresFourth.selBeautyToJPsi, kForBeauty)) { // same for all channels
                   continue;
                 }
-                auto trackParFourth = getTrackParCov(trackFourth);
-                std::array<float, 2> dcaFourth{trackFourth.dcaXY(), trackFourth.dcaZ()};
-                std::array<float, 3> pVecFourth = trackFourth.pVector();
-                if (trackFourth.collisionId() != thisCollId) {
-                  o2::base::Propagator::Instance()->propagateToDCABxByBz({collision.posX(), collision.posY(), collision.posZ()}, trackParFourth, 2.f, noMatCorr, &dcaFourth);
-                  getPxPyPz(trackParFourth, pVecFourth);
-                }
-                if (!TESTBIT(helper.isSelectedTrackForSoftPionOrBeauty<kBtoJPsiKa>(trackFourth, trackParFourth, dcaFourth), kForBeauty)) { // same for all channels
+                auto trackFourth = tracksWithItsPid.rawIteratorAt(featuresFourth.globalIndex);
+                if (trackFourth.globalIndex() == track.globalIndex() || trackFourth.globalIndex() == trackPos.globalIndex() || trackFourth.globalIndex() == trackNeg.globalIndex() || trackFourth.sign() * track.sign() > 0) {
                   continue;
                 }
+                const auto& trackParFourth = featuresFourth.trackPar;
+                const auto& pVecFourth = featuresFourth.pVec;
                 int nVtxB{0};
                 try {
                   nVtxB = df4.process(trackParPos, trackParNeg, trackParThird, trackParFourth);
@@ -1027,21 +1019,14 @@ struct HfFilter { // Main struct for HF triggers
             if (!keepEvent[kV0Charm2P] && TESTBIT(selV0, kK0S)) {
 
               // we first look for a D*+
-              for (const auto& trackBachelorId : trackIdsThisCollision) { // start loop over tracks
-                auto trackBachelor = tracks.rawIteratorAt(trackBachelorId.trackId());
-                if (trackBachelor.globalIndex() == trackPos.globalIndex() || trackBachelor.globalIndex() == trackNeg.globalIndex() || trackBachelor.globalIndex() == v0.posTrackId() || trackBachelor.globalIndex() == v0.negTrackId()) {
+              for (const auto& featuresBachelor : trackFeatures) { // start loop over tracks
+                if (featuresBachelor.globalIndex == trackPos.globalIndex() || featuresBachelor.globalIndex == trackNeg.globalIndex() || featuresBachelor.globalIndex == v0.posTrackId() || featuresBachelor.globalIndex == v0.negTrackId()) {
                   continue;
                 }
+                auto trackBachelor = tracks.rawIteratorAt(featuresBachelor.globalIndex);
+                const auto& pVecBachelor = featuresBachelor.pVec;
 
-                auto trackParBachelor = getTrackPar(trackBachelor);
-                std::array<float, 2> dcaBachelor{trackBachelor.dcaXY(), trackBachelor.dcaZ()};
-                std::array<float, 3> pVecBachelor = trackBachelor.pVector();
-                if (trackBachelor.collisionId() != thisCollId) {
-                  o2::base::Propagator::Instance()->propagateToDCABxByBz({collision.posX(), collision.posY(), collision.posZ()}, trackParBachelor, 2.f, noMatCorr, &dcaBachelor);
-                  getPxPyPz(trackParBachelor, pVecBachelor);
-                }
-
-                auto isTrackSelected = helper.isSelectedTrackForSoftPionOrBeauty<kV0Charm2P>(trackBachelor, trackParBachelor, dcaBachelor);
+                auto isTrackSelected = featuresBachelor.selCharmReso;
                 if (TESTBIT(isTrackSelected, kSoftPion) && ((TESTBIT(selD0InMass, 0) && trackBachelor.sign() > 0) || (TESTBIT(selD0InMass, 1) && trackBachelor.sign() < 0))) {
                   std::array<float, 2> massDausD0{massPi, massKa};
                   auto massD0dau = massD0Cand;
@@ -1125,37 +1110,26 @@ struct HfFilter { // Main struct for HF triggers
 
         // 2-prong (D0 or D*) with proton for Lc resonances and ThetaC (3100)
         if (!keepEvent[kPrCharm2P] && isD0SignalTagged && (TESTBIT(selD0InMass, 0) || TESTBIT(selD0InMass, 1))) {
-          for (const auto& trackProtonId : trackIdsThisCollision) { // start loop over tracks selecting only protons
-            auto trackProton = tracks.rawIteratorAt(trackProtonId.trackId());
-            auto trackParBachelorProton = getTrackPar(trackProton);
-            if (trackProton.globalIndex() == trackPos.globalIndex() || trackProton.globalIndex() == trackNeg.globalIndex()) {
+          for (const auto& featuresProton : trackFeatures) { // start loop over tracks selecting only protons
+            if (featuresProton.globalIndex == trackPos.globalIndex() || featuresProton.globalIndex == trackNeg.globalIndex()) {
               continue;
             }
-            std::array<float, 2> dcaInfoBachProton;
-            if (trackProton.collisionId() != thisCollId) {
-              o2::base::Propagator::Instance()->propagateToDCABxByBz({collision.posX(), collision.posY(), collision.posZ()}, trackParBachelorProton, 2.f, noMatCorr, &dcaInfoBachProton);
-            }
+            auto trackProton = tracks.rawIteratorAt(featuresProton.globalIndex);
             std::array<float, 3> pVecProton = trackProton.pVector();
-            bool isSelPIDProton = helper.isSelectedProton4CharmOrBeautyBaryons<false>(trackProton);
+            bool isSelPIDProton = featuresProton.isProtonForCharmBaryon;
             if (isSelPIDProton) {
               if (!keepEvent[kPrCharm2P]) {
                 // we first look for a D*+
-                for (const auto& trackBachelorId : trackIdsThisCollision) { // start loop over tracks to find bachelor pion
-                  if (!helper.isSelectedProtonFromLcResoOrThetaC<true>(trackProton)) {
-                    continue;
+                for (const auto& featuresBachelor : trackFeatures) { // start loop over tracks to find bachelor pion
+                  if (!featuresProton.isProtonForThetaC) {
+                    break;
                   } // stop here if proton below pT threshold for thetaC to avoid computational losses
-                  auto trackBachelor = tracks.rawIteratorAt(trackBachelorId.trackId());
-                  if (trackBachelor.globalIndex() == trackPos.globalIndex() || trackBachelor.globalIndex() == trackNeg.globalIndex() || trackBachelor.globalIndex() == trackProton.globalIndex()) {
+                  if (featuresBachelor.globalIndex == trackPos.globalIndex() || featuresBachelor.globalIndex == trackNeg.globalIndex() || featuresBachelor.globalIndex == featuresProton.globalIndex) {
                     continue;
                   }
-                  auto trackParBachelor = getTrackPar(trackBachelor);
-                  std::array<float, 2> dcaBachelor{trackBachelor.dcaXY(), trackBachelor.dcaZ()};
-                  std::array<float, 3> pVecBachelor = trackBachelor.pVector();
-                  if (trackBachelor.collisionId() != thisCollId) {
-                    o2::base::Propagator::Instance()->propagateToDCABxByBz({collision.posX(), collision.posY(), collision.posZ()}, trackParBachelor, 2.f, noMatCorr, &dcaBachelor);
-                    getPxPyPz(trackParBachelor, pVecBachelor);
-                  }
-                  auto isTrackSelected = helper.isSelectedTrackForSoftPionOrBeauty<kPrCharm2P>(trackBachelor, trackParBachelor, dcaBachelor);
+                  auto trackBachelor = tracks.rawIteratorAt(featuresBachelor.globalIndex);
+                  const auto& pVecBachelor = featuresBachelor.pVec;
+                  auto isTrackSelected = featuresBachelor.selCharmReso;
                   if (TESTBIT(isTrackSelected, kSoftPion) && ((TESTBIT(selD0InMass, 0) && trackBachelor.sign() > 0) || (TESTBIT(selD0InMass, 1) && trackBachelor.sign() < 0))) {
                     if (pt2Prong < cutsPtDeltaMassCharmReso->get(3u, 12u)) {
                       continue;
@@ -1428,27 +1402,22 @@ struct HfFilter { // Main struct for HF triggers
           }
         } // end high-pT selection
 
-        auto trackIdsThisCollision = trackIndices.sliceBy(trackIndicesPerCollision, thisCollId);
         auto tracksWithItsPid = soa::Attach<BigTracksPID, aod::pidits::ITSNSigmaPr, aod::pidits::ITSNSigmaDe>(tracks);
 
-        for (const auto& trackId : trackIdsThisCollision) { // start loop over track indices as associated to this collision in HF code
-          auto track = tracksWithItsPid.rawIteratorAt(trackId.trackId());
-          if (track.globalIndex() == trackFirst.globalIndex() || track.globalIndex() == trackSecond.globalIndex() || track.globalIndex() == trackThird.globalIndex()) {
+        for (const auto& featuresFourth : trackFeatures) { // start loop over track indices as associated to this collision in HF code
+          if (featuresFourth.globalIndex == trackFirst.globalIndex() || featuresFourth.globalIndex == trackSecond.globalIndex() || featuresFourth.globalIndex == trackThird.globalIndex()) {
             continue;
           }
+          auto track = tracksWithItsPid.rawIteratorAt(featuresFourth.globalIndex);
 
-          auto trackParFourth = getTrackParCov(track);
-          std::array<float, 2> dcaFourth{track.dcaXY(), track.dcaZ()};
-          std::array<float, 3> pVecFourth = track.pVector();
-          if (track.collisionId() != thisCollId) {
-            o2::base::Propagator::Instance()->propagateToDCABxByBz({collision.posX(), collision.posY(), collision.posZ()}, trackParFourth, 2.f, noMatCorr, &dcaFourth);
-            getPxPyPz(trackParFourth, pVecFourth);
-          }
+          const auto& trackParFourth = featuresFourth.trackPar;
+          const auto& dcaFourth = featuresFourth.dca;
+          const auto& pVecFourth = featuresFourth.pVec;
 
           int charmParticleID[kNBeautyParticles - 3] = {o2::constants::physics::Pdg::kDPlus, o2::constants::physics::Pdg::kDS, o2::constants::physics::Pdg::kLambdaCPlus, o2::constants::physics::Pdg::kXiCPlus};
 
           float massCharmHypos[kNBeautyParticles - 3] = {massDPlus, massDs, massLc, massXic};
-          auto isTrackSelected = helper.isSelectedTrackForSoftPionOrBeauty<kBeauty4P>(track, trackParFourth, dcaFourth);
+          auto isTrackSelected = featuresFourth.selBeauty4P;
           if (track.sign() * sign3Prong < 0 && TESTBIT(isTrackSelected, kForBeauty)) {
             for (int iHypo{0}; iHypo < kNBeautyParticles - 3 && !keepEvent[kBeauty4P]; ++iHypo) {
               if (isBeautyTagged[iHypo] && (TESTBIT(is3ProngInMass[iHypo], 0) || TESTBIT(is3ProngInMass[iHypo], 1))) {
@@ -1569,11 +1538,10 @@ struct HfFilter { // Main struct for HF triggers
             // we need a candidate Lc->pKpi and a candidate soft kaon, and also need a candidate of proton for sigmaC correlation
 
             // look for SigmaC++ candidates
-            for (const auto& trackSoftPiId : trackIdsThisCollision) { // start loop over tracks (soft pi)
+            for (const auto& featuresSoftPi : trackFeatures) { // start loop over tracks (soft pi)
 
               // soft pion candidates
-              auto trackSoftPi = tracks.rawIteratorAt(trackSoftPiId.trackId());
-              auto globalIndexSoftPi = trackSoftPi.globalIndex();
+              auto globalIndexSoftPi = featuresSoftPi.globalIndex;
 
               // exclude tracks already used to build the 3-prong candidate
               if (globalIndexSoftPi == trackFirst.globalIndex() || globalIndexSoftPi == trackSecond.globalIndex() || globalIndexSoftPi == trackThird.globalIndex()) {
@@ -1584,22 +1552,15 @@ struct HfFilter { // Main struct for HF triggers
               if (globalIndexSoftPi == track.globalIndex()) {
                 continue;
               }
+              auto trackSoftPi = tracks.rawIteratorAt(globalIndexSoftPi);
 
               // check the candidate SigmaC++ charge
               std::array<int, 4> chargesSc = {trackFirst.sign(), trackSecond.sign(), trackThird.sign(), trackSoftPi.sign()};
               int chargeSc = std::accumulate(chargesSc.begin(), chargesSc.end(), 0); // SIGNED electric charge of SigmaC candidate
 
-              // select soft pion candidates
-              auto trackParSoftPi = getTrackPar(trackSoftPi);
-              std::array<float, 2> dcaSoftPi{trackSoftPi.dcaXY(), trackSoftPi.dcaZ()};
-              std::array<float, 3> pVecSoftPi = trackSoftPi.pVector();
-              if (trackSoftPi.collisionId() != thisCollId) {
-                // This is a track reassociated to this PV by the track-to-collision-associator
-                // Let's propagate this track to it, and calculate dcaXY, dcaZ
-                o2::base::Propagator::Instance()->propagateToDCABxByBz({collision.posX(), collision.posY(), collision.posZ()}, trackParSoftPi, 2.f, noMatCorr, &dcaSoftPi);
-                getPxPyPz(trackParSoftPi, pVecSoftPi);
-              }
-              int16_t isSoftPionSelected = helper.isSelectedTrackForSoftPionOrBeauty<kSigmaCPPK>(trackSoftPi, trackParSoftPi, dcaSoftPi);
+              // select soft pion candidates, already propagated to this PV if reassociated by the track-to-collision-associator
+              const auto& pVecSoftPi = featuresSoftPi.pVec;
+              int16_t isSoftPionSelected = featuresSoftPi.selSigmaC;
               if (TESTBIT(isSoftPionSelected, kSoftPionForSigmaC) /*&& (TESTBIT(is3Prong[2], 0) || TESTBIT(is3Prong[2], 1))*/) {
 
                 // check the mass of the SigmaC++ candidate
@@ -1783,17 +1744,17 @@ struct HfFilter { // Main struct for HF triggers
             // we pair SigmaC0 with V0
             if (!keepEvent[kSigmaC0K0] && (isGoodLcToPKPi || isGoodLcToPiKP) && TESTBIT(selV0, kK0S)) {
               // look for SigmaC0 candidates
-              for (const auto& trackSoftPiId : trackIdsThisCollision) { // start loop over tracks (soft pi)
+              for (const auto& featuresSoftPi : trackFeatures) { // start loop over tracks (soft pi)
 
                 // soft pion candidates
-                auto trackSoftPi = tracks.rawIteratorAt(trackSoftPiId.trackId());
-                auto globalIndexSoftPi = trackSoftPi.globalIndex();
+                auto globalIndexSoftPi = featuresSoftPi.globalIndex;
 
                 // exclude tracks already used to build the 3-prong candidate
                 if (globalIndexSoftPi == trackFirst.globalIndex() || globalIndexSoftPi == trackSecond.globalIndex() || globalIndexSoftPi == trackThird.globalIndex() || globalIndexSoftPi == v0.posTrackId() || globalIndexSoftPi == v0.negTrackId()) {
                   // do not consider as candidate soft pion a track already used to build the current 3-prong candidate / V0 candidate
                   continue;
                 }
+                auto trackSoftPi = tracks.rawIteratorAt(globalIndexSoftPi);
 
                 // check the candidate SigmaC0 charge
                 std::array<int, 4> chargesSc = {trackFirst.sign(), trackSecond.sign(), trackThird.sign(), trackSoftPi.sign()};
@@ -1802,17 +1763,9 @@ struct HfFilter { // Main struct for HF triggers
                   continue;
                 }
 
-                // select soft pion candidates
-                auto trackParSoftPi = getTrackPar(trackSoftPi);
-                std::array<float, 2> dcaSoftPi{trackSoftPi.dcaXY(), trackSoftPi.dcaZ()};
-                std::array<float, 3> pVecSoftPi = trackSoftPi.pVector();
-                if (trackSoftPi.collisionId() != thisCollId) {
-                  // This is a track reassociated to this PV by the track-to-collision-associator
-                  // Let's propagate this track to it, and calculate dcaXY, dcaZ
-                  o2::base::Propagator::Instance()->propagateToDCABxByBz({collision.posX(), collision.posY(), collision.posZ()}, trackParSoftPi, 2.f, noMatCorr, &dcaSoftPi);
-                  getPxPyPz(trackParSoftPi, pVecSoftPi);
-                }
-                int16_t isSoftPionSelected = helper.isSelectedTrackForSoftPionOrBeauty<kSigmaC0K0>(trackSoftPi, trackParSoftPi, dcaSoftPi);
+                // select soft pion candidates, already propagated to this PV if reassociated by the track-to-collision-associator
+                const auto& pVecSoftPi = featuresSoftPi.pVec;
+                int16_t isSoftPionSelected = featuresSoftPi.selSigmaC;
                 if (TESTBIT(isSoftPionSelected, kSoftPionForSigmaC) /*&& (TESTBIT(is3Prong[2], 0) || TESTBIT(is3Prong[2], 1))*/) {
 
                   // check the mass of the SigmaC0 candidate
@@ -1926,25 +1879,18 @@ struct HfFilter { // Main struct for HF triggers
             o2::base::Propagator::Instance()->propagateToDCABxByBz({collision.posX(), collision.posY(), collision.posZ()}, trackParCascTrack, 2.f, matCorr, &dcaInfo);
           }
 
-          auto trackIdsThisCollision = trackIndices.sliceBy(trackIndicesPerCollision, thisCollId);
-          for (const auto& trackId : trackIdsThisCollision) { // start loop over tracks (first bachelor)
-            auto track = tracks.rawIteratorAt(trackId.trackId());
-
+          for (const auto& featuresBachelor : trackFeatures) { // start loop over tracks (first bachelor)
             // check if track is one of the Xi daughters
-            if (track.globalIndex() == bachelorCascId || track.globalIndex() == v0DauPosId || track.globalIndex() == v0DauNegId) {
+            if (featuresBachelor.globalIndex == bachelorCascId || featuresBachelor.globalIndex == v0DauPosId || featuresBachelor.globalIndex == v0DauNegId) {
               continue;
             }
 
-            auto trackParBachelor = getTrackParCov(track);
-            std::array<float, 2> dcaInfoBach;
-            if (track.collisionId() != thisCollId) {
-              o2::base::Propagator::Instance()->propagateToDCABxByBz({collision.posX(), collision.posY(), collision.posZ()}, trackParBachelor, 2.f, noMatCorr, &dcaInfoBach);
-            }
-
-            auto isSelBachelor = helper.isSelectedBachelorForCharmBaryon(track, dcaInfoBach);
+            auto isSelBachelor = featuresBachelor.selBachelorCharmBaryon;
             if (isSelBachelor == kRejected) {
               continue;
             }
+            auto track = tracks.rawIteratorAt(featuresBachelor.globalIndex);
+            const auto& trackParBachelor = featuresBachelor.trackPar;
 
             if (!keepEvent[kCharmBarToXiBach] && track.sign() * cascCand.sign < 0) { // XiPi and XiKa
 
@@ -1967,28 +1913,21 @@ struct HfFilter { // Main struct for HF triggers
             }
 
             if (!keepEvent[kCharmBarToXi2Bach]) {
-              for (const auto& trackIdSecond : trackIdsThisCollision) { // start loop over tracks (second bachelor)
-                auto trackSecond = tracks.rawIteratorAt(trackIdSecond.trackId());
-
+              for (const auto& featuresBachelorSecond : trackFeatures) { // start loop over tracks (second bachelor)
                 // check if track is one of the Xi daughters
-                if (trackSecond.globalIndex() == track.globalIndex() || trackSecond.globalIndex() == bachelorCascId || trackSecond.globalIndex() == v0DauPosId || trackSecond.globalIndex() == v0DauNegId) {
+                if (featuresBachelorSecond.globalIndex == track.globalIndex() || featuresBachelorSecond.globalIndex == bachelorCascId || featuresBachelorSecond.globalIndex == v0DauPosId || featuresBachelorSecond.globalIndex == v0DauNegId) {
                   continue;
                 }
 
-                if (track.sign() * trackSecond.sign() < 0 || track.sign() * cascCand.sign > 0) { // we want same sign pions, opposite to the xi
+                if (!TESTBIT(featuresBachelorSecond.selBachelorCharmBaryon, kPionForCharmBaryon)) {
                   continue;
                 }
 
-                auto trackParBachelorSecond = getTrackParCov(trackSecond);
-                std::array<float, 2> dcaInfoBachSecond;
-                if (trackSecond.collisionId() != thisCollId) {
-                  o2::base::Propagator::Instance()->propagateToDCABxByBz({collision.posX(), collision.posY(), collision.posZ()}, trackParBachelorSecond, 2.f, noMatCorr, &dcaInfoBachSecond);
-                }
-
-                auto isSelBachelorSecond = helper.isSelectedBachelorForCharmBaryon(trackSecond, dcaInfoBachSecond);
-                if (!TESTBIT(isSelBachelorSecond, kPionForCharmBaryon)) {
+                auto trackSecond = tracks.rawIteratorAt(featuresBachelorSecond.globalIndex);
+                if (track.sign() * trackSecond.sign() < 0 || track.sign() * cascCand.sign > 0) { // we want same sign pions, opposite to the xi
                   continue;
                 }
+                const auto& trackParBachelorSecond = featuresBachelorSecond.trackPar;
                 if (!keepEvent[kCharmBarToXi2Bach]) { // XiPiPi
 
                   bool isSelXiBachBach{false};
@@ -242,6 +242,23 @@ struct CascCand {
   int sign;
 };
 
+// Helper struct to cache the quantities of a track associated to the collision,
+// computed once per event and read by all the trigger branches
+struct TrackFeatures {
+  int64_t globalIndex;
+  o2::track::TrackParCov trackPar; // propagated to the collision vertex if the track was reassociated to it
+  std::array<float, 2> dca;
+  std::array<float, 3> pVec;
+  int16_t selBeauty3P;            // isSelectedTrackForSoftPionOrBeauty<kBeauty3P>
+  int16_t selBeauty4P;            // isSelectedTrackForSoftPionOrBeauty<kBeauty4P>
+  int16_t selBeautyToJPsi;        // isSelectedTrackForSoftPionOrBeauty<kBtoJPsiKa>, same for all the B->JPsiX channels
+  int16_t selCharmReso;           // isSelectedTrackForSoftPionOrBeauty<kV0Charm2P>, same for kPrCharm2P
+  int16_t selSigmaC;              // isSelectedTrackForSoftPionOrBeauty<kSigmaCPPK>, same for kSigmaC0K0 and kSigmaCPr
+  int16_t selBachelorCharmBaryon; // isSelectedBachelorForCharmBaryon
+  bool isProtonForCharmBaryon;    // isSelectedProton4CharmOrBeautyBaryons<false>
+  bool isProtonForThetaC;         // isSelectedProtonFromLcResoOrThetaC<true>
+};
+
 static const std::array<std::string, kNCharmParticles> charmParticleNames{"D0", "Dplus", "Ds", "Lc", "Xic"};
 static const int nTotBeautyParts = static_cast<int>(kNBeautyParticles) + static_cast<int>(kNBeautyParticlesToJPsi);
 static const std::array<std::string, nTotBeautyParts> beautyParticleNames{"Bplus", "B0toDStar", "Bc", "B0", "Bs", "Lb", "Xib", "BplusToJPsi", "B0ToJPsi", "BsToJPsi", "LbToJPsi", "BcToJPsi"};
@@ -734,6 +751,8 @@ class HfFilterHelper
   bool buildV0(V const& v0Indices, T const& tracks, C const& collision, o2::vertexing::DCAFitterN<2>& dcaFitter, const std::vector<int>& vetoedTrackIds, V0Cand& v0Cand);
   template <typename Casc, typename T, typename C, typename V>
   bool buildCascade(Casc const& cascIndices, V const& v0Indices, T const& tracks, C const& collision, o2::vertexing::DCAFitterN<2>& dcaFitter, const std::vector<int>& vetoedTrackIds, CascCand& cascCand);
+  template <typename TI, typename T, typename C>
+  void fillTrackFeatures(TI const& trackIndices, T const& tracks, C const& collision, o2::base::Propagator::MatCorrType matCorr, std::vector<TrackFeatures>& trackFeatures);
 
   // PID
   void setValuesBB(o2::ccdb::CcdbApi& ccdbApi, aod::BCsWithTimestamps::iterator const& bunchCrossing, const std::array<std::string, 8>& ccdbPaths);
@@ -2984,6 +3003,39 @@ inline bool HfFilterHelper::buildCascade(Casc const& cascIndices, V const& v0Ind
   return true;
 }
 
+/// compute the quantities of all the tracks associated to the collision, shared by all the trigger branches
+/// \param trackIndices track indices associated to the collision
+/// \param tracks track table
+/// \param collision collision
+/// \param matCorr material correction used to propagate the reassociated tracks to the collision vertex
+/// \param trackFeatures output vector, one entry per associated track in the same order as trackIndices
+template <typename TI, typename T, typename C>
+inline void HfFilterHelper::fillTrackFeatures(TI const& trackIndices, T const& tracks, C const& collision, o2::base::Propagator::MatCorrType matCorr, std::vector<TrackFeatures>& trackFeatures)
+{
+  trackFeatures.clear();
+  trackFeatures.reserve(trackIndices.size());
+  for (const auto& trackId : trackIndices) {
+    auto track = tracks.rawIteratorAt(trackId.trackId());
+    auto& features = trackFeatures.emplace_back();
+    features.globalIndex = track.globalIndex();
+    features.trackPar = getTrackParCov(track);
+    features.dca = {track.dcaXY(), track.dcaZ()};
+    features.pVec = track.pVector();
+    if (track.collisionId() != collision.globalIndex()) {
+      o2::base::Propagator::Instance()->propagateToDCABxByBz({collision.posX(), collision.posY(), collision.posZ()}, features.trackPar, 2.f, matCorr, &features.dca);
+      getPxPyPz(features.trackPar, features.pVec);
+    }
+    features.selBeauty3P = isSelectedTrackForSoftPionOrBeauty<kBeauty3P>(track, features.trackPar, features.dca);
+    features.selBeauty4P = isSelectedTrackForSoftPionOrBeauty<kBeauty4P>(track, features.trackPar, features.dca);
+    features.selBeautyToJPsi = isSelectedTrackForSoftPionOrBeauty<kBtoJPsiKa>(track, features.trackPar, features.dca);
+    features.selCharmReso = isSelectedTrackForSoftPionOrBeauty<kV0Charm2P>(track, features.trackPar, features.dca);
+    features.selSigmaC = isSelectedTrackForSoftPionOrBeauty<kSigmaCPPK>(track, features.trackPar, features.dca);
+    features.selBachelorCharmBaryon = isSelectedBachelorForCharmBaryon(track, features.dca);
+    features.isProtonForCharmBaryon = isSelectedProton4CharmOrBeautyBaryons<false>(track);
+    features.isProtonForThetaC = isSelectedProtonFromLcResoOrThetaC<true>(track);
+  }
+}
+
 } // namespace hffilters
 
 /// definition of tables
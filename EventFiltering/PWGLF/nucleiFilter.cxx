@@ -321,6 +321,8 @@ struct nucleiFilter {
     constexpr int nucleusIndex[nNuclei]{kH2, -1, kHe}; /// remap for nuclei triggers
     std::vector<int> h3indices;
     std::vector<ROOT::Math::PtEtaPhiMVector> h3vectors;
+    std::vector<int> pionIndices; /// femto partners of the triton candidates, tagged in the same track loop
+    std::vector<ROOT::Math::PtEtaPhiMVector> pionVectors;
 
     auto getNsigma = [&](const auto& track, int iN, int iC) {
       float fixTPCrigidity{(cfgFixTPCinnerParam && (track.pidForTracking() == track::PID::Helium3 || track.pidForTracking() == track::PID::Alpha)) ? 0.5f : 1.f};
@@ -346,6 +348,11 @@ struct nucleiFilter {
         continue;
       }
 
+      if (std::abs(track.dcaXY()) <= cfgCutDCAxy && std::abs(track.dcaZ()) <= cfgCutDCAz && std::abs(track.eta()) <= cfgCutEta) {
+        pionIndices.push_back(track.globalIndex());
+        pionVectors.emplace_back(track.pt(), track.eta(), track.phi(), constants::physics::MassPiMinus);
+      }
+
       if (std::abs(track.tpcNSigmaDe()) < 5) {
         qaHists.fill(HIST("fDeuTOFNsigma"), track.p() * track.sign(), track.tofNSigmaDe());
       }
@@ -399,17 +406,10 @@ struct nucleiFilter {
 
     } // end loop over tracks
 
-    for (const auto& track : tracks) {
-      if (track.itsNCls() < cfgCutNclusITS ||
-          track.tpcNClsFound() < cfgCutNclusTPC ||
-          std::abs(track.dcaXY()) > cfgCutDCAxy ||
-          std::abs(track.dcaZ()) > cfgCutDCAz ||
-          std::abs(track.eta()) > cfgCutEta) {
-        continue;
-      }
-      const ROOT::Math::PtEtaPhiMVector trackVector(track.pt(), track.eta(), track.phi(), constants::physics::MassPiMinus);
+    for (size_t iPi{0}; iPi < pionVectors.size() && !h3vectors.empty() && !keepEvent[kTritonFemto]; ++iPi) {
+      const auto& trackVector = pionVectors[iPi];
       for (size_t iH3{0}; iH3 < h3vectors.size(); ++iH3) {
-        if (h3indices[iH3] == track.globalIndex()) {
+        if (h3indices[iH3] == pionIndices[iPi]) {
           continue;
         }
         const auto& h3vector = h3vectors[iH3];
@@ -40,6 +40,8 @@
 #include <Rtypes.h>
 
 #include <array>
+#include <bit>
+#include <cstddef>
 #include <cstdint>
 #include <cstdio>
 #include <memory>
@@ -285,6 +287,22 @@ struct centralEventFilterTask {
     if (cfgDisableDownscalings.value) {
       LOG(info) << "Downscalings are disabled for all channels.";
     }
+
+    // compile the channels once, so that run() does not have to look up bins and downscalings by name
+    mTriggerTables.clear();
+    for (auto& table : mDownscaling) {
+      auto& triggerTable = mTriggerTables.emplace_back();
+      triggerTable.name = table.first;
+      for (auto& column : table.second) {
+        auto& channel = triggerTable.channels.emplace_back();
+        channel.column = column.first;
+        uint64_t channelBin{static_cast<uint64_t>(mScalers->GetXaxis()->FindBin(column.first.data()))};
+        channel.bin = static_cast<int>(channelBin);
+        channel.word = (channelBin - 2) / 64;
+        channel.bit = BIT((channelBin - 2) % 64);
+        channel.downscaling = cfgDisableDownscalings.value ? 1. : column.second;
+      }
+    }
   }
 
   void run(ProcessingContext& pc)
@@ -328,15 +346,15 @@ struct centralEventFilterTask {
 
     int64_t nEvents{collTabPtr->num_rows()};
     std::vector<std::array<uint64_t, 2>> outTrigger, outDecision;
-    for (auto& tableName : mDownscaling) {
-      if (!pc.inputs().isValid(tableName.first)) {
-        LOG(fatal) << tableName.first << " table is not valid.";
+    for (auto& triggerTable : mTriggerTables) {
+      if (!pc.inputs().isValid(triggerTable.name)) {
+        LOG(fatal) << triggerTable.name << " table is not valid.";
       }
-      auto tableConsumer = pc.inputs().get<TableConsumer>(tableName.first);
+      auto tableConsumer = pc.inputs().get<TableConsumer>(triggerTable.name);
       auto tablePtr{tableConsumer->asArrowTable()};
       int64_t nRows{tablePtr->num_rows()};
       if (nEvents != nRows) {
-        LOGF(fatal, "Inconsistent number of rows in the trigger table %s: %lld but it should be %lld", tableName.first.data(), nRows, nEvents);
+        LOGF(fatal, "Inconsistent number of rows in the trigger table %s: %lld but it should be %lld", triggerTable.name.data(), nRows, nEvents);
       }
 
       if (outDecision.size() == 0) {
@@ -344,65 +362,83 @@ struct centralEventFilterTask {
         outTrigger.resize(nEvents, {0ull, 0ull});
       }
 
-      auto schema{tablePtr->schema()};
-      for (auto& colName : tableName.second) {
-        uint64_t bin{static_cast<uint64_t>(mScalers->GetXaxis()->FindBin(colName.first.data()))};
-        double binCenter{mScalers->GetXaxis()->GetBinCenter(bin)};
-        uint64_t decisionBin{(bin - 2) / 64};
-        uint64_t triggerBit{BIT((bin - 2) % 64)};
-        auto column{tablePtr->GetColumnByName(colName.first)};
-        double downscaling{cfgDisableDownscalings.value ? 1. : colName.second};
-        if (column) {
-          int entry = 0;
-          for (int64_t iC{0}; iC < column->num_chunks(); ++iC) {
-            auto chunk{column->chunk(iC)};
-            auto boolArray = std::static_pointer_cast<arrow::BooleanArray>(chunk);
-            for (int64_t iS{startCollision}; iS < chunk->length(); ++iS) {
-              if (boolArray->Value(iS)) {
-                mScalers->Fill(binCenter);
-                outTrigger[entry][decisionBin] |= triggerBit;
-                if (mUniformGenerator(mGeneratorEngine) < downscaling) {
-                  mFiltered->Fill(binCenter);
-                  outDecision[entry][decisionBin] |= triggerBit;
-                }
-              }
-              entry++;
+      for (auto& channel : triggerTable.channels) {
+        auto column{tablePtr->GetColumnByName(channel.column)};
+        if (!column) {
+          continue;
+        }
+        // collect the events firing the channel, column by column
+        mFiredEvents.clear();
+        int64_t entry = 0;
+        for (int64_t iC{0}; iC < column->num_chunks(); ++iC) {
+          auto chunk{column->chunk(iC)};
+          auto boolArray = std::static_pointer_cast<arrow::BooleanArray>(chunk);
+          for (int64_t iS{startCollision}; iS < chunk->length(); ++iS) {
+            if (boolArray->Value(iS)) {
+              mFiredEvents.push_back(entry);
             }
+            entry++;
           }
         }
+        if (mFiredEvents.empty()) {
+          continue;
+        }
+        for (auto iE : mFiredEvents) {
+          outTrigger[iE][channel.word] |= channel.bit;
+        }
+        mScalers->SetBinContent(channel.bin, mScalers->GetBinContent(channel.bin) + mFiredEvents.size());
+
+        // downscaling, random numbers are only drawn for the channels which are actually downscaled
+        std::size_t nSelected{0};
+        if (channel.downscaling >= 1.) {
+          for (auto iE : mFiredEvents) {
+            outDecision[iE][channel.word] |= channel.bit;
+          }
+          nSelected = mFiredEvents.size();
+        } else if (channel.downscaling > 0.) {
+          mRandomDraws.resize(mFiredEvents.size());
+          for (auto& draw : mRandomDraws) {
+            draw = mUniformGenerator(mGeneratorEngine);
+          }
+          for (std::size_t iF{0}; iF < mFiredEvents.size(); ++iF) {
+            if (mRandomDraws[iF] < channel.downscaling) {
+              outDecision[mFiredEvents[iF]][channel.word] |= channel.bit;
+              nSelected++;
+            }
+          }
+        }
+        mFiltered->SetBinContent(channel.bin, mFiltered->GetBinContent(channel.bin) + nSelected);
       }
     }
     mScalers->SetBinContent(1, mScalers->GetBinContent(1) + nEvents - startCollision);
     mFiltered->SetBinContent(1, mFiltered->GetBinContent(1) + nEvents - startCollision);
 
+    uint64_t nTriggered{0}, nSelected{0};
     for (uint64_t iE{0}; iE < outTrigger.size(); ++iE) {
       const auto& triggerWord{outTrigger[iE]};
-      bool triggered{false}, selected{false};
+      // only the fired bits are visited
       for (uint64_t iD{0}; iD < triggerWord.size(); ++iD) {
-        for (int iB{0}; iB < 64; ++iB) {
-          if (!(triggerWord[iD] & BIT(iB))) {
-            continue;
-          }
-          uint64_t xIndex{iD * 64 + iB};
-          for (uint64_t jD{0}; jD < triggerWord.size(); ++jD) {
-            for (int jB{0}; jB < 64; ++jB) {
-              uint64_t yIndex{jD * 64 + jB};
-              if (xIndex <= yIndex && triggerWord[jD] & BIT(jB)) {
-                mCovariance->Fill(iD * 64 + iB, jD * 64 + jB);
+        for (uint64_t xBits{triggerWord[iD]}; xBits; xBits &= xBits - 1) {
+          uint64_t xIndex{iD * 64 + std::countr_zero(xBits)};
+          for (uint64_t jD{iD}; jD < triggerWord.size(); ++jD) {
+            for (uint64_t yBits{triggerWord[jD]}; yBits; yBits &= yBits - 1) {
+              uint64_t yIndex{jD * 64 + std::countr_zero(yBits)};
+              if (xIndex <= yIndex) {
+                mCovariance->Fill(xIndex, yIndex);
               }
             }
           }
         }
-        triggered = triggered || triggerWord[iD];
-        selected = selected || outDecision[iE][iD];
       }
-      if (triggered) {
-        mScalers->Fill(mScalers->GetNbinsX() - 1);
+      if (triggerWord[0] || triggerWord[1]) {
+        nTriggered++;
       }
-      if (selected) {
-        mFiltered->Fill(mFiltered->GetNbinsX() - 1);
+      if (outDecision[iE][0] || outDecision[iE][1]) {
+        nSelected++;
       }
     }
+    mScalers->SetBinContent(mScalers->GetNbinsX(), mScalers->GetBinContent(mScalers->GetNbinsX()) + nTriggered);
+    mFiltered->SetBinContent(mFiltered->GetNbinsX(), mFiltered->GetBinContent(mFiltered->GetNbinsX()) + nSelected);
 
     if (outDecision.size() != static_cast<uint64_t>(nEvents)) {
       LOGF(fatal, "Inconsistent number of rows across Collision table and CEFP decision vector.");
@@ -429,6 +465,22 @@ struct centralEventFilterTask {
 
   std::mt19937_64 mGeneratorEngine;
   std::uniform_real_distribution<double> mUniformGenerator = std::uniform_real_distribution<double>(0., 1.);
+
+  // trigger channel, with everything run() needs resolved at init
+  struct TriggerChannel {
+    std::string column;
+    int bin;            // bin in mScalers and mFiltered
+    uint64_t word;      // word of the trigger and decision masks
+    uint64_t bit;       // bit of the channel in that word
+    double downscaling; // fraction of the triggered events which is kept
+  };
+  struct TriggerTable {
+    std::string name;
+    std::vector<TriggerChannel> channels;
+  };
+  std::vector<TriggerTable> mTriggerTables;
+  std::vector<int64_t> mFiredEvents; // events firing the channel being processed
+  std::vector<double> mRandomDraws;  // one uniform draw per fired event of a downscaled channel
 };
 
 WorkflowSpec defineDataProcessing(ConfigContext const& cfg)
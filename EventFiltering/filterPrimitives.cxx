@@ -0,0 +1,107 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file filterPrimitives.cxx
+/// \brief Trigger primitives computed once per data frame for all the software triggers of the workflow
+///
+/// The tracks are tagged in a single pass (quality, acceptance, selected and high pT, see filterprimitives::TrackTagBits)
+/// and the number of selected and high pT tracks and the leading selected track are counted per collision.
+/// The filters can join aod::FilterTrackTags with their tracks and aod::FilterCollPrimitives with their collisions
+/// instead of looping over the tracks of the collision to build the same quantities.
+
+#include "filterTables.h"
+
+#include <Framework/ASoA.h>
+#include <Framework/AnalysisDataModel.h>
+#include <Framework/AnalysisHelpers.h>
+#include <Framework/AnalysisTask.h>
+#include <Framework/Configurable.h>
+#include <Framework/InitContext.h>
+#include <Framework/runDataProcessing.h>
+
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+using namespace o2;
+using namespace o2::framework;
+using namespace o2::aod::filterprimitives;
+
+struct FilterPrimitives {
+  Produces<aod::FilterCollPrimitives> collPrimitives;
+  Produces<aod::FilterTrackTags> trackTags;
+
+  // the default quality cuts are the ones of the strangeness filter trigger particles
+  Configurable<int> minTPCCrossedRows{"minTPCCrossedRows", 50, "Minimum number of TPC crossed rows of the quality tracks"};
+  Configurable<float> maxTPCChi2NCl{"maxTPCChi2NCl", 4.f, "Maximum TPC chi2 per cluster of the quality tracks"};
+  Configurable<float> maxITSChi2NCl{"maxITSChi2NCl", 36.f, "Maximum ITS chi2 per cluster of the quality tracks"};
+  Configurable<bool> requireITSInnerBarrel{"requireITSInnerBarrel", true, "Require a hit in the inner barrel layers of the quality tracks"};
+  Configurable<float> maxEta{"maxEta", 0.9f, "Maximum |eta| of the tracks in acceptance"};
+  Configurable<float> minPt{"minPt", 0.15f, "Minimum pT of the selected tracks"};
+  Configurable<float> minHighPt{"minHighPt", 5.f, "Minimum pT of the high pT tracks"};
+
+  using Tracks = soa::Join<aod::TracksIU, aod::TracksExtra>;
+
+  struct CollisionCounters {
+    uint16_t nSelected = 0;
+    uint16_t nHighPt = 0;
+    float leadingPt = -1.f;
+    int leadingId = -1;
+  };
+  std::vector<CollisionCounters> counters;
+
+  void init(InitContext&) {}
+
+  void process(aod::Collisions const& collisions, Tracks const& tracks)
+  {
+    counters.assign(collisions.size(), CollisionCounters{});
+    trackTags.reserve(tracks.size());
+    for (auto const& track : tracks) {
+      uint8_t tag = 0;
+      auto setBit = [&tag](int bit) { tag |= static_cast<uint8_t>(1) << bit; };
+      if (track.tpcNClsCrossedRows() >= minTPCCrossedRows && track.tpcChi2NCl() <= maxTPCChi2NCl && track.itsChi2NCl() <= maxITSChi2NCl &&
+          (!requireITSInnerBarrel || (track.itsClusterMap() & 0x7) != 0)) {
+        setBit(kQualityTrack);
+      }
+      if (std::abs(track.eta()) < maxEta) {
+        setBit(kInAcceptance);
+      }
+      if ((tag & (1 << kQualityTrack)) && (tag & (1 << kInAcceptance)) && track.pt() > minPt) {
+        setBit(kSelectedTrack);
+        if (track.pt() > minHighPt) {
+          setBit(kHighPtTrack);
+        }
+        if (track.has_collision()) {
+          auto& counter = counters[track.collisionId()];
+          counter.nSelected++;
+          if (tag & (1 << kHighPtTrack)) {
+            counter.nHighPt++;
+          }
+          if (track.pt() > counter.leadingPt) {
+            counter.leadingPt = track.pt();
+            counter.leadingId = track.globalIndex();
+          }
+        }
+      }
+      trackTags(tag);
+    }
+
+    collPrimitives.reserve(collisions.size());
+    for (auto const& counter : counters) {
+      collPrimitives(counter.nSelected, counter.nHighPt, counter.leadingPt, counter.leadingId);
+    }
+  }
+};
+
+WorkflowSpec defineDataProcessing(ConfigContext const& cfgc)
+{
+  return WorkflowSpec{adaptAnalysisTask<FilterPrimitives>(cfgc)};
+}
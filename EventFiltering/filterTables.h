@@ -244,6 +244,24 @@ DECLARE_SOA_COLUMN(BCend, hasBCend, uint64_t);     //! CEFP bcrange
 
 } // namespace bcrange
 
+namespace filterprimitives
+{
+/// bits of the per track tags of the filter-primitives task
+enum TrackTagBits : uint8_t {
+  kQualityTrack = 0, // TPC crossed rows, TPC and ITS chi2 and inner barrel hit
+  kInAcceptance,     // |eta| below the configured limit
+  kSelectedTrack,    // quality track in acceptance above the minimum pT
+  kHighPtTrack       // selected track above the high pT threshold
+};
+DECLARE_SOA_COLUMN(TrackTag, trackTag, uint8_t);                //! bits of TrackTagBits
+DECLARE_SOA_COLUMN(NSelectedTracks, nSelectedTracks, uint16_t); //! number of selected tracks of the collision
+DECLARE_SOA_COLUMN(NHighPtTracks, nHighPtTracks, uint16_t);     //! number of high pT selected tracks of the collision
+DECLARE_SOA_COLUMN(LeadingTrackPt, leadingTrackPt, float);      //! pT of the leading selected track, -1 if none
+DECLARE_SOA_COLUMN(LeadingTrackId, leadingTrackId, int);        //! global index of the leading selected track, -1 if none
+DECLARE_SOA_DYNAMIC_COLUMN(HasTrackTag, hasTrackTag, //! check a bit of TrackTagBits
+                           [](uint8_t tag, int bit) -> bool { return (tag & (static_cast<uint8_t>(1) << bit)) > 0; });
+} // namespace filterprimitives
+
 // nuclei
 DECLARE_SOA_TABLE(NucleiFilters, "AOD", "NucleiFilters", //!
                   filtering::H2, filtering::He, filtering::HeV0, filtering::TritonFemto, filtering::H3L3Body, filtering::Tracked3Body, filtering::ITSmildIonisation,
@@ -387,6 +405,15 @@ DECLARE_SOA_TABLE(BCRanges, "AOD", "BCRanges", //!
                   bcrange::BCstart, bcrange::BCend);
 using BCRange = BCRanges::iterator;
 
+// trigger primitives computed once for all the filters, joinable with the collisions and the tracks tables
+DECLARE_SOA_TABLE(FilterCollPrimitives, "AOD", "FiltCollPrims", //!
+                  filterprimitives::NSelectedTracks, filterprimitives::NHighPtTracks, filterprimitives::LeadingTrackPt, filterprimitives::LeadingTrackId);
+using FilterCollPrimitive = FilterCollPrimitives::iterator;
+
+DECLARE_SOA_TABLE(FilterTrackTags, "AOD", "FiltTrackTags", //!
+                  filterprimitives::TrackTag, filterprimitives::HasTrackTag<filterprimitives::TrackTag>);
+using FilterTrackTag = FilterTrackTags::iterator;
+
 /// List of the available filters, the description of their tables and the name of the tasks
 constexpr int NumberOfFilters{16};
 constexpr std::array<char[32], NumberOfFilters> AvailableFilters{"NucleiFilters", "DiffractionFilters", "DqFilters", "HfFilters", "CFFilters", "JetFilters", "JetHFFilters", "FullJetFilters", "StrangenessFilters", "MultFilters", "PhotonFilters", "F1ProtonFilters", "DoublePhiFilters", "HeavyNeutralMesonFilters", "GlobalDimuonFilters", "H2fromLbFilters"};
@@ -9,6 +9,7 @@
 // granted to it by virtue of its status as an Intergovernmental Organization
 // or submit itself to any jurisdiction.
 
+#include "BCRangeMerger.h"
 #include "filterTables.h"
 
 #include "Common/DataModel/EventSelection.h"
@@ -22,6 +23,7 @@
 #include <Framework/AnalysisTask.h>
 #include <Framework/Configurable.h>
 #include <Framework/DataProcessorSpec.h>
+#include <Framework/InitContext.h>
 #include <Framework/Logger.h>
 #include <Framework/ProcessingContext.h>
 #include <Framework/TableConsumer.h>
@@ -30,6 +32,7 @@
 #include <algorithm>
 #include <cstdint>
 #include <stdexcept>
+#include <string>
 #include <vector>
 
 using namespace o2;
@@ -41,12 +44,25 @@ struct BCRangeSelector {
   Configurable<int> nTimeRes{"nTimeRes", 4, "Range to consider for search of compatible BCs in units of vertex-time-resolution."};
   Configurable<int> nMinBCs{"nMinBCs", 7, "Minimum width of time window to consider for search of compatible BCs in units of 2*BunchSpacing."};
   Configurable<double> fillFac{"fillFactor", 0.0, "Factor of MB events to add"};
+  Configurable<int> padding{"padding", 0, "Number of BCs added on both sides of every range before merging"};
+  Configurable<bool> mergeAdjacent{"mergeAdjacent", false, "Merge also the ranges which only touch each other"};
+  Configurable<bool> mergeAcrossDFs{"mergeAcrossDFs", false, "Remember the ranges of the previous data frame and drop the BCs already written"};
+  Configurable<std::string> bitmapFile{"bitmapFile", "", "If not empty, append the selected BCs of every data frame to this file as a bitmap"};
 
   using CCs = soa::Join<aod::Collisions, aod::EvSels>;
 
   // buffer for task output
   Produces<aod::BCRanges> tags;
 
+  o2::eventfiltering::BCRangeMerger merger;
+
+  void init(InitContext&)
+  {
+    merger.setPadding(std::max(padding.value, 0));
+    merger.setMergeAdjacent(mergeAdjacent);
+    merger.setStreaming(mergeAcrossDFs);
+  }
+
   template <typename T>
   IRFrame getIRFrame(T& collision)
   {
@@ -120,22 +136,17 @@ struct BCRangeSelector {
     }
 
     /// We cannot merge the ranges in the previous loop because while collisions are sorted by time, the corresponding minBCs can be unsorted as the collision time resolution is not constant
-    std::sort(bcRanges.begin(), bcRanges.end(), [](const IRFrame& a, const IRFrame& b) {
-      return a.getMin() < b.getMin();
-    });
-
-    std::vector<IRFrame> bcRangesMerged(1, bcRanges[0]);
-    for (uint64_t iR{1}; iR < bcRanges.size(); ++iR) {
-      if (bcRangesMerged.back().getMax() >= bcRanges[iR].getMin()) {
-        bcRangesMerged.back().getMax() = std::max(bcRangesMerged.back().getMax(), bcRanges[iR].getMax());
-      } else {
-        bcRangesMerged.push_back(bcRanges[iR]);
-      }
+    merger.clear();
+    for (auto& range : bcRanges) {
+      merger.add(range.getMin().toLong(), range.getMax().toLong());
     }
-    bcRanges.swap(bcRangesMerged);
+    merger.merge();
 
-    for (auto& range : bcRanges) {
-      tags(range.getMin().toLong(), range.getMax().toLong());
+    for (const auto& range : merger.getRanges()) {
+      tags(range.getMin(), range.getMax());
+    }
+    if (!bitmapFile.value.empty() && !merger.writeBitmap(bitmapFile.value)) {
+      LOGF(error, "Cannot write the BC bitmap to %s", bitmapFile.value);
     }
   }
 
@@ -0,0 +1,81 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#ifndef PWGCF_CORE_EBYEMOMENTPROFILES_H_
+#define PWGCF_CORE_EBYEMOMENTPROFILES_H_
+
+// moments <x^k> of an event-wise quantity vs. centrality, for the event-by-event fluctuation tasks
+
+#include "PWGCF/GenericFramework/Core/ProfileFill.h"
+
+#include <TAxis.h>
+#include <TProfile.h>
+#include <TProfile2D.h>
+
+#include <array>
+#include <cstddef>
+#include <memory>
+
+namespace o2::analysis::ebye
+{
+
+// sums[k] += w^k for k = 1..N - 1, by running multiplication (sums[0] is left untouched), e.g. the power sums of the
+// inverse efficiencies of the selected tracks
+template <typename T, std::size_t N>
+inline void addPowerSums(std::array<T, N>& sums, double w)
+{
+  double wk = 1.;
+  for (std::size_t k = 1; k < N; k++) {
+    wk *= w;
+    sums[k] += wk;
+  }
+}
+
+// Profiles of x, x^2, ..., x^NOrders vs. centrality, and the same moments per bootstrap subsample in TProfile2D with
+// the subsample on the y axis. The profiles of all the orders share the same axes: the profiles are given once in
+// init, the powers are computed by running multiplication and the bins are found once per event for all the orders.
+// The profiles are filled as TProfile(2D)::Fill does.
+template <int NOrders>
+class EbyEMomentProfiles
+{
+ public:
+  void setProfile(int order, std::shared_ptr<TProfile> const& prof) { mProfiles[order - 1] = prof; }
+  void setSubsampleProfile(int order, std::shared_ptr<TProfile2D> const& prof) { mSubsampleProfiles[order - 1] = prof; }
+
+  void fill(double cent, double x)
+  {
+    const Int_t binx = mProfiles[0]->GetXaxis()->FindBin(cent);
+    double xk = 1.;
+    for (auto const& prof : mProfiles) {
+      xk *= x;
+      profile_fill::fillAtBin(prof.get(), binx, cent, xk, 1.);
+    }
+  }
+
+  void fillSubsample(double cent, int sampleIndex, double x)
+  {
+    const Int_t binx = mSubsampleProfiles[0]->GetXaxis()->FindBin(cent);
+    const Int_t biny = mSubsampleProfiles[0]->GetYaxis()->FindBin(sampleIndex);
+    double xk = 1.;
+    for (auto const& prof : mSubsampleProfiles) {
+      xk *= x;
+      profile_fill::fillAtBin(prof.get(), binx, biny, cent, sampleIndex, xk, 1.);
+    }
+  }
+
+ private:
+  std::array<std::shared_ptr<TProfile>, NOrders> mProfiles;
+  std::array<std::shared_ptr<TProfile2D>, NOrders> mSubsampleProfiles;
+};
+
+} // namespace o2::analysis::ebye
+
+#endif // PWGCF_CORE_EBYEMOMENTPROFILES_H_
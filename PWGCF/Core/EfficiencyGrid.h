@@ -0,0 +1,124 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#ifndef PWGCF_CORE_EFFICIENCYGRID_H_
+#define PWGCF_CORE_EFFICIENCYGRID_H_
+
+// dense copy of an efficiency THn (eta, pt, multiplicity, vertex) for fast lookups
+
+#include <Framework/Logger.h>
+
+#include <TArrayD.h>
+#include <TAxis.h>
+#include <THn.h>
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+// The content of the THn, under- and overflow bins included, is copied into a flat float array at load time.
+// Bins are found as TAxis::FindBin does, so the lookup returns the same value as THn::GetBinContent.
+// The multiplicity and vertex part of the index is computed once per event with getEventOffset.
+class EfficiencyGrid
+{
+ public:
+  static constexpr int NAxes = 4; // eta, pt, multiplicity, vertex
+
+  void init(THn* eff)
+  {
+    mContent.clear();
+    if (eff == nullptr || eff->GetNdimensions() != NAxes) {
+      LOGF(warning, "EfficiencyGrid: efficiency histogram with %d dimensions, %d are expected. The THn is used directly.", eff ? eff->GetNdimensions() : 0, NAxes);
+      return;
+    }
+    int64_t size = 1;
+    for (int i = NAxes - 1; i >= 0; i--) {
+      mAxes[i].init(eff->GetAxis(i));
+      mAxes[i].stride = size;
+      size *= mAxes[i].nBins + 2;
+    }
+    mContent.resize(size);
+    std::array<int, NAxes> bins{};
+    for (int64_t index = 0; index < size; index++) {
+      int64_t rest = index;
+      for (int i = 0; i < NAxes; i++) {
+        bins[i] = rest / mAxes[i].stride;
+        rest %= mAxes[i].stride;
+      }
+      mContent[index] = eff->GetBinContent(bins.data());
+    }
+    LOGF(info, "EfficiencyGrid: %s converted into a grid of %ld bins", eff->GetName(), size);
+  }
+
+  bool isInitialized() const { return !mContent.empty(); }
+
+  int64_t getEventOffset(float multiplicity, float posZ) const
+  {
+    return mAxes[2].findBin(multiplicity) * mAxes[2].stride + mAxes[3].findBin(posZ) * mAxes[3].stride;
+  }
+
+  float get(int64_t eventOffset, float eta, float pt) const
+  {
+    return mContent[eventOffset + mAxes[0].findBin(eta) * mAxes[0].stride + mAxes[1].findBin(pt) * mAxes[1].stride];
+  }
+
+  float get(float eta, float pt, float multiplicity, float posZ) const { return get(getEventOffset(multiplicity, posZ), eta, pt); }
+
+  // efficiencies of the tracks of one event, in one pass
+  void fill(int64_t eventOffset, std::span<const float> eta, std::span<const float> pt, std::vector<float>& out) const
+  {
+    out.resize(eta.size());
+    for (std::size_t i = 0; i < eta.size(); i++) {
+      out[i] = get(eventOffset, eta[i], pt[i]);
+    }
+  }
+
+ private:
+  struct Axis {
+    int nBins = 0;
+    double min = 0., max = 0.;
+    std::vector<double> edges; // only for variable bin widths
+    int64_t stride = 1;
+
+    void init(const TAxis* axis)
+    {
+      nBins = axis->GetNbins();
+      min = axis->GetXmin();
+      max = axis->GetXmax();
+      edges.clear();
+      if (axis->GetXbins()->GetSize() > 0) {
+        edges.assign(axis->GetXbins()->GetArray(), axis->GetXbins()->GetArray() + axis->GetXbins()->GetSize());
+      }
+    }
+
+    // same as TAxis::FindBin: 0 for underflow, nBins + 1 for overflow
+    int findBin(double x) const
+    {
+      if (x < min) {
+        return 0;
+      }
+      if (!(x < max)) {
+        return nBins + 1;
+      }
+      if (edges.empty()) {
+        return 1 + static_cast<int>(nBins * (x - min) / (max - min));
+      }
+      return std::upper_bound(edges.begin(), edges.end(), x) - edges.begin();
+    }
+  };
+
+  std::array<Axis, NAxes> mAxes;
+  std::vector<float> mContent;
+};
+
+#endif // PWGCF_CORE_EFFICIENCYGRID_H_
@@ -0,0 +1,186 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#ifndef PWGCF_CORE_PAIRHISTFILLPLAN_H_
+#define PWGCF_CORE_PAIRHISTFILLPLAN_H_
+
+// fill of the pair histogram of a CorrelationContainer with the per-event and per-trigger axes binned once
+
+#include <Framework/HistogramSpec.h>
+#include <Framework/Logger.h>
+#include <Framework/StepTHn.h>
+
+#include <TArrayF.h>
+
+#include <Rtypes.h>
+#include <RtypesCore.h>
+
+#include <algorithm>
+#include <vector>
+
+// The pair histogram has the axes delta_eta, pt_assoc, pt_trig, multiplicity/centrality, delta_phi, vertex.
+// Multiplicity and vertex are binned in setEvent, pt_trig in setTrigger, and fill only bins delta_eta, pt_assoc
+// and delta_phi before adding the weight to the flat bin array of the StepTHn. The bins are found as TAxis::FindBin
+// does, so the content is the same as with StepTHn::Fill. User axes are not supported.
+class PairHistFillPlan
+{
+ public:
+  void init(StepTHn* pairHist, const std::vector<o2::framework::AxisSpec>& pairAxes)
+  {
+    mPairHist = nullptr;
+    if (pairHist == nullptr || pairAxes.size() != NAxes) {
+      LOGF(warning, "PairHistFillPlan: %zu axes in the pair histogram, only %d are supported. The StepTHn is filled directly.", pairAxes.size(), NAxes);
+      return;
+    }
+    for (int i = 0; i < NAxes; i++) {
+      mAxes[i].init(pairAxes[i]);
+    }
+    Long64_t stride = 1;
+    for (int i = NAxes - 1; i >= 0; i--) { // the first axis is the slowest one in StepTHn
+      mAxes[i].stride = stride;
+      stride *= mAxes[i].nBins;
+    }
+    mPairHist = pairHist;
+  }
+
+  bool isInitialized() const { return mPairHist != nullptr; }
+  StepTHn* getPairHist() const { return mPairHist; }
+
+  // returns false if the event is out of the multiplicity or vertex range, then no pair is filled
+  bool setEvent(int step, float multiplicity, float posZ)
+  {
+    mStep = step;
+    mMultiplicity = multiplicity;
+    mPosZ = posZ;
+    updateArrays();
+    int binMult = mAxes[AxisMult].findBin(multiplicity);
+    int binVertex = mAxes[AxisVertex].findBin(posZ);
+    mIsEventInRange = mAxes[AxisMult].isInRange(binMult) && mAxes[AxisVertex].isInRange(binVertex);
+    mEventOffset = (binMult - 1) * mAxes[AxisMult].stride + (binVertex - 1) * mAxes[AxisVertex].stride;
+    return mIsEventInRange;
+  }
+
+  void setTrigger(float ptTrigger)
+  {
+    mPtTrigger = ptTrigger;
+    int binPtTrigger = mAxes[AxisPtTrigger].findBin(ptTrigger);
+    mIsTriggerInRange = mIsEventInRange && mAxes[AxisPtTrigger].isInRange(binPtTrigger);
+    mTriggerOffset = mEventOffset + (binPtTrigger - 1) * mAxes[AxisPtTrigger].stride;
+  }
+
+  void fill(float deltaEta, float ptAssoc, float deltaPhi, float weight)
+  {
+    if (!mIsTriggerInRange) {
+      return;
+    }
+    if (mValues == nullptr || (mSumw2 == nullptr && weight != 1.)) {
+      // the arrays of the step are created by StepTHn itself
+      mPairHist->Fill(mStep, deltaEta, ptAssoc, mPtTrigger, mMultiplicity, deltaPhi, mPosZ, weight);
+      updateArrays();
+      return;
+    }
+    int binDeltaEta = mAxes[AxisDeltaEta].findBin(deltaEta);
+    int binPtAssoc = mAxes[AxisPtAssoc].findBin(ptAssoc);
+    int binDeltaPhi = mAxes[AxisDeltaPhi].findBin(deltaPhi);
+    if (!mAxes[AxisDeltaEta].isInRange(binDeltaEta) || !mAxes[AxisPtAssoc].isInRange(binPtAssoc) || !mAxes[AxisDeltaPhi].isInRange(binDeltaPhi)) {
+      return;
+    }
+    Long64_t bin = mTriggerOffset + (binDeltaEta - 1) * mAxes[AxisDeltaEta].stride + (binPtAssoc - 1) * mAxes[AxisPtAssoc].stride + (binDeltaPhi - 1) * mAxes[AxisDeltaPhi].stride;
+    mValues[bin] += weight;
+    if (mSumw2 != nullptr) {
+      mSumw2[bin] += weight * weight;
+    }
+  }
+
+ private:
+  enum PairAxis { AxisDeltaEta = 0,
+                  AxisPtAssoc,
+                  AxisPtTrigger,
+                  AxisMult,
+                  AxisDeltaPhi,
+                  AxisVertex,
+                  NAxes };
+
+  struct Axis {
+    int nBins = 0;
+    double min = 0., max = 0.;
+    std::vector<double> edges; // only for variable bin widths
+    std::vector<int> lut;      // for variable bin widths, bin at the lower edge of uniform cells
+    double cellsPerUnit = 0.;
+    Long64_t stride = 1;
+
+    void init(const o2::framework::AxisSpec& spec)
+    {
+      edges.clear();
+      lut.clear();
+      if (spec.nBins.has_value()) {
+        nBins = *spec.nBins;
+        min = spec.binEdges.front();
+        max = spec.binEdges.back();
+        return;
+      }
+      edges = spec.binEdges;
+      nBins = edges.size() - 1;
+      min = edges.front();
+      max = edges.back();
+      const int nCells = 4 * nBins;
+      cellsPerUnit = nCells / (max - min);
+      lut.resize(nCells);
+      for (int cell = 0; cell < nCells; cell++) {
+        lut[cell] = std::upper_bound(edges.begin(), edges.end(), min + cell / cellsPerUnit) - edges.begin();
+      }
+    }
+
+    // same as TAxis::FindBin: 0 for underflow, nBins + 1 for overflow
+    int findBin(double x) const
+    {
+      if (x < min) {
+        return 0;
+      }
+      if (!(x < max)) {
+        return nBins + 1;
+      }
+      if (edges.empty()) {
+        return 1 + static_cast<int>(nBins * (x - min) / (max - min));
+      }
+      int cell = std::clamp(static_cast<int>((x - min) * cellsPerUnit), 0, static_cast<int>(lut.size()) - 1);
+      int bin = lut[cell];
+      while (bin > 1 && x < edges[bin - 1]) {
+        bin--;
+      }
+      while (bin < nBins && !(x < edges[bin])) {
+        bin++;
+      }
+      return bin;
+    }
+
+    bool isInRange(int bin) const { return bin >= 1 && bin <= nBins; }
+  };
+
+  void updateArrays()
+  {
+    auto* values = dynamic_cast<TArrayF*>(mPairHist->getValues(mStep));
+    auto* sumw2 = dynamic_cast<TArrayF*>(mPairHist->getSumw2(mStep));
+    mValues = values ? values->GetArray() : nullptr;
+    mSumw2 = sumw2 ? sumw2->GetArray() : nullptr;
+  }
+
+  StepTHn* mPairHist = nullptr;
+  Axis mAxes[NAxes];
+  int mStep = 0;
+  float mMultiplicity = 0.f, mPosZ = 0.f, mPtTrigger = 0.f;
+  bool mIsEventInRange = false, mIsTriggerInRange = false;
+  Long64_t mEventOffset = 0, mTriggerOffset = 0;
+  Float_t* mValues = nullptr;
+  Float_t* mSumw2 = nullptr;
+};
+
+#endif // PWGCF_CORE_PAIRHISTFILLPLAN_H_
@@ -0,0 +1,137 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#ifndef PWGCF_CORE_PAIRKINEMATICS_H_
+#define PWGCF_CORE_PAIRKINEMATICS_H_
+
+// pair kinematics of the femtoscopic analyses (k*, kT, mT, q_inv, q_out/side/long) without 4-vector classes
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <span>
+
+// The momenta are converted once to Cartesian components and all the pair variables are computed from them with
+// plain arithmetic, instead of building, adding and boosting ROOT 4-vectors for every variable. The computation is
+// done in double precision, as the ROOT::Math vectors do, the interface is float.
+namespace o2::analysis::pairkinematics
+{
+
+struct Momentum {
+  double px = 0., py = 0., pz = 0., e = 0.;
+  double m = 0.;
+};
+
+inline Momentum fromPtEtaPhiM(double pt, double eta, double phi, double m)
+{
+  Momentum p;
+  p.px = pt * std::cos(phi);
+  p.py = pt * std::sin(phi);
+  p.pz = pt * std::sinh(eta);
+  p.e = std::sqrt(p.px * p.px + p.py * p.py + p.pz * p.pz + m * m);
+  p.m = m;
+  return p;
+}
+
+inline Momentum fromPxPyPzM(double px, double py, double pz, double m)
+{
+  return Momentum{px, py, pz, std::sqrt(px * px + py * py + pz * pz + m * m), m};
+}
+
+struct Pair {
+  float kstar = 0.f; // relative momentum in the pair rest frame
+  float kt = 0.f;    // half of the pair transverse momentum
+  float mt = 0.f;    // half of the pair transverse mass, sqrt(E^2 - pz^2) / 2
+  float minv = 0.f;  // invariant mass
+  float qinv = 0.f;  // sqrt(-(p1 - p2)^2), 2 k* for equal masses
+};
+
+// Bertsch-Pratt components of p1 - p2 in the longitudinally comoving system, out along the pair kT
+struct PairLCMS {
+  float qout = 0.f, qside = 0.f, qlong = 0.f;
+};
+
+// k* from the Kaellen function, k* = sqrt(lambda(s, m1^2, m2^2) / s) / 2
+inline Pair computePair(Momentum const& p1, Momentum const& p2)
+{
+  const double sumPx = p1.px + p2.px;
+  const double sumPy = p1.py + p2.py;
+  const double sumPz = p1.pz + p2.pz;
+  const double sumE = p1.e + p2.e;
+  const double s = sumE * sumE - (sumPx * sumPx + sumPy * sumPy + sumPz * sumPz);
+  const double m1sq = p1.e * p1.e - (p1.px * p1.px + p1.py * p1.py + p1.pz * p1.pz);
+  const double m2sq = p2.e * p2.e - (p2.px * p2.px + p2.py * p2.py + p2.pz * p2.pz);
+  const double kallen = (s - m1sq - m2sq) * (s - m1sq - m2sq) - 4.0 * m1sq * m2sq;
+
+  const double dPx = p1.px - p2.px;
+  const double dPy = p1.py - p2.py;
+  const double dPz = p1.pz - p2.pz;
+  const double dE = p1.e - p2.e;
+  const double qsq = dPx * dPx + dPy * dPy + dPz * dPz - dE * dE;
+
+  const double mtsq = sumE * sumE - sumPz * sumPz;
+
+  Pair pair;
+  pair.kstar = static_cast<float>(0.5 * std::sqrt(std::max(0.0, kallen) / s));
+  pair.kt = static_cast<float>(0.5 * std::sqrt(sumPx * sumPx + sumPy * sumPy));
+  pair.mt = static_cast<float>(0.5 * (mtsq < 0. ? -std::sqrt(-mtsq) : std::sqrt(mtsq)));
+  pair.minv = static_cast<float>(s < 0. ? -std::sqrt(-s) : std::sqrt(s));
+  pair.qinv = static_cast<float>(std::sqrt(std::max(0.0, qsq)));
+  return pair;
+}
+
+// returns zeros for a pair without transverse momentum or transverse mass, like the former implementations
+inline PairLCMS computeLCMS(Momentum const& p1, Momentum const& p2)
+{
+  constexpr double MinTransverseMomentum = 1e-9;
+  const double tPx = p1.px + p2.px;
+  const double tPy = p1.py + p2.py;
+  const double tPz = p1.pz + p2.pz;
+  const double tE = p1.e + p2.e;
+  const double tPt = std::sqrt(tPx * tPx + tPy * tPy);
+  const double tMt = std::sqrt(tE * tE - tPz * tPz);
+  if (tPt < MinTransverseMomentum || tMt < MinTransverseMomentum) {
+    return {};
+  }
+  const double betaL = tPz / tE;
+  const double gammaL = tE / tMt;
+
+  const double kout1 = (p1.px * tPx + p1.py * tPy) / tPt;
+  const double kside1 = (-p1.px * tPy + p1.py * tPx) / tPt;
+  const double klong1 = gammaL * (p1.pz - betaL * p1.e);
+
+  const double kout2 = (p2.px * tPx + p2.py * tPy) / tPt;
+  const double kside2 = (p2.py * tPx - p2.px * tPy) / tPt;
+  const double klong2 = gammaL * (p2.pz - betaL * p2.e);
+
+  return {static_cast<float>(kout1 - kout2), static_cast<float>(kside1 - kside2), static_cast<float>(klong1 - klong2)};
+}
+
+// pair lists, e.g. all the mixed pairs of an event with its pool: out[i] is the pair (first[i], second[i])
+inline void computePairs(std::span<const Momentum> first, std::span<const Momentum> second, std::span<Pair> out)
+{
+  const std::size_t n = std::min({first.size(), second.size(), out.size()});
+  for (std::size_t i = 0; i < n; i++) {
+    out[i] = computePair(first[i], second[i]);
+  }
+}
+
+inline void computeLCMS(std::span<const Momentum> first, std::span<const Momentum> second, std::span<PairLCMS> out)
+{
+  const std::size_t n = std::min({first.size(), second.size(), out.size()});
+  for (std::size_t i = 0; i < n; i++) {
+    out[i] = computeLCMS(first[i], second[i]);
+  }
+}
+
+} // namespace o2::analysis::pairkinematics
+
+#endif // PWGCF_CORE_PAIRKINEMATICS_H_
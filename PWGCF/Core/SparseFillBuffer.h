@@ -0,0 +1,251 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#ifndef PWGCF_CORE_SPARSEFILLBUFFER_H_
+#define PWGCF_CORE_SPARSEFILLBUFFER_H_
+
+// fill buffer of a THnSparse, sparse per chunk of bins and dense once the chunk is filled enough
+
+#include <Framework/Logger.h>
+
+#include <TArrayD.h>
+#include <TAxis.h>
+#include <THnSparse.h>
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <unordered_map>
+#include <vector>
+
+// The fills are accumulated per global bin (under- and overflow included, as THnSparse stores them) and written
+// into the THnSparse with flush, so each occupied bin costs one THnSparse lookup per flush instead of one per fill.
+// The global bins are grouped in chunks of 2^chunkBits bins. The bins of a chunk are kept in a hash map until more
+// than denseFraction of the chunk is occupied, then the chunk moves to a dense array. Only occupied chunks are
+// stored, and only occupied bins are written. Independent buffers of the same histogram, e.g. one per thread, are
+// combined with merge before the flush. The flush takes care of the content, the sum of squared weights and the
+// number of entries; the sums of weights kept by THnBase for the statistics are not updated.
+class SparseFillBuffer
+{
+ public:
+  static constexpr int MaxDimensions = 16;
+
+  void init(THnSparse* hist, int chunkBits = 10, float denseFraction = 0.25f, int64_t maxBufferedBins = 1 << 22)
+  {
+    mHist = nullptr;
+    clear();
+    if (hist == nullptr || hist->GetNdimensions() > MaxDimensions) {
+      LOGF(warning, "SparseFillBuffer: no histogram or more than %d dimensions. The THnSparse is filled directly.", MaxDimensions);
+      return;
+    }
+    mNDimensions = hist->GetNdimensions();
+    int64_t stride = 1;
+    for (int i = mNDimensions - 1; i >= 0; i--) {
+      mAxes[i].init(hist->GetAxis(i));
+      mAxes[i].stride = stride;
+      if (stride > std::numeric_limits<int64_t>::max() / (mAxes[i].nBins + 2)) {
+        LOGF(warning, "SparseFillBuffer: %s has too many bins for a 64 bit index. The THnSparse is filled directly.", hist->GetName());
+        return;
+      }
+      stride *= mAxes[i].nBins + 2;
+    }
+    mChunkBits = std::clamp(chunkBits, 4, 20);
+    mDenseThreshold = std::max(1, static_cast<int>(denseFraction * (1 << mChunkBits)));
+    mMaxBufferedBins = maxBufferedBins;
+    mHist = hist;
+  }
+
+  bool isInitialized() const { return mHist != nullptr; }
+
+  template <typename... Ts>
+  void fill(Ts... values)
+  {
+    static_assert(sizeof...(Ts) <= MaxDimensions, "Too many dimensions");
+    const std::array<double, sizeof...(Ts)> x{static_cast<double>(values)...};
+    int64_t bin = 0;
+    for (std::size_t i = 0; i < x.size(); i++) {
+      bin += mAxes[i].findBin(x[i]) * mAxes[i].stride;
+    }
+    mEntries++;
+    add(bin, 1., 1.);
+  }
+
+  void fillWeighted(const double* x, double weight)
+  {
+    int64_t bin = 0;
+    for (int i = 0; i < mNDimensions; i++) {
+      bin += mAxes[i].findBin(x[i]) * mAxes[i].stride;
+    }
+    mEntries++;
+    add(bin, weight, weight * weight);
+  }
+
+  // adds the content of a buffer of the same histogram and clears it
+  void merge(SparseFillBuffer& other)
+  {
+    if (other.mNDimensions != mNDimensions || other.mChunkBits != mChunkBits) {
+      LOGF(fatal, "SparseFillBuffer: buffers with different binning cannot be merged");
+    }
+    mEntries += other.mEntries;
+    for (const auto& [bin, entry] : other.mSparseBins) {
+      add(bin, entry.content, entry.sumw2);
+    }
+    for (const auto& [chunk, dense] : other.mDenseChunks) {
+      for (int offset = 0; offset < (1 << mChunkBits); offset++) {
+        if (dense.content[offset] != 0. || dense.sumw2[offset] != 0.) {
+          add((chunk << mChunkBits) + offset, dense.content[offset], dense.sumw2[offset]);
+        }
+      }
+    }
+    other.clear();
+  }
+
+  void flush()
+  {
+    if (mHist == nullptr || mEntries == 0) {
+      return;
+    }
+    const double entries = mHist->GetEntries();
+    for (const auto& [bin, entry] : mSparseBins) {
+      write(bin, entry.content, entry.sumw2);
+    }
+    for (const auto& [chunk, dense] : mDenseChunks) {
+      for (int offset = 0; offset < (1 << mChunkBits); offset++) {
+        if (dense.content[offset] != 0. || dense.sumw2[offset] != 0.) {
+          write((chunk << mChunkBits) + offset, dense.content[offset], dense.sumw2[offset]);
+        }
+      }
+    }
+    mHist->SetEntries(entries + mEntries);
+    clear();
+  }
+
+  void clear()
+  {
+    mSparseBins.clear();
+    mSparseBinsPerChunk.clear();
+    mDenseChunks.clear();
+    mEntries = 0;
+  }
+
+ private:
+  struct Entry {
+    double content = 0.;
+    double sumw2 = 0.;
+  };
+
+  struct DenseChunk {
+    std::vector<double> content;
+    std::vector<double> sumw2;
+  };
+
+  struct Axis {
+    int nBins = 0;
+    double min = 0., max = 0.;
+    std::vector<double> edges; // only for variable bin widths
+    int64_t stride = 1;
+
+    void init(const TAxis* axis)
+    {
+      nBins = axis->GetNbins();
+      min = axis->GetXmin();
+      max = axis->GetXmax();
+      edges.clear();
+      if (axis->GetXbins()->GetSize() > 0) {
+        edges.assign(axis->GetXbins()->GetArray(), axis->GetXbins()->GetArray() + axis->GetXbins()->GetSize());
+      }
+    }
+
+    // same as TAxis::FindBin: 0 for underflow, nBins + 1 for overflow
+    int findBin(double x) const
+    {
+      if (x < min) {
+        return 0;
+      }
+      if (!(x < max)) {
+        return nBins + 1;
+      }
+      if (edges.empty()) {
+        return 1 + static_cast<int>(nBins * (x - min) / (max - min));
+      }
+      return std::upper_bound(edges.begin(), edges.end(), x) - edges.begin();
+    }
+  };
+
+  void add(int64_t bin, double content, double sumw2)
+  {
+    const int64_t chunk = bin >> mChunkBits;
+    const int offset = bin & ((int64_t{1} << mChunkBits) - 1);
+    auto dense = mDenseChunks.find(chunk);
+    if (dense != mDenseChunks.end()) {
+      dense->second.content[offset] += content;
+      dense->second.sumw2[offset] += sumw2;
+      return;
+    }
+    auto [entry, isNew] = mSparseBins.try_emplace(bin);
+    entry->second.content += content;
+    entry->second.sumw2 += sumw2;
+    if (isNew && ++mSparseBinsPerChunk[chunk] > mDenseThreshold) {
+      makeDense(chunk);
+    }
+    if (static_cast<int64_t>(mSparseBins.size()) + static_cast<int64_t>(mDenseChunks.size() << mChunkBits) > mMaxBufferedBins) {
+      flush();
+    }
+  }
+
+  void makeDense(int64_t chunk)
+  {
+    const int chunkSize = 1 << mChunkBits;
+    auto& dense = mDenseChunks[chunk];
+    dense.content.assign(chunkSize, 0.);
+    dense.sumw2.assign(chunkSize, 0.);
+    for (int offset = 0; offset < chunkSize; offset++) {
+      auto entry = mSparseBins.find((chunk << mChunkBits) + offset);
+      if (entry != mSparseBins.end()) {
+        dense.content[offset] = entry->second.content;
+        dense.sumw2[offset] = entry->second.sumw2;
+        mSparseBins.erase(entry);
+      }
+    }
+    mSparseBinsPerChunk.erase(chunk);
+  }
+
+  void write(int64_t bin, double content, double sumw2)
+  {
+    std::array<Int_t, MaxDimensions> coordinates{};
+    for (int i = 0; i < mNDimensions; i++) {
+      coordinates[i] = (bin / mAxes[i].stride) % (mAxes[i].nBins + 2);
+    }
+    const Long64_t histBin = mHist->GetBin(coordinates.data(), kTRUE);
+    if (mHist->GetCalculateErrors()) {
+      // AddBinContent would add content^2 to the errors, the sum of the squared weights is set instead
+      const double error2 = mHist->GetBinError2(histBin);
+      mHist->AddBinContent(histBin, content);
+      mHist->SetBinError2(histBin, error2 + sumw2);
+    } else {
+      mHist->AddBinContent(histBin, content);
+    }
+  }
+
+  THnSparse* mHist = nullptr;
+  int mNDimensions = 0;
+  std::array<Axis, MaxDimensions> mAxes;
+  int mChunkBits = 10;
+  int mDenseThreshold = 256;
+  int64_t mMaxBufferedBins = 1 << 22;
+  int64_t mEntries = 0;
+  std::unordered_map<int64_t, Entry> mSparseBins;
+  std::unordered_map<int64_t, int> mSparseBinsPerChunk;
+  std::unordered_map<int64_t, DenseChunk> mDenseChunks;
+};
+
+#endif // PWGCF_CORE_SPARSEFILLBUFFER_H_
@@ -208,6 +208,23 @@ DECLARE_SOA_TABLE(CF2ProngMcParts, "AOD", "CF2PRONGMCPART", //! Table for the da
                   cf2prongmcpart::McDecay<cf2prongmcpart::Decay>)
 using CF2ProngMcPart = CF2ProngMcParts::iterator;
 
+// Event mixing
+
+namespace cfmixingpair
+{
+DECLARE_SOA_INDEX_COLUMN_FULL(CFCollision1, cfCollision1, int, CFCollisions, "_1"); //! Index to the trigger collision
+DECLARE_SOA_INDEX_COLUMN_FULL(CFCollision2, cfCollision2, int, CFCollisions, "_2"); //! Index to the associated collision
+DECLARE_SOA_COLUMN(Bin, bin, int16_t);                                              //! Mixing bin of the two collisions
+DECLARE_SOA_COLUMN(NMixed, nMixed, uint16_t);                                       //! Number of collisions mixed with the trigger collision
+} // namespace cfmixingpair
+DECLARE_SOA_TABLE(CFMixingPairs, "AOD", "CFMIXINGPAIR", //! Pairs of collisions to be mixed, sorted by trigger collision
+                  o2::soa::Index<>,
+                  cfmixingpair::CFCollision1Id,
+                  cfmixingpair::CFCollision2Id,
+                  cfmixingpair::Bin,
+                  cfmixingpair::NMixed)
+using CFMixingPair = CFMixingPairs::iterator;
+
 } // namespace o2::aod
 
 #endif // PWGCF_DATAMODEL_CORRELATIONSDERIVED_H_
@@ -13,6 +13,8 @@
 /// \brief Task for analyzing efficiency of proton, and net-proton distributions in MC reconstructed and generated, and calculating net-proton cumulants
 /// \author Swati Saha
 
+#include "PWGCF/Core/EbyEMomentProfiles.h"
+
 #include "Common/CCDB/EventSelectionParams.h"
 #include "Common/DataModel/Centrality.h"
 #include "Common/DataModel/EventSelection.h"
@@ -103,6 +105,8 @@ struct AntiprotonCumulantsMc {
   HistogramRegistry histos{"Histos", {}, OutputObjHandlingPolicy::AnalysisObject};
 
   TRandom3* fRndm = new TRandom3(0);
+  o2::analysis::ebye::EbyEMomentProfiles<8> momentProfiles;    // mu1..mu8, reconstructed
+  o2::analysis::ebye::EbyEMomentProfiles<8> genMomentProfiles; // mu1..mu8, generated
 
   // Eff histograms 2d: eff(pT, eta)
   TH2F* hRatio2DEtaVsPtProton = nullptr;
@@ -206,14 +210,14 @@ struct AntiprotonCumulantsMc {
 
     if (cfgIsCalculateCentral) {
       // uncorrected
-      histos.add("Prof_mu1_antiproton", "", {HistType::kTProfile, {centAxis}});
-      histos.add("Prof_mu2_antiproton", "", {HistType::kTProfile, {centAxis}});
-      histos.add("Prof_mu3_antiproton", "", {HistType::kTProfile, {centAxis}});
-      histos.add("Prof_mu4_antiproton", "", {HistType::kTProfile, {centAxis}});
-      histos.add("Prof_mu5_antiproton", "", {HistType::kTProfile, {centAxis}});
-      histos.add("Prof_mu6_antiproton", "", {HistType::kTProfile, {centAxis}});
-      histos.add("Prof_mu7_antiproton", "", {HistType::kTProfile, {centAxis}});
-      histos.add("Prof_mu8_antiproton", "", {HistType::kTProfile, {centAxis}});
+      momentProfiles.setProfile(1, histos.add<TProfile>("Prof_mu1_antiproton", "", {HistType::kTProfile, {centAxis}}));
+      momentProfiles.setProfile(2, histos.add<TProfile>("Prof_mu2_antiproton", "", {HistType::kTProfile, {centAxis}}));
+      momentProfiles.setProfile(3, histos.add<TProfile>("Prof_mu3_antiproton", "", {HistType::kTProfile, {centAxis}}));
+      momentProfiles.setProfile(4, histos.add<TProfile>("Prof_mu4_antiproton", "", {HistType::kTProfile, {centAxis}}));
+      momentProfiles.setProfile(5, histos.add<TProfile>("Prof_mu5_antiproton", "", {HistType::kTProfile, {centAxis}}));
+      momentProfiles.setProfile(6, histos.add<TProfile>("Prof_mu6_antiproton", "", {HistType::kTProfile, {centAxis}}));
+      momentProfiles.setProfile(7, histos.add<TProfile>("Prof_mu7_antiproton", "", {HistType::kTProfile, {centAxis}}));
+      momentProfiles.setProfile(8, histos.add<TProfile>("Prof_mu8_antiproton", "", {HistType::kTProfile, {centAxis}}));
 
       // eff. corrected
       histos.add("Prof_Q11_1", "", {HistType::kTProfile, {centAxis}});
@@ -464,14 +468,14 @@ struct AntiprotonCumulantsMc {
 
     if (cfgIsCalculateError) {
       // uncorrected
-      histos.add("Prof2D_mu1_antiproton", "", {HistType::kTProfile2D, {centAxis, subsampleAxis}});
-      histos.add("Prof2D_mu2_antiproton", "", {HistType::kTProfile2D, {centAxis, subsampleAxis}});
-      histos.add("Prof2D_mu3_antiproton", "", {HistType::kTProfile2D, {centAxis, subsampleAxis}});
-      histos.add("Prof2D_mu4_antiproton", "", {HistType::kTProfile2D, {centAxis, subsampleAxis}});
-      histos.add("Prof2D_mu5_antiproton", "", {HistType::kTProfile2D, {centAxis, subsampleAxis}});
-      histos.add("Prof2D_mu6_antiproton", "", {HistType::kTProfile2D, {centAxis, subsampleAxis}});
-      histos.add("Prof2D_mu7_antiproton", "", {HistType::kTProfile2D, {centAxis, subsampleAxis}});
-      histos.add("Prof2D_mu8_antiproton", "", {HistType::kTProfile2D, {centAxis, subsampleAxis}});
+      momentProfiles.setSubsampleProfile(1, histos.add<TProfile2D>("Prof2D_mu1_antiproton", "", {HistType::kTProfile2D, {centAxis, subsampleAxis}}));
+      momentProfiles.setSubsampleProfile(2, histos.add<TProfile2D>("Prof2D_mu2_antiproton", "", {HistType::kTProfile2D, {centAxis, subsampleAxis}}));
+      momentProfiles.setSubsampleProfile(3, histos.add<TProfile2D>("Prof2D_mu3_antiproton", "", {HistType::kTProfile2D, {centAxis, subsampleAxis}}));
+      momentProfiles.setSubsampleProfile(4, histos.add<TProfile2D>("Prof2D_mu4_antiproton", "", {HistType::kTProfile2D, {centAxis, subsampleAxis}}));
+      momentProfiles.setSubsampleProfile(5, histos.add<TProfile2D>("Prof2D_mu5_antiproton", "", {HistType::kTProfile2D, {centAxis, subsampleAxis}}));
+      momentProfiles.setSubsampleProfile(6, histos.add<TProfile2D>("Prof2D_mu6_antiproton", "", {HistType::kTProfile2D, {centAxis, subsampleAxis}}));
+      momentProfiles.setSubsampleProfile(7, histos.add<TProfile2D>("Prof2D_mu7_antiproton", "", {HistType::kTProfile2D, {centAxis, subsampleAxis}}));
+      momentProfiles.setSubsampleProfile(8, histos.add<TProfile2D>("Prof2D_mu8_antiproton", "", {HistType::kTProfile2D, {centAxis, subsampleAxis}}));
 
       // eff. corrected
       histos.add("Prof2D_Q11_1", "", {HistType::kTProfile2D, {centAxis, subsampleAxis}});
@@ -749,25 +753,25 @@ struct AntiprotonCumulantsMc {
       histos.add("hgenProfileAntiproton", "Generated antiproton number vs. centrality", kTProfile, {centAxis});
 
       if (cfgIsCalculateCentral) {
-        histos.add("GenProf_mu1_antiproton", "", {HistType::kTProfile, {centAxis}});
-        histos.add("GenProf_mu2_antiproton", "", {HistType::kTProfile, {centAxis}});
-        histos.add("GenProf_mu3_antiproton", "", {HistType::kTProfile, {centAxis}});
-        histos.add("GenProf_mu4_antiproton", "", {HistType::kTProfile, {centAxis}});
-        histos.add("GenProf_mu5_antiproton", "", {HistType::kTProfile, {centAxis}});
-        histos.add("GenProf_mu6_antiproton", "", {HistType::kTProfile, {centAxis}});
-        histos.add("GenProf_mu7_antiproton", "", {HistType::kTProfile, {centAxis}});
-        histos.add("GenProf_mu8_antiproton", "", {HistType::kTProfile, {centAxis}});
+        genMomentProfiles.setProfile(1, histos.add<TProfile>("GenProf_mu1_antiproton", "", {HistType::kTProfile, {centAxis}}));
+        genMomentProfiles.setProfile(2, histos.add<TProfile>("GenProf_mu2_antiproton", "", {HistType::kTProfile, {centAxis}}));
+        genMomentProfiles.setProfile(3, histos.add<TProfile>("GenProf_mu3_antiproton", "", {HistType::kTProfile, {centAxis}}));
+        genMomentProfiles.setProfile(4, histos.add<TProfile>("GenProf_mu4_antiproton", "", {HistType::kTProfile, {centAxis}}));
+        genMomentProfiles.setProfile(5, histos.add<TProfile>("GenProf_mu5_antiproton", "", {HistType::kTProfile, {centAxis}}));
+        genMomentProfiles.setProfile(6, histos.add<TProfile>("GenProf_mu6_antiproton", "", {HistType::kTProfile, {centAxis}}));
+        genMomentProfiles.setProfile(7, histos.add<TProfile>("GenProf_mu7_antiproton", "", {HistType::kTProfile, {centAxis}}));
+        genMomentProfiles.setProfile(8, histos.add<TProfile>("GenProf_mu8_antiproton", "", {HistType::kTProfile, {centAxis}}));
       }
 
       if (cfgIsCalculateError) {
-        histos.add("GenProf2D_mu1_antiproton", "", {HistType::kTProfile2D, {centAxis, subsampleAxis}});
-        histos.add("GenProf2D_mu2_antiproton", "", {HistType::kTProfile2D, {centAxis, subsampleAxis}});
-        histos.add("GenProf2D_mu3_antiproton", "", {HistType::kTProfile2D, {centAxis, subsampleAxis}});
-        histos.add("GenProf2D_mu4_antiproton", "", {HistType::kTProfile2D, {centAxis, subsampleAxis}});
-        histos.add("GenProf2D_mu5_antiproton", "", {HistType::kTProfile2D, {centAxis, subsampleAxis}});
-        histos.add("GenProf2D_mu6_antiproton", "", {HistType::kTProfile2D, {centAxis, subsampleAxis}});
-        histos.add("GenProf2D_mu7_antiproton", "", {HistType::kTProfile2D, {centAxis, subsampleAxis}});
-        histos.add("GenProf2D_mu8_antiproton", "", {HistType::kTProfile2D, {centAxis, subsampleAxis}});
+        genMomentProfiles.setSubsampleProfile(1, histos.add<TProfile2D>("GenProf2D_mu1_antiproton", "", {HistType::kTProfile2D, {centAxis, subsampleAxis}}));
+        genMomentProfiles.setSubsampleProfile(2, histos.add<TProfile2D>("GenProf2D_mu2_antiproton", "", {HistType::kTProfile2D, {centAxis, subsampleAxis}}));
+        genMomentProfiles.setSubsampleProfile(3, histos.add<TProfile2D>("GenProf2D_mu3_antiproton", "", {HistType::kTProfile2D, {centAxis, subsampleAxis}}));
+        genMomentProfiles.setSubsampleProfile(4, histos.add<TProfile2D>("GenProf2D_mu4_antiproton", "", {HistType::kTProfile2D, {centAxis, subsampleAxis}}));
+        genMomentProfiles.setSubsampleProfile(5, histos.add<TProfile2D>("GenProf2D_mu5_antiproton", "", {HistType::kTProfile2D, {centAxis, subsampleAxis}}));
+        genMomentProfiles.setSubsampleProfile(6, histos.add<TProfile2D>("GenProf2D_mu6_antiproton", "", {HistType::kTProfile2D, {centAxis, subsampleAxis}}));
+        genMomentProfiles.setSubsampleProfile(7, histos.add<TProfile2D>("GenProf2D_mu7_antiproton", "", {HistType::kTProfile2D, {centAxis, subsampleAxis}}));
+        genMomentProfiles.setSubsampleProfile(8, histos.add<TProfile2D>("GenProf2D_mu8_antiproton", "", {HistType::kTProfile2D, {centAxis, subsampleAxis}}));
       }
     }
   } // end init()
@@ -788,9 +792,9 @@ struct AntiprotonCumulantsMc {
       }
     }
     if (candidate.hasTOF() && candidate.pt() > cfgCutPtUpperTPC && candidate.pt() < 5.0f) {
-      const float combNSigmaPr = std::sqrt(std::pow(candidate.tpcNSigmaPr(), 2.0) + std::pow(candidate.tofNSigmaPr(), 2.0));
-      const float combNSigmaPi = std::sqrt(std::pow(candidate.tpcNSigmaPi(), 2.0) + std::pow(candidate.tofNSigmaPi(), 2.0));
-      const float combNSigmaKa = std::sqrt(std::pow(candidate.tpcNSigmaKa(), 2.0) + std::pow(candidate.tofNSigmaKa(), 2.0));
+      const float combNSigmaPr = std::sqrt(candidate.tpcNSigmaPr() * candidate.tpcNSigmaPr() + candidate.tofNSigmaPr() * candidate.tofNSigmaPr());
+      const float combNSigmaPi = std::sqrt(candidate.tpcNSigmaPi() * candidate.tpcNSigmaPi() + candidate.tofNSigmaPi() * candidate.tofNSigmaPi());
+      const float combNSigmaKa = std::sqrt(candidate.tpcNSigmaKa() * candidate.tpcNSigmaKa() + candidate.tofNSigmaKa() * candidate.tofNSigmaKa());
 
       int flag2 = 0;
       if (combNSigmaPr < 3.0)
@@ -830,9 +834,9 @@ struct AntiprotonCumulantsMc {
       }
     }
     if (candidate.hasTOF() && candidate.pt() > cfgCutPtUpperTPC && candidate.pt() < 5.0f) {
-      const float combNSigmaPr = std::sqrt(std::pow(candidate.tpcNSigmaPr(), 2.0) + std::pow(candidate.tofNSigmaPr(), 2.0));
-      const float combNSigmaPi = std::sqrt(std::pow(candidate.tpcNSigmaPi(), 2.0) + std::pow(candidate.tofNSigmaPi(), 2.0));
-      const float combNSigmaKa = std::sqrt(std::pow(candidate.tpcNSigmaKa(), 2.0) + std::pow(candidate.tofNSigmaKa(), 2.0));
+      const float combNSigmaPr = std::sqrt(candidate.tpcNSigmaPr() * candidate.tpcNSigmaPr() + candidate.tofNSigmaPr() * candidate.tofNSigmaPr());
+      const float combNSigmaPi = std::sqrt(candidate.tpcNSigmaPi() * candidate.tpcNSigmaPi() + candidate.tofNSigmaPi() * candidate.tofNSigmaPi());
+      const float combNSigmaKa = std::sqrt(candidate.tpcNSigmaKa() * candidate.tpcNSigmaKa() + candidate.tofNSigmaKa() * candidate.tofNSigmaKa());
 
       int flag2 = 0;
       if (combNSigmaPr < 3.0)
@@ -1028,14 +1032,7 @@ struct AntiprotonCumulantsMc {
     //-------------------------------------------------------------------------------------------
 
     if (cfgIsCalculateCentral) {
-      histos.get<TProfile>(HIST("GenProf_mu1_antiproton"))->Fill(cent, std::pow(netProt, 1.0));
-      histos.get<TProfile>(HIST("GenProf_mu2_antiproton"))->Fill(cent, std::pow(netProt, 2.0));
-      histos.get<TProfile>(HIST("GenProf_mu3_antiproton"))->Fill(cent, std::pow(netProt, 3.0));
-      histos.get<TProfile>(HIST("GenProf_mu4_antiproton"))->Fill(cent, std::pow(netProt, 4.0));
-      histos.get<TProfile>(HIST("GenProf_mu5_antiproton"))->Fill(cent, std::pow(netProt, 5.0));
-      histos.get<TProfile>(HIST("GenProf_mu6_antiproton"))->Fill(cent, std::pow(netProt, 6.0));
-      histos.get<TProfile>(HIST("GenProf_mu7_antiproton"))->Fill(cent, std::pow(netProt, 7.0));
-      histos.get<TProfile>(HIST("GenProf_mu8_antiproton"))->Fill(cent, std::pow(netProt, 8.0));
+      genMomentProfiles.fill(cent, netProt);
     }
 
     if (cfgIsCalculateError) {
@@ -1043,14 +1040,7 @@ struct AntiprotonCumulantsMc {
       float lRandom = fRndm->Rndm();
       int sampleIndex = static_cast<int>(cfgNSubsample * lRandom);
 
-      histos.get<TProfile2D>(HIST("GenProf2D_mu1_antiproton"))->Fill(cent, sampleIndex, std::pow(netProt, 1.0));
-      histos.get<TProfile2D>(HIST("GenProf2D_mu2_antiproton"))->Fill(cent, sampleIndex, std::pow(netProt, 2.0));
-      histos.get<TProfile2D>(HIST("GenProf2D_mu3_antiproton"))->Fill(cent, sampleIndex, std::pow(netProt, 3.0));
-      histos.get<TProfile2D>(HIST("GenProf2D_mu4_antiproton"))->Fill(cent, sampleIndex, std::pow(netProt, 4.0));
-      histos.get<TProfile2D>(HIST("GenProf2D_mu5_antiproton"))->Fill(cent, sampleIndex, std::pow(netProt, 5.0));
-      histos.get<TProfile2D>(HIST("GenProf2D_mu6_antiproton"))->Fill(cent, sampleIndex, std::pow(netProt, 6.0));
-      histos.get<TProfile2D>(HIST("GenProf2D_mu7_antiproton"))->Fill(cent, sampleIndex, std::pow(netProt, 7.0));
-      histos.get<TProfile2D>(HIST("GenProf2D_mu8_antiproton"))->Fill(cent, sampleIndex, std::pow(netProt, 8.0));
+      genMomentProfiles.fillSubsample(cent, sampleIndex, netProt);
     }
     //-------------------------------------------------------------------------------------------
   }
@@ -1164,9 +1154,7 @@ struct AntiprotonCumulantsMc {
               nProt = nProt + 1.0;
               float pEff = getEfficiency(track); // get efficiency of track
               if (pEff != 0) {
-                for (int i = 1; i < 7; i++) {
-                  powerEffProt[i] += std::pow(1.0 / pEff, i);
-                }
+                o2::analysis::ebye::addPowerSums(powerEffProt, 1.0 / pEff);
               }
             }
             if (particle.pdgCode() == PDG_t::kProton) {
@@ -1186,9 +1174,7 @@ struct AntiprotonCumulantsMc {
               nAntiprot = nAntiprot + 1.0;
               float pEff = getEfficiency(track); // get efficiency of track
               if (pEff != 0) {
-                for (int i = 1; i < 7; i++) {
-                  powerEffAntiprot[i] += std::pow(1.0 / pEff, i);
-                }
+                o2::analysis::ebye::addPowerSums(powerEffAntiprot, 1.0 / pEff);
               }
             }
             if (particle.pdgCode() == PDG_t::kProtonBar) {
@@ -1487,14 +1473,7 @@ struct AntiprotonCumulantsMc {
     if (cfgIsCalculateCentral) {
 
       // uncorrected
-      histos.get<TProfile>(HIST("Prof_mu1_antiproton"))->Fill(cent, std::pow(netProt, 1.0));
-      histos.get<TProfile>(HIST("Prof_mu2_antiproton"))->Fill(cent, std::pow(netProt, 2.0));
-      histos.get<TProfile>(HIST("Prof_mu3_antiproton"))->Fill(cent, std::pow(netProt, 3.0));
-      histos.get<TProfile>(HIST("Prof_mu4_antiproton"))->Fill(cent, std::pow(netProt, 4.0));
-      histos.get<TProfile>(HIST("Prof_mu5_antiproton"))->Fill(cent, std::pow(netProt, 5.0));
-      histos.get<TProfile>(HIST("Prof_mu6_antiproton"))->Fill(cent, std::pow(netProt, 6.0));
-      histos.get<TProfile>(HIST("Prof_mu7_antiproton"))->Fill(cent, std::pow(netProt, 7.0));
-      histos.get<TProfile>(HIST("Prof_mu8_antiproton"))->Fill(cent, std::pow(netProt, 8.0));
+      momentProfiles.fill(cent, netProt);
 
       // eff. corrected
       histos.get<TProfile>(HIST("Prof_Q11_1"))->Fill(cent, fQ11_1);
@@ -1748,14 +1727,7 @@ struct AntiprotonCumulantsMc {
       float lRandom = fRndm->Rndm();
       int sampleIndex = static_cast<int>(cfgNSubsample * lRandom);
 
-      histos.get<TProfile2D>(HIST("Prof2D_mu1_antiproton"))->Fill(cent, sampleIndex, std::pow(netProt, 1.0));
-      histos.get<TProfile2D>(HIST("Prof2D_mu2_antiproton"))->Fill(cent, sampleIndex, std::pow(netProt, 2.0));
-      histos.get<TProfile2D>(HIST("Prof2D_mu3_antiproton"))->Fill(cent, sampleIndex, std::pow(netProt, 3.0));
-      histos.get<TProfile2D>(HIST("Prof2D_mu4_antiproton"))->Fill(cent, sampleIndex, std::pow(netProt, 4.0));
-      histos.get<TProfile2D>(HIST("Prof2D_mu5_antiproton"))->Fill(cent, sampleIndex, std::pow(netProt, 5.0));
-      histos.get<TProfile2D>(HIST("Prof2D_mu6_antiproton"))->Fill(cent, sampleIndex, std::pow(netProt, 6.0));
-      histos.get<TProfile2D>(HIST("Prof2D_mu7_antiproton"))->Fill(cent, sampleIndex, std::pow(netProt, 7.0));
-      histos.get<TProfile2D>(HIST("Prof2D_mu8_antiproton"))->Fill(cent, sampleIndex, std::pow(netProt, 8.0));
+      momentProfiles.fillSubsample(cent, sampleIndex, netProt);
 
       histos.get<TProfile2D>(HIST("Prof2D_Q11_1"))->Fill(cent, sampleIndex, fQ11_1);
       histos.get<TProfile2D>(HIST("Prof2D_Q11_2"))->Fill(cent, sampleIndex, fQ11_2);
@@ -2101,9 +2073,7 @@ struct AntiprotonCumulantsMc {
             nProt = nProt + 1.0;
             float pEff = getEfficiency(track); // get efficiency of track
             if (pEff != 0) {
-              for (int i = 1; i < 7; i++) {
-                powerEffProt[i] += std::pow(1.0 / pEff, i);
-              }
+              o2::analysis::ebye::addPowerSums(powerEffProt, 1.0 / pEff);
             }
           }
         }
@@ -2119,9 +2089,7 @@ struct AntiprotonCumulantsMc {
             nAntiprot = nAntiprot + 1.0;
             float pEff = getEfficiency(track); // get efficiency of track
             if (pEff != 0) {
-              for (int i = 1; i < 7; i++) {
-                powerEffAntiprot[i] += std::pow(1.0 / pEff, i);
-              }
+              o2::analysis::ebye::addPowerSums(powerEffAntiprot, 1.0 / pEff);
             }
           }
         }
@@ -2417,14 +2385,7 @@ struct AntiprotonCumulantsMc {
     if (cfgIsCalculateCentral) {
 
       // uncorrected
-      histos.get<TProfile>(HIST("Prof_mu1_antiproton"))->Fill(cent, std::pow(netProt, 1.0));
-      histos.get<TProfile>(HIST("Prof_mu2_antiproton"))->Fill(cent, std::pow(netProt, 2.0));
-      histos.get<TProfile>(HIST("Prof_mu3_antiproton"))->Fill(cent, std::pow(netProt, 3.0));
-      histos.get<TProfile>(HIST("Prof_mu4_antiproton"))->Fill(cent, std::pow(netProt, 4.0));
-      histos.get<TProfile>(HIST("Prof_mu5_antiproton"))->Fill(cent, std::pow(netProt, 5.0));
-      histos.get<TProfile>(HIST("Prof_mu6_antiproton"))->Fill(cent, std::pow(netProt, 6.0));
-      histos.get<TProfile>(HIST("Prof_mu7_antiproton"))->Fill(cent, std::pow(netProt, 7.0));
-      histos.get<TProfile>(HIST("Prof_mu8_antiproton"))->Fill(cent, std::pow(netProt, 8.0));
+      momentProfiles.fill(cent, netProt);
 
       // eff. corrected
       histos.get<TProfile>(HIST("Prof_Q11_1"))->Fill(cent, fQ11_1);
@@ -2678,14 +2639,7 @@ struct AntiprotonCumulantsMc {
       float lRandom = fRndm->Rndm();
       int sampleIndex = static_cast<int>(cfgNSubsample * lRandom);
 
-      histos.get<TProfile2D>(HIST("Prof2D_mu1_antiproton"))->Fill(cent, sampleIndex, std::pow(netProt, 1.0));
-      histos.get<TProfile2D>(HIST("Prof2D_mu2_antiproton"))->Fill(cent, sampleIndex, std::pow(netProt, 2.0));
-      histos.get<TProfile2D>(HIST("Prof2D_mu3_antiproton"))->Fill(cent, sampleIndex, std::pow(netProt, 3.0));
-      histos.get<TProfile2D>(HIST("Prof2D_mu4_antiproton"))->Fill(cent, sampleIndex, std::pow(netProt, 4.0));
-      histos.get<TProfile2D>(HIST("Prof2D_mu5_antiproton"))->Fill(cent, sampleIndex, std::pow(netProt, 5.0));
-      histos.get<TProfile2D>(HIST("Prof2D_mu6_antiproton"))->Fill(cent, sampleIndex, std::pow(netProt, 6.0));
-      histos.get<TProfile2D>(HIST("Prof2D_mu7_antiproton"))->Fill(cent, sampleIndex, std::pow(netProt, 7.0));
-      histos.get<TProfile2D>(HIST("Prof2D_mu8_antiproton"))->Fill(cent, sampleIndex, std::pow(netProt, 8.0));
+      momentProfiles.fillSubsample(cent, sampleIndex, netProt);
 
       histos.get<TProfile2D>(HIST("Prof2D_Q11_1"))->Fill(cent, sampleIndex, fQ11_1);
       histos.get<TProfile2D>(HIST("Prof2D_Q11_2"))->Fill(cent, sampleIndex, fQ11_2);
@@ -33,7 +33,6 @@
 #include <cstdint>
 #include <map>
 #include <numeric>
-#include <optional>
 #include <random>
 #include <string>
 #include <vector>
@@ -162,6 +161,55 @@ auto makeCprHistSpecMap(const T& confCpr)
   };
 };
 
+// phi* of a track at all the TPC radii
+struct PhistarRow {
+  float signedPt = 0.f; // abs(charge) * signed pT, phi and magnetic field the row was computed for
+  float phi = 0.f;
+  float magField = 0.f;
+  bool isFilled = false;
+  std::array<float, Nradii> phistar = {0.f};
+  std::array<bool, Nradii> mask = {false};
+};
+
+// phi* only depends on the track, so it is computed once per track and reused in all the pairs (and triplets)
+// the track is part of. The rows are indexed by the global index of the track and are recomputed when the track
+// kinematics or the magnetic field differ, so a row left from another data frame is never used.
+class PhistarTable
+{
+ public:
+  template <typename T>
+  PhistarRow const& get(T const& track, int absCharge, float magField)
+  {
+    const auto index = static_cast<std::size_t>(track.globalIndex());
+    if (index >= mRows.size()) {
+      mRows.resize(index + 1);
+    }
+    auto& row = mRows[index];
+    const float signedPt = absCharge * track.signedPt();
+    const float phi = track.phi();
+    if (!row.isFilled || row.signedPt != signedPt || row.phi != phi || row.magField != magField) {
+      fill(row, signedPt, phi, magField);
+    }
+    return row;
+  }
+
+ private:
+  static void fill(PhistarRow& row, float signedPt, float phi, float magField)
+  {
+    row.signedPt = signedPt;
+    row.phi = phi;
+    row.magField = magField;
+    row.isFilled = true;
+    for (size_t i = 0; i < TpcRadii.size(); i++) {
+      double arg = 0.3 * (0.1 * magField) * (0.01 * TpcRadii[i]) / (2. * signedPt);
+      row.mask[i] = std::fabs(arg) <= 1.;
+      row.phistar[i] = row.mask[i] ? static_cast<float>(RecoDecay::constrainAngle(phi - std::asin(arg))) : 0.f;
+    }
+  }
+
+  std::vector<PhistarRow> mRows;
+};
+
 template <const char* prefix>
 class CloseTrackRejection
 {
@@ -263,12 +311,12 @@ class CloseTrackRejection
 
     mDeta = t1.eta() - t2.eta();
 
+    const PhistarRow row1 = mPhistarTable.get(t1, mChargeAbsTrack1, mMagField); // copy, the next get can move the rows
+    auto const& row2 = mPhistarTable.get(t2, mChargeAbsTrack2, mMagField);
     for (size_t i = 0; i < TpcRadii.size(); i++) {
-      auto phistar1 = phistar(mMagField, TpcRadii[i], mChargeAbsTrack1 * t1.signedPt(), t1.phi());
-      auto phistar2 = phistar(mMagField, TpcRadii[i], mChargeAbsTrack2 * t2.signedPt(), t2.phi());
-      if (phistar1 && phistar2) {
-        mDphistar.at(i) = RecoDecay::constrainAngle(phistar1.value() - phistar2.value(), -o2::constants::math::PI); // constrain angular difference between -pi and pi
-        mDphistarMask.at(i) = true;
+      if (row1.mask[i] && row2.mask[i]) {
+        mDphistar[i] = RecoDecay::constrainAngle(row1.phistar[i] - row2.phistar[i], -o2::constants::math::PI); // constrain angular difference between -pi and pi
+        mDphistarMask[i] = true;
         count++;
       }
     }
@@ -371,16 +419,6 @@ class CloseTrackRejection
   bool isActivated() const { return mIsActivated; }
 
  private:
-  std::optional<float> phistar(float magfield, float radius, float signedPt, float phi)
-  {
-    double arg = 0.3 * (0.1 * magfield) * (0.01 * radius) / (2. * signedPt);
-    if (std::fabs(arg) <= 1.) {
-      double angle = phi - std::asin(arg);
-      return static_cast<float>(RecoDecay::constrainAngle(angle));
-    }
-    return std::nullopt;
-  }
-
   o2::framework::HistogramRegistry* mHistogramRegistry = nullptr;
   bool mPlotAllRadii = false;
   bool mPlotAverage = false;
@@ -412,6 +450,7 @@ class CloseTrackRejection
 
   std::array<float, Nradii> mDphistar = {0.f};
   std::array<bool, Nradii> mDphistarMask = {false};
+  PhistarTable mPhistarTable;
 
   bool mRandomizeTracks = false;
   std::mt19937 mRng;
@@ -16,6 +16,8 @@
 #ifndef PWGCF_FEMTO_CORE_PAIRHISTMANAGER_H_
 #define PWGCF_FEMTO_CORE_PAIRHISTMANAGER_H_
 
+#include "PWGCF/Core/PairKinematics.h"
+#include "PWGCF/Core/SparseFillBuffer.h"
 #include "PWGCF/Femto/Core/femtoUtils.h"
 #include "PWGCF/Femto/Core/histManager.h"
 #include "PWGCF/Femto/Core/modes.h"
@@ -30,6 +32,7 @@
 
 #include <Math/Vector4D.h> // IWYU pragma: keep (do not replace with Math/Vector4Dfwd.h)
 #include <Math/Vector4Dfwd.h>
+#include <THnSparse.h>
 
 #include <algorithm>
 #include <array>
@@ -38,7 +41,6 @@
 #include <map>
 #include <string>
 #include <string_view>
-#include <tuple>
 #include <unordered_set>
 #include <vector>
 
@@ -162,6 +164,8 @@ struct ConfPairBinning : o2::framework::ConfigurableGroup {
   o2::framework::Configurable<bool> plotKstarVsMtVsMinv1VsPt1VsPt2VsMultVsCent{"plotKstarVsMtVsMinv1VsPt1VsPt2VsMultVsCent", false, "Enable 7D histogram (Kstar Vs Mt Vs Minv Vs Pt1 Vs Pt2 Vs Mult Vs Cent)"};
   o2::framework::Configurable<bool> plotDalitz{"plotDalitz", false, "Enable dalitz plot"};
   o2::framework::Configurable<bool> plotDeltaEtaDeltaPhi{"plotDeltaEtaDeltaPhi", false, "Plot #Delta#phi vs #Delta#eta"};
+  o2::framework::Configurable<bool> bufferSparseFills{"bufferSparseFills", false, "Accumulate the fills of the n-D histograms and write them into the THnSparse once per event (same event) or per mixing call (mixed event)"};
+  o2::framework::Configurable<float> bufferDenseFraction{"bufferDenseFraction", 0.25f, "Occupied fraction of a chunk of bins above which the fill buffer stores the chunk densely"};
   o2::framework::ConfigurableAxis kstar{"kstar", {{600, 0, 6}}, "kstar"};
   o2::framework::ConfigurableAxis kt{"kt", {{600, 0, 6}}, "kt"};
   o2::framework::ConfigurableAxis mt{"mt", {{500, 0.8, 5.8}}, "mt"};
@@ -410,6 +414,9 @@ class PairHistManager
     mPlotDeltaEtaDeltaPhi = ConfPairBinning.plotDeltaEtaDeltaPhi.value;
     mPlotBertschPratt = ConfPairBinning.plotBertschPratt.value;
 
+    mBufferSparseFills = ConfPairBinning.bufferSparseFills.value;
+    mBufferDenseFraction = ConfPairBinning.bufferDenseFraction.value;
+
     // transverse mass type
     mMtType = static_cast<modes::TransverseMassType>(ConfPairBinning.transverseMassType.value);
 
@@ -497,20 +504,20 @@ class PairHistManager
     mParticle1 = ROOT::Math::PtEtaPhiMVector(mAbsCharge1 * particle1.pt(), particle1.eta(), particle1.phi(), mass1);
     mParticle2 = ROOT::Math::PtEtaPhiMVector(mAbsCharge2 * particle2.pt(), particle2.eta(), particle2.phi(), mass2);
 
-    // set kT
-    mKt = getKt(mParticle1, mParticle2);
-
-    // set mT
-    mMt = getMt(mParticle1, mParticle2);
-
-    // set Minv
-    mMassInv = getMinv(mParticle1, mParticle2);
-
-    // set kstar
-    mKstar = getKstar(mParticle1, mParticle2);
+    // kT, mT, Minv and kstar from one set of Cartesian momenta
+    const auto momentum1 = toMomentum(mParticle1);
+    const auto momentum2 = toMomentum(mParticle2);
+    const auto pair = pairkinematics::computePair(momentum1, momentum2);
+    mKt = pair.kt;
+    mMt = getMt(pair, mass1, mass2);
+    mMassInv = pair.minv;
+    mKstar = pair.kstar;
 
     if (mPlotBertschPratt) {
-      std::tie(mQout, mQside, mQlong) = computeBertschPrattLCMS(mParticle1, mParticle2);
+      const auto lcms = pairkinematics::computeLCMS(momentum1, momentum2);
+      mQout = lcms.qout;
+      mQside = lcms.qside;
+      mQlong = lcms.qlong;
     }
 
     if (mPlotDeltaEtaDeltaPhi) {
@@ -563,10 +570,11 @@ class PairHistManager
     mTrueParticle2 = ROOT::Math::PtEtaPhiMVector(mAbsCharge2 * mcParticle2.pt(), mcParticle2.eta(), mcParticle2.phi(), mPdgMass2);
 
     // compute true kinematics
-    mTrueKt = getKt(mTrueParticle1, mTrueParticle2);
-    mTrueMt = getMt(mTrueParticle1, mTrueParticle2);
-    mTrueMinv = getMinv(mTrueParticle1, mTrueParticle2);
-    mTrueKstar = getKstar(mTrueParticle1, mTrueParticle2);
+    const auto truePair = pairkinematics::computePair(toMomentum(mTrueParticle1), toMomentum(mTrueParticle2));
+    mTrueKt = truePair.kt;
+    mTrueMt = getMt(truePair, mPdgMass1, mPdgMass2);
+    mTrueMinv = truePair.minv;
+    mTrueKstar = truePair.kstar;
   }
 
   template <typename T1, typename T2, typename T3, typename T4, typename T5, typename T6>
@@ -675,7 +683,36 @@ class PairHistManager
 
   float getKstar() const { return mKstar; }
 
+  // writes the buffered fills of the n-D histograms, called at the end of each same event and mixing call
+  void flushFillBuffers()
+  {
+    if (!mBufferSparseFills) {
+      return;
+    }
+    for (auto& buffer : mFillBuffers) {
+      buffer.flush();
+    }
+  }
+
  private:
+  template <PairHist hist>
+  void initFillBuffer()
+  {
+    if (mBufferSparseFills) {
+      mFillBuffers[hist].init(mHistogramRegistry->get<THnSparse>(HIST(prefix) + HIST(AnalysisDir) + HIST(getHistName(hist, HistTable))).get(), 10, mBufferDenseFraction);
+    }
+  }
+
+  template <PairHist hist, typename... Ts>
+  void fillSparse(Ts... values)
+  {
+    if (mBufferSparseFills && mFillBuffers[hist].isInitialized()) {
+      mFillBuffers[hist].fill(values...);
+    } else {
+      mHistogramRegistry->fill(HIST(prefix) + HIST(AnalysisDir) + HIST(getHistName(hist, HistTable)), values...);
+    }
+  }
+
   void initAnalysis(std::map<PairHist, std::vector<o2::framework::AxisSpec>> const& Specs)
   {
     std::string analysisDir = std::string(prefix) + std::string(AnalysisDir);
@@ -710,52 +747,67 @@ class PairHistManager
     // higher dimensional histograms
     if (mPlotKstarVsMtVsMult) {
       mHistogramRegistry->add(analysisDir + getHistNameV2(kKstarVsMtVsMult, HistTable), getHistDesc(kKstarVsMtVsMult, HistTable), getHistType(kKstarVsMtVsMult, HistTable), {Specs.at(kKstarVsMtVsMult)});
+      initFillBuffer<kKstarVsMtVsMult>();
     }
     if (mPlotKstarVsMtVsMultVsCent) {
       mHistogramRegistry->add(analysisDir + getHistNameV2(kKstarVsMtVsMultVsCent, HistTable), getHistDesc(kKstarVsMtVsMultVsCent, HistTable), getHistType(kKstarVsMtVsMultVsCent, HistTable), {Specs.at(kKstarVsMtVsMultVsCent)});
+      initFillBuffer<kKstarVsMtVsMultVsCent>();
     }
     // add pt
     if (mPlotKstarVsMtVsPt1VsPt2) {
       mHistogramRegistry->add(analysisDir + getHistNameV2(kKstarVsMtVsPt1VsPt2, HistTable), getHistDesc(kKstarVsMtVsPt1VsPt2, HistTable), getHistType(kKstarVsMtVsPt1VsPt2, HistTable), {Specs.at(kKstarVsMtVsPt1VsPt2)});
+      initFillBuffer<kKstarVsMtVsPt1VsPt2>();
     }
     if (mPlotKstarVsMtVsPt1VsPt2VsMult) {
       mHistogramRegistry->add(analysisDir + getHistNameV2(kKstarVsMtVsPt1VsPt2VsMult, HistTable), getHistDesc(kKstarVsMtVsPt1VsPt2VsMult, HistTable), getHistType(kKstarVsMtVsPt1VsPt2VsMult, HistTable), {Specs.at(kKstarVsMtVsPt1VsPt2VsMult)});
+      initFillBuffer<kKstarVsMtVsPt1VsPt2VsMult>();
     }
     if (mPlotKstarVsMtVsPt1VsPt2VsMultVsCent) {
       mHistogramRegistry->add(analysisDir + getHistNameV2(kKstarVsMtVsPt1VsPt2VsMultVsCent, HistTable), getHistDesc(kKstarVsMtVsPt1VsPt2VsMultVsCent, HistTable), getHistType(kKstarVsMtVsPt1VsPt2VsMultVsCent, HistTable), {Specs.at(kKstarVsMtVsPt1VsPt2VsMultVsCent)});
+      initFillBuffer<kKstarVsMtVsPt1VsPt2VsMultVsCent>();
     }
     // add mass
     if (mPlotKstarVsMtVsMass1VsMass2) {
       mHistogramRegistry->add(analysisDir + getHistNameV2(kKstarVsMtVsMass1VsMass2, HistTable), getHistDesc(kKstarVsMtVsMass1VsMass2, HistTable), getHistType(kKstarVsMtVsMass1VsMass2, HistTable), {Specs.at(kKstarVsMtVsMass1VsMass2)});
+      initFillBuffer<kKstarVsMtVsMass1VsMass2>();
     }
     if (mPlotKstarVsMtVsMass1VsMass2VsMult) {
       mHistogramRegistry->add(analysisDir + getHistNameV2(kKstarVsMtVsMass1VsMass2VsMult, HistTable), getHistDesc(kKstarVsMtVsMass1VsMass2VsMult, HistTable), getHistType(kKstarVsMtVsMass1VsMass2VsMult, HistTable), {Specs.at(kKstarVsMtVsMass1VsMass2VsMult)});
+      initFillBuffer<kKstarVsMtVsMass1VsMass2VsMult>();
     }
     if (mPlotKstarVsMtVsMass1VsMass2VsMultVsCent) {
       mHistogramRegistry->add(analysisDir + getHistNameV2(kKstarVsMtVsMass1VsMass2VsMultVsCent, HistTable), getHistDesc(kKstarVsMtVsMass1VsMass2VsMultVsCent, HistTable), getHistType(kKstarVsMtVsMass1VsMass2VsMultVsCent, HistTable), {Specs.at(kKstarVsMtVsMass1VsMass2VsMultVsCent)});
+      initFillBuffer<kKstarVsMtVsMass1VsMass2VsMultVsCent>();
     }
     if (mPlotKstarVsMtVsMass1VsMass2VsPt1VsPt2) {
       mHistogramRegistry->add(analysisDir + getHistNameV2(kKstarVsMtVsMass1VsMass2VsPt1VsPt2, HistTable), getHistDesc(kKstarVsMtVsMass1VsMass2VsPt1VsPt2, HistTable), getHistType(kKstarVsMtVsMass1VsMass2VsPt1VsPt2, HistTable), {Specs.at(kKstarVsMtVsMass1VsMass2VsPt1VsPt2)});
+      initFillBuffer<kKstarVsMtVsMass1VsMass2VsPt1VsPt2>();
     }
     if (mPlotKstarVsMtVsMass1VsMass2VsPt1VsPt2VsMult) {
       mHistogramRegistry->add(analysisDir + getHistNameV2(kKstarVsMtVsMass1VsMass2VsPt1VsPt2VsMult, HistTable), getHistDesc(kKstarVsMtVsMass1VsMass2VsPt1VsPt2VsMult, HistTable), getHistType(kKstarVsMtVsMass1VsMass2VsPt1VsPt2VsMult, HistTable), {Specs.at(kKstarVsMtVsMass1VsMass2VsPt1VsPt2VsMult)});
+      initFillBuffer<kKstarVsMtVsMass1VsMass2VsPt1VsPt2VsMult>();
     }
     if (mPlotKstarVsMtVsMass1VsMass2VsPt1VsPt2VsMultVsCent) {
       mHistogramRegistry->add(analysisDir + getHistNameV2(kKstarVsMtVsMass1VsMass2VsPt1VsPt2VsMultVsCent, HistTable), getHistDesc(kKstarVsMtVsMass1VsMass2VsPt1VsPt2VsMultVsCent, HistTable), getHistType(kKstarVsMtVsMass1VsMass2VsPt1VsPt2VsMultVsCent, HistTable), {Specs.at(kKstarVsMtVsMass1VsMass2VsPt1VsPt2VsMultVsCent)});
+      initFillBuffer<kKstarVsMtVsMass1VsMass2VsPt1VsPt2VsMultVsCent>();
     }
 
     if (mPlotKstarVsMtVsMinvVsPt1VsPt2) {
       mHistogramRegistry->add(analysisDir + getHistNameV2(kKstarVsMtVsMinvVsPt1VsPt2, HistTable), getHistDesc(kKstarVsMtVsMinvVsPt1VsPt2, HistTable), getHistType(kKstarVsMtVsMinvVsPt1VsPt2, HistTable), {Specs.at(kKstarVsMtVsMinvVsPt1VsPt2)});
+      initFillBuffer<kKstarVsMtVsMinvVsPt1VsPt2>();
     }
     if (mPlotKstarVsMtVsMinvVsPt1VsPt2VsMult) {
       mHistogramRegistry->add(analysisDir + getHistNameV2(kKstarVsMtVsMinvVsPt1VsPt2VsMult, HistTable), getHistDesc(kKstarVsMtVsMinvVsPt1VsPt2VsMult, HistTable), getHistType(kKstarVsMtVsMinvVsPt1VsPt2VsMult, HistTable), {Specs.at(kKstarVsMtVsMinvVsPt1VsPt2VsMult)});
+      initFillBuffer<kKstarVsMtVsMinvVsPt1VsPt2VsMult>();
     }
     if (mPlotKstarVsMtVsMinvVsPt1VsPt2VsMultVsCent) {
       mHistogramRegistry->add(analysisDir + getHistNameV2(kKstarVsMtVsMinvVsPt1VsPt2VsMultVsCent, HistTable), getHistDesc(kKstarVsMtVsMinvVsPt1VsPt2VsMultVsCent, HistTable), getHistType(kKstarVsMtVsMinvVsPt1VsPt2VsMultVsCent, HistTable), {Specs.at(kKstarVsMtVsMinvVsPt1VsPt2VsMultVsCent)});
+      initFillBuffer<kKstarVsMtVsMinvVsPt1VsPt2VsMultVsCent>();
     }
 
     if (mPlotDalitz) {
       mHistogramRegistry->add(analysisDir + getHistNameV2(kDalitz, HistTable), getHistDesc(kDalitz, HistTable), getHistType(kDalitz, HistTable), {Specs.at(kDalitz)});
+      initFillBuffer<kDalitz>();
     }
     if (mPlotDeltaEtaDeltaPhi) {
       mHistogramRegistry->add(analysisDir + getHistNameV2(kDeltaEtaDeltaPhi, HistTable), getHistDesc(kDeltaEtaDeltaPhi, HistTable), getHistType(kDeltaEtaDeltaPhi, HistTable), {Specs.at(kDeltaEtaDeltaPhi)});
@@ -834,49 +886,49 @@ class PairHistManager
     // if "mass" getter does not exist for particle, it will be just set to 0
     // the user has to make sure that in this case the bin number of this dimension is set to 1
     if (mPlotKstarVsMtVsMult) {
-      mHistogramRegistry->fill(HIST(prefix) + HIST(AnalysisDir) + HIST(getHistName(kKstarVsMtVsMult, HistTable)), mKstar, mMt, mMult);
+      fillSparse<kKstarVsMtVsMult>(mKstar, mMt, mMult);
     }
     if (mPlotKstarVsMtVsMultVsCent) {
-      mHistogramRegistry->fill(HIST(prefix) + HIST(AnalysisDir) + HIST(getHistName(kKstarVsMtVsMultVsCent, HistTable)), mKstar, mMt, mMult, mCent);
+      fillSparse<kKstarVsMtVsMultVsCent>(mKstar, mMt, mMult, mCent);
     }
     if (mPlotKstarVsMtVsPt1VsPt2) {
-      mHistogramRegistry->fill(HIST(prefix) + HIST(AnalysisDir) + HIST(getHistName(kKstarVsMtVsPt1VsPt2, HistTable)), mKstar, mMt, mParticle1.Pt(), mParticle2.Pt());
+      fillSparse<kKstarVsMtVsPt1VsPt2>(mKstar, mMt, mParticle1.Pt(), mParticle2.Pt());
     }
     if (mPlotKstarVsMtVsPt1VsPt2VsMult) {
-      mHistogramRegistry->fill(HIST(prefix) + HIST(AnalysisDir) + HIST(getHistName(kKstarVsMtVsPt1VsPt2VsMult, HistTable)), mKstar, mMt, mParticle1.Pt(), mParticle2.Pt(), mMult);
+      fillSparse<kKstarVsMtVsPt1VsPt2VsMult>(mKstar, mMt, mParticle1.Pt(), mParticle2.Pt(), mMult);
     }
     if (mPlotKstarVsMtVsPt1VsPt2VsMultVsCent) {
-      mHistogramRegistry->fill(HIST(prefix) + HIST(AnalysisDir) + HIST(getHistName(kKstarVsMtVsPt1VsPt2VsMultVsCent, HistTable)), mKstar, mMt, mParticle1.Pt(), mParticle2.Pt(), mMult, mCent);
+      fillSparse<kKstarVsMtVsPt1VsPt2VsMultVsCent>(mKstar, mMt, mParticle1.Pt(), mParticle2.Pt(), mMult, mCent);
     }
     if (mPlotKstarVsMtVsMass1VsMass2) {
-      mHistogramRegistry->fill(HIST(prefix) + HIST(AnalysisDir) + HIST(getHistName(kKstarVsMtVsMass1VsMass2, HistTable)), mKstar, mMt, mRecoMass1, mRecoMass2);
+      fillSparse<kKstarVsMtVsMass1VsMass2>(mKstar, mMt, mRecoMass1, mRecoMass2);
     }
     if (mPlotKstarVsMtVsMass1VsMass2VsMult) {
-      mHistogramRegistry->fill(HIST(prefix) + HIST(AnalysisDir) + HIST(getHistName(kKstarVsMtVsMass1VsMass2VsMult, HistTable)), mKstar, mMt, mRecoMass1, mRecoMass2, mMult);
+      fillSparse<kKstarVsMtVsMass1VsMass2VsMult>(mKstar, mMt, mRecoMass1, mRecoMass2, mMult);
     }
     if (mPlotKstarVsMtVsMass1VsMass2VsMultVsCent) {
-      mHistogramRegistry->fill(HIST(prefix) + HIST(AnalysisDir) + HIST(getHistName(kKstarVsMtVsMass1VsMass2VsMultVsCent, HistTable)), mKstar, mMt, mRecoMass1, mRecoMass2, mMult, mCent);
+      fillSparse<kKstarVsMtVsMass1VsMass2VsMultVsCent>(mKstar, mMt, mRecoMass1, mRecoMass2, mMult, mCent);
     }
     if (mPlotKstarVsMtVsMass1VsMass2VsPt1VsPt2) {
-      mHistogramRegistry->fill(HIST(prefix) + HIST(AnalysisDir) + HIST(getHistName(kKstarVsMtVsMass1VsMass2VsPt1VsPt2, HistTable)), mKstar, mMt, mRecoMass1, mRecoMass2, mParticle1.Pt(), mParticle2.Pt());
+      fillSparse<kKstarVsMtVsMass1VsMass2VsPt1VsPt2>(mKstar, mMt, mRecoMass1, mRecoMass2, mParticle1.Pt(), mParticle2.Pt());
     }
     if (mPlotKstarVsMtVsMass1VsMass2VsPt1VsPt2VsMult) {
-      mHistogramRegistry->fill(HIST(prefix) + HIST(AnalysisDir) + HIST(getHistName(kKstarVsMtVsMass1VsMass2VsPt1VsPt2VsMult, HistTable)), mKstar, mMt, mRecoMass1, mRecoMass2, mParticle1.Pt(), mParticle2.Pt(), mMult);
+      fillSparse<kKstarVsMtVsMass1VsMass2VsPt1VsPt2VsMult>(mKstar, mMt, mRecoMass1, mRecoMass2, mParticle1.Pt(), mParticle2.Pt(), mMult);
     }
     if (mPlotKstarVsMtVsMass1VsMass2VsPt1VsPt2VsMultVsCent) {
-      mHistogramRegistry->fill(HIST(prefix) + HIST(AnalysisDir) + HIST(getHistName(kKstarVsMtVsMass1VsMass2VsPt1VsPt2VsMultVsCent, HistTable)), mKstar, mMt, mRecoMass1, mRecoMass2, mParticle1.Pt(), mParticle2.Pt(), mMult, mCent);
+      fillSparse<kKstarVsMtVsMass1VsMass2VsPt1VsPt2VsMultVsCent>(mKstar, mMt, mRecoMass1, mRecoMass2, mParticle1.Pt(), mParticle2.Pt(), mMult, mCent);
     }
     if (mPlotKstarVsMtVsMinvVsPt1VsPt2) {
-      mHistogramRegistry->fill(HIST(prefix) + HIST(AnalysisDir) + HIST(getHistName(kKstarVsMtVsMinvVsPt1VsPt2, HistTable)), mKstar, mMt, mMassInv, mParticle1.Pt(), mParticle2.Pt());
+      fillSparse<kKstarVsMtVsMinvVsPt1VsPt2>(mKstar, mMt, mMassInv, mParticle1.Pt(), mParticle2.Pt());
     }
     if (mPlotKstarVsMtVsMinvVsPt1VsPt2VsMult) {
-      mHistogramRegistry->fill(HIST(prefix) + HIST(AnalysisDir) + HIST(getHistName(kKstarVsMtVsMinvVsPt1VsPt2VsMult, HistTable)), mKstar, mMt, mMassInv, mParticle1.Pt(), mParticle2.Pt(), mMult);
+      fillSparse<kKstarVsMtVsMinvVsPt1VsPt2VsMult>(mKstar, mMt, mMassInv, mParticle1.Pt(), mParticle2.Pt(), mMult);
     }
     if (mPlotKstarVsMtVsMinvVsPt1VsPt2VsMultVsCent) {
-      mHistogramRegistry->fill(HIST(prefix) + HIST(AnalysisDir) + HIST(getHistName(kKstarVsMtVsMinvVsPt1VsPt2VsMultVsCent, HistTable)), mKstar, mMt, mMassInv, mParticle1.Pt(), mParticle2.Pt(), mMult, mCent);
+      fillSparse<kKstarVsMtVsMinvVsPt1VsPt2VsMultVsCent>(mKstar, mMt, mMassInv, mParticle1.Pt(), mParticle2.Pt(), mMult, mCent);
     }
     if (mPlotDalitz) {
-      mHistogramRegistry->fill(HIST(prefix) + HIST(AnalysisDir) + HIST(getHistName(kDalitz, HistTable)), mKstar, mMassTot2, mMass12, mMass13);
+      fillSparse<kDalitz>(mKstar, mMassTot2, mMass12, mMass13);
     }
     if (mPlotDeltaEtaDeltaPhi) {
       mHistogramRegistry->fill(HIST(prefix) + HIST(AnalysisDir) + HIST(getHistName(kDeltaEtaDeltaPhi, HistTable)), mDeltaPhi, mDeltaEta);
@@ -903,30 +955,27 @@ class PairHistManager
     }
   }
 
-  float getKt(ROOT::Math::PtEtaPhiMVector const& part1, ROOT::Math::PtEtaPhiMVector const& part2)
+  static pairkinematics::Momentum toMomentum(ROOT::Math::PtEtaPhiMVector const& part)
   {
-    auto sum = (part1 + part2);
-    double kt = 0.5 * sum.Pt();
-    return static_cast<float>(kt);
+    return pairkinematics::fromPtEtaPhiM(part.Pt(), part.Eta(), part.Phi(), part.M());
   }
 
-  float getMt(ROOT::Math::PtEtaPhiMVector const& part1, ROOT::Math::PtEtaPhiMVector const& part2)
+  float getMt(pairkinematics::Pair const& pair, double mass1, double mass2)
   {
-    auto sum = part1 + part2;
     double mt = 0;
     double averageMass = 0;
     double reducedMass = 0;
     switch (mMtType) {
       case modes::TransverseMassType::kAveragePdgMass:
-        averageMass = 0.5 * (part1.M() + part2.M());
-        mt = std::hypot(0.5 * sum.Pt(), averageMass);
+        averageMass = 0.5 * (mass1 + mass2);
+        mt = std::hypot(pair.kt, averageMass);
         break;
       case modes::TransverseMassType::kReducedPdgMass:
-        reducedMass = 2. * (part1.M() * part2.M()) / (part1.M() + part2.M());
-        mt = std::hypot(0.5 * sum.Pt(), reducedMass);
+        reducedMass = 2. * (mass1 * mass2) / (mass1 + mass2);
+        mt = std::hypot(pair.kt, reducedMass);
         break;
       case modes::TransverseMassType::kMt4Vector:
-        mt = 0.5 * sum.Mt();
+        mt = pair.mt;
         break;
       default:
         LOG(fatal) << "Invalid transverse mass type, breaking...";
@@ -934,66 +983,6 @@ class PairHistManager
     return static_cast<float>(mt);
   }
 
-  float getMinv(ROOT::Math::PtEtaPhiMVector const& part1, ROOT::Math::PtEtaPhiMVector const& part2)
-  {
-    return static_cast<float>((part1 + part2).M());
-  }
-
-  float getKstar(ROOT::Math::PtEtaPhiMVector const& part1, ROOT::Math::PtEtaPhiMVector const& part2)
-  {
-    // Use Cartesian 4-vectors: addition/M2() become pure arithmetic
-    const ROOT::Math::PxPyPzEVector p1(part1);
-    const ROOT::Math::PxPyPzEVector p2(part2);
-
-    // Mandelstam s = (p1 + p2)^2
-    const double s = (p1 + p2).M2();
-    const double m1sq = p1.M2();
-    const double m2sq = p2.M2();
-
-    // Källen function λ(s, m1^2, m2^2) = (s - m1^2 - m2^2)² - 4*m1^2*m2^2
-    const double kallen = (s - m1sq - m2sq) * (s - m1sq - m2sq) - 4.0 * m1sq * m2sq;
-
-    // k* = 0.5 * sqrt(λ/s)
-    return static_cast<float>(0.5 * std::sqrt(std::max(0.0, kallen) / s));
-  }
-
-  std::tuple<float, float, float> computeBertschPrattLCMS(ROOT::Math::PtEtaPhiMVector const& part1, ROOT::Math::PtEtaPhiMVector const& part2)
-  {
-    const ROOT::Math::PxPyPzEVector p1(part1);
-    const ROOT::Math::PxPyPzEVector p2(part2);
-    const ROOT::Math::PxPyPzEVector pSum = p1 + p2;
-
-    const double tPx = pSum.Px();
-    const double tPy = pSum.Py();
-    const double tPz = pSum.Pz();
-    const double tE = pSum.E();
-
-    const double tPt = std::sqrt(tPx * tPx + tPy * tPy);
-    const double tMt = std::sqrt(tE * tE - tPz * tPz);
-
-    static constexpr double MinTransverseMomentum = 1e-9;
-    if (tPt < MinTransverseMomentum || tMt < MinTransverseMomentum) {
-      return {0.0f, 0.0f, 0.0f};
-    }
-
-    const double betaL = tPz / tE;
-    const double gammaL = tE / tMt;
-
-    const double kout1 = (p1.Px() * tPx + p1.Py() * tPy) / tPt;
-    const double kside1 = (-p1.Px() * tPy + p1.Py() * tPx) / tPt;
-    const double klong1 = gammaL * (p1.Pz() - betaL * p1.E());
-
-    const double kout2 = (p2.Px() * tPx + p2.Py() * tPy) / tPt;
-    const double kside2 = (p2.Py() * tPx - p2.Px() * tPy) / tPt;
-    const double klong2 = gammaL * (p2.Pz() - betaL * p2.E());
-
-    float qOut = static_cast<float>(kout1 - kout2);
-    float qSide = static_cast<float>(kside1 - kside2);
-    float qLong = static_cast<float>(klong1 - klong2);
-
-    return {qOut, qSide, qLong};
-  }
-
   o2::framework::HistogramRegistry* mHistogramRegistry = nullptr;
   bool mUsePdgMass = true;
   double mPdgMass1 = 0.;
@@ -1071,6 +1060,10 @@ class PairHistManager
 
   bool mPlotBertschPratt = false;
 
+  bool mBufferSparseFills = false;
+  float mBufferDenseFraction = 0.25f;
+  std::array<SparseFillBuffer, kPairHistogramLast> mFillBuffers;
+
   float mQout = 0.f;
   float mQside = 0.f;
   float mQlong = 0.f;
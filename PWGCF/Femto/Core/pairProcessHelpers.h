@@ -87,6 +87,7 @@ void processSameEvent(T1 const& SliceParticle,
     }
   }
   PairHistManager.fillMixingQaSe();
+  PairHistManager.flushFillBuffers();
 }
 
 // process same event for identical particles with mc information
@@ -159,6 +160,7 @@ void processSameEvent(T1 const& SliceParticle,
     }
   }
   PairHistManager.fillMixingQaSe();
+  PairHistManager.flushFillBuffers();
 }
 
 // process same event for non-identical particles
@@ -208,6 +210,7 @@ void processSameEvent(T1 const& SliceParticle1,
     }
   }
   PairHistManager.fillMixingQaSe();
+  PairHistManager.flushFillBuffers();
 }
 
 // process same event for non-identical particles with mc information
@@ -280,6 +283,7 @@ void processSameEvent(T1 const& SliceParticle1,
     }
   }
   PairHistManager.fillMixingQaSe();
+  PairHistManager.flushFillBuffers();
 }
 
 // mixed event in data
@@ -380,6 +384,7 @@ void processMixedEvent(T1 const& Collisions,
   if (windowSizeRaw > 0) {
     PairHistManager.fillMixingQaMePerMixingBin(windowSizeRaw, windowSizeEffective);
   }
+  PairHistManager.flushFillBuffers();
 }
 
 // process mixed event in mc
@@ -496,6 +501,7 @@ void processMixedEvent(T1 const& Collisions,
   if (windowSizeRaw > 0) {
     PairHistManager.fillMixingQaMePerMixingBin(windowSizeRaw, windowSizeEffective);
   }
+  PairHistManager.flushFillBuffers();
 }
 
 } // namespace pairprocesshelpers
@@ -16,9 +16,11 @@
 #ifndef PWGCF_FEMTO_CORE_TRIPLETHISTMANAGER_H_
 #define PWGCF_FEMTO_CORE_TRIPLETHISTMANAGER_H_
 
+#include "PWGCF/Core/PairKinematics.h"
 #include "PWGCF/Femto/Core/femtoUtils.h"
 #include "PWGCF/Femto/Core/histManager.h"
 #include "PWGCF/Femto/Core/modes.h"
+#include "PWGCF/Femto/Core/tripletPruning.h"
 
 #include <Framework/Configurable.h>
 #include <Framework/HistogramRegistry.h>
@@ -134,6 +136,7 @@ struct ConfTripletCuts : o2::framework::ConfigurableGroup {
   o2::framework::Configurable<float> mtMin{"mtMin", -1, "Minimal mt (set to -1 to deactivate)"};
   o2::framework::Configurable<bool> mixOnlyCommonAncestor{"mixOnlyCommonAncestor", false, "Require pair to have common anchestor (in the same event)"};
   o2::framework::Configurable<bool> mixOnlyNonCommonAncestor{"mixOnlyNonCommonAncestor", false, "Require pair to have non-common anchestor (in the same event)"};
+  o2::framework::Configurable<bool> pruneTriplets{"pruneTriplets", false, "Only build the triplets whose pairs are compatible with q3Max (needs q3Max > 0). The close triplet rejection histograms are then only filled for these triplets"};
 };
 
 // the enum gives the correct index in the array
@@ -260,6 +263,14 @@ class TripletHistManager
     mMtMin = ConfTripletCuts.mtMin.value;
     mMtMax = ConfTripletCuts.mtMax.value;
 
+    if (ConfTripletCuts.pruneTriplets.value) {
+      if (mQ3Max > 0.f) {
+        mPruner.setQ3Max(mQ3Max);
+      } else {
+        LOG(warn) << "Triplet pruning needs q3Max > 0, all triplets are built";
+      }
+    }
+
     mPlotPt1VsPt2VsPt3 = ConfTripletBinning.plotPt1VsPt2VsPt3.value;
     mPlotQ3VsPt1VsPt2VsPt3 = ConfTripletBinning.plotQ3VsPt1VsPt2VsPt3.value;
     mPlotQ3VsMtVsMult = ConfTripletBinning.plotQ3VsMtVsMult.value;
@@ -417,6 +428,23 @@ class TripletHistManager
 
   float getQ3() const { return mQ3; }
 
+  bool usePruning() const { return mPruner.isActive(); }
+  tripletpruning::TripletPruner& getPruner() { return mPruner; }
+
+  // momentum of particle i + 1 of the triplet as used for Q3
+  template <int i, typename T>
+  pairkinematics::Momentum getMomentum(T const& particle) const
+  {
+    static_assert(i >= 0 && i < 3, "Triplets have 3 particles");
+    if constexpr (i == 0) {
+      return pairkinematics::fromPtEtaPhiM(mAbsCharge1 * particle.pt(), particle.eta(), particle.phi(), mPdgMass1);
+    } else if constexpr (i == 1) {
+      return pairkinematics::fromPtEtaPhiM(mAbsCharge2 * particle.pt(), particle.eta(), particle.phi(), mPdgMass2);
+    } else {
+      return pairkinematics::fromPtEtaPhiM(mAbsCharge3 * particle.pt(), particle.eta(), particle.phi(), mPdgMass3);
+    }
+  }
+
   template <typename T1, typename T2, typename T3>
   void trackParticlesPerEvent(T1 const& particle1, T2 const& particle2, T3 const& particle3)
   {
@@ -674,6 +702,7 @@ class TripletHistManager
   float mQ3Max = -1.f;
   float mMtMin = -1.f;
   float mMtMax = -1.f;
+  tripletpruning::TripletPruner mPruner;
 
   // flags
   bool mPlot1d = true;
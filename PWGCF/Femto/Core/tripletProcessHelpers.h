@@ -17,12 +17,15 @@
 #define PWGCF_FEMTO_CORE_TRIPLETPROCESSHELPERS_H_
 
 #include "PWGCF/Femto/Core/modes.h"
+#include "PWGCF/Femto/Core/tripletPruning.h"
 #include "PWGCF/Femto/DataModel/FemtoTables.h"
 
 #include <Framework/ASoAHelpers.h>
 #include <Framework/Logger.h>
 
 #include <cstdint>
+#include <type_traits>
+#include <vector>
 
 namespace o2::analysis::femto
 {
@@ -36,6 +39,19 @@ enum TripletOrder : uint8_t {
   kOrder321, // swap 1&2&3
 };
 
+// copies the particles of a slice for the pruned triplet loop and adds their momenta to list `list` of the pruner
+template <int list, typename T1, typename T2>
+auto collectForPruning(T1 const& slice, T2& TripletHistManager)
+{
+  std::vector<std::decay_t<decltype(*slice.begin())>> particles;
+  particles.reserve(slice.size());
+  for (auto const& part : slice) {
+    particles.push_back(part);
+    TripletHistManager.getPruner().add(list, TripletHistManager.template getMomentum<list>(part));
+  }
+  return particles;
+}
+
 // process same event for identical 3 particles
 template <modes::Mode mode,
           typename T1,
@@ -60,17 +76,16 @@ void processSameEvent(T1 const& SliceParticle,
     ParticleHistManager.template fill<mode>(part, TrackTable);
   }
 
-  for (auto const& [p1, p2, p3] : o2::soa::combinations(o2::soa::CombinationsStrictlyUpperIndexPolicy(SliceParticle, SliceParticle, SliceParticle))) {
-
+  auto processTriplet = [&](auto const& p1, auto const& p2, auto const& p3) {
     // check if triplet is clean
     if (!TcManager.isCleanTriplet(p1, p2, p3, TrackTable)) {
-      continue;
+      return;
     }
 
     // check if triplet is close
     CtrManager.setTriplet(p1, p2, p3, TrackTable);
     if (CtrManager.isCloseTriplet()) {
-      continue;
+      return;
     }
 
     // Randomize pair order if enabled
@@ -100,6 +115,16 @@ void processSameEvent(T1 const& SliceParticle,
       TripletHistManager.template fill<mode>();
       TripletHistManager.trackParticlesPerEvent(p1, p2, p3);
     }
+  };
+
+  if (TripletHistManager.usePruning()) {
+    TripletHistManager.getPruner().clear();
+    const auto particles = collectForPruning<0>(SliceParticle, TripletHistManager);
+    TripletHistManager.getPruner().forEachTriplet(tripletpruning::kIdentical123, [&](int i1, int i2, int i3) { processTriplet(particles[i1], particles[i2], particles[i3]); });
+  } else {
+    for (auto const& [p1, p2, p3] : o2::soa::combinations(o2::soa::CombinationsStrictlyUpperIndexPolicy(SliceParticle, SliceParticle, SliceParticle))) {
+      processTriplet(p1, p2, p3);
+    }
   }
 
   TripletHistManager.fillMixingQaSe();
@@ -129,39 +154,49 @@ void processSameEvent(T1 const& SliceParticle1, // 1&2 have same species
     ParticleHistManager3.template fill<mode>(part, TrackTable);
   }
 
-  for (auto const& p3 : SliceParticle3) {
-    for (auto const& [p1, p2] : o2::soa::combinations(o2::soa::CombinationsStrictlyUpperIndexPolicy(SliceParticle1, SliceParticle1))) {
-
-      // check if triplet is clean
-      if (!TcManager.isCleanTriplet(p1, p2, p3, TrackTable)) {
-        continue;
-      }
+  auto processTriplet = [&](auto const& p1, auto const& p2, auto const& p3) {
+    // check if triplet is clean
+    if (!TcManager.isCleanTriplet(p1, p2, p3, TrackTable)) {
+      return;
+    }
 
-      // check if triplet is close
-      CtrManager.setTriplet(p1, p2, p3, TrackTable);
-      if (CtrManager.isCloseTriplet()) {
-        continue;
-      }
+    // check if triplet is close
+    CtrManager.setTriplet(p1, p2, p3, TrackTable);
+    if (CtrManager.isCloseTriplet()) {
+      return;
+    }
 
-      // Randomize triplet order if enabled
-      // only kOrder123 and kOrder213 are meaningful here since particle 1 & 2 are the same species
-      switch (tripletOrder) {
-        case kOrder213:
-          TripletHistManager.setTriplet(p2, p1, p3, Collision);
-          break;
-        case kOrder123:
-        default:
-          TripletHistManager.setTriplet(p1, p2, p3, Collision);
-          break;
-      }
+    // Randomize triplet order if enabled
+    // only kOrder123 and kOrder213 are meaningful here since particle 1 & 2 are the same species
+    switch (tripletOrder) {
+      case kOrder213:
+        TripletHistManager.setTriplet(p2, p1, p3, Collision);
+        break;
+      case kOrder123:
+      default:
+        TripletHistManager.setTriplet(p1, p2, p3, Collision);
+        break;
+    }
 
-      // fill deta-dphi histograms with q3 cutoff
-      CtrManager.fill(TripletHistManager.getQ3());
+    // fill deta-dphi histograms with q3 cutoff
+    CtrManager.fill(TripletHistManager.getQ3());
 
-      // if triplet cuts are configured check them before filling
-      if (TripletHistManager.checkTripletCuts()) {
-        TripletHistManager.template fill<mode>();
-        TripletHistManager.trackParticlesPerEvent(p1, p2, p3);
+    // if triplet cuts are configured check them before filling
+    if (TripletHistManager.checkTripletCuts()) {
+      TripletHistManager.template fill<mode>();
+      TripletHistManager.trackParticlesPerEvent(p1, p2, p3);
+    }
+  };
+
+  if (TripletHistManager.usePruning()) {
+    TripletHistManager.getPruner().clear();
+    const auto particles1 = collectForPruning<0>(SliceParticle1, TripletHistManager);
+    const auto particles3 = collectForPruning<2>(SliceParticle3, TripletHistManager);
+    TripletHistManager.getPruner().forEachTriplet(tripletpruning::kIdentical12, [&](int i1, int i2, int i3) { processTriplet(particles1[i1], particles1[i2], particles3[i3]); });
+  } else {
+    for (auto const& p3 : SliceParticle3) {
+      for (auto const& [p1, p2] : o2::soa::combinations(o2::soa::CombinationsStrictlyUpperIndexPolicy(SliceParticle1, SliceParticle1))) {
+        processTriplet(p1, p2, p3);
       }
     }
   }
@@ -206,17 +241,16 @@ void processSameEvent(T1 const& SliceParticle1,
     ParticleHistManager3.template fill<mode>(part, TrackTable);
   }
 
-  for (auto const& [p1, p2, p3] : o2::soa::combinations(o2::soa::CombinationsFullIndexPolicy(SliceParticle1, SliceParticle2, SliceParticle3))) {
-
+  auto processTriplet = [&](auto const& p1, auto const& p2, auto const& p3) {
     // check if triplet is clean
     if (!TcManager.isCleanTriplet(p1, p2, p3, TrackTable)) {
-      continue;
+      return;
     }
 
     // check if triplet is close
     CtrManager.setTriplet(p1, p2, p3, TrackTable);
     if (CtrManager.isCloseTriplet()) {
-      continue;
+      return;
     }
 
     TripletHistManager.setTriplet(p1, p2, p3, Collision);
@@ -229,6 +263,18 @@ void processSameEvent(T1 const& SliceParticle1,
       TripletHistManager.template fill<mode>();
       TripletHistManager.trackParticlesPerEvent(p1, p2, p3);
     }
+  };
+
+  if (TripletHistManager.usePruning()) {
+    TripletHistManager.getPruner().clear();
+    const auto particles1 = collectForPruning<0>(SliceParticle1, TripletHistManager);
+    const auto particles2 = collectForPruning<1>(SliceParticle2, TripletHistManager);
+    const auto particles3 = collectForPruning<2>(SliceParticle3, TripletHistManager);
+    TripletHistManager.getPruner().forEachTriplet(tripletpruning::kDistinct, [&](int i1, int i2, int i3) { processTriplet(particles1[i1], particles2[i2], particles3[i3]); });
+  } else {
+    for (auto const& [p1, p2, p3] : o2::soa::combinations(o2::soa::CombinationsFullIndexPolicy(SliceParticle1, SliceParticle2, SliceParticle3))) {
+      processTriplet(p1, p2, p3);
+    }
   }
 
   TripletHistManager.fillMixingQaSe();
@@ -266,15 +312,15 @@ void processSameEvent(T1 const& SliceParticle,
     ParticleHistManager.template fill<mode>(part, TrackTable, mcParticles, mcMothers, mcPartonicMothers);
   }
 
-  for (auto const& [p1, p2, p3] : o2::soa::combinations(o2::soa::CombinationsStrictlyUpperIndexPolicy(SliceParticle, SliceParticle, SliceParticle))) {
+  auto processTriplet = [&](auto const& p1, auto const& p2, auto const& p3) {
     // check if triplet is clean
     if (!TcManager.isCleanTriplet(p1, p2, p3, TrackTable, mcPartonicMothers)) {
-      continue;
+      return;
     }
     // check if triplet is close
     CtrManager.setTriplet(p1, p2, p3, TrackTable);
     if (CtrManager.isCloseTriplet()) {
-      continue;
+      return;
     }
     // Randomize triplet order if enabled
     switch (tripletOrder) {
@@ -301,6 +347,16 @@ void processSameEvent(T1 const& SliceParticle,
       TripletHistManager.template fill<mode>();
       TripletHistManager.trackParticlesPerEvent(p1, p2, p3);
     }
+  };
+
+  if (TripletHistManager.usePruning()) {
+    TripletHistManager.getPruner().clear();
+    const auto particles = collectForPruning<0>(SliceParticle, TripletHistManager);
+    TripletHistManager.getPruner().forEachTriplet(tripletpruning::kIdentical123, [&](int i1, int i2, int i3) { processTriplet(particles[i1], particles[i2], particles[i3]); });
+  } else {
+    for (auto const& [p1, p2, p3] : o2::soa::combinations(o2::soa::CombinationsStrictlyUpperIndexPolicy(SliceParticle, SliceParticle, SliceParticle))) {
+      processTriplet(p1, p2, p3);
+    }
   }
 
   TripletHistManager.fillMixingQaSe();
@@ -334,34 +390,45 @@ void processSameEvent(T1 const& SliceParticle1,
     ParticleHistManager3.template fill<mode>(part, TrackTable, mcParticles, mcMothers, mcPartonicMothers);
   }
 
-  for (auto const& p3 : SliceParticle3) {
-    for (auto const& [p1, p2] : o2::soa::combinations(o2::soa::CombinationsStrictlyUpperIndexPolicy(SliceParticle1, SliceParticle1))) {
-      // check if triplet is clean
-      if (!TcManager.isCleanTriplet(p1, p2, p3, TrackTable, mcPartonicMothers)) {
-        continue;
-      }
-      // check if triplet is close
-      CtrManager.setTriplet(p1, p2, p3, TrackTable);
-      if (CtrManager.isCloseTriplet()) {
-        continue;
-      }
-      // Randomize triplet order if enabled
-      // only kOrder123 and kOrder213 are meaningful here since particle 1 & 2 are the same species
-      switch (tripletOrder) {
-        case kOrder213:
-          TripletHistManager.setTripletMc(p2, p1, p3, mcParticles, Collision, mcCollisions);
-          break;
-        case kOrder123:
-        default:
-          TripletHistManager.setTripletMc(p1, p2, p3, mcParticles, Collision, mcCollisions);
-          break;
-      }
-      // fill deta-dphi histograms with q3 cutoff
-      CtrManager.fill(TripletHistManager.getQ3());
-      // if triplet cuts are configured check them before filling
-      if (TripletHistManager.checkTripletCuts()) {
-        TripletHistManager.template fill<mode>();
-        TripletHistManager.trackParticlesPerEvent(p1, p2, p3);
+  auto processTriplet = [&](auto const& p1, auto const& p2, auto const& p3) {
+    // check if triplet is clean
+    if (!TcManager.isCleanTriplet(p1, p2, p3, TrackTable, mcPartonicMothers)) {
+      return;
+    }
+    // check if triplet is close
+    CtrManager.setTriplet(p1, p2, p3, TrackTable);
+    if (CtrManager.isCloseTriplet()) {
+      return;
+    }
+    // Randomize triplet order if enabled
+    // only kOrder123 and kOrder213 are meaningful here since particle 1 & 2 are the same species
+    switch (tripletOrder) {
+      case kOrder213:
+        TripletHistManager.setTripletMc(p2, p1, p3, mcParticles, Collision, mcCollisions);
+        break;
+      case kOrder123:
+      default:
+        TripletHistManager.setTripletMc(p1, p2, p3, mcParticles, Collision, mcCollisions);
+        break;
+    }
+    // fill deta-dphi histograms with q3 cutoff
+    CtrManager.fill(TripletHistManager.getQ3());
+    // if triplet cuts are configured check them before filling
+    if (TripletHistManager.checkTripletCuts()) {
+      TripletHistManager.template fill<mode>();
+      TripletHistManager.trackParticlesPerEvent(p1, p2, p3);
+    }
+  };
+
+  if (TripletHistManager.usePruning()) {
+    TripletHistManager.getPruner().clear();
+    const auto particles1 = collectForPruning<0>(SliceParticle1, TripletHistManager);
+    const auto particles3 = collectForPruning<2>(SliceParticle3, TripletHistManager);
+    TripletHistManager.getPruner().forEachTriplet(tripletpruning::kIdentical12, [&](int i1, int i2, int i3) { processTriplet(particles1[i1], particles1[i2], particles3[i3]); });
+  } else {
+    for (auto const& p3 : SliceParticle3) {
+      for (auto const& [p1, p2] : o2::soa::combinations(o2::soa::CombinationsStrictlyUpperIndexPolicy(SliceParticle1, SliceParticle1))) {
+        processTriplet(p1, p2, p3);
       }
     }
   }
@@ -414,15 +481,15 @@ void processSameEvent(T1 const& SliceParticle1,
     ParticleHistManager3.template fill<mode>(part, TrackTable, mcParticles, mcMothers, mcPartonicMothers);
   }
 
-  for (auto const& [p1, p2, p3] : o2::soa::combinations(o2::soa::CombinationsFullIndexPolicy(SliceParticle1, SliceParticle2, SliceParticle3))) {
+  auto processTriplet = [&](auto const& p1, auto const& p2, auto const& p3) {
     // check if triplet is clean
     if (!TcManager.isCleanTriplet(p1, p2, p3, TrackTable, mcPartonicMothers)) {
-      continue;
+      return;
     }
     // check if triplet is close
     CtrManager.setTriplet(p1, p2, p3, TrackTable);
     if (CtrManager.isCloseTriplet()) {
-      continue;
+      return;
     }
     TripletHistManager.setTripletMc(p1, p2, p3, mcParticles, Collision, mcCollisions);
     // fill deta-dphi histograms with q3 cutoff
@@ -432,6 +499,18 @@ void processSameEvent(T1 const& SliceParticle1,
       TripletHistManager.template fill<mode>();
       TripletHistManager.trackParticlesPerEvent(p1, p2, p3);
     }
+  };
+
+  if (TripletHistManager.usePruning()) {
+    TripletHistManager.getPruner().clear();
+    const auto particles1 = collectForPruning<0>(SliceParticle1, TripletHistManager);
+    const auto particles2 = collectForPruning<1>(SliceParticle2, TripletHistManager);
+    const auto particles3 = collectForPruning<2>(SliceParticle3, TripletHistManager);
+    TripletHistManager.getPruner().forEachTriplet(tripletpruning::kDistinct, [&](int i1, int i2, int i3) { processTriplet(particles1[i1], particles2[i2], particles3[i3]); });
+  } else {
+    for (auto const& [p1, p2, p3] : o2::soa::combinations(o2::soa::CombinationsFullIndexPolicy(SliceParticle1, SliceParticle2, SliceParticle3))) {
+      processTriplet(p1, p2, p3);
+    }
   }
 
   TripletHistManager.fillMixingQaSe();
@@ -503,15 +582,15 @@ void processMixedEvent(T1 const& Collisions,
     bool hasValidTriplet = false;
     TripletHistManager.fillMixingQaMe(collision1, collision2, collision3);
 
-    for (auto const& [p1, p2, p3] : o2::soa::combinations(o2::soa::CombinationsFullIndexPolicy(sliceParticle1, sliceParticle2, sliceParticle3))) {
+    auto processTriplet = [&](auto const& p1, auto const& p2, auto const& p3) {
       // pair cleaning
       if (!TcManager.isCleanTriplet(p1, p2, p3, TrackTable)) {
-        continue;
+        return;
       }
       // Close pair rejection
       CtrManager.setTriplet(p1, p2, p3, TrackTable);
       if (CtrManager.isCloseTriplet()) {
-        continue;
+        return;
       }
 
       TripletHistManager.setTriplet(p1, p2, p3, collision1, collision2, collision3);
@@ -522,6 +601,18 @@ void processMixedEvent(T1 const& Collisions,
         TripletHistManager.trackParticlesPerEvent(p1, p2, p3);
         TripletHistManager.template fill<mode>();
       }
+    };
+
+    if (TripletHistManager.usePruning()) {
+      TripletHistManager.getPruner().clear();
+      const auto particles1 = collectForPruning<0>(sliceParticle1, TripletHistManager);
+      const auto particles2 = collectForPruning<1>(sliceParticle2, TripletHistManager);
+      const auto particles3 = collectForPruning<2>(sliceParticle3, TripletHistManager);
+      TripletHistManager.getPruner().forEachTriplet(tripletpruning::kDistinct, [&](int i1, int i2, int i3) { processTriplet(particles1[i1], particles2[i2], particles3[i3]); });
+    } else {
+      for (auto const& [p1, p2, p3] : o2::soa::combinations(o2::soa::CombinationsFullIndexPolicy(sliceParticle1, sliceParticle2, sliceParticle3))) {
+        processTriplet(p1, p2, p3);
+      }
     }
 
     if (hasValidTriplet) {
@@ -606,15 +697,15 @@ void processMixedEvent(T1 const& Collisions,
     bool hasValidTriplet = false;
     TripletHistManager.fillMixingQaMe(collision1, collision2, collision3);
 
-    for (auto const& [p1, p2, p3] : o2::soa::combinations(o2::soa::CombinationsFullIndexPolicy(sliceParticle1, sliceParticle2, sliceParticle3))) {
+    auto processTriplet = [&](auto const& p1, auto const& p2, auto const& p3) {
       // pair cleaning
       if (!TcManager.isCleanTriplet(p1, p2, p3, TrackTable)) {
-        continue;
+        return;
       }
       // Close pair rejection
       CtrManager.setTriplet(p1, p2, p3, TrackTable);
       if (CtrManager.isCloseTriplet()) {
-        continue;
+        return;
       }
 
       TripletHistManager.setTripletMc(p1, p2, p3, mcParticles, collision1, collision2, collision3, mcCollisions);
@@ -625,6 +716,18 @@ void processMixedEvent(T1 const& Collisions,
         TripletHistManager.trackParticlesPerEvent(p1, p2, p3);
         TripletHistManager.template fill<mode>();
       }
+    };
+
+    if (TripletHistManager.usePruning()) {
+      TripletHistManager.getPruner().clear();
+      const auto particles1 = collectForPruning<0>(sliceParticle1, TripletHistManager);
+      const auto particles2 = collectForPruning<1>(sliceParticle2, TripletHistManager);
+      const auto particles3 = collectForPruning<2>(sliceParticle3, TripletHistManager);
+      TripletHistManager.getPruner().forEachTriplet(tripletpruning::kDistinct, [&](int i1, int i2, int i3) { processTriplet(particles1[i1], particles2[i2], particles3[i3]); });
+    } else {
+      for (auto const& [p1, p2, p3] : o2::soa::combinations(o2::soa::CombinationsFullIndexPolicy(sliceParticle1, sliceParticle2, sliceParticle3))) {
+        processTriplet(p1, p2, p3);
+      }
     }
 
     if (hasValidTriplet) {
@@ -0,0 +1,209 @@
+// Copyright 2019-2025 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file tripletPruning.h
+/// \brief triplet enumeration restricted to the triplets which can pass the Q3 limit
+
+#ifndef PWGCF_FEMTO_CORE_TRIPLETPRUNING_H_
+#define PWGCF_FEMTO_CORE_TRIPLETPRUNING_H_
+
+#include "PWGCF/Core/PairKinematics.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+
+namespace o2::analysis::femto
+{
+namespace tripletpruning
+{
+
+enum TripletTopology : uint8_t {
+  kIdentical123, // all particles from list 0
+  kIdentical12,  // particle 1 & 2 from list 0, particle 3 from list 2
+  kDistinct,     // particle i from list i - 1
+};
+
+// Q3^2 = -(q12^2 + q23^2 + q31^2) is a sum of non-negative pair terms, -qij^2 = 4 k*_ij^2, so a triplet can only pass
+// the Q3 limit if each of its pairs does. The particles of each list are sorted by their momentum rapidity
+// w = asinh(|p| / m). Since the relative gamma factor of a pair is at least cosh(w_i - w_j), only the pairs inside a
+// window in w can have a k* below the limit, and -qij^2 is computed for those pairs only, once per pair. The triplets
+// are then built from the pair tables, skipping a third particle as soon as the pair terms exceed the limit.
+class TripletPruner
+{
+ public:
+  void setQ3Max(float q3Max)
+  {
+    // the limit is slightly widened, the exact Q3 cut is applied to the remaining triplets
+    mQ3Max2 = q3Max > 0.f ? static_cast<double>(q3Max) * q3Max * (1. + Tolerance) : -1.;
+  }
+
+  bool isActive() const { return mQ3Max2 > 0.; }
+
+  void clear()
+  {
+    for (auto& list : mLists) {
+      list.clear();
+    }
+  }
+
+  void add(int list, pairkinematics::Momentum const& p)
+  {
+    const double absP = std::sqrt(p.px * p.px + p.py * p.py + p.pz * p.pz);
+    mLists[list].push_back({p, p.m > 0. ? std::asinh(absP / p.m) : absP, static_cast<int>(mLists[list].size())});
+  }
+
+  // calls f(index1, index2, index3) with the indices in the order the particles were added; for identical particles
+  // the indices are ascending, as with the strictly upper combinations
+  template <typename F>
+  void forEachTriplet(TripletTopology topology, F&& f)
+  {
+    const bool identical12 = topology != kDistinct;
+    const bool identical123 = topology == kIdentical123;
+    auto& listA = mLists[0];
+    auto& listB = identical12 ? mLists[0] : mLists[1];
+    auto& listC = identical123 ? mLists[0] : mLists[2];
+    for (auto* list : {&listA, &listB, &listC}) {
+      std::sort(list->begin(), list->end(), [](Particle const& a, Particle const& b) { return a.w < b.w; });
+    }
+
+    fillTable(mTableAB, listA, listB, identical12);
+    const PairTable* tableAC = &mTableAB;
+    const PairTable* tableBC = &mTableAB;
+    if (!identical123) {
+      fillTable(mTableAC, listA, listC, false);
+      tableAC = &mTableAC;
+      tableBC = &mTableAC;
+      if (!identical12) {
+        fillTable(mTableBC, listB, listC, false);
+        tableBC = &mTableBC;
+      }
+    }
+
+    for (int a = 0; a < static_cast<int>(listA.size()); a++) {
+      auto [firstB, lastB] = mTableAB.window[a];
+      if (identical12) {
+        firstB = std::max(firstB, a + 1);
+      }
+      for (int b = firstB; b < lastB; b++) {
+        const double q12 = mTableAB.at(a, b);
+        if (q12 > mQ3Max2) {
+          continue;
+        }
+        auto [firstC, lastC] = tableAC->window[a];
+        if (identical123) {
+          firstC = std::max(firstC, b + 1);
+        }
+        for (int c = firstC; c < lastC; c++) {
+          const double q13 = tableAC->at(a, c);
+          if (q12 + q13 > mQ3Max2) {
+            continue;
+          }
+          if (q12 + q13 + tableBC->at(b, c) > mQ3Max2) {
+            continue;
+          }
+          std::array<int, 3> indices{listA[a].index, listB[b].index, listC[c].index};
+          if (identical123) {
+            std::sort(indices.begin(), indices.end());
+          } else if (identical12 && indices[0] > indices[1]) {
+            std::swap(indices[0], indices[1]);
+          }
+          f(indices[0], indices[1], indices[2]);
+        }
+      }
+    }
+  }
+
+ private:
+  static constexpr double Tolerance = 1e-5;
+
+  struct Particle {
+    pairkinematics::Momentum p;
+    double w = 0.;
+    int index = 0;
+  };
+
+  struct PairTable {
+    int nSecond = 0;
+    std::vector<double> q2;                  // -q_ij^2 for the pairs inside the window, infinity outside
+    std::vector<std::pair<int, int>> window; // per particle of the first list, range in the second list
+    double at(int i, int j) const { return q2[static_cast<std::size_t>(i) * nSecond + j]; }
+  };
+
+  // same as the qij four-vector of the triplet histogram manager, -qij^2 = -(pi - pj)^2 + (mi^2 - mj^2)^2 / s
+  static double pairQ2(pairkinematics::Momentum const& pi, pairkinematics::Momentum const& pj)
+  {
+    const double sumPx = pi.px + pj.px, sumPy = pi.py + pj.py, sumPz = pi.pz + pj.pz, sumE = pi.e + pj.e;
+    const double dPx = pi.px - pj.px, dPy = pi.py - pj.py, dPz = pi.pz - pj.pz, dE = pi.e - pj.e;
+    const double s = sumE * sumE - (sumPx * sumPx + sumPy * sumPy + sumPz * sumPz);
+    const double mi2 = pi.e * pi.e - (pi.px * pi.px + pi.py * pi.py + pi.pz * pi.pz);
+    const double mj2 = pj.e * pj.e - (pj.px * pj.px + pj.py * pj.py + pj.pz * pj.pz);
+    const double q2 = dPx * dPx + dPy * dPy + dPz * dPz - dE * dE;
+    return s != 0. ? q2 + (mi2 - mj2) * (mi2 - mj2) / s : q2;
+  }
+
+  // largest w_i - w_j for which -qij^2 = 4 k*^2 can be below the limit
+  double maxRapidityDifference(double mi, double mj) const
+  {
+    if (!(mi > 0.) || !(mj > 0.)) {
+      return std::numeric_limits<double>::infinity();
+    }
+    const double kstar2 = mQ3Max2 / 4.;
+    const double sqrtS = std::sqrt(mi * mi + kstar2) + std::sqrt(mj * mj + kstar2);
+    const double coshMax = (sqrtS * sqrtS - mi * mi - mj * mj) / (2. * mi * mj);
+    return std::acosh(std::max(1., coshMax)) * (1. + Tolerance) + Tolerance;
+  }
+
+  void fillTable(PairTable& table, std::vector<Particle> const& first, std::vector<Particle> const& second, bool sameList)
+  {
+    table.nSecond = second.size();
+    table.q2.assign(first.size() * second.size(), std::numeric_limits<double>::infinity());
+    table.window.resize(first.size());
+    if (first.empty() || second.empty()) {
+      return;
+    }
+    const double maxDeltaW = maxRapidityDifference(first.front().p.m, second.front().p.m);
+    auto lower = second.begin();
+    auto upper = second.begin();
+    for (int i = 0; i < static_cast<int>(first.size()); i++) {
+      // the first list is sorted as well, the window only moves forward
+      while (lower != second.end() && lower->w < first[i].w - maxDeltaW) {
+        ++lower;
+      }
+      while (upper != second.end() && !(upper->w > first[i].w + maxDeltaW)) {
+        ++upper;
+      }
+      table.window[i] = {static_cast<int>(lower - second.begin()), static_cast<int>(upper - second.begin())};
+      for (int j = table.window[i].first; j < table.window[i].second; j++) {
+        if (sameList && j < i) {
+          table.q2[static_cast<std::size_t>(i) * table.nSecond + j] = table.at(j, i);
+        } else if (!sameList || j != i) {
+          table.q2[static_cast<std::size_t>(i) * table.nSecond + j] = pairQ2(first[i].p, second[j].p);
+        }
+      }
+    }
+  }
+
+  double mQ3Max2 = -1.;
+  std::array<std::vector<Particle>, 3> mLists;
+  PairTable mTableAB;
+  PairTable mTableAC;
+  PairTable mTableBC;
+};
+
+} // namespace tripletpruning
+} // namespace o2::analysis::femto
+
+#endif // PWGCF_FEMTO_CORE_TRIPLETPRUNING_H_
@@ -16,6 +16,8 @@
 #ifndef PWGCF_FEMTO3D_CORE_FEMTO3DPAIRTASK_H_
 #define PWGCF_FEMTO3D_CORE_FEMTO3DPAIRTASK_H_
 
+#include "PWGCF/Core/PairKinematics.h"
+
 #include <CommonConstants/MathConstants.h>
 #include <CommonConstants/PhysicsConstants.h>
 
@@ -345,12 +347,10 @@ float FemtoPair<TrackType>::GetKstar() const
   if (_PDG1 * _PDG2 == 0)
     return -1000;
 
-  TLorentzVector first4momentum;
-  first4momentum.SetPtEtaPhiM(_first->pt(), _first->eta(), _first->phi(), particle_mass(_PDG1));
-  TLorentzVector second4momentum;
-  second4momentum.SetPtEtaPhiM(_second->pt(), _second->eta(), _second->phi(), particle_mass(_PDG2));
-
-  return GetKstarFrom4vectors(first4momentum, second4momentum, _isidentical);
+  // same as GetKstarFrom4vectors: q_inv / 2 for identical particles, k* in the pair rest frame otherwise
+  const auto pair = o2::analysis::pairkinematics::computePair(o2::analysis::pairkinematics::fromPtEtaPhiM(_first->pt(), _first->eta(), _first->phi(), particle_mass(_PDG1)),
+                                                              o2::analysis::pairkinematics::fromPtEtaPhiM(_second->pt(), _second->eta(), _second->phi(), particle_mass(_PDG2)));
+  return _isidentical ? 0.5f * pair.qinv : pair.kstar;
 }
 
 template <typename TrackType>
@@ -363,12 +363,10 @@ TVector3 FemtoPair<TrackType>::GetQLCMS() const
   if (_PDG1 * _PDG2 == 0)
     return TVector3(-1000, -1000, -1000);
 
-  TLorentzVector first4momentum;
-  first4momentum.SetPtEtaPhiM(_first->pt(), _first->eta(), _first->phi(), particle_mass(_PDG1));
-  TLorentzVector second4momentum;
-  second4momentum.SetPtEtaPhiM(_second->pt(), _second->eta(), _second->phi(), particle_mass(_PDG2));
-
-  return GetQLCMSFrom4vectors(first4momentum, second4momentum);
+  // out along the pair kT, as GetQLCMSFrom4vectors
+  const auto lcms = o2::analysis::pairkinematics::computeLCMS(o2::analysis::pairkinematics::fromPtEtaPhiM(_first->pt(), _first->eta(), _first->phi(), particle_mass(_PDG1)),
+                                                              o2::analysis::pairkinematics::fromPtEtaPhiM(_second->pt(), _second->eta(), _second->phi(), particle_mass(_PDG2)));
+  return TVector3(lcms.qout, lcms.qside, lcms.qlong);
 }
 
 template <typename TrackType>
@@ -395,14 +393,9 @@ float FemtoPair<TrackType>::GetMt() const
   if (_PDG1 * _PDG2 == 0)
     return -1000;
 
-  TLorentzVector first4momentum;
-  first4momentum.SetPtEtaPhiM(_first->pt(), _first->eta(), _first->phi(), particle_mass(_PDG1));
-  TLorentzVector second4momentum;
-  second4momentum.SetPtEtaPhiM(_second->pt(), _second->eta(), _second->phi(), particle_mass(_PDG2));
-
-  TLorentzVector fourmomentasum = first4momentum + second4momentum;
-
-  return 0.5 * fourmomentasum.Mt();
+  const auto pair = o2::analysis::pairkinematics::computePair(o2::analysis::pairkinematics::fromPtEtaPhiM(_first->pt(), _first->eta(), _first->phi(), particle_mass(_PDG1)),
+                                                              o2::analysis::pairkinematics::fromPtEtaPhiM(_second->pt(), _second->eta(), _second->phi(), particle_mass(_PDG2)));
+  return pair.mt;
 }
 
 template <typename TrackType>
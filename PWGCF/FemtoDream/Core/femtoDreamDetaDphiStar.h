@@ -796,6 +796,9 @@ class FemtoDreamDetaDphiStar
   std::array<std::shared_ptr<THnSparse>, 3> histdetadpi_eta{};
   std::array<std::shared_ptr<THnSparse>, 3> histdetadpi_phi{};
 
+  std::vector<float> mPhiAtRadii1; ///< phi* of particle 1 at the radii of the pair being checked
+  std::vector<float> mPhiAtRadii2; ///< phi* of particle 2 at the radii of the pair being checked
+
   ///  Calculate phi at all required radii stored in tmpRadiiTPC
   /// Magnetic field to be provided in Tesla
   template <typename T>
@@ -938,8 +941,11 @@ class FemtoDreamDetaDphiStar
   template <bool isHF = false, typename T1, typename T2>
   float AveragePhiStar(const T1& part1, const T2& part2, int iHist, bool* sameCharge)
   {
-    std::vector<float> tmpVec1;
-    std::vector<float> tmpVec2;
+    // the buffers are members, so no allocation is done per pair
+    auto& tmpVec1 = mPhiAtRadii1;
+    auto& tmpVec2 = mPhiAtRadii2;
+    tmpVec1.clear();
+    tmpVec2.clear();
     auto charge1 = PhiAtRadiiTPC(part1, tmpVec1);
     if constexpr (!isHF) {
       auto charge2 = PhiAtRadiiTPC(part2, tmpVec2);
@@ -16,6 +16,8 @@
 #ifndef PWGCF_FEMTODREAM_CORE_FEMTODREAMMATH_H_
 #define PWGCF_FEMTODREAM_CORE_FEMTODREAMMATH_H_
 
+#include "PWGCF/Core/PairKinematics.h"
+
 #include <Math/GenVector/Boost.h>
 #include <Math/Vector4D.h> // IWYU pragma: keep (do not replace with Math/Vector4Dfwd.h)
 #include <Math/Vector4Dfwd.h>
@@ -42,24 +44,9 @@ class FemtoDreamMath
   template <typename T1, typename T2>
   static float getkstar(const T1& part1, const float mass1, const T2& part2, const float mass2)
   {
-    const ROOT::Math::PtEtaPhiMVector vecpart1(part1.pt(), part1.eta(), part1.phi(), mass1);
-    const ROOT::Math::PtEtaPhiMVector vecpart2(part2.pt(), part2.eta(), part2.phi(), mass2);
-    const ROOT::Math::PtEtaPhiMVector trackSum = vecpart1 + vecpart2;
-
-    const float beta = trackSum.Beta();
-    const float betax = beta * std::cos(trackSum.Phi()) * std::sin(trackSum.Theta());
-    const float betay = beta * std::sin(trackSum.Phi()) * std::sin(trackSum.Theta());
-    const float betaz = beta * std::cos(trackSum.Theta());
-
-    ROOT::Math::PxPyPzMVector PartOneCMS(vecpart1);
-    ROOT::Math::PxPyPzMVector PartTwoCMS(vecpart2);
-
-    const ROOT::Math::Boost boostPRF = ROOT::Math::Boost(-betax, -betay, -betaz);
-    PartOneCMS = boostPRF(PartOneCMS);
-    PartTwoCMS = boostPRF(PartTwoCMS);
-
-    const ROOT::Math::PxPyPzMVector trackRelK = PartOneCMS - PartTwoCMS;
-    return 0.5 * trackRelK.P();
+    const auto momentum1 = pairkinematics::fromPtEtaPhiM(part1.pt(), part1.eta(), part1.phi(), mass1);
+    const auto momentum2 = pairkinematics::fromPtEtaPhiM(part2.pt(), part2.eta(), part2.phi(), mass2);
+    return pairkinematics::computePair(momentum1, momentum2).kstar;
   }
   /// Compute the qij of a pair of particles
   /// \tparam T type of tracks
@@ -121,10 +108,9 @@ class FemtoDreamMath
   template <typename T1, typename T2>
   static float getkT(const T1& part1, const float mass1, const T2& part2, const float mass2)
   {
-    const ROOT::Math::PtEtaPhiMVector vecpart1(part1.pt(), part1.eta(), part1.phi(), mass1);
-    const ROOT::Math::PtEtaPhiMVector vecpart2(part2.pt(), part2.eta(), part2.phi(), mass2);
-    const ROOT::Math::PtEtaPhiMVector trackSum = vecpart1 + vecpart2;
-    return 0.5 * trackSum.Pt();
+    const auto momentum1 = pairkinematics::fromPtEtaPhiM(part1.pt(), part1.eta(), part1.phi(), mass1);
+    const auto momentum2 = pairkinematics::fromPtEtaPhiM(part2.pt(), part2.eta(), part2.phi(), mass2);
+    return pairkinematics::computePair(momentum1, momentum2).kt;
   }
 
   /// Compute the transverse mass of a pair of particles
@@ -19,6 +19,8 @@
 #ifndef PWGCF_FEMTOUNIVERSE_CORE_FEMTOUNIVERSEMATH_H_
 #define PWGCF_FEMTOUNIVERSE_CORE_FEMTOUNIVERSEMATH_H_
 
+#include "PWGCF/Core/PairKinematics.h"
+
 #include <Math/GenVector/Boost.h>
 #include <Math/Vector4D.h> // IWYU pragma: keep (do not replace with Math/Vector4Dfwd.h)
 #include <Math/Vector4Dfwd.h>
@@ -35,6 +37,20 @@ namespace o2::analysis::femto_universe
 class FemtoUniverseMath
 {
  public:
+  /// Cartesian momentum of a particle, taken from the FDMomenta columns when the particle table is joined with them
+  /// \tparam T type of tracks
+  /// \param part Particle
+  /// \param mass Mass of the particle
+  template <typename T>
+  static pairkinematics::Momentum getMomentum(const T& part, const float mass)
+  {
+    if constexpr (requires { part.pxStore(); }) {
+      return pairkinematics::fromPxPyPzM(part.pxStore(), part.pyStore(), part.pzStore(), mass);
+    } else {
+      return pairkinematics::fromPtEtaPhiM(part.pt(), part.eta(), part.phi(), mass);
+    }
+  }
+
   /// Compute the k* of a pair of particles
   /// \tparam T type of tracks
   /// \param part1 Particle 1
@@ -44,24 +60,9 @@ class FemtoUniverseMath
   template <typename T>
   static float getkstar(const T& part1, const float mass1, const T& part2, const float mass2)
   {
-    const ROOT::Math::PtEtaPhiMVector vecpart1(part1.pt(), part1.eta(), part1.phi(), mass1);
-    const ROOT::Math::PtEtaPhiMVector vecpart2(part2.pt(), part2.eta(), part2.phi(), mass2);
-    const ROOT::Math::PtEtaPhiMVector trackSum = vecpart1 + vecpart2;
-
-    const float beta = trackSum.Beta();
-    const float betax = beta * std::cos(trackSum.Phi()) * std::sin(trackSum.Theta());
-    const float betay = beta * std::sin(trackSum.Phi()) * std::sin(trackSum.Theta());
-    const float betaz = beta * std::cos(trackSum.Theta());
-
-    ROOT::Math::PxPyPzMVector partOneCMS(vecpart1);
-    ROOT::Math::PxPyPzMVector partTwoCMS(vecpart2);
-
-    const ROOT::Math::Boost boostPRF = ROOT::Math::Boost(-betax, -betay, -betaz);
-    partOneCMS = boostPRF(partOneCMS);
-    partTwoCMS = boostPRF(partTwoCMS);
-
-    const ROOT::Math::PxPyPzMVector trackRelK = partOneCMS - partTwoCMS;
-    return 0.5 * trackRelK.P();
+    const auto momentum1 = getMomentum(part1, mass1);
+    const auto momentum2 = getMomentum(part2, mass2);
+    return pairkinematics::computePair(momentum1, momentum2).kstar;
   }
 
   /// Boost particles from LAB Frame to Pair Rest Frame (for lambda daughters)
@@ -151,10 +152,9 @@ class FemtoUniverseMath
   template <typename T>
   static float getkT(const T& part1, const float mass1, const T& part2, const float mass2)
   {
-    const ROOT::Math::PtEtaPhiMVector vecpart1(part1.pt(), part1.eta(), part1.phi(), mass1);
-    const ROOT::Math::PtEtaPhiMVector vecpart2(part2.pt(), part2.eta(), part2.phi(), mass2);
-    const ROOT::Math::PtEtaPhiMVector trackSum = vecpart1 + vecpart2;
-    return 0.5 * trackSum.Pt();
+    const auto momentum1 = getMomentum(part1, mass1);
+    const auto momentum2 = getMomentum(part2, mass2);
+    return pairkinematics::computePair(momentum1, momentum2).kt;
   }
 
   /// Compute the transverse mass of a pair of particles
@@ -149,6 +149,10 @@ DECLARE_SOA_COLUMN(DecayVtxY, decayVtxY, float);     //! Y position of the decay
 DECLARE_SOA_COLUMN(DecayVtxZ, decayVtxZ, float);     //! Z position of the decay vertex
 DECLARE_SOA_COLUMN(MKaon, mKaon, float);             //! The invariant mass of V0 candidate, assuming kaon
 
+DECLARE_SOA_COLUMN(PxStore, pxStore, float); //! Stored momentum in x in GeV/c
+DECLARE_SOA_COLUMN(PyStore, pyStore, float); //! Stored momentum in y in GeV/c
+DECLARE_SOA_COLUMN(PzStore, pzStore, float); //! Stored momentum in z in GeV/c
+
 } // namespace femtouniverseparticle
 
 DECLARE_SOA_TABLE(FDParticles, "AOD", "FDPARTICLE",
@@ -171,6 +175,12 @@ DECLARE_SOA_TABLE(FDParticles, "AOD", "FDPARTICLE",
                   femtouniverseparticle::P<femtouniverseparticle::Pt, femtouniverseparticle::Eta>);
 using FDParticle = FDParticles::iterator;
 
+DECLARE_SOA_TABLE(FDMomenta, "AOD", "FDMOMENTUM", //! Table joinable to FDParticles with the Cartesian momentum, computed once in the producer
+                  femtouniverseparticle::PxStore,
+                  femtouniverseparticle::PyStore,
+                  femtouniverseparticle::PzStore);
+using FDMomentum = FDMomenta::iterator;
+
 /// FemtoUniverseCascadeTrack
 namespace femtouniversecascparticle
 {
@@ -80,6 +80,7 @@
 #include <optional>
 #include <set>
 #include <string>
+#include <utility>
 #include <vector>
 
 using namespace o2;
@@ -132,6 +133,7 @@ struct FemtoUniverseProducerTask {
   Produces<aod::FdCollisions> outputCollision;
   Produces<aod::FDExtCollisions> outputCollExtra;
   Produces<aod::FDParticles> outputParts;
+  Produces<aod::FDMomenta> outputPartsMomenta;
   Produces<aod::FdMCParticles> outputPartsMC;
   Produces<aod::FDExtParticles> outputDebugParts;
   Produces<aod::FDItsParticles> outputDebugITSParts;
@@ -143,6 +145,7 @@ struct FemtoUniverseProducerTask {
 
   Configurable<bool> confIsDebug{"confIsDebug", true, "Enable Debug tables"};
   Configurable<bool> confFillITSPid{"confFillITSPid", false, "Fill ITSPid information"};
+  Configurable<bool> confFillMomenta{"confFillMomenta", false, "Fill the table with the Cartesian momentum of the particles"};
   Configurable<bool> confIsUseCutculator{"confIsUseCutculator", true, "Enable cutculator for track cuts"};
   // Choose if filtering or skimming version is run
   // Configurable<bool> confIsTrigger{"confIsTrigger", false, "Store all collisions"}; //Commented: not used configurable
@@ -771,6 +774,17 @@ struct FemtoUniverseProducerTask {
     mRunNumber = bc.runNumber();
   }
 
+  /// fills the particle table and, with confFillMomenta, the joinable table with the Cartesian momentum, so that
+  /// the pair tasks do not recompute it from pt, eta and phi for every pair
+  template <typename... Ts>
+  void outputParticle(int collisionIndex, float pt, float eta, float phi, Ts&&... columns)
+  {
+    outputParts(collisionIndex, pt, eta, phi, std::forward<Ts>(columns)...);
+    if (confFillMomenta) {
+      outputPartsMomenta(pt * std::cos(phi), pt * std::sin(phi), pt * std::sinh(eta));
+    }
+  }
+
   template <bool isTrackOrV0, bool isPhiOrD0, bool isCasc, typename ParticleType>
   void fillDebugParticle(ParticleType const& particle)
   {
@@ -1271,7 +1285,7 @@ struct FemtoUniverseProducerTask {
       auto cutContainer = trackCuts.getCutContainer<aod::femtouniverseparticle::CutContainerType>(track);
 
       // now the table is filled
-      outputParts(outputCollision.lastIndex(), track.pt(), track.eta(),
+      outputParticle(outputCollision.lastIndex(), track.pt(), track.eta(),
                   track.phi(), aod::femtouniverseparticle::ParticleType::kTrack,
                   cutContainer.at(
                     femto_universe_track_selection::TrackContainerPosition::kCuts),
@@ -1331,7 +1345,7 @@ struct FemtoUniverseProducerTask {
       auto cutContainerITS = trackCuts.getCutContainerWithITS<aod::femtouniverseparticle::CutContainerType>(track);
 
       // now the table is filled
-      outputParts(outputCollision.lastIndex(), track.pt(), track.eta(), track.phi(),
+      outputParticle(outputCollision.lastIndex(), track.pt(), track.eta(), track.phi(),
                   aod::femtouniverseparticle::ParticleType::kTrack,
                   cutContainerITS.at(
                     femto_universe_track_selection::TrackContainerPosition::kCuts),
@@ -1386,7 +1400,7 @@ struct FemtoUniverseProducerTask {
       rowInPrimaryTrackTablePos = getRowDaughters(postrackID, tmpIDtrack);
       childIDs[0] = rowInPrimaryTrackTablePos;
       childIDs[1] = 0;
-      outputParts(outputCollision.lastIndex(), v0.positivept(),
+      outputParticle(outputCollision.lastIndex(), v0.positivept(),
                   v0.positiveeta(), v0.positivephi(),
                   aod::femtouniverseparticle::ParticleType::kV0Child,
                   cutContainerV0.at(femto_universe_v0_selection::V0ContainerPosition::kPosCuts),
@@ -1404,7 +1418,7 @@ struct FemtoUniverseProducerTask {
       rowInPrimaryTrackTableNeg = getRowDaughters(negtrackID, tmpIDtrack);
       childIDs[0] = 0;
       childIDs[1] = rowInPrimaryTrackTableNeg;
-      outputParts(outputCollision.lastIndex(),
+      outputParticle(outputCollision.lastIndex(),
                   v0.negativept(),
                   v0.negativeeta(),
                   v0.negativephi(),
@@ -1420,7 +1434,7 @@ struct FemtoUniverseProducerTask {
         fillMCParticle(negtrack, o2::aod::femtouniverseparticle::ParticleType::kV0Child);
       }
       std::vector<int> indexChildID = {rowOfPosTrack, rowOfNegTrack};
-      outputParts(outputCollision.lastIndex(),
+      outputParticle(outputCollision.lastIndex(),
                   v0.pt(),
                   v0.eta(),
                   v0.phi(),
@@ -1461,7 +1475,7 @@ struct FemtoUniverseProducerTask {
         if (d.pdgCode() == ConfV0Selection.confV0PDGMCTruth.value[0]) { // Check for a positive child
           foundPos = true;
 
-          outputParts(outputCollision.lastIndex(),
+          outputParticle(outputCollision.lastIndex(),
                       d.pt(),
                       d.eta(),
                       d.phi(),
@@ -1477,7 +1491,7 @@ struct FemtoUniverseProducerTask {
         } else if (d.pdgCode() == ConfV0Selection.confV0PDGMCTruth.value[1]) { // Check for a negative child
           foundNeg = true;
 
-          outputParts(outputCollision.lastIndex(),
+          outputParticle(outputCollision.lastIndex(),
                       d.pt(),
                       d.eta(),
                       d.phi(),
@@ -1498,7 +1512,7 @@ struct FemtoUniverseProducerTask {
 
       childIDs[0] = rowPos;
       childIDs[1] = rowNeg;
-      outputParts(outputCollision.lastIndex(),
+      outputParticle(outputCollision.lastIndex(),
                   mc.pt(),
                   mc.eta(),
                   mc.phi(),
@@ -1530,7 +1544,7 @@ struct FemtoUniverseProducerTask {
       }
 
       std::vector<int> childIDs = {0, 0};
-      outputParts(outputCollision.lastIndex(),
+      outputParticle(outputCollision.lastIndex(),
                   mc.pt(),
                   mc.eta(),
                   mc.phi(),
@@ -1570,7 +1584,7 @@ struct FemtoUniverseProducerTask {
       childIDs[1] = 0;                         // neg
       childIDs[2] = 0;                         // bachelor
       float hasTOF = posTrackCasc.hasTOF() ? 1 : 0;
-      outputParts(outputCollision.lastIndex(),
+      outputParticle(outputCollision.lastIndex(),
                   casc.positivept(),
                   casc.positiveeta(),
                   casc.positivephi(),
@@ -1592,7 +1606,7 @@ struct FemtoUniverseProducerTask {
       childIDs[1] = rowInPrimaryTrackTableNeg; // neg
       childIDs[2] = 0;                         // bachelor
       hasTOF = negTrackCasc.hasTOF() ? 1 : 0;
-      outputParts(outputCollision.lastIndex(),
+      outputParticle(outputCollision.lastIndex(),
                   casc.negativept(),
                   casc.negativeeta(),
                   casc.negativephi(),
@@ -1615,7 +1629,7 @@ struct FemtoUniverseProducerTask {
       childIDs[1] = 0;                          // neg
       childIDs[2] = rowInPrimaryTrackTableBach; // bachelor
       hasTOF = bachTrackCasc.hasTOF() ? 1 : 0;
-      outputParts(outputCollision.lastIndex(),
+      outputParticle(outputCollision.lastIndex(),
                   casc.bachelorpt(),
                   casc.bacheloreta(),
                   casc.bachelorphi(),
@@ -1632,7 +1646,7 @@ struct FemtoUniverseProducerTask {
       }
       // cascade
       std::vector<int> indexCascChildID = {rowOfPosTrack, rowOfNegTrack, rowOfBachTrack};
-      outputParts(outputCollision.lastIndex(),
+      outputParticle(outputCollision.lastIndex(),
                   casc.pt(),
                   casc.eta(),
                   casc.phi(),
@@ -1727,7 +1741,7 @@ struct FemtoUniverseProducerTask {
       }
 
       if (isD0D0bar) {
-        outputParts(outputCollision.lastIndex(),
+        outputParticle(outputCollision.lastIndex(),
                     hfCand.ptProng0(),
                     RecoDecay::eta(std::array{hfCand.pxProng0(), hfCand.pyProng0(), hfCand.pzProng0()}), // eta
                     RecoDecay::phi(hfCand.pxProng0(), hfCand.pyProng0()),                                // phi
@@ -1749,7 +1763,7 @@ struct FemtoUniverseProducerTask {
         childIDs[0] = 0;
         childIDs[1] = rowInPrimaryTrackTableNeg;
 
-        outputParts(outputCollision.lastIndex(),
+        outputParticle(outputCollision.lastIndex(),
                     hfCand.ptProng1(),
                     RecoDecay::eta(std::array{hfCand.pxProng1(), hfCand.pyProng1(), hfCand.pzProng1()}), // eta
                     RecoDecay::phi(hfCand.pxProng1(), hfCand.pyProng1()),                                // phi
@@ -1766,7 +1780,7 @@ struct FemtoUniverseProducerTask {
         }
         std::vector<int> indexChildID = {rowOfPosTrack, rowOfNegTrack};
 
-        outputParts(outputCollision.lastIndex(),
+        outputParticle(outputCollision.lastIndex(),
                     hfCand.pt(),
                     hfCand.eta(),
                     hfCand.phi(),
@@ -1849,7 +1863,7 @@ struct FemtoUniverseProducerTask {
       }
 
       if (isD0D0bar) {
-        outputParts(outputCollision.lastIndex(),
+        outputParticle(outputCollision.lastIndex(),
                     hfCand.ptProng0(),
                     RecoDecay::eta(std::array{hfCand.pxProng0(), hfCand.pyProng0(), hfCand.pzProng0()}), // eta
                     RecoDecay::phi(hfCand.pxProng0(), hfCand.pyProng0()),                                // phi
@@ -1871,7 +1885,7 @@ struct FemtoUniverseProducerTask {
         childIDs[0] = 0;
         childIDs[1] = rowInPrimaryTrackTableNeg;
 
-        outputParts(outputCollision.lastIndex(),
+        outputParticle(outputCollision.lastIndex(),
                     hfCand.ptProng1(),
                     RecoDecay::eta(std::array{hfCand.pxProng1(), hfCand.pyProng1(), hfCand.pzProng1()}), // eta
                     RecoDecay::phi(hfCand.pxProng1(), hfCand.pyProng1()),                                // phi
@@ -1888,7 +1902,7 @@ struct FemtoUniverseProducerTask {
         }
         std::vector<int> indexChildID = {rowOfPosTrack, rowOfNegTrack};
 
-        outputParts(outputCollision.lastIndex(),
+        outputParticle(outputCollision.lastIndex(),
                     hfCand.pt(),
                     hfCand.eta(),
                     hfCand.phi(),
@@ -1990,7 +2004,7 @@ struct FemtoUniverseProducerTask {
         }
 
         if (isD0D0bar) {
-          outputParts(outputCollision.lastIndex(),
+          outputParticle(outputCollision.lastIndex(),
                       hfCand.ptProng0(),
                       RecoDecay::eta(std::array{hfCand.pxProng0(), hfCand.pyProng0(), hfCand.pzProng0()}), // eta
                       RecoDecay::phi(hfCand.pxProng0(), hfCand.pyProng0()),                                // phi
@@ -2012,7 +2026,7 @@ struct FemtoUniverseProducerTask {
           childIDs[0] = 0;
           childIDs[1] = rowInPrimaryTrackTableNeg;
 
-          outputParts(outputCollision.lastIndex(),
+          outputParticle(outputCollision.lastIndex(),
                       hfCand.ptProng1(),
                       RecoDecay::eta(std::array{hfCand.pxProng1(), hfCand.pyProng1(), hfCand.pzProng1()}), // eta
                       RecoDecay::phi(hfCand.pxProng1(), hfCand.pyProng1()),                                // phi
@@ -2029,7 +2043,7 @@ struct FemtoUniverseProducerTask {
           }
           std::vector<int> indexChildID = {rowOfPosTrack, rowOfNegTrack};
 
-          outputParts(outputCollision.lastIndex(),
+          outputParticle(outputCollision.lastIndex(),
                       hfCand.pt(),
                       hfCand.eta(),
                       hfCand.phi(),
@@ -2138,7 +2152,7 @@ struct FemtoUniverseProducerTask {
       childIDs[0] = rowInPrimaryTrackTablePos;
       childIDs[1] = 0;
 
-      outputParts(outputCollision.lastIndex(), p1.pt(),
+      outputParticle(outputCollision.lastIndex(), p1.pt(),
                   p1.eta(), p1.phi(),
                   aod::femtouniverseparticle::ParticleType::kPhiChild,
                   -999,       // cutContainer
@@ -2156,7 +2170,7 @@ struct FemtoUniverseProducerTask {
       rowInPrimaryTrackTableNeg = getRowDaughters(negtrackID, tmpIDtrack);
       childIDs[0] = 0;
       childIDs[1] = rowInPrimaryTrackTableNeg;
-      outputParts(outputCollision.lastIndex(),
+      outputParticle(outputCollision.lastIndex(),
                   p2.pt(),
                   p2.eta(),
                   p2.phi(),
@@ -2173,7 +2187,7 @@ struct FemtoUniverseProducerTask {
       }
       std::vector<int> indexChildID = {rowOfPosTrack, rowOfNegTrack};
 
-      outputParts(outputCollision.lastIndex(),
+      outputParticle(outputCollision.lastIndex(),
                   phiPt,
                   phiEta,
                   phiPhi,
@@ -2254,7 +2268,7 @@ struct FemtoUniverseProducerTask {
 
       if (ConfGeneral.confIsActivateCascade)
         childIDs.push_back(0);
-      outputParts(outputCollision.lastIndex(),
+      outputParticle(outputCollision.lastIndex(),
                   particle.pt(),
                   particle.eta(),
                   particle.phi(),
@@ -2300,7 +2314,7 @@ struct FemtoUniverseProducerTask {
         int32_t variablePDG = confStoreMCmothers ? getMotherPDG(particle) : particle.pdgCode();
         int32_t variableCut = confStoreMCmothers ? particle.getProcess() : 0;
 
-        outputParts(outputCollision.lastIndex(),
+        outputParticle(outputCollision.lastIndex(),
                     particle.pt(),
                     particle.eta(),
                     particle.phi(),
@@ -2380,7 +2394,7 @@ struct FemtoUniverseProducerTask {
         }
       }
 
-      outputParts(outputCollision.lastIndex(),
+      outputParticle(outputCollision.lastIndex(),
                   particle.pt(),
                   particle.eta(),
                   particle.phi(),
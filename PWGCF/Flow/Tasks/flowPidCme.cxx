@@ -43,8 +43,11 @@
 #include <TProfile.h>
 #include <TString.h>
 
+#include <algorithm>
+#include <array>
 #include <chrono>
 #include <cmath>
+#include <cstddef>
 #include <cstdint>
 #include <memory>
 #include <string>
@@ -93,6 +96,22 @@ constexpr int8_t kPionKaonITSleft = 11;
 constexpr int8_t kPionProtonITSleft = 12;
 constexpr int8_t kKaonProtonITSleft = 13;
 constexpr int8_t kPionKaonProtonITSleft = 14;
+
+// species of a flag as bits, so that a track is classified with one lookup instead of comparing it to all the combined flags
+constexpr uint8_t kSpeciesPion = 1 << 0;
+constexpr uint8_t kSpeciesKaon = 1 << 1;
+constexpr uint8_t kSpeciesProton = 1 << 2;
+constexpr uint8_t SpeciesMasks[] = {0, 0, 1, 2, 4, 0, 0, 0, 3, 5, 6, 7, 0, 0, 0, 0};        // index flag - kUnqualified, species passing the ITS cut
+constexpr uint8_t SpeciesMasksITSleft[] = {0, 0, 0, 0, 0, 1, 2, 4, 0, 0, 0, 0, 3, 5, 6, 7}; // index flag - kUnqualified, species rejected by the ITS cut
+
+constexpr uint8_t speciesMask(int8_t flag)
+{
+  return (flag < kUnqualified || flag > kPionKaonProtonITSleft) ? 0 : SpeciesMasks[flag - kUnqualified];
+}
+constexpr uint8_t speciesMaskITSleft(int8_t flag)
+{
+  return (flag < kUnqualified || flag > kPionKaonProtonITSleft) ? 0 : SpeciesMasksITSleft[flag - kUnqualified];
+}
 } // namespace pid_flags
 
 namespace event_selection
@@ -273,7 +292,7 @@ struct FillPIDcolums {
   }
 
   template <typename T>
-  int selectionPidtpctof(const T& candidate, std::array<float, 3> nSigmaTOFCutPtUpper, std::array<float, 3> nSigmaTOFCutPtLower, std::array<float, 3> nSigmaTPCCutPtUpper, std::array<float, 3> nSigmaTPCCutPtLower)
+  int selectionPidtpctof(const T& candidate, const std::array<float, 3>& nSigmaTOFCutPtUpper, const std::array<float, 3>& nSigmaTOFCutPtLower, const std::array<float, 3>& nSigmaTPCCutPtUpper, const std::array<float, 3>& nSigmaTPCCutPtLower)
   {
     // initialization for basic parameter
     float averClusSizeCosl = averageClusterSizeCosl(candidate.itsClusterSizes(), candidate.eta());
@@ -281,48 +300,33 @@ struct FillPIDcolums {
     std::array<float, 3> nSigmaTOF = {candidate.tofNSigmaPi(), candidate.tofNSigmaKa(), candidate.tofNSigmaPr()};
     std::array<float, 3> nSigmaCombined = {std::hypot(candidate.tpcNSigmaPi(), candidate.tofNSigmaPi()), std::hypot(candidate.tpcNSigmaKa(), candidate.tofNSigmaKa()), std::hypot(candidate.tpcNSigmaPr(), candidate.tofNSigmaPr())};
     std::array<float, 3> nSigmaToUse;
-    std::vector<float> pidVectorUpper;
-    std::vector<float> pidVectorLower;
-    std::vector<float> pidVectorTOFPtUpper;
-    std::vector<float> pidVectorTOFPtLower;
-    std::vector<float> pidVectorTPCPtUpper;
-    std::vector<float> pidVectorTPCPtLower;
+    // cuts of the species, pointing to the pt dependent cuts of the track or to the configurables
+    const float* pidVectorUpper = nullptr;
+    const float* pidVectorLower = nullptr;
     int pid = -1;
     bool kIsPi = false, kIsKa = false, kIsPr = false;
-    pidVectorTOFPtUpper.push_back(nSigmaTOFCutPtUpper[0]);
-    pidVectorTOFPtUpper.push_back(nSigmaTOFCutPtUpper[1]);
-    pidVectorTOFPtUpper.push_back(nSigmaTOFCutPtUpper[2]);
-    pidVectorTOFPtLower.push_back(nSigmaTOFCutPtLower[0]);
-    pidVectorTOFPtLower.push_back(nSigmaTOFCutPtLower[1]);
-    pidVectorTOFPtLower.push_back(nSigmaTOFCutPtLower[2]);
-    pidVectorTPCPtUpper.push_back(nSigmaTPCCutPtUpper[0]);
-    pidVectorTPCPtUpper.push_back(nSigmaTPCCutPtUpper[1]);
-    pidVectorTPCPtUpper.push_back(nSigmaTPCCutPtUpper[2]);
-    pidVectorTPCPtLower.push_back(nSigmaTPCCutPtLower[0]);
-    pidVectorTPCPtLower.push_back(nSigmaTPCCutPtLower[1]);
-    pidVectorTPCPtLower.push_back(nSigmaTPCCutPtLower[2]);
     // Choose which nSigma array and PIDcut array to use
     if (cfgOpenTOFOnlyPID) {
       if (!candidate.hasTOF())
         return 0;
       nSigmaToUse = nSigmaTOF;
-      pidVectorUpper = pidVectorTOFPtUpper;
-      pidVectorLower = pidVectorTOFPtLower;
+      pidVectorUpper = nSigmaTOFCutPtUpper.data();
+      pidVectorLower = nSigmaTOFCutPtLower.data();
     } else if (cfgOpenTPCOnlyPID) {
       nSigmaToUse = nSigmaTPC;
-      pidVectorUpper = pidVectorTPCPtUpper;
-      pidVectorLower = pidVectorTPCPtLower;
+      pidVectorUpper = nSigmaTPCCutPtUpper.data();
+      pidVectorLower = nSigmaTPCCutPtLower.data();
     } else {
       if (candidate.pt() > cfgPtMaxforTPCOnlyPID && candidate.hasTOF()) {
         nSigmaToUse = nSigmaCombined;
-        pidVectorUpper = cfgnSigmaCutRMSUpper.value;
-        pidVectorLower = cfgnSigmaCutRMSLower.value;
+        pidVectorUpper = cfgnSigmaCutRMSUpper.value.data();
+        pidVectorLower = cfgnSigmaCutRMSLower.value.data();
       } else if (candidate.pt() > cfgPtMaxforTPCOnlyPID && !candidate.hasTOF() && cfgUseStrictPID) {
         return 0;
       } else {
         nSigmaToUse = nSigmaTPC;
-        pidVectorUpper = cfgnSigmaCutTPCUpper.value;
-        pidVectorLower = cfgnSigmaCutTPCLower.value;
+        pidVectorUpper = cfgnSigmaCutTPCUpper.value.data();
+        pidVectorLower = cfgnSigmaCutTPCLower.value.data();
       }
     }
     float nsigma = 9999.99;
@@ -480,17 +484,10 @@ struct FillPIDcolums {
         return pid + 1; // shift the pid by 1, 1 = pion, 2 = kaon, 3 = proton
       }
     }
-    // Clear the vectors
-    std::vector<float>().swap(pidVectorLower);
-    std::vector<float>().swap(pidVectorUpper);
-    std::vector<float>().swap(pidVectorTOFPtUpper);
-    std::vector<float>().swap(pidVectorTPCPtLower);
-    std::vector<float>().swap(pidVectorTOFPtUpper);
-    std::vector<float>().swap(pidVectorTPCPtLower);
   }
 
   template <typename T>
-  bool selectionITS(const T& candidate, int mode, float avgclssize, std::array<float, 3> nSigmaITSToUseUpper, std::array<float, 3> nSigmaITSToUseLower)
+  bool selectionITS(const T& candidate, int mode, float avgclssize, const std::array<float, 3>& nSigmaITSToUseUpper, const std::array<float, 3>& nSigmaITSToUseLower)
   {
     switch (mode) {
       case 1: // For Pion
@@ -520,10 +517,73 @@ struct FillPIDcolums {
     return false;
   }
 
+  // nSigma cuts of one species in one pt bin
+  struct PidCutSet {
+    float tofUpper;
+    float tofLower;
+    float tpcUpper;
+    float tpcLower;
+    float itsUpper;
+    float itsLower;
+  };
+  // pt dependent nSigma cuts of one species, compiled at init from the configurables
+  struct PtBinnedPidCuts {
+    std::vector<float> ptEdges;
+    std::vector<PidCutSet> cuts; // one per pt bin, empty if the pt ranged cuts of the species are off
+    PidCutSet defaultCuts;       // outside the pt bins
+
+    const PidCutSet& find(float pt) const
+    {
+      if (cuts.empty()) {
+        return defaultCuts;
+      }
+      const auto it = std::upper_bound(ptEdges.begin(), ptEdges.end(), pt);
+      if (it == ptEdges.begin() || it == ptEdges.end()) {
+        return defaultCuts;
+      }
+      return cuts[it - ptEdges.begin() - 1];
+    }
+  };
+  std::array<PtBinnedPidCuts, 3> ptBinnedPidCuts; // pi, k, p
+
+  void compilePtBinnedPidCuts(PtBinnedPidCuts& table, int species, bool usePtBins, const std::vector<float>& ptEdges,
+                              const std::vector<float>& tofUpper, const std::vector<float>& tofLower, const std::vector<float>& tpcUpper,
+                              const std::vector<float>& tpcLower, const std::vector<float>& itsUpper, const std::vector<float>& itsLower)
+  {
+    table.defaultCuts = {cfgnSigmaCutTOFUpper.value[species], cfgnSigmaCutTOFLower.value[species], cfgnSigmaCutTPCUpper.value[species],
+                         cfgnSigmaCutTPCLower.value[species], cfgnSigmaCutITSUpper.value[species], cfgnSigmaCutITSLower.value[species]};
+    table.ptEdges = ptEdges;
+    table.cuts.clear();
+    if (!usePtBins || ptEdges.size() < 2) {
+      return;
+    }
+    if (!std::is_sorted(ptEdges.begin(), ptEdges.end())) {
+      LOGF(fatal, "The pt bins of the pt ranged nSigma cuts of species %d are not increasing", species);
+    }
+    const std::size_t nBins = ptEdges.size() - 1;
+    for (const auto* cut : {&tofUpper, &tofLower, &tpcUpper, &tpcLower, &itsUpper, &itsLower}) {
+      if (cut->size() < nBins) {
+        LOGF(fatal, "The pt ranged nSigma cuts of species %d have %zu values for %zu pt bins", species, cut->size(), nBins);
+      }
+    }
+    for (std::size_t i = 0; i < nBins; ++i) {
+      table.cuts.push_back({tofUpper[i], tofLower[i], tpcUpper[i], tpcLower[i], itsUpper[i], itsLower[i]});
+    }
+  }
+
   HistogramRegistry histosQA{"histosQAPID", {}, OutputObjHandlingPolicy::AnalysisObject};
 
   void init(InitContext const&)
   {
+    compilePtBinnedPidCuts(ptBinnedPidCuts[0], 0, cfgOpenPtRangedTOFnSigmacutPi || cfgOpenPtRangedTPCnSigmacutPi || cfgOpenPtRangedITSnSigmacutPi, cfgPtBinPionPID.value,
+                           cfgnSigmaTOFPionPtUpper.value, cfgnSigmaTOFPionPtLower.value, cfgnSigmaTPCPionPtUpper.value,
+                           cfgnSigmaTPCPionPtLower.value, cfgnSigmaITSPionPtUpper.value, cfgnSigmaITSPionPtLower.value);
+    compilePtBinnedPidCuts(ptBinnedPidCuts[1], 1, cfgOpenPtRangedTOFnSigmacutKa || cfgOpenPtRangedTPCnSigmacutKa || cfgOpenPtRangedITSnSigmacutKa, cfgPtBinKaonPID.value,
+                           cfgnSigmaTOFKaonPtUpper.value, cfgnSigmaTOFKaonPtLower.value, cfgnSigmaTPCKaonPtUpper.value,
+                           cfgnSigmaTPCKaonPtLower.value, cfgnSigmaITSKaonPtUpper.value, cfgnSigmaITSKaonPtLower.value);
+    compilePtBinnedPidCuts(ptBinnedPidCuts[2], 2, cfgOpenPtRangedTOFnSigmacutPr || cfgOpenPtRangedTPCnSigmacutPr || cfgOpenPtRangedITSnSigmacutPr, cfgPtBinProtonPID.value,
+                           cfgnSigmaTOFProtonPtUpper.value, cfgnSigmaTOFProtonPtLower.value, cfgnSigmaTPCProtonPtUpper.value,
+                           cfgnSigmaTPCProtonPtLower.value, cfgnSigmaITSProtonPtUpper.value, cfgnSigmaITSProtonPtLower.value);
 
     AxisSpec axisRigidity{cfgrigidityBins, "#it{p}^{TPC}/#it{z}"};
     AxisSpec axisdEdx{cfgdedxBins, "d#it{E}/d#it{x}"};
@@ -972,55 +1032,15 @@ struct FillPIDcolums {
           histosQA.fill(HIST("QA/PID/histnSigma_Origin_ITS_Pt_Pr"), track.pt(), track.itsNSigmaPr());
         }
       }
-      int currentPtBinPi = -1, currentPtBinKa = -1, currentPtBinPr = -1;
-      if (cfgOpenPtRangedTOFnSigmacutPi || cfgOpenPtRangedTPCnSigmacutPi || cfgOpenPtRangedITSnSigmacutPi) {
-        for (int i = 0; i < static_cast<int>(cfgPtBinPionPID.value.size()) - 1; ++i) {
-          if (track.pt() >= cfgPtBinPionPID.value[i] && track.pt() < cfgPtBinPionPID.value[i + 1]) {
-            currentPtBinPi = i;
-            break;
-          }
-        }
-      }
-      if (cfgOpenPtRangedTOFnSigmacutKa || cfgOpenPtRangedTPCnSigmacutKa || cfgOpenPtRangedITSnSigmacutKa) {
-        for (int i = 0; i < static_cast<int>(cfgPtBinKaonPID.value.size()) - 1; ++i) {
-          if (track.pt() >= cfgPtBinKaonPID.value[i] && track.pt() < cfgPtBinKaonPID.value[i + 1]) {
-            currentPtBinKa = i;
-            break;
-          }
-        }
-      }
-      if (cfgOpenPtRangedTOFnSigmacutPr || cfgOpenPtRangedTPCnSigmacutPr || cfgOpenPtRangedITSnSigmacutPr) {
-        for (int i = 0; i < static_cast<int>(cfgPtBinProtonPID.value.size()) - 1; ++i) {
-          if (track.pt() >= cfgPtBinProtonPID.value[i] && track.pt() < cfgPtBinProtonPID.value[i + 1]) {
-            currentPtBinPr = i;
-            break;
-          }
-        }
-      }
-      float nSigmaTOFCutPiPtUpper = (currentPtBinPi == -1) ? cfgnSigmaCutTOFUpper.value[0] : cfgnSigmaTOFPionPtUpper.value[currentPtBinPi];
-      float nSigmaTOFCutKaPtUpper = (currentPtBinKa == -1) ? cfgnSigmaCutTOFUpper.value[1] : cfgnSigmaTOFKaonPtUpper.value[currentPtBinKa];
-      float nSigmaTOFCutPrPtUpper = (currentPtBinPr == -1) ? cfgnSigmaCutTOFUpper.value[2] : cfgnSigmaTOFProtonPtUpper.value[currentPtBinPr];
-      float nSigmaTPCCutPiPtUpper = (currentPtBinPi == -1) ? cfgnSigmaCutTPCUpper.value[0] : cfgnSigmaTPCPionPtUpper.value[currentPtBinPi];
-      float nSigmaTPCCutKaPtUpper = (currentPtBinKa == -1) ? cfgnSigmaCutTPCUpper.value[1] : cfgnSigmaTPCKaonPtUpper.value[currentPtBinKa];
-      float nSigmaTPCCutPrPtUpper = (currentPtBinPr == -1) ? cfgnSigmaCutTPCUpper.value[2] : cfgnSigmaTPCProtonPtUpper.value[currentPtBinPr];
-      float nSigmaTOFCutPiPtLower = (currentPtBinPi == -1) ? cfgnSigmaCutTOFLower.value[0] : cfgnSigmaTOFPionPtLower.value[currentPtBinPi];
-      float nSigmaTOFCutKaPtLower = (currentPtBinKa == -1) ? cfgnSigmaCutTOFLower.value[1] : cfgnSigmaTOFKaonPtLower.value[currentPtBinKa];
-      float nSigmaTOFCutPrPtLower = (currentPtBinPr == -1) ? cfgnSigmaCutTOFLower.value[2] : cfgnSigmaTOFProtonPtLower.value[currentPtBinPr];
-      float nSigmaTPCCutPiPtLower = (currentPtBinPi == -1) ? cfgnSigmaCutTPCLower.value[0] : cfgnSigmaTPCPionPtLower.value[currentPtBinPi];
-      float nSigmaTPCCutKaPtLower = (currentPtBinKa == -1) ? cfgnSigmaCutTPCLower.value[1] : cfgnSigmaTPCKaonPtLower.value[currentPtBinKa];
-      float nSigmaTPCCutPrPtLower = (currentPtBinPr == -1) ? cfgnSigmaCutTPCLower.value[2] : cfgnSigmaTPCProtonPtLower.value[currentPtBinPr];
-      float nSigmaITSCutPiPtUpper = (currentPtBinPi == -1) ? cfgnSigmaCutITSUpper.value[0] : cfgnSigmaITSPionPtUpper.value[currentPtBinPi];
-      float nSigmaITSCutKaPtUpper = (currentPtBinKa == -1) ? cfgnSigmaCutITSUpper.value[1] : cfgnSigmaITSKaonPtUpper.value[currentPtBinKa];
-      float nSigmaITSCutPrPtUpper = (currentPtBinPr == -1) ? cfgnSigmaCutITSUpper.value[2] : cfgnSigmaITSProtonPtUpper.value[currentPtBinPr];
-      float nSigmaITSCutPiPtLower = (currentPtBinPi == -1) ? cfgnSigmaCutITSLower.value[0] : cfgnSigmaITSPionPtLower.value[currentPtBinPi];
-      float nSigmaITSCutKaPtLower = (currentPtBinKa == -1) ? cfgnSigmaCutITSLower.value[1] : cfgnSigmaITSKaonPtLower.value[currentPtBinKa];
-      float nSigmaITSCutPrPtLower = (currentPtBinPr == -1) ? cfgnSigmaCutITSLower.value[2] : cfgnSigmaITSProtonPtLower.value[currentPtBinPr];
-      std::array<float, 3> nSigmaTOFCutPtUpper = {nSigmaTOFCutPiPtUpper, nSigmaTOFCutKaPtUpper, nSigmaTOFCutPrPtUpper};
-      std::array<float, 3> nSigmaTPCCutPtUpper = {nSigmaTPCCutPiPtUpper, nSigmaTPCCutKaPtUpper, nSigmaTPCCutPrPtUpper};
-      std::array<float, 3> nSigmaTOFCutPtLower = {nSigmaTOFCutPiPtLower, nSigmaTOFCutKaPtLower, nSigmaTOFCutPrPtLower};
-      std::array<float, 3> nSigmaTPCCutPtLower = {nSigmaTPCCutPiPtLower, nSigmaTPCCutKaPtLower, nSigmaTPCCutPrPtLower};
-      std::array<float, 3> nSigmaITSCutPtUpper = {nSigmaITSCutPiPtUpper, nSigmaITSCutKaPtUpper, nSigmaITSCutPrPtUpper};
-      std::array<float, 3> nSigmaITSCutPtLower = {nSigmaITSCutPiPtLower, nSigmaITSCutKaPtLower, nSigmaITSCutPrPtLower};
+      const auto& cutsPi = ptBinnedPidCuts[0].find(track.pt());
+      const auto& cutsKa = ptBinnedPidCuts[1].find(track.pt());
+      const auto& cutsPr = ptBinnedPidCuts[2].find(track.pt());
+      std::array<float, 3> nSigmaTOFCutPtUpper = {cutsPi.tofUpper, cutsKa.tofUpper, cutsPr.tofUpper};
+      std::array<float, 3> nSigmaTPCCutPtUpper = {cutsPi.tpcUpper, cutsKa.tpcUpper, cutsPr.tpcUpper};
+      std::array<float, 3> nSigmaTOFCutPtLower = {cutsPi.tofLower, cutsKa.tofLower, cutsPr.tofLower};
+      std::array<float, 3> nSigmaTPCCutPtLower = {cutsPi.tpcLower, cutsKa.tpcLower, cutsPr.tpcLower};
+      std::array<float, 3> nSigmaITSCutPtUpper = {cutsPi.itsUpper, cutsKa.itsUpper, cutsPr.itsUpper};
+      std::array<float, 3> nSigmaITSCutPtLower = {cutsPi.itsLower, cutsKa.itsLower, cutsPr.itsLower};
       const float averClusSizeCosl = averageClusterSizeCosl(track.itsClusterSizes(), track.eta());
       if (!selTrackPid(track)) {
         pidFlag = -1;
@@ -1039,8 +1059,8 @@ struct FillPIDcolums {
         pidFlag = selectionPidtpctof(track, nSigmaTOFCutPtUpper, nSigmaTOFCutPtLower, nSigmaTPCCutPtUpper, nSigmaTPCCutPtLower);
         if (!(pidFlag == pid_flags::kUnqualified || pidFlag == pid_flags::kUnPOIHadron)) {
           // First fill ITS uncut plots
-          if ((pidFlag == pid_flags::kPion) || (pidFlag == pid_flags::kPionKaon) || (pidFlag == pid_flags::kPionProton) || (pidFlag == pid_flags::kPionKaonProton)) {
-            if (cfgOpenTPCAssistanceTOFOnlyPID && !(track.tpcNSigmaPi() > nSigmaTPCCutPiPtLower && track.tpcNSigmaPi() < nSigmaTPCCutPiPtUpper)) {
+          if (pid_flags::speciesMask(pidFlag) & pid_flags::kSpeciesPion) {
+            if (cfgOpenTPCAssistanceTOFOnlyPID && !(track.tpcNSigmaPi() > cutsPi.tpcLower && track.tpcNSigmaPi() < cutsPi.tpcUpper)) {
               pidFlag = 0;
             }
             if (cfgOpenPIDPtSelection && !(track.pt() > cfgPtCutLower.value[0] && track.pt() < cfgPtCutUpper.value[0])) {
@@ -1101,8 +1121,8 @@ struct FillPIDcolums {
               }
             }
           }
-          if ((pidFlag == pid_flags::kKaon) || (pidFlag == pid_flags::kPionKaon) || (pidFlag == pid_flags::kKaonProton) || (pidFlag == pid_flags::kPionKaonProton)) {
-            if (cfgOpenTPCAssistanceTOFOnlyPID && !(track.tpcNSigmaKa() > nSigmaTPCCutKaPtLower && track.tpcNSigmaKa() < nSigmaTPCCutKaPtUpper)) {
+          if (pid_flags::speciesMask(pidFlag) & pid_flags::kSpeciesKaon) {
+            if (cfgOpenTPCAssistanceTOFOnlyPID && !(track.tpcNSigmaKa() > cutsKa.tpcLower && track.tpcNSigmaKa() < cutsKa.tpcUpper)) {
               pidFlag = 0;
             }
             if (cfgOpenPIDPtSelection && !(track.pt() > cfgPtCutLower.value[1] && track.pt() < cfgPtCutUpper.value[1])) {
@@ -1163,8 +1183,8 @@ struct FillPIDcolums {
               }
             }
           }
-          if ((pidFlag == pid_flags::kProton) || (pidFlag == pid_flags::kPionProton) || (pidFlag == pid_flags::kKaonProton) || (pidFlag == pid_flags::kPionKaonProton)) {
-            if (cfgOpenTPCAssistanceTOFOnlyPID && !(track.tpcNSigmaPr() > nSigmaTPCCutPrPtLower && track.tpcNSigmaPr() < nSigmaTPCCutPrPtUpper)) {
+          if (pid_flags::speciesMask(pidFlag) & pid_flags::kSpeciesProton) {
+            if (cfgOpenTPCAssistanceTOFOnlyPID && !(track.tpcNSigmaPr() > cutsPr.tpcLower && track.tpcNSigmaPr() < cutsPr.tpcUpper)) {
               pidFlag = 0;
             }
             if (cfgOpenPIDPtSelection && !(track.pt() > cfgPtCutLower.value[2] && track.pt() < cfgPtCutUpper.value[2])) {
@@ -1337,7 +1357,7 @@ struct FillPIDcolums {
                 histosQA.fill(HIST("QA/PID/histTPCChi2Ncls_total_AfterITS"), track.tpcChi2NCl());
                 histosQA.fill(HIST("QA/PID/histITSChi2Ncls_total_AfterITS"), track.itsChi2NCl());
               }
-              if ((pidFlag == pid_flags::kPion) || (pidFlag == pid_flags::kPionKaon) || (pidFlag == pid_flags::kPionProton) || (pidFlag == pid_flags::kPionKaonProton)) {
+              if (pid_flags::speciesMask(pidFlag) & pid_flags::kSpeciesPion) {
                 histosQA.fill(HIST("QA/PID/histnSigmaITS_nSigmaTPC_AfterITS_Pi"), track.itsNSigmaPi(), track.tpcNSigmaPi());
                 histosQA.fill(HIST("QA/PID/histnSigmaTOF_nSigmaITS_AfterITS_Pi"), track.tofNSigmaPi(), track.itsNSigmaPi());
                 histosQA.fill(HIST("QA/PID/histnSigmaTOF_nSigmaTPC_AfterITS_Pi"), track.tofNSigmaPi(), track.tpcNSigmaPi());
@@ -1386,7 +1406,7 @@ struct FillPIDcolums {
                   }
                 }
               }
-              if ((pidFlag == pid_flags::kKaon) || (pidFlag == pid_flags::kPionKaon) || (pidFlag == pid_flags::kKaonProton) || (pidFlag == pid_flags::kPionKaonProton)) {
+              if (pid_flags::speciesMask(pidFlag) & pid_flags::kSpeciesKaon) {
                 histosQA.fill(HIST("QA/PID/histnSigmaITS_nSigmaTPC_AfterITS_Ka"), track.itsNSigmaKa(), track.tpcNSigmaKa());
                 histosQA.fill(HIST("QA/PID/histnSigmaTOF_nSigmaITS_AfterITS_Ka"), track.tofNSigmaKa(), track.itsNSigmaKa());
                 histosQA.fill(HIST("QA/PID/histnSigmaTOF_nSigmaTPC_AfterITS_Ka"), track.tofNSigmaKa(), track.tpcNSigmaKa());
@@ -1435,7 +1455,7 @@ struct FillPIDcolums {
                   }
                 }
               }
-              if ((pidFlag == pid_flags::kProton) || (pidFlag == pid_flags::kPionProton) || (pidFlag == pid_flags::kKaonProton) || (pidFlag == pid_flags::kPionKaonProton)) {
+              if (pid_flags::speciesMask(pidFlag) & pid_flags::kSpeciesProton) {
                 histosQA.fill(HIST("QA/PID/histnSigmaITS_nSigmaTPC_AfterITS_Pr"), track.itsNSigmaPr(), track.tpcNSigmaPr());
                 histosQA.fill(HIST("QA/PID/histnSigmaTOF_nSigmaITS_AfterITS_Pr"), track.tofNSigmaPr(), track.itsNSigmaPr());
                 histosQA.fill(HIST("QA/PID/histnSigmaTOF_nSigmaTPC_AfterITS_Pr"), track.tofNSigmaPr(), track.tpcNSigmaPr());
@@ -1765,9 +1785,9 @@ struct QAProcessCent {
         for (const auto& trk : tracks) {
           int8_t pidFlag = trk.nPidFlag();
           if (cfgOpenPi) {
-            if ((pidFlag == pid_flags::kPion) || (pidFlag == pid_flags::kPionITSleft) || (pidFlag == pid_flags::kPionKaon) || (pidFlag == pid_flags::kPionProton) || (pidFlag == pid_flags::kPionKaonProton) || (pidFlag == pid_flags::kPionKaonITSleft) || (pidFlag == pid_flags::kPionProtonITSleft) || (pidFlag == pid_flags::kPionKaonProtonITSleft)) {
+            if ((pid_flags::speciesMask(pidFlag) | pid_flags::speciesMaskITSleft(pidFlag)) & pid_flags::kSpeciesPion) {
               if (trk.sign() > 0) {
-                if (!((pidFlag == pid_flags::kPionITSleft) || (pidFlag == pid_flags::kPionKaonITSleft) || (pidFlag == pid_flags::kPionProtonITSleft) || (pidFlag == pid_flags::kPionKaonProtonITSleft))) {
+                if (!(pid_flags::speciesMaskITSleft(pidFlag) & pid_flags::kSpeciesPion)) {
                   if (cfgOpenPtEtaPhi) {
                     vhistPhiPtEtaPosPiCen[currentBin]->Fill(trk.phi(), trk.pt(), trk.eta());
                   }
@@ -1799,7 +1819,7 @@ struct QAProcessCent {
                   vhistnSigmaTOFTPCPtPosPiBeforeCen[currentBin]->Fill(trk.nSigmaPiTOF(), trk.nSigmaPiTPC(), trk.pt());
                 }
               } else if (trk.sign() < 0) {
-                if (!((pidFlag == pid_flags::kPionITSleft) || (pidFlag == pid_flags::kPionKaonITSleft) || (pidFlag == pid_flags::kPionProtonITSleft) || (pidFlag == pid_flags::kPionKaonProtonITSleft))) {
+                if (!(pid_flags::speciesMaskITSleft(pidFlag) & pid_flags::kSpeciesPion)) {
                   if (cfgOpenPtEtaPhi) {
                     vhistPhiPtEtaNegPiCen[currentBin]->Fill(trk.phi(), trk.pt(), trk.eta());
                   }
@@ -1834,9 +1854,9 @@ struct QAProcessCent {
             }
           }
           if (cfgOpenKa) {
-            if ((pidFlag == pid_flags::kKaon) || (pidFlag == pid_flags::kKaonITSleft) || (pidFlag == pid_flags::kPionKaon) || (pidFlag == pid_flags::kKaonProton) || (pidFlag == pid_flags::kPionKaonProton) || (pidFlag == pid_flags::kPionKaonITSleft) || (pidFlag == pid_flags::kKaonProtonITSleft) || (pidFlag == pid_flags::kPionKaonProtonITSleft)) {
+            if ((pid_flags::speciesMask(pidFlag) | pid_flags::speciesMaskITSleft(pidFlag)) & pid_flags::kSpeciesKaon) {
               if (trk.sign() > 0) {
-                if (!((pidFlag == pid_flags::kKaonITSleft) || (pidFlag == pid_flags::kPionKaonITSleft) || (pidFlag == pid_flags::kKaonProtonITSleft) || (pidFlag == pid_flags::kPionKaonProtonITSleft))) {
+                if (!(pid_flags::speciesMaskITSleft(pidFlag) & pid_flags::kSpeciesKaon)) {
                   if (cfgOpenPtEtaPhi) {
                     vhistPhiPtEtaPosKaCen[currentBin]->Fill(trk.phi(), trk.pt(), trk.eta());
                   }
@@ -1868,7 +1888,7 @@ struct QAProcessCent {
                   vhistnSigmaTOFTPCPtPosKaBeforeCen[currentBin]->Fill(trk.nSigmaKaTOF(), trk.nSigmaKaTPC(), trk.pt());
                 }
               } else if (trk.sign() < 0) {
-                if (!((pidFlag == pid_flags::kKaonITSleft) || (pidFlag == pid_flags::kPionKaonITSleft) || (pidFlag == pid_flags::kKaonProtonITSleft) || (pidFlag == pid_flags::kPionKaonProtonITSleft))) {
+                if (!(pid_flags::speciesMaskITSleft(pidFlag) & pid_flags::kSpeciesKaon)) {
                   if (cfgOpenPtEtaPhi) {
                     vhistPhiPtEtaNegKaCen[currentBin]->Fill(trk.phi(), trk.pt(), trk.eta());
                   }
@@ -1903,9 +1923,9 @@ struct QAProcessCent {
             }
           }
           if (cfgOpenPr) {
-            if ((pidFlag == pid_flags::kProton) || (pidFlag == pid_flags::kProtonITSleft) || (pidFlag == pid_flags::kPionProton) || (pidFlag == pid_flags::kKaonProton) || (pidFlag == pid_flags::kPionKaonProton) || (pidFlag == pid_flags::kPionProtonITSleft) || (pidFlag == pid_flags::kKaonProtonITSleft) || (pidFlag == pid_flags::kPionKaonProtonITSleft)) {
+            if ((pid_flags::speciesMask(pidFlag) | pid_flags::speciesMaskITSleft(pidFlag)) & pid_flags::kSpeciesProton) {
               if (trk.sign() > 0) {
-                if (!((pidFlag == pid_flags::kProtonITSleft) || (pidFlag == pid_flags::kPionProtonITSleft) || (pidFlag == pid_flags::kKaonProtonITSleft) || (pidFlag == pid_flags::kPionKaonProtonITSleft))) {
+                if (!(pid_flags::speciesMaskITSleft(pidFlag) & pid_flags::kSpeciesProton)) {
                   if (cfgOpenPtEtaPhi) {
                     vhistPhiPtEtaPosPrCen[currentBin]->Fill(trk.phi(), trk.pt(), trk.eta());
                   }
@@ -1937,7 +1957,7 @@ struct QAProcessCent {
                   vhistnSigmaTOFTPCPtPosPrBeforeCen[currentBin]->Fill(trk.nSigmaPrTOF(), trk.nSigmaPrTPC(), trk.pt());
                 }
               } else if (trk.sign() < 0) {
-                if (!((pidFlag == pid_flags::kProtonITSleft) || (pidFlag == pid_flags::kPionProtonITSleft) || (pidFlag == pid_flags::kKaonProtonITSleft) || (pidFlag == pid_flags::kPionKaonProtonITSleft))) {
+                if (!(pid_flags::speciesMaskITSleft(pidFlag) & pid_flags::kSpeciesProton)) {
                   if (cfgOpenPtEtaPhi) {
                     vhistPhiPtEtaNegPrCen[currentBin]->Fill(trk.phi(), trk.pt(), trk.eta());
                   }
@@ -2661,7 +2681,7 @@ struct FlowPidCme {
         }
       }
       if ((cenBin >= 0) && (ptBin >= 0)) {
-        if ((track.nPidFlag() == pid_flags::kProton) || (track.nPidFlag() == pid_flags::kPionProton) || (track.nPidFlag() == pid_flags::kKaonProton) || (track.nPidFlag() == pid_flags::kPionKaonProton)) {
+        if (pid_flags::speciesMask(track.nPidFlag()) & pid_flags::kSpeciesProton) {
           if (cfgkOpenDebugPIDCME) {
             LOGF(info, Form("=========cen_bin: %d pt_bin: %d=========", cenBin, ptBin));
           }
@@ -3382,7 +3402,7 @@ struct FlowPidCme {
           continue;
         if (cfgkOpenTPCITSPurityCut && cfgkOpenTPCITSPurityCutQA) {
           if (cent >= cenPlotMin && cent < cenPlotMax) {
-            if ((trk.nPidFlag() == pid_flags::kProton) || (trk.nPidFlag() == pid_flags::kPionProton) || (trk.nPidFlag() == pid_flags::kKaonProton) || (trk.nPidFlag() == pid_flags::kPionKaonProton)) {
+            if (pid_flags::speciesMask(trk.nPidFlag()) & pid_flags::kSpeciesProton) {
               if (trk.sign() > 0) {
                 histosQA.fill(HIST("QA/histITSPuritycheck_Pr_Pos_Cen_20_30"), trk.nSigmaPrTPC(), trk.nSigmaPrITS(), trk.pt());
               } else {
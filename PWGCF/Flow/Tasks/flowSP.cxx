@@ -53,11 +53,11 @@
 #include <TProfile2D.h>
 #include <TProfile3D.h>
 
+#include <array>
 #include <chrono>
 #include <cmath>
 #include <cstdint>
 #include <cstdlib>
-#include <map>
 #include <memory>
 #include <string>
 #include <string_view>
@@ -225,8 +225,8 @@ struct FlowSP {
   } conf;
 
   struct SPMvars {
-    std::vector<std::map<int, float>> wacc = {{{0, 1.0}, {1, 1.0}, {2, 1.0}, {3, 1.0}}, {{0, 1.0}, {1, 1.0}, {2, 1.0}, {3, 1.0}}, {{0, 1.0}, {1, 1.0}, {2, 1.0}, {3, 1.0}}}; // int for part species, float for weight vector for kIncl, kPos, kNeg
-    std::vector<std::map<int, float>> weff = {{{0, 1.0}, {1, 1.0}, {2, 1.0}, {3, 1.0}}, {{0, 1.0}, {1, 1.0}, {2, 1.0}, {3, 1.0}}, {{0, 1.0}, {1, 1.0}, {2, 1.0}, {3, 1.0}}}; // int for part species, float for weight vector for kIncl, kPos, kNeg
+    std::array<std::array<float, 4>, 3> wacc = {{{1.f, 1.f, 1.f, 1.f}, {1.f, 1.f, 1.f, 1.f}, {1.f, 1.f, 1.f, 1.f}}}; // [kIncl, kPos, kNeg][part species], indexed directly instead of a map lookup per track
+    std::array<std::array<float, 4>, 3> weff = {{{1.f, 1.f, 1.f, 1.f}, {1.f, 1.f, 1.f, 1.f}, {1.f, 1.f, 1.f, 1.f}}}; // [kIncl, kPos, kNeg][part species], indexed directly instead of a map lookup per track
     double centWeight = 1.0;
     double meanPtWeight = 1.0;
     double ux = 0;
@@ -1435,11 +1435,23 @@ struct FlowSP {
     registry.fill(HIST("QQCorrelations/qAXYqCXY"), spm.centrality, spm.qyA * spm.qxC + spm.qxA * spm.qyC);
     registry.fill(HIST("QQCorrelations/qAqCX"), spm.centrality, spm.qxA * spm.qxC);
     registry.fill(HIST("QQCorrelations/qAqCY"), spm.centrality, spm.qyA * spm.qyC);
+    // sin(n psi) and cos(n psi) of the harmonics by angle addition, the trigonometric functions are evaluated once
+    const double sinPsiC = std::sin(spm.psiC);
+    const double cosPsiC = std::cos(spm.psiC);
+    const double sinPsiA = std::sin(spm.psiA);
+    const double cosPsiA = std::cos(spm.psiA);
+    double sinShiftC = sinPsiC, cosShiftC = cosPsiC, sinShiftA = sinPsiA, cosShiftA = cosPsiA;
     for (int ishift = 1; ishift <= nshift; ishift++) {
-      registry.fill(HIST("shift/ShiftZDCC"), spm.centrality, 0.5, ishift - 0.5, std::sin(ishift * 1.0 * spm.psiC));
-      registry.fill(HIST("shift/ShiftZDCC"), spm.centrality, 1.5, ishift - 0.5, std::cos(ishift * 1.0 * spm.psiC));
-      registry.fill(HIST("shift/ShiftZDCA"), spm.centrality, 0.5, ishift - 0.5, std::sin(ishift * 1.0 * spm.psiA));
-      registry.fill(HIST("shift/ShiftZDCA"), spm.centrality, 1.5, ishift - 0.5, std::cos(ishift * 1.0 * spm.psiA));
+      registry.fill(HIST("shift/ShiftZDCC"), spm.centrality, 0.5, ishift - 0.5, sinShiftC);
+      registry.fill(HIST("shift/ShiftZDCC"), spm.centrality, 1.5, ishift - 0.5, cosShiftC);
+      registry.fill(HIST("shift/ShiftZDCA"), spm.centrality, 0.5, ishift - 0.5, sinShiftA);
+      registry.fill(HIST("shift/ShiftZDCA"), spm.centrality, 1.5, ishift - 0.5, cosShiftA);
+      const double sinNextC = sinShiftC * cosPsiC + cosShiftC * sinPsiC;
+      cosShiftC = cosShiftC * cosPsiC - sinShiftC * sinPsiC;
+      sinShiftC = sinNextC;
+      const double sinNextA = sinShiftA * cosPsiA + cosShiftA * sinPsiA;
+      cosShiftA = cosShiftA * cosPsiA - sinShiftA * sinPsiA;
+      sinShiftA = sinNextA;
     }
 
     if (cfg.cFillEventQA) {
@@ -1526,6 +1538,17 @@ struct FlowSP {
     double meanPxEventCount = 0;
     double sumPxCEvent = 0;
 
+    // corrections of the collision, the same for all its tracks
+    const double sqrtQQ = std::sqrt(std::fabs(spm.corrQQ));
+    int meanPtCentBin = 0;
+    if (cfg.cCCDBdir_meanPt.value.empty() == false) {
+      if (!conf.clMeanPt) {
+        conf.hMeanPt = ccdb->getForTimeStamp<TProfile2D>(cfg.cCCDBdir_meanPt.value, bc.timestamp());
+        conf.clMeanPt = true;
+      }
+      meanPtCentBin = conf.hMeanPt->GetYaxis()->FindBin(spm.centrality);
+    }
+
     for (const auto& track : tracks) {
 
       if (track.sign() == 0)
@@ -1544,13 +1567,8 @@ struct FlowSP {
 
       spm.meanPtWeight = 1.0;
       if (cfg.cCCDBdir_meanPt.value.empty() == false) {
-        if (!conf.clMeanPt) {
-          conf.hMeanPt = ccdb->getForTimeStamp<TProfile2D>(cfg.cCCDBdir_meanPt.value, bc.timestamp());
-          conf.clMeanPt = true;
-        }
         int etaBin = conf.hMeanPt->GetXaxis()->FindBin(track.eta());
-        int centBin = conf.hMeanPt->GetYaxis()->FindBin(spm.centrality);
-        double weight = conf.hMeanPt->GetBinContent(etaBin, centBin);
+        double weight = conf.hMeanPt->GetBinContent(etaBin, meanPtCentBin);
         if (weight > 0) {
           spm.meanPtWeight = 1.0 / weight;
         } else {
@@ -1601,8 +1619,8 @@ struct FlowSP {
 
       // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-      spm.meanPxA = track.pt() * ((spm.uy * spm.qyA + spm.ux * spm.qxA) / (std::sqrt(std::fabs(spm.corrQQ)) * spm.meanPtWeight));
-      spm.meanPxC = track.pt() * ((spm.uy * spm.qyC + spm.ux * spm.qxC) / (std::sqrt(std::fabs(spm.corrQQ)) * spm.meanPtWeight));
+      spm.meanPxA = track.pt() * ((spm.uy * spm.qyA + spm.ux * spm.qxA) / (sqrtQQ * spm.meanPtWeight));
+      spm.meanPxC = track.pt() * ((spm.uy * spm.qyC + spm.ux * spm.qxC) / (sqrtQQ * spm.meanPtWeight));
 
       fillHistograms<kInclusive, kUnidentified>(track);
 
@@ -1617,8 +1635,8 @@ struct FlowSP {
         }
       }
 
-      double drelPxA = track.pt() * ((spm.uy * spm.qyA + spm.ux * spm.qxA) / std::sqrt(std::fabs(spm.corrQQ)));
-      double drelPxC = track.pt() * ((spm.uy * spm.qyC + spm.ux * spm.qxC) / std::sqrt(std::fabs(spm.corrQQ)));
+      double drelPxA = track.pt() * ((spm.uy * spm.qyA + spm.ux * spm.qxA) / sqrtQQ);
+      double drelPxC = track.pt() * ((spm.uy * spm.qyC + spm.ux * spm.qxC) / sqrtQQ);
 
       double weightIncl = spm.wacc[kInclusive][kUnidentified] * spm.weff[kInclusive][kUnidentified] * spm.centWeight;
       double weightPos = spm.wacc[kPositive][kUnidentified] * spm.weff[kPositive][kUnidentified] * spm.centWeight;
@@ -11,6 +11,8 @@
 
 #include "BootstrapProfile.h"
 
+#include "PWGCF/GenericFramework/Core/ProfileFill.h"
+
 #include <TCollection.h>
 #include <TH1.h>
 #include <TList.h>
@@ -65,13 +67,15 @@ void BootstrapProfile::InitializeSubsamples(Int_t nSub)
 }
 void BootstrapProfile::FillProfile(const Double_t& xv, const Double_t& yv, const Double_t& w, const Double_t& rn)
 {
-  TProfile::Fill(xv, yv, w);
+  // the subprofiles are clones of this profile, the bin is the same for all of them
+  Int_t bin = fXaxis.FindBin(xv);
+  profile_fill::fillAtBin(this, bin, xv, yv, w);
   if (!fNSubs)
     return;
   Int_t targetInd = rn * fNSubs;
   if (targetInd >= fNSubs)
     targetInd = 0;
-  reinterpret_cast<TProfile*>(fListOfEntries->At(targetInd))->Fill(xv, yv, w);
+  profile_fill::fillAtBin(reinterpret_cast<TProfile*>(fListOfEntries->At(targetInd)), bin, xv, yv, w);
 }
 void BootstrapProfile::FillProfile(const Double_t& xv, const Double_t& yv, const Double_t& w)
 {
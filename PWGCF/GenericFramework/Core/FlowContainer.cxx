@@ -11,6 +11,7 @@
 
 #include "FlowContainer.h"
 
+#include "PWGCF/GenericFramework/Core/ProfileFill.h"
 #include "PWGCF/GenericFramework/Core/ProfileSubset.h"
 
 #include <Framework/HistogramSpec.h>
@@ -155,7 +156,7 @@ void FlowContainer::SetXAxis()
     delete tempax;
   }
 }
-int FlowContainer::FillProfile(const char* hname, double multi, double corr, double w, double rn)
+int FlowContainer::GetProfileIndex(const char* hname)
 {
   if (!fProf)
     return -1;
@@ -164,10 +165,25 @@ int FlowContainer::FillProfile(const char* hname, double multi, double corr, dou
     printf("Could not find bin %s\n", hname);
     return -1;
   }
-  fProf->Fill(multi, yin, corr, w);
+  return yin;
+};
+int FlowContainer::FillProfile(const char* hname, double multi, double corr, double w, double rn)
+{
+  int yin = GetProfileIndex(hname);
+  if (yin < 0)
+    return -1;
+  return FillProfile(yin, multi, corr, w, rn);
+};
+int FlowContainer::FillProfile(int yin, double multi, double corr, double w, double rn)
+{
+  if (!fProf || yin < 1)
+    return -1;
+  // the subsample profiles are clones of the main one, the multiplicity bin is the same for all of them
+  int xin = fProf->GetXaxis()->FindBin(multi);
+  profile_fill::fillAtBin(fProf, xin, yin, multi, yin, corr, w);
   if (fNRandom) {
     double rnind = rn * fNRandom;
-    dynamic_cast<TProfile2D*>(fProfRand->At(static_cast<int>(rnind)))->Fill(multi, yin, corr, w);
+    profile_fill::fillAtBin(static_cast<TProfile2D*>(fProfRand->At(static_cast<int>(rnind))), xin, yin, multi, yin, corr, w);
   }
   return 0;
 };
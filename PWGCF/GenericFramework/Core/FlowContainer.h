@@ -52,7 +52,9 @@ class FlowContainer : public TNamed
   };
   int GetNMultiBins() { return fProf->GetNbinsX(); }
   double GetMultiAtBin(int bin) { return fProf->GetXaxis()->GetBinCenter(bin); }
+  int GetProfileIndex(const char* hname); // y bin of the correlator, -1 if it does not exist
   int FillProfile(const char* hname, double multi, double y, double w, double rn);
+  int FillProfile(int yin, double multi, double y, double w, double rn); // with the y bin from GetProfileIndex
   TProfile2D* GetProfile() { return fProf; }
   void OverrideProfileErrors(TProfile2D* inpf);
   void ReadAndMerge(const char* infile);
@@ -15,7 +15,9 @@
 
 #include <complex>
 #include <cstdio>
+#include <span>
 #include <string>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -89,9 +91,8 @@ int GFW::CreateRegions()
   }
   int nRegions = 0;
   for (auto pItr = fRegions.begin(); pItr != fRegions.end(); pItr++) {
-    GFWCumulant* lCumulant = new GFWCumulant();
-    lCumulant->CreateComplexVectorArrayVarPower(pItr->Nhar, pItr->NparVec, pItr->NpT);
-    fCumulants.push_back(*lCumulant);
+    fCumulants.emplace_back();
+    fCumulants.back().CreateComplexVectorArrayVarPower(pItr->Nhar, pItr->NparVec, pItr->NpT);
     ++nRegions;
   }
   if (nRegions)
@@ -101,11 +102,36 @@ int GFW::CreateRegions()
 void GFW::Fill(double eta, int ptin, double phi, double weight, int mask, double SecondWeight)
 {
   // if(!fInitialized) return;
+  ++fCorrCacheStamp;
   for (int i = 0; i < static_cast<int>(fRegions.size()); ++i) {
     if (fRegions.at(i).EtaMin < eta && fRegions.at(i).EtaMax > eta && (fRegions.at(i).BitMask & mask))
       fCumulants.at(i).FillArray(ptin, phi, weight, SecondWeight);
   }
 };
+void GFW::Fill(std::span<const double> eta, std::span<const int> ptin, std::span<const double> phi, std::span<const double> weight, std::span<const int> mask, std::span<const double> SecondWeight)
+{
+  bool useSecondWeight = !SecondWeight.empty();
+  ++fCorrCacheStamp;
+  for (int i = 0; i < static_cast<int>(fRegions.size()); ++i) {
+    const Region& lRegion = fRegions[i];
+    // Collect the particles of this region, then fill them all at once
+    fFillPt.clear();
+    fFillPhi.clear();
+    fFillWeight.clear();
+    fFillSecondWeight.clear();
+    for (int j = 0; j < static_cast<int>(eta.size()); ++j) {
+      if (lRegion.EtaMin < eta[j] && lRegion.EtaMax > eta[j] && (lRegion.BitMask & mask[j])) {
+        fFillPt.push_back(ptin[j]);
+        fFillPhi.push_back(phi[j]);
+        fFillWeight.push_back(weight[j]);
+        if (useSecondWeight)
+          fFillSecondWeight.push_back(SecondWeight[j]);
+      }
+    }
+    if (!fFillPhi.empty())
+      fCumulants.at(i).FillArray(fFillPt, fFillPhi, fFillWeight, fFillSecondWeight);
+  }
+};
 complex<double> GFW::TwoRec(int n1, int n2, int p1, int p2, int ptbin, GFWCumulant* r1, GFWCumulant* r2, GFWCumulant* r3)
 {
   complex<double> part1 = r1->Vec(n1, p1, ptbin);
@@ -122,7 +148,37 @@ complex<double> GFW::RecursiveCorr(GFWCumulant* qpoi, GFWCumulant* qref, GFWCumu
   return RecursiveCorr(qpoi, qref, qol, ptbin, hars, pows);
 };
 
+void GFW::BuildCorrCacheKey(GFWCumulant* qpoi, GFWCumulant* qref, GFWCumulant* qol, int ptbin, const vector<int>& hars, const vector<int>& pows)
+{
+  fCorrCacheKey.clear();
+  fCorrCacheKey.push_back(static_cast<int>(qpoi - fCumulants.data()));
+  fCorrCacheKey.push_back(static_cast<int>(qref - fCumulants.data()));
+  fCorrCacheKey.push_back(qol ? static_cast<int>(qol - fCumulants.data()) : -1);
+  fCorrCacheKey.push_back(ptbin);
+  fCorrCacheKey.insert(fCorrCacheKey.end(), hars.begin(), hars.end());
+  fCorrCacheKey.insert(fCorrCacheKey.end(), pows.begin(), pows.end());
+};
 complex<double> GFW::RecursiveCorr(GFWCumulant* qpoi, GFWCumulant* qref, GFWCumulant* qol, int ptbin, vector<int>& hars, vector<int>& pows)
+{
+  // Up to two particles, the correlator is cheaper to calculate than to look up
+  if (hars.size() < 3)
+    return RecursiveCorrNoCache(qpoi, qref, qol, ptbin, hars, pows);
+  BuildCorrCacheKey(qpoi, qref, qol, ptbin, hars, pows);
+  auto cached = fCorrCache.find(fCorrCacheKey);
+  if (cached != fCorrCache.end() && cached->second.stamp == fCorrCacheStamp)
+    return cached->second.value;
+  // References to the elements stay valid if new entries are added by the recursion
+  CorrCacheEntry* entry = (cached != fCorrCache.end()) ? &cached->second : nullptr;
+  complex<double> value = RecursiveCorrNoCache(qpoi, qref, qol, ptbin, hars, pows);
+  if (!entry) {
+    BuildCorrCacheKey(qpoi, qref, qol, ptbin, hars, pows);
+    entry = &fCorrCache[fCorrCacheKey];
+  }
+  entry->value = value;
+  entry->stamp = fCorrCacheStamp;
+  return value;
+};
+complex<double> GFW::RecursiveCorrNoCache(GFWCumulant* qpoi, GFWCumulant* qref, GFWCumulant* qol, int ptbin, vector<int>& hars, vector<int>& pows)
 {
   if ((pows.at(0) != 1) && qol)
     qpoi = qol; // if the power of POI is not unity, then always use overlap (if defined).
@@ -168,6 +224,7 @@ void GFW::Clear()
     CreateRegions();
   for (auto ptr = fCumulants.begin(); ptr != fCumulants.end(); ++ptr)
     ptr->ResetQs();
+  ++fCorrCacheStamp; // correlators of the previous event are not valid anymore
 };
 GFW::CorrConfig GFW::GetCorrelatorConfig(string config, string head, bool ptdif)
 {
@@ -260,7 +317,7 @@ complex<double> GFW::Calculate(int poi, int ref, vector<int> hars, int ptbin)
   GFWCumulant* qovl = qpoi;
   return RecursiveCorr(qpoi, qref, qovl, ptbin, hars);
 };
-complex<double> GFW::Calculate(CorrConfig corconf, int ptbin, bool SetHarmsToZero)
+complex<double> GFW::Calculate(const CorrConfig& corconf, int ptbin, bool SetHarmsToZero)
 {
   // if(!fInitialized) return complex<double>(0,0); //First check if initialised, if not -- initialize, and if it fails, return
   if (corconf.Regs.size() == 0)
@@ -296,12 +353,13 @@ complex<double> GFW::Calculate(CorrConfig corconf, int ptbin, bool SetHarmsToZer
       qovl = &fCumulants.at(ovl);
     else if (ref == poi)
       qovl = qref; // If ref and poi are the same, then the same is for overlap. Only, when OL not explicitly defined
+    vector<int> hars = corconf.Hars.at(i);
     if (SetHarmsToZero) {
-      for (int j = 0; j < static_cast<int>(corconf.Hars.at(i).size()); j++) {
-        corconf.Hars.at(i).at(j) = 0;
+      for (int j = 0; j < static_cast<int>(hars.size()); j++) {
+        hars.at(j) = 0;
       }
     }
-    retval *= RecursiveCorr(qpoi, qref, qovl, ptInd, corconf.Hars.at(i));
+    retval *= RecursiveCorr(qpoi, qref, qovl, ptInd, hars);
   }
   return retval;
 };
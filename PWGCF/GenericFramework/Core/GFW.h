@@ -20,7 +20,9 @@
 
 #include <complex>
 #include <cstdio>
+#include <span>
 #include <string>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -59,15 +61,44 @@ class GFW
   void AddRegion(std::string refName, int lNhar, int* lNparVec, double lEtaMin, double lEtaMax, int lNpT, int BitMask);  // Legacy support, array instead of a vector
   int CreateRegions();
   void Fill(double eta, int ptin, double phi, double weight, int mask, double secondWeight = -1);
+  // Batch fill for a set of particles; all spans have the same size. If secondWeight is empty, no second weight is used
+  void Fill(std::span<const double> eta, std::span<const int> ptin, std::span<const double> phi, std::span<const double> weight, std::span<const int> mask, std::span<const double> secondWeight = {});
   void Clear();
   GFWCumulant GetCumulant(int index) { return fCumulants.at(index); }
   CorrConfig GetCorrelatorConfig(std::string config, std::string head = "", bool ptdif = false);
-  std::complex<double> Calculate(CorrConfig corconf, int ptbin, bool SetHarmsToZero);
+  std::complex<double> Calculate(const CorrConfig& corconf, int ptbin, bool SetHarmsToZero);
   void InitializePowerArrays();
 
  protected:
   bool fInitialized;
   std::vector<CorrConfig> fListOfCFGs;
+  // Buffers with the particles of one region in the batch fill
+  std::vector<int> fFillPt;              //!
+  std::vector<double> fFillPhi;          //!
+  std::vector<double> fFillWeight;       //!
+  std::vector<double> fFillSecondWeight; //!
+  // Cache of the multi-particle correlators computed in the current event. The recursion produces the same sub-correlators
+  // for different configurations and pT bins, so each of them is evaluated only once per event.
+  // The key is {poi, ref, overlap, pT bin, harmonics..., powers...}; entries are reused across events and
+  // considered valid only if their stamp matches the current one, which is incremented whenever the Q-vectors change
+  struct CorrCacheHash {
+    size_t operator()(const std::vector<int>& key) const
+    {
+      size_t hash = key.size();
+      for (int k : key)
+        hash ^= static_cast<size_t>(k) + 0x9e3779b97f4a7c15ULL + (hash << 6) + (hash >> 2);
+      return hash;
+    }
+  };
+  struct CorrCacheEntry {
+    std::complex<double> value;
+    unsigned long stamp;
+  };
+  std::unordered_map<std::vector<int>, CorrCacheEntry, CorrCacheHash> fCorrCache; //!
+  std::vector<int> fCorrCacheKey;                                                 //! buffer to build the keys without allocations
+  unsigned long fCorrCacheStamp = 1;                                              //! incremented whenever the Q-vectors change
+  void BuildCorrCacheKey(GFWCumulant* qpoi, GFWCumulant* qref, GFWCumulant* qol, int ptbin, const std::vector<int>& hars, const std::vector<int>& pows);
+  std::complex<double> RecursiveCorrNoCache(GFWCumulant* qpoi, GFWCumulant* qref, GFWCumulant* qol, int ptbin, std::vector<int>& hars, std::vector<int>& pows);
   std::complex<double> TwoRec(int n1, int n2, int p1, int p2, int ptbin, GFWCumulant*, GFWCumulant*, GFWCumulant*);
   std::complex<double> RecursiveCorr(GFWCumulant* qpoi, GFWCumulant* qref, GFWCumulant* qol, int ptbin, std::vector<int>& hars, std::vector<int>& pows); // POI, Ref. flow, overlapping region
   std::complex<double> RecursiveCorr(GFWCumulant* qpoi, GFWCumulant* qref, GFWCumulant* qol, int ptbin, std::vector<int>& hars);                         // POI, Ref. flow, overlapping region
@@ -11,23 +11,41 @@
 
 #include "GFWCumulant.h"
 
+#include <algorithm>
 #include <cmath>
 #include <complex>
+#include <span>
 #include <vector>
 
 using std::complex;
 using std::vector;
 
-GFWCumulant::GFWCumulant() : fQvector(0),
+GFWCumulant::GFWCumulant() : fQvector(),
+                             fQOffsets(),
+                             fQStride(0),
+                             fMaxPow(0),
+                             fCosBuffer(),
+                             fSinBuffer(),
+                             fWeightBuffer(),
                              fUsed(kBlank),
                              fNEntries(-1),
                              fN(1),
                              fPow(1),
                              fPt(1),
-                             fFilledPts(0),
+                             fFilledPts(),
                              fInitialized(false) {}
 
 GFWCumulant::~GFWCumulant() {}
+void GFWCumulant::AddToQ(int ptin, const double* cosPhi, const double* sinPhi, const double* prefactors)
+{
+  // cosPhi/sinPhi hold cos(n*phi)/sin(n*phi) for all harmonics, prefactors the weight for all powers
+  complex<double>* lQ = &fQvector[QIndex(ptin, 0, 0)];
+  for (int lN = 0; lN < fN; lN++) {
+    complex<double>* lQn = lQ + fQOffsets[lN];
+    for (int lPow = 0; lPow < PW(lN); lPow++)
+      lQn[lPow] += complex<double>(prefactors[lPow] * cosPhi[lN], prefactors[lPow] * sinPhi[lN]);
+  }
+}
 void GFWCumulant::FillArray(int ptin, double phi, double weight, double SecondWeight)
 {
   if (!fInitialized)
@@ -37,53 +55,121 @@ void GFWCumulant::FillArray(int ptin, double phi, double weight, double SecondWe
   else if (ptin < 0 || ptin >= fPt)
     return;
   fFilledPts[ptin] = true;
-  for (int lN = 0; lN < fN; lN++) {
-    double lSin = sin(lN * phi); // No need to recalculate for each power
-    double lCos = cos(lN * phi); // No need to recalculate for each power
-    for (int lPow = 0; lPow < PW(lN); lPow++) {
-      double lPrefactor = 0;
-      // Dont calculate it twice; multiplication is cheaper that power
-      // Also, if second weight is specified, then keep the first weight with power no more than 1, and us the other weight otherwise
-      // this is important when POIs are a subset of REFs and have different weights than REFs
-      if (SecondWeight > 0 && lPow > 1)
-        lPrefactor = pow(SecondWeight, lPow - 1) * weight;
-      else
-        lPrefactor = pow(weight, lPow);
-      double qsin = lPrefactor * lSin;
-      double qcos = lPrefactor * lCos;
-      fQvector[ptin][lN][lPow] += complex<double>(qcos, qsin);
-    }
+  // Harmonics are obtained from a single sin/cos by the recurrence exp(i*n*phi) = exp(i*(n-1)*phi) * exp(i*phi)
+  double* lCos = fCosBuffer.data();
+  double* lSin = fSinBuffer.data();
+  double* lPrefactors = fWeightBuffer.data();
+  double lCos1 = cos(phi);
+  double lSin1 = sin(phi);
+  if (fN > 0) {
+    lCos[0] = 1.;
+    lSin[0] = 0.;
   }
+  for (int lN = 1; lN < fN; lN++) {
+    lCos[lN] = lCos[lN - 1] * lCos1 - lSin[lN - 1] * lSin1;
+    lSin[lN] = lSin[lN - 1] * lCos1 + lCos[lN - 1] * lSin1;
+  }
+  // Weight powers by running multiplication.
+  // If second weight is specified, then keep the first weight with power no more than 1, and us the other weight otherwise
+  // this is important when POIs are a subset of REFs and have different weights than REFs
+  double lHigherWeight = (SecondWeight > 0) ? SecondWeight : weight;
+  for (int lPow = 0; lPow < fMaxPow; lPow++)
+    lPrefactors[lPow] = (lPow == 0) ? 1. : ((lPow == 1) ? weight : lPrefactors[lPow - 1] * lHigherWeight);
+  AddToQ(ptin, lCos, lSin, lPrefactors);
   Inc();
 };
-void GFWCumulant::ResetQs()
+void GFWCumulant::FillArray(std::span<const int> ptin, std::span<const double> phi, std::span<const double> weights, std::span<const double> secondWeights)
 {
-  if (!fNEntries)
-    return; // If 0 entries, then no need to reset. Otherwise, if -1, then just initialized and need to set to 0.
-  for (int i = 0; i < fPt; i++) {
-    fFilledPts[i] = false;
-    for (int lN = 0; lN < fN; lN++) {
-      for (int lPow = 0; lPow < PW(lN); lPow++) {
-        fQvector[i][lN][lPow] = fNullQ;
+  if (!fInitialized)
+    CreateComplexVectorArray(1, 1, 1);
+  // Particles are processed in blocks; within a block, the loops over particles have no dependencies and can be vectorized
+  constexpr int kBlock = kFillBlock;
+  int nParticles = static_cast<int>(phi.size());
+  bool useSecondWeight = !secondWeights.empty();
+  double* lCos = fCosBuffer.data();
+  double* lSin = fSinBuffer.data();
+  double* lPrefactors = fWeightBuffer.data();
+  for (int lStart = 0; lStart < nParticles; lStart += kBlock) {
+    int lSize = std::min(kBlock, nParticles - lStart);
+    // harmonics, stored as [harmonic][particle]
+    for (int i = 0; i < lSize; i++) {
+      lCos[i] = 1.;
+      lSin[i] = 0.;
+    }
+    if (fN > 1) {
+      for (int i = 0; i < lSize; i++) {
+        lCos[kBlock + i] = cos(phi[lStart + i]);
+        lSin[kBlock + i] = sin(phi[lStart + i]);
+      }
+    }
+    for (int lN = 2; lN < fN; lN++) {
+      double* lCosN = &lCos[lN * kBlock];
+      double* lSinN = &lSin[lN * kBlock];
+      const double* lCosPrev = lCosN - kBlock;
+      const double* lSinPrev = lSinN - kBlock;
+      const double* lCos1 = &lCos[kBlock];
+      const double* lSin1 = &lSin[kBlock];
+      for (int i = 0; i < lSize; i++) {
+        lCosN[i] = lCosPrev[i] * lCos1[i] - lSinPrev[i] * lSin1[i];
+        lSinN[i] = lSinPrev[i] * lCos1[i] + lCosPrev[i] * lSin1[i];
       }
     }
+    // weight powers, stored as [power][particle]
+    for (int i = 0; i < lSize; i++)
+      lPrefactors[i] = 1.;
+    if (fMaxPow > 1) {
+      for (int i = 0; i < lSize; i++)
+        lPrefactors[kBlock + i] = weights[lStart + i];
+    }
+    for (int lPow = 2; lPow < fMaxPow; lPow++) {
+      double* lPrefactorsP = &lPrefactors[lPow * kBlock];
+      const double* lPrefactorsPrev = lPrefactorsP - kBlock;
+      if (useSecondWeight) {
+        for (int i = 0; i < lSize; i++)
+          lPrefactorsP[i] = lPrefactorsPrev[i] * (secondWeights[lStart + i] > 0 ? secondWeights[lStart + i] : weights[lStart + i]);
+      } else {
+        for (int i = 0; i < lSize; i++)
+          lPrefactorsP[i] = lPrefactorsPrev[i] * weights[lStart + i];
+      }
+    }
+    // accumulate the Q-vectors
+    for (int i = 0; i < lSize; i++) {
+      int lPtBin = (fPt == 1) ? 0 : ptin[lStart + i];
+      if (lPtBin < 0 || lPtBin >= fPt)
+        continue;
+      fFilledPts[lPtBin] = true;
+      complex<double>* lQ = &fQvector[QIndex(lPtBin, 0, 0)];
+      for (int lN = 0; lN < fN; lN++) {
+        complex<double>* lQn = lQ + fQOffsets[lN];
+        double lCosN = lCos[lN * kBlock + i];
+        double lSinN = lSin[lN * kBlock + i];
+        for (int lPow = 0; lPow < PW(lN); lPow++) {
+          double lPrefactor = lPrefactors[lPow * kBlock + i];
+          lQn[lPow] += complex<double>(lPrefactor * lCosN, lPrefactor * lSinN);
+        }
+      }
+      Inc();
+    }
   }
+};
+void GFWCumulant::ResetQs()
+{
+  if (!fNEntries)
+    return; // If 0 entries, then no need to reset. Otherwise, if -1, then just initialized and need to set to 0.
+  std::fill(fFilledPts.begin(), fFilledPts.end(), false);
+  std::fill(fQvector.begin(), fQvector.end(), fNullQ);
   fNEntries = 0;
 };
 void GFWCumulant::DestroyComplexVectorArray()
 {
   if (!fInitialized)
     return;
-  for (int l_n = 0; l_n < fN; l_n++) {
-    for (int i = 0; i < fPt; i++) {
-      delete[] fQvector[i][l_n];
-    }
-  }
-  for (int i = 0; i < fPt; i++) {
-    delete[] fQvector[i];
-  }
-  delete[] fQvector;
-  delete[] fFilledPts;
+  fQvector.clear();
+  fQOffsets.clear();
+  fFilledPts.clear();
+  fCosBuffer.clear();
+  fSinBuffer.clear();
+  fWeightBuffer.clear();
   fInitialized = false;
   fNEntries = -1;
 };
@@ -102,17 +188,20 @@ void GFWCumulant::CreateComplexVectorArrayVarPower(int N, vector<int> PowVec, in
   fN = N;
   fPow = 0;
   fPt = Pt;
-  fFilledPts = new bool[Pt];
   fPowVec = PowVec;
-  fQvector = new complex<double>**[fPt];
-  for (int i = 0; i < fPt; i++) {
-    fQvector[i] = new complex<double>*[fN];
-  }
+  fQOffsets.resize(fN);
+  fQStride = 0;
+  fMaxPow = 0;
   for (int l_n = 0; l_n < fN; l_n++) {
-    for (int i = 0; i < fPt; i++) {
-      fQvector[i][l_n] = new complex<double>[PW(l_n)];
-    }
+    fQOffsets[l_n] = fQStride;
+    fQStride += PW(l_n);
+    fMaxPow = std::max(fMaxPow, PW(l_n));
   }
+  fFilledPts.assign(fPt, false);
+  fQvector.assign(fPt * fQStride, fNullQ);
+  fCosBuffer.assign(kFillBlock * std::max(fN, 1), 0.);
+  fSinBuffer.assign(kFillBlock * std::max(fN, 1), 0.);
+  fWeightBuffer.assign(kFillBlock * std::max(fMaxPow, 1), 0.);
   ResetQs();
   fInitialized = true;
 };
@@ -123,12 +212,12 @@ complex<double> GFWCumulant::Vec(int n, int p, int ptbin)
   if (ptbin >= fPt || ptbin < 0)
     ptbin = 0;
   if (n >= 0)
-    return fQvector[ptbin][n][p];
-  return conj(fQvector[ptbin][-n][p]);
+    return fQvector[QIndex(ptbin, n, p)];
+  return conj(fQvector[QIndex(ptbin, -n, p)]);
 };
 bool GFWCumulant::IsPtBinFilled(int ptb)
 {
-  if (!fFilledPts)
+  if (fFilledPts.empty())
     return false;
   if (ptb > 0) {
     if (fPt == 1)
@@ -20,6 +20,7 @@
 
 #include <cmath>
 #include <complex>
+#include <span>
 #include <vector>
 
 class GFWCumulant
@@ -29,6 +30,8 @@ class GFWCumulant
   ~GFWCumulant();
   void ResetQs();
   void FillArray(int ptin, double phi, double weight = 1, double SecondWeight = -1);
+  // Batch fill; all spans have the same size. If secondWeights is empty, no second weight is used
+  void FillArray(std::span<const int> ptin, std::span<const double> phi, std::span<const double> weights, std::span<const double> secondWeights = {});
   enum UsedFlags_t { kBlank = 0,
                      kFull = 1,
                      kPt = 2 };
@@ -46,7 +49,17 @@ class GFWCumulant
   void DestroyComplexVectorArray();
   std::complex<double> Vec(int, int, int ptbin = 0); // envelope class to summarize pt-dif. Q-vec getter
  protected:
-  std::complex<double>*** fQvector;
+  static constexpr int kFillBlock = 64; // Number of particles processed together in the batch fill
+  // Q-vectors are stored contiguously as [ptbin][harmonic][power], with PW(harmonic) powers for each harmonic
+  int QIndex(int ptbin, int n, int p) const { return ptbin * fQStride + fQOffsets[n] + p; }
+  void AddToQ(int ptin, const double* cosPhi, const double* sinPhi, const double* prefactors);
+  std::vector<std::complex<double>> fQvector;
+  std::vector<int> fQOffsets;        //! Position of the first power of each harmonic within one pt bin
+  int fQStride;                      //! Number of Q-vectors per pt bin
+  int fMaxPow;                       //! Maximum power over all harmonics
+  std::vector<double> fCosBuffer;    //! cos(n*phi) for kFillBlock particles, [harmonic][particle]
+  std::vector<double> fSinBuffer;    //! sin(n*phi) for kFillBlock particles, [harmonic][particle]
+  std::vector<double> fWeightBuffer; //! weight powers for kFillBlock particles, [power][particle]
   uint fUsed;
   int fNEntries;
   // Q-vectors. Could be done recursively, but maybe defining each one of them explicitly is easier to read
@@ -54,7 +67,7 @@ class GFWCumulant
   int fPow;                 //! Power
   std::vector<int> fPowVec; //! Powers array
   int fPt;                  //! fPt bins
-  bool* fFilledPts;
+  std::vector<char> fFilledPts;
   bool fInitialized; // Arrays are initialized
   std::complex<double> fNullQ = 0;
 };
@@ -13,6 +13,7 @@
 
 #include <Framework/Logger.h>
 
+#include <TAxis.h>
 #include <TCollection.h>
 #include <TFile.h>
 #include <TH1.h>
@@ -25,7 +26,10 @@
 
 #include <RtypesCore.h>
 
+#include <algorithm>
+#include <cstddef>
 #include <cstdio>
+#include <vector>
 
 GFWWeights::GFWWeights() : TNamed("", ""),
                            fDataFilled(kFALSE),
@@ -127,59 +131,110 @@ void GFWWeights::fill(double phi, double eta, double vz, double pt, double /*cen
     th3 = reinterpret_cast<TH3D*>(tar->At(tar->GetEntries() - 1));
   }
   th3->Fill(htype ? pt : phi, eta, vz, weight);
+  resetGrids();
 };
 double GFWWeights::getWeight(double phi, double eta, double vz, double pt, double /*cent*/, int htype)
 {
-  TObjArray* tar = 0;
-  const char* pf = "";
-  if (htype == 0) {
-    tar = fW_data;
-    pf = "data";
-  }
-  if (htype == 1) {
-    tar = fW_mcrec;
-    pf = "mcrec";
-  }
-  if (htype == 2) {
-    tar = fW_mcgen;
-    pf = "mcgen";
-  }
-  if (!tar)
+  if (htype < 0 || htype > 2)
     return 1;
-  TH3D* th3 = reinterpret_cast<TH3D*>(tar->FindObject(getBinName(0, 0, pf)));
-  if (!th3)
-    return 1; //-1;
-  int xind = th3->GetXaxis()->FindBin(htype ? pt : phi);
-  int etaind = th3->GetYaxis()->FindBin(eta);
-  int vzind = th3->GetZaxis()->FindBin(vz);
-  double weight = th3->GetBinContent(xind, etaind, vzind);
-  if (weight != 0)
-    return 1. / weight;
-  return 1;
+  FlatGrid& grid = fGridWeights[htype];
+  if (!grid.isBuilt) {
+    TObjArray* tar = 0;
+    const char* pf = "";
+    if (htype == 0) {
+      tar = fW_data;
+      pf = "data";
+    }
+    if (htype == 1) {
+      tar = fW_mcrec;
+      pf = "mcrec";
+    }
+    if (htype == 2) {
+      tar = fW_mcgen;
+      pf = "mcgen";
+    }
+    grid.build(tar ? reinterpret_cast<TH3D*>(tar->FindObject(getBinName(0, 0, pf))) : 0);
+  }
+  return grid.get(htype ? pt : phi, eta, vz);
 };
 double GFWWeights::getNUA(double phi, double eta, double vz)
 {
-  if (!fAccInt)
-    createNUA();
-  int xind = fAccInt->GetXaxis()->FindBin(phi);
-  int etaind = fAccInt->GetYaxis()->FindBin(eta);
-  int vzind = fAccInt->GetZaxis()->FindBin(vz);
-  double weight = fAccInt->GetBinContent(xind, etaind, vzind);
-  if (weight != 0)
-    return 1. / weight;
-  return 1;
+  if (!fGridNUA.isBuilt) {
+    if (!fAccInt)
+      createNUA();
+    fGridNUA.build(fAccInt);
+  }
+  return fGridNUA.get(phi, eta, vz);
 }
 double GFWWeights::getNUE(double pt, double eta, double vz)
 {
-  if (!fEffInt)
-    createNUE();
-  int xind = fEffInt->GetXaxis()->FindBin(pt);
-  int etaind = fEffInt->GetYaxis()->FindBin(eta);
-  int vzind = fEffInt->GetZaxis()->FindBin(vz);
-  double weight = fEffInt->GetBinContent(xind, etaind, vzind);
-  if (weight != 0)
-    return 1. / weight;
-  return 1;
+  if (!fGridNUE.isBuilt) {
+    if (!fEffInt)
+      createNUE();
+    fGridNUE.build(fEffInt);
+  }
+  return fGridNUE.get(pt, eta, vz);
+}
+void GFWWeights::getNUA(int n, const float* phi, const float* eta, const float* vz, float* weights)
+{
+  if (n > 0)
+    weights[0] = getNUA(phi[0], eta[0], vz[0]); // builds the grid
+  for (int i = 1; i < n; i++)
+    weights[i] = fGridNUA.get(phi[i], eta[i], vz[i]);
+}
+void GFWWeights::getNUE(int n, const float* pt, const float* eta, const float* vz, float* weights)
+{
+  if (n > 0)
+    weights[0] = getNUE(pt[0], eta[0], vz[0]); // builds the grid
+  for (int i = 1; i < n; i++)
+    weights[i] = fGridNUE.get(pt[i], eta[i], vz[i]);
+}
+void GFWWeights::FlatAxis::set(const TAxis* axis)
+{
+  nBins = axis->GetNbins();
+  min = axis->GetXmin();
+  max = axis->GetXmax();
+  invWidth = nBins / (max - min);
+  edges.clear();
+  if (axis->GetXbins()->GetSize() > 0)
+    edges.assign(axis->GetXbins()->GetArray(), axis->GetXbins()->GetArray() + axis->GetXbins()->GetSize());
+}
+int GFWWeights::FlatAxis::findBin(double x) const
+{
+  if (!edges.empty())
+    return (x < min) ? 0 : (!(x < max) ? nBins + 1 : std::upper_bound(edges.begin(), edges.end(), x) - edges.begin());
+  const int bin = 1 + static_cast<int>((x - min) * invWidth);
+  return (x < min) ? 0 : (!(x < max) ? nBins + 1 : std::min(bin, nBins));
+}
+void GFWWeights::FlatGrid::build(TH3D* th3)
+{
+  isBuilt = true;
+  isEmpty = !th3;
+  inverseWeights.clear();
+  if (isEmpty)
+    return;
+  axes[0].set(th3->GetXaxis());
+  axes[1].set(th3->GetYaxis());
+  axes[2].set(th3->GetZaxis());
+  // same ordering as the global bins of the TH3D, x running fastest
+  inverseWeights.resize((axes[0].nBins + 2) * (axes[1].nBins + 2) * (axes[2].nBins + 2));
+  for (std::size_t bin = 0; bin < inverseWeights.size(); bin++) {
+    double weight = th3->GetBinContent(bin);
+    inverseWeights[bin] = (weight != 0) ? 1. / weight : 1.;
+  }
+}
+double GFWWeights::FlatGrid::get(double x, double y, double z) const
+{
+  if (isEmpty)
+    return 1;
+  return inverseWeights[axes[0].findBin(x) + (axes[0].nBins + 2) * (axes[1].findBin(y) + (axes[1].nBins + 2) * axes[2].findBin(z))];
+}
+void GFWWeights::resetGrids()
+{
+  for (auto& grid : fGridWeights)
+    grid.isBuilt = false;
+  fGridNUA.isBuilt = false;
+  fGridNUE.isBuilt = false;
 }
 double GFWWeights::findMax(TH3D* inh, int& ix, int& iy, int& iz)
 {
@@ -197,6 +252,7 @@ double GFWWeights::findMax(TH3D* inh, int& ix, int& iy, int& iz)
 };
 void GFWWeights::mcToEfficiency()
 {
+  resetGrids();
   if (fW_mcgen->GetEntries() < 1) {
     LOGF(info, "MC gen. array empty. This is probably because effs. have been calculated and the generated particle histograms have been cleared out!\n");
     return;
@@ -212,6 +268,7 @@ void GFWWeights::mcToEfficiency()
 };
 void GFWWeights::rebinNUA(int nX, int nY, int nZ)
 {
+  resetGrids();
   if (fW_data->GetEntries() < 1)
     return;
   for (int i = 0; i < fW_data->GetEntries(); i++) {
@@ -222,6 +279,7 @@ void GFWWeights::rebinNUA(int nX, int nY, int nZ)
 };
 void GFWWeights::createNUA(bool IntegrateOverCentAndPt)
 {
+  resetGrids();
   if (!IntegrateOverCentAndPt) {
     LOGF(info, "Method is outdated! NUA is integrated over centrality and pT. Quit now, or the behaviour will be bad\n");
     return;
@@ -275,6 +333,7 @@ TH1D* GFWWeights::getdNdPhi()
 }
 void GFWWeights::createNUE(bool IntegrateOverCentrality)
 {
+  resetGrids();
   if (!IntegrateOverCentrality) {
     LOGF(info, "Method is outdated! NUE is integrated over centrality. Quit now, or the behaviour will be bad\n");
     return;
@@ -299,6 +358,7 @@ void GFWWeights::createNUE(bool IntegrateOverCentrality)
 };
 void GFWWeights::readAndMerge(TString filelinks, TString listName, bool addData, bool addRec, bool addGen)
 {
+  resetGrids();
   FILE* flist = fopen(filelinks.Data(), "r");
   char str[150];
   int nFiles = 0;
@@ -371,6 +431,7 @@ void GFWWeights::addArray(TObjArray* targ, TObjArray* sour)
 };
 void GFWWeights::overwriteNUA()
 {
+  resetGrids();
   if (!fAccInt)
     createNUA();
   TString ts(fW_data->At(0)->GetName());
@@ -378,9 +439,11 @@ void GFWWeights::overwriteNUA()
   delete trash;
   fW_data->Add(reinterpret_cast<TH3D*>(fAccInt->Clone(ts.Data())));
   delete fAccInt;
+  fAccInt = 0;
 }
 Long64_t GFWWeights::Merge(TCollection* collist)
 {
+  resetGrids();
   Long64_t nmerged = 0;
   if (!fW_data) {
     fW_data = new TObjArray();
@@ -488,6 +551,7 @@ TH1D* GFWWeights::getEfficiency(double etamin, double etamax, double vzmin, doub
 }
 void GFWWeights::mergeWeights(GFWWeights* other)
 {
+  resetGrids();
   if (!fW_data) {
     fW_data = new TObjArray();
     fW_data->SetName("Weights_Data");
@@ -498,6 +562,7 @@ void GFWWeights::mergeWeights(GFWWeights* other)
 }
 void GFWWeights::setTH3D(TH3D* th3d)
 {
+  resetGrids();
   if (!fW_data) {
     fW_data = new TObjArray();
     fW_data->SetName("GFWWeights_Data");
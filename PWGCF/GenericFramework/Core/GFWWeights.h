@@ -18,6 +18,7 @@
 
 #include <TCollection.h>
 #include <TH1.h>
+#include <TAxis.h>
 #include <TH3.h>
 #include <TNamed.h>
 #include <TObjArray.h>
@@ -26,6 +27,8 @@
 #include <Rtypes.h>
 #include <RtypesCore.h>
 
+#include <vector>
+
 class GFWWeights : public TNamed
 {
  public:
@@ -37,6 +40,8 @@ class GFWWeights : public TNamed
   double getWeight(double phi, double eta, double vz, double pt, double cent, int htype);             // htype: 0 for data, 1 for mc rec, 2 for mc gen
   double getNUA(double phi, double eta, double vz);                                                   // This just fetches correction from integrated NUA, should speed up
   double getNUE(double pt, double eta, double vz);                                                    // fetches weight from fEffInt
+  void getNUA(int n, const float* phi, const float* eta, const float* vz, float* weights);            // getNUA for n tracks
+  void getNUE(int n, const float* pt, const float* eta, const float* vz, float* weights);             // getNUE for n tracks
   bool isDataFilled() { return fDataFilled; }
   bool isMCFilled() { return fMCFilled; }
   double findMax(TH3D* inh, int& ix, int& iy, int& iz);
@@ -73,6 +78,26 @@ class GFWWeights : public TNamed
   int fNbinsPt;    //! do not store
   double* fbinsPt; //! do not store
   void addArray(TObjArray* targ, TObjArray* sour);
+  // inverse weights of a TH3D in a flat array, under- and overflow included, built at the first look-up
+  struct FlatAxis {
+    int nBins = 0;
+    double min = 0., max = 0., invWidth = 0.;
+    std::vector<double> edges; // only for variable bin widths
+    void set(const TAxis* axis);
+    int findBin(double x) const; // as TAxis::FindBin
+  };
+  struct FlatGrid {
+    bool isBuilt = false;
+    bool isEmpty = true; // no histogram, all the weights are 1
+    FlatAxis axes[3];
+    std::vector<double> inverseWeights;
+    void build(TH3D* th3);
+    double get(double x, double y, double z) const;
+  };
+  FlatGrid fGridWeights[3]; //! per htype
+  FlatGrid fGridNUA;        //!
+  FlatGrid fGridNUE;        //!
+  void resetGrids();
   const char* getBinName(double /*ptv*/, double /*v0mv*/, const char* pf = "")
   {
     int ptind = 0;  // GetPtBin(ptv);
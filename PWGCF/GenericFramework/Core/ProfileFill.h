@@ -0,0 +1,111 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file ProfileFill.h
+/// \brief Fills of TProfile and TProfile2D at a known bin, for the profiles of the same binning filled for every event
+
+#ifndef PWGCF_GENERICFRAMEWORK_CORE_PROFILEFILL_H_
+#define PWGCF_GENERICFRAMEWORK_CORE_PROFILEFILL_H_
+
+#include <TArrayD.h>
+#include <TH1.h>
+#include <TMath.h>
+#include <TProfile.h>
+#include <TProfile2D.h>
+
+#include <RtypesCore.h>
+
+// The bin is looked up once and the same bin is filled in the main profile and in the subsample profile, which are
+// clones with the same axes. The content, errors, bin entries and statistics are updated as TProfile(2D)::Fill does.
+namespace profile_fill
+{
+
+inline bool acceptValue(double value, double min, double max)
+{
+  return min == max || !(value < min || value > max || TMath::IsNaN(value));
+}
+
+inline void addToBin(TProfile* prof, Int_t bin, double y, double w)
+{
+  prof->GetW()[bin] += w * y;
+  prof->GetW2()[bin] += w * y * y;
+  if (!prof->GetBinSumw2()->fN && w != 1.0 && !prof->TestBit(TH1::kIsNotW))
+    prof->Sumw2();
+  if (prof->GetBinSumw2()->fN)
+    prof->GetB2()[bin] += w * w;
+  prof->GetB()[bin] += w;
+}
+
+inline void addToBin(TProfile2D* prof, Int_t bin, double z, double w)
+{
+  prof->GetW()[bin] += w * z;
+  prof->GetW2()[bin] += w * z * z;
+  if (!prof->GetBinSumw2()->fN && w != 1.0 && !prof->TestBit(TH1::kIsNotW))
+    prof->Sumw2();
+  if (prof->GetBinSumw2()->fN)
+    prof->GetB2()[bin] += w * w;
+  prof->GetB()[bin] += w;
+}
+
+/// TProfile::Fill(x, y, w) at the bin binx of x
+inline void fillAtBin(TProfile* prof, Int_t binx, double x, double y, double w)
+{
+  if (prof->GetBuffer()) {
+    prof->Fill(x, y, w);
+    return;
+  }
+  if (!acceptValue(y, prof->GetYmin(), prof->GetYmax()))
+    return;
+  addToBin(prof, binx, y, w);
+  prof->SetEntries(prof->GetEntries() + 1);
+  if ((binx == 0 || binx > prof->GetNbinsX()) && !prof->GetStatOverflowsBehaviour())
+    return;
+  Double_t stats[6];
+  prof->GetStats(stats);
+  stats[0] += w;
+  stats[1] += w * w;
+  stats[2] += w * x;
+  stats[3] += w * x * x;
+  stats[4] += w * y;
+  stats[5] += w * y * y;
+  prof->PutStats(stats);
+}
+
+/// TProfile2D::Fill(x, y, z, w) at the bins binx of x and biny of y
+inline void fillAtBin(TProfile2D* prof, Int_t binx, Int_t biny, double x, double y, double z, double w)
+{
+  if (prof->GetBuffer()) {
+    prof->Fill(x, y, z, w);
+    return;
+  }
+  if (!acceptValue(z, prof->GetZmin(), prof->GetZmax()))
+    return;
+  addToBin(prof, prof->GetBin(binx, biny), z, w);
+  prof->SetEntries(prof->GetEntries() + 1);
+  if ((binx == 0 || binx > prof->GetNbinsX() || biny == 0 || biny > prof->GetNbinsY()) && !prof->GetStatOverflowsBehaviour())
+    return;
+  Double_t stats[9];
+  prof->GetStats(stats);
+  stats[0] += w;
+  stats[1] += w * w;
+  stats[2] += w * x;
+  stats[3] += w * x * x;
+  stats[4] += w * y;
+  stats[5] += w * y * y;
+  stats[6] += w * x * y;
+  stats[7] += w * z;
+  stats[8] += w * z * z;
+  prof->PutStats(stats);
+}
+
+} // namespace profile_fill
+
+#endif // PWGCF_GENERICFRAMEWORK_CORE_PROFILEFILL_H_
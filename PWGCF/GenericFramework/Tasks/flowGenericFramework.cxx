@@ -454,6 +454,7 @@ struct FlowGenericFramework {
   // Generic Framework
   GFW* fGFW = new GFW();
   std::vector<GFW::CorrConfig> corrconfigs;
+  std::vector<std::vector<int>> corrconfigBins; // flow container bins of corrconfigs, [0] pt-integrated, [i] pt bin i
 
   std::vector<GFW::CorrConfig> corrconfigsV02;
   std::vector<GFW::CorrConfig> corrconfigsV0;
@@ -825,6 +826,7 @@ struct FlowGenericFramework {
     addConfigObjectsToObjArray(oba, corrconfigs);
     addConfigObjectsToObjArray(oba, corrconfigsV02);
     addConfigObjectsToObjArray(oba, corrconfigsV0);
+    corrconfigBins = getProfileBins(oba, corrconfigs);
 
     if (doprocessData || doprocessRun2 || doprocessMCReco) {
       fFC->SetName("FlowContainer");
@@ -1008,6 +1010,23 @@ struct FlowGenericFramework {
     }
   }
 
+  // same bins as the label look-up of FlowContainer::FillProfile, found once instead of for every event
+  std::vector<std::vector<int>> getProfileBins(TObjArray* oba, const std::vector<GFW::CorrConfig>& configs)
+  {
+    std::vector<std::vector<int>> bins;
+    for (const auto& config : configs) {
+      auto& configBins = bins.emplace_back(fPtAxis->GetNbins() + 1, -1);
+      if (!config.pTDif) {
+        configBins[0] = oba->IndexOf(oba->FindObject(config.Head.c_str())) + 1;
+        continue;
+      }
+      for (auto i = 1; i <= fPtAxis->GetNbins(); ++i) {
+        configBins[i] = oba->IndexOf(oba->FindObject(Form("%s_pt_%i", config.Head.c_str(), i))) + 1;
+      }
+    }
+    return bins;
+  }
+
   int getMagneticField(uint64_t timestamp)
   {
     // TODO done only once (and not per run). Will be replaced by CCDBConfigurable
@@ -1494,7 +1513,7 @@ struct FlowGenericFramework {
         if (std::abs(val) < 1) {
           if (corrconfigs.at(l_ind).Head.find("3pcW") != std::string::npos && cfgEventWeight.cfgUseMultiplicityFractionWeights)
             dnx *= histosNpt[FractionV02][ChargedID]->Integral();
-          (dt == Gen) ? fFCgen->FillProfile(corrconfigs.at(l_ind).Head.c_str(), centmult, val, cfgEventWeight.cfgUseMultiplicityFlowWeights ? dnx : 1.0, rndm) : fFC->FillProfile(corrconfigs.at(l_ind).Head.c_str(), centmult, val, cfgEventWeight.cfgUseMultiplicityFlowWeights ? dnx : 1.0, rndm);
+          (dt == Gen) ? fFCgen->FillProfile(corrconfigBins[l_ind][0], centmult, val, cfgEventWeight.cfgUseMultiplicityFlowWeights ? dnx : 1.0, rndm) : fFC->FillProfile(corrconfigBins[l_ind][0], centmult, val, cfgEventWeight.cfgUseMultiplicityFlowWeights ? dnx : 1.0, rndm);
           if (cfgUseGapMethod) {
             fFCpt->fillVnPtProfiles(centmult, val, dnx, rndm, o2::analysis::gfw::configs.GetpTCorrMasks()[l_ind]);
           }
@@ -1507,7 +1526,7 @@ struct FlowGenericFramework {
           continue;
         auto val = fGFW->Calculate(corrconfigs.at(l_ind), i - 1, kFALSE).real() / dnx;
         if (std::abs(val) < 1)
-          (dt == Gen) ? fFCgen->FillProfile(Form("%s_pt_%i", corrconfigs.at(l_ind).Head.c_str(), i), centmult, val, cfgEventWeight.cfgUseMultiplicityFlowWeights ? dnx : 1.0, rndm) : fFC->FillProfile(Form("%s_pt_%i", corrconfigs.at(l_ind).Head.c_str(), i), centmult, val, cfgEventWeight.cfgUseMultiplicityFlowWeights ? dnx : 1.0, rndm);
+          (dt == Gen) ? fFCgen->FillProfile(corrconfigBins[l_ind][i], centmult, val, cfgEventWeight.cfgUseMultiplicityFlowWeights ? dnx : 1.0, rndm) : fFC->FillProfile(corrconfigBins[l_ind][i], centmult, val, cfgEventWeight.cfgUseMultiplicityFlowWeights ? dnx : 1.0, rndm);
       }
     }
 
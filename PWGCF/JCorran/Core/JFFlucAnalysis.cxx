@@ -93,24 +93,38 @@ inline TComplex TwoGap(const TComplex (&Qa)[JFFlucAnalysis::kNH][JFFlucAnalysis:
   return Qa[a][1] * C(Qb[b][1]);
 }
 
+// The gap correlators factorize into a term of subevent A times the conjugate of a term of subevent B, the two- and
+// three-particle terms below are the numerators of the 2- and 3-particle correlators inside one subevent. E.g. the
+// 6-particle correlator with 3 particles in each subevent takes two 3-particle terms and one product, instead of
+// multiplying out all the 25 products of Q-vectors.
+inline TComplex TwoSub(const TComplex (&Qs)[JFFlucAnalysis::kNH][JFFlucAnalysis::nKL], UInt_t a, UInt_t b)
+{
+  return Qs[a][1] * Qs[b][1] - Qs[a + b][2];
+}
+
+inline TComplex ThreeSub(const TComplex (&Qs)[JFFlucAnalysis::kNH][JFFlucAnalysis::nKL], UInt_t a, UInt_t b, UInt_t c)
+{
+  return Qs[a][1] * Qs[b][1] * Qs[c][1] - Qs[a + b][2] * Qs[c][1] - Qs[a + c][2] * Qs[b][1] - Qs[b + c][2] * Qs[a][1] + 2.0 * Qs[a + b + c][3];
+}
+
 inline TComplex ThreeGap(const TComplex (&Qa)[JFFlucAnalysis::kNH][JFFlucAnalysis::nKL], const TComplex (&Qb)[JFFlucAnalysis::kNH][JFFlucAnalysis::nKL], UInt_t a, UInt_t b, UInt_t c)
 {
-  return Qa[a][1] * C(Qb[b][1] * Qb[c][1] - Qb[b + c][2]);
+  return Qa[a][1] * C(TwoSub(Qb, b, c));
 }
 
 inline TComplex FourGap22(const TComplex (&Qa)[JFFlucAnalysis::kNH][JFFlucAnalysis::nKL], const TComplex (&Qb)[JFFlucAnalysis::kNH][JFFlucAnalysis::nKL], UInt_t a, UInt_t b, UInt_t c, UInt_t d)
 {
-  return Qa[a][1] * Qa[b][1] * C(Qb[c][1] * Qb[d][1]) - Qa[a + b][2] * C(Qb[c][1] * Qb[d][1]) - Qa[a][1] * Qa[b][1] * C(Qb[c + d][2]) + Qa[a + b][2] * C(Qb[c + d][2]);
+  return TwoSub(Qa, a, b) * C(TwoSub(Qb, c, d));
 }
 
 inline TComplex FourGap13(const TComplex (&Qa)[JFFlucAnalysis::kNH][JFFlucAnalysis::nKL], const TComplex (&Qb)[JFFlucAnalysis::kNH][JFFlucAnalysis::nKL], UInt_t a, UInt_t b, UInt_t c, UInt_t d)
 {
-  return Qa[a][1] * C(Qb[b][1] * Qb[c][1] * Qb[d][1] - Qb[b + c][2] * Qb[d][1] - Qb[b + d][2] * Qb[c][1] - Qb[c + d][2] * Qb[b][1] + 2.0 * Qb[b + c + d][3]);
+  return Qa[a][1] * C(ThreeSub(Qb, b, c, d));
 }
 
 inline TComplex SixGap33(const TComplex (&Qa)[JFFlucAnalysis::kNH][JFFlucAnalysis::nKL], const TComplex (&Qb)[JFFlucAnalysis::kNH][JFFlucAnalysis::nKL], UInt_t n1, UInt_t n2, UInt_t n3, UInt_t n4, UInt_t n5, UInt_t n6)
 {
-  return Qa[n1][1] * Qa[n2][1] * Qa[n3][1] * C(Qb[n4][1] * Qb[n5][1] * Qb[n6][1]) - Qa[n1][1] * Qa[n2][1] * Qa[n3][1] * C(Qb[n4 + n5][2] * Qb[n6][1]) - Qa[n1][1] * Qa[n2][1] * Qa[n3][1] * C(Qb[n4 + n6][2] * Qb[n5][1]) - Qa[n1][1] * Qa[n2][1] * Qa[n3][1] * C(Qb[n5 + n6][2] * Qb[n4][1]) + 2.0 * Qa[n1][1] * Qa[n2][1] * Qa[n3][1] * C(Qb[n4 + n5 + n6][3]) - Qa[n1 + n2][2] * Qa[n3][1] * C(Qb[n4][1] * Qb[n5][1] * Qb[n6][1]) + Qa[n1 + n2][2] * Qa[n3][1] * C(Qb[n4 + n5][2] * Qb[n6][1]) + Qa[n1 + n2][2] * Qa[n3][1] * C(Qb[n4 + n6][2] * Qb[n5][1]) + Qa[n1 + n2][2] * Qa[n3][1] * C(Qb[n5 + n6][2] * Qb[n4][1]) - 2.0 * Qa[n1 + n2][2] * Qa[n3][1] * C(Qb[n4 + n5 + n6][3]) - Qa[n1 + n3][2] * Qa[n2][1] * C(Qb[n4][1] * Qb[n5][1] * Qb[n6][1]) + Qa[n1 + n3][2] * Qa[n2][1] * C(Qb[n4 + n5][2] * Qb[n6][1]) + Qa[n1 + n3][2] * Qa[n2][1] * C(Qb[n4 + n6][2] * Qb[n5][1]) + Qa[n1 + n3][2] * Qa[n2][1] * C(Qb[n5 + n6][2] * Qb[n4][1]) - 2.0 * Qa[n1 + n3][2] * Qa[n2][1] * C(Qb[n4 + n5 + n6][3]) - Qa[n2 + n3][2] * Qa[n1][1] * C(Qb[n4][1] * Qb[n5][1] * Qb[n6][1]) + Qa[n2 + n3][2] * Qa[n1][1] * C(Qb[n4 + n5][2] * Qb[n6][1]) + Qa[n2 + n3][2] * Qa[n1][1] * C(Qb[n4 + n6][2] * Qb[n5][1]) + Qa[n2 + n3][2] * Qa[n1][1] * C(Qb[n5 + n6][2] * Qb[n4][1]) - 2.0 * Qa[n2 + n3][2] * Qa[n1][1] * C(Qb[n4 + n5 + n6][3]) + 2.0 * Qa[n1 + n2 + n3][3] * C(Qb[n4][1] * Qb[n5][1] * Qb[n6][1]) - 2.0 * Qa[n1 + n2 + n3][3] * C(Qb[n4 + n5][2] * Qb[n6][1]) - 2.0 * Qa[n1 + n2 + n3][3] * C(Qb[n4 + n6][2] * Qb[n5][1]) - 2.0 * Qa[n1 + n2 + n3][3] * C(Qb[n5 + n6][2] * Qb[n4][1]) + 4.0 * Qa[n1 + n2 + n3][3] * C(Qb[n4 + n5 + n6][3]);
+  return ThreeSub(Qa, n1, n2, n3) * C(ThreeSub(Qb, n4, n5, n6));
 }
 
 TComplex JFFlucAnalysis::Q(int n, int p)
@@ -209,20 +223,36 @@ void JFFlucAnalysis::UserExec(Option_t* /*popt*/) // NOLINT(readability/casting)
       }
     }
 
+    // Correlator plan: the subevent terms of the 4- and 6-particle correlators below, TwoSub(ih, ihh) and
+    // ThreeSub(ih, ihh, ihh), are computed once for each harmonic pair and subevent, and taken from these tables by all
+    // the correlators which need them.
+    TComplex twoA[kNH][kNH], twoB[kNH][kNH];
+    TComplex threeA[kNH][kNH], threeB[kNH][kNH];
+    for (UInt_t ih = 2; ih < kNH; ih++) {
+      for (UInt_t ihh = 2; ihh < kNH; ihh++) {
+        if (ihh != ih && ihh >= kcNH && ih >= kcNH)
+          continue; // not needed
+        twoA[ih][ihh] = TwoSub(Qa, ih, ihh);
+        twoB[ih][ihh] = TwoSub(Qb, ih, ihh);
+        threeA[ih][ihh] = ThreeSub(Qa, ih, ihh, ihh);
+        threeB[ih][ihh] = ThreeSub(Qb, ih, ihh, ihh);
+      }
+    }
+
     for (UInt_t ih = 2; ih < kNH; ih++) {
       corr[ih][1] = TwoGap(Qa, Qb, ih, ih);
       for (UInt_t ik = 2; ik < nKL; ik++)
         corr[ih][ik] = corr[ih][ik - 1] * corr[ih][1]; // TComplex::Power(corr[ih][1],ik);
       ncorr[ih][1] = corr[ih][1];
-      ncorr[ih][2] = FourGap22(Qa, Qb, ih, ih, ih, ih);
-      ncorr[ih][3] = SixGap33(Qa, Qb, ih, ih, ih, ih, ih, ih);
+      ncorr[ih][2] = twoA[ih][ih] * TComplex::Conjugate(twoB[ih][ih]);     // FourGap22(Qa, Qb, ih, ih, ih, ih)
+      ncorr[ih][3] = threeA[ih][ih] * TComplex::Conjugate(threeB[ih][ih]); // SixGap33(Qa, Qb, ih, ih, ih, ih, ih, ih)
       for (UInt_t ik = 4; ik < nKL; ik++)
         ncorr[ih][ik] = corr[ih][ik]; // for 8,...-particle correlations, ignore the autocorrelation / weight dependency for now
 
       for (UInt_t ihh = 2; ihh < kcNH; ihh++) {
-        ncorr2[ih][1][ihh][1] = FourGap22(Qa, Qb, ih, ihh, ih, ihh);
-        ncorr2[ih][1][ihh][2] = SixGap33(Qa, Qb, ih, ihh, ihh, ih, ihh, ihh);
-        ncorr2[ih][2][ihh][1] = SixGap33(Qa, Qb, ih, ih, ihh, ih, ih, ihh);
+        ncorr2[ih][1][ihh][1] = twoA[ih][ihh] * TComplex::Conjugate(twoB[ih][ihh]);     // FourGap22(Qa, Qb, ih, ihh, ih, ihh)
+        ncorr2[ih][1][ihh][2] = threeA[ih][ihh] * TComplex::Conjugate(threeB[ih][ihh]); // SixGap33(Qa, Qb, ih, ihh, ihh, ih, ihh, ihh)
+        ncorr2[ih][2][ihh][1] = threeA[ihh][ih] * TComplex::Conjugate(threeB[ihh][ih]); // SixGap33(Qa, Qb, ih, ih, ihh, ih, ih, ihh)
         for (UInt_t ik = 2; ik < nKL; ik++)
           for (UInt_t ikk = 2; ikk < nKL; ikk++)
             ncorr2[ih][ik][ihh][ikk] = ncorr[ih][ik] * ncorr[ihh][ikk];
@@ -21,6 +21,7 @@
 
 #include <experimental/type_traits>
 #include <type_traits>
+#include <vector>
 
 template <class Q, UInt_t nh, UInt_t nk>
 class JQVectorsGapBase
@@ -54,16 +55,10 @@ class JQVectors : public std::conditional_t<gap, JQVectorsGapBase<Q, nh, nk>, JQ
   template <class JInputClass>
   inline void Calculate(JInputClass& inputInst, float etamin, float etamax, float massMin = 0.0f, float massMax = 999.9f)
   {
-    // calculate Q-vector for QC method ( no subgroup )
-    for (UInt_t ih = 0; ih < nh; ++ih) {
-      for (UInt_t ik = 0; ik < nk; ++ik) {
-        QvectorQC[ih][ik] = Q(0, 0);
-        if constexpr (gap) {
-          for (UInt_t isub = 0; isub < 2; ++isub)
-            this->QvectorQCgap[isub][ih][ik] = Q(0, 0);
-        }
-      }
-    }
+    // gather the accepted tracks into arrays, the Q-vectors are then built from them
+    trackPhi.clear();
+    trackEta.clear();
+    trackWeight.clear();
     for (auto& track : inputInst) {
       if (track.eta() < -etamax || track.eta() > etamax)
         continue;
@@ -72,28 +67,65 @@ class JQVectors : public std::conditional_t<gap, JQVectorsGapBase<Q, nh, nk>, JQ
         if (track.invMass() < massMin || track.invMass() >= massMax)
           continue;
       }
+      Double_t w = 1.0;
+      if constexpr (std::experimental::is_detected<hasWeightNUA, const JInputClassIter>::value)
+        w /= track.weightNUA();
+      if constexpr (std::experimental::is_detected<hasWeightEff, const JInputClassIter>::value)
+        w *= track.weightEff();
+      trackPhi.push_back(track.phi());
+      trackEta.push_back(track.eta());
+      trackWeight.push_back(w);
+    }
+    Calculate(trackPhi.size(), trackPhi.data(), trackEta.data(), trackWeight.data(), etamin);
+  }
 
-      UInt_t isub = (UInt_t)(track.eta() > 0.0);
+  // Q-vectors from struct-of-arrays input: Q_{h,k} = sum w^k exp(i h phi). The tracks are assumed to be inside the
+  // eta acceptance, etamin is the half-width of the gap between the two subevents. The harmonics of each track are
+  // obtained with the complex recurrence exp(i h phi) = exp(i (h-1) phi) exp(i phi), and the powers of the weight
+  // with running multiplication, so there are two trigonometric calls per track.
+  inline void Calculate(UInt_t ntracks, const Double_t* phi, const Double_t* eta, const Double_t* weight, float etamin)
+  {
+    for (UInt_t ih = 0; ih < nh; ++ih) {
+      for (UInt_t ik = 0; ik < nk; ++ik) {
+        QvectorQC[ih][ik] = Q(0, 0);
+        if constexpr (gap) {
+          for (UInt_t isub = 0; isub < 2; ++isub)
+            this->QvectorQCgap[isub][ih][ik] = Q(0, 0);
+        }
+      }
+    }
+    Double_t tf[nk];
+    for (UInt_t i = 0; i < ntracks; ++i) {
+      tf[0] = 1.0;
+      for (UInt_t ik = 1; ik < nk; ++ik)
+        tf[ik] = tf[ik - 1] * weight[i];
+      const bool inSub = gap && TMath::Abs(eta[i]) > etamin;
+      const UInt_t isub = (UInt_t)(eta[i] > 0.0);
+      const Double_t c1 = TMath::Cos(phi[i]);
+      const Double_t s1 = TMath::Sin(phi[i]);
+      Double_t c = 1.0, s = 0.0; // cos(ih phi), sin(ih phi)
       for (UInt_t ih = 0; ih < nh; ++ih) {
-        Double_t tf = 1.0;
         for (UInt_t ik = 0; ik < nk; ++ik) {
-          Q q(tf * TMath::Cos(ih * track.phi()), tf * TMath::Sin(ih * track.phi()));
+          Q q(tf[ik] * c, tf[ik] * s);
           QvectorQC[ih][ik] += q;
-
           if constexpr (gap) {
-            if (TMath::Abs(track.eta()) > etamin)
+            if (inSub)
               this->QvectorQCgap[isub][ih][ik] += q;
           }
-
-          if constexpr (std::experimental::is_detected<hasWeightNUA, const JInputClassIter>::value)
-            tf /= track.weightNUA();
-          if constexpr (std::experimental::is_detected<hasWeightEff, const JInputClassIter>::value)
-            tf *= track.weightEff();
         }
+        const Double_t cn = c * c1 - s * s1;
+        s = s * c1 + c * s1;
+        c = cn;
       }
     }
   }
+
   Q QvectorQC[nh][nk];
+
+ private:
+  std::vector<Double_t> trackPhi;    // azimuthal angles of the tracks accepted in the last Calculate call
+  std::vector<Double_t> trackEta;    // pseudorapidities of the same tracks
+  std::vector<Double_t> trackWeight; // efficiency weight / NUA weight of the same tracks
 };
 
 #endif // PWGCF_JCORRAN_CORE_JQVECTORS_H_
@@ -299,11 +299,16 @@ struct JEPFlowAnalysis {
 
     auto ft0 = coll.foundFT0();
     TComplex qVecFT0C(0., 0.);
+    const int iMode = helperEP.GetHarmonicIndex(nMode);
 
     for (std::size_t iChC = 0; iChC < ft0.channelC().size(); ++iChC) {
       int ft0CChId = ft0.channelC()[iChC] + 96;
       float ampl = ft0.amplitudeC()[iChC] / (cfgGainEq ? ft0RelGainConst[ft0CChId] : 1.);
-      helperEP.SumQvectors(0, ft0CChId, ampl, nMode, qVecFT0C, ampFT0C, ft0geom, fv0geom);
+      if (iMode >= 0) {
+        helperEP.SumQvectorsFromTable(0, ft0CChId, ampl, iMode, qVecFT0C, ampFT0C);
+      } else {
+        helperEP.SumQvectors(0, ft0CChId, ampl, nMode, qVecFT0C, ampFT0C, ft0geom, fv0geom);
+      }
     }
 
     return qVecFT0C.Rho();
@@ -559,6 +564,8 @@ struct JEPFlowAnalysis {
 
     fv0geom = o2::fv0::Geometry::instance(o2::fv0::Geometry::eUninitialized);
     ft0geom.calculateChannelCenter();
+    // the offsets of the helper are never changed, the channel angles of the raw FT0C q-vector are computed once
+    helperEP.SetChannelHarmonics({2}, ft0geom, fv0geom);
 
     detId = getdetId(cfgDetName);
     refAId = getdetId(cfgRefAName);
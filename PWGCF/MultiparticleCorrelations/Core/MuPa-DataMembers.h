@@ -16,6 +16,8 @@
 #ifndef PWGCF_MULTIPARTICLECORRELATIONS_CORE_MUPA_DATAMEMBERS_H_
 #define PWGCF_MULTIPARTICLECORRELATIONS_CORE_MUPA_DATAMEMBERS_H_
 
+#include <complex>
+#include <limits>
 #include <vector>
 
 // General remarks:
@@ -120,10 +122,12 @@ struct EventByEventQuantities {
 // *) Particle-by-particle quantities:
 //    Remark: Here I define all particle quantities, that I need across several member functions.
 struct ParticleByParticleQuantities {
-  double fPhi = 0.;      // azimuthal angle
-  double fPt = 0.;       // transverse momentum
-  double fEta = 0.;      // pseudorapidity
-  double fCharge = -44.; // particle charge. Yes, never initialize charge to 0.
+  double fPhi = 0.;                                                // azimuthal angle
+  double fPt = 0.;                                                 // transverse momentum
+  double fEta = 0.;                                                // pseudorapidity
+  double fCharge = -44.;                                           // particle charge. Yes, never initialize charge to 0.
+  std::complex<double> fPhases[gMaxHarmonic * gMaxCorrelator + 1]; // exp(i*h*fPhi) for all harmonics h, calculated once per particle in Phases()
+  double fPhasesPhi = std::numeric_limits<double>::quiet_NaN();    // fPhi for which fPhases were calculated
 } pbyp;
 
 // *) QA:
@@ -293,6 +297,7 @@ struct Qvector {
   // std::vector<std::vector<std::complex<double>>> fQ; // generic Q-vector
   TComplex fQvector[gMaxHarmonic * gMaxCorrelator + 1][gMaxCorrelator + 1] = {{TComplex(0., 0.)}}; //! integrated Q-vector, legacy code (TBI 20250718 remove, and switch to line below eventually)
   // std::vector<std::vector<std::complex<double>>> fQvector; // dynamically allocated integrated Q-vector => it has to be done this way, to optimize memory usage
+  o2::analysis::mupa::CorrelatorCalculator fCorrelators; //! 7p and higher correlators from the generic Q-vector, with cache. Cleared whenever fQ is re-filled
 
   bool fCalculateqvectorsKineAny = false;                              // by default, it's off. It's set to true automatically if any of kine correlators is requested,
                                                                        // either for Correlations, Test0, EtaSeparations, etc.
@@ -345,8 +350,12 @@ struct ParticleWeights {
   bool fUseDiffEtaWeights[eDiffEtaWeights_N] = {false};          // use differential eta weights, see enum eDiffEtaWeights for supported dimensions
   bool fUseDiffChargeWeights[eDiffChargeWeights_N] = {false};    // use differential charge weights, see enum eDiffChargeWeights for supported dimensions
   // ...
-  int fDWdimension[eDiffWeightCategory_N] = {0};           // dimension of differential weight for each category in current analysis
-  TArrayD* fFindBinVector[eDiffWeightCategory_N] = {NULL}; // this is the vector I use to find bin when I obtain weights with sparse histograms
+  int fDWdimension[eDiffWeightCategory_N] = {0};                  // dimension of differential weight for each category in current analysis
+  TArrayD* fFindBinVector[eDiffWeightCategory_N] = {NULL};        // this is the vector I use to find bin when I obtain weights with sparse histograms
+  std::vector<float> fDiffWeightsGrid[eDiffWeightCategory_N];     // dense copy of fDiffWeightsSparse (under- and overflow included), booked in BookDiffWeightsGrid() if it is small enough
+  std::vector<int> fDiffWeightsGridStride[eDiffWeightCategory_N]; // stride of each axis in fDiffWeightsGrid
+  std::vector<double> fLastFindBinVector[eDiffWeightCategory_N];  // content of fFindBinVector for which fLastWeightFromSparse was fetched
+  double fLastWeightFromSparse[eDiffWeightCategory_N] = {0.};     // last weight fetched in WeightFromSparse(), the same particle asks for it for each differential q-vector
 
   TString fFileWithWeights = "";           // path to external ROOT file which holds all particle weights
   bool fParticleWeightsAreFetched = false; // ensures that particle weights are fetched only once
@@ -23,5 +23,6 @@ const int gMaxNoBinsKine = 1000;           // max number of bins for differentia
 const int gMaxBinsDiffWeights = 100;       // max number of bins for differential weights, see MakeWeights.C
 const int gMaxNumberEtaSeparations = 9;    // max number of different eta separations used to calculated 2p corr. with eta separations
 const int gMaxNumberSparseDimensions = 10; // max number of dimensions in sparse histograms
+const int gMaxDiffWeightsGridBins = 1 << 22; // max number of bins (under- and overflow included) for which differential weights are copied from sparse into a dense grid
 
 #endif // PWGCF_MULTIPARTICLECORRELATIONS_CORE_MUPA_GLOBALCONSTANTS_H_
@@ -17,6 +17,9 @@
 #define PWGCF_MULTIPARTICLECORRELATIONS_CORE_MUPA_MEMBERFUNCTIONS_H_
 
 // ...
+#include <algorithm>
+#include <complex>
+#include <cstdint>
 #include <string>
 #include <vector>
 
@@ -12840,6 +12843,7 @@ void CalculateKineTest0Ndim(eqvectorKine kineVarChoice, int Ndim)
         qv.fQ[h][wp] = TComplex(qv.fqvector[kineVarChoice][b][h][wp].real(), qv.fqvector[kineVarChoice][b][h][wp].imag()); // TBI 20250601 check if there is a simpler way to initialize ROOT TComplex with C++ type 'complex'
       }
     }
+    qv.fCorrelators.clear(); // the cached correlators were calculated from the Q-vector of the previous bin
 
     // TBI 20250702 Do I need to do some separate insanity check for the case when Q is identically 0?
     //              Most likely not, as all such cases shall already be covered with previous two checks above.
@@ -14065,7 +14069,7 @@ TComplex Seven(int n1, int n2, int n3, int n4, int n5, int n6, int n7)
 
   int harmonic[7] = {n1, n2, n3, n4, n5, n6, n7};
 
-  TComplex seven = Recursion(7, harmonic);
+  TComplex seven = Correlator(7, harmonic);
 
   return seven;
 
@@ -14079,7 +14083,7 @@ TComplex Eight(int n1, int n2, int n3, int n4, int n5, int n6, int n7, int n8)
 
   int harmonic[8] = {n1, n2, n3, n4, n5, n6, n7, n8};
 
-  TComplex eight = Recursion(8, harmonic);
+  TComplex eight = Correlator(8, harmonic);
 
   return eight;
 
@@ -14093,7 +14097,7 @@ TComplex Nine(int n1, int n2, int n3, int n4, int n5, int n6, int n7, int n8, in
 
   int harmonic[9] = {n1, n2, n3, n4, n5, n6, n7, n8, n9};
 
-  TComplex nine = Recursion(9, harmonic);
+  TComplex nine = Correlator(9, harmonic);
 
   return nine;
 
@@ -14107,7 +14111,7 @@ TComplex Ten(int n1, int n2, int n3, int n4, int n5, int n6, int n7, int n8, int
 
   int harmonic[10] = {n1, n2, n3, n4, n5, n6, n7, n8, n9, n10};
 
-  TComplex ten = Recursion(10, harmonic);
+  TComplex ten = Correlator(10, harmonic);
 
   return ten;
 
@@ -14121,7 +14125,7 @@ TComplex Eleven(int n1, int n2, int n3, int n4, int n5, int n6, int n7, int n8,
 
   int harmonic[11] = {n1, n2, n3, n4, n5, n6, n7, n8, n9, n10, n11};
 
-  TComplex eleven = Recursion(11, harmonic);
+  TComplex eleven = Correlator(11, harmonic);
 
   return eleven;
 
@@ -14135,7 +14139,7 @@ TComplex Twelve(int n1, int n2, int n3, int n4, int n5, int n6, int n7, int n8,
 
   int harmonic[12] = {n1, n2, n3, n4, n5, n6, n7, n8, n9, n10, n11, n12};
 
-  TComplex twelve = Recursion(12, harmonic);
+  TComplex twelve = Correlator(12, harmonic);
 
   return twelve;
 
@@ -14143,6 +14147,18 @@ TComplex Twelve(int n1, int n2, int n3, int n4, int n5, int n6, int n7, int n8,
 
 //============================================================
 
+TComplex Correlator(int n, int* harmonic)
+{
+  // Generic n-particle correlator, same as Recursion(n, harmonic), without recursion.
+  // It is calculated with subset-sum dynamic programming in the MuPaCore library, see MuPa-QvectorKernels.cxx,
+  // and the results are kept for the current generic Q-vector.
+
+  return qv.fCorrelators.correlator(n, harmonic, qv.fQ);
+
+} // TComplex Correlator(int n, int* harmonic)
+
+//============================================================
+
 TComplex Recursion(int n, int* harmonic, int mult = 1, int skip = 0)
 {
   // Calculate multi-particle correlators by using recursion (an improved faster version) originally developed by
@@ -14200,6 +14216,7 @@ void ResetQ()
       qv.fQ[h][wp] = TComplex(0., 0.);
     }
   }
+  qv.fCorrelators.clear();
 
   if (tc.fVerbose) {
     ExitFunction(__FUNCTION__);
@@ -14320,6 +14337,10 @@ void SetDiffWeightsSparse(THnSparseF* const sparse, eDiffWeightCategory dwc)
 
   // I book here immediately vectors needed to fetch the weight from the right bin of THnSparse:
   pw.fFindBinVector[dwc] = new TArrayD(pw.fDWdimension[dwc]);
+  pw.fLastFindBinVector[dwc].clear(); // weights have changed, nothing is cached any longer
+
+  // Dimensions of weights are small and known, so whenever possible I copy the sparse into a dense grid:
+  BookDiffWeightsGrid(dwc);
 
   // Finally, add to corresponding TList:
   pw.fWeightsList->Add(pw.fDiffWeightsSparse[dwc]);
@@ -14332,6 +14353,55 @@ void SetDiffWeightsSparse(THnSparseF* const sparse, eDiffWeightCategory dwc)
 
 //============================================================
 
+void BookDiffWeightsGrid(eDiffWeightCategory dwc)
+{
+  // Copy sparse histogram with differential weights for this category into a dense grid, so that in WeightFromSparse()
+  // the weight is fetched with one array look-up, instead of hash-based bin look-up in THnSparse.
+  // Global bins of the grid are linearized in the same way as in THnSparse, i.e. underflow and overflow are included for each dimension.
+  // If the grid would have more than gMaxDiffWeightsGridBins bins, weights are fetched from sparse histogram directly, as before.
+
+  if (tc.fVerbose) {
+    StartFunction(__FUNCTION__);
+  }
+
+  pw.fDiffWeightsGrid[dwc].clear();
+  pw.fDiffWeightsGridStride[dwc].assign(pw.fDWdimension[dwc], 0);
+
+  // *) Determine strides and total number of bins:
+  int64_t nBins = 1;
+  for (int d = pw.fDWdimension[dwc] - 1; d >= 0; d--) {
+    pw.fDiffWeightsGridStride[dwc][d] = static_cast<int>(nBins);
+    nBins *= pw.fDiffWeightsSparse[dwc]->GetAxis(d)->GetNbins() + 2; // +2 for underflow and overflow
+    if (nBins > gMaxDiffWeightsGridBins) {
+      LOGF(info, "\033[1;33m%s at line %d : sparse %s has more than %d bins, weights are fetched from it directly\033[0m", __FUNCTION__, __LINE__, pw.fDiffWeightsSparse[dwc]->GetName(), gMaxDiffWeightsGridBins);
+      pw.fDiffWeightsGridStride[dwc].clear();
+      if (tc.fVerbose) {
+        ExitFunction(__FUNCTION__);
+      }
+      return;
+    }
+  }
+
+  // *) Copy all filled bins. Bins not filled in sparse remain 0, as GetBinContent(...) returns for them:
+  pw.fDiffWeightsGrid[dwc].assign(nBins, 0.f);
+  std::vector<int> coordinates(pw.fDWdimension[dwc]);
+  for (int64_t b = 0; b < pw.fDiffWeightsSparse[dwc]->GetNbins(); b++) {
+    float content = pw.fDiffWeightsSparse[dwc]->GetBinContent(b, coordinates.data());
+    int64_t index = 0;
+    for (int d = 0; d < pw.fDWdimension[dwc]; d++) {
+      index += static_cast<int64_t>(coordinates[d]) * pw.fDiffWeightsGridStride[dwc][d];
+    }
+    pw.fDiffWeightsGrid[dwc][index] = content;
+  }
+
+  if (tc.fVerbose) {
+    ExitFunction(__FUNCTION__);
+  }
+
+} // void BookDiffWeightsGrid(eDiffWeightCategory dwc)
+
+//============================================================
+
 void insanitizeDiffWeightsSparse(THnSparseF* const sparse)
 {
   // Check if particle weights are avaiable for the phase window I have selected for each dimension with cuts.
@@ -16149,8 +16219,32 @@ double WeightFromSparse(eDiffWeightCategory dwc)
     }
   } // if(tc.fInsanityCheckForEachParticle)
 
-  // *) okay, let's fetch the weight:
-  int bin = pw.fDiffWeightsSparse[dwc]->GetBin(pw.fFindBinVector[dwc]->GetArray()); // this is the general bin, corresponding to the actual multidimensional bin
+  // *) The same particle asks for the same weight for each differential q-vector, so I fetch it only if the values have changed:
+  const double* values = pw.fFindBinVector[dwc]->GetArray();
+  const int nValues = pw.fFindBinVector[dwc]->GetSize();
+  if (std::equal(values, values + nValues, pw.fLastFindBinVector[dwc].begin(), pw.fLastFindBinVector[dwc].end())) {
+    if (tc.fVerbose) {
+      ExitFunction(__FUNCTION__);
+    }
+    return pw.fLastWeightFromSparse[dwc];
+  }
+
+  // *) If available, fetch the weight from the dense grid (see BookDiffWeightsGrid()):
+  if (!pw.fDiffWeightsGrid[dwc].empty()) {
+    int64_t index = 0;
+    for (int d = 0; d < nValues; d++) {
+      index += static_cast<int64_t>(pw.fDiffWeightsSparse[dwc]->GetAxis(d)->FindFixBin(values[d])) * pw.fDiffWeightsGridStride[dwc][d];
+    }
+    pw.fLastFindBinVector[dwc].assign(values, values + nValues);
+    pw.fLastWeightFromSparse[dwc] = pw.fDiffWeightsGrid[dwc][index];
+    if (tc.fVerbose) {
+      ExitFunction(__FUNCTION__);
+    }
+    return pw.fLastWeightFromSparse[dwc];
+  }
+
+  // *) okay, let's fetch the weight from sparse. Bins which are not filled are not allocated, their content is 0:
+  Long64_t bin = pw.fDiffWeightsSparse[dwc]->GetBin(values, kFALSE); // this is the general bin, corresponding to the actual multidimensional bin
   // TBI 20250224 do I need some insanity check here, e.g. that bin is neither in overflow nor in underflow?
   //              If I decide to implement this, remember e.g. for 2D case that all bins of type (0,1), (0,2) ... are underflow of first variable,
   //              and all bins of type (1,0), (2,0), ... are underflow of second variable. Analogously for overflow.
@@ -16170,7 +16264,9 @@ double WeightFromSparse(eDiffWeightCategory dwc)
   //              So, for 2 x 3 histogram, there are (2+2) * (3+2) = 20 linearized global bins, indexed from 0 to 19.
   //              Remember that I need to loop first over y dimension, then nest inside the loop over x dimension, to achieve loop over global bins in consequtive order. Yes!
 
-  double weight = pw.fDiffWeightsSparse[dwc]->GetBinContent(bin);
+  double weight = bin < 0 ? 0. : pw.fDiffWeightsSparse[dwc]->GetBinContent(bin);
+  pw.fLastFindBinVector[dwc].assign(values, values + nValues);
+  pw.fLastWeightFromSparse[dwc] = weight;
 
   if (tc.fVerbose) {
     ExitFunction(__FUNCTION__);
@@ -16182,6 +16278,22 @@ double WeightFromSparse(eDiffWeightCategory dwc)
 
 //============================================================
 
+const std::complex<double>* Phases()
+{
+  // Return exp(i*h*phi) of the current particle for all harmonics h = 0, ..., gMaxHarmonic * gMaxCorrelator.
+  // They are calculated only once per particle, and then shared in all integrated and differential Q-vectors which this particle fills.
+
+  if (!(pbyp.fPhasesPhi == pbyp.fPhi)) { // yes, fPhasesPhi is initialized to NaN
+    o2::analysis::mupa::calculatePhases(pbyp.fPhi, pbyp.fPhases);
+    pbyp.fPhasesPhi = pbyp.fPhi;
+  }
+
+  return pbyp.fPhases;
+
+} // const std::complex<double>* Phases()
+
+//============================================================
+
 double DiffWeight(const double& valueY, const double& valueX, eqvectorKine variableX)
 {
   // !!! OBSOLETE FUNCTION !!!
@@ -18494,7 +18606,6 @@ void FillQvectorFromSparse()
   double wPt = 1.;       // differential multidimensional pt weight, its dimensions are defined via enum eDiffPtWeights
   double wEta = 1.;      // differential multidimensional eta weight, its dimensions are defined via enum eDiffEtaWeights
   double wCharge = 1.;   // differential multidimensional charge weight, its dimensions are defined via enum eDiffChargeWeights
-  double wToPowerP = 1.; // weight raised to power p
 
   // *) Multidimensional phi weights:
   if (pw.fUseDiffPhiWeights[wPhiPhiAxis]) { // yes, 0th axis serves as a common boolean for this category
@@ -18579,20 +18690,13 @@ void FillQvectorFromSparse()
   } // if(pw.fUseDiffChargeWeights[wChargeChargeAxis])
 
   if (qv.fCalculateQvectors) {
-    for (int h = 0; h < gMaxHarmonic * gMaxCorrelator + 1; h++) {
-      for (int wp = 0; wp < gMaxCorrelator + 1; wp++) { // weight power
-        if (pw.fUseDiffPhiWeights[wPhiPhiAxis] || pw.fUseDiffPtWeights[wPtPtAxis] || pw.fUseDiffEtaWeights[wEtaEtaAxis] || pw.fUseDiffChargeWeights[wChargeChargeAxis]) {
-          wToPowerP = std::pow(wPhi * wPt * wEta * wCharge, wp);
-          qv.fQvector[h][wp] += TComplex(wToPowerP * std::cos(h * pbyp.fPhi), wToPowerP * std::sin(h * pbyp.fPhi)); // Q-vector with weights, legacy code (TBI 20251027 remove this line)
-          // qv.fQvector[h][wp] += std::complex<double>(wToPowerP * std::cos(h * pbyp.fPhi), wToPowerP * std::sin(h * pbyp.fPhi)); // Q-vector with weights, new code
-          // TBI 20251028 I have to keep it this way for the time being, otherwise I have to change all over the place, e.g. in TComplex Q(int n, int wp), etc.
-        } else {
-          qv.fQvector[h][wp] += TComplex(std::cos(h * pbyp.fPhi), std::sin(h * pbyp.fPhi)); // bare Q-vector without weights, legacy code (TBI 20251027 remove this line)
-          // qv.fQvector[h][wp] += std::complex<double>(std::cos(h * pbyp.fPhi), std::sin(h * pbyp.fPhi)); // bare Q-vector without weights, new code
-          // TBI 20251028 I have to keep it this way for the time being, otherwise I have to change all over the place, e.g. in TComplex Q(int n, int wp), etc.
-        }
-      } // for(int wp=0;wp<gMaxCorrelator+1;wp++)
-    } // for(int h=0;h<gMaxHarmonic*gMaxCorrelator+1;h++)
+    // Fill loops are compiled in the MuPaCore library, with and without weights, see MuPa-QvectorKernels.cxx.
+    // Phases are calculated only once per particle (see Phases()).
+    if (pw.fUseDiffPhiWeights[wPhiPhiAxis] || pw.fUseDiffPtWeights[wPtPtAxis] || pw.fUseDiffEtaWeights[wEtaEtaAxis] || pw.fUseDiffChargeWeights[wChargeChargeAxis]) {
+      o2::analysis::mupa::fillQvector<true>(qv.fQvector, Phases(), wPhi * wPt * wEta * wCharge); // Q-vector with weights
+    } else {
+      o2::analysis::mupa::fillQvector<false>(qv.fQvector, Phases(), 1.); // bare Q-vector without weights
+    }
   } // if (qv.fCalculateQvectors) {
 
   if (es.fCalculateEtaSeparations) { // yes, I can decouple this one from if (qv.fCalculateQvectors)
@@ -19529,18 +19633,13 @@ void FillqvectorFromSparse(const eqvectorKine& kineVarChoice, const int& bin, co
   }
 
   // *) Finally, fill differential q-vector in that linearized "global bin":
-  double wToPowerP = 1.; // weight raised to power p
-
-  for (int h = 0; h < gMaxHarmonic * gMaxCorrelator + 1; h++) {
-    for (int wp = 0; wp < gMaxCorrelator + 1; wp++) {                                                                                                                   // weight power
-      if (pw.fUseDiffPhiWeights[wPhiPhiAxis] || pw.fUseDiffPtWeights[wPtPtAxis] || pw.fUseDiffEtaWeights[wEtaEtaAxis] || pw.fUseDiffChargeWeights[wChargeChargeAxis]) { // yes, because the first enum serves as a boolean for that category
-        wToPowerP = std::pow(dWeight, wp);                                                                                                                              // dWeight = wPhi * wPt * wEta * wcharge
-        qv.fqvector[kineVarChoice][bin][h][wp] += std::complex<double>(wToPowerP * std::cos(h * pbyp.fPhi), wToPowerP * std::sin(h * pbyp.fPhi));                       // q-vector with weights
-      } else {
-        qv.fqvector[kineVarChoice][bin][h][wp] += std::complex<double>(std::cos(h * pbyp.fPhi), std::sin(h * pbyp.fPhi)); // bare q-vector without weights
-      }
-    } // for(int wp=0;wp<gMaxCorrelator+1;wp++)
-  } // for (int h = 0; h < gMaxHarmonic * gMaxCorrelator + 1; h++)
+  //    Fill loops are compiled in the MuPaCore library, with and without weights, see MuPa-QvectorKernels.cxx.
+  //    Phases are shared with all other Q- and q-vectors of this particle (see Phases()).
+  if (pw.fUseDiffPhiWeights[wPhiPhiAxis] || pw.fUseDiffPtWeights[wPtPtAxis] || pw.fUseDiffEtaWeights[wEtaEtaAxis] || pw.fUseDiffChargeWeights[wChargeChargeAxis]) { // yes, because the first enum serves as a boolean for that category
+    o2::analysis::mupa::fillQvector<true>(qv.fqvector[kineVarChoice][bin], Phases(), dWeight); // q-vector with weights, dWeight = wPhi * wPt * wEta * wCharge
+  } else {
+    o2::analysis::mupa::fillQvector<false>(qv.fqvector[kineVarChoice][bin], Phases(), 1.); // bare q-vector without weights
+  }
 
   // *) Differential nested loops:
   if (nl.fCalculateKineCustomNestedLoops) {
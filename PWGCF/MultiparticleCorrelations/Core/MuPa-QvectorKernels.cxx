@@ -0,0 +1,147 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file MuPa-QvectorKernels.cxx
+/// \brief Per-particle Q-vector filling and multiparticle correlators, compiled once in the MuPaCore library
+
+#include "PWGCF/MultiparticleCorrelations/Core/MuPa-QvectorKernels.h"
+
+#include <TComplex.h>
+
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <utility>
+#include <vector>
+
+namespace o2::analysis::mupa
+{
+
+void calculatePhases(double phi, std::complex<double>* phases)
+{
+  for (int h = 0; h < MaxHarmonicQ; h++) {
+    phases[h] = std::complex<double>(std::cos(h * phi), std::sin(h * phi));
+  }
+}
+
+namespace
+{
+// w^p by running multiplication
+inline void calculateWeightPowers(double weight, double* powers)
+{
+  powers[0] = 1.;
+  for (int wp = 1; wp < MaxPowerQ; wp++) {
+    powers[wp] = powers[wp - 1] * weight;
+  }
+}
+} // namespace
+
+template <bool Weighted>
+void fillQvector(TComplex (*qvector)[MaxPowerQ], const std::complex<double>* phases, double weight)
+{
+  if constexpr (Weighted) {
+    double powers[MaxPowerQ];
+    calculateWeightPowers(weight, powers);
+    for (int h = 0; h < MaxHarmonicQ; h++) {
+      for (int wp = 0; wp < MaxPowerQ; wp++) {
+        qvector[h][wp] += TComplex(powers[wp] * phases[h].real(), powers[wp] * phases[h].imag());
+      }
+    }
+  } else {
+    for (int h = 0; h < MaxHarmonicQ; h++) {
+      const TComplex phase(phases[h].real(), phases[h].imag());
+      for (int wp = 0; wp < MaxPowerQ; wp++) {
+        qvector[h][wp] += phase;
+      }
+    }
+  }
+}
+
+template <bool Weighted>
+void fillQvector(std::vector<std::vector<std::complex<double>>>& qvector, const std::complex<double>* phases, double weight)
+{
+  if constexpr (Weighted) {
+    double powers[MaxPowerQ];
+    calculateWeightPowers(weight, powers);
+    for (int h = 0; h < MaxHarmonicQ; h++) {
+      std::complex<double>* qh = qvector[h].data();
+      for (int wp = 0; wp < MaxPowerQ; wp++) {
+        qh[wp] += powers[wp] * phases[h];
+      }
+    }
+  } else {
+    for (int h = 0; h < MaxHarmonicQ; h++) {
+      std::complex<double>* qh = qvector[h].data();
+      for (int wp = 0; wp < MaxPowerQ; wp++) {
+        qh[wp] += phases[h];
+      }
+    }
+  }
+}
+
+template void fillQvector<true>(TComplex (*)[MaxPowerQ], const std::complex<double>*, double);
+template void fillQvector<false>(TComplex (*)[MaxPowerQ], const std::complex<double>*, double);
+template void fillQvector<true>(std::vector<std::vector<std::complex<double>>>&, const std::complex<double>*, double);
+template void fillQvector<false>(std::vector<std::vector<std::complex<double>>>&, const std::complex<double>*, double);
+
+// The correlator is the sum over all partitions of the n particles into blocks, and a block B of size k
+// contributes (-1)^(k-1) (k-1)! Q(sum of harmonics in B, k). For each subset S of particles, the sum over
+// the partitions of S is built from the smaller subsets, taking first the block which contains the lowest
+// particle of S, so that each partition is counted once (subset-sum dynamic programming, 3^n operations).
+// The correlator is symmetric in the harmonics, so the results are kept for the current Q-vector, keyed with
+// the sorted harmonics, e.g. the weight with all harmonics set to 0 is calculated once, not for each correlator.
+TComplex CorrelatorCalculator::correlator(int n, const int* harmonic, const TComplex (*q)[MaxPowerQ])
+{
+  std::vector<int> key(harmonic, harmonic + n);
+  std::sort(key.begin(), key.end());
+  auto cached = mCache.find(key);
+  if (cached != mCache.end()) {
+    return cached->second;
+  }
+
+  const int nSubsets = 1 << n;
+  mBlocks.resize(nSubsets);
+  mPartitions.resize(nSubsets);
+  int harmonicSum[1 << gMaxCorrelator] = {0};
+  int blockSize[1 << gMaxCorrelator] = {0};
+  double coefficient[gMaxCorrelator + 1] = {0., 1.}; // (-1)^(k-1) (k-1)!
+  for (int k = 2; k <= n; k++) {
+    coefficient[k] = -(k - 1) * coefficient[k - 1];
+  }
+  for (int subset = 1; subset < nSubsets; subset++) {
+    const int lowest = subset & -subset;
+    harmonicSum[subset] = harmonicSum[subset ^ lowest] + harmonic[__builtin_ctz(lowest)];
+    blockSize[subset] = blockSize[subset ^ lowest] + 1;
+    const int h = harmonicSum[subset];
+    const TComplex& qh = q[h >= 0 ? h : -h][blockSize[subset]]; // Q{-n,p} = Q{n,p}^*
+    mBlocks[subset] = coefficient[blockSize[subset]] * std::complex<double>(qh.Re(), h >= 0 ? qh.Im() : -qh.Im());
+  }
+
+  mPartitions[0] = 1.;
+  for (int subset = 1; subset < nSubsets; subset++) {
+    const int lowest = subset & -subset;
+    const int rest = subset ^ lowest;
+    std::complex<double> sum = 0.;
+    for (int others = rest;; others = (others - 1) & rest) { // block = lowest + others, loop over all subsets of rest
+      sum += mBlocks[others | lowest] * mPartitions[rest ^ others];
+      if (others == 0) {
+        break;
+      }
+    }
+    mPartitions[subset] = sum;
+  }
+
+  const TComplex correlator(mPartitions[nSubsets - 1].real(), mPartitions[nSubsets - 1].imag());
+  mCache.emplace(std::move(key), correlator);
+  return correlator;
+}
+
+} // namespace o2::analysis::mupa
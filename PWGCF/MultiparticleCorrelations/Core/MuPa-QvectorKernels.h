@@ -0,0 +1,65 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file MuPa-QvectorKernels.h
+/// \brief Per-particle Q-vector filling and multiparticle correlators, compiled once in the MuPaCore library
+
+#ifndef PWGCF_MULTIPARTICLECORRELATIONS_CORE_MUPA_QVECTORKERNELS_H_
+#define PWGCF_MULTIPARTICLECORRELATIONS_CORE_MUPA_QVECTORKERNELS_H_
+
+#include "PWGCF/MultiparticleCorrelations/Core/MuPa-GlobalConstants.h"
+
+#include <TComplex.h>
+
+#include <complex>
+#include <map>
+#include <vector>
+
+// The member functions in MuPa-MemberFunctions.h are compiled with the task, as part of its struct. The loops
+// which run for each particle and for each correlator are kept here instead, in small functions which are compiled
+// only once, and whether the particle weights are used is a template parameter, so the unweighted fills have no
+// weight arithmetic at all. The templates are instantiated for both cases in MuPa-QvectorKernels.cxx.
+namespace o2::analysis::mupa
+{
+
+constexpr int MaxHarmonicQ = gMaxHarmonic * gMaxCorrelator + 1; // number of harmonics in Q-vectors
+constexpr int MaxPowerQ = gMaxCorrelator + 1;                    // number of weight powers in Q-vectors
+
+/// exp(i*h*phi) for h = 0, ..., MaxHarmonicQ - 1
+void calculatePhases(double phi, std::complex<double>* phases);
+
+/// Q_{h,p} += w^p exp(i*h*phi) for all harmonics and weight powers of the integrated Q-vector
+template <bool Weighted>
+void fillQvector(TComplex (*qvector)[MaxPowerQ], const std::complex<double>* phases, double weight);
+
+/// the same for the differential q-vector of one kine bin
+template <bool Weighted>
+void fillQvector(std::vector<std::vector<std::complex<double>>>& qvector, const std::complex<double>* phases, double weight);
+
+/// Generic n-particle correlators from the generic Q-vector, see MuPa-QvectorKernels.cxx
+class CorrelatorCalculator
+{
+ public:
+  /// same as Recursion(n, harmonic) of the task, the harmonics are not modified
+  TComplex correlator(int n, const int* harmonic, const TComplex (*q)[MaxPowerQ]);
+
+  /// the cached correlators are valid only for the Q-vector they were calculated from
+  void clear() { mCache.clear(); }
+
+ private:
+  std::map<std::vector<int>, TComplex> mCache;   // correlators already calculated from the current Q-vector, the key is the sorted list of harmonics
+  std::vector<std::complex<double>> mBlocks;     // the term of each subset of particles
+  std::vector<std::complex<double>> mPartitions; // the sum over the partitions of each subset of particles
+};
+
+} // namespace o2::analysis::mupa
+
+#endif // PWGCF_MULTIPARTICLECORRELATIONS_CORE_MUPA_QVECTORKERNELS_H_
@@ -107,6 +107,9 @@ using namespace std;
 // *) Global constants:
 #include "PWGCF/MultiparticleCorrelations/Core/MuPa-GlobalConstants.h"
 
+// *) Q-vector kernels, compiled in the MuPaCore library:
+#include "PWGCF/MultiparticleCorrelations/Core/MuPa-QvectorKernels.h"
+
 // *) Main task:
 struct MultiparticleCorrelationsAB // this name is used in lower-case format to name the TDirectoryFile in AnalysisResults.root
 {
@@ -0,0 +1,174 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file mixingPairs.cxx
+/// \brief Event mixing pairs of the CF derived collisions, worked out once per data frame for all the consumers
+
+#include "PWGCF/DataModel/CorrelationsDerived.h"
+
+#include <Framework/AnalysisDataModel.h>
+#include <Framework/AnalysisHelpers.h>
+#include <Framework/AnalysisTask.h>
+#include <Framework/Configurable.h>
+#include <Framework/HistogramSpec.h>
+#include <Framework/InitContext.h>
+#include <Framework/runDataProcessing.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <utility>
+#include <vector>
+
+using namespace o2;
+using namespace o2::framework;
+using namespace o2::framework::expressions;
+
+#define O2_DEFINE_CONFIGURABLE(NAME, TYPE, DEFAULT, HELP) Configurable<TYPE> NAME{#NAME, DEFAULT, HELP};
+
+// The collisions are binned in vertex and multiplicity. Each collision is mixed with up to cfgNoMixedEvents
+// collisions of its bin: the following ones in the table (as the strictly upper Pair iterator of the tasks does),
+// or with cfgSeed != 0 a random choice among all the other collisions of the bin. The random generator is seeded
+// per collision from cfgSeed, its timestamp and its index, so the same input gives the same pairs in every task.
+// The pairs are written grouped by trigger collision, in the order of the collision table.
+struct MixingPairs {
+  O2_DEFINE_CONFIGURABLE(cfgCutVertex, float, 7.0f, "Accepted z-vertex range")
+  O2_DEFINE_CONFIGURABLE(cfgNoMixedEvents, int, 5, "Number of mixed events per event")
+  O2_DEFINE_CONFIGURABLE(cfgSeed, int, 0, "0 = mix with the following collisions of the bin, otherwise seed of the random choice among the collisions of the bin")
+  O2_DEFINE_CONFIGURABLE(cfgVerbosity, int, 0, "Verbosity level (0 = major, 1 = per data frame)")
+
+  ConfigurableAxis axisVertex{"axisVertex", {7, -7, 7}, "vertex axis for the mixing bins"};
+  ConfigurableAxis axisMultiplicity{"axisMultiplicity", {VARIABLE_WIDTH, 0, 5, 10, 20, 30, 40, 50, 100.1}, "multiplicity / centrality axis for the mixing bins"};
+
+  Produces<aod::CFMixingPairs> mixingPairs;
+
+  Filter collisionZVtxFilter = nabs(aod::collision::posZ) < cfgCutVertex;
+
+  std::vector<double> vertexEdges;
+  std::vector<double> multiplicityEdges;
+  std::vector<std::vector<int>> collisionsPerBin; // global indices, in the order of the table
+  std::vector<std::pair<int, int>> binOfCollision; // per collision of the data frame, bin and position in the bin
+  std::vector<int> partners;
+  std::mt19937 generator;
+
+  static std::vector<double> getEdges(const ConfigurableAxis& axis)
+  {
+    AxisSpec spec{axis, ""};
+    if (!spec.nBins.has_value()) {
+      return spec.binEdges;
+    }
+    std::vector<double> edges(*spec.nBins + 1);
+    for (int i = 0; i <= *spec.nBins; i++) {
+      edges[i] = spec.binEdges.front() + i * (spec.binEdges.back() - spec.binEdges.front()) / *spec.nBins;
+    }
+    return edges;
+  }
+
+  // -1 for the values outside the axis, which are not mixed
+  static int findBin(const std::vector<double>& edges, float x)
+  {
+    if (x < edges.front() || !(x < edges.back())) {
+      return -1;
+    }
+    return std::upper_bound(edges.begin(), edges.end(), x) - edges.begin() - 1;
+  }
+
+  void init(InitContext&)
+  {
+    vertexEdges = getEdges(axisVertex);
+    multiplicityEdges = getEdges(axisMultiplicity);
+    collisionsPerBin.resize((vertexEdges.size() - 1) * (multiplicityEdges.size() - 1));
+    partners.reserve(cfgNoMixedEvents);
+  }
+
+  template <typename TCollision>
+  void fillPartners(const std::vector<int>& collisionsInBin, int position, TCollision const& collision)
+  {
+    partners.clear();
+    const int nCollisions = collisionsInBin.size();
+    if (cfgSeed == 0) {
+      for (int i = position + 1; i < nCollisions && i <= position + cfgNoMixedEvents; i++) {
+        partners.push_back(i);
+      }
+      return;
+    }
+    for (int i = 0; i < nCollisions; i++) {
+      if (i != position) {
+        partners.push_back(i);
+      }
+    }
+    if (static_cast<int>(partners.size()) > cfgNoMixedEvents) {
+      const uint64_t timestamp = collision.timestamp();
+      std::seed_seq seed{static_cast<uint32_t>(cfgSeed), static_cast<uint32_t>(timestamp), static_cast<uint32_t>(timestamp >> 32), static_cast<uint32_t>(collision.globalIndex())};
+      generator.seed(seed);
+      // partial Fisher-Yates shuffle, the first cfgNoMixedEvents entries are the choice
+      for (int i = 0; i < cfgNoMixedEvents; i++) {
+        std::uniform_int_distribution<int> distribution(i, partners.size() - 1);
+        std::swap(partners[i], partners[distribution(generator)]);
+      }
+      partners.resize(cfgNoMixedEvents);
+      std::sort(partners.begin(), partners.end());
+    }
+  }
+
+  void process(soa::Filtered<aod::CFCollisions> const& collisions)
+  {
+    for (auto& collisionsInBin : collisionsPerBin) {
+      collisionsInBin.clear();
+    }
+    binOfCollision.clear();
+    binOfCollision.reserve(collisions.size());
+    const int nMultiplicityBins = multiplicityEdges.size() - 1;
+    for (const auto& collision : collisions) {
+      int binVertex = findBin(vertexEdges, collision.posZ());
+      int binMultiplicity = findBin(multiplicityEdges, collision.multiplicity());
+      if (binVertex < 0 || binMultiplicity < 0) {
+        binOfCollision.emplace_back(-1, -1);
+        continue;
+      }
+      int bin = binVertex * nMultiplicityBins + binMultiplicity;
+      binOfCollision.emplace_back(bin, collisionsPerBin[bin].size());
+      collisionsPerBin[bin].push_back(collision.globalIndex());
+    }
+
+    int64_t nPairs = 0;
+    for (const auto& collisionsInBin : collisionsPerBin) {
+      const int64_t nInBin = collisionsInBin.size();
+      for (int64_t position = 0; position < nInBin; position++) {
+        nPairs += std::min<int64_t>(cfgNoMixedEvents, cfgSeed == 0 ? nInBin - 1 - position : nInBin - 1);
+      }
+    }
+    mixingPairs.reserve(nPairs);
+
+    int iCollision = 0;
+    for (const auto& collision : collisions) {
+      const auto [bin, position] = binOfCollision[iCollision++];
+      if (bin < 0) {
+        continue;
+      }
+      const auto& collisionsInBin = collisionsPerBin[bin];
+      fillPartners(collisionsInBin, position, collision);
+      for (const auto& partner : partners) {
+        mixingPairs(collision.globalIndex(), collisionsInBin[partner], bin, partners.size());
+      }
+    }
+
+    if (cfgVerbosity > 0) {
+      LOGF(info, "MixingPairs: %d collisions, %ld pairs", collisions.size(), nPairs);
+    }
+  }
+};
+
+WorkflowSpec defineDataProcessing(ConfigContext const& cfgc)
+{
+  return WorkflowSpec{
+    adaptAnalysisTask<MixingPairs>(cfgc, TaskName{"correlations-mixing-pairs"})};
+}
@@ -14,7 +14,9 @@
 /// \author Jan Fiete Grosse-Oetringhaus <jan.fiete.grosse-oetringhaus@cern.ch>, Jasper Parkkila <jasper.parkkila@cern.ch>
 
 #include "PWGCF/Core/CorrelationContainer.h"
+#include "PWGCF/Core/EfficiencyGrid.h"
 #include "PWGCF/Core/PairCuts.h"
+#include "PWGCF/Core/PairHistFillPlan.h"
 #include "PWGCF/DataModel/CorrelationsDerived.h"
 
 #include "Common/CCDB/TriggerAliases.h"
@@ -62,6 +64,7 @@
 #include <string>
 #include <tuple>
 #include <type_traits>
+#include <typeinfo>
 #include <unordered_map>
 #include <utility>
 #include <vector>
@@ -103,6 +106,7 @@ struct CorrelationTask {
   O2_DEFINE_CONFIGURABLE(cfgTwoTrackCut, float, -1, "Two track cut: -1 = off; >0 otherwise distance value (suggested: 0.02)");
   O2_DEFINE_CONFIGURABLE(cfgTwoTrackCutMinRadius, float, 0.8f, "Two track cut: radius in m from which two track cuts are applied");
   O2_DEFINE_CONFIGURABLE(cfgLocalEfficiency, int, 0, "0 = OFF and 1 = ON for local efficiency");
+  O2_DEFINE_CONFIGURABLE(cfgEfficiencyGrid, bool, false, "Copy the efficiency histograms into dense grids at load time and reuse the associated efficiencies of an event between the same-event and mixed-event passes");
   O2_DEFINE_CONFIGURABLE(cfgDropStepRECO, bool, false, "choice to drop step RECO if efficiency correction is used")
   O2_DEFINE_CONFIGURABLE(cfgCentBinsForMC, int, 0, "0 = OFF and 1 = ON for data like multiplicity/centrality bins for MC steps");
   O2_DEFINE_CONFIGURABLE(cfgTrackBitMask, uint16_t, 0, "BitMask for track selection systematics; refer to the enum TrackSelectionCuts in filtering task");
@@ -123,6 +127,7 @@ struct CorrelationTask {
   O2_DEFINE_CONFIGURABLE(cfgDecayParticleMask, int, 0, "Selection bitmask for the decay particles: 0 = no selection")
   O2_DEFINE_CONFIGURABLE(cfgV0RapidityMax, float, 0.8, "Maximum rapidity for the decay particles (0 = no selection)")
   O2_DEFINE_CONFIGURABLE(cfgMassAxis, int, 0, "Use invariant mass axis (0 = OFF, 1 = ON)")
+  O2_DEFINE_CONFIGURABLE(cfgPairFillPlan, bool, false, "Bin multiplicity, vertex and trigger pT once per event/trigger when filling the pair histogram (not with mass axes)")
   O2_DEFINE_CONFIGURABLE(cfgMcTriggerPDGs, std::vector<int>, {}, "MC PDG codes to use exclusively as trigger particles and exclude from associated particles. Empty = no selection.")
 
   O2_DEFINE_CONFIGURABLE(cfgPtDepMLbkg, std::vector<float>, {}, "pT interval for ML training")
@@ -170,7 +175,19 @@ struct CorrelationTask {
 
   // persistent caches
   std::vector<float> efficiencyAssociatedCache;
+  const std::vector<float>* efficiencyAssociated = &efficiencyAssociatedCache;
+  struct EfficiencyAssociatedEntry {
+    std::size_t tracksType = 0;
+    int64_t nTracks = -1;
+    int64_t eventOffset = -1; // multiplicity and vertex bins in the efficiency grid
+    std::vector<float> values;
+  };
+  bool efficiencyAssociatedReuse = false;
+  std::unordered_map<int64_t, EfficiencyAssociatedEntry> efficiencyAssociatedEntries; // per global index of the first associated track, see fillEfficiencyAssociated
+  std::vector<float> etaBuffer, ptBuffer;
   std::vector<int> p2indexCache;
+  PairHistFillPlan pairFillPlanSame;
+  PairHistFillPlan pairFillPlanMixed;
 
   std::unique_ptr<TFormula> multCutFormula;
   std::array<uint, aod::cfmultset::NMultiplicityEstimators> multCutFormulaParamIndex;
@@ -179,6 +196,8 @@ struct CorrelationTask {
     bool mPairCuts = false;
     THn* mEfficiencyTrigger = nullptr;
     THn* mEfficiencyAssociated = nullptr;
+    EfficiencyGrid mEfficiencyTriggerGrid;
+    EfficiencyGrid mEfficiencyAssociatedGrid;
     bool efficiencyLoaded = false;
   } cfg;
 
@@ -313,8 +332,20 @@ struct CorrelationTask {
     same->setTrackEtaCut(cfgCutEta);
     mixed->setTrackEtaCut(cfgCutEta);
 
-    if (!cfgEfficiencyAssociated.value.empty())
+    if (cfgPairFillPlan) {
+      std::vector<AxisSpec> pairAxis(corrAxis);
+      pairAxis.insert(pairAxis.end(), userAxis.begin(), userAxis.end());
+      pairFillPlanSame.init(same->getPairHist(), pairAxis);
+      std::vector<AxisSpec> mixedPairAxis(corrAxis);
+      mixedPairAxis.insert(mixedPairAxis.end(), userMixingAxis.begin(), userMixingAxis.end());
+      pairFillPlanMixed.init(mixed->getPairHist(), mixedPairAxis);
+    }
+
+    if (!cfgEfficiencyAssociated.value.empty()) {
       efficiencyAssociatedCache.reserve(512);
+      // the entries are kept from the same-event passes until the end of the mixed-event pass of the data frame
+      efficiencyAssociatedReuse = cfgEfficiencyGrid && (doprocessMixedDerived || doprocessMixedDerivedMultSet || doprocessMixed2ProngDerived || doprocessMixed2ProngDerivedMixedPhi || doprocessMixed2ProngDerivedML || doprocessMixed2Prong2Prong || doprocessMixed2Prong2ProngML || doprocessMixedDerivedPairs);
+    }
     if (doprocessMCEfficiency2Prong || doprocessMCEfficiency2ProngML || doprocessMCReflection2ProngML) {
       p2indexCache.reserve(16);
       if (cfgMcTriggerPDGs->empty())
@@ -567,16 +598,30 @@ struct CorrelationTask {
   template <CorrelationContainer::CFStep step, typename TTarget, typename TTracks1, typename TTracks2>
   void fillCorrelations(TTarget target, TTracks1& tracks1, TTracks2& tracks2, float multiplicity, float posZ, int magField, float eventWeight)
   {
+    PairHistFillPlan* pairFillPlan = nullptr;
+    if (cfgPairFillPlan && !cfgMassAxis) {
+      pairFillPlan = target->getPairHist() == pairFillPlanSame.getPairHist() ? &pairFillPlanSame : &pairFillPlanMixed;
+      if (pairFillPlan->isInitialized()) {
+        pairFillPlan->setEvent(step, multiplicity, posZ);
+      } else {
+        pairFillPlan = nullptr;
+      }
+    }
+
     // Cache efficiency for particles (too many FindBin lookups)
     if constexpr (step == CorrelationContainer::kCFStepCorrected) {
-      if (cfg.mEfficiencyAssociated) {
+      if (cfg.mEfficiencyAssociatedGrid.isInitialized()) {
+        fillEfficiencyAssociated(tracks2, multiplicity, posZ);
+      } else if (cfg.mEfficiencyAssociated) {
         efficiencyAssociatedCache.clear();
         efficiencyAssociatedCache.reserve(tracks2.size());
         for (const auto& track : tracks2) {
           efficiencyAssociatedCache.push_back(getEfficiencyCorrection(cfg.mEfficiencyAssociated, track.eta(), track.pt(), multiplicity, posZ));
         }
+        efficiencyAssociated = &efficiencyAssociatedCache;
       }
     }
+    int64_t efficiencyTriggerOffset = cfg.mEfficiencyTriggerGrid.isInitialized() ? cfg.mEfficiencyTriggerGrid.getEventOffset(multiplicity, posZ) : 0;
 
     for (const auto& track1 : tracks1) {
       // LOGF(info, "Track %f | %f | %f  %d %d", track1.eta(), track1.phi(), track1.pt(), track1.isGlobalTrack(), track1.isGlobalTrackSDD());
@@ -634,7 +679,9 @@ struct CorrelationTask {
 
       float triggerWeight = eventWeight;
       if constexpr (step == CorrelationContainer::kCFStepCorrected) {
-        if (cfg.mEfficiencyTrigger) {
+        if (cfg.mEfficiencyTriggerGrid.isInitialized()) {
+          triggerWeight *= cfg.mEfficiencyTriggerGrid.get(efficiencyTriggerOffset, track1.eta(), track1.pt());
+        } else if (cfg.mEfficiencyTrigger) {
           triggerWeight *= getEfficiencyCorrection(cfg.mEfficiencyTrigger, track1.eta(), track1.pt(), multiplicity, posZ);
         }
       }
@@ -652,6 +699,9 @@ struct CorrelationTask {
       } else {
         target->getTriggerHist()->Fill(step, track1.pt(), multiplicity, posZ, triggerWeight);
       }
+      if (pairFillPlan) {
+        pairFillPlan->setTrigger(track1.pt());
+      }
 
       for (const auto& track2 : tracks2) {
         if constexpr (std::is_same<TTracks1, TTracks2>::value) {
@@ -800,7 +850,7 @@ struct CorrelationTask {
         float associatedWeight = triggerWeight;
         if constexpr (step == CorrelationContainer::kCFStepCorrected) {
           if (cfg.mEfficiencyAssociated) {
-            associatedWeight *= efficiencyAssociatedCache[track2.filteredIndex()];
+            associatedWeight *= (*efficiencyAssociated)[track2.filteredIndex()];
           }
         }
 
@@ -825,6 +875,8 @@ struct CorrelationTask {
           } else {
             LOGF(fatal, "Can not fill mass axis without invMass column. Disable cfgMassAxis.");
           }
+        } else if (pairFillPlan) {
+          pairFillPlan->fill(track1.eta() - track2.eta(), track2.pt(), deltaPhi, associatedWeight);
         } else {
           target->getPairHist()->Fill(step, track1.eta() - track2.eta(), track2.pt(), track1.pt(), multiplicity, deltaPhi, posZ, associatedWeight);
         }
@@ -848,6 +900,9 @@ struct CorrelationTask {
         LOGF(fatal, "Could not load efficiency histogram for trigger particles from %s", cfgEfficiencyTrigger.value.c_str());
       }
       LOGF(info, "Loaded efficiency histogram for trigger particles from %s (%p)", cfgEfficiencyTrigger.value.c_str(), (void*)cfg.mEfficiencyTrigger);
+      if (cfgEfficiencyGrid) {
+        cfg.mEfficiencyTriggerGrid.init(cfg.mEfficiencyTrigger);
+      }
     }
     if (cfgEfficiencyAssociated.value.empty() == false) {
       if (cfgLocalEfficiency > 0) {
@@ -860,6 +915,9 @@ struct CorrelationTask {
         LOGF(fatal, "Could not load efficiency histogram for associated particles from %s", cfgEfficiencyAssociated.value.c_str());
       }
       LOGF(info, "Loaded efficiency histogram for associated particles from %s (%p)", cfgEfficiencyAssociated.value.c_str(), (void*)cfg.mEfficiencyAssociated);
+      if (cfgEfficiencyGrid) {
+        cfg.mEfficiencyAssociatedGrid.init(cfg.mEfficiencyAssociated);
+      }
     }
     cfg.efficiencyLoaded = true;
   }
@@ -874,6 +932,37 @@ struct CorrelationTask {
     return eff->GetBinContent(effVars);
   }
 
+  // Efficiencies of the associated tracks from the grid, in one pass over the tracks. An event is the associated event
+  // of its same-event pass and of several mixed-event passes, so with mixing the values are kept per event until the end
+  // of the mixed-event pass and reused as long as the tracks and the multiplicity and vertex bins of the efficiency are the same.
+  template <typename TTracks>
+  void fillEfficiencyAssociated(TTracks const& tracks, float multiplicity, float posZ)
+  {
+    const auto& grid = cfg.mEfficiencyAssociatedGrid;
+    int64_t eventOffset = grid.getEventOffset(multiplicity, posZ);
+    std::vector<float>* values = &efficiencyAssociatedCache;
+    if (efficiencyAssociatedReuse && tracks.size() > 0) {
+      auto& entry = efficiencyAssociatedEntries[tracks.begin().globalIndex()];
+      const std::size_t tracksType = typeid(TTracks).hash_code();
+      if (entry.tracksType == tracksType && entry.nTracks == static_cast<int64_t>(tracks.size()) && entry.eventOffset == eventOffset) {
+        efficiencyAssociated = &entry.values;
+        return;
+      }
+      entry.tracksType = tracksType;
+      entry.nTracks = tracks.size();
+      entry.eventOffset = eventOffset;
+      values = &entry.values;
+    }
+    etaBuffer.clear();
+    ptBuffer.clear();
+    for (const auto& track : tracks) {
+      etaBuffer.push_back(track.eta());
+      ptBuffer.push_back(track.pt());
+    }
+    grid.fill(eventOffset, etaBuffer, ptBuffer, *values);
+    efficiencyAssociated = values;
+  }
+
   // Version with explicit nested loop
   void processSameAOD(AodCollisions::iterator const& collision, aod::BCsWithTimestamps const&, AodTracks const& tracks)
   {
@@ -1080,6 +1169,7 @@ struct CorrelationTask {
         fillCorrelations<CorrelationContainer::kCFStepCorrected>(mixed, tracks1, tracks2, collision1.multiplicity(), collision1.posZ(), field, eventWeight);
       }
     }
+    efficiencyAssociatedEntries.clear(); // the global indices are those of this data frame
   }
 
   void processMixedDerived(DerivedCollisions const& collisions, DerivedTracks const& tracks)
@@ -1133,6 +1223,60 @@ struct CorrelationTask {
   }
   PROCESS_SWITCH(CorrelationTask, processMixed2Prong2ProngML, "Process mixed events on derived data with ML scores", false);
 
+  // Mixed events from the pairs of the correlations-mixing-pairs producer, which every task of the train can share
+  // instead of binning the collisions itself. The producer has to use the vertex cut and the mixing axes of this task.
+  Preslice<aod::CFTracks> perCollisionDerived = aod::cftrack::cfCollisionId;
+  void processMixedDerivedPairs(aod::CFCollisions const& collisions, DerivedTracks const& tracks, aod::CFMixingPairs const& mixingPairs)
+  {
+    int64_t lastCollision1 = -1;
+    for (const auto& mixingPair : mixingPairs) {
+      auto collision1 = collisions.rawIteratorAt(mixingPair.cfCollision1Id());
+      auto collision2 = collisions.rawIteratorAt(mixingPair.cfCollision2Id());
+      if (std::abs(collision1.posZ()) >= cfgCutVertex || std::abs(collision2.posZ()) >= cfgCutVertex) {
+        continue;
+      }
+      const bool isNewWindow = mixingPair.cfCollision1Id() != lastCollision1;
+      lastCollision1 = mixingPair.cfCollision1Id();
+      const int bin = mixingPair.bin();
+      float eventWeight = 1.0f / mixingPair.nMixed();
+      int field = 0;
+      if (cfgTwoTrackCut > 0) {
+        field = getMagneticField(collision1.timestamp());
+      }
+
+      if (cfgVerbosity > 0) {
+        LOGF(info, "processMixedDerivedPairs: Mixed collisions bin: %d pair: [%d, %d] %d (%.3f, %.3f), %d (%.3f, %.3f)", bin, isNewWindow, mixingPair.nMixed(), collision1.globalIndex(), collision1.posZ(), collision1.multiplicity(), collision2.globalIndex(), collision2.posZ(), collision2.multiplicity());
+      }
+
+      if (isNewWindow) {
+        loadEfficiency(collision1.timestamp());
+      }
+      const bool hasEfficiencyMixed = (cfg.mEfficiencyAssociated != nullptr || cfg.mEfficiencyTrigger != nullptr);
+      const bool fillRecoMixed = !(cfgDropStepRECO && hasEfficiencyMixed);
+      if (isNewWindow && fillRecoMixed) {
+        mixed->fillEvent(collision1.multiplicity(), CorrelationContainer::kCFStepReconstructed);
+      }
+
+      auto tracks1 = tracks.sliceBy(perCollisionDerived, collision1.globalIndex());
+      auto tracks2 = tracks.sliceBy(perCollisionDerived, collision2.globalIndex());
+
+      registry.fill(HIST("eventcount_mixed"), bin);
+      registry.fill(HIST("trackcount_mixed"), bin, tracks1.size(), tracks2.size());
+      if (fillRecoMixed) {
+        fillCorrelations<CorrelationContainer::kCFStepReconstructed>(mixed, tracks1, tracks2, collision1.multiplicity(), collision1.posZ(), field, eventWeight);
+      }
+
+      if (hasEfficiencyMixed) {
+        if (isNewWindow) {
+          mixed->fillEvent(collision1.multiplicity(), CorrelationContainer::kCFStepCorrected);
+        }
+        fillCorrelations<CorrelationContainer::kCFStepCorrected>(mixed, tracks1, tracks2, collision1.multiplicity(), collision1.posZ(), field, eventWeight);
+      }
+    }
+    efficiencyAssociatedEntries.clear(); // the global indices are those of this data frame
+  }
+  PROCESS_SWITCH(CorrelationTask, processMixedDerivedPairs, "Process mixed events on derived data with the pairs of correlations-mixing-pairs", false);
+
   // Version with combinations
   /*void processWithCombinations(soa::Join<aod::Collisions, aod::CentRun2V0Ms>::iterator const& collision, aod::BCsWithTimestamps const&, soa::Filtered<aod::Tracks> const& tracks)
   {
@@ -36,6 +36,8 @@
 #include <Framework/OutputObjHeader.h>
 #include <Framework/runDataProcessing.h>
 
+#include <TArrayD.h>
+#include <TAxis.h>
 #include <TH1.h>
 #include <TH2.h>
 #include <TH3.h>
@@ -46,6 +48,7 @@
 
 #include <RtypesCore.h>
 
+#include <algorithm>
 #include <cmath>
 #include <cstdint>
 #include <cstdio>
@@ -98,6 +101,71 @@ std::vector<std::string> poinames;                     ///< the species of inter
 std::vector<std::string> tnames;                       ///< the track names
 std::vector<double> poimass;                           ///< the species of interest mass
 std::vector<std::vector<std::string>> trackPairsNames; ///< the track pairs names
+
+/// \brief Copy of the content of a correction histogram in a contiguous array
+/// The bins are found as TH1::FindFixBin does, under and overflow included, so a lookup
+/// gives the same value as GetBinContent(FindFixBin(...)) without the virtual calls
+class FlatCorrection
+{
+ public:
+  void set(TH1 const* h)
+  {
+    mAxes.clear();
+    mContent.clear();
+    if (h == nullptr) {
+      return;
+    }
+    TAxis const* axes[3] = {h->GetXaxis(), h->GetYaxis(), h->GetZaxis()};
+    for (int i = 0; i < h->GetDimension(); ++i) {
+      Axis axis;
+      axis.nbins = axes[i]->GetNbins();
+      axis.low = axes[i]->GetXmin();
+      axis.up = axes[i]->GetXmax();
+      if (axes[i]->GetXbins()->fN > 0) {
+        axis.edges.assign(axes[i]->GetXbins()->GetArray(), axes[i]->GetXbins()->GetArray() + axes[i]->GetXbins()->fN);
+      }
+      mAxes.push_back(axis);
+    }
+    /* the ROOT global bin numbering: the x bin runs the fastest */
+    const int nx = h->GetNbinsX() + 2;
+    const int ny = h->GetDimension() > 1 ? h->GetNbinsY() + 2 : 1;
+    const int nz = h->GetDimension() > 2 ? h->GetNbinsZ() + 2 : 1;
+    mContent.resize(nx * ny * nz);
+    for (int gbin = 0; gbin < nx * ny * nz; ++gbin) {
+      mContent[gbin] = h->GetBinContent(gbin);
+    }
+  }
+
+  float get(double x) const { return mContent[mAxes[0].findBin(x)]; }
+  float get(double x, double y) const { return mContent[mAxes[0].findBin(x) + (mAxes[0].nbins + 2) * mAxes[1].findBin(y)]; }
+  float get(double x, double y, double z) const
+  {
+    return mContent[mAxes[0].findBin(x) + (mAxes[0].nbins + 2) * (mAxes[1].findBin(y) + (mAxes[1].nbins + 2) * mAxes[2].findBin(z))];
+  }
+
+ private:
+  struct Axis {
+    int nbins = 0;
+    double low = 0.0;
+    double up = 0.0;
+    std::vector<double> edges; ///< empty for fixed size bins
+    int findBin(double x) const
+    {
+      if (x < low) {
+        return 0;
+      }
+      if (!(x < up)) {
+        return nbins + 1;
+      }
+      if (edges.empty()) {
+        return 1 + static_cast<int>(nbins * (x - low) / (up - low));
+      }
+      return std::upper_bound(edges.begin(), edges.end(), x) - edges.begin();
+    }
+  };
+  std::vector<Axis> mAxes;
+  std::vector<float> mContent;
+};
 } // namespace correlationstask
 
 // Task for building <dpt,dpt> correlations
@@ -121,6 +189,8 @@ struct DptDptCorrelations {
     std::vector<TH3F*> fhSum1PtVsZEtaPhiPt{nch, nullptr};                        //!<! accumulated sum of weighted \f$p_T\f$ vs \f$\mbox{vtx}_z,\; \eta,\;\phi,\;p_T\f$, for the different species
     std::vector<TH1*> fhNuaNue{nch, nullptr};                                    //!<! NUA+NUE correction for the differents species
     std::vector<TH2*> fhPtAvgVsEtaPhi{nch, nullptr};                             //!<! average \f$p_T\f$ vs \f$\eta,\;\phi\f$, for the different species
+    std::vector<correlationstask::FlatCorrection> fNuaNueFlat{nch};              //!<! the NUA+NUE corrections in contiguous arrays, for the per track lookups
+    std::vector<correlationstask::FlatCorrection> fPtAvgVsEtaPhiFlat{nch};       //!<! the average \f$p_T\f$ in contiguous arrays, for the per track lookups
     std::vector<std::vector<TH2F*>> fhN2VsPtPt{nch, {nch, nullptr}};             //!<! weighted two particle distribution vs \f${p_T}_1, {p_T}_2\f$ for the different species combinations
     std::vector<std::vector<TH2F*>> fhN2VsDEtaDPhi{nch, {nch, nullptr}};         //!<! two-particle distribution vs \f$\Delta\eta,\;\Delta\phi\f$ for the different species combinations
     std::vector<std::vector<TH2F*>> fhN2contVsDEtaDPhi{nch, {nch, nullptr}};     //!<! two-particle distribution continuous vs \f$\Delta\eta,\;\Delta\phi\f$ for the different species combinations
@@ -325,6 +395,7 @@ struct DptDptCorrelations {
           }
         }
         fhNuaNue[i] = corrs[i];
+        fNuaNueFlat[i].set(fhNuaNue[i]);
         if (fhNuaNue[i] != nullptr) {
           int nbins = 0;
           double avg = 0.0;
@@ -358,6 +429,7 @@ struct DptDptCorrelations {
       for (uint i = 0; i < ptavgs.size(); ++i) {
         LOGF(info, "  Stored pT average for track id %d %s", i, ptavgs[i] != nullptr ? "yes" : "no");
         fhPtAvgVsEtaPhi[i] = ptavgs[i];
+        fPtAvgVsEtaPhiFlat[i].set(fhPtAvgVsEtaPhi[i]);
       }
       ccdbstored = true;
     }
@@ -372,11 +444,11 @@ struct DptDptCorrelations {
       for (const auto& t : tracks) {
         if (fhNuaNue[t.trackacceptedid()] != nullptr) {
           if constexpr (nDim == k1D) {
-            (*corr)[index] = fhNuaNue[t.trackacceptedid()]->GetBinContent(fhNuaNue[t.trackacceptedid()]->FindFixBin(t.pt()));
+            (*corr)[index] = fNuaNueFlat[t.trackacceptedid()].get(t.pt());
           } else if constexpr (nDim == k2D) {
-            (*corr)[index] = fhNuaNue[t.trackacceptedid()]->GetBinContent(fhNuaNue[t.trackacceptedid()]->FindFixBin(t.eta(), t.pt()));
+            (*corr)[index] = fNuaNueFlat[t.trackacceptedid()].get(t.eta(), t.pt());
           } else if constexpr (nDim == k3D) {
-            (*corr)[index] = fhNuaNue[t.trackacceptedid()]->GetBinContent(fhNuaNue[t.trackacceptedid()]->FindFixBin(zvtx, getEtaPhiIndex(t) + 0.5, t.pt()));
+            (*corr)[index] = fNuaNueFlat[t.trackacceptedid()].get(zvtx, getEtaPhiIndex(t) + 0.5, t.pt());
           }
         }
         index++;
@@ -406,7 +478,7 @@ struct DptDptCorrelations {
       int index = 0;
       for (auto const& t : tracks) {
         if (fhPtAvgVsEtaPhi[t.trackacceptedid()] != nullptr) {
-          (*ptavg)[index] = fhPtAvgVsEtaPhi[t.trackacceptedid()]->GetBinContent(fhPtAvgVsEtaPhi[t.trackacceptedid()]->FindFixBin(t.eta(), t.phi()));
+          (*ptavg)[index] = fPtAvgVsEtaPhiFlat[t.trackacceptedid()].get(t.eta(), t.phi());
           index++;
         }
       }
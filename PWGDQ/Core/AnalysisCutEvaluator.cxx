@@ -0,0 +1,232 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#include "PWGDQ/Core/AnalysisCutEvaluator.h"
+
+#include "PWGDQ/Core/AnalysisCompositeCut.h"
+#include "PWGDQ/Core/AnalysisCut.h"
+
+#include <Framework/Logger.h>
+
+#include <TF1.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+//____________________________________________________________________________
+int AnalysisCutEvaluator::AddCut(const AnalysisCut* cut)
+{
+  //
+  // register a cut
+  //
+  if (static_cast<int>(fRoots.size()) >= kMaxCuts) {
+    LOG(error) << "AnalysisCutEvaluator::AddCut(): Maximum number of cuts (" << kMaxCuts << ") exceeded, cut " << cut->GetName() << " not added";
+    return -1;
+  }
+  fRoots.push_back(cut);
+  return fRoots.size() - 1;
+}
+
+//____________________________________________________________________________
+void AnalysisCutEvaluator::Compile(int nLUTPoints)
+{
+  //
+  // flatten all the registered cuts into a single program
+  //
+  fConditions.clear();
+  fLUTs.clear();
+  fProgram.clear();
+  int depth = 0;
+  int maxDepth = 0;
+  for (std::size_t i = 0; i < fRoots.size(); ++i) {
+    CompileNode(fRoots[i], nLUTPoints, depth, maxDepth);
+    fProgram.push_back({kStore, static_cast<int>(i), 0});
+    depth--;
+  }
+  if (maxDepth > kMaxStackDepth) {
+    LOG(fatal) << "AnalysisCutEvaluator::Compile(): The cuts are too complex to be compiled, needed stack depth " << maxDepth;
+  }
+}
+
+//____________________________________________________________________________
+void AnalysisCutEvaluator::CompileNode(const AnalysisCut* cut, int nLUTPoints, int& depth, int& maxDepth)
+{
+  //
+  // compile a cut in post-order: the children decisions are pushed first, then combined
+  //
+  auto* compositeCut = dynamic_cast<const AnalysisCompositeCut*>(cut);
+  if (compositeCut) {
+    for (auto const& child : compositeCut->GetCutList()) {
+      CompileNode(&child, nLUTPoints, depth, maxDepth);
+    }
+    for (auto const& child : compositeCut->GetCompositeCutList()) {
+      CompileNode(&child, nLUTPoints, depth, maxDepth);
+    }
+    int nChildren = compositeCut->GetNCuts();
+    fProgram.push_back({(compositeCut->GetUseAND() ? kAnd : kOr), nChildren, 0});
+    depth += 1 - nChildren;
+    if (depth > maxDepth) {
+      maxDepth = depth;
+    }
+    return;
+  }
+
+  int begin = fConditions.size();
+  for (auto const& c : cut->GetCuts()) {
+    Condition cond = {};
+    cond.fVar = c.fVar;
+    cond.fExclude = c.fExclude;
+    cond.fLow = CompileLimit(c.fLow, c.fFuncLow, c.fDepVar, nLUTPoints);
+    cond.fHigh = CompileLimit(c.fHigh, c.fFuncHigh, c.fDepVar, nLUTPoints);
+    cond.fDepVar = c.fDepVar;
+    cond.fDepLow = c.fDepLow;
+    cond.fDepHigh = c.fDepHigh;
+    cond.fDepExclude = c.fDepExclude;
+    cond.fDepVar2 = c.fDepVar2;
+    cond.fDep2Low = c.fDep2Low;
+    cond.fDep2High = c.fDep2High;
+    cond.fDep2Exclude = c.fDep2Exclude;
+    fConditions.push_back(cond);
+  }
+  fProgram.push_back({kLeaf, begin, static_cast<int>(fConditions.size())});
+  depth++;
+  if (depth > maxDepth) {
+    maxDepth = depth;
+  }
+}
+
+//____________________________________________________________________________
+AnalysisCutEvaluator::Limit AnalysisCutEvaluator::CompileLimit(float value, const std::shared_ptr<TF1>& func, int var, int nLUTPoints)
+{
+  //
+  // compile a cut limit; functions are tabulated once, even if used in several places
+  //
+  if (!func) {
+    return {value, -1};
+  }
+  for (std::size_t i = 0; i < fLUTs.size(); ++i) {
+    if (fLUTs[i].fFunc == func && fLUTs[i].fVar == var) {
+      return {value, static_cast<int>(i)};
+    }
+  }
+  FunctionLUT lut;
+  lut.fFunc = func;
+  lut.fVar = var;
+  lut.fXmin = func->GetXmin();
+  lut.fXmax = func->GetXmax();
+  lut.fInvStep = 0.;
+  if (nLUTPoints > 1 && lut.fXmax > lut.fXmin) {
+    double step = (lut.fXmax - lut.fXmin) / (nLUTPoints - 1);
+    lut.fInvStep = 1.0 / step;
+    lut.fValues.resize(nLUTPoints);
+    for (int i = 0; i < nLUTPoints; ++i) {
+      lut.fValues[i] = func->Eval(lut.fXmin + i * step);
+    }
+  }
+  fLUTs.push_back(lut);
+  return {value, static_cast<int>(fLUTs.size()) - 1};
+}
+
+//____________________________________________________________________________
+float AnalysisCutEvaluator::EvalLimit(const Limit& limit, const float* values) const
+{
+  //
+  // get the value of a cut limit
+  //
+  if (limit.fLUT < 0) {
+    return limit.fValue;
+  }
+  auto const& lut = fLUTs[limit.fLUT];
+  float x = values[lut.fVar];
+  if (lut.fValues.empty() || !(x >= lut.fXmin && x < lut.fXmax)) {
+    return lut.fFunc->Eval(x);
+  }
+  float pos = (x - lut.fXmin) * lut.fInvStep;
+  auto bin = static_cast<std::size_t>(pos);
+  if (bin + 1 >= lut.fValues.size()) {
+    return lut.fValues.back();
+  }
+  float frac = pos - bin;
+  return lut.fValues[bin] + frac * (lut.fValues[bin + 1] - lut.fValues[bin]);
+}
+
+//____________________________________________________________________________
+bool AnalysisCutEvaluator::EvalCondition(const Condition& cond, const float* values) const
+{
+  //
+  // evaluate one selection, with the same logic as in AnalysisCut::IsSelected()
+  //
+  // the selection is not applied if the dependent variables are not in the requested range
+  if (cond.fDepVar != -1) {
+    bool inRange = (values[cond.fDepVar] > cond.fDepLow && values[cond.fDepVar] <= cond.fDepHigh);
+    if (inRange == cond.fDepExclude) {
+      return true;
+    }
+  }
+  if (cond.fDepVar2 != -1) {
+    bool inRange = (values[cond.fDepVar2] > cond.fDep2Low && values[cond.fDepVar2] <= cond.fDep2High);
+    if (inRange == cond.fDep2Exclude) {
+      return true;
+    }
+  }
+  float value = values[cond.fVar];
+  bool inRange = (value >= EvalLimit(cond.fLow, values) && value <= EvalLimit(cond.fHigh, values));
+  return inRange != cond.fExclude;
+}
+
+//____________________________________________________________________________
+uint64_t AnalysisCutEvaluator::Evaluate(const float* values) const
+{
+  //
+  // run the program and return the decision mask
+  //
+  uint64_t mask = 0;
+  bool stack[kMaxStackDepth];
+  int top = 0;
+  for (auto const& instr : fProgram) {
+    switch (instr.fOp) {
+      case kLeaf: {
+        bool decision = true;
+        for (int i = instr.fArg1; i < instr.fArg2 && decision; ++i) {
+          decision = EvalCondition(fConditions[i], values);
+        }
+        stack[top++] = decision;
+        break;
+      }
+      case kAnd: {
+        top -= instr.fArg1;
+        bool decision = true;
+        for (int i = top; i < top + instr.fArg1; ++i) {
+          decision &= stack[i];
+        }
+        stack[top++] = decision;
+        break;
+      }
+      case kOr: {
+        top -= instr.fArg1;
+        bool decision = false;
+        for (int i = top; i < top + instr.fArg1; ++i) {
+          decision |= stack[i];
+        }
+        stack[top++] = decision;
+        break;
+      }
+      case kStore:
+        if (stack[--top]) {
+          mask |= (static_cast<uint64_t>(1) << instr.fArg1);
+        }
+        break;
+    }
+  }
+  return mask;
+}
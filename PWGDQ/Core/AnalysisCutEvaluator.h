@@ -0,0 +1,105 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+//
+// Contact: iarsene@cern.ch, i.c.arsene@fys.uio.no
+//
+// Class compiling a set of AnalysisCut / AnalysisCompositeCut objects into a flat program
+//   which evaluates all of them in a single pass and returns the decisions as a bit mask
+//
+
+#ifndef PWGDQ_CORE_ANALYSISCUTEVALUATOR_H_
+#define PWGDQ_CORE_ANALYSISCUTEVALUATOR_H_
+
+#include "PWGDQ/Core/AnalysisCut.h"
+
+#include <TF1.h>
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+//_________________________________________________________________________
+class AnalysisCutEvaluator
+{
+ public:
+  AnalysisCutEvaluator() = default;
+
+  enum Constants {
+    kMaxCuts = 64,       // maximum number of registered cuts (size of the decision mask)
+    kMaxStackDepth = 256 // maximum number of intermediate decisions kept during the evaluation
+  };
+
+  // Register a cut (simple or composite) and return the bit assigned to it in the decision mask, or -1 if kMaxCuts is exceeded
+  // NOTE: The cut content is copied only when Compile() is called, so the cut must be alive until then
+  int AddCut(const AnalysisCut* cut);
+  // Build the flat program for all the registered cuts
+  // If nLUTPoints > 1, the cut limits given by TF1 functions are tabulated with nLUTPoints points over the function range
+  //   and linearly interpolated; outside the function range (or if nLUTPoints < 2), TF1::Eval() is used
+  void Compile(int nLUTPoints = 0);
+  // Evaluate all the registered cuts; bit i of the returned mask corresponds to the i-th registered cut
+  uint64_t Evaluate(const float* values) const;
+
+  int GetNCuts() const { return fRoots.size(); }
+
+ private:
+  // cut limit, either a constant or a function of the dependent variable
+  struct Limit {
+    float fValue; // constant value, used if fLUT < 0
+    int fLUT;     // index in the list of tabulated functions
+  };
+  // one selection from AnalysisCut::CutContainer
+  struct Condition {
+    int16_t fVar;
+    bool fExclude;
+    Limit fLow;
+    Limit fHigh;
+    int16_t fDepVar;
+    float fDepLow;
+    float fDepHigh;
+    bool fDepExclude;
+    int16_t fDepVar2;
+    float fDep2Low;
+    float fDep2High;
+    bool fDep2Exclude;
+  };
+  // TF1 tabulated over its range
+  struct FunctionLUT {
+    std::shared_ptr<TF1> fFunc;
+    int16_t fVar;   // variable the function is evaluated on
+    float fXmin;    // lower edge of the tabulated range
+    float fXmax;    // upper edge of the tabulated range
+    float fInvStep; // inverse of the distance between two consecutive points
+    std::vector<float> fValues;
+  };
+  enum OpCode : uint8_t {
+    kLeaf, // evaluate the conditions [fArg1, fArg2) with AND and push the result
+    kAnd,  // pop fArg1 decisions and push their AND
+    kOr,   // pop fArg1 decisions and push their OR
+    kStore // pop one decision and store it in bit fArg1 of the mask
+  };
+  struct Instruction {
+    OpCode fOp;
+    int fArg1;
+    int fArg2;
+  };
+
+  std::vector<const AnalysisCut*> fRoots; // registered cuts
+  std::vector<Condition> fConditions;     // flattened list of selections
+  std::vector<FunctionLUT> fLUTs;         // tabulated cut functions
+  std::vector<Instruction> fProgram;      // post-order program for all the registered cuts
+
+  void CompileNode(const AnalysisCut* cut, int nLUTPoints, int& depth, int& maxDepth);
+  Limit CompileLimit(float value, const std::shared_ptr<TF1>& func, int var, int nLUTPoints);
+  float EvalLimit(const Limit& limit, const float* values) const;
+  bool EvalCondition(const Condition& cond, const float* values) const;
+};
+
+#endif // PWGDQ_CORE_ANALYSISCUTEVALUATOR_H_
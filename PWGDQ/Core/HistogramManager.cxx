@@ -28,7 +28,9 @@
 #include <cstdint>
 #include <iostream>
 #include <list>
+#include <map>
 #include <memory>
+#include <string>
 #include <vector>
 using namespace std;
 
@@ -45,6 +47,217 @@ using namespace std;
 
 ClassImp(HistogramManager);
 
+namespace
+{
+// Type specific fill functions used by the pre-decoded fill plans
+// NOTE: For the fill plan entries, fVars[0..3] hold the X, Y, Z and T variables
+template <typename TEntry>
+void fillTH1(const TEntry& e, const float* values)
+{
+  if (e.fVarW > HistogramManager::kNothing) {
+    reinterpret_cast<TH1*>(e.fHist)->Fill(values[e.fVars[0]], values[e.fVarW]);
+  } else {
+    reinterpret_cast<TH1*>(e.fHist)->Fill(values[e.fVars[0]]);
+  }
+}
+
+template <typename TEntry>
+void fillTH1Labels(const TEntry& e, const float* values)
+{
+  reinterpret_cast<TH1*>(e.fHist)->Fill(Form("%d", static_cast<int>(values[e.fVars[0]])), (e.fVarW > HistogramManager::kNothing ? values[e.fVarW] : 1.));
+}
+
+template <typename TEntry>
+void fillTProfile(const TEntry& e, const float* values)
+{
+  if (e.fVarW > HistogramManager::kNothing) {
+    reinterpret_cast<TProfile*>(e.fHist)->Fill(values[e.fVars[0]], values[e.fVars[1]], values[e.fVarW]);
+  } else {
+    reinterpret_cast<TProfile*>(e.fHist)->Fill(values[e.fVars[0]], values[e.fVars[1]]);
+  }
+}
+
+template <typename TEntry>
+void fillTProfileLabels(const TEntry& e, const float* values)
+{
+  if (e.fVarW > HistogramManager::kNothing) {
+    reinterpret_cast<TProfile*>(e.fHist)->Fill(Form("%d", static_cast<int>(values[e.fVars[0]])), values[e.fVars[1]], values[e.fVarW]);
+  } else {
+    reinterpret_cast<TProfile*>(e.fHist)->Fill(Form("%d", static_cast<int>(values[e.fVars[0]])), values[e.fVars[1]]);
+  }
+}
+
+template <typename TEntry>
+void fillTH2(const TEntry& e, const float* values)
+{
+  if (e.fVarW > HistogramManager::kNothing) {
+    reinterpret_cast<TH2*>(e.fHist)->Fill(values[e.fVars[0]], values[e.fVars[1]], values[e.fVarW]);
+  } else {
+    reinterpret_cast<TH2*>(e.fHist)->Fill(values[e.fVars[0]], values[e.fVars[1]]);
+  }
+}
+
+template <typename TEntry>
+void fillTH2Labels(const TEntry& e, const float* values)
+{
+  reinterpret_cast<TH2*>(e.fHist)->Fill(Form("%d", static_cast<int>(values[e.fVars[0]])), values[e.fVars[1]], (e.fVarW > HistogramManager::kNothing ? values[e.fVarW] : 1.));
+}
+
+template <typename TEntry>
+void fillTProfile2D(const TEntry& e, const float* values)
+{
+  if (e.fVarW > HistogramManager::kNothing) {
+    reinterpret_cast<TProfile2D*>(e.fHist)->Fill(values[e.fVars[0]], values[e.fVars[1]], values[e.fVars[2]], values[e.fVarW]);
+  } else {
+    reinterpret_cast<TProfile2D*>(e.fHist)->Fill(values[e.fVars[0]], values[e.fVars[1]], values[e.fVars[2]]);
+  }
+}
+
+template <typename TEntry>
+void fillTH3(const TEntry& e, const float* values)
+{
+  if (e.fVarW > HistogramManager::kNothing) {
+    reinterpret_cast<TH3*>(e.fHist)->Fill(values[e.fVars[0]], values[e.fVars[1]], values[e.fVars[2]], values[e.fVarW]);
+  } else {
+    reinterpret_cast<TH3*>(e.fHist)->Fill(values[e.fVars[0]], values[e.fVars[1]], values[e.fVars[2]]);
+  }
+}
+
+template <typename TEntry>
+void fillTProfile3D(const TEntry& e, const float* values)
+{
+  if (e.fVarW > HistogramManager::kNothing) {
+    reinterpret_cast<TProfile3D*>(e.fHist)->Fill(values[e.fVars[0]], values[e.fVars[1]], values[e.fVars[2]], values[e.fVars[3]], values[e.fVarW]);
+  } else {
+    reinterpret_cast<TProfile3D*>(e.fHist)->Fill(values[e.fVars[0]], values[e.fVars[1]], values[e.fVars[2]], values[e.fVars[3]]);
+  }
+}
+
+template <typename TEntry>
+void fillTHn(const TEntry& e, const float* values)
+{
+  double fillValues[HistogramManager::kMaxFillDimensions];
+  for (int i = 0; i < e.fDimension; i++) {
+    fillValues[i] = values[e.fVars[i]];
+  }
+  reinterpret_cast<THnBase*>(e.fHist)->Fill(fillValues, (e.fVarW > HistogramManager::kNothing ? values[e.fVarW] : 1.));
+}
+
+// Column-wise counterparts of the fill functions above, used for batches stored as structure-of-arrays
+template <typename TEntry>
+void fillBatchTH1(const TEntry& e, int n, const double* const* cols)
+{
+  reinterpret_cast<TH1*>(e.fHist)->FillN(n, cols[e.fVars[0]], (e.fVarW > HistogramManager::kNothing ? cols[e.fVarW] : nullptr));
+}
+
+template <typename TEntry>
+void fillBatchTH1Labels(const TEntry& e, int n, const double* const* cols)
+{
+  for (int i = 0; i < n; i++) {
+    reinterpret_cast<TH1*>(e.fHist)->Fill(Form("%d", static_cast<int>(cols[e.fVars[0]][i])), (e.fVarW > HistogramManager::kNothing ? cols[e.fVarW][i] : 1.));
+  }
+}
+
+template <typename TEntry>
+void fillBatchTProfile(const TEntry& e, int n, const double* const* cols)
+{
+  reinterpret_cast<TProfile*>(e.fHist)->FillN(n, cols[e.fVars[0]], cols[e.fVars[1]], (e.fVarW > HistogramManager::kNothing ? cols[e.fVarW] : nullptr));
+}
+
+template <typename TEntry>
+void fillBatchTProfileLabels(const TEntry& e, int n, const double* const* cols)
+{
+  for (int i = 0; i < n; i++) {
+    reinterpret_cast<TProfile*>(e.fHist)->Fill(Form("%d", static_cast<int>(cols[e.fVars[0]][i])), cols[e.fVars[1]][i], (e.fVarW > HistogramManager::kNothing ? cols[e.fVarW][i] : 1.));
+  }
+}
+
+template <typename TEntry>
+void fillBatchTH2(const TEntry& e, int n, const double* const* cols)
+{
+  reinterpret_cast<TH2*>(e.fHist)->FillN(n, cols[e.fVars[0]], cols[e.fVars[1]], (e.fVarW > HistogramManager::kNothing ? cols[e.fVarW] : nullptr));
+}
+
+template <typename TEntry>
+void fillBatchTH2Labels(const TEntry& e, int n, const double* const* cols)
+{
+  for (int i = 0; i < n; i++) {
+    reinterpret_cast<TH2*>(e.fHist)->Fill(Form("%d", static_cast<int>(cols[e.fVars[0]][i])), cols[e.fVars[1]][i], (e.fVarW > HistogramManager::kNothing ? cols[e.fVarW][i] : 1.));
+  }
+}
+
+template <typename TEntry>
+void fillBatchTProfile2D(const TEntry& e, int n, const double* const* cols)
+{
+  auto* h = reinterpret_cast<TProfile2D*>(e.fHist);
+  const double* x = cols[e.fVars[0]];
+  const double* y = cols[e.fVars[1]];
+  const double* z = cols[e.fVars[2]];
+  if (e.fVarW > HistogramManager::kNothing) {
+    const double* w = cols[e.fVarW];
+    for (int i = 0; i < n; i++) {
+      h->Fill(x[i], y[i], z[i], w[i]);
+    }
+  } else {
+    for (int i = 0; i < n; i++) {
+      h->Fill(x[i], y[i], z[i]);
+    }
+  }
+}
+
+template <typename TEntry>
+void fillBatchTH3(const TEntry& e, int n, const double* const* cols)
+{
+  auto* h = reinterpret_cast<TH3*>(e.fHist);
+  const double* x = cols[e.fVars[0]];
+  const double* y = cols[e.fVars[1]];
+  const double* z = cols[e.fVars[2]];
+  if (e.fVarW > HistogramManager::kNothing) {
+    const double* w = cols[e.fVarW];
+    for (int i = 0; i < n; i++) {
+      h->Fill(x[i], y[i], z[i], w[i]);
+    }
+  } else {
+    for (int i = 0; i < n; i++) {
+      h->Fill(x[i], y[i], z[i]);
+    }
+  }
+}
+
+template <typename TEntry>
+void fillBatchTProfile3D(const TEntry& e, int n, const double* const* cols)
+{
+  auto* h = reinterpret_cast<TProfile3D*>(e.fHist);
+  const double* x = cols[e.fVars[0]];
+  const double* y = cols[e.fVars[1]];
+  const double* z = cols[e.fVars[2]];
+  const double* t = cols[e.fVars[3]];
+  if (e.fVarW > HistogramManager::kNothing) {
+    const double* w = cols[e.fVarW];
+    for (int i = 0; i < n; i++) {
+      h->Fill(x[i], y[i], z[i], t[i], w[i]);
+    }
+  } else {
+    for (int i = 0; i < n; i++) {
+      h->Fill(x[i], y[i], z[i], t[i]);
+    }
+  }
+}
+
+template <typename TEntry>
+void fillBatchTHn(const TEntry& e, int n, const double* const* cols)
+{
+  auto* h = reinterpret_cast<THnBase*>(e.fHist);
+  double fillValues[HistogramManager::kMaxFillDimensions];
+  for (int i = 0; i < n; i++) {
+    for (int idim = 0; idim < e.fDimension; idim++) {
+      fillValues[idim] = cols[e.fVars[idim]][i];
+    }
+    h->Fill(fillValues, (e.fVarW > HistogramManager::kNothing ? cols[e.fVarW][i] : 1.));
+  }
+}
+} // namespace
+
 //_______________________________________________________________________________
 HistogramManager::HistogramManager() : TNamed("", ""),
                                        fMainList(nullptr),
@@ -335,6 +548,8 @@ void HistogramManager::AddHistogram(const char* histClass, const char* hname, co
       hList->Add(h);
       break;
   } // end switch
+
+  UpdateFillPlan(histClass);
 }
 
 //_________________________________________________________________
@@ -541,6 +756,8 @@ void HistogramManager::AddHistogram(const char* histClass, const char* hname, co
       hList->Add(h);
       break;
   } // end switch(dimension)
+
+  UpdateFillPlan(histClass);
 }
 
 //_________________________________________________________________
@@ -641,6 +858,8 @@ void HistogramManager::AddHistogram(const char* histClass, const char* hname, co
   }
 
   fBinsAllocated += nbins;
+
+  UpdateFillPlan(histClass);
 }
 
 //_________________________________________________________________
@@ -747,6 +966,8 @@ void HistogramManager::AddHistogram(const char* histClass, const char* hname, co
     }
   }
   fBinsAllocated += bins;
+
+  UpdateFillPlan(histClass);
 }
 
 //__________________________________________________________________
@@ -755,150 +976,157 @@ void HistogramManager::FillHistClass(const char* className, Float_t* values)
   //
   //  fill a class of histograms
   //
-
-  // get the needed histogram list
-  auto* hList = reinterpret_cast<TList*>(fMainList->FindObject(className));
-  if (!hList) {
+  auto handleIt = fClassHandles.find(className);
+  int handle = (handleIt != fClassHandles.end() ? handleIt->second : GetHistClassHandle(className));
+  if (handle == kNothing) {
     // TODO: add some meaningfull error message
     /*LOG(warn) << "HistogramManager::FillHistClass(): Histogram list " << className << " not found!";
     LOG(warn) << "         Histogram list not filled" << endl; */
     return;
   }
+  FillHistClass(handle, values);
+}
 
-  // get the corresponding std::list containng identifiers to the needed variables to be filled
-  auto const& varList = fVariablesMap[className];
+//_________________________________________________________________
+void HistogramManager::FillHistClass(int handle, Float_t* values)
+{
+  //
+  //  fill a class of histograms using the pre-decoded fill plan
+  //
+  for (auto const& entry : fFillPlans[handle]) {
+    entry.fFill(entry, values);
+  }
+}
 
-  TIter next(hList);
+//_________________________________________________________________
+void HistogramManager::FillHistClassBatch(const char* className, int nEntries, const double* const* columns)
+{
+  //
+  //  fill a class of histograms from a batch of objects stored as columns
+  //
+  int handle = GetHistClassHandle(className);
+  if (handle == kNothing) {
+    return;
+  }
+  FillHistClassBatch(handle, nEntries, columns);
+}
 
-  TObject* h = nullptr;
-  bool isProfile;
-  bool isTHn;
-  int dimension = 0;
-  bool isSparse = kFALSE;
-  bool isFillLabelx = kFALSE;
-  // TODO: At the moment, maximum 20 dimensions are foreseen for the THn histograms. We should make this more dynamic
-  //       But maybe its better to have it like to avoid dynamically allocating this array in the histogram loop
-  double fillValues[20] = {0.0};
-  int varX = -1, varY = -1, varZ = -1, varT = -1, varW = -1;
+//_________________________________________________________________
+void HistogramManager::FillHistClassBatch(int handle, int nEntries, const double* const* columns)
+{
+  //
+  //  fill a class of histograms from a batch of objects stored as columns, using the pre-decoded fill plan
+  //
+  if (nEntries <= 0) {
+    return;
+  }
+  for (auto const& entry : fFillPlans[handle]) {
+    entry.fFillBatch(entry, nEntries, columns);
+  }
+}
+
+//_________________________________________________________________
+int HistogramManager::GetHistClassHandle(const char* className)
+{
+  //
+  //  get the handle of a histogram class, building its fill plan if this was not done yet
+  //
+  auto handleIt = fClassHandles.find(className);
+  if (handleIt != fClassHandles.end()) {
+    return handleIt->second;
+  }
+  if (!fMainList->FindObject(className)) {
+    return kNothing;
+  }
+  int handle = fFillPlans.size();
+  fClassHandles[className] = handle;
+  fHandleClassNames.push_back(className);
+  fFillPlans.emplace_back();
+  BuildFillPlan(handle);
+  return handle;
+}
+
+//_________________________________________________________________
+void HistogramManager::UpdateFillPlan(const char* histClass)
+{
+  //
+  //  rebuild the fill plan of a histogram class, if a handle was already created for it
+  //
+  auto handleIt = fClassHandles.find(histClass);
+  if (handleIt != fClassHandles.end()) {
+    BuildFillPlan(handleIt->second);
+  }
+}
+
+//_________________________________________________________________
+void HistogramManager::BuildFillPlan(int handle)
+{
+  //
+  //  decode the variable identifiers and histogram types of a histogram class into a flat fill plan
+  //
+  auto& plan = fFillPlans[handle];
+  plan.clear();
+  const std::string& className = fHandleClassNames[handle];
+  auto* hList = reinterpret_cast<TList*>(fMainList->FindObject(className.c_str()));
+  auto const& varList = fVariablesMap[className];
 
   // loop over the histogram and std::list
   // NOTE: these two should contain the same number of elements and be synchronized, otherwise its a mess
+  TIter next(hList);
   for (auto varIter = varList.begin(); varIter != varList.end(); varIter++) {
-    h = next(); // get the histogram
-    // decode information from the vector of indices
-    isProfile = ((*varIter)[0] == 1 ? true : false);
-    isTHn = ((*varIter)[1] > 0 ? true : false);
-    if (isTHn) {
-      dimension = (*varIter)[1];
-    } else {
-      dimension = (reinterpret_cast<TH1*>(h))->GetDimension();
+    FillPlanEntry entry;
+    entry.fHist = next();
+    entry.fVarW = (*varIter)[2];
+    for (int i = 0; i < kMaxFillDimensions; i++) {
+      entry.fVars[i] = kNothing;
     }
 
-    // get the various variable indices
-    varW = (*varIter)[2];
+    // decode information from the vector of indices
+    bool isProfile = ((*varIter)[0] == 1 ? true : false);
+    bool isTHn = ((*varIter)[1] > 0 ? true : false);
     if (isTHn) {
-      for (int i = 0; i < dimension; i++) {
-        fillValues[i] = values[(*varIter)[3 + i]];
+      entry.fDimension = (*varIter)[1];
+      for (int i = 0; i < entry.fDimension; i++) {
+        entry.fVars[i] = (*varIter)[3 + i];
       }
-    } else {
-      varX = (*varIter)[3];
-      varY = (*varIter)[4];
-      varZ = (*varIter)[5];
-      varT = (*varIter)[6];
-      isFillLabelx = ((*varIter)[7] == 1 ? true : false);
+      entry.fFill = &fillTHn<FillPlanEntry>;
+      entry.fFillBatch = &fillBatchTHn<FillPlanEntry>;
+      plan.push_back(entry);
+      continue;
     }
 
-    if (!isTHn) {
-      switch (dimension) {
-        case 1:
-          if (isProfile) {
-            if (varW > kNothing) {
-              if (isFillLabelx) {
-                (reinterpret_cast<TProfile*>(h))->Fill(Form("%d", static_cast<int>(values[varX])), values[varY], values[varW]);
-              } else {
-                (reinterpret_cast<TProfile*>(h))->Fill(values[varX], values[varY], values[varW]);
-              }
-            } else {
-              if (isFillLabelx) {
-                (reinterpret_cast<TProfile*>(h))->Fill(Form("%d", static_cast<int>(values[varX])), values[varY]);
-              } else {
-                (reinterpret_cast<TProfile*>(h))->Fill(values[varX], values[varY]);
-              }
-            }
-          } else {
-            if (varW > kNothing) {
-              if (isFillLabelx) {
-                (reinterpret_cast<TH1*>(h))->Fill(Form("%d", static_cast<int>(values[varX])), values[varW]);
-              } else {
-                (reinterpret_cast<TH1*>(h))->Fill(values[varX], values[varW]);
-              }
-            } else {
-              if (isFillLabelx) {
-                (reinterpret_cast<TH1*>(h))->Fill(Form("%d", static_cast<int>(values[varX])), 1.);
-              } else {
-                (reinterpret_cast<TH1*>(h))->Fill(values[varX]);
-              }
-            }
-          }
-          break;
-        case 2:
-          if (isProfile) {
-            if (varW > kNothing) {
-              (reinterpret_cast<TProfile2D*>(h))->Fill(values[varX], values[varY], values[varZ], values[varW]);
-            } else {
-              (reinterpret_cast<TProfile2D*>(h))->Fill(values[varX], values[varY], values[varZ]);
-            }
-          } else {
-            if (varW > kNothing) {
-              if (isFillLabelx) {
-                (reinterpret_cast<TH2*>(h))->Fill(Form("%d", static_cast<int>(values[varX])), values[varY], values[varW]);
-              } else {
-                (reinterpret_cast<TH2*>(h))->Fill(values[varX], values[varY], values[varW]);
-              }
-            } else {
-              if (isFillLabelx) {
-                (reinterpret_cast<TH2*>(h))->Fill(Form("%d", static_cast<int>(values[varX])), values[varY], 1.);
-              } else {
-                (reinterpret_cast<TH2*>(h))->Fill(values[varX], values[varY]);
-              }
-            }
-          }
-          break;
-        case 3:
-          if (isProfile) {
-            if (varW > kNothing) {
-              (reinterpret_cast<TProfile3D*>(h))->Fill(values[varX], values[varY], values[varZ], values[varT], values[varW]);
-            } else {
-              (reinterpret_cast<TProfile3D*>(h))->Fill(values[varX], values[varY], values[varZ], values[varT]);
-            }
-          } else {
-            if (varW > kNothing) {
-              (reinterpret_cast<TH3*>(h))->Fill(values[varX], values[varY], values[varZ], values[varW]);
-            } else {
-              (reinterpret_cast<TH3*>(h))->Fill(values[varX], values[varY], values[varZ]);
-            }
-          }
-          break;
-
-        default:
-          break;
-      } // end switch
-      // end if(!isTHn)
-    } else {
-      if (varW > kNothing) {
-        if (isSparse) {
-          (reinterpret_cast<THnSparse*>(h))->Fill(fillValues, values[varW]);
+    entry.fDimension = (reinterpret_cast<TH1*>(entry.fHist))->GetDimension();
+    for (int i = 0; i < 4; i++) {
+      entry.fVars[i] = (*varIter)[3 + i];
+    }
+    bool isFillLabelx = ((*varIter)[7] == 1 ? true : false);
+    switch (entry.fDimension) {
+      case 1:
+        if (isProfile) {
+          entry.fFill = (isFillLabelx ? &fillTProfileLabels<FillPlanEntry> : &fillTProfile<FillPlanEntry>);
+          entry.fFillBatch = (isFillLabelx ? &fillBatchTProfileLabels<FillPlanEntry> : &fillBatchTProfile<FillPlanEntry>);
         } else {
-          (reinterpret_cast<THn*>(h))->Fill(fillValues, values[varW]);
+          entry.fFill = (isFillLabelx ? &fillTH1Labels<FillPlanEntry> : &fillTH1<FillPlanEntry>);
+          entry.fFillBatch = (isFillLabelx ? &fillBatchTH1Labels<FillPlanEntry> : &fillBatchTH1<FillPlanEntry>);
         }
-      } else {
-        if (isSparse) {
-          (reinterpret_cast<THnSparse*>(h))->Fill(fillValues);
+        break;
+      case 2:
+        if (isProfile) {
+          entry.fFill = &fillTProfile2D<FillPlanEntry>;
+          entry.fFillBatch = &fillBatchTProfile2D<FillPlanEntry>;
         } else {
-          (reinterpret_cast<THn*>(h))->Fill(fillValues);
+          entry.fFill = (isFillLabelx ? &fillTH2Labels<FillPlanEntry> : &fillTH2<FillPlanEntry>);
+          entry.fFillBatch = (isFillLabelx ? &fillBatchTH2Labels<FillPlanEntry> : &fillBatchTH2<FillPlanEntry>);
         }
-      }
-    } // end else
+        break;
+      case 3:
+        entry.fFill = (isProfile ? &fillTProfile3D<FillPlanEntry> : &fillTH3<FillPlanEntry>);
+        entry.fFillBatch = (isProfile ? &fillBatchTProfile3D<FillPlanEntry> : &fillBatchTH3<FillPlanEntry>);
+        break;
+      default:
+        continue;
+    }
+    plan.push_back(entry);
   } // end loop over histograms
 }
 
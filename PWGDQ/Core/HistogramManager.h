@@ -41,7 +41,8 @@ class HistogramManager : public TNamed
   ~HistogramManager() override;
 
   enum Constants {
-    kNothing = -1
+    kNothing = -1,
+    kMaxFillDimensions = 20 // maximum number of axes handled when filling THn histograms
   };
 
   void SetMainHistogramList(THashList* list)
@@ -88,6 +89,17 @@ class HistogramManager : public TNamed
                     TString* axLabels = nullptr, int varW = -1, bool useSparse = kFALSE, bool isdouble = false);
 
   void FillHistClass(const char* className, float* values);
+  // Resolve a histogram class into an integer handle to be used with FillHistClass(int, float*)
+  // The handle is typically obtained once at init; returns kNothing if the class does not exist
+  // Histograms added to the class after the handle was created are picked up automatically
+  int GetHistClassHandle(const char* className);
+  // Fill a class of histograms using the pre-decoded fill plan behind the handle
+  void FillHistClass(int handle, float* values);
+  // Fill a class of histograms for a batch of nEntries objects stored as columns (structure-of-arrays)
+  // columns[var] must point to nEntries contiguous values for each variable used by the histograms of the class
+  //   (see VarManager::ValuesBatch)
+  void FillHistClassBatch(const char* className, int nEntries, const double* const* columns);
+  void FillHistClassBatch(int handle, int nEntries, const double* const* columns);
 
   void SetUseDefaultVariableNames(bool flag) { fUseDefaultVariableNames = flag; }
   void SetDefaultVarNames(TString* vars, TString* units);
@@ -99,11 +111,27 @@ class HistogramManager : public TNamed
   void Print(Option_t*) const override;
 
  private:
+  struct FillPlanEntry;
+  using FillFunction = void (*)(const FillPlanEntry& entry, const float* values);
+  using FillBatchFunction = void (*)(const FillPlanEntry& entry, int nEntries, const double* const* columns);
+  // flat, pre-decoded information needed to fill one histogram
+  struct FillPlanEntry {
+    TObject* fHist;                // histogram to be filled
+    FillFunction fFill;            // fill function specific to the histogram type
+    FillBatchFunction fFillBatch;  // column-wise fill function specific to the histogram type
+    int fDimension;                // number of axes; for profiles this does not include the averaged variable
+    int fVarW;                     // variable used for weighting
+    int fVars[kMaxFillDimensions]; // variables on each axis (for TProfile3D, the 4th one is the averaged variable)
+  };
+
   THashList* fMainList; // master histogram list
   int fNVars;           // number of variables handled (tipically from the Variable Manager)
 
   bool* fUsedVars;                                                  //! flags of used variables
   std::map<std::string, std::list<std::vector<int>>> fVariablesMap; //!  map holding identifiers for all variables needed by histograms
+  std::map<std::string, int> fClassHandles;                         //! map between histogram class names and fill plan handles
+  std::vector<std::string> fHandleClassNames;                       //! histogram class name for each handle
+  std::vector<std::vector<FillPlanEntry>> fFillPlans;               //! pre-decoded fill plans, indexed by handle
 
   // various
   bool fUseDefaultVariableNames; //! toggle the usage of default variable names and units
@@ -112,6 +140,8 @@ class HistogramManager : public TNamed
   TString* fVariableUnits;       //! variable units
 
   void MakeAxisLabels(TAxis* ax, const char* labels);
+  void BuildFillPlan(int handle);
+  void UpdateFillPlan(const char* histClass);
 
   HistogramManager& operator=(const HistogramManager& c);
   HistogramManager(const HistogramManager& c);
@@ -17,6 +17,7 @@
 
 #include <Rtypes.h>
 
+#include <cstddef>
 #include <cstdint>
 #include <iostream>
 #include <vector>
@@ -85,6 +86,14 @@ void MCSignal::AddProng(MCProng prong, int8_t commonAncestor)
   }
 }
 
+//________________________________________________________________________________________________
+void MCSignal::ResetCache(std::size_t nMCParticles)
+{
+  fCacheSize = nMCParticles;
+  fCacheDecisions.assign(2 * fNProngs, {});
+  fCacheAncestorLabels.assign(2 * fNProngs, {});
+}
+
 //________________________________________________________________________________________________
 void MCSignal::PrintConfig()
 {
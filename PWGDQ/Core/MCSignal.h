@@ -60,6 +60,7 @@ process(aod::McParticles const& mcTracks) {
 
 #include <TNamed.h>
 
+#include <cstddef>
 #include <cstdint>
 #include <vector>
 
@@ -117,6 +118,11 @@ class MCSignal : public TNamed
     return CheckMC(0, checkSources, args...);
   };
 
+  // Enable the cache of the prong decisions for a table of nMCParticles MC particles, identified by their global index.
+  // The decision of each prong and the common ancestor of each MC particle are then computed once and reused by all the
+  //   signal checks involving this particle. It has to be called again for each new table of MC particles.
+  void ResetCache(std::size_t nMCParticles);
+
   void PrintConfig();
 
  private:
@@ -129,8 +135,16 @@ class MCSignal : public TNamed
   int fNAncestorDirectProngs;              // number of direct prongs belonging to the common ancestor specified by this signal
   int fTempAncestorLabel;
 
+  std::size_t fCacheSize = 0;                         //! number of MC particles of the cached table, 0 if the cache is disabled
+  std::vector<std::vector<int8_t>> fCacheDecisions;   //! per prong and checkSources value: -1 if not computed, 0 if rejected, 1 if accepted
+  std::vector<std::vector<int>> fCacheAncestorLabels; //! per prong and checkSources value: label of the particle at the common ancestor generation
+
   template <typename T>
   bool CheckProng(int i, bool checkSources, const T& track);
+  template <typename T>
+  bool CheckProngCached(int i, bool checkSources, const T& track, int& ancestorLabel);
+  template <typename T>
+  bool CheckProngHistory(int i, bool checkSources, const T& track, int& ancestorLabel);
 
   bool CheckMC(int, bool)
   {
@@ -151,6 +165,57 @@ class MCSignal : public TNamed
 
 template <typename T>
 bool MCSignal::CheckProng(int i, bool checkSources, const T& track)
+{
+  int ancestorLabel = -1;
+  if (!CheckProngCached(i, checkSources, track, ancestorLabel)) {
+    return false;
+  }
+  // check the common ancestor (if specified)
+  if (ancestorLabel > -1) {
+    if (i == 0) {
+      fTempAncestorLabel = ancestorLabel;
+    } else {
+      if (ancestorLabel != fTempAncestorLabel && !fExcludeCommonAncestor)
+        return false;
+      else if (ancestorLabel == fTempAncestorLabel && fExcludeCommonAncestor)
+        return false;
+    }
+  }
+  return true;
+}
+
+template <typename T>
+bool MCSignal::CheckProngCached(int i, bool checkSources, const T& track, int& ancestorLabel)
+{
+  const auto index = static_cast<std::size_t>(track.globalIndex());
+  if (index >= fCacheSize) {
+    return CheckProngHistory(i, checkSources, track, ancestorLabel);
+  }
+  const int slot = 2 * i + (checkSources ? 1 : 0);
+  auto& decisions = fCacheDecisions[slot];
+  if (decisions.empty()) {
+    decisions.assign(fCacheSize, -1);
+    if (fNProngs > 1) {
+      fCacheAncestorLabels[slot].assign(fCacheSize, -1);
+    }
+  }
+  if (decisions[index] < 0) {
+    int label = -1;
+    decisions[index] = CheckProngHistory(i, checkSources, track, label) ? 1 : 0;
+    if (fNProngs > 1) {
+      fCacheAncestorLabels[slot][index] = label;
+    }
+  }
+  if (fNProngs > 1) {
+    ancestorLabel = fCacheAncestorLabels[slot][index];
+  }
+  return decisions[index] == 1;
+}
+
+// Checks the prong requirements on the history of the track. The label of the particle at the common ancestor generation,
+//   compared among the prongs by CheckProng, is returned in ancestorLabel (-1 if there is no common ancestor to check)
+template <typename T>
+bool MCSignal::CheckProngHistory(int i, bool checkSources, const T& track, int& ancestorLabel)
 {
   using P = typename T::parent_t;
   auto currentMCParticle = track;
@@ -161,10 +226,10 @@ bool MCSignal::CheckProng(int i, bool checkSources, const T& track)
     if (!fProngs[i].TestPDG(j, currentMCParticle.pdgCode())) {
       return false;
     }
-    // check the common ancestor (if specified)
+    // record the common ancestor (if specified)
     if (fNProngs > 1 && fCommonAncestorIdxs[i] == j) {
+      ancestorLabel = currentMCParticle.globalIndex();
       if (i == 0) {
-        fTempAncestorLabel = currentMCParticle.globalIndex();
         // In the case of decay channels marked as being "exclusive", check how many decay daughters this mother has registered
         //   in the stack and compare to the number of prongs defined for this MCSignal.
         //  If these numbers are equal, it means this decay MCSignal match is exclusive (there are no additional prongs for this mother besides the
@@ -177,11 +242,6 @@ bool MCSignal::CheckProng(int i, bool checkSources, const T& track)
             return false;
           }
         }
-      } else {
-        if (currentMCParticle.globalIndex() != fTempAncestorLabel && !fExcludeCommonAncestor)
-          return false;
-        else if (currentMCParticle.globalIndex() == fTempAncestorLabel && fExcludeCommonAncestor)
-          return false;
       }
     }
 
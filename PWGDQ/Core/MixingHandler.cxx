@@ -31,6 +31,8 @@ MixingHandler::MixingHandler() : TNamed(),
                                  fVariableLimits(),
                                  fVariables(),
                                  fPoolDepth(0),
+                                 fPoolTrackCapacity1(0),
+                                 fPoolTrackCapacity2(0),
                                  fPools()
 {
   //
@@ -44,6 +46,8 @@ MixingHandler::MixingHandler(const char* name, const char* title) : TNamed(name,
                                                                     fVariableLimits(),
                                                                     fVariables(),
                                                                     fPoolDepth(0),
+                                                                    fPoolTrackCapacity1(0),
+                                                                    fPoolTrackCapacity2(0),
                                                                     fPools()
 {
   //
@@ -106,12 +110,26 @@ void MixingHandler::Init()
     nCategories *= (fVariableLimits[var.second].size() - 1);
   }
   // add elements in the map for each category (the key is the category and the value is an empty pool)
+  // NOTE: the track storage of each pool is allocated only when the first event is added to it
   for (int i = 0; i < nCategories; i++) {
-    fPools[i] = MixingPool();
+    fPools[i].Configure(fPoolDepth, fPoolTrackCapacity1, fPoolTrackCapacity2);
   }
   fIsInitialized = true;
 }
 
+//_________________________________________________________________________
+MixingHandler::MixingPool& MixingHandler::GetPool(int category)
+{
+  //
+  // Get the pool for a given category, configuring it if not done already
+  //
+  auto& pool = fPools[category];
+  if (!pool.IsConfigured()) {
+    pool.Configure(fPoolDepth, fPoolTrackCapacity1, fPoolTrackCapacity2);
+  }
+  return pool;
+}
+
 //_________________________________________________________________________
 int MixingHandler::FindEventCategory(float* values)
 {
@@ -25,9 +25,10 @@
 #include <Rtypes.h>
 
 #include <algorithm>
-#include <array>
+#include <cstdint>
 #include <iostream>
 #include <map>
+#include <span>
 #include <vector>
 
 class MixingHandler : public TNamed
@@ -48,125 +49,176 @@ class MixingHandler : public TNamed
     }
   };
 
-  // Struct to define events used in mixing and few utility functions.
-  // An event is defined as two vectors of tracks (typically the legs of a two-body
-  // decay or the two-particles in a correlation analysis)
-  struct MixingEvent {
-    std::vector<MixingTrack> tracks1;
-    std::vector<MixingTrack> tracks2;
-    // bit map for active filtering bits of all the tracks
-    uint32_t filteringMask = 0;
-    // counters to keep track of how many times the event was used for mixing (for each track cut separately)
-    std::array<short, 64> counters = {0};
-    // add a track to the event and update the filtering mask accordingly
+  // View of one event stored in a mixing pool: the two track lists point directly into the pool storage
+  struct MixingEventView {
+    std::span<const MixingTrack> tracks1;
+    std::span<const MixingTrack> tracks2;
+    uint32_t filteringMask = 0; // bit map for active filtering bits of all the tracks
+  };
+
+  // Pair of events to be mixed: the current event and one of the events in the pool
+  struct MixingEventPair {
+    MixingEventView current;
+    MixingEventView pooled;
+  };
+
+  // Pool of events for one mixing category, implemented as a ring buffer with a fixed number of event slots.
+  // The tracks of all the slots are kept in two contiguous arrays (one per track list), with a fixed number of tracks per slot.
+  // The slot following the most recent event is used to stage the current event, so that the current event is
+  // filled in place and committed to the pool without copies. Once the pool is full, the oldest event is overwritten.
+  // The storage is allocated when the first event is staged and grows only if an event has more tracks than the slot capacity,
+  // such that the memory stays constant once the largest events have been seen.
+  class MixingPool
+  {
+   public:
+    // forward iterator over the pooled events (most recent first), yielding pairs of (current event, pooled event)
+    class Iterator
+    {
+     public:
+      Iterator(const MixingPool* pool, int index) : fPool(pool), fIndex(index) {}
+      MixingEventPair operator*() const { return {fPool->GetCurrentEvent(), fPool->GetEvent(fIndex)}; }
+      Iterator& operator++()
+      {
+        ++fIndex;
+        return *this;
+      }
+      bool operator==(const Iterator& other) const { return fIndex == other.fIndex; }
+      bool operator!=(const Iterator& other) const { return fIndex != other.fIndex; }
+
+     private:
+      const MixingPool* fPool;
+      int fIndex;
+    };
+
+    MixingPool() = default;
+    MixingPool(int depth, int maxTracks1 = 0, int maxTracks2 = 0) { Configure(depth, maxTracks1, maxTracks2); }
+
+    // set the pool depth and the initial track capacity of each event slot; the pool is emptied
+    void Configure(int depth, int maxTracks1 = 0, int maxTracks2 = 0)
+    {
+      fDepth = std::max(depth, 0);
+      fCapacity1 = std::max(maxTracks1, 0);
+      fCapacity2 = std::max(maxTracks2, 0);
+      fTracks1.clear();
+      fTracks2.clear();
+      fNTracks1.clear();
+      fNTracks2.clear();
+      fMasks.clear();
+      fHead = 0;
+      fNEvents = 0;
+    }
+    bool IsConfigured() const { return fDepth > 0; }
+
+    // start a new current event in the staging slot (any previous uncommitted event is discarded)
+    void StartEvent()
+    {
+      if (fMasks.empty()) {
+        Allocate(fCapacity1, fCapacity2);
+      }
+      fNTracks1[fHead] = 0;
+      fNTracks2[fHead] = 0;
+      fMasks[fHead] = 0;
+    }
+    // add a track to the current event and update the filtering mask accordingly
     void AddTrack1(const MixingTrack& track)
     {
-      tracks1.push_back(track);
-      filteringMask |= track.filteringFlags;
+      if (fNTracks1[fHead] == fCapacity1) {
+        Allocate(std::max(2 * fCapacity1, 16), fCapacity2);
+      }
+      fTracks1[fHead * fCapacity1 + fNTracks1[fHead]++] = track;
+      fMasks[fHead] |= track.filteringFlags;
     }
     void AddTrack2(const MixingTrack& track)
     {
-      tracks2.push_back(track);
-      filteringMask |= track.filteringFlags;
+      if (fNTracks2[fHead] == fCapacity2) {
+        Allocate(fCapacity1, std::max(2 * fCapacity2, 16));
+      }
+      fTracks2[fHead * fCapacity2 + fNTracks2[fHead]++] = track;
+      fMasks[fHead] |= track.filteringFlags;
     }
-    // Clear bits in the filtering mask.
-    void ClearFilteringMask(uint32_t mask) { filteringMask &= ~mask; }
-    // 1) increment the counters for a given track cut bit mask and if the counters reached the pool depth,
-    // 2) clear the corresponding bit in the tracks filtering flags to exclude them from further mixing
-    // 3) for each track, if there are no more active bits in the filtering mask, then remove the track from the event
-    void IncrementCounters(uint32_t mask, short poolDepth)
+    // add the current event to the pool, overwriting the oldest event if the pool is full
+    // Events without tracks are not kept, since they do not contribute to the mixing
+    void CommitEvent()
     {
-      for (int i = 0; i < 32; i++) {
-        uint32_t bitMask = (static_cast<uint32_t>(1) << i);
-        if (mask & bitMask) {
-          counters[i]++;
-          if (counters[i] >= poolDepth) {
-            for (auto& track : tracks1) {
-              track.ClearBit(bitMask);
-            }
-            for (auto track = tracks1.begin(); track != tracks1.end();) {
-              if (track->filteringFlags == 0) {
-                track = tracks1.erase(track);
-              } else {
-                ++track;
-              }
-            }
-
-            for (auto& track : tracks2) {
-              track.ClearBit(bitMask);
-            }
-            for (auto track = tracks2.begin(); track != tracks2.end();) {
-              if (track->filteringFlags == 0) {
-                track = tracks2.erase(track);
-              } else {
-                ++track;
-              }
-            }
-            ClearFilteringMask(bitMask);
-          }
-        }
+      if (fMasks.empty() || (fNTracks1[fHead] == 0 && fNTracks2[fHead] == 0)) {
+        return;
       }
+      fHead = (fHead + 1) % GetNSlots();
+      fNEvents = std::min(fNEvents + 1, fDepth);
     }
+
+    // getters for the events: the current (staged) event and the pooled events, index 0 being the most recent one
+    MixingEventView GetCurrentEvent() const { return GetSlot(fHead); }
+    MixingEventView GetEvent(int i) const { return GetSlot((fHead + GetNSlots() - 1 - i) % GetNSlots()); }
+    int GetNEvents() const { return fNEvents; }
+    int GetDepth() const { return fDepth; }
+    Iterator begin() const { return Iterator(this, 0); }
+    Iterator end() const { return Iterator(this, fNEvents); }
+
     void Print() const
     {
-      std::cout << "Event filtering mask: ";
-      for (int i = 0; i < 32; i++) {
-        if (filteringMask & (1ULL << i)) {
-          std::cout << "1";
-        } else {
-          std::cout << "0";
+      std::cout << "Mixing pool with " << fNEvents << " events (depth " << fDepth << ", track capacity per event " << fCapacity1 << " / " << fCapacity2 << "):" << std::endl;
+      for (int i = 0; i < fNEvents; ++i) {
+        auto event = GetEvent(i);
+        std::cout << "Event " << i << ", filtering mask " << event.filteringMask << std::endl;
+        std::cout << "Tracks 1: " << std::endl;
+        for (const auto& track : event.tracks1) {
+          track.Print();
         }
-      }
-      std::cout << std::endl;
-      for (int i = 0; i < 32; i++) {
-        if (filteringMask & (1ULL << i)) {
-          std::cout << "Counter " << i << ": " << counters[i] << std::endl;
+        std::cout << "Tracks 2: " << std::endl;
+        for (const auto& track : event.tracks2) {
+          track.Print();
         }
       }
-      std::cout << "Tracks 1: " << std::endl;
-      for (const auto& track : tracks1) {
-        track.Print();
-      }
-      std::cout << "Tracks 2: " << std::endl;
-      for (const auto& track : tracks2) {
-        track.Print();
-      }
     }
-  };
 
-  struct MixingPool {
-    std::vector<MixingEvent> events;
+   private:
+    int fDepth = 0;     // maximum number of events kept in the pool
+    int fCapacity1 = 0; // number of tracks1 per event slot
+    int fCapacity2 = 0; // number of tracks2 per event slot
+    int fHead = 0;      // slot used for the current event; the most recent pooled event is in the slot before it
+    int fNEvents = 0;   // number of events in the pool
+
+    std::vector<MixingTrack> fTracks1; // contiguous track storage, fCapacity1 tracks for each slot
+    std::vector<MixingTrack> fTracks2; // contiguous track storage, fCapacity2 tracks for each slot
+    std::vector<int> fNTracks1;        // number of tracks1 in each slot
+    std::vector<int> fNTracks2;        // number of tracks2 in each slot
+    std::vector<uint32_t> fMasks;      // filtering mask of each slot
 
-    // check which events in the pool are empty (i.e. no active tracks for mixing) and remove them from the pool
-    void CleanPool()
+    int GetNSlots() const { return fDepth + 1; }
+    MixingEventView GetSlot(int slot) const
     {
-      for (auto event = events.begin(); event != events.end();) {
-        if (event->tracks1.empty() && event->tracks2.empty()) {
-          event = events.erase(event);
-        } else {
-          ++event;
-        }
+      if (fMasks.empty()) {
+        return {};
       }
+      return {std::span<const MixingTrack>(fTracks1.data() + slot * fCapacity1, fNTracks1[slot]),
+              std::span<const MixingTrack>(fTracks2.data() + slot * fCapacity2, fNTracks2[slot]),
+              fMasks[slot]};
     }
-    // The function that performs the mixing is called outside this class, but the pool provides the events and tracks to be mixed and takes care of updating the events after mixing
-    // (e.g. incrementing the counters and removing the tracks that reached the pool depth for a given cut)
-    void UpdatePool(const MixingEvent& event, short poolDepth)
+    // (re)allocate the track storage with the given capacity per slot, keeping the stored events
+    void Allocate(int capacity1, int capacity2)
     {
-      for (auto& event : events) {
-        event.IncrementCounters(event.filteringMask, poolDepth);
+      int nSlots = GetNSlots();
+      if (fMasks.empty()) {
+        fNTracks1.assign(nSlots, 0);
+        fNTracks2.assign(nSlots, 0);
+        fMasks.assign(nSlots, 0);
+      }
+      if (capacity1 != fCapacity1 || fTracks1.empty()) {
+        Restride(fTracks1, fNTracks1, fCapacity1, capacity1);
+      }
+      if (capacity2 != fCapacity2 || fTracks2.empty()) {
+        Restride(fTracks2, fNTracks2, fCapacity2, capacity2);
       }
-      CleanPool();
-      events.push_back(event);
     }
-    // getter for the events in the pool
-    const std::vector<MixingEvent>& GetEvents() const { return events; }
-
-    void Print() const
+    void Restride(std::vector<MixingTrack>& tracks, const std::vector<int>& nTracks, int& capacity, int newCapacity)
     {
-      std::cout << "Mixing pool with " << events.size() << " events:" << std::endl;
-      for (const auto& event : events) {
-        event.Print();
+      std::vector<MixingTrack> newTracks(GetNSlots() * newCapacity);
+      for (int slot = 0; slot < GetNSlots() && !tracks.empty(); ++slot) {
+        std::copy_n(tracks.begin() + slot * capacity, nTracks[slot], newTracks.begin() + slot * newCapacity);
       }
+      tracks.swap(newTracks);
+      capacity = newCapacity;
     }
   };
 
@@ -177,12 +229,18 @@ class MixingHandler : public TNamed
   // setters
   void AddMixingVariable(int var, std::vector<float> binLims);
   void SetPoolDepth(short depth) { fPoolDepth = depth; }
+  // initial track capacity of each event slot in the pools; the pools grow if events with more tracks are found
+  void SetPoolTrackCapacity(int maxTracks1, int maxTracks2)
+  {
+    fPoolTrackCapacity1 = maxTracks1;
+    fPoolTrackCapacity2 = maxTracks2;
+  }
 
   // getters
   // int GetNMixingVariables() const { return fVariables.size(); }
   // int GetMixingVariable(VarManager::Variables var); // returns the position in the internal varible list of the handler. Useful for checks, mostly
   // std::vector<float> GetMixingVariableLimits(VarManager::Variables var);
-  MixingPool& GetPool(int category) { return fPools[category]; }
+  MixingPool& GetPool(int category);
   short GetPoolDepth() const { return fPoolDepth; }
 
   void Init();
@@ -201,9 +259,11 @@ class MixingHandler : public TNamed
   std::map<int, int> fVariables; // key: variable, value: position in the internal variable list of the handler (used to map the variables to the values passed to FindEventCategory)
 
   short fPoolDepth;                 // number of events to be kept in each pool
-  std::map<int, MixingPool> fPools; // key: category, value: pool of events corresponding to that category
+  int fPoolTrackCapacity1;          // initial number of tracks1 per event in each pool
+  int fPoolTrackCapacity2;          // initial number of tracks2 per event in each pool
+  std::map<int, MixingPool> fPools; //! key: category, value: pool of events corresponding to that category
 
-  ClassDef(MixingHandler, 2);
+  ClassDef(MixingHandler, 3);
 };
 
 #endif // PWGDQ_CORE_MIXINGHANDLER_H_
@@ -20,6 +20,7 @@
 #include <DataFormatsParameters/GRPLHCIFData.h>
 #include <Framework/Logger.h>
 #include <GlobalTracking/MatchGlobalFwd.h>
+#include <ReconstructionDataFormats/GlobalFwdTrack.h>
 
 #include <Math/Vector4D.h> // IWYU pragma: keep (do not replace with Math/Vector4Dfwd.h)
 #include <Math/Vector4Dfwd.h>
@@ -49,11 +50,16 @@ TString VarManager::fgVariableNames[VarManager::kNVars] = {""};
 TString VarManager::fgVariableUnits[VarManager::kNVars] = {""};
 std::map<TString, int> VarManager::fgVarNamesMap;
 bool VarManager::fgUsedVars[VarManager::kNVars] = {false};
+std::vector<int> VarManager::fgUsedVarsList;
+bool VarManager::fgUsedVarGroups[VarManager::kNVarGroups] = {true};
+bool VarManager::fgSkipUnusedVarGroups = false;
 bool VarManager::fgUsedKF = false;
 bool VarManager::fgPVrecalKF = true;
 float VarManager::fgMagField = 0.5;
 float VarManager::fgzMatching = -77.5;
 float VarManager::fgzShiftFwd = 0.0;
+bool VarManager::fgUseMuonPropagationCache = false;
+std::map<std::tuple<int64_t, int64_t, int>, o2::dataformats::GlobalFwdTrack> VarManager::fgMuonPropagationCache;
 float VarManager::fgValues[VarManager::kNVars] = {0.0f};
 float VarManager::fgTPCInterSectorBoundary = 1.0; // cm
 int VarManager::fgITSROFbias = 0;
@@ -123,6 +129,62 @@ void VarManager::SetVariableDependencies()
   if (fgUsedVars[kTrackIsInsideTPCModule]) {
     fgUsedVars[kPhiTPCOuter] = true;
   }
+  UpdateUsedVarsList();
+}
+
+//__________________________________________________________________
+void VarManager::UpdateUsedVarsList()
+{
+  //
+  // Build the compact list of used variables and flag the variable groups which need to be computed
+  //
+  fgUsedVarsList.clear();
+  for (int i = 0; i < kNVars; ++i) {
+    if (fgUsedVars[i]) {
+      fgUsedVarsList.push_back(i);
+    }
+  }
+
+  // variables computed by the secondary vertexing
+  static const int vertexingVars[] = {
+    kVertexingLxy, kVertexingLxyErr, kVertexingPseudoCTau, kVertexingLxyz, kVertexingLxyzErr, kVertexingLz, kVertexingLzErr,
+    kVertexingTauxy, kVertexingTauxyErr, kVertexingLzProjected, kVertexingLxyProjected, kVertexingLxyProjectedRecalculatePV,
+    kVertexingLxyzProjected, kVertexingTauzProjected, kVertexingTauxyProjected, kVertexingTauxyProjectedPoleJPsiMass,
+    kVertexingTauxyProjectedPoleJPsiMassRecalculatePV, kVertexingTauxyProjectedNs, kVertexingTauxyzProjected, kVertexingTauz,
+    kVertexingTauzErr, kVertexingPz, kVertexingSV, kVertexingProcCode, kVertexingChi2PCA, kCosPointingAngle,
+    kVertexingLxyOverErr, kVertexingLzOverErr, kVertexingLxyzOverErr, kKFMass, kKFMassGeoTop,
+    kKFTrack0DCAxyz, kKFTrack1DCAxyz, kKFTracksDCAxyzMax, kKFDCAxyzBetweenProngs, kKFTrack0DCAxy, kKFTrack1DCAxy,
+    kKFTracksDCAxyMax, kKFDCAxyBetweenProngs, kKFTrack0DeviationFromPV, kKFTrack1DeviationFromPV, kKFTrack0DeviationxyFromPV,
+    kKFTrack1DeviationxyFromPV, kKFChi2OverNDFGeo, kKFNContributorsPV, kKFCosPA, kKFChi2OverNDFGeoTop, kKFJpsiDCAxyz,
+    kKFJpsiDCAxy, kKFPairDeviationFromPV, kKFPairDeviationxyFromPV};
+  fgUsedVarGroups[kVarGroupVertexing] = !fgSkipUnusedVarGroups;
+  for (auto var : vertexingVars) {
+    if (fgUsedVars[var]) {
+      fgUsedVarGroups[kVarGroupVertexing] = true;
+      break;
+    }
+  }
+}
+
+//__________________________________________________________________
+VarManager::ValuesBatch::ValuesBatch(int capacity) : fCapacity(capacity),
+                                                     fSize(0),
+                                                     fVariables(),
+                                                     fData(),
+                                                     fColumns(kNVars, nullptr)
+{
+  //
+  // constructor; allocate one column for each of the currently used variables
+  //
+  for (int i = 0; i < kNVars; ++i) {
+    if (fgUsedVars[i]) {
+      fVariables.push_back(i);
+    }
+  }
+  fData.resize(fVariables.size() * fCapacity, 0.0);
+  for (std::size_t i = 0; i < fVariables.size(); ++i) {
+    fColumns[fVariables[i]] = fData.data() + i * fCapacity;
+  }
 }
 
 //__________________________________________________________________
@@ -77,6 +77,7 @@
 #include <array>
 #include <cmath>
 #include <complex>
+#include <cstddef>
 #include <cstdint>
 #include <map>
 #include <numbers>
@@ -1153,6 +1154,12 @@ class VarManager : public TObject
     kITSUPCMode
   };
 
+  // Groups of variables computed together by expensive algorithms, which are skipped altogether when none of their outputs are used
+  enum VarGroups {
+    kVarGroupVertexing = 0, // secondary vertexing with the DCA fitter or KFParticle (FillPairVertexing, FillDileptonTrackVertexing)
+    kNVarGroups
+  };
+
   enum MuonExtrapolation {
     // Index used to set different options for Muon propagation
     kToVertex = 0, // propagtion to vertex by default
@@ -1187,6 +1194,7 @@ class VarManager : public TObject
     for (auto& var : usedVars) {
       fgUsedVars[var] = true;
     }
+    UpdateUsedVarsList();
   }
   static bool GetUsedVar(int var)
   {
@@ -1195,6 +1203,22 @@ class VarManager : public TObject
     }
     return false;
   }
+  // sorted list with the identifiers of all the used variables
+  static const std::vector<int>& GetUsedVarsList()
+  {
+    return fgUsedVarsList;
+  }
+  static bool GetUsedVarGroup(VarGroups group)
+  {
+    return fgUsedVarGroups[group];
+  }
+  // If enabled, groups of variables (see VarGroups) are not computed when none of their variables are flagged as used
+  // NOTE: Tasks which read such variables directly from the values array (e.g. when writing tables) must flag them via SetUseVariable()
+  static void SetSkipUnusedVarGroups(bool skip)
+  {
+    fgSkipUnusedVarGroups = skip;
+    UpdateUsedVarsList();
+  }
 
   // Flag to  set PV recalculation via KF
   static void SetPVrecalculationKF(const bool pvRecalKF)
@@ -1209,12 +1233,14 @@ class VarManager : public TObject
   static void SetMagneticField(float magField)
   {
     fgMagField = magField;
+    fgMuonPropagationCache.clear();
   }
 
   // Setup plane position for MFT-MCH matching
   static void SetMatchingPlane(float z)
   {
     fgzMatching = z;
+    fgMuonPropagationCache.clear();
   }
 
   static float GetMatchingPlane()
@@ -1226,6 +1252,22 @@ class VarManager : public TObject
   static void SetZShift(float z)
   {
     fgzShiftFwd = z;
+    fgMuonPropagationCache.clear();
+  }
+
+  // Cache of the muon propagations, keyed by the muon and collision indices and the end point.
+  // The same muon is often propagated several times to the same collision (e.g. when filling the track variables,
+  // the pDCA and the global muon refit). The indices are only unique within a DF and a table, so the cache has to be
+  // reset for every DF and should be used only if the muons and collisions passed to PropagateMuon come each from a single table.
+  static void SetUseMuonPropagationCache(bool useCache)
+  {
+    fgUseMuonPropagationCache = useCache;
+    fgMuonPropagationCache.clear();
+  }
+
+  static void ResetMuonPropagationCache()
+  {
+    fgMuonPropagationCache.clear();
   }
 
   // Setup the 2 prong KFParticle
@@ -1238,6 +1280,7 @@ class VarManager : public TObject
   static void SetupMuonMagField()
   {
     o2::mch::TrackExtrap::setField();
+    fgMuonPropagationCache.clear();
   }
 
   // Setup the 2 prong DCAFitterN
@@ -1347,6 +1390,8 @@ class VarManager : public TObject
   template <typename T, typename C>
   static o2::dataformats::GlobalFwdTrack PropagateMuon(const T& muon, const C& collision, int endPoint = kToVertex);
   template <typename T, typename C>
+  static o2::dataformats::GlobalFwdTrack PropagateMuonNoCache(const T& muon, const C& collision, int endPoint);
+  template <typename T, typename C>
   static o2::track::TrackParCovFwd PropagateFwd(const T& track, const C& cov, float z);
   template <uint32_t fillMap, typename T, typename C>
   static void FillMuonPDca(const T& muon, const C& collision, float* values = nullptr);
@@ -1531,8 +1576,52 @@ class VarManager : public TObject
   static float fgValues[kNVars]; // array holding all variables computed during analysis
   static void ResetValues(int startValue = 0, int endValue = kNVars, float* values = nullptr);
 
+  // Structure-of-arrays buffer holding, for a batch of objects (e.g. tracks or pairs), only the variables flagged as used
+  // The list of stored variables is frozen at construction, so the batch should be created after all calls to SetUseVars()
+  // Typical usage: call Add() after each Fill*() call and, once IsFull(), pass GetColumns() to HistogramManager::FillHistClassBatch()
+  //   and Clear() the batch. Add() must not be called on a full batch.
+  class ValuesBatch
+  {
+   public:
+    explicit ValuesBatch(int capacity = 1024);
+    // the column pointers refer to the owned storage, so the batch can be moved but not copied
+    ValuesBatch(const ValuesBatch&) = delete;
+    ValuesBatch& operator=(const ValuesBatch&) = delete;
+    ValuesBatch(ValuesBatch&&) = default;
+    ValuesBatch& operator=(ValuesBatch&&) = default;
+
+    void Add(const float* values = nullptr)
+    {
+      if (!values) {
+        values = fgValues;
+      }
+      for (std::size_t i = 0; i < fVariables.size(); ++i) {
+        fData[i * fCapacity + fSize] = values[fVariables[i]];
+      }
+      fSize++;
+    }
+    void Clear() { fSize = 0; }
+    bool IsFull() const { return fSize >= fCapacity; }
+    int GetSize() const { return fSize; }
+    int GetCapacity() const { return fCapacity; }
+    const std::vector<int>& GetVariables() const { return fVariables; }
+    // columns indexed by the variable identifier; nullptr for the variables which are not stored
+    const double* const* GetColumns() const { return fColumns.data(); }
+
+   private:
+    int fCapacity;
+    int fSize;
+    std::vector<int> fVariables;         // identifiers of the stored variables
+    std::vector<double> fData;           // contiguous storage, one column of fCapacity entries per stored variable
+    std::vector<const double*> fColumns; // kNVars column pointers into fData
+  };
+
  private:
-  static bool fgUsedVars[kNVars]; // holds flags for when the corresponding variable is needed (e.g., in the histogram manager, in cuts, mixing handler, etc.)
+  static bool fgUsedVars[kNVars];           // holds flags for when the corresponding variable is needed (e.g., in the histogram manager, in cuts, mixing handler, etc.)
+  static std::vector<int> fgUsedVarsList;   // compact, sorted list of the used variables
+  static bool fgUsedVarGroups[kNVarGroups]; // flags for the variable groups which need to be computed
+  static bool fgSkipUnusedVarGroups;        // if true, the variable groups without used variables are not computed
+  static void UpdateUsedVarsList();         // rebuild the list of used variables and the group flags
   static bool fgUsedKF;
   static bool fgPVrecalKF;
   static void SetVariableDependencies(); // toggle those variables on which other used variables might depend
@@ -1575,6 +1664,10 @@ class VarManager : public TObject
   static o2::vertexing::FwdDCAFitterN<3> fgFitterThreeProngFwd;
   static o2::globaltracking::MatchGlobalFwd mMatching;
 
+  // propagated muons, keyed by (muon index, collision index, end point), filled only if fgUseMuonPropagationCache is set
+  static bool fgUseMuonPropagationCache;
+  static std::map<std::tuple<int64_t, int64_t, int>, o2::dataformats::GlobalFwdTrack> fgMuonPropagationCache;
+
   static std::map<CalibObjects, TObject*> fgCalibs; // map of calibration histograms
   static bool fgRunTPCPostCalibration[4];           // 0-electron, 1-pion, 2-kaon, 3-proton
   static int fgCalibrationType;                     // 0 - no calibration, 1 - calibration vs (TPCncls,pIN,eta) typically for pp, 2 - calibration vs (eta,nPV,nLong,tLong) typically for PbPb
@@ -1721,6 +1814,22 @@ o2::dataformats::VertexBase VarManager::RecalculatePrimaryVertex(T const& track0
 
 template <typename T, typename C>
 o2::dataformats::GlobalFwdTrack VarManager::PropagateMuon(const T& muon, const C& collision, const int endPoint)
+{
+  if constexpr (requires { muon.globalIndex(); collision.globalIndex(); }) {
+    if (fgUseMuonPropagationCache) {
+      auto key = std::make_tuple(static_cast<int64_t>(muon.globalIndex()), static_cast<int64_t>(collision.globalIndex()), endPoint);
+      auto found = fgMuonPropagationCache.find(key);
+      if (found != fgMuonPropagationCache.end()) {
+        return found->second;
+      }
+      return fgMuonPropagationCache.emplace(key, PropagateMuonNoCache(muon, collision, endPoint)).first->second;
+    }
+  }
+  return PropagateMuonNoCache(muon, collision, endPoint);
+}
+
+template <typename T, typename C>
+o2::dataformats::GlobalFwdTrack VarManager::PropagateMuonNoCache(const T& muon, const C& collision, const int endPoint)
 {
   o2::track::TrackParCovFwd fwdtrack = o2::aod::fwdtrackutils::getTrackParCovFwdShift(muon, fgzShiftFwd, muon);
   o2::dataformats::GlobalFwdTrack propmuon;
@@ -4623,7 +4732,9 @@ void VarManager::FillPairVertexing(C const& collision, T const& t1, T const& t2,
   ROOT::Math::PtEtaPhiMVector v12 = v1 + v2;
 
   values[kUsedKF] = fgUsedKF;
-  if (!fgUsedKF) {
+  // the vertexing is skipped if none of its outputs are used and the pair kinematics does not need to be recomputed at the SV
+  bool doVertexing = propToSV || fgUsedVarGroups[kVarGroupVertexing];
+  if (!fgUsedKF && doVertexing) {
     int procCode = 0;
 
     // TODO: use trackUtilities functions to initialize the various matrices to avoid code duplication
@@ -4767,7 +4878,7 @@ void VarManager::FillPairVertexing(C const& collision, T const& t1, T const& t2,
       values[kVertexingTauzProjected] = values[kVertexingLzProjected] * v12.M() / TMath::Abs(v12.Pz());
       values[kVertexingTauxyzProjected] = values[kVertexingLxyzProjected] * v12.M() / (v12.P());
     }
-  } else {
+  } else if (doVertexing) {
     KFParticle trk0KF;
     KFParticle trk1KF;
     KFParticle KFGeoTwoProng;
@@ -5294,8 +5405,10 @@ void VarManager::FillDileptonTrackVertexing(C const& collision, T1 const& lepton
       o2::track::TrackParCovFwd pars2 = FwdToTrackPar(lepton2, lepton2);
       o2::track::TrackParCovFwd pars3 = FwdToTrackPar(track, track);
 
-      procCode = VarManager::fgFitterThreeProngFwd.process(pars1, pars2, pars3);
-      procCodeJpsi = VarManager::fgFitterTwoProngFwd.process(pars1, pars2);
+      if (fgUsedVarGroups[kVarGroupVertexing]) {
+        procCode = VarManager::fgFitterThreeProngFwd.process(pars1, pars2, pars3);
+        procCodeJpsi = VarManager::fgFitterTwoProngFwd.process(pars1, pars2);
+      }
     } else if constexpr ((candidateType == kBtoJpsiEEK || candidateType == kDstarToD0KPiPi) && trackHasCov) {
       if constexpr ((candidateType == kBtoJpsiEEK) && trackHasCov) {
         mlepton1 = o2::constants::physics::MassElectron;
@@ -5321,8 +5434,10 @@ void VarManager::FillDileptonTrackVertexing(C const& collision, T1 const& lepton
                                            track.cSnpSnp(), track.cTglY(), track.cTglZ(), track.cTglSnp(), track.cTglTgl(),
                                            track.c1PtY(), track.c1PtZ(), track.c1PtSnp(), track.c1PtTgl(), track.c1Pt21Pt2()};
       o2::track::TrackParCov pars3{track.x(), track.alpha(), lepton3pars, lepton3covs};
-      procCode = VarManager::fgFitterThreeProngBarrel.process(pars1, pars2, pars3);
-      procCodeJpsi = VarManager::fgFitterTwoProngBarrel.process(pars1, pars2);
+      if (fgUsedVarGroups[kVarGroupVertexing]) {
+        procCode = VarManager::fgFitterThreeProngBarrel.process(pars1, pars2, pars3);
+        procCodeJpsi = VarManager::fgFitterTwoProngBarrel.process(pars1, pars2);
+      }
     } else {
       return;
     }
@@ -5348,6 +5463,11 @@ void VarManager::FillDileptonTrackVertexing(C const& collision, T1 const& lepton
     values[kS13] = (v1 + v3).M2();
     values[kS23] = (v2 + v3).M2();
 
+    // only the triplet kinematics is needed if none of the vertexing variables are used
+    if (!fgUsedVarGroups[kVarGroupVertexing]) {
+      return;
+    }
+
     values[VarManager::kVertexingProcCode] = procCode;
     if (procCode == 0 || procCodeJpsi == 0) {
       // TODO: set the other variables to appropriate values and return
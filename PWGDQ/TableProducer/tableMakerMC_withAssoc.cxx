@@ -552,6 +552,11 @@ struct TableMakerMC {
     uint16_t mcflags = static_cast<uint16_t>(0); // flags which will hold the decisions for each MC signal
     int trackCounter = 0;
 
+    // The same MC particles are checked again for the reconstructed tracks, muons and MFT tracks of this time frame
+    for (auto& sig : fMCSignals) {
+      sig->ResetCache(mcTracks.size());
+    }
+
     for (auto& mctrack : mcTracks) {
       // check all the requested MC signals and fill the decision bit map
       mcflags = 0;
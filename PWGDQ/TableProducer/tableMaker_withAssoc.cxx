@@ -248,6 +248,7 @@ struct TableMaker {
     Configurable<bool> fConfigQA{"cfgQA", false, "If true, fill QA histograms"};
     Configurable<bool> fConfigFillBcStat{"cfgFillBcStat", false, "If true, fill QA histograms for normalization studies (for OO and Pb-Pb)"};
     Configurable<bool> fConfigDetailedQA{"cfgDetailedQA", false, "If true, include more QA histograms (BeforeCuts classes)"};
+    Configurable<int> fConfigQAPrescale{"cfgQAPrescale", 1, "Fill the per cut QA histograms of the barrel tracks and muons only for one out of this number of skimmed objects (1: all)"};
     Configurable<std::string> fConfigAddEventHistogram{"cfgAddEventHistogram", "", "Comma separated list of histograms"};
     Configurable<std::string> fConfigAddTrackHistogram{"cfgAddTrackHistogram", "", "Comma separated list of histograms"};
     Configurable<std::string> fConfigAddMuonHistogram{"cfgAddMuonHistogram", "", "Comma separated list of histograms"};
@@ -304,6 +305,7 @@ struct TableMaker {
     // Muon related options
     Configurable<bool> fPropMuon{"cfgPropMuon", true, "Propagate muon tracks through absorber (do not use if applying pairing)"};
     Configurable<bool> fRefitGlobalMuon{"cfgRefitGlobalMuon", true, "Correct global muon parameters"};
+    Configurable<bool> fCacheMuonPropagation{"cfgCacheMuonPropagation", false, "Cache the muon propagations within a DF, a muon is propagated only once per collision and end point"};
     Configurable<bool> fKeepBestMatch{"cfgKeepBestMatch", false, "Keep only the best match global muons in the skimming"};
     Configurable<bool> fUseML{"cfgUseML", false, "Import ONNX model from ccdb to decide which matching candidates to keep"};
     Configurable<float> fMuonMatchEtaMin{"cfgMuonMatchEtaMin", -4.0f, "Definition of the acceptance of muon tracks to be matched with MFT"};
@@ -332,6 +334,8 @@ struct TableMaker {
   std::vector<AnalysisCompositeCut*> fMuonCuts;  //! Muon track cuts
 
   bool fDoDetailedQA = false; // Bool to set detailed QA true, if QA is set true
+  uint64_t fNQATracks = 0;    // number of barrel tracks considered for the per cut QA, used for the QA prescaling
+  uint64_t fNQAMuons = 0;     // number of muons considered for the per cut QA, used for the QA prescaling
   int fCurrentRun;            // needed to detect if the run changed and trigger update of calibrations etc.
 
   // maps used to store index info; NOTE: std::map are sorted in ascending order by default (needed for track to collision indices)
@@ -461,6 +465,9 @@ struct TableMaker {
     if (fConfigHistOutput.fConfigQA && fConfigHistOutput.fConfigDetailedQA) {
       fDoDetailedQA = true;
     }
+    if (fConfigHistOutput.fConfigQAPrescale.value < 1) {
+      LOG(fatal) << "cfgQAPrescale has to be at least 1";
+    }
 
     // Create the histogram class names to be added to the histogram manager
     // The histogram class names are added into a string and then passed to the DefineHistograms() function which
@@ -526,6 +533,7 @@ struct TableMaker {
     fOutputList.setObject(fHistMan->GetMainHistogramList());
 
     VarManager::SetMatchingPlane(fConfigVariousOptions.fzMatching.value);
+    VarManager::SetUseMuonPropagationCache(fConfigVariousOptions.fCacheMuonPropagation.value);
 
     if (fConfigVariousOptions.fUseML.value) {
       // TODO : for now we use hard coded values since the current models use 1 pT bin
@@ -1307,14 +1315,16 @@ struct TableMaker {
         fHistMan->FillHistClass("TrackBarrel_BeforeCuts", VarManager::fgValues);
       }
 
+      // NOTE: the QA is filled here just for the first occurence of this track.
+      //    So if there are histograms of quantities which depend on the collision association, these will not be accurate
+      const bool fillTrackQA = fConfigHistOutput.fConfigQA && (fTrackIndexMap.find(track.globalIndex()) == fTrackIndexMap.end()) && (fNQATracks++ % fConfigHistOutput.fConfigQAPrescale.value == 0);
+
       // apply track cuts and fill stats histogram
       int i = 0;
       for (auto cut = fTrackCuts.begin(); cut != fTrackCuts.end(); cut++, i++) {
         if ((*cut)->IsSelected(VarManager::fgValues)) {
           trackTempFilterMap |= (static_cast<uint32_t>(1) << i);
-          // NOTE: the QA is filled here just for the first occurence of this track.
-          //    So if there are histograms of quantities which depend on the collision association, these will not be accurate
-          if (fConfigHistOutput.fConfigQA && (fTrackIndexMap.find(track.globalIndex()) == fTrackIndexMap.end())) {
+          if (fillTrackQA) {
             fHistMan->FillHistClass(Form("TrackBarrel_%s", (*cut)->GetName()), VarManager::fgValues);
           }
           (reinterpret_cast<TH1D*>(fStatsList->At(kStatsTracks)))->Fill(static_cast<float>(i));
@@ -1576,15 +1586,17 @@ struct TableMaker {
       if (fDoDetailedQA) {
         fHistMan->FillHistClass("Muons_BeforeCuts", VarManager::fgValues);
       }
+      // NOTE: the QA is filled here just for the first occurence of this muon, which means the current association
+      //     will be skipped from histograms if this muon was already filled in the skimming map.
+      //    So if there are histograms of quantities which depend on the collision association, these histograms will not be completely accurate
+      const bool fillMuonQA = fConfigHistOutput.fConfigQA && (fFwdTrackIndexMap.find(muon.globalIndex()) == fFwdTrackIndexMap.end()) && (fNQAMuons++ % fConfigHistOutput.fConfigQAPrescale.value == 0);
+
       // check the cuts and filters
       int i = 0;
       for (auto cut = fMuonCuts.begin(); cut != fMuonCuts.end(); cut++, i++) {
         if ((*cut)->IsSelected(VarManager::fgValues)) {
           trackTempFilterMap |= (static_cast<uint8_t>(1) << i);
-          // NOTE: the QA is filled here just for the first occurence of this muon, which means the current association
-          //     will be skipped from histograms if this muon was already filled in the skimming map.
-          //    So if there are histograms of quantities which depend on the collision association, these histograms will not be completely accurate
-          if (fConfigHistOutput.fConfigQA && (fFwdTrackIndexMap.find(muon.globalIndex()) == fFwdTrackIndexMap.end())) {
+          if (fillMuonQA) {
             fHistMan->FillHistClass(Form("Muons_%s", (*cut)->GetName()), VarManager::fgValues);
           }
           (reinterpret_cast<TH1D*>(fStatsList->At(kStatsMuons)))->Fill(static_cast<float>(i));
@@ -1689,6 +1701,8 @@ struct TableMaker {
                     TTracks const& tracksBarrel, TMuons const& muons, TMFTTracks const& mftTracks,
                     TTrackAssoc const& trackAssocs, TFwdTrackAssoc const& fwdTrackAssocs, TMFTTrackAssoc const& mftAssocs, TMFTCov const& mftCovs, TFt0s const& ft0s, TFv0as const& fv0as, TFdds const& fdds)
   {
+    // the muon and collision indices used as keys of the propagation cache are valid only within this DF
+    VarManager::ResetMuonPropagationCache();
 
     if (bcs.size() > 0 && fCurrentRun != bcs.begin().runNumber()) {
       if (fConfigPostCalibTPC.fConfigComputeTPCpostCalib) {
@@ -1993,13 +1993,12 @@ struct AnalysisSameEventPairing {
     }
 
     TString cutNames = fConfigCuts.track.value;
-    std::map<int, std::vector<TString>> histNames = fTrackHistNames;
-    std::map<int, std::vector<TString>> histNamesMC = fBarrelHistNamesMCmatched;
+    // refer to the histogram names of the pair type instead of copying the maps at each call
+    const auto& histNames = (TPairType == VarManager::kDecayToMuMu) ? fMuonHistNames : fTrackHistNames;
+    const auto& histNamesMC = (TPairType == VarManager::kDecayToMuMu) ? fMuonHistNamesMCmatched : fBarrelHistNamesMCmatched;
     int ncuts = fNCutsBarrel;
     if constexpr (TPairType == VarManager::kDecayToMuMu) {
       cutNames = fConfigCuts.muon.value;
-      histNames = fMuonHistNames;
-      histNamesMC = fMuonHistNamesMCmatched;
       ncuts = fNCutsMuon;
     }
 
@@ -2264,14 +2263,14 @@ struct AnalysisSameEventPairing {
             isAmbiInBunch = (twoTrackFilter & (static_cast<uint32_t>(1) << 28)) || (twoTrackFilter & (static_cast<uint32_t>(1) << 29));
             isAmbiOutOfBunch = (twoTrackFilter & (static_cast<uint32_t>(1) << 30)) || (twoTrackFilter & (static_cast<uint32_t>(1) << 31));
             if (sign1 * sign2 < 0) {                                                    // +- pairs
-              fHistMan->FillHistClass(histNames[icut][0].Data(), dqefficiency_helpers::varValues()); // reconstructed, unmatched
+              fHistMan->FillHistClass(histNames.at(icut)[0].Data(), dqefficiency_helpers::varValues()); // reconstructed, unmatched
               for (unsigned int isig = 0; isig < fRecMCSignals.size(); isig++) {        // loop over MC signals
                 if (mcDecision & (static_cast<uint32_t>(1) << isig)) {
                   PromptNonPromptSepTable(VarManager::fgValues[VarManager::kMass], VarManager::fgValues[VarManager::kPt], VarManager::fgValues[VarManager::kEta], VarManager::fgValues[VarManager::kRap], VarManager::fgValues[VarManager::kPhi],
                                           VarManager::fgValues[VarManager::kVertexingTauxyProjected], VarManager::fgValues[VarManager::kVertexingTauxyProjectedPoleJPsiMass], VarManager::fgValues[VarManager::kVertexingTauzProjected], VarManager::fgValues[VarManager::kVertexingTauxyProjectedPoleJPsiMassRecalculatePV],
                                           VarManager::fgValues[VarManager::kVtxX], VarManager::fgValues[VarManager::kVtxY], VarManager::fgValues[VarManager::kVtxZ], VarManager::fgValues[VarManager::kDCAxy1], VarManager::fgValues[VarManager::kDCAz1], VarManager::fgValues[VarManager::kITSclusterMap1], VarManager::fgValues[VarManager::kTPCnSigmaEl1], VarManager::fgValues[VarManager::kDCAxy2], VarManager::fgValues[VarManager::kDCAz2], VarManager::fgValues[VarManager::kITSclusterMap2], VarManager::fgValues[VarManager::kTPCnSigmaEl2],
                                           isAmbiInBunch, isAmbiOutOfBunch, isCorrect_pair, VarManager::fgValues[VarManager::kMultFT0A], VarManager::fgValues[VarManager::kMultFT0C], VarManager::fgValues[VarManager::kCentFT0M], VarManager::fgValues[VarManager::kVtxNcontribReal]);
-                  fHistMan->FillHistClass(histNamesMC[icut * fRecMCSignals.size() + isig][0].Data(), dqefficiency_helpers::varValues()); // matched signal
+                  fHistMan->FillHistClass(histNamesMC.at(icut * fRecMCSignals.size() + isig)[0].Data(), dqefficiency_helpers::varValues()); // matched signal
                   if (useMiniTree.fConfigMiniTree) {
                     if constexpr (TPairType == VarManager::kDecayToMuMu) {
                       twoTrackFilter = a1.isMuonSelected_raw() & a2.isMuonSelected_raw() & fMuonFilterMask;
@@ -2306,82 +2305,82 @@ struct AnalysisSameEventPairing {
                   }
                   if (fConfigQA) {
                     if (isCorrectAssoc_leg1 && isCorrectAssoc_leg2) { // correct track-collision association
-                      fHistMan->FillHistClass(histNamesMC[icut * fRecMCSignals.size() + isig][3].Data(), dqefficiency_helpers::varValues());
+                      fHistMan->FillHistClass(histNamesMC.at(icut * fRecMCSignals.size() + isig)[3].Data(), dqefficiency_helpers::varValues());
                     } else { // incorrect track-collision association
-                      fHistMan->FillHistClass(histNamesMC[icut * fRecMCSignals.size() + isig][4].Data(), dqefficiency_helpers::varValues());
+                      fHistMan->FillHistClass(histNamesMC.at(icut * fRecMCSignals.size() + isig)[4].Data(), dqefficiency_helpers::varValues());
                     }
                     if (isAmbiInBunch) { // ambiguous in bunch
-                      fHistMan->FillHistClass(histNamesMC[icut * fRecMCSignals.size() + isig][5].Data(), dqefficiency_helpers::varValues());
+                      fHistMan->FillHistClass(histNamesMC.at(icut * fRecMCSignals.size() + isig)[5].Data(), dqefficiency_helpers::varValues());
                       if (isCorrectAssoc_leg1 && isCorrectAssoc_leg2) {
-                        fHistMan->FillHistClass(histNamesMC[icut * fRecMCSignals.size() + isig][6].Data(), dqefficiency_helpers::varValues());
+                        fHistMan->FillHistClass(histNamesMC.at(icut * fRecMCSignals.size() + isig)[6].Data(), dqefficiency_helpers::varValues());
                       } else {
-                        fHistMan->FillHistClass(histNamesMC[icut * fRecMCSignals.size() + isig][7].Data(), dqefficiency_helpers::varValues());
+                        fHistMan->FillHistClass(histNamesMC.at(icut * fRecMCSignals.size() + isig)[7].Data(), dqefficiency_helpers::varValues());
                       }
                     }
                     if (isAmbiOutOfBunch) { // ambiguous out of bunch
-                      fHistMan->FillHistClass(histNamesMC[icut * fRecMCSignals.size() + isig][8].Data(), dqefficiency_helpers::varValues());
+                      fHistMan->FillHistClass(histNamesMC.at(icut * fRecMCSignals.size() + isig)[8].Data(), dqefficiency_helpers::varValues());
                       if (isCorrectAssoc_leg1 && isCorrectAssoc_leg2) {
-                        fHistMan->FillHistClass(histNamesMC[icut * fRecMCSignals.size() + isig][9].Data(), dqefficiency_helpers::varValues());
+                        fHistMan->FillHistClass(histNamesMC.at(icut * fRecMCSignals.size() + isig)[9].Data(), dqefficiency_helpers::varValues());
                       } else {
-                        fHistMan->FillHistClass(histNamesMC[icut * fRecMCSignals.size() + isig][10].Data(), dqefficiency_helpers::varValues());
+                        fHistMan->FillHistClass(histNamesMC.at(icut * fRecMCSignals.size() + isig)[10].Data(), dqefficiency_helpers::varValues());
                       }
                     }
                   }
                 }
                 if (fConfigQA) {
                   if (isAmbiInBunch) {
-                    fHistMan->FillHistClass(histNames[icut][3].Data(), dqefficiency_helpers::varValues());
+                    fHistMan->FillHistClass(histNames.at(icut)[3].Data(), dqefficiency_helpers::varValues());
                   }
                   if (isAmbiOutOfBunch) {
-                    fHistMan->FillHistClass(histNames[icut][3 + 3].Data(), dqefficiency_helpers::varValues());
+                    fHistMan->FillHistClass(histNames.at(icut)[3 + 3].Data(), dqefficiency_helpers::varValues());
                   }
                 }
               }
             } else {
               if (sign1 > 0) { // ++ pairs
-                fHistMan->FillHistClass(histNames[icut][1].Data(), dqefficiency_helpers::varValues());
+                fHistMan->FillHistClass(histNames.at(icut)[1].Data(), dqefficiency_helpers::varValues());
                 for (unsigned int isig = 0; isig < fRecMCSignals.size(); isig++) { // loop over MC signals
                   if (mcDecision & (static_cast<uint32_t>(1) << isig)) {
-                    fHistMan->FillHistClass(histNamesMC[icut * fRecMCSignals.size() + isig][1].Data(), dqefficiency_helpers::varValues());
+                    fHistMan->FillHistClass(histNamesMC.at(icut * fRecMCSignals.size() + isig)[1].Data(), dqefficiency_helpers::varValues());
                   }
                 }
                 if (fConfigQA) {
                   if (isAmbiInBunch) {
-                    fHistMan->FillHistClass(histNames[icut][4].Data(), dqefficiency_helpers::varValues());
+                    fHistMan->FillHistClass(histNames.at(icut)[4].Data(), dqefficiency_helpers::varValues());
                   }
                   if (isAmbiOutOfBunch) {
-                    fHistMan->FillHistClass(histNames[icut][4 + 3].Data(), dqefficiency_helpers::varValues());
+                    fHistMan->FillHistClass(histNames.at(icut)[4 + 3].Data(), dqefficiency_helpers::varValues());
                   }
                 }
               } else { // -- pairs
-                fHistMan->FillHistClass(histNames[icut][2].Data(), dqefficiency_helpers::varValues());
+                fHistMan->FillHistClass(histNames.at(icut)[2].Data(), dqefficiency_helpers::varValues());
                 for (unsigned int isig = 0; isig < fRecMCSignals.size(); isig++) { // loop over MC signals
                   if (mcDecision & (static_cast<uint32_t>(1) << isig)) {
-                    fHistMan->FillHistClass(histNamesMC[icut * fRecMCSignals.size() + isig][2].Data(), dqefficiency_helpers::varValues());
+                    fHistMan->FillHistClass(histNamesMC.at(icut * fRecMCSignals.size() + isig)[2].Data(), dqefficiency_helpers::varValues());
                   }
                 }
                 if (fConfigQA) {
                   if (isAmbiInBunch) {
-                    fHistMan->FillHistClass(histNames[icut][5].Data(), dqefficiency_helpers::varValues());
+                    fHistMan->FillHistClass(histNames.at(icut)[5].Data(), dqefficiency_helpers::varValues());
                   }
                   if (isAmbiOutOfBunch) {
-                    fHistMan->FillHistClass(histNames[icut][5 + 3].Data(), dqefficiency_helpers::varValues());
+                    fHistMan->FillHistClass(histNames.at(icut)[5 + 3].Data(), dqefficiency_helpers::varValues());
                   }
                 }
               }
             }
             for (unsigned int iPairCut = 0; iPairCut < fPairCuts.size(); iPairCut++) {
-              AnalysisCompositeCut cut = fPairCuts.at(iPairCut);
+              auto& cut = fPairCuts.at(iPairCut);
               if (!(cut.IsSelected(dqefficiency_helpers::varValues()))) { // apply pair cuts
                 continue;
               }
               if (sign1 * sign2 < 0) {
-                fHistMan->FillHistClass(histNames[ncuts + icut * fPairCuts.size() + iPairCut][0].Data(), dqefficiency_helpers::varValues());
+                fHistMan->FillHistClass(histNames.at(ncuts + icut * fPairCuts.size() + iPairCut)[0].Data(), dqefficiency_helpers::varValues());
               } else {
                 if (sign1 > 0) {
-                  fHistMan->FillHistClass(histNames[ncuts + icut * fPairCuts.size() + iPairCut][1].Data(), dqefficiency_helpers::varValues());
+                  fHistMan->FillHistClass(histNames.at(ncuts + icut * fPairCuts.size() + iPairCut)[1].Data(), dqefficiency_helpers::varValues());
                 } else {
-                  fHistMan->FillHistClass(histNames[ncuts + icut * fPairCuts.size() + iPairCut][2].Data(), dqefficiency_helpers::varValues());
+                  fHistMan->FillHistClass(histNames.at(ncuts + icut * fPairCuts.size() + iPairCut)[2].Data(), dqefficiency_helpers::varValues());
                 }
               }
             } // end loop (pair cuts)
@@ -2652,7 +2651,7 @@ struct AnalysisSameEventPairing {
             // pair-cut reco entries
             for (int iPairCut = 0; iPairCut < nPairCuts; ++iPairCut) {
               if (!fPairCuts.empty()) {
-                AnalysisCompositeCut cut = fPairCuts.at(iPairCut);
+                auto& cut = fPairCuts.at(iPairCut);
                 if (!cut.IsSelected(dqefficiency_helpers::varValues())) {
                   continue;
                 }
@@ -2782,7 +2781,7 @@ struct AnalysisSameEventPairing {
             }
             for (int iPairCut = 0; iPairCut < nPairCuts; ++iPairCut) {
               if (!fPairCuts.empty()) {
-                AnalysisCompositeCut cut = fPairCuts.at(iPairCut);
+                auto& cut = fPairCuts.at(iPairCut);
                 if (!cut.IsSelected(dqefficiency_helpers::varValues())) {
                   continue;
                 }
@@ -14,6 +14,7 @@
 
 #include "PWGDQ/Core/AnalysisCompositeCut.h"
 #include "PWGDQ/Core/AnalysisCut.h"
+#include "PWGDQ/Core/AnalysisCutEvaluator.h"
 #include "PWGDQ/Core/CutsLibrary.h"
 #include "PWGDQ/Core/DQMlResponse.h"
 #include "PWGDQ/Core/HistogramManager.h"
@@ -31,6 +32,7 @@
 #include <CCDB/BasicCCDBManager.h>
 #include <CCDB/CcdbApi.h>
 #include <CommonConstants/MathConstants.h>
+#include <CommonConstants/PhysicsConstants.h>
 #include <DataFormatsITSMFT/DPLAlpideParam.h>
 #include <DataFormatsParameters/GRPLHCIFData.h>
 #include <DataFormatsParameters/GRPMagField.h>
@@ -60,8 +62,10 @@
 #include <RtypesCore.h>
 
 #include <algorithm>
+#include <array>
 #include <chrono>
 #include <cmath>
+#include <cstddef>
 #include <cstdint>
 #include <cstdio>
 #include <cstdlib>
@@ -669,12 +673,18 @@ struct AnalysisTrackSelection {
   Configurable<std::string> grpmagPath{"grpmagPath", "GLO/Config/GRPMagField", "CCDB path of the GRPMagField object"};
   // Track related options
   Configurable<bool> fPropTrack{"cfgPropTrack", true, "Propgate tracks to associated collision to recalculate DCA and momentum vector"};
+  Configurable<int> fConfigCutFunctionLUTPoints{"cfgCutFunctionLUTPoints", 0, "If > 1, cut limits given by functions are tabulated with this number of points; otherwise they are evaluated exactly"};
 
   Service<o2::ccdb::BasicCCDBManager> fCCDB{};
   o2::ccdb::CcdbApi fCCDBApi;
 
   HistogramManager* fHistMan = nullptr;
   std::vector<AnalysisCompositeCut*> fTrackCuts;
+  AnalysisCutEvaluator fCutEvaluator; // all the track cuts compiled into a single program
+
+  // QA histograms are filled column-wise: index 0 corresponds to TrackBarrel_BeforeCuts, index 1+i to the i-th track cut
+  std::vector<int> fQAHistHandles;
+  std::vector<VarManager::ValuesBatch> fQABatches;
 
   int fCurrentRun = 0; // current run kept to detect run changes and trigger loading params from CCDB
 
@@ -704,6 +714,10 @@ struct AnalysisTrackSelection {
         fTrackCuts.push_back(static_cast<AnalysisCompositeCut*>(t));
       }
     }
+    for (auto const& cut : fTrackCuts) {
+      fCutEvaluator.AddCut(cut);
+    }
+    fCutEvaluator.Compile(fConfigCutFunctionLUTPoints.value);
 
     VarManager::SetUseVars(AnalysisCut::fgUsedVars); // provide the list of required variables so that VarManager knows what to fill
 
@@ -725,6 +739,13 @@ struct AnalysisTrackSelection {
       dqhistograms::AddHistogramsFromJSON(fHistMan, fConfigAddJSONHistograms.value.c_str());  // ad-hoc histograms via JSON
       VarManager::SetUseVars(fHistMan->GetUsedVars());                                        // provide the list of required variables so that VarManager knows what to fill
       fOutputList.setObject(fHistMan->GetMainHistogramList());
+
+      // the batches are created after all the used variables are known
+      fQAHistHandles.push_back(fHistMan->GetHistClassHandle("TrackBarrel_BeforeCuts"));
+      for (auto const& cut : fTrackCuts) {
+        fQAHistHandles.push_back(fHistMan->GetHistClassHandle(Form("TrackBarrel_%s", cut->GetName())));
+      }
+      fQABatches.resize(fQAHistHandles.size());
     }
 
     fCCDB->setURL(fConfigCcdbUrl.value);
@@ -734,6 +755,24 @@ struct AnalysisTrackSelection {
     fCCDBApi.init(fConfigCcdbUrl.value);
   }
 
+  void addToQABatch(std::size_t iHist)
+  {
+    auto& batch = fQABatches[iHist];
+    batch.Add(dqtablereader_helpers::varValues());
+    if (batch.IsFull()) {
+      flushQABatch(iHist);
+    }
+  }
+
+  void flushQABatch(std::size_t iHist)
+  {
+    auto& batch = fQABatches[iHist];
+    if (fQAHistHandles[iHist] != HistogramManager::kNothing) {
+      fHistMan->FillHistClassBatch(fQAHistHandles[iHist], batch.GetSize(), batch.GetColumns());
+    }
+    batch.Clear();
+  }
+
   template <uint32_t TEventFillMap, uint32_t TTrackFillMap, typename TEvents, typename TTracks>
   void runTrackSelection(ReducedTracksAssoc const& assocs, TEvents const& events, TTracks const& tracks)
   {
@@ -798,17 +837,17 @@ struct AnalysisTrackSelection {
         VarManager::FillTrackCollision<TTrackFillMap>(track, event);
       }
       if (fConfigQA) {
-        fHistMan->FillHistClass("TrackBarrel_BeforeCuts", dqtablereader_helpers::varValues());
+        addToQABatch(0);
       }
-      iCut = 0;
-      for (auto cut = fTrackCuts.begin(); cut != fTrackCuts.end(); cut++, iCut++) {
-        if ((*cut)->IsSelected(dqtablereader_helpers::varValues())) {
-          filterMap |= (static_cast<uint32_t>(1) << iCut);
-          if (fConfigQA) {
-            fHistMan->FillHistClass(Form("TrackBarrel_%s", (*cut)->GetName()), dqtablereader_helpers::varValues());
+      // evaluate all the cuts in one pass
+      filterMap = static_cast<uint32_t>(fCutEvaluator.Evaluate(dqtablereader_helpers::varValues()));
+      if (fConfigQA) {
+        for (iCut = 0; iCut < static_cast<int>(fTrackCuts.size()); iCut++) {
+          if (filterMap & (static_cast<uint32_t>(1) << iCut)) {
+            addToQABatch(1 + iCut);
           }
         }
-      } // end loop over cuts
+      }
 
       // publish the decisions
       trackSel(filterMap);
@@ -836,6 +875,11 @@ struct AnalysisTrackSelection {
       }
     } // end loop over associations
 
+    // fill the histograms for the remaining entries in the QA batches
+    for (std::size_t iHist = 0; iHist < fQABatches.size(); iHist++) {
+      flushQABatch(iHist);
+    }
+
     if (fConfigPublishAmbiguity) {
       // QA the collision-track associations
       if (fConfigQA) {
@@ -1829,6 +1873,43 @@ struct AnalysisSameEventPairing {
     }
   }
 
+  // Remembers the cuts passed by a pair of ambiguous legs, returns true if the pair was already counted with this cut
+  // (e.g. from another collision association). Independent of the pair type, so compiled once and not per pairing instance
+  bool registerAmbiguousPair(uint32_t id1, uint32_t id2, int icut)
+  {
+    const uint32_t cutBit = static_cast<uint32_t>(1) << icut;
+    auto [it, inserted] = fAmbiguousPairs.try_emplace(std::make_pair(id1, id2), cutBit);
+    if (inserted) {
+      return false;
+    }
+    if (it->second & cutBit) { // if this pair is already stored with this cut
+      return true;
+    }
+    it->second |= cutBit;
+    return false;
+  }
+
+  // Fills the pair histograms of the pair cuts passed by the pair, for the track cut icut.
+  // The pair variables are taken from VarManager, so this does not depend on the pair type
+  void fillPairCutHistograms(std::map<int, std::vector<TString>> const& histNames, int ncuts, int icut, int sign1, int sign2)
+  {
+    for (unsigned int iPairCut = 0; iPairCut < fPairCuts.size(); iPairCut++) {
+      if (!(fPairCuts[iPairCut].IsSelected(dqtablereader_helpers::varValues()))) { // apply pair cuts
+        continue;
+      }
+      auto const& names = histNames.at(ncuts + icut * ncuts + iPairCut);
+      if (sign1 * sign2 < 0) {
+        fHistMan->FillHistClass(names[0].Data(), dqtablereader_helpers::varValues());
+      } else {
+        if (sign1 > 0) {
+          fHistMan->FillHistClass(names[1].Data(), dqtablereader_helpers::varValues());
+        } else {
+          fHistMan->FillHistClass(names[2].Data(), dqtablereader_helpers::varValues());
+        }
+      }
+    } // end loop (pair cuts)
+  }
+
   // Template function to run same event pairing (barrel-barrel, muon-muon, barrel-muon)
   template <bool TTwoProngFitter, int TPairType, uint32_t TEventFillMap, uint32_t TTrackFillMap, typename TEvents, typename TTrackAssocs, typename TTracks>
   void runSameEventPairing(TEvents const& events, Preslice<TTrackAssocs>& preslice, TTrackAssocs const& assocs, TTracks const& /*tracks*/)
@@ -1841,12 +1922,12 @@ struct AnalysisSameEventPairing {
     }
 
     TString cutNames = fConfigCuts.track.value;
-    std::map<int, std::vector<TString>> histNames = fTrackHistNames;
+    // refer to the histogram names of the pair type instead of copying the map at each call
+    const auto& histNames = (TPairType == pairTypeMuMu) ? fMuonHistNames : fTrackHistNames;
     int ncuts = fNCutsBarrel;
     int histIdxOffset = 0;
     if constexpr (TPairType == pairTypeMuMu) {
       cutNames = fConfigCuts.muon.value;
-      histNames = fMuonHistNames;
       ncuts = fNCutsMuon;
       if (fEnableMuonMixingHistos) {
         histIdxOffset = 3;
@@ -2188,15 +2269,8 @@ struct AnalysisSameEventPairing {
             isLeg2Ambi = (twoTrackFilter & (static_cast<uint32_t>(1) << 29) || (twoTrackFilter & (static_cast<uint32_t>(1) << 31)));
             if constexpr (TPairType == VarManager::kDecayToEE) {
               if (isLeg1Ambi && isLeg2Ambi) {
-                std::pair<uint32_t, uint32_t> iPair(a1.reducedtrackId(), a2.reducedtrackId());
-                if (fAmbiguousPairs.contains(iPair)) {
-                  if (fAmbiguousPairs[iPair] & (static_cast<uint32_t>(1) << icut)) { // if this pair is already stored with this cut
-                    isAmbiExtra = true;
-                  } else {
-                    fAmbiguousPairs[iPair] |= static_cast<uint32_t>(1) << icut;
-                  }
-                } else {
-                  fAmbiguousPairs[iPair] = static_cast<uint32_t>(1) << icut;
+                if (registerAmbiguousPair(a1.reducedtrackId(), a2.reducedtrackId(), icut)) {
+                  isAmbiExtra = true;
                 }
               }
             }
@@ -2206,7 +2280,7 @@ struct AnalysisSameEventPairing {
                                       VarManager::fgValues[VarManager::kVtxX], VarManager::fgValues[VarManager::kVtxY], VarManager::fgValues[VarManager::kVtxZ], VarManager::fgValues[VarManager::kDCAxy1], VarManager::fgValues[VarManager::kDCAz1], VarManager::fgValues[VarManager::kITSclusterMap1], VarManager::fgValues[VarManager::kTPCnSigmaEl1], VarManager::fgValues[VarManager::kDCAxy2], VarManager::fgValues[VarManager::kDCAz2], VarManager::fgValues[VarManager::kITSclusterMap2], VarManager::fgValues[VarManager::kTPCnSigmaEl2],
                                       isAmbiInBunch, isAmbiOutOfBunch, VarManager::fgValues[VarManager::kMultFT0A], VarManager::fgValues[VarManager::kMultFT0C], VarManager::fgValues[VarManager::kCentFT0M], VarManager::fgValues[VarManager::kVtxNcontribReal]);
               if constexpr (TPairType == VarManager::kDecayToMuMu) {
-                fHistMan->FillHistClass(histNames[icut][0].Data(), dqtablereader_helpers::varValues());
+                fHistMan->FillHistClass(histNames.at(icut)[0].Data(), dqtablereader_helpers::varValues());
                 if (useMiniTree.fConfigMiniTree) {
                   auto t1 = a1.template reducedmuon_as<TTracks>();
                   auto t2 = a2.template reducedmuon_as<TTracks>();
@@ -2228,82 +2302,68 @@ struct AnalysisSameEventPairing {
                 }
                 if (fConfigAmbiguousMuonHistograms) {
                   if (isAmbiInBunch) {
-                    fHistMan->FillHistClass(histNames[icut][3 + histIdxOffset].Data(), dqtablereader_helpers::varValues());
+                    fHistMan->FillHistClass(histNames.at(icut)[3 + histIdxOffset].Data(), dqtablereader_helpers::varValues());
                   }
                   if (isAmbiOutOfBunch) {
-                    fHistMan->FillHistClass(histNames[icut][3 + histIdxOffset + 3].Data(), dqtablereader_helpers::varValues());
+                    fHistMan->FillHistClass(histNames.at(icut)[3 + histIdxOffset + 3].Data(), dqtablereader_helpers::varValues());
                   }
                   if (isUnambiguous) {
-                    fHistMan->FillHistClass(histNames[icut][3 + histIdxOffset + 6].Data(), dqtablereader_helpers::varValues());
+                    fHistMan->FillHistClass(histNames.at(icut)[3 + histIdxOffset + 6].Data(), dqtablereader_helpers::varValues());
                   }
                 }
               }
               if constexpr (TPairType == VarManager::kDecayToEE) {
-                fHistMan->FillHistClass(histNames[icut][0].Data(), dqtablereader_helpers::varValues());
+                fHistMan->FillHistClass(histNames.at(icut)[0].Data(), dqtablereader_helpers::varValues());
                 if (isAmbiExtra) {
-                  fHistMan->FillHistClass(histNames[icut][3].Data(), dqtablereader_helpers::varValues());
+                  fHistMan->FillHistClass(histNames.at(icut)[3].Data(), dqtablereader_helpers::varValues());
                 }
               }
             } else {
               if (sign1 > 0) {
                 if constexpr (TPairType == VarManager::kDecayToMuMu) {
-                  fHistMan->FillHistClass(histNames[icut][1].Data(), dqtablereader_helpers::varValues());
+                  fHistMan->FillHistClass(histNames.at(icut)[1].Data(), dqtablereader_helpers::varValues());
                   if (fConfigAmbiguousMuonHistograms) {
                     if (isAmbiInBunch) {
-                      fHistMan->FillHistClass(histNames[icut][4 + histIdxOffset].Data(), dqtablereader_helpers::varValues());
+                      fHistMan->FillHistClass(histNames.at(icut)[4 + histIdxOffset].Data(), dqtablereader_helpers::varValues());
                     }
                     if (isAmbiOutOfBunch) {
-                      fHistMan->FillHistClass(histNames[icut][4 + histIdxOffset + 3].Data(), dqtablereader_helpers::varValues());
+                      fHistMan->FillHistClass(histNames.at(icut)[4 + histIdxOffset + 3].Data(), dqtablereader_helpers::varValues());
                     }
                     if (isUnambiguous) {
-                      fHistMan->FillHistClass(histNames[icut][4 + histIdxOffset + 6].Data(), dqtablereader_helpers::varValues());
+                      fHistMan->FillHistClass(histNames.at(icut)[4 + histIdxOffset + 6].Data(), dqtablereader_helpers::varValues());
                     }
                   }
                 }
                 if constexpr (TPairType == VarManager::kDecayToEE) {
-                  fHistMan->FillHistClass(histNames[icut][1].Data(), dqtablereader_helpers::varValues());
+                  fHistMan->FillHistClass(histNames.at(icut)[1].Data(), dqtablereader_helpers::varValues());
                   if (isAmbiExtra) {
-                    fHistMan->FillHistClass(histNames[icut][4].Data(), dqtablereader_helpers::varValues());
+                    fHistMan->FillHistClass(histNames.at(icut)[4].Data(), dqtablereader_helpers::varValues());
                   }
                 }
               } else {
                 if constexpr (TPairType == VarManager::kDecayToMuMu) {
-                  fHistMan->FillHistClass(histNames[icut][2].Data(), dqtablereader_helpers::varValues());
+                  fHistMan->FillHistClass(histNames.at(icut)[2].Data(), dqtablereader_helpers::varValues());
                   if (fConfigAmbiguousMuonHistograms) {
                     if (isAmbiInBunch) {
-                      fHistMan->FillHistClass(histNames[icut][5 + histIdxOffset].Data(), dqtablereader_helpers::varValues());
+                      fHistMan->FillHistClass(histNames.at(icut)[5 + histIdxOffset].Data(), dqtablereader_helpers::varValues());
                     }
                     if (isAmbiOutOfBunch) {
-                      fHistMan->FillHistClass(histNames[icut][5 + histIdxOffset + 3].Data(), dqtablereader_helpers::varValues());
+                      fHistMan->FillHistClass(histNames.at(icut)[5 + histIdxOffset + 3].Data(), dqtablereader_helpers::varValues());
                     }
                     if (isUnambiguous) {
-                      fHistMan->FillHistClass(histNames[icut][5 + histIdxOffset + 6].Data(), dqtablereader_helpers::varValues());
+                      fHistMan->FillHistClass(histNames.at(icut)[5 + histIdxOffset + 6].Data(), dqtablereader_helpers::varValues());
                     }
                   }
                 }
                 if constexpr (TPairType == VarManager::kDecayToEE) {
-                  fHistMan->FillHistClass(histNames[icut][2].Data(), dqtablereader_helpers::varValues());
+                  fHistMan->FillHistClass(histNames.at(icut)[2].Data(), dqtablereader_helpers::varValues());
                   if (isAmbiExtra) {
-                    fHistMan->FillHistClass(histNames[icut][5].Data(), dqtablereader_helpers::varValues());
+                    fHistMan->FillHistClass(histNames.at(icut)[5].Data(), dqtablereader_helpers::varValues());
                   }
                 }
               }
             }
-            for (unsigned int iPairCut = 0; iPairCut < fPairCuts.size(); iPairCut++) {
-              AnalysisCompositeCut cut = fPairCuts.at(iPairCut);
-              if (!(cut.IsSelected(dqtablereader_helpers::varValues()))) { // apply pair cuts
-                continue;
-              }
-              if (sign1 * sign2 < 0) {
-                fHistMan->FillHistClass(histNames[ncuts + icut * ncuts + iPairCut][0].Data(), dqtablereader_helpers::varValues());
-              } else {
-                if (sign1 > 0) {
-                  fHistMan->FillHistClass(histNames[ncuts + icut * ncuts + iPairCut][1].Data(), dqtablereader_helpers::varValues());
-                } else {
-                  fHistMan->FillHistClass(histNames[ncuts + icut * ncuts + iPairCut][2].Data(), dqtablereader_helpers::varValues());
-                }
-              }
-            } // end loop (pair cuts)
+            fillPairCutHistograms(histNames, ncuts, icut, sign1, sign2);
           }
         } // end loop (cuts)
 
@@ -2343,15 +2403,8 @@ struct AnalysisSameEventPairing {
                 isLeg2Ambi = (twoTrackFilter & (static_cast<uint32_t>(1) << 29) || (twoTrackFilter & (static_cast<uint32_t>(1) << 31)));
                 if constexpr (TPairType == VarManager::kDecayToEE) {
                   if (isLeg1Ambi && isLeg2Ambi) {
-                    std::pair<uint32_t, uint32_t> iPair(a1.reducedtrackId(), a2.reducedtrackId());
-                    if (fAmbiguousPairs.contains(iPair)) {
-                      if (fAmbiguousPairs[iPair] & (static_cast<uint32_t>(1) << icut)) { // if this pair is already stored with this cut
-                        isAmbiExtra = true;
-                      } else {
-                        fAmbiguousPairs[iPair] |= static_cast<uint32_t>(1) << icut;
-                      }
-                    } else {
-                      fAmbiguousPairs[iPair] = static_cast<uint32_t>(1) << icut;
+                    if (registerAmbiguousPair(a1.reducedtrackId(), a2.reducedtrackId(), icut)) {
+                      isAmbiExtra = true;
                     }
                   }
                 }
@@ -2379,8 +2432,9 @@ struct AnalysisSameEventPairing {
 
       if (fConfigRunMixingAcrossTFs) {
         // run event mixing across TFs
-        // 1) create a MixingEvent and fill it with the relevant tracks
-        MixingHandler::MixingEvent mixingEvent;
+        // 1) fill the current event with the relevant tracks, directly in the pool corresponding to this event
+        auto& pool = fMixingHandler.GetPool(fMixingHandler.FindEventCategory(dqtablereader_helpers::varValues()));
+        pool.StartEvent();
         uint32_t trackFilterForMixing = 0;
         for (auto const& assoc : groupedAssocs) {
           if constexpr (TPairType == VarManager::kDecayToEE) {
@@ -2391,16 +2445,15 @@ struct AnalysisSameEventPairing {
             auto t1 = assoc.template reducedtrack_as<TTracks>();
             MixingHandler::MixingTrack mixingTrack(t1.pt(), t1.eta(), t1.phi(), trackFilterForMixing);
             if (t1.sign() > 0) {
-              mixingEvent.AddTrack1(mixingTrack);
+              pool.AddTrack1(mixingTrack);
             } else {
-              mixingEvent.AddTrack2(mixingTrack);
+              pool.AddTrack2(mixingTrack);
             }
           }
         }
         // 2) run the mixing with the events in the pool corresponding to this event
-        auto& pool = fMixingHandler.GetPool(fMixingHandler.FindEventCategory(dqtablereader_helpers::varValues()));
-        for (auto const& poolEvent : pool.GetEvents()) {
-          for (auto const& t1 : mixingEvent.tracks1) {
+        for (auto const& [currentEvent, poolEvent] : pool) {
+          for (auto const& t1 : currentEvent.tracks1) {
             // run +- pairing
             for (auto const& t2 : poolEvent.tracks2) {
               // check the two-track filter for the mixed pair
@@ -2430,7 +2483,7 @@ struct AnalysisSameEventPairing {
               }
             }
           }
-          for (auto const& t1 : mixingEvent.tracks2) {
+          for (auto const& t1 : currentEvent.tracks2) {
             // run -+ pairing
             for (auto const& t2 : poolEvent.tracks1) {
               // check the two-track filter for the mixed pair
@@ -2462,7 +2515,7 @@ struct AnalysisSameEventPairing {
           }
         }
         // 3) add the current event to the pool
-        pool.UpdatePool(mixingEvent, fMixingHandler.GetPoolDepth());
+        pool.CommitEvent();
         // pool.Print();
       }
     } // end loop over events
@@ -2471,7 +2524,7 @@ struct AnalysisSameEventPairing {
   template <int TPairType, uint32_t TEventFillMap, typename TAssoc1, typename TAssoc2, typename TTracks1, typename TTracks2>
   void runMixedPairing(TAssoc1 const& assocs1, TAssoc2 const& assocs2, TTracks1 const& /*tracks1*/, TTracks2 const& /*tracks2*/)
   {
-    std::map<int, std::vector<TString>> histNames = fTrackHistNames;
+    const auto& histNames = (TPairType == VarManager::kDecayToMuMu) ? fMuonHistNames : fTrackHistNames;
     int pairSign = 0;
     int ncuts = 0;
     auto twoTrackFilter = static_cast<uint32_t>(0);
@@ -2530,7 +2583,6 @@ struct AnalysisSameEventPairing {
             twoTrackFilter |= (static_cast<uint32_t>(1) << 31);
           }
           ncuts = fNCutsMuon;
-          histNames = fMuonHistNames;
 
           if (fConfigOptions.flatTables.value) {
             dimuonAllList(-999., -999., -999., -999.,
@@ -2578,16 +2630,16 @@ struct AnalysisSameEventPairing {
           isUnambiguous = !((twoTrackFilter & (static_cast<uint32_t>(1) << 28)) || (twoTrackFilter & (static_cast<uint32_t>(1) << 29)) || (twoTrackFilter & (static_cast<uint32_t>(1) << 30)) || (twoTrackFilter & (static_cast<uint32_t>(1) << 31)));
           if (pairSign == 0) {
             if constexpr (TPairType == VarManager::kDecayToMuMu) {
-              fHistMan->FillHistClass(histNames[icut][3].Data(), dqtablereader_helpers::varValues());
+              fHistMan->FillHistClass(histNames.at(icut)[3].Data(), dqtablereader_helpers::varValues());
               if (fConfigAmbiguousMuonHistograms) {
                 if (isAmbiInBunch) {
-                  fHistMan->FillHistClass(histNames[icut][15].Data(), dqtablereader_helpers::varValues());
+                  fHistMan->FillHistClass(histNames.at(icut)[15].Data(), dqtablereader_helpers::varValues());
                 }
                 if (isAmbiOutOfBunch) {
-                  fHistMan->FillHistClass(histNames[icut][18].Data(), dqtablereader_helpers::varValues());
+                  fHistMan->FillHistClass(histNames.at(icut)[18].Data(), dqtablereader_helpers::varValues());
                 }
                 if (isUnambiguous) {
-                  fHistMan->FillHistClass(histNames[icut][21].Data(), dqtablereader_helpers::varValues());
+                  fHistMan->FillHistClass(histNames.at(icut)[21].Data(), dqtablereader_helpers::varValues());
                 }
               }
             }
@@ -2597,16 +2649,16 @@ struct AnalysisSameEventPairing {
           } else {
             if (pairSign > 0) {
               if constexpr (TPairType == VarManager::kDecayToMuMu) {
-                fHistMan->FillHistClass(histNames[icut][4].Data(), dqtablereader_helpers::varValues());
+                fHistMan->FillHistClass(histNames.at(icut)[4].Data(), dqtablereader_helpers::varValues());
                 if (fConfigAmbiguousMuonHistograms) {
                   if (isAmbiInBunch) {
-                    fHistMan->FillHistClass(histNames[icut][16].Data(), dqtablereader_helpers::varValues());
+                    fHistMan->FillHistClass(histNames.at(icut)[16].Data(), dqtablereader_helpers::varValues());
                   }
                   if (isAmbiOutOfBunch) {
-                    fHistMan->FillHistClass(histNames[icut][19].Data(), dqtablereader_helpers::varValues());
+                    fHistMan->FillHistClass(histNames.at(icut)[19].Data(), dqtablereader_helpers::varValues());
                   }
                   if (isUnambiguous) {
-                    fHistMan->FillHistClass(histNames[icut][22].Data(), dqtablereader_helpers::varValues());
+                    fHistMan->FillHistClass(histNames.at(icut)[22].Data(), dqtablereader_helpers::varValues());
                   }
                 }
               }
@@ -2615,16 +2667,16 @@ struct AnalysisSameEventPairing {
               }
             } else {
               if constexpr (TPairType == VarManager::kDecayToMuMu) {
-                fHistMan->FillHistClass(histNames[icut][5].Data(), dqtablereader_helpers::varValues());
+                fHistMan->FillHistClass(histNames.at(icut)[5].Data(), dqtablereader_helpers::varValues());
                 if (fConfigAmbiguousMuonHistograms) {
                   if (isAmbiInBunch) {
-                    fHistMan->FillHistClass(histNames[icut][17].Data(), dqtablereader_helpers::varValues());
+                    fHistMan->FillHistClass(histNames.at(icut)[17].Data(), dqtablereader_helpers::varValues());
                   }
                   if (isAmbiOutOfBunch) {
-                    fHistMan->FillHistClass(histNames[icut][20].Data(), dqtablereader_helpers::varValues());
+                    fHistMan->FillHistClass(histNames.at(icut)[20].Data(), dqtablereader_helpers::varValues());
                   }
                   if (isUnambiguous) {
-                    fHistMan->FillHistClass(histNames[icut][23].Data(), dqtablereader_helpers::varValues());
+                    fHistMan->FillHistClass(histNames.at(icut)[23].Data(), dqtablereader_helpers::varValues());
                   }
                 }
               }
@@ -2767,7 +2819,7 @@ struct AnalysisSameEventPairing {
 
             for (unsigned int iPairCut = 0; iPairCut < (fPairCuts.empty() ? 1 : fPairCuts.size()); iPairCut++) {
               if (!fPairCuts.empty()) {
-                AnalysisCompositeCut cut = fPairCuts.at(iPairCut);
+                auto& cut = fPairCuts.at(iPairCut);
                 if (!cut.IsSelected(dqtablereader_helpers::varValues())) {
                   continue;
                 }
@@ -2836,7 +2888,7 @@ struct AnalysisSameEventPairing {
             }
             for (int iPairCut = 0; iPairCut < nPairCuts; ++iPairCut) {
               if (!fPairCuts.empty()) {
-                AnalysisCompositeCut cut = fPairCuts.at(iPairCut);
+                auto& cut = fPairCuts.at(iPairCut);
                 if (!cut.IsSelected(dqtablereader_helpers::varValues())) {
                   continue;
                 }
@@ -3804,6 +3856,8 @@ struct AnalysisDileptonTrack {
   Configurable<float> fConfigDileptonRapCutAbs{"cfgDileptonRapCutAbs", 1.0, "Rap cut for dileptons used in the triplet vertexing"};
   Configurable<float> fConfigDileptonLxyCut{"cfgDileptonLxyCut", 0.0, "Lxy cut for dileptons used in the triplet vertexing"};
   Configurable<float> fConfigDileptonTauxyCut{"cfgDileptonTauxyCut", -10000, "Tauxy cut for dileptons used to select the non-prompt Jpsi"};
+  Configurable<float> fConfigTripletLowMass{"cfgTripletLowMass", 0.0, "Low mass cut for the dilepton-track combinations, applied before the triplet vertexing"};
+  Configurable<float> fConfigTripletHighMass{"cfgTripletHighMass", 1E5, "High mass cut for the dilepton-track combinations, applied before the triplet vertexing"};
   Configurable<bool> fConfigUseKFVertexing{"cfgUseKFVertexing", false, "Use KF Particle for secondary vertex reconstruction (DCAFitter is used by default)"};
 
   Configurable<std::string> fConfigHistogramSubgroups{"cfgDileptonTrackHistogramsSubgroups", "invmass,vertexing", "Comma separated list of dilepton-track histogram subgroups"};
@@ -3834,6 +3888,7 @@ struct AnalysisDileptonTrack {
   int fNCommonTrackCuts = 0;
   std::map<int, int> fCommonTrackCutMap;
   uint32_t fTrackCutBitMap = 0; // track cut bit mask to be used in the selection of tracks associated with dileptons
+  bool fApplyTripletMassWindow = false;
   // vector for single-lepton and track cut names for easy access when calling FillHistogramList()
   std::vector<TString> fTrackCutNames;
   std::vector<TString> fLegCutNames;
@@ -3868,6 +3923,7 @@ struct AnalysisDileptonTrack {
 
   void init(o2::framework::InitContext& context)
   {
+    fApplyTripletMassWindow = fConfigTripletLowMass > 0.0 || fConfigTripletHighMass < 1E5;
     bool isBarrel = context.mOptions.get<bool>("processBarrelSkimmed");
     bool isBarrelME = context.mOptions.get<bool>("processBarrelMixedEvent");
     bool isBarrelAsymmetric = context.mOptions.get<bool>("processDstarToD0Pi");
@@ -4156,6 +4212,30 @@ struct AnalysisDileptonTrack {
     return hEff->Interpolate(safeX, safeY);
   }
 
+  // masses of the two legs and of the track, as assumed in VarManager::FillDileptonTrackVertexing
+  template <int TCandidateType>
+  static constexpr std::array<float, 3> tripletMasses()
+  {
+    if constexpr (TCandidateType == VarManager::kDstarToD0KPiPi) {
+      return {o2::constants::physics::MassKaonCharged, o2::constants::physics::MassPionCharged, o2::constants::physics::MassPionCharged};
+    } else if constexpr (TCandidateType == VarManager::kBcToThreeMuons) {
+      return {o2::constants::physics::MassMuon, o2::constants::physics::MassMuon, o2::constants::physics::MassMuon};
+    } else {
+      return {o2::constants::physics::MassElectron, o2::constants::physics::MassElectron, o2::constants::physics::MassKaonCharged};
+    }
+  }
+
+  // triplet mass from the 4-momenta, so that the combinations outside the mass window are rejected before the vertexing
+  template <typename TTrack>
+  bool isInTripletMassWindow(ROOT::Math::PtEtaPhiMVector const& vDilepton, TTrack const& track, float trackMass) const
+  {
+    if (!fApplyTripletMassWindow) {
+      return true;
+    }
+    const float mass = (vDilepton + ROOT::Math::PtEtaPhiMVector(track.pt(), track.eta(), track.phi(), trackMass)).M();
+    return mass > fConfigTripletLowMass && mass < fConfigTripletHighMass;
+  }
+
   // Template function to run pair - hadron combinations
   template <int TCandidateType, uint32_t TEventFillMap, uint32_t TTrackFillMap, typename TEvent, typename TTracks, typename TTrackAssocs, typename TDileptons>
   void runDileptonHadron(TEvent const& event, TTrackAssocs const& assocs, TTracks const& tracks, TDileptons const& dileptons)
@@ -4211,6 +4291,13 @@ struct AnalysisDileptonTrack {
         }
       } // end loop over single lepton selections
 
+      // dilepton 4-momentum from the legs, as in the triplet vertexing, only needed for the triplet mass window
+      constexpr auto TripletMasses = tripletMasses<TCandidateType>();
+      ROOT::Math::PtEtaPhiMVector vDilepton;
+      if (fApplyTripletMassWindow) {
+        vDilepton = ROOT::Math::PtEtaPhiMVector(lepton1.pt(), lepton1.eta(), lepton1.phi(), TripletMasses[0]) + ROOT::Math::PtEtaPhiMVector(lepton2.pt(), lepton2.eta(), lepton2.phi(), TripletMasses[1]);
+      }
+
       // loop over hadrons
       for (auto const& assoc : assocs) {
 
@@ -4228,6 +4315,9 @@ struct AnalysisDileptonTrack {
           if (track.globalIndex() == dilepton.index0Id() || track.globalIndex() == dilepton.index1Id()) {
             continue;
           }
+          if (!isInTripletMassWindow(vDilepton, track, TripletMasses[2])) {
+            continue;
+          }
           // compute needed quantities
           VarManager::FillDileptonHadron(dilepton, track, fValuesHadron);
           VarManager::FillDileptonTrackVertexing<TCandidateType, TEventFillMap, TTrackFillMap>(event, lepton1, lepton2, track, fValuesHadron);
@@ -4278,6 +4368,9 @@ struct AnalysisDileptonTrack {
           if (!((track.sign() == 1 && lepton1.sign() == -1 && lepton2.sign() == 1) || (track.sign() == -1 && lepton1.sign() == 1 && lepton2.sign() == -1))) {
             continue;
           }
+          if (!isInTripletMassWindow(vDilepton, track, TripletMasses[2])) {
+            continue;
+          }
           VarManager::FillDileptonHadron(dilepton, track, fValuesHadron);
           VarManager::FillDileptonTrackVertexing<TCandidateType, TEventFillMap, TTrackFillMap>(event, lepton1, lepton2, track, fValuesHadron);
         }
@@ -4290,6 +4383,9 @@ struct AnalysisDileptonTrack {
           if (track.globalIndex() == dilepton.index0Id() || track.globalIndex() == dilepton.index1Id()) {
             continue;
           }
+          if (!isInTripletMassWindow(vDilepton, track, TripletMasses[2])) {
+            continue;
+          }
 
           VarManager::FillDileptonHadron(dilepton, track, fValuesHadron);
           VarManager::FillDileptonTrackVertexing<TCandidateType, TEventFillMap, TTrackFillMap>(event, lepton1, lepton2, track, fValuesHadron);
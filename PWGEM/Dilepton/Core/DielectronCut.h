@@ -549,6 +549,10 @@ class DielectronCut : public TNamed
 
   // Getters
   bool IsPhotonConversionSelected() const { return mSelectPC; }
+  float GetMinPairMass() const { return mMinMee; }
+  float GetMaxPairMass() const { return mMaxMee; }
+  float GetMinPairPt() const { return mMinPairPt; }
+  float GetMaxPairPt() const { return mMaxPairPt; }
 
  private:
   static const std::pair<int8_t, std::set<uint8_t>> its_ib_any_Requirement;
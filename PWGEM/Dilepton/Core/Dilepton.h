@@ -344,6 +344,15 @@ struct Dilepton {
   std::vector<float> occ_bin_edges;
 
   int nmod = -1; // this is for flow analysis
+
+  // flow quantities of the collision being paired, computed once per collision for all its pairs
+  struct EventFlowInfo {
+    std::array<float, 2> qvector{999.f, 999.f}; // Q vector of the harmonic nmod from cfgQvecEstimator
+    float spResolution = 1.f;                    // SP resolution at the centrality and occupancy of the collision
+    float eventplane = 0.f;                      // event plane of the harmonic nmod from cfgQvecEstimator, in [-pi/nmod, pi/nmod)
+  };
+  EventFlowInfo fEventFlowInfo;
+
   float leptonM1 = 0.f;
   float leptonM2 = 0.f;
 
@@ -841,6 +850,23 @@ struct Dilepton {
     fDimuonCut.EnableTTCA(dimuoncuts.enableTTCA);
   }
 
+  template <typename TCollision, typename TQvectors>
+  void cacheEventFlowInfo(TCollision const& collision, TQvectors const& qvectors)
+  {
+    if (nmod < 0) {
+      return;
+    }
+    fEventFlowInfo.qvector = qvectors[nmod][cfgQvecEstimator];
+    fEventFlowInfo.spResolution = getSPresolution(collision.centFT0C(), collision.trackOccupancyInTimeRange());
+    if (nmod == 2) {
+      const float eventplanes[7] = {collision.ep2ft0m(), collision.ep2ft0a(), collision.ep2ft0c(), collision.ep2btot(), collision.ep2bpos(), collision.ep2bneg(), collision.ep2fv0a()};
+      fEventFlowInfo.eventplane = RecoDecay::constrainAngle(eventplanes[cfgQvecEstimator], -o2::constants::math::PI / nmod, static_cast<uint>(nmod));
+    } else if (nmod == 3) {
+      const float eventplanes[7] = {collision.ep3ft0m(), collision.ep3ft0a(), collision.ep3ft0c(), collision.ep3btot(), collision.ep3bpos(), collision.ep3bneg(), collision.ep3fv0a()};
+      fEventFlowInfo.eventplane = RecoDecay::constrainAngle(eventplanes[cfgQvecEstimator], -o2::constants::math::PI / nmod, static_cast<uint>(nmod));
+    }
+  }
+
   template <typename TQvectors>
   bool isGoodQvector(TQvectors const& qvectors)
   {
@@ -879,37 +905,28 @@ struct Dilepton {
     }
   }
 
-  template <int ev_id, typename TCollision, typename TTrack1, typename TTrack2, typename TCut, typename TAllTracks>
-  bool fillPairInfo(TCollision const& collision, TTrack1 const& t1, TTrack2 const& t2, TCut const& cut, TAllTracks const&, const std::vector<float> weightvector)
+  template <typename TTrack, typename TCut>
+  bool isSelectedLepton(TTrack const& t, TCut const& cut)
   {
-    if constexpr (ev_id == 0) {
-      if constexpr (pairtype == o2::aod::pwgem::dilepton::utils::pairutil::DileptonPairType::kDielectron) {
-        if (dielectroncuts.cfg_pid_scheme == static_cast<int>(DielectronCut::PIDSchemes::kPIDML)) {
-          if (!cut.template IsSelectedTrack<false>(t1) || !cut.template IsSelectedTrack<false>(t2)) {
-            return false;
-          }
-        } else { // cut-based
-          if (!cut.template IsSelectedTrack<false>(t1) || !cut.template IsSelectedTrack<false>(t2)) {
-            return false;
-          }
-        }
-      } else if constexpr (pairtype == o2::aod::pwgem::dilepton::utils::pairutil::DileptonPairType::kDimuon) {
-        if (!cut.template IsSelectedTrack<false>(t1) || !cut.template IsSelectedTrack<false>(t2)) {
-          return false;
-        }
-        if (!map_best_match_globalmuon[t1.globalIndex()] || !map_best_match_globalmuon[t2.globalIndex()]) {
-          return false;
-        }
-
-        // if (!o2::aod::pwgem::dilepton::utils::emtrackutil::isBestMatch(t1, cut, tracks)) {
-        //   return false;
-        // }
-        // if (!o2::aod::pwgem::dilepton::utils::emtrackutil::isBestMatch(t2, cut, tracks)) {
-        //   return false;
-        // }
+    if (!cut.template IsSelectedTrack<false>(t)) {
+      return false;
+    }
+    if constexpr (pairtype == o2::aod::pwgem::dilepton::utils::pairutil::DileptonPairType::kDimuon) {
+      if (!map_best_match_globalmuon[t.globalIndex()]) {
+        return false;
       }
+
+      // if (!o2::aod::pwgem::dilepton::utils::emtrackutil::isBestMatch(t, cut, tracks)) {
+      //   return false;
+      // }
     }
+    return true;
+  }
 
+  // the legs of same-event pairs are selected beforehand with isSelectedLepton
+  template <int ev_id, typename TCollision, typename TTrack1, typename TTrack2, typename TCut, typename TAllTracks>
+  bool fillPairInfo(TCollision const& collision, TTrack1 const& t1, TTrack2 const& t2, TCut const& cut, TAllTracks const&, const std::vector<float> weightvector)
+  {
     if constexpr (pairtype == o2::aod::pwgem::dilepton::utils::pairutil::DileptonPairType::kDielectron) {
       if (!cut.IsSelectedPair(t1, t2)) {
         return false;
@@ -1029,32 +1046,11 @@ struct Dilepton {
         fRegistry.fill(HIST("Pair/") + HIST(event_pair_types[ev_id]) + HIST("lsmm/hs"), v12.M(), v12.Pt(), pair_dca, v12.Rapidity(), aco, asym, std::fabs(dphi_l_ll), cos_thetaPol, weight);
       }
     } else if (cfgAnalysisType == static_cast<int>(o2::aod::pwgem::dilepton::utils::pairutil::DileptonAnalysisType::kFlowV2SP) || cfgAnalysisType == static_cast<int>(o2::aod::pwgem::dilepton::utils::pairutil::DileptonAnalysisType::kFlowV3SP)) {
-      std::array<float, 2> q2ft0m = {collision.q2xft0m(), collision.q2yft0m()};
-      std::array<float, 2> q2ft0a = {collision.q2xft0a(), collision.q2yft0a()};
-      std::array<float, 2> q2ft0c = {collision.q2xft0c(), collision.q2yft0c()};
-      std::array<float, 2> q2btot = {collision.q2xbtot(), collision.q2ybtot()};
-      std::array<float, 2> q2bpos = {collision.q2xbpos(), collision.q2ybpos()};
-      std::array<float, 2> q2bneg = {collision.q2xbneg(), collision.q2ybneg()};
-      std::array<float, 2> q2fv0a = {collision.q2xfv0a(), collision.q2yfv0a()};
-      std::array<float, 2> q3ft0m = {collision.q3xft0m(), collision.q3yft0m()};
-      std::array<float, 2> q3ft0a = {collision.q3xft0a(), collision.q3yft0a()};
-      std::array<float, 2> q3ft0c = {collision.q3xft0c(), collision.q3yft0c()};
-      std::array<float, 2> q3btot = {collision.q3xbtot(), collision.q3ybtot()};
-      std::array<float, 2> q3bpos = {collision.q3xbpos(), collision.q3ybpos()};
-      std::array<float, 2> q3bneg = {collision.q3xbneg(), collision.q3ybneg()};
-      std::array<float, 2> q3fv0a = {collision.q3xfv0a(), collision.q3yfv0a()};
-
-      std::vector<std::vector<std::array<float, 2>>> qvectors = {
-        {{999.f, 999.f}, {999.f, 999.f}, {999.f, 999.f}, {999.f, 999.f}, {999.f, 999.f}, {999.f, 999.f}, {999.f, 999.f}}, // 0th harmonics
-        {{999.f, 999.f}, {999.f, 999.f}, {999.f, 999.f}, {999.f, 999.f}, {999.f, 999.f}, {999.f, 999.f}, {999.f, 999.f}}, // 1st harmonics
-        {q2ft0m, q2ft0a, q2ft0c, q2btot, q2bpos, q2bneg, q2fv0a},                                                         // 2nd harmonics
-        {q3ft0m, q3ft0a, q3ft0c, q3btot, q3bpos, q3bneg, q3fv0a},                                                         // 3rd harmonics
-      };
-
       if constexpr (ev_id == 0) {
         // LOGF(info, "collision.centFT0C() = %f, collision.trackOccupancyInTimeRange() = %d, getSPresolution = %f", collision.centFT0C(), collision.trackOccupancyInTimeRange(), getSPresolution(collision.centFT0C(), collision.trackOccupancyInTimeRange()));
 
-        float sp = RecoDecay::dotProd(std::array<float, 2>{static_cast<float>(std::cos(nmod * v12.Phi())), static_cast<float>(std::sin(nmod * v12.Phi()))}, qvectors[nmod][cfgQvecEstimator]) / getSPresolution(collision.centFT0C(), collision.trackOccupancyInTimeRange());
+        double phi_ll = v12.Phi();
+        float sp = RecoDecay::dotProd(std::array<float, 2>{static_cast<float>(std::cos(nmod * phi_ll)), static_cast<float>(std::sin(nmod * phi_ll))}, fEventFlowInfo.qvector) / fEventFlowInfo.spResolution;
         if (t1.sign() * t2.sign() < 0) { // ULS
           fRegistry.fill(HIST("Pair/") + HIST(event_pair_types[ev_id]) + HIST("uls/hs"), v12.M(), v12.Pt(), pair_dca, v12.Rapidity(), sp, weight);
         } else if (t1.sign() > 0 && t2.sign() > 0) { // LS++
@@ -1107,32 +1103,11 @@ struct Dilepton {
       }
 
     } else if (cfgAnalysisType == static_cast<int>(o2::aod::pwgem::dilepton::utils::pairutil::DileptonAnalysisType::kBootstrapv2)) {
-      std::array<float, 2> q2ft0m = {collision.q2xft0m(), collision.q2yft0m()};
-      std::array<float, 2> q2ft0a = {collision.q2xft0a(), collision.q2yft0a()};
-      std::array<float, 2> q2ft0c = {collision.q2xft0c(), collision.q2yft0c()};
-      std::array<float, 2> q2btot = {collision.q2xbtot(), collision.q2ybtot()};
-      std::array<float, 2> q2bpos = {collision.q2xbpos(), collision.q2ybpos()};
-      std::array<float, 2> q2bneg = {collision.q2xbneg(), collision.q2ybneg()};
-      std::array<float, 2> q2fv0a = {collision.q2xfv0a(), collision.q2yfv0a()};
-      std::array<float, 2> q3ft0m = {collision.q3xft0m(), collision.q3yft0m()};
-      std::array<float, 2> q3ft0a = {collision.q3xft0a(), collision.q3yft0a()};
-      std::array<float, 2> q3ft0c = {collision.q3xft0c(), collision.q3yft0c()};
-      std::array<float, 2> q3btot = {collision.q3xbtot(), collision.q3ybtot()};
-      std::array<float, 2> q3bpos = {collision.q3xbpos(), collision.q3ybpos()};
-      std::array<float, 2> q3bneg = {collision.q3xbneg(), collision.q3ybneg()};
-      std::array<float, 2> q3fv0a = {collision.q3xfv0a(), collision.q3yfv0a()};
-
-      std::vector<std::vector<std::array<float, 2>>> qvectors = {
-        {{999.f, 999.f}, {999.f, 999.f}, {999.f, 999.f}, {999.f, 999.f}, {999.f, 999.f}, {999.f, 999.f}, {999.f, 999.f}}, // 0th harmonics
-        {{999.f, 999.f}, {999.f, 999.f}, {999.f, 999.f}, {999.f, 999.f}, {999.f, 999.f}, {999.f, 999.f}, {999.f, 999.f}}, // 1st harmonics
-        {q2ft0m, q2ft0a, q2ft0c, q2btot, q2bpos, q2bneg, q2fv0a},                                                         // 2nd harmonics
-        {q3ft0m, q3ft0a, q3ft0c, q3btot, q3bpos, q3bneg, q3fv0a},                                                         // 3rd harmonics
-      };
-
       if constexpr (ev_id == 0) {
         // LOGF(info, "collision.centFT0C() = %f, collision.trackOccupancyInTimeRange() = %d, getSPresolution = %f", collision.centFT0C(), collision.trackOccupancyInTimeRange(), getSPresolution(collision.centFT0C(), collision.trackOccupancyInTimeRange()));
 
-        float sp = RecoDecay::dotProd(std::array<float, 2>{static_cast<float>(std::cos(nmod * v12.Phi())), static_cast<float>(std::sin(nmod * v12.Phi()))}, qvectors[nmod][cfgQvecEstimator]) / getSPresolution(collision.centFT0C(), collision.trackOccupancyInTimeRange());
+        double phi_ll = v12.Phi();
+        float sp = RecoDecay::dotProd(std::array<float, 2>{static_cast<float>(std::cos(nmod * phi_ll)), static_cast<float>(std::sin(nmod * phi_ll))}, fEventFlowInfo.qvector) / fEventFlowInfo.spResolution;
         for (int i = 0; i < cfgNumBootstrapSamples; i++) {
           if (t1.sign() * t2.sign() < 0) { // ULS
             fRegistry.fill(HIST("Pair/") + HIST(event_pair_types[ev_id]) + HIST("uls/hs"), v12.M(), v12.Pt(), pair_dca, v12.Rapidity(), sp, i + 0.5, weightvector.at(i));
@@ -1153,14 +1128,7 @@ struct Dilepton {
       }
     } else if (cfgAnalysisType == static_cast<int>(o2::aod::pwgem::dilepton::utils::pairutil::DileptonAnalysisType::kFlowV2EP) || cfgAnalysisType == static_cast<int>(o2::aod::pwgem::dilepton::utils::pairutil::DileptonAnalysisType::kFlowV3EP)) {
       if constexpr (ev_id == 0) {
-        std::vector<std::vector<float>> eventplanes = {
-          {0.f, 0.f, 0.f, 0.f, 0.f, 0.f, 0.f},                                                                                                                 // 0th harmonics
-          {0.f, 0.f, 0.f, 0.f, 0.f, 0.f, 0.f},                                                                                                                 // 1st harmonics
-          {collision.ep2ft0m(), collision.ep2ft0a(), collision.ep2ft0c(), collision.ep2btot(), collision.ep2bpos(), collision.ep2bneg(), collision.ep2fv0a()}, // 2nd harmonics
-          {collision.ep3ft0m(), collision.ep3ft0a(), collision.ep3ft0c(), collision.ep3btot(), collision.ep3bpos(), collision.ep3bneg(), collision.ep3fv0a()}, // 3rd harmonics
-        };
-
-        float ep = RecoDecay::constrainAngle(eventplanes[nmod][cfgQvecEstimator], -o2::constants::math::PI / nmod, static_cast<uint>(nmod));
+        float ep = fEventFlowInfo.eventplane;
         float phi_ll = RecoDecay::constrainAngle(v12.Phi(), -o2::constants::math::PI / nmod, 1U);
         float dphi_ll_ep = std::fabs(RecoDecay::constrainAngle(phi_ll - ep, 0.f, static_cast<uint>(nmod)));
 
@@ -1296,6 +1264,8 @@ struct Dilepton {
   std::unordered_map<int, bool> map_best_match_globalmuon;
 
   std::vector<int> used_trackIds_per_col;
+  o2::aod::pwgem::dilepton::utils::pairutil::LegBuffer posLegs, negLegs;       // leptons of the current event
+  o2::aod::pwgem::dilepton::utils::pairutil::LegBuffer posLegsMix, negLegsMix; // leptons of the pooled event
   int ndf = 0;
 
   template <bool isTriggerAnalysis, typename TCollisions, typename TLeptons, typename TPresilce, typename TCut, typename TAllTracks>
@@ -1406,31 +1376,47 @@ struct Dilepton {
       fRegistry.fill(HIST("Event/before/hCollisionCounter"), o2::aod::pwgem::dilepton::utils::eventhistogram::nbin_ev); // accepted
       fRegistry.fill(HIST("Event/after/hCollisionCounter"), o2::aod::pwgem::dilepton::utils::eventhistogram::nbin_ev);  // accepted
       fRegistry.fill(HIST("Event/after/hEP2_CentFT0C_forMix"), collision.centFT0C(), ep2);
+      cacheEventFlowInfo(collision, qvectors);
 
       auto posTracks_per_coll = posTracks.sliceByCached(perCollision, collision.globalIndex(), cache);
       auto negTracks_per_coll = negTracks.sliceByCached(perCollision, collision.globalIndex(), cache);
       // LOGF(info, "collision.globalIndex() = %d , collision.posZ() = %f , collision.numContrib() = %d, centrality = %f , posTracks_per_coll.size() = %d, negTracks_per_coll.size() = %d", collision.globalIndex(), collision.posZ(), collision.numContrib(), centralities[cfgCentEstimator], posTracks_per_coll.size(), negTracks_per_coll.size());
 
       used_trackIds_per_col.reserve(posTracks_per_coll.size() + negTracks_per_coll.size());
+
+      // the lepton selection is applied once per track, and only the pairs in the mass and pT range of the cut are filled
+      std::vector<typename std::decay_t<decltype(posTracks_per_coll)>::iterator> selectedPosTracks, selectedNegTracks;
+      selectedPosTracks.reserve(posTracks_per_coll.size());
+      selectedNegTracks.reserve(negTracks_per_coll.size());
+      for (const auto& pos : posTracks_per_coll) {
+        if (isSelectedLepton(pos, cut)) {
+          selectedPosTracks.emplace_back(pos);
+        }
+      }
+      for (const auto& neg : negTracks_per_coll) {
+        if (isSelectedLepton(neg, cut)) {
+          selectedNegTracks.emplace_back(neg);
+        }
+      }
+      o2::aod::pwgem::dilepton::utils::pairutil::fillLegBuffer(posLegs, selectedPosTracks, leptonM1);
+      o2::aod::pwgem::dilepton::utils::pairutil::fillLegBuffer(negLegs, selectedNegTracks, leptonM2);
+
       int nuls = 0, nlspp = 0, nlsmm = 0;
-      for (const auto& [pos, neg] : combinations(o2::soa::CombinationsFullIndexPolicy(posTracks_per_coll, negTracks_per_coll))) { // ULS
-        bool is_pair_ok = fillPairInfo<0>(collision, pos, neg, cut, tracks, bootstrapweights);
-        if (is_pair_ok) {
+      o2::aod::pwgem::dilepton::utils::pairutil::forEachPairInKinematicRange(posLegs, negLegs, false, cut.GetMinPairMass(), cut.GetMaxPairMass(), cut.GetMinPairPt(), cut.GetMaxPairPt(), [&](std::size_t iPos, std::size_t iNeg) { // ULS
+        if (fillPairInfo<0>(collision, selectedPosTracks[iPos], selectedNegTracks[iNeg], cut, tracks, bootstrapweights)) {
           nuls++;
         }
-      }
-      for (const auto& [pos1, pos2] : combinations(o2::soa::CombinationsStrictlyUpperIndexPolicy(posTracks_per_coll, posTracks_per_coll))) { // LS++
-        bool is_pair_ok = fillPairInfo<0>(collision, pos1, pos2, cut, tracks, bootstrapweights);
-        if (is_pair_ok) {
+      });
+      o2::aod::pwgem::dilepton::utils::pairutil::forEachPairInKinematicRange(posLegs, posLegs, true, cut.GetMinPairMass(), cut.GetMaxPairMass(), cut.GetMinPairPt(), cut.GetMaxPairPt(), [&](std::size_t iPos1, std::size_t iPos2) { // LS++
+        if (fillPairInfo<0>(collision, selectedPosTracks[iPos1], selectedPosTracks[iPos2], cut, tracks, bootstrapweights)) {
           nlspp++;
         }
-      }
-      for (const auto& [neg1, neg2] : combinations(o2::soa::CombinationsStrictlyUpperIndexPolicy(negTracks_per_coll, negTracks_per_coll))) { // LS--
-        bool is_pair_ok = fillPairInfo<0>(collision, neg1, neg2, cut, tracks, bootstrapweights);
-        if (is_pair_ok) {
+      });
+      o2::aod::pwgem::dilepton::utils::pairutil::forEachPairInKinematicRange(negLegs, negLegs, true, cut.GetMinPairMass(), cut.GetMaxPairMass(), cut.GetMinPairPt(), cut.GetMaxPairPt(), [&](std::size_t iNeg1, std::size_t iNeg2) { // LS--
+        if (fillPairInfo<0>(collision, selectedNegTracks[iNeg1], selectedNegTracks[iNeg2], cut, tracks, bootstrapweights)) {
           nlsmm++;
         }
-      }
+      });
       used_trackIds_per_col.clear();
       used_trackIds_per_col.shrink_to_fit();
 
@@ -1483,6 +1469,8 @@ struct Dilepton {
       // make a vector of selected photons in this collision.
       auto selected_posTracks_in_this_event = emh_pos->GetTracksPerCollision(key_df_collision);
       auto selected_negTracks_in_this_event = emh_neg->GetTracksPerCollision(key_df_collision);
+      o2::aod::pwgem::dilepton::utils::pairutil::fillLegBuffer(posLegs, selected_posTracks_in_this_event, leptonM1);
+      o2::aod::pwgem::dilepton::utils::pairutil::fillLegBuffer(negLegs, selected_negTracks_in_this_event, leptonM2);
       // LOGF(info, "N selected tracks in current event (%d, %d), zvtx = %f, centrality = %f , npos = %d , nneg = %d, nuls = %d , nlspp = %d, nlsmm = %d", ndf, collision.globalIndex(), collision.posZ(), centralities[cfgCentEstimator], selected_posTracks_in_this_event.size(), selected_negTracks_in_this_event.size(), nuls, nlspp, nlsmm);
 
       auto collisionIds_in_mixing_pool = emh_pos->GetCollisionIdsFromEventPool(key_bin); // pos/neg does not matter.
@@ -1506,29 +1494,21 @@ struct Dilepton {
         auto negTracks_from_event_pool = emh_neg->GetTracksPerCollision(mix_dfId_collisionId);
         // LOGF(info, "Do event mixing: current event (%d, %d) | event pool (%d, %d), npos = %d , nneg = %d", ndf, collision.globalIndex(), mix_dfId, mix_collisionId, posTracks_from_event_pool.size(), negTracks_from_event_pool.size());
 
-        for (const auto& pos : selected_posTracks_in_this_event) { // ULS mix
-          for (const auto& neg : negTracks_from_event_pool) {
-            fillPairInfo<1>(collision, pos, neg, cut, nullptr, bootstrapweights);
-          }
-        }
-
-        for (const auto& neg : selected_negTracks_in_this_event) { // ULS mix
-          for (const auto& pos : posTracks_from_event_pool) {
-            fillPairInfo<1>(collision, neg, pos, cut, nullptr, bootstrapweights);
-          }
-        }
-
-        for (const auto& pos1 : selected_posTracks_in_this_event) { // LS++ mix
-          for (const auto& pos2 : posTracks_from_event_pool) {
-            fillPairInfo<1>(collision, pos1, pos2, cut, nullptr, bootstrapweights);
-          }
-        }
-
-        for (const auto& neg1 : selected_negTracks_in_this_event) { // LS-- mix
-          for (const auto& neg2 : negTracks_from_event_pool) {
-            fillPairInfo<1>(collision, neg1, neg2, cut, nullptr, bootstrapweights);
-          }
-        }
+        o2::aod::pwgem::dilepton::utils::pairutil::fillLegBuffer(posLegsMix, posTracks_from_event_pool, leptonM1);
+        o2::aod::pwgem::dilepton::utils::pairutil::fillLegBuffer(negLegsMix, negTracks_from_event_pool, leptonM2);
+
+        o2::aod::pwgem::dilepton::utils::pairutil::forEachPairInKinematicRange(posLegs, negLegsMix, false, cut.GetMinPairMass(), cut.GetMaxPairMass(), cut.GetMinPairPt(), cut.GetMaxPairPt(), [&](std::size_t iPos, std::size_t iNeg) { // ULS mix
+          fillPairInfo<1>(collision, selected_posTracks_in_this_event[iPos], negTracks_from_event_pool[iNeg], cut, nullptr, bootstrapweights);
+        });
+        o2::aod::pwgem::dilepton::utils::pairutil::forEachPairInKinematicRange(negLegs, posLegsMix, false, cut.GetMinPairMass(), cut.GetMaxPairMass(), cut.GetMinPairPt(), cut.GetMaxPairPt(), [&](std::size_t iNeg, std::size_t iPos) { // ULS mix
+          fillPairInfo<1>(collision, selected_negTracks_in_this_event[iNeg], posTracks_from_event_pool[iPos], cut, nullptr, bootstrapweights);
+        });
+        o2::aod::pwgem::dilepton::utils::pairutil::forEachPairInKinematicRange(posLegs, posLegsMix, false, cut.GetMinPairMass(), cut.GetMaxPairMass(), cut.GetMinPairPt(), cut.GetMaxPairPt(), [&](std::size_t iPos1, std::size_t iPos2) { // LS++ mix
+          fillPairInfo<1>(collision, selected_posTracks_in_this_event[iPos1], posTracks_from_event_pool[iPos2], cut, nullptr, bootstrapweights);
+        });
+        o2::aod::pwgem::dilepton::utils::pairutil::forEachPairInKinematicRange(negLegs, negLegsMix, false, cut.GetMinPairMass(), cut.GetMaxPairMass(), cut.GetMinPairPt(), cut.GetMaxPairPt(), [&](std::size_t iNeg1, std::size_t iNeg2) { // LS-- mix
+          fillPairInfo<1>(collision, selected_negTracks_in_this_event[iNeg1], negTracks_from_event_pool[iNeg2], cut, nullptr, bootstrapweights);
+        });
       } // end of loop over mixed event pool
 
       if (nuls > 0 || nlspp > 0 || nlsmm > 0) {
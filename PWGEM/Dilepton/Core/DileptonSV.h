@@ -384,6 +384,14 @@ struct DileptonSV {
   std::vector<float> occ_bin_edges;
 
   int nmod = -1; // this is for flow analysis
+
+  // flow quantities of the collision being paired, computed once per collision for all its pairs
+  struct EventFlowInfo {
+    std::array<float, 2> qvector{999.f, 999.f}; // Q vector of the harmonic nmod from cfgQvecEstimator
+    float spResolution = 1.f;                    // SP resolution at the centrality and occupancy of the collision
+    float eventplane = 0.f;                      // event plane of the harmonic nmod from cfgQvecEstimator, in [-pi/nmod, pi/nmod)
+  };
+  EventFlowInfo fEventFlowInfo;
   float leptonM1 = 0.f;
   float leptonM2 = 0.f;
 
@@ -900,6 +908,20 @@ struct DileptonSV {
     return false;
   }
 
+  template <typename TCollision, typename TQvectors>
+  void cacheEventFlowInfo(TCollision const& collision, TQvectors const& qvectors)
+  {
+    if (nmod < 0) {
+      return;
+    }
+    fEventFlowInfo.qvector = qvectors[nmod][cfgQvecEstimator];
+    fEventFlowInfo.spResolution = getSPresolution(collision.centFT0C(), collision.trackOccupancyInTimeRange());
+    if (nmod == 2) {
+      const float eventplanes[7] = {collision.ep2ft0m(), collision.ep2ft0a(), collision.ep2ft0c(), collision.ep2btot(), collision.ep2bpos(), collision.ep2bneg(), collision.ep2fv0a()};
+      fEventFlowInfo.eventplane = RecoDecay::constrainAngle(eventplanes[cfgQvecEstimator], -o2::constants::math::PI / nmod, static_cast<uint>(nmod));
+    }
+  }
+
   template <typename TQvectors>
   bool isGoodQvector(TQvectors const& qvectors)
   {
@@ -1198,22 +1220,9 @@ struct DileptonSV {
         fRegistry.fill(HIST("Pair/") + HIST(event_pair_types[ev_id]) + HIST("lsmm/hs"), v12.M(), v12.Pt(), pair_dca, v12.Rapidity(), aco, asym, std::fabs(dphi_l_ll), cos_thetaPol, weight);
       }
     } else if (cfgAnalysisType == static_cast<int>(o2::aod::pwgem::dilepton::utils::pairutil::DileptonAnalysisType::kFlowV2SP)) {
-      std::array<float, 2> q2ft0m = {collision.q2xft0m(), collision.q2yft0m()};
-      std::array<float, 2> q2ft0a = {collision.q2xft0a(), collision.q2yft0a()};
-      std::array<float, 2> q2ft0c = {collision.q2xft0c(), collision.q2yft0c()};
-      std::array<float, 2> q2btot = {collision.q2xbtot(), collision.q2ybtot()};
-      std::array<float, 2> q2bpos = {collision.q2xbpos(), collision.q2ybpos()};
-      std::array<float, 2> q2bneg = {collision.q2xbneg(), collision.q2ybneg()};
-      std::array<float, 2> q2fv0a = {collision.q2xfv0a(), collision.q2yfv0a()};
-
-      std::vector<std::vector<std::array<float, 2>>> qvectors = {
-        {{999.f, 999.f}, {999.f, 999.f}, {999.f, 999.f}, {999.f, 999.f}, {999.f, 999.f}, {999.f, 999.f}, {999.f, 999.f}}, // 0th harmonics
-        {{999.f, 999.f}, {999.f, 999.f}, {999.f, 999.f}, {999.f, 999.f}, {999.f, 999.f}, {999.f, 999.f}, {999.f, 999.f}}, // 1st harmonics
-        {q2ft0m, q2ft0a, q2ft0c, q2btot, q2bpos, q2bneg, q2fv0a},                                                         // 2nd harmonics
-      };
-
       if constexpr (ev_id == 0) {
-        float sp = RecoDecay::dotProd(std::array<float, 2>{static_cast<float>(std::cos(nmod * v12.Phi())), static_cast<float>(std::sin(nmod * v12.Phi()))}, qvectors[nmod][cfgQvecEstimator]) / getSPresolution(collision.centFT0C(), collision.trackOccupancyInTimeRange());
+        double phi_ll = v12.Phi();
+        float sp = RecoDecay::dotProd(std::array<float, 2>{static_cast<float>(std::cos(nmod * phi_ll)), static_cast<float>(std::sin(nmod * phi_ll))}, fEventFlowInfo.qvector) / fEventFlowInfo.spResolution;
         if (t1.sign() * t2.sign() < 0) { // ULS
           fRegistry.fill(HIST("Pair/") + HIST(event_pair_types[ev_id]) + HIST("uls/hs"), v12.M(), v12.Pt(), pair_dca, v12.Rapidity(), sp, weight);
         } else if (t1.sign() > 0 && t2.sign() > 0) { // LS++
@@ -1266,24 +1275,11 @@ struct DileptonSV {
       }
 
     } else if (cfgAnalysisType == static_cast<int>(o2::aod::pwgem::dilepton::utils::pairutil::DileptonAnalysisType::kBootstrapv2)) {
-      std::array<float, 2> q2ft0m = {collision.q2xft0m(), collision.q2yft0m()};
-      std::array<float, 2> q2ft0a = {collision.q2xft0a(), collision.q2yft0a()};
-      std::array<float, 2> q2ft0c = {collision.q2xft0c(), collision.q2yft0c()};
-      std::array<float, 2> q2btot = {collision.q2xbtot(), collision.q2ybtot()};
-      std::array<float, 2> q2bpos = {collision.q2xbpos(), collision.q2ybpos()};
-      std::array<float, 2> q2bneg = {collision.q2xbneg(), collision.q2ybneg()};
-      std::array<float, 2> q2fv0a = {collision.q2xfv0a(), collision.q2yfv0a()};
-
-      std::vector<std::vector<std::array<float, 2>>> qvectors = {
-        {{999.f, 999.f}, {999.f, 999.f}, {999.f, 999.f}, {999.f, 999.f}, {999.f, 999.f}, {999.f, 999.f}, {999.f, 999.f}}, // 0th harmonics
-        {{999.f, 999.f}, {999.f, 999.f}, {999.f, 999.f}, {999.f, 999.f}, {999.f, 999.f}, {999.f, 999.f}, {999.f, 999.f}}, // 1st harmonics
-        {q2ft0m, q2ft0a, q2ft0c, q2btot, q2bpos, q2bneg, q2fv0a},                                                         // 2nd harmonics
-      };
-
       if constexpr (ev_id == 0) {
         // LOGF(info, "collision.centFT0C() = %f, collision.trackOccupancyInTimeRange() = %d, getSPresolution = %f", collision.centFT0C(), collision.trackOccupancyInTimeRange(), getSPresolution(collision.centFT0C(), collision.trackOccupancyInTimeRange()));
 
-        float sp = RecoDecay::dotProd(std::array<float, 2>{static_cast<float>(std::cos(nmod * v12.Phi())), static_cast<float>(std::sin(nmod * v12.Phi()))}, qvectors[nmod][cfgQvecEstimator]) / getSPresolution(collision.centFT0C(), collision.trackOccupancyInTimeRange());
+        double phi_ll = v12.Phi();
+        float sp = RecoDecay::dotProd(std::array<float, 2>{static_cast<float>(std::cos(nmod * phi_ll)), static_cast<float>(std::sin(nmod * phi_ll))}, fEventFlowInfo.qvector) / fEventFlowInfo.spResolution;
         for (int i = 0; i < cfgNumBootstrapSamples; i++) {
           if (t1.sign() * t2.sign() < 0) { // ULS
             fRegistry.fill(HIST("Pair/") + HIST(event_pair_types[ev_id]) + HIST("uls/hs"), v12.M(), v12.Pt(), pair_dca, v12.Rapidity(), sp, i + 0.5, weightvector.at(i));
@@ -1304,13 +1300,7 @@ struct DileptonSV {
       }
     } else if (cfgAnalysisType == static_cast<int>(o2::aod::pwgem::dilepton::utils::pairutil::DileptonAnalysisType::kFlowV2EP)) {
       if constexpr (ev_id == 0) {
-        std::vector<std::vector<float>> eventplanes = {
-          {0.f, 0.f, 0.f, 0.f, 0.f, 0.f, 0.f},                                                                                                                 // 0th harmonics
-          {0.f, 0.f, 0.f, 0.f, 0.f, 0.f, 0.f},                                                                                                                 // 1st harmonics
-          {collision.ep2ft0m(), collision.ep2ft0a(), collision.ep2ft0c(), collision.ep2btot(), collision.ep2bpos(), collision.ep2bneg(), collision.ep2fv0a()}, // 2nd harmonics
-        };
-
-        float ep = RecoDecay::constrainAngle(eventplanes[nmod][cfgQvecEstimator], -o2::constants::math::PI / nmod, static_cast<uint>(nmod));
+        float ep = fEventFlowInfo.eventplane;
         float phi_ll = RecoDecay::constrainAngle(v12.Phi(), -o2::constants::math::PI / nmod, 1U);
         float dphi_ll_ep = std::fabs(RecoDecay::constrainAngle(phi_ll - ep, 0.f, static_cast<uint>(nmod)));
 
@@ -1581,6 +1571,7 @@ struct DileptonSV {
       fRegistry.fill(HIST("Event/before/hCollisionCounter"), o2::aod::pwgem::dilepton::utils::eventhistogram::nbin_ev); // accepted
       fRegistry.fill(HIST("Event/after/hCollisionCounter"), o2::aod::pwgem::dilepton::utils::eventhistogram::nbin_ev);  // accepted
       fRegistry.fill(HIST("Event/after/hEP2_CentFT0C_forMix"), collision.centFT0C(), ep2);
+      cacheEventFlowInfo(collision, qvectors);
 
       auto posTracks_per_coll = posTracks.sliceByCached(perCollision, collision.globalIndex(), cache);
       auto negTracks_per_coll = negTracks.sliceByCached(perCollision, collision.globalIndex(), cache);
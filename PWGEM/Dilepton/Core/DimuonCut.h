@@ -279,6 +279,12 @@ class DimuonCut : public TNamed
   void SetMaxDiffMatchingChi2MCHMFT(float diff);
   void EnableTTCA(bool flag);
 
+  // Getters
+  float GetMinPairMass() const { return mMinMass; }
+  float GetMaxPairMass() const { return mMaxMass; }
+  float GetMinPairPt() const { return mMinPairPt; }
+  float GetMaxPairPt() const { return mMaxPairPt; }
+
  private:
   // pair cuts
   float mMinMass{0.f}, mMaxMass{1e10f};
@@ -14,6 +14,7 @@
 /// \author Daiki Sekihata, daiki.sekihata@cern.ch
 
 #include "PWGEM/Dilepton/DataModel/dileptonTables.h"
+#include "PWGEM/Dilepton/Utils/EMDerivedDataWriter.h"
 
 #include "Common/CCDB/EventSelectionParams.h"
 #include "Common/DataModel/Centrality.h"
@@ -42,6 +43,7 @@ using namespace o2::aod;
 using namespace o2::framework;
 using namespace o2::framework::expressions;
 using namespace o2::soa;
+using namespace o2::aod::pwgem::dilepton::utils::emderiveddata;
 
 using MyBCs = soa::Join<aod::BCsWithTimestamps, aod::BcSels>;
 // using MyMults = soa::Join<aod::Mults, /*aod::MultsGlobal,*/ aod::FT0MultZeqs, aod::PVMultZeqs/*, aod::GlobalMultZeqs*/>;
@@ -105,9 +107,55 @@ struct CreateEMEventDilepton {
   int mRunNumber{0};
   // Service<o2::ccdb::BasicCCDBManager> ccdb;
 
+  template <bool isMC, bool isTriggerAnalysis, typename TCollision>
+  bool isSelectedEvent(TCollision const& collision)
+  {
+    if constexpr (isMC) {
+      if (!collision.has_mcCollision()) {
+        return false;
+      }
+    }
+    if (!collision.isSelected()) { // minimal cut for MB
+      return false;
+    }
+    if (!collision.isEoI()) { // events with at least 1 lepton for data reduction.
+      return false;
+    }
+    if constexpr (isTriggerAnalysis) {
+      if (collision.swtaliastmp_raw() == 0) {
+        return false;
+      }
+    }
+    return true;
+  }
+
   template <bool isMC, bool isTriggerAnalysis, EMEventType eventtype, typename TCollisions, typename TBCs>
   void skimEvent(TCollisions const& collisions, TBCs const& bcs)
   {
+    // counting pass, so that the table builders are allocated once per data frame
+    int64_t nTVXBCs = 0, nTVXCollisions = 0, nSelectedCollisions = 0;
+    for (const auto& bc : bcs) {
+      if (bc.selection_bit(o2::aod::evsel::kIsTriggerTVX)) {
+        nTVXBCs++;
+      }
+    }
+    for (const auto& collision : collisions) {
+      if constexpr (isMC) {
+        if (!collision.has_mcCollision()) {
+          continue;
+        }
+      }
+      if (collision.selection_bit(o2::aod::evsel::kIsTriggerTVX)) {
+        nTVXCollisions++;
+      }
+      if (isSelectedEvent<isMC, isTriggerAnalysis>(collision)) {
+        nSelectedCollisions++;
+      }
+    }
+    reserveRows(nTVXBCs, embc);
+    reserveRows(nTVXCollisions, event_norm_info);
+    reserveRows(nSelectedCollisions, event, eventXY, eventcov, event_mult, event_cent, event_qvec2, event_qvec3);
+
     for (const auto& bc : bcs) {
       if (bc.selection_bit(o2::aod::evsel::kIsTriggerTVX)) {
         embc(o2::aod::emevsel::reduceSelectionBit(bc), bc.rct_raw()); // TVX is fired.
@@ -148,20 +196,10 @@ struct CreateEMEventDilepton {
         }
       }
 
-      if (!collision.isSelected()) { // minimal cut for MB
+      if (!isSelectedEvent<isMC, isTriggerAnalysis>(collision)) {
         continue;
       }
 
-      if (!collision.isEoI()) { // events with at least 1 lepton for data reduction.
-        continue;
-      }
-
-      if constexpr (isTriggerAnalysis) {
-        if (collision.swtaliastmp_raw() == 0) {
-          continue;
-        }
-      }
-
       registry.fill(HIST("hEventCounter"), 2);
 
       event(collision.globalIndex(), bc.runNumber(), bc.globalBC(), o2::aod::emevsel::reduceSelectionBit(collision), collision.rct_raw(), bc.timestamp(),
@@ -296,13 +334,13 @@ struct AssociateDileptonToEMEvent {
   Produces<o2::aod::EMPrimaryMuonEMEventIds> prmmueventid;
   Produces<o2::aod::EMPrimaryTrackEMEventIds> prmtrackeventid;
 
-  PresliceUnsorted<aod::EMPrimaryElectrons> perCollision_el = aod::emprimaryelectron::collisionId;
-  PresliceUnsorted<aod::EMPrimaryMuons> perCollision_mu = aod::emprimarymuon::collisionId;
   // Preslice<aod::EMPrimaryTracks> perCollision_track = aod::emprimarytrack::collisionId;
   Preslice<aod::EMPrimaryTrackEMEventIdsTMP> perCollision_track = aod::track::collisionId;
 
   void init(o2::framework::InitContext&) {}
 
+  EMIndexMap mapCollisionToEMEvent; // original collision index -> EM event index
+
   template <typename TCollisions, typename TLeptons, typename TEventIds, typename TPreslice>
   void fillEventId(TCollisions const& collisions, TLeptons const& leptons, TEventIds& eventIds, TPreslice const& perCollision)
   {
@@ -321,12 +359,12 @@ struct AssociateDileptonToEMEvent {
 
   void processElectron(aod::EMEvents const& collisions, aod::EMPrimaryElectrons const& tracks)
   {
-    fillEventId(collisions, tracks, prmeleventid, perCollision_el);
+    fillEventIds(collisions, tracks, prmeleventid, mapCollisionToEMEvent);
   }
 
   void processFwdMuon(aod::EMEvents const& collisions, aod::EMPrimaryMuons const& tracks)
   {
-    fillEventId(collisions, tracks, prmmueventid, perCollision_mu);
+    fillEventIds(collisions, tracks, prmmueventid, mapCollisionToEMEvent);
   }
 
   void processChargedTrack(aod::EMEvents const& collisions, soa::Join<aod::EMPrimaryTracks, aod::EMPrimaryTrackEMEventIdsTMP> const& tracks)
@@ -44,9 +44,12 @@
 #include <Math/Vector4D.h> // IWYU pragma: keep (do not replace with Math/Vector4Dfwd.h)
 #include <Math/Vector4Dfwd.h>
 
+#include <algorithm>
 #include <cmath>
 #include <cstddef>
 #include <cstdint>
+#include <iterator>
+#include <numeric>
 #include <string>
 #include <tuple>
 #include <unordered_map>
@@ -79,6 +82,7 @@ struct prefilterDielectron {
   Configurable<int> cfgCentEstimator{"cfgCentEstimator", 2, "FT0M:0, FT0A:1, FT0C:2"};
   Configurable<float> cfgCentMin{"cfgCentMin", -1, "min. centrality"};
   Configurable<float> cfgCentMax{"cfgCentMax", 999.f, "max. centrality"};
+  Configurable<bool> cfgFastTagging{"cfgFastTagging", false, "search only for the first partner of each bit in momentum (mass, phiv) or eta (deta-dphi) order. Pair QA histograms are not filled."};
 
   EMEventCut fEMEventCut;
   struct : ConfigurableGroup {
@@ -314,6 +318,173 @@ struct prefilterDielectron {
 
   std::unordered_map<int, uint16_t> map_pfb; // map track.globalIndex -> prefilter bit
 
+  // selected electron for the fast tagging
+  struct TaggedElectron {
+    int globalIndex;
+    int index; // order in the table, to keep the order of the LS pairs
+    int8_t sign;
+    ROOT::Math::PtEtaPhiMVector v;
+    double p;
+    uint16_t pfb;
+  };
+  std::vector<TaggedElectron> posElectrons, negElectrons; // sorted by momentum
+  std::vector<int> posOrderInEta, negOrderInEta;
+
+  template <typename TTracks>
+  void selectElectrons(TTracks const& tracks, std::vector<TaggedElectron>& electrons, std::vector<int>& orderInEta)
+  {
+    electrons.clear();
+    int index = 0;
+    for (const auto& track : tracks) {
+      if (fDielectronCut.IsSelectedTrack(track)) {
+        ROOT::Math::PtEtaPhiMVector v(track.pt(), track.eta(), track.phi(), o2::constants::physics::MassElectron);
+        electrons.emplace_back(TaggedElectron{static_cast<int>(track.globalIndex()), index, track.sign(), v, v.P(), 0});
+      }
+      index++;
+    }
+    std::sort(electrons.begin(), electrons.end(), [](const auto& a, const auto& b) { return a.p < b.p; });
+    orderInEta.resize(electrons.size());
+    std::iota(orderInEta.begin(), orderInEta.end(), 0);
+    std::sort(orderInEta.begin(), orderInEta.end(), [&electrons](int a, int b) { return electrons[a].v.Eta() < electrons[b].v.Eta(); });
+  }
+
+  // same conditions as in processPFB, t1 is the positron for ULS pairs and the first track in the table for LS pairs
+  uint16_t pairPFB(TaggedElectron const& t1, TaggedElectron const& t2, uint16_t bits)
+  {
+    uint16_t pfb = 0;
+    ROOT::Math::PtEtaPhiMVector v12 = t1.v + t2.v;
+    if ((bits & (1 << static_cast<int>(DileptonPrefilterBitDerived::kMee))) && dielectroncuts.cfg_min_mass < v12.M() && v12.M() < dielectroncuts.cfg_max_mass) {
+      pfb |= 1 << static_cast<int>(DileptonPrefilterBitDerived::kMee);
+    }
+    if (bits & (1 << static_cast<int>(DileptonPrefilterBitDerived::kPhiV))) {
+      float phiv = getPhivPair(t1.v.Px(), t1.v.Py(), t1.v.Pz(), t2.v.Px(), t2.v.Py(), t2.v.Pz(), t1.sign, t2.sign, d_bz);
+      if ((v12.M() < dielectroncuts.cfg_phiv_slope * phiv + dielectroncuts.cfg_phiv_intercept) && (dielectroncuts.cfg_min_phiv < phiv && phiv < dielectroncuts.cfg_max_phiv)) {
+        pfb |= 1 << static_cast<int>(DileptonPrefilterBitDerived::kPhiV);
+      }
+    }
+    if (bits & (1 << static_cast<int>(DileptonPrefilterBitDerived::kSplitOrMergedTrackLS) | 1 << static_cast<int>(DileptonPrefilterBitDerived::kSplitOrMergedTrackULS))) {
+      bool isULS = t1.sign * t2.sign < 0;
+      float deta = t1.sign * t1.v.Pt() > t2.sign * t2.v.Pt() ? t1.v.Eta() - t2.v.Eta() : t2.v.Eta() - t1.v.Eta();
+      float dphi = t1.sign * t1.v.Pt() > t2.sign * t2.v.Pt() ? t1.v.Phi() - t2.v.Phi() : t2.v.Phi() - t1.v.Phi();
+      dphi = RecoDecay::constrainAngle(dphi, -M_PI, 1U); // -pi - +pi
+      float minDeta = isULS ? dielectroncuts.cfg_min_deta_uls : dielectroncuts.cfg_min_deta_ls;
+      float minDphi = isULS ? dielectroncuts.cfg_min_dphi_uls : dielectroncuts.cfg_min_dphi_ls;
+      if (std::pow(deta / minDeta, 2) + std::pow(dphi / minDphi, 2) < 1.f) {
+        pfb |= 1 << static_cast<int>(isULS ? DileptonPrefilterBitDerived::kSplitOrMergedTrackULS : DileptonPrefilterBitDerived::kSplitOrMergedTrackLS);
+      }
+    }
+    return bits & pfb;
+  }
+
+  // highest mass which can set one of the mass bits
+  float maxTaggedMass(uint16_t bits)
+  {
+    float maxMass = 0.f;
+    if (bits & (1 << static_cast<int>(DileptonPrefilterBitDerived::kMee))) {
+      maxMass = std::max(maxMass, dielectroncuts.cfg_max_mass.value);
+    }
+    if (bits & (1 << static_cast<int>(DileptonPrefilterBitDerived::kPhiV))) {
+      float minPhiv = std::max(dielectroncuts.cfg_min_phiv.value, 0.f), maxPhiv = std::min(dielectroncuts.cfg_max_phiv.value, static_cast<float>(M_PI));
+      maxMass = std::max({maxMass, dielectroncuts.cfg_phiv_slope * minPhiv + dielectroncuts.cfg_phiv_intercept, dielectroncuts.cfg_phiv_slope * maxPhiv + dielectroncuts.cfg_phiv_intercept});
+    }
+    return maxMass;
+  }
+
+  // ULS mass bits of the electrons of one charge, with the partners of the other charge.
+  // The partners are sorted by momentum, and the lowest mass of a pair with momenta p1 and p2, 2 m_e^2 + 2 (E1 E2 - p1 p2),
+  // grows with |p2 - p1|, so the search goes outwards from p1 and stops as soon as it is above the mass range.
+  void tagMassBits(std::vector<TaggedElectron>& electrons, std::vector<TaggedElectron>& partners, uint16_t massBits)
+  {
+    const double me2 = o2::constants::physics::MassElectron * o2::constants::physics::MassElectron;
+    for (auto& t1 : electrons) {
+      uint16_t bits = massBits & ~t1.pfb;
+      if (bits == 0) {
+        continue;
+      }
+      const double maxMass = maxTaggedMass(bits);
+      const double maxMass2 = maxMass * maxMass * (1.0 + 1e-6) + 1e-12;
+      const double e1 = std::sqrt(t1.p * t1.p + me2);
+      auto isBelowMaxMass = [&](TaggedElectron const& t2) {
+        return 2.0 * (me2 + std::sqrt(t2.p * t2.p + me2) * e1 - t1.p * t2.p) < maxMass2;
+      };
+      auto tag = [&](TaggedElectron& t2) {
+        uint16_t pfb = t1.sign > 0 ? pairPFB(t1, t2, bits) : pairPFB(t2, t1, bits);
+        t1.pfb |= pfb;
+        t2.pfb |= pfb;
+        bits &= ~pfb;
+      };
+      auto first = std::lower_bound(partners.begin(), partners.end(), t1.p, [](const auto& t, double p) { return t.p < p; });
+      for (auto up = first; bits != 0 && up != partners.end() && isBelowMaxMass(*up); ++up) {
+        tag(*up);
+      }
+      for (auto down = first; bits != 0 && down != partners.begin() && isBelowMaxMass(*std::prev(down)); --down) {
+        tag(*std::prev(down));
+      }
+    }
+  }
+
+  // deta-dphi bit of the electrons, with the partners in an eta window of +-minDeta
+  void tagSplitOrMergedBit(std::vector<TaggedElectron>& electrons, std::vector<int> const& orderInEta, std::vector<TaggedElectron>& partners, std::vector<int> const& partnerOrderInEta, uint16_t bit, double minDeta)
+  {
+    const bool isLS = &electrons == &partners;
+    std::size_t firstInWindow = 0;
+    for (const auto& i1 : orderInEta) {
+      auto& t1 = electrons[i1];
+      const double eta1 = t1.v.Eta();
+      while (firstInWindow < partnerOrderInEta.size() && eta1 - partners[partnerOrderInEta[firstInWindow]].v.Eta() >= minDeta) {
+        firstInWindow++;
+      }
+      for (std::size_t j = firstInWindow; (t1.pfb & bit) == 0 && j < partnerOrderInEta.size(); j++) {
+        auto& t2 = partners[partnerOrderInEta[j]];
+        if (t2.v.Eta() - eta1 >= minDeta) {
+          break;
+        }
+        if (isLS && &t1 == &t2) {
+          continue;
+        }
+        uint16_t pfb = isLS ? (t1.index < t2.index ? pairPFB(t1, t2, bit) : pairPFB(t2, t1, bit)) : (t1.sign > 0 ? pairPFB(t1, t2, bit) : pairPFB(t2, t1, bit));
+        t1.pfb |= pfb;
+        t2.pfb |= pfb;
+      }
+    }
+  }
+
+  template <typename TTracks>
+  void tagCollision(TTracks const& posTracks_per_coll, TTracks const& negTracks_per_coll)
+  {
+    selectElectrons(posTracks_per_coll, posElectrons, posOrderInEta);
+    selectElectrons(negTracks_per_coll, negElectrons, negOrderInEta);
+
+    uint16_t massBits = 0;
+    if (dielectroncuts.cfg_min_mass < dielectroncuts.cfg_max_mass) {
+      massBits |= 1 << static_cast<int>(DileptonPrefilterBitDerived::kMee);
+    }
+    if (dielectroncuts.cfg_apply_phiv && dielectroncuts.cfg_min_phiv < dielectroncuts.cfg_max_phiv) {
+      massBits |= 1 << static_cast<int>(DileptonPrefilterBitDerived::kPhiV);
+    }
+    if (massBits != 0 && maxTaggedMass(massBits) > 0.f) {
+      tagMassBits(posElectrons, negElectrons, massBits);
+      tagMassBits(negElectrons, posElectrons, massBits); // for the electrons which are not the partner of an already tagged positron
+    }
+    if (dielectroncuts.cfg_apply_detadphi_uls) {
+      const uint16_t bit = 1 << static_cast<int>(DileptonPrefilterBitDerived::kSplitOrMergedTrackULS);
+      tagSplitOrMergedBit(posElectrons, posOrderInEta, negElectrons, negOrderInEta, bit, dielectroncuts.cfg_min_deta_uls);
+      tagSplitOrMergedBit(negElectrons, negOrderInEta, posElectrons, posOrderInEta, bit, dielectroncuts.cfg_min_deta_uls);
+    }
+    if (dielectroncuts.cfg_apply_detadphi_ls) {
+      const uint16_t bit = 1 << static_cast<int>(DileptonPrefilterBitDerived::kSplitOrMergedTrackLS);
+      tagSplitOrMergedBit(posElectrons, posOrderInEta, posElectrons, posOrderInEta, bit, dielectroncuts.cfg_min_deta_ls);
+      tagSplitOrMergedBit(negElectrons, negOrderInEta, negElectrons, negOrderInEta, bit, dielectroncuts.cfg_min_deta_ls);
+    }
+
+    for (const auto& electron : posElectrons) {
+      map_pfb[electron.globalIndex] = electron.pfb;
+    }
+    for (const auto& electron : negElectrons) {
+      map_pfb[electron.globalIndex] = electron.pfb;
+    }
+  }
+
   SliceCache cache;
   Preslice<MyTracks> perCollision_track = aod::emprimaryelectron::emeventId;
   Partition<MyTracks> posTracks = o2::aod::emprimaryelectron::sign > int8_t(0);
@@ -353,6 +524,11 @@ struct prefilterDielectron {
 
       // LOGF(info, "centrality = %f , posTracks_per_coll.size() = %d, negTracks_per_coll.size() = %d", centralities[cfgCentEstimator], posTracks_per_coll.size(), negTracks_per_coll.size());
 
+      if (cfgFastTagging) {
+        tagCollision(posTracks_per_coll, negTracks_per_coll);
+        continue;
+      }
+
       for (const auto& [pos, ele] : combinations(CombinationsFullIndexPolicy(posTracks_per_coll, negTracks_per_coll))) { // ULS
         if (!fDielectronCut.IsSelectedTrack(pos) || !fDielectronCut.IsSelectedTrack(ele)) {
           continue;
@@ -444,6 +620,11 @@ struct prefilterDielectron {
       pfb_derived(map_pfb[track.globalIndex()]);
     } // end of track loop
 
+    if (cfgFastTagging) {
+      map_pfb.clear();
+      return;
+    }
+
     // check pfb.
     for (const auto& collision : collisions) {
       const float centralities[3] = {collision.centFT0M(), collision.centFT0A(), collision.centFT0C()};
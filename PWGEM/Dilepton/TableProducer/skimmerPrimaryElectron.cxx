@@ -13,6 +13,7 @@
 /// \author daiki.sekihata@cern.ch
 
 #include "PWGEM/Dilepton/DataModel/dileptonTables.h"
+#include "PWGEM/Dilepton/Utils/EMDerivedDataWriter.h"
 #include "PWGEM/Dilepton/Utils/MlResponseO2Track.h"
 #include "PWGEM/Dilepton/Utils/PairUtilities.h"
 
@@ -171,9 +172,12 @@ struct skimmerPrimaryElectron {
   // Configurable<int64_t> timestampCCDB{"timestampCCDB", -1, "timestamp of the ONNX file for ML model used to query in CCDB.  Exceptions: > 0 for the specific timestamp, 0 gets the run dependent timestamp"};
   Configurable<bool> loadModelsFromCCDB{"loadModelsFromCCDB", false, "Flag to enable or disable the loading of models from CCDB"};
   Configurable<bool> enableOptimizations{"enableOptimizations", false, "Enables the ONNX extended model-optimization: sessionOptions.SetGraphOptimizationLevel(GraphOptimizationLevel::ORT_ENABLE_EXTENDED)"};
+  Configurable<bool> batchPIDML{"batchPIDML", false, "Evaluate the PID ML models once per collision for all the tracks, instead of track by track"};
 
   HistogramRegistry fRegistry{"output", {}, OutputObjHandlingPolicy::AnalysisObject, false, false};
   o2::analysis::MlResponseO2Track<float> mlResponseSingleTrack;
+  std::vector<float> mlInputFeatures; // features of one track, reused for all the tracks of a batch
+  std::vector<float> mlOutputScores;  // scores of one track of the evaluated batch
 
   int mRunNumber;
   float d_bz;
@@ -468,6 +472,48 @@ struct skimmerPrimaryElectron {
     }
   }
 
+  // Same as fillMLPIDTable for all the tracks of a collision. With batchPIDML, the features of all the tracks are gathered
+  // first and each model is evaluated once, then the scores are written in the same order as track by track.
+  template <typename TCollision, typename TTracks, typename TGetTrack>
+  void fillMLPIDTables(TCollision const& collision, TTracks const& tracks, TGetTrack const& getTrack)
+  {
+    if (!usePIDML || !batchPIDML) {
+      for (const auto& entry : tracks) {
+        fillMLPIDTable(collision, getTrack(entry));
+      }
+      return;
+    }
+
+    mlResponseSingleTrack.clearBatch();
+    for (const auto& entry : tracks) {
+      auto track = getTrack(entry);
+      auto trackParCov = getTrackParCov(track);
+      trackParCov.setPID(o2::track::PID::Electron);
+      float beta = mapTOFBetaReassociated[std::make_pair(collision.globalIndex(), track.globalIndex())];
+      float tofNSigmaEl = mapTOFNsigmaReassociated[std::make_pair(collision.globalIndex(), track.globalIndex())];
+      mlResponseSingleTrack.fillInputFeatures(mlInputFeatures, track, trackParCov, collision, beta, tofNSigmaEl);
+      float binningFeature = mlResponseSingleTrack.getBinningFeature(track, trackParCov, collision, beta, tofNSigmaEl);
+
+      int pbin = lower_bound(binsMl.value.begin(), binsMl.value.end(), binningFeature) - binsMl.value.begin() - 1;
+      if (pbin < 0) {
+        pbin = 0;
+      } else if (static_cast<int>(binsMl.value.size()) - 2 < pbin) {
+        pbin = static_cast<int>(binsMl.value.size()) - 2;
+      }
+      mlResponseSingleTrack.addToBatchInModel(mlInputFeatures, pbin);
+    }
+    mlResponseSingleTrack.evaluateBatch();
+
+    int iCandidate = 0;
+    for (const auto& entry : tracks) {
+      auto track = getTrack(entry);
+      mlResponseSingleTrack.isSelectedMlBatch(iCandidate++, mlOutputScores);
+      float probaEl = mlOutputScores[1]; // 0: hadron, 1:electron
+      mapProbaEl[std::make_pair(collision.globalIndex(), track.globalIndex())] = probaEl;
+      emmlpids(collision.globalIndex(), track.globalIndex(), probaEl);
+    }
+  }
+
   template <typename TCollision, typename TTrack>
   bool isElectron(TCollision const& collision, TTrack const& track)
   {
@@ -552,7 +598,7 @@ struct skimmerPrimaryElectron {
   template <bool isMC, typename TCollision, typename TTrack>
   void fillTrackTable(TCollision const& collision, TTrack const& track)
   {
-    if (std::find(stored_trackIds.begin(), stored_trackIds.end(), std::pair<int, int>{collision.globalIndex(), track.globalIndex()}) == stored_trackIds.end()) {
+    if (!stored_trackIds.contains(collision.globalIndex(), track.globalIndex())) {
       o2::dataformats::DCA mDcaInfoCov;
       mDcaInfoCov.set(999, 999, 999, 999, 999);
       auto trackParCov = getTrackParCov(track);
@@ -615,7 +661,7 @@ struct skimmerPrimaryElectron {
         trackParCov.getSigma1PtTgl(),
         trackParCov.getSigma1Pt2());
 
-      stored_trackIds.emplace_back(std::pair<int, int>{collision.globalIndex(), track.globalIndex()});
+      stored_trackIds.insert(collision.globalIndex(), track.globalIndex(), emprimaryelectrons.lastIndex());
 
       if (fillQAHistogram) {
         // uint32_t itsClusterSizes = track.itsClusterSizes();
@@ -759,14 +805,14 @@ struct skimmerPrimaryElectron {
   }
 
   Preslice<aod::TrackAssoc> trackIndicesPerCollision = aod::track_association::collisionId;
-  std::vector<std::pair<int, int>> stored_trackIds;
+  o2::aod::pwgem::dilepton::utils::emderiveddata::EMStoredTrackMap stored_trackIds; // pair(collisionId, trackId) -> electron index
   Filter trackFilter = ncheckbit(aod::track::v001::detectorMap, (uint8_t)o2::aod::track::ITS) == true && ncheckbit(aod::track::v001::detectorMap, (uint8_t)o2::aod::track::TPC) == true;
   using MyFilteredTracks = soa::Filtered<MyTracks>;
 
   Partition<MyTracks> posTracks = o2::aod::track::signed1Pt > 0.f;
   Partition<MyTracks> negTracks = o2::aod::track::signed1Pt < 0.f;
 
-  std::unordered_multimap<int, int> multiMapTracksPerCollision; // collisionId -> trackIds
+  o2::aod::pwgem::dilepton::utils::emderiveddata::EMTracksPerCollision electronsPerCollision; // collisionId -> trackIds
 
   std::unordered_map<int, double> mapCollisionTime;
   std::unordered_map<int, double> mapCollisionTimeError;
@@ -779,7 +825,7 @@ struct skimmerPrimaryElectron {
 
   void processRec_SA(MyCollisions const& collisions, aod::BCsWithTimestamps const& bcs, MyFilteredTracks const& tracks)
   {
-    stored_trackIds.reserve(tracks.size());
+    stored_trackIds.reset(tracks.size());
 
     initCCDB(bcs.iteratorAt(0));
     mTOFResponse->processSetup(bcs.iteratorAt(0));
@@ -795,36 +841,36 @@ struct skimmerPrimaryElectron {
       }
 
       auto tracks_per_coll = tracks.sliceBy(perCol, collision.globalIndex());
+      fillMLPIDTables(collision, tracks_per_coll, [](auto const& track) { return track; });
       for (const auto& track : tracks_per_coll) {
-        fillMLPIDTable(collision, track);
         if (!checkTrack<false>(collision, track)) {
           continue;
         }
         if (!isElectron(collision, track)) {
           continue;
         }
-        multiMapTracksPerCollision.insert(std::make_pair(collision.globalIndex(), track.globalIndex()));
+        electronsPerCollision.add(collision.globalIndex(), track.globalIndex());
       }
     } // end of collision loop
 
+    electronsPerCollision.build(collisions.size());
+    o2::aod::pwgem::dilepton::utils::emderiveddata::reserveRows(electronsPerCollision.size(), emprimaryelectrons, emprimaryelectronscov);
     for (const auto& collision : collisions) {
-      int count_electrons = multiMapTracksPerCollision.count(collision.globalIndex());
+      int count_electrons = electronsPerCollision.count(collision.globalIndex());
       if (fillQAHistogram) {
         fRegistry.fill(HIST("Track/hNe"), count_electrons);
       }
       if (count_electrons >= minNelectron) {
-        auto range_electrons = multiMapTracksPerCollision.equal_range(collision.globalIndex());
-        for (auto it = range_electrons.first; it != range_electrons.second; it++) {
-          auto track = tracks.rawIteratorAt(it->second);
+        for (const auto& trackId : electronsPerCollision.get(collision.globalIndex())) {
+          auto track = tracks.rawIteratorAt(trackId);
           fillTrackTable<false>(collision, track);
         }
       }
     } // end of collision loop
 
     mapProbaEl.clear();
-    multiMapTracksPerCollision.clear();
-    stored_trackIds.clear();
-    stored_trackIds.shrink_to_fit();
+    electronsPerCollision.clear();
+    stored_trackIds.finalize();
 
     mapCollisionTime.clear();
     mapCollisionTimeError.clear();
@@ -835,7 +881,7 @@ struct skimmerPrimaryElectron {
 
   void processRec_TTCA(MyCollisions const& collisions, aod::BCsWithTimestamps const& bcs, MyTracks const& tracks, aod::TrackAssoc const& trackIndices)
   {
-    stored_trackIds.reserve(tracks.size() * 2);
+    stored_trackIds.reset(tracks.size());
 
     initCCDB(bcs.iteratorAt(0));
     mTOFResponse->processSetup(bcs.iteratorAt(0));
@@ -859,37 +905,37 @@ struct skimmerPrimaryElectron {
 
       auto trackIdsThisCollision = trackIndices.sliceBy(trackIndicesPerCollision, collision.globalIndex());
 
+      fillMLPIDTables(collision, trackIdsThisCollision, [](auto const& trackId) { return trackId.template track_as<MyTracks>(); });
       for (const auto& trackId : trackIdsThisCollision) {
         auto track = trackId.template track_as<MyTracks>();
-        fillMLPIDTable(collision, track);
         if (!checkTrack<false>(collision, track)) {
           continue;
         }
         if (!isElectron(collision, track)) {
           continue;
         }
-        multiMapTracksPerCollision.insert(std::make_pair(collision.globalIndex(), track.globalIndex()));
+        electronsPerCollision.add(collision.globalIndex(), track.globalIndex());
       }
     } // end of collision loop
 
+    electronsPerCollision.build(collisions.size());
+    o2::aod::pwgem::dilepton::utils::emderiveddata::reserveRows(electronsPerCollision.size(), emprimaryelectrons, emprimaryelectronscov);
     for (const auto& collision : collisions) {
-      int count_electrons = multiMapTracksPerCollision.count(collision.globalIndex());
+      int count_electrons = electronsPerCollision.count(collision.globalIndex());
       if (fillQAHistogram) {
         fRegistry.fill(HIST("Track/hNe"), count_electrons);
       }
       if (count_electrons >= minNelectron) {
-        auto range_electrons = multiMapTracksPerCollision.equal_range(collision.globalIndex());
-        for (auto it = range_electrons.first; it != range_electrons.second; it++) {
-          auto track = tracks.rawIteratorAt(it->second);
+        for (const auto& trackId : electronsPerCollision.get(collision.globalIndex())) {
+          auto track = tracks.rawIteratorAt(trackId);
           fillTrackTable<false>(collision, track);
         }
       }
     } // end of collision loop
 
     mapProbaEl.clear();
-    multiMapTracksPerCollision.clear();
-    stored_trackIds.clear();
-    stored_trackIds.shrink_to_fit();
+    electronsPerCollision.clear();
+    stored_trackIds.finalize();
     mapCollisionTime.clear();
     mapCollisionTimeError.clear();
     mapTOFNsigmaReassociated.clear();
@@ -899,7 +945,7 @@ struct skimmerPrimaryElectron {
 
   void processRec_SA_SWT(MyCollisionsWithSWT const& collisions, aod::BCsWithTimestamps const& bcs, MyFilteredTracks const& tracks)
   {
-    stored_trackIds.reserve(tracks.size());
+    stored_trackIds.reset(tracks.size());
     initCCDB(bcs.iteratorAt(0));
     mTOFResponse->processSetup(bcs.iteratorAt(0));
     calculateTOFNSigmaWithReassociation<false>(collisions, bcs, tracks, nullptr);
@@ -917,37 +963,37 @@ struct skimmerPrimaryElectron {
       }
 
       auto tracks_per_coll = tracks.sliceBy(perCol, collision.globalIndex());
+      fillMLPIDTables(collision, tracks_per_coll, [](auto const& track) { return track; });
       for (const auto& track : tracks_per_coll) {
-        fillMLPIDTable(collision, track);
         if (!checkTrack<false>(collision, track)) {
           continue;
         }
         if (!isElectron(collision, track)) {
           continue;
         }
-        multiMapTracksPerCollision.insert(std::make_pair(collision.globalIndex(), track.globalIndex()));
+        electronsPerCollision.add(collision.globalIndex(), track.globalIndex());
       }
 
     } // end of collision loop
 
+    electronsPerCollision.build(collisions.size());
+    o2::aod::pwgem::dilepton::utils::emderiveddata::reserveRows(electronsPerCollision.size(), emprimaryelectrons, emprimaryelectronscov);
     for (const auto& collision : collisions) {
-      int count_electrons = multiMapTracksPerCollision.count(collision.globalIndex());
+      int count_electrons = electronsPerCollision.count(collision.globalIndex());
       if (fillQAHistogram) {
         fRegistry.fill(HIST("Track/hNe"), count_electrons);
       }
       if (count_electrons >= minNelectron) {
-        auto range_electrons = multiMapTracksPerCollision.equal_range(collision.globalIndex());
-        for (auto it = range_electrons.first; it != range_electrons.second; it++) {
-          auto track = tracks.rawIteratorAt(it->second);
+        for (const auto& trackId : electronsPerCollision.get(collision.globalIndex())) {
+          auto track = tracks.rawIteratorAt(trackId);
           fillTrackTable<false>(collision, track);
         }
       }
     } // end of collision loop
 
     mapProbaEl.clear();
-    multiMapTracksPerCollision.clear();
-    stored_trackIds.clear();
-    stored_trackIds.shrink_to_fit();
+    electronsPerCollision.clear();
+    stored_trackIds.finalize();
     mapCollisionTime.clear();
     mapCollisionTimeError.clear();
     mapTOFNsigmaReassociated.clear();
@@ -957,7 +1003,7 @@ struct skimmerPrimaryElectron {
 
   void processRec_TTCA_SWT(MyCollisionsWithSWT const& collisions, aod::BCsWithTimestamps const& bcs, MyTracks const& tracks, aod::TrackAssoc const& trackIndices)
   {
-    stored_trackIds.reserve(tracks.size() * 2);
+    stored_trackIds.reset(tracks.size());
     initCCDB(bcs.iteratorAt(0));
     mTOFResponse->processSetup(bcs.iteratorAt(0));
     for (const auto& track : tracks) {
@@ -982,37 +1028,37 @@ struct skimmerPrimaryElectron {
 
       auto trackIdsThisCollision = trackIndices.sliceBy(trackIndicesPerCollision, collision.globalIndex());
 
+      fillMLPIDTables(collision, trackIdsThisCollision, [](auto const& trackId) { return trackId.template track_as<MyTracks>(); });
       for (const auto& trackId : trackIdsThisCollision) {
         auto track = trackId.template track_as<MyTracks>();
-        fillMLPIDTable(collision, track);
         if (!checkTrack<false>(collision, track)) {
           continue;
         }
         if (!isElectron(collision, track)) {
           continue;
         }
-        multiMapTracksPerCollision.insert(std::make_pair(collision.globalIndex(), track.globalIndex()));
+        electronsPerCollision.add(collision.globalIndex(), track.globalIndex());
       }
     } // end of collision loop
 
+    electronsPerCollision.build(collisions.size());
+    o2::aod::pwgem::dilepton::utils::emderiveddata::reserveRows(electronsPerCollision.size(), emprimaryelectrons, emprimaryelectronscov);
     for (const auto& collision : collisions) {
-      int count_electrons = multiMapTracksPerCollision.count(collision.globalIndex());
+      int count_electrons = electronsPerCollision.count(collision.globalIndex());
       if (fillQAHistogram) {
         fRegistry.fill(HIST("Track/hNe"), count_electrons);
       }
       if (count_electrons >= minNelectron) {
-        auto range_electrons = multiMapTracksPerCollision.equal_range(collision.globalIndex());
-        for (auto it = range_electrons.first; it != range_electrons.second; it++) {
-          auto track = tracks.rawIteratorAt(it->second);
+        for (const auto& trackId : electronsPerCollision.get(collision.globalIndex())) {
+          auto track = tracks.rawIteratorAt(trackId);
           fillTrackTable<false>(collision, track);
         }
       }
     } // end of collision loop
 
     mapProbaEl.clear();
-    multiMapTracksPerCollision.clear();
-    stored_trackIds.clear();
-    stored_trackIds.shrink_to_fit();
+    electronsPerCollision.clear();
+    stored_trackIds.finalize();
     mapCollisionTime.clear();
     mapCollisionTimeError.clear();
     mapTOFNsigmaReassociated.clear();
@@ -1027,7 +1073,7 @@ struct skimmerPrimaryElectron {
   Partition<MyTracksMC> negTracksMC = o2::aod::track::signed1Pt < 0.f;
   void processMC_SA(soa::Join<MyCollisions, aod::McCollisionLabels> const& collisions, aod::McCollisions const&, aod::BCsWithTimestamps const& bcs, MyFilteredTracksMC const& tracks, aod::McParticles const&)
   {
-    stored_trackIds.reserve(tracks.size());
+    stored_trackIds.reset(tracks.size());
     initCCDB(bcs.iteratorAt(0));
     mTOFResponse->processSetup(bcs.iteratorAt(0));
     calculateTOFNSigmaWithReassociation<false>(collisions, bcs, tracks, nullptr);
@@ -1044,36 +1090,36 @@ struct skimmerPrimaryElectron {
       }
 
       auto tracks_per_coll = tracks.sliceBy(perCol, collision.globalIndex());
+      fillMLPIDTables(collision, tracks_per_coll, [](auto const& track) { return track; });
       for (const auto& track : tracks_per_coll) {
-        fillMLPIDTable(collision, track);
         if (!checkTrack<true>(collision, track)) {
           continue;
         }
         if (!isElectron(collision, track)) {
           continue;
         }
-        multiMapTracksPerCollision.insert(std::make_pair(collision.globalIndex(), track.globalIndex()));
+        electronsPerCollision.add(collision.globalIndex(), track.globalIndex());
       }
     } // end of collision loop
 
+    electronsPerCollision.build(collisions.size());
+    o2::aod::pwgem::dilepton::utils::emderiveddata::reserveRows(electronsPerCollision.size(), emprimaryelectrons, emprimaryelectronscov);
     for (const auto& collision : collisions) {
-      int count_electrons = multiMapTracksPerCollision.count(collision.globalIndex());
+      int count_electrons = electronsPerCollision.count(collision.globalIndex());
       if (fillQAHistogram) {
         fRegistry.fill(HIST("Track/hNe"), count_electrons);
       }
       if (count_electrons >= minNelectron) {
-        auto range_electrons = multiMapTracksPerCollision.equal_range(collision.globalIndex());
-        for (auto it = range_electrons.first; it != range_electrons.second; it++) {
-          auto track = tracks.rawIteratorAt(it->second);
+        for (const auto& trackId : electronsPerCollision.get(collision.globalIndex())) {
+          auto track = tracks.rawIteratorAt(trackId);
           fillTrackTable<true>(collision, track);
         }
       }
     } // end of collision loop
 
     mapProbaEl.clear();
-    multiMapTracksPerCollision.clear();
-    stored_trackIds.clear();
-    stored_trackIds.shrink_to_fit();
+    electronsPerCollision.clear();
+    stored_trackIds.finalize();
     mapCollisionTime.clear();
     mapCollisionTimeError.clear();
     mapTOFNsigmaReassociated.clear();
@@ -1083,7 +1129,7 @@ struct skimmerPrimaryElectron {
 
   void processMC_TTCA(soa::Join<MyCollisions, aod::McCollisionLabels> const& collisions, aod::McCollisions const&, aod::BCsWithTimestamps const& bcs, MyTracksMC const& tracks, aod::TrackAssoc const& trackIndices, aod::McParticles const&)
   {
-    stored_trackIds.reserve(tracks.size() * 2);
+    stored_trackIds.reset(tracks.size());
     initCCDB(bcs.iteratorAt(0));
     mTOFResponse->processSetup(bcs.iteratorAt(0));
     for (const auto& track : tracks) {
@@ -1108,37 +1154,37 @@ struct skimmerPrimaryElectron {
 
       auto trackIdsThisCollision = trackIndices.sliceBy(trackIndicesPerCollision, collision.globalIndex());
 
+      fillMLPIDTables(collision, trackIdsThisCollision, [](auto const& trackId) { return trackId.template track_as<MyTracksMC>(); });
       for (const auto& trackId : trackIdsThisCollision) {
         auto track = trackId.template track_as<MyTracksMC>();
-        fillMLPIDTable(collision, track);
         if (!checkTrack<true>(collision, track)) {
           continue;
         }
         if (!isElectron(collision, track)) {
           continue;
         }
-        multiMapTracksPerCollision.insert(std::make_pair(collision.globalIndex(), track.globalIndex()));
+        electronsPerCollision.add(collision.globalIndex(), track.globalIndex());
       }
     } // end of collision loop
 
+    electronsPerCollision.build(collisions.size());
+    o2::aod::pwgem::dilepton::utils::emderiveddata::reserveRows(electronsPerCollision.size(), emprimaryelectrons, emprimaryelectronscov);
     for (const auto& collision : collisions) {
-      int count_electrons = multiMapTracksPerCollision.count(collision.globalIndex());
+      int count_electrons = electronsPerCollision.count(collision.globalIndex());
       if (fillQAHistogram) {
         fRegistry.fill(HIST("Track/hNe"), count_electrons);
       }
       if (count_electrons >= minNelectron) {
-        auto range_electrons = multiMapTracksPerCollision.equal_range(collision.globalIndex());
-        for (auto it = range_electrons.first; it != range_electrons.second; it++) {
-          auto track = tracks.rawIteratorAt(it->second);
+        for (const auto& trackId : electronsPerCollision.get(collision.globalIndex())) {
+          auto track = tracks.rawIteratorAt(trackId);
           fillTrackTable<true>(collision, track);
         }
       }
     } // end of collision loop
 
     mapProbaEl.clear();
-    multiMapTracksPerCollision.clear();
-    stored_trackIds.clear();
-    stored_trackIds.shrink_to_fit();
+    electronsPerCollision.clear();
+    stored_trackIds.finalize();
     mapCollisionTime.clear();
     mapCollisionTimeError.clear();
     mapTOFNsigmaReassociated.clear();
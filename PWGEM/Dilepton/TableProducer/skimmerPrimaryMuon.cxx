@@ -13,6 +13,7 @@
 /// \author daiki.sekihata@cern.ch
 
 #include "PWGEM/Dilepton/DataModel/dileptonTables.h"
+#include "PWGEM/Dilepton/Utils/EMDerivedDataWriter.h"
 
 #include "Common/Core/fwdtrackUtilities.h"
 #include "Common/DataModel/CollisionAssociationTables.h"
@@ -675,8 +676,8 @@ struct skimmerPrimaryMuon {
   Preslice<aod::FwdTrackAssoc> fwdtrackIndicesPerCollision = aod::track_association::collisionId;
   PresliceUnsorted<aod::FwdTrackAssoc> fwdtrackIndicesPerFwdTrack = aod::track_association::fwdtrackId;
   PresliceUnsorted<aod::FwdTracks> fwdtracksPerMCHTrack = aod::fwdtrack::matchMCHTrackId;
-  std::unordered_multimap<int, int> multiMapSAMuonsPerCollision; // collisionId -> trackIds
-  std::unordered_multimap<int, int> multiMapGLMuonsPerCollision; // collisionId -> trackIds
+  o2::aod::pwgem::dilepton::utils::emderiveddata::EMTracksPerCollision saMuonsPerCollision; // collisionId -> trackIds
+  o2::aod::pwgem::dilepton::utils::emderiveddata::EMTracksPerCollision glMuonsPerCollision; // collisionId -> trackIds
 
   void processRec_SA(MyCollisions const& collisions, MyFwdTracks const& fwdtracks, aod::MFTTracks const& mfttracks, aod::BCsWithTimestamps const&)
   {
@@ -714,40 +715,41 @@ struct skimmerPrimaryMuon {
         }
 
         if (fwdtrack.trackType() == o2::aod::fwdtrack::ForwardTrackTypeEnum::GlobalMuonTrack) {
-          multiMapGLMuonsPerCollision.insert(std::make_pair(collision.globalIndex(), fwdtrack.globalIndex()));
+          glMuonsPerCollision.add(collision.globalIndex(), fwdtrack.globalIndex());
         }
         if (fwdtrack.trackType() == o2::aod::fwdtrack::ForwardTrackTypeEnum::MuonStandaloneTrack) {
-          multiMapSAMuonsPerCollision.insert(std::make_pair(collision.globalIndex(), fwdtrack.globalIndex()));
+          saMuonsPerCollision.add(collision.globalIndex(), fwdtrack.globalIndex());
         }
 
       } // end of fwdtrack loop
     } // end of collision loop
 
+    saMuonsPerCollision.build(collisions.size());
+    glMuonsPerCollision.build(collisions.size());
+    o2::aod::pwgem::dilepton::utils::emderiveddata::reserveRows(saMuonsPerCollision.size() + glMuonsPerCollision.size(), emprimarymuons, emprimarymuonscov);
     for (const auto& collision : collisions) {
-      int count_samuons = multiMapSAMuonsPerCollision.count(collision.globalIndex());
-      int count_glmuons = multiMapGLMuonsPerCollision.count(collision.globalIndex());
+      int count_samuons = saMuonsPerCollision.count(collision.globalIndex());
+      int count_glmuons = glMuonsPerCollision.count(collision.globalIndex());
       if (fillQAHistograms) {
         fRegistry.fill(HIST("MCHMID/hNmu"), count_samuons);
         fRegistry.fill(HIST("MFTMCHMID/hNmu"), count_glmuons);
       }
       if (count_samuons >= minNmuon) {
-        auto range_samuons = multiMapSAMuonsPerCollision.equal_range(collision.globalIndex());
-        for (auto it = range_samuons.first; it != range_samuons.second; it++) {
-          auto fwdtrack = fwdtracks.rawIteratorAt(it->second);
+        for (const auto& fwdtrackId : saMuonsPerCollision.get(collision.globalIndex())) {
+          auto fwdtrack = fwdtracks.rawIteratorAt(fwdtrackId);
           fillFwdTrackTable<false, false, MyFwdTracks, aod::MFTTracks, true>(collision, fwdtrack, nullptr, false);
         }
       }
       if (count_glmuons >= minNmuon) {
-        auto range_glmuons = multiMapGLMuonsPerCollision.equal_range(collision.globalIndex());
-        for (auto it = range_glmuons.first; it != range_glmuons.second; it++) {
-          auto fwdtrack = fwdtracks.rawIteratorAt(it->second);
+        for (const auto& fwdtrackId : glMuonsPerCollision.get(collision.globalIndex())) {
+          auto fwdtrack = fwdtracks.rawIteratorAt(fwdtrackId);
           fillFwdTrackTable<false, false, MyFwdTracks, aod::MFTTracks, true>(collision, fwdtrack, nullptr, false);
         }
       }
     } // end of collision loop
 
-    multiMapSAMuonsPerCollision.clear();
-    multiMapGLMuonsPerCollision.clear();
+    saMuonsPerCollision.clear();
+    glMuonsPerCollision.clear();
     map_mfttrackcovs.clear();
     vec_min_chi2MatchMCHMFT.clear();
     vec_min_chi2MatchMCHMFT.shrink_to_fit();
@@ -801,40 +803,41 @@ struct skimmerPrimaryMuon {
         }
 
         if (fwdtrack.trackType() == o2::aod::fwdtrack::ForwardTrackTypeEnum::GlobalMuonTrack) {
-          multiMapGLMuonsPerCollision.insert(std::make_pair(collision.globalIndex(), fwdtrack.globalIndex()));
+          glMuonsPerCollision.add(collision.globalIndex(), fwdtrack.globalIndex());
         }
         if (fwdtrack.trackType() == o2::aod::fwdtrack::ForwardTrackTypeEnum::MuonStandaloneTrack) {
-          multiMapSAMuonsPerCollision.insert(std::make_pair(collision.globalIndex(), fwdtrack.globalIndex()));
+          saMuonsPerCollision.add(collision.globalIndex(), fwdtrack.globalIndex());
         }
 
       } // end of fwdtrack loop
     } // end of collision loop
 
+    saMuonsPerCollision.build(collisions.size());
+    glMuonsPerCollision.build(collisions.size());
+    o2::aod::pwgem::dilepton::utils::emderiveddata::reserveRows(saMuonsPerCollision.size() + glMuonsPerCollision.size(), emprimarymuons, emprimarymuonscov);
     for (const auto& collision : collisions) {
-      int count_samuons = multiMapSAMuonsPerCollision.count(collision.globalIndex());
-      int count_glmuons = multiMapGLMuonsPerCollision.count(collision.globalIndex());
+      int count_samuons = saMuonsPerCollision.count(collision.globalIndex());
+      int count_glmuons = glMuonsPerCollision.count(collision.globalIndex());
       if (fillQAHistograms) {
         fRegistry.fill(HIST("MCHMID/hNmu"), count_samuons);
         fRegistry.fill(HIST("MFTMCHMID/hNmu"), count_glmuons);
       }
       if (count_samuons >= minNmuon) {
-        auto range_samuons = multiMapSAMuonsPerCollision.equal_range(collision.globalIndex());
-        for (auto it = range_samuons.first; it != range_samuons.second; it++) {
-          auto fwdtrack = fwdtracks.rawIteratorAt(it->second);
+        for (const auto& fwdtrackId : saMuonsPerCollision.get(collision.globalIndex())) {
+          auto fwdtrack = fwdtracks.rawIteratorAt(fwdtrackId);
           fillFwdTrackTable<false, false, MyFwdTracks, aod::MFTTracks, true>(collision, fwdtrack, nullptr, mapAmb[fwdtrack.globalIndex()]);
         }
       }
       if (count_glmuons >= minNmuon) {
-        auto range_glmuons = multiMapGLMuonsPerCollision.equal_range(collision.globalIndex());
-        for (auto it = range_glmuons.first; it != range_glmuons.second; it++) {
-          auto fwdtrack = fwdtracks.rawIteratorAt(it->second);
+        for (const auto& fwdtrackId : glMuonsPerCollision.get(collision.globalIndex())) {
+          auto fwdtrack = fwdtracks.rawIteratorAt(fwdtrackId);
           fillFwdTrackTable<false, false, MyFwdTracks, aod::MFTTracks, true>(collision, fwdtrack, nullptr, mapAmb[fwdtrack.globalIndex()]);
         }
       }
     } // end of collision loop
 
-    multiMapSAMuonsPerCollision.clear();
-    multiMapGLMuonsPerCollision.clear();
+    saMuonsPerCollision.clear();
+    glMuonsPerCollision.clear();
     mapAmb.clear();
     map_mfttrackcovs.clear();
     vec_min_chi2MatchMCHMFT.clear();
@@ -971,40 +974,41 @@ struct skimmerPrimaryMuon {
         }
 
         if (fwdtrack.trackType() == o2::aod::fwdtrack::ForwardTrackTypeEnum::GlobalMuonTrack) {
-          multiMapGLMuonsPerCollision.insert(std::make_pair(collision.globalIndex(), fwdtrack.globalIndex()));
+          glMuonsPerCollision.add(collision.globalIndex(), fwdtrack.globalIndex());
         }
         if (fwdtrack.trackType() == o2::aod::fwdtrack::ForwardTrackTypeEnum::MuonStandaloneTrack) {
-          multiMapSAMuonsPerCollision.insert(std::make_pair(collision.globalIndex(), fwdtrack.globalIndex()));
+          saMuonsPerCollision.add(collision.globalIndex(), fwdtrack.globalIndex());
         }
 
       } // end of fwdtrack loop
     } // end of collision loop
 
+    saMuonsPerCollision.build(collisions.size());
+    glMuonsPerCollision.build(collisions.size());
+    o2::aod::pwgem::dilepton::utils::emderiveddata::reserveRows(saMuonsPerCollision.size() + glMuonsPerCollision.size(), emprimarymuons, emprimarymuonscov);
     for (const auto& collision : collisions) {
-      int count_samuons = multiMapSAMuonsPerCollision.count(collision.globalIndex());
-      int count_glmuons = multiMapGLMuonsPerCollision.count(collision.globalIndex());
+      int count_samuons = saMuonsPerCollision.count(collision.globalIndex());
+      int count_glmuons = glMuonsPerCollision.count(collision.globalIndex());
       if (fillQAHistograms) {
         fRegistry.fill(HIST("MCHMID/hNmu"), count_samuons);
         fRegistry.fill(HIST("MFTMCHMID/hNmu"), count_glmuons);
       }
       if (count_samuons >= minNmuon) {
-        auto range_samuons = multiMapSAMuonsPerCollision.equal_range(collision.globalIndex());
-        for (auto it = range_samuons.first; it != range_samuons.second; it++) {
-          auto fwdtrack = fwdtracks.rawIteratorAt(it->second);
+        for (const auto& fwdtrackId : saMuonsPerCollision.get(collision.globalIndex())) {
+          auto fwdtrack = fwdtracks.rawIteratorAt(fwdtrackId);
           fillFwdTrackTable<false, false, MyFwdTracks, aod::MFTTracks, true>(collision, fwdtrack, nullptr, false);
         }
       }
       if (count_glmuons >= minNmuon) {
-        auto range_glmuons = multiMapGLMuonsPerCollision.equal_range(collision.globalIndex());
-        for (auto it = range_glmuons.first; it != range_glmuons.second; it++) {
-          auto fwdtrack = fwdtracks.rawIteratorAt(it->second);
+        for (const auto& fwdtrackId : glMuonsPerCollision.get(collision.globalIndex())) {
+          auto fwdtrack = fwdtracks.rawIteratorAt(fwdtrackId);
           fillFwdTrackTable<false, false, MyFwdTracks, aod::MFTTracks, true>(collision, fwdtrack, nullptr, false);
         }
       }
     } // end of collision loop
 
-    multiMapSAMuonsPerCollision.clear();
-    multiMapGLMuonsPerCollision.clear();
+    saMuonsPerCollision.clear();
+    glMuonsPerCollision.clear();
     map_mfttrackcovs.clear();
     vec_min_chi2MatchMCHMFT.clear();
     vec_min_chi2MatchMCHMFT.shrink_to_fit();
@@ -1057,40 +1061,41 @@ struct skimmerPrimaryMuon {
         }
 
         if (fwdtrack.trackType() == o2::aod::fwdtrack::ForwardTrackTypeEnum::GlobalMuonTrack) {
-          multiMapGLMuonsPerCollision.insert(std::make_pair(collision.globalIndex(), fwdtrack.globalIndex()));
+          glMuonsPerCollision.add(collision.globalIndex(), fwdtrack.globalIndex());
         }
         if (fwdtrack.trackType() == o2::aod::fwdtrack::ForwardTrackTypeEnum::MuonStandaloneTrack) {
-          multiMapSAMuonsPerCollision.insert(std::make_pair(collision.globalIndex(), fwdtrack.globalIndex()));
+          saMuonsPerCollision.add(collision.globalIndex(), fwdtrack.globalIndex());
         }
 
       } // end of fwdtrack loop
     } // end of collision loop
 
+    saMuonsPerCollision.build(collisions.size());
+    glMuonsPerCollision.build(collisions.size());
+    o2::aod::pwgem::dilepton::utils::emderiveddata::reserveRows(saMuonsPerCollision.size() + glMuonsPerCollision.size(), emprimarymuons, emprimarymuonscov);
     for (const auto& collision : collisions) {
-      int count_samuons = multiMapSAMuonsPerCollision.count(collision.globalIndex());
-      int count_glmuons = multiMapGLMuonsPerCollision.count(collision.globalIndex());
+      int count_samuons = saMuonsPerCollision.count(collision.globalIndex());
+      int count_glmuons = glMuonsPerCollision.count(collision.globalIndex());
       if (fillQAHistograms) {
         fRegistry.fill(HIST("MCHMID/hNmu"), count_samuons);
         fRegistry.fill(HIST("MFTMCHMID/hNmu"), count_glmuons);
       }
       if (count_samuons >= minNmuon) {
-        auto range_samuons = multiMapSAMuonsPerCollision.equal_range(collision.globalIndex());
-        for (auto it = range_samuons.first; it != range_samuons.second; it++) {
-          auto fwdtrack = fwdtracks.rawIteratorAt(it->second);
+        for (const auto& fwdtrackId : saMuonsPerCollision.get(collision.globalIndex())) {
+          auto fwdtrack = fwdtracks.rawIteratorAt(fwdtrackId);
           fillFwdTrackTable<false, false, MyFwdTracks, aod::MFTTracks, true>(collision, fwdtrack, nullptr, mapAmb[fwdtrack.globalIndex()]);
         }
       }
       if (count_glmuons >= minNmuon) {
-        auto range_glmuons = multiMapGLMuonsPerCollision.equal_range(collision.globalIndex());
-        for (auto it = range_glmuons.first; it != range_glmuons.second; it++) {
-          auto fwdtrack = fwdtracks.rawIteratorAt(it->second);
+        for (const auto& fwdtrackId : glMuonsPerCollision.get(collision.globalIndex())) {
+          auto fwdtrack = fwdtracks.rawIteratorAt(fwdtrackId);
           fillFwdTrackTable<false, false, MyFwdTracks, aod::MFTTracks, true>(collision, fwdtrack, nullptr, mapAmb[fwdtrack.globalIndex()]);
         }
       }
     } // end of collision loop
 
-    multiMapSAMuonsPerCollision.clear();
-    multiMapGLMuonsPerCollision.clear();
+    saMuonsPerCollision.clear();
+    glMuonsPerCollision.clear();
     mapAmb.clear();
     map_mfttrackcovs.clear();
     vec_min_chi2MatchMCHMFT.clear();
@@ -1228,40 +1233,41 @@ struct skimmerPrimaryMuon {
         }
 
         if (fwdtrack.trackType() == o2::aod::fwdtrack::ForwardTrackTypeEnum::GlobalMuonTrack) {
-          multiMapGLMuonsPerCollision.insert(std::make_pair(collision.globalIndex(), fwdtrack.globalIndex()));
+          glMuonsPerCollision.add(collision.globalIndex(), fwdtrack.globalIndex());
         }
         if (fwdtrack.trackType() == o2::aod::fwdtrack::ForwardTrackTypeEnum::MuonStandaloneTrack) {
-          multiMapSAMuonsPerCollision.insert(std::make_pair(collision.globalIndex(), fwdtrack.globalIndex()));
+          saMuonsPerCollision.add(collision.globalIndex(), fwdtrack.globalIndex());
         }
 
       } // end of fwdtrack loop
     } // end of collision loop
 
+    saMuonsPerCollision.build(collisions.size());
+    glMuonsPerCollision.build(collisions.size());
+    o2::aod::pwgem::dilepton::utils::emderiveddata::reserveRows(saMuonsPerCollision.size() + glMuonsPerCollision.size(), emprimarymuons, emprimarymuonscov);
     for (const auto& collision : collisions) {
-      int count_samuons = multiMapSAMuonsPerCollision.count(collision.globalIndex());
-      int count_glmuons = multiMapGLMuonsPerCollision.count(collision.globalIndex());
+      int count_samuons = saMuonsPerCollision.count(collision.globalIndex());
+      int count_glmuons = glMuonsPerCollision.count(collision.globalIndex());
       if (fillQAHistograms) {
         fRegistry.fill(HIST("MCHMID/hNmu"), count_samuons);
         fRegistry.fill(HIST("MFTMCHMID/hNmu"), count_glmuons);
       }
       if (count_samuons >= minNmuon) {
-        auto range_samuons = multiMapSAMuonsPerCollision.equal_range(collision.globalIndex());
-        for (auto it = range_samuons.first; it != range_samuons.second; it++) {
-          auto fwdtrack = fwdtracks.rawIteratorAt(it->second);
+        for (const auto& fwdtrackId : saMuonsPerCollision.get(collision.globalIndex())) {
+          auto fwdtrack = fwdtracks.rawIteratorAt(fwdtrackId);
           fillFwdTrackTable<false, false, MyFwdTracksMC, MFTTracksMC, true>(collision, fwdtrack, nullptr, false);
         }
       }
       if (count_glmuons >= minNmuon) {
-        auto range_glmuons = multiMapGLMuonsPerCollision.equal_range(collision.globalIndex());
-        for (auto it = range_glmuons.first; it != range_glmuons.second; it++) {
-          auto fwdtrack = fwdtracks.rawIteratorAt(it->second);
+        for (const auto& fwdtrackId : glMuonsPerCollision.get(collision.globalIndex())) {
+          auto fwdtrack = fwdtracks.rawIteratorAt(fwdtrackId);
           fillFwdTrackTable<false, false, MyFwdTracksMC, MFTTracksMC, true>(collision, fwdtrack, nullptr, false);
         }
       }
     } // end of collision loop
 
-    multiMapSAMuonsPerCollision.clear();
-    multiMapGLMuonsPerCollision.clear();
+    saMuonsPerCollision.clear();
+    glMuonsPerCollision.clear();
     map_mfttrackcovs.clear();
     vec_min_chi2MatchMCHMFT.clear();
     vec_min_chi2MatchMCHMFT.shrink_to_fit();
@@ -1317,40 +1323,41 @@ struct skimmerPrimaryMuon {
         }
 
         if (fwdtrack.trackType() == o2::aod::fwdtrack::ForwardTrackTypeEnum::GlobalMuonTrack) {
-          multiMapGLMuonsPerCollision.insert(std::make_pair(collision.globalIndex(), fwdtrack.globalIndex()));
+          glMuonsPerCollision.add(collision.globalIndex(), fwdtrack.globalIndex());
         }
         if (fwdtrack.trackType() == o2::aod::fwdtrack::ForwardTrackTypeEnum::MuonStandaloneTrack) {
-          multiMapSAMuonsPerCollision.insert(std::make_pair(collision.globalIndex(), fwdtrack.globalIndex()));
+          saMuonsPerCollision.add(collision.globalIndex(), fwdtrack.globalIndex());
         }
 
       } // end of fwdtrack loop
     } // end of collision loop
 
+    saMuonsPerCollision.build(collisions.size());
+    glMuonsPerCollision.build(collisions.size());
+    o2::aod::pwgem::dilepton::utils::emderiveddata::reserveRows(saMuonsPerCollision.size() + glMuonsPerCollision.size(), emprimarymuons, emprimarymuonscov);
     for (const auto& collision : collisions) {
-      int count_samuons = multiMapSAMuonsPerCollision.count(collision.globalIndex());
-      int count_glmuons = multiMapGLMuonsPerCollision.count(collision.globalIndex());
+      int count_samuons = saMuonsPerCollision.count(collision.globalIndex());
+      int count_glmuons = glMuonsPerCollision.count(collision.globalIndex());
       if (fillQAHistograms) {
         fRegistry.fill(HIST("MCHMID/hNmu"), count_samuons);
         fRegistry.fill(HIST("MFTMCHMID/hNmu"), count_glmuons);
       }
       if (count_samuons >= minNmuon) {
-        auto range_samuons = multiMapSAMuonsPerCollision.equal_range(collision.globalIndex());
-        for (auto it = range_samuons.first; it != range_samuons.second; it++) {
-          auto fwdtrack = fwdtracks.rawIteratorAt(it->second);
+        for (const auto& fwdtrackId : saMuonsPerCollision.get(collision.globalIndex())) {
+          auto fwdtrack = fwdtracks.rawIteratorAt(fwdtrackId);
           fillFwdTrackTable<true, false, MyFwdTracksMC, MFTTracksMC, true>(collision, fwdtrack, nullptr, mapAmb[fwdtrack.globalIndex()]);
         }
       }
       if (count_glmuons >= minNmuon) {
-        auto range_glmuons = multiMapGLMuonsPerCollision.equal_range(collision.globalIndex());
-        for (auto it = range_glmuons.first; it != range_glmuons.second; it++) {
-          auto fwdtrack = fwdtracks.rawIteratorAt(it->second);
+        for (const auto& fwdtrackId : glMuonsPerCollision.get(collision.globalIndex())) {
+          auto fwdtrack = fwdtracks.rawIteratorAt(fwdtrackId);
           fillFwdTrackTable<true, false, MyFwdTracksMC, MFTTracksMC, true>(collision, fwdtrack, nullptr, mapAmb[fwdtrack.globalIndex()]);
         }
       }
     } // end of collision loop
 
-    multiMapSAMuonsPerCollision.clear();
-    multiMapGLMuonsPerCollision.clear();
+    saMuonsPerCollision.clear();
+    glMuonsPerCollision.clear();
     mapAmb.clear();
     map_mfttrackcovs.clear();
     vec_min_chi2MatchMCHMFT.clear();
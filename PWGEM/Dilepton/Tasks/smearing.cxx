@@ -37,6 +37,7 @@
 #include <cstdint>
 #include <cstdlib>
 #include <string>
+#include <vector>
 
 using namespace o2;
 using namespace o2::framework;
@@ -67,6 +68,9 @@ struct ApplySmearing {
   Configurable<int64_t> fTimestamp{"cfgCcdbTimestamp", 10, "valid timestamp of CCDB object"};
   Configurable<float> fCentralityForCocktail{"cfgCentralityForCocktail", 5, "average centrality for cocktail"};
   Configurable<int> cfgCentEstimator{"cfgCentEstimator", 2, "FT0M:0, FT0A:1, FT0C:2"};
+  Configurable<bool> fUseLookupTables{"cfgUseLookupTables", false, "smear in batches with inverse-CDF lookup tables and counter-based random numbers (reproducible), not available for ND-correlated smearing"};
+  Configurable<int> fNQuantiles{"cfgNQuantiles", 1000, "number of quantiles per pt bin of the lookup tables"};
+  Configurable<int64_t> fSeed{"cfgSeed", 0, "seed of the counter-based random numbers"};
 
   struct : ConfigurableGroup {
     std::string prefix = "electron_filename_group";
@@ -131,6 +135,47 @@ struct ApplySmearing {
   Service<ccdb::BasicCCDBManager> ccdb;
   int mRunNumber{0};
 
+  // leptons of a data frame, smeared together when the lookup tables are used
+  struct LeptonBatch {
+    std::vector<float> centrality, ptgen, etagen, phigen;
+    std::vector<int> ch;
+    std::vector<uint64_t> counter;
+
+    void clear()
+    {
+      centrality.clear();
+      ptgen.clear();
+      etagen.clear();
+      phigen.clear();
+      ch.clear();
+      counter.clear();
+    }
+    void add(float cen, int charge, float pt, float eta, float phi, uint64_t cnt)
+    {
+      centrality.emplace_back(cen);
+      ch.emplace_back(charge);
+      ptgen.emplace_back(pt);
+      etagen.emplace_back(eta);
+      phigen.emplace_back(phi);
+      counter.emplace_back(cnt);
+    }
+    size_t size() const { return ptgen.size(); }
+  };
+  struct SmearedBatch {
+    std::vector<float> pt, eta, phi, dca;
+
+    void resize(size_t n)
+    {
+      pt.resize(n);
+      eta.resize(n);
+      phi.resize(n);
+      dca.resize(n);
+    }
+  };
+  LeptonBatch electronBatch, muonBatch;
+  SmearedBatch smearedElectronBatch, smearedStandaloneMuonBatch, smearedGlobalMuonBatch;
+  uint64_t nParticlesBefore{0}; // counter of the first particle of the data frame
+
   void init(InitContext&)
   {
     mRunNumber = 0;
@@ -217,14 +262,92 @@ struct ApplySmearing {
       smearer_GlobalMuon.setTimestamp(timestamp);
       smearer_GlobalMuon.setCcdb(ccdb);
     }
+    smearer_Electron.setUseLookupTables(fUseLookupTables, fNQuantiles);
+    smearer_StandaloneMuon.setUseLookupTables(fUseLookupTables, fNQuantiles);
+    smearer_GlobalMuon.setUseLookupTables(fUseLookupTables, fNQuantiles);
+    // independent random numbers for the 3 smearers, the standalone and global muons share the same counters
+    smearer_Electron.setSeed(static_cast<uint64_t>(fSeed.value) * 3);
+    smearer_StandaloneMuon.setSeed(static_cast<uint64_t>(fSeed.value) * 3 + 1);
+    smearer_GlobalMuon.setSeed(static_cast<uint64_t>(fSeed.value) * 3 + 2);
     smearer_Electron.init();
     smearer_StandaloneMuon.init();
     smearer_GlobalMuon.init();
   }
 
   template <o2::aod::pwgem::dilepton::smearing::EMAnaType type, typename TTracksMC, typename TCollisions, typename TMCCollisions>
-  void applySmearing(TTracksMC const& tracksMC, TCollisions const& collisions, TMCCollisions const&)
+  void applySmearingInBatch(TTracksMC const& tracksMC, TCollisions const& collisions, TMCCollisions const&)
+  {
+    // the counter of a particle is its position in the processed data, so the smearing does not depend on the batch
+    electronBatch.clear();
+    muonBatch.clear();
+    uint64_t counter = nParticlesBefore;
+    for (const auto& mctrack : tracksMC) {
+      float centrality = -1.f;
+      if constexpr (type == o2::aod::pwgem::dilepton::smearing::EMAnaType::kEfficiency) {
+        auto mccollision = mctrack.template emmcevent_as<TMCCollisions>();
+        if (mccollision.mpemeventId() > 0) { // if mc collisions are not reconstructed, such mc collisions should not enter efficiency calculation.
+          auto collision = collisions.rawIteratorAt(mccollision.mpemeventId());
+          centrality = std::array{collision.centFT0M(), collision.centFT0A(), collision.centFT0C()}[cfgCentEstimator];
+        }
+      } else {
+        centrality = fCentralityForCocktail;
+      }
+
+      int pdgCode = mctrack.pdgCode();
+      int ch = pdgCode < 0 ? 1 : -1;
+      if (std::abs(pdgCode) == 11) {
+        electronBatch.add(centrality, ch, mctrack.pt(), mctrack.eta(), mctrack.phi(), counter);
+      } else if (std::abs(pdgCode) == 13) {
+        muonBatch.add(centrality, ch, mctrack.pt(), mctrack.eta(), mctrack.phi(), counter);
+      }
+      counter++;
+    }
+    nParticlesBefore = counter;
+
+    smearedElectronBatch.resize(electronBatch.size());
+    smearer_Electron.applySmearingBatch(electronBatch.centrality, electronBatch.ch, electronBatch.ptgen, electronBatch.etagen, electronBatch.phigen, electronBatch.counter,
+                                        smearedElectronBatch.pt, smearedElectronBatch.eta, smearedElectronBatch.phi, smearedElectronBatch.dca);
+    smearedStandaloneMuonBatch.resize(muonBatch.size());
+    smearer_StandaloneMuon.applySmearingBatch(muonBatch.centrality, muonBatch.ch, muonBatch.ptgen, muonBatch.etagen, muonBatch.phigen, muonBatch.counter,
+                                              smearedStandaloneMuonBatch.pt, smearedStandaloneMuonBatch.eta, smearedStandaloneMuonBatch.phi, smearedStandaloneMuonBatch.dca);
+    smearedGlobalMuonBatch.resize(muonBatch.size());
+    smearer_GlobalMuon.applySmearingBatch(muonBatch.centrality, muonBatch.ch, muonBatch.ptgen, muonBatch.etagen, muonBatch.phigen, muonBatch.counter,
+                                          smearedGlobalMuonBatch.pt, smearedGlobalMuonBatch.eta, smearedGlobalMuonBatch.phi, smearedGlobalMuonBatch.dca);
+
+    // fill the tables in the particle order
+    size_t iElectron = 0, iMuon = 0;
+    for (const auto& mctrack : tracksMC) {
+      float ptgen = mctrack.pt();
+      float etagen = mctrack.eta();
+      float phigen = mctrack.phi();
+      int pdgCode = mctrack.pdgCode();
+      if (std::abs(pdgCode) == 11) {
+        float efficiency = smearer_Electron.getEfficiency(ptgen, etagen, phigen);
+        smearedelectron(smearedElectronBatch.pt[iElectron], smearedElectronBatch.eta[iElectron], smearedElectronBatch.phi[iElectron], efficiency, smearedElectronBatch.dca[iElectron]);
+        smearedmuon(ptgen, etagen, phigen, 1.f, 0.f, ptgen, etagen, phigen, 1.f, 0.f);
+        iElectron++;
+      } else if (std::abs(pdgCode) == 13) {
+        float efficiency_sa = smearer_StandaloneMuon.getEfficiency(ptgen, etagen, phigen);
+        float efficiency_gl = smearer_GlobalMuon.getEfficiency(ptgen, etagen, phigen);
+        smearedmuon(smearedStandaloneMuonBatch.pt[iMuon], smearedStandaloneMuonBatch.eta[iMuon], smearedStandaloneMuonBatch.phi[iMuon], efficiency_sa, smearedStandaloneMuonBatch.dca[iMuon],
+                    smearedGlobalMuonBatch.pt[iMuon], smearedGlobalMuonBatch.eta[iMuon], smearedGlobalMuonBatch.phi[iMuon], efficiency_gl, smearedGlobalMuonBatch.dca[iMuon]);
+        smearedelectron(ptgen, etagen, phigen, 1.f, 0.f);
+        iMuon++;
+      } else {
+        // don't apply smearing
+        smearedelectron(ptgen, etagen, phigen, 1.f, 0.f);
+        smearedmuon(ptgen, etagen, phigen, 1.f, 0.f, ptgen, etagen, phigen, 1.f, 0.f);
+      }
+    } // end of mc track loop
+  }
+
+  template <o2::aod::pwgem::dilepton::smearing::EMAnaType type, typename TTracksMC, typename TCollisions, typename TMCCollisions>
+  void applySmearing(TTracksMC const& tracksMC, TCollisions const& collisions, TMCCollisions const& mcCollisions)
   {
+    if (fUseLookupTables) {
+      applySmearingInBatch<type>(tracksMC, collisions, mcCollisions);
+      return;
+    }
     for (const auto& mctrack : tracksMC) {
       float ptgen = mctrack.pt();
       float etagen = mctrack.eta();
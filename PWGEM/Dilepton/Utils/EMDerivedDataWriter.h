@@ -0,0 +1,211 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \bookkeeping shared by the EM derived-data producers
+/// \author daiki.sekihata@cern.ch
+
+#ifndef PWGEM_DILEPTON_UTILS_EMDERIVEDDATAWRITER_H_
+#define PWGEM_DILEPTON_UTILS_EMDERIVEDDATAWRITER_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace o2::aod::pwgem::dilepton::utils::emderiveddata
+{
+
+// presets the capacity of the table builders, e.g. with the number of rows found in a counting pass
+template <typename... TCursors>
+void reserveRows(int64_t nRows, TCursors&... cursors)
+{
+  (cursors.reserve(nRows), ...);
+}
+
+// Dense translation from the index of a row in a parent table to the index of the corresponding derived row.
+// Rows which were not written keep -1. The storage is kept across data frames, so reset() only refills it.
+class EMIndexMap
+{
+ public:
+  static constexpr int32_t NotFound = -1;
+
+  void reset(std::size_t nEntries) { mIndices.assign(nEntries, NotFound); }
+
+  void set(int64_t parentIndex, int32_t derivedIndex)
+  {
+    if (parentIndex < 0) {
+      return;
+    }
+    if (static_cast<std::size_t>(parentIndex) >= mIndices.size()) {
+      mIndices.resize(parentIndex + 1, NotFound);
+    }
+    mIndices[parentIndex] = derivedIndex;
+  }
+
+  int32_t find(int64_t parentIndex) const
+  {
+    if (parentIndex < 0 || static_cast<std::size_t>(parentIndex) >= mIndices.size()) {
+      return NotFound;
+    }
+    return mIndices[parentIndex];
+  }
+
+ private:
+  std::vector<int32_t> mIndices;
+};
+
+// Tracks selected per collision, collected in a first pass and written per collision in a second one.
+// add() only appends to flat arrays, build() groups the tracks by collision with a counting sort,
+// keeping the order of insertion within a collision. The storage is kept across data frames.
+class EMTracksPerCollision
+{
+ public:
+  void add(int64_t collisionIndex, int64_t trackIndex)
+  {
+    if (collisionIndex < 0) {
+      return;
+    }
+    mCollisionIds.emplace_back(static_cast<int32_t>(collisionIndex));
+    mTrackIds.emplace_back(static_cast<int32_t>(trackIndex));
+  }
+
+  // to be called once all the tracks are added, before count() and get()
+  void build(std::size_t nCollisions)
+  {
+    for (const auto& collisionId : mCollisionIds) {
+      if (static_cast<std::size_t>(collisionId) >= nCollisions) {
+        nCollisions = collisionId + 1;
+      }
+    }
+    mOffsets.assign(nCollisions + 1, 0);
+    for (const auto& collisionId : mCollisionIds) {
+      mOffsets[collisionId + 1]++;
+    }
+    for (std::size_t i = 0; i < nCollisions; i++) {
+      mOffsets[i + 1] += mOffsets[i];
+    }
+    mGrouped.resize(mTrackIds.size());
+    mFill.assign(mOffsets.begin(), mOffsets.end() - 1);
+    for (std::size_t i = 0; i < mTrackIds.size(); i++) {
+      mGrouped[mFill[mCollisionIds[i]]++] = mTrackIds[i];
+    }
+  }
+
+  int count(int64_t collisionIndex) const { return get(collisionIndex).size(); }
+
+  std::span<const int32_t> get(int64_t collisionIndex) const
+  {
+    if (collisionIndex < 0 || static_cast<std::size_t>(collisionIndex) + 1 >= mOffsets.size()) {
+      return {};
+    }
+    return std::span<const int32_t>(mGrouped.data() + mOffsets[collisionIndex], mOffsets[collisionIndex + 1] - mOffsets[collisionIndex]);
+  }
+
+  std::size_t size() const { return mTrackIds.size(); }
+
+  void clear()
+  {
+    mCollisionIds.clear();
+    mTrackIds.clear();
+    mOffsets.clear();
+    mFill.clear();
+    mGrouped.clear();
+  }
+
+ private:
+  std::vector<int32_t> mCollisionIds; // per added track, the collision
+  std::vector<int32_t> mTrackIds;     // per added track, the track
+  std::vector<int32_t> mOffsets;      // per collision, the first entry in mGrouped
+  std::vector<int32_t> mFill;         // per collision, the next entry to be filled by build()
+  std::vector<int32_t> mGrouped;      // tracks, grouped by collision
+};
+
+// Derived index of the (collision, track) pairs already written. A track is written once per compatible
+// collision at most, so its entries are chained through flat arrays instead of a node based container.
+class EMStoredTrackMap
+{
+ public:
+  static constexpr int32_t NotFound = -1;
+
+  void reset(std::size_t nTracks)
+  {
+    mFirstEntry.assign(nTracks, NotFound);
+    mEntryCollision.clear();
+    mEntryDerivedIndex.clear();
+    mEntryNext.clear();
+  }
+
+  void insert(int64_t collisionIndex, int64_t trackIndex, int32_t derivedIndex)
+  {
+    if (trackIndex < 0) {
+      return;
+    }
+    if (static_cast<std::size_t>(trackIndex) >= mFirstEntry.size()) {
+      mFirstEntry.resize(trackIndex + 1, NotFound);
+    }
+    int32_t entry = mEntryCollision.size();
+    mEntryCollision.emplace_back(static_cast<int32_t>(collisionIndex));
+    mEntryDerivedIndex.emplace_back(derivedIndex);
+    mEntryNext.emplace_back(mFirstEntry[trackIndex]);
+    mFirstEntry[trackIndex] = entry;
+  }
+
+  // returns the derived index of the pair, or NotFound if it was not written
+  int32_t find(int64_t collisionIndex, int64_t trackIndex) const
+  {
+    if (trackIndex < 0 || static_cast<std::size_t>(trackIndex) >= mFirstEntry.size()) {
+      return NotFound;
+    }
+    for (int32_t entry = mFirstEntry[trackIndex]; entry != NotFound; entry = mEntryNext[entry]) {
+      if (mEntryCollision[entry] == collisionIndex) {
+        return mEntryDerivedIndex[entry];
+      }
+    }
+    return NotFound;
+  }
+
+  bool contains(int64_t collisionIndex, int64_t trackIndex) const { return find(collisionIndex, trackIndex) != NotFound; }
+
+  // releases the memory at the end of a data frame
+  void finalize()
+  {
+    std::vector<int32_t>().swap(mFirstEntry);
+    std::vector<int32_t>().swap(mEntryCollision);
+    std::vector<int32_t>().swap(mEntryDerivedIndex);
+    std::vector<int32_t>().swap(mEntryNext);
+  }
+
+ private:
+  std::vector<int32_t> mFirstEntry;        // per track, the most recently inserted entry
+  std::vector<int32_t> mEntryCollision;    // per entry, the collision of the pair
+  std::vector<int32_t> mEntryDerivedIndex; // per entry, the derived track index
+  std::vector<int32_t> mEntryNext;         // per entry, the previous entry of the same track
+};
+
+// Writes the derived event index of every lepton, in the order of the lepton table.
+// The derived events are looked up through a dense map from the original collision index,
+// which replaces the per-event slicing of the lepton table.
+template <typename TEvents, typename TLeptons, typename TEventIds>
+void fillEventIds(TEvents const& events, TLeptons const& leptons, TEventIds& eventIds, EMIndexMap& map)
+{
+  map.reset(0);
+  for (const auto& event : events) {
+    map.set(event.collisionId(), event.globalIndex());
+  }
+  eventIds.reserve(leptons.size());
+  for (const auto& lepton : leptons) {
+    eventIds(map.find(lepton.collisionId()));
+  }
+}
+
+} // namespace o2::aod::pwgem::dilepton::utils::emderiveddata
+
+#endif // PWGEM_DILEPTON_UTILS_EMDERIVEDDATAWRITER_H_
@@ -15,67 +15,158 @@
 #ifndef PWGEM_DILEPTON_UTILS_EVENTMIXINGHANDLER_H_
 #define PWGEM_DILEPTON_UTILS_EVENTMIXINGHANDLER_H_
 
-#include <map>
+#include <cstddef>
+#include <functional>
+#include <span>
+#include <tuple>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
 namespace o2::aod::pwgem::dilepton::utils
 {
-template <typename T, typename U, typename V>
-class EventMixingHandler
+namespace detail
 {
- public:
-  EventMixingHandler()
-  {
-    fNdepth = 0;
-    fMapMixBins.clear();
-    fMap_Tracks_per_collision.clear();
-  }
+template <typename K, typename = void>
+struct IsTupleLike : std::false_type {
+};
+template <typename K>
+struct IsTupleLike<K, std::void_t<decltype(std::tuple_size<K>::value)>> : std::true_type {
+};
 
-  explicit EventMixingHandler(int ndepth)
+// hash of the bin and collision keys, which are integers or pairs/tuples of them
+struct MixingKeyHash {
+  template <typename K>
+  std::size_t operator()(const K& key) const
   {
-    fNdepth = ndepth;
-    fMapMixBins.clear();
-    fMap_Tracks_per_collision.clear();
+    if constexpr (IsTupleLike<K>::value) {
+      std::size_t seed = 0;
+      std::apply([&seed](const auto&... elems) { ((seed ^= std::hash<std::decay_t<decltype(elems)>>{}(elems) + 0x9e3779b9 + (seed << 6) + (seed >> 2)), ...); }, key);
+      return seed;
+    } else {
+      return std::hash<K>{}(key);
+    }
   }
+};
+} // namespace detail
 
-  ~EventMixingHandler()
-  {
-    fMapMixBins.clear();
-    fMap_Tracks_per_collision.clear();
-  }
+// T: key of the mixing bin, U: key of the collision, V: stored track
+// Each bin keeps up to ndepth collisions in a ring of slots, the track buffer of a slot is reused when the
+// oldest collision is replaced, so the pool does not reallocate once it is filled. The tracks are returned
+// as views on the pool, which are valid until the collision is replaced (or, for the collision being filled,
+// until a track is added to it).
+template <typename T, typename U, typename V>
+class EventMixingHandler
+{
+ public:
+  EventMixingHandler() = default;
 
+  explicit EventMixingHandler(int ndepth) : fNdepth(ndepth) {}
+
+  // to be called before the first collision is added
   void SetNdepth(int ndepth) { fNdepth = ndepth; }
 
   void ReserveNTracksPerCollision(U key_df_collision, int ntrack)
   {
-    fMap_Tracks_per_collision[key_df_collision].reserve(ntrack);
+    pendingTracks(key_df_collision).reserve(ntrack);
   }
 
   void AddTrackToEventPool(U key_df_collision, V obj)
   {
-    fMap_Tracks_per_collision[key_df_collision].emplace_back(obj);
+    pendingTracks(key_df_collision).emplace_back(obj);
   }
 
-  std::vector<U> GetCollisionIdsFromEventPool(T key_bin) { return fMapMixBins[key_bin]; }
-  std::vector<V> GetTracksPerCollision(T key_bin, int index) { return fMap_Tracks_per_collision[fMapMixBins[key_bin][index]]; }
-  std::vector<V> GetTracksPerCollision(U key_df_collision) { return fMap_Tracks_per_collision[key_df_collision]; }
+  // collisions of the bin, from the oldest to the newest
+  std::span<const U> GetCollisionIdsFromEventPool(T key_bin) const
+  {
+    auto bin = fBins.find(key_bin);
+    if (bin == fBins.end()) {
+      return {};
+    }
+    return bin->second.ids;
+  }
+  std::span<const V> GetTracksPerCollision(T key_bin, int index) const
+  {
+    auto bin = fBins.find(key_bin);
+    if (bin == fBins.end() || index < 0 || index >= static_cast<int>(bin->second.ids.size())) {
+      return {};
+    }
+    return GetTracksPerCollision(bin->second.ids[index]);
+  }
+  // tracks of a pooled collision, or of the collision being filled
+  std::span<const V> GetTracksPerCollision(U key_df_collision) const
+  {
+    if (auto pending = fPending.find(key_df_collision); pending != fPending.end()) {
+      return pending->second;
+    }
+    if (auto pooled = fPooled.find(key_df_collision); pooled != fPooled.end()) {
+      return *pooled->second;
+    }
+    return {};
+  }
 
   // call this function at the end of collision loop
   void AddCollisionIdAtLast(T key_bin, U key_df_collision)
   {
-    // LOGF(info, "fMapMixBins[key_bin].size() = %d", fMapMixBins[key_bin].size());
-    if (static_cast<int>(fMapMixBins[key_bin].size()) >= fNdepth) {
-      fMap_Tracks_per_collision[fMapMixBins[key_bin][0]].clear();
-      fMap_Tracks_per_collision[fMapMixBins[key_bin][0]].shrink_to_fit();
-      fMapMixBins[key_bin].erase(fMapMixBins[key_bin].begin());
+    if (fNdepth <= 0) {
+      fPending.erase(key_df_collision);
+      return;
+    }
+    auto& bin = fBins[key_bin];
+    Slot* slot = nullptr;
+    if (static_cast<int>(bin.ids.size()) >= fNdepth) {
+      // the oldest slot becomes the newest one
+      slot = &bin.slots[bin.oldest];
+      fPooled.erase(slot->key);
+      slot->tracks.clear();
+      bin.oldest = (bin.oldest + 1) % bin.slots.size();
+      bin.ids.erase(bin.ids.begin());
+    } else {
+      if (bin.slots.empty()) {
+        bin.slots.reserve(fNdepth); // the slots are never moved, fPooled points into them
+        bin.ids.reserve(fNdepth);
+      }
+      slot = &bin.slots.emplace_back();
     }
-    fMapMixBins[key_bin].emplace_back(key_df_collision);
+    slot->key = key_df_collision;
+    if (auto pending = fPending.find(key_df_collision); pending != fPending.end()) {
+      slot->tracks.swap(pending->second);
+      if (pending->second.capacity() > 0) {
+        fSpareBuffers.emplace_back(std::move(pending->second)); // cleared buffer of the replaced collision
+      }
+      fPending.erase(pending);
+    }
+    fPooled[key_df_collision] = &slot->tracks;
+    bin.ids.emplace_back(key_df_collision);
   }
 
  private:
-  int fNdepth;                                           // depth of event mixing
-  std::map<T, std::vector<U>> fMapMixBins;               // map : e.g. <zbin, centbin, epbin> -> pair<df index, global collision index>
-  std::map<U, std::vector<V>> fMap_Tracks_per_collision; // map : e.g. pair<df index, global collision index> -> track array
+  struct Slot {
+    U key{};
+    std::vector<V> tracks;
+  };
+  struct Bin {
+    std::vector<Slot> slots; // ring of at most fNdepth collisions
+    std::size_t oldest = 0;  // slot of the oldest collision, once the ring is full
+    std::vector<U> ids;      // collisions from the oldest to the newest
+  };
+
+  std::vector<V>& pendingTracks(const U& key_df_collision)
+  {
+    auto [pending, isNew] = fPending.try_emplace(key_df_collision);
+    if (isNew && !fSpareBuffers.empty()) {
+      pending->second.swap(fSpareBuffers.back());
+      fSpareBuffers.pop_back();
+    }
+    return pending->second;
+  }
+
+  int fNdepth = 0;                                                       // depth of event mixing
+  std::unordered_map<T, Bin, detail::MixingKeyHash> fBins;               // e.g. <zbin, centbin, epbin> -> pooled collisions
+  std::unordered_map<U, std::vector<V>*, detail::MixingKeyHash> fPooled; // e.g. pair<df index, global collision index> -> tracks in the pool
+  std::unordered_map<U, std::vector<V>, detail::MixingKeyHash> fPending; // tracks of the collisions not added to a bin yet
+  std::vector<std::vector<V>> fSpareBuffers;                             // track buffers to be reused
 };
 } // namespace o2::aod::pwgem::dilepton::utils
 #endif // PWGEM_DILEPTON_UTILS_EVENTMIXINGHANDLER_H_
@@ -253,6 +253,16 @@ class MlResponseO2Track : public MlResponse<TypeOutputScore>
     return inputFeatures;
   }
 
+  /// Same as getInputFeatures, filling a vector owned by the caller so that it is not reallocated for every track
+  template <typename T, typename U, typename V>
+  void fillInputFeatures(std::vector<float>& inputFeatures, T const& track, U const& trackParCov, V const& collision, const float beta = -1.f, const float tofNSigmaEl = -999.f)
+  {
+    inputFeatures.resize(MlResponse<TypeOutputScore>::mCachedIndices.size());
+    for (size_t i = 0; i < inputFeatures.size(); i++) {
+      inputFeatures[i] = return_feature(MlResponse<TypeOutputScore>::mCachedIndices[i], track, trackParCov, collision, beta, tofNSigmaEl);
+    }
+  }
+
   /// Method to get the value of variable chosen for binning
   /// \param track is the single track, \param collision is the collision
   /// \return binning variable
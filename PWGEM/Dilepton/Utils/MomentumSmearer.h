@@ -31,12 +31,21 @@
 #include <TObject.h>
 #include <TString.h>
 
+#include <algorithm>
 #include <cstdint>
+#include <span>
 #include <vector>
 
 class MomentumSmearer
 {
  public:
+  // inverse CDFs of the projections of a resolution map
+  struct InverseCDFTable {
+    std::vector<double> ptEdges;  // pt bin edges of the resolution map
+    std::vector<float> quantiles; // CDF^-1 at k / fNQuantiles, k = 0..fNQuantiles, for each pt bin
+    std::vector<bool> isFilled;   // false for the empty projections, which are not smeared
+  };
+
   /// Default constructor
   MomentumSmearer() = default;
 
@@ -368,9 +377,66 @@ class MomentumSmearer
       delete listDCA;
     }
 
+    if (fUseLookupTables) {
+      if (fDoNDSmearing) {
+        LOGP(warning, "Lookup tables are not available for ND-correlated smearing, histogram sampling is used");
+      } else {
+        LOGP(info, "Build inverse-CDF lookup tables with {} quantiles per pt bin", fNQuantiles);
+        if (fResType != 0) {
+          fillInverseCDFTable(fResoPt, fVecResoPt, fLutResoPt);
+          fillInverseCDFTable(fResoEta, fVecResoEta, fLutResoEta);
+          fillInverseCDFTable(fResoPhi_Pos, fVecResoPhi_Pos, fLutResoPhi_Pos);
+          fillInverseCDFTable(fResoPhi_Neg, fVecResoPhi_Neg, fLutResoPhi_Neg);
+        }
+        if (fDCAType != 0) {
+          fillInverseCDFTable(fDCA, fVecDCA, fLutDCA);
+        }
+      }
+    }
+
     fInitialized = true;
   }
 
+  /// Converts the projections of a resolution map into inverse CDFs sampled at nQuantiles + 1 points per pt bin.
+  /// As TH1::GetRandom, the bin contents are used as probabilities and the value is uniform within a bin.
+  void fillInverseCDFTable(TH2F* fReso, const std::vector<TH1F*>& fVecReso, InverseCDFTable& table)
+  {
+    TAxis* axisPt = fReso->GetXaxis();
+    int nBinsPt = axisPt->GetNbins();
+    table.ptEdges.resize(nBinsPt + 1);
+    for (int i = 0; i <= nBinsPt; i++) {
+      table.ptEdges[i] = axisPt->GetBinLowEdge(i + 1);
+    }
+    table.quantiles.assign(nBinsPt * (fNQuantiles + 1), 0.f);
+    table.isFilled.assign(nBinsPt, false);
+
+    std::vector<double> cdf;
+    for (int i = 0; i < nBinsPt; i++) {
+      TH1F* h1 = fVecReso[i];
+      TAxis* axis = h1->GetXaxis();
+      int nBins = axis->GetNbins();
+      cdf.assign(nBins + 1, 0.);
+      for (int j = 0; j < nBins; j++) {
+        cdf[j + 1] = cdf[j] + std::max(h1->GetBinContent(j + 1), 0.);
+      }
+      if (h1->GetEntries() <= 0 || cdf[nBins] <= 0.) {
+        continue; // no smearing, as in applySmearing
+      }
+      table.isFilled[i] = true;
+
+      float* quantiles = &table.quantiles[i * (fNQuantiles + 1)];
+      int j = 0;
+      for (int k = 0; k <= fNQuantiles; k++) {
+        double target = cdf[nBins] * k / fNQuantiles;
+        while (j < nBins - 1 && (cdf[j + 1] < target || cdf[j + 1] <= cdf[j])) { // skip the empty bins
+          j++;
+        }
+        double fraction = std::clamp((target - cdf[j]) / (cdf[j + 1] - cdf[j]), 0., 1.);
+        quantiles[k] = axis->GetBinLowEdge(j + 1) + axis->GetBinWidth(j + 1) * fraction;
+      }
+    }
+  }
+
   void applySmearing(const float ptgen, const float vargen, const float multiply, float& varsmeared, TH2F* fReso, std::vector<TH1F*>& fVecReso)
   {
     float ptgen_tmp = ptgen > fMinPtGen ? ptgen : fMinPtGen;
@@ -472,6 +538,36 @@ class MomentumSmearer
     // LOGF(info, "ptgen = %f (GeV/c), etagen = %f, phigen = %f (rad.), ptsmeared = %f (GeV/c), etasmeared = %f, phismeared = %f (rad.)", ptgen, etagen, phigen, ptsmeared, etasmeared, phismeared);
   }
 
+  /// Smears a batch of leptons with the lookup tables built at init.
+  /// The random numbers of lepton i only depend on the seed and on counters[i], so the result is reproducible
+  /// and does not depend on how the leptons are split into batches or threads.
+  /// Without lookup tables (ND-correlated smearing, or disabled), the histograms are sampled as in applySmearing.
+  void applySmearingBatch(std::span<const float> centrality, std::span<const int> ch, std::span<const float> ptgen, std::span<const float> etagen, std::span<const float> phigen, std::span<const uint64_t> counters,
+                          std::span<float> ptsmeared, std::span<float> etasmeared, std::span<float> phismeared, std::span<float> dca)
+  {
+    if (!fUseLookupTables || fDoNDSmearing) {
+      for (size_t i = 0; i < ptgen.size(); i++) {
+        applySmearing(centrality[i], ch[i], ptgen[i], etagen[i], phigen[i], ptsmeared[i], etasmeared[i], phismeared[i]);
+        dca[i] = getDCA(ptsmeared[i]);
+      }
+      return;
+    }
+
+    for (size_t i = 0; i < ptgen.size(); i++) {
+      if (fResType == 0) {
+        ptsmeared[i] = ptgen[i];
+        etasmeared[i] = etagen[i];
+        phismeared[i] = phigen[i];
+      } else {
+        float ptgen_tmp = ptgen[i] > fMinPtGen ? ptgen[i] : fMinPtGen;
+        ptsmeared[i] = ptgen[i] - sampleInverseCDF(fLutResoPt, ptgen_tmp, uniform(counters[i], 0)) * ptgen[i];
+        etasmeared[i] = etagen[i] - sampleInverseCDF(fLutResoEta, ptgen_tmp, uniform(counters[i], 1));
+        phismeared[i] = phigen[i] - sampleInverseCDF(ch[i] > 0 ? fLutResoPhi_Pos : fLutResoPhi_Neg, ptgen_tmp, uniform(counters[i], 2));
+      }
+      dca[i] = fDCAType == 0 ? 0.f : sampleInverseCDF(fLutDCA, ptsmeared[i], uniform(counters[i], 3));
+    }
+  }
+
   float getEfficiency(float pt, float eta, float phi)
   {
 
@@ -580,6 +676,12 @@ class MomentumSmearer
   }
   void setTimestamp(int64_t timestamp) { fTimestamp = timestamp; }
   void setMinPt(float minpt) { fMinPtGen = minpt; }
+  void setUseLookupTables(bool flag, int nQuantiles = 1000)
+  {
+    fUseLookupTables = flag;
+    fNQuantiles = nQuantiles > 0 ? nQuantiles : 1;
+  }
+  void setSeed(uint64_t seed) { fSeed = seed; }
 
   // getters
   bool getNDSmearing() { return fDoNDSmearing; }
@@ -602,8 +704,38 @@ class MomentumSmearer
   TString getCcdbPathEff() { return fCcdbPathEff; }
   TString getCcdbPathDCA() { return fCcdbPathDCA; }
   float getMinPt() { return fMinPtGen; }
+  bool getUseLookupTables() { return fUseLookupTables; }
+  uint64_t getSeed() { return fSeed; }
 
  private:
+  float sampleInverseCDF(const InverseCDFTable& table, const float pt, const double u) const
+  {
+    // same bin as TAxis::FindBin, under- and overflow go to the first and last bins
+    int nBinsPt = table.isFilled.size();
+    int ptbin = std::upper_bound(table.ptEdges.begin(), table.ptEdges.end(), pt) - table.ptEdges.begin() - 1;
+    ptbin = std::clamp(ptbin, 0, nBinsPt - 1);
+    if (!table.isFilled[ptbin]) {
+      return 0.f;
+    }
+    const float* quantiles = &table.quantiles[ptbin * (fNQuantiles + 1)];
+    double t = u * fNQuantiles;
+    int k = std::min(static_cast<int>(t), fNQuantiles - 1);
+    return quantiles[k] + (t - k) * (quantiles[k + 1] - quantiles[k]);
+  }
+
+  /// counter-based random number in [0, 1), a function of (fSeed, counter, stream) only
+  double uniform(const uint64_t counter, const uint64_t stream) const
+  {
+    uint64_t z = fSeed ^ ((counter * 4 + stream) * 0x9e3779b97f4a7c15ull);
+    for (int i = 0; i < 2; i++) { // splitmix64 finalizer
+      z += 0x9e3779b97f4a7c15ull;
+      z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+      z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+      z ^= z >> 31;
+    }
+    return (z >> 11) * 0x1.0p-53;
+  }
+
   bool fInitialized = false;
   bool fDoNDSmearing = false;
   TString fResFileName;
@@ -644,6 +776,14 @@ class MomentumSmearer
   bool fFromCcdb = false;
   o2::framework::Service<o2::ccdb::BasicCCDBManager> fCcdb;
   float fMinPtGen = -1.f;
+  bool fUseLookupTables = false;
+  int fNQuantiles = 1000;
+  uint64_t fSeed = 0;
+  InverseCDFTable fLutResoPt;
+  InverseCDFTable fLutResoEta;
+  InverseCDFTable fLutResoPhi_Pos;
+  InverseCDFTable fLutResoPhi_Neg;
+  InverseCDFTable fLutDCA;
 };
 
 #endif // PWGEM_DILEPTON_UTILS_MOMENTUMSMEARER_H_
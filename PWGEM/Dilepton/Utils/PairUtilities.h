@@ -29,8 +29,10 @@
 #include <Math/Vector4Dfwd.h>
 #include <TMathBase.h>
 
+#include <algorithm>
 #include <array>
 #include <cmath>
+#include <cstddef>
 #include <cstdint>
 #include <vector>
 
@@ -363,6 +365,84 @@ inline float getOpeningAngle(const float pxpos, const float pypos, const float p
   return std::acos(clipToPM1(argcos));
 }
 //_______________________________________________________________________
+// Float approximations for the pair loops, without branches that prevent vectorisation of the callers.
+// fastAtan2: minimax polynomial of order 11 for atan on [0, 1], max. abs. deviation from std::atan2 of 2.5e-6 rad.
+// fastAcos: Abramowitz-Stegun 4.4.46, max. abs. deviation from std::acos of 5e-7 rad on [-1, 1]. Arguments out of [-1, 1] are clipped.
+constexpr float fastAtan2(const float y, const float x)
+{
+  const float ax = x < 0.f ? -x : x;
+  const float ay = y < 0.f ? -y : y;
+  const float maxAbs = ax > ay ? ax : ay;
+  const float minAbs = ax > ay ? ay : ax;
+  if (maxAbs == 0.f) {
+    return 0.f;
+  }
+  const float a = minAbs / maxAbs;
+  const float s = a * a;
+  float r = a * (0.99997726f + s * (-0.33262347f + s * (0.19354346f + s * (-0.11643287f + s * (0.05265332f + s * -0.01172120f)))));
+  r = ay > ax ? 1.57079632679f - r : r;
+  r = x < 0.f ? 3.14159265359f - r : r;
+  return y < 0.f ? -r : r;
+}
+inline float fastAcos(float x)
+{
+  x = x < -1.f ? -1.f : (x > 1.f ? 1.f : x);
+  const float ax = x < 0.f ? -x : x;
+  float r = 1.5707963050f + ax * (-0.2145988016f + ax * (0.0889789874f + ax * (-0.0501743046f + ax * (0.0308918810f + ax * (-0.0170881256f + ax * (0.0066700901f + ax * -0.0012624911f))))));
+  r *= std::sqrt(1.f - ax);
+  return x < 0.f ? 3.14159265359f - r : r;
+}
+//_______________________________________________________________________
+// Same as getPhivPair, with the orientation of the cross product chosen without branches, one normalisation per vector and fastAcos.
+// The differences in the cross product are taken in double, as conversion pairs have tiny opening angles. The deviation from
+// a double precision phiv is the same as for getPhivPair: up to 1e-3 rad close to 0 and pi, where acos is steep, 3e-5 rad elsewhere.
+inline float getPhivPairFast(const float pxpos, const float pypos, const float pzpos, const float pxneg, const float pyneg, const float pzneg, const int8_t cpos, const int8_t cneg, const float bz)
+{
+  const float ptpos = std::sqrt(pxpos * pxpos + pypos * pypos);
+  const float ptneg = std::sqrt(pxneg * pxneg + pyneg * pyneg);
+  const bool isPosFirst = (cpos * cneg > 0 ? bz < 0.f : bz > 0.f) == (cpos * ptpos > cneg * ptneg);
+  const double sign = isPosFirst ? 1. : -1.;
+
+  // unit vector of pep X pem
+  const float cx = sign * (static_cast<double>(pypos) * pzneg - static_cast<double>(pzpos) * pyneg);
+  const float cy = sign * (static_cast<double>(pzpos) * pxneg - static_cast<double>(pxpos) * pzneg);
+  const float cz = sign * (static_cast<double>(pxpos) * pyneg - static_cast<double>(pypos) * pxneg);
+  const float invNormC = 1.f / std::sqrt(cx * cx + cy * cy + cz * cz);
+  const float vx = cx * invNormC, vy = cy * invNormC, vz = cz * invNormC;
+
+  // unit vector of (pep+pem)
+  const float px = pxpos + pxneg, py = pypos + pyneg, pz = pzpos + pzneg;
+  const float invNormU = 1.f / std::sqrt(px * px + py * py + pz * pz);
+  const float ux = px * invNormU, uy = py * invNormU, uz = pz * invNormU;
+  const float invNormA = 1.f / std::sqrt(ux * ux + uy * uy);
+  const float ax = uy * invNormA, ay = -ux * invNormA;
+
+  const float wx = uy * vz - uz * vy;
+  const float wy = uz * vx - ux * vz;
+  return fastAcos(wx * ax + wy * ay); // phiv in [0,pi]
+}
+//_______________________________________________________________________
+// Same as getOpeningAngle with fastAcos
+inline float getOpeningAngleFast(const float pxpos, const float pypos, const float pzpos, const float pxneg, const float pyneg, const float pzneg)
+{
+  const float ptot2 = (pxpos * pxpos + pypos * pypos + pzpos * pzpos) * (pxneg * pxneg + pyneg * pyneg + pzneg * pzneg);
+  return fastAcos((pxpos * pxneg + pypos * pyneg + pzpos * pzneg) / std::sqrt(ptot2));
+}
+//_______________________________________________________________________
+// phiv and opening angle of n pairs given as structures of arrays, the pair i being made of the legs 1[i] and 2[i]
+inline void getPhivPairs(const std::size_t n, const float* px1, const float* py1, const float* pz1, const float* px2, const float* py2, const float* pz2, const int8_t* c1, const int8_t* c2, const float bz, float* phiv)
+{
+  for (std::size_t i = 0; i < n; i++) {
+    phiv[i] = getPhivPairFast(px1[i], py1[i], pz1[i], px2[i], py2[i], pz2[i], c1[i], c2[i], bz);
+  }
+}
+inline void getOpeningAngles(const std::size_t n, const float* px1, const float* py1, const float* pz1, const float* px2, const float* py2, const float* pz2, float* opAng)
+{
+  for (std::size_t i = 0; i < n; i++) {
+    opAng[i] = getOpeningAngleFast(px1[i], py1[i], pz1[i], px2[i], py2[i], pz2[i]);
+  }
+}
+//_______________________________________________________________________
 inline float pairDCAQuadSum(const float dca1, const float dca2)
 {
   return std::sqrt((dca1 * dca1 + dca2 * dca2) / 2.);
@@ -373,5 +453,75 @@ inline float pairDCASignQuadSum(const float dca1, const float dca2, const int8_t
   return charge1 * charge2 * TMath::Sign(1., dca1) * TMath::Sign(1., dca2) * std::sqrt((dca1 * dca1 + dca2 * dca2) / 2.);
 }
 //_______________________________________________________________________
+// kinematics of the selected leptons of an event, as a structure of arrays for the pair loops
+struct LegBuffer {
+  std::vector<float> px, py, pz, e;
+
+  void clear()
+  {
+    px.clear();
+    py.clear();
+    pz.clear();
+    e.clear();
+  }
+  void add(const float px_, const float py_, const float pz_, const float mass)
+  {
+    px.emplace_back(px_);
+    py.emplace_back(py_);
+    pz.emplace_back(pz_);
+    e.emplace_back(std::sqrt(px_ * px_ + py_ * py_ + pz_ * pz_ + mass * mass));
+  }
+  std::size_t size() const { return px.size(); }
+};
+//_______________________________________________________________________
+template <typename TTracks>
+void fillLegBuffer(LegBuffer& legs, TTracks const& tracks, const float mass)
+{
+  legs.clear();
+  for (const auto& track : tracks) {
+    legs.add(track.px(), track.py(), track.pz(), mass);
+  }
+}
+//_______________________________________________________________________
+// Calls fnc(i1, i2) for the pairs of legs1 x legs2 (only i1 < i2 if sameLegs) whose mass and pT can be in [minMass, maxMass] and [minPt, maxPt].
+// The pair kinematics are computed in float over blocks of legs2 without branches, with a tolerance for the rounding,
+// so the exact pair selection still has to be applied in fnc, but a pair accepted by it is never skipped.
+template <typename TFnc>
+void forEachPairInKinematicRange(LegBuffer const& legs1, LegBuffer const& legs2, const bool sameLegs, const float minMass, const float maxMass, const float minPt, const float maxPt, TFnc&& fnc)
+{
+  constexpr std::size_t BlockSize = 64;
+  constexpr float Tolerance = 1e-5; // relative to (E1 + E2)^2
+  const float minM2 = minMass > 0.f ? minMass * minMass : -1.f;
+  const float maxM2 = maxMass * maxMass;
+  const float minPt2 = minPt > 0.f ? minPt * minPt : -1.f;
+  const float maxPt2 = maxPt * maxPt;
+
+  std::array<uint8_t, BlockSize> isInRange{};
+  const std::size_t n1 = legs1.size();
+  const std::size_t n2 = legs2.size();
+  for (std::size_t i1 = 0; i1 < n1; i1++) {
+    const float px1 = legs1.px[i1], py1 = legs1.py[i1], pz1 = legs1.pz[i1], e1 = legs1.e[i1];
+    for (std::size_t first = sameLegs ? i1 + 1 : 0; first < n2; first += BlockSize) {
+      const std::size_t nInBlock = std::min(BlockSize, n2 - first);
+      const float* px2 = legs2.px.data() + first;
+      const float* py2 = legs2.py.data() + first;
+      const float* pz2 = legs2.pz.data() + first;
+      const float* e2 = legs2.e.data() + first;
+      for (std::size_t k = 0; k < nInBlock; k++) {
+        float px = px1 + px2[k], py = py1 + py2[k], pz = pz1 + pz2[k], e = e1 + e2[k];
+        float pt2 = px * px + py * py;
+        float m2 = e * e - pt2 - pz * pz;
+        float tolerance = Tolerance * e * e;
+        isInRange[k] = (m2 >= minM2 - tolerance) & (m2 <= maxM2 + tolerance) & (pt2 >= minPt2 - tolerance) & (pt2 <= maxPt2 + tolerance);
+      }
+      for (std::size_t k = 0; k < nInBlock; k++) {
+        if (isInRange[k]) {
+          fnc(i1, first + k);
+        }
+      }
+    }
+  }
+}
+//_______________________________________________________________________
 } // namespace o2::aod::pwgem::dilepton::utils::pairutil
 #endif // PWGEM_DILEPTON_UTILS_PAIRUTILITIES_H_
@@ -254,8 +254,28 @@ struct Pi0EtaToGammaGamma {
   o2::aod::pwgem::dilepton::utils::EventMixingHandler<std::tuple<int, int, int, int>, std::pair<int, int>, o2::aod::pwgem::photonmeson::utils::EMPhoton>* emh2 = nullptr;
   //---------------------------------------------------------------------------
 
-  std::vector<int> used_photonIds_per_col;                   // <ndf, trackId>
-  std::vector<std::pair<int, int>> used_dileptonIds_per_col; // <ndf, trackId>
+  // photon which passed the single photon cuts in the collision being paired
+  struct SelectedPhoton {
+    int posTrackId; // V0 legs, only filled for the Dalitz pairing
+    int eleTrackId;
+    float pt;
+    float eta;
+    float phi;
+    float e;
+    float weight;  // omega MB weight, 1 if not available
+    bool isInPool; // already added to the mixing pool of this collision
+  };
+  // dielectron which passed the pair cuts in the collision being paired
+  struct SelectedDielectron {
+    int posTrackId;
+    int eleTrackId;
+    ROOT::Math::PtEtaPhiMVector vPos;
+    ROOT::Math::PtEtaPhiMVector vEle;
+    bool isInPool; // already added to the mixing pool of this collision
+  };
+  std::vector<SelectedPhoton> selected_photons1_per_col;
+  std::vector<SelectedPhoton> selected_photons2_per_col;
+  std::vector<SelectedDielectron> selected_dielectrons_per_col;
   std::map<std::pair<int, int>, uint64_t> map_mixed_eventId_to_globalBC;
 
   std::vector<float> zvtx_bin_edges;
@@ -461,10 +481,12 @@ struct Pi0EtaToGammaGamma {
     delete emh2;
     emh2 = 0x0;
 
-    used_photonIds_per_col.clear();
-    used_photonIds_per_col.shrink_to_fit();
-    used_dileptonIds_per_col.clear();
-    used_dileptonIds_per_col.shrink_to_fit();
+    selected_photons1_per_col.clear();
+    selected_photons1_per_col.shrink_to_fit();
+    selected_photons2_per_col.clear();
+    selected_photons2_per_col.shrink_to_fit();
+    selected_dielectrons_per_col.clear();
+    selected_dielectrons_per_col.shrink_to_fit();
     map_mixed_eventId_to_globalBC.clear();
   }
 
@@ -694,6 +716,47 @@ struct Pi0EtaToGammaGamma {
     return;
   }
 
+  /// \brief Applies the single photon cuts to the photons of one collision, in the table order
+  /// \tparam TDetectorTag tag of the photon type
+  /// \tparam applyCutWithoutMatching for EMCal, apply first the cut without the matched tracks (second photon of a PCM-EMC pair)
+  /// \tparam TLegs V0 leg table type, used to store the leg track ids of PCM photons for the Dalitz pairing
+  /// \param photons photons of the collision
+  /// \param selected output list of the selected photons
+  template <typename TDetectorTag, bool applyCutWithoutMatching, typename TLegs, typename TPhotons, typename TMatchedTracks, typename TMatchedSecondaries>
+  void selectPhotons(TPhotons const& photons, std::vector<SelectedPhoton>& selected, TMatchedTracks const& matchedTracks, TMatchedSecondaries const& matchedSecondaries)
+  {
+    selected.clear();
+    for (const auto& g : photons) {
+      if constexpr (std::is_same_v<TDetectorTag, EMCTag>) {
+        if constexpr (applyCutWithoutMatching) {
+          if (!TDetectorTag::applyCut(*this, g)) {
+            continue;
+          }
+        }
+        // For the EMCal case we need to get the primary and secondary matched tracks
+        auto matchedTracks_per_cluster = matchedTracks.sliceByCached(TDetectorTag::perClusterMT(), g.globalIndex(), cache);
+        auto matchedSecondaries_per_cluster = matchedSecondaries.sliceByCached(TDetectorTag::perClusterMS(), g.globalIndex(), cache);
+        if (!TDetectorTag::applyCut(*this, g, matchedTracks_per_cluster, matchedSecondaries_per_cluster)) {
+          continue;
+        }
+      } else {
+        if (!TDetectorTag::applyCut(*this, g)) {
+          continue;
+        }
+      }
+
+      SelectedPhoton photon{-1, -1, g.pt(), g.eta(), g.phi(), g.e(), 1.f, false};
+      if constexpr (pairtype == o2::aod::pwgem::photonmeson::photonpair::PairType::kPCMDalitzEE && std::is_same_v<TDetectorTag, PCMTag>) {
+        photon.posTrackId = g.template posTrack_as<TLegs>().trackId();
+        photon.eleTrackId = g.template negTrack_as<TLegs>().trackId();
+      }
+      if constexpr (requires { g.omegaMBWeight(); }) {
+        photon.weight = g.omegaMBWeight();
+      }
+      selected.emplace_back(photon);
+    }
+  }
+
   /// \brief function to run the photon pairing
   /// \tparam TDetectorTag1 tag for TPhotons1 type to select the proper cut function and arguments
   /// \tparam TDetectorTag2 tag for TPhotons2 type to select the proper cut function and arguments
@@ -792,64 +855,54 @@ struct Pi0EtaToGammaGamma {
         auto positrons_per_collision = positrons->sliceByCached(o2::aod::emprimaryelectronda::pmeventId, collision.globalIndex(), cache);
         auto electrons_per_collision = electrons->sliceByCached(o2::aod::emprimaryelectronda::pmeventId, collision.globalIndex(), cache);
 
-        for (const auto& g1 : photons1_per_collision) {
-          if constexpr (std::is_same_v<TDetectorTag1, PCMTag>) {
-            if (!TDetectorTag1::applyCut(*this, g1)) {
+        selectPhotons<TDetectorTag1, false, TLegs>(photons1_per_collision, selected_photons1_per_col, matchedTracks, matchedSecondaries);
+        if (selected_photons1_per_col.empty()) {
+          continue;
+        }
+
+        // the dielectron cuts do not depend on the photon, so they are applied once per collision
+        selected_dielectrons_per_col.clear();
+        for (const auto& [pos2, ele2] : o2::soa::combinations(TCombinationPolicy(positrons_per_collision, electrons_per_collision))) {
+          if (pos2.trackId() == ele2.trackId()) { // this is protection against pairing identical 2 tracks.
+            continue;
+          }
+          if constexpr (std::is_same_v<TDetectorTag2, DalitzEETag>) {
+            if (!TDetectorTag2::applyCut(*this, pos2, ele2, d_bz)) {
               continue;
             }
           } else {
-            if (!TDetectorTag2::applyCut(*this, g1)) {
+            if (!TDetectorTag1::applyCut(*this, pos2, ele2, d_bz)) {
               continue;
             }
           }
-          auto pos1 = g1.template posTrack_as<TLegs>();
-          auto ele1 = g1.template negTrack_as<TLegs>();
-          ROOT::Math::PtEtaPhiMVector v_gamma(g1.pt(), g1.eta(), g1.phi(), 0.);
+          ROOT::Math::PtEtaPhiMVector v_pos(pos2.pt(), pos2.eta(), pos2.phi(), o2::constants::physics::MassElectron);
+          ROOT::Math::PtEtaPhiMVector v_ele(ele2.pt(), ele2.eta(), ele2.phi(), o2::constants::physics::MassElectron);
+          selected_dielectrons_per_col.emplace_back(SelectedDielectron{static_cast<int>(pos2.trackId()), static_cast<int>(ele2.trackId()), v_pos, v_ele, false});
+        }
 
-          for (const auto& [pos2, ele2] : o2::soa::combinations(TCombinationPolicy(positrons_per_collision, electrons_per_collision))) {
+        for (auto& g1 : selected_photons1_per_col) {
+          ROOT::Math::PtEtaPhiMVector v_gamma(g1.pt, g1.eta, g1.phi, 0.);
 
-            if (pos2.trackId() == ele2.trackId()) { // this is protection against pairing identical 2 tracks.
-              continue;
-            }
-            if (pos1.trackId() == pos2.trackId() || ele1.trackId() == ele2.trackId()) {
+          for (auto& ee : selected_dielectrons_per_col) {
+            if (g1.posTrackId == ee.posTrackId || g1.eleTrackId == ee.eleTrackId) {
               continue;
             }
 
-            if constexpr (std::is_same_v<TDetectorTag2, DalitzEETag>) {
-              if (!TDetectorTag2::applyCut(*this, pos2, ele2, d_bz)) {
-                continue;
-              }
-            } else {
-              if (!TDetectorTag1::applyCut(*this, pos2, ele2, d_bz)) {
-                continue;
-              }
-            }
-            // if (!cut2.template IsSelectedTrack<false>(pos2, collision) || !cut2.template IsSelectedTrack<false>(ele2, collision)) {
-            //   continue;
-            // }
-
-            // if (!cut2.IsSelectedPair(pos2, ele2, d_bz)) {
-            //   continue;
-            // }
-
-            ROOT::Math::PtEtaPhiMVector v_pos(pos2.pt(), pos2.eta(), pos2.phi(), o2::constants::physics::MassElectron);
-            ROOT::Math::PtEtaPhiMVector v_ele(ele2.pt(), ele2.eta(), ele2.phi(), o2::constants::physics::MassElectron);
-            ROOT::Math::PtEtaPhiMVector v_ee = v_pos + v_ele;
-            ROOT::Math::PtEtaPhiMVector veeg = v_gamma + v_pos + v_ele;
+            ROOT::Math::PtEtaPhiMVector v_ee = ee.vPos + ee.vEle;
+            ROOT::Math::PtEtaPhiMVector veeg = v_gamma + ee.vPos + ee.vEle;
             if (std::fabs(veeg.Rapidity()) > maxY) {
               continue;
             }
 
             fRegistry.fill(HIST("Pair/same/hs"), veeg.M(), veeg.Pt(), weight);
 
-            std::pair<int, int> tuple_tmp_id2 = std::make_pair(pos2.trackId(), ele2.trackId());
-            if (std::find(used_photonIds_per_col.begin(), used_photonIds_per_col.end(), g1.globalIndex()) == used_photonIds_per_col.end()) {
-              emh1->AddTrackToEventPool(key_df_collision, o2::aod::pwgem::photonmeson::utils::EMPhoton(g1.pt(), g1.eta(), g1.phi(), 0));
-              used_photonIds_per_col.emplace_back(g1.globalIndex());
+            if (!g1.isInPool) {
+              emh1->AddTrackToEventPool(key_df_collision, o2::aod::pwgem::photonmeson::utils::EMPhoton(g1.pt, g1.eta, g1.phi, 0));
+              g1.isInPool = true;
             }
-            if (std::find(used_dileptonIds_per_col.begin(), used_dileptonIds_per_col.end(), tuple_tmp_id2) == used_dileptonIds_per_col.end()) {
+            if (!ee.isInPool) {
               emh2->AddTrackToEventPool(key_df_collision, o2::aod::pwgem::photonmeson::utils::EMPhoton(v_ee.Pt(), v_ee.Eta(), v_ee.Phi(), v_ee.M()));
-              used_dileptonIds_per_col.emplace_back(tuple_tmp_id2);
+              ee.isInPool = true;
             }
             ndiphoton++;
           } // end of dielectron loop
@@ -858,87 +911,62 @@ struct Pi0EtaToGammaGamma {
         auto photons1_per_collision = photons1.sliceByCached(TDetectorTag1::perCollision(), collision.globalIndex(), cache);
         auto photons2_per_collision = photons2.sliceByCached(TDetectorTag2::perCollision(), collision.globalIndex(), cache);
 
-        for (const auto& [g1, g2] : o2::soa::combinations(TCombinationPolicy(photons1_per_collision, photons2_per_collision))) {
-          if constexpr (std::is_same_v<TDetectorTag1, EMCTag>) {
-            // For the EMCal case we need to get the primary and secondary matched tracks
-            auto matchedTracks1 = matchedTracks.sliceByCached(TDetectorTag1::perClusterMT(), g1.globalIndex(), cache);
-            auto matchedSecondaries1 = matchedSecondaries.sliceByCached(TDetectorTag1::perClusterMS(), g1.globalIndex(), cache);
-
-            if (!TDetectorTag1::applyCut(*this, g1, matchedTracks1, matchedSecondaries1)) {
+        // same kinds pairing runs over the pairs i < j of a single list, as CombinationsStrictlyUpperIndexPolicy does
+        constexpr bool isSameKind = std::is_same_v<TCombinationPolicy<TPhotons1, TPhotons2>, o2::soa::CombinationsStrictlyUpperIndexPolicy<TPhotons1, TPhotons2>>;
+        selectPhotons<TDetectorTag1, false, TLegs>(photons1_per_collision, selected_photons1_per_col, matchedTracks, matchedSecondaries);
+        if constexpr (!isSameKind) {
+          // without EMCal as first photon, the second one is also checked without its matched tracks
+          selectPhotons<TDetectorTag2, !std::is_same_v<TDetectorTag1, EMCTag>, TLegs>(photons2_per_collision, selected_photons2_per_col, matchedTracks, matchedSecondaries);
+        }
+        auto& selected_photons2 = isSameKind ? selected_photons1_per_col : selected_photons2_per_col;
+
+        for (size_t i1 = 0; i1 < selected_photons1_per_col.size(); i1++) {
+          for (size_t i2 = isSameKind ? i1 + 1 : 0; i2 < selected_photons2.size(); i2++) {
+            auto& g1 = selected_photons1_per_col[i1];
+            auto& g2 = selected_photons2[i2];
+
+            ROOT::Math::PtEtaPhiMVector v1(g1.pt, g1.eta, g1.phi, 0.);
+            ROOT::Math::PtEtaPhiMVector v2(g2.pt, g2.eta, g2.phi, 0.);
+            ROOT::Math::PtEtaPhiMVector v12 = v1 + v2;
+            if (std::fabs(v12.Rapidity()) > maxY) {
               continue;
             }
-          } else {
-            if (!TDetectorTag1::applyCut(*this, g1) || !TDetectorTag2::applyCut(*this, g2)) {
-              continue;
-            }
-          }
 
-          if constexpr (std::is_same_v<TDetectorTag2, EMCTag>) {
-            auto matchedTracks2 = matchedTracks.sliceByCached(TDetectorTag2::perClusterMT(), g2.globalIndex(), cache);
-            auto matchedSecondaries2 = matchedSecondaries.sliceByCached(TDetectorTag2::perClusterMS(), g2.globalIndex(), cache);
-            if (!TDetectorTag2::applyCut(*this, g2, matchedTracks2, matchedSecondaries2)) {
-              continue;
+            float alphaMeson = std::fabs(g1.e - g2.e) / (g1.e + g2.e);
+            float alphaCut = 999.f;
+            switch (static_cast<AlphaMesonCutOption>(cfgAlphaMesonCut.value)) {
+              case AlphaMesonCutOption::Off:
+                break;
+              case AlphaMesonCutOption::SpecificValue:
+                alphaCut = cfgAlphaMeson;
+                break;
+              case AlphaMesonCutOption::PTDependent: {
+                alphaCut = cfgAlphaMesonA * std::tanh(cfgAlphaMesonB * v12.pt());
+                break;
+              }
+              default:
+                LOGF(error, "Invalid option for alpha meson cut. No alpha cut will be applied.");
             }
-          } else {
-            if (!TDetectorTag2::applyCut(*this, g2)) {
+            if (alphaMeson > alphaCut) {
               continue;
             }
-          }
 
-          ROOT::Math::PtEtaPhiMVector v1(g1.pt(), g1.eta(), g1.phi(), 0.);
-          ROOT::Math::PtEtaPhiMVector v2(g2.pt(), g2.eta(), g2.phi(), 0.);
-          ROOT::Math::PtEtaPhiMVector v12 = v1 + v2;
-          if (std::fabs(v12.Rapidity()) > maxY) {
-            continue;
-          }
+            float wpair = weight * g1.weight * g2.weight;
+            fRegistry.fill(HIST("Pair/same/hs"), v12.M(), v12.Pt(), wpair);
 
-          float alphaMeson = std::fabs(g1.e() - g2.e()) / (g1.e() + g2.e());
-          float alphaCut = 999.f;
-          switch (static_cast<AlphaMesonCutOption>(cfgAlphaMesonCut.value)) {
-            case AlphaMesonCutOption::Off:
-              break;
-            case AlphaMesonCutOption::SpecificValue:
-              alphaCut = cfgAlphaMeson;
-              break;
-            case AlphaMesonCutOption::PTDependent: {
-              alphaCut = cfgAlphaMesonA * std::tanh(cfgAlphaMesonB * v12.pt());
-              break;
+            if (!g1.isInPool) {
+              emh1->AddTrackToEventPool(key_df_collision, o2::aod::pwgem::photonmeson::utils::EMPhoton(g1.pt, g1.eta, g1.phi, 0));
+              g1.isInPool = true;
             }
-            default:
-              LOGF(error, "Invalid option for alpha meson cut. No alpha cut will be applied.");
-          }
-          if (alphaMeson > alphaCut) {
-            continue;
-          }
-
-          float wpair = weight;
-
-          if constexpr (requires { g1.omegaMBWeight(); }) {
-            wpair *= g1.omegaMBWeight();
-          }
-          if constexpr (requires { g2.omegaMBWeight(); }) {
-            wpair *= g2.omegaMBWeight();
-          }
-
-          fRegistry.fill(HIST("Pair/same/hs"), v12.M(), v12.Pt(), wpair);
-
-          if (std::find(used_photonIds_per_col.begin(), used_photonIds_per_col.end(), g1.globalIndex()) == used_photonIds_per_col.end()) {
-            emh1->AddTrackToEventPool(key_df_collision, o2::aod::pwgem::photonmeson::utils::EMPhoton(g1.pt(), g1.eta(), g1.phi(), 0));
-            used_photonIds_per_col.emplace_back(g1.globalIndex());
-          }
-          if (std::find(used_photonIds_per_col.begin(), used_photonIds_per_col.end(), g2.globalIndex()) == used_photonIds_per_col.end()) {
-            emh2->AddTrackToEventPool(key_df_collision, o2::aod::pwgem::photonmeson::utils::EMPhoton(g2.pt(), g2.eta(), g2.phi(), 0));
-            used_photonIds_per_col.emplace_back(g2.globalIndex());
+            if (!g2.isInPool) {
+              emh2->AddTrackToEventPool(key_df_collision, o2::aod::pwgem::photonmeson::utils::EMPhoton(g2.pt, g2.eta, g2.phi, 0));
+              g2.isInPool = true;
+            }
+            ndiphoton++;
           }
-          ndiphoton++;
         } // end of pairing loop
       } // end of pairing in same event
 
-      used_photonIds_per_col.clear();
-      used_photonIds_per_col.shrink_to_fit();
-      used_dileptonIds_per_col.clear();
-      used_dileptonIds_per_col.shrink_to_fit();
-
       // event mixing
       if (!cfgDoMix || !(ndiphoton > 0)) {
         continue;
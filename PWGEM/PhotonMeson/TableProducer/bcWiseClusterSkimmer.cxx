@@ -205,12 +205,13 @@ struct bcWiseClusterSkimmer {
       }
       bool isEta = false;
       if (mesonMCIndex >= 0) {
-        if (mcParticles.iteratorAt(mesonMCIndex).pdgCode() == PDG_t::kPi0) {
+        const int mesonPdgCode = mcParticles.iteratorAt(mesonMCIndex).pdgCode();
+        if (mesonPdgCode == PDG_t::kPi0) {
           if (fMapPi0Index.find(mesonMCIndex) != fMapPi0Index.end()) // Some pi0s might not be found (not gg decay or too large y)
             mesonMCIndex = fMapPi0Index[mesonMCIndex];               // If pi0 was stored in table, change index from the MC index to the pi0 index from this task
           else                                                       // If pi0 was not stored, treat photon as if not from pi0
             mesonMCIndex = -1;
-        } else if (mcParticles.iteratorAt(mesonMCIndex).pdgCode() == Pdg::kEta) {
+        } else if (mesonPdgCode == Pdg::kEta) {
           isEta = true;
           if (fMapEtaIndex.find(mesonMCIndex) != fMapEtaIndex.end()) // Some etas might not be found (not gg decay or too large y)
             mesonMCIndex = fMapEtaIndex[mesonMCIndex];               // If eta was stored in table, change index from the MC index to the eta index from this task
@@ -180,7 +180,6 @@ struct PhotonConversionBuilder {
   Configurable<float> propV0LegsRadius{"propV0LegsRadius", 60.f, "Radius to which the V0 legs are propagated to calculate psipair and phiV"};
 
   o2::analysis::EmMlResponsePCM<float> emMlResponse;
-  std::vector<float> outputML;
   V0PhotonCandidate v0photoncandidate;
   o2::ccdb::CcdbApi ccdbApi;
 
@@ -504,8 +503,24 @@ struct PhotonConversionBuilder {
     }
   }
 
+  // photon candidate accepted in the first pass, kept until the tables are filled for the selected ones
+  struct V0PhotonRecord {
+    V0PhotonCandidate candidate;
+    KFParticle gammaKF_DecayVtx;
+    KFParticle gammaKF_PV;
+    KFParticle kfp_pos_DecayVtx;
+    KFParticle kfp_ele_DecayVtx;
+    o2::track::TrackParCov pTrack;
+    o2::track::TrackParCov nTrack;
+    float posdcaXY, posdcaZ, eledcaXY, eledcaZ;
+    float rxy, v0eta, v0phi;
+    float cospa_kf, cospaXYKF, cospaRZKF;
+    std::vector<float> outputML;
+    bool isSelectedML;
+  };
+
   template <bool isMC, class TBCs, class TCollisions, class TTracks, typename TV0>
-  void fillV0Table(TV0 const& v0, const bool filltable)
+  void buildV0Candidate(TV0 const& v0)
   {
     // Get tracks
     const auto& pos = v0.template posTrack_as<TTracks>();
@@ -583,37 +598,6 @@ struct PhotonConversionBuilder {
       return; // RZ line cut
     }
 
-    float phiv = 999.f;
-    float psipair = 999.f;
-    float baseR = std::hypot(xyz[0], xyz[1]);
-    float offsetsR[3] = {propV0LegsRadius, 30.f, 10.f};
-    bool pPropagatedSuccess = false;
-    bool nPropagatedSuccess = false;
-    auto pTrackProp = pTrack;
-    auto nTrackProp = nTrack;
-    for (float offsetR : offsetsR) {
-      pTrackProp = pTrack;
-      pTrackProp.setPID(o2::track::PID::Electron);
-      nTrackProp = nTrack;
-      nTrackProp.setPID(o2::track::PID::Electron);
-      o2::base::Propagator::Instance()->propagateToDCABxByBz({collision.posX(), collision.posY(), collision.posZ()}, pTrackProp, 2.f, matCorr, &dcaInfo);
-      o2::base::Propagator::Instance()->propagateToDCABxByBz({collision.posX(), collision.posY(), collision.posZ()}, nTrackProp, 2.f, matCorr, &dcaInfo);
-      pPropagatedSuccess = o2::base::Propagator::Instance()->propagateToR(pTrackProp, baseR + offsetR);
-      nPropagatedSuccess = o2::base::Propagator::Instance()->propagateToR(nTrackProp, baseR + offsetR);
-      if (pPropagatedSuccess && nPropagatedSuccess) {
-        KFPTrack kfp_track_posProp = createKFPTrackFromTrackParCov(pTrackProp, pos.sign(), pos.tpcNClsFound(), pos.tpcChi2NCl());
-        KFPTrack kfp_track_eleProp = createKFPTrackFromTrackParCov(nTrackProp, ele.sign(), ele.tpcNClsFound(), ele.tpcChi2NCl());
-        phiv = o2::aod::pwgem::dilepton::utils::pairutil::getPhivPair(kfp_track_posProp.GetPx(), kfp_track_posProp.GetPy(), kfp_track_posProp.GetPz(), kfp_track_eleProp.GetPx(), kfp_track_eleProp.GetPy(), kfp_track_eleProp.GetPz(), pos.sign(), ele.sign(), d_bz);
-        psipair = o2::aod::pwgem::dilepton::utils::pairutil::getPsiPair(kfp_track_posProp.GetPx(), kfp_track_posProp.GetPy(), kfp_track_posProp.GetPz(), kfp_track_eleProp.GetPx(), kfp_track_eleProp.GetPy(), kfp_track_eleProp.GetPz());
-        break;
-      } else {
-        LOG(debug) << "Propagation to offset" << offsetR << " cm failed for " << (pPropagatedSuccess ? "negative" : "positive") << " track. Trying smaller offset.";
-      }
-    }
-    if (phiv == 999.f || psipair == 999.f) {
-      LOG(debug) << "Propagation failed for all radii (" << propV0LegsRadius << ", 30, 10 cm). Using default values for phiv and psipair (999.f).";
-    }
-
     KFPTrack kfp_track_pos = createKFPTrackFromTrackParCov(pTrack, pos.sign(), pos.tpcNClsFound(), pos.tpcChi2NCl());
     KFPTrack kfp_track_ele = createKFPTrackFromTrackParCov(nTrack, ele.sign(), ele.tpcNClsFound(), ele.tpcChi2NCl());
     KFParticle kfp_pos(kfp_track_pos, kPositron);
@@ -655,20 +639,18 @@ struct PhotonConversionBuilder {
       return;
     }
 
-    if (!filltable) {
-      if (isITSTPCTrack(pos) && isITSTPCTrack(ele)) {
-        registry.fill(HIST("V0/hRxy_minX_ITSTPC_ITSTPC"), std::min(pTrack.getX(), nTrack.getX()), std::min(pTrack.getX(), nTrack.getX()) - rxy); // trackiu.x() - rxy should be positive
-      } else if (isITSonlyTrack(pos) && isITSonlyTrack(ele)) {
-        registry.fill(HIST("V0/hRxy_minX_ITSonly_ITSonly"), std::min(pTrack.getX(), nTrack.getX()), std::min(pTrack.getX(), nTrack.getX()) - rxy); // trackiu.x() - rxy should be positive
-      } else if ((isITSTPCTrack(pos) && isITSonlyTrack(ele)) || (isITSTPCTrack(ele) && isITSonlyTrack(pos))) {
-        registry.fill(HIST("V0/hRxy_minX_ITSTPC_ITSonly"), std::min(pTrack.getX(), nTrack.getX()), std::min(pTrack.getX(), nTrack.getX()) - rxy); // trackiu.x() - rxy should be positive
-      } else if (isITSTPCTrack(pos) && !ele.hasITS()) {
-        registry.fill(HIST("V0/hRxy_minX_ITSTPC_TPC"), std::min(pTrack.getX(), 83.f), std::min(pTrack.getX(), 83.f) - rxy); // trackiu.x() - rxy should be positive
-      } else if (isITSTPCTrack(ele) && !pos.hasITS()) {
-        registry.fill(HIST("V0/hRxy_minX_ITSTPC_TPC"), std::min(nTrack.getX(), 83.f), std::min(nTrack.getX(), 83.f) - rxy); // trackiu.x() - rxy should be positive
-      } else {
-        registry.fill(HIST("V0/hRxy_minX_TPC_TPC"), std::min(83.f, 83.f), std::min(83.f, 83.f) - rxy); // trackiu.x() - rxy should be positive
-      }
+    if (isITSTPCTrack(pos) && isITSTPCTrack(ele)) {
+      registry.fill(HIST("V0/hRxy_minX_ITSTPC_ITSTPC"), std::min(pTrack.getX(), nTrack.getX()), std::min(pTrack.getX(), nTrack.getX()) - rxy); // trackiu.x() - rxy should be positive
+    } else if (isITSonlyTrack(pos) && isITSonlyTrack(ele)) {
+      registry.fill(HIST("V0/hRxy_minX_ITSonly_ITSonly"), std::min(pTrack.getX(), nTrack.getX()), std::min(pTrack.getX(), nTrack.getX()) - rxy); // trackiu.x() - rxy should be positive
+    } else if ((isITSTPCTrack(pos) && isITSonlyTrack(ele)) || (isITSTPCTrack(ele) && isITSonlyTrack(pos))) {
+      registry.fill(HIST("V0/hRxy_minX_ITSTPC_ITSonly"), std::min(pTrack.getX(), nTrack.getX()), std::min(pTrack.getX(), nTrack.getX()) - rxy); // trackiu.x() - rxy should be positive
+    } else if (isITSTPCTrack(pos) && !ele.hasITS()) {
+      registry.fill(HIST("V0/hRxy_minX_ITSTPC_TPC"), std::min(pTrack.getX(), 83.f), std::min(pTrack.getX(), 83.f) - rxy); // trackiu.x() - rxy should be positive
+    } else if (isITSTPCTrack(ele) && !pos.hasITS()) {
+      registry.fill(HIST("V0/hRxy_minX_ITSTPC_TPC"), std::min(nTrack.getX(), 83.f), std::min(nTrack.getX(), 83.f) - rxy); // trackiu.x() - rxy should be positive
+    } else {
+      registry.fill(HIST("V0/hRxy_minX_TPC_TPC"), std::min(83.f, 83.f), std::min(83.f, 83.f) - rxy); // trackiu.x() - rxy should be positive
     }
 
     if (pos.hasITS() && ele.hasITS()) { // ITSonly-ITSonly, ITSTPC-ITSTPC, ITSTPC-ITSonly
@@ -719,6 +701,33 @@ struct PhotonConversionBuilder {
       return;
     }
 
+    float phiv = 999.f;
+    float psipair = 999.f;
+    float baseR = std::hypot(xyz[0], xyz[1]);
+    float offsetsR[3] = {propV0LegsRadius, 30.f, 10.f};
+    bool pPropagatedSuccess = false;
+    bool nPropagatedSuccess = false;
+    auto pTrackProp = pTrackC;
+    auto nTrackProp = nTrackC;
+    for (float offsetR : offsetsR) {
+      pTrackProp = pTrackC; // already at the DCA to the PV
+      nTrackProp = nTrackC;
+      pPropagatedSuccess = o2::base::Propagator::Instance()->propagateToR(pTrackProp, baseR + offsetR);
+      nPropagatedSuccess = o2::base::Propagator::Instance()->propagateToR(nTrackProp, baseR + offsetR);
+      if (pPropagatedSuccess && nPropagatedSuccess) {
+        KFPTrack kfp_track_posProp = createKFPTrackFromTrackParCov(pTrackProp, pos.sign(), pos.tpcNClsFound(), pos.tpcChi2NCl());
+        KFPTrack kfp_track_eleProp = createKFPTrackFromTrackParCov(nTrackProp, ele.sign(), ele.tpcNClsFound(), ele.tpcChi2NCl());
+        phiv = o2::aod::pwgem::dilepton::utils::pairutil::getPhivPair(kfp_track_posProp.GetPx(), kfp_track_posProp.GetPy(), kfp_track_posProp.GetPz(), kfp_track_eleProp.GetPx(), kfp_track_eleProp.GetPy(), kfp_track_eleProp.GetPz(), pos.sign(), ele.sign(), d_bz);
+        psipair = o2::aod::pwgem::dilepton::utils::pairutil::getPsiPair(kfp_track_posProp.GetPx(), kfp_track_posProp.GetPy(), kfp_track_posProp.GetPz(), kfp_track_eleProp.GetPx(), kfp_track_eleProp.GetPy(), kfp_track_eleProp.GetPz());
+        break;
+      } else {
+        LOG(debug) << "Propagation to offset" << offsetR << " cm failed for " << (pPropagatedSuccess ? "negative" : "positive") << " track. Trying smaller offset.";
+      }
+    }
+    if (phiv == 999.f || psipair == 999.f) {
+      LOG(debug) << "Propagation failed for all radii (" << propV0LegsRadius << ", 30, 10 cm). Using default values for phiv and psipair (999.f).";
+    }
+
     KFParticle kfp_pos_DecayVtx = kfp_pos;  // Don't set Primary Vertex
     KFParticle kfp_ele_DecayVtx = kfp_ele;  // Don't set Primary Vertex
     kfp_pos_DecayVtx.TransportToPoint(xyz); // Don't set Primary Vertex
@@ -770,113 +779,130 @@ struct PhotonConversionBuilder {
     if (!checkAP(v0photoncandidate.getAlpha(), v0photoncandidate.getQt(), max_alpha_ap, max_qt_ap)) { // store only photon conversions
       return;
     }
-    pca_map[std::make_tuple(v0.globalIndex(), collision.globalIndex(), pos.globalIndex(), ele.globalIndex())] = v0photoncandidate.getPCA();
-    cospa_map[std::make_tuple(v0.globalIndex(), collision.globalIndex(), pos.globalIndex(), ele.globalIndex())] = v0photoncandidate.getCosPA();
-
+    V0PhotonRecord record{v0photoncandidate, gammaKF_DecayVtx, gammaKF_PV, kfp_pos_DecayVtx, kfp_ele_DecayVtx, pTrack, nTrack,
+                          posdcaXY, posdcaZ, eledcaXY, eledcaZ, rxy, v0eta, v0phi, cospa_kf, cospaXYKF, cospaRZKF, {}, true};
     if (applyPCMMl) {
-      bool isSelectedML = false;
       std::vector<float> mlInputFeatures = emMlResponse.getInputFeatures(v0photoncandidate, pos, ele);
       if (use2DBinning) {
-        isSelectedML = emMlResponse.isSelectedMl(mlInputFeatures, v0photoncandidate.getPt(), v0photoncandidate.getCent(), outputML);
+        record.isSelectedML = emMlResponse.isSelectedMl(mlInputFeatures, v0photoncandidate.getPt(), v0photoncandidate.getCent(), record.outputML);
       } else {
-        isSelectedML = emMlResponse.isSelectedMl(mlInputFeatures, v0photoncandidate.getPt(), outputML);
+        record.isSelectedML = emMlResponse.isSelectedMl(mlInputFeatures, v0photoncandidate.getPt(), record.outputML);
       }
-      if (filltable) {
-        if (nClassesPCMMl == 2) {
-          registry.fill(HIST("V0/hBDTBackgroundScoreBeforeCutVsPt"), v0photoncandidate.getPt(), outputML[0]);
-          registry.fill(HIST("V0/hBDTSignalScoreBeforeCutVsPt"), v0photoncandidate.getPt(), outputML[1]);
-        } else if (nClassesPCMMl == 3) {
-          registry.fill(HIST("V0/hBDTPrimaryPhotonScoreBeforeCutVsPt"), v0photoncandidate.getPt(), outputML[0]);
-          registry.fill(HIST("V0/hBDTSecondaryPhotonScoreBeforeCutVsPt"), v0photoncandidate.getPt(), outputML[1]);
-          registry.fill(HIST("V0/hBDTBackgroundScoreBeforeCutVsPt"), v0photoncandidate.getPt(), outputML[2]);
-        } else {
-          registry.fill(HIST("V0/hBDTScoreBeforeCutVsPt"), v0photoncandidate.getPt(), outputML[0]);
-        }
+    }
+    v0photon_records.emplace(std::make_tuple(v0.globalIndex(), collision.globalIndex(), pos.globalIndex(), ele.globalIndex()), std::move(record));
+  }
+
+  template <bool isMC, class TTracks, typename TV0>
+  void fillV0Table(TV0 const& v0, const int64_t collisionId, V0PhotonRecord const& record)
+  {
+    const auto& pos = v0.template posTrack_as<TTracks>();
+    const auto& ele = v0.template negTrack_as<TTracks>();
+    const auto& candidate = record.candidate;
+    const auto& outputML = record.outputML;
+    const auto& gammaKF_DecayVtx = record.gammaKF_DecayVtx;
+    const auto& gammaKF_PV = record.gammaKF_PV;
+    const auto& kfp_pos_DecayVtx = record.kfp_pos_DecayVtx;
+    const auto& kfp_ele_DecayVtx = record.kfp_ele_DecayVtx;
+    const auto& pTrack = record.pTrack;
+    const auto& nTrack = record.nTrack;
+
+    if (applyPCMMl) {
+      if (nClassesPCMMl == 2) {
+        registry.fill(HIST("V0/hBDTBackgroundScoreBeforeCutVsPt"), candidate.getPt(), outputML[0]);
+        registry.fill(HIST("V0/hBDTSignalScoreBeforeCutVsPt"), candidate.getPt(), outputML[1]);
+      } else if (nClassesPCMMl == 3) {
+        registry.fill(HIST("V0/hBDTPrimaryPhotonScoreBeforeCutVsPt"), candidate.getPt(), outputML[0]);
+        registry.fill(HIST("V0/hBDTSecondaryPhotonScoreBeforeCutVsPt"), candidate.getPt(), outputML[1]);
+        registry.fill(HIST("V0/hBDTBackgroundScoreBeforeCutVsPt"), candidate.getPt(), outputML[2]);
+      } else {
+        registry.fill(HIST("V0/hBDTScoreBeforeCutVsPt"), candidate.getPt(), outputML[0]);
       }
-      if (!isSelectedML) {
+      if (!record.isSelectedML) {
         return;
       }
-      if (filltable) {
-        if (nClassesPCMMl == 2) {
-          registry.fill(HIST("V0/hBDTBackgroundScoreAfterCutVsPt"), v0photoncandidate.getPt(), outputML[0]);
-          registry.fill(HIST("V0/hBDTSignalScoreAfterCutVsPt"), v0photoncandidate.getPt(), outputML[1]);
-        } else if (nClassesPCMMl == 3) {
-          registry.fill(HIST("V0/hBDTPrimaryPhotonScoreAfterCutVsPt"), v0photoncandidate.getPt(), outputML[0]);
-          registry.fill(HIST("V0/hBDTSecondaryPhotonScoreAfterCutVsPt"), v0photoncandidate.getPt(), outputML[1]);
-          registry.fill(HIST("V0/hBDTBackgroundScoreAfterCutVsPt"), v0photoncandidate.getPt(), outputML[2]);
-        } else {
-          registry.fill(HIST("V0/hBDTScoreAfterCutVsPt"), v0photoncandidate.getPt(), outputML[0]);
-        }
+      if (nClassesPCMMl == 2) {
+        registry.fill(HIST("V0/hBDTBackgroundScoreAfterCutVsPt"), candidate.getPt(), outputML[0]);
+        registry.fill(HIST("V0/hBDTSignalScoreAfterCutVsPt"), candidate.getPt(), outputML[1]);
+      } else if (nClassesPCMMl == 3) {
+        registry.fill(HIST("V0/hBDTPrimaryPhotonScoreAfterCutVsPt"), candidate.getPt(), outputML[0]);
+        registry.fill(HIST("V0/hBDTSecondaryPhotonScoreAfterCutVsPt"), candidate.getPt(), outputML[1]);
+        registry.fill(HIST("V0/hBDTBackgroundScoreAfterCutVsPt"), candidate.getPt(), outputML[2]);
+      } else {
+        registry.fill(HIST("V0/hBDTScoreAfterCutVsPt"), candidate.getPt(), outputML[0]);
       }
     }
 
-    if (filltable) {
-      registry.fill(HIST("V0/hAP"), v0photoncandidate.getAlpha(), v0photoncandidate.getQt());
-      registry.fill(HIST("V0/hConversionPointXY"), gammaKF_DecayVtx.GetX(), gammaKF_DecayVtx.GetY());
-      registry.fill(HIST("V0/hConversionPointRZ"), gammaKF_DecayVtx.GetZ(), rxy);
-      registry.fill(HIST("V0/hPt"), v0photoncandidate.getPt());
-      registry.fill(HIST("V0/hEtaPhi"), v0phi, v0eta);
-      registry.fill(HIST("V0/hCosPA"), v0photoncandidate.getCosPA());
-      registry.fill(HIST("V0/hCosPA_Rxy"), rxy, v0photoncandidate.getCosPA());
-      registry.fill(HIST("V0/hPCA"), v0photoncandidate.getPCA());
-      registry.fill(HIST("V0/hPCA_CosPA"), v0photoncandidate.getCosPA(), v0photoncandidate.getPCA());
-      registry.fill(HIST("V0/hPCA_Rxy"), rxy, v0photoncandidate.getPCA());
-      registry.fill(HIST("V0/hDCAxyz"), v0photoncandidate.getDcaXYToPV(), v0photoncandidate.getDcaZToPV());
-      registry.fill(HIST("V0/hPCA_diffX"), v0photoncandidate.getPCA(), std::min(pTrack.getX(), nTrack.getX()) - rxy); // trackiu.x() - rxy should be positive
-      registry.fill(HIST("V0/hPhiVPsiPair"), v0photoncandidate.getPsiPair(), v0photoncandidate.getPhiV());
-
-      // LOGF(info, "cospa_kf = %f, cospaXY_kf = %f, cospaRZ_kf = %f", cospa_kf, cospaXY_kf, cospaRZ_kf);
-      registry.fill(HIST("V0/hCosPAXY_Rxy"), rxy, cospaXYKF);
-      registry.fill(HIST("V0/hCosPARZ_Rxy"), rxy, cospaRZKF);
-
-      for (const auto& leg : {kfp_pos_DecayVtx, kfp_ele_DecayVtx}) {
-        float legpt = RecoDecay::sqrtSumOfSquares(leg.GetPx(), leg.GetPy());
-        float legeta = RecoDecay::eta(std::array{leg.GetPx(), leg.GetPy(), leg.GetPz()});
-        float legphi = RecoDecay::constrainAngle(RecoDecay::phi(leg.GetPx(), leg.GetPy()));
-        registry.fill(HIST("V0Leg/hPt"), legpt);
-        registry.fill(HIST("V0Leg/hEtaPhi"), legphi, legeta);
-      } // end of leg loop
-      for (const auto& leg : {pos, ele}) {
-        registry.fill(HIST("V0Leg/hdEdx_Pin"), leg.tpcInnerParam(), leg.tpcSignal());
-        registry.fill(HIST("V0Leg/hTPCNsigmaEl"), leg.tpcInnerParam(), leg.tpcNSigmaEl());
-      } // end of leg loop
-      for (const auto& leg : {pTrack, nTrack}) {
-        registry.fill(HIST("V0Leg/hXZ"), leg.getZ(), leg.getX());
-        registry.fill(HIST("V0Leg/hRelDeltaPt"), leg.getPt(), leg.getPt() * std::sqrt(leg.getSigma1Pt2()));
-      } // end of leg loop
-      registry.fill(HIST("V0Leg/hDCAxyz"), posdcaXY, posdcaZ);
-      registry.fill(HIST("V0Leg/hDCAxyz"), eledcaXY, eledcaZ);
-
-      ROOT::Math::PxPyPzMVector vpos_sv(kfp_pos_DecayVtx.GetPx(), kfp_pos_DecayVtx.GetPy(), kfp_pos_DecayVtx.GetPz(), o2::constants::physics::MassElectron);
-      ROOT::Math::PxPyPzMVector vele_sv(kfp_ele_DecayVtx.GetPx(), kfp_ele_DecayVtx.GetPy(), kfp_ele_DecayVtx.GetPz(), o2::constants::physics::MassElectron);
-      ROOT::Math::PxPyPzMVector v0_sv = vpos_sv + vele_sv;
-      registry.fill(HIST("V0/hMeeSV_Rxy"), rxy, v0_sv.M());
-
-      v0photonskf(collision.globalIndex(), v0.globalIndex(), v0legs.lastIndex() + 1, v0legs.lastIndex() + 2,
-                  gammaKF_DecayVtx.GetX(), gammaKF_DecayVtx.GetY(), gammaKF_DecayVtx.GetZ(),
-                  gammaKF_PV.GetPx(), gammaKF_PV.GetPy(), gammaKF_PV.GetPz(),
-                  v0_sv.M(), v0photoncandidate.getDcaXYToPV(), v0photoncandidate.getDcaZToPV(),
-                  cospa_kf, cospaXYKF, cospaRZKF,
-                  v0photoncandidate.getPCA(), v0photoncandidate.getAlpha(), v0photoncandidate.getQt(), v0photoncandidate.getChi2NDF());
-      v0photonsphivpsi(v0photoncandidate.getPhiV(), v0photoncandidate.getPsiPair());
-
-      // v0photonskfcov(gammaKF_PV.GetCovariance(9), gammaKF_PV.GetCovariance(14), gammaKF_PV.GetCovariance(20), gammaKF_PV.GetCovariance(13), gammaKF_PV.GetCovariance(19), gammaKF_PV.GetCovariance(18));
-
-      fillTrackTable<isMC>(pos, kfp_pos_DecayVtx, posdcaXY, posdcaZ); // positive leg first
-      fillTrackTable<isMC>(ele, kfp_ele_DecayVtx, eledcaXY, eledcaZ); // negative leg second
-    } // end of fill table
+    registry.fill(HIST("V0/hAP"), candidate.getAlpha(), candidate.getQt());
+    registry.fill(HIST("V0/hConversionPointXY"), gammaKF_DecayVtx.GetX(), gammaKF_DecayVtx.GetY());
+    registry.fill(HIST("V0/hConversionPointRZ"), gammaKF_DecayVtx.GetZ(), record.rxy);
+    registry.fill(HIST("V0/hPt"), candidate.getPt());
+    registry.fill(HIST("V0/hEtaPhi"), record.v0phi, record.v0eta);
+    registry.fill(HIST("V0/hCosPA"), candidate.getCosPA());
+    registry.fill(HIST("V0/hCosPA_Rxy"), record.rxy, candidate.getCosPA());
+    registry.fill(HIST("V0/hPCA"), candidate.getPCA());
+    registry.fill(HIST("V0/hPCA_CosPA"), candidate.getCosPA(), candidate.getPCA());
+    registry.fill(HIST("V0/hPCA_Rxy"), record.rxy, candidate.getPCA());
+    registry.fill(HIST("V0/hDCAxyz"), candidate.getDcaXYToPV(), candidate.getDcaZToPV());
+    registry.fill(HIST("V0/hPCA_diffX"), candidate.getPCA(), std::min(pTrack.getX(), nTrack.getX()) - record.rxy); // trackiu.x() - rxy should be positive
+    registry.fill(HIST("V0/hPhiVPsiPair"), candidate.getPsiPair(), candidate.getPhiV());
+
+    // LOGF(info, "cospa_kf = %f, cospaXY_kf = %f, cospaRZ_kf = %f", cospa_kf, cospaXY_kf, cospaRZ_kf);
+    registry.fill(HIST("V0/hCosPAXY_Rxy"), record.rxy, record.cospaXYKF);
+    registry.fill(HIST("V0/hCosPARZ_Rxy"), record.rxy, record.cospaRZKF);
+
+    for (const auto& leg : {kfp_pos_DecayVtx, kfp_ele_DecayVtx}) {
+      float legpt = RecoDecay::sqrtSumOfSquares(leg.GetPx(), leg.GetPy());
+      float legeta = RecoDecay::eta(std::array{leg.GetPx(), leg.GetPy(), leg.GetPz()});
+      float legphi = RecoDecay::constrainAngle(RecoDecay::phi(leg.GetPx(), leg.GetPy()));
+      registry.fill(HIST("V0Leg/hPt"), legpt);
+      registry.fill(HIST("V0Leg/hEtaPhi"), legphi, legeta);
+    } // end of leg loop
+    for (const auto& leg : {pos, ele}) {
+      registry.fill(HIST("V0Leg/hdEdx_Pin"), leg.tpcInnerParam(), leg.tpcSignal());
+      registry.fill(HIST("V0Leg/hTPCNsigmaEl"), leg.tpcInnerParam(), leg.tpcNSigmaEl());
+    } // end of leg loop
+    for (const auto& leg : {pTrack, nTrack}) {
+      registry.fill(HIST("V0Leg/hXZ"), leg.getZ(), leg.getX());
+      registry.fill(HIST("V0Leg/hRelDeltaPt"), leg.getPt(), leg.getPt() * std::sqrt(leg.getSigma1Pt2()));
+    } // end of leg loop
+    registry.fill(HIST("V0Leg/hDCAxyz"), record.posdcaXY, record.posdcaZ);
+    registry.fill(HIST("V0Leg/hDCAxyz"), record.eledcaXY, record.eledcaZ);
+
+    ROOT::Math::PxPyPzMVector vpos_sv(kfp_pos_DecayVtx.GetPx(), kfp_pos_DecayVtx.GetPy(), kfp_pos_DecayVtx.GetPz(), o2::constants::physics::MassElectron);
+    ROOT::Math::PxPyPzMVector vele_sv(kfp_ele_DecayVtx.GetPx(), kfp_ele_DecayVtx.GetPy(), kfp_ele_DecayVtx.GetPz(), o2::constants::physics::MassElectron);
+    ROOT::Math::PxPyPzMVector v0_sv = vpos_sv + vele_sv;
+    registry.fill(HIST("V0/hMeeSV_Rxy"), record.rxy, v0_sv.M());
+
+    v0photonskf(collisionId, v0.globalIndex(), v0legs.lastIndex() + 1, v0legs.lastIndex() + 2,
+                gammaKF_DecayVtx.GetX(), gammaKF_DecayVtx.GetY(), gammaKF_DecayVtx.GetZ(),
+                gammaKF_PV.GetPx(), gammaKF_PV.GetPy(), gammaKF_PV.GetPz(),
+                v0_sv.M(), candidate.getDcaXYToPV(), candidate.getDcaZToPV(),
+                record.cospa_kf, record.cospaXYKF, record.cospaRZKF,
+                candidate.getPCA(), candidate.getAlpha(), candidate.getQt(), candidate.getChi2NDF());
+    v0photonsphivpsi(candidate.getPhiV(), candidate.getPsiPair());
+
+    // v0photonskfcov(gammaKF_PV.GetCovariance(9), gammaKF_PV.GetCovariance(14), gammaKF_PV.GetCovariance(20), gammaKF_PV.GetCovariance(13), gammaKF_PV.GetCovariance(19), gammaKF_PV.GetCovariance(18));
+
+    fillTrackTable<isMC>(pos, kfp_pos_DecayVtx, record.posdcaXY, record.posdcaZ); // positive leg first
+    fillTrackTable<isMC>(ele, kfp_ele_DecayVtx, record.eledcaXY, record.eledcaZ); // negative leg second
   }
 
   Preslice<aod::V0s> perCollision = o2::aod::v0::collisionId;
-  std::map<std::tuple<int64_t, int64_t, int64_t, int64_t>, float> pca_map;      // (v0.globalIndex(), collision.globalIndex(), pos.globalIndex(), ele.globalIndex()) -> pca
-  std::map<std::tuple<int64_t, int64_t, int64_t, int64_t>, float> cospa_map;    // (v0.globalIndex(), collision.globalIndex(), pos.globalIndex(), ele.globalIndex()) -> cospa
-  std::vector<std::pair<int64_t, int64_t>> stored_v0Ids;                        // (pos.globalIndex(), ele.globalIndex())
-  std::vector<std::tuple<int64_t, int64_t, int64_t, int64_t>> stored_fullv0Ids; // (v0.globalIndex(), collision.globalIndex(), pos.globalIndex(), ele.globalIndex())
-  std::unordered_map<int64_t, int> nv0_map;                                     // map collisionId -> nv0
+  std::map<std::tuple<int64_t, int64_t, int64_t, int64_t>, V0PhotonRecord> v0photon_records;    // (v0.globalIndex(), collision.globalIndex(), pos.globalIndex(), ele.globalIndex()) -> candidate
+  std::unordered_map<int64_t, float> min_pca_per_pos;                                           // pos.globalIndex() -> min. pca of the candidates with this leg
+  std::unordered_map<int64_t, float> min_pca_per_ele;                                           // ele.globalIndex() -> min. pca of the candidates with this leg
+  std::map<std::pair<int64_t, int64_t>, std::vector<std::pair<int64_t, float>>> cospa_per_legs; // (pos.globalIndex(), ele.globalIndex()) -> (collision.globalIndex(), cospa)
+  std::set<std::pair<int64_t, int64_t>> stored_v0Ids;                                           // (pos.globalIndex(), ele.globalIndex())
+  std::vector<std::tuple<int64_t, int64_t, int64_t, int64_t>> stored_fullv0Ids;                 // (v0.globalIndex(), collision.globalIndex(), pos.globalIndex(), ele.globalIndex())
+  std::unordered_map<int64_t, int> nv0_map;                                                     // map collisionId -> nv0
 
   template <bool isMC, bool isTriggerAnalysis, bool enableFilter, typename TCollisions, typename TV0s, typename TTracks, typename TBCs>
   void build(TCollisions const& collisions, TV0s const& v0s, TTracks const&, TBCs const&)
   {
+    if (moveTPCTracks) {
+      // TPC-only tracks of several V0s are moved once per collision
+      mVDriftMgr.cacheDataFrame<TBCs>(collisions);
+    }
     for (const auto& collision : collisions) {
       if constexpr (isMC) {
         if (!collision.has_mcCollision()) {
@@ -906,64 +932,54 @@ struct PhotonConversionBuilder {
       // LOGF(info, "n v0 = %d", v0s_per_coll.size());
       for (const auto& v0 : v0s_per_coll) {
         // LOGF(info, "collision.globalIndex() = %d, v0.globalIndex() = %d, v0.posTrackId() = %d, v0.negTrackId() = %d", collision.globalIndex(), v0.globalIndex(), v0.posTrackId() , v0.negTrackId());
-        fillV0Table<isMC, TBCs, TCollisions, TTracks>(v0, false);
+        buildV0Candidate<isMC, TBCs, TCollisions, TTracks>(v0);
       } // end of v0 loop
     } // end of collision loop
 
-    stored_v0Ids.reserve(pca_map.size());     // number of photon candidates per DF
-    stored_fullv0Ids.reserve(pca_map.size()); // number of photon candidates per DF
+    stored_fullv0Ids.reserve(v0photon_records.size()); // number of photon candidates per DF
 
-    // find minimal pca
-    for (const auto& [key, value] : pca_map) {
-      auto v0Id = std::get<0>(key);
+    // find minimal pca: a candidate is rejected if another one shares a leg and has a smaller pca,
+    // or has the same legs but is attached to a different collision with a larger cospa
+    for (const auto& [key, record] : v0photon_records) {
       auto collisionId = std::get<1>(key);
       auto posId = std::get<2>(key);
       auto eleId = std::get<3>(key);
-      float v0pca = value;
-      float cospa = cospa_map[key];
-      bool is_closest_v0 = true;
-      bool is_most_aligned_v0 = true;
-
-      for (const auto& [key_tmp, value_tmp] : pca_map) {
-        auto v0Id_tmp = std::get<0>(key_tmp);
-        auto collisionId_tmp = std::get<1>(key_tmp);
-        auto posId_tmp = std::get<2>(key_tmp);
-        auto eleId_tmp = std::get<3>(key_tmp);
-        float v0pca_tmp = value_tmp;
-        float cospa_tmp = cospa_map[key_tmp];
+      float v0pca = record.candidate.getPCA();
+      auto [min_pca_pos, isNewPos] = min_pca_per_pos.try_emplace(posId, v0pca);
+      if (!isNewPos) {
+        min_pca_pos->second = std::min(min_pca_pos->second, v0pca);
+      }
+      auto [min_pca_ele, isNewEle] = min_pca_per_ele.try_emplace(eleId, v0pca);
+      if (!isNewEle) {
+        min_pca_ele->second = std::min(min_pca_ele->second, v0pca);
+      }
+      cospa_per_legs[std::make_pair(posId, eleId)].emplace_back(collisionId, record.candidate.getCosPA());
+    }
 
-        if (v0Id == v0Id_tmp) { // skip exactly the same v0
-          continue;
-        }
+    for (const auto& [key, record] : v0photon_records) {
+      auto v0Id = std::get<0>(key);
+      auto collisionId = std::get<1>(key);
+      auto posId = std::get<2>(key);
+      auto eleId = std::get<3>(key);
+      float v0pca = record.candidate.getPCA();
+      float cospa = record.candidate.getCosPA();
 
-        if (collisionId != collisionId_tmp && eleId == eleId_tmp && posId == posId_tmp && cospa < cospa_tmp) { // same ele and pos, but attached to different collision
-          // LOGF(info, "!reject! | collision id = %d | posid1 = %d , eleid1 = %d , posid2 = %d , eleid2 = %d , cospa1 = %f , cospa2 = %f", collisionId, posId, eleId, posId_tmp, eleId_tmp, cospa, cospa_tmp);
+      bool is_closest_v0 = v0pca <= min_pca_per_pos[posId] && v0pca <= min_pca_per_ele[eleId];
+      bool is_most_aligned_v0 = true;
+      for (const auto& [collisionId_tmp, cospa_tmp] : cospa_per_legs[std::make_pair(posId, eleId)]) {
+        if (collisionId != collisionId_tmp && cospa < cospa_tmp) { // same ele and pos, but attached to different collision
           is_most_aligned_v0 = false;
           break;
         }
+      }
 
-        if ((eleId == eleId_tmp || posId == posId_tmp) && v0pca > v0pca_tmp) {
-          // LOGF(info, "!reject! | collision id = %d | posid1 = %d , eleid1 = %d , posid2 = %d , eleid2 = %d , pca1 = %f , pca2 = %f", collisionId, posId, eleId, posId_tmp, eleId_tmp, v0pca, v0pca_tmp);
-          is_closest_v0 = false;
-          break;
-        }
-      } // end of pca_map tmp loop
-
-      bool is_stored = std::find(stored_v0Ids.begin(), stored_v0Ids.end(), std::make_pair(posId, eleId)) != stored_v0Ids.end();
-      if (is_closest_v0 && is_most_aligned_v0 && !is_stored) {
-        // auto v0 = v0s.rawIteratorAt(v0Id);
-        // auto collision = collisions.rawIteratorAt(collisionId);
-        // auto pos = tracks.rawIteratorAt(posId);
-        // auto ele = tracks.rawIteratorAt(eleId);
+      if (is_closest_v0 && is_most_aligned_v0 && stored_v0Ids.insert(std::make_pair(posId, eleId)).second) {
         // LOGF(info, "!accept! | collision id = %d | v0id1 = %d , posid1 = %d , eleid1 = %d , pca1 = %f , cospa = %f", collisionId, v0Id, posId, eleId, v0pca, cospa);
-
-        // fillV0Table<isMC, TCollisions, TTracks>(v0, true);
-        stored_v0Ids.emplace_back(std::make_pair(posId, eleId));
         stored_fullv0Ids.emplace_back(std::make_tuple(v0Id, collisionId, posId, eleId));
         nv0_map[collisionId]++;
       }
-    } // end of pca_map loop
-    // LOGF(info, "pca_map.size() = %d", pca_map.size());
+    } // end of candidate loop
+    // LOGF(info, "v0photon_records.size() = %d", v0photon_records.size());
 
     for (const auto& fullv0Id : stored_fullv0Ids) {
       auto v0Id = std::get<0>(fullv0Id);
@@ -981,7 +997,7 @@ struct PhotonConversionBuilder {
         // LOGF(info, "collision_tmp.globalIndex() = %d, collision_tmp.neeuls() = %d, nv0_map = %d", collision_tmp.globalIndex(), collision_tmp.neeuls(), nv0_map[collision_tmp.globalIndex()]);
       }
 
-      fillV0Table<isMC, TBCs, TCollisions, TTracks>(v0, true);
+      fillV0Table<isMC, TTracks>(v0, std::get<1>(fullv0Id), v0photon_records.at(fullv0Id));
     } // end of fullv0Id loop
 
     for (const auto& collision : collisions) {
@@ -993,11 +1009,12 @@ struct PhotonConversionBuilder {
       // events_ngpcm(nv0_map[collision.globalIndex()]);
     } // end of collision loop
 
-    pca_map.clear();
-    cospa_map.clear();
+    v0photon_records.clear();
+    min_pca_per_pos.clear();
+    min_pca_per_ele.clear();
+    cospa_per_legs.clear();
     nv0_map.clear();
     stored_v0Ids.clear();
-    stored_v0Ids.shrink_to_fit();
     stored_fullv0Ids.clear();
     stored_fullv0Ids.shrink_to_fit();
   } // end of build
@@ -34,7 +34,6 @@
 
 #include <TH1.h>
 
-#include <algorithm>
 #include <cmath>
 #include <cstddef>
 #include <cstdint>
@@ -82,6 +81,8 @@ struct SkimmerGammaCalo {
 
   HistogramRegistry historeg{"output", {}, OutputObjHandlingPolicy::AnalysisObject, false, false};
 
+  std::vector<bool> mIsAcceptedDefinition; // accepted cluster definitions indexed by definition, filled from clusterDefinitions at init
+
   void init(o2::framework::InitContext&)
   {
     historeg.add("DefinitionIn", "Cluster definitions before cuts;#bf{Cluster definition};#bf{#it{N}_{clusters}}", HistType::kTH1F, {{51, -0.5, 50.5}});
@@ -119,6 +120,16 @@ struct SkimmerGammaCalo {
     hCaloSecondaryTrackFilter->GetXaxis()->SetBinLabel(3, "E/p cut");
     hCaloSecondaryTrackFilter->GetXaxis()->SetBinLabel(4, "out");
 
+    for (const auto& definition : clusterDefinitions.value) {
+      if (definition < 0) {
+        continue;
+      }
+      if (static_cast<size_t>(definition) >= mIsAcceptedDefinition.size()) {
+        mIsAcceptedDefinition.resize(definition + 1, false);
+      }
+      mIsAcceptedDefinition[definition] = true;
+    }
+
     LOG(info) << "| EMCal cluster cuts for skimming:";
     LOG(info) << "| Timing cut: " << minTime << " < t < " << maxTime;
     LOG(info) << "| M02 cut: " << minM02 << " < M02 < " << maxM02;
@@ -128,6 +139,11 @@ struct SkimmerGammaCalo {
     LOG(info) << "| TM - E/p cut: E/p < " << maxEoverP;
   }
 
+  bool isAcceptedDefinition(int definition) const
+  {
+    return definition >= 0 && static_cast<size_t>(definition) < mIsAcceptedDefinition.size() && mIsAcceptedDefinition[definition];
+  }
+
   template <typename TSecondaries>
   static constexpr bool HasSecondaries = !std::is_same_v<TSecondaries, std::nullptr_t>;
 
@@ -170,7 +186,7 @@ struct SkimmerGammaCalo {
       historeg.fill(HIST("EIn"), emccluster.energy());
 
       // Definition cut
-      if (!(std::find(clusterDefinitions.value.begin(), clusterDefinitions.value.end(), emccluster.definition()) != clusterDefinitions.value.end())) {
+      if (!isAcceptedDefinition(emccluster.definition())) {
         historeg.fill(HIST("hCaloClusterFilter"), 1);
         continue;
       }
@@ -208,8 +224,10 @@ struct SkimmerGammaCalo {
           historeg.fill(HIST("hCaloTrackFilter"), 1);
           continue;
         }
-        historeg.fill(HIST("Eoverp"), emccluster.energy(), emccluster.energy() / emcmatchedtrack.template track_as<aod::FullTracks>().p());
-        if (emccluster.energy() / emcmatchedtrack.template track_as<aod::FullTracks>().p() > maxEoverP) {
+        const auto& matchedTrack = emcmatchedtrack.template track_as<aod::FullTracks>();
+        const float trackP = matchedTrack.p();
+        historeg.fill(HIST("Eoverp"), emccluster.energy(), emccluster.energy() / trackP);
+        if (emccluster.energy() / trackP > maxEoverP) {
           historeg.fill(HIST("hCaloTrackFilter"), 2);
           continue;
         }
@@ -217,8 +235,8 @@ struct SkimmerGammaCalo {
         historeg.fill(HIST("MTEtaPhiAfterTM"), emcmatchedtrack.deltaEta(), emcmatchedtrack.deltaPhi());
         vEta.emplace_back(emcmatchedtrack.deltaEta());
         vPhi.emplace_back(emcmatchedtrack.deltaPhi());
-        vP.emplace_back(emcmatchedtrack.template track_as<aod::FullTracks>().p());
-        vPt.emplace_back(emcmatchedtrack.template track_as<aod::FullTracks>().pt());
+        vP.emplace_back(trackP);
+        vPt.emplace_back(matchedTrack.pt());
       }
 
       if constexpr (HasSecondaries<TMatchedSecondaries>) {
@@ -234,8 +252,9 @@ struct SkimmerGammaCalo {
           historeg.fill(HIST("MSTEtaPhiAfterTM"), emcMatchedSecondary.deltaEta(), emcMatchedSecondary.deltaPhi());
           vEtaSecondaries.emplace_back(emcMatchedSecondary.deltaEta());
           vPhiSecondaries.emplace_back(emcMatchedSecondary.deltaPhi());
-          vPSecondaries.emplace_back(emcMatchedSecondary.template track_as<aod::FullTracks>().p());
-          vPtSecondaries.emplace_back(emcMatchedSecondary.template track_as<aod::FullTracks>().pt());
+          const auto& matchedSecondary = emcMatchedSecondary.template track_as<aod::FullTracks>();
+          vPSecondaries.emplace_back(matchedSecondary.p());
+          vPtSecondaries.emplace_back(matchedSecondary.pt());
         }
       }
 
@@ -315,7 +334,7 @@ struct SkimmerGammaCalo {
     for (const auto& emccluster : emcclusters) {
 
       // Definition cut
-      if (!(std::find(clusterDefinitions.value.begin(), clusterDefinitions.value.end(), emccluster.definition()) != clusterDefinitions.value.end())) {
+      if (!isAcceptedDefinition(emccluster.definition())) {
         continue;
       }
       // Energy cut
@@ -42,6 +42,7 @@ struct HfHelper {
   // 2-prong
 
   // D0(bar) → π± K∓
+  // Masses and rapidity are read from aod::HfCand2ProngKinD0 when the candidate table is joined with it
 
   template <typename T>
   static auto ctD0(const T& candidate)
@@ -52,7 +53,11 @@ struct HfHelper {
   template <typename T>
   static auto yD0(const T& candidate)
   {
-    return candidate.y(o2::constants::physics::MassD0);
+    if constexpr (requires { candidate.rapidityD0(); }) {
+      return candidate.rapidityD0();
+    } else {
+      return candidate.y(o2::constants::physics::MassD0);
+    }
   }
 
   template <typename T>
@@ -64,13 +69,21 @@ struct HfHelper {
   template <typename T>
   static auto invMassD0ToPiK(const T& candidate)
   {
-    return candidate.m(std::array{o2::constants::physics::MassPiPlus, o2::constants::physics::MassKPlus});
+    if constexpr (requires { candidate.invMassD0ToPiK(); }) {
+      return candidate.invMassD0ToPiK();
+    } else {
+      return candidate.m(std::array{o2::constants::physics::MassPiPlus, o2::constants::physics::MassKPlus});
+    }
   }
 
   template <typename T>
   static auto invMassD0barToKPi(const T& candidate)
   {
-    return candidate.m(std::array{o2::constants::physics::MassKPlus, o2::constants::physics::MassPiPlus});
+    if constexpr (requires { candidate.invMassD0barToKPi(); }) {
+      return candidate.invMassD0barToKPi();
+    } else {
+      return candidate.m(std::array{o2::constants::physics::MassKPlus, o2::constants::physics::MassPiPlus});
+    }
   }
 
   template <typename T>
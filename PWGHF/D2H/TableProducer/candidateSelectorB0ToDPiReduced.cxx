@@ -41,6 +41,7 @@
 #include <Rtypes.h>
 
 #include <array>
+#include <cstddef>
 #include <cstdint>
 #include <numeric>
 #include <string>
@@ -98,6 +99,9 @@ struct HfCandidateSelectorB0ToDPiReduced {
   o2::analysis::HfMlResponseB0ToDPi<float, true> hfMlResponse;
   float outputMlNotPreselected = -1.;
   std::vector<float> outputMl;
+  std::vector<int> statusCandidates; // selection status of the candidates, written after the ML batch evaluation
+  std::vector<int> mlBatchIndices;   // index of the candidates in the ML batch (-1 if not evaluated)
+  std::vector<float> ptCandidates;   // pT of the candidates, for the QA of the ML selection
   o2::ccdb::CcdbApi ccdbApi;
 
   TrackSelectorPi selectorPion;
@@ -219,9 +223,21 @@ struct HfCandidateSelectorB0ToDPiReduced {
       mySelectionFlagD = config.mySelectionFlagD();
     }
 
+    // The table rows are written after the loop, so that the ML models are evaluated on all the candidates at once
+    statusCandidates.clear();
+    mlBatchIndices.clear();
+    ptCandidates.clear();
+    if (applyB0Ml) {
+      hfMlResponse.clearBatch();
+    }
+    auto storeCandidate = [&](int status, int mlBatchIndex = -1) {
+      statusCandidates.push_back(status);
+      mlBatchIndices.push_back(mlBatchIndex);
+    };
     for (const auto& hfCandB0 : hfCandsB0) {
       int statusB0ToDPi = 0;
       auto ptCandB0 = hfCandB0.pt();
+      ptCandidates.push_back(ptCandB0);
 
       SETBIT(statusB0ToDPi, SelectionStep::RecoSkims); // RecoSkims = 0 --> statusB0ToDPi = 1
       if (activateQA) {
@@ -230,20 +246,14 @@ struct HfCandidateSelectorB0ToDPiReduced {
 
       // topological cuts
       if (!HfHelper::selectionB0ToDPiTopol(hfCandB0, cuts, binsPt)) {
-        hfSelB0ToDPiCandidate(statusB0ToDPi);
-        if (applyB0Ml) {
-          hfMlB0ToDPiCandidate(outputMlNotPreselected);
-        }
+        storeCandidate(statusB0ToDPi);
         // LOGF(info, "B0 candidate selection failed at topology selection");
         continue;
       }
 
       if constexpr (WithDmesMl) { // we include it in the topological selections
         if (!HfHelper::selectionDmesMlScoresForBReduced(hfCandB0, cutsDmesMl, binsPtDmesMl)) {
-          hfSelB0ToDPiCandidate(statusB0ToDPi);
-          if (applyB0Ml) {
-            hfMlB0ToDPiCandidate(outputMlNotPreselected);
-          }
+          storeCandidate(statusB0ToDPi);
           // LOGF(info, "B0 candidate selection failed at D-meson ML selection");
           continue;
         }
@@ -264,10 +274,7 @@ struct HfCandidateSelectorB0ToDPiReduced {
         }
         if (!HfHelper::selectionB0ToDPiPid(pidTrackBachPi, acceptPIDNotApplicable.value)) {
           // LOGF(info, "B0 candidate selection failed at PID selection");
-          hfSelB0ToDPiCandidate(statusB0ToDPi);
-          if (applyB0Ml) {
-            hfMlB0ToDPiCandidate(outputMlNotPreselected);
-          }
+          storeCandidate(statusB0ToDPi);
           continue;
         }
         SETBIT(statusB0ToDPi, SelectionStep::RecoPID); // RecoPID = 2 --> statusB0ToDPi = 7
@@ -276,23 +283,36 @@ struct HfCandidateSelectorB0ToDPiReduced {
         }
       }
       if (applyB0Ml) {
-        // B0 ML selections
+        // B0 ML selections, evaluated on all the candidates after the loop
         std::vector<float> inputFeatures = getMlInputFeatures<WithDmesMl>(hfCandB0, trackBachPi);
-        bool const isSelectedMl = hfMlResponse.isSelectedMl(inputFeatures, ptCandB0, outputMl);
-        hfMlB0ToDPiCandidate(outputMl[1]); // storing ML score for signal class
+        storeCandidate(statusB0ToDPi, hfMlResponse.addToBatch(inputFeatures, ptCandB0));
+        continue;
+      }
 
-        if (!isSelectedMl) {
-          hfSelB0ToDPiCandidate(statusB0ToDPi);
-          continue;
-        }
-        SETBIT(statusB0ToDPi, SelectionStep::RecoMl); // RecoML = 3 --> statusB0ToDPi = 15 if pionPidMethod, 11 otherwise
-        if (activateQA) {
-          registry.fill(HIST("hSelections"), 2 + SelectionStep::RecoMl, ptCandB0);
+      storeCandidate(statusB0ToDPi);
+      // LOGF(info, "B0 candidate selection passed all selections");
+    }
+
+    if (applyB0Ml) {
+      hfMlResponse.evaluateBatch();
+    }
+    for (std::size_t iCand = 0; iCand < statusCandidates.size(); ++iCand) {
+      auto statusB0ToDPi = statusCandidates[iCand];
+      if (applyB0Ml) {
+        if (mlBatchIndices[iCand] < 0) {
+          hfMlB0ToDPiCandidate(outputMlNotPreselected);
+        } else {
+          bool const isSelectedMl = hfMlResponse.isSelectedMlBatch(mlBatchIndices[iCand], outputMl);
+          hfMlB0ToDPiCandidate(outputMl[1]); // storing ML score for signal class
+          if (isSelectedMl) {
+            SETBIT(statusB0ToDPi, SelectionStep::RecoMl); // RecoML = 3 --> statusB0ToDPi = 15 if pionPidMethod, 11 otherwise
+            if (activateQA) {
+              registry.fill(HIST("hSelections"), 2 + SelectionStep::RecoMl, ptCandidates[iCand]);
+            }
+          }
         }
       }
-
       hfSelB0ToDPiCandidate(statusB0ToDPi);
-      // LOGF(info, "B0 candidate selection passed all selections");
     }
   }
 
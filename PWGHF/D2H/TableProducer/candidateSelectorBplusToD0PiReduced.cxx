@@ -40,6 +40,7 @@
 #include <Rtypes.h>
 
 #include <array>
+#include <cstddef>
 #include <cstdint>
 #include <numeric>
 #include <string>
@@ -98,6 +99,9 @@ struct HfCandidateSelectorBplusToD0PiReduced {
   o2::analysis::HfMlResponseBplusToD0PiReduced<float> hfMlResponse;
   float outputMlNotPreselected = -1.;
   std::vector<float> outputMl;
+  std::vector<int> statusCandidates; // selection status of the candidates, written after the ML batch evaluation
+  std::vector<int> mlBatchIndices;   // index of the candidates in the ML batch (-1 if not evaluated)
+  std::vector<float> ptCandidates;   // pT of the candidates, for the QA of the ML selection
   o2::ccdb::CcdbApi ccdbApi;
 
   TrackSelectorPi selectorPion;
@@ -170,9 +174,21 @@ struct HfCandidateSelectorBplusToD0PiReduced {
       mySelectionFlagD0bar = config.mySelectionFlagD0bar();
     }
 
+    // The table rows are written after the loop, so that the ML models are evaluated on all the candidates at once
+    statusCandidates.clear();
+    mlBatchIndices.clear();
+    ptCandidates.clear();
+    if (applyBplusMl) {
+      hfMlResponse.clearBatch();
+    }
+    auto storeCandidate = [&](int status, int mlBatchIndex = -1) {
+      statusCandidates.push_back(status);
+      mlBatchIndices.push_back(mlBatchIndex);
+    };
     for (const auto& hfCandBp : hfCandsBp) {
       int statusBplus = 0;
       auto ptCandBplus = hfCandBp.pt();
+      ptCandidates.push_back(ptCandBplus);
 
       SETBIT(statusBplus, SelectionStep::RecoSkims); // RecoSkims = 0 --> statusBplus = 1
       if (activateQA) {
@@ -181,20 +197,14 @@ struct HfCandidateSelectorBplusToD0PiReduced {
 
       // topological cuts
       if (!HfHelper::selectionBplusToD0PiTopol(hfCandBp, cuts, binsPt)) {
-        hfSelBplusToD0PiCandidate(statusBplus);
-        if (applyBplusMl) {
-          hfMlBplusToD0PiCandidate(outputMlNotPreselected);
-        }
+        storeCandidate(statusBplus);
         // LOGF(info, "B+ candidate selection failed at topology selection");
         continue;
       }
 
       if constexpr (WithDmesMl) { // we include it in the topological selections
         if (!HfHelper::selectionDmesMlScoresForBReduced(hfCandBp, cutsDmesMl, binsPtDmesMl)) {
-          hfSelBplusToD0PiCandidate(statusBplus);
-          if (applyBplusMl) {
-            hfMlBplusToD0PiCandidate(outputMlNotPreselected);
-          }
+          storeCandidate(statusBplus);
           // LOGF(info, "B+ candidate selection failed at D0-meson ML selection");
           continue;
         }
@@ -216,10 +226,7 @@ struct HfCandidateSelectorBplusToD0PiReduced {
         }
         if (!HfHelper::selectionBplusToD0PiPid(pidTrackPi, acceptPIDNotApplicable.value)) {
           // LOGF(info, "B+ candidate selection failed at PID selection");
-          hfSelBplusToD0PiCandidate(statusBplus);
-          if (applyBplusMl) {
-            hfMlBplusToD0PiCandidate(outputMlNotPreselected);
-          }
+          storeCandidate(statusBplus);
           continue;
         }
         SETBIT(statusBplus, SelectionStep::RecoPID); // RecoPID = 2 --> statusBplus = 7
@@ -228,23 +235,36 @@ struct HfCandidateSelectorBplusToD0PiReduced {
         }
       }
       if (applyBplusMl) {
-        // B+ ML selections
+        // B+ ML selections, evaluated on all the candidates after the loop
         std::vector<float> inputFeatures = hfMlResponse.getInputFeatures<WithDmesMl>(hfCandBp, trackPi);
-        bool const isSelectedMl = hfMlResponse.isSelectedMl(inputFeatures, ptCandBplus, outputMl);
-        hfMlBplusToD0PiCandidate(outputMl[1]); // storing ML score for signal class
+        storeCandidate(statusBplus, hfMlResponse.addToBatch(inputFeatures, ptCandBplus));
+        continue;
+      }
 
-        if (!isSelectedMl) {
-          hfSelBplusToD0PiCandidate(statusBplus);
-          continue;
-        }
-        SETBIT(statusBplus, SelectionStep::RecoMl); // RecoML = 3 --> statusBplus = 15 if pionPidMethod, 11 otherwise
-        if (activateQA) {
-          registry.fill(HIST("hSelections"), 2 + SelectionStep::RecoMl, ptCandBplus);
+      storeCandidate(statusBplus);
+      // LOGF(info, "B+ candidate selection passed all selections");
+    }
+
+    if (applyBplusMl) {
+      hfMlResponse.evaluateBatch();
+    }
+    for (std::size_t iCand = 0; iCand < statusCandidates.size(); ++iCand) {
+      auto statusBplus = statusCandidates[iCand];
+      if (applyBplusMl) {
+        if (mlBatchIndices[iCand] < 0) {
+          hfMlBplusToD0PiCandidate(outputMlNotPreselected);
+        } else {
+          bool const isSelectedMl = hfMlResponse.isSelectedMlBatch(mlBatchIndices[iCand], outputMl);
+          hfMlBplusToD0PiCandidate(outputMl[1]); // storing ML score for signal class
+          if (isSelectedMl) {
+            SETBIT(statusBplus, SelectionStep::RecoMl); // RecoML = 3 --> statusBplus = 15 if pionPidMethod, 11 otherwise
+            if (activateQA) {
+              registry.fill(HIST("hSelections"), 2 + SelectionStep::RecoMl, ptCandidates[iCand]);
+            }
+          }
         }
       }
-
       hfSelBplusToD0PiCandidate(statusBplus);
-      // LOGF(info, "B+ candidate selection passed all selections");
     }
   }
 
@@ -40,6 +40,7 @@
 #include <Rtypes.h>
 
 #include <array>
+#include <cstddef>
 #include <cstdint>
 #include <numeric>
 #include <string>
@@ -93,7 +94,11 @@ struct HfCandidateSelectorBsToDsPiReduced {
   Configurable<bool> loadModelsFromCCDB{"loadModelsFromCCDB", false, "Flag to enable or disable the loading of models from CCDB"};
 
   o2::analysis::HfMlResponseBsToDsPi<float> hfMlResponse;
+  std::vector<float> outputMlNotPreselected{}; // empty ML scores of the candidates not evaluated
   std::vector<float> outputMl;
+  std::vector<int> statusCandidates; // selection status of the candidates, written after the ML batch evaluation
+  std::vector<int> mlBatchIndices;   // index of the candidates in the ML batch (-1 if not evaluated)
+  std::vector<float> ptCandidates;   // pT of the candidates, for the QA of the ML selection
   o2::ccdb::CcdbApi ccdbApi;
 
   TrackSelectorPi selectorPion;
@@ -160,10 +165,21 @@ struct HfCandidateSelectorBsToDsPiReduced {
                     TracksPion const&,
                     HfCandBsConfigs const&)
   {
+    // The table rows are written after the loop, so that the ML models are evaluated on all the candidates at once
+    statusCandidates.clear();
+    mlBatchIndices.clear();
+    ptCandidates.clear();
+    if (applyBsMl) {
+      hfMlResponse.clearBatch();
+    }
+    auto storeCandidate = [&](int status, int mlBatchIndex = -1) {
+      statusCandidates.push_back(status);
+      mlBatchIndices.push_back(mlBatchIndex);
+    };
     for (const auto& hfCandBs : hfCandsBs) {
       int statusBsToDsPi = 0;
-      outputMl.clear();
       auto ptCandBs = hfCandBs.pt();
+      ptCandidates.push_back(ptCandBs);
 
       SETBIT(statusBsToDsPi, SelectionStep::RecoSkims); // RecoSkims = 0 --> statusBsToDsPi = 1
       if (activateQA) {
@@ -172,19 +188,13 @@ struct HfCandidateSelectorBsToDsPiReduced {
 
       // topological cuts
       if (!HfHelper::selectionBsToDsPiTopol(hfCandBs, cuts, binsPt)) {
-        hfSelBsToDsPiCandidate(statusBsToDsPi);
-        if (applyBsMl) {
-          hfMlBsToDsPiCandidate(outputMl);
-        }
+        storeCandidate(statusBsToDsPi);
         continue;
       }
 
       if constexpr (WithDmesMl) { // we include it in the topological selections
         if (!HfHelper::selectionDmesMlScoresForBReduced(hfCandBs, cutsDmesMl, binsPtDmesMl)) {
-          hfSelBsToDsPiCandidate(statusBsToDsPi);
-          if (applyBsMl) {
-            hfMlBsToDsPiCandidate(outputMl);
-          }
+          storeCandidate(statusBsToDsPi);
           continue;
         }
       }
@@ -204,10 +214,7 @@ struct HfCandidateSelectorBsToDsPiReduced {
           pidTrackPi = selectorPion.statusTpcAndTof(trackPi);
         }
         if (!HfHelper::selectionBsToDsPiPid(pidTrackPi, acceptPIDNotApplicable.value)) {
-          hfSelBsToDsPiCandidate(statusBsToDsPi);
-          if (applyBsMl) {
-            hfMlBsToDsPiCandidate(outputMl);
-          }
+          storeCandidate(statusBsToDsPi);
           continue;
         }
         SETBIT(statusBsToDsPi, SelectionStep::RecoPID); // RecoPID = 2 --> statusBsToDsPi = 7
@@ -217,21 +224,34 @@ struct HfCandidateSelectorBsToDsPiReduced {
       }
 
       if (applyBsMl) {
-        // Bs ML selections
+        // Bs ML selections, evaluated on all the candidates after the loop
         std::vector<float> inputFeatures = hfMlResponse.getInputFeatures<WithDmesMl>(hfCandBs, trackPi);
-        bool const isSelectedMl = hfMlResponse.isSelectedMl(inputFeatures, ptCandBs, outputMl);
-        hfMlBsToDsPiCandidate(outputMl);
+        storeCandidate(statusBsToDsPi, hfMlResponse.addToBatch(inputFeatures, ptCandBs));
+        continue;
+      }
 
-        if (!isSelectedMl) {
-          hfSelBsToDsPiCandidate(statusBsToDsPi);
-          continue;
-        }
-        SETBIT(statusBsToDsPi, SelectionStep::RecoMl); // RecoML = 3 --> statusBsToDsPi = 15 if pionPidMethod, 11 otherwise
-        if (activateQA) {
-          registry.fill(HIST("hSelections"), 2 + SelectionStep::RecoMl, ptCandBs);
+      storeCandidate(statusBsToDsPi);
+    }
+
+    if (applyBsMl) {
+      hfMlResponse.evaluateBatch();
+    }
+    for (std::size_t iCand = 0; iCand < statusCandidates.size(); ++iCand) {
+      auto statusBsToDsPi = statusCandidates[iCand];
+      if (applyBsMl) {
+        if (mlBatchIndices[iCand] < 0) {
+          hfMlBsToDsPiCandidate(outputMlNotPreselected);
+        } else {
+          bool const isSelectedMl = hfMlResponse.isSelectedMlBatch(mlBatchIndices[iCand], outputMl);
+          hfMlBsToDsPiCandidate(outputMl);
+          if (isSelectedMl) {
+            SETBIT(statusBsToDsPi, SelectionStep::RecoMl); // RecoML = 3 --> statusBsToDsPi = 15 if pionPidMethod, 11 otherwise
+            if (activateQA) {
+              registry.fill(HIST("hSelections"), 2 + SelectionStep::RecoMl, ptCandidates[iCand]);
+            }
+          }
         }
       }
-
       hfSelBsToDsPiCandidate(statusBsToDsPi);
     }
   }
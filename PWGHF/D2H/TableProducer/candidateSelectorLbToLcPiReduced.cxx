@@ -40,6 +40,7 @@
 #include <Rtypes.h>
 
 #include <array>
+#include <cstddef>
 #include <cstdint>
 #include <numeric>
 #include <string>
@@ -95,6 +96,9 @@ struct HfCandidateSelectorLbToLcPiReduced {
   o2::analysis::HfMlResponseLbToLcPi<float> hfMlResponse;
   float outputMlNotPreselected = -1.;
   std::vector<float> outputMl;
+  std::vector<int> statusCandidates; // selection status of the candidates, written after the ML batch evaluation
+  std::vector<int> mlBatchIndices;   // index of the candidates in the ML batch (-1 if not evaluated)
+  std::vector<float> ptCandidates;   // pT of the candidates, for the QA of the ML selection
   o2::ccdb::CcdbApi ccdbApi;
 
   TrackSelectorPi selectorPion;
@@ -161,10 +165,21 @@ struct HfCandidateSelectorLbToLcPiReduced {
                     TracksPion const&,
                     HfCandLbConfigs const&)
   {
+    // The table rows are written after the loop, so that the ML models are evaluated on all the candidates at once
+    statusCandidates.clear();
+    mlBatchIndices.clear();
+    ptCandidates.clear();
+    if (applyLbMl) {
+      hfMlResponse.clearBatch();
+    }
+    auto storeCandidate = [&](int status, int mlBatchIndex = -1) {
+      statusCandidates.push_back(status);
+      mlBatchIndices.push_back(mlBatchIndex);
+    };
     for (const auto& hfCandLb : hfCandsLb) {
       int statusLbToLcPi = 0;
-      outputMl.clear();
       auto ptCandLb = hfCandLb.pt();
+      ptCandidates.push_back(ptCandLb);
 
       SETBIT(statusLbToLcPi, SelectionStep::RecoSkims); // RecoSkims = 0 --> statusLbToLcPi = 1
       if (activateQA) {
@@ -173,19 +188,13 @@ struct HfCandidateSelectorLbToLcPiReduced {
 
       // topological cuts
       if (!HfHelper::selectionLbToLcPiTopol(hfCandLb, cuts, binsPt)) {
-        hfSelLbToLcPiCandidate(statusLbToLcPi);
-        if (applyLbMl) {
-          hfMlLbToLcPiCandidate(outputMlNotPreselected);
-        }
+        storeCandidate(statusLbToLcPi);
         continue;
       }
 
       if constexpr (WithLcMl) { // we include it in the topological selections
         if (!HfHelper::selectionDmesMlScoresForBReduced(hfCandLb, cutsLcMl, binsPtLcMl)) {
-          hfSelLbToLcPiCandidate(statusLbToLcPi);
-          if (applyLbMl) {
-            hfMlLbToLcPiCandidate(outputMlNotPreselected);
-          }
+          storeCandidate(statusLbToLcPi);
           continue;
         }
       }
@@ -205,10 +214,7 @@ struct HfCandidateSelectorLbToLcPiReduced {
           pidTrackPi = selectorPion.statusTpcAndTof(trackPi);
         }
         if (!HfHelper::selectionLbToLcPiPid(pidTrackPi, acceptPIDNotApplicable.value)) {
-          hfSelLbToLcPiCandidate(statusLbToLcPi);
-          if (applyLbMl) {
-            hfMlLbToLcPiCandidate(outputMlNotPreselected);
-          }
+          storeCandidate(statusLbToLcPi);
           continue;
         }
         SETBIT(statusLbToLcPi, SelectionStep::RecoPID); // RecoPID = 2 --> statusLbToLcPi = 7
@@ -218,21 +224,34 @@ struct HfCandidateSelectorLbToLcPiReduced {
       }
 
       if (applyLbMl) {
-        // Lb ML selections
+        // Lb ML selections, evaluated on all the candidates after the loop
         std::vector<float> inputFeatures = hfMlResponse.getInputFeatures<WithLcMl>(hfCandLb, trackPi);
-        bool const isSelectedMl = hfMlResponse.isSelectedMl(inputFeatures, ptCandLb, outputMl);
-        hfMlLbToLcPiCandidate(outputMl[1]);
+        storeCandidate(statusLbToLcPi, hfMlResponse.addToBatch(inputFeatures, ptCandLb));
+        continue;
+      }
 
-        if (!isSelectedMl) {
-          hfSelLbToLcPiCandidate(statusLbToLcPi);
-          continue;
-        }
-        SETBIT(statusLbToLcPi, SelectionStep::RecoMl); // RecoML = 3 --> statusLbToLcPi = 15 if PidMethod, 11 otherwise
-        if (activateQA) {
-          registry.fill(HIST("hSelections"), 2 + SelectionStep::RecoMl, ptCandLb);
+      storeCandidate(statusLbToLcPi);
+    }
+
+    if (applyLbMl) {
+      hfMlResponse.evaluateBatch();
+    }
+    for (std::size_t iCand = 0; iCand < statusCandidates.size(); ++iCand) {
+      auto statusLbToLcPi = statusCandidates[iCand];
+      if (applyLbMl) {
+        if (mlBatchIndices[iCand] < 0) {
+          hfMlLbToLcPiCandidate(outputMlNotPreselected);
+        } else {
+          bool const isSelectedMl = hfMlResponse.isSelectedMlBatch(mlBatchIndices[iCand], outputMl);
+          hfMlLbToLcPiCandidate(outputMl[1]);
+          if (isSelectedMl) {
+            SETBIT(statusLbToLcPi, SelectionStep::RecoMl); // RecoML = 3 --> statusLbToLcPi = 15 if PidMethod, 11 otherwise
+            if (activateQA) {
+              registry.fill(HIST("hSelections"), 2 + SelectionStep::RecoMl, ptCandidates[iCand]);
+            }
+          }
         }
       }
-
       hfSelLbToLcPiCandidate(statusLbToLcPi);
     }
   }
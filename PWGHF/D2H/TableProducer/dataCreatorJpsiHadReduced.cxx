@@ -67,6 +67,7 @@
 
 #include <array>
 #include <cmath>
+#include <cstddef>
 #include <cstdint>
 #include <map>
 #include <memory>
@@ -385,14 +386,13 @@ struct HfDataCreatorJpsiHadReduced {
     return true;
   }
 
-  /// Kaon selection (J/Psi K+ <-- B+)
+  /// Kaon selection (J/Psi K+ <-- B+), independent of the J/Psi candidate
   /// \param track is the considered track
   /// \param trackParCov is the track parametrisation
   /// \param dca is the 2-D array with track DCAs
-  /// \param jPsiDautracks J/Psi daughter tracks
   /// \return true if track passes all cuts
   template <typename T1, typename T2, typename T3>
-  bool isTrackSelected(const T1& track, const T2& trackParCov, const T3& dca, const std::vector<T1>& jPsiDautracks)
+  bool isTrackSelected(const T1& track, const T2& trackParCov, const T3& dca)
   {
     // check isGlobalTrackWoDCA status for kaons if wanted
     if (useTrackIsGlobalTrackWoDCA && !track.isGlobalTrackWoDCA()) {
@@ -402,12 +402,6 @@ struct HfDataCreatorJpsiHadReduced {
     if (trackParCov.getPt() < ptTrackMin || std::abs(trackParCov.getEta()) > absEtaTrackMax || !isSelectedTrackDCA(trackParCov, dca, binsPtTrack, cutsTrackDCA)) {
       return false;
     }
-    // reject kaons that are J/Psi daughters
-    for (const auto& trackJpsi : jPsiDautracks) {
-      if (track.globalIndex() == trackJpsi.globalIndex()) {
-        return false;
-      }
-    }
 
     return true;
   }
@@ -746,6 +740,9 @@ struct HfDataCreatorJpsiHadReduced {
     // the value is the track index in the table of the selected tracks
     std::map<int64_t, int64_t> selectedTracksBach;
     std::map<int64_t, int64_t> selectedTracksBach2; // for the second daughter (for B0 and Bs)
+    // bachelor tracks propagated to the collision and preselected once for all the J/Psi candidates
+    o2::hf_reduced::HfBachelorTrackPool<TTracks> bachPool;
+    bool isBachPoolFilled{false};
 
     bool fillHfReducedCollision = false;
 
@@ -839,20 +836,16 @@ struct HfDataCreatorJpsiHadReduced {
 
       // TODO: add single track information (min eta, min ITS/TPC clusters, etc.)
       double invMass2JpsiHad{0.};
-      for (const auto& trackId : trackIndices) {
-        auto trackBach = trackId.template track_as<TTracks>();
-
-        // apply selections on bachelor tracks
-        auto trackParCovBach = getTrackParCov(trackBach);
-        std::array<float, 2> dcaBach{trackBach.dcaXY(), trackBach.dcaZ()};
-        std::array<float, 3> pVecBach = trackBach.pVector();
-        if (trackBach.collisionId() != thisCollId) {
-          o2::base::Propagator::Instance()->propagateToDCABxByBz({collision.posX(), collision.posY(), collision.posZ()}, trackParCovBach, 2.f, noMatCorr, &dcaBach);
-          getPxPyPz(trackParCovBach, pVecBach);
-        }
+      if (!isBachPoolFilled) {
+        bachPool.fill(collision, trackIndices, [this](const auto& track, const auto& trackParCov, const auto& dca) { return isTrackSelected(track, trackParCov, dca); }, noMatCorr);
+        isBachPoolFilled = true;
+      }
+      for (std::size_t iBach = 0; iBach < bachPool.size(); ++iBach) {
+        const auto& trackBach = bachPool.tracks[iBach];
+        const auto& trackParCovBach = bachPool.trackParCovs[iBach];
 
-        // apply selections on bachelor tracks
-        if (!isTrackSelected(trackBach, trackParCovBach, dcaBach, jPsiDauTracks)) {
+        // reject bachelor tracks that are J/Psi daughters
+        if (o2::hf_reduced::isCandidateDaughter(trackBach, jPsiDauTracks)) {
           continue;
         }
 
@@ -928,22 +921,16 @@ struct HfDataCreatorJpsiHadReduced {
           }
           fillHfCandJpsi = true;
         } else if constexpr (DecChannel == DecayChannel::B0ToJpsiK0Star) {
-          for (auto trackBachId2 = trackId + 1; trackBachId2 != trackIndices.end(); ++trackBachId2) {
-            auto trackBach2 = trackBachId2.template track_as<TTracks>();
+          for (std::size_t iBach2 = iBach + 1; iBach2 < bachPool.size(); ++iBach2) {
+            const auto& trackBach2 = bachPool.tracks[iBach2];
             if (trackBach.sign() == trackBach2.sign()) {
               continue;
             }
-            auto trackBach2ParCov = getTrackParCov(trackBach2);
+            const auto& trackBach2ParCov = bachPool.trackParCovs[iBach2];
+            const auto& pVecBach2 = bachPool.pVecs[iBach2];
 
-            std::array<float, 2> dcaBach2{trackBach2.dcaXY(), trackBach2.dcaZ()};
-            std::array<float, 3> pVecBach2 = trackBach2.pVector();
-            if (trackBach2.collisionId() != thisCollId) {
-              o2::base::Propagator::Instance()->propagateToDCABxByBz({collision.posX(), collision.posY(), collision.posZ()}, trackBach2ParCov, 2.f, noMatCorr, &dcaBach2);
-              getPxPyPz(trackBach2ParCov, pVecBach2);
-            }
-
-            // apply selections on bachelor tracks
-            if (!isTrackSelected(trackBach2, trackBach2ParCov, dcaBach2, jPsiDauTracks)) {
+            // reject bachelor tracks that are J/Psi daughters
+            if (o2::hf_reduced::isCandidateDaughter(trackBach2, jPsiDauTracks)) {
               continue;
             }
             std::array<float, 3> pVec2{trackBach.pVector()}, pVec3{trackBach2.pVector()};
@@ -989,8 +976,8 @@ struct HfDataCreatorJpsiHadReduced {
               continue;
             }
 
-            registry.fill(HIST("hPtK0Star"), RecoDecay::pt(pVecBach, pVecBach2));
-            registry.fill(HIST("hMassK0Star"), RecoDecay::m(std::array{pVecBach, pVecBach2}, isK0StarPiK ? std::array{MassPiPlus, MassKPlus} : std::array{MassKPlus, MassPiPlus}));
+            registry.fill(HIST("hPtK0Star"), RecoDecay::pt(bachPool.pVecs[iBach], pVecBach2));
+            registry.fill(HIST("hMassK0Star"), RecoDecay::m(std::array{bachPool.pVecs[iBach], pVecBach2}, isK0StarPiK ? std::array{MassPiPlus, MassKPlus} : std::array{MassKPlus, MassPiPlus}));
             invMass2JpsiHad = RecoDecay::m2(std::array{pVecJpsi, pVecK0Star}, std::array{MassJPsi, MassK0Star892});
             if ((invMass2JpsiHad < invMass2JpsiHadMin) || (invMass2JpsiHad > invMass2JpsiHadMax)) {
               continue;
@@ -1058,22 +1045,16 @@ struct HfDataCreatorJpsiHadReduced {
             fillHfCandJpsi = true;
           }
         } else if constexpr (DecChannel == DecayChannel::BsToJpsiPhi) {
-          for (auto trackBachId2 = trackId + 1; trackBachId2 != trackIndices.end(); ++trackBachId2) {
-            auto trackBach2 = trackBachId2.template track_as<TTracks>();
+          for (std::size_t iBach2 = iBach + 1; iBach2 < bachPool.size(); ++iBach2) {
+            const auto& trackBach2 = bachPool.tracks[iBach2];
             if (trackBach.sign() == trackBach2.sign()) {
               continue;
             }
-            auto trackBach2ParCov = getTrackParCov(trackBach2);
-
-            std::array<float, 2> dcaBach2{trackBach2.dcaXY(), trackBach2.dcaZ()};
-            std::array<float, 3> pVecBach2 = trackBach2.pVector();
-            if (trackBach2.collisionId() != thisCollId) {
-              o2::base::Propagator::Instance()->propagateToDCABxByBz({collision.posX(), collision.posY(), collision.posZ()}, trackBach2ParCov, 2.f, noMatCorr, &dcaBach2);
-              getPxPyPz(trackBach2ParCov, pVecBach2);
-            }
+            const auto& trackBach2ParCov = bachPool.trackParCovs[iBach2];
+            const auto& pVecBach2 = bachPool.pVecs[iBach2];
 
-            // apply selections on bachelor tracks
-            if (!isTrackSelected(trackBach2, trackBach2ParCov, dcaBach2, jPsiDauTracks)) {
+            // reject bachelor tracks that are J/Psi daughters
+            if (o2::hf_reduced::isCandidateDaughter(trackBach2, jPsiDauTracks)) {
               continue;
             }
             std::array<float, 3> pVec2{trackBach.pVector()}, pVec3{trackBach2.pVector()};
@@ -1116,8 +1097,8 @@ struct HfDataCreatorJpsiHadReduced {
               continue;
             }
 
-            registry.fill(HIST("hPtPhi"), RecoDecay::pt(pVecBach, pVecBach2));
-            registry.fill(HIST("hMassPhi"), RecoDecay::m(std::array{pVecBach, pVecBach2}, std::array{MassKPlus, MassKPlus}));
+            registry.fill(HIST("hPtPhi"), RecoDecay::pt(bachPool.pVecs[iBach], pVecBach2));
+            registry.fill(HIST("hMassPhi"), RecoDecay::m(std::array{bachPool.pVecs[iBach], pVecBach2}, std::array{MassKPlus, MassKPlus}));
             invMass2JpsiHad = RecoDecay::m2(std::array{pVecJpsi, pVecPhi}, std::array{MassJPsi, MassPhi});
             if ((invMass2JpsiHad < invMass2JpsiHadMin) || (invMass2JpsiHad > invMass2JpsiHadMax)) {
               continue;
@@ -19,13 +19,20 @@
 #include "PWGHF/Core/CentralityEstimation.h"
 #include "PWGHF/Utils/utilsEvSelHf.h"
 
+#include "Common/Core/trackUtilities.h"
+
 #include <CCDB/BasicCCDBManager.h>
+#include <DetectorsBase/Propagator.h>
 #include <Framework/AnalysisHelpers.h>
 #include <Framework/HistogramRegistry.h>
+#include <ReconstructionDataFormats/Track.h>
 
 #include <Rtypes.h>
 
+#include <array>
 #include <cmath>
+#include <cstddef>
+#include <vector>
 
 namespace o2::hf_evsel
 {
@@ -133,4 +140,65 @@ float getTpcTofNSigmaKa1(const T1& prong1)
 }
 } // namespace o2::pid_tpc_tof_utils
 
+namespace o2::hf_reduced
+{
+/// Bachelor tracks associated to a collision, propagated to its primary vertex and preselected once,
+/// to be paired with all the charm-hadron (or J/Psi) candidates of the collision
+/// \tparam TTracks table of the bachelor tracks
+template <typename TTracks>
+struct HfBachelorTrackPool {
+  std::vector<typename TTracks::iterator> tracks;     // preselected tracks, in the order of the track-to-collision associations
+  std::vector<o2::track::TrackParCov> trackParCovs; // track parametrisations, at the DCA to the collision for tracks of other collisions
+  std::vector<std::array<float, 3>> pVecs;          // momenta at the DCA to the collision
+
+  void clear()
+  {
+    tracks.clear();
+    trackParCovs.clear();
+    pVecs.clear();
+  }
+
+  std::size_t size() const { return tracks.size(); }
+
+  /// Fills the pool with the tracks associated to the collision that pass the preselection
+  /// \param collision collision the tracks are associated to
+  /// \param trackIndices track-to-collision associations of the collision
+  /// \param isPreselected function (track, trackParCov, dca) -> bool with the candidate-independent selections
+  /// \param matCorr material correction used to propagate the tracks of other collisions
+  template <typename TColl, typename TTrackAssoc, typename TPreselection>
+  void fill(TColl const& collision, TTrackAssoc const& trackIndices, TPreselection const& isPreselected, o2::base::Propagator::MatCorrType matCorr)
+  {
+    clear();
+    for (const auto& trackId : trackIndices) {
+      auto track = trackId.template track_as<TTracks>();
+      auto trackParCov = getTrackParCov(track);
+      std::array<float, 2> dca{track.dcaXY(), track.dcaZ()};
+      std::array<float, 3> pVec = track.pVector();
+      if (track.collisionId() != collision.globalIndex()) {
+        o2::base::Propagator::Instance()->propagateToDCABxByBz({collision.posX(), collision.posY(), collision.posZ()}, trackParCov, 2.f, matCorr, &dca);
+        getPxPyPz(trackParCov, pVec);
+      }
+      if (!isPreselected(track, trackParCov, dca)) {
+        continue;
+      }
+      tracks.push_back(track);
+      trackParCovs.push_back(trackParCov);
+      pVecs.push_back(pVec);
+    }
+  }
+};
+
+/// Checks whether a track is one of the daughter tracks of a candidate
+template <typename TTrack>
+bool isCandidateDaughter(TTrack const& track, std::vector<TTrack> const& dauTracks)
+{
+  for (const auto& dauTrack : dauTracks) {
+    if (track.globalIndex() == dauTrack.globalIndex()) {
+      return true;
+    }
+  }
+  return false;
+}
+} // namespace o2::hf_reduced
+
 #endif // PWGHF_D2H_UTILS_UTILSREDDATAFORMAT_H_
@@ -363,6 +363,11 @@ DECLARE_SOA_DYNAMIC_COLUMN(CtXY, ctXY, //!
 DECLARE_SOA_COLUMN(KfGeoMassD0, kfGeoMassD0, float);       //! mass of the D0 candidate from the KFParticle geometric fit
 DECLARE_SOA_COLUMN(KfGeoMassD0bar, kfGeoMassD0bar, float); //! mass of the D0bar candidate from the KFParticle geometric fit
 
+// D0 kinematics computed once from the prong momenta
+DECLARE_SOA_COLUMN(InvMassD0ToPiK, invMassD0ToPiK, float);       //! invariant mass under the D0 -> pi K hypothesis
+DECLARE_SOA_COLUMN(InvMassD0barToKPi, invMassD0barToKPi, float); //! invariant mass under the D0bar -> K pi hypothesis
+DECLARE_SOA_COLUMN(RapidityD0, rapidityD0, float);               //! rapidity under the D0 mass hypothesis
+
 } // namespace hf_cand_2prong
 
 // MC
@@ -467,6 +472,10 @@ DECLARE_SOA_TABLE(HfCand2ProngKF, "AOD", "HFCAND2PKF",
                   hf_cand::KfTopolChi2OverNdf,
                   hf_cand_2prong::KfGeoMassD0, hf_cand_2prong::KfGeoMassD0bar);
 
+// optional table with the D0 kinematics, used by HfHelper instead of recomputing them when joined
+DECLARE_SOA_TABLE(HfCand2ProngKinD0, "AOD", "HFCAND2PKIND0", //!
+                  hf_cand_2prong::InvMassD0ToPiK, hf_cand_2prong::InvMassD0barToKPi, hf_cand_2prong::RapidityD0);
+
 // table with results of reconstruction level MC matching
 DECLARE_SOA_TABLE(HfCand2ProngMcRec, "AOD", "HFCAND2PMCREC", //!
                   hf_cand_mc_flag::FlagMcMatchRec,
@@ -22,6 +22,7 @@
 #include "PWGHF/DataModel/TrackIndexSkimmingTables.h"
 #include "PWGHF/HFC/DataModel/CorrelationTables.h"
 #include "PWGHF/HFC/DataModel/DerivedDataCorrelationTables.h"
+#include "PWGHF/HFC/Utils/utilsCorrelations.h"
 #include "PWGHF/Utils/utilsAnalysis.h"
 
 #include "Common/CCDB/EventSelectionParams.h"
@@ -48,6 +49,7 @@
 #include <TPDGCode.h>
 
 #include <array>
+#include <cstddef>
 #include <cstdint>
 #include <cstdlib>
 #include <vector>
@@ -197,6 +199,7 @@ struct HfCorrelatorDplusHadrons {
   Configurable<bool> removeCollWSplitVtx{"removeCollWSplitVtx", true, "Flag for rejecting the splitted collisions"};
   Configurable<bool> useSel8{"useSel8", true, "Flag for applying sel8 for collision selection"};
   Configurable<bool> selNoSameBunchPileUpColl{"selNoSameBunchPileUpColl", true, "Flag for rejecting the collisions associated with the same bunch crossing"};
+  Configurable<bool> storeTracksOnlyWithCand{"storeTracksOnlyWithCand", false, "Store the associated tracks in the derived data only for the collisions with at least one stored candidate (the other collisions then do not contribute tracks to the mixed events)"};
   Configurable<float> zVtxMax{"zVtxMax", 10., "max. position-z of the reconstructed collision"};
   Configurable<bool> applyEfficiency{"applyEfficiency", true, "Flag for applying D-meson efficiency weights"};
   Configurable<bool> removeDaughters{"removeDaughters", true, "Flag for removing D-meson daughters from correlations"};
@@ -256,6 +259,7 @@ struct HfCorrelatorDplusHadrons {
   ConfigurableAxis binsMassD{"binsMassD", {200, 1.7, 2.10}, "inv. mass (#pi^{+}K^{-}#pi^{+}) (GeV/#it{c}^{2})"};
   ConfigurableAxis binsDcaXY{"binsDcaXY", {128, -0.2, 0.2}, "DCA xy"};
   BinningType corrBinning{{binsZVtx, binsMultiplicity}, true};
+  hf_correlations::HfAssocTrackPool assocTrackPool; // associated tracks of the collision, paired with all the D+ candidates
   HistogramRegistry registry{"registry", {}, OutputObjHandlingPolicy::AnalysisObject};
 
   void init(InitContext&)
@@ -478,6 +482,7 @@ struct HfCorrelatorDplusHadrons {
       }
       registry.fill(HIST("hMultiplicity"), nTracks);
 
+      assocTrackPool.fill(tracks);
       int cntDplus = 0;
       std::vector<float> outputMl = {-1., -1., -1.};
       for (const auto& candidate : candidates) {
@@ -509,27 +514,22 @@ struct HfCorrelatorDplusHadrons {
 
         // Dplus-Hadron correlation dedicated section
         // if the candidate is a Dplus, search for Hadrons and evaluate correlations
-        for (const auto& track : tracks) {
-          // apply track selection
-          if (!track.isGlobalTrackWoDCA()) {
-            continue;
-          }
+        // the tracks passing the track selection (isGlobalTrackWoDCA) are in the pool
+        for (std::size_t iTrack = 0; iTrack < assocTrackPool.size(); ++iTrack) {
           // Removing Dplus daughters by checking track indices
-          if (removeDaughters) {
-            if ((candidate.prong0Id() == track.globalIndex()) || (candidate.prong1Id() == track.globalIndex()) || (candidate.prong2Id() == track.globalIndex())) {
-              continue;
-            }
+          if (removeDaughters && assocTrackPool.isProngOf3Prong(iTrack, candidate)) {
+            continue;
           }
-          entryDplusHadronPair(getDeltaPhi(track.phi(), candidate.phi()),
-                               track.eta() - candidate.eta(),
+          entryDplusHadronPair(getDeltaPhi(assocTrackPool.phis[iTrack], candidate.phi()),
+                               assocTrackPool.etas[iTrack] - candidate.eta(),
                                candidate.pt(),
-                               track.pt(), poolBin);
+                               assocTrackPool.pts[iTrack], poolBin);
           entryDplusHadronRecoInfo(HfHelper::invMassDplusToPiKPi(candidate), false);
           entryDplusHadronGenInfo(false, false, 0);
           entryDplusHadronMlInfo(outputMl[0], outputMl[1], outputMl[2]);
-          entryTrackRecoInfo(track.dcaXY(), track.dcaZ(), track.tpcNClsCrossedRows());
+          entryTrackRecoInfo(assocTrackPool.dcaXYs[iTrack], assocTrackPool.dcaZs[iTrack], assocTrackPool.tpcNClsCrossedRows[iTrack]);
           if (cntDplus == 0) {
-            entryHadron(track.phi(), track.eta(), track.pt(), poolBin, gCollisionId, timeStamp);
+            entryHadron(assocTrackPool.phis[iTrack], assocTrackPool.etas[iTrack], assocTrackPool.pts[iTrack], poolBin, gCollisionId, timeStamp);
             registry.fill(HIST("hTracksBin"), poolBin);
           }
         } // Hadron Tracks loop
@@ -552,6 +552,7 @@ struct HfCorrelatorDplusHadrons {
       auto tracksThisColl = tracks.sliceBy(trackIndicesPerCollision, thisCollId);
 
       int indexHfcReducedCollision = collReduced.lastIndex() + 1;
+      int nCandStored = 0;
 
       // Ds fill histograms and Dplus candidates information stored
       for (const auto& candidate : candsDplusThisColl) {
@@ -563,11 +564,15 @@ struct HfCorrelatorDplusHadrons {
           }
           candReduced(indexHfcReducedCollision, candidate.phi(), candidate.eta(), candidate.pt(), HfHelper::invMassDplusToPiKPi(candidate), candidate.prong0Id(), candidate.prong1Id(), candidate.prong2Id());
           candSelInfo(indexHfcReducedCollision, outputMl[0], outputMl[2]);
+          nCandStored++;
         }
       }
 
-      // tracks information
+      // tracks information, the collision is always stored so that the indices of the candidates stay valid
       for (const auto& track : tracksThisColl) {
+        if (storeTracksOnlyWithCand && nCandStored == 0) {
+          break;
+        }
         if (!track.isGlobalTrackWoDCA()) {
           continue;
         }
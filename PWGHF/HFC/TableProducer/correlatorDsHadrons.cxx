@@ -55,6 +55,7 @@
 
 #include <array>
 #include <cmath>
+#include <cstddef>
 #include <cstdint>
 #include <cstdlib>
 #include <unordered_map>
@@ -188,6 +189,7 @@ struct HfCorrelatorDsHadrons {
   Configurable<bool> selNoSameBunchPileUpColl{"selNoSameBunchPileUpColl", true, "Flag for rejecting the collisions associated with the same bunch crossing (used only in MC processes)"};
   Configurable<bool> pidTrkApplied{"pidTrkApplied", false, "Apply PID selection for associated tracks"};
   Configurable<bool> forceTOF{"forceTOF", false, "force the TOF signal for the PID"};
+  Configurable<bool> storeTracksOnlyWithCand{"storeTracksOnlyWithCand", false, "Store the associated tracks in the derived data only for the collisions with at least one stored candidate (the other collisions then do not contribute tracks to the mixed events)"};
   Configurable<int> selectionFlagDs{"selectionFlagDs", 7, "Selection Flag for Ds (avoid the case of flag = 0, no outputMlScore)"};
   Configurable<int> numberEventsMixed{"numberEventsMixed", 5, "Number of events mixed in ME process"};
   Configurable<int> decayChannel{"decayChannel", 1, "Resonant decay channels: 1 for Ds->PhiPi->KKpi, 2 for Ds->K0*K->KKPi"};
@@ -248,6 +250,7 @@ struct HfCorrelatorDsHadrons {
   ConfigurableAxis binsPosZ{"binsPosZ", {100, -10., 10.}, "primary vertex z coordinate"};
   ConfigurableAxis binsPoolBin{"binsPoolBin", {9, 0., 9.}, "PoolBin"};
 
+  HfAssocTrackPool assocTrackPool; // associated tracks of the collision, paired with all the Ds candidates
   HistogramRegistry registry{"registry", {}, OutputObjHandlingPolicy::AnalysisObject};
 
   void init(InitContext&)
@@ -451,6 +454,9 @@ struct HfCorrelatorDsHadrons {
     int const nTracks = tracks.size();
     registry.fill(HIST("hMultiplicity"), nTracks);
 
+    if (candidates.size() > 0) {
+      assocTrackPool.fill(tracks);
+    }
     // Ds fill histograms and Ds-Hadron correlation for DsToKKPi
     for (const auto& candidate : candidates) {
       if (std::abs(HfHelper::yDs(candidate)) > yCandMax || candidate.pt() < ptCandMin || candidate.pt() > ptCandMax) {
@@ -481,42 +487,41 @@ struct HfCorrelatorDsHadrons {
         registry.fill(HIST("hCountSelectionStatusDsToKKPiAndToPiKK"), 0.);
       }
 
-      // Ds-Hadron correlation dedicated section
-      for (const auto& track : tracks) {
+      // Ds-Hadron correlation dedicated section, the tracks passing isGlobalTrackWoDCA are in the pool
+      for (std::size_t iTrack = 0; iTrack < assocTrackPool.size(); ++iTrack) {
         // Removing Ds daughters by checking track indices
-        if ((candidate.prong0Id() == track.globalIndex()) || (candidate.prong1Id() == track.globalIndex()) || (candidate.prong2Id() == track.globalIndex())) {
-          continue;
-        }
-        if (!track.isGlobalTrackWoDCA()) {
+        if (assocTrackPool.isProngOf3Prong(iTrack, candidate)) {
           continue;
         }
+        const float etaTrack = assocTrackPool.etas[iTrack];
+        const float phiTrack = assocTrackPool.phis[iTrack];
 
-        registry.fill(HIST("hEtaVsPtPartAssoc"), track.eta(), candidate.pt());
-        registry.fill(HIST("hPhiVsPtPartAssoc"), RecoDecay::constrainAngle(track.phi(), -PIHalf), candidate.pt());
+        registry.fill(HIST("hEtaVsPtPartAssoc"), etaTrack, candidate.pt());
+        registry.fill(HIST("hPhiVsPtPartAssoc"), RecoDecay::constrainAngle(phiTrack, -PIHalf), candidate.pt());
         if (candidate.isSelDsToKKPi() >= selectionFlagDs) {
-          entryDsHadronPair(getDeltaPhi(track.phi(), candidate.phi()),
-                            track.eta() - candidate.eta(),
+          entryDsHadronPair(getDeltaPhi(phiTrack, candidate.phi()),
+                            etaTrack - candidate.eta(),
                             candidate.pt() * chargeDs,
-                            track.pt() * track.sign(),
+                            assocTrackPool.pts[iTrack] * assocTrackPool.signs[iTrack],
                             poolBin,
                             collision.numContrib(),
                             collision.centFT0M());
           entryDsHadronRecoInfo(HfHelper::invMassDsToKKPi(candidate), false, false);
           // entryDsHadronGenInfo(false, false, 0);
           entryDsHadronMlInfo(outputMl[0], outputMl[2]);
-          entryTrackRecoInfo(track.dcaXY(), track.dcaZ(), track.tpcNClsCrossedRows());
+          entryTrackRecoInfo(assocTrackPool.dcaXYs[iTrack], assocTrackPool.dcaZs[iTrack], assocTrackPool.tpcNClsCrossedRows[iTrack]);
         } else if (candidate.isSelDsToPiKK() >= selectionFlagDs) {
-          entryDsHadronPair(getDeltaPhi(track.phi(), candidate.phi()),
-                            track.eta() - candidate.eta(),
+          entryDsHadronPair(getDeltaPhi(phiTrack, candidate.phi()),
+                            etaTrack - candidate.eta(),
                             candidate.pt() * chargeDs,
-                            track.pt() * track.sign(),
+                            assocTrackPool.pts[iTrack] * assocTrackPool.signs[iTrack],
                             poolBin,
                             collision.numContrib(),
                             collision.centFT0M());
           entryDsHadronRecoInfo(HfHelper::invMassDsToPiKK(candidate), false, false);
           // entryDsHadronGenInfo(false, false, 0);
           entryDsHadronMlInfo(outputMl[0], outputMl[2]);
-          entryTrackRecoInfo(track.dcaXY(), track.dcaZ(), track.tpcNClsCrossedRows());
+          entryTrackRecoInfo(assocTrackPool.dcaXYs[iTrack], assocTrackPool.dcaZs[iTrack], assocTrackPool.tpcNClsCrossedRows[iTrack]);
         }
       } // end track loop
     } // end candidate loop
@@ -847,6 +852,7 @@ struct HfCorrelatorDsHadrons {
       auto tracksThisColl = tracks.sliceBy(trackIndicesPerCollision, thisCollId);
 
       int indexHfcReducedCollision = collReduced.lastIndex() + 1;
+      int nCandStored = 0;
 
       // Ds fill histograms and Ds candidates information stored
       for (const auto& candidate : candsDsThisColl) {
@@ -860,17 +866,22 @@ struct HfCorrelatorDsHadrons {
           }
           candReduced(indexHfcReducedCollision, candidate.phi(), candidate.eta(), candidate.pt() * chargeDs, HfHelper::invMassDsToKKPi(candidate), candidate.prong0Id(), candidate.prong1Id(), candidate.prong2Id());
           candSelInfo(indexHfcReducedCollision, outputMl[0], outputMl[2]);
+          nCandStored++;
         } else if (candidate.isSelDsToPiKK() >= selectionFlagDs) {
           for (unsigned int iclass = 0; iclass < classMl->size(); iclass++) {
             outputMl[iclass] = candidate.mlProbDsToPiKK()[classMl->at(iclass)];
           }
           candReduced(indexHfcReducedCollision, candidate.phi(), candidate.eta(), candidate.pt() * chargeDs, HfHelper::invMassDsToPiKK(candidate), candidate.prong0Id(), candidate.prong1Id(), candidate.prong2Id());
           candSelInfo(indexHfcReducedCollision, outputMl[0], outputMl[2]);
+          nCandStored++;
         }
       }
 
-      // tracks information
+      // tracks information, the collision is always stored so that the indices of the candidates stay valid
       for (const auto& track : tracksThisColl) {
+        if (storeTracksOnlyWithCand && nCandStored == 0) {
+          break;
+        }
         if (!track.isGlobalTrackWoDCA()) {
           continue;
         }
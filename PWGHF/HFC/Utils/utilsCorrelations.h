@@ -29,6 +29,8 @@
 
 #include <cmath>
 #include <cstddef>
+#include <cstdint>
+#include <vector>
 
 namespace o2::analysis::hf_correlations
 {
@@ -190,6 +192,61 @@ bool matchCandAndMass(McParticleType const& particle, double& massCand)
   }
 }
 
+// ========= Associated-track pool ==============
+/// Associated tracks of a collision passing isGlobalTrackWoDCA, with the columns used in the pairing copied once
+/// into arrays, so that the pairing with all the trigger candidates of the collision does not read the track table again
+struct HfAssocTrackPool {
+  std::vector<int64_t> globalIndices;
+  std::vector<float> pts;
+  std::vector<float> etas;
+  std::vector<float> phis;
+  std::vector<int8_t> signs;
+  std::vector<float> dcaXYs;
+  std::vector<float> dcaZs;
+  std::vector<int16_t> tpcNClsCrossedRows;
+
+  void clear()
+  {
+    globalIndices.clear();
+    pts.clear();
+    etas.clear();
+    phis.clear();
+    signs.clear();
+    dcaXYs.clear();
+    dcaZs.clear();
+    tpcNClsCrossedRows.clear();
+  }
+
+  std::size_t size() const { return globalIndices.size(); }
+
+  /// replaces the content with the tracks passing isGlobalTrackWoDCA, in the order of the table
+  template <typename TTracks>
+  void fill(TTracks const& tracks)
+  {
+    clear();
+    for (const auto& track : tracks) {
+      if (!track.isGlobalTrackWoDCA()) {
+        continue;
+      }
+      globalIndices.push_back(track.globalIndex());
+      pts.push_back(track.pt());
+      etas.push_back(track.eta());
+      phis.push_back(track.phi());
+      signs.push_back(track.sign());
+      dcaXYs.push_back(track.dcaXY());
+      dcaZs.push_back(track.dcaZ());
+      tpcNClsCrossedRows.push_back(track.tpcNClsCrossedRows());
+    }
+  }
+
+  /// whether the track i is one of the prongs of a 3-prong candidate
+  template <typename TCandidate>
+  bool isProngOf3Prong(std::size_t i, TCandidate const& candidate) const
+  {
+    return candidate.prong0Id() == globalIndices[i] || candidate.prong1Id() == globalIndices[i] || candidate.prong2Id() == globalIndices[i];
+  }
+};
+
 // ========= Find Leading Particle ==============
 template <typename TTracks, typename T1> //// FIXME: 14 days
 int findLeadingParticle(TTracks const& tracks, T1 const etaTrackMax)
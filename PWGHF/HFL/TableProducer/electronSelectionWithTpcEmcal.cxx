@@ -333,8 +333,9 @@ struct HfElectronSelectionWithTpcEmcal {
   }
   // nonHfe Identification
 
-  template <bool IsMc, typename ElectronType, typename TracksType, typename McParticleType>
-  void nonHfe(ElectronType const& electron, TracksType const& tracks, McParticleType const& mcparticles, float eop,
+  // assoTracks are the tracks of the collision passing the associated electron selection, see fillElectronTrack
+  template <bool IsMc, typename ElectronType, typename AssoTracksType, typename McParticleType>
+  void nonHfe(ElectronType const& electron, AssoTracksType const& assoTracks, McParticleType const& mcparticles, float eop,
               float m02, bool isEMcal)
   {
     int nElPairsLS = 0;
@@ -345,31 +346,27 @@ struct HfElectronSelectionWithTpcEmcal {
 
     std::vector<float> vecLSMass;
     std::vector<float> vecULSMass;
-    for (const auto& pTrack : tracks) {
-      if (pTrack.globalIndex() == electron.globalIndex()) {
-        continue;
-      }
-      // Apply partner electron selection
 
-      if (!selAssoTracks(pTrack)) {
+    int pdgE1 = kElectron;
+    if (electron.sign() > 0) {
+      pdgE1 = kPositron;
+    }
+    KFPTrack const kfpTrack = createKFPTrackFromTrack(electron);
+    KFParticle const kfTrack(kfpTrack, pdgE1);
+
+    for (const auto& pTrack : assoTracks) {
+      if (pTrack.globalIndex() == electron.globalIndex()) {
         continue;
       }
       if (electron.pt() <= pTrack.pt()) {
         continue;
       }
-      int pdgE1 = kElectron;
       int pdgE2 = kElectron;
-      if (electron.sign() > 0) {
-        pdgE1 = kPositron;
-      }
-
       if (pTrack.sign() > 0) {
         pdgE2 = kPositron;
       }
 
-      KFPTrack const kfpTrack = createKFPTrackFromTrack(electron);
       KFPTrack const kfpAssociatedTrack = createKFPTrackFromTrack(pTrack);
-      KFParticle const kfTrack(kfpTrack, pdgE1);
       KFParticle const kfAssociatedTrack(kfpAssociatedTrack, pdgE2);
       const KFParticle* electronPairs[2] = {&kfTrack, &kfAssociatedTrack};
       kfNonHfe.SetConstructMethod(2);
@@ -630,6 +627,14 @@ struct HfElectronSelectionWithTpcEmcal {
     float dcazTrack = -999;
     float tpcNsigmaTrack = -999;
 
+    // partners of the photonic electron pairs, selected once per collision instead of once per electron candidate
+    std::vector<typename TracksType::iterator> assoTracks;
+    for (const auto& assoTrack : tracks) {
+      if (selAssoTracks(assoTrack)) {
+        assoTracks.push_back(assoTrack);
+      }
+    }
+
     for (const auto& track : tracks) {
       phiTrack = track.phi();
       etaTrack = track.eta();
@@ -737,7 +742,7 @@ struct HfElectronSelectionWithTpcEmcal {
         }
         registry.fill(HIST("hphiElectronPassEmcal"), track.phi());
 
-        nonHfe<false>(matchTrack, tracks, mcparticles, eop, m02MatchEmcCluster, true);
+        nonHfe<false>(matchTrack, assoTracks, mcparticles, eop, m02MatchEmcCluster, true);
         /////////////////          NonHf electron Selection with Emcal       ////////////////////////
         if constexpr (IsMc) {
           if (matchTrack.has_mcParticle()) {
@@ -798,7 +803,7 @@ struct HfElectronSelectionWithTpcEmcal {
                   if (!(isEmbPi0 || isEmbEta)) {
                     continue;
                   }
-                  nonHfe<true>(matchTrack, tracks, mcparticles, eop, m02MatchEmcCluster, true);
+                  nonHfe<true>(matchTrack, assoTracks, mcparticles, eop, m02MatchEmcCluster, true);
                 }
               }
             }
@@ -882,13 +887,13 @@ struct HfElectronSelectionWithTpcEmcal {
                   continue;
                 }
 
-                nonHfe<true>(track, tracks, mcparticles, eop, m02MatchEmcCluster, false);
+                nonHfe<true>(track, assoTracks, mcparticles, eop, m02MatchEmcCluster, false);
               }
             }
           }
         }
       }
-      nonHfe<false>(track, tracks, mcparticles, eop, m02MatchEmcCluster, false);
+      nonHfe<false>(track, assoTracks, mcparticles, eop, m02MatchEmcCluster, false);
       /////////////////          NonHf electron Selection without Emcal       ////////////////////////
       electronSel(track.collisionId(), track.globalIndex(), etaTrack, phiTrack, ptTrack, pTrack, trackRapidity, dcaxyTrack, dcazTrack, track.tpcNSigmaEl(), track.tofNSigmaEl(),
                   eMatchEmcCluster, etaMatchEmcCluster, phiMatchEmcCluster, m02MatchEmcCluster, m20MatchEmcCluster, cellEmcCluster, timeEmcCluster, deltaEtaMatch, deltaPhiMatch, isEMcal);
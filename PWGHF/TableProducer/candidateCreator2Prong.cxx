@@ -93,6 +93,7 @@ using namespace o2::aod::pid_tpc_tof_utils;
 struct HfCandidateCreator2Prong {
   Produces<aod::HfCand2ProngBase> rowCandidateBase;
   Produces<aod::HfCand2ProngKF> rowCandidateKF;
+  Produces<aod::HfCand2ProngKinD0> rowCandidateKinD0;
   Produces<aod::HfCand2Prong0PidPi> rowProng0PidPi;
   Produces<aod::HfCand2Prong0PidKa> rowProng0PidKa;
   Produces<aod::HfCand2Prong1PidPi> rowProng1PidPi;
@@ -108,6 +109,7 @@ struct HfCandidateCreator2Prong {
   Configurable<double> minParamChange{"minParamChange", 1.e-3, "stop iterations if largest change of any X is smaller than this"};
   Configurable<double> minRelChi2Change{"minRelChi2Change", 0.9, "stop iterations is chi2/chi2old > this"};
   Configurable<bool> fillHistograms{"fillHistograms", true, "do validation plots"};
+  Configurable<bool> fillKinematicsD0{"fillKinematicsD0", false, "Fill the table with the D0 masses and rapidity, to be joined by the downstream tasks"};
   // magnetic field setting from CCDB
   Configurable<bool> isRun2{"isRun2", false, "enable Run 2 or Run 3 GRP objects for magnetic field"};
   Configurable<std::string> ccdbUrl{"ccdbUrl", "http://alice-ccdb.cern.ch", "url of the ccdb repository"};
@@ -120,6 +122,7 @@ struct HfCandidateCreator2Prong {
 
   int runNumber{0};
   double bz{0.};
+  KFPTrackCache kfpTracks; // KFPTracks of the daughters, shared by the candidates of the DF
 
   constexpr static float CentiToMicro{10000.f}; // from cm to µm
 
@@ -214,6 +217,15 @@ struct HfCandidateCreator2Prong {
     setLabelHistoCands(hCandidates);
   }
 
+  /// Fills the D0 kinematics table from the prong momenta stored in the candidate table
+  void fillCandidateKinematicsD0(std::array<float, 3> const& pVec0, std::array<float, 3> const& pVec1)
+  {
+    const auto arrayMomenta = std::array{pVec0, pVec1};
+    rowCandidateKinD0(RecoDecay::m(arrayMomenta, std::array{MassPiPlus, MassKPlus}),
+                      RecoDecay::m(arrayMomenta, std::array{MassKPlus, MassPiPlus}),
+                      RecoDecay::y(RecoDecay::pVec(pVec0, pVec1), MassD0));
+  }
+
   template <bool DoPvRefit, bool ApplyUpcSel, o2::hf_centrality::CentralityEstimator CentEstimator, typename Coll, typename CandType, typename TTracks, typename BCsType>
   void runCreator2ProngWithDCAFitterN(Coll const&,
                                       CandType const& rowsTrackIndexProng2,
@@ -348,6 +360,9 @@ struct HfCandidateCreator2Prong {
                        std::sqrt(impactParameter0.getSigmaZ2()), std::sqrt(impactParameter1.getSigmaZ2()),
                        rowTrackIndexProng2.prong0Id(), rowTrackIndexProng2.prong1Id(), nProngsContributorsPV, bitmapProngsContributorsPV,
                        rowTrackIndexProng2.hfflag());
+      if (fillKinematicsD0) {
+        fillCandidateKinematicsD0(pvec0, pvec1);
+      }
 
       // fill candidate prong PID rows
       fillProngPid<HfProngSpecies::Pion>(track0, rowProng0PidPi);
@@ -374,9 +389,10 @@ struct HfCandidateCreator2Prong {
   template <bool DoPvRefit, bool ApplyUpcSel, o2::hf_centrality::CentralityEstimator CentEstimator, typename Coll, typename CandType, typename TTracks, typename BCsType>
   void runCreator2ProngWithKFParticle(Coll const&,
                                       CandType const& rowsTrackIndexProng2,
-                                      TTracks const&,
+                                      TTracks const& tracks,
                                       BCsType const& bcs)
   {
+    kfpTracks.reset(tracks.size());
 
     for (const auto& rowTrackIndexProng2 : rowsTrackIndexProng2) {
 
@@ -429,8 +445,8 @@ struct HfCandidateCreator2Prong {
       registry.fill(HIST("hCovPVXZ"), covMatrixPV[3]);
       registry.fill(HIST("hCovPVZZ"), covMatrixPV[5]);
 
-      KFPTrack const kfpTrack0 = createKFPTrackFromTrack(track0);
-      KFPTrack const kfpTrack1 = createKFPTrackFromTrack(track1);
+      KFPTrack const kfpTrack0 = kfpTracks.get(track0);
+      KFPTrack const kfpTrack1 = kfpTracks.get(track1);
 
       KFParticle const kfPosPion(kfpTrack0, kPiPlus);
       KFParticle const kfNegPion(kfpTrack1, kPiPlus);
@@ -509,6 +525,10 @@ struct HfCandidateCreator2Prong {
                        0.f, 0.f,
                        rowTrackIndexProng2.prong0Id(), rowTrackIndexProng2.prong1Id(), nProngsContributorsPV, bitmapProngsContributorsPV,
                        rowTrackIndexProng2.hfflag());
+      if (fillKinematicsD0) {
+        fillCandidateKinematicsD0(std::array{kfPosPion.GetPx(), kfPosPion.GetPy(), kfPosPion.GetPz()},
+                                  std::array{kfNegKaon.GetPx(), kfNegKaon.GetPy(), kfNegKaon.GetPz()});
+      }
 
       // fill candidate prong PID rows
       fillProngPid<HfProngSpecies::Pion>(track0, rowProng0PidPi);
@@ -828,7 +848,8 @@ struct HfCandidateCreator2ProngExpressions {
   Configurable<bool> matchInteractionsWithMaterial{"matchInteractionsWithMaterial", false, "Match also candidates with tracks that interact with material"};
   Configurable<bool> matchCorrelatedBackground{"matchCorrelatedBackground", false, "Match correlated background candidates"};
 
-  HfEventSelectionMc hfEvSelMc; // mc event selection and monitoring
+  HfEventSelectionMc hfEvSelMc;   // mc event selection and monitoring
+  RecoDecayMcAncestry mcAncestry; // origin of the MC particles, shared by the reconstructed and generated matching
 
   using McCollisionsNoCents = soa::Join<aod::Collisions, aod::EvSels, aod::McCollisionLabels>;
   using McCollisionsFT0Cs = soa::Join<aod::Collisions, aod::EvSels, aod::McCollisionLabels, aod::CentFT0Cs>;
@@ -870,6 +891,7 @@ struct HfCandidateCreator2ProngExpressions {
                           BCsInfo const&)
   {
     rowCandidateProng2->bindExternalIndices(&tracks);
+    mcAncestry.reset(mcParticles.size());
 
     int indexRec = -1;
     int8_t sign = 0;
@@ -1008,7 +1030,7 @@ struct HfCandidateCreator2ProngExpressions {
       // Check whether the particle is non-prompt (from a b quark).
       if (flagChannelMain != 0) {
         auto particle = mcParticles.rawIteratorAt(indexRec);
-        origin = RecoDecay::getCharmHadronOrigin(mcParticles, particle, false, &idxBhadMothers);
+        origin = mcAncestry.getCharmHadronOrigin(mcParticles, particle, &idxBhadMothers);
       }
       if (origin == RecoDecay::OriginType::NonPrompt) {
         auto bHadMother = mcParticles.rawIteratorAt(idxBhadMothers[0]);
@@ -1045,7 +1067,7 @@ struct HfCandidateCreator2ProngExpressions {
         }
         continue;
       }
-      hf_mc_gen::fillMcMatchGen2Prong(mcParticles, mcParticlesPerMcColl, rowMcMatchGen, rejectBackground, matchCorrelatedBackground);
+      hf_mc_gen::fillMcMatchGen2Prong(mcParticles, mcParticlesPerMcColl, rowMcMatchGen, rejectBackground, matchCorrelatedBackground, &mcAncestry);
     }
   }
 
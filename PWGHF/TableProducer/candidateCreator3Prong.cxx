@@ -151,6 +151,7 @@ struct HfCandidateCreator3Prong {
 
   int runNumber{0};
   double bz{0.};
+  KFPTrackCache kfpTracks; // KFPTracks of the daughters, shared by the candidates of the DF
 
   constexpr static float CentiToMicro{10000.f}; // from cm to µm
   constexpr static float UndefValueFloat{-999.f};
@@ -468,9 +469,10 @@ struct HfCandidateCreator3Prong {
   template <bool DoPvRefit, bool ApplyUpcSel, o2::hf_centrality::CentralityEstimator CentEstimator, typename Coll, typename Cand, typename BCsType>
   void runCreator3ProngWithKFParticle(Coll const&,
                                       Cand const& rowsTrackIndexProng3,
-                                      TracksWCovExtraPidPiKaPrLightNuclei const&,
+                                      TracksWCovExtraPidPiKaPrLightNuclei const& tracks,
                                       BCsType const& bcs)
   {
+    kfpTracks.reset(tracks.size());
     for (const auto& rowTrackIndexProng3 : rowsTrackIndexProng3) {
       /// reject candidates in collisions not satisfying the event selections
       auto collision = rowTrackIndexProng3.template collision_as<Coll>();
@@ -522,9 +524,9 @@ struct HfCandidateCreator3Prong {
       registry.fill(HIST("hCovPVXZ"), covMatrixPV[3]);
       registry.fill(HIST("hCovPVZZ"), covMatrixPV[5]);
 
-      KFPTrack const kfpTrack0 = createKFPTrackFromTrack(track0);
-      KFPTrack const kfpTrack1 = createKFPTrackFromTrack(track1);
-      KFPTrack const kfpTrack2 = createKFPTrackFromTrack(track2);
+      KFPTrack const kfpTrack0 = kfpTracks.get(track0);
+      KFPTrack const kfpTrack1 = kfpTracks.get(track1);
+      KFPTrack const kfpTrack2 = kfpTracks.get(track2);
 
       KFParticle const kfFirstProton(kfpTrack0, kProton);
       KFParticle const kfFirstPion(kfpTrack0, kPiPlus);
@@ -1011,7 +1013,8 @@ struct HfCandidateCreator3ProngExpressions {
 
   constexpr static std::size_t NDaughtersResonant{2u};
 
-  HfEventSelectionMc hfEvSelMc; // mc event selection and monitoring
+  HfEventSelectionMc hfEvSelMc;   // mc event selection and monitoring
+  RecoDecayMcAncestry mcAncestry; // origin of the MC particles, shared by the reconstructed and generated matching
 
   using BCsInfo = soa::Join<aod::BCs, aod::Timestamps, aod::BcSels>;
   using McCollisionsNoCents = soa::Join<aod::Collisions, aod::EvSels, aod::McCollisionLabels>;
@@ -1053,6 +1056,7 @@ struct HfCandidateCreator3ProngExpressions {
                           BCsInfo const&)
   {
     rowCandidateProng3->bindExternalIndices(&tracks);
+    mcAncestry.reset(mcParticles.size());
 
     int indexRec = -1;
     int8_t sign = 0;
@@ -1352,7 +1356,7 @@ struct HfCandidateCreator3ProngExpressions {
       // Check whether the particle is non-prompt (from a b quark).
       if (flagChannelMain != 0) {
         auto particle = mcParticles.rawIteratorAt(indexRec);
-        origin = static_cast<int8_t>(RecoDecay::getCharmHadronOrigin(mcParticles, particle, false, &idxBhadMothers));
+        origin = static_cast<int8_t>(mcAncestry.getCharmHadronOrigin(mcParticles, particle, &idxBhadMothers));
       }
       if (origin == RecoDecay::OriginType::NonPrompt) {
         auto bHadMother = mcParticles.rawIteratorAt(idxBhadMothers[0]);
@@ -1389,7 +1393,7 @@ struct HfCandidateCreator3ProngExpressions {
         }
         continue;
       }
-      hf_mc_gen::fillMcMatchGen3Prong(mcParticles, mcParticlesPerMcColl, rowMcMatchGen, rejectBackground, matchCorrelatedBackground ? pdgMothersCorrelBkg : std::vector<int>{});
+      hf_mc_gen::fillMcMatchGen3Prong(mcParticles, mcParticlesPerMcColl, rowMcMatchGen, rejectBackground, matchCorrelatedBackground ? pdgMothersCorrelBkg : std::vector<int>{}, &mcAncestry);
     }
   }
 
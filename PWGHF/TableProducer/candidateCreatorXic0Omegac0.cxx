@@ -28,6 +28,7 @@
 #include "PWGHF/DataModel/TrackIndexSkimmingTables.h"
 #include "PWGHF/Utils/utilsBfieldCCDB.h"
 #include "PWGHF/Utils/utilsEvSelHf.h"
+#include "PWGHF/Utils/utilsTrkCandHf.h"
 //
 #include "PWGLF/DataModel/LFStrangenessTables.h"
 #include "PWGLF/DataModel/mcCentrality.h"
@@ -77,6 +78,7 @@
 #include <numeric>
 #include <stdexcept>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 using namespace o2;
@@ -90,6 +92,7 @@ using namespace o2::constants::physics;
 using namespace o2::framework;
 using namespace o2::framework::expressions;
 using namespace o2::hf_evsel;
+using namespace o2::hf_trkcandsel;
 
 enum McMatchFlag : uint8_t {
   None = 0,
@@ -173,6 +176,7 @@ struct HfCandidateCreatorXic0Omegac0 {
   o2::base::Propagator::MatCorrType matCorr = o2::base::Propagator::MatCorrType::USEMatCorrLUT;
   int runNumber{-1};
   double magneticField{0.};
+  ImpactParameterCache impactParameterCache; // impact parameters of the daughter tracks, shared by the candidates of a collision
 
   using MyCascTable = soa::Join<aod::CascDatas, aod::CascCovs>;
   using MyTraCascTable = soa::Join<aod::TraCascDatas, aod::TraCascCovs>; // to use strangeness tracking
@@ -284,6 +288,26 @@ struct HfCandidateCreatorXic0Omegac0 {
     float etaXic;
   } kfXic0Candidate{};
 
+  // V0 and cascade of a LF cascade built with KF, shared by all the charm-baryon candidates with the same cascade
+  struct KfCascadeState {
+    bool isSelected{false};
+    KFParticle kfPos;
+    KFParticle kfNeg;
+    KFParticle kfBach;
+    KFParticle kfV0;
+    KFParticle kfV0MassConstrained;
+    KFParticle kfCasc;
+    KFParticle kfCascMassConstrained;
+    float massV0{};
+    float sigMassV0{};
+    float massCasc{};
+    float sigMassCasc{};
+    float massCascRej{}; // rej
+    float chi2GeoV0{};
+    float chi2GeoCasc{};
+  };
+  std::unordered_map<int64_t, KfCascadeState> kfCascadeStates; // per cascade index, cleared for each dataframe and run
+
   void init(InitContext const&)
   {
     std::array<bool, 16> allProcesses = {doprocessNoCentToXiPi, doprocessNoCentToXiPiTraCasc, doprocessCentFT0CToXiPi, doprocessCentFT0MToXiPi, doprocessNoCentToOmegaPi, doprocessNoCentOmegacToOmegaPiWithKFParticle, doprocessCentFT0COmegacToOmegaPiWithKFParticle, doprocessCentFT0MOmegacToOmegaPiWithKFParticle, doprocessCentFT0CToOmegaPi, doprocessCentFT0MToOmegaPi, doprocessNoCentToOmegaK, doprocessCentFT0CToOmegaK, doprocessCentFT0MToOmegaK, doprocessNoCentXicToXiPiWithKFParticle, doprocessCentFT0CXicToXiPiWithKFParticle, doprocessCentFT0MXicToXiPiWithKFParticle};
@@ -427,6 +451,9 @@ struct HfCandidateCreatorXic0Omegac0 {
       LOGP(fatal, "Decay channel not recognized!");
     }
 
+    // track and collision indices are only valid within the data frame
+    impactParameterCache.clear();
+
     for (const auto& cand : candidates) {
 
       hCandidateCounter->Fill(0);
@@ -584,15 +611,17 @@ struct HfCandidateCreatorXic0Omegac0 {
       std::array<float, 3> pvCoord = {collision.posX(), collision.posY(), collision.posZ()};
 
       // DCAxy and DCAz (computed with propagateToDCABxByBz method)
-      o2::dataformats::DCA impactParameterV0Dau0;
-      o2::dataformats::DCA impactParameterV0Dau1;
-      o2::dataformats::DCA impactParameterCascDauCharged;
-      auto trackParVarV0Dau0 = getTrackParCov(trackV0Dau0);
-      auto trackParVarV0Dau1 = getTrackParCov(trackV0Dau1);
-      auto trackParVarCascDauCharged = getTrackParCov(trackCascDauCharged);
-      o2::base::Propagator::Instance()->propagateToDCABxByBz(primaryVertex, trackParVarV0Dau0, 2.f, matCorr, &impactParameterV0Dau0);
-      o2::base::Propagator::Instance()->propagateToDCABxByBz(primaryVertex, trackParVarV0Dau1, 2.f, matCorr, &impactParameterV0Dau1);
-      o2::base::Propagator::Instance()->propagateToDCABxByBz(primaryVertex, trackParVarCascDauCharged, 2.f, matCorr, &impactParameterCascDauCharged);
+      // the daughter tracks are shared by many candidates of the collision, so they are propagated only once
+      const auto indexCollision = collision.globalIndex();
+      auto getImpactParameter = [&](const auto& track) -> const o2::dataformats::DCA& {
+        return impactParameterCache.get(track.globalIndex(), indexCollision, [&](o2::dataformats::DCA& impactParameter) {
+          auto trackParVar = getTrackParCov(track);
+          o2::base::Propagator::Instance()->propagateToDCABxByBz(primaryVertex, trackParVar, 2.f, matCorr, &impactParameter);
+        });
+      };
+      const auto impactParameterV0Dau0 = getImpactParameter(trackV0Dau0);
+      const auto impactParameterV0Dau1 = getImpactParameter(trackV0Dau1);
+      const auto impactParameterCascDauCharged = getImpactParameter(trackCascDauCharged);
       float const dcaxyV0Dau0 = impactParameterV0Dau0.getY();
       float const dcaxyV0Dau1 = impactParameterV0Dau1.getY();
       float const dcaxyCascBachelor = impactParameterCascDauCharged.getY();
@@ -602,9 +631,8 @@ struct HfCandidateCreatorXic0Omegac0 {
 
       // impact parameters
       o2::dataformats::DCA impactParameterCasc;
-      o2::dataformats::DCA impactParameterCharmBachelor;
       o2::base::Propagator::Instance()->propagateToDCABxByBz(primaryVertex, trackCasc, 2.f, matCorr, &impactParameterCasc);
-      o2::base::Propagator::Instance()->propagateToDCABxByBz(primaryVertex, trackParVarCharmBachelor, 2.f, matCorr, &impactParameterCharmBachelor);
+      const auto impactParameterCharmBachelor = getImpactParameter(trackCharmBachelor);
       float const impactParBachFromCharmBaryonXY = impactParameterCharmBachelor.getY();
       float const impactParBachFromCharmBaryonZ = impactParameterCharmBachelor.getZ();
 
@@ -763,6 +791,201 @@ struct HfCandidateCreatorXic0Omegac0 {
     } // loop over LF Cascade-bachelor candidates
   } // end of run function
 
+  /// builds the V0 and the Omega of a cascade with KF, with the selections of the Omegac0 -> Omega pi KF creator
+  template <typename TTrack>
+  KfCascadeState buildKfOmegaState(TTrack const& trackV0Dau0, TTrack const& trackV0Dau1, TTrack const& trackCascDauCharged)
+  {
+    KfCascadeState state;
+    const int bachCharge = trackCascDauCharged.signed1Pt() > 0 ? +1 : -1;
+    KFPTrack const kfTrack0 = createKFPTrackFromTrack(trackV0Dau0);
+    KFPTrack const kfTrack1 = createKFPTrackFromTrack(trackV0Dau1);
+    KFPTrack const kfTrackBach = createKFPTrackFromTrack(trackCascDauCharged);
+    KFParticle kfBachPionRej; // rej
+    if (bachCharge < 0) {
+      state.kfPos = KFParticle(kfTrack0, kProton);
+      state.kfNeg = KFParticle(kfTrack1, kPiMinus);
+      state.kfBach = KFParticle(kfTrackBach, kKMinus);
+      kfBachPionRej = KFParticle(kfTrackBach, kPiMinus); // rej
+    } else {
+      state.kfPos = KFParticle(kfTrack0, kPiPlus);
+      state.kfNeg = KFParticle(kfTrack1, kProtonBar);
+      state.kfBach = KFParticle(kfTrackBach, kKPlus);
+      kfBachPionRej = KFParticle(kfTrackBach, kPiPlus); // rej
+    }
+
+    //__________________________________________
+    //*>~<* step 1 : construct V0 with KF
+    const KFParticle* v0Daughters[2] = {&state.kfPos, &state.kfNeg};
+    // construct V0
+    KFParticle& kfV0 = state.kfV0;
+    kfV0.SetConstructMethod(kfConstructMethod);
+    try {
+      kfV0.Construct(v0Daughters, 2);
+    } catch (std::runtime_error& e) {
+      LOG(debug) << "Failed to construct cascade V0 from daughter tracks: " << e.what();
+      return state;
+    }
+
+    // mass window cut on lambda before mass constraint
+    kfV0.GetMass(state.massV0, state.sigMassV0);
+    if (std::abs(state.massV0 - MassLambda0) > lambdaMassWindow) {
+      return state;
+    }
+    // err_mass>0 of Lambda
+    if (state.sigMassV0 <= 0) {
+      return state;
+    }
+    state.chi2GeoV0 = kfV0.GetChi2();
+    state.kfV0MassConstrained = kfV0;
+    state.kfV0MassConstrained.SetNonlinearMassConstraint(o2::constants::physics::MassLambda); // set mass constrain to Lambda
+    if (kfUseV0MassConstraint) {
+      KFParticle const kfV0 = state.kfV0MassConstrained;
+    }
+    kfV0.TransportToDecayVertex();
+
+    //__________________________________________
+    //*>~<* step 2 : reconstruct cascade(Omega) with KF
+    const KFParticle* omegaDaugthers[2] = {&state.kfBach, &kfV0};
+    const KFParticle* omegaDaugthersRej[2] = {&kfBachPionRej, &kfV0}; // rej
+    // construct cascade
+    KFParticle& kfOmega = state.kfCasc;
+    KFParticle kfOmegarej; // rej
+    kfOmega.SetPDG(bachCharge < 0 ? kOmegaMinus : kOmegaPlusBar);
+    kfOmegarej.SetPDG(bachCharge < 0 ? kOmegaMinus : kOmegaPlusBar);
+    kfOmega.SetConstructMethod(kfConstructMethod);
+    kfOmegarej.SetConstructMethod(kfConstructMethod); // rej
+    try {
+      kfOmega.Construct(omegaDaugthers, 2);
+      kfOmegarej.Construct(omegaDaugthersRej, 2); // rej
+    } catch (std::runtime_error& e) {
+      LOG(debug) << "Failed to construct Omega or Omega_rej from V0 and bachelor track: " << e.what();
+      return state;
+    }
+    float sigCascrej{};
+    kfOmega.GetMass(state.massCasc, state.sigMassCasc);
+    kfOmegarej.GetMass(state.massCascRej, sigCascrej); // rej
+    // err_massOmega > 0
+    if (state.sigMassCasc <= 0) {
+      return state;
+    }
+    if (std::abs(state.massCasc - MassOmegaMinus) > massToleranceCascade) {
+      return state;
+    }
+
+    state.chi2GeoCasc = kfOmega.GetChi2();
+    state.kfCascMassConstrained = kfOmega;
+    state.kfCascMassConstrained.SetNonlinearMassConstraint(o2::constants::physics::MassOmegaMinus); // set mass constrain to OmegaMinus
+    if (kfUseCascadeMassConstraint) {
+      // set mass constraint if requested
+      KFParticle const kfOmega = state.kfCascMassConstrained;
+    }
+    kfOmega.TransportToDecayVertex();
+    state.isSelected = true;
+    return state;
+  }
+
+  /// builds the V0 and the Xi of a cascade with KF, with the selections of the Xic0 -> Xi pi KF creator
+  template <typename TTrack>
+  KfCascadeState buildKfXiState(TTrack const& trackV0Dau0, TTrack const& trackV0Dau1, TTrack const& trackCascDauCharged)
+  {
+    KfCascadeState state;
+    const int bachCharge = trackCascDauCharged.signed1Pt() > 0 ? +1 : -1;
+    KFPTrack const kfTrack0 = createKFPTrackFromTrack(trackV0Dau0);
+    KFPTrack const kfTrack1 = createKFPTrackFromTrack(trackV0Dau1);
+    KFPTrack const kfTrackBach = createKFPTrackFromTrack(trackCascDauCharged);
+    if (bachCharge < 0) {
+      state.kfPos = KFParticle(kfTrack0, kProton);
+      state.kfNeg = KFParticle(kfTrack1, kPiMinus);
+      state.kfBach = KFParticle(kfTrackBach, kPiMinus);
+    } else {
+      state.kfPos = KFParticle(kfTrack0, kPiPlus);
+      state.kfNeg = KFParticle(kfTrack1, kProtonBar);
+      state.kfBach = KFParticle(kfTrackBach, kPiPlus);
+    }
+
+    //__________________________________________
+    //*>~<* step 1 : construct V0 with KF
+    const KFParticle* v0Daughters[2] = {&state.kfPos, &state.kfNeg};
+    // construct V0
+    KFParticle& kfV0 = state.kfV0;
+    kfV0.SetConstructMethod(kfConstructMethod);
+    try {
+      kfV0.Construct(v0Daughters, 2);
+    } catch (std::runtime_error& e) {
+      LOG(debug) << "Failed to construct cascade V0 from daughter tracks: " << e.what();
+      return state;
+    }
+
+    // mass window cut on lambda before mass constraint
+    kfV0.GetMass(state.massV0, state.sigMassV0);
+    if (std::abs(state.massV0 - MassLambda0) > lambdaMassWindow) {
+      return state;
+    }
+    // err_mass>0 of Lambda
+    if (state.sigMassV0 <= 0) {
+      return state;
+    }
+    // chi2>0 && NDF>0 for selecting Lambda
+    if ((kfV0.GetNDF() <= 0 || kfV0.GetChi2() <= 0)) {
+      return state;
+    }
+    state.chi2GeoV0 = kfV0.GetChi2();
+    state.kfV0MassConstrained = kfV0;
+    state.kfV0MassConstrained.SetNonlinearMassConstraint(o2::constants::physics::MassLambda); // set mass constrain to Lambda
+    if (kfUseV0MassConstraint) {
+      kfV0 = state.kfV0MassConstrained;
+    }
+    kfV0.TransportToDecayVertex();
+
+    //__________________________________________
+    //*>~<* step 2 : reconstruct cascade(Xi) with KF
+    const KFParticle* xiDaugthers[2] = {&state.kfBach, &kfV0};
+    // construct cascade
+    KFParticle& kfXi = state.kfCasc;
+    kfXi.SetPDG(bachCharge < 0 ? kXiMinus : kXiPlusBar);
+    kfXi.SetConstructMethod(kfConstructMethod);
+    try {
+      kfXi.Construct(xiDaugthers, 2);
+    } catch (std::runtime_error& e) {
+      LOG(debug) << "Failed to construct Xi from V0 and bachelor track: " << e.what();
+      return state;
+    }
+
+    kfXi.GetMass(state.massCasc, state.sigMassCasc);
+    // err_massXi > 0
+    if (state.sigMassCasc <= 0) {
+      return state;
+    }
+    if (std::abs(state.massCasc - MassXiMinus) > massToleranceCascade) {
+      return state;
+    }
+    // chi2>0 && NDF>0
+    if (kfXi.GetNDF() <= 0 || kfXi.GetChi2() <= 0) {
+      return state;
+    }
+    state.chi2GeoCasc = kfXi.GetChi2();
+    state.kfCascMassConstrained = kfXi;
+    state.kfCascMassConstrained.SetNonlinearMassConstraint(o2::constants::physics::MassXiMinus); // set mass constrain to XiMinus
+    if (kfUseCascadeMassConstraint) {
+      // set mass constraint if requested
+      KFParticle const kfXi = state.kfCascMassConstrained;
+    }
+    kfXi.TransportToDecayVertex();
+    state.isSelected = true;
+    return state;
+  }
+
+  /// KF state of the cascade of a candidate, built at the first candidate with this cascade
+  template <typename TCasc, typename TBuilder>
+  KfCascadeState const& getKfCascadeState(TCasc const& casc, TBuilder&& build)
+  {
+    auto itState = kfCascadeStates.find(casc.globalIndex());
+    if (itState == kfCascadeStates.end()) {
+      itState = kfCascadeStates.emplace(casc.globalIndex(), build()).first;
+    }
+    return itState->second;
+  }
+
   template <o2::hf_centrality::CentralityEstimator CentEstimator, int DecayChannel, typename Coll, typename Hist>
   void runKfOmegac0CreatorWithKFParticle(Coll const&,
                                          aod::BCsWithTimestamps const& /*bcWithTimeStamps*/,
@@ -775,6 +998,7 @@ struct HfCandidateCreatorXic0Omegac0 {
                                          Hist& hCandidateCounter,
                                          Hist& hCascadesCounter)
   {
+    kfCascadeStates.clear();
     for (const auto& cand : candidates) {
       hCandidateCounter->Fill(1);
 
@@ -794,6 +1018,7 @@ struct HfCandidateCreatorXic0Omegac0 {
         magneticField = o2::base::Propagator::Instance()->getNominalBz();
         LOG(info) << ">>>>>>>>>>>> Magnetic field: " << magneticField;
         runNumber = bc.runNumber();
+        kfCascadeStates.clear();
       }
       df.setBz(magneticField);
       KFParticle::SetField(magneticField);
@@ -822,108 +1047,27 @@ struct HfCandidateCreatorXic0Omegac0 {
       auto trackParCovV0Dau1 = getTrackParCov(trackV0Dau1);
       // kaon <- casc TrackParCov
       auto omegaDauChargedTrackParCov = getTrackParCov(trackCascDauCharged);
-      // convert tracks into KFParticle object
-      KFPTrack const kfTrack0 = createKFPTrackFromTrack(trackV0Dau0);
-      KFPTrack const kfTrack1 = createKFPTrackFromTrack(trackV0Dau1);
-      KFPTrack const kfTrackBach = createKFPTrackFromTrack(trackCascDauCharged);
-
-      KFParticle const kfPosPr(kfTrack0, kProton);
-      KFParticle const kfNegPi(kfTrack1, kPiMinus);
-      KFParticle const kfNegKa(kfTrackBach, kKMinus);
-      KFParticle const kfNegPiRej(kfTrackBach, kPiMinus); // rej
-      KFParticle const kfPosPi(kfTrack0, kPiPlus);
-      KFParticle const kfNegPr(kfTrack1, kProtonBar);
-      KFParticle const kfPosKa(kfTrackBach, kKPlus);
-      KFParticle const kfPosPiRej(kfTrackBach, kPiPlus); // rej
-
-      KFParticle kfBachKaon;
-      KFParticle kfPos;
-      KFParticle kfNeg;
-      KFParticle kfBachPionRej; // rej
-      if (bachCharge < 0) {
-        kfPos = kfPosPr;
-        kfNeg = kfNegPi;
-        kfBachKaon = kfNegKa;
-        kfBachPionRej = kfNegPiRej; // rej
-      } else {
-        kfPos = kfPosPi;
-        kfNeg = kfNegPr;
-        kfBachKaon = kfPosKa;
-        kfBachPionRej = kfPosPiRej; // rej
-      }
 
       //__________________________________________
-      //*>~<* step 1 : construct V0 with KF
-      const KFParticle* v0Daughters[2] = {&kfPos, &kfNeg};
-      // construct V0
-      KFParticle kfV0;
-      kfV0.SetConstructMethod(kfConstructMethod);
-      try {
-        kfV0.Construct(v0Daughters, 2);
-      } catch (std::runtime_error& e) {
-        LOG(debug) << "Failed to construct cascade V0 from daughter tracks: " << e.what();
-        continue;
-      }
-
-      // mass window cut on lambda before mass constraint
-      float massLam{}, sigLam{};
-      kfV0.GetMass(massLam, sigLam);
-      if (std::abs(massLam - MassLambda0) > lambdaMassWindow) {
-        continue;
-      }
-      // err_mass>0 of Lambda
-      if (sigLam <= 0) {
+      //*>~<* steps 1 and 2 : V0 and cascade(Omega) with KF, built once per cascade
+      auto const& cascState = getKfCascadeState(casc, [&]() { return buildKfOmegaState(trackV0Dau0, trackV0Dau1, trackCascDauCharged); });
+      if (!cascState.isSelected) {
         continue;
       }
-      kfOmegac0Candidate.chi2GeoV0 = kfV0.GetChi2();
-      KFParticle kfV0MassConstrained = kfV0;
-      kfV0MassConstrained.SetNonlinearMassConstraint(o2::constants::physics::MassLambda); // set mass constrain to Lambda
-      if (kfUseV0MassConstraint) {
-        KFParticle const kfV0 = kfV0MassConstrained;
-      }
-      kfV0.TransportToDecayVertex();
-
-      //__________________________________________
-      //*>~<* step 2 : reconstruct cascade(Omega) with KF
-      const KFParticle* omegaDaugthers[2] = {&kfBachKaon, &kfV0};
-      const KFParticle* omegaDaugthersRej[2] = {&kfBachPionRej, &kfV0}; // rej
-      // construct cascade
-      KFParticle kfOmega;
-      KFParticle kfOmegarej; // rej
-      kfOmega.SetPDG(bachCharge < 0 ? kOmegaMinus : kOmegaPlusBar);
-      kfOmegarej.SetPDG(bachCharge < 0 ? kOmegaMinus : kOmegaPlusBar);
-      kfOmega.SetConstructMethod(kfConstructMethod);
-      kfOmegarej.SetConstructMethod(kfConstructMethod); // rej
-      try {
-        kfOmega.Construct(omegaDaugthers, 2);
-        kfOmegarej.Construct(omegaDaugthersRej, 2); // rej
-      } catch (std::runtime_error& e) {
-        LOG(debug) << "Failed to construct Omega or Omega_rej from V0 and bachelor track: " << e.what();
-        continue;
-      }
-      float massCasc{}, sigCasc{};
-      float massCascrej{}, sigCascrej{};
-      kfOmega.GetMass(massCasc, sigCasc);
-      kfOmegarej.GetMass(massCascrej, sigCascrej); // rej
-      // err_massOmega > 0
-      if (sigCasc <= 0) {
-        continue;
-      }
-      if (std::abs(massCasc - MassOmegaMinus) > massToleranceCascade) {
-        continue;
-      }
-
-      kfOmegac0Candidate.chi2GeoCasc = kfOmega.GetChi2();
-      kfOmegac0Candidate.cascRejectInvmass = massCascrej;
-      registry.fill(HIST("hInvMassXiMinus_rej"), massCascrej); // rej
-      KFParticle kfOmegaMassConstrained = kfOmega;
-      kfOmegaMassConstrained.SetNonlinearMassConstraint(o2::constants::physics::MassOmegaMinus); // set mass constrain to OmegaMinus
-      if (kfUseCascadeMassConstraint) {
-        // set mass constraint if requested
-        KFParticle const kfOmega = kfOmegaMassConstrained;
-      }
+      KFParticle kfPos = cascState.kfPos;
+      KFParticle kfNeg = cascState.kfNeg;
+      KFParticle kfBachKaon = cascState.kfBach;
+      KFParticle kfV0 = cascState.kfV0;
+      KFParticle kfV0MassConstrained = cascState.kfV0MassConstrained;
+      KFParticle kfOmega = cascState.kfCasc;
+      KFParticle kfOmegaMassConstrained = cascState.kfCascMassConstrained;
+      const float massLam = cascState.massV0;
+      const float massCasc = cascState.massCasc;
+      kfOmegac0Candidate.chi2GeoV0 = cascState.chi2GeoV0;
+      kfOmegac0Candidate.chi2GeoCasc = cascState.chi2GeoCasc;
+      kfOmegac0Candidate.cascRejectInvmass = cascState.massCascRej;
+      registry.fill(HIST("hInvMassXiMinus_rej"), cascState.massCascRej); // rej
       registry.fill(HIST("hInvMassOmegaMinus"), massCasc);
-      kfOmega.TransportToDecayVertex();
       // rej: Add competing rejection to minimize misidentified Xi impact. Reject if kfBachPionRej is Pion and the constructed cascade has Xi's invariant mass.
 
       //__________________________________________
@@ -1267,6 +1411,7 @@ struct HfCandidateCreatorXic0Omegac0 {
                                       Hist& hCandidateCounter,
                                       Hist& hCascadesCounter)
   {
+    kfCascadeStates.clear();
     for (const auto& cand : candidates) {
       hCandidateCounter->Fill(1);
       if (!TESTBIT(cand.hfflag(), aod::hf_cand_casc_lf::DecayType2Prong::XiczeroOmegaczeroToXiPi)) {
@@ -1289,6 +1434,7 @@ struct HfCandidateCreatorXic0Omegac0 {
         magneticField = o2::base::Propagator::Instance()->getNominalBz();
         LOG(info) << ">>>>>>>>>>>> Magnetic field: " << magneticField;
         runNumber = bc.runNumber();
+        kfCascadeStates.clear();
       }
       df.setBz(magneticField);
       KFParticle::SetField(magneticField);
@@ -1318,105 +1464,26 @@ struct HfCandidateCreatorXic0Omegac0 {
       // pion <- casc TrackParCov
       auto xiDauChargedTrackParCov = getTrackParCov(trackCascDauCharged);
 
-      // convert tracks into KFParticle object
-      KFPTrack const kfTrack0 = createKFPTrackFromTrack(trackV0Dau0);
-      KFPTrack const kfTrack1 = createKFPTrackFromTrack(trackV0Dau1);
-      KFPTrack const kfTrackBach = createKFPTrackFromTrack(trackCascDauCharged);
-
-      KFParticle const kfPosPr(kfTrack0, kProton);
-      KFParticle const kfNegPi(kfTrack1, kPiMinus);
-      KFParticle const kfNegBachPi(kfTrackBach, kPiMinus);
-      KFParticle const kfPosPi(kfTrack0, kPiPlus);
-      KFParticle const kfNegPr(kfTrack1, kProtonBar);
-      KFParticle const kfPosBachPi(kfTrackBach, kPiPlus);
-
-      KFParticle kfBachPion;
-      KFParticle kfPos;
-      KFParticle kfNeg;
-      if (bachCharge < 0) {
-        kfPos = kfPosPr;
-        kfNeg = kfNegPi;
-        kfBachPion = kfNegBachPi;
-      } else {
-        kfPos = kfPosPi;
-        kfNeg = kfNegPr;
-        kfBachPion = kfPosBachPi;
-      }
-
       //__________________________________________
-      //*>~<* step 1 : construct V0 with KF
-      const KFParticle* v0Daughters[2] = {&kfPos, &kfNeg};
-      // construct V0
-      KFParticle kfV0;
-      kfV0.SetConstructMethod(kfConstructMethod);
-      try {
-        kfV0.Construct(v0Daughters, 2);
-      } catch (std::runtime_error& e) {
-        LOG(debug) << "Failed to construct cascade V0 from daughter tracks: " << e.what();
+      //*>~<* steps 1 and 2 : V0 and cascade(Xi) with KF, built once per cascade
+      auto const& cascState = getKfCascadeState(casc, [&]() { return buildKfXiState(trackV0Dau0, trackV0Dau1, trackCascDauCharged); });
+      if (!cascState.isSelected) {
         continue;
       }
-
-      // mass window cut on lambda before mass constraint
-      float massLam, sigLam;
-      kfV0.GetMass(massLam, sigLam);
-      if (std::abs(massLam - MassLambda0) > lambdaMassWindow) {
-        continue;
-      }
-
-      // err_mass>0 of Lambda
-      if (sigLam <= 0) {
-        continue;
-      }
-      // chi2>0 && NDF>0 for selecting Lambda
-      if ((kfV0.GetNDF() <= 0 || kfV0.GetChi2() <= 0)) {
-        continue;
-      }
-
-      kfXic0Candidate.chi2GeoV0 = kfV0.GetChi2();
-      KFParticle kfV0MassConstrained = kfV0;
-      kfV0MassConstrained.SetNonlinearMassConstraint(o2::constants::physics::MassLambda); // set mass constrain to Lambda
-      if (kfUseV0MassConstraint) {
-        kfV0 = kfV0MassConstrained;
-      }
-      kfV0.TransportToDecayVertex();
-
-      //__________________________________________
-      //*>~<* step 2 : reconstruct cascade(Xi) with KF
-      const KFParticle* xiDaugthers[2] = {&kfBachPion, &kfV0};
-      // construct cascade
-      KFParticle kfXi;
-      kfXi.SetPDG(bachCharge < 0 ? kXiMinus : kXiPlusBar);
-      kfXi.SetConstructMethod(kfConstructMethod);
-      try {
-        kfXi.Construct(xiDaugthers, 2);
-      } catch (std::runtime_error& e) {
-        LOG(debug) << "Failed to construct Xi from V0 and bachelor track: " << e.what();
-        continue;
-      }
-
-      float massCasc, sigCasc;
-      kfXi.GetMass(massCasc, sigCasc);
-      // err_massXi > 0
-      if (sigCasc <= 0) {
-        continue;
-      }
-
-      if (std::abs(massCasc - MassXiMinus) > massToleranceCascade) {
-        continue;
-      }
-      // chi2>0 && NDF>0
-      if (kfXi.GetNDF() <= 0 || kfXi.GetChi2() <= 0) {
-        continue;
-      }
-      kfXic0Candidate.chi2GeoCasc = kfXi.GetChi2();
-      KFParticle kfXiMassConstrained = kfXi;
-      kfXiMassConstrained.SetNonlinearMassConstraint(o2::constants::physics::MassXiMinus); // set mass constrain to XiMinus
-      if (kfUseCascadeMassConstraint) {
-        // set mass constraint if requested
-        KFParticle const kfXi = kfXiMassConstrained;
-      }
+      KFParticle kfPos = cascState.kfPos;
+      KFParticle kfNeg = cascState.kfNeg;
+      KFParticle kfBachPion = cascState.kfBach;
+      KFParticle kfV0 = cascState.kfV0;
+      KFParticle kfV0MassConstrained = cascState.kfV0MassConstrained;
+      KFParticle kfXi = cascState.kfCasc;
+      KFParticle kfXiMassConstrained = cascState.kfCascMassConstrained;
+      const float massLam = cascState.massV0;
+      const float sigLam = cascState.sigMassV0;
+      const float massCasc = cascState.massCasc;
+      const float sigCasc = cascState.sigMassCasc;
+      kfXic0Candidate.chi2GeoV0 = cascState.chi2GeoV0;
+      kfXic0Candidate.chi2GeoCasc = cascState.chi2GeoCasc;
       registry.fill(HIST("hInvMassXiMinus"), massCasc);
-      kfXi.TransportToDecayVertex();
 
       //__________________________________________
       //*>~<* step 3 : reconstruc Xic0 with KF
@@ -102,6 +102,7 @@ struct HfCandidateSelectorB0ToDPi {
   o2::ccdb::CcdbApi ccdbApi;
 
   TrackSelectorPi selectorPion;
+  TrackSelectorPidStatusCache pidStatusPion;
 
   using TracksPion = soa::Join<aod::TracksWExtra, aod::TracksPidPi, aod::TrackSelection>;
 
@@ -162,8 +163,9 @@ struct HfCandidateSelectorB0ToDPi {
   template <bool WithDmesMl, typename Cands, typename CandsDmes>
   void runSelection(Cands const& hfCandsB0,
                     CandsDmes const& /*hfCandsD*/,
-                    TracksPion const& /*pionTracks*/)
+                    TracksPion const& pionTracks)
   {
+    pidStatusPion.reset(pionTracks.size());
 
     for (const auto& hfCandB0 : hfCandsB0) {
       int statusB0 = 0;
@@ -210,9 +212,9 @@ struct HfCandidateSelectorB0ToDPi {
       if (pionPidMethod == PidMethod::TpcOrTof || pionPidMethod == PidMethod::TpcAndTof) {
         int pidTrackPi{TrackSelectorPID::Status::NotApplicable};
         if (pionPidMethod == PidMethod::TpcOrTof) {
-          pidTrackPi = selectorPion.statusTpcOrTof(trackPi);
+          pidTrackPi = pidStatusPion.status(trackPi, [this](const auto& track) { return selectorPion.statusTpcOrTof(track); });
         } else if (pionPidMethod == PidMethod::TpcAndTof) {
-          pidTrackPi = selectorPion.statusTpcAndTof(trackPi);
+          pidTrackPi = pidStatusPion.status(trackPi, [this](const auto& track) { return selectorPion.statusTpcAndTof(track); });
         }
         if (!HfHelper::selectionB0ToDPiPid(pidTrackPi, acceptPIDNotApplicable.value)) {
           // LOGF(info, "B0 candidate selection failed at PID selection");
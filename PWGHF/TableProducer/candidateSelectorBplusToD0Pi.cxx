@@ -105,6 +105,7 @@ struct HfCandidateSelectorBplusToD0Pi {
   o2::ccdb::CcdbApi ccdbApi;
 
   TrackSelectorPi selectorPion;
+  TrackSelectorPidStatusCache pidStatusPion;
 
   using TracksPion = soa::Join<aod::TracksWExtra, aod::TracksPidPi, aod::TrackSelection>;
 
@@ -165,8 +166,9 @@ struct HfCandidateSelectorBplusToD0Pi {
   template <bool WithDmesMl, typename Cands, typename CandsDmes>
   void runSelection(Cands const& hfCandsBp,
                     CandsDmes const& /*hfCandsD0*/,
-                    TracksPion const& /*pionTracks*/)
+                    TracksPion const& pionTracks)
   {
+    pidStatusPion.reset(pionTracks.size());
 
     for (const auto& hfCandBp : hfCandsBp) {
       int statusBplus = 0;
@@ -217,9 +219,9 @@ struct HfCandidateSelectorBplusToD0Pi {
       if (pionPidMethod == PidMethod::TpcOrTof || pionPidMethod == PidMethod::TpcAndTof) {
         int pidTrackPi{TrackSelectorPID::Status::NotApplicable};
         if (pionPidMethod == PidMethod::TpcOrTof) {
-          pidTrackPi = selectorPion.statusTpcOrTof(trackPi);
+          pidTrackPi = pidStatusPion.status(trackPi, [this](const auto& track) { return selectorPion.statusTpcOrTof(track); });
         } else if (pionPidMethod == PidMethod::TpcAndTof) {
-          pidTrackPi = selectorPion.statusTpcAndTof(trackPi);
+          pidTrackPi = pidStatusPion.status(trackPi, [this](const auto& track) { return selectorPion.statusTpcAndTof(track); });
         }
         if (!HfHelper::selectionBplusToD0PiPid(pidTrackPi, acceptPIDNotApplicable.value)) {
           // LOGF(info, "B+ candidate selection failed at PID selection");
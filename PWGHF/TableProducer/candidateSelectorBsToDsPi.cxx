@@ -96,6 +96,7 @@ struct HfCandidateSelectorBsToDsPi {
   o2::ccdb::CcdbApi ccdbApi;
 
   TrackSelectorPi selectorPion;
+  TrackSelectorPidStatusCache pidStatusPion;
 
   using TracksPidWithSel = soa::Join<aod::TracksWExtra, aod::TracksPidPi, aod::TrackSelection>;
 
@@ -161,8 +162,9 @@ struct HfCandidateSelectorBsToDsPi {
   }
 
   void process(aod::HfCandBs const& hfCandsBs,
-               TracksPidWithSel const&)
+               TracksPidWithSel const& tracks)
   {
+    pidStatusPion.reset(tracks.size());
     for (const auto& hfCandBs : hfCandsBs) {
       int statusBsToDsPi = 0;
       outputMl.clear();
@@ -197,7 +199,7 @@ struct HfCandidateSelectorBsToDsPi {
       // track-level PID selection
       if (usePid) {
         auto trackPi = hfCandBs.prong1_as<TracksPidWithSel>();
-        int const pidTrackPi = selectorPion.statusTpcAndTof(trackPi);
+        int const pidTrackPi = pidStatusPion.status(trackPi, [this](const auto& track) { return selectorPion.statusTpcAndTof(track); });
         if (!HfHelper::selectionBsToDsPiPid(pidTrackPi, acceptPIDNotApplicable.value)) {
           hfSelBsToDsPiCandidate(statusBsToDsPi);
           if (applyMl) {
@@ -98,6 +98,7 @@ struct HfCandidateSelectorD0 {
   Configurable<std::vector<std::string>> onnxFileNames{"onnxFileNames", std::vector<std::string>{"ModelHandler_onnx_D0ToKPi.onnx"}, "ONNX file names for each pT bin (if not from CCDB full path)"};
   Configurable<int64_t> timestampCCDB{"timestampCCDB", -1, "timestamp of the ONNX file for ML model used to query in CCDB"};
   Configurable<bool> loadModelsFromCCDB{"loadModelsFromCCDB", false, "Flag to enable or disable the loading of models from CCDB"};
+  Configurable<bool> shareMlSessions{"shareMlSessions", false, "Flag to share the ONNX sessions with the other tasks of the process using the same models"};
   // Mass Cut for trigger analysis
   Configurable<bool> useTriggerMassCut{"useTriggerMassCut", false, "Flag to enable parametrize pT differential mass cut for triggered data"};
 
@@ -119,7 +120,7 @@ struct HfCandidateSelectorD0 {
 
   void init(InitContext&)
   {
-    std::array<bool, 2> doprocess{doprocessWithDCAFitterN, doprocessWithKFParticle};
+    std::array<bool, 3> doprocess{doprocessWithDCAFitterN, doprocessWithDCAFitterNAndKinematics, doprocessWithKFParticle};
     if ((std::accumulate(doprocess.begin(), doprocess.end(), 0)) != 1) {
       LOGP(fatal, "Only one process function can be enabled at a time.");
     }
@@ -148,7 +149,7 @@ struct HfCandidateSelectorD0 {
         hfMlResponse.setModelPathsLocal(onnxFileNames);
       }
       hfMlResponse.cacheInputFeaturesIndices(namesInputFeatures);
-      hfMlResponse.init();
+      hfMlResponse.init(false, 0, shareMlSessions);
     }
   }
 
@@ -500,6 +501,12 @@ struct HfCandidateSelectorD0 {
   }
   PROCESS_SWITCH(HfCandidateSelectorD0, processWithDCAFitterN, "process candidates selection with DCAFitterN", true);
 
+  void processWithDCAFitterNAndKinematics(soa::Join<aod::HfCand2ProngWPid, aod::HfCand2ProngKinD0> const& candidates, TracksSel const& tracks)
+  {
+    processSel<aod::hf_cand::VertexerType::DCAFitter>(candidates, tracks);
+  }
+  PROCESS_SWITCH(HfCandidateSelectorD0, processWithDCAFitterNAndKinematics, "process candidates selection with DCAFitterN, reading the D0 kinematics from the candidate creator (requires fillKinematicsD0)", false);
+
   void processWithKFParticle(soa::Join<aod::HfCand2ProngWPid, aod::HfCand2ProngKF> const& candidates, TracksSel const& tracks)
   {
     processSel<aod::hf_cand::VertexerType::KfParticle>(candidates, tracks);
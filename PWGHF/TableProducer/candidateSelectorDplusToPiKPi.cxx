@@ -42,6 +42,7 @@
 
 #include <Rtypes.h>
 
+#include <cstddef>
 #include <cstdint>
 #include <string>
 #include <vector>
@@ -98,6 +99,9 @@ struct HfCandidateSelectorDplusToPiKPi {
   HfMlResponseDplusToPiKPi<float> hfMlResponse;
   std::vector<float> outputMlNotPreselected;
   std::vector<float> outputMl;
+  std::vector<int> statusCandidates; // selection status of the candidates, written after the ML batch evaluation
+  std::vector<int> mlBatchIndices;   // index of the candidates in the ML batch (-1 if not evaluated)
+  std::vector<float> ptCandidates;   // pT of the candidates, for the QA of the ML selection
   o2::ccdb::CcdbApi ccdbApi;
   TrackSelectorPi selectorPion;
   TrackSelectorKa selectorKaon;
@@ -233,6 +237,18 @@ struct HfCandidateSelectorDplusToPiKPi {
   void process(aod::HfCand3ProngWPidPiKa const& candidates,
                TracksSel const&)
   {
+    // The table rows are written after the loop, so that the ML models are evaluated on all candidates at once
+    statusCandidates.clear();
+    mlBatchIndices.clear();
+    ptCandidates.clear();
+    if (applyMl) {
+      hfMlResponse.clearBatch();
+    }
+    auto storeCandidate = [&](int status, int mlBatchIndex = -1) {
+      statusCandidates.push_back(status);
+      mlBatchIndices.push_back(mlBatchIndex);
+    };
+
     // looping over 3-prong candidates
     for (const auto& candidate : candidates) {
 
@@ -240,12 +256,10 @@ struct HfCandidateSelectorDplusToPiKPi {
       auto statusDplusToPiKPi = 0;
 
       auto ptCand = candidate.pt();
+      ptCandidates.push_back(ptCand);
 
       if (!TESTBIT(candidate.hfflag(), aod::hf_cand_3prong::DecayType::DplusToPiKPi)) {
-        hfSelDplusToPiKPiCandidate(statusDplusToPiKPi);
-        if (applyMl) {
-          hfMlDplusToPiKPiCandidate(outputMlNotPreselected);
-        }
+        storeCandidate(statusDplusToPiKPi);
         if (activateQA) {
           registry.fill(HIST("hSelections"), 1, ptCand);
         }
@@ -262,10 +276,7 @@ struct HfCandidateSelectorDplusToPiKPi {
 
       // topological selection
       if (!selection(candidate, trackPos1, trackNeg, trackPos2)) {
-        hfSelDplusToPiKPiCandidate(statusDplusToPiKPi);
-        if (applyMl) {
-          hfMlDplusToPiKPiCandidate(outputMlNotPreselected);
-        }
+        storeCandidate(statusDplusToPiKPi);
         continue;
       }
       SETBIT(statusDplusToPiKPi, aod::SelectionStep::RecoTopol);
@@ -289,10 +300,7 @@ struct HfCandidateSelectorDplusToPiKPi {
       }
 
       if (!selectionPID(pidTrackPos1Pion, pidTrackNegKaon, pidTrackPos2Pion)) { // exclude D±
-        hfSelDplusToPiKPiCandidate(statusDplusToPiKPi);
-        if (applyMl) {
-          hfMlDplusToPiKPiCandidate(outputMlNotPreselected);
-        }
+        storeCandidate(statusDplusToPiKPi);
         continue;
       }
       SETBIT(statusDplusToPiKPi, aod::SelectionStep::RecoPID);
@@ -301,21 +309,34 @@ struct HfCandidateSelectorDplusToPiKPi {
       }
 
       if (applyMl) {
-        // ML selections
+        // ML selections, evaluated after the loop
         std::vector<float> inputFeatures = hfMlResponse.getInputFeatures(candidate);
-        bool const isSelectedMl = hfMlResponse.isSelectedMl(inputFeatures, ptCand, outputMl);
-        hfMlDplusToPiKPiCandidate(outputMl);
+        storeCandidate(statusDplusToPiKPi, hfMlResponse.addToBatch(inputFeatures, ptCand));
+        continue;
+      }
 
-        if (!isSelectedMl) {
-          hfSelDplusToPiKPiCandidate(statusDplusToPiKPi);
-          continue;
-        }
-        SETBIT(statusDplusToPiKPi, aod::SelectionStep::RecoMl);
-        if (activateQA) {
-          registry.fill(HIST("hSelections"), 2 + aod::SelectionStep::RecoMl, ptCand);
+      storeCandidate(statusDplusToPiKPi);
+    }
+
+    if (applyMl) {
+      hfMlResponse.evaluateBatch();
+    }
+    for (std::size_t iCand = 0; iCand < statusCandidates.size(); ++iCand) {
+      auto statusDplusToPiKPi = statusCandidates[iCand];
+      if (applyMl) {
+        if (mlBatchIndices[iCand] < 0) {
+          hfMlDplusToPiKPiCandidate(outputMlNotPreselected);
+        } else {
+          bool const isSelectedMl = hfMlResponse.isSelectedMlBatch(mlBatchIndices[iCand], outputMl);
+          hfMlDplusToPiKPiCandidate(outputMl);
+          if (isSelectedMl) {
+            SETBIT(statusDplusToPiKPi, aod::SelectionStep::RecoMl);
+            if (activateQA) {
+              registry.fill(HIST("hSelections"), 2 + aod::SelectionStep::RecoMl, ptCandidates[iCand]);
+            }
+          }
         }
       }
-
       hfSelDplusToPiKPiCandidate(statusDplusToPiKPi);
     }
   }
@@ -307,12 +307,7 @@ struct HfDerivedDataCreatorBplusToD0Pi {
       const auto sizeTableCandThisColl = candidatesThisColl.size();
       LOGF(debug, "Rec. collision %d has %d candidates", thisCollId, sizeTableCandThisColl);
       // Skip collisions without HF candidates (and without HF particles in matched MC collisions if saving indices of reconstructed collisions matched to MC collisions)
-      bool mcCollisionHasMcParticles{false};
-      if constexpr (IsMc) {
-        mcCollisionHasMcParticles = confDerData.fillMcRCollId && collision.has_mcCollision() && rowsCommon.hasMcParticles[collision.mcCollisionId()];
-        LOGF(debug, "Rec. collision %d has MC collision %d with MC particles? %s", thisCollId, collision.mcCollisionId(), mcCollisionHasMcParticles ? "yes" : "no");
-      }
-      if (sizeTableCandThisColl == 0 && (!confDerData.fillMcRCollId || !mcCollisionHasMcParticles)) {
+      if (!rowsCommon.keepCollision<IsMc>(collision, sizeTableCandThisColl)) {
         LOGF(debug, "Skipping rec. collision %d", thisCollId);
         continue;
       }
@@ -29,6 +29,7 @@
 #include "PWGHF/Utils/utilsAnalysis.h"
 #include "PWGHF/Utils/utilsBfieldCCDB.h"
 #include "PWGHF/Utils/utilsEvSelHf.h"
+#include "PWGHF/Utils/utilsSecondaryVertexing.h"
 #include "PWGLF/DataModel/LFStrangenessTables.h"
 
 #include "Common/CCDB/TriggerAliases.h"
@@ -1405,6 +1406,8 @@ struct HfTrackIndexSkimCreator {
     // preselection of 3-prongs using the decay length computed only with the first two tracks
     Configurable<double> minTwoTrackDecayLengthFor3Prongs{"minTwoTrackDecayLengthFor3Prongs", 0., "Minimum decay length computed with 2 tracks for 3-prongs to speedup combinatorial"};
     Configurable<double> maxTwoTrackChi2PcaFor3Prongs{"maxTwoTrackChi2PcaFor3Prongs", 1.e10, "Maximum chi2 pca computed with 2 tracks for 3-prongs to speedup combinatorial"};
+    // preselection of prong pairs before the vertex reconstruction
+    Configurable<double> maxProngDeltaDcaZ{"maxProngDeltaDcaZ", -1., "Maximum difference between the dcaZ of two prongs to speedup combinatorial (negative: no cut)"};
     // vertexing
     // Configurable<double> bz{"bz", 5., "magnetic field kG"};
     Configurable<bool> propagateToPCA{"propagateToPCA", true, "create tracks version propagated to PCA"};
@@ -1490,6 +1493,15 @@ struct HfTrackIndexSkimCreator {
   o2::base::Propagator::MatCorrType noMatCorr = o2::base::Propagator::MatCorrType::USEMatCorrNONE;
   int runNumber{};
 
+  // prong tracks of the current collision, propagated once to its primary vertex and indexed by their position in the collision slice
+  struct ProngTracks {
+    std::vector<o2::track::TrackParCov> trackParVar;
+    std::vector<std::array<float, 3>> pVec;
+    std::vector<std::array<float, 2>> dcaInfo;
+  };
+  ProngTracks prongTracksPos{};
+  ProngTracks prongTracksNeg{};
+
   // int nColls{0}; //can be added to run over limited collisions per file - for tesing purposes
 
   static constexpr int kN2ProngDecays = hf_cand_2prong::DecayType::N2ProngDecays;                                                                                                                                                                                                                                                                   // number of 2-prong hadron types
@@ -1584,21 +1596,8 @@ struct HfTrackIndexSkimCreator {
     cut3Prong = {config.cutsDplusToPiKPi, config.cutsLcToPKPi, config.cutsDsToKKPi, config.cutsXicToPKPi, config.cutsCdToDeKPi, config.cutsCtToTrKPi, config.cutsChToHeKPi, config.cutsCaToAlKPi};
     binsPt3Prong = {config.binsPtDplusToPiKPi, config.binsPtLcToPKPi, config.binsPtDsToKKPi, config.binsPtXicToPKPi, config.binsPtCdToDeKPi, config.binsPtCtToTrKPi, config.binsPtChToHeKPi, config.binsPtCaToAlKPi};
 
-    df2.setPropagateToPCA(config.propagateToPCA);
-    df2.setMaxR(config.maxR);
-    df2.setMaxDZIni(config.maxDZIni);
-    df2.setMinParamChange(config.minParamChange);
-    df2.setMinRelChi2Change(config.minRelChi2Change);
-    df2.setUseAbsDCA(config.useAbsDCA);
-    df2.setWeightedFinalPCA(config.useWeightedFinalPCA);
-
-    df3.setPropagateToPCA(config.propagateToPCA);
-    df3.setMaxR(config.maxR);
-    df3.setMaxDZIni(config.maxDZIni);
-    df3.setMinParamChange(config.minParamChange);
-    df3.setMinRelChi2Change(config.minRelChi2Change);
-    df3.setUseAbsDCA(config.useAbsDCA);
-    df3.setWeightedFinalPCA(config.useWeightedFinalPCA);
+    o2::hf_vertexing::configureFitter(df2, config.propagateToPCA, config.maxR, config.maxDZIni, config.minParamChange, config.minRelChi2Change, config.useAbsDCA, config.useWeightedFinalPCA);
+    o2::hf_vertexing::configureFitter(df3, config.propagateToPCA, config.maxR, config.maxDZIni, config.minParamChange, config.minRelChi2Change, config.useAbsDCA, config.useWeightedFinalPCA);
 
     ccdb->setURL(config.ccdbUrl);
     ccdb->setCaching(true);
@@ -2308,6 +2307,38 @@ struct HfTrackIndexSkimCreator {
 
   } /// end of performPvRefitCandProngs function
 
+  /// Fills the track parameters, momenta and impact parameters of the prong tracks of a collision,
+  /// propagating to its primary vertex the tracks reassociated to it
+  /// \param trackIndices are the track indices of the collision
+  /// \param collision is the collision
+  /// \param prongTracks is the output
+  template <typename TTracks, typename TTrackIndices, typename TCollision>
+  void fillProngTracks(TTrackIndices const& trackIndices, TCollision const& collision, ProngTracks& prongTracks)
+  {
+    prongTracks.trackParVar.clear();
+    prongTracks.pVec.clear();
+    prongTracks.dcaInfo.clear();
+    for (const auto& trackIndex : trackIndices) {
+      const auto track = trackIndex.template track_as<TTracks>();
+      auto& trackParVar = prongTracks.trackParVar.emplace_back(getTrackParCov(track));
+      auto& pVec = prongTracks.pVec.emplace_back(track.pVector());
+      auto& dcaInfo = prongTracks.dcaInfo.emplace_back(std::array{track.dcaXY(), track.dcaZ()});
+      if (collision.globalIndex() != track.collisionId()) { // this is not the "default" collision for this track, we have to re-propagate it
+        o2::base::Propagator::Instance()->propagateToDCABxByBz({collision.posX(), collision.posY(), collision.posZ()}, trackParVar, 2.f, noMatCorr, &dcaInfo);
+        getPxPyPz(trackParVar, pVec);
+      }
+    }
+  }
+
+  /// Cheap compatibility check of two prongs, applied before the vertex reconstruction
+  /// \param dcaInfo0 is the impact parameter of the first prong
+  /// \param dcaInfo1 is the impact parameter of the second prong
+  /// \return true if the prongs can come from a common secondary vertex
+  bool areProngsCompatible(std::array<float, 2> const& dcaInfo0, std::array<float, 2> const& dcaInfo1)
+  {
+    return config.maxProngDeltaDcaZ < 0. || std::abs(dcaInfo0[1] - dcaInfo1[1]) <= config.maxProngDeltaDcaZ;
+  }
+
   template <bool DoPvRefit, bool UsePidForHfFiltersBdt, typename TTracks>
   void run2And3Prongs(SelectedCollisions const& collisions,
                       aod::BCsWithTimestamps const& bcWithTimeStamps,
@@ -2404,8 +2435,11 @@ struct HfTrackIndexSkimCreator {
       const auto groupedTrackIndicesNeg1 = negativeFor2And3Prongs->sliceByCached(aod::track::collisionId, collision.globalIndex(), cache);
       std::optional<decltype(positiveSoftPions->sliceByCached(aod::track::collisionId, 0, cache))> groupedTrackIndicesSoftPionsPos;
       std::optional<decltype(negativeSoftPions->sliceByCached(aod::track::collisionId, 0, cache))> groupedTrackIndicesSoftPionsNeg;
+      fillProngTracks<TTracks>(groupedTrackIndicesPos1, collision, prongTracksPos);
+      fillProngTracks<TTracks>(groupedTrackIndicesNeg1, collision, prongTracksNeg);
       int lastFilledD0 = -1; // index to be filled in table for D* mesons
-      for (auto trackIndexPos1 = groupedTrackIndicesPos1.begin(); trackIndexPos1 != groupedTrackIndicesPos1.end(); ++trackIndexPos1) {
+      std::size_t iPos1{0};
+      for (auto trackIndexPos1 = groupedTrackIndicesPos1.begin(); trackIndexPos1 != groupedTrackIndicesPos1.end(); ++trackIndexPos1, ++iPos1) {
         const auto trackPos1 = trackIndexPos1.template track_as<TTracks>();
 
         // retrieve the selection flag that corresponds to this collision
@@ -2413,16 +2447,13 @@ struct HfTrackIndexSkimCreator {
         const bool sel2ProngStatusPos = TESTBIT(isSelProngPos1, CandidateType::Cand2Prong);
         const bool sel3ProngStatusPos1 = TESTBIT(isSelProngPos1, CandidateType::Cand3Prong);
 
-        auto trackParVarPos1 = getTrackParCov(trackPos1);
-        std::array pVecTrackPos1{trackPos1.pVector()};
-        std::array dcaInfoPos1{trackPos1.dcaXY(), trackPos1.dcaZ()};
-        if (thisCollId != trackPos1.collisionId()) { // this is not the "default" collision for this track, we have to re-propagate it
-          o2::base::Propagator::Instance()->propagateToDCABxByBz({collision.posX(), collision.posY(), collision.posZ()}, trackParVarPos1, 2.f, noMatCorr, &dcaInfoPos1);
-          getPxPyPz(trackParVarPos1, pVecTrackPos1);
-        }
+        const auto& trackParVarPos1 = prongTracksPos.trackParVar[iPos1];
+        const auto& pVecTrackPos1 = prongTracksPos.pVec[iPos1];
+        const auto& dcaInfoPos1 = prongTracksPos.dcaInfo[iPos1];
 
         // first loop over negative tracks
-        for (auto trackIndexNeg1 = groupedTrackIndicesNeg1.begin(); trackIndexNeg1 != groupedTrackIndicesNeg1.end(); ++trackIndexNeg1) {
+        std::size_t iNeg1{0};
+        for (auto trackIndexNeg1 = groupedTrackIndicesNeg1.begin(); trackIndexNeg1 != groupedTrackIndicesNeg1.end(); ++trackIndexNeg1, ++iNeg1) {
           const auto trackNeg1 = trackIndexNeg1.template track_as<TTracks>();
 
           // retrieve the selection flag that corresponds to this collision
@@ -2430,12 +2461,14 @@ struct HfTrackIndexSkimCreator {
           const bool sel2ProngStatusNeg = TESTBIT(isSelProngNeg1, CandidateType::Cand2Prong);
           const bool sel3ProngStatusNeg1 = TESTBIT(isSelProngNeg1, CandidateType::Cand3Prong);
 
-          auto trackParVarNeg1 = getTrackParCov(trackNeg1);
-          std::array pVecTrackNeg1{trackNeg1.pVector()};
-          std::array dcaInfoNeg1{trackNeg1.dcaXY(), trackNeg1.dcaZ()};
-          if (thisCollId != trackNeg1.collisionId()) { // this is not the "default" collision for this track, we have to re-propagate it
-            o2::base::Propagator::Instance()->propagateToDCABxByBz({collision.posX(), collision.posY(), collision.posZ()}, trackParVarNeg1, 2.f, noMatCorr, &dcaInfoNeg1);
-            getPxPyPz(trackParVarNeg1, pVecTrackNeg1);
+          const auto& trackParVarNeg1 = prongTracksNeg.trackParVar[iNeg1];
+          const auto& pVecTrackNeg1 = prongTracksNeg.pVec[iNeg1];
+          const auto& dcaInfoNeg1 = prongTracksNeg.dcaInfo[iNeg1];
+
+          // cheap rejection of the pair before any preselection, in debug mode the pair is kept to fill the cut status
+          const bool areProngsCompatiblePos1Neg1 = areProngsCompatible(dcaInfoPos1, dcaInfoNeg1);
+          if (!areProngsCompatiblePos1Neg1 && !config.debug) {
+            continue;
           }
 
           uint isSelected2ProngCand = n2ProngBit; // bitmap for checking status of two-prong candidates (1 is true, 0 is rejected)
@@ -2454,8 +2487,11 @@ struct HfTrackIndexSkimCreator {
 
           // 2-prong vertex reconstruction
           float pt2Prong{-1.};
-          bool is2ProngCandidateGoodFor3Prong{sel3ProngStatusPos1 && sel3ProngStatusNeg1};
+          bool is2ProngCandidateGoodFor3Prong{sel3ProngStatusPos1 && sel3ProngStatusNeg1 && areProngsCompatiblePos1Neg1};
           int nVtxFrom2ProngFitter = 0;
+          if (!areProngsCompatiblePos1Neg1) {
+            isSelected2ProngCand = 0;
+          }
           if (sel2ProngStatusPos && sel2ProngStatusNeg) {
 
             // 2-prong preselections
@@ -2464,10 +2500,7 @@ struct HfTrackIndexSkimCreator {
 
             if (isSelected2ProngCand > 0) {
               // secondary vertex reconstruction and further 2-prong selections
-              try {
-                nVtxFrom2ProngFitter = df2.process(trackParVarPos1, trackParVarNeg1);
-              } catch (...) {
-              }
+              nVtxFrom2ProngFitter = o2::hf_vertexing::fitVertex(df2, trackParVarPos1, trackParVarNeg1);
 
               if (nVtxFrom2ProngFitter > 0) { // should it be this or > 0 or are they equivalent
                 // get secondary vertex
@@ -2629,11 +2662,8 @@ struct HfTrackIndexSkimCreator {
           }
 
           // if the cut on the decay length of 3-prongs computed with the first two tracks is enabled and the vertex was not computed for the D0, we compute it now
-          if (config.do3Prong && is2ProngCandidateGoodFor3Prong && (config.minTwoTrackDecayLengthFor3Prongs > 0.f || config.maxTwoTrackChi2PcaFor3Prongs < 1.e9f) && nVtxFrom2ProngFitter == 0) { // o2-linter: disable="magic-number" (default maxTwoTrackChi2PcaFor3Prongs is 1.e10)
-            try {
-              nVtxFrom2ProngFitter = df2.process(trackParVarPos1, trackParVarNeg1);
-            } catch (...) {
-            }
+          if (config.do3Prong && is2ProngCandidateGoodFor3Prong && (config.minTwoTrackDecayLengthFor3Prongs > 0.f || config.maxTwoTrackChi2PcaFor3Prongs < 1.e9f) && nVtxFrom2ProngFitter <= 0) { // o2-linter: disable="magic-number" (default maxTwoTrackChi2PcaFor3Prongs is 1.e10)
+            nVtxFrom2ProngFitter = o2::hf_vertexing::fitVertex(df2, trackParVarPos1, trackParVarNeg1);
             if (nVtxFrom2ProngFitter > 0) {
               const auto& secondaryVertex2 = df2.getPCACandidate();
               const std::array pvCoord2Prong{collision.posX(), collision.posY(), collision.posZ()};
@@ -2645,7 +2675,9 @@ struct HfTrackIndexSkimCreator {
 
           if (config.do3Prong && is2ProngCandidateGoodFor3Prong) { // if 3 prongs are enabled and the first 2 tracks are selected for the 3-prong channels
             // second loop over positive tracks
+            std::size_t iPos2{iPos1};
             for (auto trackIndexPos2 = trackIndexPos1 + 1; trackIndexPos2 != groupedTrackIndicesPos1.end(); ++trackIndexPos2) {
+              ++iPos2;
 
               uint isSelected3ProngCand = n3ProngBit;
               if (!TESTBIT(trackIndexPos2.isSelProng(), CandidateType::Cand3Prong)) { // continue immediately
@@ -2662,18 +2694,20 @@ struct HfTrackIndexSkimCreator {
                 isSelected3ProngCand = 0;
               }
 
-              const auto trackPos2 = trackIndexPos2.template track_as<TTracks>();
+              const auto& trackParVarPos2 = prongTracksPos.trackParVar[iPos2];
+              const auto& dcaInfoPos2 = prongTracksPos.dcaInfo[iPos2];
+              if (!areProngsCompatible(dcaInfoPos1, dcaInfoPos2) || !areProngsCompatible(dcaInfoNeg1, dcaInfoPos2)) { // continue immediately
+                if (!config.debug) {
+                  continue;
+                }
+                isSelected3ProngCand = 0;
+              }
 
-              auto trackParVarPos2 = getTrackParCov(trackPos2);
-              std::array dcaInfoPos2{trackPos2.dcaXY(), trackPos2.dcaZ()};
+              const auto trackPos2 = trackIndexPos2.template track_as<TTracks>();
 
               // preselection of 3-prong candidates
               if (isSelected3ProngCand) {
-                std::array pVecTrackPos2{trackPos2.pVector()};
-                if (thisCollId != trackPos2.collisionId()) { // this is not the "default" collision for this track and we still did not re-propagate it, we have to re-propagate it
-                  o2::base::Propagator::Instance()->propagateToDCABxByBz({collision.posX(), collision.posY(), collision.posZ()}, trackParVarPos2, 2.f, noMatCorr, &dcaInfoPos2);
-                  getPxPyPz(trackParVarPos2, pVecTrackPos2);
-                }
+                const auto& pVecTrackPos2 = prongTracksPos.pVec[iPos2];
 
                 if (config.debug) {
                   for (int iDecay3P = 0; iDecay3P < kN3ProngDecays; iDecay3P++) {
@@ -2782,14 +2816,8 @@ struct HfTrackIndexSkimCreator {
               }
 
               // reconstruct the 3-prong secondary vertex
-              int nVtxFrom3ProngFitter = 0;
-              try {
-                nVtxFrom3ProngFitter = df3.process(trackParVarPos1, trackParVarNeg1, trackParVarPos2);
-              } catch (...) {
-                continue;
-              }
-
-              if (nVtxFrom3ProngFitter == 0) {
+              int nVtxFrom3ProngFitter = o2::hf_vertexing::fitVertex(df3, trackParVarPos1, trackParVarNeg1, trackParVarPos2);
+              if (nVtxFrom3ProngFitter <= 0) {
                 continue;
               }
               // get secondary vertex
@@ -2921,7 +2949,9 @@ struct HfTrackIndexSkimCreator {
             }
 
             // second loop over negative tracks
+            std::size_t iNeg2{iNeg1};
             for (auto trackIndexNeg2 = trackIndexNeg1 + 1; trackIndexNeg2 != groupedTrackIndicesNeg1.end(); ++trackIndexNeg2) {
+              ++iNeg2;
 
               int isSelected3ProngCand = n3ProngBit;
               if (!TESTBIT(trackIndexNeg2.isSelProng(), CandidateType::Cand3Prong)) { // continue immediately
@@ -2938,17 +2968,20 @@ struct HfTrackIndexSkimCreator {
                 isSelected3ProngCand = 0;
               }
 
+              const auto& trackParVarNeg2 = prongTracksNeg.trackParVar[iNeg2];
+              const auto& dcaInfoNeg2 = prongTracksNeg.dcaInfo[iNeg2];
+              if (!areProngsCompatible(dcaInfoNeg1, dcaInfoNeg2) || !areProngsCompatible(dcaInfoPos1, dcaInfoNeg2)) { // continue immediately
+                if (!config.debug) {
+                  continue;
+                }
+                isSelected3ProngCand = 0;
+              }
+
               auto trackNeg2 = trackIndexNeg2.template track_as<TTracks>();
-              auto trackParVarNeg2 = getTrackParCov(trackNeg2);
-              std::array dcaInfoNeg2{trackNeg2.dcaXY(), trackNeg2.dcaZ()};
 
               // preselection of 3-prong candidates
               if (isSelected3ProngCand) {
-                std::array pVecTrackNeg2{trackNeg2.pVector()};
-                if (thisCollId != trackNeg2.collisionId()) { // this is not the "default" collision for this track and we still did not re-propagate it, we have to re-propagate it
-                  o2::base::Propagator::Instance()->propagateToDCABxByBz({collision.posX(), collision.posY(), collision.posZ()}, trackParVarNeg2, 2.f, noMatCorr, &dcaInfoNeg2);
-                  getPxPyPz(trackParVarNeg2, pVecTrackNeg2);
-                }
+                const auto& pVecTrackNeg2 = prongTracksNeg.pVec[iNeg2];
 
                 if (config.debug) {
                   for (int iDecay3P = 0; iDecay3P < kN3ProngDecays; iDecay3P++) {
@@ -3057,14 +3090,8 @@ struct HfTrackIndexSkimCreator {
               }
 
               // reconstruct the 3-prong secondary vertex
-              int nVtxFrom3ProngFitterSecondLoop = 0;
-              try {
-                nVtxFrom3ProngFitterSecondLoop = df3.process(trackParVarNeg1, trackParVarPos1, trackParVarNeg2);
-              } catch (...) {
-                continue;
-              }
-
-              if (nVtxFrom3ProngFitterSecondLoop == 0) {
+              int nVtxFrom3ProngFitterSecondLoop = o2::hf_vertexing::fitVertex(df3, trackParVarNeg1, trackParVarPos1, trackParVarNeg2);
+              if (nVtxFrom3ProngFitterSecondLoop <= 0) {
                 continue;
               }
               // get secondary vertex
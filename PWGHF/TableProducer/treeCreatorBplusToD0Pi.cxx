@@ -22,6 +22,7 @@
 #include "PWGHF/DataModel/AliasTables.h"
 #include "PWGHF/DataModel/CandidateReconstructionTables.h"
 #include "PWGHF/DataModel/CandidateSelectionTables.h"
+#include "PWGHF/Utils/utilsAnalysis.h"
 
 #include "Common/Core/RecoDecay.h"
 
@@ -401,8 +402,7 @@ struct HfTreeCreatorBplusToD0Pi {
     }
     for (const auto& candidate : candidates) {
       if (fillOnlyBackground) {
-        float const pseudoRndm = candidate.ptProng1() * 1000. - static_cast<int64_t>(candidate.ptProng1() * 1000);
-        if (candidate.pt() < ptMaxForDownSample && pseudoRndm >= downSampleBkgFactor) {
+        if (!o2::analysis::isKeptByDownSampling(candidate.pt(), o2::analysis::pseudoRandomFromMomentum(candidate.ptProng1()), downSampleBkgFactor, ptMaxForDownSample)) {
           continue;
         }
       }
@@ -441,8 +441,7 @@ struct HfTreeCreatorBplusToD0Pi {
         rowCandidateLite.reserve(recBg.size());
       }
       for (const auto& candidate : recBg) {
-        float const pseudoRndm = candidate.ptProng1() * 1000. - static_cast<int64_t>(candidate.ptProng1() * 1000);
-        if (candidate.pt() < ptMaxForDownSample && pseudoRndm >= downSampleBkgFactor) {
+        if (!o2::analysis::isKeptByDownSampling(candidate.pt(), o2::analysis::pseudoRandomFromMomentum(candidate.ptProng1()), downSampleBkgFactor, ptMaxForDownSample)) {
           continue;
         }
         auto prong1 = candidate.prong1_as<TracksWPid>();
@@ -21,6 +21,7 @@
 #include "PWGHF/DataModel/AliasTables.h"
 #include "PWGHF/DataModel/CandidateReconstructionTables.h"
 #include "PWGHF/DataModel/CandidateSelectionTables.h"
+#include "PWGHF/Utils/utilsAnalysis.h"
 
 #include "Common/Core/RecoDecay.h"
 
@@ -301,8 +302,7 @@ struct HfTreeCreatorBsToDsPi {
     }
     for (const auto& candidate : candidates) {
       if (fillOnlyBackground && downSampleBkgFactor < 1.) {
-        float const pseudoRndm = candidate.ptProng1() * 1000. - static_cast<int64_t>(candidate.ptProng1() * 1000);
-        if (pseudoRndm >= downSampleBkgFactor && candidate.pt() < ptMaxForDownSample) {
+        if (!o2::analysis::isKeptByDownSampling(candidate.pt(), o2::analysis::pseudoRandomFromMomentum(candidate.ptProng1()), downSampleBkgFactor, ptMaxForDownSample)) {
           continue;
         }
       }
@@ -341,8 +341,7 @@ struct HfTreeCreatorBsToDsPi {
         rowCandidateLite.reserve(recBg.size());
       }
       for (const auto& candidate : recBg) {
-        float const pseudoRndm = candidate.ptProng1() * 1000. - static_cast<int64_t>(candidate.ptProng1() * 1000);
-        if (candidate.pt() < ptMaxForDownSample && pseudoRndm >= downSampleBkgFactor) {
+        if (!o2::analysis::isKeptByDownSampling(candidate.pt(), o2::analysis::pseudoRandomFromMomentum(candidate.ptProng1()), downSampleBkgFactor, ptMaxForDownSample)) {
           continue;
         }
         auto prong1 = candidate.prong1_as<TracksWPid>();
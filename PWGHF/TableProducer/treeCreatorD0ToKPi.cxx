@@ -38,6 +38,7 @@
 #include <array>
 #include <cstdint>
 #include <numeric>
+#include <vector>
 
 using namespace o2;
 using namespace o2::framework;
@@ -242,6 +243,8 @@ struct HfTreeCreatorD0ToKPi {
   // parameters for production of training samples
   Configurable<float> downSampleBkgFactor{"downSampleBkgFactor", 1., "Fraction of background candidates to keep for ML trainings"};
   Configurable<float> ptMaxForDownSample{"ptMaxForDownSample", 10., "Maximum pt for the application of the downsampling factor"};
+  Configurable<std::vector<double>> binsPtDownSample{"binsPtDownSample", std::vector<double>{}, "pT bin limits for a downsampling factor per pT bin (if empty, downSampleBkgFactor and ptMaxForDownSample are used)"};
+  Configurable<std::vector<float>> downSampleBkgFactorsPtBins{"downSampleBkgFactorsPtBins", std::vector<float>{}, "Fractions of background candidates to keep per pT bin for ML trainings"};
   Configurable<bool> fillCorrBkgs{"fillCorrBkgs", false, "Flag to fill derived tables with correlated background candidates"};
 
   // using TracksWPid = soa::Join<aod::Tracks, aod::TracksPidPi, aod::PidTpcTofFullPi, aod::TracksPidKa, aod::PidTpcTofFullKa>;
@@ -410,6 +413,19 @@ struct HfTreeCreatorD0ToKPi {
     }
   }
 
+  /// Down-sampling of the background candidates, per pT bin if pT bins are given
+  template <typename CandType>
+  bool isKeptByBkgDownSampling(CandType const& candidate)
+  {
+    if (binsPtDownSample->size() > 1) {
+      return o2::analysis::isKeptByDownSampling(candidate.pt(), o2::analysis::pseudoRandomFromMomentum(candidate.ptProng0()), binsPtDownSample, downSampleBkgFactorsPtBins);
+    }
+    if (downSampleBkgFactor < 1.) {
+      return o2::analysis::isKeptByDownSampling(candidate.pt(), o2::analysis::pseudoRandomFromMomentum(candidate.ptProng0()), downSampleBkgFactor, ptMaxForDownSample);
+    }
+    return true;
+  }
+
   template <int ReconstructionType, bool ApplyMl, typename CandType>
   void processData(aod::Collisions const& collisions,
                    CandType const& candidates,
@@ -431,11 +447,8 @@ struct HfTreeCreatorD0ToKPi {
       rowCandidateMl.reserve(candidates.size());
     }
     for (const auto& candidate : candidates) {
-      if (downSampleBkgFactor < 1.) {
-        float const pseudoRndm = candidate.ptProng0() * 1000. - static_cast<int64_t>(candidate.ptProng0() * 1000);
-        if (candidate.pt() < ptMaxForDownSample && pseudoRndm >= downSampleBkgFactor) {
-          continue;
-        }
+      if (!isKeptByBkgDownSampling(candidate)) {
+        continue;
       }
       double const yD = HfHelper::yD0(candidate);
       double const eD = HfHelper::eD0(candidate);
@@ -523,11 +536,8 @@ struct HfTreeCreatorD0ToKPi {
         if ((std::abs(candidate.flagMcMatchRec()) == o2::hf_decay::hf_cand_2prong::DecayChannelMain::D0ToPiK) || (fillCorrBkgs && (candidate.flagMcMatchRec() != 0))) {
           continue;
         }
-        if (downSampleBkgFactor < 1.) {
-          float const pseudoRndm = candidate.ptProng0() * 1000. - static_cast<int64_t>(candidate.ptProng0() * 1000);
-          if (candidate.pt() < ptMaxForDownSample && pseudoRndm >= downSampleBkgFactor) {
-            continue;
-          }
+        if (!isKeptByBkgDownSampling(candidate)) {
+          continue;
         }
       }
       if constexpr (OnlySig) {
@@ -484,8 +484,7 @@ struct HfTreeCreatorDplusToPiKPi {
     }
     for (const auto& candidate : candidates) {
       if (downSampleBkgFactor < 1.) {
-        float const pseudoRndm = candidate.ptProng0() * 1000. - static_cast<int64_t>(candidate.ptProng0() * 1000);
-        if (candidate.pt() < ptMaxForDownSample && pseudoRndm >= downSampleBkgFactor) {
+        if (!o2::analysis::isKeptByDownSampling(candidate.pt(), o2::analysis::pseudoRandomFromMomentum(candidate.ptProng0()), downSampleBkgFactor, ptMaxForDownSample)) {
           continue;
         }
       }
@@ -513,8 +512,7 @@ struct HfTreeCreatorDplusToPiKPi {
     }
     for (const auto& candidate : candidates) {
       if (downSampleBkgFactor < 1.) {
-        float const pseudoRndm = candidate.ptProng0() * 1000. - static_cast<int64_t>(candidate.ptProng0() * 1000);
-        if (candidate.pt() < ptMaxForDownSample && pseudoRndm >= downSampleBkgFactor) {
+        if (!o2::analysis::isKeptByDownSampling(candidate.pt(), o2::analysis::pseudoRandomFromMomentum(candidate.ptProng0()), downSampleBkgFactor, ptMaxForDownSample)) {
           continue;
         }
       }
@@ -545,8 +543,7 @@ struct HfTreeCreatorDplusToPiKPi {
     }
     for (const auto& candidate : candidates) {
       if (downSampleBkgFactor < 1.) {
-        float const pseudoRndm = candidate.ptProng0() * 1000. - static_cast<int64_t>(candidate.ptProng0() * 1000);
-        if (candidate.pt() < ptMaxForDownSample && pseudoRndm >= downSampleBkgFactor) {
+        if (!o2::analysis::isKeptByDownSampling(candidate.pt(), o2::analysis::pseudoRandomFromMomentum(candidate.ptProng0()), downSampleBkgFactor, ptMaxForDownSample)) {
           continue;
         }
       }
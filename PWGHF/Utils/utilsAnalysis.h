@@ -22,6 +22,7 @@
 #include <Framework/Configurable.h>
 
 #include <algorithm> // std::upper_bound
+#include <cstdint>
 #include <cstdlib>
 #include <iterator> // std::distance
 #include <string>   //std::string
@@ -171,6 +172,40 @@ bool isCandidateInMassRange(const float invMass,
   return (!(std::abs(invMass - peakMean) > cutConfig.nSigmaMax.value * peakWidth && pt < cutConfig.ptMassCutMax.value));
 }
 
+/// Pseudo-random number in [0, 1) from the decimals of a momentum, for a reproducible down-sampling of the candidates
+/// \param p is the momentum, e.g. the pT of a prong
+/// \return pseudo-random number
+template <typename TNumber>
+float pseudoRandomFromMomentum(const TNumber p)
+{
+  return p * 1000. - static_cast<int64_t>(p * 1000);
+}
+
+/// Down-sampling of the background candidates of the tree creators
+/// \param pt is the pT of the candidate
+/// \param pseudoRndm is the pseudo-random number of the candidate
+/// \param factor is the fraction of candidates kept below ptMax
+/// \param ptMax is the pT from which all the candidates are kept
+/// \return true if the candidate is kept
+inline bool isKeptByDownSampling(const float pt, const float pseudoRndm, const float factor, const float ptMax)
+{
+  return !(pt < ptMax && pseudoRndm >= factor);
+}
+
+/// Down-sampling of the background candidates of the tree creators with a fraction per pT bin
+/// \param pt is the pT of the candidate
+/// \param pseudoRndm is the pseudo-random number of the candidate
+/// \param binsPt pT bins
+/// \param factors fractions of candidates kept per pT bin
+/// \return true if the candidate is kept
+/// \note The candidates outside the pT bins are all kept.
+template <typename TArrayPt, typename TArrayFactors>
+bool isKeptByDownSampling(const float pt, const float pseudoRndm, TArrayPt const& binsPt, TArrayFactors const& factors)
+{
+  const int bin = findBin(binsPt, pt);
+  return bin < 0 || bin >= static_cast<int>(factors->size()) || pseudoRndm < factors->at(bin);
+}
+
 /// Configurable group to apply trigger specific cuts for 2-prong HF analysis
 struct HfTrigger2ProngCuts : o2::framework::ConfigurableGroup {
   std::string prefix = "hfTrigger2ProngCuts"; // JSON group name
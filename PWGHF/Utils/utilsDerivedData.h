@@ -23,8 +23,8 @@
 #include <Framework/Configurable.h>
 #include <Framework/Logger.h>
 
+#include <cstddef>
 #include <cstdint>
-#include <map>
 #include <vector>
 
 // Macro to store nSigma for prong _id_ with PID hypothesis _hyp_ in an array
@@ -88,8 +88,38 @@ struct HfProducesDerivedData : o2::framework::ProducesGroup {
   o2::framework::Produces<HfPIds> rowParticleId;
 
   HfConfigurableDerivedData const* conf{};
-  std::map<int, std::vector<int>> matchedCollisions; // indices of derived reconstructed collisions matched to the global indices of MC collisions
-  std::map<int, bool> hasMcParticles;                // flags for MC collisions with HF particles
+  std::vector<std::vector<int>> matchedCollisions; // indices of derived reconstructed collisions matched to the global indices of MC collisions, indexed by MC collision
+  std::vector<bool> hasMcParticles;                // flags for MC collisions with HF particles, indexed by MC collision
+
+  /// indices of the derived reconstructed collisions matched to an MC collision
+  std::vector<int> const& getMatchedCollisions(const int64_t mcCollisionId) const
+  {
+    static const std::vector<int> NoCollisions{};
+    return (mcCollisionId >= 0 && mcCollisionId < static_cast<int64_t>(matchedCollisions.size())) ? matchedCollisions[mcCollisionId] : NoCollisions;
+  }
+
+  /// whether an MC collision has HF particles, filled by preProcessMcCollisions
+  bool mcCollisionHasMcParticles(const int64_t mcCollisionId) const
+  {
+    return mcCollisionId >= 0 && mcCollisionId < static_cast<int64_t>(hasMcParticles.size()) && hasMcParticles[mcCollisionId];
+  }
+
+  /// whether a reconstructed collision is saved: with HF candidates, or matched to an MC collision with HF particles
+  /// when saving the indices of the reconstructed collisions matched to the MC collisions
+  /// \param nCandidates  number of HF candidates of the collision, summed over the channels written with the same collision tables
+  template <bool IsMc, typename TCollision>
+  bool keepCollision(TCollision const& collision, const std::size_t nCandidates) const
+  {
+    if (nCandidates > 0) {
+      return true;
+    }
+    if constexpr (IsMc) {
+      const bool hasMatchedMcParticles = conf->fillMcRCollId.value && collision.has_mcCollision() && mcCollisionHasMcParticles(collision.mcCollisionId());
+      LOGF(debug, "Rec. collision %d has MC collision %d with MC particles? %s", collision.globalIndex(), collision.mcCollisionId(), hasMatchedMcParticles ? "yes" : "no");
+      return hasMatchedMcParticles;
+    }
+    return false;
+  }
 
   void init(HfConfigurableDerivedData const& c)
   {
@@ -159,7 +189,10 @@ struct HfProducesDerivedData : o2::framework::ProducesGroup {
       if (conf->fillMcRCollId.value && collision.has_mcCollision()) {
         // Save rowCollBase.lastIndex() at key collision.mcCollisionId()
         LOGF(debug, "Rec. collision %d: Filling derived-collision index %d for MC collision %d", collision.globalIndex(), rowCollBase.lastIndex(), collision.mcCollisionId());
-        matchedCollisions[collision.mcCollisionId()].push_back(rowCollBase.lastIndex()); // [] inserts an empty element if it does not exist
+        if (collision.mcCollisionId() >= static_cast<int64_t>(matchedCollisions.size())) {
+          matchedCollisions.resize(collision.mcCollisionId() + 1);
+        }
+        matchedCollisions[collision.mcCollisionId()].push_back(rowCollBase.lastIndex());
       }
     }
   }
@@ -181,7 +214,7 @@ struct HfProducesDerivedData : o2::framework::ProducesGroup {
     if (conf->fillMcRCollId.value) {
       // Fill the table with the vector of indices of derived reconstructed collisions matched to mcCollision.globalIndex()
       rowMcRCollId(
-        matchedCollisions[mcCollision.globalIndex()]);
+        getMatchedCollisions(mcCollision.globalIndex()));
     }
   }
 
@@ -207,19 +240,19 @@ struct HfProducesDerivedData : o2::framework::ProducesGroup {
 
   template <typename TMcCollisions, typename TMcParticles>
   void preProcessMcCollisions(TMcCollisions const& mcCollisions,
-                              o2::framework::Preslice<TMcParticles> const& mcParticlesPerMcCollision,
+                              o2::framework::Preslice<TMcParticles> const& /*mcParticlesPerMcCollision*/,
                               TMcParticles const& mcParticles)
   {
     if (!conf->fillMcRCollId.value) {
       return;
     }
-    hasMcParticles.clear();
-    // Fill MC collision flags
-    for (const auto& mcCollision : mcCollisions) {
-      const auto thisMcCollId = mcCollision.globalIndex();
-      const auto particlesThisMcColl = mcParticles.sliceBy(mcParticlesPerMcCollision, thisMcCollId);
-      LOGF(debug, "MC collision %d has %d MC particles (preprocess)", thisMcCollId, particlesThisMcColl.size());
-      hasMcParticles[thisMcCollId] = (particlesThisMcColl.size() > 0);
+    // Fill MC collision flags in one pass over the MC particles
+    hasMcParticles.assign(mcCollisions.size(), false);
+    for (const auto& particle : mcParticles) {
+      const auto thisMcCollId = particle.mcCollisionId();
+      if (thisMcCollId >= 0 && thisMcCollId < static_cast<int64_t>(hasMcParticles.size())) {
+        hasMcParticles[thisMcCollId] = true;
+      }
     }
   }
 
@@ -240,8 +273,8 @@ struct HfProducesDerivedData : o2::framework::ProducesGroup {
       const auto sizeTablePart = particlesThisMcColl.size();
       LOGF(debug, "MC collision %d has %d MC particles", thisMcCollId, sizeTablePart);
       // Skip MC collisions without HF particles (and without HF candidates in matched reconstructed collisions if saving indices of reconstructed collisions matched to MC collisions)
-      LOGF(debug, "MC collision %d has %d saved derived rec. collisions", thisMcCollId, matchedCollisions[thisMcCollId].size());
-      if (sizeTablePart == 0 && (!conf->fillMcRCollId.value || matchedCollisions[thisMcCollId].empty())) {
+      LOGF(debug, "MC collision %d has %d saved derived rec. collisions", thisMcCollId, getMatchedCollisions(thisMcCollId).size());
+      if (sizeTablePart == 0 && (!conf->fillMcRCollId.value || getMatchedCollisions(thisMcCollId).empty())) {
         LOGF(debug, "Skipping MC collision %d", thisMcCollId);
         continue;
       }
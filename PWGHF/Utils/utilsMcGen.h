@@ -40,7 +40,8 @@ void fillMcMatchGen2Prong(TMcParticles const& mcParticles,
                           TMcParticlesPerColl const& mcParticlesPerMcColl,
                           TCursor& rowMcMatchGen,
                           const bool rejectBackground,
-                          const bool matchCorrelatedBackground)
+                          const bool matchCorrelatedBackground,
+                          RecoDecayMcAncestry* mcAncestry = nullptr)
 {
   using namespace o2::constants::physics;
   using namespace o2::hf_decay::hf_cand_2prong;
@@ -117,7 +118,7 @@ void fillMcMatchGen2Prong(TMcParticles const& mcParticles,
 
     // Check whether the particle is non-prompt (from a b quark).
     if (flagChannelMain != 0) {
-      origin = RecoDecay::getCharmHadronOrigin(mcParticles, particle, false, &idxBhadMothers);
+      origin = mcAncestry ? mcAncestry->getCharmHadronOrigin(mcParticles, particle, &idxBhadMothers) : RecoDecay::getCharmHadronOrigin(mcParticles, particle, false, &idxBhadMothers);
     }
     if (origin == RecoDecay::OriginType::NonPrompt) {
       rowMcMatchGen(flagChannelMain, origin, flagChannelResonant, idxBhadMothers[0]);
@@ -132,7 +133,8 @@ void fillMcMatchGen3Prong(TMcParticles const& mcParticles,
                           TMcParticlesPerColl const& mcParticlesPerMcColl,
                           TCursor& rowMcMatchGen,
                           const bool rejectBackground,
-                          std::vector<int> const& pdgMothersCorrelBkg = {})
+                          std::vector<int> const& pdgMothersCorrelBkg = {},
+                          RecoDecayMcAncestry* mcAncestry = nullptr)
 {
   using namespace o2::constants::physics;
   using namespace o2::hf_decay::hf_cand_3prong;
@@ -313,7 +315,7 @@ void fillMcMatchGen3Prong(TMcParticles const& mcParticles,
 
     // Check whether the particle is non-prompt (from a b quark).
     if (flagChannelMain != 0) {
-      origin = RecoDecay::getCharmHadronOrigin(mcParticles, particle, false, &idxBhadMothers);
+      origin = mcAncestry ? mcAncestry->getCharmHadronOrigin(mcParticles, particle, &idxBhadMothers) : RecoDecay::getCharmHadronOrigin(mcParticles, particle, false, &idxBhadMothers);
     }
     if (origin == RecoDecay::OriginType::NonPrompt) {
       rowMcMatchGen(flagChannelMain, origin, flagChannelResonant, idxBhadMothers[0]);
@@ -0,0 +1,140 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file utilsSecondaryVertexing.h
+/// \brief Secondary-vertex building blocks shared by the HF track-index skim and the jet SV reconstruction
+/// \author Hadi Hassan <hadi.hassan@cern.ch>
+
+#ifndef PWGHF_UTILS_UTILSSECONDARYVERTEXING_H_
+#define PWGHF_UTILS_UTILSSECONDARYVERTEXING_H_
+
+#include <DCAFitter/DCAFitterN.h>
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+namespace o2::hf_vertexing
+{
+
+/// \brief Applies the fitter settings common to all the secondary-vertex builders
+/// \param df is the fitter to configure
+template <int NProngs>
+void configureFitter(o2::vertexing::DCAFitterN<NProngs>& df,
+                     bool propagateToPCA,
+                     float maxR,
+                     float maxDZIni,
+                     float minParamChange,
+                     float minRelChi2Change,
+                     bool useAbsDCA,
+                     bool useWeightedFinalPCA)
+{
+  df.setPropagateToPCA(propagateToPCA);
+  df.setMaxR(maxR);
+  df.setMaxDZIni(maxDZIni);
+  df.setMinParamChange(minParamChange);
+  df.setMinRelChi2Change(minRelChi2Change);
+  df.setUseAbsDCA(useAbsDCA);
+  df.setWeightedFinalPCA(useWeightedFinalPCA);
+}
+
+/// \brief Runs the fitter on the given prongs
+/// \return number of vertex candidates found, or -1 if the fitter threw a run-time error
+template <typename TFitter, typename... TTracks>
+int fitVertex(TFitter& df, TTracks const&... prongs)
+{
+  try {
+    return df.process(prongs...);
+  } catch (...) {
+    return -1;
+  }
+}
+
+/// \brief Same as above, with the prongs given as an array
+template <typename TFitter, typename TTrack, std::size_t NProngs>
+int fitVertex(TFitter& df, std::array<TTrack, NProngs> const& prongs)
+{
+  return std::apply([&df](auto const&... elems) { return fitVertex(df, elems...); }, prongs);
+}
+
+/// \brief Calls fnc(indices) for all the NProngs-combinations of nItems items, in lexicographic order
+/// \param areCompatible is a cheap pair check, a partial combination is dropped (with all its continuations) as soon as one of its pairs fails it
+template <std::size_t NProngs, typename TCompatible, typename TFnc>
+void forEachCombination(std::size_t nItems, TCompatible&& areCompatible, TFnc&& fnc)
+{
+  if (NProngs == 0 || nItems < NProngs) {
+    return;
+  }
+  std::array<std::size_t, NProngs> indices{};
+  std::size_t depth = 0;
+  while (true) {
+    if (indices[depth] + (NProngs - depth) > nItems) {
+      // no room left for the remaining prongs at this depth
+      if (depth == 0) {
+        return;
+      }
+      --depth;
+      ++indices[depth];
+      continue;
+    }
+    bool isCompatible = true;
+    for (std::size_t iPrevious = 0; iPrevious < depth && isCompatible; ++iPrevious) {
+      isCompatible = areCompatible(indices[iPrevious], indices[depth]);
+    }
+    if (!isCompatible) {
+      ++indices[depth];
+      continue;
+    }
+    if (depth + 1 == NProngs) {
+      fnc(indices);
+      ++indices[depth];
+      continue;
+    }
+    indices[depth + 1] = indices[depth] + 1;
+    ++depth;
+  }
+}
+
+/// \brief Runs task(iTask, iThread) for iTask in [0, nTasks) over nThreads threads, the calling thread being thread 0
+/// Tasks are taken one by one from a shared counter, so every task has to write its results into its own slot
+template <typename TTask>
+void runInParallel(int nThreads, std::size_t nTasks, TTask&& task)
+{
+  if (nThreads <= 1 || nTasks <= 1) {
+    for (std::size_t iTask = 0; iTask < nTasks; ++iTask) {
+      task(iTask, 0);
+    }
+    return;
+  }
+  std::atomic<std::size_t> nextTask{0};
+  auto worker = [&](int iThread) {
+    for (std::size_t iTask = nextTask++; iTask < nTasks; iTask = nextTask++) {
+      task(iTask, iThread);
+    }
+  };
+  int nWorkers = static_cast<std::size_t>(nThreads) < nTasks ? nThreads : static_cast<int>(nTasks);
+  std::vector<std::thread> threads;
+  threads.reserve(nWorkers - 1);
+  for (int iThread = 1; iThread < nWorkers; ++iThread) {
+    threads.emplace_back(worker, iThread);
+  }
+  worker(0);
+  for (auto& thread : threads) {
+    thread.join();
+  }
+}
+
+} // namespace o2::hf_vertexing
+
+#endif // PWGHF_UTILS_UTILSSECONDARYVERTEXING_H_
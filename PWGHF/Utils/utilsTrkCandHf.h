@@ -19,11 +19,13 @@
 #include "PWGHF/Utils/utilsAnalysis.h"
 
 #include <Framework/HistogramSpec.h>
+#include <ReconstructionDataFormats/DCA.h>
 
 #include <Rtypes.h>
 
 #include <cstddef>
 #include <cstdint>
+#include <vector>
 
 namespace o2::hf_trkcandsel
 {
@@ -86,6 +88,42 @@ bool isSelectedTrackDCA(TTrackPar const& trackPar,
   return true;
 }
 
+/// Impact parameters of tracks propagated to the primary vertex of their candidate's collision.
+/// The same track enters many candidates of a collision, so it is propagated only the first time.
+/// Every entry remembers the collision it was computed for, hence nothing has to be cleared
+/// between collisions and candidates do not need to be sorted by collision.
+class ImpactParameterCache
+{
+ public:
+  /// \param trackId is the global index of the track
+  /// \param collisionId is the global index of the collision defining the primary vertex
+  /// \param propagate is called as propagate(dca) if the entry is missing and has to fill dca
+  template <typename TPropagate>
+  const o2::dataformats::DCA& get(int64_t trackId, int64_t collisionId, TPropagate&& propagate)
+  {
+    if (static_cast<std::size_t>(trackId) >= mCollisionIds.size()) {
+      mCollisionIds.resize(trackId + 1, -1);
+      mImpactParameters.resize(trackId + 1);
+    }
+    if (mCollisionIds[trackId] != collisionId) {
+      propagate(mImpactParameters[trackId]);
+      mCollisionIds[trackId] = collisionId;
+    }
+    return mImpactParameters[trackId];
+  }
+
+  /// invalidates all the entries, to be called when the track table or the propagator settings change
+  void clear()
+  {
+    mCollisionIds.clear();
+    mImpactParameters.clear();
+  }
+
+ private:
+  std::vector<int64_t> mCollisionIds;                  // per track, collision of the cached entry (-1 if none)
+  std::vector<o2::dataformats::DCA> mImpactParameters; // per track, impact parameter to the primary vertex
+};
+
 } // namespace o2::hf_trkcandsel
 
 #endif // PWGHF_UTILS_UTILSTRKCANDHF_H_
@@ -27,7 +27,10 @@
 #include <fastjet/tools/Subtractor.hh>
 
 #include <algorithm>
+#include <cmath>
+#include <cstddef>
 #include <cstdlib>
+#include <memory>
 #include <tuple>
 #include <vector>
 
@@ -107,6 +110,79 @@ std::tuple<double, double> JetBkgSubUtils::estimateRhoAreaMedian(const std::vect
   return std::make_tuple(rho, rhoM);
 }
 
+std::tuple<double, double> JetBkgSubUtils::estimateRhoGridMedian(const std::vector<fastjet::PseudoJet>& inputParticles, bool doSparseSub)
+{
+  if (inputParticles.size() == 0) {
+    return std::make_tuple(0.0, 0.0);
+  }
+
+  // the phi acceptance can be given wider than 2pi (e.g. -pi to 2pi), the grid covers at most one turn
+  double etaSpan = bkgEtaMax - bkgEtaMin;
+  double phiSpan = std::min(static_cast<double>(bkgPhiMax - bkgPhiMin), 2.0 * M_PI);
+  if (etaSpan <= 0.0 || phiSpan <= 0.0 || gridTileSize <= 0.0) {
+    return std::make_tuple(0.0, 0.0);
+  }
+  int nEta = std::max(1, static_cast<int>(etaSpan / gridTileSize + 0.5));
+  int nPhi = std::max(1, static_cast<int>(phiSpan / gridTileSize + 0.5));
+  double tileEta = etaSpan / nEta;
+  double tilePhi = phiSpan / nPhi;
+  std::size_t nTiles = static_cast<std::size_t>(nEta) * nPhi;
+
+  // assign() keeps the capacity, so the tiles are only allocated for the first event
+  gridPt.assign(nTiles, 0.0);
+  gridMd.assign(nTiles, 0.0);
+
+  for (const auto& particle : inputParticles) {
+    double eta = particle.eta();
+    if (eta < bkgEtaMin || eta >= bkgEtaMax) {
+      continue;
+    }
+    double phi = particle.phi() - bkgPhiMin;
+    phi -= 2.0 * M_PI * std::floor(phi / (2.0 * M_PI));
+    if (phi >= phiSpan) {
+      continue;
+    }
+    int iEta = std::min(static_cast<int>((eta - bkgEtaMin) / tileEta), nEta - 1);
+    int iPhi = std::min(static_cast<int>(phi / tilePhi), nPhi - 1);
+    std::size_t iTile = static_cast<std::size_t>(iEta) * nPhi + iPhi;
+    gridPt[iTile] += particle.pt();
+    gridMd[iTile] += std::sqrt(particle.m() * particle.m() + particle.pt() * particle.pt()) - particle.pt();
+  }
+
+  std::size_t nOccupied = 0;
+  for (auto tilePt : gridPt) {
+    if (tilePt > 0.0) {
+      nOccupied++;
+    }
+  }
+
+  // all the tiles have the same area, so the median density is the median sum divided by the tile area
+  double tileArea = tileEta * tilePhi;
+  double rho = medianInPlace(gridPt) / tileArea;
+  double rhoM = medianInPlace(gridMd) / tileArea;
+
+  if (doSparseSub) {
+    // occupancy factor, the fraction of tiles with at least one particle
+    double occupancyFactor = static_cast<double>(nOccupied) / nTiles;
+    rho *= occupancyFactor;
+    rhoM *= occupancyFactor;
+  }
+
+  return std::make_tuple(rho, rhoM);
+}
+
+double JetBkgSubUtils::medianInPlace(std::vector<double>& values)
+{
+  // same convention as TMath::Median, the mean of the two central values for an even number of entries
+  std::size_t half = values.size() / 2;
+  std::nth_element(values.begin(), values.begin() + half, values.end());
+  double median = values[half];
+  if (values.size() % 2 == 0) {
+    median = 0.5 * (median + *std::max_element(values.begin(), values.begin() + half));
+  }
+  return median;
+}
+
 fastjet::PseudoJet JetBkgSubUtils::doRhoAreaSub(const fastjet::PseudoJet& jet, double rhoParam, double rhoMParam)
 {
 
@@ -120,19 +196,29 @@ fastjet::PseudoJet JetBkgSubUtils::doRhoAreaSub(const fastjet::PseudoJet& jet, d
 std::vector<fastjet::PseudoJet> JetBkgSubUtils::doEventConstSub(std::vector<fastjet::PseudoJet>& inputParticles, double rhoParam, double rhoMParam)
 {
   JetBkgSubUtils::initialise();
-  fastjet::contrib::ConstituentSubtractor constituentSub(rhoParam, rhoMParam);
-  constituentSub.set_distance_type(fastjet::contrib::ConstituentSubtractor::deltaR); /// deltaR=sqrt((y_i-y_j)^2+(phi_i-phi_j)^2)), longitudinal Lorentz invariant
-  constituentSub.set_max_distance(constSubRMax);
-  constituentSub.set_alpha(constSubAlpha);
-  constituentSub.set_ghost_area(ghostAreaSpec.ghost_area());
-  constituentSub.set_max_eta(std::max(std::abs(bkgEtaMin), std::abs(bkgEtaMax)));
+  const float maxEta = std::max(std::abs(bkgEtaMin), std::abs(bkgEtaMax));
+
+  // the subtractor and its grid of ghosts only depend on the settings, only the background densities change from one call to the next
+  auto settings = std::make_tuple(constSubRMax, constSubAlpha, ghostAreaSpec.ghost_area(), maxEta, doRhoMassSub);
+  if (eventConstSub && settings == eventConstSubSettings) {
+    eventConstSub->set_scalar_background_density(rhoParam, rhoMParam);
+    return eventConstSub->subtract_event(inputParticles, maxEta);
+  }
+
+  eventConstSub = std::make_shared<fastjet::contrib::ConstituentSubtractor>(rhoParam, rhoMParam);
+  eventConstSub->set_distance_type(fastjet::contrib::ConstituentSubtractor::deltaR); /// deltaR=sqrt((y_i-y_j)^2+(phi_i-phi_j)^2)), longitudinal Lorentz invariant
+  eventConstSub->set_max_distance(constSubRMax);
+  eventConstSub->set_alpha(constSubAlpha);
+  eventConstSub->set_ghost_area(ghostAreaSpec.ghost_area());
+  eventConstSub->set_max_eta(maxEta);
 
   // by default, the masses of all particles are set to zero. With this flag the jet mass will also be subtracted
   if (doRhoMassSub) {
-    constituentSub.set_do_mass_subtraction();
+    eventConstSub->set_do_mass_subtraction();
   }
+  eventConstSubSettings = settings;
 
-  return constituentSub.subtract_event(inputParticles, std::max(std::abs(bkgEtaMin), std::abs(bkgEtaMax)));
+  return eventConstSub->subtract_event(inputParticles, maxEta);
 }
 
 std::vector<fastjet::PseudoJet> JetBkgSubUtils::doJetConstSub(std::vector<fastjet::PseudoJet>& jets, double rhoParam, double rhoMParam)
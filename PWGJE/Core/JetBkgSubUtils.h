@@ -23,11 +23,17 @@
 #include <fastjet/PseudoJet.hh>
 #include <fastjet/Selector.hh>
 
+#include <memory>
 #include <tuple>
 #include <vector>
 
 #include <math.h>
 
+namespace fastjet::contrib
+{
+class ConstituentSubtractor;
+}
+
 enum class BkgSubEstimator { none = 0,
                              medianRho = 1,
                              medianRhoSparse = 2
@@ -68,6 +74,12 @@ class JetBkgSubUtils
   /// @return Rho, RhoM the underlying event density
   std::tuple<double, double> estimateRhoAreaMedian(const std::vector<fastjet::PseudoJet>& inputParticles, bool doSparseSub);
 
+  /// @brief Method for estimating the jet background density using the median of the eta-phi grid tiles (no clustering, no ghosts)
+  /// @param inputParticles (all particles in the event)
+  /// @param doSparseSub whether to scale the median by the fraction of occupied tiles
+  /// @return Rho, RhoM the underlying event density
+  std::tuple<double, double> estimateRhoGridMedian(const std::vector<fastjet::PseudoJet>& inputParticles, bool doSparseSub);
+
   /// @brief method that subtracts the background from jets using the area method
   /// @param jet input jet to be background subtracted
   /// @param rhoParam the underlying evvent density vs pT (to be set)
@@ -108,6 +120,7 @@ class JetBkgSubUtils
   }
   void setDoRhoMassSub(bool doMSub_out = true) { doRhoMassSub = doMSub_out; }
   void setGhostAreaSpec(fastjet::GhostedAreaSpec ghostAreaSpec_out) { ghostAreaSpec = ghostAreaSpec_out; }
+  void setGridTileSize(float gridTileSize_out) { gridTileSize = gridTileSize_out; }
 
   // Getters
   float getJetBkgR() const { return jetBkgR; }
@@ -119,6 +132,7 @@ class JetBkgSubUtils
   float getConstSubRMax() const { return constSubRMax; }
   float getDoRhoMassSub() const { return doRhoMassSub; }
   fastjet::GhostedAreaSpec getGhostAreaSpec() const { return ghostAreaSpec; }
+  float getGridTileSize() const { return gridTileSize; }
   fastjet::JetDefinition getJetDefinition() const { return jetDefBkg; }
   fastjet::AreaDefinition getAreaDefinition() const { return areaDefBkg; }
   fastjet::Selector getRhoSelector() const { return selRho; }
@@ -136,6 +150,7 @@ class JetBkgSubUtils
   float constSubRMax = 0.24;
   int nHardReject = 2;
   bool doRhoMassSub = false; /// flag whether to do jet mass subtraction with the const sub
+  float gridTileSize = 0.2;  /// requested tile size in eta and phi for the grid estimator
 
   fastjet::GhostedAreaSpec ghostAreaSpec = fastjet::GhostedAreaSpec();
   fastjet::JetAlgorithm algorithmBkg = fastjet::kt_algorithm;
@@ -144,6 +159,15 @@ class JetBkgSubUtils
   fastjet::AreaDefinition areaDefBkg = fastjet::AreaDefinition(fastjet::active_area_explicit_ghosts, ghostAreaSpec);
   fastjet::Selector selRho = fastjet::Selector();
 
+  std::vector<double> gridPt; /// scalar pT sum per tile, kept across events to avoid reallocating
+  std::vector<double> gridMd; /// sum of (mT - pT) per tile, kept across events to avoid reallocating
+
+  std::shared_ptr<fastjet::contrib::ConstituentSubtractor> eventConstSub; /// event-wise subtractor, kept across events so that its ghosts are only built again when the settings change
+  std::tuple<float, float, double, float, bool> eventConstSubSettings;   /// rMax, alpha, ghost area, max eta and mass subtraction flag of eventConstSub
+
+  // median of the values, reorders the vector
+  static double medianInPlace(std::vector<double>& values);
+
 }; // class JetBkgSubUtils
 
 #endif // PWGJE_CORE_JETBKGSUBUTILS_H_
@@ -23,6 +23,7 @@
 
 #include <cstdint>
 #include <type_traits>
+#include <vector>
 
 namespace jetcandidateutilities
 {
@@ -133,6 +134,80 @@ bool isDaughterTrack(T& track, U& candidate)
   }
 }
 
+/**
+ * calls f with the global index of each daughter track of the candidate
+ *
+ * @param candidate candidate
+ * @param f function called with the global index of the daughter track
+ */
+template <typename T, typename F>
+void forEachDaughterTrackId(T const& candidate, F&& f)
+{
+  if constexpr (jethfutilities::isHFCandidate<T>()) {
+    jethfutilities::forEachHFDaughterTrackId(candidate, f);
+  } else if constexpr (jetv0utilities::isV0Candidate<T>()) {
+    jetv0utilities::forEachV0DaughterTrackId(candidate, f);
+  } else if constexpr (jetdqutilities::isDielectronCandidate<T>()) {
+    jetdqutilities::forEachDielectronDaughterTrackId(candidate, f);
+  }
+}
+
+/**
+ * Lookup of the daughter tracks of a set of candidates, filled from the prong indices of the candidates so that
+ * checking if a track is a daughter of any of them does not loop over the candidates. The flags are indexed by the
+ * track global index and only the ones which were set are reset by clear(), so the lookup can be kept between events.
+ */
+class DaughterTrackLookup
+{
+ public:
+  template <typename T>
+  void add(T const& candidate)
+  {
+    forEachDaughterTrackId(candidate, [this](int64_t trackId) {
+      if (trackId < 0) {
+        return;
+      }
+      if (trackId >= static_cast<int64_t>(mIsDaughter.size())) {
+        mIsDaughter.resize(trackId + 1, false);
+      }
+      if (!mIsDaughter[trackId]) {
+        mIsDaughter[trackId] = true;
+        mDaughterIds.push_back(trackId);
+      }
+    });
+  }
+
+  template <typename T>
+  void build(T const& candidates)
+  {
+    clear();
+    for (auto const& candidate : candidates) {
+      add(candidate);
+    }
+  }
+
+  void clear()
+  {
+    for (auto trackId : mDaughterIds) {
+      mIsDaughter[trackId] = false;
+    }
+    mDaughterIds.clear();
+  }
+
+  bool empty() const { return mDaughterIds.empty(); }
+
+  template <typename T>
+  bool isDaughterTrack(T const& track) const
+  {
+    const int64_t trackId = track.globalIndex();
+    return trackId < static_cast<int64_t>(mIsDaughter.size()) && mIsDaughter[trackId];
+  }
+
+ private:
+  std::vector<bool> mIsDaughter;
+  std::vector<int64_t> mDaughterIds;
+};
+
 /**
  * returns true if the particle has any daughters with the given global index
  *
@@ -109,6 +109,21 @@ bool isDielectronDaughterTrack(T& track, U& candidate)
   }
 }
 
+/**
+ * calls f with the global index of each daughter track of the Dielectron candidate
+ *
+ * @param candidate Dielectron candidate
+ * @param f function called with the global index of the daughter track
+ */
+template <typename T, typename F>
+void forEachDielectronDaughterTrackId(T const& candidate, F&& f)
+{
+  if constexpr (isDielectronCandidate<T>()) {
+    f(candidate.prong0Id());
+    f(candidate.prong1Id());
+  }
+}
+
 /**
  * returns the index of the JMcParticle matched to the Dielectron candidate
  *
@@ -0,0 +1,114 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file JetDerivedDataIndexMaps.h
+/// \brief Dense index translation from the parent tables to the derived tables, shared by the PWGJE producers
+///
+/// \author Nima Zardoshti <nima.zardoshti@cern.ch>
+
+#ifndef PWGJE_CORE_JETDERIVEDDATAINDEXMAPS_H_
+#define PWGJE_CORE_JETDERIVEDDATAINDEXMAPS_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace jetderiveddatautilities
+{
+
+/// Translates the index of a row in a parent table into the index of the corresponding row in a derived table.
+/// Rows which were not written keep the sentinel value -1. The storage is kept across data frames,
+/// so after the first one reset() only refills it.
+class IndexMap
+{
+ public:
+  static constexpr int32_t NotFound = -1;
+
+  /// prepares the map for a parent table with nEntries rows, all of them unmapped
+  void reset(std::size_t nEntries) { mIndices.assign(nEntries, NotFound); }
+
+  /// unchecked access, the parent index has to be within the size given to reset()
+  int32_t& operator[](std::size_t parentIndex) { return mIndices[parentIndex]; }
+  int32_t operator[](std::size_t parentIndex) const { return mIndices[parentIndex]; }
+
+  /// checked access, returns NotFound for negative or out of range parent indices
+  int32_t find(int64_t parentIndex) const
+  {
+    if (parentIndex < 0 || static_cast<std::size_t>(parentIndex) >= mIndices.size()) {
+      return NotFound;
+    }
+    return mIndices[parentIndex];
+  }
+
+  std::size_t size() const { return mIndices.size(); }
+
+ private:
+  std::vector<int32_t> mIndices;
+};
+
+/// Translates a (track, collision) pair into the index of the derived track.
+/// Without a track-to-collision associator every track has a single entry, with it a track is written once
+/// per compatible collision. The entries of a track are chained through flat arrays indexed by the order
+/// of insertion, which is the same as the derived table order, so no node based container is needed.
+class TrackCollisionIndexMap
+{
+ public:
+  static constexpr int32_t NotFound = -1;
+
+  /// prepares the map for a track table with nTracks rows
+  void reset(std::size_t nTracks)
+  {
+    mFirstEntry.assign(nTracks, NotFound);
+    mEntryCollision.clear();
+    mEntryDerivedIndex.clear();
+    mEntryNext.clear();
+  }
+
+  void insert(int64_t trackIndex, int32_t collisionIndex, int32_t derivedIndex)
+  {
+    if (trackIndex < 0) {
+      return;
+    }
+    if (static_cast<std::size_t>(trackIndex) >= mFirstEntry.size()) {
+      mFirstEntry.resize(trackIndex + 1, NotFound);
+    }
+    // the newest entry is the head of the chain, so a repeated pair returns the last inserted value
+    int32_t entry = mEntryCollision.size();
+    mEntryCollision.push_back(collisionIndex);
+    mEntryDerivedIndex.push_back(derivedIndex);
+    mEntryNext.push_back(mFirstEntry[trackIndex]);
+    mFirstEntry[trackIndex] = entry;
+  }
+
+  /// returns the derived track index, or NotFound if the pair was not inserted
+  int32_t find(int64_t trackIndex, int32_t collisionIndex) const
+  {
+    if (trackIndex < 0 || static_cast<std::size_t>(trackIndex) >= mFirstEntry.size()) {
+      return NotFound;
+    }
+    for (int32_t entry = mFirstEntry[trackIndex]; entry != NotFound; entry = mEntryNext[entry]) {
+      if (mEntryCollision[entry] == collisionIndex) {
+        return mEntryDerivedIndex[entry];
+      }
+    }
+    return NotFound;
+  }
+
+ private:
+  std::vector<int32_t> mFirstEntry;        // per track, the most recently inserted entry
+  std::vector<int32_t> mEntryCollision;    // per entry, the collision of the pair
+  std::vector<int32_t> mEntryDerivedIndex; // per entry, the derived track index
+  std::vector<int32_t> mEntryNext;         // per entry, the previous entry of the same track
+};
+
+} // namespace jetderiveddatautilities
+
+#endif // PWGJE_CORE_JETDERIVEDDATAINDEXMAPS_H_
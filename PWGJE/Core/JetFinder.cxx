@@ -16,11 +16,16 @@
 
 #include "PWGJE/Core/JetFinder.h"
 
+#include <fastjet/AreaDefinition.hh>
+#include <fastjet/ClusterSequence.hh>
+#include <fastjet/ClusterSequenceActiveAreaExplicitGhosts.hh>
 #include <fastjet/ClusterSequenceArea.hh>
 #include <fastjet/JetDefinition.hh>
 #include <fastjet/PseudoJet.hh>
 #include <fastjet/Selector.hh>
 
+#include <cstddef>
+#include <memory>
 #include <vector>
 
 /// Sets the jet finding parameters
@@ -65,3 +70,43 @@ fastjet::ClusterSequenceArea JetFinder::findJets(std::vector<fastjet::PseudoJet>
   jets = fastjet::sorted_by_pt(jets);
   return clusterSeq;
 }
+
+/// Performs jet finding for several jet radii on the same input particles
+/// \param inputParticles vector of input particles/tracks
+/// \param jetRValues jet radii
+/// \param jets vector of jets for each jet radius to be filled
+void JetFinder::findJets(std::vector<fastjet::PseudoJet>& inputParticles, const std::vector<double>& jetRValues, std::vector<std::vector<fastjet::PseudoJet>>& jets)
+{
+  const bool doArea = ghostRepeatN > 0;
+  // a single set of ghosts can be clustered explicitly together with the particles, so it is generated once for all the radii
+  const bool useExplicitGhosts = doArea && ghostRepeatN == 1 && (areaType == fastjet::active_area || areaType == fastjet::active_area_explicit_ghosts);
+  clusterSequences.clear();
+  jets.resize(jetRValues.size());
+  for (std::size_t iR = 0; iR < jetRValues.size(); iR++) {
+    jetR = jetRValues[iR];
+    setParams();
+    jets[iR].clear();
+    if (useExplicitGhosts) {
+      if (iR == 0 && !(reuseGhosts && ghostsValid)) {
+        ghosts.clear();
+        ghostAreaSpec.add_ghosts(ghosts);
+        ghostsValid = true;
+      }
+      clusterSequences.push_back(std::make_shared<fastjet::ClusterSequenceActiveAreaExplicitGhosts>(inputParticles, jetDef, ghosts, ghostAreaSpec.actual_ghost_area()));
+      jets[iR] = (!fastjet::SelectorIsPureGhost() && selJets)(clusterSequences.back()->inclusive_jets());
+    } else if (doArea) {
+      clusterSequences.push_back(std::make_shared<fastjet::ClusterSequenceArea>(inputParticles, jetDef, areaDef));
+      jets[iR] = selJets(clusterSequences.back()->inclusive_jets());
+    } else {
+      clusterSequences.push_back(std::make_shared<fastjet::ClusterSequence>(inputParticles, jetDef));
+      jets[iR] = selJets(clusterSequences.back()->inclusive_jets());
+    }
+    jets[iR] = fastjet::sorted_by_pt(jets[iR]);
+  }
+}
+
+/// Removes the ghosts from a list of jet constituents
+std::vector<fastjet::PseudoJet> JetFinder::removeGhosts(const std::vector<fastjet::PseudoJet>& constituents)
+{
+  return (!fastjet::SelectorIsPureGhost())(constituents);
+}
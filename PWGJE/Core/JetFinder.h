@@ -19,6 +19,7 @@
 #define PWGJE_CORE_JETFINDER_H_
 
 #include <fastjet/AreaDefinition.hh>
+#include <fastjet/ClusterSequence.hh>
 #include <fastjet/ClusterSequenceArea.hh>
 #include <fastjet/GhostedAreaSpec.hh>
 #include <fastjet/JetDefinition.hh>
@@ -27,6 +28,7 @@
 
 #include <Rtypes.h>
 
+#include <memory>
 #include <vector>
 
 #include <math.h>
@@ -70,6 +72,7 @@ class JetFinder
 
   bool isReclustering = false;
   bool isTriggering = false;
+  bool reuseGhosts = false; // multi-radius jet finding: generate the ghosts once for all the events, instead of once per event
 
   fastjet::JetAlgorithm algorithm = fastjet::antikt_algorithm;
   fastjet::RecombinationScheme recombScheme = fastjet::E_scheme;
@@ -92,8 +95,24 @@ class JetFinder
   /// \return ClusterSequenceArea object needed to access constituents
   fastjet::ClusterSequenceArea findJets(std::vector<fastjet::PseudoJet>& inputParticles, std::vector<fastjet::PseudoJet>& jets); // ideally find a way of passing the cluster sequence as a reeference
 
+  /// Performs jet finding for several jet radii on the same input particles
+  /// \note the cluster sequences are owned by the JetFinder and stay valid until the next call, so the jets and their constituents can be used until then
+  /// \note the areas are calculated only if ghostRepeatN > 0. With one ghost repetition and active areas, the same explicit ghosts are used for all the radii
+  /// and they can be part of the jet constituents, use removeGhosts() to drop them
+  /// \param inputParticles vector of input particles/tracks
+  /// \param jetRValues jet radii
+  /// \param jets vector of jets for each jet radius to be filled
+  void findJets(std::vector<fastjet::PseudoJet>& inputParticles, const std::vector<double>& jetRValues, std::vector<std::vector<fastjet::PseudoJet>>& jets);
+
+  /// Removes the ghosts from a list of jet constituents
+  static std::vector<fastjet::PseudoJet> removeGhosts(const std::vector<fastjet::PseudoJet>& constituents);
+
  private:
-  ClassDefNV(JetFinder, 1);
+  std::vector<std::shared_ptr<fastjet::ClusterSequence>> clusterSequences; //! cluster sequences of the last multi-radius jet finding
+  std::vector<fastjet::PseudoJet> ghosts;                                  //! explicit ghosts shared by all the jet radii
+  bool ghostsValid = false;                                                //! ghosts have been generated
+
+  ClassDefNV(JetFinder, 2);
 };
 
 #endif // PWGJE_CORE_JETFINDER_H_
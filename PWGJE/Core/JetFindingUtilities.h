@@ -35,6 +35,7 @@
 #include <fastjet/PseudoJet.hh>
 
 #include <cmath>
+#include <cstddef>
 #include <memory>
 #include <string>
 #include <type_traits>
@@ -130,19 +131,19 @@ void analyseTracks(std::vector<fastjet::PseudoJet>& inputParticles, T const& tra
  * @param tracks track table to be added
  * @param trackSelection track selection to be applied to tracks
  * @param candidates candidiates
+ * @param daughterTracks lookup of the daughter tracks, filled here from the candidates
  */
 
 template <typename T, typename U>
-void analyseTracksMultipleCandidates(std::vector<fastjet::PseudoJet>& inputParticles, T const& tracks, int trackSelection, U const& candidates)
+void analyseTracksMultipleCandidates(std::vector<fastjet::PseudoJet>& inputParticles, T const& tracks, int trackSelection, U const& candidates, jetcandidateutilities::DaughterTrackLookup& daughterTracks)
 {
+  daughterTracks.build(candidates);
   for (auto& track : tracks) {
     if (!jetderiveddatautilities::selectTrack(track, trackSelection)) {
       continue;
     }
-    for (auto& candidate : candidates) {
-      if (jetcandidateutilities::isDaughterTrack(track, candidate)) {
-        continue;
-      }
+    if (daughterTracks.isDaughterTrack(track)) {
+      continue;
     }
     fastjetutilities::fillTracks(track, inputParticles, track.globalIndex());
   }
@@ -283,11 +284,12 @@ void findJets(JetFinder& jetFinder, std::vector<fastjet::PseudoJet>& inputPartic
   auto jetRValues = static_cast<std::vector<double>>(jetRadius);
   jetFinder.jetPtMin = jetPtMin;
   jetFinder.jetPtMax = jetPtMax;
-  for (auto R : jetRValues) {
-    jetFinder.jetR = R;
-    std::vector<fastjet::PseudoJet> jets;
-    fastjet::ClusterSequenceArea clusterSeq(jetFinder.findJets(inputParticles, jets));
-    for (const auto& jet : jets) {
+  std::vector<std::vector<fastjet::PseudoJet>> jetsPerR;
+  jetFinder.findJets(inputParticles, jetRValues, jetsPerR); // all the radii at once, the cluster sequences are kept in the jet finder
+  for (std::size_t iR = 0; iR < jetRValues.size(); iR++) {
+    const auto R = jetRValues[iR];
+    for (const auto& jet : jetsPerR[iR]) {
+      const auto constituents = JetFinder::removeGhosts(jet.constituents());
       if (jet.has_area() && jet.area() < jetAreaFractionMin * M_PI * R * R) {
         continue;
       }
@@ -296,7 +298,7 @@ void findJets(JetFinder& jetFinder, std::vector<fastjet::PseudoJet>& inputPartic
       }
       if (doCandidateJetFinding) {
         bool isCandidateJet = false;
-        for (const auto& constituent : jet.constituents()) {
+        for (const auto& constituent : constituents) {
           JetConstituentStatus constituentStatus = constituent.template user_info<fastjetutilities::fastjet_user_info>().getStatus();
           if (constituentStatus == JetConstituentStatus::candidate) { // note currently we cannot run V0 and HF in the same jet. If we ever need to we can seperate the loops
             isCandidateJet = true;
@@ -312,7 +314,7 @@ void findJets(JetFinder& jetFinder, std::vector<fastjet::PseudoJet>& inputPartic
       std::vector<int> clusters;
       jetsTable(collision.globalIndex(), jet.pt(), jet.eta(), jet.phi(),
                 jet.E(), jet.rapidity(), jet.m(), jet.has_area() ? jet.area() : 0., std::round(R * 100));
-      for (const auto& constituent : sorted_by_pt(jet.constituents())) {
+      for (const auto& constituent : sorted_by_pt(constituents)) {
         if (constituent.template user_info<fastjetutilities::fastjet_user_info>().getStatus() == JetConstituentStatus::track) {
           tracks.push_back(constituent.template user_info<fastjetutilities::fastjet_user_info>().getIndex());
         }
@@ -601,6 +601,36 @@ bool isHFDaughterTrack(T& track, U& candidate)
   }
 }
 
+/**
+ * calls f with the global index of each daughter track of the HF candidate, the same tracks as checked by isHFDaughterTrack
+ *
+ * @param candidate HF candidate
+ * @param f function called with the global index of the daughter track
+ */
+template <typename T, typename F>
+void forEachHFDaughterTrackId(T const& candidate, F&& f)
+{
+  if constexpr (isD0Candidate<T>()) {
+    f(candidate.prong0Id());
+    f(candidate.prong1Id());
+  } else if constexpr (isDplusCandidate<T>() || isDsCandidate<T>() || isDstarCandidate<T>() || isLcCandidate<T>() || isBplusCandidate<T>()) {
+    f(candidate.prong0Id());
+    f(candidate.prong1Id());
+    f(candidate.prong2Id());
+  } else if constexpr (isB0Candidate<T>()) {
+    f(candidate.prong0Id());
+    f(candidate.prong1Id());
+    f(candidate.prong2Id());
+    f(candidate.prong3Id());
+  } else if constexpr (isXicToXiPiPiCandidate<T>()) {
+    f(candidate.prong0Id());
+    f(candidate.prong1Id());
+    f(candidate.prong2Id());
+    f(candidate.prong3Id());
+    f(candidate.prong4Id());
+  }
+}
+
 /**
  * returns the JMcParticle matched to the HF candidate
  *
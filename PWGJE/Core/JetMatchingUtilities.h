@@ -33,6 +33,7 @@
 #include <RtypesCore.h>
 
 #include <algorithm>
+#include <cmath>
 #include <cstddef>
 #include <numeric>
 #include <ostream>
@@ -294,8 +295,163 @@ std::tuple<std::vector<int>, std::vector<int>> MatchJetsGeometrically(
   return std::make_tuple(baseToTagMap, tagToBaseMap);
 }
 
+/**
+ * Geometrical jet matching on an eta-phi grid.
+ *
+ * Same matching as `MatchJetsGeometrically`, without building KD-trees: the tag jets are sorted in cells
+ * of size (at least) maxMatchingDistance, so the closest jet within the matching distance of any point is
+ * always in one of the 3x3 surrounding cells. Phi is periodic on the grid, so the jets do not need to be
+ * duplicated around the phi boundary. The closest jets in both directions are found in a single loop over
+ * the base jets, as every base-tag pair within the matching distance is seen once.
+ *
+ * The buffers are kept between calls, so a matcher reused over the events does not allocate once it has
+ * grown to the largest event.
+ *
+ * NOTE: Among jets at the same distance, the one with the lowest index is taken.
+ */
+template <typename T>
+class JetGeoGridMatcher
+{
+ public:
+  /**
+   * @param jetsBasePhi Base jet collection phi.
+   * @param jetsBaseEta Base jet collection eta.
+   * @param jetsTagPhi Tag jet collection phi.
+   * @param jetsTagEta Tag jet collection eta.
+   * @param maxMatchingDistance Maximum matching distance.
+   * @param baseToTagMap Filled with the base to tag index map for uniquely matched jets (-1 if not matched).
+   * @param tagToBaseMap Filled with the tag to base index map for uniquely matched jets (-1 if not matched).
+   */
+  void match(const std::vector<T>& jetsBasePhi,
+             const std::vector<T>& jetsBaseEta,
+             const std::vector<T>& jetsTagPhi,
+             const std::vector<T>& jetsTagEta,
+             double maxMatchingDistance,
+             std::vector<int>& baseToTagMap,
+             std::vector<int>& tagToBaseMap)
+  {
+    const std::size_t nJetsBase = jetsBaseEta.size();
+    const std::size_t nJetsTag = jetsTagEta.size();
+    baseToTagMap.assign(nJetsBase, -1);
+    tagToBaseMap.assign(nJetsTag, -1);
+    if (!(nJetsBase && nJetsTag) || !(maxMatchingDistance > 0.)) {
+      return;
+    }
+    if (jetsBasePhi.size() != nJetsBase) {
+      throw std::invalid_argument("Base collection eta and phi sizes don't match. Check the inputs.");
+    }
+    if (jetsTagPhi.size() != nJetsTag) {
+      throw std::invalid_argument("Tag collection eta and phi sizes don't match. Check the inputs.");
+    }
+
+    buildGrid(jetsBaseEta, jetsTagPhi, jetsTagEta, maxMatchingDistance);
+
+    // closest jets and squared distances in both directions, only pairs within the matching distance are considered
+    const double maxDistance2 = maxMatchingDistance * maxMatchingDistance;
+    mClosestTag.assign(nJetsBase, -1);
+    mClosestBase.assign(nJetsTag, -1);
+    mDistance2Tag.assign(nJetsBase, maxDistance2);
+    mDistance2Base.assign(nJetsTag, maxDistance2);
+
+    for (std::size_t iBase = 0; iBase < nJetsBase; iBase++) {
+      const int etaBin = getEtaBin(jetsBaseEta[iBase]);
+      const int phiBin = getPhiBin(jetsBasePhi[iBase]);
+      const int nPhiNeighbours = mNPhiBins < 3 ? mNPhiBins : 3;
+      for (int iEta = std::max(etaBin - 1, 0); iEta <= std::min(etaBin + 1, mNEtaBins - 1); iEta++) {
+        for (int iPhiNeighbour = 0; iPhiNeighbour < nPhiNeighbours; iPhiNeighbour++) {
+          int iPhi = mNPhiBins < 3 ? iPhiNeighbour : phiBin - 1 + iPhiNeighbour;
+          iPhi = iPhi < 0 ? iPhi + mNPhiBins : (iPhi >= mNPhiBins ? iPhi - mNPhiBins : iPhi);
+          const int cell = iEta * mNPhiBins + iPhi;
+          for (int iEntry = mCellOffsets[cell]; iEntry < mCellOffsets[cell + 1]; iEntry++) {
+            const int iTag = mCellJets[iEntry];
+            const double deltaEta = jetsBaseEta[iBase] - jetsTagEta[iTag];
+            const double deltaPhi = getDeltaPhi(jetsBasePhi[iBase], jetsTagPhi[iTag]);
+            const double distance2 = deltaEta * deltaEta + deltaPhi * deltaPhi;
+            if (distance2 < mDistance2Tag[iBase] || (distance2 == mDistance2Tag[iBase] && iTag < mClosestTag[iBase])) {
+              mDistance2Tag[iBase] = distance2;
+              mClosestTag[iBase] = iTag;
+            }
+            if (distance2 < mDistance2Base[iTag]) { // base jets are looped in increasing index order
+              mDistance2Base[iTag] = distance2;
+              mClosestBase[iTag] = iBase;
+            }
+          }
+        }
+      }
+    }
+
+    // true matches are pairs where the base jet is the closest to the tag jet and vice versa
+    for (std::size_t iBase = 0; iBase < nJetsBase; iBase++) {
+      const int iTag = mClosestTag[iBase];
+      if (iTag > -1 && mClosestBase[iTag] == static_cast<int>(iBase)) {
+        LOG(debug) << "True match! base index: " << iBase << ", tag index: " << iTag << "\n";
+        baseToTagMap[iBase] = iTag;
+        tagToBaseMap[iTag] = iBase;
+      }
+    }
+  }
+
+ private:
+  // sort the tag jets in the grid cells (counting sort), the eta range covers both collections
+  void buildGrid(const std::vector<T>& jetsBaseEta, const std::vector<T>& jetsTagPhi, const std::vector<T>& jetsTagEta, double maxMatchingDistance)
+  {
+    const auto [baseEtaMin, baseEtaMax] = std::minmax_element(jetsBaseEta.begin(), jetsBaseEta.end());
+    const auto [tagEtaMin, tagEtaMax] = std::minmax_element(jetsTagEta.begin(), jetsTagEta.end());
+    mEtaMin = std::min<double>(*baseEtaMin, *tagEtaMin);
+    mEtaBinWidth = maxMatchingDistance;
+    mNEtaBins = static_cast<int>((std::max<double>(*baseEtaMax, *tagEtaMax) - mEtaMin) / mEtaBinWidth) + 1;
+    mNPhiBins = std::max(static_cast<int>(2 * M_PI / maxMatchingDistance), 1);
+    mPhiBinWidth = 2 * M_PI / mNPhiBins;
+
+    const std::size_t nJetsTag = jetsTagEta.size();
+    mCellOffsets.assign(mNEtaBins * mNPhiBins + 1, 0);
+    mTagCells.resize(nJetsTag);
+    for (std::size_t iTag = 0; iTag < nJetsTag; iTag++) {
+      mTagCells[iTag] = getEtaBin(jetsTagEta[iTag]) * mNPhiBins + getPhiBin(jetsTagPhi[iTag]);
+      mCellOffsets[mTagCells[iTag] + 1]++;
+    }
+    std::partial_sum(mCellOffsets.begin(), mCellOffsets.end(), mCellOffsets.begin());
+    mCellFill.assign(mCellOffsets.begin(), mCellOffsets.end() - 1);
+    mCellJets.resize(nJetsTag);
+    for (std::size_t iTag = 0; iTag < nJetsTag; iTag++) {
+      mCellJets[mCellFill[mTagCells[iTag]]++] = iTag;
+    }
+  }
+
+  int getEtaBin(double eta) const
+  {
+    return std::clamp(static_cast<int>((eta - mEtaMin) / mEtaBinWidth), 0, mNEtaBins - 1);
+  }
+
+  int getPhiBin(double phi) const
+  {
+    int bin = static_cast<int>(std::floor(phi / mPhiBinWidth)) % mNPhiBins;
+    return bin < 0 ? bin + mNPhiBins : bin;
+  }
+
+  static double getDeltaPhi(double phi1, double phi2)
+  {
+    double deltaPhi = std::fmod(std::abs(phi1 - phi2), 2 * M_PI);
+    return deltaPhi > M_PI ? 2 * M_PI - deltaPhi : deltaPhi;
+  }
+
+  double mEtaMin = 0.;
+  double mEtaBinWidth = 1.;
+  double mPhiBinWidth = 2 * M_PI;
+  int mNEtaBins = 1;
+  int mNPhiBins = 1;
+  std::vector<int> mCellOffsets;      // first entry of each cell in mCellJets, plus the total number of entries
+  std::vector<int> mCellFill;         // fill position of each cell while sorting the jets
+  std::vector<int> mTagCells;         // cell of each tag jet
+  std::vector<int> mCellJets;         // tag jet indices sorted by cell
+  std::vector<int> mClosestTag;       // closest tag jet of each base jet
+  std::vector<int> mClosestBase;      // closest base jet of each tag jet
+  std::vector<double> mDistance2Tag;  // squared distance to the closest tag jet of each base jet
+  std::vector<double> mDistance2Base; // squared distance to the closest base jet of each tag jet
+};
+
 template <typename T, typename U>
-void MatchGeo(T const& jetsBasePerCollision, U const& jetsTagPerCollision, std::vector<std::vector<int>>& baseToTagMatchingGeo, std::vector<std::vector<int>>& tagToBaseMatchingGeo, std::vector<double> const& jetRadiiForMatchingDistance, std::vector<double> const& maxMatchingDistancePerJetR)
+void MatchGeo(T const& jetsBasePerCollision, U const& jetsTagPerCollision, std::vector<std::vector<int>>& baseToTagMatchingGeo, std::vector<std::vector<int>>& tagToBaseMatchingGeo, std::vector<double> const& jetRadiiForMatchingDistance, std::vector<double> const& maxMatchingDistancePerJetR, JetGeoGridMatcher<double>& geoMatcher)
 {
   std::vector<double> jetsR;
   for (const auto& jetBase : jetsBasePerCollision) {
@@ -344,7 +500,7 @@ void MatchGeo(T const& jetsBasePerCollision, U const& jetsTagPerCollision, std::
       jetsTagEta.emplace_back(jetTag.eta());
       jetsTagGlobalIndex.emplace_back(jetTag.globalIndex());
     }
-    std::tie(baseToTagMatchingGeoIndex, tagToBaseMatchingGeoIndex) = MatchJetsGeometrically(jetsBasePhi, jetsBaseEta, jetsTagPhi, jetsTagEta, effectiveMatchingDistance);
+    geoMatcher.match(jetsBasePhi, jetsBaseEta, jetsTagPhi, jetsTagEta, effectiveMatchingDistance, baseToTagMatchingGeoIndex, tagToBaseMatchingGeoIndex);
     int jetBaseIndex = 0;
     int jetTagIndex = 0;
     for (const auto& jetBase : jetsBasePerCollision) {
@@ -373,6 +529,13 @@ void MatchGeo(T const& jetsBasePerCollision, U const& jetsTagPerCollision, std::
   }
 }
 
+template <typename T, typename U>
+void MatchGeo(T const& jetsBasePerCollision, U const& jetsTagPerCollision, std::vector<std::vector<int>>& baseToTagMatchingGeo, std::vector<std::vector<int>>& tagToBaseMatchingGeo, std::vector<double> const& jetRadiiForMatchingDistance, std::vector<double> const& maxMatchingDistancePerJetR)
+{
+  JetGeoGridMatcher<double> geoMatcher;
+  MatchGeo(jetsBasePerCollision, jetsTagPerCollision, baseToTagMatchingGeo, tagToBaseMatchingGeo, jetRadiiForMatchingDistance, maxMatchingDistancePerJetR, geoMatcher);
+}
+
 // function that does the HF matching of jets from jetsBasePerColl and jets from jetsTagPerColl; assumes both jetsBasePerColl and jetsTagPerColl have access to Mc information
 template <bool jetsBaseIsMc, bool jetsTagIsMc, typename T, typename U, typename V, typename M, typename N, typename O>
 void MatchHF(T const& jetsBasePerCollision, U const& jetsTagPerCollision, std::vector<std::vector<int>>& baseToTagMatchingHF, std::vector<std::vector<int>>& tagToBaseMatchingHF, V const& /*candidatesBase*/, M const& /*candidatesTag*/, N const& tracksBase, O const& tracksTag)
@@ -575,12 +738,13 @@ void MatchPt(T const& jetsBasePerCollision, U const& jetsTagPerCollision, std::v
 }
 
 // function that calls all the Match functions
+// the geometric matcher keeps its buffers between calls, it can be a member of the matching task
 template <bool jetsBaseIsMc, bool jetsTagIsMc, typename T, typename U, typename V, typename M, typename N, typename O, typename P, typename R>
-void doAllMatching(T const& jetsBasePerCollision, U const& jetsTagPerCollision, std::vector<std::vector<int>>& baseToTagMatchingGeo, std::vector<std::vector<int>>& baseToTagMatchingPt, std::vector<std::vector<int>>& baseToTagMatchingHF, std::vector<std::vector<int>>& tagToBaseMatchingGeo, std::vector<std::vector<int>>& tagToBaseMatchingPt, std::vector<std::vector<int>>& tagToBaseMatchingHF, V const& candidatesBase, M const& tracksBase, N const& clustersBase, O const& candidatesTag, P const& tracksTag, R const& clustersTag, bool doMatchingGeo, bool doMatchingHf, bool doMatchingPt, float minPtFraction, std::vector<double> const& jetRadiiForMatchingDistance, std::vector<double> const& maxMatchingDistancePerJetR)
+void doAllMatching(T const& jetsBasePerCollision, U const& jetsTagPerCollision, std::vector<std::vector<int>>& baseToTagMatchingGeo, std::vector<std::vector<int>>& baseToTagMatchingPt, std::vector<std::vector<int>>& baseToTagMatchingHF, std::vector<std::vector<int>>& tagToBaseMatchingGeo, std::vector<std::vector<int>>& tagToBaseMatchingPt, std::vector<std::vector<int>>& tagToBaseMatchingHF, V const& candidatesBase, M const& tracksBase, N const& clustersBase, O const& candidatesTag, P const& tracksTag, R const& clustersTag, bool doMatchingGeo, bool doMatchingHf, bool doMatchingPt, float minPtFraction, std::vector<double> const& jetRadiiForMatchingDistance, std::vector<double> const& maxMatchingDistancePerJetR, JetGeoGridMatcher<double>& geoMatcher)
 {
   // geometric matching
   if (doMatchingGeo) {
-    MatchGeo(jetsBasePerCollision, jetsTagPerCollision, baseToTagMatchingGeo, tagToBaseMatchingGeo, jetRadiiForMatchingDistance, maxMatchingDistancePerJetR);
+    MatchGeo(jetsBasePerCollision, jetsTagPerCollision, baseToTagMatchingGeo, tagToBaseMatchingGeo, jetRadiiForMatchingDistance, maxMatchingDistancePerJetR, geoMatcher);
   }
   // pt matching
   if (doMatchingPt) {
@@ -594,6 +758,13 @@ void doAllMatching(T const& jetsBasePerCollision, U const& jetsTagPerCollision,
   }
 }
 
+template <bool jetsBaseIsMc, bool jetsTagIsMc, typename T, typename U, typename V, typename M, typename N, typename O, typename P, typename R>
+void doAllMatching(T const& jetsBasePerCollision, U const& jetsTagPerCollision, std::vector<std::vector<int>>& baseToTagMatchingGeo, std::vector<std::vector<int>>& baseToTagMatchingPt, std::vector<std::vector<int>>& baseToTagMatchingHF, std::vector<std::vector<int>>& tagToBaseMatchingGeo, std::vector<std::vector<int>>& tagToBaseMatchingPt, std::vector<std::vector<int>>& tagToBaseMatchingHF, V const& candidatesBase, M const& tracksBase, N const& clustersBase, O const& candidatesTag, P const& tracksTag, R const& clustersTag, bool doMatchingGeo, bool doMatchingHf, bool doMatchingPt, float minPtFraction, std::vector<double> const& jetRadiiForMatchingDistance, std::vector<double> const& maxMatchingDistancePerJetR)
+{
+  JetGeoGridMatcher<double> geoMatcher;
+  doAllMatching<jetsBaseIsMc, jetsTagIsMc>(jetsBasePerCollision, jetsTagPerCollision, baseToTagMatchingGeo, baseToTagMatchingPt, baseToTagMatchingHF, tagToBaseMatchingGeo, tagToBaseMatchingPt, tagToBaseMatchingHF, candidatesBase, tracksBase, clustersBase, candidatesTag, tracksTag, clustersTag, doMatchingGeo, doMatchingHf, doMatchingPt, minPtFraction, jetRadiiForMatchingDistance, maxMatchingDistancePerJetR, geoMatcher);
+}
+
 // function that does pair matching
 template <bool jetsBaseIsMc, bool jetsTagIsMc, typename T, typename U, typename V, typename M, typename N, typename O>
 void doPairMatching(T const& pairsBase, U const& pairsTag, std::vector<std::vector<int>>& baseToTagMatching, std::vector<std::vector<int>>& tagToBaseMatching, V const& /*candidatesBase*/, M const& tracksBase, N const& /*candidatesTag*/, O const& tracksTag)
@@ -0,0 +1,159 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file JetObservablesUtilities.h
+/// \brief Jet shape observables computed from the constituents of a jet loaded once as arrays
+///
+/// The constituents of a jet are copied once into a struct of arrays, together with their distance to the jet axis.
+/// All the angularities and the radial profile of the jet are then computed from these arrays, without going through
+/// the table iterators and without computing the distance to the axis again for every observable.
+
+#ifndef PWGJE_CORE_JETOBSERVABLESUTILITIES_H_
+#define PWGJE_CORE_JETOBSERVABLESUTILITIES_H_
+
+#include "PWGJE/Core/JetUtilities.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace jetobservablesutilities
+{
+
+/**
+ * constituents of one jet, with their distance to the jet axis
+ */
+struct JetConstituentArrays {
+  std::vector<float> pt;
+  std::vector<float> eta;
+  std::vector<float> phi;
+  std::vector<float> deltaR; /// distance to the jet axis, as given by jetutilities::deltaR
+
+  void clear()
+  {
+    pt.clear();
+    eta.clear();
+    phi.clear();
+    deltaR.clear();
+  }
+
+  std::size_t size() const { return pt.size(); }
+
+  template <typename T, typename U>
+  void add(T const& jet, U const& constituent)
+  {
+    pt.push_back(constituent.pt());
+    eta.push_back(constituent.eta());
+    phi.push_back(constituent.phi());
+    deltaR.push_back(jetutilities::deltaR(jet, constituent));
+  }
+
+  /**
+   * replaces the content with the given constituents of the jet
+   *
+   * @param jet jet whose axis is used for the distances
+   * @param constituents range of constituents (tracks, particles or clusters with pt, eta and phi)
+   */
+  template <typename T, typename U>
+  void fill(T const& jet, U const& constituents)
+  {
+    clear();
+    for (auto const& constituent : constituents) {
+      add(jet, constituent);
+    }
+  }
+};
+
+// x^a, without calling pow for the usual exponents
+inline float power(float x, float a)
+{
+  if (a == 1.f) {
+    return x;
+  }
+  if (a == 2.f) {
+    return x * x;
+  }
+  return std::pow(x, a);
+}
+
+/**
+ * sum over the constituents of pt^kappa * (deltaR / rScale)^alpha, the normalisation is left to the caller
+ *
+ * @param constituents constituents of the jet
+ * @param kappa exponent of the constituent pt
+ * @param alpha exponent of the distance to the jet axis
+ * @param rScale scale of the distance to the jet axis, e.g. the jet radius
+ */
+inline float angularity(JetConstituentArrays const& constituents, float kappa, float alpha, float rScale = 1.f)
+{
+  float sum = 0.f;
+  for (std::size_t i = 0; i < constituents.size(); i++) {
+    sum += power(constituents.pt[i], kappa) * power(constituents.deltaR[i] / rScale, alpha);
+  }
+  return sum;
+}
+
+/**
+ * angularity of the constituents for each (kappa, alpha) combination, in one pass over the constituents
+ *
+ * @param constituents constituents of the jet
+ * @param kappaAlpha (kappa, alpha) combinations
+ * @param rScale scale of the distance to the jet axis, e.g. the jet radius
+ * @param angularities sums of the combinations, in the same order
+ */
+inline void angularities(JetConstituentArrays const& constituents, std::vector<std::pair<float, float>> const& kappaAlpha, float rScale, std::vector<float>& angularities)
+{
+  angularities.assign(kappaAlpha.size(), 0.f);
+  for (std::size_t i = 0; i < constituents.size(); i++) {
+    const float distance = constituents.deltaR[i] / rScale;
+    for (std::size_t j = 0; j < kappaAlpha.size(); j++) {
+      angularities[j] += power(constituents.pt[i], kappaAlpha[j].first) * power(distance, kappaAlpha[j].second);
+    }
+  }
+}
+
+/**
+ * index of the bin of the distance, for the ascending bin edges, -1 if it is outside
+ *
+ * @param edges ascending bin edges
+ * @param distance value to be binned, in [edges[k], edges[k + 1]) for bin k
+ */
+inline int findRadialBin(std::vector<float> const& edges, float distance)
+{
+  if (edges.size() < 2 || !(distance >= edges.front()) || !(distance < edges.back())) {
+    return -1;
+  }
+  return std::upper_bound(edges.begin(), edges.end(), distance) - edges.begin() - 1;
+}
+
+/**
+ * scalar pt sum of the constituents in each bin of the distance to the jet axis
+ *
+ * @param constituents constituents of the jet
+ * @param edges ascending bin edges of the distance
+ * @param ptSum pt sum per bin, resized to the number of bins
+ */
+inline void radialProfile(JetConstituentArrays const& constituents, std::vector<float> const& edges, std::vector<float>& ptSum)
+{
+  ptSum.assign(edges.size() > 1 ? edges.size() - 1 : 0, 0.f);
+  for (std::size_t i = 0; i < constituents.size(); i++) {
+    const int bin = findRadialBin(edges, constituents.deltaR[i]);
+    if (bin >= 0) {
+      ptSum[bin] += constituents.pt[i];
+    }
+  }
+}
+
+}; // namespace jetobservablesutilities
+
+#endif // PWGJE_CORE_JETOBSERVABLESUTILITIES_H_
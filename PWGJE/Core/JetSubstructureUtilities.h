@@ -45,9 +45,10 @@ namespace jetsubstructureutilities
  * @param clusters vector of constituent clusters
  * @param candidates vector of constituent candidates
  * @param pseudoJet converted pseudoJet object which is passed by reference
+ * @param doArea calculate the jet areas with ghosts, not needed for the substructure observables
  */
 template <typename T, typename U, typename V, typename O>
-fastjet::ClusterSequenceArea jetToPseudoJet(T const& jet, U const& /*tracks*/, V const& /*clusters*/, O const& /*candidates*/, fastjet::PseudoJet& pseudoJet, int hadronicCorrectionType = 0)
+fastjet::ClusterSequenceArea jetToPseudoJet(T const& jet, U const& /*tracks*/, V const& /*clusters*/, O const& /*candidates*/, fastjet::PseudoJet& pseudoJet, int hadronicCorrectionType = 0, bool doArea = true)
 {
   std::vector<fastjet::PseudoJet> jetConstituents;
   for (auto& jetConstituent : jet.template tracks_as<U>()) {
@@ -68,6 +69,9 @@ fastjet::ClusterSequenceArea jetToPseudoJet(T const& jet, U const& /*tracks*/, V
   JetFinder jetReclusterer;
   jetReclusterer.isReclustering = true;
   jetReclusterer.jetR = jet.r() / 100.0;
+  if (!doArea) {
+    jetReclusterer.ghostRepeatN = 0;
+  }
   fastjet::ClusterSequenceArea clusterSeq = jetReclusterer.findJets(jetConstituents, jetReclustered);
   jetReclustered = sorted_by_pt(jetReclustered);
   pseudoJet = jetReclustered[0];
@@ -88,13 +92,11 @@ fastjet::ClusterSequenceArea jetToPseudoJet(T const& jet, U const& /*tracks*/, V
  * @param beta angular exponent in the SoftDrop condition
  */
 
-// function that returns the N-subjettiness ratio and the distance betewwen the two axes considered for tau2, in the form of a vector
-template <typename T, typename U, typename V, typename O, typename M>
-std::vector<float> getNSubjettiness(T const& jet, U const& tracks, V const& clusters, O const& candidates, std::vector<fastjet::PseudoJet>::size_type nMax, M const& reclusteringAlgorithm, bool doSoftDrop = false, float zCut = 0.1, float beta = 0.0, int hadronicCorrectionType = 0)
+// same as below for a jet which is already reclustered, e.g. with jetToPseudoJet, so that several observables can be computed from one reclustering
+template <typename M>
+std::vector<float> getNSubjettiness(fastjet::PseudoJet pseudoJet, float jetR, std::vector<fastjet::PseudoJet>::size_type nMax, M const& reclusteringAlgorithm, bool doSoftDrop = false, float zCut = 0.1, float beta = 0.0)
 {
   std::vector<float> result;
-  fastjet::PseudoJet pseudoJet;
-  fastjet::ClusterSequenceArea clusterSeq(jetToPseudoJet(jet, tracks, clusters, candidates, pseudoJet, hadronicCorrectionType));
   if (doSoftDrop) {
     fastjet::contrib::SoftDrop softDrop(beta, zCut);
     pseudoJet = softDrop(pseudoJet);
@@ -108,7 +110,7 @@ std::vector<float> getNSubjettiness(T const& jet, U const& tracks, V const& clus
     if (pseudoJet.constituents().size() < n) { // Tau_N needs at least N tracks
       return result;
     }
-    fastjet::contrib::Nsubjettiness nSub(n, reclusteringAlgorithm, fastjet::contrib::NormalizedMeasure(1.0, jet.r() / 100.0));
+    fastjet::contrib::Nsubjettiness nSub(n, reclusteringAlgorithm, fastjet::contrib::NormalizedMeasure(1.0, jetR));
     result[n] = nSub.result(pseudoJet);
     if (n == 2) {
       std::vector<fastjet::PseudoJet> nSubAxes = nSub.currentAxes(); // gets the two axes used in the 2-subjettiness calculation
@@ -118,6 +120,16 @@ std::vector<float> getNSubjettiness(T const& jet, U const& tracks, V const& clus
   return result;
 }
 
+// function that returns the N-subjettiness ratio and the distance betewwen the two axes considered for tau2, in the form of a vector
+// the jet areas are not needed, the jet is reclustered without ghosts
+template <typename T, typename U, typename V, typename O, typename M>
+std::vector<float> getNSubjettiness(T const& jet, U const& tracks, V const& clusters, O const& candidates, std::vector<fastjet::PseudoJet>::size_type nMax, M const& reclusteringAlgorithm, bool doSoftDrop = false, float zCut = 0.1, float beta = 0.0, int hadronicCorrectionType = 0)
+{
+  fastjet::PseudoJet pseudoJet;
+  fastjet::ClusterSequenceArea clusterSeq(jetToPseudoJet(jet, tracks, clusters, candidates, pseudoJet, hadronicCorrectionType, false));
+  return getNSubjettiness(pseudoJet, jet.r() / 100.0, nMax, reclusteringAlgorithm, doSoftDrop, zCut, beta);
+}
+
 }; // namespace jetsubstructureutilities
 
 #endif // PWGJE_CORE_JETSUBSTRUCTUREUTILITIES_H_
@@ -92,6 +92,21 @@ bool isV0DaughterTrack(T& track, U& candidate)
   }
 }
 
+/**
+ * calls f with the global index of each daughter track of the V0 candidate
+ *
+ * @param candidate V0 candidate
+ * @param f function called with the global index of the daughter track
+ */
+template <typename T, typename F>
+void forEachV0DaughterTrackId(T const& candidate, F&& f)
+{
+  if constexpr (isV0Candidate<T>()) {
+    f(candidate.posTrackId());
+    f(candidate.negTrackId());
+  }
+}
+
 /**
  * returns the index of the JMcParticle matched to the V0 candidate
  *
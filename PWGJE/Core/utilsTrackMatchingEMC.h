@@ -16,31 +16,131 @@
 #ifndef PWGJE_CORE_UTILSTRACKMATCHINGEMC_H_
 #define PWGJE_CORE_UTILSTRACKMATCHINGEMC_H_
 
-#include <TKDTree.h>
-
 #include <algorithm>
 #include <cmath>
 #include <cstddef>
 #include <limits>
 #include <span>
 #include <stdexcept>
+#include <utility>
 #include <vector>
 
 namespace tmemcutilities
 {
 
+/// Matches of all the clusters of an event, in compressed sparse row layout:
+/// the matches of the cluster i are at the positions [offsets[i], offsets[i + 1]) of the flat arrays,
+/// ordered by increasing distance
 struct MatchResult {
-  std::vector<std::vector<int>> matchIndexTrack;
-  std::vector<std::vector<float>> matchDeltaPhi;
-  std::vector<std::vector<float>> matchDeltaEta;
+  std::vector<int> offsets;
+  std::vector<int> matchIndexTrack;
+  std::vector<float> matchDeltaPhi;
+  std::vector<float> matchDeltaEta;
+
+  std::size_t nClusters() const { return offsets.empty() ? 0 : offsets.size() - 1; }
+  int firstMatch(std::size_t iCluster) const { return offsets[iCluster]; }
+  int lastMatch(std::size_t iCluster) const { return offsets[iCluster + 1]; }
+  void clear()
+  {
+    offsets.clear();
+    matchIndexTrack.clear();
+    matchDeltaPhi.clear();
+    matchDeltaEta.clear();
+  }
+};
+
+/// Fixed eta-phi grid covering the EMCal and DCal acceptance, used to find the tracks close to a cluster.
+/// The cells are at least as large as the matching distance, so all the tracks within the matching distance of a
+/// cluster are in the cell of the cluster or in one of its neighbours. Values outside of the grid are put in the
+/// border cells, which keeps this property. The buffers are kept between the events.
+class MatchingGrid
+{
+ public:
+  static constexpr float EtaMin = -1.f;
+  static constexpr float EtaMax = 1.f;
+  static constexpr float PhiMin = 0.f;
+  static constexpr float PhiMax = 2.f * static_cast<float>(M_PI);
+  static constexpr int MaxCellsPerAxis = 128;
+
+  /// Buckets the tracks in the cells of the grid, with one counting pass and one filling pass
+  void build(std::span<const float> trackPhi, std::span<const float> trackEta, double cellSize)
+  {
+    mNEta = nCells(EtaMax - EtaMin, cellSize);
+    mNPhi = nCells(PhiMax - PhiMin, cellSize);
+    mTrackPhi = trackPhi;
+    mTrackEta = trackEta;
+    mCellStart.assign(static_cast<std::size_t>(mNEta) * mNPhi + 1, 0);
+    mTrackCell.resize(trackEta.size());
+    for (std::size_t iTrack = 0; iTrack < trackEta.size(); iTrack++) {
+      mTrackCell[iTrack] = cell(etaBin(trackEta[iTrack]), phiBin(trackPhi[iTrack]));
+      mCellStart[mTrackCell[iTrack] + 1]++;
+    }
+    for (std::size_t iCell = 1; iCell < mCellStart.size(); iCell++) {
+      mCellStart[iCell] += mCellStart[iCell - 1];
+    }
+    mCellTracks.resize(trackEta.size());
+    mFill.assign(mCellStart.begin(), mCellStart.end() - 1);
+    for (std::size_t iTrack = 0; iTrack < trackEta.size(); iTrack++) {
+      mCellTracks[mFill[mTrackCell[iTrack]]++] = iTrack;
+    }
+  }
+
+  /// Appends to result the maxNumberMatches closest tracks with a distance below maxMatchingDistance
+  void findMatches(float phi, float eta, double maxMatchingDistance, int maxNumberMatches, MatchResult& result)
+  {
+    mCandidates.clear();
+    const int iEta = etaBin(eta);
+    const int iPhi = phiBin(phi);
+    for (int jEta = std::max(iEta - 1, 0); jEta <= std::min(iEta + 1, mNEta - 1); jEta++) {
+      for (int jPhi = std::max(iPhi - 1, 0); jPhi <= std::min(iPhi + 1, mNPhi - 1); jPhi++) {
+        const int iCell = cell(jEta, jPhi);
+        for (int i = mCellStart[iCell]; i < mCellStart[iCell + 1]; i++) {
+          const int iTrack = mCellTracks[i];
+          const float dEta = eta - mTrackEta[iTrack];
+          const float dPhi = phi - mTrackPhi[iTrack];
+          const float distance = std::sqrt(dEta * dEta + dPhi * dPhi);
+          if (distance < maxMatchingDistance) {
+            mCandidates.emplace_back(distance, iTrack);
+          }
+        }
+      }
+    }
+    const auto nMatches = std::min<std::size_t>(mCandidates.size(), std::max(maxNumberMatches, 0));
+    std::partial_sort(mCandidates.begin(), mCandidates.begin() + nMatches, mCandidates.end());
+    for (std::size_t m = 0; m < nMatches; m++) {
+      const int iTrack = mCandidates[m].second;
+      result.matchIndexTrack.push_back(iTrack);
+      result.matchDeltaPhi.push_back(mTrackPhi[iTrack] - phi);
+      result.matchDeltaEta.push_back(mTrackEta[iTrack] - eta);
+    }
+  }
+
+ private:
+  int etaBin(float eta) const { return std::clamp(static_cast<int>((eta - EtaMin) / (EtaMax - EtaMin) * mNEta), 0, mNEta - 1); }
+  int phiBin(float phi) const { return std::clamp(static_cast<int>((phi - PhiMin) / (PhiMax - PhiMin) * mNPhi), 0, mNPhi - 1); }
+  int cell(int iEta, int iPhi) const { return iEta * mNPhi + iPhi; }
+  static int nCells(float range, double cellSize)
+  {
+    return cellSize > range / MaxCellsPerAxis ? std::max(static_cast<int>(range / cellSize), 1) : MaxCellsPerAxis;
+  }
+
+  int mNEta = 1;
+  int mNPhi = 1;
+  std::span<const float> mTrackPhi;
+  std::span<const float> mTrackEta;
+  std::vector<int> mCellStart; // first track of each cell in mCellTracks
+  std::vector<int> mCellTracks;
+  std::vector<int> mTrackCell;
+  std::vector<int> mFill;
+  std::vector<std::pair<float, int>> mCandidates;
 };
 
 /**
  * Match clusters and tracks.
  *
  * Match cluster with tracks, where maxNumberMatches are considered in dR=maxMatchingDistance.
- * If no unique match was found for a jet, an index of -1 is stored.
- * The same map is created for clusters matched to tracks e.g. for electron analyses.
+ * The distance is computed in the (eta, phi) plane, the matches of each cluster are ordered by distance.
+ * The tracks are bucketed in the grid, which is reused between the calls.
  *
  * @param clusterPhi cluster collection phi.
  * @param clusterEta cluster collection eta.
@@ -48,24 +148,26 @@ struct MatchResult {
  * @param trackEta track collection eta.
  * @param maxMatchingDistance Maximum matching distance.
  * @param maxNumberMatches Maximum number of matches (e.g. 5 closest).
- *
- * @returns (cluster to track index map, track to cluster index map)
+ * @param grid grid of the tracks, rebuilt for each call.
+ * @param result cluster to track index map, overwritten.
  */
-MatchResult matchTracksToCluster(
-  std::span<float> clusterPhi,
-  std::span<float> clusterEta,
-  std::span<float> trackPhi,
-  std::span<float> trackEta,
+inline void matchTracksToCluster(
+  std::span<const float> clusterPhi,
+  std::span<const float> clusterEta,
+  std::span<const float> trackPhi,
+  std::span<const float> trackEta,
   double maxMatchingDistance,
-  int maxNumberMatches)
+  int maxNumberMatches,
+  MatchingGrid& grid,
+  MatchResult& result)
 {
   const std::size_t nClusters = clusterEta.size();
   const std::size_t nTracks = trackEta.size();
-  MatchResult result;
+  result.clear();
 
   if (nClusters == 0 || nTracks == 0) {
-    // There are no jets, so nothing to be done.
-    return result;
+    // There are no clusters or tracks, so nothing to be done.
+    return;
   }
   // Input sizes must match
   if (clusterPhi.size() != clusterEta.size()) {
@@ -75,44 +177,13 @@ MatchResult matchTracksToCluster(
     throw std::invalid_argument("track collection eta and phi sizes don't match. Check the inputs.");
   }
 
-  result.matchIndexTrack.resize(nClusters);
-  result.matchDeltaPhi.resize(nClusters);
-  result.matchDeltaEta.resize(nClusters);
-
-  // Build the KD-trees using vectors
-  // We build two trees:
-  // treeBase, which contains the base collection.
-  // treeTag, which contains the tag collection.
-  // The trees are built to match in two dimensions (eta, phi)
-  TKDTree<int, float> treeTrack(trackEta.size(), 2, 1);
-  treeTrack.SetData(0, trackEta.data());
-  treeTrack.SetData(1, trackPhi.data());
-  treeTrack.Build();
-
-  // Find the track closest to each cluster.
+  grid.build(trackPhi, trackEta, maxMatchingDistance);
+  result.offsets.reserve(nClusters + 1);
+  result.offsets.push_back(0);
   for (std::size_t iCluster = 0; iCluster < nClusters; iCluster++) {
-    float point[2] = {clusterEta[iCluster], clusterPhi[iCluster]};
-    int index[50];      // size 50 for safety
-    float distance[50]; // size 50 for safery
-    std::fill_n(index, 50, -1);
-    std::fill_n(distance, 50, std::numeric_limits<float>::max());
-    treeTrack.FindNearestNeighbors(point, maxNumberMatches, index, distance);
-
-    // allocate enough memory
-    result.matchIndexTrack[iCluster].reserve(maxNumberMatches);
-    result.matchDeltaPhi[iCluster].reserve(maxNumberMatches);
-    result.matchDeltaEta[iCluster].reserve(maxNumberMatches);
-
-    // test whether indices are matching:
-    for (int m = 0; m < maxNumberMatches; m++) {
-      if (index[m] >= 0 && distance[m] < maxMatchingDistance) {
-        result.matchIndexTrack[iCluster].push_back(index[m]);
-        result.matchDeltaPhi[iCluster].push_back(trackPhi[index[m]] - clusterPhi[iCluster]);
-        result.matchDeltaEta[iCluster].push_back(trackEta[index[m]] - clusterEta[iCluster]);
-      }
-    }
+    grid.findMatches(clusterPhi[iCluster], clusterEta[iCluster], maxMatchingDistance, maxNumberMatches, result);
+    result.offsets.push_back(static_cast<int>(result.matchIndexTrack.size()));
   }
-  return result;
 }
 }; // namespace tmemcutilities
 
@@ -14,6 +14,7 @@
 /// \author Nima Zardoshti <nima.zardoshti@cern.ch>
 
 #include "PWGJE/Core/JetDQUtilities.h"
+#include "PWGJE/Core/JetDerivedDataIndexMaps.h"
 #include "PWGJE/Core/JetDerivedDataUtilities.h"
 #include "PWGJE/Core/JetV0Utilities.h"
 #include "PWGJE/DataModel/EMCALClusters.h"
@@ -64,7 +65,6 @@
 #include <cstddef>
 #include <cstdint>
 #include <iterator>
-#include <map>
 #include <string>
 #include <utility>
 #include <vector>
@@ -179,7 +179,7 @@ struct JetDerivedDataProducerTask {
     Preslice<aod::TrackAssoc> perCollisionTrackIndices = aod::track_association::collisionId;
   } preslices;
 
-  std::map<std::pair<int32_t, int32_t>, int32_t> trackCollisionMapping;
+  jetderiveddatautilities::TrackCollisionIndexMap trackCollisionMapping;
   Service<o2::ccdb::BasicCCDBManager> ccdb;
   o2::base::MatLayerCylSet* lut;
   o2::base::Propagator::MatCorrType noMatCorr = o2::base::Propagator::MatCorrType::USEMatCorrNONE;
@@ -240,7 +240,7 @@ struct JetDerivedDataProducerTask {
 
   void processClearMaps(aod::Collisions const& collisions, aod::Tracks const& tracks)
   {
-    trackCollisionMapping.clear();
+    trackCollisionMapping.reset(tracks.size());
     trackMCSelection.clear();
     trackMCSelection.resize(tracks.size(), true);
     if (config.applyTrackingEfficiency) {
@@ -500,7 +500,7 @@ struct JetDerivedDataProducerTask {
 
     products.jTracksExtraTable(dcaX, dcaY, track.dcaZ(), track.dcaXY(), dcaXYZ, std::sqrt(track.sigmaDcaZ2()), std::sqrt(track.sigmaDcaXY2()), std::sqrt(sigmaDCAXYZ2), track.sigma1Pt()); // why is this getSigmaZY
     products.jTracksParentIndexTable(track.globalIndex());
-    trackCollisionMapping[{track.globalIndex(), track.collisionId()}] = products.jTracksTable.lastIndex();
+    trackCollisionMapping.insert(track.globalIndex(), track.collisionId(), products.jTracksTable.lastIndex());
   }
   PROCESS_SWITCH(JetDerivedDataProducerTask, processTracks, "produces derived track table", true);
 
@@ -545,7 +545,7 @@ struct JetDerivedDataProducerTask {
           }
           products.jTracksExtraTable(xyzTrack.X() - collision.posX(), xyzTrack.Y() - collision.posY(), dcaZ, dcaXY, dcaXYZ, std::sqrt(covZZ), std::sqrt(covYY), std::sqrt(sigmaDCAXYZ), std::sqrt(trackParCov.getSigma1Pt2()));
         }
-        trackCollisionMapping[{track.globalIndex(), collision.globalIndex()}] = products.jTracksTable.lastIndex();
+        trackCollisionMapping.insert(track.globalIndex(), collision.globalIndex(), products.jTracksTable.lastIndex());
       }
     }
   }
@@ -562,7 +562,7 @@ struct JetDerivedDataProducerTask {
 
     products.jTracksExtraTable(dcaX, dcaY, track.dcaZ(), track.dcaXY(), dcaXYZ, std::sqrt(1.), std::sqrt(1.), std::sqrt(sigmaDCAXYZ2), track.sigma1Pt()); // dummy values - will be fixed when TracksDCACov table is available for Run 2
     products.jTracksParentIndexTable(track.globalIndex());
-    trackCollisionMapping[{track.globalIndex(), track.collisionId()}] = products.jTracksTable.lastIndex();
+    trackCollisionMapping.insert(track.globalIndex(), track.collisionId(), products.jTracksTable.lastIndex());
   }
   PROCESS_SWITCH(JetDerivedDataProducerTask, processTracksRun2, "produces derived track table for Run2 AO2Ds", false);
 
@@ -647,10 +647,10 @@ struct JetDerivedDataProducerTask {
       auto const clusterTracks = matchedTracks.sliceBy(preslices.perClusterTracks, cluster.globalIndex());
       std::vector<int32_t> clusterTrackIDs;
       for (const auto& clusterTrack : clusterTracks) {
-        auto JClusterID = trackCollisionMapping.find({clusterTrack.trackId(), cluster.collisionId()}); // does EMCal use its own associator?
-        clusterTrackIDs.push_back(JClusterID->second);
+        auto JClusterID = trackCollisionMapping.find(clusterTrack.trackId(), cluster.collisionId()); // does EMCal use its own associator?
+        clusterTrackIDs.push_back(JClusterID);
         auto emcTrack = clusterTrack.track_as<soa::Join<aod::Tracks, aod::TracksExtra>>();
-        products.jTracksEMCalTable(JClusterID->second, emcTrack.trackEtaEmcal(), emcTrack.trackPhiEmcal(), clusterTrack.deltaEta(), clusterTrack.deltaPhi());
+        products.jTracksEMCalTable(JClusterID, emcTrack.trackEtaEmcal(), emcTrack.trackPhiEmcal(), clusterTrack.deltaEta(), clusterTrack.deltaPhi());
       }
       products.jClustersMatchedTracksTable(clusterTrackIDs);
     }
@@ -684,13 +684,13 @@ struct JetDerivedDataProducerTask {
 
   void processD0(aod::HfD0Ids::iterator const& D0Candidate, aod::Tracks const&)
   {
-    auto JProng0ID = trackCollisionMapping.find({D0Candidate.prong0Id(), D0Candidate.prong0_as<aod::Tracks>().collisionId()});
-    auto JProng1ID = trackCollisionMapping.find({D0Candidate.prong1Id(), D0Candidate.prong1_as<aod::Tracks>().collisionId()});
+    auto JProng0ID = trackCollisionMapping.find(D0Candidate.prong0Id(), D0Candidate.prong0_as<aod::Tracks>().collisionId());
+    auto JProng1ID = trackCollisionMapping.find(D0Candidate.prong1Id(), D0Candidate.prong1_as<aod::Tracks>().collisionId());
     if (withCollisionAssociator) {
-      JProng0ID = trackCollisionMapping.find({D0Candidate.prong0Id(), D0Candidate.collisionId()});
-      JProng1ID = trackCollisionMapping.find({D0Candidate.prong1Id(), D0Candidate.collisionId()});
+      JProng0ID = trackCollisionMapping.find(D0Candidate.prong0Id(), D0Candidate.collisionId());
+      JProng1ID = trackCollisionMapping.find(D0Candidate.prong1Id(), D0Candidate.collisionId());
     }
-    products.jD0IdsTable(D0Candidate.collisionId(), JProng0ID->second, JProng1ID->second);
+    products.jD0IdsTable(D0Candidate.collisionId(), JProng0ID, JProng1ID);
   }
   PROCESS_SWITCH(JetDerivedDataProducerTask, processD0, "produces derived index for D0 candidates", false);
 
@@ -714,15 +714,15 @@ struct JetDerivedDataProducerTask {
 
   void processDplus(aod::HfDplusIds::iterator const& DplusCandidate, aod::Tracks const&)
   {
-    auto JProng0ID = trackCollisionMapping.find({DplusCandidate.prong0Id(), DplusCandidate.prong0_as<aod::Tracks>().collisionId()});
-    auto JProng1ID = trackCollisionMapping.find({DplusCandidate.prong1Id(), DplusCandidate.prong1_as<aod::Tracks>().collisionId()});
-    auto JProng2ID = trackCollisionMapping.find({DplusCandidate.prong2Id(), DplusCandidate.prong2_as<aod::Tracks>().collisionId()});
+    auto JProng0ID = trackCollisionMapping.find(DplusCandidate.prong0Id(), DplusCandidate.prong0_as<aod::Tracks>().collisionId());
+    auto JProng1ID = trackCollisionMapping.find(DplusCandidate.prong1Id(), DplusCandidate.prong1_as<aod::Tracks>().collisionId());
+    auto JProng2ID = trackCollisionMapping.find(DplusCandidate.prong2Id(), DplusCandidate.prong2_as<aod::Tracks>().collisionId());
     if (withCollisionAssociator) {
-      JProng0ID = trackCollisionMapping.find({DplusCandidate.prong0Id(), DplusCandidate.collisionId()});
-      JProng1ID = trackCollisionMapping.find({DplusCandidate.prong1Id(), DplusCandidate.collisionId()});
-      JProng2ID = trackCollisionMapping.find({DplusCandidate.prong2Id(), DplusCandidate.collisionId()});
+      JProng0ID = trackCollisionMapping.find(DplusCandidate.prong0Id(), DplusCandidate.collisionId());
+      JProng1ID = trackCollisionMapping.find(DplusCandidate.prong1Id(), DplusCandidate.collisionId());
+      JProng2ID = trackCollisionMapping.find(DplusCandidate.prong2Id(), DplusCandidate.collisionId());
     }
-    products.jDplusIdsTable(DplusCandidate.collisionId(), JProng0ID->second, JProng1ID->second, JProng2ID->second);
+    products.jDplusIdsTable(DplusCandidate.collisionId(), JProng0ID, JProng1ID, JProng2ID);
   }
   PROCESS_SWITCH(JetDerivedDataProducerTask, processDplus, "produces derived index for Dplus candidates", false);
 
@@ -746,15 +746,15 @@ struct JetDerivedDataProducerTask {
 
   void processDs(aod::HfDsIds::iterator const& DsCandidate, aod::Tracks const&)
   {
-    auto JProng0ID = trackCollisionMapping.find({DsCandidate.prong0Id(), DsCandidate.prong0_as<aod::Tracks>().collisionId()});
-    auto JProng1ID = trackCollisionMapping.find({DsCandidate.prong1Id(), DsCandidate.prong1_as<aod::Tracks>().collisionId()});
-    auto JProng2ID = trackCollisionMapping.find({DsCandidate.prong2Id(), DsCandidate.prong2_as<aod::Tracks>().collisionId()});
+    auto JProng0ID = trackCollisionMapping.find(DsCandidate.prong0Id(), DsCandidate.prong0_as<aod::Tracks>().collisionId());
+    auto JProng1ID = trackCollisionMapping.find(DsCandidate.prong1Id(), DsCandidate.prong1_as<aod::Tracks>().collisionId());
+    auto JProng2ID = trackCollisionMapping.find(DsCandidate.prong2Id(), DsCandidate.prong2_as<aod::Tracks>().collisionId());
     if (withCollisionAssociator) {
-      JProng0ID = trackCollisionMapping.find({DsCandidate.prong0Id(), DsCandidate.collisionId()});
-      JProng1ID = trackCollisionMapping.find({DsCandidate.prong1Id(), DsCandidate.collisionId()});
-      JProng2ID = trackCollisionMapping.find({DsCandidate.prong2Id(), DsCandidate.collisionId()});
+      JProng0ID = trackCollisionMapping.find(DsCandidate.prong0Id(), DsCandidate.collisionId());
+      JProng1ID = trackCollisionMapping.find(DsCandidate.prong1Id(), DsCandidate.collisionId());
+      JProng2ID = trackCollisionMapping.find(DsCandidate.prong2Id(), DsCandidate.collisionId());
     }
-    products.jDsIdsTable(DsCandidate.collisionId(), JProng0ID->second, JProng1ID->second, JProng2ID->second);
+    products.jDsIdsTable(DsCandidate.collisionId(), JProng0ID, JProng1ID, JProng2ID);
   }
   PROCESS_SWITCH(JetDerivedDataProducerTask, processDs, "produces derived index for Ds candidates", false);
 
@@ -778,15 +778,15 @@ struct JetDerivedDataProducerTask {
 
   void processDstar(aod::HfDstarIds::iterator const& DstarCandidate, aod::Tracks const&)
   {
-    auto JProng0ID = trackCollisionMapping.find({DstarCandidate.prong0Id(), DstarCandidate.prong0_as<aod::Tracks>().collisionId()});
-    auto JProng1ID = trackCollisionMapping.find({DstarCandidate.prong1Id(), DstarCandidate.prong1_as<aod::Tracks>().collisionId()});
-    auto JProng2ID = trackCollisionMapping.find({DstarCandidate.prong2Id(), DstarCandidate.prong2_as<aod::Tracks>().collisionId()});
+    auto JProng0ID = trackCollisionMapping.find(DstarCandidate.prong0Id(), DstarCandidate.prong0_as<aod::Tracks>().collisionId());
+    auto JProng1ID = trackCollisionMapping.find(DstarCandidate.prong1Id(), DstarCandidate.prong1_as<aod::Tracks>().collisionId());
+    auto JProng2ID = trackCollisionMapping.find(DstarCandidate.prong2Id(), DstarCandidate.prong2_as<aod::Tracks>().collisionId());
     if (withCollisionAssociator) {
-      JProng0ID = trackCollisionMapping.find({DstarCandidate.prong0Id(), DstarCandidate.collisionId()});
-      JProng1ID = trackCollisionMapping.find({DstarCandidate.prong1Id(), DstarCandidate.collisionId()});
-      JProng2ID = trackCollisionMapping.find({DstarCandidate.prong2Id(), DstarCandidate.collisionId()});
+      JProng0ID = trackCollisionMapping.find(DstarCandidate.prong0Id(), DstarCandidate.collisionId());
+      JProng1ID = trackCollisionMapping.find(DstarCandidate.prong1Id(), DstarCandidate.collisionId());
+      JProng2ID = trackCollisionMapping.find(DstarCandidate.prong2Id(), DstarCandidate.collisionId());
     }
-    products.jDstarIdsTable(DstarCandidate.collisionId(), JProng0ID->second, JProng1ID->second, JProng2ID->second);
+    products.jDstarIdsTable(DstarCandidate.collisionId(), JProng0ID, JProng1ID, JProng2ID);
   }
   PROCESS_SWITCH(JetDerivedDataProducerTask, processDstar, "produces derived index for Dstar candidates", false);
 
@@ -810,15 +810,15 @@ struct JetDerivedDataProducerTask {
 
   void processLc(aod::HfLcIds::iterator const& LcCandidate, aod::Tracks const&)
   {
-    auto JProng0ID = trackCollisionMapping.find({LcCandidate.prong0Id(), LcCandidate.prong0_as<aod::Tracks>().collisionId()});
-    auto JProng1ID = trackCollisionMapping.find({LcCandidate.prong1Id(), LcCandidate.prong1_as<aod::Tracks>().collisionId()});
-    auto JProng2ID = trackCollisionMapping.find({LcCandidate.prong2Id(), LcCandidate.prong2_as<aod::Tracks>().collisionId()});
+    auto JProng0ID = trackCollisionMapping.find(LcCandidate.prong0Id(), LcCandidate.prong0_as<aod::Tracks>().collisionId());
+    auto JProng1ID = trackCollisionMapping.find(LcCandidate.prong1Id(), LcCandidate.prong1_as<aod::Tracks>().collisionId());
+    auto JProng2ID = trackCollisionMapping.find(LcCandidate.prong2Id(), LcCandidate.prong2_as<aod::Tracks>().collisionId());
     if (withCollisionAssociator) {
-      JProng0ID = trackCollisionMapping.find({LcCandidate.prong0Id(), LcCandidate.collisionId()});
-      JProng1ID = trackCollisionMapping.find({LcCandidate.prong1Id(), LcCandidate.collisionId()});
-      JProng2ID = trackCollisionMapping.find({LcCandidate.prong2Id(), LcCandidate.collisionId()});
+      JProng0ID = trackCollisionMapping.find(LcCandidate.prong0Id(), LcCandidate.collisionId());
+      JProng1ID = trackCollisionMapping.find(LcCandidate.prong1Id(), LcCandidate.collisionId());
+      JProng2ID = trackCollisionMapping.find(LcCandidate.prong2Id(), LcCandidate.collisionId());
     }
-    products.jLcIdsTable(LcCandidate.collisionId(), JProng0ID->second, JProng1ID->second, JProng2ID->second);
+    products.jLcIdsTable(LcCandidate.collisionId(), JProng0ID, JProng1ID, JProng2ID);
   }
   PROCESS_SWITCH(JetDerivedDataProducerTask, processLc, "produces derived index for Lc candidates", false);
 
@@ -842,17 +842,17 @@ struct JetDerivedDataProducerTask {
 
   void processB0(aod::HfB0Ids::iterator const& B0Candidate, aod::Tracks const&)
   {
-    auto JProng0ID = trackCollisionMapping.find({B0Candidate.prong0Id(), B0Candidate.prong0_as<aod::Tracks>().collisionId()});
-    auto JProng1ID = trackCollisionMapping.find({B0Candidate.prong1Id(), B0Candidate.prong1_as<aod::Tracks>().collisionId()});
-    auto JProng2ID = trackCollisionMapping.find({B0Candidate.prong2Id(), B0Candidate.prong2_as<aod::Tracks>().collisionId()});
-    auto JProng3ID = trackCollisionMapping.find({B0Candidate.prong3Id(), B0Candidate.prong3_as<aod::Tracks>().collisionId()});
+    auto JProng0ID = trackCollisionMapping.find(B0Candidate.prong0Id(), B0Candidate.prong0_as<aod::Tracks>().collisionId());
+    auto JProng1ID = trackCollisionMapping.find(B0Candidate.prong1Id(), B0Candidate.prong1_as<aod::Tracks>().collisionId());
+    auto JProng2ID = trackCollisionMapping.find(B0Candidate.prong2Id(), B0Candidate.prong2_as<aod::Tracks>().collisionId());
+    auto JProng3ID = trackCollisionMapping.find(B0Candidate.prong3Id(), B0Candidate.prong3_as<aod::Tracks>().collisionId());
     if (withCollisionAssociator) {
-      JProng0ID = trackCollisionMapping.find({B0Candidate.prong0Id(), B0Candidate.collisionId()});
-      JProng1ID = trackCollisionMapping.find({B0Candidate.prong1Id(), B0Candidate.collisionId()});
-      JProng2ID = trackCollisionMapping.find({B0Candidate.prong2Id(), B0Candidate.collisionId()});
-      JProng3ID = trackCollisionMapping.find({B0Candidate.prong3Id(), B0Candidate.collisionId()});
+      JProng0ID = trackCollisionMapping.find(B0Candidate.prong0Id(), B0Candidate.collisionId());
+      JProng1ID = trackCollisionMapping.find(B0Candidate.prong1Id(), B0Candidate.collisionId());
+      JProng2ID = trackCollisionMapping.find(B0Candidate.prong2Id(), B0Candidate.collisionId());
+      JProng3ID = trackCollisionMapping.find(B0Candidate.prong3Id(), B0Candidate.collisionId());
     }
-    products.jB0IdsTable(B0Candidate.collisionId(), JProng0ID->second, JProng1ID->second, JProng2ID->second, JProng3ID->second);
+    products.jB0IdsTable(B0Candidate.collisionId(), JProng0ID, JProng1ID, JProng2ID, JProng3ID);
   }
   PROCESS_SWITCH(JetDerivedDataProducerTask, processB0, "produces derived index for B0 candidates", false);
 
@@ -876,15 +876,15 @@ struct JetDerivedDataProducerTask {
 
   void processBplus(aod::HfBplusIds::iterator const& BplusCandidate, aod::Tracks const&)
   {
-    auto JProng0ID = trackCollisionMapping.find({BplusCandidate.prong0Id(), BplusCandidate.prong0_as<aod::Tracks>().collisionId()});
-    auto JProng1ID = trackCollisionMapping.find({BplusCandidate.prong1Id(), BplusCandidate.prong1_as<aod::Tracks>().collisionId()});
-    auto JProng2ID = trackCollisionMapping.find({BplusCandidate.prong2Id(), BplusCandidate.prong2_as<aod::Tracks>().collisionId()});
+    auto JProng0ID = trackCollisionMapping.find(BplusCandidate.prong0Id(), BplusCandidate.prong0_as<aod::Tracks>().collisionId());
+    auto JProng1ID = trackCollisionMapping.find(BplusCandidate.prong1Id(), BplusCandidate.prong1_as<aod::Tracks>().collisionId());
+    auto JProng2ID = trackCollisionMapping.find(BplusCandidate.prong2Id(), BplusCandidate.prong2_as<aod::Tracks>().collisionId());
     if (withCollisionAssociator) {
-      JProng0ID = trackCollisionMapping.find({BplusCandidate.prong0Id(), BplusCandidate.collisionId()});
-      JProng1ID = trackCollisionMapping.find({BplusCandidate.prong1Id(), BplusCandidate.collisionId()});
-      JProng2ID = trackCollisionMapping.find({BplusCandidate.prong2Id(), BplusCandidate.collisionId()});
+      JProng0ID = trackCollisionMapping.find(BplusCandidate.prong0Id(), BplusCandidate.collisionId());
+      JProng1ID = trackCollisionMapping.find(BplusCandidate.prong1Id(), BplusCandidate.collisionId());
+      JProng2ID = trackCollisionMapping.find(BplusCandidate.prong2Id(), BplusCandidate.collisionId());
     }
-    products.jBplusIdsTable(BplusCandidate.collisionId(), JProng0ID->second, JProng1ID->second, JProng2ID->second);
+    products.jBplusIdsTable(BplusCandidate.collisionId(), JProng0ID, JProng1ID, JProng2ID);
   }
   PROCESS_SWITCH(JetDerivedDataProducerTask, processBplus, "produces derived index for Bplus candidates", false);
 
@@ -908,19 +908,19 @@ struct JetDerivedDataProducerTask {
 
   void processXicToXiPiPi(aod::HfXicToXiPiPiIds::iterator const& XicToXiPiPiCandidate, aod::Tracks const&)
   {
-    auto JProng0ID = trackCollisionMapping.find({XicToXiPiPiCandidate.prong0Id(), XicToXiPiPiCandidate.prong0_as<aod::Tracks>().collisionId()});
-    auto JProng1ID = trackCollisionMapping.find({XicToXiPiPiCandidate.prong1Id(), XicToXiPiPiCandidate.prong1_as<aod::Tracks>().collisionId()});
-    auto JProng2ID = trackCollisionMapping.find({XicToXiPiPiCandidate.prong2Id(), XicToXiPiPiCandidate.prong2_as<aod::Tracks>().collisionId()});
-    auto JProng3ID = trackCollisionMapping.find({XicToXiPiPiCandidate.prong3Id(), XicToXiPiPiCandidate.prong3_as<aod::Tracks>().collisionId()});
-    auto JProng4ID = trackCollisionMapping.find({XicToXiPiPiCandidate.prong4Id(), XicToXiPiPiCandidate.prong4_as<aod::Tracks>().collisionId()});
+    auto JProng0ID = trackCollisionMapping.find(XicToXiPiPiCandidate.prong0Id(), XicToXiPiPiCandidate.prong0_as<aod::Tracks>().collisionId());
+    auto JProng1ID = trackCollisionMapping.find(XicToXiPiPiCandidate.prong1Id(), XicToXiPiPiCandidate.prong1_as<aod::Tracks>().collisionId());
+    auto JProng2ID = trackCollisionMapping.find(XicToXiPiPiCandidate.prong2Id(), XicToXiPiPiCandidate.prong2_as<aod::Tracks>().collisionId());
+    auto JProng3ID = trackCollisionMapping.find(XicToXiPiPiCandidate.prong3Id(), XicToXiPiPiCandidate.prong3_as<aod::Tracks>().collisionId());
+    auto JProng4ID = trackCollisionMapping.find(XicToXiPiPiCandidate.prong4Id(), XicToXiPiPiCandidate.prong4_as<aod::Tracks>().collisionId());
     if (withCollisionAssociator) {
-      JProng0ID = trackCollisionMapping.find({XicToXiPiPiCandidate.prong0Id(), XicToXiPiPiCandidate.collisionId()});
-      JProng1ID = trackCollisionMapping.find({XicToXiPiPiCandidate.prong1Id(), XicToXiPiPiCandidate.collisionId()});
-      JProng2ID = trackCollisionMapping.find({XicToXiPiPiCandidate.prong2Id(), XicToXiPiPiCandidate.collisionId()});
-      JProng3ID = trackCollisionMapping.find({XicToXiPiPiCandidate.prong3Id(), XicToXiPiPiCandidate.collisionId()});
-      JProng4ID = trackCollisionMapping.find({XicToXiPiPiCandidate.prong4Id(), XicToXiPiPiCandidate.collisionId()});
+      JProng0ID = trackCollisionMapping.find(XicToXiPiPiCandidate.prong0Id(), XicToXiPiPiCandidate.collisionId());
+      JProng1ID = trackCollisionMapping.find(XicToXiPiPiCandidate.prong1Id(), XicToXiPiPiCandidate.collisionId());
+      JProng2ID = trackCollisionMapping.find(XicToXiPiPiCandidate.prong2Id(), XicToXiPiPiCandidate.collisionId());
+      JProng3ID = trackCollisionMapping.find(XicToXiPiPiCandidate.prong3Id(), XicToXiPiPiCandidate.collisionId());
+      JProng4ID = trackCollisionMapping.find(XicToXiPiPiCandidate.prong4Id(), XicToXiPiPiCandidate.collisionId());
     }
-    products.jXicToXiPiPiIdsTable(XicToXiPiPiCandidate.collisionId(), JProng0ID->second, JProng1ID->second, JProng2ID->second, JProng3ID->second, JProng4ID->second);
+    products.jXicToXiPiPiIdsTable(XicToXiPiPiCandidate.collisionId(), JProng0ID, JProng1ID, JProng2ID, JProng3ID, JProng4ID);
   }
   PROCESS_SWITCH(JetDerivedDataProducerTask, processXicToXiPiPi, "produces derived index for XicToXiPiPi candidates", false);
 
@@ -932,13 +932,13 @@ struct JetDerivedDataProducerTask {
 
   void processV0(aod::V0Indices::iterator const& V0Candidate, aod::Tracks const&)
   {
-    auto JPosTrackID = trackCollisionMapping.find({V0Candidate.posTrackId(), V0Candidate.posTrack_as<aod::Tracks>().collisionId()});
-    auto JNegTrackID = trackCollisionMapping.find({V0Candidate.negTrackId(), V0Candidate.negTrack_as<aod::Tracks>().collisionId()});
+    auto JPosTrackID = trackCollisionMapping.find(V0Candidate.posTrackId(), V0Candidate.posTrack_as<aod::Tracks>().collisionId());
+    auto JNegTrackID = trackCollisionMapping.find(V0Candidate.negTrackId(), V0Candidate.negTrack_as<aod::Tracks>().collisionId());
     if (withCollisionAssociator) {
-      JPosTrackID = trackCollisionMapping.find({V0Candidate.posTrackId(), V0Candidate.collisionId()});
-      JNegTrackID = trackCollisionMapping.find({V0Candidate.negTrackId(), V0Candidate.collisionId()});
+      JPosTrackID = trackCollisionMapping.find(V0Candidate.posTrackId(), V0Candidate.collisionId());
+      JNegTrackID = trackCollisionMapping.find(V0Candidate.negTrackId(), V0Candidate.collisionId());
     }
-    products.jV0IdsTable(V0Candidate.collisionId(), JPosTrackID->second, JNegTrackID->second);
+    products.jV0IdsTable(V0Candidate.collisionId(), JPosTrackID, JNegTrackID);
   }
   PROCESS_SWITCH(JetDerivedDataProducerTask, processV0, "produces derived index for V0 candidates", false);
 
@@ -986,13 +986,13 @@ struct JetDerivedDataProducerTask {
 
   void processDielectron(aod::DielectronInfo const& DielectronCandidate, aod::Tracks const&)
   {
-    auto JProng0ID = trackCollisionMapping.find({DielectronCandidate.prong0Id(), DielectronCandidate.prong0_as<aod::Tracks>().collisionId()});
-    auto JProng1ID = trackCollisionMapping.find({DielectronCandidate.prong1Id(), DielectronCandidate.prong1_as<aod::Tracks>().collisionId()});
+    auto JProng0ID = trackCollisionMapping.find(DielectronCandidate.prong0Id(), DielectronCandidate.prong0_as<aod::Tracks>().collisionId());
+    auto JProng1ID = trackCollisionMapping.find(DielectronCandidate.prong1Id(), DielectronCandidate.prong1_as<aod::Tracks>().collisionId());
     if (withCollisionAssociator) {
-      JProng0ID = trackCollisionMapping.find({DielectronCandidate.prong0Id(), DielectronCandidate.collisionId()});
-      JProng1ID = trackCollisionMapping.find({DielectronCandidate.prong1Id(), DielectronCandidate.collisionId()});
+      JProng0ID = trackCollisionMapping.find(DielectronCandidate.prong0Id(), DielectronCandidate.collisionId());
+      JProng1ID = trackCollisionMapping.find(DielectronCandidate.prong1Id(), DielectronCandidate.collisionId());
     }
-    products.jDielectronIdsTable(DielectronCandidate.collisionId(), JProng0ID->second, JProng1ID->second);
+    products.jDielectronIdsTable(DielectronCandidate.collisionId(), JProng0ID, JProng1ID);
   }
   PROCESS_SWITCH(JetDerivedDataProducerTask, processDielectron, "produces derived index for Dielectron candidates", false);
 
@@ -21,6 +21,7 @@
 #include "PWGDQ/DataModel/ReducedInfoTables.h"
 #include "PWGHF/DataModel/DerivedTables.h"
 #include "PWGJE/Core/JetDQUtilities.h"
+#include "PWGJE/Core/JetDerivedDataIndexMaps.h"
 #include "PWGJE/Core/JetHFUtilities.h"
 #include "PWGJE/DataModel/Jet.h"
 #include "PWGJE/DataModel/JetReducedData.h"
@@ -421,34 +422,32 @@ struct JetDerivedDataWriter {
   }
   PROCESS_SWITCH(JetDerivedDataWriter, processDummyTable, "write out dummy output table", true);
 
-  std::vector<int32_t> collisionMapping;
-  std::vector<int32_t> bcMapping;
-  std::vector<int32_t> trackMapping;
-  std::vector<int32_t> mcCollisionMapping;
-  std::vector<int32_t> particleMapping;
-  std::vector<int32_t> d0McCollisionMapping;
-  std::vector<int32_t> dplusMcCollisionMapping;
-  std::vector<int32_t> dsMcCollisionMapping;
-  std::vector<int32_t> dstarMcCollisionMapping;
-  std::vector<int32_t> lcMcCollisionMapping;
-  std::vector<int32_t> b0McCollisionMapping;
-  std::vector<int32_t> bplusMcCollisionMapping;
-  std::vector<int32_t> xicToXiPiPiMcCollisionMapping;
-  // std::vector<int32_t> dielectronMcCollisionMapping;
+  jetderiveddatautilities::IndexMap collisionMapping;
+  jetderiveddatautilities::IndexMap bcMapping;
+  jetderiveddatautilities::IndexMap trackMapping;
+  jetderiveddatautilities::IndexMap mcCollisionMapping;
+  jetderiveddatautilities::IndexMap particleMapping;
+  jetderiveddatautilities::IndexMap d0McCollisionMapping;
+  jetderiveddatautilities::IndexMap dplusMcCollisionMapping;
+  jetderiveddatautilities::IndexMap dsMcCollisionMapping;
+  jetderiveddatautilities::IndexMap dstarMcCollisionMapping;
+  jetderiveddatautilities::IndexMap lcMcCollisionMapping;
+  jetderiveddatautilities::IndexMap b0McCollisionMapping;
+  jetderiveddatautilities::IndexMap bplusMcCollisionMapping;
+  jetderiveddatautilities::IndexMap xicToXiPiPiMcCollisionMapping;
+  // jetderiveddatautilities::IndexMap dielectronMcCollisionMapping;
 
   void processBCs(soa::Join<aod::JCollisions, aod::JCollisionSelections> const& collisions, soa::Join<aod::JBCs, aod::JBCPIs> const& bcs)
   {
-    std::vector<int32_t> bcIndicies;
-    bcMapping.clear();
-    bcMapping.resize(bcs.size(), -1);
+    bcMapping.reset(bcs.size());
 
+    // a BC is written once, for the first selected collision pointing to it
     for (auto const& collision : collisions) {
       if (collision.isCollisionSelected()) {
         auto bc = collision.bc_as<soa::Join<aod::JBCs, aod::JBCPIs>>();
-        if (std::find(bcIndicies.begin(), bcIndicies.end(), bc.globalIndex()) == bcIndicies.end()) {
+        if (bcMapping[bc.globalIndex()] == jetderiveddatautilities::IndexMap::NotFound) {
           products.storedJBCsTable(bc.runNumber(), bc.globalBC(), bc.triggerMask(), bc.timestamp(), bc.alias_raw(), bc.selection_raw(), bc.rct_raw());
           products.storedJBCParentIndexTable(bc.bcId());
-          bcIndicies.push_back(bc.globalIndex());
           bcMapping[bc.globalIndex()] = products.storedJBCsTable.lastIndex();
         }
       }
@@ -458,16 +457,13 @@ struct JetDerivedDataWriter {
 
   void processBCsForMcGenOnly(soa::Join<aod::JMcCollisions, aod::JMcCollisionSelections> const& mcCollisions, aod::JBCs const& bcs)
   {
-    std::vector<int32_t> bcIndicies;
-    bcMapping.clear();
-    bcMapping.resize(bcs.size(), -1);
+    bcMapping.reset(bcs.size());
 
     for (auto const& mcCollision : mcCollisions) {
       if (mcCollision.isMcCollisionSelected()) {
         auto bc = mcCollision.bc_as<aod::JBCs>();
-        if (std::find(bcIndicies.begin(), bcIndicies.end(), bc.globalIndex()) == bcIndicies.end()) {
+        if (bcMapping[bc.globalIndex()] == jetderiveddatautilities::IndexMap::NotFound) {
           products.storedJBCsTable(bc.runNumber(), bc.globalBC(), bc.triggerMask(), bc.timestamp(), bc.alias_raw(), bc.selection_raw(), bc.rct_raw());
-          bcIndicies.push_back(bc.globalIndex());
           bcMapping[bc.globalIndex()] = products.storedJBCsTable.lastIndex();
         }
       }
@@ -477,8 +473,15 @@ struct JetDerivedDataWriter {
 
   void processColllisons(soa::Join<aod::JCollisions, aod::JCollisionMcInfos, aod::JCollisionPIs, aod::JCollisionSelections> const& collisions)
   {
-    collisionMapping.clear();
-    collisionMapping.resize(collisions.size(), -1);
+    collisionMapping.reset(collisions.size());
+
+    int nSelectedCollisions = 0;
+    for (auto const& collision : collisions) {
+      nSelectedCollisions += collision.isCollisionSelected();
+    }
+    products.storedJCollisionsTable.reserve(nSelectedCollisions);
+    products.storedJCollisionMcInfosTable.reserve(nSelectedCollisions);
+    products.storedJCollisionsParentIndexTable.reserve(nSelectedCollisions);
 
     for (auto const& collision : collisions) {
       if (collision.isCollisionSelected()) {
@@ -523,8 +526,18 @@ struct JetDerivedDataWriter {
 
   void processTracks(soa::Join<aod::JCollisions, aod::JCollisionSelections> const& collisions, soa::Join<aod::JTracks, aod::JTrackExtras, aod::JTrackPIs> const& tracks)
   {
-    trackMapping.clear();
-    trackMapping.resize(tracks.size(), -1);
+    trackMapping.reset(tracks.size());
+
+    // the tracks of the selected collisions are an upper bound of the written tracks
+    int nTracksSelectedCollisions = 0;
+    for (auto const& collision : collisions) {
+      if (collision.isCollisionSelected()) {
+        nTracksSelectedCollisions += tracks.sliceBy(preslices.TracksPerCollision, collision.globalIndex()).size();
+      }
+    }
+    products.storedJTracksTable.reserve(nTracksSelectedCollisions);
+    products.storedJTracksExtraTable.reserve(nTracksSelectedCollisions);
+    products.storedJTracksParentIndexTable.reserve(nTracksSelectedCollisions);
 
     for (auto const& collision : collisions) {
       if (collision.isCollisionSelected()) {
@@ -681,8 +694,7 @@ struct JetDerivedDataWriter {
 
   void processMcCollisions(soa::Join<aod::JMcCollisions, aod::JMcCollisionPIs, aod::JMcCollisionSelections> const& mcCollisions)
   {
-    mcCollisionMapping.clear();
-    mcCollisionMapping.resize(mcCollisions.size(), -1);
+    mcCollisionMapping.reset(mcCollisions.size());
     for (auto const& mcCollision : mcCollisions) {
       if (mcCollision.isMcCollisionSelected()) {
         products.storedJMcCollisionsTable(bcMapping[mcCollision.bcId()], mcCollision.posX(), mcCollision.posY(), mcCollision.posZ(), mcCollision.multFV0A(), mcCollision.multFT0A(), mcCollision.multFT0C(), mcCollision.centFT0M(), mcCollision.weight(), mcCollision.accepted(), mcCollision.attempted(), mcCollision.xsectGen(), mcCollision.xsectErr(), mcCollision.ptHard(), mcCollision.eventSel(), mcCollision.rct_raw(), mcCollision.getGeneratorId(), mcCollision.getSubGeneratorId(), mcCollision.getSourceId(), mcCollision.impactParameter(), mcCollision.eventPlaneAngle());
@@ -695,8 +707,7 @@ struct JetDerivedDataWriter {
 
   void processMcParticles(soa::Join<aod::JMcCollisions, aod::JMcCollisionSelections> const& mcCollisions, soa::Join<aod::JMcParticles, aod::JMcParticlePIs> const& particles)
   {
-    particleMapping.clear();
-    particleMapping.resize(particles.size(), -1);
+    particleMapping.reset(particles.size());
     int particleTableIndex = 0;
     for (auto const& mcCollision : mcCollisions) {
       if (mcCollision.isMcCollisionSelected()) {
@@ -743,8 +754,7 @@ struct JetDerivedDataWriter {
 
   void processD0MCP(soa::Join<aod::JMcCollisions, aod::JMcCollisionSelections> const& mcCollisions, aod::McCollisionsD0 const& D0McCollisions, aod::CandidatesD0MCP const& D0Particles)
   {
-    d0McCollisionMapping.clear();
-    d0McCollisionMapping.resize(D0McCollisions.size(), -1);
+    d0McCollisionMapping.reset(D0McCollisions.size());
     for (auto const& mcCollision : mcCollisions) {
       if (mcCollision.isMcCollisionSelected()) {
         const auto d0McCollisionsPerMcCollision = D0McCollisions.sliceBy(preslices.D0McCollisionsPerMcCollision, mcCollision.globalIndex());
@@ -765,8 +775,7 @@ struct JetDerivedDataWriter {
 
   void processDplusMCP(soa::Join<aod::JMcCollisions, aod::JMcCollisionSelections> const& mcCollisions, aod::McCollisionsDplus const& DplusMcCollisions, aod::CandidatesDplusMCP const& DplusParticles)
   {
-    dplusMcCollisionMapping.clear();
-    dplusMcCollisionMapping.resize(DplusMcCollisions.size(), -1);
+    dplusMcCollisionMapping.reset(DplusMcCollisions.size());
     for (auto const& mcCollision : mcCollisions) {
       if (mcCollision.isMcCollisionSelected()) {
         const auto dplusMcCollisionsPerMcCollision = DplusMcCollisions.sliceBy(preslices.DplusMcCollisionsPerMcCollision, mcCollision.globalIndex());
@@ -787,8 +796,7 @@ struct JetDerivedDataWriter {
 
   void processDsMCP(soa::Join<aod::JMcCollisions, aod::JMcCollisionSelections> const& mcCollisions, aod::McCollisionsDs const& DsMcCollisions, aod::CandidatesDsMCP const& DsParticles)
   {
-    dsMcCollisionMapping.clear();
-    dsMcCollisionMapping.resize(DsMcCollisions.size(), -1);
+    dsMcCollisionMapping.reset(DsMcCollisions.size());
     for (auto const& mcCollision : mcCollisions) {
       if (mcCollision.isMcCollisionSelected()) {
         const auto dsMcCollisionsPerMcCollision = DsMcCollisions.sliceBy(preslices.DsMcCollisionsPerMcCollision, mcCollision.globalIndex());
@@ -809,8 +817,7 @@ struct JetDerivedDataWriter {
 
   void processDstarMCP(soa::Join<aod::JMcCollisions, aod::JMcCollisionSelections> const& mcCollisions, aod::McCollisionsDstar const& DstarMcCollisions, aod::CandidatesDstarMCP const& DstarParticles)
   {
-    dstarMcCollisionMapping.clear();
-    dstarMcCollisionMapping.resize(DstarMcCollisions.size(), -1);
+    dstarMcCollisionMapping.reset(DstarMcCollisions.size());
     for (auto const& mcCollision : mcCollisions) {
       if (mcCollision.isMcCollisionSelected()) {
         const auto dstarMcCollisionsPerMcCollision = DstarMcCollisions.sliceBy(preslices.DstarMcCollisionsPerMcCollision, mcCollision.globalIndex());
@@ -831,8 +838,7 @@ struct JetDerivedDataWriter {
 
   void processLcMCP(soa::Join<aod::JMcCollisions, aod::JMcCollisionSelections> const& mcCollisions, aod::McCollisionsLc const& LcMcCollisions, aod::CandidatesLcMCP const& LcParticles)
   {
-    lcMcCollisionMapping.clear();
-    lcMcCollisionMapping.resize(LcMcCollisions.size(), -1);
+    lcMcCollisionMapping.reset(LcMcCollisions.size());
     for (auto const& mcCollision : mcCollisions) {
       if (mcCollision.isMcCollisionSelected()) {
         const auto lcMcCollisionsPerMcCollision = LcMcCollisions.sliceBy(preslices.LcMcCollisionsPerMcCollision, mcCollision.globalIndex());
@@ -853,8 +859,7 @@ struct JetDerivedDataWriter {
 
   void processB0MCP(soa::Join<aod::JMcCollisions, aod::JMcCollisionSelections> const& mcCollisions, aod::McCollisionsB0 const& B0McCollisions, aod::CandidatesB0MCP const& B0Particles)
   {
-    b0McCollisionMapping.clear();
-    b0McCollisionMapping.resize(B0McCollisions.size(), -1);
+    b0McCollisionMapping.reset(B0McCollisions.size());
     for (auto const& mcCollision : mcCollisions) {
       if (mcCollision.isMcCollisionSelected()) {
         const auto b0McCollisionsPerMcCollision = B0McCollisions.sliceBy(preslices.B0McCollisionsPerMcCollision, mcCollision.globalIndex());
@@ -875,8 +880,7 @@ struct JetDerivedDataWriter {
 
   void processBplusMCP(soa::Join<aod::JMcCollisions, aod::JMcCollisionSelections> const& mcCollisions, aod::McCollisionsBplus const& BplusMcCollisions, aod::CandidatesBplusMCP const& BplusParticles)
   {
-    bplusMcCollisionMapping.clear();
-    bplusMcCollisionMapping.resize(BplusMcCollisions.size(), -1);
+    bplusMcCollisionMapping.reset(BplusMcCollisions.size());
     for (auto const& mcCollision : mcCollisions) {
       if (mcCollision.isMcCollisionSelected()) {
         const auto bplusMcCollisionsPerMcCollision = BplusMcCollisions.sliceBy(preslices.BplusMcCollisionsPerMcCollision, mcCollision.globalIndex());
@@ -897,8 +901,7 @@ struct JetDerivedDataWriter {
 
   void processXicToXiPiPiMCP(soa::Join<aod::JMcCollisions, aod::JMcCollisionSelections> const& mcCollisions, aod::McCollisionsXicToXiPiPi const& XicToXiPiPiMcCollisions, aod::CandidatesXicToXiPiPiMCP const& XicToXiPiPiParticles)
   {
-    xicToXiPiPiMcCollisionMapping.clear();
-    xicToXiPiPiMcCollisionMapping.resize(XicToXiPiPiMcCollisions.size(), -1);
+    xicToXiPiPiMcCollisionMapping.reset(XicToXiPiPiMcCollisions.size());
     for (auto const& mcCollision : mcCollisions) {
       if (mcCollision.isMcCollisionSelected()) {
         const auto xicToXiPiPiMcCollisionsPerMcCollision = XicToXiPiPiMcCollisions.sliceBy(preslices.XicToXiPiPiMcCollisionsPerMcCollision, mcCollision.globalIndex());
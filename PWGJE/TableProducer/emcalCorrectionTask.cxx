@@ -58,6 +58,7 @@
 
 #include <GPUROOTCartesianFwd.h>
 
+#include <algorithm>
 #include <cmath>
 #include <cstddef>
 #include <cstdint>
@@ -169,6 +170,7 @@ struct EmcalCorrectionTask {
   // Cells and clusters
   std::vector<o2::emcal::AnalysisCluster> mAnalysisClusters;
   std::vector<o2::emcal::ClusterLabel> mClusterLabels;
+  MatchingGrid mMatchingGrid;
 
   // Cluster Eta and Phi used for track matching later
   std::vector<float> mClusterPhi;
@@ -205,11 +207,13 @@ struct EmcalCorrectionTask {
   static constexpr uint MaxAmbClusterPerDFPerClusterizer = 300'000;         // memory footprint: 19.5 MB per clusterizer
   static constexpr uint MaxCellsPerClusterPerDFPerClusterizer = 300'000;    // memory footprint: 4.8 MB per clusterizer
   static constexpr uint MaxCellsPerAmbClusterPerDFPerClusterizer = 450'000; // memory footprint: 7.2 MB per clusterizer
+  static constexpr uint MinReservePerClusterizer = 1'000;                   // reserved for the first DF
 
   // cluster size
   size_t nCluster = 0;
   size_t nClusterAmb = 0;
   size_t nCells = 0;
+  size_t nCellsAmb = 0;
 
   void init(InitContext const&)
   {
@@ -419,10 +423,7 @@ struct EmcalCorrectionTask {
   void processFull(BcEvSels const& bcs, CollEventSels const& collisions, MyGlobTracks const& tracks, FilteredCells const& cells)
   {
     LOG(debug) << "Starting process full.";
-    clusters.reserve(MaxClusterPerDFPerClusterizer * mClusterizers.size());
-    clustersAmbiguous.reserve(MaxAmbClusterPerDFPerClusterizer * mClusterizers.size());
-    clustercells.reserve(MaxCellsPerClusterPerDFPerClusterizer * mClusterizers.size());
-    clustercellsambiguous.reserve(MaxCellsPerAmbClusterPerDFPerClusterizer * mClusterizers.size());
+    reserveOutputTables(false);
 
     int previousCollisionId = 0; // Collision ID of the last unique BC. Needed to skip unordered collisions to ensure ordered collisionIds in the cluster table
     int nBCsProcessed = 0;
@@ -432,6 +433,7 @@ struct EmcalCorrectionTask {
     nCluster = 0;
     nClusterAmb = 0;
     nCells = 0;
+    nCellsAmb = 0;
     for (const auto& bc : bcs) {
       LOG(debug) << "Next BC";
 
@@ -579,10 +581,7 @@ struct EmcalCorrectionTask {
   {
     LOG(debug) << "Starting process full.";
 
-    clusters.reserve(MaxClusterPerDFPerClusterizer * mClusterizers.size());
-    clustersAmbiguous.reserve(MaxAmbClusterPerDFPerClusterizer * mClusterizers.size());
-    clustercells.reserve(MaxCellsPerClusterPerDFPerClusterizer * mClusterizers.size());
-    clustercellsambiguous.reserve(MaxCellsPerAmbClusterPerDFPerClusterizer * mClusterizers.size());
+    reserveOutputTables(false);
 
     int previousCollisionId = 0; // Collision ID of the last unique BC. Needed to skip unordered collisions to ensure ordered collisionIds in the cluster table
     int nBCsProcessed = 0;
@@ -593,6 +592,7 @@ struct EmcalCorrectionTask {
     nCluster = 0;
     nClusterAmb = 0;
     nCells = 0;
+    nCellsAmb = 0;
     for (const auto& bc : bcs) {
       LOG(debug) << "Next BC";
 
@@ -744,12 +744,7 @@ struct EmcalCorrectionTask {
   {
     LOG(debug) << "Starting processMCFull.";
 
-    clusters.reserve(MaxClusterPerDFPerClusterizer * mClusterizers.size());
-    mcclusters.reserve(MaxClusterPerDFPerClusterizer * mClusterizers.size());
-    clustersAmbiguous.reserve(MaxAmbClusterPerDFPerClusterizer * mClusterizers.size());
-    mcclustersAmbiguous.reserve(MaxAmbClusterPerDFPerClusterizer * mClusterizers.size());
-    clustercells.reserve(MaxCellsPerClusterPerDFPerClusterizer * mClusterizers.size());
-    clustercellsambiguous.reserve(MaxCellsPerAmbClusterPerDFPerClusterizer * mClusterizers.size());
+    reserveOutputTables(true);
 
     int previousCollisionId = 0; // Collision ID of the last unique BC. Needed to skip unordered collisions to ensure ordered collisionIds in the cluster table
     int nBCsProcessed = 0;
@@ -760,6 +755,7 @@ struct EmcalCorrectionTask {
     nCluster = 0;
     nClusterAmb = 0;
     nCells = 0;
+    nCellsAmb = 0;
 
     for (const auto& bc : bcs) {
       LOG(debug) << "Next BC";
@@ -939,12 +935,7 @@ struct EmcalCorrectionTask {
   {
     LOG(debug) << "Starting processMCWithSecondaries.";
 
-    clusters.reserve(MaxClusterPerDFPerClusterizer * mClusterizers.size());
-    mcclusters.reserve(MaxClusterPerDFPerClusterizer * mClusterizers.size());
-    clustersAmbiguous.reserve(MaxAmbClusterPerDFPerClusterizer * mClusterizers.size());
-    mcclustersAmbiguous.reserve(MaxAmbClusterPerDFPerClusterizer * mClusterizers.size());
-    clustercells.reserve(MaxCellsPerClusterPerDFPerClusterizer * mClusterizers.size());
-    clustercellsambiguous.reserve(MaxCellsPerAmbClusterPerDFPerClusterizer * mClusterizers.size());
+    reserveOutputTables(true);
 
     int previousCollisionId = 0; // Collision ID of the last unique BC. Needed to skip unordered collisions to ensure ordered collisionIds in the cluster table
     int nBCsProcessed = 0;
@@ -955,6 +946,7 @@ struct EmcalCorrectionTask {
     nCluster = 0;
     nClusterAmb = 0;
     nCells = 0;
+    nCellsAmb = 0;
     for (const auto& bc : bcs) {
       LOG(debug) << "Next BC";
       // Convert aod::Calo to o2::emcal::Cell which can be used with the clusterizer.
@@ -1136,10 +1128,7 @@ struct EmcalCorrectionTask {
   {
     LOG(debug) << "Starting process standalone.";
 
-    clusters.reserve(MaxClusterPerDFPerClusterizer * mClusterizers.size());
-    clustersAmbiguous.reserve(MaxAmbClusterPerDFPerClusterizer * mClusterizers.size());
-    clustercells.reserve(MaxCellsPerClusterPerDFPerClusterizer * mClusterizers.size());
-    clustercellsambiguous.reserve(MaxCellsPerAmbClusterPerDFPerClusterizer * mClusterizers.size());
+    reserveOutputTables(false);
 
     int previousCollisionId = 0; // Collision ID of the last unique BC. Needed to skip unordered collisions to ensure ordered collisionIds in the cluster table
     int nBCsProcessed = 0;
@@ -1148,6 +1137,7 @@ struct EmcalCorrectionTask {
     nCluster = 0;
     nClusterAmb = 0;
     nCells = 0;
+    nCellsAmb = 0;
 
     for (const auto& bc : bcs) {
       LOG(debug) << "Next BC";
@@ -1263,6 +1253,23 @@ struct EmcalCorrectionTask {
   }
   PROCESS_SWITCH(EmcalCorrectionTask, processStandalone, "run stand alone analysis", false);
 
+  /// Reserves the output tables with the sizes of the previous DF and a margin of 25%, at most with the worst case sizes
+  void reserveOutputTables(bool isMC)
+  {
+    const size_t nClusterizers = mClusterizers.size();
+    auto capacity = [nClusterizers](size_t previousSize, uint maxPerClusterizer) {
+      return std::clamp<size_t>(previousSize + previousSize / 4, MinReservePerClusterizer * nClusterizers, maxPerClusterizer * nClusterizers);
+    };
+    clusters.reserve(capacity(nCluster, MaxClusterPerDFPerClusterizer));
+    clustersAmbiguous.reserve(capacity(nClusterAmb, MaxAmbClusterPerDFPerClusterizer));
+    clustercells.reserve(capacity(nCells, MaxCellsPerClusterPerDFPerClusterizer));
+    clustercellsambiguous.reserve(capacity(nCellsAmb, MaxCellsPerAmbClusterPerDFPerClusterizer));
+    if (isMC) {
+      mcclusters.reserve(capacity(nCluster, MaxClusterPerDFPerClusterizer));
+      mcclustersAmbiguous.reserve(capacity(nClusterAmb, MaxAmbClusterPerDFPerClusterizer));
+    }
+  }
+
   void cellsToCluster(size_t iClusterizer, const gsl::span<o2::emcal::Cell> cellsBC, gsl::span<const o2::emcal::CellLabel> cellLabels = {})
   {
     mClusterizers.at(iClusterizer)->findClusters(cellsBC);
@@ -1364,23 +1371,23 @@ struct EmcalCorrectionTask {
         mHistManager.fill(HIST("hClusterFCrossSigmaShortE"), cluster.E(), cluster.getFCross(), cluster.getM20());
       }
       if (indexMapPair && trackGlobalIndex) {
-        if (iCluster < indexMapPair->matchIndexTrack.size() && indexMapPair->matchIndexTrack.size() > 0) {
-          for (unsigned int iTrack = 0; iTrack < indexMapPair->matchIndexTrack[iCluster].size(); iTrack++) {
-            if (indexMapPair->matchIndexTrack[iCluster][iTrack] >= 0) {
-              LOG(debug) << "Found track " << (*trackGlobalIndex)[indexMapPair->matchIndexTrack[iCluster][iTrack]] << " in cluster " << cluster.getID();
-              matchedTracks(clusters.lastIndex(), (*trackGlobalIndex)[indexMapPair->matchIndexTrack[iCluster][iTrack]], indexMapPair->matchDeltaPhi[iCluster][iTrack], indexMapPair->matchDeltaEta[iCluster][iTrack]);
-              mHistManager.fill(HIST("hMatchedPrimaryTracks"), indexMapPair->matchDeltaEta[iCluster][iTrack], indexMapPair->matchDeltaPhi[iCluster][iTrack]);
+        if (iCluster < indexMapPair->nClusters()) {
+          for (int iTrack = indexMapPair->firstMatch(iCluster); iTrack < indexMapPair->lastMatch(iCluster); iTrack++) {
+            if (indexMapPair->matchIndexTrack[iTrack] >= 0) {
+              LOG(debug) << "Found track " << (*trackGlobalIndex)[indexMapPair->matchIndexTrack[iTrack]] << " in cluster " << cluster.getID();
+              matchedTracks(clusters.lastIndex(), (*trackGlobalIndex)[indexMapPair->matchIndexTrack[iTrack]], indexMapPair->matchDeltaPhi[iTrack], indexMapPair->matchDeltaEta[iTrack]);
+              mHistManager.fill(HIST("hMatchedPrimaryTracks"), indexMapPair->matchDeltaEta[iTrack], indexMapPair->matchDeltaPhi[iTrack]);
             }
           }
         }
       }
       if (indexMapPairSecondaries && secondariesGlobalIndex) {
-        if (iCluster < indexMapPairSecondaries->matchIndexTrack.size() && indexMapPairSecondaries->matchIndexTrack.size() > 0) {
-          for (unsigned int iTrack = 0; iTrack < indexMapPairSecondaries->matchIndexTrack[iCluster].size(); iTrack++) {
-            if (indexMapPairSecondaries->matchIndexTrack[iCluster][iTrack] >= 0) {
-              LOG(debug) << "Found secondary track " << (*secondariesGlobalIndex)[indexMapPairSecondaries->matchIndexTrack[iCluster][iTrack]] << " in cluster " << cluster.getID();
-              matchedSecondaries(clusters.lastIndex(), (*secondariesGlobalIndex)[indexMapPairSecondaries->matchIndexTrack[iCluster][iTrack]], indexMapPairSecondaries->matchDeltaPhi[iCluster][iTrack], indexMapPairSecondaries->matchDeltaEta[iCluster][iTrack]);
-              mHistManager.fill(HIST("hMatchedSecondaries"), indexMapPairSecondaries->matchDeltaEta[iCluster][iTrack], indexMapPairSecondaries->matchDeltaPhi[iCluster][iTrack]);
+        if (iCluster < indexMapPairSecondaries->nClusters()) {
+          for (int iTrack = indexMapPairSecondaries->firstMatch(iCluster); iTrack < indexMapPairSecondaries->lastMatch(iCluster); iTrack++) {
+            if (indexMapPairSecondaries->matchIndexTrack[iTrack] >= 0) {
+              LOG(debug) << "Found secondary track " << (*secondariesGlobalIndex)[indexMapPairSecondaries->matchIndexTrack[iTrack]] << " in cluster " << cluster.getID();
+              matchedSecondaries(clusters.lastIndex(), (*secondariesGlobalIndex)[indexMapPairSecondaries->matchIndexTrack[iTrack]], indexMapPairSecondaries->matchDeltaPhi[iTrack], indexMapPairSecondaries->matchDeltaEta[iTrack]);
+              mHistManager.fill(HIST("hMatchedSecondaries"), indexMapPairSecondaries->matchDeltaEta[iTrack], indexMapPairSecondaries->matchDeltaPhi[iTrack]);
             }
           }
         }
@@ -1432,6 +1439,7 @@ struct EmcalCorrectionTask {
         cellindex = cluster.getCellIndex(ncell);
         clustercellsambiguous(clustersAmbiguous.lastIndex(),
                               cellIndicesBC[cellindex]);
+        ++nCellsAmb;
       } // end of cells of cluster loop
       iCluster++;
     } // end of cluster loop
@@ -1450,7 +1458,7 @@ struct EmcalCorrectionTask {
     trackGlobalIndex.reserve(nTracksInCol);
     fillTrackInfo<decltype(groupedTracks)>(groupedTracks, trackPhi, trackEta, trackGlobalIndex);
 
-    indexMapPair = matchTracksToCluster(mClusterPhi, mClusterEta, trackPhi, trackEta, maxMatchingDistance, MaxMatchesPerCluster);
+    matchTracksToCluster(mClusterPhi, mClusterEta, trackPhi, trackEta, maxMatchingDistance, MaxMatchesPerCluster, mMatchingGrid, indexMapPair);
   }
 
   template <typename Collision>
@@ -1486,7 +1494,7 @@ struct EmcalCorrectionTask {
       trackEta.emplace_back(trackEtaEmcal);
       trackGlobalIndex.emplace_back(track.globalIndex());
     }
-    indexMapPair = matchTracksToCluster(mClusterPhi, mClusterEta, trackPhi, trackEta, maxMatchingDistance, MaxMatchesPerCluster);
+    matchTracksToCluster(mClusterPhi, mClusterEta, trackPhi, trackEta, maxMatchingDistance, MaxMatchesPerCluster, mMatchingGrid, indexMapPair);
   }
 
   template <typename Tracks>
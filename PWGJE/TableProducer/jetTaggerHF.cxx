@@ -112,6 +112,7 @@ struct JetTaggerHFTask {
   Configurable<int> nClassesMl{"nClassesMl", 2, "Number of classes in ML model"};
   Configurable<std::vector<std::string>> namesInputFeatures{"namesInputFeatures", std::vector<std::string>{"feature1", "feature2"}, "Names of ML model input features"};
   Configurable<bool> useDb{"useDb", false, "Flag to use DB for ML model instead of the score"};
+  Configurable<bool> evaluateMlInBatch{"evaluateMlInBatch", false, "Flag to evaluate the ML model once per DF on all the jets (models with 1D input only)"};
 
   Configurable<std::string> ccdbUrl{"ccdbUrl", "http://alice-ccdb.cern.ch", "url of the ccdb repository"};
   Configurable<std::vector<std::string>> modelPathsCCDB{"modelPathsCCDB", std::vector<std::string>{"Users/h/hahassan"}, "Paths of models on CCDB"};
@@ -178,6 +179,13 @@ struct JetTaggerHFTask {
 
   o2::analysis::GNNBjetAllocator tensorAlloc;
 
+  // jets added to the ML batch, in the order of the batch
+  std::vector<int64_t> mlBatchJetIndices;
+  // GNN inputs, reused from one jet to the next
+  std::vector<std::vector<float>> gnnTrkFeat;
+  std::vector<float> gnnFeat;
+  std::vector<Ort::Value> gnnInput;
+
   template <typename T, typename U>
   float calculateJetProbability(int origin, T const& jet, U const& tracks, bool const& isMC = false)
   {
@@ -548,6 +556,19 @@ struct JetTaggerHFTask {
   template <typename AnyJets, typename AnyTracks, typename SecondaryVertices>
   void analyzeJetAlgorithmML(AnyJets const& alljets, AnyTracks const& allTracks, SecondaryVertices const& allSVs)
   {
+    auto fillScore = [&](int64_t jetIndex, std::vector<float> const& output) {
+      if (bMlResponse.getOutputNodes() > 1) {
+        auto mDb = [](const std::vector<float>& scores, float fC) {
+          return std::log(scores[2] / (fC * scores[1] + (1 - fC) * scores[0]));
+        };
+
+        scoreML[jetIndex] = useDb ? mDb(output, fC) : output[2]; // 2 is the b-jet index
+      } else {
+        scoreML[jetIndex] = output[0];
+      }
+    };
+
+    const bool inBatch = evaluateMlInBatch && bMlResponse.getInputShape().size() <= 1;
     for (const auto& analysisJet : alljets) {
 
       std::vector<jettaggingutilities::BJetTrackParams> tracksParams;
@@ -562,6 +583,12 @@ struct JetTaggerHFTask {
       tracksParams.resize(nJetConst); // resize to the number of inputs of the ML
       svsParams.resize(nJetConst);    // resize to the number of inputs of the ML
 
+      if (inBatch) {
+        bMlResponse.addToBatch(bMlResponse.getInputFeatures1D(jetparam, tracksParams, svsParams), analysisJet.pt());
+        mlBatchJetIndices.push_back(analysisJet.globalIndex());
+        continue;
+      }
+
       std::vector<float> output;
 
       if (bMlResponse.getInputShape().size() > 1) {
@@ -572,21 +599,36 @@ struct JetTaggerHFTask {
         bMlResponse.isSelectedMl(inputML, analysisJet.pt(), output);
       }
 
-      if (bMlResponse.getOutputNodes() > 1) {
-        auto mDb = [](const std::vector<float>& scores, float fC) {
-          return std::log(scores[2] / (fC * scores[1] + (1 - fC) * scores[0]));
-        };
+      fillScore(analysisJet.globalIndex(), output);
+    }
 
-        scoreML[analysisJet.globalIndex()] = useDb ? mDb(output, fC) : output[2]; // 2 is the b-jet index
-      } else {
-        scoreML[analysisJet.globalIndex()] = output[0];
-      }
+    if (inBatch) {
+      evaluateMlBatch(fillScore);
+    }
+  }
+
+  // one inference per model on all the jets added to the batch, the scores are then filled in the order of the batch
+  template <typename F>
+  void evaluateMlBatch(F&& fillScore)
+  {
+    bMlResponse.evaluateBatch();
+    std::vector<float> output;
+    for (int iJet = 0; iJet < bMlResponse.getBatchSize(); iJet++) {
+      bMlResponse.isSelectedMlBatch(iJet, output);
+      fillScore(mlBatchJetIndices[iJet], output);
     }
+    bMlResponse.clearBatch();
+    mlBatchJetIndices.clear();
   }
 
   template <typename AnyJets, typename AnyTracks>
   void analyzeJetAlgorithmMLnoSV(AnyJets const& alljets, AnyTracks const& allTracks)
   {
+    auto fillScore = [&](int64_t jetIndex, std::vector<float> const& output) {
+      scoreML[jetIndex] = output[0];
+    };
+
+    const bool inBatch = evaluateMlInBatch && bMlResponse.getInputShape().size() <= 1;
     for (const auto& analysisJet : alljets) {
 
       std::vector<jettaggingutilities::BJetTrackParams> tracksParams;
@@ -597,6 +639,12 @@ struct JetTaggerHFTask {
       jettaggingutilities::BJetParams jetparam = {analysisJet.pt(), analysisJet.eta(), analysisJet.phi(), static_cast<int>(tracksParams.size()), 0, analysisJet.mass()};
       tracksParams.resize(nJetConst); // resize to the number of inputs of the ML
 
+      if (inBatch) {
+        bMlResponse.addToBatch(bMlResponse.getInputFeatures1D(jetparam, tracksParams, svsParams), analysisJet.pt());
+        mlBatchJetIndices.push_back(analysisJet.globalIndex());
+        continue;
+      }
+
       std::vector<float> output;
 
       if (bMlResponse.getInputShape().size() > 1) {
@@ -607,7 +655,11 @@ struct JetTaggerHFTask {
         bMlResponse.isSelectedMl(inputML, analysisJet.pt(), output);
       }
 
-      scoreML[analysisJet.globalIndex()] = output[0];
+      fillScore(analysisJet.globalIndex(), output);
+    }
+
+    if (inBatch) {
+      evaluateMlBatch(fillScore);
     }
   }
 
@@ -615,15 +667,16 @@ struct JetTaggerHFTask {
   void analyzeJetAlgorithmGNNwExtra(AnyJets const& jets, AnyTracks const& tracks, AnyOriginalTracks const& origTracks)
   {
     for (const auto& jet : jets) {
-      std::vector<std::vector<float>> trkFeat;
-      jettaggingutilities::analyzeJetTrackInfo4GNNwExtra(jet, tracks, origTracks, trkFeat, trackPtMin, trackDcaXYMax, trackDcaZMax, nJetConst);
+      gnnTrkFeat.clear();
+      jettaggingutilities::analyzeJetTrackInfo4GNNwExtra(jet, tracks, origTracks, gnnTrkFeat, trackPtMin, trackDcaXYMax, trackDcaZMax, nJetConst);
 
       std::vector<float> jetFeat{jet.pt(), jet.phi(), jet.eta(), jet.mass()};
 
-      if (trkFeat.size() > 0) {
-        std::vector<float> feat;
-        std::vector<Ort::Value> gnnInput;
-        tensorAlloc.getGNNInput(jetFeat, trkFeat, feat, gnnInput);
+      if (gnnTrkFeat.size() > 0) {
+        // the tensors point to gnnFeat, they are released before the features of the next jet are written
+        gnnInput.clear();
+        gnnFeat.clear();
+        tensorAlloc.getGNNInput(jetFeat, gnnTrkFeat, gnnFeat, gnnInput);
 
         auto modelOutput = bMlResponse.getModelOutput(gnnInput, 0);
         float db = jettaggingutilities::getDb(modelOutput, fC);
@@ -644,15 +697,16 @@ struct JetTaggerHFTask {
   void analyzeJetAlgorithmGNN(AnyJets const& jets, AnyTracks const& tracks)
   {
     for (const auto& jet : jets) {
-      std::vector<std::vector<float>> trkFeat;
-      jettaggingutilities::analyzeJetTrackInfo4GNN(jet, tracks, trkFeat, trackPtMin, trackDcaXYMax, trackDcaZMax, nJetConst);
+      gnnTrkFeat.clear();
+      jettaggingutilities::analyzeJetTrackInfo4GNN(jet, tracks, gnnTrkFeat, trackPtMin, trackDcaXYMax, trackDcaZMax, nJetConst);
 
       std::vector<float> jetFeat{jet.pt(), jet.phi(), jet.eta(), jet.mass()};
 
-      if (trkFeat.size() > 0) {
-        std::vector<float> feat;
-        std::vector<Ort::Value> gnnInput;
-        tensorAlloc.getGNNInput(jetFeat, trkFeat, feat, gnnInput);
+      if (gnnTrkFeat.size() > 0) {
+        // the tensors point to gnnFeat, they are released before the features of the next jet are written
+        gnnInput.clear();
+        gnnFeat.clear();
+        tensorAlloc.getGNNInput(jetFeat, gnnTrkFeat, gnnFeat, gnnInput);
 
         auto modelOutput = bMlResponse.getModelOutput(gnnInput, 0);
         float db = jettaggingutilities::getDb(modelOutput, fC);
@@ -70,19 +70,23 @@ struct McOutlierRejectorTask {
       float selectionObjectPt = 0.0;
       if constexpr (std::is_same_v<std::decay_t<T>, aod::JetTracksMCD> || std::is_same_v<std::decay_t<T>, aod::JetParticles>) {
         for (auto selectionObject : selectionObjects) {
+          if (flagArray[collisionIndex]) { // the flag is never cleared, the remaining objects cannot change the decision
+            break;
+          }
           selectionObjectPt = selectionObject.pt();
           // may be slow - could save only MC particle then check difference only for tracks IDd as outliers?
           if constexpr (std::is_same_v<std::decay_t<T>, aod::JetTracksMCD>) { // tracks
             if (!jetderiveddatautilities::selectTrack(selectionObject, trackSelection)) {
               continue;
             }
-            auto& mcCollisions = mcCollisionsOpt.value().get();
             auto mcParticle = selectionObject.template mcParticle_as<soa::Join<aod::JetParticles, aod::JMcParticlePIs>>();
-            auto mcCollision = mcCollisions.sliceBy(perColParticle, mcParticle.mcCollisionId());
-            int subGenID = mcCollision.begin().getSubGeneratorId();
             int diffCollisionID = mcParticle.mcCollisionId() - mcCollisionId;
             if (diffCollisionID != 0 &&
                 selectionObjectPt > ptHatMax * ptHard) {
+              // the sub generator is only needed for the few tracks which can flag the collision, the slice is not done for the others
+              auto& mcCollisions = mcCollisionsOpt.value().get();
+              auto mcCollision = mcCollisions.sliceBy(perColParticle, mcParticle.mcCollisionId());
+              int subGenID = mcCollision.begin().getSubGeneratorId();
               if (subGenID != jetderiveddatautilities::JCollisionSubGeneratorId::mbGap && selectionObjectPt > ptHatMax * ptHard) {
                 flagArray[collisionIndex] = true;
               }
@@ -33,6 +33,7 @@
 #include <fastjet/PseudoJet.hh>
 
 #include <string>
+#include <tuple>
 #include <type_traits>
 #include <vector>
 
@@ -80,6 +81,8 @@ struct RhoEstimatorTask {
     Configurable<int> jetRecombScheme{"jetRecombScheme", 0, "jet recombination scheme. 0 = E-scheme, 1 = pT-scheme, 2 = pT2-scheme"};
     Configurable<float> bkgjetR{"bkgjetR", 0.2, "jet resolution parameter for determining background density"};
     Configurable<bool> doSparse{"doSparse", false, "perfom sparse estimation"};
+    Configurable<bool> doGrid{"doGrid", false, "estimate rho from the median of eta-phi grid tiles instead of kT jets with ghosts"};
+    Configurable<float> gridTileSize{"gridTileSize", 0.2, "requested tile size in eta and phi for the grid estimator"};
     Configurable<double> ghostRapMax{"ghostRapMax", 0.9, "Ghost rapidity max"};
     Configurable<int> ghostRepeat{"ghostRepeat", 1, "Ghost tiling repeats"};
     Configurable<double> ghostArea{"ghostArea", 0.005, "Area per ghost"};
@@ -137,11 +140,20 @@ struct RhoEstimatorTask {
     fastjet::GhostedAreaSpec ghostAreaSpec(config.ghostRapMax, config.ghostRepeat, config.ghostArea,
                                            config.ghostGridScatter, config.ghostKtScatter, config.ghostMeanPt);
     bkgSub.setGhostAreaSpec(ghostAreaSpec);
+    bkgSub.setGridTileSize(config.gridTileSize);
 
     eventSelectionBits = jetderiveddatautilities::initialiseEventSelectionBits(static_cast<std::string>(config.eventSelections));
     triggerMaskBits = jetderiveddatautilities::initialiseTriggerMaskBits(config.triggerMasks);
   }
 
+  std::tuple<double, double> estimateRho(const std::vector<fastjet::PseudoJet>& particles)
+  {
+    if (config.doGrid) {
+      return bkgSub.estimateRhoGridMedian(particles, config.doSparse);
+    }
+    return bkgSub.estimateRhoAreaMedian(particles, config.doSparse);
+  }
+
   Filter trackCuts = (aod::jtrack::pt >= config.trackPtMin && aod::jtrack::pt < config.trackPtMax && aod::jtrack::eta > config.trackEtaMin && aod::jtrack::eta < config.trackEtaMax && aod::jtrack::phi >= config.trackPhiMin && aod::jtrack::phi <= config.trackPhiMax);
   Filter partCuts = (aod::jmcparticle::pt >= config.trackPtMin && aod::jmcparticle::pt < config.trackPtMax && aod::jmcparticle::eta >= config.trackEtaMin && aod::jmcparticle::eta <= config.trackEtaMax && aod::jmcparticle::phi >= config.trackPhiMin && aod::jmcparticle::phi <= config.trackPhiMax);
 
@@ -212,7 +224,7 @@ struct RhoEstimatorTask {
     }
     inputParticles.clear();
     jetfindingutilities::analyseTracks<soa::Filtered<aod::JetTracks>, soa::Filtered<aod::JetTracks>::iterator>(inputParticles, tracks, trackSelection);
-    auto [rho, rhoM] = bkgSub.estimateRhoAreaMedian(inputParticles, config.doSparse);
+    auto [rho, rhoM] = estimateRho(inputParticles);
     rhoChargedTable(rho, rhoM);
   }
   PROCESS_SWITCH(RhoEstimatorTask, processChargedCollisions, "Fill rho tables for collisions using charged tracks", true);
@@ -225,7 +237,7 @@ struct RhoEstimatorTask {
     }
     inputParticles.clear();
     jetfindingutilities::analyseParticles<false, soa::Filtered<aod::JetParticles>, soa::Filtered<aod::JetParticles>::iterator>(inputParticles, particleSelection, 1, particles, pdgDatabase);
-    auto [rho, rhoM] = bkgSub.estimateRhoAreaMedian(inputParticles, config.doSparse);
+    auto [rho, rhoM] = estimateRho(inputParticles);
     rhoChargedMcTable(rho, rhoM);
   }
   PROCESS_SWITCH(RhoEstimatorTask, processChargedMcCollisions, "Fill rho tables for MC collisions using charged tracks", false);
@@ -240,7 +252,7 @@ struct RhoEstimatorTask {
       inputParticles.clear();
       jetfindingutilities::analyseTracks(inputParticles, tracks, trackSelection, &candidate);
 
-      auto [rho, rhoM] = bkgSub.estimateRhoAreaMedian(inputParticles, config.doSparse);
+      auto [rho, rhoM] = estimateRho(inputParticles);
       rhoD0Table(rho, rhoM);
     }
   }
@@ -256,7 +268,7 @@ struct RhoEstimatorTask {
       inputParticles.clear();
       jetfindingutilities::analyseParticles<true>(inputParticles, particleSelection, 1, particles, pdgDatabase, &candidate);
 
-      auto [rho, rhoM] = bkgSub.estimateRhoAreaMedian(inputParticles, config.doSparse);
+      auto [rho, rhoM] = estimateRho(inputParticles);
       rhoD0McTable(rho, rhoM);
     }
   }
@@ -272,7 +284,7 @@ struct RhoEstimatorTask {
       inputParticles.clear();
       jetfindingutilities::analyseTracks(inputParticles, tracks, trackSelection, &candidate);
 
-      auto [rho, rhoM] = bkgSub.estimateRhoAreaMedian(inputParticles, config.doSparse);
+      auto [rho, rhoM] = estimateRho(inputParticles);
       rhoDplusTable(rho, rhoM);
     }
   }
@@ -289,7 +301,7 @@ struct RhoEstimatorTask {
       inputParticles.clear();
       jetfindingutilities::analyseParticles<true>(inputParticles, particleSelection, 1, particles, pdgDatabase, &candidate);
 
-      auto [rho, rhoM] = bkgSub.estimateRhoAreaMedian(inputParticles, config.doSparse);
+      auto [rho, rhoM] = estimateRho(inputParticles);
       rhoDplusMcTable(rho, rhoM);
     }
   }
@@ -305,7 +317,7 @@ struct RhoEstimatorTask {
       inputParticles.clear();
       jetfindingutilities::analyseTracks(inputParticles, tracks, trackSelection, &candidate);
 
-      auto [rho, rhoM] = bkgSub.estimateRhoAreaMedian(inputParticles, config.doSparse);
+      auto [rho, rhoM] = estimateRho(inputParticles);
       rhoDsTable(rho, rhoM);
     }
   }
@@ -321,7 +333,7 @@ struct RhoEstimatorTask {
       inputParticles.clear();
       jetfindingutilities::analyseParticles<true>(inputParticles, particleSelection, 1, particles, pdgDatabase, &candidate);
 
-      auto [rho, rhoM] = bkgSub.estimateRhoAreaMedian(inputParticles, config.doSparse);
+      auto [rho, rhoM] = estimateRho(inputParticles);
       rhoDsMcTable(rho, rhoM);
     }
   }
@@ -337,7 +349,7 @@ struct RhoEstimatorTask {
       inputParticles.clear();
       jetfindingutilities::analyseTracks(inputParticles, tracks, trackSelection, &candidate);
 
-      auto [rho, rhoM] = bkgSub.estimateRhoAreaMedian(inputParticles, config.doSparse);
+      auto [rho, rhoM] = estimateRho(inputParticles);
       rhoDstarTable(rho, rhoM);
     }
   }
@@ -353,7 +365,7 @@ struct RhoEstimatorTask {
       inputParticles.clear();
       jetfindingutilities::analyseParticles<true>(inputParticles, particleSelection, 1, particles, pdgDatabase, &candidate);
 
-      auto [rho, rhoM] = bkgSub.estimateRhoAreaMedian(inputParticles, config.doSparse);
+      auto [rho, rhoM] = estimateRho(inputParticles);
       rhoDstarMcTable(rho, rhoM);
     }
   }
@@ -369,7 +381,7 @@ struct RhoEstimatorTask {
       inputParticles.clear();
       jetfindingutilities::analyseTracks(inputParticles, tracks, trackSelection, &candidate);
 
-      auto [rho, rhoM] = bkgSub.estimateRhoAreaMedian(inputParticles, config.doSparse);
+      auto [rho, rhoM] = estimateRho(inputParticles);
       rhoLcTable(rho, rhoM);
     }
   }
@@ -385,7 +397,7 @@ struct RhoEstimatorTask {
       inputParticles.clear();
       jetfindingutilities::analyseParticles<true>(inputParticles, particleSelection, 1, particles, pdgDatabase, &candidate);
 
-      auto [rho, rhoM] = bkgSub.estimateRhoAreaMedian(inputParticles, config.doSparse);
+      auto [rho, rhoM] = estimateRho(inputParticles);
       rhoLcMcTable(rho, rhoM);
     }
   }
@@ -401,7 +413,7 @@ struct RhoEstimatorTask {
       inputParticles.clear();
       jetfindingutilities::analyseTracks(inputParticles, tracks, trackSelection, &candidate);
 
-      auto [rho, rhoM] = bkgSub.estimateRhoAreaMedian(inputParticles, config.doSparse);
+      auto [rho, rhoM] = estimateRho(inputParticles);
       rhoB0Table(rho, rhoM);
     }
   }
@@ -417,7 +429,7 @@ struct RhoEstimatorTask {
       inputParticles.clear();
       jetfindingutilities::analyseParticles<true>(inputParticles, particleSelection, 1, particles, pdgDatabase, &candidate);
 
-      auto [rho, rhoM] = bkgSub.estimateRhoAreaMedian(inputParticles, config.doSparse);
+      auto [rho, rhoM] = estimateRho(inputParticles);
       rhoB0McTable(rho, rhoM);
     }
   }
@@ -433,7 +445,7 @@ struct RhoEstimatorTask {
       inputParticles.clear();
       jetfindingutilities::analyseTracks(inputParticles, tracks, trackSelection, &candidate);
 
-      auto [rho, rhoM] = bkgSub.estimateRhoAreaMedian(inputParticles, config.doSparse);
+      auto [rho, rhoM] = estimateRho(inputParticles);
       rhoBplusTable(rho, rhoM);
     }
   }
@@ -449,7 +461,7 @@ struct RhoEstimatorTask {
       inputParticles.clear();
       jetfindingutilities::analyseParticles<true>(inputParticles, particleSelection, 1, particles, pdgDatabase, &candidate);
 
-      auto [rho, rhoM] = bkgSub.estimateRhoAreaMedian(inputParticles, config.doSparse);
+      auto [rho, rhoM] = estimateRho(inputParticles);
       rhoBplusMcTable(rho, rhoM);
     }
   }
@@ -465,7 +477,7 @@ struct RhoEstimatorTask {
       inputParticles.clear();
       jetfindingutilities::analyseTracks(inputParticles, tracks, trackSelection, &candidate);
 
-      auto [rho, rhoM] = bkgSub.estimateRhoAreaMedian(inputParticles, config.doSparse);
+      auto [rho, rhoM] = estimateRho(inputParticles);
       rhoXicToXiPiPiTable(rho, rhoM);
     }
   }
@@ -481,7 +493,7 @@ struct RhoEstimatorTask {
       inputParticles.clear();
       jetfindingutilities::analyseParticles<true>(inputParticles, particleSelection, 1, particles, pdgDatabase, &candidate);
 
-      auto [rho, rhoM] = bkgSub.estimateRhoAreaMedian(inputParticles, config.doSparse);
+      auto [rho, rhoM] = estimateRho(inputParticles);
       rhoXicToXiPiPiMcTable(rho, rhoM);
     }
   }
@@ -497,7 +509,7 @@ struct RhoEstimatorTask {
       inputParticles.clear();
       jetfindingutilities::analyseTracks(inputParticles, tracks, trackSelection, &candidate);
 
-      auto [rho, rhoM] = bkgSub.estimateRhoAreaMedian(inputParticles, config.doSparse);
+      auto [rho, rhoM] = estimateRho(inputParticles);
       rhoDielectronTable(rho, rhoM);
     }
   }
@@ -513,7 +525,7 @@ struct RhoEstimatorTask {
       inputParticles.clear();
       jetfindingutilities::analyseParticles<true>(inputParticles, particleSelection, 1, particles, pdgDatabase, &candidate);
 
-      auto [rho, rhoM] = bkgSub.estimateRhoAreaMedian(inputParticles, config.doSparse);
+      auto [rho, rhoM] = estimateRho(inputParticles);
       rhoDielectronMcTable(rho, rhoM);
     }
   }
@@ -14,6 +14,7 @@
 /// \author Hadi Hassan <hadi.hassan@cern.ch>
 
 #include "PWGHF/Utils/utilsBfieldCCDB.h"
+#include "PWGHF/Utils/utilsSecondaryVertexing.h"
 #include "PWGJE/DataModel/Jet.h"
 #include "PWGJE/DataModel/JetReducedData.h"
 #include "PWGJE/DataModel/JetTagging.h"
@@ -43,9 +44,11 @@
 
 #include <GPUROOTCartesianFwd.h>
 
+#include <algorithm>
 #include <array>
+#include <cmath>
 #include <cstddef>
-#include <stdexcept>
+#include <cstdint>
 #include <string>
 #include <vector>
 
@@ -91,14 +94,16 @@ struct SecondaryVertexReconstruction {
   Configurable<float> etaMaxTrack{"etaMaxTrack", 4., "max. pseudorapidity"};
   Configurable<float> maxIPxy{"maxIPxy", 10, "maximum track DCA in xy plane"};
   Configurable<float> maxIPz{"maxIPz", 10, "maximum track DCA in z direction"};
+  Configurable<float> maxProngDeltaDcaZ{"maxProngDeltaDcaZ", -1., "reject (if>0) prong pairs whose DCAz differ by more than this before running the vertex fitter"};
+  Configurable<int> nThreads{"nThreads", 1, "number of threads over which the jets of a collision are vertexed"};
   Configurable<bool> fillHistograms{"fillHistograms", true, "do validation plots"};
 
   Configurable<std::string> ccdbUrl{"ccdbUrl", "http://alice-ccdb.cern.ch", "url of the ccdb repository"};
   Configurable<std::string> ccdbPathLut{"ccdbPathLut", "GLO/Param/MatLUT", "Path for LUT parametrization"};
   Configurable<std::string> ccdbPathGrpMag{"ccdbPathGrpMag", "GLO/Config/GRPMagField", "CCDB path of the GRPMagField object (Run 3)"};
 
-  o2::vertexing::DCAFitterN<2> df2; // 2-prong vertex fitter
-  o2::vertexing::DCAFitterN<3> df3; // 3-prong vertex fitter
+  std::vector<o2::vertexing::DCAFitterN<2>> df2; // 2-prong vertex fitters, one per thread
+  std::vector<o2::vertexing::DCAFitterN<3>> df3; // 3-prong vertex fitters, one per thread
   Service<o2::ccdb::BasicCCDBManager> ccdb;
   o2::base::MatLayerCylSet* lut = nullptr;
 
@@ -123,21 +128,14 @@ struct SecondaryVertexReconstruction {
       registry.add("hDispersion", "Vertex dispersion;#sigma_{vtx};nProngs;entries", {HistType::kTH2F, {{200, 0., 1.0}, nProngsBins}});
     }
 
-    df2.setPropagateToPCA(propagateToPCA);
-    df2.setMaxR(maxR);
-    df2.setMaxDZIni(maxDZIni);
-    df2.setMinParamChange(minParamChange);
-    df2.setMinRelChi2Change(minRelChi2Change);
-    df2.setUseAbsDCA(useAbsDCA);
-    df2.setWeightedFinalPCA(useWeightedFinalPCA);
-
-    df3.setPropagateToPCA(propagateToPCA);
-    df3.setMaxR(maxR);
-    df3.setMaxDZIni(maxDZIni);
-    df3.setMinParamChange(minParamChange);
-    df3.setMinRelChi2Change(minRelChi2Change);
-    df3.setUseAbsDCA(useAbsDCA);
-    df3.setWeightedFinalPCA(useWeightedFinalPCA);
+    df2.resize(std::max(1, static_cast<int>(nThreads)));
+    df3.resize(std::max(1, static_cast<int>(nThreads)));
+    for (auto& df : df2) {
+      o2::hf_vertexing::configureFitter(df, propagateToPCA, maxR, maxDZIni, minParamChange, minRelChi2Change, useAbsDCA, useWeightedFinalPCA);
+    }
+    for (auto& df : df3) {
+      o2::hf_vertexing::configureFitter(df, propagateToPCA, maxR, maxDZIni, minParamChange, minRelChi2Change, useAbsDCA, useWeightedFinalPCA);
+    }
 
     ccdb->setURL(ccdbUrl);
     ccdb->setCaching(true);
@@ -153,28 +151,224 @@ struct SecondaryVertexReconstruction {
   using JetTracksMCDwPIs = soa::Filtered<soa::Join<aod::JetTracksMCD, aod::JTrackPIs>>;
   using OriginalTracks = soa::Join<aod::Tracks, aod::TracksCov, aod::TrackSelection, aod::TracksDCA, aod::TracksDCACov>;
 
-  template <unsigned int numProngs, bool externalMagneticField, typename AnyCollision, typename AnyJet, typename AnyParticles>
-  void runCreatorNProng(AnyCollision const& collision,
-                        AnyJet const& analysisJet,
-                        AnyParticles const& listoftracks,
-                        std::vector<int>& svIndices,
-                        o2::vertexing::DCAFitterN<numProngs>& df,
-                        size_t prongIndex = 0,
-                        std::vector<size_t> currentCombination = {})
+  // per-collision work buffers, kept across collisions to avoid reallocating them
+  struct JetProngs {
+    std::vector<o2::track::TrackParametrizationWithError<float>> trackParVars; // selected constituents of all the jets
+    std::vector<float> energies;                                               // with pion mass hypothesis
+    std::vector<float> pts;
+    std::vector<float> dcaZs;
+    std::vector<std::size_t> jetOffsets; // selected constituents of jet i are in [jetOffsets[i], jetOffsets[i + 1])
+  } jetProngs;
+
+  // secondary vertices found in one jet, in column form
+  struct SecondaryVertexColumns {
+    std::vector<float> svX, svY, svZ;
+    std::vector<float> px, py, pz;
+    std::vector<float> energy, mass, chi2PCA, dispersion, errorDecayLength, errorDecayLengthXY;
+    std::vector<float> prongPt, prongDcaXY, prongDcaZ; // numProngs entries per vertex, only for the histograms
+
+    void clear()
+    {
+      for (auto* column : {&svX, &svY, &svZ, &px, &py, &pz, &energy, &mass, &chi2PCA, &dispersion, &errorDecayLength, &errorDecayLengthXY, &prongPt, &prongDcaXY, &prongDcaZ}) {
+        column->clear();
+      }
+    }
+  };
+  std::vector<SecondaryVertexColumns> jetVertices;
+  std::vector<float> jetEnergies;
+
+  /// Fits one combination of prongs and appends the vertex to the columns if it passes the selections
+  template <unsigned int numProngs>
+  void fitCombination(std::array<std::size_t, numProngs> const& combination,
+                      std::size_t firstProng,
+                      o2::dataformats::VertexBase const& primaryVertex,
+                      o2::vertexing::DCAFitterN<numProngs>& df,
+                      SecondaryVertexColumns& columns)
   {
+    // Create an array of track parameters and covariance matrices for the current combination
+    std::array<o2::track::TrackParametrizationWithError<float>, numProngs> trackParVars;
+    double energySV = 0.;
+    for (unsigned int inum = 0; inum < numProngs; ++inum) {
+      energySV += jetProngs.energies[firstProng + combination[inum]];
+      trackParVars[inum] = jetProngs.trackParVars[firstProng + combination[inum]];
+    }
+
+    // Reconstruct the secondary vertex
+    int processResult = o2::hf_vertexing::fitVertex(df, trackParVars);
+    if (processResult < 0) {
+      LOG(info) << "Run time error found. DCAFitterN cannot work, skipping the candidate.";
+      return;
+    }
+    if (processResult == 0) {
+      return;
+    }
 
-    const auto& particles = analysisJet.template tracks_as<AnyParticles>();
+    const auto& secondaryVertex = df.getPCACandidatePos();
+    if (std::sqrt(secondaryVertex[0] * secondaryVertex[0] + secondaryVertex[1] * secondaryVertex[1]) > maxRsv || std::abs(secondaryVertex[2]) > maxZsv) {
+      return;
+    }
+
+    float dispersion = 0.;
+    for (unsigned int inum = 0; inum < numProngs; ++inum) {
+      o2::dataformats::VertexBase sv(o2::math_utils::Point3D<float>{secondaryVertex[0], secondaryVertex[1], secondaryVertex[2]}, std::array<float, 6>{0});
+      o2::dataformats::DCA dcaSV;
+      auto& prong = df.getTrack(inum);
+      prong.propagateToDCA(sv, bz, &dcaSV);
+      dispersion += (dcaSV.getY() * dcaSV.getY() + dcaSV.getZ() * dcaSV.getZ());
+    }
+    dispersion = std::sqrt(dispersion / numProngs);
+
+    auto chi2PCA = df.getChi2AtPCACandidate();
+    auto covMatrixPCA = df.calcPCACovMatrixFlat();
+    auto covMatrixPV = primaryVertex.getCov();
+
+    // Get track momenta and impact parameters
+    // This modifies track momenta!
+    std::array<std::array<float, 3>, numProngs> arrayMomenta{};
+    std::array<o2::dataformats::DCA, numProngs> impactParameters;
+    for (unsigned int inum = 0; inum < numProngs; ++inum) {
+      trackParVars[inum].getPxPyPzGlo(arrayMomenta[inum]);
+      trackParVars[inum].propagateToDCA(primaryVertex, bz, &impactParameters[inum]);
+    }
 
-    if (currentCombination.size() == numProngs) {
-      // Create an array of track parameters and covariance matrices for the current combination
-      std::array<o2::track::TrackParametrizationWithError<float>, numProngs> trackParVars;
-      double energySV = 0.;
+    // get uncertainty of the decay length
+    double phi, theta;
+    getPointDirection(std::array{primaryVertex.getX(), primaryVertex.getY(), primaryVertex.getZ()}, secondaryVertex, phi, theta);
+    auto errorDecayLength = std::sqrt(getRotatedCovMatrixXX(covMatrixPV, phi, theta) + getRotatedCovMatrixXX(covMatrixPCA, phi, theta));
+    auto errorDecayLengthXY = std::sqrt(getRotatedCovMatrixXX(covMatrixPV, phi, 0.) + getRotatedCovMatrixXX(covMatrixPCA, phi, 0.));
+
+    // calculate invariant mass
+    std::array<double, numProngs> massArray{};
+    std::fill(massArray.begin(), massArray.end(), o2::constants::physics::MassPiPlus);
+    double massSV = RecoDecay::m(arrayMomenta, massArray);
+
+    // calculate momentum
+    double xMomenta = 0.;
+    double yMomenta = 0.;
+    double zMomenta = 0.;
+    for (unsigned int inum = 0; inum < numProngs; ++inum) {
+      xMomenta += arrayMomenta[inum][0];
+      yMomenta += arrayMomenta[inum][1];
+      zMomenta += arrayMomenta[inum][2];
+    }
+
+    columns.svX.push_back(secondaryVertex[0]);
+    columns.svY.push_back(secondaryVertex[1]);
+    columns.svZ.push_back(secondaryVertex[2]);
+    columns.px.push_back(xMomenta);
+    columns.py.push_back(yMomenta);
+    columns.pz.push_back(zMomenta);
+    columns.energy.push_back(energySV);
+    columns.mass.push_back(massSV);
+    columns.chi2PCA.push_back(chi2PCA);
+    columns.dispersion.push_back(dispersion);
+    columns.errorDecayLength.push_back(errorDecayLength);
+    columns.errorDecayLengthXY.push_back(errorDecayLengthXY);
+    if (fillHistograms) {
       for (unsigned int inum = 0; inum < numProngs; ++inum) {
-        const auto& prong = particles[currentCombination[inum]].template track_as<OriginalTracks>();
-        energySV += prong.energy(o2::constants::physics::MassPiPlus);
-        trackParVars[inum] = getTrackParCov(prong);
+        columns.prongPt.push_back(jetProngs.pts[firstProng + combination[inum]]);
+        columns.prongDcaXY.push_back(impactParameters[inum].getY());
+        columns.prongDcaZ.push_back(impactParameters[inum].getZ());
       }
+    }
+  }
 
+  /// Writes one secondary vertex to the table of the enabled process function and returns its index
+  template <unsigned int numProngs>
+  int fillSecondaryVertexTable(int64_t jetIndex, o2::dataformats::VertexBase const& primaryVertex, SecondaryVertexColumns const& columns, std::size_t iSV)
+  {
+    if ((doprocessData3Prongs || doprocessData3ProngsExternalMagneticField) && numProngs == ThreeProngCount) {
+      sv3prongTableData(jetIndex,
+                        primaryVertex.getX(), primaryVertex.getY(), primaryVertex.getZ(),
+                        columns.svX[iSV], columns.svY[iSV], columns.svZ[iSV],
+                        columns.px[iSV], columns.py[iSV], columns.pz[iSV],
+                        columns.energy[iSV], columns.mass[iSV], columns.chi2PCA[iSV], columns.dispersion[iSV], columns.errorDecayLength[iSV], columns.errorDecayLengthXY[iSV]);
+      return sv3prongTableData.lastIndex();
+    } else if ((doprocessData2Prongs || doprocessData2ProngsExternalMagneticField) && numProngs == TwoProngCount) {
+      sv2prongTableData(jetIndex,
+                        primaryVertex.getX(), primaryVertex.getY(), primaryVertex.getZ(),
+                        columns.svX[iSV], columns.svY[iSV], columns.svZ[iSV],
+                        columns.px[iSV], columns.py[iSV], columns.pz[iSV],
+                        columns.energy[iSV], columns.mass[iSV], columns.chi2PCA[iSV], columns.dispersion[iSV], columns.errorDecayLength[iSV], columns.errorDecayLengthXY[iSV]);
+      return sv2prongTableData.lastIndex();
+    } else if ((doprocessDataNProngs || doprocessDataNProngsExternalMagneticField)) {
+      svnprongTableData(jetIndex,
+                        primaryVertex.getX(), primaryVertex.getY(), primaryVertex.getZ(),
+                        columns.svX[iSV], columns.svY[iSV], columns.svZ[iSV],
+                        columns.px[iSV], columns.py[iSV], columns.pz[iSV],
+                        columns.energy[iSV], columns.mass[iSV], columns.chi2PCA[iSV], columns.dispersion[iSV], columns.errorDecayLength[iSV], columns.errorDecayLengthXY[iSV]);
+      return svnprongTableData.lastIndex();
+    } else if ((doprocessMCD3Prongs || doprocessMCD3ProngsExternalMagneticField) && numProngs == ThreeProngCount) {
+      sv3prongTableMCD(jetIndex,
+                       primaryVertex.getX(), primaryVertex.getY(), primaryVertex.getZ(),
+                       columns.svX[iSV], columns.svY[iSV], columns.svZ[iSV],
+                       columns.px[iSV], columns.py[iSV], columns.pz[iSV],
+                       columns.energy[iSV], columns.mass[iSV], columns.chi2PCA[iSV], columns.dispersion[iSV], columns.errorDecayLength[iSV], columns.errorDecayLengthXY[iSV]);
+      return sv3prongTableMCD.lastIndex();
+    } else if ((doprocessMCD2Prongs || doprocessMCD2ProngsExternalMagneticField) && numProngs == TwoProngCount) {
+      sv2prongTableMCD(jetIndex,
+                       primaryVertex.getX(), primaryVertex.getY(), primaryVertex.getZ(),
+                       columns.svX[iSV], columns.svY[iSV], columns.svZ[iSV],
+                       columns.px[iSV], columns.py[iSV], columns.pz[iSV],
+                       columns.energy[iSV], columns.mass[iSV], columns.chi2PCA[iSV], columns.dispersion[iSV], columns.errorDecayLength[iSV], columns.errorDecayLengthXY[iSV]);
+      return sv2prongTableMCD.lastIndex();
+    } else if (doprocessMCDNProngs || doprocessMCDNProngsExternalMagneticField) {
+      svnprongTableMCD(jetIndex,
+                       primaryVertex.getX(), primaryVertex.getY(), primaryVertex.getZ(),
+                       columns.svX[iSV], columns.svY[iSV], columns.svZ[iSV],
+                       columns.px[iSV], columns.py[iSV], columns.pz[iSV],
+                       columns.energy[iSV], columns.mass[iSV], columns.chi2PCA[iSV], columns.dispersion[iSV], columns.errorDecayLength[iSV], columns.errorDecayLengthXY[iSV]);
+      return svnprongTableMCD.lastIndex();
+    }
+    LOG(error) << "No process specified\n";
+    return -1;
+  }
+
+  /// Builds the secondary vertices of all the jets of a collision
+  /// The constituents are gathered and the output tables filled in jet order, the vertex fits in between can run over several threads
+  template <unsigned int numProngs, bool externalMagneticField, typename AnyCollision, typename AnyJets, typename AnyParticles, typename AnyIndicesTable>
+  void runCreatorNProng(AnyCollision const& collision,
+                        AnyJets const& jets,
+                        AnyParticles const& /*listoftracks*/,
+                        std::vector<o2::vertexing::DCAFitterN<numProngs>>& fitters,
+                        AnyIndicesTable& svIndicesTable)
+  {
+    // gather the selected constituents of every jet once, instead of at every step of the combinatorics
+    jetProngs.trackParVars.clear();
+    jetProngs.energies.clear();
+    jetProngs.pts.clear();
+    jetProngs.dcaZs.clear();
+    jetProngs.jetOffsets.clear();
+    jetEnergies.clear();
+    for (const auto& jet : jets) {
+      jetProngs.jetOffsets.push_back(jetProngs.trackParVars.size());
+      jetEnergies.push_back(jet.energy());
+      for (const auto& particle : jet.template tracks_as<AnyParticles>()) {
+        const auto& track = particle.template track_as<OriginalTracks>();
+        if (track.pt() < ptMinTrack || track.eta() < etaMinTrack || track.eta() > etaMaxTrack || std::abs(track.dcaXY()) > maxIPxy || std::abs(track.dcaZ()) > maxIPz) {
+          continue;
+        }
+        jetProngs.trackParVars.push_back(getTrackParCov(track));
+        jetProngs.energies.push_back(track.energy(o2::constants::physics::MassPiPlus));
+        jetProngs.pts.push_back(track.pt());
+        jetProngs.dcaZs.push_back(track.dcaZ());
+      }
+    }
+    std::size_t nJets = jetEnergies.size();
+    jetProngs.jetOffsets.push_back(jetProngs.trackParVars.size());
+    if (jetVertices.size() < nJets) {
+      jetVertices.resize(nJets);
+    }
+    for (std::size_t iJet = 0; iJet < nJets; ++iJet) {
+      jetVertices[iJet].clear();
+    }
+
+    bool hasCombinations = false;
+    for (std::size_t iJet = 0; iJet < nJets && !hasCombinations; ++iJet) {
+      hasCombinations = jetProngs.jetOffsets[iJet + 1] - jetProngs.jetOffsets[iJet] >= numProngs;
+    }
+    o2::dataformats::VertexBase primaryVertex;
+    if (hasCombinations) {
       if constexpr (externalMagneticField) {
         bz = magneticField;
       } else {
@@ -184,172 +378,49 @@ struct SecondaryVertexReconstruction {
           bz = o2::base::Propagator::Instance()->getNominalBz();
         }
       }
-
-      // Use a different fitter depending on the number of prongs
-      df.setBz(bz);
-
-      // Reconstruct the secondary vertex
-      int processResult = 0;
-      try {
-        std::apply([&df, &processResult](const auto&... elems) { processResult = df.process(elems...); }, trackParVars);
-      } catch (const std::runtime_error& error) {
-        LOG(info) << "Run time error found: " << error.what() << ". DCAFitterN cannot work, skipping the candidate.";
-        return;
-      }
-      if (processResult == 0) {
-        return;
-      }
-
-      const auto& secondaryVertex = df.getPCACandidatePos();
-      if (std::sqrt(secondaryVertex[0] * secondaryVertex[0] + secondaryVertex[1] * secondaryVertex[1]) > maxRsv || std::abs(secondaryVertex[2]) > maxZsv) {
-        return;
-      }
-
-      float dispersion = 0.;
-      for (unsigned int inum = 0; inum < numProngs; ++inum) {
-        o2::dataformats::VertexBase sv(o2::math_utils::Point3D<float>{secondaryVertex[0], secondaryVertex[1], secondaryVertex[2]}, std::array<float, 6>{0});
-        o2::dataformats::DCA dcaSV;
-        auto& prong = df.getTrack(inum);
-        prong.propagateToDCA(sv, bz, &dcaSV);
-        dispersion += (dcaSV.getY() * dcaSV.getY() + dcaSV.getZ() * dcaSV.getZ());
+      for (auto& df : fitters) {
+        df.setBz(bz);
       }
-      dispersion = std::sqrt(dispersion / numProngs);
-
-      auto chi2PCA = df.getChi2AtPCACandidate();
-      auto covMatrixPCA = df.calcPCACovMatrixFlat();
 
       // get track impact parameters
-      // This modifies track momenta!
-      auto primaryVertex = getPrimaryVertex(collision);
-      auto covMatrixPV = primaryVertex.getCov();
-
-      // Get track momenta and impact parameters
-      std::array<std::array<float, 3>, numProngs> arrayMomenta{};
-      std::array<o2::dataformats::DCA, numProngs> impactParameters;
-      for (unsigned int inum = 0; inum < numProngs; ++inum) {
-        trackParVars[inum].getPxPyPzGlo(arrayMomenta[inum]);
-        trackParVars[inum].propagateToDCA(primaryVertex, bz, &impactParameters[inum]);
+      primaryVertex = getPrimaryVertex(collision);
+      float maxDeltaDcaZ = maxProngDeltaDcaZ;
+      o2::hf_vertexing::runInParallel(static_cast<int>(fitters.size()), nJets, [&](std::size_t iJet, int iThread) {
+        std::size_t firstProng = jetProngs.jetOffsets[iJet];
+        auto areCompatible = [&](std::size_t iProng, std::size_t jProng) {
+          return maxDeltaDcaZ <= 0.f || std::abs(jetProngs.dcaZs[firstProng + iProng] - jetProngs.dcaZs[firstProng + jProng]) <= maxDeltaDcaZ;
+        };
+        o2::hf_vertexing::forEachCombination<numProngs>(jetProngs.jetOffsets[iJet + 1] - firstProng, areCompatible, [&](std::array<std::size_t, numProngs> const& combination) {
+          fitCombination<numProngs>(combination, firstProng, primaryVertex, fitters[iThread], jetVertices[iJet]);
+        });
+      });
+    }
 
+    std::size_t iJet = 0;
+    std::vector<int> svIndices;
+    for (const auto& jet : jets) {
+      svIndices.clear();
+      const auto& columns = jetVertices[iJet];
+      for (std::size_t iSV = 0; iSV < columns.svX.size(); ++iSV) {
+        svIndices.push_back(fillSecondaryVertexTable<numProngs>(jet.globalIndex(), primaryVertex, columns, iSV));
         if (fillHistograms) {
-          const auto& prong = particles[currentCombination[inum]].template track_as<OriginalTracks>();
-          registry.fill(HIST("hDcaXYNProngs"), prong.pt(), impactParameters[inum].getY() * toMicrometers, numProngs);
-          registry.fill(HIST("hDcaZNProngs"), prong.pt(), impactParameters[inum].getZ() * toMicrometers, numProngs);
+          for (unsigned int inum = 0; inum < numProngs; ++inum) {
+            registry.fill(HIST("hDcaXYNProngs"), columns.prongPt[iSV * numProngs + inum], columns.prongDcaXY[iSV * numProngs + inum] * toMicrometers, numProngs);
+            registry.fill(HIST("hDcaZNProngs"), columns.prongPt[iSV * numProngs + inum], columns.prongDcaZ[iSV * numProngs + inum] * toMicrometers, numProngs);
+          }
+          double decayLengthNormalised = RecoDecay::distance(std::array{primaryVertex.getX(), primaryVertex.getY(), primaryVertex.getZ()}, std::array{columns.svX[iSV], columns.svY[iSV], columns.svZ[iSV]}) / columns.errorDecayLength[iSV];
+          double decayLengthXYNormalised = RecoDecay::distanceXY(std::array{primaryVertex.getX(), primaryVertex.getY()}, std::array{columns.svX[iSV], columns.svY[iSV]}) / columns.errorDecayLengthXY[iSV];
+          double energyFraction = columns.energy[iSV] / jetEnergies[iJet];
+
+          registry.fill(HIST("hDispersion"), columns.dispersion[iSV], numProngs);
+          registry.fill(HIST("hMassNProngs"), columns.mass[iSV], numProngs);
+          registry.fill(HIST("hLxySNProngs"), decayLengthXYNormalised, numProngs);
+          registry.fill(HIST("hLSNProngs"), decayLengthNormalised, numProngs);
+          registry.fill(HIST("hFeNProngs"), energyFraction > 1. ? 0.99 : energyFraction, numProngs);
         }
       }
-
-      // get uncertainty of the decay length
-      double phi, theta;
-      getPointDirection(std::array{primaryVertex.getX(), primaryVertex.getY(), primaryVertex.getZ()}, secondaryVertex, phi, theta);
-      auto errorDecayLength = std::sqrt(getRotatedCovMatrixXX(covMatrixPV, phi, theta) + getRotatedCovMatrixXX(covMatrixPCA, phi, theta));
-      auto errorDecayLengthXY = std::sqrt(getRotatedCovMatrixXX(covMatrixPV, phi, 0.) + getRotatedCovMatrixXX(covMatrixPCA, phi, 0.));
-
-      // calculate invariant mass
-      std::array<double, numProngs> massArray{};
-      std::fill(massArray.begin(), massArray.end(), o2::constants::physics::MassPiPlus);
-      double massSV = RecoDecay::m(arrayMomenta, massArray);
-
-      // calculate momentum
-      double xMomenta = -1;
-      double yMomenta = -1;
-      double zMomenta = -1;
-      if (numProngs == ThreeProngCount) {
-        xMomenta = arrayMomenta[0][0] + arrayMomenta[1][0] + arrayMomenta[2][0];
-        yMomenta = arrayMomenta[0][1] + arrayMomenta[1][1] + arrayMomenta[2][1];
-        zMomenta = arrayMomenta[0][2] + arrayMomenta[1][2] + arrayMomenta[2][2];
-      } else if (numProngs == TwoProngCount) {
-        xMomenta = arrayMomenta[0][0] + arrayMomenta[1][0];
-        yMomenta = arrayMomenta[0][1] + arrayMomenta[1][1];
-        zMomenta = arrayMomenta[0][2] + arrayMomenta[1][2];
-      } else {
-        LOG(error) << "No process momenta\n";
-      }
-
-      // fill candidate table rows
-      if ((doprocessData3Prongs || doprocessData3ProngsExternalMagneticField) && numProngs == ThreeProngCount) {
-        sv3prongTableData(analysisJet.globalIndex(),
-                          primaryVertex.getX(), primaryVertex.getY(), primaryVertex.getZ(),
-                          secondaryVertex[0], secondaryVertex[1], secondaryVertex[2],
-                          xMomenta,
-                          yMomenta,
-                          zMomenta,
-                          energySV, massSV, chi2PCA, dispersion, errorDecayLength, errorDecayLengthXY);
-        svIndices.push_back(sv3prongTableData.lastIndex());
-      } else if ((doprocessData2Prongs || doprocessData2ProngsExternalMagneticField) && numProngs == TwoProngCount) {
-        sv2prongTableData(analysisJet.globalIndex(),
-                          primaryVertex.getX(), primaryVertex.getY(), primaryVertex.getZ(),
-                          secondaryVertex[0], secondaryVertex[1], secondaryVertex[2],
-                          xMomenta,
-                          yMomenta,
-                          zMomenta,
-                          energySV, massSV, chi2PCA, dispersion, errorDecayLength, errorDecayLengthXY);
-        svIndices.push_back(sv2prongTableData.lastIndex());
-      } else if ((doprocessDataNProngs || doprocessDataNProngsExternalMagneticField)) {
-        svnprongTableData(analysisJet.globalIndex(),
-                          primaryVertex.getX(), primaryVertex.getY(), primaryVertex.getZ(),
-                          secondaryVertex[0], secondaryVertex[1], secondaryVertex[2],
-                          xMomenta,
-                          yMomenta,
-                          zMomenta,
-                          energySV, massSV, chi2PCA, dispersion, errorDecayLength, errorDecayLengthXY);
-        svIndices.push_back(svnprongTableData.lastIndex());
-      } else if ((doprocessMCD3Prongs || doprocessMCD3ProngsExternalMagneticField) && numProngs == ThreeProngCount) {
-        sv3prongTableMCD(analysisJet.globalIndex(),
-                         primaryVertex.getX(), primaryVertex.getY(), primaryVertex.getZ(),
-                         secondaryVertex[0], secondaryVertex[1], secondaryVertex[2],
-                         xMomenta,
-                         yMomenta,
-                         zMomenta,
-                         energySV, massSV, chi2PCA, dispersion, errorDecayLength, errorDecayLengthXY);
-        svIndices.push_back(sv3prongTableMCD.lastIndex());
-      } else if ((doprocessMCD2Prongs || doprocessMCD2ProngsExternalMagneticField) && numProngs == TwoProngCount) {
-        sv2prongTableMCD(analysisJet.globalIndex(),
-                         primaryVertex.getX(), primaryVertex.getY(), primaryVertex.getZ(),
-                         secondaryVertex[0], secondaryVertex[1], secondaryVertex[2],
-                         xMomenta,
-                         yMomenta,
-                         zMomenta,
-                         energySV, massSV, chi2PCA, dispersion, errorDecayLength, errorDecayLengthXY);
-        svIndices.push_back(sv2prongTableMCD.lastIndex());
-      } else if (doprocessMCDNProngs || doprocessMCDNProngsExternalMagneticField) {
-        svnprongTableMCD(analysisJet.globalIndex(),
-                         primaryVertex.getX(), primaryVertex.getY(), primaryVertex.getZ(),
-                         secondaryVertex[0], secondaryVertex[1], secondaryVertex[2],
-                         xMomenta,
-                         yMomenta,
-                         zMomenta,
-                         energySV, massSV, chi2PCA, dispersion, errorDecayLength, errorDecayLengthXY);
-        svIndices.push_back(svnprongTableMCD.lastIndex());
-      } else {
-        LOG(error) << "No process specified\n";
-      }
-
-      // fill histograms
-      if (fillHistograms) {
-        double decayLengthNormalised = RecoDecay::distance(std::array{primaryVertex.getX(), primaryVertex.getY(), primaryVertex.getZ()}, std::array{secondaryVertex[0], secondaryVertex[1], secondaryVertex[2]}) / errorDecayLength;
-        double decayLengthXYNormalised = RecoDecay::distanceXY(std::array{primaryVertex.getX(), primaryVertex.getY()}, std::array{secondaryVertex[0], secondaryVertex[1]}) / errorDecayLengthXY;
-
-        registry.fill(HIST("hDispersion"), dispersion, numProngs);
-        registry.fill(HIST("hMassNProngs"), massSV, numProngs);
-        registry.fill(HIST("hLxySNProngs"), decayLengthXYNormalised, numProngs);
-        registry.fill(HIST("hLSNProngs"), decayLengthNormalised, numProngs);
-        registry.fill(HIST("hFeNProngs"), energySV / analysisJet.energy() > 1. ? 0.99 : energySV / analysisJet.energy(), numProngs);
-      }
-
-      return;
-    }
-
-    // Recursive call to explore all combinations
-    for (size_t iprong = prongIndex; iprong < particles.size(); ++iprong) {
-
-      const auto& testTrack = particles[iprong].template track_as<OriginalTracks>();
-      if (testTrack.pt() < ptMinTrack || testTrack.eta() < etaMinTrack || testTrack.eta() > etaMaxTrack || std::abs(testTrack.dcaXY()) > maxIPxy || std::abs(testTrack.dcaZ()) > maxIPz) {
-        continue;
-      }
-
-      currentCombination.push_back(iprong);
-      runCreatorNProng<numProngs, externalMagneticField>(
-        collision, analysisJet, listoftracks, svIndices, df, iprong + 1, currentCombination);
-      currentCombination.pop_back();
+      svIndicesTable(svIndices);
+      iJet++;
     }
   }
 
@@ -360,148 +431,96 @@ struct SecondaryVertexReconstruction {
 
   void processData3Prongs(JetCollisionwPIs::iterator const& collision, aod::Collisions const& /*realColl*/, soa::Join<aod::ChargedJets, aod::ChargedJetConstituents> const& jets, JetTracksData const& tracks, OriginalTracks const& /*tracks*/, aod::BCsWithTimestamps const& /*bcWithTimeStamps*/)
   {
-    for (const auto& jet : jets) {
-      std::vector<int> svIndices;
-      runCreatorNProng<3, false>(collision.template collision_as<aod::Collisions>(), jet, tracks, svIndices, df3);
-      sv3prongIndicesTableData(svIndices);
-    }
+    runCreatorNProng<3, false>(collision.template collision_as<aod::Collisions>(), jets, tracks, df3, sv3prongIndicesTableData);
   }
   PROCESS_SWITCH(SecondaryVertexReconstruction, processData3Prongs, "Reconstruct the data 3-prong secondary vertex", false);
 
   void processData3ProngsExternalMagneticField(JetCollisionwPIs::iterator const& collision, aod::Collisions const& /*realColl*/, soa::Join<aod::ChargedJets, aod::ChargedJetConstituents> const& jets, JetTracksData const& tracks, OriginalTracks const& /*tracks*/)
   {
-    for (const auto& jet : jets) {
-      std::vector<int> svIndices;
-      runCreatorNProng<3, true>(collision.template collision_as<aod::Collisions>(), jet, tracks, svIndices, df3);
-      sv3prongIndicesTableData(svIndices);
-    }
+    runCreatorNProng<3, true>(collision.template collision_as<aod::Collisions>(), jets, tracks, df3, sv3prongIndicesTableData);
   }
   PROCESS_SWITCH(SecondaryVertexReconstruction, processData3ProngsExternalMagneticField, "Reconstruct the data 3-prong secondary vertex with external magnetic field", false);
 
   void processData2Prongs(JetCollisionwPIs::iterator const& collision, aod::Collisions const& /*realColl*/, soa::Join<aod::ChargedJets, aod::ChargedJetConstituents> const& jets, JetTracksData const& tracks, OriginalTracks const& /*tracks*/, aod::BCsWithTimestamps const& /*bcWithTimeStamps*/)
   {
-    for (const auto& jet : jets) {
-      std::vector<int> svIndices;
-      runCreatorNProng<2, false>(collision.template collision_as<aod::Collisions>(), jet, tracks, svIndices, df2);
-      sv2prongIndicesTableData(svIndices);
-    }
+    runCreatorNProng<2, false>(collision.template collision_as<aod::Collisions>(), jets, tracks, df2, sv2prongIndicesTableData);
   }
   PROCESS_SWITCH(SecondaryVertexReconstruction, processData2Prongs, "Reconstruct the data 2-prong secondary vertex", false);
 
   void processData2ProngsExternalMagneticField(JetCollisionwPIs::iterator const& collision, aod::Collisions const& /*realColl*/, soa::Join<aod::ChargedJets, aod::ChargedJetConstituents> const& jets, JetTracksData const& tracks, OriginalTracks const& /*tracks*/)
   {
-    for (const auto& jet : jets) {
-      std::vector<int> svIndices;
-      runCreatorNProng<2, true>(collision.template collision_as<aod::Collisions>(), jet, tracks, svIndices, df2);
-      sv2prongIndicesTableData(svIndices);
-    }
+    runCreatorNProng<2, true>(collision.template collision_as<aod::Collisions>(), jets, tracks, df2, sv2prongIndicesTableData);
   }
   PROCESS_SWITCH(SecondaryVertexReconstruction, processData2ProngsExternalMagneticField, "Reconstruct the data 2-prong secondary vertex with extrernal magnetic field", false);
 
   void processDataNProngs(JetCollisionwPIs::iterator const& collision, aod::Collisions const& /*realColl*/, soa::Join<aod::ChargedJets, aod::ChargedJetConstituents> const& jets, JetTracksData const& tracks, OriginalTracks const& /*tracks*/, aod::BCsWithTimestamps const& /*bcWithTimeStamps*/)
   {
-    for (const auto& jet : jets) {
-      std::vector<int> svIndices;
-      if (nProng == ThreeProngCount) {
-        runCreatorNProng<ThreeProngCount, false>(collision.template collision_as<aod::Collisions>(), jet, tracks, svIndices, df3);
-        svnprongIndicesTableData(svIndices);
-      } else if (nProng == TwoProngCount) {
-        runCreatorNProng<TwoProngCount, false>(collision.template collision_as<aod::Collisions>(), jet, tracks, svIndices, df2);
-        svnprongIndicesTableData(svIndices);
-      } else {
-        LOG(error) << "set number of prong\n";
-      }
+    if (nProng == ThreeProngCount) {
+      runCreatorNProng<ThreeProngCount, false>(collision.template collision_as<aod::Collisions>(), jets, tracks, df3, svnprongIndicesTableData);
+    } else if (nProng == TwoProngCount) {
+      runCreatorNProng<TwoProngCount, false>(collision.template collision_as<aod::Collisions>(), jets, tracks, df2, svnprongIndicesTableData);
+    } else {
+      LOG(error) << "set number of prong\n";
     }
   }
   PROCESS_SWITCH(SecondaryVertexReconstruction, processDataNProngs, "Reconstruct the data mult-prong secondary vertex", false);
 
   void processDataNProngsExternalMagneticField(JetCollisionwPIs::iterator const& collision, aod::Collisions const& /*realColl*/, soa::Join<aod::ChargedJets, aod::ChargedJetConstituents> const& jets, JetTracksData const& tracks, OriginalTracks const& /*tracks*/)
   {
-    for (const auto& jet : jets) {
-      std::vector<int> svIndices;
-      if (nProng == ThreeProngCount) {
-        runCreatorNProng<ThreeProngCount, true>(collision.template collision_as<aod::Collisions>(), jet, tracks, svIndices, df3);
-        svnprongIndicesTableData(svIndices);
-      } else if (nProng == TwoProngCount) {
-        runCreatorNProng<TwoProngCount, true>(collision.template collision_as<aod::Collisions>(), jet, tracks, svIndices, df2);
-        svnprongIndicesTableData(svIndices);
-      } else {
-        LOG(error) << "set number of prong\n";
-      }
+    if (nProng == ThreeProngCount) {
+      runCreatorNProng<ThreeProngCount, true>(collision.template collision_as<aod::Collisions>(), jets, tracks, df3, svnprongIndicesTableData);
+    } else if (nProng == TwoProngCount) {
+      runCreatorNProng<TwoProngCount, true>(collision.template collision_as<aod::Collisions>(), jets, tracks, df2, svnprongIndicesTableData);
+    } else {
+      LOG(error) << "set number of prong\n";
     }
   }
   PROCESS_SWITCH(SecondaryVertexReconstruction, processDataNProngsExternalMagneticField, "Reconstruct the data mult-prong secondary vertex with extrernal magnetic field", false);
 
   void processMCD3Prongs(JetCollisionwPIs::iterator const& collision, aod::Collisions const& /*realColl*/, soa::Join<aod::ChargedMCDetectorLevelJets, aod::ChargedMCDetectorLevelJetConstituents> const& mcdjets, JetTracksMCDwPIs const& tracks, OriginalTracks const& /*tracks*/, aod::BCsWithTimestamps const& /*bcWithTimeStamps*/)
   {
-    for (const auto& jet : mcdjets) {
-      std::vector<int> svIndices;
-      runCreatorNProng<3, false>(collision.template collision_as<aod::Collisions>(), jet, tracks, svIndices, df3);
-      sv3prongIndicesTableMCD(svIndices);
-    }
+    runCreatorNProng<3, false>(collision.template collision_as<aod::Collisions>(), mcdjets, tracks, df3, sv3prongIndicesTableMCD);
   }
   PROCESS_SWITCH(SecondaryVertexReconstruction, processMCD3Prongs, "Reconstruct the MCD 3-prong secondary vertex", false);
 
   void processMCD3ProngsExternalMagneticField(JetCollisionwPIs::iterator const& collision, aod::Collisions const& /*realColl*/, soa::Join<aod::ChargedMCDetectorLevelJets, aod::ChargedMCDetectorLevelJetConstituents> const& mcdjets, JetTracksMCDwPIs const& tracks, OriginalTracks const& /*tracks*/)
   {
-    for (const auto& jet : mcdjets) {
-      std::vector<int> svIndices;
-      runCreatorNProng<3, true>(collision.template collision_as<aod::Collisions>(), jet, tracks, svIndices, df3);
-      sv3prongIndicesTableMCD(svIndices);
-    }
+    runCreatorNProng<3, true>(collision.template collision_as<aod::Collisions>(), mcdjets, tracks, df3, sv3prongIndicesTableMCD);
   }
   PROCESS_SWITCH(SecondaryVertexReconstruction, processMCD3ProngsExternalMagneticField, "Reconstruct the MCD 3-prong secondary vertex with external magnetic field", false);
 
   void processMCD2Prongs(JetCollisionwPIs::iterator const& collision, aod::Collisions const& /*realColl*/, soa::Join<aod::ChargedMCDetectorLevelJets, aod::ChargedMCDetectorLevelJetConstituents> const& mcdjets, JetTracksMCDwPIs const& tracks, OriginalTracks const& /*tracks*/, aod::BCsWithTimestamps const& /*bcWithTimeStamps*/)
   {
-    for (const auto& jet : mcdjets) {
-      std::vector<int> svIndices;
-      runCreatorNProng<2, false>(collision.template collision_as<aod::Collisions>(), jet, tracks, svIndices, df2);
-      sv2prongIndicesTableMCD(svIndices);
-    }
+    runCreatorNProng<2, false>(collision.template collision_as<aod::Collisions>(), mcdjets, tracks, df2, sv2prongIndicesTableMCD);
   }
   PROCESS_SWITCH(SecondaryVertexReconstruction, processMCD2Prongs, "Reconstruct the MCD 2-prong secondary vertex", false);
 
   void processMCD2ProngsExternalMagneticField(JetCollisionwPIs::iterator const& collision, aod::Collisions const& /*realColl*/, soa::Join<aod::ChargedMCDetectorLevelJets, aod::ChargedMCDetectorLevelJetConstituents> const& mcdjets, JetTracksMCDwPIs const& tracks, OriginalTracks const& /*tracks*/)
   {
-    for (const auto& jet : mcdjets) {
-      std::vector<int> svIndices;
-      runCreatorNProng<2, true>(collision.template collision_as<aod::Collisions>(), jet, tracks, svIndices, df2);
-      sv2prongIndicesTableMCD(svIndices);
-    }
+    runCreatorNProng<2, true>(collision.template collision_as<aod::Collisions>(), mcdjets, tracks, df2, sv2prongIndicesTableMCD);
   }
   PROCESS_SWITCH(SecondaryVertexReconstruction, processMCD2ProngsExternalMagneticField, "Reconstruct the MCD 2-prong secondary vertex with external magnetic field", false);
 
   void processMCDNProngs(JetCollisionwPIs::iterator const& collision, aod::Collisions const& /*realColl*/, soa::Join<aod::ChargedMCDetectorLevelJets, aod::ChargedMCDetectorLevelJetConstituents> const& mcdjets, JetTracksMCDwPIs const& tracks, OriginalTracks const& /*tracks*/, aod::BCsWithTimestamps const& /*bcWithTimeStamps*/)
   {
-    for (const auto& jet : mcdjets) {
-      std::vector<int> svIndices;
-      if (nProng == ThreeProngCount) {
-        runCreatorNProng<ThreeProngCount, false>(collision.template collision_as<aod::Collisions>(), jet, tracks, svIndices, df3);
-        svnprongIndicesTableMCD(svIndices);
-      } else if (nProng == TwoProngCount) {
-        runCreatorNProng<TwoProngCount, false>(collision.template collision_as<aod::Collisions>(), jet, tracks, svIndices, df2);
-        svnprongIndicesTableMCD(svIndices);
-      } else {
-        LOG(error) << "set number of prong\n";
-      }
+    if (nProng == ThreeProngCount) {
+      runCreatorNProng<ThreeProngCount, false>(collision.template collision_as<aod::Collisions>(), mcdjets, tracks, df3, svnprongIndicesTableMCD);
+    } else if (nProng == TwoProngCount) {
+      runCreatorNProng<TwoProngCount, false>(collision.template collision_as<aod::Collisions>(), mcdjets, tracks, df2, svnprongIndicesTableMCD);
+    } else {
+      LOG(error) << "set number of prong\n";
     }
   }
   PROCESS_SWITCH(SecondaryVertexReconstruction, processMCDNProngs, "Reconstruct the MCD n-prong secondary vertex", false);
 
   void processMCDNProngsExternalMagneticField(JetCollisionwPIs::iterator const& collision, aod::Collisions const& /*realColl*/, soa::Join<aod::ChargedMCDetectorLevelJets, aod::ChargedMCDetectorLevelJetConstituents> const& mcdjets, JetTracksMCDwPIs const& tracks, OriginalTracks const& /*tracks*/)
   {
-    for (const auto& jet : mcdjets) {
-      std::vector<int> svIndices;
-      if (nProng == ThreeProngCount) {
-        runCreatorNProng<ThreeProngCount, true>(collision.template collision_as<aod::Collisions>(), jet, tracks, svIndices, df3);
-        svnprongIndicesTableMCD(svIndices);
-      } else if (nProng == TwoProngCount) {
-        runCreatorNProng<TwoProngCount, true>(collision.template collision_as<aod::Collisions>(), jet, tracks, svIndices, df2);
-        svnprongIndicesTableMCD(svIndices);
-      } else {
-        LOG(error) << "set number of prong\n";
-      }
+    if (nProng == ThreeProngCount) {
+      runCreatorNProng<ThreeProngCount, true>(collision.template collision_as<aod::Collisions>(), mcdjets, tracks, df3, svnprongIndicesTableMCD);
+    } else if (nProng == TwoProngCount) {
+      runCreatorNProng<TwoProngCount, true>(collision.template collision_as<aod::Collisions>(), mcdjets, tracks, df2, svnprongIndicesTableMCD);
+    } else {
+      LOG(error) << "set number of prong\n";
     }
   }
   PROCESS_SWITCH(SecondaryVertexReconstruction, processMCDNProngsExternalMagneticField, "Reconstruct the MCD n-prong secondary vertex with external magnetic field", false);
@@ -18,6 +18,7 @@
 
 #include "PWGJE/Core/JetDerivedDataUtilities.h"
 #include "PWGJE/Core/JetHFUtilities.h"
+#include "PWGJE/Core/JetObservablesUtilities.h"
 #include "PWGJE/Core/JetUtilities.h"
 #include "PWGJE/DataModel/Jet.h"
 #include "PWGJE/DataModel/JetReducedData.h"
@@ -339,6 +340,8 @@ struct JetD0AngSubstructure {
   Configurable<float> kappa{"kappa", 1.0, "angularity kappa"}; // to do: configurable from json
   Configurable<float> alpha{"alpha", 1.0, "angularity alpha"};
 
+  jetobservablesutilities::JetConstituentArrays jetConstituents;
+
   std::vector<int> eventSelectionBits;
   int trackSelection = -1;
 
@@ -431,10 +434,8 @@ struct JetD0AngSubstructure {
   template <typename T, typename U>
   float jetCalculateAngularityEXP(T const& jet, U const& /*tracks*/)
   {
-    float tAngularity = 0.0;
-    for (const auto& constituent : jet.template tracks_as<U>()) {
-      tAngularity += std::pow(constituent.pt(), kappa) * std::pow(jetutilities::deltaR(jet, constituent) / (jet.r() / 100.f), alpha);
-    }
+    jetConstituents.fill(jet, jet.template tracks_as<U>());
+    float tAngularity = jetobservablesutilities::angularity(jetConstituents, kappa, alpha, jet.r() / 100.f);
     tAngularity /= std::pow(jet.pt(), kappa);
     return tAngularity;
   }
@@ -442,22 +443,22 @@ struct JetD0AngSubstructure {
   template <typename JetTableMCDConstituent>
   float jetCalculateAngularityMCD(JetTableMCDConstituent const& jet, aod::JetTracks const& tracks)
   {
-    float a = 0.f;
+    jetConstituents.clear();
     for (const auto& id : jet.tracksIds()) {
-      const auto trk = tracks.iteratorAt(id);
-      a += std::pow(trk.pt(), kappa) * std::pow(jetutilities::deltaR(jet, trk) / (jet.r() / 100.f), alpha);
+      jetConstituents.add(jet, tracks.iteratorAt(id));
     }
+    float a = jetobservablesutilities::angularity(jetConstituents, kappa, alpha, jet.r() / 100.f);
     return a / std::pow(jet.pt(), kappa);
   }
 
   template <typename JetTableMCPConstituent>
   float jetCalculateAngularityMCP(JetTableMCPConstituent const& jet, aod::JetParticles const& particles)
   {
-    float a = 0.f;
+    jetConstituents.clear();
     for (const auto& id : jet.tracksIds()) {
-      const auto p = particles.iteratorAt(id);
-      a += std::pow(p.pt(), kappa) * std::pow(jetutilities::deltaR(jet, p) / (jet.r() / 100.f), alpha);
+      jetConstituents.add(jet, particles.iteratorAt(id));
     }
+    float a = jetobservablesutilities::angularity(jetConstituents, kappa, alpha, jet.r() / 100.f);
     return a / std::pow(jet.pt(), kappa);
   }
 
@@ -14,6 +14,7 @@
 /// \brief Task for measuring the dependence of the jet shape function rho(r) on the distance r from the jet axis.
 
 #include "PWGJE/Core/JetDerivedDataUtilities.h"
+#include "PWGJE/Core/JetObservablesUtilities.h"
 #include "PWGJE/DataModel/Jet.h"
 #include "PWGJE/DataModel/JetReducedData.h"
 #include "PWGJE/DataModel/JetSubtraction.h"
@@ -398,12 +399,8 @@ struct JetShapeTask {
         }
 
         // summmention in Signal resion
-        for (size_t k = 0; k < nBins; k++) {
-          if (distanceCategory->at(k) <= distance &&
-              distance < distanceCategory->at(k + 1)) {
-            accumSumSig[i][k] += trkPt;
-            break;
-          }
+        if (int k = jetobservablesutilities::findRadialBin(distanceCategory.value, distance); k >= 0) {
+          accumSumSig[i][k] += trkPt;
         }
 
         // calculation in Background region
@@ -411,24 +408,16 @@ struct JetShapeTask {
         float deltaPhiBg1 = RecoDecay::constrainAngle(trkPhi - jet.phiBg1);
         float distBg1 = std::sqrt(dEta * dEta + deltaPhiBg1 * deltaPhiBg1);
 
-        for (size_t k = 0; k < nBins; k++) {
-          if (distanceCategory->at(k) <= distBg1 &&
-              distBg1 < distanceCategory->at(k + 1)) {
-            accumSumBg1[i][k] += trkPt;
-            break;
-          }
+        if (int k = jetobservablesutilities::findRadialBin(distanceCategory.value, distBg1); k >= 0) {
+          accumSumBg1[i][k] += trkPt;
         }
 
         // 2. Bg2
         float deltaPhiBg2 = RecoDecay::constrainAngle(trkPhi - jet.phiBg2);
         float distBg2 = std::sqrt(dEta * dEta + deltaPhiBg2 * deltaPhiBg2);
 
-        for (size_t k = 0; k < nBins; k++) {
-          if (distanceCategory->at(k) <= distBg2 &&
-              distBg2 < distanceCategory->at(k + 1)) {
-            accumSumBg2[i][k] += trkPt;
-            break;
-          }
+        if (int k = jetobservablesutilities::findRadialBin(distanceCategory.value, distBg2); k >= 0) {
+          accumSumBg2[i][k] += trkPt;
         }
       }
     }
@@ -18,6 +18,7 @@
 #define PWGJE_TASKS_JETSUBSTRUCTUREHF_H_
 
 #include "PWGJE/Core/FastJetUtilities.h"
+#include "PWGJE/Core/JetCandidateUtilities.h"
 #include "PWGJE/Core/JetDQUtilities.h"
 #include "PWGJE/Core/JetDerivedDataUtilities.h"
 #include "PWGJE/Core/JetFinder.h"
@@ -108,6 +109,7 @@ struct JetSubstructureHFTask {
   std::vector<float> pairPerpCone1PerpCone2PtVec;
   std::vector<float> pairPerpCone1PerpCone2EnergyVec;
   std::vector<float> pairPerpCone1PerpCone2ThetaVec;
+  jetcandidateutilities::DaughterTrackLookup daughterTracks;
   float angularity;
   float leadingConstituentPt;
   float perpConeRho;
@@ -343,6 +345,7 @@ struct JetSubstructureHFTask {
       }
     }
     auto tracksPerCollision = tracks.sliceBy(slicer, slicerId);
+    daughterTracks.build(jet.template candidates_as<V>());
 
     float perpCone1Phi = RecoDecay::constrainAngle<float, float>(jet.phi() + (M_PI / 2.));
     float perpCone2Phi = RecoDecay::constrainAngle<float, float>(jet.phi() - (M_PI / 2.));
@@ -360,14 +363,7 @@ struct JetSubstructureHFTask {
           continue;
         }
       }
-      bool isdaughterTrack = false;
-      for (auto& candidate : jet.template candidates_as<V>()) {
-        if (jetcandidateutilities::isDaughterTrack(track, candidate)) {
-          isdaughterTrack = true;
-          break;
-        }
-      }
-      if (isdaughterTrack) {
+      if (daughterTracks.isDaughterTrack(track)) {
         continue;
       }
       float deltaPhi1 = track.phi() - perpCone1Phi;
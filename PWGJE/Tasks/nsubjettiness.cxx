@@ -32,7 +32,9 @@
 #include <TH1.h>
 #include <TH2.h>
 
+#include <fastjet/ClusterSequenceArea.hh>
 #include <fastjet/JetDefinition.hh>
+#include <fastjet/PseudoJet.hh>
 #include <fastjet/contrib/AxesDefinition.hh>
 
 #include <vector>
@@ -186,9 +188,12 @@ struct NSubjettinessTask {
   template <bool isMCP, typename T, typename U>
   void processJet(T const& jet, U const& tracks, float weight = 1.0)
   {
-    nSub_Kt_results = jetsubstructureutilities::getNSubjettiness(jet, tracks, tracks, tracks, 2, fastjet::contrib::KT_Axes());
-    nSub_CA_results = jetsubstructureutilities::getNSubjettiness(jet, tracks, tracks, tracks, 2, fastjet::contrib::CA_Axes());
-    nSub_CASD_results = jetsubstructureutilities::getNSubjettiness(jet, tracks, tracks, tracks, 2, fastjet::contrib::CA_Axes(), true, SD_z_cut, SD_beta);
+    // the jet is reclustered once for the three sets of axes
+    fastjet::PseudoJet pseudoJet;
+    fastjet::ClusterSequenceArea clusterSeq(jetsubstructureutilities::jetToPseudoJet(jet, tracks, tracks, tracks, pseudoJet, 0, false));
+    nSub_Kt_results = jetsubstructureutilities::getNSubjettiness(pseudoJet, jet.r() / 100.0, 2, fastjet::contrib::KT_Axes());
+    nSub_CA_results = jetsubstructureutilities::getNSubjettiness(pseudoJet, jet.r() / 100.0, 2, fastjet::contrib::CA_Axes());
+    nSub_CASD_results = jetsubstructureutilities::getNSubjettiness(pseudoJet, jet.r() / 100.0, 2, fastjet::contrib::CA_Axes(), true, SD_z_cut, SD_beta);
 
     if (jet.tracksIds().size() > 1) {
       if constexpr (isMCP) {
@@ -160,6 +160,30 @@ DECLARE_SOA_TABLE(McMiniTrkTables, "AOD", "MCMINITRKTABLE",
                   LFEbyeTable::GenEtaMask,
                   LFEbyeTable::IsReco);
 using McMiniTrkTable = McMiniTrkTables::iterator;
+
+namespace LFEbyeCountTable
+{
+DECLARE_SOA_COLUMN(Species, species, uint8_t); //! 0: proton, 1: deuteron, 2: lambda
+DECLARE_SOA_COLUMN(PtBin, ptBin, uint8_t);     //! bin of the countPtBins edges of ebye-maker
+DECLARE_SOA_COLUMN(EtaBin, etaBin, uint8_t);   //! bin of the countEtaBins edges of ebye-maker
+DECLARE_SOA_COLUMN(NPos, nPos, uint16_t);      //! number of particles in the bin
+DECLARE_SOA_COLUMN(NNeg, nNeg, uint16_t);      //! number of antiparticles in the bin
+DECLARE_SOA_DYNAMIC_COLUMN(NetCount, netCount, //! net number of particles in the bin
+                           [](uint16_t nPos, uint16_t nNeg) -> int { return static_cast<int>(nPos) - static_cast<int>(nNeg); });
+} // namespace LFEbyeCountTable
+
+// counts of the candidates of a collision in the (species, pt, eta) bins with at least one candidate: the power sums
+// of the (efficiency weighted) net number of particles follow from the counts of the bins, without the candidate tables
+DECLARE_SOA_TABLE(EbyeCountTables, "AOD", "EBYECOUNTTABLE",
+                  o2::soa::Index<>,
+                  LFEbyeTable::MiniCollTableId,
+                  LFEbyeCountTable::Species,
+                  LFEbyeCountTable::PtBin,
+                  LFEbyeCountTable::EtaBin,
+                  LFEbyeCountTable::NPos,
+                  LFEbyeCountTable::NNeg,
+                  LFEbyeCountTable::NetCount<LFEbyeCountTable::NPos, LFEbyeCountTable::NNeg>);
+using EbyeCountTable = EbyeCountTables::iterator;
 } // namespace o2::aod
 
 #endif // PWGLF_DATAMODEL_LFEBYETABLES_H_
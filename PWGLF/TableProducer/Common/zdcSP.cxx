@@ -15,6 +15,7 @@
 #include "PWGLF/DataModel/LFzdcSPtables.h"
 
 #include "Common/CCDB/ctpRateFetcher.h"
+#include "Common/Core/ZdcCentroid.h"
 #include "Common/DataModel/Centrality.h"
 #include "Common/DataModel/EventSelection.h"
 
@@ -147,52 +148,8 @@ struct zdcSP {
                  zncCommon, zncEnergy[0], zncEnergy[1], zncEnergy[2], zncEnergy[3]);
     }
 
-    ///          | 3 | 4 |
-    /// beam out | 1 | 2 | --> x       (ZNC)
-    ///
-    ///          | 3 | 4 |
-    ///    <-- x | 1 | 2 |   beam in   (ZNA)
-
-    constexpr float beamEne = 5.36 * 0.5;
-    constexpr float x[4] = {-1.75, 1.75, -1.75, 1.75};
-    constexpr float y[4] = {-1.75, -1.75, 1.75, 1.75};
-    constexpr float alpha = 0.395;
-    float numXZNC = 0., numYZNC = 0., denZNC = 0.;
-    float numXZNA = 0., numYZNA = 0., denZNA = 0.;
-    //
-    for (int i = 0; i < 4; i++) {
-      if (zncEnergy[i] > 0.) {
-        float wZNC = std::pow(zncEnergy[i], alpha);
-        numXZNC -= x[i] * wZNC;
-        numYZNC += y[i] * wZNC;
-        denZNC += wZNC;
-      }
-      if (znaEnergy[i] > 0.) {
-        float wZNA = std::pow(znaEnergy[i], alpha);
-        numXZNA += x[i] * wZNA;
-        numYZNA += y[i] * wZNA;
-        denZNA += wZNA;
-      }
-    }
-    //
-    float centrZNC[2], centrZNA[2];
-    if (denZNC != 0.) {
-      float nSpecnC = zncCommon / beamEne;
-      float cZNC = 1.89358 - 0.71262 / (nSpecnC + 0.71789);
-      centrZNC[0] = cZNC * numXZNC / denZNC;
-      centrZNC[1] = cZNC * numYZNC / denZNC;
-    } else {
-      centrZNC[0] = centrZNC[1] = 999.;
-    }
-    //
-    if (denZNA != 0.) {
-      float nSpecnA = znaCommon / beamEne;
-      float cZNA = 1.89358 - 0.71262 / (nSpecnA + 0.71789);
-      centrZNA[0] = cZNA * numXZNA / denZNA;
-      centrZNA[1] = cZNA * numYZNA / denZNA;
-    } else {
-      centrZNA[0] = centrZNA[1] = 999.;
-    }
+    const auto centrZNC = o2::common::zdc::znCentroid(zncEnergy, zncCommon, true);
+    const auto centrZNA = o2::common::zdc::znCentroid(znaEnergy, znaCommon, false);
     for (int i{0}; i < 2; ++i) {
       gCurrentCentroidC[i]->Fill(seconds, centrZNC[i]);
       gCurrentCentroidA[i]->Fill(seconds, centrZNA[i]);
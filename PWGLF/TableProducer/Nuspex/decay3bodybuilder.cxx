@@ -61,12 +61,15 @@
 
 #include <KFParticle.h>
 
+#include <algorithm>
 #include <array>
 #include <cmath>
+#include <cstdint>
 #include <cstdlib>
 #include <memory>
 #include <ostream>
 #include <string>
+#include <thread>
 #include <unordered_map>
 #include <vector>
 
@@ -138,6 +141,7 @@ struct decay3bodyBuilder {
   Configurable<std::string> triggerList{"triggerList", "fTriggerEventF1Proton, fTrackedOmega, fTrackedXi, fOmegaLargeRadius, fDoubleOmega, fOmegaHighMult, fSingleXiYN, fQuadrupleXi, fDoubleXi, fhadronOmega, fOmegaXi, fTripleXi, fOmega, fGammaVeryLowPtEMCAL, fGammaVeryLowPtDCAL, fGammaHighPtEMCAL, fGammaLowPtEMCAL, fGammaVeryHighPtDCAL, fGammaVeryHighPtEMCAL, fGammaLowPtDCAL, fJetNeutralLowPt, fJetNeutralHighPt, fGammaHighPtDCAL, fJetFullLowPt, fJetFullHighPt, fEMCALReadout, fPCMandEE, fPHOSnbar, fPCMHighPtPhoton, fPHOSPhoton, fLD, fPPPHI, fPD, fLLL, fPLL, fPPL, fPPP, fLeadingPtTrack, fHighFt0cFv0Flat, fHighFt0cFv0Mult, fHighFt0Flat, fHighFt0Mult, fHighMultFv0, fHighTrackMult, fHfSingleNonPromptCharm3P, fHfSingleNonPromptCharm2P, fHfSingleCharm3P, fHfPhotonCharm3P, fHfHighPt2P, fHfSigmaC0K0, fHfDoubleCharm2P, fHfBeauty3P, fHfFemto3P, fHfFemto2P, fHfHighPt3P, fHfSigmaCPPK, fHfDoubleCharm3P, fHfDoubleCharmMix, fHfPhotonCharm2P, fHfV0Charm2P, fHfBeauty4P, fHfV0Charm3P, fHfSingleCharm2P, fHfCharmBarToXiBach, fSingleMuHigh, fSingleMuLow, fLMeeHMR, fDiMuon, fDiElectron, fLMeeIMR, fSingleE, fTrackHighPt, fTrackLowPt, fJetChHighPt, fJetChLowPt, fUDdiffLarge, fUDdiffSmall, fITSextremeIonisation, fITSmildIonisation, fH3L3Body, fHe, fH2", "List of triggers used to select events"};
   Configurable<bool> onlyKeepInterestedTrigger{"onlyKeepInterestedTrigger", false, "Flag to keep only interested trigger"};
   Configurable<bool> doLikeSign{"doLikeSign", false, "Flag to produce like-sign background. If true, require the sign of pion is as same as deuteron but not proton."};
+  Configurable<int> nThreads{"nThreads", 1, "Number of threads used to fit the prefiltered decay3body candidates (AO2D input only)"};
 
   // CCDB options
   struct : ConfigurableGroup {
@@ -187,6 +191,7 @@ struct decay3bodyBuilder {
     Configurable<float> maxPt{"maxPt", 5.0, "Max Pt of decay3body candidate"};
     Configurable<float> minMass{"minMass", 2.96, "Min mass of decay3body candidate"};
     Configurable<float> maxMass{"maxMass", 3.04, "Max mass of decay3body candidate"};
+    Configurable<float> massMarginAtIU{"massMarginAtIU", -1.0, "Margin on the mass window for the prefilter with the daughter momenta at IU (< 0: disabled)"};
     Configurable<float> minCtau{"minCtau", 0.0, "Min ctau of decay3body candidate"};
     Configurable<float> maxCtau{"maxCtau", 100.0, "Max ctau of decay3body candidate"};
     Configurable<float> minCosPA{"minCosPA", 0.9, "Min cosPA of decay3body candidate"};
@@ -277,6 +282,21 @@ struct decay3bodyBuilder {
   // MC info
   std::vector<bool> isGoodCollision;
 
+  // candidates surviving the prefilter, and their vertex fits when done in parallel
+  struct decay3bodyInput {
+    int64_t decay3bodyIndex;
+    double tofNSigmaDeuteron;
+  };
+  enum PrebuiltStatus : uint8_t {
+    kNotPrebuilt = 0, // left to the sequential loop
+    kPrebuiltOk,
+    kPrebuiltFailed
+  };
+  std::vector<decay3bodyInput> candidatesToBuild;
+  std::vector<o2::pwglf::decay3bodyBuilderHelper> workerHelpers;
+  std::vector<o2::pwglf::decay3bodyCandidate> prebuiltCandidates;
+  std::vector<uint8_t> prebuiltStatus;
+
   void init(InitContext& initContext)
   {
     zorroSummary.setObject(zorro.getZorroSummary());
@@ -344,6 +364,7 @@ struct decay3bodyBuilder {
     helper.decay3bodyselections.maxPt = decay3bodyBuilderOpts.maxPt;
     helper.decay3bodyselections.minMass = decay3bodyBuilderOpts.minMass;
     helper.decay3bodyselections.maxMass = decay3bodyBuilderOpts.maxMass;
+    helper.decay3bodyselections.massMarginAtIU = decay3bodyBuilderOpts.massMarginAtIU;
     helper.decay3bodyselections.minCtau = decay3bodyBuilderOpts.minCtau;
     helper.decay3bodyselections.maxCtau = decay3bodyBuilderOpts.maxCtau;
     helper.decay3bodyselections.minCosPA = decay3bodyBuilderOpts.minCosPA;
@@ -683,7 +704,9 @@ struct decay3bodyBuilder {
 
     // Loop over all decay3bodys in same time frame
     registry.fill(HIST("Counters/hInputStatistics"), kVtx3BodyDatas, decay3bodys.size());
-    int lastRunNumber = -1;
+
+    // prefilter: event selection and cheap daughter selections, nothing is propagated or fitted yet
+    candidatesToBuild.clear();
     for (const auto& decay3body : decay3bodys) {
       // only build tracked decay3body if aksed
       if (decay3bodyBuilderOpts.buildOnlyTracked && fTrackedClSizeVector[decay3body.globalIndex()] == 0) {
@@ -713,22 +736,8 @@ struct decay3bodyBuilder {
         }
       }
 
-      // initialise CCDB from run number saved in reduced collisions table when running over reduced data
-      if constexpr (!soa::is_table<TBCs>) { // only do if running over reduced data (otherwise CCDB is initialised in process function)
-        if (collision.runNumber() != lastRunNumber) {
-          initFittersWithMagField(collision.runNumber(), getMagFieldFromRunNumber(collision.runNumber()));
-          lastRunNumber = collision.runNumber(); // Update the last run number
-          LOG(debug) << "CCDB initialized for run " << lastRunNumber;
-        }
-      }
-
       // aquire tracks
-      auto trackPos = decay3body.template track0_as<TTracksTo>();
-      auto trackNeg = decay3body.template track1_as<TTracksTo>();
-      auto trackDeuteron = decay3body.template track2_as<TTracksTo>();
-      int protonSign = doLikeSign ? -trackDeuteron.sign() : trackDeuteron.sign();
-      auto trackProton = protonSign > 0 ? trackPos : trackNeg;
-      auto trackPion = protonSign > 0 ? trackNeg : trackPos;
+      auto [trackProton, trackPion, trackDeuteron] = getDaughterTracks<TTracksTo>(decay3body);
 
       // get deuteron TOF PID
       float tofNSigmaDeuteron;
@@ -742,24 +751,43 @@ struct decay3bodyBuilder {
         }
       }
 
+      if (decay3bodyBuilderOpts.useSelections && !helper.preselectDecay3BodyCandidate(trackProton, trackPion, trackDeuteron, tofNSigmaDeuteron, decay3bodyBuilderOpts.useTPCforPion, decay3bodyBuilderOpts.acceptTPCOnly, decay3bodyBuilderOpts.askOnlyITSMatch)) {
+        continue;
+      }
+      candidatesToBuild.push_back({decay3body.globalIndex(), tofNSigmaDeuteron});
+    }
+
+    // fit the prefiltered candidates in parallel, if requested. Running over reduced data,
+    // the magnetic field may change from one candidate to the next, so the fits stay sequential
+    prebuiltStatus.clear();
+    if constexpr (soa::is_table<TBCs>) {
+      prebuildCandidates<TTracksTo>(collisions, decay3bodys);
+    }
+
+    int lastRunNumber = -1;
+    for (std::size_t iCandidate = 0; iCandidate < candidatesToBuild.size(); iCandidate++) {
+      auto const& decay3body = decay3bodys.rawIteratorAt(candidatesToBuild[iCandidate].decay3bodyIndex);
+      auto const& collision = collisions.rawIteratorAt(decay3body.collisionId());
+
+      // initialise CCDB from run number saved in reduced collisions table when running over reduced data
+      if constexpr (!soa::is_table<TBCs>) { // only do if running over reduced data (otherwise CCDB is initialised in process function)
+        if (collision.runNumber() != lastRunNumber) {
+          initFittersWithMagField(collision.runNumber(), getMagFieldFromRunNumber(collision.runNumber()));
+          lastRunNumber = collision.runNumber(); // Update the last run number
+          LOG(debug) << "CCDB initialized for run " << lastRunNumber;
+        }
+      }
+
+      // aquire tracks
+      auto [trackProton, trackPion, trackDeuteron] = getDaughterTracks<TTracksTo>(decay3body);
+
       /// build Decay3body candidate
-      if (!helper.buildDecay3BodyCandidate(collision,
-                                           trackProton,
-                                           trackPion,
-                                           trackDeuteron,
-                                           decay3body.globalIndex(),
-                                           tofNSigmaDeuteron,
-                                           fTrackedClSizeVector[decay3body.globalIndex()],
-                                           decay3bodyBuilderOpts.useKFParticle,
-                                           decay3bodyBuilderOpts.kfSetTopologicalConstraint,
-                                           decay3bodyBuilderOpts.useSelections,
-                                           decay3bodyBuilderOpts.useChi2Selection,
-                                           decay3bodyBuilderOpts.useTPCforPion,
-                                           decay3bodyBuilderOpts.acceptTPCOnly,
-                                           decay3bodyBuilderOpts.askOnlyITSMatch,
-                                           decay3bodyBuilderOpts.calculateCovariance,
-                                           false /*isEventMixing*/,
-                                           false /*applySVertexerCuts*/)) {
+      if (iCandidate < prebuiltStatus.size()) {
+        if (prebuiltStatus[iCandidate] == kPrebuiltFailed) {
+          continue;
+        }
+        helper.decay3body = prebuiltCandidates[iCandidate];
+      } else if (!buildCandidate(helper, collision, trackProton, trackPion, trackDeuteron, decay3body.globalIndex(), candidatesToBuild[iCandidate].tofNSigmaDeuteron)) {
         continue;
       }
 
@@ -1060,6 +1088,77 @@ struct decay3bodyBuilder {
     } // end decay3body combinations loop
   }
 
+  // ______________________________________________________________
+  // daughter tracks of a decay3body, in the order proton, pion, deuteron
+  template <class TTracksTo, typename T3Body>
+  auto getDaughterTracks(T3Body const& decay3body)
+  {
+    auto trackPos = decay3body.template track0_as<TTracksTo>();
+    auto trackNeg = decay3body.template track1_as<TTracksTo>();
+    auto trackDeuteron = decay3body.template track2_as<TTracksTo>();
+    int protonSign = doLikeSign ? -trackDeuteron.sign() : trackDeuteron.sign();
+    return std::array{protonSign > 0 ? trackPos : trackNeg, protonSign > 0 ? trackNeg : trackPos, trackDeuteron};
+  }
+
+  // ______________________________________________________________
+  // vertex fit and final selections of a decay3body from the data frame
+  template <typename TCollision, typename TTrack>
+  bool buildCandidate(o2::pwglf::decay3bodyBuilderHelper& builder, TCollision const& collision, TTrack const& trackProton, TTrack const& trackPion, TTrack const& trackDeuteron, int64_t decay3bodyIndex, double tofNSigmaDeuteron)
+  {
+    return builder.buildDecay3BodyCandidate(collision,
+                                            trackProton,
+                                            trackPion,
+                                            trackDeuteron,
+                                            decay3bodyIndex,
+                                            tofNSigmaDeuteron,
+                                            fTrackedClSizeVector[decay3bodyIndex],
+                                            decay3bodyBuilderOpts.useKFParticle,
+                                            decay3bodyBuilderOpts.kfSetTopologicalConstraint,
+                                            decay3bodyBuilderOpts.useSelections,
+                                            decay3bodyBuilderOpts.useChi2Selection,
+                                            decay3bodyBuilderOpts.useTPCforPion,
+                                            decay3bodyBuilderOpts.acceptTPCOnly,
+                                            decay3bodyBuilderOpts.askOnlyITSMatch,
+                                            decay3bodyBuilderOpts.calculateCovariance,
+                                            false /*isEventMixing*/,
+                                            false /*applySVertexerCuts*/);
+  }
+
+  // ______________________________________________________________
+  // fits the prefiltered candidates with nThreads workers, each with its own copy
+  // of the configured helper. The propagator and the material LUT are only read
+  template <class TTracksTo, typename TCollisions, typename T3Bodys>
+  void prebuildCandidates(TCollisions const& collisions, T3Bodys const& decay3bodys)
+  {
+    const std::size_t nCandidates = candidatesToBuild.size();
+    if (nThreads.value <= 1 || nCandidates < 2) {
+      return;
+    }
+    const std::size_t nWorkers = std::min<std::size_t>(nThreads.value, nCandidates);
+    workerHelpers.assign(nWorkers, helper);
+    prebuiltCandidates.resize(nCandidates);
+    prebuiltStatus.assign(nCandidates, kNotPrebuilt);
+    auto task = [&](std::size_t iWorker) {
+      for (std::size_t iCandidate = iWorker * nCandidates / nWorkers; iCandidate < (iWorker + 1) * nCandidates / nWorkers; iCandidate++) {
+        auto const& decay3body = decay3bodys.rawIteratorAt(candidatesToBuild[iCandidate].decay3bodyIndex);
+        auto const& collision = collisions.rawIteratorAt(decay3body.collisionId());
+        auto [trackProton, trackPion, trackDeuteron] = getDaughterTracks<TTracksTo>(decay3body);
+        bool isBuilt = buildCandidate(workerHelpers[iWorker], collision, trackProton, trackPion, trackDeuteron, decay3body.globalIndex(), candidatesToBuild[iCandidate].tofNSigmaDeuteron);
+        prebuiltCandidates[iCandidate] = workerHelpers[iWorker].decay3body;
+        prebuiltStatus[iCandidate] = isBuilt ? kPrebuiltOk : kPrebuiltFailed;
+      }
+    };
+    std::vector<std::thread> threads;
+    threads.reserve(nWorkers - 1);
+    for (std::size_t iWorker = 1; iWorker < nWorkers; iWorker++) {
+      threads.emplace_back(task, iWorker);
+    }
+    task(0);
+    for (auto& thread : threads) {
+      thread.join();
+    }
+  }
+
   // ______________________________________________________________
   // function to calculate correct TOF nSigma for deuteron track
   template <bool isMC, class TCollisionTo, typename TCollision, typename TTrack>
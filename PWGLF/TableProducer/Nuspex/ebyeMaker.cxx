@@ -214,9 +214,11 @@ struct EbyeMaker {
   Produces<aod::McNucleiEbyeTable> mcNucleiEbyeTable;
   Produces<aod::McLambdaEbyeTable> mcLambdaEbyeTable;
   Produces<aod::McMiniTrkTable> mcMiniTrkTable;
+  Produces<aod::EbyeCountTable> ebyeCountTable;
   std::mt19937 gen32;
   std::vector<CandidateV0> candidateV0s;
   std::array<std::vector<CandidateTrack>, 2> candidateTracks;
+  std::vector<std::array<uint16_t, 2>> binCounts; // antiparticles and particles per (species, pt, eta) bin of the count table
   Service<o2::ccdb::BasicCCDBManager> ccdb;
   o2::vertexing::DCAFitterN<2> fitter;
   std::vector<int> classIds;
@@ -301,7 +303,12 @@ struct EbyeMaker {
   Configurable<float> v0settingRadius{"v0setting_radius", 5.f, "v0radius"};
   Configurable<float> v0settingLifetime{"v0setting_lifetime", 40.f, "v0 lifetime cut"};
   Configurable<float> v0settingNSigmaTpc{"v0setting_nsigmatpc", 4.f, "nsigmatpc"};
-  Configurable<float> lambdaMassCut{"lambdaMassCut", 0.02f, "maximum deviation from PDG mass (for QA histograms)"};
+  Configurable<float> lambdaMassCut{"lambdaMassCut", 0.02f, "maximum deviation from PDG mass (for QA histograms and the lambda counts)"};
+
+  Configurable<bool> fillCountTable{"fillCountTable", false, "fill the counts of the candidates per collision in pt and eta bins (data only)"};
+  Configurable<bool> skipCandidateTables{"skipCandidateTables", false, "with fillCountTable, write only the collision and count tables"};
+  Configurable<std::vector<float>> countPtBins{"countPtBins", {0.4f, 0.6f, 0.9f, 1.2f, 1.8f, 4.f}, "pt bin edges of the count table"};
+  Configurable<std::vector<float>> countEtaBins{"countEtaBins", {-0.8f, -0.4f, 0.f, 0.4f, 0.8f}, "eta bin edges of the count table"};
 
   Configurable<LabeledArray<float>> cfgTrackSels{"cfgTrackSels", {kTrackSels, 1, 12, particleName, trackSelsNames}, "Track selections"};
   Configurable<LabeledArray<float>> cfgDcaSelsParam{"cfgDcaSelsParam", {kDcaSelsParam[0], 3, 3, dcaSelsNames, dcaParNames}, "DCA threshold settings"};
@@ -965,6 +972,49 @@ struct EbyeMaker {
     }
   }
 
+  // fills the count table with the candidates of the collision, one row per non-empty bin
+  void fillCountTableRows()
+  {
+    constexpr int kNspecies = kNpart + 1;
+    auto const& ptBins = countPtBins.value;
+    auto const& etaBins = countEtaBins.value;
+    if (ptBins.size() < 2 || etaBins.size() < 2) {
+      return;
+    }
+    const int nPtBins = ptBins.size() - 1;
+    const int nEtaBins = etaBins.size() - 1;
+    binCounts.assign(kNspecies * nPtBins * nEtaBins, {0, 0});
+    auto addCandidate = [&](int species, float signedPt, float eta) {
+      const float pt = std::abs(signedPt);
+      const int ptBin = std::upper_bound(ptBins.begin(), ptBins.end(), pt) - ptBins.begin() - 1;
+      const int etaBin = std::upper_bound(etaBins.begin(), etaBins.end(), eta) - etaBins.begin() - 1;
+      if (ptBin < 0 || ptBin >= nPtBins || etaBin < 0 || etaBin >= nEtaBins) {
+        return;
+      }
+      auto& count = binCounts[(species * nPtBins + ptBin) * nEtaBins + etaBin][signedPt > 0 ? 1 : 0];
+      if (count < UINT16_MAX) {
+        ++count;
+      }
+    };
+    for (int iP{0}; iP < kNpart; ++iP) {
+      for (const auto& candidateTrack : candidateTracks[iP]) {
+        addCandidate(iP, candidateTrack.pt, candidateTrack.eta);
+      }
+    }
+    for (const auto& candidateV0 : candidateV0s) {
+      if (std::abs(candidateV0.mass - o2::constants::physics::MassLambda0) < lambdaMassCut) {
+        addCandidate(kNpart, candidateV0.pt, candidateV0.eta);
+      }
+    }
+    for (int iBin{0}; iBin < static_cast<int>(binCounts.size()); ++iBin) {
+      auto const& count = binCounts[iBin];
+      if (count[0] == 0 && count[1] == 0) {
+        continue;
+      }
+      ebyeCountTable(miniCollTable.lastIndex(), iBin / (nPtBins * nEtaBins), (iBin / nEtaBins) % nPtBins, iBin % nEtaBins, count[1], count[0]);
+    }
+  }
+
   void processRun3(soa::Join<aod::Collisions, aod::EvSels, aod::CentFT0Ms, aod::CentFT0Cs> const& collisions, TracksFullIUPID const& tracks, aod::V0s const& V0s, aod::BCsWithTimestamps const&)
   {
     for (const auto& collision : collisions) {
@@ -988,6 +1038,12 @@ struct EbyeMaker {
       histos.fill(HIST("QA/PvMultVsCent"), centrality, nTracksColl);
 
       miniCollTable(static_cast<int8_t>(collision.posZ() * 10), 0x0, nTrackletsColl, centrality, nTracksColl);
+      if (fillCountTable) {
+        fillCountTableRows();
+        if (skipCandidateTables) {
+          continue;
+        }
+      }
       for (auto& candidateTrack : candidateTracks[0]) { // o2-linter: disable=const-ref-in-for-loop (not a const ref)
         auto tk = tracks.rawIteratorAt(candidateTrack.globalIndex);
         fillTableMiniTrack<false>(candidateTrack, tk);
@@ -1040,12 +1096,18 @@ struct EbyeMaker {
 
       encode16bit(nTracksCollFull, nTrackletsColl, nTracksColl);
       miniCollTable(static_cast<int8_t>(collision.posZ() * 10), 0x0, nTrackletsColl, centrality, nTracksColl);
+      collisionEbyeTable(centrality, collision.posZ());
+      if (fillCountTable) {
+        fillCountTableRows();
+        if (skipCandidateTables) {
+          continue;
+        }
+      }
       for (auto& candidateTrack : candidateTracks[0]) { // o2-linter: disable=const-ref-in-for-loop (not a const ref)
         auto tk = tracks.rawIteratorAt(candidateTrack.globalIndex);
         fillTableMiniTrack<false>(candidateTrack, tk);
       }
 
-      collisionEbyeTable(centrality, collision.posZ());
       for (const auto& candidateV0 : candidateV0s) {
         lambdaEbyeTable(
           collisionEbyeTable.lastIndex(),
@@ -1118,6 +1180,12 @@ struct EbyeMaker {
       }
 
       miniCollTable(static_cast<int8_t>(collision.posZ() * 10), trigger, nTrackletsColl, centrality, nTracksColl);
+      if (fillCountTable) {
+        fillCountTableRows();
+        if (skipCandidateTables) {
+          continue;
+        }
+      }
       for (auto& candidateTrack : candidateTracks[0]) { // o2-linter: disable=const-ref-in-for-loop (not a const ref)
         auto tk = tracks.rawIteratorAt(candidateTrack.globalIndex);
         auto [itsSignal, nSigmaITS] = getITSSignal(tk, trackExtraRun2);
@@ -663,6 +663,62 @@ struct nucleiSpectra {
       {nuclei::charges[3] * cfgMomentumScalingBetheBloch->get(3u, 0u) / nuclei::masses[3], nuclei::charges[3] * cfgMomentumScalingBetheBloch->get(3u, 1u) / nuclei::masses[3]},
       {nuclei::charges[4] * cfgMomentumScalingBetheBloch->get(3u, 0u) / nuclei::masses[4], nuclei::charges[4] * cfgMomentumScalingBetheBloch->get(3u, 1u) / nuclei::masses[4]}};
 
+    // Bethe-Bloch parameters read once, then the expected signal of all the species is computed in one loop per track
+    double betheBlochParams[nuclei::species][6];
+    for (int iS{0}; iS < nuclei::species; ++iS) {
+      for (int iPar{0}; iPar < 6; ++iPar) {
+        betheBlochParams[iS][iPar] = cfgBetheBlochParams->get(iS, iPar);
+      }
+    }
+
+    // event plane information, the same for all the candidates of the collision
+    NucleusCandidateFlow collisionFlow{};
+    float psiFT0CAlternative{0.f};
+    if constexpr (requires {
+                    collision.psiFT0A();
+                  }) {
+      collisionFlow = NucleusCandidateFlow{
+        collision.centFV0A(),
+        collision.centFT0M(),
+        collision.centFT0A(),
+        collision.centFT0C(),
+        collision.psiFT0A(),
+        collision.psiFT0C(),
+        collision.psiTPC(),
+        collision.psiTPCL(),
+        collision.psiTPCR(),
+        collision.qFT0A(),
+        collision.qFT0C(),
+        collision.qTPC(),
+        collision.qTPCL(),
+        collision.qTPCR(),
+      };
+    } else if constexpr (requires {
+                           collision.qvecFT0AIm();
+                         }) {
+      collisionFlow = NucleusCandidateFlow{
+        collision.centFV0A(),
+        collision.centFT0M(),
+        collision.centFT0A(),
+        collision.centFT0C(),
+        computeEventPlane(collision.qvecFT0AIm(), collision.qvecFT0ARe()),
+        computeEventPlane(collision.qvecFT0CIm(), collision.qvecFT0CRe()),
+        computeEventPlane(collision.qvecBTotIm(), collision.qvecBTotRe()),
+        computeEventPlane(collision.qvecBNegIm(), collision.qvecBNegRe()),
+        computeEventPlane(collision.qvecBPosIm(), collision.qvecBPosRe()),
+        std::hypot(collision.qvecFT0AIm(), collision.qvecFT0ARe()),
+        std::hypot(collision.qvecFT0CIm(), collision.qvecFT0CRe()),
+        std::hypot(collision.qvecBTotIm(), collision.qvecBTotRe()),
+        std::hypot(collision.qvecBNegIm(), collision.qvecBNegRe()),
+        std::hypot(collision.qvecBPosIm(), collision.qvecBPosRe())};
+    }
+    if constexpr (requires {
+                    collision.qvecFT0CIm();
+                    collision.qvecFT0CRe();
+                  }) {
+      psiFT0CAlternative = computeEventPlane(collision.qvecFT0CIm(), collision.qvecFT0CRe());
+    }
+
     int nGloTracks[2]{0, 0}, nTOFTracks[2]{0, 0};
     for (const auto& track : tracks) { // start loop over tracks
       if (std::abs(track.eta()) > cfgTrackCut.EtaMax ||
@@ -694,8 +750,8 @@ struct nucleiSpectra {
       bool selectedTPC[5]{false}, goodToAnalyse{false};
       std::array<float, 5> nSigmaTPC;
       for (int iS{0}; iS < nuclei::species; ++iS) {
-        double expBethe{common::BetheBlochAleph(static_cast<double>(correctedTpcInnerParam * bgScalings[iS][iC]), cfgBetheBlochParams->get(iS, 0u), cfgBetheBlochParams->get(iS, 1u), cfgBetheBlochParams->get(iS, 2u), cfgBetheBlochParams->get(iS, 3u), cfgBetheBlochParams->get(iS, 4u))};
-        double expSigma{expBethe * cfgBetheBlochParams->get(iS, 5u)};
+        double expBethe{common::BetheBlochAleph(static_cast<double>(correctedTpcInnerParam * bgScalings[iS][iC]), betheBlochParams[iS][0], betheBlochParams[iS][1], betheBlochParams[iS][2], betheBlochParams[iS][3], betheBlochParams[iS][4])};
+        double expSigma{expBethe * betheBlochParams[iS][5]};
         nSigma[0][iS] = static_cast<float>((track.tpcSignal() - expBethe) / expSigma);
         nSigmaTPC[iS] = nSigma[0][iS];
         selectedTPC[iS] = (nSigma[0][iS] > nuclei::pidCuts[0][iS][0] && nSigma[0][iS] < nuclei::pidCuts[0][iS][1]);
@@ -718,6 +774,7 @@ struct nucleiSpectra {
       spectra.fill(HIST("hTpcSignalDataSelected"), correctedTpcInnerParam * track.sign(), track.tpcSignal());
       spectra.fill(HIST("hTofSignalData"), correctedTpcInnerParam, beta);
       beta = std::min(1.f - 1.e-6f, std::max(1.e-4f, beta)); /// sometimes beta > 1 or < 0, to be checked
+      const float betaGammaInverse{std::sqrt(1.f / (beta * beta) - 1.f)};
       uint16_t flag = static_cast<uint16_t>((track.pidForTracking() & 0xF) << 12);
       std::array<float, 5> tofMasses{-3.f, -3.f, -3.f, -3.f, -3.f};
       bool fillTree{false};
@@ -749,7 +806,7 @@ struct nucleiSpectra {
             } else if (iPID) {
               selectedTOF = true; /// temporarly skipped
               float charge{1.f + static_cast<float>(iS == 3 || iS == 4)};
-              tofMasses[iS] = correctedTpcInnerParam * charge * std::sqrt(1.f / (beta * beta) - 1.f) - nuclei::masses[iS];
+              tofMasses[iS] = correctedTpcInnerParam * charge * betaGammaInverse - nuclei::masses[iS];
             }
             if (!cfgTrackCut.RapidityToggle || (y > cfgTrackCut.RapidityMin && y < cfgTrackCut.RapidityMax)) {
               if (std::abs(nSigmaTPC[iS]) < cfgNsigmaTPCcutDCAhists && (!iPID || std::abs(tofMasses[iS]) < cfgDeltaTOFmassCutDCAhists)) {
@@ -779,7 +836,7 @@ struct nucleiSpectra {
                                   collision.qvecFT0CIm();
                                   collision.qvecFT0CRe();
                                 }) {
-                    auto deltaPhiInRange = RecoDecay::constrainAngle(fvector.phi() - computeEventPlane(collision.qvecFT0CIm(), collision.qvecFT0CRe()), 0.f, 2);
+                    auto deltaPhiInRange = RecoDecay::constrainAngle(fvector.phi() - psiFT0CAlternative, 0.f, 2);
                     auto v2 = std::cos(2.0 * deltaPhiInRange);
                     nuclei::hFlowHists[iC][iS]->Fill(collision.centFT0C(), fvector.pt(), nSigma[0][iS], tofMasses[iS], v2, track.itsNCls(), track.tpcNClsFound());
                   }
@@ -806,41 +863,10 @@ struct nucleiSpectra {
       if (flag & (kProton | kDeuteron | kTriton | kHe3 | kHe4) || doprocessMC) { /// ignore PID pre-selections for the MC
         if constexpr (requires {
                         collision.psiFT0A();
+                      } || requires {
+                        collision.qvecFT0AIm();
                       }) {
-          nuclei::candidates_flow.emplace_back(NucleusCandidateFlow{
-            collision.centFV0A(),
-            collision.centFT0M(),
-            collision.centFT0A(),
-            collision.centFT0C(),
-            collision.psiFT0A(),
-            collision.psiFT0C(),
-            collision.psiTPC(),
-            collision.psiTPCL(),
-            collision.psiTPCR(),
-            collision.qFT0A(),
-            collision.qFT0C(),
-            collision.qTPC(),
-            collision.qTPCL(),
-            collision.qTPCR(),
-          });
-        } else if constexpr (requires {
-                               collision.qvecFT0AIm();
-                             }) {
-          nuclei::candidates_flow.emplace_back(NucleusCandidateFlow{
-            collision.centFV0A(),
-            collision.centFT0M(),
-            collision.centFT0A(),
-            collision.centFT0C(),
-            computeEventPlane(collision.qvecFT0AIm(), collision.qvecFT0ARe()),
-            computeEventPlane(collision.qvecFT0CIm(), collision.qvecFT0CRe()),
-            computeEventPlane(collision.qvecBTotIm(), collision.qvecBTotRe()),
-            computeEventPlane(collision.qvecBNegIm(), collision.qvecBNegRe()),
-            computeEventPlane(collision.qvecBPosIm(), collision.qvecBPosRe()),
-            std::hypot(collision.qvecFT0AIm(), collision.qvecFT0ARe()),
-            std::hypot(collision.qvecFT0CIm(), collision.qvecFT0CRe()),
-            std::hypot(collision.qvecBTotIm(), collision.qvecBTotRe()),
-            std::hypot(collision.qvecBNegIm(), collision.qvecBNegRe()),
-            std::hypot(collision.qvecBPosIm(), collision.qvecBPosRe())});
+          nuclei::candidates_flow.push_back(collisionFlow);
         }
         if (fillTree) {
           if (flag & kTriton) {
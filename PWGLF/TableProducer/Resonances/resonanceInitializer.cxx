@@ -690,56 +690,22 @@ struct ResonanceInitializer {
     returnValue = helperEP.GetResolution(helperEP.GetEventPlane(ResoEvents.qvecRe()[a * 4 + 3], ResoEvents.qvecIm()[a * 4 + 3], 2), helperEP.GetEventPlane(ResoEvents.qvecRe()[b * 4 + 3], ResoEvents.qvecIm()[b * 4 + 3], 2), 2);
     return returnValue;
   }
-  // Filter for micro tracks
-  template <bool isMC, typename TrackType, typename CollisionType>
-  void fillMicroTracks(CollisionType const& collision, TrackType const& tracks)
-  {
-    // Loop over tracks
-    for (auto const& track : tracks) {
-      if (!isMicroTrackSelected<isMC>(collision, track))
-        continue;
-      if (!filterMicroTrack(track))
-        continue;
-      o2::aod::resomicrodaughter::ResoMicroTrackSelFlag trackSelFlag(track.dcaXY(), track.dcaZ());
-      if (std::abs(track.dcaXY()) < (0.004 + (0.013 / track.pt()))) {
-        trackSelFlag.setDCAxy0();
-      }
-      if (std::abs(track.dcaZ()) < (0.004 + (0.013 / track.pt()))) { // TODO: check this
-        trackSelFlag.setDCAz0();
-      }
-      uint8_t trackFlags = (track.passedITSRefit() << 0) |
-                           (track.passedTPCRefit() << 1) |
-                           (track.isGlobalTrackWoDCA() << 2) |
-                           (track.isGlobalTrack() << 3) |
-                           (track.isPrimaryTrack() << 4) |
-                           (track.isPVContributor() << 5) |
-                           (track.hasTOF() << 6) |
-                           ((track.sign() > 0) << 7); // sign +1: 1, -1: 0
-      reso2microtrks(resoCollisions.lastIndex(),
-                     track.px(),
-                     track.py(),
-                     track.pz(),
-                     static_cast<uint8_t>(o2::aod::resomicrodaughter::PidNSigma(std::abs(track.tpcNSigmaPi()), std::abs(track.tofNSigmaPi()), track.hasTOF())),
-                     static_cast<uint8_t>(o2::aod::resomicrodaughter::PidNSigma(std::abs(track.tpcNSigmaKa()), std::abs(track.tofNSigmaKa()), track.hasTOF())),
-                     static_cast<uint8_t>(o2::aod::resomicrodaughter::PidNSigma(std::abs(track.tpcNSigmaPr()), std::abs(track.tofNSigmaPr()), track.hasTOF())),
-                     static_cast<uint8_t>(trackSelFlag),
-                     trackFlags);
-      if (!cfgBypassTrackIndexFill) {
-        resoMicroTrackTracks(track.globalIndex());
-      }
-    }
-  }
-  // Filter for all tracks
+  // Filter for all tracks and micro tracks, in a single pass over the tracks
   template <bool isMC, typename TrackType, typename CollisionType>
   void fillTracks(CollisionType const& collision, TrackType const& tracks)
   {
-    if (cfgBypassTrackFill)
+    const bool fillResoTracks = !cfgBypassTrackFill;
+    const bool fillResoMicroTracks = cfgFillMicroTracks;
+    if (!fillResoTracks && !fillResoMicroTracks)
       return;
     // Loop over tracks
     for (auto const& track : tracks) {
-      if (!isTrackSelected<isMC>(collision, track))
+      // the micro track selection is the same as the track one, without QA
+      if (fillResoTracks ? !isTrackSelected<isMC>(collision, track) : !isMicroTrackSelected<isMC>(collision, track))
         continue;
-      if (!filterTrack(track))
+      const bool isResoTrack = fillResoTracks && filterTrack(track);
+      const bool isResoMicroTrack = fillResoMicroTracks && filterMicroTrack(track);
+      if (!isResoTrack && !isResoMicroTrack)
         continue;
       uint8_t trackFlags = (track.passedITSRefit() << 0) |
                            (track.passedTPCRefit() << 1) |
@@ -749,28 +715,57 @@ struct ResonanceInitializer {
                            (track.isPVContributor() << 5) |
                            (track.hasTOF() << 6) |
                            ((track.sign() > 0) << 7); // sign +1: 1, -1: 0
-      reso2trks(resoCollisions.lastIndex(),
-                track.pt(),
-                track.px(),
-                track.py(),
-                track.pz(),
-                static_cast<uint8_t>(track.tpcNClsCrossedRows()),
-                static_cast<uint8_t>(track.tpcNClsFound()),
-                static_cast<int16_t>(std::round(track.dcaXY() * 10000)),
-                static_cast<int16_t>(std::round(track.dcaZ() * 10000)),
-                static_cast<int8_t>(std::round(track.tpcNSigmaPi() * 10)),
-                static_cast<int8_t>(std::round(track.tpcNSigmaKa() * 10)),
-                static_cast<int8_t>(std::round(track.tpcNSigmaPr() * 10)),
-                static_cast<int8_t>(std::round(track.tofNSigmaPi() * 10)),
-                static_cast<int8_t>(std::round(track.tofNSigmaKa() * 10)),
-                static_cast<int8_t>(std::round(track.tofNSigmaPr() * 10)),
-                static_cast<int16_t>(std::round(track.tpcSignal() * 100)),
-                trackFlags);
-      if (!cfgBypassTrackIndexFill) {
-        resoTrackTracks(track.globalIndex());
+      const float tpcNSigmaPi = track.tpcNSigmaPi();
+      const float tpcNSigmaKa = track.tpcNSigmaKa();
+      const float tpcNSigmaPr = track.tpcNSigmaPr();
+      const float tofNSigmaPi = track.tofNSigmaPi();
+      const float tofNSigmaKa = track.tofNSigmaKa();
+      const float tofNSigmaPr = track.tofNSigmaPr();
+      if (isResoTrack) {
+        reso2trks(resoCollisions.lastIndex(),
+                  track.pt(),
+                  track.px(),
+                  track.py(),
+                  track.pz(),
+                  static_cast<uint8_t>(track.tpcNClsCrossedRows()),
+                  static_cast<uint8_t>(track.tpcNClsFound()),
+                  static_cast<int16_t>(std::round(track.dcaXY() * 10000)),
+                  static_cast<int16_t>(std::round(track.dcaZ() * 10000)),
+                  static_cast<int8_t>(std::round(tpcNSigmaPi * 10)),
+                  static_cast<int8_t>(std::round(tpcNSigmaKa * 10)),
+                  static_cast<int8_t>(std::round(tpcNSigmaPr * 10)),
+                  static_cast<int8_t>(std::round(tofNSigmaPi * 10)),
+                  static_cast<int8_t>(std::round(tofNSigmaKa * 10)),
+                  static_cast<int8_t>(std::round(tofNSigmaPr * 10)),
+                  static_cast<int16_t>(std::round(track.tpcSignal() * 100)),
+                  trackFlags);
+        if (!cfgBypassTrackIndexFill) {
+          resoTrackTracks(track.globalIndex());
+        }
+        if constexpr (isMC) {
+          fillMCTrack(track);
+        }
       }
-      if constexpr (isMC) {
-        fillMCTrack(track);
+      if (isResoMicroTrack) {
+        o2::aod::resomicrodaughter::ResoMicroTrackSelFlag trackSelFlag(track.dcaXY(), track.dcaZ());
+        if (std::abs(track.dcaXY()) < (0.004 + (0.013 / track.pt()))) {
+          trackSelFlag.setDCAxy0();
+        }
+        if (std::abs(track.dcaZ()) < (0.004 + (0.013 / track.pt()))) { // TODO: check this
+          trackSelFlag.setDCAz0();
+        }
+        reso2microtrks(resoCollisions.lastIndex(),
+                       track.px(),
+                       track.py(),
+                       track.pz(),
+                       static_cast<uint8_t>(o2::aod::resomicrodaughter::PidNSigma(std::abs(tpcNSigmaPi), std::abs(tofNSigmaPi), track.hasTOF())),
+                       static_cast<uint8_t>(o2::aod::resomicrodaughter::PidNSigma(std::abs(tpcNSigmaKa), std::abs(tofNSigmaKa), track.hasTOF())),
+                       static_cast<uint8_t>(o2::aod::resomicrodaughter::PidNSigma(std::abs(tpcNSigmaPr), std::abs(tofNSigmaPr), track.hasTOF())),
+                       static_cast<uint8_t>(trackSelFlag),
+                       trackFlags);
+        if (!cfgBypassTrackIndexFill) {
+          resoMicroTrackTracks(track.globalIndex());
+        }
       }
     }
   }
@@ -787,31 +782,33 @@ struct ResonanceInitializer {
       childIDs[1] = v0.negTrackId();
       if (!filterV0(collision, v0))
         continue;
+      auto posTrack = v0.template posTrack_as<TrackType>();
+      auto negTrack = v0.template negTrack_as<TrackType>();
       reso2v0s(resoCollisions.lastIndex(),
                v0.pt(),
                v0.px(),
                v0.py(),
                v0.pz(),
                childIDs,
-               (int8_t)(v0.template posTrack_as<TrackType>().tpcNSigmaPi() * 10),
-               (int8_t)(v0.template posTrack_as<TrackType>().tpcNSigmaKa() * 10),
-               (int8_t)(v0.template posTrack_as<TrackType>().tpcNSigmaPr() * 10),
-               (int8_t)(v0.template negTrack_as<TrackType>().tpcNSigmaPi() * 10),
-               (int8_t)(v0.template negTrack_as<TrackType>().tpcNSigmaKa() * 10),
-               (int8_t)(v0.template negTrack_as<TrackType>().tpcNSigmaPr() * 10),
-               (int8_t)(v0.template negTrack_as<TrackType>().tofNSigmaPi() * 10),
-               (int8_t)(v0.template negTrack_as<TrackType>().tofNSigmaKa() * 10),
-               (int8_t)(v0.template negTrack_as<TrackType>().tofNSigmaPr() * 10),
-               (int8_t)(v0.template posTrack_as<TrackType>().tofNSigmaPi() * 10),
-               (int8_t)(v0.template posTrack_as<TrackType>().tofNSigmaKa() * 10),
-               (int8_t)(v0.template posTrack_as<TrackType>().tofNSigmaPr() * 10),
+               (int8_t)(posTrack.tpcNSigmaPi() * 10),
+               (int8_t)(posTrack.tpcNSigmaKa() * 10),
+               (int8_t)(posTrack.tpcNSigmaPr() * 10),
+               (int8_t)(negTrack.tpcNSigmaPi() * 10),
+               (int8_t)(negTrack.tpcNSigmaKa() * 10),
+               (int8_t)(negTrack.tpcNSigmaPr() * 10),
+               (int8_t)(negTrack.tofNSigmaPi() * 10),
+               (int8_t)(negTrack.tofNSigmaKa() * 10),
+               (int8_t)(negTrack.tofNSigmaPr() * 10),
+               (int8_t)(posTrack.tofNSigmaPi() * 10),
+               (int8_t)(posTrack.tofNSigmaKa() * 10),
+               (int8_t)(posTrack.tofNSigmaPr() * 10),
                v0.v0cosPA(),
                v0.dcaV0daughters(),
                v0.dcapostopv(),
                v0.dcanegtopv(),
                v0.dcav0topv(),
-               static_cast<uint8_t>(v0.template posTrack_as<TrackType>().tpcNClsCrossedRows()),
-               static_cast<uint8_t>(v0.template negTrack_as<TrackType>().tpcNClsCrossedRows()),
+               static_cast<uint8_t>(posTrack.tpcNClsCrossedRows()),
+               static_cast<uint8_t>(negTrack.tpcNClsCrossedRows()),
                v0.mLambda(),
                v0.mAntiLambda(),
                v0.mK0Short(),
@@ -839,30 +836,33 @@ struct ResonanceInitializer {
       childIDs[2] = casc.bachelorId();
       if (!filterCasc(casc))
         continue;
+      auto posTrack = casc.template posTrack_as<TrackType>();
+      auto negTrack = casc.template negTrack_as<TrackType>();
+      auto bachTrack = casc.template bachelor_as<TrackType>();
       reso2cascades(resoCollisions.lastIndex(),
                     casc.pt(),
                     casc.px(),
                     casc.py(),
                     casc.pz(),
                     childIDs,
-                    (int8_t)(casc.template posTrack_as<TrackType>().tpcNSigmaPi() * 10),
-                    (int8_t)(casc.template posTrack_as<TrackType>().tpcNSigmaKa() * 10),
-                    (int8_t)(casc.template posTrack_as<TrackType>().tpcNSigmaPr() * 10),
-                    (int8_t)(casc.template negTrack_as<TrackType>().tpcNSigmaPi() * 10),
-                    (int8_t)(casc.template negTrack_as<TrackType>().tpcNSigmaKa() * 10),
-                    (int8_t)(casc.template negTrack_as<TrackType>().tpcNSigmaPr() * 10),
-                    (int8_t)(casc.template bachelor_as<TrackType>().tpcNSigmaPi() * 10),
-                    (int8_t)(casc.template bachelor_as<TrackType>().tpcNSigmaKa() * 10),
-                    (int8_t)(casc.template bachelor_as<TrackType>().tpcNSigmaPr() * 10),
-                    (int8_t)(casc.template posTrack_as<TrackType>().tofNSigmaPi() * 10),
-                    (int8_t)(casc.template posTrack_as<TrackType>().tofNSigmaKa() * 10),
-                    (int8_t)(casc.template posTrack_as<TrackType>().tofNSigmaPr() * 10),
-                    (int8_t)(casc.template negTrack_as<TrackType>().tofNSigmaPi() * 10),
-                    (int8_t)(casc.template negTrack_as<TrackType>().tofNSigmaKa() * 10),
-                    (int8_t)(casc.template negTrack_as<TrackType>().tofNSigmaPr() * 10),
-                    (int8_t)(casc.template bachelor_as<TrackType>().tofNSigmaPi() * 10),
-                    (int8_t)(casc.template bachelor_as<TrackType>().tofNSigmaKa() * 10),
-                    (int8_t)(casc.template bachelor_as<TrackType>().tofNSigmaPr() * 10),
+                    (int8_t)(posTrack.tpcNSigmaPi() * 10),
+                    (int8_t)(posTrack.tpcNSigmaKa() * 10),
+                    (int8_t)(posTrack.tpcNSigmaPr() * 10),
+                    (int8_t)(negTrack.tpcNSigmaPi() * 10),
+                    (int8_t)(negTrack.tpcNSigmaKa() * 10),
+                    (int8_t)(negTrack.tpcNSigmaPr() * 10),
+                    (int8_t)(bachTrack.tpcNSigmaPi() * 10),
+                    (int8_t)(bachTrack.tpcNSigmaKa() * 10),
+                    (int8_t)(bachTrack.tpcNSigmaPr() * 10),
+                    (int8_t)(posTrack.tofNSigmaPi() * 10),
+                    (int8_t)(posTrack.tofNSigmaKa() * 10),
+                    (int8_t)(posTrack.tofNSigmaPr() * 10),
+                    (int8_t)(negTrack.tofNSigmaPi() * 10),
+                    (int8_t)(negTrack.tofNSigmaKa() * 10),
+                    (int8_t)(negTrack.tofNSigmaPr() * 10),
+                    (int8_t)(bachTrack.tofNSigmaPi() * 10),
+                    (int8_t)(bachTrack.tofNSigmaKa() * 10),
+                    (int8_t)(bachTrack.tofNSigmaPr() * 10),
                     casc.v0cosPA(collision.posX(), collision.posY(), collision.posZ()),
                     casc.casccosPA(collision.posX(), collision.posY(), collision.posZ()),
                     casc.dcaV0daughters(),
@@ -874,9 +874,9 @@ struct ResonanceInitializer {
                     casc.dcaXYCascToPV(),
                     casc.dcaZCascToPV(),
                     casc.sign(),
-                    static_cast<uint8_t>(casc.template posTrack_as<TrackType>().tpcNClsCrossedRows()),
-                    static_cast<uint8_t>(casc.template negTrack_as<TrackType>().tpcNClsCrossedRows()),
-                    static_cast<uint8_t>(casc.template bachelor_as<TrackType>().tpcNClsCrossedRows()),
+                    static_cast<uint8_t>(posTrack.tpcNClsCrossedRows()),
+                    static_cast<uint8_t>(negTrack.tpcNClsCrossedRows()),
+                    static_cast<uint8_t>(bachTrack.tpcNClsCrossedRows()),
                     casc.mLambda(),
                     casc.mXi(),
                     casc.v0radius(), casc.cascradius(), casc.x(), casc.y(), casc.z());
@@ -1474,9 +1474,6 @@ struct ResonanceInitializer {
     resoEvtPlCollisions(0, 0, 0, 0);
 
     fillTracks<false>(collision, tracks);
-    if (cfgFillMicroTracks) {
-      fillMicroTracks<false>(collision, tracks);
-    }
   }
   PROCESS_SWITCH(ResonanceInitializer, processTrackData, "Process for data", false);
 
@@ -1500,9 +1497,6 @@ struct ResonanceInitializer {
     resoEvtPlCollisions(0, 0, 0, 0);
 
     fillTracks<false>(collision, tracks);
-    if (cfgFillMicroTracks) {
-      fillMicroTracks<false>(collision, tracks);
-    }
   }
   PROCESS_SWITCH(ResonanceInitializer, processTrackDataRun2, "Process for data", false);
 
@@ -1526,9 +1520,6 @@ struct ResonanceInitializer {
     resoSpheroCollisions(computeSpherocity(tracks, trackSphMin, trackSphDef));
     resoEvtPlCollisions(getEvtPl(collision), getEvtPlRes(collision, evtPlDetId, evtPlRefAId), getEvtPlRes(collision, evtPlDetId, evtPlRefBId), getEvtPlRes(collision, evtPlRefAId, evtPlRefBId));
     fillTracks<false>(collision, tracks);
-    if (cfgFillMicroTracks) {
-      fillMicroTracks<false>(collision, tracks);
-    }
   }
   PROCESS_SWITCH(ResonanceInitializer, processTrackEPData, "Process for data and ep ana", false);
 
@@ -1557,9 +1548,6 @@ struct ResonanceInitializer {
     }
 
     fillTracks<false>(collision, tracks);
-    if (cfgFillMicroTracks) {
-      fillMicroTracks<false>(collision, tracks);
-    }
     fillV0s<false>(collision, V0s, tracks);
   }
   PROCESS_SWITCH(ResonanceInitializer, processTrackV0Data, "Process for data", false);
@@ -1583,9 +1571,6 @@ struct ResonanceInitializer {
     resoEvtPlCollisions(0, 0, 0, 0);
 
     fillTracks<false>(collision, tracks);
-    if (cfgFillMicroTracks) {
-      fillMicroTracks<false>(collision, tracks);
-    }
     fillV0s<false>(collision, V0s, tracks);
   }
   PROCESS_SWITCH(ResonanceInitializer, processTrackV0DataRun2, "Process for data", false);
@@ -1623,9 +1608,6 @@ struct ResonanceInitializer {
       return;
     }
     fillTracks<false>(collision, tracks);
-    if (cfgFillMicroTracks) {
-      fillMicroTracks<false>(collision, tracks);
-    }
     fillV0s<false>(collision, V0s, tracks);
     fillCascades<false>(collision, Cascades, tracks);
   }
@@ -1651,9 +1633,6 @@ struct ResonanceInitializer {
     resoEvtPlCollisions(0, 0, 0, 0);
 
     fillTracks<false>(collision, tracks);
-    if (cfgFillMicroTracks) {
-      fillMicroTracks<false>(collision, tracks);
-    }
     fillV0s<false>(collision, V0s, tracks);
     fillCascades<false>(collision, Cascades, tracks);
   }
@@ -1685,9 +1664,6 @@ struct ResonanceInitializer {
 
     // Loop over tracks
     fillTracks<true>(collision, tracks);
-    if (cfgFillMicroTracks) {
-      fillMicroTracks<true>(collision, tracks);
-    }
 
     // Loop over all MC particles
     auto mcParts = selectedMCParticles->sliceBy(perMcCollision, collision.mcCollision().globalIndex());
@@ -1715,9 +1691,6 @@ struct ResonanceInitializer {
 
     // Loop over tracks
     fillTracks<false>(collision, tracks);
-    if (cfgFillMicroTracks) {
-      fillMicroTracks<false>(collision, tracks);
-    }
     // Loop over all MC particles
     auto mcParts = selectedMCParticles->sliceBy(perMcCollision, collision.mcCollision().globalIndex());
     fillMCParticles(mcParts, mcParticles);
@@ -1742,9 +1715,6 @@ struct ResonanceInitializer {
 
     // Loop over tracks
     fillTracks<true>(collision, tracks);
-    if (cfgFillMicroTracks) {
-      fillMicroTracks<true>(collision, tracks);
-    }
     // Loop over all MC particles
     auto mcParts = selectedMCParticles->sliceBy(perMcCollisionRun2, collision.mcCollision().globalIndex());
     fillMCParticles(mcParts, mcParticles);
@@ -1778,9 +1748,6 @@ struct ResonanceInitializer {
       return;
     }
     fillTracks<true>(collision, tracks);
-    if (cfgFillMicroTracks) {
-      fillMicroTracks<true>(collision, tracks);
-    }
     fillV0s<true>(collision, V0s, tracks);
   }
   PROCESS_SWITCH(ResonanceInitializer, processTrackV0MC, "Process for MC", false);
@@ -1803,9 +1770,6 @@ struct ResonanceInitializer {
 
     // Loop over tracks
     fillTracks<true>(collision, tracks);
-    if (cfgFillMicroTracks) {
-      fillMicroTracks<true>(collision, tracks);
-    }
     fillV0s<true>(collision, V0s, tracks);
 
     // Loop over all MC particles
@@ -1869,9 +1833,6 @@ struct ResonanceInitializer {
       return;
     }
     fillTracks<true>(collision, tracks);
-    if (cfgFillMicroTracks) {
-      fillMicroTracks<true>(collision, tracks);
-    }
     fillV0s<true>(collision, V0s, tracks);
     fillCascades<true>(collision, Cascades, tracks);
   }
@@ -1982,9 +1943,6 @@ struct ResonanceInitializer {
 
     // Loop over tracks
     fillTracks<true>(collision, tracks);
-    if (cfgFillMicroTracks) {
-      fillMicroTracks<true>(collision, tracks);
-    }
     fillV0s<true>(collision, V0s, tracks);
     fillCascades<true>(collision, Cascades, tracks);
 
@@ -53,6 +53,7 @@ using namespace o2::soa;
 struct ResonanceMergeDF {
   //  SliceCache cache;
   Configurable<int> nDF{"nDF", 1, "no of combination of collision"};
+  Configurable<int> nMaxStagedTracks{"nMaxStagedTracks", 0, "write the merged collisions before nDF is reached once they hold this many tracks, 0: no limit"};
   Configurable<bool> isLoggingEnabled{"isLoggingEnabled", 0, "print log"};
   Configurable<bool> cpidCut{"cpidCut", 0, "pid cut"};
   Configurable<bool> crejtpc{"crejtpc", 0, "reject electron pion"};
@@ -82,333 +83,274 @@ struct ResonanceMergeDF {
     const AxisSpec axisCent(110, 0, 110, "FT0 (%)");
     histos.add("Event/h1d_ft0_mult_percentile", "FT0 (%)", kTH1F, {axisCent});
     histos.add("Event/h1d_ft0_mult_percentile_CASC", "FT0 (%)", kTH1F, {axisCent});
+
+    if (nMaxStagedTracks > 0) {
+      stagedTracks.reserve(nMaxStagedTracks);
+    }
   }
   Produces<aod::ResoCollisionDFs> resoCollisionsdf;
   Produces<aod::ResoTrackDFs> reso2trksdf;
   Produces<aod::ResoCascadeDFs> reso2cascadesdf;
   int df = 0;
 
-  std::vector<std::tuple<float, float, float, float, float, float, bool, int>> vecOfTuples;
-  std::vector<std::vector<std::tuple<float, float, float, float,
-                                     unsigned char, unsigned char,
-                                     int16_t, int16_t, int8_t, int8_t, int8_t,
-                                     int8_t, int8_t, int8_t, float,
-                                     uint8_t>>>
-    vecOfVecOfTuples;
-  std::vector<std::vector<std::tuple<float, float, float, float,
-                                     int*,
-                                     int8_t, int8_t, int8_t, // TPC Pos Trk
-                                     int8_t, int8_t, int8_t, // TPC Neg Trk
-                                     int8_t, int8_t, int8_t, // TPC Bach Trk
-                                     int8_t, int8_t, int8_t, // TOF Pos Trk
-                                     int8_t, int8_t, int8_t, // TOF Neg Trk
-                                     int8_t, int8_t, int8_t, // TOF Bach Trk
-                                     float, float, float, float,
-                                     float, float, float, float,
-                                     float, float, int, float,
-                                     float, float, float,
-                                     float, float, float>>>
-    vecOfVecOfTuplesCasc;
-  void processTrackDataDF(aod::ResoCollisions::iterator const& collision, aod::ResoTracks const& tracks)
+  // staging of the merged collisions: flat row arenas, the rows of staged collision i
+  // being [offsets[i], offsets[i + 1]). The arenas keep their capacity across flushes
+  struct StagedCollision {
+    float posX;
+    float posY;
+    float posZ;
+    float cent;
+    bool isRecINELgt0;
+  };
+  struct StagedTrack {
+    float pt;
+    float px;
+    float py;
+    float pz;
+    uint8_t tpcNClsCrossedRows;
+    uint8_t tpcNClsFound;
+    int16_t dcaXY;
+    int16_t dcaZ;
+    int8_t tpcNSigma[3]; // pi, K, p
+    int8_t tofNSigma[3]; // pi, K, p
+    int16_t tpcSignal;
+    uint8_t trackFlags;
+  };
+  struct StagedCascade {
+    float pt;
+    float px;
+    float py;
+    float pz;
+    int cascadeIndices[3];
+    int8_t tpcNSigma[9]; // pos pi, K, p, neg pi, K, p, bach pi, K, p
+    int8_t tofNSigma[9]; // same ordering
+    float v0CosPA;
+    float cascCosPA;
+    float daughDCA;
+    float cascDaughDCA;
+    float dcapostopv;
+    float dcanegtopv;
+    float dcabachtopv;
+    float dcav0topv;
+    float dcaXYCascToPV;
+    float dcaZCascToPV;
+    int sign;
+    float mLambda;
+    float mXi;
+    float transRadius;
+    float cascTransRadius;
+    float decayVtxX;
+    float decayVtxY;
+    float decayVtxZ;
+  };
+  std::vector<StagedCollision> stagedCollisions;
+  std::vector<StagedTrack> stagedTracks;
+  std::vector<StagedCascade> stagedCascades;
+  std::vector<std::size_t> stagedTrackOffsets{0};
+  std::vector<std::size_t> stagedCascadeOffsets{0};
+
+  template <typename TrackType>
+  bool isTrackSelectedForMerging(TrackType const& track)
   {
+    if (!cpidCut)
+      return true;
+    if (!track.hasTOF()) {
+      if (std::abs(track.tpcNSigmaPr()) > nsigmaPr && std::abs(track.tpcNSigmaKa()) > nsigmaKa)
+        return false;
 
-    int nCollisions = nDF;
-    vecOfTuples.push_back(std::make_tuple(collision.posX(), collision.posY(), collision.posZ(), collision.cent(), 0, 0, collision.isRecINELgt0(), 0));
-    std::vector<std::tuple<float, float, float, float,
-                           unsigned char, unsigned char,
-                           int16_t, int16_t, int8_t, int8_t, int8_t,
-                           int8_t, int8_t, int8_t, float,
-                           uint8_t>>
-      innerVector;
-    for (const auto& track : tracks) {
-      if (cpidCut) {
-        if (!track.hasTOF()) {
-          if (std::abs(track.tpcNSigmaPr()) > nsigmaPr && std::abs(track.tpcNSigmaKa()) > nsigmaKa)
-            continue;
-
-          if (crejtpc && (std::abs(track.tpcNSigmaPr()) > std::abs(track.tpcNSigmaPi()) && std::abs(track.tpcNSigmaKa()) > std::abs(track.tpcNSigmaPi())))
-            continue;
-
-        } else {
-          if (std::abs(track.tofNSigmaPr()) > nsigmatofPr && std::abs(track.tofNSigmaKa()) > nsigmatofKa)
-            continue;
-
-          if (crejtof && (std::abs(track.tofNSigmaPr()) > std::abs(track.tofNSigmaPi()) && std::abs(track.tofNSigmaKa()) > std::abs(track.tofNSigmaPi())))
-            continue;
-        }
-
-        if (std::abs(track.dcaXY()) > cDCAXY)
-          continue;
-        if (std::abs(track.dcaZ()) > cDCAZ)
-          continue;
-      }
-
-      innerVector.push_back(std::make_tuple(
-        //  track.trackId(),
-        track.pt(),
-        track.px(),
-        track.py(),
-        track.pz(),
-        (uint8_t)track.tpcNClsCrossedRows(),
-        (uint8_t)track.tpcNClsFound(),
-        static_cast<int16_t>(track.dcaXY() * 10000),
-        static_cast<int16_t>(track.dcaZ() * 10000),
-        (int8_t)(track.tpcNSigmaPi() * 10),
-        (int8_t)(track.tpcNSigmaKa() * 10),
-        (int8_t)(track.tpcNSigmaPr() * 10),
-        (int8_t)(track.tofNSigmaPi() * 10),
-        (int8_t)(track.tofNSigmaKa() * 10),
-        (int8_t)(track.tofNSigmaPr() * 10),
-        static_cast<int16_t>(track.tpcSignal() * 100),
-        track.trackFlags()));
-    }
-
-    vecOfVecOfTuples.push_back(innerVector);
-    innerVector.clear();
-    df++;
-    if (isLoggingEnabled)
-      LOGF(info, "collisions: df = %i", df);
-    if (df < nCollisions)
-      return;
-    df = 0;
-
-    for (size_t i = 0; i < vecOfTuples.size(); ++i) {
-      const auto& tuple = vecOfTuples[i];
-      const auto& innerVector = vecOfVecOfTuples[i];
+      if (crejtpc && (std::abs(track.tpcNSigmaPr()) > std::abs(track.tpcNSigmaPi()) && std::abs(track.tpcNSigmaKa()) > std::abs(track.tpcNSigmaPi())))
+        return false;
 
-      histos.fill(HIST("Event/h1d_ft0_mult_percentile"), std::get<3>(tuple));
-      resoCollisionsdf(0, std::get<0>(tuple), std::get<1>(tuple), std::get<2>(tuple), std::get<3>(tuple), std::get<4>(tuple), std::get<5>(tuple), 0., 0., 0., 0., std::get<6>(tuple), 0, std::get<7>(tuple));
-      //  LOGF(info, "collisions: Index = %d ) %f - %f - %f %f %d -- %d", std::get<0>(tuple).globalIndex(),std::get<1>(tuple),std::get<2>(tuple), std::get<3>(tuple), std::get<4>(tuple), std::get<5>(tuple).size(),resoCollisionsdf.lastIndex());
+    } else {
+      if (std::abs(track.tofNSigmaPr()) > nsigmatofPr && std::abs(track.tofNSigmaKa()) > nsigmatofKa)
+        return false;
 
-      for (const auto& tuple : innerVector) {
-        reso2trksdf(resoCollisionsdf.lastIndex(),
-                    std::get<0>(tuple),
-                    std::get<1>(tuple),
-                    std::get<2>(tuple),
-                    std::get<3>(tuple),
-                    std::get<4>(tuple),
-                    std::get<5>(tuple),
-                    std::get<6>(tuple),
-                    std::get<7>(tuple),
-                    std::get<8>(tuple),
-                    std::get<9>(tuple),
-                    std::get<10>(tuple),
-                    std::get<11>(tuple),
-                    std::get<12>(tuple),
-                    std::get<13>(tuple),
-                    std::get<14>(tuple),
-                    std::get<15>(tuple));
-      }
+      if (crejtof && (std::abs(track.tofNSigmaPr()) > std::abs(track.tofNSigmaPi()) && std::abs(track.tofNSigmaKa()) > std::abs(track.tofNSigmaPi())))
+        return false;
     }
 
-    vecOfTuples.clear();
-    vecOfVecOfTuples.clear();
+    if (std::abs(track.dcaXY()) > cDCAXY)
+      return false;
+    if (std::abs(track.dcaZ()) > cDCAZ)
+      return false;
+    return true;
   }
 
-  PROCESS_SWITCH(ResonanceMergeDF, processTrackDataDF, "Process for data merged DF", true);
-
-  void processTrackDataDFCasc(aod::ResoCollisions::iterator const& collision, aod::ResoTracks const& tracks, aod::ResoCascades const& trackCascs)
+  template <typename CollisionType, typename TrackType>
+  void stageCollision(CollisionType const& collision, TrackType const& tracks)
   {
-
-    int nCollisions = nDF;
-    vecOfTuples.push_back(std::make_tuple(collision.posX(), collision.posY(), collision.posZ(), collision.cent(), 0, 0, collision.isRecINELgt0(), 0));
-    std::vector<std::tuple<float, float, float, float,
-                           unsigned char, unsigned char,
-                           int16_t, int16_t, int8_t, int8_t, int8_t,
-                           int8_t, int8_t, int8_t, float,
-                           uint8_t>>
-      innerVector;
-    std::vector<std::tuple<float, float, float, float,
-                           int*,
-                           int8_t, int8_t, int8_t, // TPC Pos Trk
-                           int8_t, int8_t, int8_t, // TPC Neg Trk
-                           int8_t, int8_t, int8_t, // TPC Bach Trk
-                           int8_t, int8_t, int8_t, // TOF Pos Trk
-                           int8_t, int8_t, int8_t, // TOF Neg Trk
-                           int8_t, int8_t, int8_t, // TOF Bach Trk
-                           float, float, float, float,
-                           float, float, float, float,
-                           float, float, int, float,
-                           float, float, float,
-                           float, float, float>>
-      innerVectorCasc;
+    stagedCollisions.push_back({collision.posX(), collision.posY(), collision.posZ(), collision.cent(), static_cast<bool>(collision.isRecINELgt0())});
     for (const auto& track : tracks) {
-      if (cpidCut) {
-        if (!track.hasTOF()) {
-          if (std::abs(track.tpcNSigmaPr()) > nsigmaPr && std::abs(track.tpcNSigmaKa()) > nsigmaKa)
-            continue;
-
-          if (crejtpc && (std::abs(track.tpcNSigmaPr()) > std::abs(track.tpcNSigmaPi()) && std::abs(track.tpcNSigmaKa()) > std::abs(track.tpcNSigmaPi())))
-            continue;
-
-        } else {
-          if (std::abs(track.tofNSigmaPr()) > nsigmatofPr && std::abs(track.tofNSigmaKa()) > nsigmatofKa)
-            continue;
-
-          if (crejtof && (std::abs(track.tofNSigmaPr()) > std::abs(track.tofNSigmaPi()) && std::abs(track.tofNSigmaKa()) > std::abs(track.tofNSigmaPi())))
-            continue;
-        }
-
-        if (std::abs(track.dcaXY()) > cDCAXY)
-          continue;
-        if (std::abs(track.dcaZ()) > cDCAZ)
-          continue;
-      }
-
-      innerVector.push_back(std::make_tuple(
-        //  track.trackId(),
-        track.pt(),
-        track.px(),
-        track.py(),
-        track.pz(),
-        (uint8_t)track.tpcNClsCrossedRows(),
-        (uint8_t)track.tpcNClsFound(),
-        static_cast<int16_t>(track.dcaXY() * 10000),
-        static_cast<int16_t>(track.dcaZ() * 10000),
-        (int8_t)(track.tpcNSigmaPi() * 10),
-        (int8_t)(track.tpcNSigmaKa() * 10),
-        (int8_t)(track.tpcNSigmaPr() * 10),
-        (int8_t)(track.tofNSigmaPi() * 10),
-        (int8_t)(track.tofNSigmaKa() * 10),
-        (int8_t)(track.tofNSigmaPr() * 10),
-        static_cast<int16_t>(track.tpcSignal() * 100),
-        track.trackFlags()));
+      if (!isTrackSelectedForMerging(track))
+        continue;
+      stagedTracks.push_back({track.pt(),
+                              track.px(),
+                              track.py(),
+                              track.pz(),
+                              (uint8_t)track.tpcNClsCrossedRows(),
+                              (uint8_t)track.tpcNClsFound(),
+                              static_cast<int16_t>(track.dcaXY() * 10000),
+                              static_cast<int16_t>(track.dcaZ() * 10000),
+                              {(int8_t)(track.tpcNSigmaPi() * 10), (int8_t)(track.tpcNSigmaKa() * 10), (int8_t)(track.tpcNSigmaPr() * 10)},
+                              {(int8_t)(track.tofNSigmaPi() * 10), (int8_t)(track.tofNSigmaKa() * 10), (int8_t)(track.tofNSigmaPr() * 10)},
+                              static_cast<int16_t>(track.tpcSignal() * 100),
+                              track.trackFlags()});
     }
+    stagedTrackOffsets.push_back(stagedTracks.size());
+  }
 
+  template <typename CascadeType>
+  void stageCascades(CascadeType const& trackCascs)
+  {
     for (const auto& trackCasc : trackCascs) {
-      innerVectorCasc.push_back(std::make_tuple(
-        trackCasc.pt(),
-        trackCasc.px(),
-        trackCasc.py(),
-        trackCasc.pz(),
-        const_cast<int*>(trackCasc.cascadeIndices()),
-        (int8_t)(trackCasc.daughterTPCNSigmaPosPi() * 10),
-        (int8_t)(trackCasc.daughterTPCNSigmaPosKa() * 10),
-        (int8_t)(trackCasc.daughterTPCNSigmaPosPr() * 10),
-        (int8_t)(trackCasc.daughterTPCNSigmaNegPi() * 10),
-        (int8_t)(trackCasc.daughterTPCNSigmaNegKa() * 10),
-        (int8_t)(trackCasc.daughterTPCNSigmaNegPr() * 10),
-        (int8_t)(trackCasc.daughterTPCNSigmaBachPi() * 10),
-        (int8_t)(trackCasc.daughterTPCNSigmaBachKa() * 10),
-        (int8_t)(trackCasc.daughterTPCNSigmaBachPr() * 10),
-        (int8_t)(trackCasc.daughterTOFNSigmaPosPi() * 10),
-        (int8_t)(trackCasc.daughterTOFNSigmaPosKa() * 10),
-        (int8_t)(trackCasc.daughterTOFNSigmaPosPr() * 10),
-        (int8_t)(trackCasc.daughterTOFNSigmaNegPi() * 10),
-        (int8_t)(trackCasc.daughterTOFNSigmaNegKa() * 10),
-        (int8_t)(trackCasc.daughterTOFNSigmaNegPr() * 10),
-        (int8_t)(trackCasc.daughterTOFNSigmaBachPi() * 10),
-        (int8_t)(trackCasc.daughterTOFNSigmaBachKa() * 10),
-        (int8_t)(trackCasc.daughterTOFNSigmaBachPr() * 10),
-        trackCasc.v0CosPA(),
-        trackCasc.cascCosPA(),
-        trackCasc.daughDCA(),
-        trackCasc.cascDaughDCA(),
-        trackCasc.dcapostopv(),
-        trackCasc.dcanegtopv(),
-        trackCasc.dcabachtopv(),
-        trackCasc.dcav0topv(),
-        trackCasc.dcaXYCascToPV(),
-        trackCasc.dcaZCascToPV(),
-        trackCasc.sign(),
-        trackCasc.mLambda(),
-        trackCasc.mXi(),
-        trackCasc.transRadius(), trackCasc.cascTransRadius(), trackCasc.decayVtxX(), trackCasc.decayVtxY(), trackCasc.decayVtxZ()));
+      const int* indices = trackCasc.cascadeIndices();
+      stagedCascades.push_back({trackCasc.pt(),
+                                trackCasc.px(),
+                                trackCasc.py(),
+                                trackCasc.pz(),
+                                {indices[0], indices[1], indices[2]}, // copied, the input table does not outlive the data frame
+                                {(int8_t)(trackCasc.daughterTPCNSigmaPosPi() * 10),
+                                 (int8_t)(trackCasc.daughterTPCNSigmaPosKa() * 10),
+                                 (int8_t)(trackCasc.daughterTPCNSigmaPosPr() * 10),
+                                 (int8_t)(trackCasc.daughterTPCNSigmaNegPi() * 10),
+                                 (int8_t)(trackCasc.daughterTPCNSigmaNegKa() * 10),
+                                 (int8_t)(trackCasc.daughterTPCNSigmaNegPr() * 10),
+                                 (int8_t)(trackCasc.daughterTPCNSigmaBachPi() * 10),
+                                 (int8_t)(trackCasc.daughterTPCNSigmaBachKa() * 10),
+                                 (int8_t)(trackCasc.daughterTPCNSigmaBachPr() * 10)},
+                                {(int8_t)(trackCasc.daughterTOFNSigmaPosPi() * 10),
+                                 (int8_t)(trackCasc.daughterTOFNSigmaPosKa() * 10),
+                                 (int8_t)(trackCasc.daughterTOFNSigmaPosPr() * 10),
+                                 (int8_t)(trackCasc.daughterTOFNSigmaNegPi() * 10),
+                                 (int8_t)(trackCasc.daughterTOFNSigmaNegKa() * 10),
+                                 (int8_t)(trackCasc.daughterTOFNSigmaNegPr() * 10),
+                                 (int8_t)(trackCasc.daughterTOFNSigmaBachPi() * 10),
+                                 (int8_t)(trackCasc.daughterTOFNSigmaBachKa() * 10),
+                                 (int8_t)(trackCasc.daughterTOFNSigmaBachPr() * 10)},
+                                trackCasc.v0CosPA(),
+                                trackCasc.cascCosPA(),
+                                trackCasc.daughDCA(),
+                                trackCasc.cascDaughDCA(),
+                                trackCasc.dcapostopv(),
+                                trackCasc.dcanegtopv(),
+                                trackCasc.dcabachtopv(),
+                                trackCasc.dcav0topv(),
+                                trackCasc.dcaXYCascToPV(),
+                                trackCasc.dcaZCascToPV(),
+                                trackCasc.sign(),
+                                trackCasc.mLambda(),
+                                trackCasc.mXi(),
+                                trackCasc.transRadius(), trackCasc.cascTransRadius(), trackCasc.decayVtxX(), trackCasc.decayVtxY(), trackCasc.decayVtxZ()});
     }
+    stagedCascadeOffsets.push_back(stagedCascades.size());
+  }
 
-    vecOfVecOfTuples.push_back(innerVector);
-    vecOfVecOfTuplesCasc.push_back(innerVectorCasc);
-    innerVector.clear();
-    innerVectorCasc.clear();
-
+  // the staged collisions are written once nDF of them are collected, or earlier
+  // if the staged tracks exceed nMaxStagedTracks, which bounds the memory used
+  bool isFlushDue()
+  {
     df++;
-    LOGF(info, "collisions: df = %i", df);
-    if (df < nCollisions)
-      return;
-    df = 0;
+    if (df >= nDF || (nMaxStagedTracks > 0 && stagedTracks.size() >= static_cast<std::size_t>(nMaxStagedTracks.value))) {
+      df = 0;
+      return true;
+    }
+    return false;
+  }
 
-    for (size_t i = 0; i < vecOfTuples.size(); ++i) {
-      const auto& tuple = vecOfTuples[i];
-      const auto& innerVector = vecOfVecOfTuples[i];
-      const auto& innerVectorCasc = vecOfVecOfTuplesCasc[i];
+  void flushStaged(bool withCascades)
+  {
+    for (std::size_t i = 0; i < stagedCollisions.size(); ++i) {
+      const auto& collision = stagedCollisions[i];
 
-      histos.fill(HIST("Event/h1d_ft0_mult_percentile"), std::get<3>(tuple));
-      resoCollisionsdf(0, std::get<0>(tuple), std::get<1>(tuple), std::get<2>(tuple), std::get<3>(tuple), std::get<4>(tuple), std::get<5>(tuple), 0., 0., 0., 0., std::get<6>(tuple), 0, std::get<7>(tuple));
-      //  LOGF(info, "collisions: Index = %d ) %f - %f - %f %f %d -- %d", std::get<0>(tuple).globalIndex(),std::get<1>(tuple),std::get<2>(tuple), std::get<3>(tuple), std::get<4>(tuple), std::get<5>(tuple).size(),resoCollisionsdf.lastIndex());
+      histos.fill(HIST("Event/h1d_ft0_mult_percentile"), collision.cent);
+      resoCollisionsdf(0, collision.posX, collision.posY, collision.posZ, collision.cent, 0, 0, 0., 0., 0., 0., collision.isRecINELgt0, 0, 0);
 
-      for (const auto& tuple : innerVector) {
+      for (std::size_t iTrack = stagedTrackOffsets[i]; iTrack < stagedTrackOffsets[i + 1]; ++iTrack) {
+        const auto& track = stagedTracks[iTrack];
         reso2trksdf(resoCollisionsdf.lastIndex(),
-                    std::get<0>(tuple),
-                    std::get<1>(tuple),
-                    std::get<2>(tuple),
-                    std::get<3>(tuple),
-                    std::get<4>(tuple),
-                    std::get<5>(tuple),
-                    std::get<6>(tuple),
-                    std::get<7>(tuple),
-                    std::get<8>(tuple),
-                    std::get<9>(tuple),
-                    std::get<10>(tuple),
-                    std::get<11>(tuple),
-                    std::get<12>(tuple),
-                    std::get<13>(tuple),
-                    std::get<14>(tuple),
-                    std::get<15>(tuple));
+                    track.pt,
+                    track.px,
+                    track.py,
+                    track.pz,
+                    track.tpcNClsCrossedRows,
+                    track.tpcNClsFound,
+                    track.dcaXY,
+                    track.dcaZ,
+                    track.tpcNSigma[0],
+                    track.tpcNSigma[1],
+                    track.tpcNSigma[2],
+                    track.tofNSigma[0],
+                    track.tofNSigma[1],
+                    track.tofNSigma[2],
+                    track.tpcSignal,
+                    track.trackFlags);
       }
 
-      for (const auto& tuple : innerVectorCasc) {
+      if (!withCascades)
+        continue;
+      for (std::size_t iCasc = stagedCascadeOffsets[i]; iCasc < stagedCascadeOffsets[i + 1]; ++iCasc) {
+        auto& casc = stagedCascades[iCasc];
         reso2cascadesdf(resoCollisionsdf.lastIndex(),
-                        std::get<0>(tuple),
-                        std::get<1>(tuple),
-                        std::get<2>(tuple),
-                        std::get<3>(tuple),
-                        std::get<4>(tuple),
-                        std::get<5>(tuple),
-                        std::get<6>(tuple),
-                        std::get<7>(tuple),
-                        std::get<8>(tuple),
-                        std::get<9>(tuple),
-                        std::get<10>(tuple),
-                        std::get<11>(tuple),
-                        std::get<12>(tuple),
-                        std::get<13>(tuple),
-                        std::get<14>(tuple),
-                        std::get<15>(tuple),
-                        std::get<16>(tuple),
-                        std::get<17>(tuple),
-                        std::get<18>(tuple),
-                        std::get<19>(tuple),
-                        std::get<20>(tuple),
-                        std::get<21>(tuple),
-                        std::get<22>(tuple),
-                        std::get<23>(tuple),
-                        std::get<24>(tuple),
-                        std::get<25>(tuple),
-                        std::get<26>(tuple),
-                        std::get<27>(tuple),
-                        std::get<28>(tuple),
-                        std::get<29>(tuple),
-                        std::get<30>(tuple),
-                        std::get<31>(tuple),
-                        std::get<32>(tuple),
-                        std::get<33>(tuple),
-                        std::get<34>(tuple),
-                        std::get<35>(tuple),
-                        std::get<36>(tuple),
-                        std::get<37>(tuple),
-                        std::get<38>(tuple),
-                        std::get<39>(tuple),
-                        std::get<40>(tuple));
+                        casc.pt,
+                        casc.px,
+                        casc.py,
+                        casc.pz,
+                        casc.cascadeIndices,
+                        casc.tpcNSigma[0], casc.tpcNSigma[1], casc.tpcNSigma[2],
+                        casc.tpcNSigma[3], casc.tpcNSigma[4], casc.tpcNSigma[5],
+                        casc.tpcNSigma[6], casc.tpcNSigma[7], casc.tpcNSigma[8],
+                        casc.tofNSigma[0], casc.tofNSigma[1], casc.tofNSigma[2],
+                        casc.tofNSigma[3], casc.tofNSigma[4], casc.tofNSigma[5],
+                        casc.tofNSigma[6], casc.tofNSigma[7], casc.tofNSigma[8],
+                        casc.v0CosPA,
+                        casc.cascCosPA,
+                        casc.daughDCA,
+                        casc.cascDaughDCA,
+                        casc.dcapostopv,
+                        casc.dcanegtopv,
+                        casc.dcabachtopv,
+                        casc.dcav0topv,
+                        casc.dcaXYCascToPV,
+                        casc.dcaZCascToPV,
+                        casc.sign,
+                        casc.mLambda,
+                        casc.mXi,
+                        casc.transRadius, casc.cascTransRadius, casc.decayVtxX, casc.decayVtxY, casc.decayVtxZ);
       }
     }
 
-    vecOfTuples.clear();
-    vecOfVecOfTuples.clear();
-    vecOfVecOfTuplesCasc.clear(); //
+    stagedCollisions.clear();
+    stagedTracks.clear();
+    stagedCascades.clear();
+    stagedTrackOffsets.resize(1);
+    stagedCascadeOffsets.resize(1);
+  }
+
+  void processTrackDataDF(aod::ResoCollisions::iterator const& collision, aod::ResoTracks const& tracks)
+  {
+    stageCollision(collision, tracks);
+    if (isLoggingEnabled)
+      LOGF(info, "collisions: df = %i", df + 1);
+    if (!isFlushDue())
+      return;
+    flushStaged(false);
+  }
+
+  PROCESS_SWITCH(ResonanceMergeDF, processTrackDataDF, "Process for data merged DF", true);
+
+  void processTrackDataDFCasc(aod::ResoCollisions::iterator const& collision, aod::ResoTracks const& tracks, aod::ResoCascades const& trackCascs)
+  {
+    stageCollision(collision, tracks);
+    stageCascades(trackCascs);
+    LOGF(info, "collisions: df = %i", df + 1);
+    if (!isFlushDue())
+      return;
+    flushStaged(true);
   }
 
   PROCESS_SWITCH(ResonanceMergeDF, processTrackDataDFCasc, "Process for data merged DF for cascade", false);
 
+
   void processLambdaStarCandidate(aod::ResoCollisions::iterator const& collision, aod::ResoTracks const& tracks)
   {
 
@@ -58,6 +58,7 @@
 #include <cstdint>
 #include <memory>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 using namespace o2;
@@ -332,6 +333,7 @@ struct cascadeFlow {
 
   // ML inference
   Configurable<bool> isApplyML{"isApplyML", 1, "Flag to apply ML selections"};
+  Configurable<bool> isBatchML{"isBatchML", false, "Evaluate the ML models once per collision for all the cascades of the data, instead of cascade by cascade"};
   Configurable<std::vector<double>> binsPtMl{"binsPtMl", std::vector<double>{cascade_flow_cuts_ml::vecBinsPt}, "pT bin limits for ML application"};
   Configurable<std::vector<int>> cutDirMl{"cutDirMl", std::vector<int>{cascade_flow_cuts_ml::vecCutDir}, "Whether to reject score values greater or smaller than the threshold"};
   Configurable<LabeledArray<double>> cutsMl{"cutsMl", {cascade_flow_cuts_ml::cuts[0], cascade_flow_cuts_ml::nBinsPt, cascade_flow_cuts_ml::nCutScores, cascade_flow_cuts_ml::labelsPt, cascade_flow_cuts_ml::labelsCutScore}, "ML selections per pT bin"};
@@ -348,6 +350,7 @@ struct cascadeFlow {
   // Add objects needed for ML inference
   o2::analysis::MlResponse<float> mlResponseXi;
   o2::analysis::MlResponse<float> mlResponseOmega;
+  std::unordered_map<int64_t, int> cascMlBatchIndices; // index in the ML batch of the cascades of the collision, with isBatchML
 
   template <typename TCollision>
   bool AcceptEvent(TCollision const& collision, bool isFillHisto)
@@ -437,7 +440,7 @@ struct cascadeFlow {
     return true;
   }
 
-  template <typename TCascade, typename TDaughter>
+  template <bool FillQA = true, typename TCascade, typename TDaughter>
   bool IsCascAccepted(TCascade casc, TDaughter negExtra, TDaughter posExtra, TDaughter bachExtra, int& counter) // loose cuts on topological selections of cascades
   {
     // TPC cuts as those implemented for the training of the signal
@@ -459,22 +462,69 @@ struct cascadeFlow {
 
     counter++;
 
-    double pTotPosExtra = std::sqrt(casc.pxpos() * casc.pxpos() + casc.pypos() * casc.pypos() + casc.pzpos() * casc.pzpos());
-    double pTotNegExtra = std::sqrt(casc.pxneg() * casc.pxneg() + casc.pyneg() * casc.pyneg() + casc.pzneg() * casc.pzneg());
-    double pTotBachExtra = std::sqrt(casc.pxbach() * casc.pxbach() + casc.pybach() * casc.pybach() + casc.pzbach() * casc.pzbach());
-    if (casc.sign() < 0) {
-      histos.fill(HIST("hNsigmaTPCPi"), posExtra.tpcNSigmaPr(), pTotPosExtra);
-      histos.fill(HIST("hNsigmaTPCPr"), negExtra.tpcNSigmaPi(), pTotNegExtra);
-    } else if (casc.sign() > 0) {
-      histos.fill(HIST("hNsigmaTPCPi"), posExtra.tpcNSigmaPi(), pTotPosExtra);
-      histos.fill(HIST("hNsigmaTPCPr"), negExtra.tpcNSigmaPr(), pTotNegExtra);
+    if constexpr (FillQA) {
+      double pTotPosExtra = std::sqrt(casc.pxpos() * casc.pxpos() + casc.pypos() * casc.pypos() + casc.pzpos() * casc.pzpos());
+      double pTotNegExtra = std::sqrt(casc.pxneg() * casc.pxneg() + casc.pyneg() * casc.pyneg() + casc.pzneg() * casc.pzneg());
+      double pTotBachExtra = std::sqrt(casc.pxbach() * casc.pxbach() + casc.pybach() * casc.pybach() + casc.pzbach() * casc.pzbach());
+      if (casc.sign() < 0) {
+        histos.fill(HIST("hNsigmaTPCPi"), posExtra.tpcNSigmaPr(), pTotPosExtra);
+        histos.fill(HIST("hNsigmaTPCPr"), negExtra.tpcNSigmaPi(), pTotNegExtra);
+      } else if (casc.sign() > 0) {
+        histos.fill(HIST("hNsigmaTPCPi"), posExtra.tpcNSigmaPi(), pTotPosExtra);
+        histos.fill(HIST("hNsigmaTPCPr"), negExtra.tpcNSigmaPr(), pTotNegExtra);
+      }
+      histos.fill(HIST("hNsigmaTPCBachKa"), bachExtra.tpcNSigmaKa(), pTotBachExtra);
+      histos.fill(HIST("hNsigmaTPCBachPi"), bachExtra.tpcNSigmaPi(), pTotBachExtra);
     }
-    histos.fill(HIST("hNsigmaTPCBachKa"), bachExtra.tpcNSigmaKa(), pTotBachExtra);
-    histos.fill(HIST("hNsigmaTPCBachPi"), bachExtra.tpcNSigmaPi(), pTotBachExtra);
 
     return true;
   }
 
+  template <typename TCollision, typename TCascade>
+  std::vector<float> getCascMlInputFeatures(TCollision const& coll, TCascade const& casc)
+  {
+    return {casc.cascradius(),
+            casc.v0radius(),
+            casc.casccosPA(coll.posX(), coll.posY(), coll.posZ()),
+            casc.v0cosPA(coll.posX(), coll.posY(), coll.posZ()),
+            casc.dcapostopv(),
+            casc.dcanegtopv(),
+            casc.dcabachtopv(),
+            casc.dcacascdaughters(),
+            casc.dcaV0daughters(),
+            casc.dcav0topv(coll.posX(), coll.posY(), coll.posZ()),
+            casc.bachBaryonCosPA(),
+            casc.bachBaryonDCAxyToPV()};
+  }
+
+  // With isBatchML, the cascades of the collision passing the selections applied before the ML ones (daughters, pt and
+  // competing mass rejection) are scored together, with one inference per model. The cascade loop then reads the
+  // scores of a cascade at the batch index stored in cascMlBatchIndices.
+  template <typename TCollision, typename TCascades>
+  void evaluateCascMlBatch(TCollision const& coll, TCascades const& Cascades)
+  {
+    cascMlBatchIndices.clear();
+    mlResponseXi.clearBatch();
+    mlResponseOmega.clearBatch();
+    for (auto const& casc : Cascades) {
+      int counter = 0;
+      if (!IsCascAccepted<false>(casc, casc.template negTrackExtra_as<DauTracks>(), casc.template posTrackExtra_as<DauTracks>(), casc.template bachTrackExtra_as<DauTracks>(), counter)) {
+        continue;
+      }
+      if (casc.pt() < CandidateConfigs.MinPt || casc.pt() > CandidateConfigs.MaxPt) {
+        continue;
+      }
+      if (casc.mXi() > CandidateConfigs.CMRlowerLimitMassXi && casc.mXi() < CandidateConfigs.CMRupperLimitMassXi) {
+        continue;
+      }
+      auto inputFeaturesCasc = getCascMlInputFeatures(coll, casc);
+      cascMlBatchIndices[casc.globalIndex()] = mlResponseXi.addToBatch(inputFeaturesCasc, casc.pt());
+      mlResponseOmega.addToBatch(inputFeaturesCasc, casc.pt());
+    }
+    mlResponseXi.evaluateBatch();
+    mlResponseOmega.evaluateBatch();
+  }
+
   template <typename TDaughter>
   bool isLambdaAccepted(TDaughter negExtra, TDaughter posExtra, int& counter) // loose cuts on topological selections of v0s
   {
@@ -1390,6 +1440,10 @@ struct cascadeFlow {
     resolution.fill(HIST("QVectorsNormTPCAC"), eventplaneVecTPCA.Dot(eventplaneVecTPCC) / (coll.qTPCR() * coll.qTPCL()), coll.centFT0C());
     resolution.fill(HIST("QVectorsSpecPlane"), spectatorplaneVecZDCC.Dot(spectatorplaneVecZDCA), coll.centFT0C());
 
+    if (isApplyML && isBatchML) {
+      evaluateCascMlBatch(coll, Cascades);
+    }
+
     std::vector<float> bdtScore[nParticles];
     for (auto const& casc : Cascades) {
 
@@ -1409,18 +1463,7 @@ struct cascadeFlow {
       // ML selections
       bool isSelectedCasc[2]{false, false};
 
-      std::vector<float> inputFeaturesCasc{casc.cascradius(),
-                                           casc.v0radius(),
-                                           casc.casccosPA(coll.posX(), coll.posY(), coll.posZ()),
-                                           casc.v0cosPA(coll.posX(), coll.posY(), coll.posZ()),
-                                           casc.dcapostopv(),
-                                           casc.dcanegtopv(),
-                                           casc.dcabachtopv(),
-                                           casc.dcacascdaughters(),
-                                           casc.dcaV0daughters(),
-                                           casc.dcav0topv(coll.posX(), coll.posY(), coll.posZ()),
-                                           casc.bachBaryonCosPA(),
-                                           casc.bachBaryonDCAxyToPV()};
+      auto inputFeaturesCasc = getCascMlInputFeatures(coll, casc);
 
       float massCasc[2]{casc.mXi(), casc.mOmega()};
 
@@ -1439,8 +1482,14 @@ struct cascadeFlow {
 
       if (isApplyML) {
         // Retrieve model output and selection outcome
-        isSelectedCasc[0] = mlResponseXi.isSelectedMl(inputFeaturesCasc, casc.pt(), bdtScore[0]);
-        isSelectedCasc[1] = mlResponseOmega.isSelectedMl(inputFeaturesCasc, casc.pt(), bdtScore[1]);
+        if (isBatchML) {
+          const int iBatch = cascMlBatchIndices.at(casc.globalIndex());
+          isSelectedCasc[0] = mlResponseXi.isSelectedMlBatch(iBatch, bdtScore[0]);
+          isSelectedCasc[1] = mlResponseOmega.isSelectedMlBatch(iBatch, bdtScore[1]);
+        } else {
+          isSelectedCasc[0] = mlResponseXi.isSelectedMl(inputFeaturesCasc, casc.pt(), bdtScore[0]);
+          isSelectedCasc[1] = mlResponseOmega.isSelectedMl(inputFeaturesCasc, casc.pt(), bdtScore[1]);
+        }
 
         for (int iS{0}; iS < nParticles; ++iS) {
           // Fill BDT score histograms before selection
@@ -1526,11 +1575,12 @@ struct cascadeFlow {
       int chargeIndex = 0;
       if (casc.sign() > 0)
         chargeIndex = 1;
-      double pzs2Xi = cosThetaStarLambda[0] * std::sin(2 * (casc.phi() - psiT0CCorr)) / cascadev2::AlphaXi[chargeIndex] / meanCos2ThetaLambdaFromXi;
-      double pzs2Omega = cosThetaStarLambda[1] * std::sin(2 * (casc.phi() - psiT0CCorr)) / cascadev2::AlphaOmega[chargeIndex] / meanCos2ThetaLambdaFromOmega;
+      const double sin2CascMinusPsiT0C = std::sin(2 * (casc.phi() - psiT0CCorr));
+      double pzs2Xi = cosThetaStarLambda[0] * sin2CascMinusPsiT0C / cascadev2::AlphaXi[chargeIndex] / meanCos2ThetaLambdaFromXi;
+      double pzs2Omega = cosThetaStarLambda[1] * sin2CascMinusPsiT0C / cascadev2::AlphaOmega[chargeIndex] / meanCos2ThetaLambdaFromOmega;
       double cos2ThetaXi = cosThetaStarLambda[0] * cosThetaStarLambda[0];
       double cos2ThetaOmega = cosThetaStarLambda[1] * cosThetaStarLambda[1];
-      double pzs2LambdaFromCasc = cosThetaStarProton * std::sin(2 * (casc.phi() - psiT0CCorr)) / cascadev2::AlphaLambda[chargeIndex] / meanCos2ThetaProtonFromLambda;
+      double pzs2LambdaFromCasc = cosThetaStarProton * sin2CascMinusPsiT0C / cascadev2::AlphaLambda[chargeIndex] / meanCos2ThetaProtonFromLambda;
       double cos2ThetaLambda = cosThetaStarProton * cosThetaStarProton;
 
       double cosThetaXiWithAlpha = cosThetaStarLambda[0] / cascadev2::AlphaXi[chargeIndex];
@@ -1721,6 +1771,10 @@ struct cascadeFlow {
     resolution.fill(HIST("QVectorsNormT0CTPCC"), eventplaneVecT0C.Dot(eventplaneVecTPCC) / (coll.qTPCL() * coll.sumAmplFT0C()), coll.centFT0C());
     resolution.fill(HIST("QVectorsNormTPCAC"), eventplaneVecTPCA.Dot(eventplaneVecTPCC) / (coll.qTPCR() * coll.qTPCL()), coll.centFT0C());
 
+    if (isApplyML && isBatchML) {
+      evaluateCascMlBatch(coll, Cascades);
+    }
+
     std::vector<float> bdtScore[nParticles];
     for (auto const& casc : Cascades) {
 
@@ -1740,18 +1794,7 @@ struct cascadeFlow {
       // ML selections
       bool isSelectedCasc[nParticles]{false, false};
 
-      std::vector<float> inputFeaturesCasc{casc.cascradius(),
-                                           casc.v0radius(),
-                                           casc.casccosPA(coll.posX(), coll.posY(), coll.posZ()),
-                                           casc.v0cosPA(coll.posX(), coll.posY(), coll.posZ()),
-                                           casc.dcapostopv(),
-                                           casc.dcanegtopv(),
-                                           casc.dcabachtopv(),
-                                           casc.dcacascdaughters(),
-                                           casc.dcaV0daughters(),
-                                           casc.dcav0topv(coll.posX(), coll.posY(), coll.posZ()),
-                                           casc.bachBaryonCosPA(),
-                                           casc.bachBaryonDCAxyToPV()};
+      auto inputFeaturesCasc = getCascMlInputFeatures(coll, casc);
 
       float massCasc[nParticles]{casc.mXi(), casc.mOmega()};
 
@@ -1770,8 +1813,14 @@ struct cascadeFlow {
 
       if (isApplyML) {
         // Retrieve model output and selection outcome
-        isSelectedCasc[0] = mlResponseXi.isSelectedMl(inputFeaturesCasc, casc.pt(), bdtScore[0]);
-        isSelectedCasc[1] = mlResponseOmega.isSelectedMl(inputFeaturesCasc, casc.pt(), bdtScore[1]);
+        if (isBatchML) {
+          const int iBatch = cascMlBatchIndices.at(casc.globalIndex());
+          isSelectedCasc[0] = mlResponseXi.isSelectedMlBatch(iBatch, bdtScore[0]);
+          isSelectedCasc[1] = mlResponseOmega.isSelectedMlBatch(iBatch, bdtScore[1]);
+        } else {
+          isSelectedCasc[0] = mlResponseXi.isSelectedMl(inputFeaturesCasc, casc.pt(), bdtScore[0]);
+          isSelectedCasc[1] = mlResponseOmega.isSelectedMl(inputFeaturesCasc, casc.pt(), bdtScore[1]);
+        }
 
         for (int iS{0}; iS < nParticles; ++iS) {
           // Fill BDT score histograms before selection
@@ -1851,11 +1900,12 @@ struct cascadeFlow {
       int chargeIndex = 0;
       if (casc.sign() > 0)
         chargeIndex = 1;
-      double pzs2Xi = cosThetaStarLambda[0] * std::sin(2 * (casc.phi() - psiT0CCorr)) / cascadev2::AlphaXi[chargeIndex] / meanCos2ThetaLambdaFromXi;
-      double pzs2Omega = cosThetaStarLambda[1] * std::sin(2 * (casc.phi() - psiT0CCorr)) / cascadev2::AlphaOmega[chargeIndex] / meanCos2ThetaLambdaFromOmega;
+      const double sin2CascMinusPsiT0C = std::sin(2 * (casc.phi() - psiT0CCorr));
+      double pzs2Xi = cosThetaStarLambda[0] * sin2CascMinusPsiT0C / cascadev2::AlphaXi[chargeIndex] / meanCos2ThetaLambdaFromXi;
+      double pzs2Omega = cosThetaStarLambda[1] * sin2CascMinusPsiT0C / cascadev2::AlphaOmega[chargeIndex] / meanCos2ThetaLambdaFromOmega;
       double cos2ThetaXi = cosThetaStarLambda[0] * cosThetaStarLambda[0];
       double cos2ThetaOmega = cosThetaStarLambda[1] * cosThetaStarLambda[1];
-      double pzs2LambdaFromCasc = cosThetaStarProton * std::sin(2 * (casc.phi() - psiT0CCorr)) / cascadev2::AlphaLambda[chargeIndex] / meanCos2ThetaProtonFromLambda;
+      double pzs2LambdaFromCasc = cosThetaStarProton * sin2CascMinusPsiT0C / cascadev2::AlphaLambda[chargeIndex] / meanCos2ThetaProtonFromLambda;
       double cos2ThetaLambda = cosThetaStarProton * cosThetaStarProton;
 
       double cosThetaXiWithAlpha = cosThetaStarLambda[0] / cascadev2::AlphaXi[chargeIndex];
@@ -2378,6 +2428,10 @@ struct cascadeFlow {
     resolution.fill(HIST("QVectorsNormTPCAC"), eventplaneVecTPCA.Dot(eventplaneVecTPCC) / (NormQvTPCA * NormQvTPCC), coll.centFT0C());
     resolution.fill(HIST("QVectorsSpecPlane"), spectatorplaneVecZDCC.Dot(spectatorplaneVecZDCA), coll.centFT0C());
 
+    if (isApplyML && isBatchML) {
+      evaluateCascMlBatch(coll, Cascades);
+    }
+
     std::vector<float> bdtScore[nParticles];
     for (auto const& casc : Cascades) {
 
@@ -2397,18 +2451,7 @@ struct cascadeFlow {
       // ML selections
       bool isSelectedCasc[nParticles]{false, false};
 
-      std::vector<float> inputFeaturesCasc{casc.cascradius(),
-                                           casc.v0radius(),
-                                           casc.casccosPA(coll.posX(), coll.posY(), coll.posZ()),
-                                           casc.v0cosPA(coll.posX(), coll.posY(), coll.posZ()),
-                                           casc.dcapostopv(),
-                                           casc.dcanegtopv(),
-                                           casc.dcabachtopv(),
-                                           casc.dcacascdaughters(),
-                                           casc.dcaV0daughters(),
-                                           casc.dcav0topv(coll.posX(), coll.posY(), coll.posZ()),
-                                           casc.bachBaryonCosPA(),
-                                           casc.bachBaryonDCAxyToPV()};
+      auto inputFeaturesCasc = getCascMlInputFeatures(coll, casc);
 
       float massCasc[nParticles]{casc.mXi(), casc.mOmega()};
 
@@ -2427,8 +2470,14 @@ struct cascadeFlow {
 
       if (isApplyML) {
         // Retrieve model output and selection outcome
-        isSelectedCasc[0] = mlResponseXi.isSelectedMl(inputFeaturesCasc, casc.pt(), bdtScore[0]);
-        isSelectedCasc[1] = mlResponseOmega.isSelectedMl(inputFeaturesCasc, casc.pt(), bdtScore[1]);
+        if (isBatchML) {
+          const int iBatch = cascMlBatchIndices.at(casc.globalIndex());
+          isSelectedCasc[0] = mlResponseXi.isSelectedMlBatch(iBatch, bdtScore[0]);
+          isSelectedCasc[1] = mlResponseOmega.isSelectedMlBatch(iBatch, bdtScore[1]);
+        } else {
+          isSelectedCasc[0] = mlResponseXi.isSelectedMl(inputFeaturesCasc, casc.pt(), bdtScore[0]);
+          isSelectedCasc[1] = mlResponseOmega.isSelectedMl(inputFeaturesCasc, casc.pt(), bdtScore[1]);
+        }
 
         for (int iS{0}; iS < nParticles; ++iS) {
           // Fill BDT score histograms before selection
@@ -2556,18 +2605,7 @@ struct cascadeFlow {
       // ML selections
       bool isSelectedCasc[nParticles]{false, false};
 
-      std::vector<float> inputFeaturesCasc{casc.cascradius(),
-                                           casc.v0radius(),
-                                           casc.casccosPA(coll.posX(), coll.posY(), coll.posZ()),
-                                           casc.v0cosPA(coll.posX(), coll.posY(), coll.posZ()),
-                                           casc.dcapostopv(),
-                                           casc.dcanegtopv(),
-                                           casc.dcabachtopv(),
-                                           casc.dcacascdaughters(),
-                                           casc.dcaV0daughters(),
-                                           casc.dcav0topv(coll.posX(), coll.posY(), coll.posZ()),
-                                           casc.bachBaryonCosPA(),
-                                           casc.bachBaryonDCAxyToPV()};
+      auto inputFeaturesCasc = getCascMlInputFeatures(coll, casc);
 
       float massCasc[nParticles]{casc.mXi(), casc.mOmega()};
 
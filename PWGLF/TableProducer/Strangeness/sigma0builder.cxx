@@ -47,10 +47,12 @@
 #include <TMath.h>
 #include <TPDGCode.h>
 
+#include <algorithm>
 #include <array>
 #include <cmath>
 #include <cstdint>
 #include <cstdlib>
+#include <numeric>
 #include <string>
 #include <string_view>
 #include <unordered_set>
@@ -175,6 +177,7 @@ struct sigma0builder {
   Configurable<bool> fillPi0Tables{"fillPi0Tables", false, "fill pi0 tables for QA"};
   Configurable<bool> fillSigma0Tables{"fillSigma0Tables", true, "fill sigma0 tables for analysis"};
   Configurable<bool> fillKStarTables{"fillKStarTables", true, "fill kstar tables for analysis"};
+  Configurable<bool> pruneByMassBound{"pruneByMassBound", false, "Loop the photons by increasing momentum in the sigma0/kstar pairing and stop when the lowest possible pair mass is above the mass window (the pairs skipped are then missing in the selection statistics)"};
 
   // For ML Selection
   Configurable<bool> useMLScores{"useMLScores", false, "use ML scores to select candidates"};
@@ -2212,6 +2215,15 @@ struct sigma0builder {
     return true;
   }
 
+  // Largest momentum of a massless photon for which the pair with a V0 of momentum pV0 can have a mass below massMax.
+  // The lowest pair mass, for collinear momenta, is m^2 = mV0^2 + 2 pGamma (EV0 - pV0) and grows with pGamma.
+  static float getMaxPhotonMomentum(float pV0, float massV0, float massMax)
+  {
+    constexpr float RelativeTolerance = 1.e-3f; // keeps the pairs at the edge of the window despite the rounding
+    const float energyMinusP = massV0 * massV0 / (std::hypot(pV0, massV0) + pV0);
+    return (1.f + RelativeTolerance) * (massMax * massMax - massV0 * massV0) / (2.f * energyMinusP);
+  }
+
   //_______________________________________________
   // Build pi0 candidate for QA
   template <typename TV0Object, typename TCollision, typename TMCParticles>
@@ -2645,6 +2657,8 @@ struct sigma0builder {
     std::vector<int> bestGammasArray;
     std::vector<int> bestLambdasArray;
     std::vector<int> bestKShortsArray;
+    std::vector<float> gammaMomenta; // momenta of the best gamma candidates, for pruneByMassBound
+    std::vector<int> gammaOrder;     // best gamma candidates by increasing momentum, for pruneByMassBound
 
     // Custom grouping
     std::vector<std::vector<int>> v0grouped(collisions.size());
@@ -2742,33 +2756,35 @@ struct sigma0builder {
         }
       }
 
+      //_______________________________________________
+      // Building of the photon-V0 candidates & filling tables
+      auto buildSigma0 = [&](int gammaIndex, auto const& lambda) {
+        if constexpr (soa::is_table<TEMCal>) { // using EMCal photons
+          auto gamma1 = fullEMCalClusters.rawIteratorAt(gammaIndex);
+          buildEMCalSigma0(lambda, gamma1, coll, mcparticles, emcaltracksgrouped);
+        } else { // using PCM photons
+          auto gamma1 = fullV0s.rawIteratorAt(gammaIndex);
+          buildPCMSigma0(lambda, gamma1, coll, mcparticles);
+        }
+      };
+
       //_______________________________________________
       // Photon-V0 nested loop
       for (size_t i = 0; i < bestGammasArray.size(); ++i) {
 
         //_______________________________________________
         // Sigma0 loop
-        if (fillSigma0Tables) {
+        if (fillSigma0Tables && !pruneByMassBound) {
           for (size_t j = 0; j < bestLambdasArray.size(); ++j) {
             auto lambda = fullV0s.rawIteratorAt(bestLambdasArray[j]);
-
-            // Building sigma0 candidate & filling tables
-            if constexpr (soa::is_table<TEMCal>) { // using EMCal photons
-              auto gamma1 = fullEMCalClusters.rawIteratorAt(bestGammasArray[i]);
-              if (!buildEMCalSigma0(lambda, gamma1, coll, mcparticles, emcaltracksgrouped))
-                continue;
-            } else { // using PCM photons
-              auto gamma1 = fullV0s.rawIteratorAt(bestGammasArray[i]);
-              if (!buildPCMSigma0(lambda, gamma1, coll, mcparticles))
-                continue;
-            }
+            buildSigma0(bestGammasArray[i], lambda);
           }
         }
 
         //_______________________________________________
         // KStar loop
         if constexpr (!soa::is_table<TEMCal>) { // Don't use EMCal clusters here
-          if (fillKStarTables) {
+          if (fillKStarTables && !pruneByMassBound) {
             auto gamma1 = fullV0s.rawIteratorAt(bestGammasArray[i]);
             for (size_t j = 0; j < bestKShortsArray.size(); ++j) {
               auto kshort = fullV0s.rawIteratorAt(bestKShortsArray[j]);
@@ -2795,6 +2811,51 @@ struct sigma0builder {
           }
         }
       }
+
+      //_______________________________________________
+      // V0-photon loops with the photons by increasing momentum, stopped at the upper edge of the mass window
+      if (pruneByMassBound && (fillSigma0Tables || fillKStarTables)) {
+        gammaMomenta.resize(bestGammasArray.size());
+        for (size_t i = 0; i < bestGammasArray.size(); ++i) {
+          if constexpr (soa::is_table<TEMCal>) {
+            gammaMomenta[i] = fullEMCalClusters.rawIteratorAt(bestGammasArray[i]).energy();
+          } else {
+            auto gamma = fullV0s.rawIteratorAt(bestGammasArray[i]);
+            gammaMomenta[i] = std::hypot(gamma.px(), gamma.py(), gamma.pz());
+          }
+        }
+        gammaOrder.resize(bestGammasArray.size());
+        std::iota(gammaOrder.begin(), gammaOrder.end(), 0);
+        std::sort(gammaOrder.begin(), gammaOrder.end(), [&](int a, int b) { return gammaMomenta[a] < gammaMomenta[b]; });
+
+        if (fillSigma0Tables) {
+          const float massMaxSigma0 = (doLambdaStar ? o2::constants::physics::MassLambda1520 : o2::constants::physics::MassSigma0) + Sigma0Window;
+          for (size_t j = 0; j < bestLambdasArray.size(); ++j) {
+            auto lambda = fullV0s.rawIteratorAt(bestLambdasArray[j]);
+            const float pMaxGamma = getMaxPhotonMomentum(std::hypot(lambda.px(), lambda.py(), lambda.pz()), o2::constants::physics::MassLambda0, massMaxSigma0);
+            for (const auto& i : gammaOrder) {
+              if (gammaMomenta[i] > pMaxGamma)
+                break;
+              buildSigma0(bestGammasArray[i], lambda);
+            }
+          }
+        }
+
+        if constexpr (!soa::is_table<TEMCal>) { // Don't use EMCal clusters here
+          if (fillKStarTables) {
+            const float massMaxKStar = o2::constants::physics::MassK0Star892 + KStarWindow;
+            for (size_t j = 0; j < bestKShortsArray.size(); ++j) {
+              auto kshort = fullV0s.rawIteratorAt(bestKShortsArray[j]);
+              const float pMaxGamma = getMaxPhotonMomentum(std::hypot(kshort.px(), kshort.py(), kshort.pz()), o2::constants::physics::MassK0Short, massMaxKStar);
+              for (const auto& i : gammaOrder) {
+                if (gammaMomenta[i] > pMaxGamma)
+                  break;
+                buildKStar(kshort, fullV0s.rawIteratorAt(bestGammasArray[i]), coll, mcparticles);
+              }
+            }
+          }
+        }
+      }
     }
   }
 
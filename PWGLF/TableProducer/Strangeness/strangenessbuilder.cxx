@@ -79,6 +79,7 @@
 #include <numeric>
 #include <stdexcept>
 #include <string>
+#include <thread>
 #include <utility>
 #include <vector>
 
@@ -365,6 +366,9 @@ struct StrangenessBuilder {
   // Autoconfigure process functions
   Configurable<bool> autoConfigureProcess{"autoConfigureProcess", false, "if true, will configure process function switches based on metadata"};
 
+  // parallel building: candidates are fitted by nThreads workers, tables are then filled in the usual order
+  Configurable<int> nThreads{"nThreads", 1, "number of threads used to build the V0 and cascade candidates (DCAFitter path)"};
+
   // V0 building options
   struct : ConfigurableGroup {
     std::string prefix = "v0BuilderOpts";
@@ -593,6 +597,19 @@ struct StrangenessBuilder {
 
   std::vector<v0Entry> v0List;
   std::vector<cascadeEntry> cascadeList;
+  o2::pwglf::V0groupTable v0tableGrouped; // (p,n) groups of duplicated V0s, buffers kept across data frames
+
+  // parallel building: one helper (and fitter) per worker, and the candidates they built
+  enum PrebuiltStatus : uint8_t {
+    kNotPrebuilt = 0, // left to the sequential loop
+    kPrebuiltOk,
+    kPrebuiltFailed
+  };
+  std::vector<o2::pwglf::strangenessBuilderHelper> workerHelpers;
+  std::vector<o2::pwglf::v0candidate> prebuiltV0s;
+  std::vector<uint8_t> prebuiltV0Status;
+  std::vector<o2::pwglf::cascadeCandidate> prebuiltCascades;
+  std::vector<uint8_t> prebuiltCascadeStatus;
   std::vector<std::size_t> sorted_v0;
   std::vector<std::size_t> sorted_cascade;
 
@@ -871,7 +888,7 @@ struct StrangenessBuilder {
   //_______________________________________________________________________
   // Process duplicated photons
   template <class TBCs, typename TCollisions, typename TTracks>
-  std::vector<V0DuplicateExtra> processDuplicates(TCollisions const& collisions, TTracks const& tracks, std::vector<o2::pwglf::V0group> V0Grouped, size_t iV0)
+  std::vector<V0DuplicateExtra> processDuplicates(TCollisions const& collisions, TTracks const& tracks, o2::pwglf::V0groupTable const& V0Grouped, size_t iV0)
   {
     auto pTrack = tracks.rawIteratorAt(V0Grouped[iV0].posTrackId);
     auto nTrack = tracks.rawIteratorAt(V0Grouped[iV0].negTrackId);
@@ -1198,7 +1215,7 @@ struct StrangenessBuilder {
         // handle duplicates explicitly: group V0s according to (p,n) indices
         // will provide a list of collisionIds (in V0group), allowing for
         // easy de-duplication when passing to the v0List
-        std::vector<o2::pwglf::V0group> v0tableGrouped = o2::pwglf::groupDuplicates(v0s);
+        o2::pwglf::groupDuplicates(v0s, v0tableGrouped);
         histos.fill(HIST("hDeduplicationStatistics"), 0.0, v0s.size());
         histos.fill(HIST("hDeduplicationStatistics"), 1.0, v0tableGrouped.size());
 
@@ -1628,6 +1645,120 @@ struct StrangenessBuilder {
     LOGF(debug, "V0 total %i, Cascade total %i, Tracked cascade total %i, V0s flagged used in cascades: %i", v0s.size(), cascades.size(), trackedCascadeCount, v0sUsedInCascades);
   }
 
+  //__________________________________________________
+  // splits [0, nItems) into nThreads contiguous chunks and calls
+  // task(helper, first, last) for each of them in its own thread, every
+  // thread having a copy of the configured straHelper. The task must only
+  // write to its own entries: tables and histograms are not thread safe
+  template <typename TTask>
+  void runInChunks(std::size_t nItems, TTask&& task)
+  {
+    const std::size_t nWorkers = std::min<std::size_t>(nThreads.value, nItems);
+    workerHelpers.assign(nWorkers, straHelper);
+    std::vector<std::thread> threads;
+    threads.reserve(nWorkers - 1);
+    for (std::size_t iWorker = 1; iWorker < nWorkers; iWorker++) {
+      threads.emplace_back([&, iWorker]() { task(workerHelpers[iWorker], iWorker * nItems / nWorkers, (iWorker + 1) * nItems / nWorkers); });
+    }
+    task(workerHelpers[0], 0, nItems / nWorkers);
+    for (auto& thread : threads) {
+      thread.join();
+    }
+  }
+
+  //__________________________________________________
+  // fits the V0s of v0List in parallel. V0s with TPC-only tracks to be
+  // moved are left to the sequential loop, since the drift manager may
+  // have to query the CCDB
+  template <typename TCollisions, typename TTracks>
+  void prebuildV0s(TCollisions const& collisions, TTracks const& tracks)
+  {
+    prebuiltV0Status.clear();
+    if (nThreads.value <= 1 || v0List.size() < 2) {
+      return;
+    }
+    prebuiltV0s.resize(v0List.size());
+    prebuiltV0Status.assign(v0List.size(), kNotPrebuilt);
+    runInChunks(v0List.size(), [&](o2::pwglf::strangenessBuilderHelper& helper, std::size_t first, std::size_t last) {
+      for (std::size_t iv0 = first; iv0 < last; iv0++) {
+        const auto& v0 = v0List[sorted_v0[iv0]];
+        if (!mEnabledTables[kV0CoresBase] && v0Map[iv0] == -2) {
+          continue;
+        }
+        auto const& posTrack = tracks.rawIteratorAt(v0.posTrackId);
+        auto const& negTrack = tracks.rawIteratorAt(v0.negTrackId);
+        if (v0BuilderOpts.moveTPCOnlyTracks) {
+          bool isPosTPCOnly = (posTrack.hasTPC() && !posTrack.hasITS() && !posTrack.hasTRD() && !posTrack.hasTOF());
+          bool isNegTPCOnly = (negTrack.hasTPC() && !negTrack.hasITS() && !negTrack.hasTRD() && !negTrack.hasTOF());
+          if (isPosTPCOnly || isNegTPCOnly) {
+            continue;
+          }
+        }
+        float pvX = 0.0f, pvY = 0.0f, pvZ = 0.0f;
+        if (v0.collisionId >= 0) {
+          auto const& collision = collisions.rawIteratorAt(v0.collisionId);
+          pvX = collision.posX();
+          pvY = collision.posY();
+          pvZ = collision.posZ();
+        }
+        auto posTrackPar = getTrackParCov(posTrack);
+        auto negTrackPar = getTrackParCov(negTrack);
+        bool isBuilt = helper.buildV0Candidate(v0.collisionId, pvX, pvY, pvZ, posTrack, negTrack, posTrackPar, negTrackPar, v0.isCollinearV0, mEnabledTables[kV0Covs], v0BuilderOpts.generatePhotonCandidates);
+        prebuiltV0s[iv0] = helper.v0;
+        prebuiltV0Status[iv0] = isBuilt ? kPrebuiltOk : kPrebuiltFailed;
+      }
+    });
+  }
+
+  //__________________________________________________
+  // fits the cascades of cascadeList in parallel, from the buffered V0s
+  // or from the tracks, as the sequential loop would do
+  template <typename TCollisions, typename TTracks>
+  void prebuildCascades(TCollisions const& collisions, TTracks const& tracks)
+  {
+    prebuiltCascadeStatus.clear();
+    if (nThreads.value <= 1 || cascadeList.size() < 2) {
+      return;
+    }
+    prebuiltCascades.resize(cascadeList.size());
+    prebuiltCascadeStatus.assign(cascadeList.size(), kNotPrebuilt);
+    runInChunks(cascadeList.size(), [&](o2::pwglf::strangenessBuilderHelper& helper, std::size_t first, std::size_t last) {
+      for (std::size_t icascade = first; icascade < last; icascade++) {
+        auto const& cascade = cascadeList[sorted_cascade[icascade]];
+        if (useV0BufferForCascades && (cascade.v0Id < 0 || v0Map[cascade.v0Id] < 0)) {
+          continue;
+        }
+        float pvX = 0.0f, pvY = 0.0f, pvZ = 0.0f;
+        if (cascade.collisionId >= 0) {
+          auto const& collision = collisions.rawIteratorAt(cascade.collisionId);
+          pvX = collision.posX();
+          pvY = collision.posY();
+          pvZ = collision.posZ();
+        }
+        auto const& posTrack = tracks.rawIteratorAt(cascade.posTrackId);
+        auto const& negTrack = tracks.rawIteratorAt(cascade.negTrackId);
+        auto const& bachTrack = tracks.rawIteratorAt(cascade.bachTrackId);
+        bool isBuilt = false;
+        if (useV0BufferForCascades) {
+          isBuilt = helper.buildCascadeCandidate(cascade.collisionId, pvX, pvY, pvZ,
+                                                 v0sFromCascades[v0Map[cascade.v0Id]],
+                                                 posTrack, negTrack, bachTrack,
+                                                 mEnabledTables[kCascBBs],
+                                                 cascadeBuilderOpts.useCascadeMomentumAtPrimVtx,
+                                                 mEnabledTables[kCascCovs]);
+        } else {
+          isBuilt = helper.buildCascadeCandidate(cascade.collisionId, pvX, pvY, pvZ,
+                                                 posTrack, negTrack, bachTrack,
+                                                 mEnabledTables[kCascBBs],
+                                                 cascadeBuilderOpts.useCascadeMomentumAtPrimVtx,
+                                                 mEnabledTables[kCascCovs]);
+        }
+        prebuiltCascades[icascade] = helper.cascade;
+        prebuiltCascadeStatus[icascade] = isBuilt ? kPrebuiltOk : kPrebuiltFailed;
+      }
+    });
+  }
+
   //__________________________________________________
   template <class TBCs, typename TCollisions, typename TTracks, typename TV0s, typename TMCParticles>
   void buildV0s(TCollisions const& collisions, TV0s const& v0s, TTracks const& tracks, TMCParticles const& mcParticles)
@@ -1641,6 +1772,9 @@ struct StrangenessBuilder {
       mcParticleIsReco.resize(mcParticles.size(), false);
     }
 
+    // fit the candidates in parallel first, if requested
+    prebuildV0s(collisions, tracks);
+
     int nV0s = 0;
     // Loops over all V0s in the time frame
     histos.fill(HIST("hInputStatistics"), kV0CoresBase, v0s.size());
@@ -1666,41 +1800,49 @@ struct StrangenessBuilder {
       auto const& posTrack = tracks.rawIteratorAt(v0.posTrackId);
       auto const& negTrack = tracks.rawIteratorAt(v0.negTrackId);
 
-      auto posTrackPar = getTrackParCov(posTrack);
-      auto negTrackPar = getTrackParCov(negTrack);
-
-      // handle TPC-only tracks properly (photon conversions)
-      if (v0BuilderOpts.moveTPCOnlyTracks) {
-        bool isPosTPCOnly = (posTrack.hasTPC() && !posTrack.hasITS() && !posTrack.hasTRD() && !posTrack.hasTOF());
-        if (isPosTPCOnly) {
-          // Nota bene: positive is TPC-only -> this entire V0 merits treatment as photon candidate
-          posTrackPar.setPID(o2::track::PID::Electron);
-          negTrackPar.setPID(o2::track::PID::Electron);
-
-          auto const& collision = collisions.rawIteratorAt(v0.collisionId);
-          if (!mVDriftMgr.moveTPCTrack<TBCs, TCollisions>(collision, posTrack, posTrackPar)) {
-            products.v0dataLink(-1, -1);
-            continue;
-          }
+      if (iv0 < prebuiltV0Status.size() && prebuiltV0Status[iv0] != kNotPrebuilt) {
+        if (prebuiltV0Status[iv0] == kPrebuiltFailed) {
+          products.v0dataLink(-1, -1);
+          continue;
         }
+        straHelper.v0 = prebuiltV0s[iv0];
+      } else {
+        auto posTrackPar = getTrackParCov(posTrack);
+        auto negTrackPar = getTrackParCov(negTrack);
+
+        // handle TPC-only tracks properly (photon conversions)
+        if (v0BuilderOpts.moveTPCOnlyTracks) {
+          bool isPosTPCOnly = (posTrack.hasTPC() && !posTrack.hasITS() && !posTrack.hasTRD() && !posTrack.hasTOF());
+          if (isPosTPCOnly) {
+            // Nota bene: positive is TPC-only -> this entire V0 merits treatment as photon candidate
+            posTrackPar.setPID(o2::track::PID::Electron);
+            negTrackPar.setPID(o2::track::PID::Electron);
+
+            auto const& collision = collisions.rawIteratorAt(v0.collisionId);
+            if (!mVDriftMgr.moveTPCTrack<TBCs, TCollisions>(collision, posTrack, posTrackPar)) {
+              products.v0dataLink(-1, -1);
+              continue;
+            }
+          }
 
-        bool isNegTPCOnly = (negTrack.hasTPC() && !negTrack.hasITS() && !negTrack.hasTRD() && !negTrack.hasTOF());
-        if (isNegTPCOnly) {
-          // Nota bene: negative is TPC-only -> this entire V0 merits treatment as photon candidate
-          posTrackPar.setPID(o2::track::PID::Electron);
-          negTrackPar.setPID(o2::track::PID::Electron);
+          bool isNegTPCOnly = (negTrack.hasTPC() && !negTrack.hasITS() && !negTrack.hasTRD() && !negTrack.hasTOF());
+          if (isNegTPCOnly) {
+            // Nota bene: negative is TPC-only -> this entire V0 merits treatment as photon candidate
+            posTrackPar.setPID(o2::track::PID::Electron);
+            negTrackPar.setPID(o2::track::PID::Electron);
 
-          auto const& collision = collisions.rawIteratorAt(v0.collisionId);
-          if (!mVDriftMgr.moveTPCTrack<TBCs, TCollisions>(collision, negTrack, negTrackPar)) {
-            products.v0dataLink(-1, -1);
-            continue;
+            auto const& collision = collisions.rawIteratorAt(v0.collisionId);
+            if (!mVDriftMgr.moveTPCTrack<TBCs, TCollisions>(collision, negTrack, negTrackPar)) {
+              products.v0dataLink(-1, -1);
+              continue;
+            }
           }
         }
-      }
 
-      if (!straHelper.buildV0Candidate(v0.collisionId, pvX, pvY, pvZ, posTrack, negTrack, posTrackPar, negTrackPar, v0.isCollinearV0, mEnabledTables[kV0Covs], v0BuilderOpts.generatePhotonCandidates)) {
-        products.v0dataLink(-1, -1);
-        continue;
+        if (!straHelper.buildV0Candidate(v0.collisionId, pvX, pvY, pvZ, posTrack, negTrack, posTrackPar, negTrackPar, v0.isCollinearV0, mEnabledTables[kV0Covs], v0BuilderOpts.generatePhotonCandidates)) {
+          products.v0dataLink(-1, -1);
+          continue;
+        }
       }
       if constexpr (requires { posTrack.tpcNSigmaEl(); }) {
         if (preSelectOpts.preselectOnlyDesiredV0s) {
@@ -2180,6 +2322,9 @@ struct StrangenessBuilder {
     if (!mEnabledTables[kStoredCascCores]) {
       return; // don't do if no request for cascades in place
     }
+    // fit the candidates in parallel first, if requested
+    prebuildCascades(collisions, tracks);
+
     int nCascades = 0;
     // Loops over all cascades in the time frame
     histos.fill(HIST("hInputStatistics"), kStoredCascCores, cascades.size());
@@ -2198,7 +2343,14 @@ struct StrangenessBuilder {
       auto const& posTrack = tracks.rawIteratorAt(cascade.posTrackId);
       auto const& negTrack = tracks.rawIteratorAt(cascade.negTrackId);
       auto const& bachTrack = tracks.rawIteratorAt(cascade.bachTrackId);
-      if (useV0BufferForCascades) {
+      if (icascade < prebuiltCascadeStatus.size() && prebuiltCascadeStatus[icascade] != kNotPrebuilt) {
+        if (prebuiltCascadeStatus[icascade] == kPrebuiltFailed) {
+          products.cascdataLink(-1);
+          interlinks.cascadeToCascCores.push_back(-1);
+          continue; // didn't work out, skip
+        }
+        straHelper.cascade = prebuiltCascades[icascade];
+      } else if (useV0BufferForCascades) {
         // this processing path uses a buffer of V0s so that no
         // additional minimization step is redone. It consumes less
         // CPU at the cost of more memory. Since memory is a more
@@ -2837,6 +2989,11 @@ struct StrangenessBuilder {
     if (!initCCDB(bcs, collisions))
       return;
 
+    if (v0BuilderOpts.generatePhotonCandidates.value && v0BuilderOpts.moveTPCOnlyTracks.value) {
+      // TPC-only tracks of several photon candidates are moved once per collision
+      mVDriftMgr.cacheDataFrame<TBCs>(collisions);
+    }
+
     // reset vectors for cascade interlinks
     resetInterlinks();
 
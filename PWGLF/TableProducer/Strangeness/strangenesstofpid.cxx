@@ -865,6 +865,7 @@ struct strangenesstofpid {
     bool hasTPC = false;
     bool hasTOF = false;
     int collisionId = -1;
+    int64_t trackId = -1; // index of the track, for the propagation cache
     float tofExpMom = 0.0f;
     float tofSignal = 0.0f;
     float tofEvTime = 0.0f;
@@ -878,6 +879,53 @@ struct strangenesstofpid {
     float tpcNSigmaPr = 0.0f;
   };
 
+  struct daughterPropagation { // propagation of a daughter track from its decay point to the vertex of its collision
+    std::array<float, 7> start{}; // x, alpha and parameters of the daughter at the decay point
+    int collisionId = -1;
+    bool success = false;
+    float length = 0.0f;             // integrated length from the decay point to the vertex
+    o2::track::TrackPar propagated{}; // daughter after the propagation
+  };
+
+  // daughters shared by several V0s and cascades with the same decay point and momentum (e.g. the V0 daughters of
+  // cascades with the same V0) are propagated once per dataframe, the cache is cleared in the process functions
+  std::unordered_map<int64_t, daughterPropagation> daughterPropagations;
+
+  static std::array<float, 7> trackParArray(o2::track::TrackPar const& track)
+  {
+    return {track.getX(), track.getAlpha(), track.getY(), track.getZ(), track.getSnp(), track.getTgl(), track.getQ2Pt()};
+  }
+
+  /// propagates the daughter to the vertex, as propagateToDCA with the track length integral
+  /// \param trackVertex the vertex of the collision of the daughter track
+  /// \param tofInfo the TOF information of the daughter track
+  /// \param track the daughter at the decay point, propagated to the vertex on return
+  /// \param length the integrated length from the decay point to the vertex
+  bool propagateDaughterToVertex(o2::math_utils::Point3D<float> const& trackVertex, trackTofInfo const& tofInfo, o2::track::TrackPar& track, float& length)
+  {
+    if (tofInfo.trackId < 0) {
+      o2::track::TrackLTIntegral ltIntegral;
+      bool successPropag = o2::base::Propagator::Instance()->propagateToDCA(trackVertex, track, d_bz, 2.f, o2::base::Propagator::MatCorrType::USEMatCorrNONE, nullptr, &ltIntegral);
+      length = ltIntegral.getL();
+      return successPropag;
+    }
+    const auto start = trackParArray(track);
+    auto it = daughterPropagations.find(tofInfo.trackId);
+    if (it == daughterPropagations.end() || it->second.start != start || it->second.collisionId != tofInfo.collisionId) {
+      daughterPropagation propagation;
+      propagation.start = start;
+      propagation.collisionId = tofInfo.collisionId;
+      o2::track::TrackLTIntegral ltIntegral;
+      propagation.success = o2::base::Propagator::Instance()->propagateToDCA(trackVertex, track, d_bz, 2.f, o2::base::Propagator::MatCorrType::USEMatCorrNONE, nullptr, &ltIntegral);
+      propagation.length = ltIntegral.getL();
+      propagation.propagated = track;
+      it = daughterPropagations.insert_or_assign(tofInfo.trackId, propagation).first;
+    }
+    track = it->second.propagated;
+    length = it->second.length;
+    return it->second.success;
+  }
+
   // templatized process function for symmetric operation in derived and original AO2D
   /// \param collisions the collisions table (needed for de-referencing V0 and progns)
   /// \param v0 the V0 being processed
@@ -947,13 +995,13 @@ struct strangenesstofpid {
         if (pTof.collisionId >= 0) {
           auto trackCollision = collisions.rawIteratorAt(pTof.collisionId);
           const o2::math_utils::Point3D<float> trackVertex{trackCollision.posX(), trackCollision.posY(), trackCollision.posZ()};
-          o2::track::TrackLTIntegral ltIntegral;
-          bool successPropag = o2::base::Propagator::Instance()->propagateToDCA(trackVertex, posTrack, d_bz, 2.f, o2::base::Propagator::MatCorrType::USEMatCorrNONE, nullptr, &ltIntegral);
+          float lengthToVertex = 0.0f;
+          bool successPropag = propagateDaughterToVertex(trackVertex, pTof, posTrack, lengthToVertex);
           if (doQA) {
             histos.fill(HIST("hPropagationBookkeeping"), kPropagPosV0, static_cast<float>(successPropag));
           }
           if (successPropag) {
-            lengthPositive = pTof.length - ltIntegral.getL();
+            lengthPositive = pTof.length - lengthToVertex;
             v0tof.timePositiveEl = o2::framework::pid::tof::MassToExpTime(pTof.tofExpMom, lengthPositive, o2::constants::physics::MassElectron * o2::constants::physics::MassElectron);
             v0tof.timePositivePr = o2::framework::pid::tof::MassToExpTime(pTof.tofExpMom, lengthPositive, o2::constants::physics::MassProton * o2::constants::physics::MassProton);
             v0tof.timePositivePi = o2::framework::pid::tof::MassToExpTime(pTof.tofExpMom, lengthPositive, o2::constants::physics::MassPionCharged * o2::constants::physics::MassPionCharged);
@@ -1063,13 +1111,13 @@ struct strangenesstofpid {
         if (nTof.collisionId >= 0) {
           auto trackCollision = collisions.rawIteratorAt(nTof.collisionId);
           const o2::math_utils::Point3D<float> trackVertex{trackCollision.posX(), trackCollision.posY(), trackCollision.posZ()};
-          o2::track::TrackLTIntegral ltIntegral;
-          bool successPropag = o2::base::Propagator::Instance()->propagateToDCA(trackVertex, negTrack, d_bz, 2.f, o2::base::Propagator::MatCorrType::USEMatCorrNONE, nullptr, &ltIntegral);
+          float lengthToVertex = 0.0f;
+          bool successPropag = propagateDaughterToVertex(trackVertex, nTof, negTrack, lengthToVertex);
           if (doQA) {
             histos.fill(HIST("hPropagationBookkeeping"), kPropagNegV0, static_cast<float>(successPropag));
           }
           if (successPropag) {
-            lengthNegative = nTof.length - ltIntegral.getL();
+            lengthNegative = nTof.length - lengthToVertex;
             v0tof.timeNegativeEl = o2::framework::pid::tof::MassToExpTime(nTof.tofExpMom, lengthNegative, o2::constants::physics::MassElectron * o2::constants::physics::MassElectron);
             v0tof.timeNegativePr = o2::framework::pid::tof::MassToExpTime(nTof.tofExpMom, lengthNegative, o2::constants::physics::MassProton * o2::constants::physics::MassProton);
             v0tof.timeNegativePi = o2::framework::pid::tof::MassToExpTime(nTof.tofExpMom, lengthNegative, o2::constants::physics::MassPionCharged * o2::constants::physics::MassPionCharged);
@@ -1297,15 +1345,15 @@ struct strangenesstofpid {
         if (pTof.collisionId >= 0) {
           auto trackCollision = collisions.rawIteratorAt(pTof.collisionId);
           const o2::math_utils::Point3D<float> trackVertex{trackCollision.posX(), trackCollision.posY(), trackCollision.posZ()};
-          o2::track::TrackLTIntegral ltIntegral;
-          bool successPropag = o2::base::Propagator::Instance()->propagateToDCA(trackVertex, posTrack, d_bz, 2.f, o2::base::Propagator::MatCorrType::USEMatCorrNONE, nullptr, &ltIntegral);
+          float lengthToVertex = 0.0f;
+          bool successPropag = propagateDaughterToVertex(trackVertex, pTof, posTrack, lengthToVertex);
           if (doQA) {
             histos.fill(HIST("hPropagationBookkeeping"), kPropagPosCasc, static_cast<float>(successPropag));
           }
           if (successPropag) {
-            lengthPositive = pTof.length - ltIntegral.getL();
-            casctof.posFlightPr = o2::framework::pid::tof::MassToExpTime(pTof.tofExpMom, pTof.length - ltIntegral.getL(), o2::constants::physics::MassProton * o2::constants::physics::MassProton);
-            casctof.posFlightPi = o2::framework::pid::tof::MassToExpTime(pTof.tofExpMom, pTof.length - ltIntegral.getL(), o2::constants::physics::MassPionCharged * o2::constants::physics::MassPionCharged);
+            lengthPositive = pTof.length - lengthToVertex;
+            casctof.posFlightPr = o2::framework::pid::tof::MassToExpTime(pTof.tofExpMom, pTof.length - lengthToVertex, o2::constants::physics::MassProton * o2::constants::physics::MassProton);
+            casctof.posFlightPi = o2::framework::pid::tof::MassToExpTime(pTof.tofExpMom, pTof.length - lengthToVertex, o2::constants::physics::MassPionCharged * o2::constants::physics::MassPionCharged);
 
             // as primary
             casctof.posFlightAsPrimaryPr = o2::framework::pid::tof::MassToExpTime(pTof.tofExpMom, pTof.length, o2::constants::physics::MassProton * o2::constants::physics::MassProton);
@@ -1434,15 +1482,15 @@ struct strangenesstofpid {
         if (nTof.collisionId >= 0) {
           auto trackCollision = collisions.rawIteratorAt(nTof.collisionId);
           const o2::math_utils::Point3D<float> trackVertex{trackCollision.posX(), trackCollision.posY(), trackCollision.posZ()};
-          o2::track::TrackLTIntegral ltIntegral;
-          bool successPropag = o2::base::Propagator::Instance()->propagateToDCA(trackVertex, negTrack, d_bz, 2.f, o2::base::Propagator::MatCorrType::USEMatCorrNONE, nullptr, &ltIntegral);
+          float lengthToVertex = 0.0f;
+          bool successPropag = propagateDaughterToVertex(trackVertex, nTof, negTrack, lengthToVertex);
           if (doQA) {
             histos.fill(HIST("hPropagationBookkeeping"), kPropagNegCasc, static_cast<float>(successPropag));
           }
           if (successPropag) {
-            lengthNegative = nTof.length - ltIntegral.getL();
-            casctof.negFlightPr = o2::framework::pid::tof::MassToExpTime(nTof.tofExpMom, nTof.length - ltIntegral.getL(), o2::constants::physics::MassProton * o2::constants::physics::MassProton);
-            casctof.negFlightPi = o2::framework::pid::tof::MassToExpTime(nTof.tofExpMom, nTof.length - ltIntegral.getL(), o2::constants::physics::MassPionCharged * o2::constants::physics::MassPionCharged);
+            lengthNegative = nTof.length - lengthToVertex;
+            casctof.negFlightPr = o2::framework::pid::tof::MassToExpTime(nTof.tofExpMom, nTof.length - lengthToVertex, o2::constants::physics::MassProton * o2::constants::physics::MassProton);
+            casctof.negFlightPi = o2::framework::pid::tof::MassToExpTime(nTof.tofExpMom, nTof.length - lengthToVertex, o2::constants::physics::MassPionCharged * o2::constants::physics::MassPionCharged);
 
             // as primary
             casctof.negFlightAsPrimaryPr = o2::framework::pid::tof::MassToExpTime(nTof.tofExpMom, nTof.length, o2::constants::physics::MassProton * o2::constants::physics::MassProton);
@@ -1571,15 +1619,15 @@ struct strangenesstofpid {
         if (bTof.collisionId >= 0) {
           auto trackCollision = collisions.rawIteratorAt(bTof.collisionId);
           const o2::math_utils::Point3D<float> trackVertex{trackCollision.posX(), trackCollision.posY(), trackCollision.posZ()};
-          o2::track::TrackLTIntegral ltIntegral;
-          bool successPropag = o2::base::Propagator::Instance()->propagateToDCA(trackVertex, bachTrack, d_bz, 2.f, o2::base::Propagator::MatCorrType::USEMatCorrNONE, nullptr, &ltIntegral);
+          float lengthToVertex = 0.0f;
+          bool successPropag = propagateDaughterToVertex(trackVertex, bTof, bachTrack, lengthToVertex);
           if (doQA) {
             histos.fill(HIST("hPropagationBookkeeping"), kPropagBachCasc, static_cast<float>(successPropag));
           }
           if (successPropag) {
-            lengthBachelor = bTof.length - ltIntegral.getL();
-            casctof.bachFlightPi = o2::framework::pid::tof::MassToExpTime(bTof.tofExpMom, bTof.length - ltIntegral.getL(), o2::constants::physics::MassPionCharged * o2::constants::physics::MassPionCharged);
-            casctof.bachFlightKa = o2::framework::pid::tof::MassToExpTime(bTof.tofExpMom, bTof.length - ltIntegral.getL(), o2::constants::physics::MassKaonCharged * o2::constants::physics::MassKaonCharged);
+            lengthBachelor = bTof.length - lengthToVertex;
+            casctof.bachFlightPi = o2::framework::pid::tof::MassToExpTime(bTof.tofExpMom, bTof.length - lengthToVertex, o2::constants::physics::MassPionCharged * o2::constants::physics::MassPionCharged);
+            casctof.bachFlightKa = o2::framework::pid::tof::MassToExpTime(bTof.tofExpMom, bTof.length - lengthToVertex, o2::constants::physics::MassKaonCharged * o2::constants::physics::MassKaonCharged);
 
             // as primary
             casctof.bachFlightAsPrimaryPi = o2::framework::pid::tof::MassToExpTime(bTof.tofExpMom, bTof.length, o2::constants::physics::MassPionCharged * o2::constants::physics::MassPionCharged);
@@ -1668,6 +1716,8 @@ struct strangenesstofpid {
 
   void processStandardData(/*aod::BCs const& bcs,*/ aod::Collisions const& collisions, V0OriginalDatas const& V0s, CascOriginalDatas const& cascades, TracksWithAllExtras const& tracks, aod::BCsWithTimestamps const& bcs)
   {
+    daughterPropagations.clear();
+
     // Fire up CCDB with first collision in record. If no collisions, bypass
     if (useCustomRunNumber || collisions.size() < 1) {
       initCCDB(manualRunNumber);
@@ -1740,6 +1790,8 @@ struct strangenesstofpid {
         }
 
         pTof.collisionId = pTra.collisionId();
+
+        pTof.trackId = pTra.globalIndex();
         pTof.hasITS = pTra.hasITS();
         pTof.hasTPC = pTra.hasTPC();
         pTof.hasTOF = pTra.hasTOF();
@@ -1756,6 +1808,8 @@ struct strangenesstofpid {
         pTof.tpcNSigmaPr = pTra.tpcNSigmaPr();
 
         nTof.collisionId = nTra.collisionId();
+
+        nTof.trackId = nTra.globalIndex();
         nTof.hasITS = nTra.hasITS();
         nTof.hasTPC = nTra.hasTPC();
         nTof.hasTOF = nTra.hasTOF();
@@ -1858,6 +1912,8 @@ struct strangenesstofpid {
         }
 
         pTof.collisionId = pTra.collisionId();
+
+        pTof.trackId = pTra.globalIndex();
         pTof.hasITS = pTra.hasITS();
         pTof.hasTPC = pTra.hasTPC();
         pTof.hasTOF = pTra.hasTOF();
@@ -1871,6 +1927,8 @@ struct strangenesstofpid {
         pTof.tpcNSigmaPr = pTra.tpcNSigmaPr();
 
         nTof.collisionId = nTra.collisionId();
+
+        nTof.trackId = nTra.globalIndex();
         nTof.hasITS = nTra.hasITS();
         nTof.hasTPC = nTra.hasTPC();
         nTof.hasTOF = nTra.hasTOF();
@@ -1884,6 +1942,8 @@ struct strangenesstofpid {
         nTof.tpcNSigmaPr = nTra.tpcNSigmaPr();
 
         bTof.collisionId = bTra.collisionId();
+
+        bTof.trackId = bTra.globalIndex();
         bTof.hasITS = bTra.hasITS();
         bTof.hasTPC = bTra.hasTPC();
         bTof.hasTOF = bTra.hasTOF();
@@ -1937,6 +1997,7 @@ struct strangenesstofpid {
 
   void processDerivedData(soa::Join<aod::StraCollisions, aod::StraStamps, aod::StraEvTimes> const& collisions, V0DerivedDatas const& V0s, CascDerivedDatas const& cascades, dauTracks const& dauTrackTable, aod::DauTrackTOFPIDs const& dauTrackTOFPIDs)
   {
+    daughterPropagations.clear();
     bool isNewTOFFormat = true; // can only happen for new format
 
     for (const auto& collision : collisions) {
@@ -2007,6 +2068,7 @@ struct strangenesstofpid {
 
             // assign variables
             pTof.collisionId = pTofExt.straCollisionId();
+            pTof.trackId = pTra.globalIndex();
             pTof.tofExpMom = pTofExt.tofExpMom();
             pTof.tofEvTime = reassociateTracks.value ? collision.eventTime() : pTofExt.tofEvTime();
             pTof.tofEvTimeErr = reassociateTracks.value ? collision.eventTimeErr() : pTofExt.tofEvTimeErr();
@@ -2034,6 +2096,7 @@ struct strangenesstofpid {
 
             // assign variables
             nTof.collisionId = nTofExt.straCollisionId();
+            nTof.trackId = nTra.globalIndex();
             nTof.tofExpMom = nTofExt.tofExpMom();
             nTof.tofEvTime = reassociateTracks.value ? collision.eventTime() : nTofExt.tofEvTime();
             nTof.tofEvTimeErr = reassociateTracks.value ? collision.eventTimeErr() : nTofExt.tofEvTimeErr();
@@ -2103,6 +2166,8 @@ struct strangenesstofpid {
             histos.fill(HIST("h2dTOFSignalCascadePositive"), pTof.tofSignal, deltaTimeBc);
 
             pTof.collisionId = pTofExt.straCollisionId();
+
+            pTof.trackId = pTra.globalIndex();
             pTof.tofExpMom = pTofExt.tofExpMom();
             pTof.tofEvTime = reassociateTracks.value ? collision.eventTime() : pTofExt.tofEvTime();
             pTof.tofEvTimeErr = reassociateTracks.value ? collision.eventTimeErr() : pTofExt.tofEvTimeErr();
@@ -2129,6 +2194,8 @@ struct strangenesstofpid {
             histos.fill(HIST("h2dTOFSignalCascadeNegative"), nTof.tofSignal, deltaTimeBc);
 
             nTof.collisionId = nTofExt.straCollisionId();
+
+            nTof.trackId = nTra.globalIndex();
             nTof.tofExpMom = nTofExt.tofExpMom();
             nTof.tofEvTime = reassociateTracks.value ? collision.eventTime() : nTofExt.tofEvTime();
             nTof.tofEvTimeErr = reassociateTracks.value ? collision.eventTime() : nTofExt.tofEvTimeErr();
@@ -2155,6 +2222,8 @@ struct strangenesstofpid {
             histos.fill(HIST("h2dTOFSignalCascadeBachelor"), bTof.tofSignal, deltaTimeBc);
 
             bTof.collisionId = bTofExt.straCollisionId();
+
+            bTof.trackId = bTra.globalIndex();
             bTof.tofExpMom = bTofExt.tofExpMom();
             bTof.tofEvTime = reassociateTracks.value ? collision.eventTime() : bTofExt.tofEvTime();
             bTof.tofEvTimeErr = reassociateTracks.value ? collision.eventTimeErr() : bTofExt.tofEvTimeErr();
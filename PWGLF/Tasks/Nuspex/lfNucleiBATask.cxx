@@ -24,6 +24,7 @@
 #include "PWGLF/Utils/inelGt.h"
 
 #include "Common/CCDB/EventSelectionParams.h"
+#include "Common/Core/FillCostMonitor.h"
 #include "Common/Core/Zorro.h"
 #include "Common/Core/ZorroSummary.h"
 #include "Common/DataModel/Centrality.h"
@@ -85,6 +86,7 @@ struct lfNucleiBATask {
   HistogramRegistry evtimeHistos{"evtimeHistos", {}, OutputObjHandlingPolicy::AnalysisObject, false, false};
   HistogramRegistry evLossHistos{"evLossHistos", {}, OutputObjHandlingPolicy::AnalysisObject, false, false};
   HistogramRegistry histoGen{"histoGen", {}, OutputObjHandlingPolicy::AnalysisObject, false, true};
+  o2::common::core::FillCostMonitor fillCost;
 
   // Enable particle for analysis
   Configurable<bool> enablePr{"enablePr", true, "Flag to enable proton analysis."};
@@ -94,6 +96,7 @@ struct lfNucleiBATask {
   Configurable<bool> enableAl{"enableAl", true, "Flag to enable alpha analysis."};
 
   Configurable<bool> enableTrackingEff{"enableTrackingEff", false, "Flag to enable tracking efficiency histos."};
+  Configurable<std::string> cfgFillCostReport{"cfgFillCostReport", "", "If not empty, JSON file where the number of fills and the time per histogram and per process function are reported at the end of the job"};
   Configurable<std::string> ccdbUrl{"ccdb-url", "http://alice-ccdb.cern.ch", "url of the ccdb repository"}; // o2-linter: disable=name/configurable (fast fix)
 
   // Set the triggered events skimming scheme
@@ -319,6 +322,7 @@ struct lfNucleiBATask {
 
   void init(o2::framework::InitContext& context)
   {
+    fillCost.setReport(cfgFillCostReport.value);
     if (initITSPID) {
       o2::aod::ITSResponse::setParameters(context);
     }
@@ -2340,7 +2344,7 @@ struct lfNucleiBATask {
                       const ParticleType& particles,
                       float centFT0M)
   {
-    histos.fill(HIST("event/eventSkimming"), 0.5);
+    fillCost.fill(histos, HIST("event/eventSkimming"), 0.5);
     // Apply skimming
     if constexpr (!IsFilteredData) {
       const auto& bc = event.template bc_as<o2::aod::BCsWithTimestamps>();
@@ -2350,16 +2354,16 @@ struct lfNucleiBATask {
           return;
         }
       }
-      histos.fill(HIST("event/eventSkimming"), 1.5);
+      fillCost.fill(histos, HIST("event/eventSkimming"), 1.5);
     }
 
     // Event histos fill
     if (enableCentrality)
-      histos.fill(HIST("event/eventSelection"), 0, centFT0M);
+      fillCost.fill(histos, HIST("event/eventSelection"), 0, centFT0M);
     else
-      histos.fill(HIST("event/eventSelection"), 0);
+      fillCost.fill(histos, HIST("event/eventSelection"), 0);
     if (enableDebug)
-      debugHistos.fill(HIST("qa/h1VtxZ_nocut"), event.posZ());
+      fillCost.fill(debugHistos, HIST("qa/h1VtxZ_nocut"), event.posZ());
 
     if constexpr (!IsFilteredData) {
       if (!event.selection_bit(aod::evsel::kIsTriggerTVX)) {
@@ -2367,11 +2371,11 @@ struct lfNucleiBATask {
           return;
       } else {
         if (enableCentrality)
-          histos.fill(HIST("event/eventSelection"), 1, centFT0M);
+          fillCost.fill(histos, HIST("event/eventSelection"), 1, centFT0M);
         else
-          histos.fill(HIST("event/eventSelection"), 1);
+          fillCost.fill(histos, HIST("event/eventSelection"), 1);
         if (enableDebug)
-          debugHistos.fill(HIST("qa/h1VtxZ_TVXtrigger"), event.posZ());
+          fillCost.fill(debugHistos, HIST("qa/h1VtxZ_TVXtrigger"), event.posZ());
       }
 
       if (!event.selection_bit(aod::evsel::kNoTimeFrameBorder)) {
@@ -2379,11 +2383,11 @@ struct lfNucleiBATask {
           return;
       } else {
         if (enableCentrality)
-          histos.fill(HIST("event/eventSelection"), 2, centFT0M);
+          fillCost.fill(histos, HIST("event/eventSelection"), 2, centFT0M);
         else
-          histos.fill(HIST("event/eventSelection"), 2);
+          fillCost.fill(histos, HIST("event/eventSelection"), 2);
         if (enableDebug)
-          debugHistos.fill(HIST("qa/h1VtxZ_TFrameBorder"), event.posZ());
+          fillCost.fill(debugHistos, HIST("qa/h1VtxZ_TFrameBorder"), event.posZ());
       }
 
       if (!event.selection_bit(aod::evsel::kNoITSROFrameBorder)) {
@@ -2391,37 +2395,37 @@ struct lfNucleiBATask {
           return;
       } else {
         if (enableCentrality)
-          histos.fill(HIST("event/eventSelection"), 3, centFT0M);
+          fillCost.fill(histos, HIST("event/eventSelection"), 3, centFT0M);
         else
-          histos.fill(HIST("event/eventSelection"), 3);
+          fillCost.fill(histos, HIST("event/eventSelection"), 3);
         if (enableDebug)
-          debugHistos.fill(HIST("qa/h1VtxZ_ITSROFBorder"), event.posZ());
+          fillCost.fill(debugHistos, HIST("qa/h1VtxZ_ITSROFBorder"), event.posZ());
       }
 
       if ((event.selection_bit(aod::evsel::kNoITSROFrameBorder)) &&
           (event.selection_bit(aod::evsel::kNoTimeFrameBorder)) &&
           (event.selection_bit(aod::evsel::kIsTriggerTVX))) {
         if (enableCentrality)
-          histos.fill(HIST("event/eventSelection"), 4, centFT0M);
+          fillCost.fill(histos, HIST("event/eventSelection"), 4, centFT0M);
         else
-          histos.fill(HIST("event/eventSelection"), 4);
+          fillCost.fill(histos, HIST("event/eventSelection"), 4);
       }
 
       if (evselOptions.useSel8 && !event.sel8())
         return;
       if (enableCentrality)
-        histos.fill(HIST("event/eventSelection"), 5, centFT0M);
+        fillCost.fill(histos, HIST("event/eventSelection"), 5, centFT0M);
       else
-        histos.fill(HIST("event/eventSelection"), 5);
+        fillCost.fill(histos, HIST("event/eventSelection"), 5);
       if (enableDebug)
-        debugHistos.fill(HIST("qa/h1VtxZ_sel8"), event.posZ());
+        fillCost.fill(debugHistos, HIST("qa/h1VtxZ_sel8"), event.posZ());
 
       if (event.posZ() < cfgVzCutLow || event.posZ() > cfgVzCutHigh)
         return;
       if (enableCentrality)
-        histos.fill(HIST("event/eventSelection"), 6, centFT0M);
+        fillCost.fill(histos, HIST("event/eventSelection"), 6, centFT0M);
       else
-        histos.fill(HIST("event/eventSelection"), 6);
+        fillCost.fill(histos, HIST("event/eventSelection"), 6);
 
     } else {
       if (event.posZ() < cfgVzCutLow || event.posZ() > cfgVzCutHigh)
@@ -2434,24 +2438,24 @@ struct lfNucleiBATask {
       return;
     }
     if (enableCentrality) {
-      histos.fill(HIST("event/eventSelection"), 7, centFT0M);
-      histos.fill(HIST("event/eventSelection"), 8, centFT0M);
+      fillCost.fill(histos, HIST("event/eventSelection"), 7, centFT0M);
+      fillCost.fill(histos, HIST("event/eventSelection"), 8, centFT0M);
     } else {
-      histos.fill(HIST("event/eventSelection"), 7);
-      histos.fill(HIST("event/eventSelection"), 8);
+      fillCost.fill(histos, HIST("event/eventSelection"), 7);
+      fillCost.fill(histos, HIST("event/eventSelection"), 8);
     }
 
     if (event.isInelGt0()) {
       if (enableCentrality)
-        histos.fill(HIST("event/eventSelection"), 9, centFT0M);
+        fillCost.fill(histos, HIST("event/eventSelection"), 9, centFT0M);
       else
-        histos.fill(HIST("event/eventSelection"), 9);
+        fillCost.fill(histos, HIST("event/eventSelection"), 9);
     }
     if (event.isInelGt1()) {
       if (enableCentrality)
-        histos.fill(HIST("event/eventSelection"), 10, centFT0M);
+        fillCost.fill(histos, HIST("event/eventSelection"), 10, centFT0M);
       else
-        histos.fill(HIST("event/eventSelection"), 10);
+        fillCost.fill(histos, HIST("event/eventSelection"), 10);
     }
 
     float gamma = 0., massTOF = 0., massTOFhe = 0., massTOFantihe = 0., heTPCmomentum = 0.f, antiheTPCmomentum = 0.f, heP = 0.f, antiheP = 0.f, hePt = 0.f, antihePt = 0.f, antiDPt = 0.f, DPt = 0.f;
@@ -2464,20 +2468,20 @@ struct lfNucleiBATask {
 
     // Event histos fill
     if (enableCentrality)
-      histos.fill(HIST("event/h1VtxZ"), event.posZ(), centFT0M);
+      fillCost.fill(histos, HIST("event/h1VtxZ"), event.posZ(), centFT0M);
     else
-      histos.fill(HIST("event/h1VtxZ"), event.posZ());
+      fillCost.fill(histos, HIST("event/h1VtxZ"), event.posZ());
     if (enableDebug && enableCentrality) {
-      debugHistos.fill(HIST("event/hFT0M"), centFT0M);
+      fillCost.fill(debugHistos, HIST("event/hFT0M"), centFT0M);
       if (event.isInelGt0())
-        debugHistos.fill(HIST("event/hFT0M_INELgt0"), centFT0M);
+        fillCost.fill(debugHistos, HIST("event/hFT0M_INELgt0"), centFT0M);
       if (event.isInelGt1())
-        debugHistos.fill(HIST("event/hFT0M_INELgt1"), centFT0M);
+        fillCost.fill(debugHistos, HIST("event/hFT0M_INELgt1"), centFT0M);
     }
 
     if constexpr (IsFilteredData) {
       if (enableCentrality)
-        debugHistos.fill(HIST("event/hFV0M"), event.centFV0M());
+        fillCost.fill(debugHistos, HIST("event/hFV0M"), event.centFV0M());
     }
 
     auto tracksWithITS = soa::Attach<TracksType,
@@ -2490,6 +2494,44 @@ struct lfNucleiBATask {
 
     tracks.copyIndexBindings(tracksWithITS);
 
+    // quantities which do not depend on the track, read once per collision
+    const auto& tpcChi2NclRange = trkqcOptions.tpcChi2NclCuts.value;
+    const auto& itsChi2NclRange = trkqcOptions.itsChi2NclCuts.value;
+    const auto& parDCAxy = parDCAxycuts.value;
+    const auto& parDCAz = parDCAzcuts.value;
+    // pT dependent DCA limit, |DCA| < [3] * ([O] + [1]/Pt^[2])
+    auto dcaLimit = [](const std::vector<float>& par, float pt) { return par[3] * (par[0] + par[1] / std::pow(pt, par[2])); };
+
+    if (enablePtShiftHe && !fShiftPtHe) {
+      fShiftPtHe = new TF1("fShiftPtHe", "[0] * exp([1] + [2] * x) + [3] + [4] * x", 0.f, 8.f);
+      auto parHe = (std::vector<float>)parShiftPtHe; // NOLINT
+      fShiftPtHe->SetParameters(parHe[0], parHe[1], parHe[2], parHe[3], parHe[4]);
+    }
+
+    if (enablePtShiftHe && !fShiftPtantiHe) {
+      fShiftPtantiHe = new TF1("fShiftPtantiHe", "[0] * exp([1] + [2] * x) + [3] + [4] * x", 0.f, 8.f);
+      auto parAntiHe = (std::vector<float>)parShiftPtAntiHe; // NOLINT
+      fShiftPtantiHe->SetParameters(parAntiHe[0], parAntiHe[1], parAntiHe[2], parAntiHe[3], parAntiHe[4]);
+    }
+
+    if (enablePtShiftAntiD && !fShiftAntiD) {
+      fShiftAntiD = new TF1("fShiftAntiD", "[0] * exp([1] + [2] * x) + [3] + [4] * x", 0.f, 8.f);
+      auto parAntiD = (std::vector<float>)parShiftPtAntiD; // NOLINT
+      fShiftAntiD->SetParameters(parAntiD[0], parAntiD[1], parAntiD[2], parAntiD[3], parAntiD[4]);
+    }
+
+    if (enablePtShiftPID && !fShiftPtPID) {
+      fShiftPtPID = new TF1("fShiftPtPID", "[0] * exp([1] + [2] * x) + [3] + [4] * x + [5] * x * x + [6] * x * x * x", 0.f, 8.f);
+      auto parPID = (std::vector<float>)parShiftPtPID; // NOLINT
+      fShiftPtPID->SetParameters(parPID[0], parPID[1], parPID[2], parPID[3], parPID[4], parPID[5], parPID[6]);
+    }
+
+    if (enablePtShiftD && !fShiftD) {
+      fShiftD = new TF1("fShiftD", "[0] * exp([1] + [2] * x) + [3] + [4] * x", 0.f, 8.f);
+      auto parD = (std::vector<float>)parShiftPtD; // NOLINT
+      fShiftD->SetParameters(parD[0], parD[1], parD[2], parD[3], parD[4]);
+    }
+
     for (auto const& track : tracksWithITS) {
       if constexpr (!IsFilteredData) {
         if (!track.isGlobalTrackWoDCA() && filterOptions.enableIsGlobalTrack) {
@@ -2500,7 +2542,7 @@ struct lfNucleiBATask {
 
       if constexpr (!IsFilteredData) {
         if (nsigmaITSvar.showAverageClusterSize && outFlagOptions.enablePIDplot)
-          histos.fill(HIST("tracks/avgClusterSizePerCoslInvVsITSlayers"), track.p(), averageClusterSizePerCoslInv(track), track.itsNCls());
+          fillCost.fill(histos, HIST("tracks/avgClusterSizePerCoslInvVsITSlayers"), track.p(), averageClusterSizePerCoslInv(track), track.itsNCls());
       }
 
       if (track.itsNCls() < trkqcOptions.cfgCutITSClusters ||
@@ -2510,10 +2552,8 @@ struct lfNucleiBATask {
         continue;
       }
 
-      auto tpcChi2NclRange = (std::vector<float>)trkqcOptions.tpcChi2NclCuts;
       if ((track.tpcChi2NCl() < tpcChi2NclRange[0]) || (track.tpcChi2NCl() > tpcChi2NclRange[1]))
         continue;
-      auto itsChi2NclRange = (std::vector<float>)trkqcOptions.itsChi2NclCuts;
       if ((track.itsChi2NCl() < itsChi2NclRange[0]) || (track.itsChi2NCl() > itsChi2NclRange[1]))
         continue;
 
@@ -2523,8 +2563,8 @@ struct lfNucleiBATask {
         continue;
 
       if (outFlagOptions.enablePIDplot) {
-        histos.fill(HIST("tracks/h1pT"), track.pt());
-        histos.fill(HIST("tracks/h1p"), track.p());
+        fillCost.fill(histos, HIST("tracks/h1pT"), track.pt());
+        fillCost.fill(histos, HIST("tracks/h1p"), track.p());
       }
 
       isTritonTPCpid = std::abs(track.tpcNSigmaTr()) < nsigmaTPCvar.nsigmaTPCTr;
@@ -2536,30 +2576,6 @@ struct lfNucleiBATask {
       float shiftPtNeg = 0.f;
       float shiftPtPID = 0.f;
 
-      if (enablePtShiftHe && !fShiftPtHe) {
-        fShiftPtHe = new TF1("fShiftPtHe", "[0] * exp([1] + [2] * x) + [3] + [4] * x", 0.f, 8.f);
-        auto parHe = (std::vector<float>)parShiftPtHe; // NOLINT
-        fShiftPtHe->SetParameters(parHe[0], parHe[1], parHe[2], parHe[3], parHe[4]);
-      }
-
-      if (enablePtShiftHe && !fShiftPtantiHe) {
-        fShiftPtantiHe = new TF1("fShiftPtantiHe", "[0] * exp([1] + [2] * x) + [3] + [4] * x", 0.f, 8.f);
-        auto parAntiHe = (std::vector<float>)parShiftPtAntiHe; // NOLINT
-        fShiftPtantiHe->SetParameters(parAntiHe[0], parAntiHe[1], parAntiHe[2], parAntiHe[3], parAntiHe[4]);
-      }
-
-      if (enablePtShiftAntiD && !fShiftAntiD) {
-        fShiftAntiD = new TF1("fShiftAntiD", "[0] * exp([1] + [2] * x) + [3] + [4] * x", 0.f, 8.f);
-        auto parAntiD = (std::vector<float>)parShiftPtAntiD; // NOLINT
-        fShiftAntiD->SetParameters(parAntiD[0], parAntiD[1], parAntiD[2], parAntiD[3], parAntiD[4]);
-      }
-
-      if (enablePtShiftPID && !fShiftPtPID) {
-        fShiftPtPID = new TF1("fShiftPtPID", "[0] * exp([1] + [2] * x) + [3] + [4] * x + [5] * x * x + [6] * x * x * x", 0.f, 8.f);
-        auto parPID = (std::vector<float>)parShiftPtPID; // NOLINT
-        fShiftPtPID->SetParameters(parPID[0], parPID[1], parPID[2], parPID[3], parPID[4], parPID[5], parPID[6]);
-      }
-
       switch (unableAntiDPtShift) {
         case 0:
           if (enablePtShiftAntiD && fShiftAntiD) {
@@ -2572,12 +2588,6 @@ struct lfNucleiBATask {
           break;
       }
 
-      if (enablePtShiftD && !fShiftD) {
-        fShiftD = new TF1("fShiftD", "[0] * exp([1] + [2] * x) + [3] + [4] * x", 0.f, 8.f);
-        auto parD = (std::vector<float>)parShiftPtD; // NOLINT
-        fShiftD->SetParameters(parD[0], parD[1], parD[2], parD[3], parD[4]);
-      }
-
       switch (unableDPtShift) {
         case 0:
           if (enablePtShiftD && fShiftD) {
@@ -2629,11 +2639,6 @@ struct lfNucleiBATask {
       heTPCmomentum = track.tpcInnerParam();
       antiheTPCmomentum = track.tpcInnerParam();
 
-      // auto parDCAxy = (std::vector<float>)parDCAxycuts;
-      // auto parDCAz = (std::vector<float>)parDCAzcuts;
-      const auto& parDCAxy = parDCAxycuts.value;
-      const auto& parDCAz = parDCAzcuts.value;
-
       bool passDCAxyCut = false;
       bool passDCAzCut = false;
       bool passDCAxyCutDe = false;
@@ -2687,61 +2692,59 @@ struct lfNucleiBATask {
       const float dcaXY2 = track.dcaXY() * track.dcaXY();
       const float dcaZ2 = track.dcaZ() * track.dcaZ();
 
+      // the limits of the pT dependent cuts for the pT hypotheses of the track, each evaluated once
+      auto passDCAxyLimit = [&](float pt) { return std::abs(track.dcaXY()) <= dcaLimit(parDCAxy, pt); };
+      auto passDCAzLimit = [&](float pt) { return std::abs(track.dcaZ()) <= dcaLimit(parDCAz, pt); };
+      auto passDCAEllipse = [&](float pt) { return dcaXY2 / std::pow(dcaLimit(parDCAxy, pt), 2) + dcaZ2 / std::pow(dcaLimit(parDCAz, pt), 2) <= 1; };
+
       switch (dcaConfOptions.cfgCustomDCA) {
         case 0:
           passDCAxyCut = passDCAxyCutDe = passDCAxyCutAntiDe = passDCAxyCutHe = passDCAxyCutAntiHe = (std::abs(track.dcaXY()) <= dcaConfOptions.cfgCustomDCAxy);
           passDCAzCut = passDCAzCutDe = passDCAzCutAntiDe = passDCAzCutHe = passDCAzCutAntiHe = (std::abs(track.dcaZ()) <= dcaConfOptions.cfgCustomDCAz);
           break;
         case 1:
-          passDCAxyCut = (std::abs(track.dcaXY()) <= parDCAxy[3] * (parDCAxy[0] + parDCAxy[1] / std::pow(track.pt(), parDCAxy[2])));
-          passDCAzCut = (std::abs(track.dcaZ()) <= parDCAz[3] * (parDCAz[0] + parDCAz[1] / std::pow(track.pt(), parDCAz[2])));
-
-          passDCAxyCutDe = (std::abs(track.dcaXY()) <= parDCAxy[3] * (parDCAxy[0] + parDCAxy[1] / std::pow(DPt, parDCAxy[2])));
-          passDCAzCutDe = (std::abs(track.dcaZ()) <= parDCAz[3] * (parDCAz[0] + parDCAz[1] / std::pow(DPt, parDCAz[2])));
-          passDCAxyCutAntiDe = (std::abs(track.dcaXY()) <= parDCAxy[3] * (parDCAxy[0] + parDCAxy[1] / std::pow(antiDPt, parDCAxy[2])));
-          passDCAzCutAntiDe = (std::abs(track.dcaZ()) <= parDCAz[3] * (parDCAz[0] + parDCAz[1] / std::pow(antiDPt, parDCAz[2])));
-
-          passDCAxyCutHe = (std::abs(track.dcaXY()) <= parDCAxy[3] * (parDCAxy[0] + parDCAxy[1] / std::pow(hePt, parDCAxy[2])));
-          passDCAzCutHe = (std::abs(track.dcaZ()) <= parDCAz[3] * (parDCAz[0] + parDCAz[1] / std::pow(hePt, parDCAz[2])));
-          passDCAxyCutAntiHe = (std::abs(track.dcaXY()) <= parDCAxy[3] * (parDCAxy[0] + parDCAxy[1] / std::pow(antihePt, parDCAxy[2])));
-          passDCAzCutAntiHe = (std::abs(track.dcaZ()) <= parDCAz[3] * (parDCAz[0] + parDCAz[1] / std::pow(antihePt, parDCAz[2])));
+          passDCAxyCut = passDCAxyLimit(track.pt());
+          passDCAzCut = passDCAzLimit(track.pt());
+
+          passDCAxyCutDe = passDCAxyLimit(DPt);
+          passDCAzCutDe = passDCAzLimit(DPt);
+          passDCAxyCutAntiDe = passDCAxyLimit(antiDPt);
+          passDCAzCutAntiDe = passDCAzLimit(antiDPt);
+
+          passDCAxyCutHe = passDCAxyLimit(hePt);
+          passDCAzCutHe = passDCAzLimit(hePt);
+          passDCAxyCutAntiHe = passDCAxyLimit(antihePt);
+          passDCAzCutAntiHe = passDCAzLimit(antihePt);
           break;
         case 2:
-          passDCAxyCutDe = (std::abs(track.dcaXY()) <= parDCAxy[3] * (parDCAxy[0] + parDCAxy[1] / std::pow(DPt, parDCAxy[2])));
-          passDCAxyCutAntiDe = (std::abs(track.dcaXY()) <= parDCAxy[3] * (parDCAxy[0] + parDCAxy[1] / std::pow(antiDPt, parDCAxy[2])));
+          passDCAxyCutDe = passDCAxyLimit(DPt);
+          passDCAxyCutAntiDe = passDCAxyLimit(antiDPt);
 
-          passDCAxyCutHe = (std::abs(track.dcaXY()) <= parDCAxy[3] * (parDCAxy[0] + parDCAxy[1] / std::pow(hePt, parDCAxy[2])));
-          passDCAxyCutAntiHe = (std::abs(track.dcaXY()) <= parDCAxy[3] * (parDCAxy[0] + parDCAxy[1] / std::pow(antihePt, parDCAxy[2])));
+          passDCAxyCutHe = passDCAxyLimit(hePt);
+          passDCAxyCutAntiHe = passDCAxyLimit(antihePt);
 
-          passDCAxyCut = (std::abs(track.dcaXY()) <= parDCAxy[3] * (parDCAxy[0] + parDCAxy[1] / std::pow(track.pt(), parDCAxy[2])));
+          passDCAxyCut = passDCAxyLimit(track.pt());
           passDCAzCut = passDCAzCutDe = passDCAzCutAntiDe = passDCAzCutHe = passDCAzCutAntiHe = (std::abs(track.dcaZ()) <= dcaConfOptions.cfgCustomDCAz);
           break;
         case 3:
           passDCAxyCut = passDCAxyCutDe = passDCAxyCutAntiDe = passDCAxyCutHe = passDCAxyCutAntiHe = (std::abs(track.dcaXY()) <= dcaConfOptions.cfgCustomDCAxy);
-          passDCAzCut = (std::abs(track.dcaZ()) <= parDCAz[3] * (parDCAz[0] + parDCAz[1] / std::pow(track.pt(), parDCAz[2])));
+          passDCAzCut = passDCAzLimit(track.pt());
 
-          passDCAzCutDe = (std::abs(track.dcaZ()) <= parDCAz[3] * (parDCAz[0] + parDCAz[1] / std::pow(DPt, parDCAz[2])));
-          passDCAzCutAntiDe = (std::abs(track.dcaZ()) <= parDCAz[3] * (parDCAz[0] + parDCAz[1] / std::pow(antiDPt, parDCAz[2])));
+          passDCAzCutDe = passDCAzLimit(DPt);
+          passDCAzCutAntiDe = passDCAzLimit(antiDPt);
 
-          passDCAzCutHe = (std::abs(track.dcaZ()) <= parDCAz[3] * (parDCAz[0] + parDCAz[1] / std::pow(hePt, parDCAz[2])));
-          passDCAzCutAntiHe = (std::abs(track.dcaZ()) <= parDCAz[3] * (parDCAz[0] + parDCAz[1] / std::pow(antihePt, parDCAz[2])));
+          passDCAzCutHe = passDCAzLimit(hePt);
+          passDCAzCutAntiHe = passDCAzLimit(antihePt);
           break;
         case 4:
           passDCAxyCut = passDCAzCut = passDCAxyCutDe = passDCAzCutDe = passDCAxyCutAntiDe = passDCAzCutAntiDe = passDCAxyCutHe = passDCAzCutHe = passDCAxyCutAntiHe = passDCAzCutAntiHe = dcaXY2 / std::pow(dcaConfOptions.cfgCustomDCAxy, 2) + dcaZ2 / std::pow(dcaConfOptions.cfgCustomDCAz, 2) <= 1;
           break;
         case 5:
-          passDCAxyCut = dcaXY2 / std::pow(parDCAxy[3] * (parDCAxy[0] + parDCAxy[1] / std::pow(track.pt(), parDCAxy[2])), 2) + dcaZ2 / std::pow(parDCAz[3] * (parDCAz[0] + parDCAz[1] / std::pow(track.pt(), parDCAz[2])), 2) <= 1;
-          passDCAzCut = dcaXY2 / std::pow(parDCAxy[3] * (parDCAxy[0] + parDCAxy[1] / std::pow(track.pt(), parDCAxy[2])), 2) + dcaZ2 / std::pow(parDCAz[3] * (parDCAz[0] + parDCAz[1] / std::pow(track.pt(), parDCAz[2])), 2) <= 1;
-
-          passDCAxyCutDe = dcaXY2 / std::pow(parDCAxy[3] * (parDCAxy[0] + parDCAxy[1] / std::pow(DPt, parDCAxy[2])), 2) + dcaZ2 / std::pow(parDCAz[3] * (parDCAz[0] + parDCAz[1] / std::pow(DPt, parDCAz[2])), 2) <= 1;
-          passDCAzCutDe = dcaXY2 / std::pow(parDCAxy[3] * (parDCAxy[0] + parDCAxy[1] / std::pow(DPt, parDCAxy[2])), 2) + dcaZ2 / std::pow(parDCAz[3] * (parDCAz[0] + parDCAz[1] / std::pow(DPt, parDCAz[2])), 2) <= 1;
-          passDCAxyCutAntiDe = dcaXY2 / std::pow(parDCAxy[3] * (parDCAxy[0] + parDCAxy[1] / std::pow(antiDPt, parDCAxy[2])), 2) + dcaZ2 / std::pow(parDCAz[3] * (parDCAz[0] + parDCAz[1] / std::pow(antiDPt, parDCAz[2])), 2) <= 1;
-          passDCAzCutAntiDe = dcaXY2 / std::pow(parDCAxy[3] * (parDCAxy[0] + parDCAxy[1] / std::pow(antiDPt, parDCAxy[2])), 2) + dcaZ2 / std::pow(parDCAz[3] * (parDCAz[0] + parDCAz[1] / std::pow(antiDPt, parDCAz[2])), 2) <= 1;
-
-          passDCAxyCutHe = dcaXY2 / std::pow(parDCAxy[3] * (parDCAxy[0] + parDCAxy[1] / std::pow(hePt, parDCAxy[2])), 2) + dcaZ2 / std::pow(parDCAz[3] * (parDCAz[0] + parDCAz[1] / std::pow(hePt, parDCAz[2])), 2) <= 1;
-          passDCAzCutHe = dcaXY2 / std::pow(parDCAxy[3] * (parDCAxy[0] + parDCAxy[1] / std::pow(hePt, parDCAxy[2])), 2) + dcaZ2 / std::pow(parDCAz[3] * (parDCAz[0] + parDCAz[1] / std::pow(hePt, parDCAz[2])), 2) <= 1;
-          passDCAxyCutAntiHe = dcaXY2 / std::pow(parDCAxy[3] * (parDCAxy[0] + parDCAxy[1] / std::pow(antihePt, parDCAxy[2])), 2) + dcaZ2 / std::pow(parDCAz[3] * (parDCAz[0] + parDCAz[1] / std::pow(antihePt, parDCAz[2])), 2) <= 1;
-          passDCAzCutAntiHe = dcaXY2 / std::pow(parDCAxy[3] * (parDCAxy[0] + parDCAxy[1] / std::pow(antihePt, parDCAxy[2])), 2) + dcaZ2 / std::pow(parDCAz[3] * (parDCAz[0] + parDCAz[1] / std::pow(antihePt, parDCAz[2])), 2) <= 1;
+          passDCAxyCut = passDCAzCut = passDCAEllipse(track.pt());
+          passDCAxyCutDe = passDCAzCutDe = passDCAEllipse(DPt);
+          passDCAxyCutAntiDe = passDCAzCutAntiDe = passDCAEllipse(antiDPt);
+          passDCAxyCutHe = passDCAzCutHe = passDCAEllipse(hePt);
+          passDCAxyCutAntiHe = passDCAzCutAntiHe = passDCAEllipse(antihePt);
           break;
       }
 
@@ -2767,19 +2770,22 @@ struct lfNucleiBATask {
       if constexpr (IsMC && !IsFilteredData) {
         int pdgCheck = track.mcParticle().pdgCode();
         if (std::abs(pdgCheck) == PDGDeuteron)
-          histos.fill(HIST("tracks/hItsDeHeChecker"), 0);
+          fillCost.fill(histos, HIST("tracks/hItsDeHeChecker"), 0);
         if (std::abs(pdgCheck) == PDGHelium)
-          histos.fill(HIST("tracks/hItsDeHeChecker"), 1);
+          fillCost.fill(histos, HIST("tracks/hItsDeHeChecker"), 1);
       }
 
       if constexpr (IsMC && !IsFilteredData) {
         int pdgCheck = track.mcParticle().pdgCode();
         if ((std::abs(pdgCheck) == PDGDeuteron) && passITSDeCut)
-          histos.fill(HIST("tracks/hItsDeHeChecker"), 2);
+          fillCost.fill(histos, HIST("tracks/hItsDeHeChecker"), 2);
         if ((std::abs(pdgCheck) == PDGHelium) && passITSHeCut)
-          histos.fill(HIST("tracks/hItsDeHeChecker"), 3);
+          fillCost.fill(histos, HIST("tracks/hItsDeHeChecker"), 3);
       }
 
+      const bool passTPCDe = std::abs(track.tpcNSigmaDe()) < nsigmaTPCvar.nsigmaTPCDe;
+      const bool passTPCHe = std::abs(track.tpcNSigmaHe()) < nsigmaTPCvar.nsigmaTPCHe;
+
       isDe = isDeuteron && passITSDeCut && track.sign() > 0;
       isAntiDe = isDeuteron && passITSDeCut && track.sign() < 0;
 
@@ -2796,98 +2802,98 @@ struct lfNucleiBATask {
       isHeWoDCAz = isHe && passDCAxyCutHe;
       isAntiHeWoDCAz = isAntiHe && passDCAxyCutAntiHe;
 
-      isDeWoDCAxyWTPCpid = isDeWoDCAxy && std::abs(track.tpcNSigmaDe()) < nsigmaTPCvar.nsigmaTPCDe;
-      isAntiDeWoDCAxyWTPCpid = isAntiDeWoDCAxy && std::abs(track.tpcNSigmaDe()) < nsigmaTPCvar.nsigmaTPCDe;
-      isHeWoDCAxyWTPCpid = isHeWoDCAxy && std::abs(track.tpcNSigmaHe()) < nsigmaTPCvar.nsigmaTPCHe;
-      isAntiHeWoDCAxyWTPCpid = isAntiHeWoDCAxy && std::abs(track.tpcNSigmaHe()) < nsigmaTPCvar.nsigmaTPCHe;
+      isDeWoDCAxyWTPCpid = isDeWoDCAxy && passTPCDe;
+      isAntiDeWoDCAxyWTPCpid = isAntiDeWoDCAxy && passTPCDe;
+      isHeWoDCAxyWTPCpid = isHeWoDCAxy && passTPCHe;
+      isAntiHeWoDCAxyWTPCpid = isAntiHeWoDCAxy && passTPCHe;
 
-      isDeWoDCAzWTPCpid = isDeWoDCAz && std::abs(track.tpcNSigmaDe()) < nsigmaTPCvar.nsigmaTPCDe;
-      isAntiDeWoDCAzWTPCpid = isAntiDeWoDCAz && std::abs(track.tpcNSigmaDe()) < nsigmaTPCvar.nsigmaTPCDe;
-      isHeWoDCAzWTPCpid = isHeWoDCAz && std::abs(track.tpcNSigmaHe()) < nsigmaTPCvar.nsigmaTPCHe;
-      isAntiHeWoDCAzWTPCpid = isAntiHeWoDCAz && std::abs(track.tpcNSigmaHe()) < nsigmaTPCvar.nsigmaTPCHe;
+      isDeWoDCAzWTPCpid = isDeWoDCAz && passTPCDe;
+      isAntiDeWoDCAzWTPCpid = isAntiDeWoDCAz && passTPCDe;
+      isHeWoDCAzWTPCpid = isHeWoDCAz && passTPCHe;
+      isAntiHeWoDCAzWTPCpid = isAntiHeWoDCAz && passTPCHe;
 
       isDeWoTPCpid = isDe && passDCAzCutDe && passDCAxyCutDe;
       isAntiDeWoTPCpid = isAntiDe && passDCAzCutAntiDe && passDCAxyCutAntiDe;
       isHeWoTPCpid = isHe && passDCAzCutHe && passDCAxyCutHe;
       isAntiHeWoTPCpid = isAntiHe && passDCAzCutAntiHe && passDCAxyCutAntiHe;
 
-      isDeWTPCpid = isDeWoTPCpid && std::abs(track.tpcNSigmaDe()) < nsigmaTPCvar.nsigmaTPCDe;
-      isAntiDeWTPCpid = isAntiDeWoTPCpid && std::abs(track.tpcNSigmaDe()) < nsigmaTPCvar.nsigmaTPCDe;
-      isHeWTPCpid = isHeWoTPCpid && std::abs(track.tpcNSigmaHe()) < nsigmaTPCvar.nsigmaTPCHe;
-      isAntiHeWTPCpid = isAntiHeWoTPCpid && std::abs(track.tpcNSigmaHe()) < nsigmaTPCvar.nsigmaTPCHe;
+      isDeWTPCpid = isDeWoTPCpid && passTPCDe;
+      isAntiDeWTPCpid = isAntiDeWoTPCpid && passTPCDe;
+      isHeWTPCpid = isHeWoTPCpid && passTPCHe;
+      isAntiHeWTPCpid = isAntiHeWoTPCpid && passTPCHe;
 
       passDCAxyzCut = passDCAxyCut && passDCAzCut;
 
       // DCAxy vs DCAz plots BEFORE cut
       if (outFlagOptions.makeDCABeforeCutPlots) {
-        histos.fill(HIST("tracks/dca/before/hDCAxyVsDCAzVsPt"), track.dcaXY(), track.dcaZ(), track.pt());
-        histos.fill(HIST("tracks/dca/before/hDCAxyVsDCAz"), track.dcaZ(), track.dcaXY());
+        fillCost.fill(histos, HIST("tracks/dca/before/hDCAxyVsDCAzVsPt"), track.dcaXY(), track.dcaZ(), track.pt());
+        fillCost.fill(histos, HIST("tracks/dca/before/hDCAxyVsDCAz"), track.dcaZ(), track.dcaXY());
 
-        if (isHe && std::abs(track.tpcNSigmaHe()) < nsigmaTPCvar.nsigmaTPCHe) {
-          histos.fill(HIST("tracks/helium/dca/before/h3DCAvsPtHelium"), track.dcaXY(), track.dcaZ(), hePt);
+        if (isHe && passTPCHe) {
+          fillCost.fill(histos, HIST("tracks/helium/dca/before/h3DCAvsPtHelium"), track.dcaXY(), track.dcaZ(), hePt);
           if (track.hasTOF() && outFlagOptions.doTOFplots) {
-            histos.fill(HIST("tracks/helium/dca/before/TOF/hDCAxyVsDCAzVsPtHelium"), track.dcaXY(), track.dcaZ(), hePt);
+            fillCost.fill(histos, HIST("tracks/helium/dca/before/TOF/hDCAxyVsDCAzVsPtHelium"), track.dcaXY(), track.dcaZ(), hePt);
           }
         }
-        if (isAntiHe && std::abs(track.tpcNSigmaHe()) < nsigmaTPCvar.nsigmaTPCHe) {
-          histos.fill(HIST("tracks/helium/dca/before/h3DCAvsPtantiHelium"), track.dcaXY(), track.dcaZ(), antihePt);
+        if (isAntiHe && passTPCHe) {
+          fillCost.fill(histos, HIST("tracks/helium/dca/before/h3DCAvsPtantiHelium"), track.dcaXY(), track.dcaZ(), antihePt);
           if (track.hasTOF() && outFlagOptions.doTOFplots) {
-            histos.fill(HIST("tracks/helium/dca/before/TOF/hDCAxyVsDCAzVsPtantiHelium"), track.dcaXY(), track.dcaZ(), antihePt);
+            fillCost.fill(histos, HIST("tracks/helium/dca/before/TOF/hDCAxyVsDCAzVsPtantiHelium"), track.dcaXY(), track.dcaZ(), antihePt);
           }
         }
         if (passDCAxyCut) {
-          histos.fill(HIST("tracks/dca/before/hDCAzVsPt"), track.pt(), track.dcaZ());
+          fillCost.fill(histos, HIST("tracks/dca/before/hDCAzVsPt"), track.pt(), track.dcaZ());
 
           if (enablePr && prRapCut && (std::abs(track.tpcNSigmaPr()) < nsigmaTPCvar.nsigmaTPCPr)) {
             if (track.sign() > 0) {
-              histos.fill(HIST("tracks/proton/dca/before/hDCAzVsPtProton"), track.pt(), track.dcaZ());
+              fillCost.fill(histos, HIST("tracks/proton/dca/before/hDCAzVsPtProton"), track.pt(), track.dcaZ());
             } else {
-              histos.fill(HIST("tracks/proton/dca/before/hDCAzVsPtantiProton"), track.pt(), track.dcaZ());
+              fillCost.fill(histos, HIST("tracks/proton/dca/before/hDCAzVsPtantiProton"), track.pt(), track.dcaZ());
             }
           }
           if (enableTr && trRapCut && isTritonTPCpid) {
             if (track.sign() > 0) {
-              histos.fill(HIST("tracks/triton/dca/before/hDCAzVsPtTriton"), track.pt(), track.dcaZ());
+              fillCost.fill(histos, HIST("tracks/triton/dca/before/hDCAzVsPtTriton"), track.pt(), track.dcaZ());
             } else {
-              histos.fill(HIST("tracks/triton/dca/before/hDCAzVsPtantiTriton"), track.pt(), track.dcaZ());
+              fillCost.fill(histos, HIST("tracks/triton/dca/before/hDCAzVsPtantiTriton"), track.pt(), track.dcaZ());
             }
           }
           if (enableAl && alRapCut && (std::abs(track.tpcNSigmaAl()) < nsigmaTPCvar.nsigmaTPCAl)) {
             if (track.sign() > 0) {
-              histos.fill(HIST("tracks/alpha/dca/before/hDCAzVsPtAlpha"), track.pt(), track.dcaZ());
+              fillCost.fill(histos, HIST("tracks/alpha/dca/before/hDCAzVsPtAlpha"), track.pt(), track.dcaZ());
             } else {
-              histos.fill(HIST("tracks/alpha/dca/before/hDCAzVsPtantiAlpha"), track.pt(), track.dcaZ());
+              fillCost.fill(histos, HIST("tracks/alpha/dca/before/hDCAzVsPtantiAlpha"), track.pt(), track.dcaZ());
             }
           }
         }
 
         if (isDeWoDCAzWTPCpid) {
-          histos.fill(HIST("tracks/deuteron/dca/before/hDCAzVsPtDeuteron"), DPt, track.dcaZ());
+          fillCost.fill(histos, HIST("tracks/deuteron/dca/before/hDCAzVsPtDeuteron"), DPt, track.dcaZ());
           if (!track.hasTOF() && (outFlagOptions.enableNoTOFPlots))
-            histos.fill(HIST("tracks/deuteron/dca/before/hDCAzVsPtDeuteronNoTOF"), DPt, track.dcaZ());
+            fillCost.fill(histos, HIST("tracks/deuteron/dca/before/hDCAzVsPtDeuteronNoTOF"), DPt, track.dcaZ());
         }
 
         if (isAntiDeWoDCAzWTPCpid) {
-          histos.fill(HIST("tracks/deuteron/dca/before/hDCAzVsPtantiDeuteron"), antiDPt, track.dcaZ());
+          fillCost.fill(histos, HIST("tracks/deuteron/dca/before/hDCAzVsPtantiDeuteron"), antiDPt, track.dcaZ());
           if (!track.hasTOF() && (outFlagOptions.enableNoTOFPlots))
-            histos.fill(HIST("tracks/deuteron/dca/before/hDCAzVsPtantiDeuteronNoTOF"), antiDPt, track.dcaZ());
+            fillCost.fill(histos, HIST("tracks/deuteron/dca/before/hDCAzVsPtantiDeuteronNoTOF"), antiDPt, track.dcaZ());
         }
 
         if (isHeWoDCAzWTPCpid) {
-          histos.fill(HIST("tracks/helium/dca/before/hDCAzVsPtHelium"), hePt, track.dcaZ());
+          fillCost.fill(histos, HIST("tracks/helium/dca/before/hDCAzVsPtHelium"), hePt, track.dcaZ());
           if (!track.hasTOF() && (outFlagOptions.enableNoTOFPlots))
-            histos.fill(HIST("tracks/helium/dca/before/hDCAzVsPtHeliumNoTOF"), hePt, track.dcaZ());
+            fillCost.fill(histos, HIST("tracks/helium/dca/before/hDCAzVsPtHeliumNoTOF"), hePt, track.dcaZ());
           if (track.hasTOF() && outFlagOptions.doTOFplots) {
-            histos.fill(HIST("tracks/helium/dca/before/TOF/hDCAzVsPtHelium"), hePt, track.dcaZ());
+            fillCost.fill(histos, HIST("tracks/helium/dca/before/TOF/hDCAzVsPtHelium"), hePt, track.dcaZ());
           }
         }
 
         if (isAntiHeWoDCAzWTPCpid) {
-          histos.fill(HIST("tracks/helium/dca/before/hDCAzVsPtantiHelium"), antihePt, track.dcaZ());
+          fillCost.fill(histos, HIST("tracks/helium/dca/before/hDCAzVsPtantiHelium"), antihePt, track.dcaZ());
           if (!track.hasTOF() && (outFlagOptions.enableNoTOFPlots))
-            histos.fill(HIST("tracks/helium/dca/before/hDCAzVsPtantiHeliumNoTOF"), hePt, track.dcaZ());
+            fillCost.fill(histos, HIST("tracks/helium/dca/before/hDCAzVsPtantiHeliumNoTOF"), hePt, track.dcaZ());
           if (track.hasTOF() && outFlagOptions.doTOFplots) {
-            histos.fill(HIST("tracks/helium/dca/before/TOF/hDCAzVsPtantiHelium"), antihePt, track.dcaZ());
+            fillCost.fill(histos, HIST("tracks/helium/dca/before/TOF/hDCAzVsPtantiHelium"), antihePt, track.dcaZ());
           }
         }
       }
@@ -2918,27 +2924,27 @@ struct lfNucleiBATask {
           switch (pdgCode) {
             case PDGProton:
               if (enablePr && prRapCut && passDCAxyCut) {
-                histos.fill(HIST("tracks/proton/dca/before/hDCAzVsPtProtonTrue"), track.pt(), track.dcaZ());
+                fillCost.fill(histos, HIST("tracks/proton/dca/before/hDCAzVsPtProtonTrue"), track.pt(), track.dcaZ());
                 if (track.hasTOF() && outFlagOptions.doTOFplots) {
-                  histos.fill(HIST("tracks/proton/dca/before/TOF/hDCAzVsPtProtonTrue"), track.pt(), track.dcaZ());
+                  fillCost.fill(histos, HIST("tracks/proton/dca/before/TOF/hDCAzVsPtProtonTrue"), track.pt(), track.dcaZ());
                 }
                 if (isPhysPrim) {
-                  histos.fill(HIST("tracks/proton/dca/before/hDCAzVsPtProtonTruePrim"), track.pt(), track.dcaZ());
+                  fillCost.fill(histos, HIST("tracks/proton/dca/before/hDCAzVsPtProtonTruePrim"), track.pt(), track.dcaZ());
                   if (track.hasTOF() && outFlagOptions.doTOFplots) {
-                    histos.fill(HIST("tracks/proton/dca/before/TOF/hDCAzVsPtProtonTruePrim"), track.pt(), track.dcaZ());
+                    fillCost.fill(histos, HIST("tracks/proton/dca/before/TOF/hDCAzVsPtProtonTruePrim"), track.pt(), track.dcaZ());
                   }
                 }
                 if (!isPhysPrim && !isProdByGen) {
                   if (isWeakDecay) {
-                    histos.fill(HIST("tracks/proton/dca/before/hDCAzVsPtProtonTrueSec"), track.pt(), track.dcaZ());
+                    fillCost.fill(histos, HIST("tracks/proton/dca/before/hDCAzVsPtProtonTrueSec"), track.pt(), track.dcaZ());
                   } else {
-                    histos.fill(HIST("tracks/proton/dca/before/hDCAzVsPtProtonTrueMaterial"), track.pt(), track.dcaZ());
+                    fillCost.fill(histos, HIST("tracks/proton/dca/before/hDCAzVsPtProtonTrueMaterial"), track.pt(), track.dcaZ());
                   }
                   if (track.hasTOF() && outFlagOptions.doTOFplots) {
                     if (isWeakDecay) {
-                      histos.fill(HIST("tracks/proton/dca/before/TOF/hDCAzVsPtProtonTrueSec"), track.pt(), track.dcaZ());
+                      fillCost.fill(histos, HIST("tracks/proton/dca/before/TOF/hDCAzVsPtProtonTrueSec"), track.pt(), track.dcaZ());
                     } else {
-                      histos.fill(HIST("tracks/proton/dca/before/TOF/hDCAzVsPtProtonTrueMaterial"), track.pt(), track.dcaZ());
+                      fillCost.fill(histos, HIST("tracks/proton/dca/before/TOF/hDCAzVsPtProtonTrueMaterial"), track.pt(), track.dcaZ());
                     }
                   }
                 }
@@ -2946,27 +2952,27 @@ struct lfNucleiBATask {
               break;
             case -PDGProton:
               if (enablePr && prRapCut && passDCAxyCut) {
-                histos.fill(HIST("tracks/proton/dca/before/hDCAzVsPtantiProtonTrue"), track.pt(), track.dcaZ());
+                fillCost.fill(histos, HIST("tracks/proton/dca/before/hDCAzVsPtantiProtonTrue"), track.pt(), track.dcaZ());
                 if (track.hasTOF() && outFlagOptions.doTOFplots) {
-                  histos.fill(HIST("tracks/proton/dca/before/TOF/hDCAzVsPtantiProtonTrue"), track.pt(), track.dcaZ());
+                  fillCost.fill(histos, HIST("tracks/proton/dca/before/TOF/hDCAzVsPtantiProtonTrue"), track.pt(), track.dcaZ());
                 }
                 if (isPhysPrim) {
-                  histos.fill(HIST("tracks/proton/dca/before/hDCAzVsPtantiProtonTruePrim"), track.pt(), track.dcaZ());
+                  fillCost.fill(histos, HIST("tracks/proton/dca/before/hDCAzVsPtantiProtonTruePrim"), track.pt(), track.dcaZ());
                   if (track.hasTOF() && outFlagOptions.doTOFplots) {
-                    histos.fill(HIST("tracks/proton/dca/before/TOF/hDCAzVsPtantiProtonTruePrim"), track.pt(), track.dcaZ());
+                    fillCost.fill(histos, HIST("tracks/proton/dca/before/TOF/hDCAzVsPtantiProtonTruePrim"), track.pt(), track.dcaZ());
                   }
                 }
                 if (!isPhysPrim && !isProdByGen) {
                   if (isWeakDecay) {
-                    histos.fill(HIST("tracks/proton/dca/before/hDCAzVsPtantiProtonTrueSec"), track.pt(), track.dcaZ());
+                    fillCost.fill(histos, HIST("tracks/proton/dca/before/hDCAzVsPtantiProtonTrueSec"), track.pt(), track.dcaZ());
                   } else {
-                    histos.fill(HIST("tracks/proton/dca/before/hDCAzVsPtantiProtonTrueMaterial"), track.pt(), track.dcaZ());
+                    fillCost.fill(histos, HIST("tracks/proton/dca/before/hDCAzVsPtantiProtonTrueMaterial"), track.pt(), track.dcaZ());
                   }
                   if (track.hasTOF() && outFlagOptions.doTOFplots) {
                     if (isWeakDecay) {
-                      histos.fill(HIST("tracks/proton/dca/before/TOF/hDCAzVsPtantiProtonTrueSec"), hePt, track.dcaZ());
+                      fillCost.fill(histos, HIST("tracks/proton/dca/before/TOF/hDCAzVsPtantiProtonTrueSec"), hePt, track.dcaZ());
                     } else {
-                      histos.fill(HIST("tracks/proton/dca/before/TOF/hDCAzVsPtantiProtonTrueMaterial"), hePt, track.dcaZ());
+                      fillCost.fill(histos, HIST("tracks/proton/dca/before/TOF/hDCAzVsPtantiProtonTrueMaterial"), hePt, track.dcaZ());
                     }
                   }
                 }
@@ -2974,27 +2980,27 @@ struct lfNucleiBATask {
               break;
             case PDGDeuteron:
               if (isDeWoDCAz) {
-                histos.fill(HIST("tracks/deuteron/dca/before/hDCAzVsPtDeuteronTrue"), DPt, track.dcaZ());
+                fillCost.fill(histos, HIST("tracks/deuteron/dca/before/hDCAzVsPtDeuteronTrue"), DPt, track.dcaZ());
                 if (track.hasTOF() && outFlagOptions.doTOFplots) {
-                  histos.fill(HIST("tracks/deuteron/dca/before/TOF/hDCAzVsPtDeuteronTrue"), DPt, track.dcaZ());
+                  fillCost.fill(histos, HIST("tracks/deuteron/dca/before/TOF/hDCAzVsPtDeuteronTrue"), DPt, track.dcaZ());
                 }
                 if (isPhysPrim) {
-                  histos.fill(HIST("tracks/deuteron/dca/before/hDCAzVsPtDeuteronTruePrim"), DPt, track.dcaZ());
+                  fillCost.fill(histos, HIST("tracks/deuteron/dca/before/hDCAzVsPtDeuteronTruePrim"), DPt, track.dcaZ());
                   if (track.hasTOF() && outFlagOptions.doTOFplots) {
-                    histos.fill(HIST("tracks/deuteron/dca/before/TOF/hDCAzVsPtDeuteronTruePrim"), DPt, track.dcaZ());
+                    fillCost.fill(histos, HIST("tracks/deuteron/dca/before/TOF/hDCAzVsPtDeuteronTruePrim"), DPt, track.dcaZ());
                   }
                 }
                 if (!isPhysPrim && !isProdByGen) {
                   if (isWeakDecay) {
-                    histos.fill(HIST("tracks/deuteron/dca/before/hDCAzVsPtDeuteronTrueSec"), DPt, track.dcaZ());
+                    fillCost.fill(histos, HIST("tracks/deuteron/dca/before/hDCAzVsPtDeuteronTrueSec"), DPt, track.dcaZ());
                   } else {
-                    histos.fill(HIST("tracks/deuteron/dca/before/hDCAzVsPtDeuteronTrueMaterial"), DPt, track.dcaZ());
+                    fillCost.fill(histos, HIST("tracks/deuteron/dca/before/hDCAzVsPtDeuteronTrueMaterial"), DPt, track.dcaZ());
                   }
                   if (track.hasTOF() && outFlagOptions.doTOFplots) {
                     if (isWeakDecay) {
-                      histos.fill(HIST("tracks/deuteron/dca/before/TOF/hDCAzVsPtDeuteronTrueSec"), DPt, track.dcaZ());
+                      fillCost.fill(histos, HIST("tracks/deuteron/dca/before/TOF/hDCAzVsPtDeuteronTrueSec"), DPt, track.dcaZ());
                     } else {
-                      histos.fill(HIST("tracks/deuteron/dca/before/TOF/hDCAzVsPtDeuteronTrueMaterial"), DPt, track.dcaZ());
+                      fillCost.fill(histos, HIST("tracks/deuteron/dca/before/TOF/hDCAzVsPtDeuteronTrueMaterial"), DPt, track.dcaZ());
                     }
                   }
                 }
@@ -3002,27 +3008,27 @@ struct lfNucleiBATask {
               break;
             case -PDGDeuteron:
               if (isAntiDeWoDCAz) {
-                histos.fill(HIST("tracks/deuteron/dca/before/hDCAzVsPtantiDeuteronTrue"), antiDPt, track.dcaZ());
+                fillCost.fill(histos, HIST("tracks/deuteron/dca/before/hDCAzVsPtantiDeuteronTrue"), antiDPt, track.dcaZ());
                 if (track.hasTOF() && outFlagOptions.doTOFplots) {
-                  histos.fill(HIST("tracks/deuteron/dca/before/TOF/hDCAzVsPtantiDeuteronTrue"), antiDPt, track.dcaZ());
+                  fillCost.fill(histos, HIST("tracks/deuteron/dca/before/TOF/hDCAzVsPtantiDeuteronTrue"), antiDPt, track.dcaZ());
                 }
                 if (isPhysPrim) {
-                  histos.fill(HIST("tracks/deuteron/dca/before/hDCAzVsPtantiDeuteronTruePrim"), antiDPt, track.dcaZ());
+                  fillCost.fill(histos, HIST("tracks/deuteron/dca/before/hDCAzVsPtantiDeuteronTruePrim"), antiDPt, track.dcaZ());
                   if (track.hasTOF() && outFlagOptions.doTOFplots) {
-                    histos.fill(HIST("tracks/deuteron/dca/before/TOF/hDCAzVsPtantiDeuteronTruePrim"), antiDPt, track.dcaZ());
+                    fillCost.fill(histos, HIST("tracks/deuteron/dca/before/TOF/hDCAzVsPtantiDeuteronTruePrim"), antiDPt, track.dcaZ());
                   }
                 }
                 if (!isPhysPrim && !isProdByGen) {
                   if (isWeakDecay) {
-                    histos.fill(HIST("tracks/deuteron/dca/before/hDCAzVsPtantiDeuteronTrueSec"), antiDPt, track.dcaZ());
+                    fillCost.fill(histos, HIST("tracks/deuteron/dca/before/hDCAzVsPtantiDeuteronTrueSec"), antiDPt, track.dcaZ());
                   } else {
-                    histos.fill(HIST("tracks/deuteron/dca/before/hDCAzVsPtantiDeuteronTrueMaterial"), antiDPt, track.dcaZ());
+                    fillCost.fill(histos, HIST("tracks/deuteron/dca/before/hDCAzVsPtantiDeuteronTrueMaterial"), antiDPt, track.dcaZ());
                   }
                   if (track.hasTOF() && outFlagOptions.doTOFplots) {
                     if (isWeakDecay) {
-                      histos.fill(HIST("tracks/deuteron/dca/before/TOF/hDCAzVsPtantiDeuteronTrueSec"), antiDPt, track.dcaZ());
+                      fillCost.fill(histos, HIST("tracks/deuteron/dca/before/TOF/hDCAzVsPtantiDeuteronTrueSec"), antiDPt, track.dcaZ());
                     } else {
-                      histos.fill(HIST("tracks/deuteron/dca/before/TOF/hDCAzVsPtantiDeuteronTrueMaterial"), antiDPt, track.dcaZ());
+                      fillCost.fill(histos, HIST("tracks/deuteron/dca/before/TOF/hDCAzVsPtantiDeuteronTrueMaterial"), antiDPt, track.dcaZ());
                     }
                   }
                 }
@@ -3030,57 +3036,57 @@ struct lfNucleiBATask {
               break;
             case PDGTriton:
               if (enableTr && trRapCut && passDCAxyCut) {
-                histos.fill(HIST("tracks/triton/dca/before/hDCAzVsPtTritonTrue"), track.pt(), track.dcaZ());
+                fillCost.fill(histos, HIST("tracks/triton/dca/before/hDCAzVsPtTritonTrue"), track.pt(), track.dcaZ());
                 if (isPhysPrim) {
-                  histos.fill(HIST("tracks/triton/dca/before/hDCAzVsPtTritonTruePrim"), track.pt(), track.dcaZ());
+                  fillCost.fill(histos, HIST("tracks/triton/dca/before/hDCAzVsPtTritonTruePrim"), track.pt(), track.dcaZ());
                 }
                 if (!isPhysPrim && !isProdByGen) {
                   if (isWeakDecay) {
-                    histos.fill(HIST("tracks/triton/dca/before/hDCAzVsPtTritonTrueSec"), track.pt(), track.dcaZ());
+                    fillCost.fill(histos, HIST("tracks/triton/dca/before/hDCAzVsPtTritonTrueSec"), track.pt(), track.dcaZ());
                   } else {
-                    histos.fill(HIST("tracks/triton/dca/before/hDCAzVsPtTritonTrueMaterial"), track.pt(), track.dcaZ());
+                    fillCost.fill(histos, HIST("tracks/triton/dca/before/hDCAzVsPtTritonTrueMaterial"), track.pt(), track.dcaZ());
                   }
                 }
               }
               break;
             case -PDGTriton:
               if (enableTr && trRapCut && passDCAxyCut) {
-                histos.fill(HIST("tracks/triton/dca/before/hDCAzVsPtantiTritonTrue"), track.pt(), track.dcaZ());
+                fillCost.fill(histos, HIST("tracks/triton/dca/before/hDCAzVsPtantiTritonTrue"), track.pt(), track.dcaZ());
                 if (isPhysPrim) {
-                  histos.fill(HIST("tracks/triton/dca/before/hDCAzVsPtantiTritonTruePrim"), track.pt(), track.dcaZ());
+                  fillCost.fill(histos, HIST("tracks/triton/dca/before/hDCAzVsPtantiTritonTruePrim"), track.pt(), track.dcaZ());
                 }
                 if (!isPhysPrim && !isProdByGen) {
                   if (isWeakDecay) {
-                    histos.fill(HIST("tracks/triton/dca/before/hDCAzVsPtantiTritonTrueSec"), track.pt(), track.dcaZ());
+                    fillCost.fill(histos, HIST("tracks/triton/dca/before/hDCAzVsPtantiTritonTrueSec"), track.pt(), track.dcaZ());
                   } else {
-                    histos.fill(HIST("tracks/triton/dca/before/hDCAzVsPtantiTritonTrueMaterial"), track.pt(), track.dcaZ());
+                    fillCost.fill(histos, HIST("tracks/triton/dca/before/hDCAzVsPtantiTritonTrueMaterial"), track.pt(), track.dcaZ());
                   }
                 }
               }
               break;
             case PDGHelium:
               if (isHeWoDCAz) {
-                histos.fill(HIST("tracks/helium/dca/before/hDCAzVsPtHeliumTrue"), hePt, track.dcaZ());
+                fillCost.fill(histos, HIST("tracks/helium/dca/before/hDCAzVsPtHeliumTrue"), hePt, track.dcaZ());
                 if (track.hasTOF() && outFlagOptions.doTOFplots) {
-                  histos.fill(HIST("tracks/helium/dca/before/TOF/hDCAzVsPtHeliumTrue"), hePt, track.dcaZ());
+                  fillCost.fill(histos, HIST("tracks/helium/dca/before/TOF/hDCAzVsPtHeliumTrue"), hePt, track.dcaZ());
                 }
                 if (isPhysPrim) {
-                  histos.fill(HIST("tracks/helium/dca/before/hDCAzVsPtHeliumTruePrim"), hePt, track.dcaZ());
+                  fillCost.fill(histos, HIST("tracks/helium/dca/before/hDCAzVsPtHeliumTruePrim"), hePt, track.dcaZ());
                   if (track.hasTOF() && outFlagOptions.doTOFplots) {
-                    histos.fill(HIST("tracks/helium/dca/before/TOF/hDCAzVsPtHeliumTruePrim"), hePt, track.dcaZ());
+                    fillCost.fill(histos, HIST("tracks/helium/dca/before/TOF/hDCAzVsPtHeliumTruePrim"), hePt, track.dcaZ());
                   }
                 }
                 if (!isPhysPrim && !isProdByGen) {
                   if (isWeakDecay) {
-                    histos.fill(HIST("tracks/helium/dca/before/hDCAzVsPtHeliumTrueSec"), hePt, track.dcaZ());
+                    fillCost.fill(histos, HIST("tracks/helium/dca/before/hDCAzVsPtHeliumTrueSec"), hePt, track.dcaZ());
                   } else {
-                    histos.fill(HIST("tracks/helium/dca/before/hDCAzVsPtHeliumTrueMaterial"), hePt, track.dcaZ());
+                    fillCost.fill(histos, HIST("tracks/helium/dca/before/hDCAzVsPtHeliumTrueMaterial"), hePt, track.dcaZ());
                   }
                   if (track.hasTOF() && outFlagOptions.doTOFplots) {
                     if (isWeakDecay) {
-                      histos.fill(HIST("tracks/helium/dca/before/TOF/hDCAzVsPtHeliumTrueSec"), hePt, track.dcaZ());
+                      fillCost.fill(histos, HIST("tracks/helium/dca/before/TOF/hDCAzVsPtHeliumTrueSec"), hePt, track.dcaZ());
                     } else {
-                      histos.fill(HIST("tracks/helium/dca/before/TOF/hDCAzVsPtHeliumTrueMaterial"), hePt, track.dcaZ());
+                      fillCost.fill(histos, HIST("tracks/helium/dca/before/TOF/hDCAzVsPtHeliumTrueMaterial"), hePt, track.dcaZ());
                     }
                   }
                 }
@@ -3088,25 +3094,25 @@ struct lfNucleiBATask {
               if constexpr (!IsFilteredData) {
                 if ((event.has_mcCollision() && (track.mcParticle().mcCollisionId() != event.mcCollisionId())) || !event.has_mcCollision()) {
                   if (isHeWoDCAz && outFlagOptions.makeWrongEventPlots) {
-                    histos.fill(HIST("tracks/helium/dca/before/wrong/hDCAzVsPtHeliumTrue"), hePt, track.dcaZ());
+                    fillCost.fill(histos, HIST("tracks/helium/dca/before/wrong/hDCAzVsPtHeliumTrue"), hePt, track.dcaZ());
                     if (track.hasTOF() && outFlagOptions.doTOFplots) {
-                      histos.fill(HIST("tracks/helium/dca/before/wrong/TOF/hDCAzVsPtHeliumTrue"), hePt, track.dcaZ());
+                      fillCost.fill(histos, HIST("tracks/helium/dca/before/wrong/TOF/hDCAzVsPtHeliumTrue"), hePt, track.dcaZ());
                     }
                     if (isPhysPrim) {
-                      histos.fill(HIST("tracks/helium/dca/before/wrong/hDCAzVsPtHeliumTruePrim"), hePt, track.dcaZ());
+                      fillCost.fill(histos, HIST("tracks/helium/dca/before/wrong/hDCAzVsPtHeliumTruePrim"), hePt, track.dcaZ());
                       if (track.hasTOF() && outFlagOptions.doTOFplots) {
-                        histos.fill(HIST("tracks/helium/dca/before/wrong/TOF/hDCAzVsPtHeliumTruePrim"), hePt, track.dcaZ());
+                        fillCost.fill(histos, HIST("tracks/helium/dca/before/wrong/TOF/hDCAzVsPtHeliumTruePrim"), hePt, track.dcaZ());
                       }
                     }
                     if (!isPhysPrim && !isProdByGen) {
-                      histos.fill(HIST("tracks/helium/dca/before/wrong/hDCAzVsPtHeliumTrueTransport"), hePt, track.dcaZ());
+                      fillCost.fill(histos, HIST("tracks/helium/dca/before/wrong/hDCAzVsPtHeliumTrueTransport"), hePt, track.dcaZ());
                       if (isWeakDecay) {
-                        histos.fill(HIST("tracks/helium/dca/before/wrong/hDCAzVsPtHeliumTrueSec"), hePt, track.dcaZ());
+                        fillCost.fill(histos, HIST("tracks/helium/dca/before/wrong/hDCAzVsPtHeliumTrueSec"), hePt, track.dcaZ());
                       }
                       if (track.hasTOF() && outFlagOptions.doTOFplots) {
-                        histos.fill(HIST("tracks/helium/dca/before/wrong/TOF/hDCAzVsPtHeliumTrueTransport"), hePt, track.dcaZ());
+                        fillCost.fill(histos, HIST("tracks/helium/dca/before/wrong/TOF/hDCAzVsPtHeliumTrueTransport"), hePt, track.dcaZ());
                         if (isWeakDecay) {
-                          histos.fill(HIST("tracks/helium/dca/before/wrong/TOF/hDCAzVsPtHeliumTrueSec"), hePt, track.dcaZ());
+                          fillCost.fill(histos, HIST("tracks/helium/dca/before/wrong/TOF/hDCAzVsPtHeliumTrueSec"), hePt, track.dcaZ());
                         }
                       }
                     }
@@ -3116,27 +3122,27 @@ struct lfNucleiBATask {
               break;
             case -PDGHelium:
               if (isAntiHeWoDCAz) {
-                histos.fill(HIST("tracks/helium/dca/before/hDCAzVsPtantiHeliumTrue"), antihePt, track.dcaZ());
+                fillCost.fill(histos, HIST("tracks/helium/dca/before/hDCAzVsPtantiHeliumTrue"), antihePt, track.dcaZ());
                 if (track.hasTOF() && outFlagOptions.doTOFplots) {
-                  histos.fill(HIST("tracks/helium/dca/before/TOF/hDCAzVsPtantiHeliumTrue"), antihePt, track.dcaZ());
+                  fillCost.fill(histos, HIST("tracks/helium/dca/before/TOF/hDCAzVsPtantiHeliumTrue"), antihePt, track.dcaZ());
                 }
                 if (isPhysPrim) {
-                  histos.fill(HIST("tracks/helium/dca/before/hDCAzVsPtantiHeliumTruePrim"), antihePt, track.dcaZ());
+                  fillCost.fill(histos, HIST("tracks/helium/dca/before/hDCAzVsPtantiHeliumTruePrim"), antihePt, track.dcaZ());
                   if (track.hasTOF() && outFlagOptions.doTOFplots) {
-                    histos.fill(HIST("tracks/helium/dca/before/TOF/hDCAzVsPtantiHeliumTruePrim"), antihePt, track.dcaZ());
+                    fillCost.fill(histos, HIST("tracks/helium/dca/before/TOF/hDCAzVsPtantiHeliumTruePrim"), antihePt, track.dcaZ());
                   }
                 }
                 if (!isPhysPrim && !isProdByGen) {
                   if (isWeakDecay) {
-                    histos.fill(HIST("tracks/helium/dca/before/hDCAzVsPtantiHeliumTrueSec"), antihePt, track.dcaZ());
+                    fillCost.fill(histos, HIST("tracks/helium/dca/before/hDCAzVsPtantiHeliumTrueSec"), antihePt, track.dcaZ());
                   } else {
-                    histos.fill(HIST("tracks/helium/dca/before/hDCAzVsPtantiHeliumTrueMaterial"), antihePt, track.dcaZ());
+                    fillCost.fill(histos, HIST("tracks/helium/dca/before/hDCAzVsPtantiHeliumTrueMaterial"), antihePt, track.dcaZ());
                   }
                   if (track.hasTOF() && outFlagOptions.doTOFplots) {
                     if (isWeakDecay) {
-                      histos.fill(HIST("tracks/helium/dca/before/TOF/hDCAzVsPtantiHeliumTrueSec"), antihePt, track.dcaZ());
+                      fillCost.fill(histos, HIST("tracks/helium/dca/before/TOF/hDCAzVsPtantiHeliumTrueSec"), antihePt, track.dcaZ());
                     } else {
-                      histos.fill(HIST("tracks/helium/dca/before/TOF/hDCAzVsPtantiHeliumTrueMaterial"), antihePt, track.dcaZ());
+                      fillCost.fill(histos, HIST("tracks/helium/dca/before/TOF/hDCAzVsPtantiHeliumTrueMaterial"), antihePt, track.dcaZ());
                     }
                   }
                 }
@@ -3144,25 +3150,25 @@ struct lfNucleiBATask {
               if constexpr (!IsFilteredData) {
                 if ((event.has_mcCollision() && (track.mcParticle().mcCollisionId() != event.mcCollisionId())) || !event.has_mcCollision()) {
                   if (isAntiHeWoDCAz && outFlagOptions.makeWrongEventPlots) {
-                    histos.fill(HIST("tracks/helium/dca/before/wrong/hDCAzVsPtantiHeliumTrue"), antihePt, track.dcaZ());
+                    fillCost.fill(histos, HIST("tracks/helium/dca/before/wrong/hDCAzVsPtantiHeliumTrue"), antihePt, track.dcaZ());
                     if (track.hasTOF() && outFlagOptions.doTOFplots) {
-                      histos.fill(HIST("tracks/helium/dca/before/wrong/TOF/hDCAzVsPtantiHeliumTrue"), antihePt, track.dcaZ());
+                      fillCost.fill(histos, HIST("tracks/helium/dca/before/wrong/TOF/hDCAzVsPtantiHeliumTrue"), antihePt, track.dcaZ());
                     }
                     if (isPhysPrim) {
-                      histos.fill(HIST("tracks/helium/dca/before/wrong/hDCAzVsPtantiHeliumTruePrim"), antihePt, track.dcaZ());
+                      fillCost.fill(histos, HIST("tracks/helium/dca/before/wrong/hDCAzVsPtantiHeliumTruePrim"), antihePt, track.dcaZ());
                       if (track.hasTOF() && outFlagOptions.doTOFplots) {
-                        histos.fill(HIST("tracks/helium/dca/before/wrong/TOF/hDCAzVsPtantiHeliumTruePrim"), antihePt, track.dcaZ());
+                        fillCost.fill(histos, HIST("tracks/helium/dca/before/wrong/TOF/hDCAzVsPtantiHeliumTruePrim"), antihePt, track.dcaZ());
                       }
                     }
                     if (!isPhysPrim && !isProdByGen) {
-                      histos.fill(HIST("tracks/helium/dca/before/wrong/hDCAzVsPtantiHeliumTrueTransport"), antihePt, track.dcaZ());
+                      fillCost.fill(histos, HIST("tracks/helium/dca/before/wrong/hDCAzVsPtantiHeliumTrueTransport"), antihePt, track.dcaZ());
                       if (isWeakDecay) {
-                        histos.fill(HIST("tracks/helium/dca/before/wrong/hDCAzVsPtantiHeliumTrueSec"), antihePt, track.dcaZ());
+                        fillCost.fill(histos, HIST("tracks/helium/dca/before/wrong/hDCAzVsPtantiHeliumTrueSec"), antihePt, track.dcaZ());
                       }
                       if (track.hasTOF() && outFlagOptions.doTOFplots) {
-                        histos.fill(HIST("tracks/helium/dca/before/wrong/TOF/hDCAzVsPtantiHeliumTrueTransport"), antihePt, track.dcaZ());
+                        fillCost.fill(histos, HIST("tracks/helium/dca/before/wrong/TOF/hDCAzVsPtantiHeliumTrueTransport"), antihePt, track.dcaZ());
                         if (isWeakDecay) {
-                          histos.fill(HIST("tracks/helium/dca/before/wrong/TOF/hDCAzVsPtantiHeliumTrueSec"), antihePt, track.dcaZ());
+                          fillCost.fill(histos, HIST("tracks/helium/dca/before/wrong/TOF/hDCAzVsPtantiHeliumTrueSec"), antihePt, track.dcaZ());
                         }
                       }
                     }
@@ -3172,30 +3178,30 @@ struct lfNucleiBATask {
               break;
             case PDGAlpha:
               if (enableAl && alRapCut && passDCAxyCut) {
-                histos.fill(HIST("tracks/alpha/dca/before/hDCAzVsPtAlphaTrue"), track.pt(), track.dcaZ());
+                fillCost.fill(histos, HIST("tracks/alpha/dca/before/hDCAzVsPtAlphaTrue"), track.pt(), track.dcaZ());
                 if (isPhysPrim) {
-                  histos.fill(HIST("tracks/alpha/dca/before/hDCAzVsPtAlphaTruePrim"), track.pt(), track.dcaZ());
+                  fillCost.fill(histos, HIST("tracks/alpha/dca/before/hDCAzVsPtAlphaTruePrim"), track.pt(), track.dcaZ());
                 }
                 if (!isPhysPrim && !isProdByGen) {
                   if (isWeakDecay) {
-                    histos.fill(HIST("tracks/alpha/dca/before/hDCAzVsPtAlphaTrueSec"), track.pt(), track.dcaZ());
+                    fillCost.fill(histos, HIST("tracks/alpha/dca/before/hDCAzVsPtAlphaTrueSec"), track.pt(), track.dcaZ());
                   } else {
-                    histos.fill(HIST("tracks/alpha/dca/before/hDCAzVsPtAlphaTrueMaterial"), track.pt(), track.dcaZ());
+                    fillCost.fill(histos, HIST("tracks/alpha/dca/before/hDCAzVsPtAlphaTrueMaterial"), track.pt(), track.dcaZ());
                   }
                 }
               }
               break;
             case -PDGAlpha:
               if (enableAl && alRapCut && passDCAxyCut) {
-                histos.fill(HIST("tracks/alpha/dca/before/hDCAzVsPtantiAlphaTrue"), track.pt(), track.dcaZ());
+                fillCost.fill(histos, HIST("tracks/alpha/dca/before/hDCAzVsPtantiAlphaTrue"), track.pt(), track.dcaZ());
                 if (isPhysPrim) {
-                  histos.fill(HIST("tracks/alpha/dca/before/hDCAzVsPtantiAlphaTruePrim"), track.pt(), track.dcaZ());
+                  fillCost.fill(histos, HIST("tracks/alpha/dca/before/hDCAzVsPtantiAlphaTruePrim"), track.pt(), track.dcaZ());
                 }
                 if (!isPhysPrim && !isProdByGen) {
                   if (isWeakDecay) {
-                    histos.fill(HIST("tracks/alpha/dca/before/hDCAzVsPtantiAlphaTrueSec"), track.pt(), track.dcaZ());
+                    fillCost.fill(histos, HIST("tracks/alpha/dca/before/hDCAzVsPtantiAlphaTrueSec"), track.pt(), track.dcaZ());
                   } else {
-                    histos.fill(HIST("tracks/alpha/dca/before/hDCAzVsPtantiAlphaTrueMaterial"), track.pt(), track.dcaZ());
+                    fillCost.fill(histos, HIST("tracks/alpha/dca/before/hDCAzVsPtantiAlphaTrueMaterial"), track.pt(), track.dcaZ());
                   }
                 }
               }
@@ -3209,48 +3215,48 @@ struct lfNucleiBATask {
               break;
             default:
               if (isDeWoDCAzWTPCpid && outFlagOptions.makeFakeTracksPlots) {
-                histos.fill(HIST("tracks/deuteron/dca/before/fake/hDCAzVsPtDeuteronTrue"), DPt, track.dcaZ());
+                fillCost.fill(histos, HIST("tracks/deuteron/dca/before/fake/hDCAzVsPtDeuteronTrue"), DPt, track.dcaZ());
                 if (track.hasTOF() && outFlagOptions.doTOFplots) {
-                  histos.fill(HIST("tracks/deuteron/dca/before/fake/TOF/hDCAzVsPtDeuteronTrue"), DPt, track.dcaZ());
+                  fillCost.fill(histos, HIST("tracks/deuteron/dca/before/fake/TOF/hDCAzVsPtDeuteronTrue"), DPt, track.dcaZ());
                 }
                 if (isPhysPrim) {
-                  histos.fill(HIST("tracks/deuteron/dca/before/fake/hDCAzVsPtDeuteronTruePrim"), DPt, track.dcaZ());
+                  fillCost.fill(histos, HIST("tracks/deuteron/dca/before/fake/hDCAzVsPtDeuteronTruePrim"), DPt, track.dcaZ());
                   if (track.hasTOF() && outFlagOptions.doTOFplots) {
-                    histos.fill(HIST("tracks/deuteron/dca/before/fake/TOF/hDCAzVsPtDeuteronTruePrim"), DPt, track.dcaZ());
+                    fillCost.fill(histos, HIST("tracks/deuteron/dca/before/fake/TOF/hDCAzVsPtDeuteronTruePrim"), DPt, track.dcaZ());
                   }
                 }
                 if (!isPhysPrim && !isProdByGen) {
-                  histos.fill(HIST("tracks/deuteron/dca/before/fake/hDCAzVsPtDeuteronTrueTransport"), DPt, track.dcaZ());
+                  fillCost.fill(histos, HIST("tracks/deuteron/dca/before/fake/hDCAzVsPtDeuteronTrueTransport"), DPt, track.dcaZ());
                   if (isWeakDecay) {
-                    histos.fill(HIST("tracks/deuteron/dca/before/fake/hDCAzVsPtDeuteronTrueSec"), DPt, track.dcaZ());
+                    fillCost.fill(histos, HIST("tracks/deuteron/dca/before/fake/hDCAzVsPtDeuteronTrueSec"), DPt, track.dcaZ());
                   }
                   if (track.hasTOF() && outFlagOptions.doTOFplots) {
-                    histos.fill(HIST("tracks/deuteron/dca/before/fake/TOF/hDCAzVsPtDeuteronTrueTransport"), DPt, track.dcaZ());
+                    fillCost.fill(histos, HIST("tracks/deuteron/dca/before/fake/TOF/hDCAzVsPtDeuteronTrueTransport"), DPt, track.dcaZ());
                     if (isWeakDecay) {
-                      histos.fill(HIST("tracks/deuteron/dca/before/fake/TOF/hDCAzVsPtDeuteronTrueSec"), DPt, track.dcaZ());
+                      fillCost.fill(histos, HIST("tracks/deuteron/dca/before/fake/TOF/hDCAzVsPtDeuteronTrueSec"), DPt, track.dcaZ());
                     }
                   }
                 }
               } else if (isAntiDeWoDCAzWTPCpid && outFlagOptions.makeFakeTracksPlots) {
-                histos.fill(HIST("tracks/deuteron/dca/before/fake/hDCAzVsPtantiDeuteronTrue"), antiDPt, track.dcaZ());
+                fillCost.fill(histos, HIST("tracks/deuteron/dca/before/fake/hDCAzVsPtantiDeuteronTrue"), antiDPt, track.dcaZ());
                 if (track.hasTOF() && outFlagOptions.doTOFplots) {
-                  histos.fill(HIST("tracks/deuteron/dca/before/fake/TOF/hDCAzVsPtantiDeuteronTrue"), antiDPt, track.dcaZ());
+                  fillCost.fill(histos, HIST("tracks/deuteron/dca/before/fake/TOF/hDCAzVsPtantiDeuteronTrue"), antiDPt, track.dcaZ());
                 }
                 if (isPhysPrim) {
-                  histos.fill(HIST("tracks/deuteron/dca/before/fake/hDCAzVsPtantiDeuteronTruePrim"), antiDPt, track.dcaZ());
+                  fillCost.fill(histos, HIST("tracks/deuteron/dca/before/fake/hDCAzVsPtantiDeuteronTruePrim"), antiDPt, track.dcaZ());
                   if (track.hasTOF() && outFlagOptions.doTOFplots) {
-                    histos.fill(HIST("tracks/deuteron/dca/before/fake/TOF/hDCAzVsPtantiDeuteronTruePrim"), antiDPt, track.dcaZ());
+                    fillCost.fill(histos, HIST("tracks/deuteron/dca/before/fake/TOF/hDCAzVsPtantiDeuteronTruePrim"), antiDPt, track.dcaZ());
                   }
                 }
                 if (!isPhysPrim && !isProdByGen) {
-                  histos.fill(HIST("tracks/deuteron/dca/before/fake/hDCAzVsPtantiDeuteronTrueTransport"), antiDPt, track.dcaZ());
+                  fillCost.fill(histos, HIST("tracks/deuteron/dca/before/fake/hDCAzVsPtantiDeuteronTrueTransport"), antiDPt, track.dcaZ());
                   if (isWeakDecay) {
-                    histos.fill(HIST("tracks/deuteron/dca/before/fake/hDCAzVsPtantiDeuteronTrueSec"), antiDPt, track.dcaZ());
+                    fillCost.fill(histos, HIST("tracks/deuteron/dca/before/fake/hDCAzVsPtantiDeuteronTrueSec"), antiDPt, track.dcaZ());
                   }
                   if (track.hasTOF() && outFlagOptions.doTOFplots) {
-                    histos.fill(HIST("tracks/deuteron/dca/before/fake/TOF/hDCAzVsPtantiDeuteronTrueTransport"), antiDPt, track.dcaZ());
+                    fillCost.fill(histos, HIST("tracks/deuteron/dca/before/fake/TOF/hDCAzVsPtantiDeuteronTrueTransport"), antiDPt, track.dcaZ());
                     if (isWeakDecay) {
-                      histos.fill(HIST("tracks/deuteron/dca/before/fake/TOF/hDCAzVsPtantiDeuteronTrueSec"), antiDPt, track.dcaZ());
+                      fillCost.fill(histos, HIST("tracks/deuteron/dca/before/fake/TOF/hDCAzVsPtantiDeuteronTrueSec"), antiDPt, track.dcaZ());
                     }
                   }
                 }
@@ -3264,49 +3270,49 @@ struct lfNucleiBATask {
               break;
             default:
               if (isHeWoDCAzWTPCpid && outFlagOptions.makeFakeTracksPlots) {
-                histos.fill(HIST("tracks/helium/dca/before/fake/hDCAzVsPtHeliumTrue"), hePt, track.dcaZ());
+                fillCost.fill(histos, HIST("tracks/helium/dca/before/fake/hDCAzVsPtHeliumTrue"), hePt, track.dcaZ());
                 if (track.hasTOF() && outFlagOptions.doTOFplots) {
-                  histos.fill(HIST("tracks/helium/dca/before/fake/TOF/hDCAzVsPtHeliumTrue"), hePt, track.dcaZ());
+                  fillCost.fill(histos, HIST("tracks/helium/dca/before/fake/TOF/hDCAzVsPtHeliumTrue"), hePt, track.dcaZ());
                 }
                 if (isPhysPrim) {
-                  histos.fill(HIST("tracks/helium/dca/before/fake/hDCAzVsPtHeliumTruePrim"), hePt, track.dcaZ());
+                  fillCost.fill(histos, HIST("tracks/helium/dca/before/fake/hDCAzVsPtHeliumTruePrim"), hePt, track.dcaZ());
                   if (track.hasTOF() && outFlagOptions.doTOFplots) {
-                    histos.fill(HIST("tracks/helium/dca/before/fake/TOF/hDCAzVsPtHeliumTruePrim"), hePt, track.dcaZ());
+                    fillCost.fill(histos, HIST("tracks/helium/dca/before/fake/TOF/hDCAzVsPtHeliumTruePrim"), hePt, track.dcaZ());
                   }
                 }
                 if (!isPhysPrim && !isProdByGen) {
-                  histos.fill(HIST("tracks/helium/dca/before/fake/hDCAzVsPtHeliumTrueTransport"), hePt, track.dcaZ());
+                  fillCost.fill(histos, HIST("tracks/helium/dca/before/fake/hDCAzVsPtHeliumTrueTransport"), hePt, track.dcaZ());
                   if (isWeakDecay) {
-                    histos.fill(HIST("tracks/helium/dca/before/fake/hDCAzVsPtHeliumTrueSec"), hePt, track.dcaZ());
+                    fillCost.fill(histos, HIST("tracks/helium/dca/before/fake/hDCAzVsPtHeliumTrueSec"), hePt, track.dcaZ());
                   }
                   if (track.hasTOF() && outFlagOptions.doTOFplots) {
-                    histos.fill(HIST("tracks/helium/dca/before/fake/TOF/hDCAzVsPtHeliumTrueTransport"), hePt, track.dcaZ());
+                    fillCost.fill(histos, HIST("tracks/helium/dca/before/fake/TOF/hDCAzVsPtHeliumTrueTransport"), hePt, track.dcaZ());
                     if (isWeakDecay) {
-                      histos.fill(HIST("tracks/helium/dca/before/fake/TOF/hDCAzVsPtHeliumTrueSec"), hePt, track.dcaZ());
+                      fillCost.fill(histos, HIST("tracks/helium/dca/before/fake/TOF/hDCAzVsPtHeliumTrueSec"), hePt, track.dcaZ());
                     }
                   }
                 }
               }
               if (isAntiHeWoDCAzWTPCpid && outFlagOptions.makeFakeTracksPlots) {
-                histos.fill(HIST("tracks/helium/dca/before/fake/hDCAzVsPtantiHeliumTrue"), antihePt, track.dcaZ());
+                fillCost.fill(histos, HIST("tracks/helium/dca/before/fake/hDCAzVsPtantiHeliumTrue"), antihePt, track.dcaZ());
                 if (track.hasTOF() && outFlagOptions.doTOFplots) {
-                  histos.fill(HIST("tracks/helium/dca/before/fake/TOF/hDCAzVsPtantiHeliumTrue"), antihePt, track.dcaZ());
+                  fillCost.fill(histos, HIST("tracks/helium/dca/before/fake/TOF/hDCAzVsPtantiHeliumTrue"), antihePt, track.dcaZ());
                 }
                 if (isPhysPrim) {
-                  histos.fill(HIST("tracks/helium/dca/before/fake/hDCAzVsPtantiHeliumTruePrim"), antihePt, track.dcaZ());
+                  fillCost.fill(histos, HIST("tracks/helium/dca/before/fake/hDCAzVsPtantiHeliumTruePrim"), antihePt, track.dcaZ());
                   if (track.hasTOF() && outFlagOptions.doTOFplots) {
-                    histos.fill(HIST("tracks/helium/dca/before/fake/TOF/hDCAzVsPtantiHeliumTruePrim"), antihePt, track.dcaZ());
+                    fillCost.fill(histos, HIST("tracks/helium/dca/before/fake/TOF/hDCAzVsPtantiHeliumTruePrim"), antihePt, track.dcaZ());
                   }
                 }
                 if (!isPhysPrim && !isProdByGen) {
-                  histos.fill(HIST("tracks/helium/dca/before/fake/hDCAzVsPtantiHeliumTrueTransport"), antihePt, track.dcaZ());
+                  fillCost.fill(histos, HIST("tracks/helium/dca/before/fake/hDCAzVsPtantiHeliumTrueTransport"), antihePt, track.dcaZ());
                   if (isWeakDecay) {
-                    histos.fill(HIST("tracks/helium/dca/before/fake/hDCAzVsPtantiHeliumTrueSec"), antihePt, track.dcaZ());
+                    fillCost.fill(histos, HIST("tracks/helium/dca/before/fake/hDCAzVsPtantiHeliumTrueSec"), antihePt, track.dcaZ());
                   }
                   if (track.hasTOF() && outFlagOptions.doTOFplots) {
-                    histos.fill(HIST("tracks/helium/dca/before/fake/TOF/hDCAzVsPtantiHeliumTrueTransport"), antihePt, track.dcaZ());
+                    fillCost.fill(histos, HIST("tracks/helium/dca/before/fake/TOF/hDCAzVsPtantiHeliumTrueTransport"), antihePt, track.dcaZ());
                     if (isWeakDecay) {
-                      histos.fill(HIST("tracks/helium/dca/before/fake/TOF/hDCAzVsPtantiHeliumTrueSec"), antihePt, track.dcaZ());
+                      fillCost.fill(histos, HIST("tracks/helium/dca/before/fake/TOF/hDCAzVsPtantiHeliumTrueSec"), antihePt, track.dcaZ());
                     }
                   }
                 }
@@ -3320,14 +3326,14 @@ struct lfNucleiBATask {
       // Tracks DCA histos fill
       if (outFlagOptions.makeDCABeforeCutPlots) {
         if (passDCAzCut) {
-          histos.fill(HIST("tracks/dca/before/hDCAxyVsPt"), track.pt(), track.dcaXY());
+          fillCost.fill(histos, HIST("tracks/dca/before/hDCAxyVsPt"), track.pt(), track.dcaXY());
 
           if (enablePr && prRapCut) {
             if (std::abs(track.tpcNSigmaPr()) < nsigmaTPCvar.nsigmaTPCPr) {
               if (track.sign() > 0) {
-                histos.fill(HIST("tracks/proton/dca/before/hDCAxyVsPtProton"), track.pt(), track.dcaXY());
+                fillCost.fill(histos, HIST("tracks/proton/dca/before/hDCAxyVsPtProton"), track.pt(), track.dcaXY());
               } else {
-                histos.fill(HIST("tracks/proton/dca/before/hDCAxyVsPtantiProton"), track.pt(), track.dcaXY());
+                fillCost.fill(histos, HIST("tracks/proton/dca/before/hDCAxyVsPtantiProton"), track.pt(), track.dcaXY());
               }
             }
           }
@@ -3335,18 +3341,18 @@ struct lfNucleiBATask {
           if (enableTr && trRapCut) {
             if (isTritonTPCpid) {
               if (track.sign() > 0) {
-                histos.fill(HIST("tracks/triton/dca/before/hDCAxyVsPtTriton"), track.pt(), track.dcaXY());
+                fillCost.fill(histos, HIST("tracks/triton/dca/before/hDCAxyVsPtTriton"), track.pt(), track.dcaXY());
               } else {
-                histos.fill(HIST("tracks/triton/dca/before/hDCAxyVsPtantiTriton"), track.pt(), track.dcaXY());
+                fillCost.fill(histos, HIST("tracks/triton/dca/before/hDCAxyVsPtantiTriton"), track.pt(), track.dcaXY());
               }
             }
           }
           if (enableAl && alRapCut) {
             if (std::abs(track.tpcNSigmaAl()) < nsigmaTPCvar.nsigmaTPCAl) {
               if (track.sign() > 0) {
-                histos.fill(HIST("tracks/alpha/dca/before/hDCAxyVsPtAlpha"), track.pt(), track.dcaXY());
+                fillCost.fill(histos, HIST("tracks/alpha/dca/before/hDCAxyVsPtAlpha"), track.pt(), track.dcaXY());
               } else {
-                histos.fill(HIST("tracks/alpha/dca/before/hDCAxyVsPtantiAlpha"), track.pt(), track.dcaXY());
+                fillCost.fill(histos, HIST("tracks/alpha/dca/before/hDCAxyVsPtantiAlpha"), track.pt(), track.dcaXY());
               }
             }
           }
@@ -3356,37 +3362,37 @@ struct lfNucleiBATask {
           if (usenITSLayer && !itsClusterMap.test(trkqcOptions.nITSLayer))
             continue;
           if (enableCentrality)
-            histos.fill(HIST("tracks/deuteron/dca/before/hDCAxyVsPtDeuteronVsMult"), DPt, track.dcaXY(), centFT0M);
+            fillCost.fill(histos, HIST("tracks/deuteron/dca/before/hDCAxyVsPtDeuteronVsMult"), DPt, track.dcaXY(), centFT0M);
           else
-            histos.fill(HIST("tracks/deuteron/dca/before/hDCAxyVsPtDeuteron"), DPt, track.dcaXY());
+            fillCost.fill(histos, HIST("tracks/deuteron/dca/before/hDCAxyVsPtDeuteron"), DPt, track.dcaXY());
           if (!track.hasTOF() && (outFlagOptions.enableNoTOFPlots))
-            histos.fill(HIST("tracks/deuteron/dca/before/hDCAxyVsPtDeuteronNoTOF"), DPt, track.dcaXY());
+            fillCost.fill(histos, HIST("tracks/deuteron/dca/before/hDCAxyVsPtDeuteronNoTOF"), DPt, track.dcaXY());
         }
         if (isAntiDeWoDCAxyWTPCpid) {
           if (usenITSLayer && !itsClusterMap.test(trkqcOptions.nITSLayer))
             continue;
           if (enableCentrality)
-            histos.fill(HIST("tracks/deuteron/dca/before/hDCAxyVsPtantiDeuteronVsMult"), antiDPt, track.dcaXY(), centFT0M);
+            fillCost.fill(histos, HIST("tracks/deuteron/dca/before/hDCAxyVsPtantiDeuteronVsMult"), antiDPt, track.dcaXY(), centFT0M);
           else
-            histos.fill(HIST("tracks/deuteron/dca/before/hDCAxyVsPtantiDeuteron"), antiDPt, track.dcaXY());
+            fillCost.fill(histos, HIST("tracks/deuteron/dca/before/hDCAxyVsPtantiDeuteron"), antiDPt, track.dcaXY());
           if (!track.hasTOF() && (outFlagOptions.enableNoTOFPlots))
-            histos.fill(HIST("tracks/deuteron/dca/before/hDCAxyVsPtantiDeuteronNoTOF"), antiDPt, track.dcaXY());
+            fillCost.fill(histos, HIST("tracks/deuteron/dca/before/hDCAxyVsPtantiDeuteronNoTOF"), antiDPt, track.dcaXY());
         }
 
         if (isHeWoDCAxyWTPCpid) {
-          histos.fill(HIST("tracks/helium/dca/before/hDCAxyVsPtHelium"), hePt, track.dcaXY());
+          fillCost.fill(histos, HIST("tracks/helium/dca/before/hDCAxyVsPtHelium"), hePt, track.dcaXY());
           if (!track.hasTOF() && (outFlagOptions.enableNoTOFPlots))
-            histos.fill(HIST("tracks/helium/dca/before/hDCAxyVsPtHeliumNoTOF"), hePt, track.dcaXY());
+            fillCost.fill(histos, HIST("tracks/helium/dca/before/hDCAxyVsPtHeliumNoTOF"), hePt, track.dcaXY());
           if (track.hasTOF() && outFlagOptions.doTOFplots) {
-            histos.fill(HIST("tracks/helium/dca/before/TOF/hDCAxyVsPtHelium"), hePt, track.dcaXY());
+            fillCost.fill(histos, HIST("tracks/helium/dca/before/TOF/hDCAxyVsPtHelium"), hePt, track.dcaXY());
           }
         }
         if (isAntiHeWoDCAxyWTPCpid) {
-          histos.fill(HIST("tracks/helium/dca/before/hDCAxyVsPtantiHelium"), antihePt, track.dcaXY());
+          fillCost.fill(histos, HIST("tracks/helium/dca/before/hDCAxyVsPtantiHelium"), antihePt, track.dcaXY());
           if (!track.hasTOF() && (outFlagOptions.enableNoTOFPlots))
-            histos.fill(HIST("tracks/helium/dca/before/hDCAxyVsPtantiHeliumNoTOF"), antihePt, track.dcaXY());
+            fillCost.fill(histos, HIST("tracks/helium/dca/before/hDCAxyVsPtantiHeliumNoTOF"), antihePt, track.dcaXY());
           if (track.hasTOF() && outFlagOptions.doTOFplots) {
-            histos.fill(HIST("tracks/helium/dca/before/TOF/hDCAxyVsPtantiHelium"), antihePt, track.dcaXY());
+            fillCost.fill(histos, HIST("tracks/helium/dca/before/TOF/hDCAxyVsPtantiHelium"), antihePt, track.dcaXY());
           }
         }
       }
@@ -3466,29 +3472,29 @@ struct lfNucleiBATask {
             }
           }
           if (hasFakeHit && passDCAzCut) {
-            debugHistos.fill(HIST("debug/h2TPCsignVsTPCmomentum_FakeHits"), track.tpcInnerParam() / (1.f * track.sign()), track.tpcSignal());
+            fillCost.fill(debugHistos, HIST("debug/h2TPCsignVsTPCmomentum_FakeHits"), track.tpcInnerParam() / (1.f * track.sign()), track.tpcSignal());
           }
         }
         switch (pdgCode) {
           case PDGProton:
             if (enablePr && prRapCut && outFlagOptions.makeDCABeforeCutPlots && passDCAzCut) {
-              histos.fill(HIST("tracks/proton/dca/before/hDCAxyVsPtProtonTrue"), track.pt(), track.dcaXY());
+              fillCost.fill(histos, HIST("tracks/proton/dca/before/hDCAxyVsPtProtonTrue"), track.pt(), track.dcaXY());
               if (track.hasTOF() && outFlagOptions.doTOFplots) {
-                histos.fill(HIST("tracks/proton/dca/before/TOF/hDCAxyVsPtProtonTrue"), track.pt(), track.dcaXY());
+                fillCost.fill(histos, HIST("tracks/proton/dca/before/TOF/hDCAxyVsPtProtonTrue"), track.pt(), track.dcaXY());
               }
               if (isPhysPrim) {
-                histos.fill(HIST("tracks/proton/dca/before/hDCAxyVsPtProtonTruePrim"), track.pt(), track.dcaXY());
+                fillCost.fill(histos, HIST("tracks/proton/dca/before/hDCAxyVsPtProtonTruePrim"), track.pt(), track.dcaXY());
                 if (track.hasTOF() && outFlagOptions.doTOFplots) {
-                  histos.fill(HIST("tracks/proton/dca/before/TOF/hDCAxyVsPtProtonTruePrim"), track.pt(), track.dcaXY());
+                  fillCost.fill(histos, HIST("tracks/proton/dca/before/TOF/hDCAxyVsPtProtonTruePrim"), track.pt(), track.dcaXY());
                 }
               }
               if (!isPhysPrim && !isProdByGen) {
                 if (isWeakDecay) {
-                  histos.fill(HIST("tracks/proton/dca/before/hDCAxyVsPtProtonTrueSec"), track.pt(), track.dcaXY());
+                  fillCost.fill(histos, HIST("tracks/proton/dca/before/hDCAxyVsPtProtonTrueSec"), track.pt(), track.dcaXY());
                 } else {
-                  histos.fill(HIST("tracks/proton/dca/before/hDCAxyVsPtProtonTrueMaterial"), track.pt(), track.dcaXY());
+                  fillCost.fill(histos, HIST("tracks/proton/dca/before/hDCAxyVsPtProtonTrueMaterial"), track.pt(), track.dcaXY());
                   if constexpr (!IsFilteredData) {
-                    histos.fill(HIST("tracks/proton/dca/before/hNumMothers"), nSaved);
+                    fillCost.fill(histos, HIST("tracks/proton/dca/before/hNumMothers"), nSaved);
                     if (nSaved > 0) {
                       for (int iMom = 0; iMom < nSaved; iMom++) {
                         int pdgMom = pdgMomList[iMom];
@@ -3504,16 +3510,16 @@ struct lfNucleiBATask {
                             }
                           }
                         }
-                        histos.fill(HIST("tracks/proton/dca/before/hMomTrueMaterial"), pdgSign, motherSpeciesBin, ptMom);
+                        fillCost.fill(histos, HIST("tracks/proton/dca/before/hMomTrueMaterial"), pdgSign, motherSpeciesBin, ptMom);
                       }
                     }
                   }
                 }
                 if (track.hasTOF() && outFlagOptions.doTOFplots) {
                   if (isWeakDecay) {
-                    histos.fill(HIST("tracks/proton/dca/before/TOF/hDCAxyVsPtProtonTrueSec"), track.pt(), track.dcaXY());
+                    fillCost.fill(histos, HIST("tracks/proton/dca/before/TOF/hDCAxyVsPtProtonTrueSec"), track.pt(), track.dcaXY());
                   } else {
-                    histos.fill(HIST("tracks/proton/dca/before/TOF/hDCAxyVsPtProtonTrueMaterial"), track.pt(), track.dcaXY());
+                    fillCost.fill(histos, HIST("tracks/proton/dca/before/TOF/hDCAxyVsPtProtonTrueMaterial"), track.pt(), track.dcaXY());
                   }
                 }
               }
@@ -3521,27 +3527,27 @@ struct lfNucleiBATask {
             break;
           case -PDGProton:
             if (enablePr && prRapCut && outFlagOptions.makeDCABeforeCutPlots && passDCAzCut) {
-              histos.fill(HIST("tracks/proton/dca/before/hDCAxyVsPtantiProtonTrue"), track.pt(), track.dcaXY());
+              fillCost.fill(histos, HIST("tracks/proton/dca/before/hDCAxyVsPtantiProtonTrue"), track.pt(), track.dcaXY());
               if (track.hasTOF() && outFlagOptions.doTOFplots) {
-                histos.fill(HIST("tracks/proton/dca/before/TOF/hDCAxyVsPtantiProtonTrue"), track.pt(), track.dcaXY());
+                fillCost.fill(histos, HIST("tracks/proton/dca/before/TOF/hDCAxyVsPtantiProtonTrue"), track.pt(), track.dcaXY());
               }
               if (isPhysPrim) {
-                histos.fill(HIST("tracks/proton/dca/before/hDCAxyVsPtantiProtonTruePrim"), track.pt(), track.dcaXY());
+                fillCost.fill(histos, HIST("tracks/proton/dca/before/hDCAxyVsPtantiProtonTruePrim"), track.pt(), track.dcaXY());
                 if (track.hasTOF() && outFlagOptions.doTOFplots) {
-                  histos.fill(HIST("tracks/proton/dca/before/TOF/hDCAxyVsPtantiProtonTruePrim"), track.pt(), track.dcaXY());
+                  fillCost.fill(histos, HIST("tracks/proton/dca/before/TOF/hDCAxyVsPtantiProtonTruePrim"), track.pt(), track.dcaXY());
                 }
               }
               if (!isPhysPrim && !isProdByGen) {
                 if (isWeakDecay) {
-                  histos.fill(HIST("tracks/proton/dca/before/hDCAxyVsPtantiProtonTrueSec"), track.pt(), track.dcaXY());
+                  fillCost.fill(histos, HIST("tracks/proton/dca/before/hDCAxyVsPtantiProtonTrueSec"), track.pt(), track.dcaXY());
                 } else {
-                  histos.fill(HIST("tracks/proton/dca/before/hDCAxyVsPtantiProtonTrueMaterial"), track.pt(), track.dcaXY());
+                  fillCost.fill(histos, HIST("tracks/proton/dca/before/hDCAxyVsPtantiProtonTrueMaterial"), track.pt(), track.dcaXY());
                 }
                 if (track.hasTOF() && outFlagOptions.doTOFplots) {
                   if (isWeakDecay) {
-                    histos.fill(HIST("tracks/proton/dca/before/TOF/hDCAxyVsPtantiProtonTrueSec"), track.pt(), track.dcaXY());
+                    fillCost.fill(histos, HIST("tracks/proton/dca/before/TOF/hDCAxyVsPtantiProtonTrueSec"), track.pt(), track.dcaXY());
                   } else {
-                    histos.fill(HIST("tracks/proton/dca/before/TOF/hDCAxyVsPtantiProtonTrueMaterial"), track.pt(), track.dcaXY());
+                    fillCost.fill(histos, HIST("tracks/proton/dca/before/TOF/hDCAxyVsPtantiProtonTrueMaterial"), track.pt(), track.dcaXY());
                   }
                 }
               }
@@ -3550,42 +3556,42 @@ struct lfNucleiBATask {
           case PDGDeuteron:
             if (isDeWoDCAxy) {
               if (outFlagOptions.makeDCABeforeCutPlots) {
-                histos.fill(HIST("tracks/deuteron/dca/before/hDCAxyVsPtDeuteronTrue"), DPt, track.dcaXY());
+                fillCost.fill(histos, HIST("tracks/deuteron/dca/before/hDCAxyVsPtDeuteronTrue"), DPt, track.dcaXY());
                 if (track.hasTOF() && outFlagOptions.doTOFplots) {
-                  histos.fill(HIST("tracks/deuteron/dca/before/TOF/hDCAxyVsPtDeuteronTrue"), DPt, track.dcaXY());
+                  fillCost.fill(histos, HIST("tracks/deuteron/dca/before/TOF/hDCAxyVsPtDeuteronTrue"), DPt, track.dcaXY());
                 }
               }
               if (isPhysPrim) {
                 if (outFlagOptions.makeDCABeforeCutPlots) {
-                  histos.fill(HIST("tracks/deuteron/dca/before/hDCAxyVsPtDeuteronTruePrim"), DPt, track.dcaXY());
+                  fillCost.fill(histos, HIST("tracks/deuteron/dca/before/hDCAxyVsPtDeuteronTruePrim"), DPt, track.dcaXY());
                   if (track.hasTOF() && outFlagOptions.doTOFplots) {
-                    histos.fill(HIST("tracks/deuteron/dca/before/TOF/hDCAxyVsPtDeuteronTruePrim"), DPt, track.dcaXY());
+                    fillCost.fill(histos, HIST("tracks/deuteron/dca/before/TOF/hDCAxyVsPtDeuteronTruePrim"), DPt, track.dcaXY());
                   }
                 }
                 if constexpr (IsFilteredData) {
-                  spectraGen.fill(HIST("deuteron/histDeuteronPtShift"), track.pt(), track.pt() - genPt);
-                  spectraGen.fill(HIST("deuteron/histDeuteronPtShiftVsEta"), track.eta(), track.pt() - genPt);
+                  fillCost.fill(spectraGen, HIST("deuteron/histDeuteronPtShift"), track.pt(), track.pt() - genPt);
+                  fillCost.fill(spectraGen, HIST("deuteron/histDeuteronPtShiftVsEta"), track.eta(), track.pt() - genPt);
 
-                  histos.fill(HIST("tracks/deuteron/histDeuteronPtShiftRec"), DPt);
-                  histos.fill(HIST("tracks/deuteron/histDeuteronPtRec"), track.pt());
-                  spectraGen.fill(HIST("deuteron/histDeuteronPtShiftCorrection"), DPt, DPt - genPt);
+                  fillCost.fill(histos, HIST("tracks/deuteron/histDeuteronPtShiftRec"), DPt);
+                  fillCost.fill(histos, HIST("tracks/deuteron/histDeuteronPtRec"), track.pt());
+                  fillCost.fill(spectraGen, HIST("deuteron/histDeuteronPtShiftCorrection"), DPt, DPt - genPt);
                 } else {
-                  spectraGen.fill(HIST("deuteron/histDeuteronPtShift"), track.pt(), track.pt() - genPt);
-                  spectraGen.fill(HIST("deuteron/histDeuteronPtShiftVsEta"), track.eta(), track.pt() - genPt);
+                  fillCost.fill(spectraGen, HIST("deuteron/histDeuteronPtShift"), track.pt(), track.pt() - genPt);
+                  fillCost.fill(spectraGen, HIST("deuteron/histDeuteronPtShiftVsEta"), track.eta(), track.pt() - genPt);
 
-                  histos.fill(HIST("tracks/deuteron/histDeuteronPtShiftRec"), DPt);
-                  histos.fill(HIST("tracks/deuteron/histDeuteronPtRec"), track.pt());
-                  spectraGen.fill(HIST("deuteron/histDeuteronPtShiftCorrection"), DPt, DPt - genPt);
+                  fillCost.fill(histos, HIST("tracks/deuteron/histDeuteronPtShiftRec"), DPt);
+                  fillCost.fill(histos, HIST("tracks/deuteron/histDeuteronPtRec"), track.pt());
+                  fillCost.fill(spectraGen, HIST("deuteron/histDeuteronPtShiftCorrection"), DPt, DPt - genPt);
                 }
               }
               if (!isPhysPrim && !isProdByGen) {
                 if (outFlagOptions.makeDCABeforeCutPlots) {
                   if (isWeakDecay) {
-                    histos.fill(HIST("tracks/deuteron/dca/before/hDCAxyVsPtDeuteronTrueSec"), DPt, track.dcaXY());
+                    fillCost.fill(histos, HIST("tracks/deuteron/dca/before/hDCAxyVsPtDeuteronTrueSec"), DPt, track.dcaXY());
                   } else {
-                    histos.fill(HIST("tracks/deuteron/dca/before/hDCAxyVsPtDeuteronTrueMaterial"), DPt, track.dcaXY());
+                    fillCost.fill(histos, HIST("tracks/deuteron/dca/before/hDCAxyVsPtDeuteronTrueMaterial"), DPt, track.dcaXY());
                     if constexpr (!IsFilteredData) {
-                      histos.fill(HIST("tracks/deuteron/dca/before/hNumMothers"), nSaved);
+                      fillCost.fill(histos, HIST("tracks/deuteron/dca/before/hNumMothers"), nSaved);
                       if (nSaved > 0) {
                         for (int iMom = 0; iMom < nSaved; iMom++) {
                           int pdgMom = pdgMomList[iMom];
@@ -3601,16 +3607,16 @@ struct lfNucleiBATask {
                               }
                             }
                           }
-                          histos.fill(HIST("tracks/deuteron/dca/before/hMomTrueMaterial"), pdgSign, motherSpeciesBin, ptMom);
+                          fillCost.fill(histos, HIST("tracks/deuteron/dca/before/hMomTrueMaterial"), pdgSign, motherSpeciesBin, ptMom);
                         }
                       }
                     }
                   }
                   if (track.hasTOF() && outFlagOptions.doTOFplots) {
                     if (isWeakDecay) {
-                      histos.fill(HIST("tracks/deuteron/dca/before/TOF/hDCAxyVsPtDeuteronTrueSec"), DPt, track.dcaXY());
+                      fillCost.fill(histos, HIST("tracks/deuteron/dca/before/TOF/hDCAxyVsPtDeuteronTrueSec"), DPt, track.dcaXY());
                     } else {
-                      histos.fill(HIST("tracks/deuteron/dca/before/TOF/hDCAxyVsPtDeuteronTrueMaterial"), DPt, track.dcaXY());
+                      fillCost.fill(histos, HIST("tracks/deuteron/dca/before/TOF/hDCAxyVsPtDeuteronTrueMaterial"), DPt, track.dcaXY());
                     }
                   }
                 }
@@ -3620,46 +3626,46 @@ struct lfNucleiBATask {
           case -PDGDeuteron:
             if (isAntiDeWoDCAxy) {
               if (outFlagOptions.makeDCABeforeCutPlots) {
-                histos.fill(HIST("tracks/deuteron/dca/before/hDCAxyVsPtantiDeuteronTrue"), antiDPt, track.dcaXY());
+                fillCost.fill(histos, HIST("tracks/deuteron/dca/before/hDCAxyVsPtantiDeuteronTrue"), antiDPt, track.dcaXY());
                 if (track.hasTOF() && outFlagOptions.doTOFplots) {
-                  histos.fill(HIST("tracks/deuteron/dca/before/TOF/hDCAxyVsPtantiDeuteronTrue"), antiDPt, track.dcaXY());
+                  fillCost.fill(histos, HIST("tracks/deuteron/dca/before/TOF/hDCAxyVsPtantiDeuteronTrue"), antiDPt, track.dcaXY());
                 }
               }
               if (isPhysPrim) {
                 if (outFlagOptions.makeDCABeforeCutPlots) {
-                  histos.fill(HIST("tracks/deuteron/dca/before/hDCAxyVsPtantiDeuteronTruePrim"), antiDPt, track.dcaXY());
+                  fillCost.fill(histos, HIST("tracks/deuteron/dca/before/hDCAxyVsPtantiDeuteronTruePrim"), antiDPt, track.dcaXY());
                   if (track.hasTOF() && outFlagOptions.doTOFplots) {
-                    histos.fill(HIST("tracks/deuteron/dca/before/TOF/hDCAxyVsPtantiDeuteronTruePrim"), antiDPt, track.dcaXY());
+                    fillCost.fill(histos, HIST("tracks/deuteron/dca/before/TOF/hDCAxyVsPtantiDeuteronTruePrim"), antiDPt, track.dcaXY());
                   }
                 }
                 if constexpr (IsFilteredData) {
-                  spectraGen.fill(HIST("deuteron/histAntiDeuteronPtShift"), track.pt(), track.pt() - genPt);
-                  spectraGen.fill(HIST("deuteron/histAntiDeuteronPtShiftVsEta"), track.eta(), track.pt() - genPt);
+                  fillCost.fill(spectraGen, HIST("deuteron/histAntiDeuteronPtShift"), track.pt(), track.pt() - genPt);
+                  fillCost.fill(spectraGen, HIST("deuteron/histAntiDeuteronPtShiftVsEta"), track.eta(), track.pt() - genPt);
 
-                  histos.fill(HIST("tracks/deuteron/histAntiDeuteronPtShiftRec"), antiDPt);
-                  histos.fill(HIST("tracks/deuteron/histAntiDeuteronPtRec"), track.pt());
-                  spectraGen.fill(HIST("deuteron/histAntiDeuteronPtShiftCorrection"), antiDPt, antiDPt - genPt);
+                  fillCost.fill(histos, HIST("tracks/deuteron/histAntiDeuteronPtShiftRec"), antiDPt);
+                  fillCost.fill(histos, HIST("tracks/deuteron/histAntiDeuteronPtRec"), track.pt());
+                  fillCost.fill(spectraGen, HIST("deuteron/histAntiDeuteronPtShiftCorrection"), antiDPt, antiDPt - genPt);
                 } else {
-                  spectraGen.fill(HIST("deuteron/histAntiDeuteronPtShift"), track.pt(), track.pt() - genPt);
-                  spectraGen.fill(HIST("deuteron/histAntiDeuteronPtShiftVsEta"), track.eta(), track.pt() - genPt);
+                  fillCost.fill(spectraGen, HIST("deuteron/histAntiDeuteronPtShift"), track.pt(), track.pt() - genPt);
+                  fillCost.fill(spectraGen, HIST("deuteron/histAntiDeuteronPtShiftVsEta"), track.eta(), track.pt() - genPt);
 
-                  histos.fill(HIST("tracks/deuteron/histAntiDeuteronPtShiftRec"), antiDPt);
-                  histos.fill(HIST("tracks/deuteron/histAntiDeuteronPtRec"), track.pt());
-                  spectraGen.fill(HIST("deuteron/histAntiDeuteronPtShiftCorrection"), antiDPt, antiDPt - genPt);
+                  fillCost.fill(histos, HIST("tracks/deuteron/histAntiDeuteronPtShiftRec"), antiDPt);
+                  fillCost.fill(histos, HIST("tracks/deuteron/histAntiDeuteronPtRec"), track.pt());
+                  fillCost.fill(spectraGen, HIST("deuteron/histAntiDeuteronPtShiftCorrection"), antiDPt, antiDPt - genPt);
                 }
               }
               if (!isPhysPrim && !isProdByGen) {
                 if (outFlagOptions.makeDCABeforeCutPlots) {
                   if (isWeakDecay) {
-                    histos.fill(HIST("tracks/deuteron/dca/before/hDCAxyVsPtantiDeuteronTrueSec"), antiDPt, track.dcaXY());
+                    fillCost.fill(histos, HIST("tracks/deuteron/dca/before/hDCAxyVsPtantiDeuteronTrueSec"), antiDPt, track.dcaXY());
                   } else {
-                    histos.fill(HIST("tracks/deuteron/dca/before/hDCAxyVsPtantiDeuteronTrueMaterial"), antiDPt, track.dcaXY());
+                    fillCost.fill(histos, HIST("tracks/deuteron/dca/before/hDCAxyVsPtantiDeuteronTrueMaterial"), antiDPt, track.dcaXY());
                   }
                   if (track.hasTOF() && outFlagOptions.doTOFplots) {
                     if (isWeakDecay) {
-                      histos.fill(HIST("tracks/deuteron/dca/before/TOF/hDCAxyVsPtantiDeuteronTrueSec"), antiDPt, track.dcaXY());
+                      fillCost.fill(histos, HIST("tracks/deuteron/dca/before/TOF/hDCAxyVsPtantiDeuteronTrueSec"), antiDPt, track.dcaXY());
                     } else {
-                      histos.fill(HIST("tracks/deuteron/dca/before/TOF/hDCAxyVsPtantiDeuteronTrueMaterial"), antiDPt, track.dcaXY());
+                      fillCost.fill(histos, HIST("tracks/deuteron/dca/before/TOF/hDCAxyVsPtantiDeuteronTrueMaterial"), antiDPt, track.dcaXY());
                     }
                   }
                 }
@@ -3668,26 +3674,26 @@ struct lfNucleiBATask {
             break;
           case PDGTriton:
             if (enableTr && trRapCut && outFlagOptions.makeDCABeforeCutPlots && passDCAzCut) {
-              histos.fill(HIST("tracks/triton/dca/before/hDCAxyVsPtTritonTrue"), track.pt(), track.dcaXY());
+              fillCost.fill(histos, HIST("tracks/triton/dca/before/hDCAxyVsPtTritonTrue"), track.pt(), track.dcaXY());
               if (track.hasTOF() && outFlagOptions.doTOFplots) {
-                histos.fill(HIST("tracks/triton/dca/before/TOF/hDCAxyVsPtTritonTrue"), track.pt(), track.dcaXY());
+                fillCost.fill(histos, HIST("tracks/triton/dca/before/TOF/hDCAxyVsPtTritonTrue"), track.pt(), track.dcaXY());
               }
               if (isPhysPrim) {
-                histos.fill(HIST("tracks/triton/dca/before/hDCAxyVsPtTritonTruePrim"), track.pt(), track.dcaXY());
+                fillCost.fill(histos, HIST("tracks/triton/dca/before/hDCAxyVsPtTritonTruePrim"), track.pt(), track.dcaXY());
                 if (track.hasTOF() && outFlagOptions.doTOFplots) {
-                  histos.fill(HIST("tracks/triton/dca/before/TOF/hDCAxyVsPtTritonTruePrim"), track.pt(), track.dcaXY());
+                  fillCost.fill(histos, HIST("tracks/triton/dca/before/TOF/hDCAxyVsPtTritonTruePrim"), track.pt(), track.dcaXY());
                 }
               }
               if (!isPhysPrim && !isProdByGen) {
                 if (isWeakDecay) {
-                  histos.fill(HIST("tracks/triton/dca/before/hDCAxyVsPtTritonTrueSec"), track.pt(), track.dcaXY());
+                  fillCost.fill(histos, HIST("tracks/triton/dca/before/hDCAxyVsPtTritonTrueSec"), track.pt(), track.dcaXY());
                   if (track.hasTOF() && outFlagOptions.doTOFplots) {
-                    histos.fill(HIST("tracks/triton/dca/before/TOF/hDCAxyVsPtTritonTrueSec"), track.pt(), track.dcaXY());
+                    fillCost.fill(histos, HIST("tracks/triton/dca/before/TOF/hDCAxyVsPtTritonTrueSec"), track.pt(), track.dcaXY());
                   }
                 } else {
-                  histos.fill(HIST("tracks/triton/dca/before/hDCAxyVsPtTritonTrueMaterial"), track.pt(), track.dcaXY());
+                  fillCost.fill(histos, HIST("tracks/triton/dca/before/hDCAxyVsPtTritonTrueMaterial"), track.pt(), track.dcaXY());
                   if (track.hasTOF() && outFlagOptions.doTOFplots) {
-                    histos.fill(HIST("tracks/triton/dca/before/TOF/hDCAxyVsPtTritonTrueMaterial"), track.pt(), track.dcaXY());
+                    fillCost.fill(histos, HIST("tracks/triton/dca/before/TOF/hDCAxyVsPtTritonTrueMaterial"), track.pt(), track.dcaXY());
                   }
                 }
               }
@@ -3695,15 +3701,15 @@ struct lfNucleiBATask {
             break;
           case -PDGTriton:
             if (enableTr && trRapCut && outFlagOptions.makeDCABeforeCutPlots && passDCAzCut) {
-              histos.fill(HIST("tracks/triton/dca/before/hDCAxyVsPtantiTritonTrue"), track.pt(), track.dcaXY());
+              fillCost.fill(histos, HIST("tracks/triton/dca/before/hDCAxyVsPtantiTritonTrue"), track.pt(), track.dcaXY());
               if (track.hasTOF() && outFlagOptions.doTOFplots) {
-                histos.fill(HIST("tracks/triton/dca/before/TOF/hDCAxyVsPtantiTritonTrue"), track.pt(), track.dcaXY());
+                fillCost.fill(histos, HIST("tracks/triton/dca/before/TOF/hDCAxyVsPtantiTritonTrue"), track.pt(), track.dcaXY());
               }
 
               if (isPhysPrim) {
-                histos.fill(HIST("tracks/triton/dca/before/hDCAxyVsPtantiTritonTruePrim"), track.pt(), track.dcaXY());
+                fillCost.fill(histos, HIST("tracks/triton/dca/before/hDCAxyVsPtantiTritonTruePrim"), track.pt(), track.dcaXY());
                 if (track.hasTOF() && outFlagOptions.doTOFplots) {
-                  histos.fill(HIST("tracks/triton/dca/before/TOF/hDCAxyVsPtantiTritonTruePrim"), track.pt(), track.dcaXY());
+                  fillCost.fill(histos, HIST("tracks/triton/dca/before/TOF/hDCAxyVsPtantiTritonTruePrim"), track.pt(), track.dcaXY());
                 }
               }
               if (!isPhysPrim && isProdByGen) {
@@ -3711,14 +3717,14 @@ struct lfNucleiBATask {
               }
               if (!isPhysPrim && !isProdByGen) {
                 if (isWeakDecay) {
-                  histos.fill(HIST("tracks/triton/dca/before/hDCAxyVsPtantiTritonTrueSec"), track.pt(), track.dcaXY());
+                  fillCost.fill(histos, HIST("tracks/triton/dca/before/hDCAxyVsPtantiTritonTrueSec"), track.pt(), track.dcaXY());
                   if (track.hasTOF() && outFlagOptions.doTOFplots) {
-                    histos.fill(HIST("tracks/triton/dca/before/TOF/hDCAxyVsPtantiTritonTrueSec"), track.pt(), track.dcaXY());
+                    fillCost.fill(histos, HIST("tracks/triton/dca/before/TOF/hDCAxyVsPtantiTritonTrueSec"), track.pt(), track.dcaXY());
                   }
                 } else {
-                  histos.fill(HIST("tracks/triton/dca/before/hDCAxyVsPtantiTritonTrueMaterial"), track.pt(), track.dcaXY());
+                  fillCost.fill(histos, HIST("tracks/triton/dca/before/hDCAxyVsPtantiTritonTrueMaterial"), track.pt(), track.dcaXY());
                   if (track.hasTOF() && outFlagOptions.doTOFplots) {
-                    histos.fill(HIST("tracks/triton/dca/before/TOF/hDCAxyVsPtantiTritonTrueMaterial"), track.pt(), track.dcaXY());
+                    fillCost.fill(histos, HIST("tracks/triton/dca/before/TOF/hDCAxyVsPtantiTritonTrueMaterial"), track.pt(), track.dcaXY());
                   }
                 }
               }
@@ -3727,24 +3733,24 @@ struct lfNucleiBATask {
           case PDGHelium:
             if (isHeWoDCAxy) {
               if (outFlagOptions.makeDCABeforeCutPlots) {
-                histos.fill(HIST("tracks/helium/dca/before/hDCAxyVsPtHeliumTrue"), hePt, track.dcaXY());
+                fillCost.fill(histos, HIST("tracks/helium/dca/before/hDCAxyVsPtHeliumTrue"), hePt, track.dcaXY());
                 if (track.hasTOF() && outFlagOptions.doTOFplots) {
-                  histos.fill(HIST("tracks/helium/dca/before/TOF/hDCAxyVsPtHeliumTrue"), hePt, track.dcaXY());
+                  fillCost.fill(histos, HIST("tracks/helium/dca/before/TOF/hDCAxyVsPtHeliumTrue"), hePt, track.dcaXY());
                 }
                 if (isPhysPrim) {
-                  histos.fill(HIST("tracks/helium/dca/before/hDCAxyVsPtHeliumTruePrim"), hePt, track.dcaXY());
+                  fillCost.fill(histos, HIST("tracks/helium/dca/before/hDCAxyVsPtHeliumTruePrim"), hePt, track.dcaXY());
                   if (track.hasTOF() && outFlagOptions.doTOFplots) {
-                    histos.fill(HIST("tracks/helium/dca/before/TOF/hDCAxyVsPtHeliumTruePrim"), hePt, track.dcaXY());
+                    fillCost.fill(histos, HIST("tracks/helium/dca/before/TOF/hDCAxyVsPtHeliumTruePrim"), hePt, track.dcaXY());
                   }
                 }
               }
               if (!isPhysPrim && !isProdByGen && outFlagOptions.makeDCABeforeCutPlots) {
                 if (isWeakDecay) {
-                  histos.fill(HIST("tracks/helium/dca/before/hDCAxyVsPtHeliumTrueSec"), hePt, track.dcaXY());
+                  fillCost.fill(histos, HIST("tracks/helium/dca/before/hDCAxyVsPtHeliumTrueSec"), hePt, track.dcaXY());
                 } else {
-                  histos.fill(HIST("tracks/helium/dca/before/hDCAxyVsPtHeliumTrueMaterial"), hePt, track.dcaXY());
+                  fillCost.fill(histos, HIST("tracks/helium/dca/before/hDCAxyVsPtHeliumTrueMaterial"), hePt, track.dcaXY());
                   if (!IsFilteredData) {
-                    histos.fill(HIST("tracks/helium/dca/before/hNumMothers"), nSaved);
+                    fillCost.fill(histos, HIST("tracks/helium/dca/before/hNumMothers"), nSaved);
                     if (nSaved > 0) {
                       for (int iMom = 0; iMom < nSaved; iMom++) {
                         int pdgMom = pdgMomList[iMom];
@@ -3760,16 +3766,16 @@ struct lfNucleiBATask {
                             }
                           }
                         }
-                        histos.fill(HIST("tracks/helium/dca/before/hMomTrueMaterial"), pdgSign, motherSpeciesBin, ptMom);
+                        fillCost.fill(histos, HIST("tracks/helium/dca/before/hMomTrueMaterial"), pdgSign, motherSpeciesBin, ptMom);
                       }
                     }
                   }
                 }
                 if (track.hasTOF() && outFlagOptions.doTOFplots) {
                   if (isWeakDecay) {
-                    histos.fill(HIST("tracks/helium/dca/before/TOF/hDCAxyVsPtHeliumTrueSec"), hePt, track.dcaXY());
+                    fillCost.fill(histos, HIST("tracks/helium/dca/before/TOF/hDCAxyVsPtHeliumTrueSec"), hePt, track.dcaXY());
                   } else {
-                    histos.fill(HIST("tracks/helium/dca/before/TOF/hDCAxyVsPtHeliumTrueMaterial"), hePt, track.dcaXY());
+                    fillCost.fill(histos, HIST("tracks/helium/dca/before/TOF/hDCAxyVsPtHeliumTrueMaterial"), hePt, track.dcaXY());
                   }
                 }
               }
@@ -3777,25 +3783,25 @@ struct lfNucleiBATask {
             if constexpr (!IsFilteredData) {
               if ((event.has_mcCollision() && (track.mcParticle().mcCollisionId() != event.mcCollisionId())) || !event.has_mcCollision()) {
                 if (isHeWoDCAxy && outFlagOptions.makeDCABeforeCutPlots && outFlagOptions.makeWrongEventPlots) {
-                  histos.fill(HIST("tracks/helium/dca/before/wrong/hDCAxyVsPtHeliumTrue"), hePt, track.dcaXY());
+                  fillCost.fill(histos, HIST("tracks/helium/dca/before/wrong/hDCAxyVsPtHeliumTrue"), hePt, track.dcaXY());
                   if (track.hasTOF() && outFlagOptions.doTOFplots) {
-                    histos.fill(HIST("tracks/helium/dca/before/wrong/TOF/hDCAxyVsPtHeliumTrue"), hePt, track.dcaXY());
+                    fillCost.fill(histos, HIST("tracks/helium/dca/before/wrong/TOF/hDCAxyVsPtHeliumTrue"), hePt, track.dcaXY());
                   }
                   if (isPhysPrim) {
-                    histos.fill(HIST("tracks/helium/dca/before/wrong/hDCAxyVsPtHeliumTruePrim"), hePt, track.dcaXY());
+                    fillCost.fill(histos, HIST("tracks/helium/dca/before/wrong/hDCAxyVsPtHeliumTruePrim"), hePt, track.dcaXY());
                     if (track.hasTOF() && outFlagOptions.doTOFplots) {
-                      histos.fill(HIST("tracks/helium/dca/before/wrong/TOF/hDCAxyVsPtHeliumTruePrim"), hePt, track.dcaXY());
+                      fillCost.fill(histos, HIST("tracks/helium/dca/before/wrong/TOF/hDCAxyVsPtHeliumTruePrim"), hePt, track.dcaXY());
                     }
                   }
                   if (!isPhysPrim && !isProdByGen) {
-                    histos.fill(HIST("tracks/helium/dca/before/wrong/hDCAxyVsPtHeliumTrueTransport"), hePt, track.dcaXY());
+                    fillCost.fill(histos, HIST("tracks/helium/dca/before/wrong/hDCAxyVsPtHeliumTrueTransport"), hePt, track.dcaXY());
                     if (isWeakDecay) {
-                      histos.fill(HIST("tracks/helium/dca/before/wrong/hDCAxyVsPtHeliumTrueSec"), hePt, track.dcaXY());
+                      fillCost.fill(histos, HIST("tracks/helium/dca/before/wrong/hDCAxyVsPtHeliumTrueSec"), hePt, track.dcaXY());
                     }
                     if (track.hasTOF() && outFlagOptions.doTOFplots) {
-                      histos.fill(HIST("tracks/helium/dca/before/wrong/TOF/hDCAxyVsPtHeliumTrueTransport"), hePt, track.dcaXY());
+                      fillCost.fill(histos, HIST("tracks/helium/dca/before/wrong/TOF/hDCAxyVsPtHeliumTrueTransport"), hePt, track.dcaXY());
                       if (isWeakDecay) {
-                        histos.fill(HIST("tracks/helium/dca/before/wrong/TOF/hDCAxyVsPtHeliumTrueSec"), hePt, track.dcaXY());
+                        fillCost.fill(histos, HIST("tracks/helium/dca/before/wrong/TOF/hDCAxyVsPtHeliumTrueSec"), hePt, track.dcaXY());
                       }
                     }
                   }
@@ -3804,26 +3810,26 @@ struct lfNucleiBATask {
               if (isHeWoTPCpid) {
                 if (isPhysPrim) {
                   if constexpr (!IsFilteredData) {
-                    spectraGen.fill(HIST("helium/histPtGenHe"), std::abs(track.mcParticle().pt()));
-                    spectraGen.fill(HIST("helium/histPtRecHe"), 2.f * hePt);
-                    spectraGen.fill(HIST("helium/histPtShiftHe"), 2.f * hePt, 2.f * hePt - track.mcParticle().pt());
-                    spectraGen.fill(HIST("helium/histPtShiftHeVsGen"), track.mcParticle().pt(), 2.f * hePt - track.mcParticle().pt());
+                    fillCost.fill(spectraGen, HIST("helium/histPtGenHe"), std::abs(track.mcParticle().pt()));
+                    fillCost.fill(spectraGen, HIST("helium/histPtRecHe"), 2.f * hePt);
+                    fillCost.fill(spectraGen, HIST("helium/histPtShiftHe"), 2.f * hePt, 2.f * hePt - track.mcParticle().pt());
+                    fillCost.fill(spectraGen, HIST("helium/histPtShiftHeVsGen"), track.mcParticle().pt(), 2.f * hePt - track.mcParticle().pt());
                     if (!heliumPID)
-                      spectraGen.fill(HIST("helium/histPtShiftHe_WrongPidAll"), 2.f * hePt, 2.f * hePt - track.mcParticle().pt());
+                      fillCost.fill(spectraGen, HIST("helium/histPtShiftHe_WrongPidAll"), 2.f * hePt, 2.f * hePt - track.mcParticle().pt());
                     if (tritonPID)
-                      spectraGen.fill(HIST("helium/histPtShiftHe_WrongPidTr"), 2.f * hePt, 2.f * hePt - track.mcParticle().pt());
+                      fillCost.fill(spectraGen, HIST("helium/histPtShiftHe_WrongPidTr"), 2.f * hePt, 2.f * hePt - track.mcParticle().pt());
                     if (deuteronPID)
-                      spectraGen.fill(HIST("helium/histPtShiftHe_WrongPidDe"), 2.f * hePt, 2.f * hePt - track.mcParticle().pt());
+                      fillCost.fill(spectraGen, HIST("helium/histPtShiftHe_WrongPidDe"), 2.f * hePt, 2.f * hePt - track.mcParticle().pt());
 
-                    spectraGen.fill(HIST("helium/histPtShiftVsEtaHe"), track.eta(), 2.f * hePt - track.mcParticle().pt());
+                    fillCost.fill(spectraGen, HIST("helium/histPtShiftVsEtaHe"), track.eta(), 2.f * hePt - track.mcParticle().pt());
                     if (track.hasTOF() && outFlagOptions.doTOFplots) {
-                      spectraGen.fill(HIST("helium/TOF/histPtShiftHe"), 2.f * hePt, 2.f * hePt - track.mcParticle().pt());
-                      spectraGen.fill(HIST("helium/TOF/histPtShiftHeVsGen"), track.mcParticle().pt(), 2.f * hePt - track.mcParticle().pt());
+                      fillCost.fill(spectraGen, HIST("helium/TOF/histPtShiftHe"), 2.f * hePt, 2.f * hePt - track.mcParticle().pt());
+                      fillCost.fill(spectraGen, HIST("helium/TOF/histPtShiftHeVsGen"), track.mcParticle().pt(), 2.f * hePt - track.mcParticle().pt());
                     }
-                    spectraGen.fill(HIST("helium/histPGenHe"), std::abs(track.mcParticle().p()));
-                    spectraGen.fill(HIST("helium/histPRecHe"), 2.f * heP);
-                    spectraGen.fill(HIST("helium/histPShiftHe"), 2.f * heP, 2.f * heP - track.mcParticle().p());
-                    spectraGen.fill(HIST("helium/histPShiftVsEtaHe"), track.eta(), 2.f * heP - track.mcParticle().p());
+                    fillCost.fill(spectraGen, HIST("helium/histPGenHe"), std::abs(track.mcParticle().p()));
+                    fillCost.fill(spectraGen, HIST("helium/histPRecHe"), 2.f * heP);
+                    fillCost.fill(spectraGen, HIST("helium/histPShiftHe"), 2.f * heP, 2.f * heP - track.mcParticle().p());
+                    fillCost.fill(spectraGen, HIST("helium/histPShiftVsEtaHe"), track.eta(), 2.f * heP - track.mcParticle().p());
                   }
                 }
               }
@@ -3832,28 +3838,28 @@ struct lfNucleiBATask {
           case -PDGHelium:
             if (isAntiHeWoDCAxy) {
               if (outFlagOptions.makeDCABeforeCutPlots) {
-                histos.fill(HIST("tracks/helium/dca/before/hDCAxyVsPtantiHeliumTrue"), antihePt, track.dcaXY());
+                fillCost.fill(histos, HIST("tracks/helium/dca/before/hDCAxyVsPtantiHeliumTrue"), antihePt, track.dcaXY());
                 if (track.hasTOF() && outFlagOptions.doTOFplots) {
-                  histos.fill(HIST("tracks/helium/dca/before/TOF/hDCAxyVsPtantiHeliumTrue"), antihePt, track.dcaXY());
+                  fillCost.fill(histos, HIST("tracks/helium/dca/before/TOF/hDCAxyVsPtantiHeliumTrue"), antihePt, track.dcaXY());
                 }
                 if (isPhysPrim) {
-                  histos.fill(HIST("tracks/helium/dca/before/hDCAxyVsPtantiHeliumTruePrim"), antihePt, track.dcaXY());
+                  fillCost.fill(histos, HIST("tracks/helium/dca/before/hDCAxyVsPtantiHeliumTruePrim"), antihePt, track.dcaXY());
                   if (track.hasTOF() && outFlagOptions.doTOFplots) {
-                    histos.fill(HIST("tracks/helium/dca/before/TOF/hDCAxyVsPtantiHeliumTruePrim"), antihePt, track.dcaXY());
+                    fillCost.fill(histos, HIST("tracks/helium/dca/before/TOF/hDCAxyVsPtantiHeliumTruePrim"), antihePt, track.dcaXY());
                   }
                 }
               }
               if (!isPhysPrim && !isProdByGen && outFlagOptions.makeDCABeforeCutPlots) {
                 if (isWeakDecay) {
-                  histos.fill(HIST("tracks/helium/dca/before/hDCAxyVsPtantiHeliumTrueSec"), antihePt, track.dcaXY());
+                  fillCost.fill(histos, HIST("tracks/helium/dca/before/hDCAxyVsPtantiHeliumTrueSec"), antihePt, track.dcaXY());
                 } else {
-                  histos.fill(HIST("tracks/helium/dca/before/hDCAxyVsPtantiHeliumTrueMaterial"), antihePt, track.dcaXY());
+                  fillCost.fill(histos, HIST("tracks/helium/dca/before/hDCAxyVsPtantiHeliumTrueMaterial"), antihePt, track.dcaXY());
                 }
                 if (track.hasTOF() && outFlagOptions.doTOFplots) {
                   if (isWeakDecay) {
-                    histos.fill(HIST("tracks/helium/dca/before/TOF/hDCAxyVsPtantiHeliumTrueSec"), antihePt, track.dcaXY());
+                    fillCost.fill(histos, HIST("tracks/helium/dca/before/TOF/hDCAxyVsPtantiHeliumTrueSec"), antihePt, track.dcaXY());
                   } else {
-                    histos.fill(HIST("tracks/helium/dca/before/TOF/hDCAxyVsPtantiHeliumTrueMaterial"), antihePt, track.dcaXY());
+                    fillCost.fill(histos, HIST("tracks/helium/dca/before/TOF/hDCAxyVsPtantiHeliumTrueMaterial"), antihePt, track.dcaXY());
                   }
                 }
               }
@@ -3861,25 +3867,25 @@ struct lfNucleiBATask {
             if constexpr (!IsFilteredData) {
               if ((event.has_mcCollision() && (track.mcParticle().mcCollisionId() != event.mcCollisionId())) || !event.has_mcCollision()) {
                 if (isAntiHeWoDCAxy && outFlagOptions.makeDCABeforeCutPlots && outFlagOptions.makeWrongEventPlots) {
-                  histos.fill(HIST("tracks/helium/dca/before/wrong/hDCAxyVsPtantiHeliumTrue"), antihePt, track.dcaXY());
+                  fillCost.fill(histos, HIST("tracks/helium/dca/before/wrong/hDCAxyVsPtantiHeliumTrue"), antihePt, track.dcaXY());
                   if (track.hasTOF() && outFlagOptions.doTOFplots) {
-                    histos.fill(HIST("tracks/helium/dca/before/wrong/TOF/hDCAxyVsPtantiHeliumTrue"), antihePt, track.dcaXY());
+                    fillCost.fill(histos, HIST("tracks/helium/dca/before/wrong/TOF/hDCAxyVsPtantiHeliumTrue"), antihePt, track.dcaXY());
                   }
                   if (isPhysPrim) {
-                    histos.fill(HIST("tracks/helium/dca/before/wrong/hDCAxyVsPtantiHeliumTruePrim"), antihePt, track.dcaXY());
+                    fillCost.fill(histos, HIST("tracks/helium/dca/before/wrong/hDCAxyVsPtantiHeliumTruePrim"), antihePt, track.dcaXY());
                     if (track.hasTOF() && outFlagOptions.doTOFplots) {
-                      histos.fill(HIST("tracks/helium/dca/before/wrong/TOF/hDCAxyVsPtantiHeliumTruePrim"), antihePt, track.dcaXY());
+                      fillCost.fill(histos, HIST("tracks/helium/dca/before/wrong/TOF/hDCAxyVsPtantiHeliumTruePrim"), antihePt, track.dcaXY());
                     }
                   }
                   if (!isPhysPrim && !isProdByGen) {
-                    histos.fill(HIST("tracks/helium/dca/before/wrong/hDCAxyVsPtantiHeliumTrueTransport"), antihePt, track.dcaXY());
+                    fillCost.fill(histos, HIST("tracks/helium/dca/before/wrong/hDCAxyVsPtantiHeliumTrueTransport"), antihePt, track.dcaXY());
                     if (isWeakDecay) {
-                      histos.fill(HIST("tracks/helium/dca/before/wrong/hDCAxyVsPtantiHeliumTrueSec"), antihePt, track.dcaXY());
+                      fillCost.fill(histos, HIST("tracks/helium/dca/before/wrong/hDCAxyVsPtantiHeliumTrueSec"), antihePt, track.dcaXY());
                     }
                     if (track.hasTOF() && outFlagOptions.doTOFplots) {
-                      histos.fill(HIST("tracks/helium/dca/before/wrong/TOF/hDCAxyVsPtantiHeliumTrueTransport"), antihePt, track.dcaXY());
+                      fillCost.fill(histos, HIST("tracks/helium/dca/before/wrong/TOF/hDCAxyVsPtantiHeliumTrueTransport"), antihePt, track.dcaXY());
                       if (isWeakDecay) {
-                        histos.fill(HIST("tracks/helium/dca/before/wrong/TOF/hDCAxyVsPtantiHeliumTrueSec"), antihePt, track.dcaXY());
+                        fillCost.fill(histos, HIST("tracks/helium/dca/before/wrong/TOF/hDCAxyVsPtantiHeliumTrueSec"), antihePt, track.dcaXY());
                       }
                     }
                   }
@@ -3888,26 +3894,26 @@ struct lfNucleiBATask {
               if (isAntiHeWoTPCpid) {
                 if (isPhysPrim) {
                   if constexpr (!IsFilteredData) {
-                    spectraGen.fill(HIST("helium/histPtGenantiHe"), std::abs(track.mcParticle().pt()));
-                    spectraGen.fill(HIST("helium/histPtRecantiHe"), 2.f * antihePt);
-                    spectraGen.fill(HIST("helium/histPtShiftantiHe"), 2.f * antihePt, 2.f * antihePt - track.mcParticle().pt());
-                    spectraGen.fill(HIST("helium/histPtShiftantiHeVsGen"), track.mcParticle().pt(), 2.f * antihePt - track.mcParticle().pt());
+                    fillCost.fill(spectraGen, HIST("helium/histPtGenantiHe"), std::abs(track.mcParticle().pt()));
+                    fillCost.fill(spectraGen, HIST("helium/histPtRecantiHe"), 2.f * antihePt);
+                    fillCost.fill(spectraGen, HIST("helium/histPtShiftantiHe"), 2.f * antihePt, 2.f * antihePt - track.mcParticle().pt());
+                    fillCost.fill(spectraGen, HIST("helium/histPtShiftantiHeVsGen"), track.mcParticle().pt(), 2.f * antihePt - track.mcParticle().pt());
                     if (!heliumPID)
-                      spectraGen.fill(HIST("helium/histPtShiftantiHe_WrongPidAll"), 2.f * antihePt, 2.f * antihePt - track.mcParticle().pt());
+                      fillCost.fill(spectraGen, HIST("helium/histPtShiftantiHe_WrongPidAll"), 2.f * antihePt, 2.f * antihePt - track.mcParticle().pt());
                     if (tritonPID)
-                      spectraGen.fill(HIST("helium/histPtShiftantiHe_WrongPidTr"), 2.f * antihePt, 2.f * antihePt - track.mcParticle().pt());
+                      fillCost.fill(spectraGen, HIST("helium/histPtShiftantiHe_WrongPidTr"), 2.f * antihePt, 2.f * antihePt - track.mcParticle().pt());
                     if (deuteronPID)
-                      spectraGen.fill(HIST("helium/histPtShiftantiHe_WrongPidDe"), 2.f * antihePt, 2.f * antihePt - track.mcParticle().pt());
+                      fillCost.fill(spectraGen, HIST("helium/histPtShiftantiHe_WrongPidDe"), 2.f * antihePt, 2.f * antihePt - track.mcParticle().pt());
 
-                    spectraGen.fill(HIST("helium/histPtShiftVsEtaantiHe"), track.eta(), 2.f * antihePt - track.mcParticle().pt());
+                    fillCost.fill(spectraGen, HIST("helium/histPtShiftVsEtaantiHe"), track.eta(), 2.f * antihePt - track.mcParticle().pt());
                     if (track.hasTOF() && outFlagOptions.doTOFplots) {
-                      spectraGen.fill(HIST("helium/TOF/histPtShiftantiHe"), 2.f * antihePt, 2.f * antihePt - track.mcParticle().pt());
-                      spectraGen.fill(HIST("helium/TOF/histPtShiftantiHeVsGen"), track.mcParticle().pt(), 2.f * antihePt - track.mcParticle().pt());
+                      fillCost.fill(spectraGen, HIST("helium/TOF/histPtShiftantiHe"), 2.f * antihePt, 2.f * antihePt - track.mcParticle().pt());
+                      fillCost.fill(spectraGen, HIST("helium/TOF/histPtShiftantiHeVsGen"), track.mcParticle().pt(), 2.f * antihePt - track.mcParticle().pt());
                     }
-                    spectraGen.fill(HIST("helium/histPGenantiHe"), std::abs(track.mcParticle().p()));
-                    spectraGen.fill(HIST("helium/histPRecantiHe"), 2.f * antiheP);
-                    spectraGen.fill(HIST("helium/histPShiftantiHe"), 2.f * antiheP, 2.f * antiheP - track.mcParticle().p());
-                    spectraGen.fill(HIST("helium/histPShiftVsEtaantiHe"), track.eta(), 2.f * antiheP - track.mcParticle().p());
+                    fillCost.fill(spectraGen, HIST("helium/histPGenantiHe"), std::abs(track.mcParticle().p()));
+                    fillCost.fill(spectraGen, HIST("helium/histPRecantiHe"), 2.f * antiheP);
+                    fillCost.fill(spectraGen, HIST("helium/histPShiftantiHe"), 2.f * antiheP, 2.f * antiheP - track.mcParticle().p());
+                    fillCost.fill(spectraGen, HIST("helium/histPShiftVsEtaantiHe"), track.eta(), 2.f * antiheP - track.mcParticle().p());
                   }
                 }
               }
@@ -3915,30 +3921,30 @@ struct lfNucleiBATask {
             break;
           case PDGAlpha:
             if (enableAl && alRapCut && outFlagOptions.makeDCABeforeCutPlots && passDCAzCut) {
-              histos.fill(HIST("tracks/alpha/dca/before/hDCAxyVsPtAlphaTrue"), track.pt(), track.dcaXY());
+              fillCost.fill(histos, HIST("tracks/alpha/dca/before/hDCAxyVsPtAlphaTrue"), track.pt(), track.dcaXY());
               if (isPhysPrim) {
-                histos.fill(HIST("tracks/alpha/dca/before/hDCAxyVsPtAlphaTruePrim"), track.pt(), track.dcaXY());
+                fillCost.fill(histos, HIST("tracks/alpha/dca/before/hDCAxyVsPtAlphaTruePrim"), track.pt(), track.dcaXY());
               }
               if (!isPhysPrim && !isProdByGen) {
                 if (isWeakDecay) {
-                  histos.fill(HIST("tracks/alpha/dca/before/hDCAxyVsPtAlphaTrueSec"), track.pt(), track.dcaXY());
+                  fillCost.fill(histos, HIST("tracks/alpha/dca/before/hDCAxyVsPtAlphaTrueSec"), track.pt(), track.dcaXY());
                 } else {
-                  histos.fill(HIST("tracks/alpha/dca/before/hDCAxyVsPtAlphaTrueMaterial"), track.pt(), track.dcaXY());
+                  fillCost.fill(histos, HIST("tracks/alpha/dca/before/hDCAxyVsPtAlphaTrueMaterial"), track.pt(), track.dcaXY());
                 }
               }
             }
             break;
           case -PDGAlpha:
             if (enableAl && alRapCut && outFlagOptions.makeDCABeforeCutPlots && passDCAzCut) {
-              histos.fill(HIST("tracks/alpha/dca/before/hDCAxyVsPtantiAlphaTrue"), track.pt(), track.dcaXY());
+              fillCost.fill(histos, HIST("tracks/alpha/dca/before/hDCAxyVsPtantiAlphaTrue"), track.pt(), track.dcaXY());
               if (isPhysPrim) {
-                histos.fill(HIST("tracks/alpha/dca/before/hDCAxyVsPtantiAlphaTruePrim"), track.pt(), track.dcaXY());
+                fillCost.fill(histos, HIST("tracks/alpha/dca/before/hDCAxyVsPtantiAlphaTruePrim"), track.pt(), track.dcaXY());
               }
               if (!isPhysPrim && !isProdByGen) {
                 if (isWeakDecay) {
-                  histos.fill(HIST("tracks/alpha/dca/before/hDCAxyVsPtantiAlphaTrueSec"), track.pt(), track.dcaXY());
+                  fillCost.fill(histos, HIST("tracks/alpha/dca/before/hDCAxyVsPtantiAlphaTrueSec"), track.pt(), track.dcaXY());
                 } else {
-                  histos.fill(HIST("tracks/alpha/dca/before/hDCAxyVsPtantiAlphaTrueMaterial"), track.pt(), track.dcaXY());
+                  fillCost.fill(histos, HIST("tracks/alpha/dca/before/hDCAxyVsPtantiAlphaTrueMaterial"), track.pt(), track.dcaXY());
                 }
               }
             }
@@ -3953,31 +3959,31 @@ struct lfNucleiBATask {
           default:
             if (isDeWoDCAxyWTPCpid && outFlagOptions.makeFakeTracksPlots) {
               if (outFlagOptions.makeDCABeforeCutPlots) {
-                histos.fill(HIST("tracks/deuteron/dca/before/fake/hDCAxyVsPtDeuteronTrue"), DPt, track.dcaXY());
+                fillCost.fill(histos, HIST("tracks/deuteron/dca/before/fake/hDCAxyVsPtDeuteronTrue"), DPt, track.dcaXY());
                 if (track.hasTOF() && outFlagOptions.doTOFplots) {
-                  histos.fill(HIST("tracks/deuteron/dca/before/fake/TOF/hDCAxyVsPtDeuteronTrue"), DPt, track.dcaXY());
+                  fillCost.fill(histos, HIST("tracks/deuteron/dca/before/fake/TOF/hDCAxyVsPtDeuteronTrue"), DPt, track.dcaXY());
                 }
               }
               if (isPhysPrim) {
                 if (outFlagOptions.makeDCABeforeCutPlots) {
-                  histos.fill(HIST("tracks/deuteron/dca/before/fake/hDCAxyVsPtDeuteronTruePrim"), DPt, track.dcaXY());
+                  fillCost.fill(histos, HIST("tracks/deuteron/dca/before/fake/hDCAxyVsPtDeuteronTruePrim"), DPt, track.dcaXY());
                   if (track.hasTOF() && outFlagOptions.doTOFplots) {
-                    histos.fill(HIST("tracks/deuteron/dca/before/fake/TOF/hDCAxyVsPtDeuteronTruePrim"), DPt, track.dcaXY());
+                    fillCost.fill(histos, HIST("tracks/deuteron/dca/before/fake/TOF/hDCAxyVsPtDeuteronTruePrim"), DPt, track.dcaXY());
                   }
                 }
               }
               if (!isPhysPrim && !isProdByGen) {
                 if (outFlagOptions.makeDCABeforeCutPlots) {
                   if (isWeakDecay) {
-                    histos.fill(HIST("tracks/deuteron/dca/before/fake/hDCAxyVsPtDeuteronTrueSec"), DPt, track.dcaXY());
+                    fillCost.fill(histos, HIST("tracks/deuteron/dca/before/fake/hDCAxyVsPtDeuteronTrueSec"), DPt, track.dcaXY());
                   } else {
-                    histos.fill(HIST("tracks/deuteron/dca/before/fake/hDCAxyVsPtDeuteronTrueMaterial"), DPt, track.dcaXY());
+                    fillCost.fill(histos, HIST("tracks/deuteron/dca/before/fake/hDCAxyVsPtDeuteronTrueMaterial"), DPt, track.dcaXY());
                   }
                   if (track.hasTOF() && outFlagOptions.doTOFplots) {
                     if (isWeakDecay) {
-                      histos.fill(HIST("tracks/deuteron/dca/before/fake/TOF/hDCAxyVsPtDeuteronTrueSec"), DPt, track.dcaXY());
+                      fillCost.fill(histos, HIST("tracks/deuteron/dca/before/fake/TOF/hDCAxyVsPtDeuteronTrueSec"), DPt, track.dcaXY());
                     } else {
-                      histos.fill(HIST("tracks/deuteron/dca/before/fake/TOF/hDCAxyVsPtDeuteronTrueMaterial"), DPt, track.dcaXY());
+                      fillCost.fill(histos, HIST("tracks/deuteron/dca/before/fake/TOF/hDCAxyVsPtDeuteronTrueMaterial"), DPt, track.dcaXY());
                     }
                   }
                 }
@@ -3985,31 +3991,31 @@ struct lfNucleiBATask {
             }
             if (isAntiDeWoDCAxyWTPCpid && outFlagOptions.makeFakeTracksPlots) {
               if (outFlagOptions.makeDCABeforeCutPlots) {
-                histos.fill(HIST("tracks/deuteron/dca/before/fake/hDCAxyVsPtantiDeuteronTrue"), antiDPt, track.dcaXY());
+                fillCost.fill(histos, HIST("tracks/deuteron/dca/before/fake/hDCAxyVsPtantiDeuteronTrue"), antiDPt, track.dcaXY());
                 if (track.hasTOF() && outFlagOptions.doTOFplots) {
-                  histos.fill(HIST("tracks/deuteron/dca/before/fake/TOF/hDCAxyVsPtantiDeuteronTrue"), antiDPt, track.dcaXY());
+                  fillCost.fill(histos, HIST("tracks/deuteron/dca/before/fake/TOF/hDCAxyVsPtantiDeuteronTrue"), antiDPt, track.dcaXY());
                 }
               }
               if (isPhysPrim) {
                 if (outFlagOptions.makeDCABeforeCutPlots) {
-                  histos.fill(HIST("tracks/deuteron/dca/before/fake/hDCAxyVsPtantiDeuteronTruePrim"), antiDPt, track.dcaXY());
+                  fillCost.fill(histos, HIST("tracks/deuteron/dca/before/fake/hDCAxyVsPtantiDeuteronTruePrim"), antiDPt, track.dcaXY());
                   if (track.hasTOF() && outFlagOptions.doTOFplots) {
-                    histos.fill(HIST("tracks/deuteron/dca/before/fake/TOF/hDCAxyVsPtantiDeuteronTruePrim"), antiDPt, track.dcaXY());
+                    fillCost.fill(histos, HIST("tracks/deuteron/dca/before/fake/TOF/hDCAxyVsPtantiDeuteronTruePrim"), antiDPt, track.dcaXY());
                   }
                 }
               }
               if (!isPhysPrim && !isProdByGen) {
                 if (outFlagOptions.makeDCABeforeCutPlots) {
                   if (isWeakDecay) {
-                    histos.fill(HIST("tracks/deuteron/dca/before/fake/hDCAxyVsPtantiDeuteronTrueSec"), antiDPt, track.dcaXY());
+                    fillCost.fill(histos, HIST("tracks/deuteron/dca/before/fake/hDCAxyVsPtantiDeuteronTrueSec"), antiDPt, track.dcaXY());
                   } else {
-                    histos.fill(HIST("tracks/deuteron/dca/before/fake/hDCAxyVsPtantiDeuteronTrueMaterial"), antiDPt, track.dcaXY());
+                    fillCost.fill(histos, HIST("tracks/deuteron/dca/before/fake/hDCAxyVsPtantiDeuteronTrueMaterial"), antiDPt, track.dcaXY());
                   }
                   if (track.hasTOF() && outFlagOptions.doTOFplots) {
                     if (isWeakDecay) {
-                      histos.fill(HIST("tracks/deuteron/dca/before/fake/TOF/hDCAxyVsPtantiDeuteronTrueSec"), antiDPt, track.dcaXY());
+                      fillCost.fill(histos, HIST("tracks/deuteron/dca/before/fake/TOF/hDCAxyVsPtantiDeuteronTrueSec"), antiDPt, track.dcaXY());
                     } else {
-                      histos.fill(HIST("tracks/deuteron/dca/before/fake/TOF/hDCAxyVsPtantiDeuteronTrueMaterial"), antiDPt, track.dcaXY());
+                      fillCost.fill(histos, HIST("tracks/deuteron/dca/before/fake/TOF/hDCAxyVsPtantiDeuteronTrueMaterial"), antiDPt, track.dcaXY());
                     }
                   }
                 }
@@ -4025,27 +4031,27 @@ struct lfNucleiBATask {
           default:
             if (isHeWoDCAxyWTPCpid && outFlagOptions.makeFakeTracksPlots) {
               if (outFlagOptions.makeDCABeforeCutPlots) {
-                histos.fill(HIST("tracks/helium/dca/before/fake/hDCAxyVsPtHeliumTrue"), hePt, track.dcaXY());
+                fillCost.fill(histos, HIST("tracks/helium/dca/before/fake/hDCAxyVsPtHeliumTrue"), hePt, track.dcaXY());
                 if (track.hasTOF() && outFlagOptions.doTOFplots) {
-                  histos.fill(HIST("tracks/helium/dca/before/fake/TOF/hDCAxyVsPtHeliumTrue"), hePt, track.dcaXY());
+                  fillCost.fill(histos, HIST("tracks/helium/dca/before/fake/TOF/hDCAxyVsPtHeliumTrue"), hePt, track.dcaXY());
                 }
                 if (isPhysPrim) {
-                  histos.fill(HIST("tracks/helium/dca/before/fake/hDCAxyVsPtHeliumTruePrim"), hePt, track.dcaXY());
+                  fillCost.fill(histos, HIST("tracks/helium/dca/before/fake/hDCAxyVsPtHeliumTruePrim"), hePt, track.dcaXY());
                   if (track.hasTOF() && outFlagOptions.doTOFplots) {
-                    histos.fill(HIST("tracks/helium/dca/before/fake/TOF/hDCAxyVsPtHeliumTruePrim"), hePt, track.dcaXY());
+                    fillCost.fill(histos, HIST("tracks/helium/dca/before/fake/TOF/hDCAxyVsPtHeliumTruePrim"), hePt, track.dcaXY());
                   }
                 }
                 if (!isPhysPrim && !isProdByGen) {
                   if (isWeakDecay) {
-                    histos.fill(HIST("tracks/helium/dca/before/fake/hDCAxyVsPtHeliumTrueSec"), hePt, track.dcaXY());
+                    fillCost.fill(histos, HIST("tracks/helium/dca/before/fake/hDCAxyVsPtHeliumTrueSec"), hePt, track.dcaXY());
                   } else {
-                    histos.fill(HIST("tracks/helium/dca/before/fake/hDCAxyVsPtHeliumTrueMaterial"), hePt, track.dcaXY());
+                    fillCost.fill(histos, HIST("tracks/helium/dca/before/fake/hDCAxyVsPtHeliumTrueMaterial"), hePt, track.dcaXY());
                   }
                   if (track.hasTOF() && outFlagOptions.doTOFplots) {
                     if (isWeakDecay) {
-                      histos.fill(HIST("tracks/helium/dca/before/fake/TOF/hDCAxyVsPtHeliumTrueSec"), hePt, track.dcaXY());
+                      fillCost.fill(histos, HIST("tracks/helium/dca/before/fake/TOF/hDCAxyVsPtHeliumTrueSec"), hePt, track.dcaXY());
                     } else {
-                      histos.fill(HIST("tracks/helium/dca/before/fake/TOF/hDCAxyVsPtHeliumTrueMaterial"), hePt, track.dcaXY());
+                      fillCost.fill(histos, HIST("tracks/helium/dca/before/fake/TOF/hDCAxyVsPtHeliumTrueMaterial"), hePt, track.dcaXY());
                     }
                   }
                 }
@@ -4053,27 +4059,27 @@ struct lfNucleiBATask {
             }
             if (isAntiHeWoDCAxyWTPCpid && outFlagOptions.makeFakeTracksPlots) {
               if (outFlagOptions.makeDCABeforeCutPlots) {
-                histos.fill(HIST("tracks/helium/dca/before/fake/hDCAxyVsPtantiHeliumTrue"), antihePt, track.dcaXY());
+                fillCost.fill(histos, HIST("tracks/helium/dca/before/fake/hDCAxyVsPtantiHeliumTrue"), antihePt, track.dcaXY());
                 if (track.hasTOF() && outFlagOptions.doTOFplots) {
-                  histos.fill(HIST("tracks/helium/dca/before/fake/TOF/hDCAxyVsPtantiHeliumTrue"), antihePt, track.dcaXY());
+                  fillCost.fill(histos, HIST("tracks/helium/dca/before/fake/TOF/hDCAxyVsPtantiHeliumTrue"), antihePt, track.dcaXY());
                 }
                 if (isPhysPrim) {
-                  histos.fill(HIST("tracks/helium/dca/before/fake/hDCAxyVsPtantiHeliumTruePrim"), antihePt, track.dcaXY());
+                  fillCost.fill(histos, HIST("tracks/helium/dca/before/fake/hDCAxyVsPtantiHeliumTruePrim"), antihePt, track.dcaXY());
                   if (track.hasTOF() && outFlagOptions.doTOFplots) {
-                    histos.fill(HIST("tracks/helium/dca/before/fake/TOF/hDCAxyVsPtantiHeliumTruePrim"), antihePt, track.dcaXY());
+                    fillCost.fill(histos, HIST("tracks/helium/dca/before/fake/TOF/hDCAxyVsPtantiHeliumTruePrim"), antihePt, track.dcaXY());
                   }
                 }
                 if (!isPhysPrim && !isProdByGen) {
                   if (isWeakDecay) {
-                    histos.fill(HIST("tracks/helium/dca/before/fake/hDCAxyVsPtantiHeliumTrueSec"), antihePt, track.dcaXY());
+                    fillCost.fill(histos, HIST("tracks/helium/dca/before/fake/hDCAxyVsPtantiHeliumTrueSec"), antihePt, track.dcaXY());
                   } else {
-                    histos.fill(HIST("tracks/helium/dca/before/fake/hDCAxyVsPtantiHeliumTrueMaterial"), antihePt, track.dcaXY());
+                    fillCost.fill(histos, HIST("tracks/helium/dca/before/fake/hDCAxyVsPtantiHeliumTrueMaterial"), antihePt, track.dcaXY());
                   }
                   if (track.hasTOF() && outFlagOptions.doTOFplots) {
                     if (isWeakDecay) {
-                      histos.fill(HIST("tracks/helium/dca/before/fake/TOF/hDCAxyVsPtantiHeliumTrueSec"), antihePt, track.dcaXY());
+                      fillCost.fill(histos, HIST("tracks/helium/dca/before/fake/TOF/hDCAxyVsPtantiHeliumTrueSec"), antihePt, track.dcaXY());
                     } else {
-                      histos.fill(HIST("tracks/helium/dca/before/fake/TOF/hDCAxyVsPtantiHeliumTrueMaterial"), antihePt, track.dcaXY());
+                      fillCost.fill(histos, HIST("tracks/helium/dca/before/fake/TOF/hDCAxyVsPtantiHeliumTrueMaterial"), antihePt, track.dcaXY());
                     }
                   }
                 }
@@ -4104,80 +4110,80 @@ struct lfNucleiBATask {
 
       if (outFlagOptions.makeDCAAfterCutPlots) {
         if (isHeWTPCpid) {
-          histos.fill(HIST("tracks/helium/dca/after/hDCAxyVsDCAzVsPtHelium"), track.dcaXY(), track.dcaZ(), hePt);
-          histos.fill(HIST("tracks/helium/dca/after/h3DCAvsPtHelium"), track.dcaXY(), track.dcaZ(), hePt);
+          fillCost.fill(histos, HIST("tracks/helium/dca/after/hDCAxyVsDCAzVsPtHelium"), track.dcaXY(), track.dcaZ(), hePt);
+          fillCost.fill(histos, HIST("tracks/helium/dca/after/h3DCAvsPtHelium"), track.dcaXY(), track.dcaZ(), hePt);
           if (track.hasTOF() && outFlagOptions.doTOFplots) {
-            histos.fill(HIST("tracks/helium/dca/after/TOF/hDCAxyVsDCAzVsPtHelium"), track.dcaXY(), track.dcaZ(), hePt);
+            fillCost.fill(histos, HIST("tracks/helium/dca/after/TOF/hDCAxyVsDCAzVsPtHelium"), track.dcaXY(), track.dcaZ(), hePt);
           }
         }
         if (isAntiHeWTPCpid) {
-          histos.fill(HIST("tracks/helium/dca/after/hDCAxyVsDCAzVsPtantiHelium"), track.dcaXY(), track.dcaZ(), antihePt);
-          histos.fill(HIST("tracks/helium/dca/after/h3DCAvsPtantiHelium"), track.dcaXY(), track.dcaZ(), antihePt);
+          fillCost.fill(histos, HIST("tracks/helium/dca/after/hDCAxyVsDCAzVsPtantiHelium"), track.dcaXY(), track.dcaZ(), antihePt);
+          fillCost.fill(histos, HIST("tracks/helium/dca/after/h3DCAvsPtantiHelium"), track.dcaXY(), track.dcaZ(), antihePt);
           if (track.hasTOF() && outFlagOptions.doTOFplots) {
-            histos.fill(HIST("tracks/helium/dca/after/TOF/hDCAxyVsDCAzVsPtantiHelium"), track.dcaXY(), track.dcaZ(), antihePt);
+            fillCost.fill(histos, HIST("tracks/helium/dca/after/TOF/hDCAxyVsDCAzVsPtantiHelium"), track.dcaXY(), track.dcaZ(), antihePt);
           }
         }
 
         if (passDCAxyzCut) {
-          histos.fill(HIST("tracks/dca/after/hDCAxy"), track.dcaXY());
-          histos.fill(HIST("tracks/dca/after/hDCAz"), track.dcaZ());
-          histos.fill(HIST("tracks/dca/after/hDCAxyVsPt"), track.pt(), track.dcaXY());
-          histos.fill(HIST("tracks/dca/after/hDCAzVsPt"), track.pt(), track.dcaZ());
+          fillCost.fill(histos, HIST("tracks/dca/after/hDCAxy"), track.dcaXY());
+          fillCost.fill(histos, HIST("tracks/dca/after/hDCAz"), track.dcaZ());
+          fillCost.fill(histos, HIST("tracks/dca/after/hDCAxyVsPt"), track.pt(), track.dcaXY());
+          fillCost.fill(histos, HIST("tracks/dca/after/hDCAzVsPt"), track.pt(), track.dcaZ());
 
           if (enablePr && prRapCut && (std::abs(track.tpcNSigmaPr()) < nsigmaTPCvar.nsigmaTPCPr)) {
             if (track.sign() > 0) {
-              histos.fill(HIST("tracks/proton/dca/after/hDCAxyVsPtProton"), track.pt(), track.dcaXY());
-              histos.fill(HIST("tracks/proton/dca/after/hDCAzVsPtProton"), track.pt(), track.dcaZ());
+              fillCost.fill(histos, HIST("tracks/proton/dca/after/hDCAxyVsPtProton"), track.pt(), track.dcaXY());
+              fillCost.fill(histos, HIST("tracks/proton/dca/after/hDCAzVsPtProton"), track.pt(), track.dcaZ());
             } else {
-              histos.fill(HIST("tracks/proton/dca/after/hDCAxyVsPtantiProton"), track.pt(), track.dcaXY());
-              histos.fill(HIST("tracks/proton/dca/after/hDCAzVsPtantiProton"), track.pt(), track.dcaZ());
+              fillCost.fill(histos, HIST("tracks/proton/dca/after/hDCAxyVsPtantiProton"), track.pt(), track.dcaXY());
+              fillCost.fill(histos, HIST("tracks/proton/dca/after/hDCAzVsPtantiProton"), track.pt(), track.dcaZ());
             }
           }
           if (enableTr && trRapCut && isTritonTPCpid) {
             if (track.sign() > 0) {
-              histos.fill(HIST("tracks/triton/dca/after/hDCAxyVsPtTriton"), track.pt(), track.dcaXY());
-              histos.fill(HIST("tracks/triton/dca/after/hDCAzVsPtTriton"), track.pt(), track.dcaZ());
+              fillCost.fill(histos, HIST("tracks/triton/dca/after/hDCAxyVsPtTriton"), track.pt(), track.dcaXY());
+              fillCost.fill(histos, HIST("tracks/triton/dca/after/hDCAzVsPtTriton"), track.pt(), track.dcaZ());
             } else {
-              histos.fill(HIST("tracks/triton/dca/after/hDCAxyVsPtantiTriton"), track.pt(), track.dcaXY());
-              histos.fill(HIST("tracks/triton/dca/after/hDCAzVsPtantiTriton"), track.pt(), track.dcaZ());
+              fillCost.fill(histos, HIST("tracks/triton/dca/after/hDCAxyVsPtantiTriton"), track.pt(), track.dcaXY());
+              fillCost.fill(histos, HIST("tracks/triton/dca/after/hDCAzVsPtantiTriton"), track.pt(), track.dcaZ());
             }
           }
           if (enableAl && alRapCut && (std::abs(track.tpcNSigmaAl()) < nsigmaTPCvar.nsigmaTPCAl)) {
             if (track.sign() > 0) {
-              histos.fill(HIST("tracks/alpha/dca/after/hDCAxyVsPtAlpha"), track.pt(), track.dcaXY());
-              histos.fill(HIST("tracks/alpha/dca/after/hDCAzVsPtAlpha"), track.pt(), track.dcaZ());
+              fillCost.fill(histos, HIST("tracks/alpha/dca/after/hDCAxyVsPtAlpha"), track.pt(), track.dcaXY());
+              fillCost.fill(histos, HIST("tracks/alpha/dca/after/hDCAzVsPtAlpha"), track.pt(), track.dcaZ());
             } else {
-              histos.fill(HIST("tracks/alpha/dca/after/hDCAxyVsPtantiAlpha"), track.pt(), track.dcaXY());
-              histos.fill(HIST("tracks/alpha/dca/after/hDCAzVsPtantiAlpha"), track.pt(), track.dcaZ());
+              fillCost.fill(histos, HIST("tracks/alpha/dca/after/hDCAxyVsPtantiAlpha"), track.pt(), track.dcaXY());
+              fillCost.fill(histos, HIST("tracks/alpha/dca/after/hDCAzVsPtantiAlpha"), track.pt(), track.dcaZ());
             }
           }
         }
         if (isDeWTPCpid) {
           if (usenITSLayer && !itsClusterMap.test(trkqcOptions.nITSLayer))
             continue;
-          histos.fill(HIST("tracks/deuteron/dca/after/hDCAxyVsPtDeuteron"), DPt, track.dcaXY());
-          histos.fill(HIST("tracks/deuteron/dca/after/hDCAzVsPtDeuteron"), DPt, track.dcaZ());
+          fillCost.fill(histos, HIST("tracks/deuteron/dca/after/hDCAxyVsPtDeuteron"), DPt, track.dcaXY());
+          fillCost.fill(histos, HIST("tracks/deuteron/dca/after/hDCAzVsPtDeuteron"), DPt, track.dcaZ());
         }
         if (isAntiDeWTPCpid) {
           if (usenITSLayer && !itsClusterMap.test(trkqcOptions.nITSLayer))
             continue;
-          histos.fill(HIST("tracks/deuteron/dca/after/hDCAxyVsPtantiDeuteron"), antiDPt, track.dcaXY());
-          histos.fill(HIST("tracks/deuteron/dca/after/hDCAzVsPtantiDeuteron"), antiDPt, track.dcaZ());
+          fillCost.fill(histos, HIST("tracks/deuteron/dca/after/hDCAxyVsPtantiDeuteron"), antiDPt, track.dcaXY());
+          fillCost.fill(histos, HIST("tracks/deuteron/dca/after/hDCAzVsPtantiDeuteron"), antiDPt, track.dcaZ());
         }
         if (isHeWTPCpid) {
-          histos.fill(HIST("tracks/helium/dca/after/hDCAxyVsPtHelium"), hePt, track.dcaXY());
-          histos.fill(HIST("tracks/helium/dca/after/hDCAzVsPtHelium"), hePt, track.dcaZ());
+          fillCost.fill(histos, HIST("tracks/helium/dca/after/hDCAxyVsPtHelium"), hePt, track.dcaXY());
+          fillCost.fill(histos, HIST("tracks/helium/dca/after/hDCAzVsPtHelium"), hePt, track.dcaZ());
           if (track.hasTOF() && outFlagOptions.doTOFplots) {
-            histos.fill(HIST("tracks/helium/dca/after/TOF/hDCAxyVsPtHelium"), hePt, track.dcaXY());
-            histos.fill(HIST("tracks/helium/dca/after/TOF/hDCAzVsPtHelium"), hePt, track.dcaZ());
+            fillCost.fill(histos, HIST("tracks/helium/dca/after/TOF/hDCAxyVsPtHelium"), hePt, track.dcaXY());
+            fillCost.fill(histos, HIST("tracks/helium/dca/after/TOF/hDCAzVsPtHelium"), hePt, track.dcaZ());
           }
         }
         if (isAntiHeWTPCpid) {
-          histos.fill(HIST("tracks/helium/dca/after/hDCAxyVsPtantiHelium"), antihePt, track.dcaXY());
-          histos.fill(HIST("tracks/helium/dca/after/hDCAzVsPtantiHelium"), antihePt, track.dcaZ());
+          fillCost.fill(histos, HIST("tracks/helium/dca/after/hDCAxyVsPtantiHelium"), antihePt, track.dcaXY());
+          fillCost.fill(histos, HIST("tracks/helium/dca/after/hDCAzVsPtantiHelium"), antihePt, track.dcaZ());
           if (track.hasTOF() && outFlagOptions.doTOFplots) {
-            histos.fill(HIST("tracks/helium/dca/after/TOF/hDCAxyVsPtantiHelium"), antihePt, track.dcaXY());
-            histos.fill(HIST("tracks/helium/dca/after/TOF/hDCAzVsPtantiHelium"), antihePt, track.dcaZ());
+            fillCost.fill(histos, HIST("tracks/helium/dca/after/TOF/hDCAxyVsPtantiHelium"), antihePt, track.dcaXY());
+            fillCost.fill(histos, HIST("tracks/helium/dca/after/TOF/hDCAzVsPtantiHelium"), antihePt, track.dcaZ());
           }
         }
       }
@@ -4185,55 +4191,55 @@ struct lfNucleiBATask {
       if (passDCAxyzCut) {
         // QA histos fill
         if (enableDebug) {
-          histos.fill(HIST("qa/h1ITSncr"), track.itsNCls());
-          histos.fill(HIST("qa/h1TPCnfound"), track.tpcNClsFound());
-          histos.fill(HIST("qa/h1TPCncr"), track.tpcNClsCrossedRows());
-          histos.fill(HIST("qa/h1rTPC"), track.tpcCrossedRowsOverFindableCls());
-          histos.fill(HIST("qa/h1chi2ITS"), track.tpcChi2NCl());
-          histos.fill(HIST("qa/h1chi2TPC"), track.itsChi2NCl());
-          debugHistos.fill(HIST("debug/h2TPCsignVsTPCmomentum_AllTracks"), track.tpcInnerParam() / (1.f * track.sign()), track.tpcSignal());
+          fillCost.fill(histos, HIST("qa/h1ITSncr"), track.itsNCls());
+          fillCost.fill(histos, HIST("qa/h1TPCnfound"), track.tpcNClsFound());
+          fillCost.fill(histos, HIST("qa/h1TPCncr"), track.tpcNClsCrossedRows());
+          fillCost.fill(histos, HIST("qa/h1rTPC"), track.tpcCrossedRowsOverFindableCls());
+          fillCost.fill(histos, HIST("qa/h1chi2ITS"), track.tpcChi2NCl());
+          fillCost.fill(histos, HIST("qa/h1chi2TPC"), track.itsChi2NCl());
+          fillCost.fill(debugHistos, HIST("debug/h2TPCsignVsTPCmomentum_AllTracks"), track.tpcInnerParam() / (1.f * track.sign()), track.tpcSignal());
         }
 
         if (enableDebug) {
-          debugHistos.fill(HIST("debug/tracks/h1Eta"), track.eta());
-          debugHistos.fill(HIST("debug/tracks/h1VarPhi"), track.phi());
-          debugHistos.fill(HIST("debug/tracks/h2EtaVsPhi"), track.eta(), track.phi());
-          debugHistos.fill(HIST("debug/tracks/h2PionYvsPt"), track.rapidity(o2::track::PID::getMass2Z(o2::track::PID::Pion)), track.pt());
+          fillCost.fill(debugHistos, HIST("debug/tracks/h1Eta"), track.eta());
+          fillCost.fill(debugHistos, HIST("debug/tracks/h1VarPhi"), track.phi());
+          fillCost.fill(debugHistos, HIST("debug/tracks/h2EtaVsPhi"), track.eta(), track.phi());
+          fillCost.fill(debugHistos, HIST("debug/tracks/h2PionYvsPt"), track.rapidity(o2::track::PID::getMass2Z(o2::track::PID::Pion)), track.pt());
 
           if (track.sign() > 0) {
-            debugHistos.fill(HIST("debug/qa/h2TPCncrVsPtPos"), track.tpcInnerParam(), track.tpcNClsCrossedRows());
-            debugHistos.fill(HIST("debug/qa/h2TPCncrVsTPCsignalPos"), track.tpcSignal(), track.tpcNClsCrossedRows());
+            fillCost.fill(debugHistos, HIST("debug/qa/h2TPCncrVsPtPos"), track.tpcInnerParam(), track.tpcNClsCrossedRows());
+            fillCost.fill(debugHistos, HIST("debug/qa/h2TPCncrVsTPCsignalPos"), track.tpcSignal(), track.tpcNClsCrossedRows());
 
             if (track.tpcInnerParam() < CfgTpcClasses[0]) {
-              debugHistos.fill(HIST("debug/qa/h1TPCncrLowPPos"), track.tpcNClsCrossedRows());
+              fillCost.fill(debugHistos, HIST("debug/qa/h1TPCncrLowPPos"), track.tpcNClsCrossedRows());
             }
             if ((track.tpcInnerParam() >= CfgTpcClasses[0]) && (track.tpcInnerParam() < CfgTpcClasses[1])) {
-              debugHistos.fill(HIST("debug/qa/h1TPCncrMidPPos"), track.tpcNClsCrossedRows());
+              fillCost.fill(debugHistos, HIST("debug/qa/h1TPCncrMidPPos"), track.tpcNClsCrossedRows());
             }
             if (track.tpcInnerParam() >= CfgTpcClasses[1]) {
-              debugHistos.fill(HIST("debug/qa/h1TPCncrHighPPos"), track.tpcNClsCrossedRows());
+              fillCost.fill(debugHistos, HIST("debug/qa/h1TPCncrHighPPos"), track.tpcNClsCrossedRows());
             }
           } else {
-            debugHistos.fill(HIST("debug/qa/h2TPCncrVsPtNeg"), track.tpcInnerParam(), track.tpcNClsCrossedRows());
-            debugHistos.fill(HIST("debug/qa/h2TPCncrVsTPCsignalNeg"), track.tpcSignal(), track.tpcNClsCrossedRows());
+            fillCost.fill(debugHistos, HIST("debug/qa/h2TPCncrVsPtNeg"), track.tpcInnerParam(), track.tpcNClsCrossedRows());
+            fillCost.fill(debugHistos, HIST("debug/qa/h2TPCncrVsTPCsignalNeg"), track.tpcSignal(), track.tpcNClsCrossedRows());
 
             if (track.tpcInnerParam() < CfgTpcClasses[0]) {
-              debugHistos.fill(HIST("debug/qa/h1TPCncrLowPNeg"), track.tpcNClsCrossedRows());
+              fillCost.fill(debugHistos, HIST("debug/qa/h1TPCncrLowPNeg"), track.tpcNClsCrossedRows());
             }
             if ((track.tpcInnerParam() >= CfgTpcClasses[0]) && (track.tpcInnerParam() < CfgTpcClasses[1])) {
-              debugHistos.fill(HIST("debug/qa/h1TPCncrMidPNeg"), track.tpcNClsCrossedRows());
+              fillCost.fill(debugHistos, HIST("debug/qa/h1TPCncrMidPNeg"), track.tpcNClsCrossedRows());
             }
             if (track.tpcInnerParam() >= CfgTpcClasses[1]) {
-              debugHistos.fill(HIST("debug/qa/h1TPCncrHighPNeg"), track.tpcNClsCrossedRows());
+              fillCost.fill(debugHistos, HIST("debug/qa/h1TPCncrHighPNeg"), track.tpcNClsCrossedRows());
             }
           }
 
-          debugHistos.fill(HIST("debug/tracks/pion/h2PionVspTNSigmaTPC"), track.pt(), track.tpcNSigmaPi());
-          debugHistos.fill(HIST("debug/tracks/kaon/h2KaonVspTNSigmaTPC"), track.pt(), track.tpcNSigmaKa());
+          fillCost.fill(debugHistos, HIST("debug/tracks/pion/h2PionVspTNSigmaTPC"), track.pt(), track.tpcNSigmaPi());
+          fillCost.fill(debugHistos, HIST("debug/tracks/kaon/h2KaonVspTNSigmaTPC"), track.pt(), track.tpcNSigmaKa());
         }
 
         if (outFlagOptions.enableEffPlots)
-          histos.fill(HIST("tracks/eff/h2pVsTPCmomentum"), track.tpcInnerParam(), track.p());
+          fillCost.fill(histos, HIST("tracks/eff/h2pVsTPCmomentum"), track.tpcInnerParam(), track.p());
 
         if (filterOptions.enableFiltering) {
           if (track.tpcNSigmaKa() < CfgKaonCut)
@@ -4241,225 +4247,225 @@ struct lfNucleiBATask {
         }
 
         if (outFlagOptions.enablePIDplot)
-          histos.fill(HIST("tracks/h2TPCsignVsTPCmomentum"), track.tpcInnerParam() / (1.f * track.sign()), track.tpcSignal());
+          fillCost.fill(histos, HIST("tracks/h2TPCsignVsTPCmomentum"), track.tpcInnerParam() / (1.f * track.sign()), track.tpcSignal());
 
         if constexpr (!IsFilteredData) {
           if (nsigmaITSvar.showAverageClusterSize && outFlagOptions.enablePIDplot) {
-            histos.fill(HIST("tracks/averageClusterSize"), track.p(), averageClusterSizeTrk(track));
-            histos.fill(HIST("tracks/averageClusterSizePerCoslInv"), track.p(), averageClusterSizePerCoslInv(track));
+            fillCost.fill(histos, HIST("tracks/averageClusterSize"), track.p(), averageClusterSizeTrk(track));
+            fillCost.fill(histos, HIST("tracks/averageClusterSizePerCoslInv"), track.p(), averageClusterSizePerCoslInv(track));
           }
         }
 
         if (track.sign() > 0) {
           if (enablePr && prRapCut) {
             if (outFlagOptions.enableExpSignalTPC)
-              histos.fill(HIST("tracks/proton/h2ProtonTPCExpSignalDiffVsPt"), track.pt(), track.tpcExpSignalDiffPr());
+              fillCost.fill(histos, HIST("tracks/proton/h2ProtonTPCExpSignalDiffVsPt"), track.pt(), track.tpcExpSignalDiffPr());
 
             switch (useHasTRDConfig) {
               case 0:
-                histos.fill(HIST("tracks/proton/h2ProtonVspTNSigmaTPC"), track.pt(), track.tpcNSigmaPr());
+                fillCost.fill(histos, HIST("tracks/proton/h2ProtonVspTNSigmaTPC"), track.pt(), track.tpcNSigmaPr());
                 break;
               case 1:
                 if (track.hasTRD()) {
-                  histos.fill(HIST("tracks/proton/h2ProtonVspTNSigmaTPC"), track.pt(), track.tpcNSigmaPr());
+                  fillCost.fill(histos, HIST("tracks/proton/h2ProtonVspTNSigmaTPC"), track.pt(), track.tpcNSigmaPr());
                 }
                 break;
               case 2:
                 if (!track.hasTRD()) {
-                  histos.fill(HIST("tracks/proton/h2ProtonVspTNSigmaTPC"), track.pt(), track.tpcNSigmaPr());
+                  fillCost.fill(histos, HIST("tracks/proton/h2ProtonVspTNSigmaTPC"), track.pt(), track.tpcNSigmaPr());
                 }
                 break;
             }
           }
           if (enableTr && trRapCut) {
-            histos.fill(HIST("tracks/triton/h2TritonVspTNSigmaTPC"), track.pt(), track.tpcNSigmaTr());
+            fillCost.fill(histos, HIST("tracks/triton/h2TritonVspTNSigmaTPC"), track.pt(), track.tpcNSigmaTr());
           }
           if (enableAl && alRapCut) {
-            histos.fill(HIST("tracks/alpha/h2AlphaVspTNSigmaTPC"), track.pt(), track.tpcNSigmaAl());
+            fillCost.fill(histos, HIST("tracks/alpha/h2AlphaVspTNSigmaTPC"), track.pt(), track.tpcNSigmaAl());
           }
         } else {
           if (enablePr && prRapCut) {
             if (outFlagOptions.enableExpSignalTPC)
-              histos.fill(HIST("tracks/proton/h2antiProtonTPCExpSignalDiffVsPt"), track.pt(), track.tpcExpSignalDiffPr());
+              fillCost.fill(histos, HIST("tracks/proton/h2antiProtonTPCExpSignalDiffVsPt"), track.pt(), track.tpcExpSignalDiffPr());
             switch (useHasTRDConfig) {
               case 0:
-                histos.fill(HIST("tracks/proton/h2antiProtonVspTNSigmaTPC"), track.pt(), track.tpcNSigmaPr());
+                fillCost.fill(histos, HIST("tracks/proton/h2antiProtonVspTNSigmaTPC"), track.pt(), track.tpcNSigmaPr());
                 break;
               case 1:
                 if (track.hasTRD()) {
-                  histos.fill(HIST("tracks/proton/h2antiProtonVspTNSigmaTPC"), track.pt(), track.tpcNSigmaPr());
+                  fillCost.fill(histos, HIST("tracks/proton/h2antiProtonVspTNSigmaTPC"), track.pt(), track.tpcNSigmaPr());
                 }
                 break;
               case 2:
                 if (!track.hasTRD()) {
-                  histos.fill(HIST("tracks/proton/h2antiProtonVspTNSigmaTPC"), track.pt(), track.tpcNSigmaPr());
+                  fillCost.fill(histos, HIST("tracks/proton/h2antiProtonVspTNSigmaTPC"), track.pt(), track.tpcNSigmaPr());
                 }
                 break;
             }
           }
           if (enableTr && trRapCut) {
-            histos.fill(HIST("tracks/triton/h2antiTritonVspTNSigmaTPC"), track.pt(), track.tpcNSigmaTr());
+            fillCost.fill(histos, HIST("tracks/triton/h2antiTritonVspTNSigmaTPC"), track.pt(), track.tpcNSigmaTr());
           }
           if (enableAl && alRapCut) {
-            histos.fill(HIST("tracks/alpha/h2antiAlphaVspTNSigmaTPC"), track.pt(), track.tpcNSigmaAl());
+            fillCost.fill(histos, HIST("tracks/alpha/h2antiAlphaVspTNSigmaTPC"), track.pt(), track.tpcNSigmaAl());
           }
         }
 
         //  TOF
         if (outFlagOptions.doTOFplots) {
           if (enableDebug) {
-            histos.fill(HIST("tracks/pion/h2PionVspTNSigmaTOF"), track.pt(), track.tofNSigmaPi());
-            histos.fill(HIST("tracks/kaon/h2KaonVspTNSigmaTOF"), track.pt(), track.tofNSigmaKa());
+            fillCost.fill(histos, HIST("tracks/pion/h2PionVspTNSigmaTOF"), track.pt(), track.tofNSigmaPi());
+            fillCost.fill(histos, HIST("tracks/kaon/h2KaonVspTNSigmaTOF"), track.pt(), track.tofNSigmaKa());
           }
           if (track.sign() > 0) {
             if (enablePr && prRapCut) {
 
               switch (useHasTRDConfig) {
                 case 0:
-                  histos.fill(HIST("tracks/proton/h2ProtonVspTNSigmaTOF"), track.pt(), track.tofNSigmaPr());
+                  fillCost.fill(histos, HIST("tracks/proton/h2ProtonVspTNSigmaTOF"), track.pt(), track.tofNSigmaPr());
                   break;
                 case 1:
                   if (track.hasTRD()) {
-                    histos.fill(HIST("tracks/proton/h2ProtonVspTNSigmaTOF"), track.pt(), track.tofNSigmaPr());
+                    fillCost.fill(histos, HIST("tracks/proton/h2ProtonVspTNSigmaTOF"), track.pt(), track.tofNSigmaPr());
                   }
                   break;
                 case 2:
                   if (!track.hasTRD()) {
-                    histos.fill(HIST("tracks/proton/h2ProtonVspTNSigmaTOF"), track.pt(), track.tofNSigmaPr());
+                    fillCost.fill(histos, HIST("tracks/proton/h2ProtonVspTNSigmaTOF"), track.pt(), track.tofNSigmaPr());
                   }
                   break;
               }
               if (outFlagOptions.enableExpSignalTOF)
-                histos.fill(HIST("tracks/proton/h2ProtonTOFExpSignalDiffVsPt"), track.pt(), track.tofExpSignalDiffPr());
+                fillCost.fill(histos, HIST("tracks/proton/h2ProtonTOFExpSignalDiffVsPt"), track.pt(), track.tofExpSignalDiffPr());
             }
 
             if (filterOptions.enableEvTimeSplitting && track.hasTOF()) {
               if (track.isEvTimeTOF() && track.isEvTimeT0AC()) {
                 if (enablePr)
-                  evtimeHistos.fill(HIST("tracks/evtime/ft0tof/proton/h2ProtonVspTNSigmaTOF"), track.pt(), track.tofNSigmaPr());
+                  fillCost.fill(evtimeHistos, HIST("tracks/evtime/ft0tof/proton/h2ProtonVspTNSigmaTOF"), track.pt(), track.tofNSigmaPr());
                 if (enableDe)
-                  evtimeHistos.fill(HIST("tracks/evtime/ft0tof/deuteron/h2DeuteronVspTNSigmaTOF"), DPt, track.tofNSigmaDe());
+                  fillCost.fill(evtimeHistos, HIST("tracks/evtime/ft0tof/deuteron/h2DeuteronVspTNSigmaTOF"), DPt, track.tofNSigmaDe());
                 if (outFlagOptions.enableExpSignalTOF) {
                   if (enablePr)
-                    evtimeHistos.fill(HIST("tracks/evtime/ft0tof/proton/h2ProtonTOFExpSignalDiffVsPt"), track.pt(), track.tofExpSignalDiffPr());
+                    fillCost.fill(evtimeHistos, HIST("tracks/evtime/ft0tof/proton/h2ProtonTOFExpSignalDiffVsPt"), track.pt(), track.tofExpSignalDiffPr());
                   if (enableDe)
-                    evtimeHistos.fill(HIST("tracks/evtime/ft0tof/deuteron/h2DeuteronTOFExpSignalDiffVsPt"), DPt, track.tofExpSignalDiffDe());
+                    fillCost.fill(evtimeHistos, HIST("tracks/evtime/ft0tof/deuteron/h2DeuteronTOFExpSignalDiffVsPt"), DPt, track.tofExpSignalDiffDe());
                 }
                 if (enablePr)
-                  evtimeHistos.fill(HIST("tracks/evtime/ft0tof/proton/h3ProtonNSigmaTPCvsNSigmaTOFvsPt"), track.tpcNSigmaPr(), track.tofNSigmaPr(), track.pt());
+                  fillCost.fill(evtimeHistos, HIST("tracks/evtime/ft0tof/proton/h3ProtonNSigmaTPCvsNSigmaTOFvsPt"), track.tpcNSigmaPr(), track.tofNSigmaPr(), track.pt());
                 if (enableDe)
-                  evtimeHistos.fill(HIST("tracks/evtime/ft0tof/deuteron/h3DeuteronNSigmaTPCvsNSigmaTOFvsPt"), track.tpcNSigmaDe(), track.tofNSigmaDe(), DPt);
+                  fillCost.fill(evtimeHistos, HIST("tracks/evtime/ft0tof/deuteron/h3DeuteronNSigmaTPCvsNSigmaTOFvsPt"), track.tpcNSigmaDe(), track.tofNSigmaDe(), DPt);
                 if (enableDebug && (track.beta() > cfgBetaCut)) {
                   if (enablePr)
-                    debugHistos.fill(HIST("debug/evtime/ft0tof/proton/h2ProtonVspTNSigmaTPC_BetaCut"), track.pt(), track.tpcNSigmaPr());
+                    fillCost.fill(debugHistos, HIST("debug/evtime/ft0tof/proton/h2ProtonVspTNSigmaTPC_BetaCut"), track.pt(), track.tpcNSigmaPr());
                   if (enableDe)
-                    debugHistos.fill(HIST("debug/evtime/ft0tof/deuteron/h2DeuteronVspTNSigmaTPC_BetaCut"), DPt, track.tpcNSigmaDe());
+                    fillCost.fill(debugHistos, HIST("debug/evtime/ft0tof/deuteron/h2DeuteronVspTNSigmaTPC_BetaCut"), DPt, track.tpcNSigmaDe());
 
                   if (enablePr)
-                    debugHistos.fill(HIST("debug/evtime/ft0tof/proton/h2ProtonVspTNSigmaTOF_BetaCut"), track.pt(), track.tofNSigmaPr());
+                    fillCost.fill(debugHistos, HIST("debug/evtime/ft0tof/proton/h2ProtonVspTNSigmaTOF_BetaCut"), track.pt(), track.tofNSigmaPr());
                   if (enableDe)
-                    debugHistos.fill(HIST("debug/evtime/ft0tof/deuteron/h2DeuteronVspTNSigmaTOF_BetaCut"), DPt, track.tofNSigmaDe());
+                    fillCost.fill(debugHistos, HIST("debug/evtime/ft0tof/deuteron/h2DeuteronVspTNSigmaTOF_BetaCut"), DPt, track.tofNSigmaDe());
                   if (outFlagOptions.enableExpSignalTOF) {
-                    debugHistos.fill(HIST("debug/evtime/ft0tof/proton/h2ProtonTOFExpSignalDiffVsPt_BetaCut"), track.pt(), track.tofExpSignalDiffPr());
+                    fillCost.fill(debugHistos, HIST("debug/evtime/ft0tof/proton/h2ProtonTOFExpSignalDiffVsPt_BetaCut"), track.pt(), track.tofExpSignalDiffPr());
                     if (enableDe)
-                      debugHistos.fill(HIST("debug/evtime/ft0tof/deuteron/h2DeuteronTOFExpSignalDiffVsPt_BetaCut"), DPt, track.tofExpSignalDiffDe());
+                      fillCost.fill(debugHistos, HIST("debug/evtime/ft0tof/deuteron/h2DeuteronTOFExpSignalDiffVsPt_BetaCut"), DPt, track.tofExpSignalDiffDe());
                   }
                 }
               } else if (track.isEvTimeT0AC()) {
                 if (enablePr)
-                  evtimeHistos.fill(HIST("tracks/evtime/ft0/proton/h2ProtonVspTNSigmaTOF"), track.pt(), track.tofNSigmaPr());
+                  fillCost.fill(evtimeHistos, HIST("tracks/evtime/ft0/proton/h2ProtonVspTNSigmaTOF"), track.pt(), track.tofNSigmaPr());
                 if (enableDe)
-                  evtimeHistos.fill(HIST("tracks/evtime/ft0/deuteron/h2DeuteronVspTNSigmaTOF"), DPt, track.tofNSigmaDe());
+                  fillCost.fill(evtimeHistos, HIST("tracks/evtime/ft0/deuteron/h2DeuteronVspTNSigmaTOF"), DPt, track.tofNSigmaDe());
                 if (outFlagOptions.enableExpSignalTOF) {
                   if (enablePr)
-                    evtimeHistos.fill(HIST("tracks/evtime/ft0/proton/h2ProtonTOFExpSignalDiffVsPt"), track.pt(), track.tofExpSignalDiffPr());
+                    fillCost.fill(evtimeHistos, HIST("tracks/evtime/ft0/proton/h2ProtonTOFExpSignalDiffVsPt"), track.pt(), track.tofExpSignalDiffPr());
                   if (enableDe)
-                    evtimeHistos.fill(HIST("tracks/evtime/ft0/deuteron/h2DeuteronTOFExpSignalDiffVsPt"), DPt, track.tofExpSignalDiffDe());
+                    fillCost.fill(evtimeHistos, HIST("tracks/evtime/ft0/deuteron/h2DeuteronTOFExpSignalDiffVsPt"), DPt, track.tofExpSignalDiffDe());
                 }
                 if (enablePr)
-                  evtimeHistos.fill(HIST("tracks/evtime/ft0/proton/h3ProtonNSigmaTPCvsNSigmaTOFvsPt"), track.tpcNSigmaPr(), track.tofNSigmaPr(), track.pt());
+                  fillCost.fill(evtimeHistos, HIST("tracks/evtime/ft0/proton/h3ProtonNSigmaTPCvsNSigmaTOFvsPt"), track.tpcNSigmaPr(), track.tofNSigmaPr(), track.pt());
                 if (enableDe)
-                  evtimeHistos.fill(HIST("tracks/evtime/ft0/deuteron/h3DeuteronNSigmaTPCvsNSigmaTOFvsPt"), track.tpcNSigmaDe(), track.tofNSigmaDe(), DPt);
+                  fillCost.fill(evtimeHistos, HIST("tracks/evtime/ft0/deuteron/h3DeuteronNSigmaTPCvsNSigmaTOFvsPt"), track.tpcNSigmaDe(), track.tofNSigmaDe(), DPt);
                 if (enableDebug && (track.beta() > cfgBetaCut)) {
                   if (enablePr)
-                    debugHistos.fill(HIST("debug/evtime/ft0/proton/h2ProtonVspTNSigmaTPC_BetaCut"), track.pt(), track.tpcNSigmaPr());
+                    fillCost.fill(debugHistos, HIST("debug/evtime/ft0/proton/h2ProtonVspTNSigmaTPC_BetaCut"), track.pt(), track.tpcNSigmaPr());
                   if (enableDe)
-                    debugHistos.fill(HIST("debug/evtime/ft0/deuteron/h2DeuteronVspTNSigmaTPC_BetaCut"), DPt, track.tpcNSigmaDe());
+                    fillCost.fill(debugHistos, HIST("debug/evtime/ft0/deuteron/h2DeuteronVspTNSigmaTPC_BetaCut"), DPt, track.tpcNSigmaDe());
                   if (enablePr)
-                    debugHistos.fill(HIST("debug/evtime/ft0/proton/h2ProtonVspTNSigmaTOF_BetaCut"), track.pt(), track.tofNSigmaPr());
+                    fillCost.fill(debugHistos, HIST("debug/evtime/ft0/proton/h2ProtonVspTNSigmaTOF_BetaCut"), track.pt(), track.tofNSigmaPr());
                   if (enableDe)
-                    debugHistos.fill(HIST("debug/evtime/ft0/deuteron/h2DeuteronVspTNSigmaTOF_BetaCut"), DPt, track.tofNSigmaDe());
+                    fillCost.fill(debugHistos, HIST("debug/evtime/ft0/deuteron/h2DeuteronVspTNSigmaTOF_BetaCut"), DPt, track.tofNSigmaDe());
                   if (outFlagOptions.enableExpSignalTOF) {
                     if (enablePr)
-                      debugHistos.fill(HIST("debug/evtime/ft0/proton/h2ProtonTOFExpSignalDiffVsPt_BetaCut"), track.pt(), track.tofExpSignalDiffPr());
+                      fillCost.fill(debugHistos, HIST("debug/evtime/ft0/proton/h2ProtonTOFExpSignalDiffVsPt_BetaCut"), track.pt(), track.tofExpSignalDiffPr());
                     if (enableDe)
-                      debugHistos.fill(HIST("debug/evtime/ft0/deuteron/h2DeuteronTOFExpSignalDiffVsPt_BetaCut"), DPt, track.tofExpSignalDiffDe());
+                      fillCost.fill(debugHistos, HIST("debug/evtime/ft0/deuteron/h2DeuteronTOFExpSignalDiffVsPt_BetaCut"), DPt, track.tofExpSignalDiffDe());
                   }
                 }
               } else if (track.isEvTimeTOF()) {
                 if (enablePr)
-                  evtimeHistos.fill(HIST("tracks/evtime/tof/proton/h2ProtonVspTNSigmaTOF"), track.pt(), track.tofNSigmaPr());
+                  fillCost.fill(evtimeHistos, HIST("tracks/evtime/tof/proton/h2ProtonVspTNSigmaTOF"), track.pt(), track.tofNSigmaPr());
                 if (enableDe)
-                  evtimeHistos.fill(HIST("tracks/evtime/tof/deuteron/h2DeuteronVspTNSigmaTOF"), DPt, track.tofNSigmaDe());
+                  fillCost.fill(evtimeHistos, HIST("tracks/evtime/tof/deuteron/h2DeuteronVspTNSigmaTOF"), DPt, track.tofNSigmaDe());
                 if (outFlagOptions.enableExpSignalTOF) {
                   if (enablePr)
-                    evtimeHistos.fill(HIST("tracks/evtime/tof/proton/h2ProtonTOFExpSignalDiffVsPt"), track.pt(), track.tofExpSignalDiffPr());
+                    fillCost.fill(evtimeHistos, HIST("tracks/evtime/tof/proton/h2ProtonTOFExpSignalDiffVsPt"), track.pt(), track.tofExpSignalDiffPr());
                   if (enableDe)
-                    evtimeHistos.fill(HIST("tracks/evtime/tof/deuteron/h2DeuteronTOFExpSignalDiffVsPt"), DPt, track.tofExpSignalDiffDe());
+                    fillCost.fill(evtimeHistos, HIST("tracks/evtime/tof/deuteron/h2DeuteronTOFExpSignalDiffVsPt"), DPt, track.tofExpSignalDiffDe());
                 }
                 if (enablePr)
-                  evtimeHistos.fill(HIST("tracks/evtime/tof/proton/h3ProtonNSigmaTPCvsNSigmaTOFvsPt"), track.tpcNSigmaPr(), track.tofNSigmaPr(), track.pt());
+                  fillCost.fill(evtimeHistos, HIST("tracks/evtime/tof/proton/h3ProtonNSigmaTPCvsNSigmaTOFvsPt"), track.tpcNSigmaPr(), track.tofNSigmaPr(), track.pt());
                 if (enableDe)
-                  evtimeHistos.fill(HIST("tracks/evtime/tof/deuteron/h3DeuteronNSigmaTPCvsNSigmaTOFvsPt"), track.tpcNSigmaDe(), track.tofNSigmaDe(), DPt);
+                  fillCost.fill(evtimeHistos, HIST("tracks/evtime/tof/deuteron/h3DeuteronNSigmaTPCvsNSigmaTOFvsPt"), track.tpcNSigmaDe(), track.tofNSigmaDe(), DPt);
                 if (enableDebug && (track.beta() > cfgBetaCut)) {
                   if (enablePr)
-                    debugHistos.fill(HIST("debug/evtime/tof/proton/h2ProtonVspTNSigmaTPC_BetaCut"), track.pt(), track.tpcNSigmaPr());
+                    fillCost.fill(debugHistos, HIST("debug/evtime/tof/proton/h2ProtonVspTNSigmaTPC_BetaCut"), track.pt(), track.tpcNSigmaPr());
                   if (enableDe)
-                    debugHistos.fill(HIST("debug/evtime/tof/deuteron/h2DeuteronVspTNSigmaTPC_BetaCut"), DPt, track.tpcNSigmaDe());
+                    fillCost.fill(debugHistos, HIST("debug/evtime/tof/deuteron/h2DeuteronVspTNSigmaTPC_BetaCut"), DPt, track.tpcNSigmaDe());
 
                   if (enablePr)
-                    debugHistos.fill(HIST("debug/evtime/tof/proton/h2ProtonVspTNSigmaTOF_BetaCut"), track.pt(), track.tofNSigmaPr());
+                    fillCost.fill(debugHistos, HIST("debug/evtime/tof/proton/h2ProtonVspTNSigmaTOF_BetaCut"), track.pt(), track.tofNSigmaPr());
                   if (enableDe)
-                    debugHistos.fill(HIST("debug/evtime/tof/deuteron/h2DeuteronVspTNSigmaTOF_BetaCut"), DPt, track.tofNSigmaDe());
+                    fillCost.fill(debugHistos, HIST("debug/evtime/tof/deuteron/h2DeuteronVspTNSigmaTOF_BetaCut"), DPt, track.tofNSigmaDe());
 
                   if (outFlagOptions.enableExpSignalTOF) {
                     if (enablePr)
-                      debugHistos.fill(HIST("debug/evtime/tof/proton/h2ProtonTOFExpSignalDiffVsPt_BetaCut"), track.pt(), track.tofExpSignalDiffPr());
+                      fillCost.fill(debugHistos, HIST("debug/evtime/tof/proton/h2ProtonTOFExpSignalDiffVsPt_BetaCut"), track.pt(), track.tofExpSignalDiffPr());
                     if (enableDe)
-                      debugHistos.fill(HIST("debug/evtime/tof/deuteron/h2DeuteronTOFExpSignalDiffVsPt_BetaCut"), DPt, track.tofExpSignalDiffDe());
+                      fillCost.fill(debugHistos, HIST("debug/evtime/tof/deuteron/h2DeuteronTOFExpSignalDiffVsPt_BetaCut"), DPt, track.tofExpSignalDiffDe());
                   }
                 }
               } else {
                 if (enablePr)
-                  evtimeHistos.fill(HIST("tracks/evtime/fill/proton/h2ProtonVspTNSigmaTOF"), track.pt(), track.tofNSigmaPr());
+                  fillCost.fill(evtimeHistos, HIST("tracks/evtime/fill/proton/h2ProtonVspTNSigmaTOF"), track.pt(), track.tofNSigmaPr());
                 if (enableDe)
-                  evtimeHistos.fill(HIST("tracks/evtime/fill/deuteron/h2DeuteronVspTNSigmaTOF"), DPt, track.tofNSigmaDe());
+                  fillCost.fill(evtimeHistos, HIST("tracks/evtime/fill/deuteron/h2DeuteronVspTNSigmaTOF"), DPt, track.tofNSigmaDe());
                 if (outFlagOptions.enableExpSignalTOF) {
                   if (enablePr)
-                    evtimeHistos.fill(HIST("tracks/evtime/fill/proton/h2ProtonTOFExpSignalDiffVsPt"), track.pt(), track.tofExpSignalDiffPr());
+                    fillCost.fill(evtimeHistos, HIST("tracks/evtime/fill/proton/h2ProtonTOFExpSignalDiffVsPt"), track.pt(), track.tofExpSignalDiffPr());
                   if (enableDe)
-                    evtimeHistos.fill(HIST("tracks/evtime/fill/deuteron/h2DeuteronTOFExpSignalDiffVsPt"), DPt, track.tofExpSignalDiffDe());
+                    fillCost.fill(evtimeHistos, HIST("tracks/evtime/fill/deuteron/h2DeuteronTOFExpSignalDiffVsPt"), DPt, track.tofExpSignalDiffDe());
                 }
                 if (enablePr)
-                  evtimeHistos.fill(HIST("tracks/evtime/fill/proton/h3ProtonNSigmaTPCvsNSigmaTOFvsPt"), track.tpcNSigmaPr(), track.tofNSigmaPr(), track.pt());
+                  fillCost.fill(evtimeHistos, HIST("tracks/evtime/fill/proton/h3ProtonNSigmaTPCvsNSigmaTOFvsPt"), track.tpcNSigmaPr(), track.tofNSigmaPr(), track.pt());
                 if (enableDe)
-                  evtimeHistos.fill(HIST("tracks/evtime/fill/deuteron/h3DeuteronNSigmaTPCvsNSigmaTOFvsPt"), track.tpcNSigmaDe(), track.tofNSigmaDe(), DPt);
+                  fillCost.fill(evtimeHistos, HIST("tracks/evtime/fill/deuteron/h3DeuteronNSigmaTPCvsNSigmaTOFvsPt"), track.tpcNSigmaDe(), track.tofNSigmaDe(), DPt);
                 if (enableDebug && (track.beta() > cfgBetaCut)) {
                   if (enablePr)
-                    debugHistos.fill(HIST("debug/evtime/fill/proton/h2ProtonVspTNSigmaTPC_BetaCut"), track.pt(), track.tpcNSigmaPr());
+                    fillCost.fill(debugHistos, HIST("debug/evtime/fill/proton/h2ProtonVspTNSigmaTPC_BetaCut"), track.pt(), track.tpcNSigmaPr());
                   if (enableDe)
-                    debugHistos.fill(HIST("debug/evtime/fill/deuteron/h2DeuteronVspTNSigmaTPC_BetaCut"), DPt, track.tpcNSigmaDe());
+                    fillCost.fill(debugHistos, HIST("debug/evtime/fill/deuteron/h2DeuteronVspTNSigmaTPC_BetaCut"), DPt, track.tpcNSigmaDe());
 
                   if (enablePr)
-                    debugHistos.fill(HIST("debug/evtime/fill/proton/h2ProtonVspTNSigmaTOF_BetaCut"), track.pt(), track.tofNSigmaPr());
+                    fillCost.fill(debugHistos, HIST("debug/evtime/fill/proton/h2ProtonVspTNSigmaTOF_BetaCut"), track.pt(), track.tofNSigmaPr());
                   if (enableDe)
-                    debugHistos.fill(HIST("debug/evtime/fill/deuteron/h2DeuteronVspTNSigmaTOF_BetaCut"), DPt, track.tofNSigmaDe());
+                    fillCost.fill(debugHistos, HIST("debug/evtime/fill/deuteron/h2DeuteronVspTNSigmaTOF_BetaCut"), DPt, track.tofNSigmaDe());
 
                   if (outFlagOptions.enableExpSignalTOF) {
                     if (enablePr)
-                      debugHistos.fill(HIST("debug/evtime/fill/proton/h2ProtonTOFExpSignalDiffVsPt_BetaCut"), track.pt(), track.tofExpSignalDiffPr());
+                      fillCost.fill(debugHistos, HIST("debug/evtime/fill/proton/h2ProtonTOFExpSignalDiffVsPt_BetaCut"), track.pt(), track.tofExpSignalDiffPr());
                     if (enableDe)
-                      debugHistos.fill(HIST("debug/evtime/fill/deuteron/h2DeuteronTOFExpSignalDiffVsPt_BetaCut"), DPt, track.tofExpSignalDiffDe());
+                      fillCost.fill(debugHistos, HIST("debug/evtime/fill/deuteron/h2DeuteronTOFExpSignalDiffVsPt_BetaCut"), DPt, track.tofExpSignalDiffDe());
                   }
                 }
               }
@@ -4468,139 +4474,139 @@ struct lfNucleiBATask {
             if (enablePr && prRapCut) {
               switch (useHasTRDConfig) {
                 case 0:
-                  histos.fill(HIST("tracks/proton/h2antiProtonVspTNSigmaTOF"), track.pt(), track.tofNSigmaPr());
+                  fillCost.fill(histos, HIST("tracks/proton/h2antiProtonVspTNSigmaTOF"), track.pt(), track.tofNSigmaPr());
                   break;
                 case 1:
                   if (track.hasTRD()) {
-                    histos.fill(HIST("tracks/proton/h2antiProtonVspTNSigmaTOF"), track.pt(), track.tofNSigmaPr());
+                    fillCost.fill(histos, HIST("tracks/proton/h2antiProtonVspTNSigmaTOF"), track.pt(), track.tofNSigmaPr());
                   }
                   break;
                 case 2:
                   if (!track.hasTRD()) {
-                    histos.fill(HIST("tracks/proton/h2antiProtonVspTNSigmaTOF"), track.pt(), track.tofNSigmaPr());
+                    fillCost.fill(histos, HIST("tracks/proton/h2antiProtonVspTNSigmaTOF"), track.pt(), track.tofNSigmaPr());
                   }
                   break;
               }
               if (outFlagOptions.enableExpSignalTOF)
-                histos.fill(HIST("tracks/proton/h2antiProtonTOFExpSignalDiffVsPt"), track.pt(), track.tofExpSignalDiffPr());
+                fillCost.fill(histos, HIST("tracks/proton/h2antiProtonTOFExpSignalDiffVsPt"), track.pt(), track.tofExpSignalDiffPr());
             }
             if (filterOptions.enableEvTimeSplitting && track.hasTOF()) {
               if (track.isEvTimeTOF() && track.isEvTimeT0AC()) {
                 if (enablePr)
-                  evtimeHistos.fill(HIST("tracks/evtime/ft0tof/proton/h2antiProtonVspTNSigmaTOF"), track.pt(), track.tofNSigmaPr());
+                  fillCost.fill(evtimeHistos, HIST("tracks/evtime/ft0tof/proton/h2antiProtonVspTNSigmaTOF"), track.pt(), track.tofNSigmaPr());
                 if (enableDe)
-                  evtimeHistos.fill(HIST("tracks/evtime/ft0tof/deuteron/h2antiDeuteronVspTNSigmaTOF"), antiDPt, track.tofNSigmaDe());
+                  fillCost.fill(evtimeHistos, HIST("tracks/evtime/ft0tof/deuteron/h2antiDeuteronVspTNSigmaTOF"), antiDPt, track.tofNSigmaDe());
                 if (outFlagOptions.enableExpSignalTOF) {
                   if (enablePr)
-                    evtimeHistos.fill(HIST("tracks/evtime/ft0tof/proton/h2antiProtonTOFExpSignalDiffVsPt"), track.pt(), track.tofExpSignalDiffPr());
+                    fillCost.fill(evtimeHistos, HIST("tracks/evtime/ft0tof/proton/h2antiProtonTOFExpSignalDiffVsPt"), track.pt(), track.tofExpSignalDiffPr());
                   if (enableDe)
-                    evtimeHistos.fill(HIST("tracks/evtime/ft0tof/deuteron/h2antiDeuteronTOFExpSignalDiffVsPt"), antiDPt, track.tofExpSignalDiffDe());
+                    fillCost.fill(evtimeHistos, HIST("tracks/evtime/ft0tof/deuteron/h2antiDeuteronTOFExpSignalDiffVsPt"), antiDPt, track.tofExpSignalDiffDe());
                 }
                 if (enablePr)
-                  evtimeHistos.fill(HIST("tracks/evtime/ft0tof/proton/h3antiProtonNSigmaTPCvsNSigmaTOFvsPt"), track.tpcNSigmaPr(), track.tofNSigmaPr(), track.pt());
+                  fillCost.fill(evtimeHistos, HIST("tracks/evtime/ft0tof/proton/h3antiProtonNSigmaTPCvsNSigmaTOFvsPt"), track.tpcNSigmaPr(), track.tofNSigmaPr(), track.pt());
                 if (enableDe)
-                  evtimeHistos.fill(HIST("tracks/evtime/ft0tof/deuteron/h3antiDeuteronNSigmaTPCvsNSigmaTOFvsPt"), track.tpcNSigmaDe(), track.tofNSigmaDe(), antiDPt);
+                  fillCost.fill(evtimeHistos, HIST("tracks/evtime/ft0tof/deuteron/h3antiDeuteronNSigmaTPCvsNSigmaTOFvsPt"), track.tpcNSigmaDe(), track.tofNSigmaDe(), antiDPt);
                 if (enableDebug && (track.beta() > cfgBetaCut)) {
                   if (enablePr)
-                    debugHistos.fill(HIST("debug/evtime/ft0tof/proton/h2antiProtonVspTNSigmaTPC_BetaCut"), track.pt(), track.tpcNSigmaPr());
+                    fillCost.fill(debugHistos, HIST("debug/evtime/ft0tof/proton/h2antiProtonVspTNSigmaTPC_BetaCut"), track.pt(), track.tpcNSigmaPr());
                   if (enableDe)
-                    debugHistos.fill(HIST("debug/evtime/ft0tof/deuteron/h2antiDeuteronVspTNSigmaTPC_BetaCut"), antiDPt, track.tpcNSigmaDe());
+                    fillCost.fill(debugHistos, HIST("debug/evtime/ft0tof/deuteron/h2antiDeuteronVspTNSigmaTPC_BetaCut"), antiDPt, track.tpcNSigmaDe());
                   if (enablePr)
-                    debugHistos.fill(HIST("debug/evtime/ft0tof/proton/h2antiProtonVspTNSigmaTOF_BetaCut"), track.pt(), track.tofNSigmaPr());
+                    fillCost.fill(debugHistos, HIST("debug/evtime/ft0tof/proton/h2antiProtonVspTNSigmaTOF_BetaCut"), track.pt(), track.tofNSigmaPr());
                   if (enableDe)
-                    debugHistos.fill(HIST("debug/evtime/ft0tof/deuteron/h2antiDeuteronVspTNSigmaTOF_BetaCut"), antiDPt, track.tofNSigmaDe());
+                    fillCost.fill(debugHistos, HIST("debug/evtime/ft0tof/deuteron/h2antiDeuteronVspTNSigmaTOF_BetaCut"), antiDPt, track.tofNSigmaDe());
 
                   if (outFlagOptions.enableExpSignalTOF) {
                     if (enablePr)
-                      debugHistos.fill(HIST("debug/evtime/ft0tof/proton/h2antiProtonTOFExpSignalDiffVsPt_BetaCut"), track.pt(), track.tofExpSignalDiffPr());
+                      fillCost.fill(debugHistos, HIST("debug/evtime/ft0tof/proton/h2antiProtonTOFExpSignalDiffVsPt_BetaCut"), track.pt(), track.tofExpSignalDiffPr());
                     if (enableDe)
-                      debugHistos.fill(HIST("debug/evtime/ft0tof/deuteron/h2antiDeuteronTOFExpSignalDiffVsPt_BetaCut"), antiDPt, track.tofExpSignalDiffDe());
+                      fillCost.fill(debugHistos, HIST("debug/evtime/ft0tof/deuteron/h2antiDeuteronTOFExpSignalDiffVsPt_BetaCut"), antiDPt, track.tofExpSignalDiffDe());
                   }
                 }
               } else if (track.isEvTimeT0AC()) {
                 if (enablePr)
-                  evtimeHistos.fill(HIST("tracks/evtime/ft0/proton/h2antiProtonVspTNSigmaTOF"), track.pt(), track.tofNSigmaPr());
+                  fillCost.fill(evtimeHistos, HIST("tracks/evtime/ft0/proton/h2antiProtonVspTNSigmaTOF"), track.pt(), track.tofNSigmaPr());
                 if (enableDe)
-                  evtimeHistos.fill(HIST("tracks/evtime/ft0/deuteron/h2antiDeuteronVspTNSigmaTOF"), antiDPt, track.tofNSigmaDe());
+                  fillCost.fill(evtimeHistos, HIST("tracks/evtime/ft0/deuteron/h2antiDeuteronVspTNSigmaTOF"), antiDPt, track.tofNSigmaDe());
                 if (outFlagOptions.enableExpSignalTOF) {
                   if (enablePr)
-                    evtimeHistos.fill(HIST("tracks/evtime/ft0/proton/h2antiProtonTOFExpSignalDiffVsPt"), track.pt(), track.tofExpSignalDiffPr());
+                    fillCost.fill(evtimeHistos, HIST("tracks/evtime/ft0/proton/h2antiProtonTOFExpSignalDiffVsPt"), track.pt(), track.tofExpSignalDiffPr());
                   if (enableDe)
-                    evtimeHistos.fill(HIST("tracks/evtime/ft0/deuteron/h2antiDeuteronTOFExpSignalDiffVsPt"), antiDPt, track.tofExpSignalDiffDe());
+                    fillCost.fill(evtimeHistos, HIST("tracks/evtime/ft0/deuteron/h2antiDeuteronTOFExpSignalDiffVsPt"), antiDPt, track.tofExpSignalDiffDe());
                   if (enablePr)
-                    evtimeHistos.fill(HIST("tracks/evtime/ft0/proton/h3antiProtonNSigmaTPCvsNSigmaTOFvsPt"), track.tpcNSigmaPr(), track.tofNSigmaPr(), track.pt());
+                    fillCost.fill(evtimeHistos, HIST("tracks/evtime/ft0/proton/h3antiProtonNSigmaTPCvsNSigmaTOFvsPt"), track.tpcNSigmaPr(), track.tofNSigmaPr(), track.pt());
                   if (enablePr)
-                    debugHistos.fill(HIST("debug/evtime/ft0/proton/h2antiProtonVspTNSigmaTPC_BetaCut"), track.pt(), track.tpcNSigmaPr());
+                    fillCost.fill(debugHistos, HIST("debug/evtime/ft0/proton/h2antiProtonVspTNSigmaTPC_BetaCut"), track.pt(), track.tpcNSigmaPr());
                   if (enableDe)
-                    debugHistos.fill(HIST("debug/evtime/ft0/deuteron/h2antiDeuteronVspTNSigmaTPC_BetaCut"), antiDPt, track.tpcNSigmaDe());
+                    fillCost.fill(debugHistos, HIST("debug/evtime/ft0/deuteron/h2antiDeuteronVspTNSigmaTPC_BetaCut"), antiDPt, track.tpcNSigmaDe());
                   if (enablePr)
-                    debugHistos.fill(HIST("debug/evtime/ft0/proton/h2antiProtonVspTNSigmaTOF_BetaCut"), track.pt(), track.tofNSigmaPr());
+                    fillCost.fill(debugHistos, HIST("debug/evtime/ft0/proton/h2antiProtonVspTNSigmaTOF_BetaCut"), track.pt(), track.tofNSigmaPr());
                   if (enableDe)
-                    debugHistos.fill(HIST("debug/evtime/ft0/deuteron/h2antiDeuteronVspTNSigmaTOF_BetaCut"), antiDPt, track.tofNSigmaDe());
+                    fillCost.fill(debugHistos, HIST("debug/evtime/ft0/deuteron/h2antiDeuteronVspTNSigmaTOF_BetaCut"), antiDPt, track.tofNSigmaDe());
 
                   if (outFlagOptions.enableExpSignalTOF) {
                     if (enablePr)
-                      debugHistos.fill(HIST("debug/evtime/ft0/proton/h2antiProtonTOFExpSignalDiffVsPt_BetaCut"), track.pt(), track.tofExpSignalDiffPr());
+                      fillCost.fill(debugHistos, HIST("debug/evtime/ft0/proton/h2antiProtonTOFExpSignalDiffVsPt_BetaCut"), track.pt(), track.tofExpSignalDiffPr());
                     if (enableDe)
-                      debugHistos.fill(HIST("debug/evtime/ft0/deuteron/h2antiDeuteronTOFExpSignalDiffVsPt_BetaCut"), antiDPt, track.tofExpSignalDiffDe());
+                      fillCost.fill(debugHistos, HIST("debug/evtime/ft0/deuteron/h2antiDeuteronTOFExpSignalDiffVsPt_BetaCut"), antiDPt, track.tofExpSignalDiffDe());
                   }
                 }
               } else if (track.isEvTimeTOF()) {
                 if (enablePr)
-                  evtimeHistos.fill(HIST("tracks/evtime/tof/proton/h2antiProtonVspTNSigmaTOF"), track.pt(), track.tofNSigmaPr());
+                  fillCost.fill(evtimeHistos, HIST("tracks/evtime/tof/proton/h2antiProtonVspTNSigmaTOF"), track.pt(), track.tofNSigmaPr());
                 if (enableDe)
-                  evtimeHistos.fill(HIST("tracks/evtime/tof/deuteron/h2antiDeuteronVspTNSigmaTOF"), antiDPt, track.tofNSigmaDe());
+                  fillCost.fill(evtimeHistos, HIST("tracks/evtime/tof/deuteron/h2antiDeuteronVspTNSigmaTOF"), antiDPt, track.tofNSigmaDe());
                 if (outFlagOptions.enableExpSignalTOF) {
                   if (enablePr)
-                    evtimeHistos.fill(HIST("tracks/evtime/tof/proton/h2antiProtonTOFExpSignalDiffVsPt"), track.pt(), track.tofExpSignalDiffPr());
+                    fillCost.fill(evtimeHistos, HIST("tracks/evtime/tof/proton/h2antiProtonTOFExpSignalDiffVsPt"), track.pt(), track.tofExpSignalDiffPr());
                   if (enableDe)
-                    evtimeHistos.fill(HIST("tracks/evtime/tof/deuteron/h2antiDeuteronTOFExpSignalDiffVsPt"), antiDPt, track.tofExpSignalDiffDe());
+                    fillCost.fill(evtimeHistos, HIST("tracks/evtime/tof/deuteron/h2antiDeuteronTOFExpSignalDiffVsPt"), antiDPt, track.tofExpSignalDiffDe());
                   if (enablePr)
-                    evtimeHistos.fill(HIST("tracks/evtime/tof/proton/h3antiProtonNSigmaTPCvsNSigmaTOFvsPt"), track.tpcNSigmaPr(), track.tofNSigmaPr(), track.pt());
+                    fillCost.fill(evtimeHistos, HIST("tracks/evtime/tof/proton/h3antiProtonNSigmaTPCvsNSigmaTOFvsPt"), track.tpcNSigmaPr(), track.tofNSigmaPr(), track.pt());
                   if (enablePr)
-                    debugHistos.fill(HIST("debug/evtime/tof/proton/h2antiProtonVspTNSigmaTPC_BetaCut"), track.pt(), track.tpcNSigmaPr());
+                    fillCost.fill(debugHistos, HIST("debug/evtime/tof/proton/h2antiProtonVspTNSigmaTPC_BetaCut"), track.pt(), track.tpcNSigmaPr());
                   if (enableDe)
-                    debugHistos.fill(HIST("debug/evtime/tof/deuteron/h2antiDeuteronVspTNSigmaTPC_BetaCut"), antiDPt, track.tpcNSigmaDe());
+                    fillCost.fill(debugHistos, HIST("debug/evtime/tof/deuteron/h2antiDeuteronVspTNSigmaTPC_BetaCut"), antiDPt, track.tpcNSigmaDe());
 
                   if (enablePr)
-                    debugHistos.fill(HIST("debug/evtime/tof/proton/h2antiProtonVspTNSigmaTOF_BetaCut"), track.pt(), track.tofNSigmaPr());
+                    fillCost.fill(debugHistos, HIST("debug/evtime/tof/proton/h2antiProtonVspTNSigmaTOF_BetaCut"), track.pt(), track.tofNSigmaPr());
                   if (enableDe)
-                    debugHistos.fill(HIST("debug/evtime/tof/deuteron/h2antiDeuteronVspTNSigmaTOF_BetaCut"), antiDPt, track.tofNSigmaDe());
+                    fillCost.fill(debugHistos, HIST("debug/evtime/tof/deuteron/h2antiDeuteronVspTNSigmaTOF_BetaCut"), antiDPt, track.tofNSigmaDe());
 
                   if (outFlagOptions.enableExpSignalTOF) {
                     if (enablePr)
-                      debugHistos.fill(HIST("debug/evtime/tof/proton/h2antiProtonTOFExpSignalDiffVsPt_BetaCut"), track.pt(), track.tofExpSignalDiffPr());
+                      fillCost.fill(debugHistos, HIST("debug/evtime/tof/proton/h2antiProtonTOFExpSignalDiffVsPt_BetaCut"), track.pt(), track.tofExpSignalDiffPr());
                     if (enableDe)
-                      debugHistos.fill(HIST("debug/evtime/tof/deuteron/h2antiDeuteronTOFExpSignalDiffVsPt_BetaCut"), antiDPt, track.tofExpSignalDiffDe());
+                      fillCost.fill(debugHistos, HIST("debug/evtime/tof/deuteron/h2antiDeuteronTOFExpSignalDiffVsPt_BetaCut"), antiDPt, track.tofExpSignalDiffDe());
                   }
                 }
               } else {
                 if (enablePr)
-                  evtimeHistos.fill(HIST("tracks/evtime/fill/proton/h2antiProtonVspTNSigmaTOF"), track.pt(), track.tofNSigmaPr());
+                  fillCost.fill(evtimeHistos, HIST("tracks/evtime/fill/proton/h2antiProtonVspTNSigmaTOF"), track.pt(), track.tofNSigmaPr());
                 if (enableDe)
-                  evtimeHistos.fill(HIST("tracks/evtime/fill/deuteron/h2antiDeuteronVspTNSigmaTOF"), antiDPt, track.tofNSigmaDe());
+                  fillCost.fill(evtimeHistos, HIST("tracks/evtime/fill/deuteron/h2antiDeuteronVspTNSigmaTOF"), antiDPt, track.tofNSigmaDe());
                 if (outFlagOptions.enableExpSignalTOF) {
                   if (enablePr)
-                    evtimeHistos.fill(HIST("tracks/evtime/fill/proton/h2antiProtonTOFExpSignalDiffVsPt"), track.pt(), track.tofExpSignalDiffPr());
+                    fillCost.fill(evtimeHistos, HIST("tracks/evtime/fill/proton/h2antiProtonTOFExpSignalDiffVsPt"), track.pt(), track.tofExpSignalDiffPr());
                   if (enableDe)
-                    evtimeHistos.fill(HIST("tracks/evtime/fill/deuteron/h2antiDeuteronTOFExpSignalDiffVsPt"), antiDPt, track.tofExpSignalDiffDe());
+                    fillCost.fill(evtimeHistos, HIST("tracks/evtime/fill/deuteron/h2antiDeuteronTOFExpSignalDiffVsPt"), antiDPt, track.tofExpSignalDiffDe());
                   if (enablePr)
-                    evtimeHistos.fill(HIST("tracks/evtime/fill/proton/h3antiProtonNSigmaTPCvsNSigmaTOFvsPt"), track.tpcNSigmaPr(), track.tofNSigmaPr(), track.pt());
+                    fillCost.fill(evtimeHistos, HIST("tracks/evtime/fill/proton/h3antiProtonNSigmaTPCvsNSigmaTOFvsPt"), track.tpcNSigmaPr(), track.tofNSigmaPr(), track.pt());
                   if (enablePr)
-                    debugHistos.fill(HIST("debug/evtime/fill/proton/h2antiProtonVspTNSigmaTPC_BetaCut"), track.pt(), track.tpcNSigmaPr());
+                    fillCost.fill(debugHistos, HIST("debug/evtime/fill/proton/h2antiProtonVspTNSigmaTPC_BetaCut"), track.pt(), track.tpcNSigmaPr());
                   if (enableDe)
-                    debugHistos.fill(HIST("debug/evtime/fill/deuteron/h2antiDeuteronVspTNSigmaTPC_BetaCut"), antiDPt, track.tpcNSigmaDe());
+                    fillCost.fill(debugHistos, HIST("debug/evtime/fill/deuteron/h2antiDeuteronVspTNSigmaTPC_BetaCut"), antiDPt, track.tpcNSigmaDe());
 
                   if (enablePr)
-                    debugHistos.fill(HIST("debug/evtime/fill/proton/h2antiProtonVspTNSigmaTOF_BetaCut"), track.pt(), track.tofNSigmaPr());
+                    fillCost.fill(debugHistos, HIST("debug/evtime/fill/proton/h2antiProtonVspTNSigmaTOF_BetaCut"), track.pt(), track.tofNSigmaPr());
                   if (enableDe)
-                    debugHistos.fill(HIST("debug/evtime/fill/deuteron/h2antiDeuteronVspTNSigmaTOF_BetaCut"), antiDPt, track.tofNSigmaDe());
+                    fillCost.fill(debugHistos, HIST("debug/evtime/fill/deuteron/h2antiDeuteronVspTNSigmaTOF_BetaCut"), antiDPt, track.tofNSigmaDe());
 
                   if (outFlagOptions.enableExpSignalTOF) {
                     if (enablePr)
-                      debugHistos.fill(HIST("debug/evtime/fill/proton/h2antiProtonTOFExpSignalDiffVsPt_BetaCut"), track.pt(), track.tofExpSignalDiffPr());
+                      fillCost.fill(debugHistos, HIST("debug/evtime/fill/proton/h2antiProtonTOFExpSignalDiffVsPt_BetaCut"), track.pt(), track.tofExpSignalDiffPr());
                     if (enableDe)
-                      debugHistos.fill(HIST("debug/evtime/fill/deuteron/h2antiDeuteronTOFExpSignalDiffVsPt_BetaCut"), antiDPt, track.tofExpSignalDiffDe());
+                      fillCost.fill(debugHistos, HIST("debug/evtime/fill/deuteron/h2antiDeuteronTOFExpSignalDiffVsPt_BetaCut"), antiDPt, track.tofExpSignalDiffDe());
                   }
                 }
               }
@@ -4611,50 +4617,50 @@ struct lfNucleiBATask {
 
       if (isDeWoTPCpid) {
         if (outFlagOptions.enableExpSignalTPC)
-          histos.fill(HIST("tracks/deuteron/h2DeuteronTPCExpSignalDiffVsPt"), DPt, track.tpcExpSignalDiffDe());
+          fillCost.fill(histos, HIST("tracks/deuteron/h2DeuteronTPCExpSignalDiffVsPt"), DPt, track.tpcExpSignalDiffDe());
 
-        histos.fill(HIST("tracks/deuteron/h2DeuteronVspNSigmaITSDe"), track.p(), nITSDe);
+        fillCost.fill(histos, HIST("tracks/deuteron/h2DeuteronVspNSigmaITSDe"), track.p(), nITSDe);
 
         switch (useHasTRDConfig) {
           case 0:
             if (enableCentrality)
-              histos.fill(HIST("tracks/deuteron/h3DeuteronVspTNSigmaTPCVsMult"), DPt, track.tpcNSigmaDe(), centFT0M);
+              fillCost.fill(histos, HIST("tracks/deuteron/h3DeuteronVspTNSigmaTPCVsMult"), DPt, track.tpcNSigmaDe(), centFT0M);
             else
-              histos.fill(HIST("tracks/deuteron/h2DeuteronVspTNSigmaTPC"), DPt, track.tpcNSigmaDe());
+              fillCost.fill(histos, HIST("tracks/deuteron/h2DeuteronVspTNSigmaTPC"), DPt, track.tpcNSigmaDe());
             break;
           case 1:
             if (track.hasTRD() && !enableCentrality) {
-              histos.fill(HIST("tracks/deuteron/h2DeuteronVspTNSigmaTPC"), DPt, track.tpcNSigmaDe());
+              fillCost.fill(histos, HIST("tracks/deuteron/h2DeuteronVspTNSigmaTPC"), DPt, track.tpcNSigmaDe());
             }
             break;
           case 2:
             if (!track.hasTRD() && !enableCentrality) {
-              histos.fill(HIST("tracks/deuteron/h2DeuteronVspTNSigmaTPC"), DPt, track.tpcNSigmaDe());
+              fillCost.fill(histos, HIST("tracks/deuteron/h2DeuteronVspTNSigmaTPC"), DPt, track.tpcNSigmaDe());
             }
             break;
         }
       }
       if (isAntiDeWoTPCpid) {
         if (outFlagOptions.enableExpSignalTPC)
-          histos.fill(HIST("tracks/deuteron/h2antiDeuteronTPCExpSignalDiffVsPt"), antiDPt, track.tpcExpSignalDiffDe());
+          fillCost.fill(histos, HIST("tracks/deuteron/h2antiDeuteronTPCExpSignalDiffVsPt"), antiDPt, track.tpcExpSignalDiffDe());
 
-        histos.fill(HIST("tracks/deuteron/h2antiDeuteronVspNSigmaITSDe"), track.p(), nITSDe);
+        fillCost.fill(histos, HIST("tracks/deuteron/h2antiDeuteronVspNSigmaITSDe"), track.p(), nITSDe);
 
         switch (useHasTRDConfig) {
           case 0:
             if (enableCentrality)
-              histos.fill(HIST("tracks/deuteron/h3antiDeuteronVspTNSigmaTPCVsMult"), antiDPt, track.tpcNSigmaDe(), centFT0M);
+              fillCost.fill(histos, HIST("tracks/deuteron/h3antiDeuteronVspTNSigmaTPCVsMult"), antiDPt, track.tpcNSigmaDe(), centFT0M);
             else
-              histos.fill(HIST("tracks/deuteron/h2antiDeuteronVspTNSigmaTPC"), antiDPt, track.tpcNSigmaDe());
+              fillCost.fill(histos, HIST("tracks/deuteron/h2antiDeuteronVspTNSigmaTPC"), antiDPt, track.tpcNSigmaDe());
             break;
           case 1:
             if (track.hasTRD() && !enableCentrality) {
-              histos.fill(HIST("tracks/deuteron/h2antiDeuteronVspTNSigmaTPC"), antiDPt, track.tpcNSigmaDe());
+              fillCost.fill(histos, HIST("tracks/deuteron/h2antiDeuteronVspTNSigmaTPC"), antiDPt, track.tpcNSigmaDe());
             }
             break;
           case 2:
             if (!track.hasTRD() && !enableCentrality) {
-              histos.fill(HIST("tracks/deuteron/h2antiDeuteronVspTNSigmaTPC"), antiDPt, track.tpcNSigmaDe());
+              fillCost.fill(histos, HIST("tracks/deuteron/h2antiDeuteronVspTNSigmaTPC"), antiDPt, track.tpcNSigmaDe());
             }
             break;
         }
@@ -4662,31 +4668,31 @@ struct lfNucleiBATask {
 
       if (isHeWoTPCpid) {
         if (outFlagOptions.enableExpSignalTPC)
-          histos.fill(HIST("tracks/helium/h2HeliumTPCExpSignalDiffVsPt"), hePt, track.tpcExpSignalDiffHe());
-        histos.fill(HIST("tracks/helium/h2HeliumVspTNSigmaITSHe"), track.p(), nITSHe);
-        histos.fill(HIST("tracks/helium/h2HeliumVspTNSigmaTPC"), hePt, track.tpcNSigmaHe());
+          fillCost.fill(histos, HIST("tracks/helium/h2HeliumTPCExpSignalDiffVsPt"), hePt, track.tpcExpSignalDiffHe());
+        fillCost.fill(histos, HIST("tracks/helium/h2HeliumVspTNSigmaITSHe"), track.p(), nITSHe);
+        fillCost.fill(histos, HIST("tracks/helium/h2HeliumVspTNSigmaTPC"), hePt, track.tpcNSigmaHe());
         if (enableCentrality)
-          histos.fill(HIST("tracks/helium/h3HeliumVspTNSigmaTPCVsMult"), hePt, track.tpcNSigmaHe(), centFT0M);
+          fillCost.fill(histos, HIST("tracks/helium/h3HeliumVspTNSigmaTPCVsMult"), hePt, track.tpcNSigmaHe(), centFT0M);
       }
       if (isAntiHeWoTPCpid) {
         if (outFlagOptions.enableExpSignalTPC)
-          histos.fill(HIST("tracks/helium/h2antiHeliumTPCExpSignalDiffVsPt"), antihePt, track.tpcExpSignalDiffHe());
-        histos.fill(HIST("tracks/helium/h2antiHeliumVspTNSigmaITSHe"), track.p(), nITSHe);
-        histos.fill(HIST("tracks/helium/h2antiHeliumVspTNSigmaTPC"), antihePt, track.tpcNSigmaHe());
+          fillCost.fill(histos, HIST("tracks/helium/h2antiHeliumTPCExpSignalDiffVsPt"), antihePt, track.tpcExpSignalDiffHe());
+        fillCost.fill(histos, HIST("tracks/helium/h2antiHeliumVspTNSigmaITSHe"), track.p(), nITSHe);
+        fillCost.fill(histos, HIST("tracks/helium/h2antiHeliumVspTNSigmaTPC"), antihePt, track.tpcNSigmaHe());
         if (enableCentrality)
-          histos.fill(HIST("tracks/helium/h3antiHeliumVspTNSigmaTPCVsMult"), antihePt, track.tpcNSigmaHe(), centFT0M);
+          fillCost.fill(histos, HIST("tracks/helium/h3antiHeliumVspTNSigmaTPCVsMult"), antihePt, track.tpcNSigmaHe(), centFT0M);
       }
       if (isHeWTPCpid) {
-        histos.fill(HIST("tracks/helium/h2HeliumVspTNSigmaITSHe_wTPCpid"), track.p(), nITSHe);
+        fillCost.fill(histos, HIST("tracks/helium/h2HeliumVspTNSigmaITSHe_wTPCpid"), track.p(), nITSHe);
       }
       if (isAntiHeWTPCpid) {
-        histos.fill(HIST("tracks/helium/h2antiHeliumVspTNSigmaITSHe_wTPCpid"), track.p(), nITSHe);
+        fillCost.fill(histos, HIST("tracks/helium/h2antiHeliumVspTNSigmaITSHe_wTPCpid"), track.p(), nITSHe);
       }
       if constexpr (!IsFilteredData) {
         if (isHeWTPCpid || isAntiHeWTPCpid) {
           if (nsigmaITSvar.showAverageClusterSize) {
-            histos.fill(HIST("tracks/helium/averageClusterSize"), track.p(), averageClusterSizeTrk(track));
-            histos.fill(HIST("tracks/helium/averageClusterSizePerCoslInv"), track.p(), averageClusterSizePerCoslInv(track));
+            fillCost.fill(histos, HIST("tracks/helium/averageClusterSize"), track.p(), averageClusterSizeTrk(track));
+            fillCost.fill(histos, HIST("tracks/helium/averageClusterSizePerCoslInv"), track.p(), averageClusterSizePerCoslInv(track));
           }
         }
       }
@@ -4696,53 +4702,53 @@ struct lfNucleiBATask {
         if (isDeWTPCpid) {
           switch (useHasTRDConfig) {
             case 0:
-              histos.fill(HIST("tracks/deuteron/h2DeuteronVspTNSigmaTOF"), DPt, track.tofNSigmaDe());
+              fillCost.fill(histos, HIST("tracks/deuteron/h2DeuteronVspTNSigmaTOF"), DPt, track.tofNSigmaDe());
               break;
             case 1:
               if (track.hasTRD()) {
-                histos.fill(HIST("tracks/deuteron/h2DeuteronVspTNSigmaTOF"), DPt, track.tofNSigmaDe());
+                fillCost.fill(histos, HIST("tracks/deuteron/h2DeuteronVspTNSigmaTOF"), DPt, track.tofNSigmaDe());
               }
               break;
             case 2:
               if (!track.hasTRD()) {
-                histos.fill(HIST("tracks/deuteron/h2DeuteronVspTNSigmaTOF"), DPt, track.tofNSigmaDe());
+                fillCost.fill(histos, HIST("tracks/deuteron/h2DeuteronVspTNSigmaTOF"), DPt, track.tofNSigmaDe());
               }
               break;
           }
           if (outFlagOptions.enableExpSignalTOF)
-            histos.fill(HIST("tracks/deuteron/h2DeuteronTOFExpSignalDiffVsPt"), DPt, track.tofExpSignalDiffDe());
+            fillCost.fill(histos, HIST("tracks/deuteron/h2DeuteronTOFExpSignalDiffVsPt"), DPt, track.tofExpSignalDiffDe());
         }
 
         if (isAntiDeWTPCpid) {
           switch (useHasTRDConfig) {
             case 0:
-              histos.fill(HIST("tracks/deuteron/h2antiDeuteronVspTNSigmaTOF"), antiDPt, track.tofNSigmaDe());
+              fillCost.fill(histos, HIST("tracks/deuteron/h2antiDeuteronVspTNSigmaTOF"), antiDPt, track.tofNSigmaDe());
               break;
             case 1:
               if (track.hasTRD()) {
-                histos.fill(HIST("tracks/deuteron/h2antiDeuteronVspTNSigmaTOF"), antiDPt, track.tofNSigmaDe());
+                fillCost.fill(histos, HIST("tracks/deuteron/h2antiDeuteronVspTNSigmaTOF"), antiDPt, track.tofNSigmaDe());
               }
               break;
             case 2:
               if (!track.hasTRD()) {
-                histos.fill(HIST("tracks/deuteron/h2antiDeuteronVspTNSigmaTOF"), antiDPt, track.tofNSigmaDe());
+                fillCost.fill(histos, HIST("tracks/deuteron/h2antiDeuteronVspTNSigmaTOF"), antiDPt, track.tofNSigmaDe());
               }
               break;
           }
           if (outFlagOptions.enableExpSignalTOF)
-            histos.fill(HIST("tracks/deuteron/h2antiDeuteronTOFExpSignalDiffVsPt"), antiDPt, track.tofExpSignalDiffDe());
+            fillCost.fill(histos, HIST("tracks/deuteron/h2antiDeuteronTOFExpSignalDiffVsPt"), antiDPt, track.tofExpSignalDiffDe());
         }
 
         if (isHeWTPCpid) {
-          histos.fill(HIST("tracks/helium/h2HeliumVspTNSigmaTOF"), hePt, track.tofNSigmaHe());
+          fillCost.fill(histos, HIST("tracks/helium/h2HeliumVspTNSigmaTOF"), hePt, track.tofNSigmaHe());
           if (outFlagOptions.enableExpSignalTOF)
-            histos.fill(HIST("tracks/helium/h2HeliumTOFExpSignalDiffVsPt"), hePt, track.tofExpSignalDiffHe());
+            fillCost.fill(histos, HIST("tracks/helium/h2HeliumTOFExpSignalDiffVsPt"), hePt, track.tofExpSignalDiffHe());
         }
 
         if (isAntiHeWTPCpid) {
-          histos.fill(HIST("tracks/helium/h2antiHeliumVspTNSigmaTOF"), antihePt, track.tofNSigmaHe());
+          fillCost.fill(histos, HIST("tracks/helium/h2antiHeliumVspTNSigmaTOF"), antihePt, track.tofNSigmaHe());
           if (outFlagOptions.enableExpSignalTOF)
-            histos.fill(HIST("tracks/helium/h2antiHeliumTOFExpSignalDiffVsPt"), antihePt, track.tofExpSignalDiffHe());
+            fillCost.fill(histos, HIST("tracks/helium/h2antiHeliumTOFExpSignalDiffVsPt"), antihePt, track.tofExpSignalDiffHe());
         }
       }
 
@@ -4750,35 +4756,35 @@ struct lfNucleiBATask {
         // PID
         if (outFlagOptions.enableEffPlots && enableDebug) {
           if (track.sign() > 0)
-            debugHistos.fill(HIST("tracks/eff/hPtP"), track.pt());
+            fillCost.fill(debugHistos, HIST("tracks/eff/hPtP"), track.pt());
           else
-            debugHistos.fill(HIST("tracks/eff/hPtantiP"), track.pt());
+            fillCost.fill(debugHistos, HIST("tracks/eff/hPtantiP"), track.pt());
         }
 
         if (enablePr) {
           if (std::abs(track.tpcNSigmaPr()) < nsigmaTPCvar.nsigmaTPCPr && prRapCut) {
             if (track.sign() > 0) {
               if (outFlagOptions.enableEffPlots) {
-                histos.fill(HIST("tracks/eff/proton/hPtPr"), track.pt());
-                histos.fill(HIST("tracks/eff/proton/h2pVsTPCmomentumPr"), track.tpcInnerParam(), track.p());
+                fillCost.fill(histos, HIST("tracks/eff/proton/hPtPr"), track.pt());
+                fillCost.fill(histos, HIST("tracks/eff/proton/h2pVsTPCmomentumPr"), track.tpcInnerParam(), track.p());
               }
-              histos.fill(HIST("tracks/proton/h1ProtonSpectra"), track.pt());
-              histos.fill(HIST("tracks/proton/h2ProtonYvsPt"), track.rapidity(o2::track::PID::getMass2Z(o2::track::PID::Proton)), track.pt());
-              histos.fill(HIST("tracks/proton/h2ProtonEtavsPt"), track.eta(), track.pt());
+              fillCost.fill(histos, HIST("tracks/proton/h1ProtonSpectra"), track.pt());
+              fillCost.fill(histos, HIST("tracks/proton/h2ProtonYvsPt"), track.rapidity(o2::track::PID::getMass2Z(o2::track::PID::Proton)), track.pt());
+              fillCost.fill(histos, HIST("tracks/proton/h2ProtonEtavsPt"), track.eta(), track.pt());
 
               if (outFlagOptions.enablePIDplot)
-                histos.fill(HIST("tracks/proton/h2TPCsignVsTPCmomentumProton"), track.tpcInnerParam(), track.tpcSignal());
+                fillCost.fill(histos, HIST("tracks/proton/h2TPCsignVsTPCmomentumProton"), track.tpcInnerParam(), track.tpcSignal());
             } else {
               if (outFlagOptions.enableEffPlots) {
-                histos.fill(HIST("tracks/eff/proton/hPtantiPr"), track.pt());
-                histos.fill(HIST("tracks/eff/proton/h2pVsTPCmomentumantiPr"), track.tpcInnerParam(), track.p());
+                fillCost.fill(histos, HIST("tracks/eff/proton/hPtantiPr"), track.pt());
+                fillCost.fill(histos, HIST("tracks/eff/proton/h2pVsTPCmomentumantiPr"), track.tpcInnerParam(), track.p());
               }
-              histos.fill(HIST("tracks/proton/h1antiProtonSpectra"), track.pt());
-              histos.fill(HIST("tracks/proton/h2antiProtonYvsPt"), track.rapidity(o2::track::PID::getMass2Z(o2::track::PID::Proton)), track.pt());
-              histos.fill(HIST("tracks/proton/h2antiProtonEtavsPt"), track.eta(), track.pt());
+              fillCost.fill(histos, HIST("tracks/proton/h1antiProtonSpectra"), track.pt());
+              fillCost.fill(histos, HIST("tracks/proton/h2antiProtonYvsPt"), track.rapidity(o2::track::PID::getMass2Z(o2::track::PID::Proton)), track.pt());
+              fillCost.fill(histos, HIST("tracks/proton/h2antiProtonEtavsPt"), track.eta(), track.pt());
 
               if (outFlagOptions.enablePIDplot)
-                histos.fill(HIST("tracks/proton/h2TPCsignVsTPCmomentumantiProton"), track.tpcInnerParam(), track.tpcSignal());
+                fillCost.fill(histos, HIST("tracks/proton/h2TPCsignVsTPCmomentumantiProton"), track.tpcInnerParam(), track.tpcSignal());
             }
           }
         }
@@ -4786,33 +4792,33 @@ struct lfNucleiBATask {
           if ((isTritonTPCpid) && trRapCut) {
             if (track.sign() > 0) {
               if (outFlagOptions.enableEffPlots) {
-                histos.fill(HIST("tracks/eff/triton/hPtTr"), track.pt());
-                histos.fill(HIST("tracks/eff/triton/h2pVsTPCmomentumTr"), track.tpcInnerParam(), track.p());
+                fillCost.fill(histos, HIST("tracks/eff/triton/hPtTr"), track.pt());
+                fillCost.fill(histos, HIST("tracks/eff/triton/h2pVsTPCmomentumTr"), track.tpcInnerParam(), track.p());
               }
-              histos.fill(HIST("tracks/triton/h1TritonSpectra"), track.pt());
+              fillCost.fill(histos, HIST("tracks/triton/h1TritonSpectra"), track.pt());
               if (outFlagOptions.enablePIDplot)
-                histos.fill(HIST("tracks/triton/h2TPCsignVsTPCmomentumTriton"), track.tpcInnerParam(), track.tpcSignal());
+                fillCost.fill(histos, HIST("tracks/triton/h2TPCsignVsTPCmomentumTriton"), track.tpcInnerParam(), track.tpcSignal());
             } else {
               if (outFlagOptions.enableEffPlots) {
-                histos.fill(HIST("tracks/eff/triton/hPtantiTr"), track.pt());
-                histos.fill(HIST("tracks/eff/triton/h2pVsTPCmomentumantiTr"), track.tpcInnerParam(), track.p());
+                fillCost.fill(histos, HIST("tracks/eff/triton/hPtantiTr"), track.pt());
+                fillCost.fill(histos, HIST("tracks/eff/triton/h2pVsTPCmomentumantiTr"), track.tpcInnerParam(), track.p());
               }
-              histos.fill(HIST("tracks/triton/h1antiTritonSpectra"), track.pt());
+              fillCost.fill(histos, HIST("tracks/triton/h1antiTritonSpectra"), track.pt());
               if (outFlagOptions.enablePIDplot)
-                histos.fill(HIST("tracks/triton/h2TPCsignVsTPCmomentumantiTriton"), track.tpcInnerParam(), track.tpcSignal());
+                fillCost.fill(histos, HIST("tracks/triton/h2TPCsignVsTPCmomentumantiTriton"), track.tpcInnerParam(), track.tpcSignal());
             }
           }
         }
         if (enableAl) {
           if ((std::abs(track.tpcNSigmaAl()) < nsigmaTPCvar.nsigmaTPCAl) && alRapCut) {
             if (track.sign() > 0) {
-              histos.fill(HIST("tracks/alpha/h1AlphaSpectra"), track.pt());
+              fillCost.fill(histos, HIST("tracks/alpha/h1AlphaSpectra"), track.pt());
               if (outFlagOptions.enablePIDplot)
-                histos.fill(HIST("tracks/alpha/h2TPCsignVsTPCmomentumAlpha"), track.tpcInnerParam(), track.tpcSignal());
+                fillCost.fill(histos, HIST("tracks/alpha/h2TPCsignVsTPCmomentumAlpha"), track.tpcInnerParam(), track.tpcSignal());
             } else {
-              histos.fill(HIST("tracks/alpha/h1antiAlphaSpectra"), track.pt());
+              fillCost.fill(histos, HIST("tracks/alpha/h1antiAlphaSpectra"), track.pt());
               if (outFlagOptions.enablePIDplot)
-                histos.fill(HIST("tracks/alpha/h2TPCsignVsTPCmomentumantiAlpha"), track.tpcInnerParam(), track.tpcSignal());
+                fillCost.fill(histos, HIST("tracks/alpha/h2TPCsignVsTPCmomentumantiAlpha"), track.tpcInnerParam(), track.tpcSignal());
             }
           }
         }
@@ -4820,79 +4826,79 @@ struct lfNucleiBATask {
         if (outFlagOptions.doTOFplots && track.hasTOF()) {
           if (outFlagOptions.enableEffPlots && enableDebug) {
             if (track.sign() > 0)
-              debugHistos.fill(HIST("tracks/eff/hPtPTOF"), track.pt());
+              fillCost.fill(debugHistos, HIST("tracks/eff/hPtPTOF"), track.pt());
             else
-              debugHistos.fill(HIST("tracks/eff/hPtantiPTOF"), track.pt());
+              fillCost.fill(debugHistos, HIST("tracks/eff/hPtantiPTOF"), track.pt());
           }
 
           if (outFlagOptions.enableBetaCut && (track.beta() > cfgBetaCut) && outFlagOptions.enablePIDplot)
-            histos.fill(HIST("tracks/h2TOFbetaVsP_BetaCut"), track.p() / (1.f * track.sign()), track.beta());
+            fillCost.fill(histos, HIST("tracks/h2TOFbetaVsP_BetaCut"), track.p() / (1.f * track.sign()), track.beta());
           if (outFlagOptions.enablePIDplot) {
             switch (useHasTRDConfig) {
               case 0:
-                histos.fill(HIST("tracks/h2TOFbetaVsP"), track.p() / (1.f * track.sign()), track.beta());
+                fillCost.fill(histos, HIST("tracks/h2TOFbetaVsP"), track.p() / (1.f * track.sign()), track.beta());
                 break;
               case 1:
                 if (track.hasTRD()) {
-                  histos.fill(HIST("tracks/h2TOFbetaVsP"), track.p() / (1.f * track.sign()), track.beta());
+                  fillCost.fill(histos, HIST("tracks/h2TOFbetaVsP"), track.p() / (1.f * track.sign()), track.beta());
                 }
                 break;
               case 2:
                 if (!track.hasTRD()) {
-                  histos.fill(HIST("tracks/h2TOFbetaVsP"), track.p() / (1.f * track.sign()), track.beta());
+                  fillCost.fill(histos, HIST("tracks/h2TOFbetaVsP"), track.p() / (1.f * track.sign()), track.beta());
                 }
                 break;
             }
           }
 
           if (outFlagOptions.enableEffPlots)
-            histos.fill(HIST("tracks/eff/h2TPCmomentumVsTOFExpMomentum"), track.tofExpMom(), track.tpcInnerParam());
+            fillCost.fill(histos, HIST("tracks/eff/h2TPCmomentumVsTOFExpMomentum"), track.tofExpMom(), track.tpcInnerParam());
 
           if (enablePr && prRapCut) {
             if (std::abs(track.tpcNSigmaPr()) < nsigmaTPCvar.nsigmaTPCPr && track.sign() > 0) {
-              histos.fill(HIST("tracks/proton/h2ProtonTOFbetaVsP"), track.p(), track.beta());
+              fillCost.fill(histos, HIST("tracks/proton/h2ProtonTOFbetaVsP"), track.p(), track.beta());
               if (outFlagOptions.enableEffPlots) {
-                histos.fill(HIST("tracks/eff/proton/h2pVsTOFExpMomentumPr"), track.tofExpMom(), track.p());
-                histos.fill(HIST("tracks/eff/proton/h2TPCmomentumVsTOFExpMomentumPr"), track.tofExpMom(), track.tpcInnerParam());
+                fillCost.fill(histos, HIST("tracks/eff/proton/h2pVsTOFExpMomentumPr"), track.tofExpMom(), track.p());
+                fillCost.fill(histos, HIST("tracks/eff/proton/h2TPCmomentumVsTOFExpMomentumPr"), track.tofExpMom(), track.tpcInnerParam());
               }
             }
             if (std::abs(track.tpcNSigmaPr()) < nsigmaTPCvar.nsigmaTPCPr && track.sign() < 0) {
-              histos.fill(HIST("tracks/proton/h2antiProtonTOFbetaVsP"), track.p(), track.beta());
+              fillCost.fill(histos, HIST("tracks/proton/h2antiProtonTOFbetaVsP"), track.p(), track.beta());
               if (outFlagOptions.enableEffPlots) {
-                histos.fill(HIST("tracks/eff/proton/h2pVsTOFExpMomentumantiPr"), track.tofExpMom(), track.p());
-                histos.fill(HIST("tracks/eff/proton/h2TPCmomentumVsTOFExpMomentumantiPr"), track.tofExpMom(), track.tpcInnerParam());
+                fillCost.fill(histos, HIST("tracks/eff/proton/h2pVsTOFExpMomentumantiPr"), track.tofExpMom(), track.p());
+                fillCost.fill(histos, HIST("tracks/eff/proton/h2TPCmomentumVsTOFExpMomentumantiPr"), track.tofExpMom(), track.tpcInnerParam());
               }
             }
           }
           if (enableTr && trRapCut) {
             if (isTritonTPCpid && track.sign() > 0) {
-              histos.fill(HIST("tracks/triton/h2TritonTOFbetaVsP"), track.p(), track.beta());
+              fillCost.fill(histos, HIST("tracks/triton/h2TritonTOFbetaVsP"), track.p(), track.beta());
               if (outFlagOptions.enableEffPlots) {
-                histos.fill(HIST("tracks/eff/triton/h2pVsTOFExpMomentumTr"), track.tofExpMom(), track.p());
-                histos.fill(HIST("tracks/eff/triton/h2TPCmomentumVsTOFExpMomentumTr"), track.tofExpMom(), track.tpcInnerParam());
+                fillCost.fill(histos, HIST("tracks/eff/triton/h2pVsTOFExpMomentumTr"), track.tofExpMom(), track.p());
+                fillCost.fill(histos, HIST("tracks/eff/triton/h2TPCmomentumVsTOFExpMomentumTr"), track.tofExpMom(), track.tpcInnerParam());
               }
             }
             if (isTritonTPCpid && track.sign() < 0) {
-              histos.fill(HIST("tracks/triton/h2antiTritonTOFbetaVsP"), track.p(), track.beta());
+              fillCost.fill(histos, HIST("tracks/triton/h2antiTritonTOFbetaVsP"), track.p(), track.beta());
               if (outFlagOptions.enableEffPlots) {
-                histos.fill(HIST("tracks/eff/triton/h2pVsTOFExpMomentumantiTr"), track.tofExpMom(), track.p());
-                histos.fill(HIST("tracks/eff/triton/h2TPCmomentumVsTOFExpMomentumantiTr"), track.tofExpMom(), track.tpcInnerParam());
+                fillCost.fill(histos, HIST("tracks/eff/triton/h2pVsTOFExpMomentumantiTr"), track.tofExpMom(), track.p());
+                fillCost.fill(histos, HIST("tracks/eff/triton/h2TPCmomentumVsTOFExpMomentumantiTr"), track.tofExpMom(), track.tpcInnerParam());
               }
             }
           }
           if (filterOptions.enableEvTimeSplitting) {
             if (track.isEvTimeTOF() && track.isEvTimeT0AC()) {
-              evtimeHistos.fill(HIST("tracks/evtime/ft0tof/h2TOFbetaVsP"), track.p() / (1.f * track.sign()), track.beta());
-              evtimeHistos.fill(HIST("tracks/evtime/ft0tof/h2TPCsignVsTPCmomentum"), track.tpcInnerParam() / (1.f * track.sign()), track.tpcSignal());
+              fillCost.fill(evtimeHistos, HIST("tracks/evtime/ft0tof/h2TOFbetaVsP"), track.p() / (1.f * track.sign()), track.beta());
+              fillCost.fill(evtimeHistos, HIST("tracks/evtime/ft0tof/h2TPCsignVsTPCmomentum"), track.tpcInnerParam() / (1.f * track.sign()), track.tpcSignal());
             } else if (track.isEvTimeT0AC()) {
-              evtimeHistos.fill(HIST("tracks/evtime/ft0/h2TOFbetaVsP"), track.p() / (1.f * track.sign()), track.beta());
-              evtimeHistos.fill(HIST("tracks/evtime/ft0/h2TPCsignVsTPCmomentum"), track.tpcInnerParam() / (1.f * track.sign()), track.tpcSignal());
+              fillCost.fill(evtimeHistos, HIST("tracks/evtime/ft0/h2TOFbetaVsP"), track.p() / (1.f * track.sign()), track.beta());
+              fillCost.fill(evtimeHistos, HIST("tracks/evtime/ft0/h2TPCsignVsTPCmomentum"), track.tpcInnerParam() / (1.f * track.sign()), track.tpcSignal());
             } else if (track.isEvTimeTOF()) {
-              evtimeHistos.fill(HIST("tracks/evtime/tof/h2TOFbetaVsP"), track.p() / (1.f * track.sign()), track.beta());
-              evtimeHistos.fill(HIST("tracks/evtime/tof/h2TPCsignVsTPCmomentum"), track.tpcInnerParam() / (1.f * track.sign()), track.tpcSignal());
+              fillCost.fill(evtimeHistos, HIST("tracks/evtime/tof/h2TOFbetaVsP"), track.p() / (1.f * track.sign()), track.beta());
+              fillCost.fill(evtimeHistos, HIST("tracks/evtime/tof/h2TPCsignVsTPCmomentum"), track.tpcInnerParam() / (1.f * track.sign()), track.tpcSignal());
             } else {
-              evtimeHistos.fill(HIST("tracks/evtime/fill/h2TOFbetaVsP"), track.p() / (1.f * track.sign()), track.beta());
-              evtimeHistos.fill(HIST("tracks/evtime/fill/h2TPCsignVsTPCmomentum"), track.tpcInnerParam() / (1.f * track.sign()), track.tpcSignal());
+              fillCost.fill(evtimeHistos, HIST("tracks/evtime/fill/h2TOFbetaVsP"), track.p() / (1.f * track.sign()), track.beta());
+              fillCost.fill(evtimeHistos, HIST("tracks/evtime/fill/h2TPCsignVsTPCmomentum"), track.tpcInnerParam() / (1.f * track.sign()), track.tpcSignal());
             }
           }
         }
@@ -4900,113 +4906,115 @@ struct lfNucleiBATask {
 
       if (isDeWTPCpid) {
         if (outFlagOptions.enableEffPlots) {
-          histos.fill(HIST("tracks/eff/deuteron/hPtDe"), DPt);
-          histos.fill(HIST("tracks/eff/deuteron/h2pVsTPCmomentumDe"), track.tpcInnerParam(), track.p());
+          fillCost.fill(histos, HIST("tracks/eff/deuteron/hPtDe"), DPt);
+          fillCost.fill(histos, HIST("tracks/eff/deuteron/h2pVsTPCmomentumDe"), track.tpcInnerParam(), track.p());
         }
-        histos.fill(HIST("tracks/deuteron/h1DeuteronSpectra"), DPt);
-        histos.fill(HIST("tracks/deuteron/h2DeuteronYvsPt"), track.rapidity(o2::track::PID::getMass2Z(o2::track::PID::Deuteron)), DPt);
-        histos.fill(HIST("tracks/deuteron/h2DeuteronEtavsPt"), track.eta(), DPt);
-        histos.fill(HIST("tracks/deuteron/h2DeuteronVspNSigmaITSDe_wTPCpid"), track.p(), nITSDe);
+        fillCost.fill(histos, HIST("tracks/deuteron/h1DeuteronSpectra"), DPt);
+        fillCost.fill(histos, HIST("tracks/deuteron/h2DeuteronYvsPt"), track.rapidity(o2::track::PID::getMass2Z(o2::track::PID::Deuteron)), DPt);
+        fillCost.fill(histos, HIST("tracks/deuteron/h2DeuteronEtavsPt"), track.eta(), DPt);
+        fillCost.fill(histos, HIST("tracks/deuteron/h2DeuteronVspNSigmaITSDe_wTPCpid"), track.p(), nITSDe);
 
         if (outFlagOptions.enablePIDplot)
-          histos.fill(HIST("tracks/deuteron/h2TPCsignVsTPCmomentumDeuteron"), track.tpcInnerParam(), track.tpcSignal());
+          fillCost.fill(histos, HIST("tracks/deuteron/h2TPCsignVsTPCmomentumDeuteron"), track.tpcInnerParam(), track.tpcSignal());
       }
       if (isAntiDeWTPCpid) {
         if (outFlagOptions.enableEffPlots) {
-          histos.fill(HIST("tracks/eff/deuteron/hPtantiDe"), antiDPt);
-          histos.fill(HIST("tracks/eff/deuteron/h2pVsTPCmomentumantiDe"), track.tpcInnerParam(), track.p());
+          fillCost.fill(histos, HIST("tracks/eff/deuteron/hPtantiDe"), antiDPt);
+          fillCost.fill(histos, HIST("tracks/eff/deuteron/h2pVsTPCmomentumantiDe"), track.tpcInnerParam(), track.p());
         }
-        histos.fill(HIST("tracks/deuteron/h1antiDeuteronSpectra"), antiDPt);
-        histos.fill(HIST("tracks/deuteron/h2antiDeuteronYvsPt"), track.rapidity(o2::track::PID::getMass2Z(o2::track::PID::Deuteron)), antiDPt);
-        histos.fill(HIST("tracks/deuteron/h2antiDeuteronEtavsPt"), track.eta(), antiDPt);
-        histos.fill(HIST("tracks/deuteron/h2antiDeuteronVspNSigmaITSDe_wTPCpid"), track.p(), nITSDe);
+        fillCost.fill(histos, HIST("tracks/deuteron/h1antiDeuteronSpectra"), antiDPt);
+        fillCost.fill(histos, HIST("tracks/deuteron/h2antiDeuteronYvsPt"), track.rapidity(o2::track::PID::getMass2Z(o2::track::PID::Deuteron)), antiDPt);
+        fillCost.fill(histos, HIST("tracks/deuteron/h2antiDeuteronEtavsPt"), track.eta(), antiDPt);
+        fillCost.fill(histos, HIST("tracks/deuteron/h2antiDeuteronVspNSigmaITSDe_wTPCpid"), track.p(), nITSDe);
 
         if (outFlagOptions.enablePIDplot)
-          histos.fill(HIST("tracks/deuteron/h2TPCsignVsTPCmomentumantiDeuteron"), track.tpcInnerParam(), track.tpcSignal());
+          fillCost.fill(histos, HIST("tracks/deuteron/h2TPCsignVsTPCmomentumantiDeuteron"), track.tpcInnerParam(), track.tpcSignal());
       }
       if (isHeWTPCpid) {
         if (outFlagOptions.enableEffPlots) {
-          histos.fill(HIST("tracks/eff/helium/hPtHe"), 2 * hePt);
-          histos.fill(HIST("tracks/eff/helium/h2pVsTPCmomentumHe"), heTPCmomentum, heP);
+          fillCost.fill(histos, HIST("tracks/eff/helium/hPtHe"), 2 * hePt);
+          fillCost.fill(histos, HIST("tracks/eff/helium/h2pVsTPCmomentumHe"), heTPCmomentum, heP);
         }
-        histos.fill(HIST("tracks/helium/h1HeliumSpectra_Z2"), 2 * hePt);
-        histos.fill(HIST("tracks/helium/h2HeliumYvsPt_Z2"), track.rapidity(o2::track::PID::getMass2Z(o2::track::PID::Helium3)), 2 * hePt);
-        histos.fill(HIST("tracks/helium/h2HeliumEtavsPt_Z2"), track.eta(), 2 * hePt);
+        fillCost.fill(histos, HIST("tracks/helium/h1HeliumSpectra_Z2"), 2 * hePt);
+        fillCost.fill(histos, HIST("tracks/helium/h2HeliumYvsPt_Z2"), track.rapidity(o2::track::PID::getMass2Z(o2::track::PID::Helium3)), 2 * hePt);
+        fillCost.fill(histos, HIST("tracks/helium/h2HeliumEtavsPt_Z2"), track.eta(), 2 * hePt);
         if (outFlagOptions.enablePIDplot)
-          histos.fill(HIST("tracks/helium/h2TPCsignVsTPCmomentumHelium"), heTPCmomentum, track.tpcSignal());
+          fillCost.fill(histos, HIST("tracks/helium/h2TPCsignVsTPCmomentumHelium"), heTPCmomentum, track.tpcSignal());
         if (enableDebug)
-          debugHistos.fill(HIST("tracks/helium/h2HeliumPidTrackingVsPt"), 2 * hePt, track.pidForTracking());
+          fillCost.fill(debugHistos, HIST("tracks/helium/h2HeliumPidTrackingVsPt"), 2 * hePt, track.pidForTracking());
       }
       if (isAntiHeWTPCpid) {
         if (outFlagOptions.enableEffPlots) {
-          histos.fill(HIST("tracks/eff/helium/hPtantiHe"), 2 * antihePt);
-          histos.fill(HIST("tracks/eff/helium/h2pVsTPCmomentumantiHe"), antiheTPCmomentum, antiheP);
+          fillCost.fill(histos, HIST("tracks/eff/helium/hPtantiHe"), 2 * antihePt);
+          fillCost.fill(histos, HIST("tracks/eff/helium/h2pVsTPCmomentumantiHe"), antiheTPCmomentum, antiheP);
         }
-        histos.fill(HIST("tracks/helium/h1antiHeliumSpectra_Z2"), 2 * antihePt);
-        histos.fill(HIST("tracks/helium/h2antiHeliumYvsPt_Z2"), track.rapidity(o2::track::PID::getMass2Z(o2::track::PID::Helium3)), 2 * antihePt);
-        histos.fill(HIST("tracks/helium/h2antiHeliumEtavsPt_Z2"), track.eta(), 2 * antihePt);
+        fillCost.fill(histos, HIST("tracks/helium/h1antiHeliumSpectra_Z2"), 2 * antihePt);
+        fillCost.fill(histos, HIST("tracks/helium/h2antiHeliumYvsPt_Z2"), track.rapidity(o2::track::PID::getMass2Z(o2::track::PID::Helium3)), 2 * antihePt);
+        fillCost.fill(histos, HIST("tracks/helium/h2antiHeliumEtavsPt_Z2"), track.eta(), 2 * antihePt);
         if (outFlagOptions.enablePIDplot)
-          histos.fill(HIST("tracks/helium/h2TPCsignVsTPCmomentumantiHelium"), antiheTPCmomentum, track.tpcSignal());
+          fillCost.fill(histos, HIST("tracks/helium/h2TPCsignVsTPCmomentumantiHelium"), antiheTPCmomentum, track.tpcSignal());
         if (enableDebug)
-          debugHistos.fill(HIST("tracks/helium/h2antiHeliumPidTrackingVsPt"), 2 * antihePt, track.pidForTracking());
+          fillCost.fill(debugHistos, HIST("tracks/helium/h2antiHeliumPidTrackingVsPt"), 2 * antihePt, track.pidForTracking());
       }
 
       if (outFlagOptions.doTOFplots && track.hasTOF()) {
         if (isDeWTPCpid) {
-          histos.fill(HIST("tracks/deuteron/h2DeuteronTOFbetaVsP"), track.p(), track.beta());
+          fillCost.fill(histos, HIST("tracks/deuteron/h2DeuteronTOFbetaVsP"), track.p(), track.beta());
           if (outFlagOptions.enableEffPlots) {
-            histos.fill(HIST("tracks/eff/deuteron/h2pVsTOFExpMomentumDe"), track.tofExpMom(), track.p());
-            histos.fill(HIST("tracks/eff/deuteron/h2TPCmomentumVsTOFExpMomentumDe"), track.tofExpMom(), track.tpcInnerParam());
+            fillCost.fill(histos, HIST("tracks/eff/deuteron/h2pVsTOFExpMomentumDe"), track.tofExpMom(), track.p());
+            fillCost.fill(histos, HIST("tracks/eff/deuteron/h2TPCmomentumVsTOFExpMomentumDe"), track.tofExpMom(), track.tpcInnerParam());
           }
         }
         if (isAntiDeWTPCpid) {
-          histos.fill(HIST("tracks/deuteron/h2antiDeuteronTOFbetaVsP"), track.p(), track.beta());
+          fillCost.fill(histos, HIST("tracks/deuteron/h2antiDeuteronTOFbetaVsP"), track.p(), track.beta());
           if (outFlagOptions.enableEffPlots) {
-            histos.fill(HIST("tracks/eff/deuteron/h2pVsTOFExpMomentumantiDe"), track.tofExpMom(), track.p());
-            histos.fill(HIST("tracks/eff/deuteron/h2TPCmomentumVsTOFExpMomentumantiDe"), track.tofExpMom(), track.tpcInnerParam());
+            fillCost.fill(histos, HIST("tracks/eff/deuteron/h2pVsTOFExpMomentumantiDe"), track.tofExpMom(), track.p());
+            fillCost.fill(histos, HIST("tracks/eff/deuteron/h2TPCmomentumVsTOFExpMomentumantiDe"), track.tofExpMom(), track.tpcInnerParam());
           }
         }
 
         if (isHeWTPCpid) {
           if (enableCentrality)
-            histos.fill(HIST("tracks/helium/TOF/h2HeliumSpectraVsMult_Z2"), 2 * hePt, centFT0M);
-          histos.fill(HIST("tracks/helium/h2HeliumTOFbetaVsP"), heP, track.beta());
+            fillCost.fill(histos, HIST("tracks/helium/TOF/h2HeliumSpectraVsMult_Z2"), 2 * hePt, centFT0M);
+          fillCost.fill(histos, HIST("tracks/helium/h2HeliumTOFbetaVsP"), heP, track.beta());
           if (outFlagOptions.enableEffPlots) {
-            histos.fill(HIST("tracks/eff/helium/h2pVsTOFExpMomentumHe"), track.tofExpMom(), heP);
-            histos.fill(HIST("tracks/eff/helium/h2TPCmomentumVsTOFExpMomentumHe"), track.tofExpMom(), heTPCmomentum);
+            fillCost.fill(histos, HIST("tracks/eff/helium/h2pVsTOFExpMomentumHe"), track.tofExpMom(), heP);
+            fillCost.fill(histos, HIST("tracks/eff/helium/h2TPCmomentumVsTOFExpMomentumHe"), track.tofExpMom(), heTPCmomentum);
           }
         }
 
         if (isAntiHeWTPCpid) {
           if (enableCentrality)
-            histos.fill(HIST("tracks/helium/TOF/h2antiHeliumSpectraVsMult_Z2"), 2 * antihePt, centFT0M);
-          histos.fill(HIST("tracks/helium/h2antiHeliumTOFbetaVsP"), antiheP, track.beta());
+            fillCost.fill(histos, HIST("tracks/helium/TOF/h2antiHeliumSpectraVsMult_Z2"), 2 * antihePt, centFT0M);
+          fillCost.fill(histos, HIST("tracks/helium/h2antiHeliumTOFbetaVsP"), antiheP, track.beta());
           if (outFlagOptions.enableEffPlots) {
-            histos.fill(HIST("tracks/eff/helium/h2pVsTOFExpMomentumantiHe"), track.tofExpMom(), antiheP);
-            histos.fill(HIST("tracks/eff/helium/h2TPCmomentumVsTOFExpMomentumantiHe"), track.tofExpMom(), antiheTPCmomentum);
+            fillCost.fill(histos, HIST("tracks/eff/helium/h2pVsTOFExpMomentumantiHe"), track.tofExpMom(), antiheP);
+            fillCost.fill(histos, HIST("tracks/eff/helium/h2TPCmomentumVsTOFExpMomentumantiHe"), track.tofExpMom(), antiheTPCmomentum);
           }
         }
 
         if ((track.beta() * track.beta()) < 1.) {
           gamma = 1.f / std::sqrt(1.f - (track.beta() * track.beta()));
+          // m / p = sqrt(1 / beta^2 - 1), common to all the mass hypotheses
+          const float massOverP = std::sqrt(1.f / (track.beta() * track.beta()) - 1.f);
 
           switch (massTOFConfig) {
             case 0:
-              massTOF = track.tpcInnerParam() * std::sqrt(1.f / (track.beta() * track.beta()) - 1.f);
-              massTOFhe = heTPCmomentum * std::sqrt(1.f / (track.beta() * track.beta()) - 1.f);
-              massTOFantihe = antiheTPCmomentum * std::sqrt(1.f / (track.beta() * track.beta()) - 1.f);
+              massTOF = track.tpcInnerParam() * massOverP;
+              massTOFhe = heTPCmomentum * massOverP;
+              massTOFantihe = antiheTPCmomentum * massOverP;
               break;
             case 1:
-              massTOF = track.tofExpMom() * std::sqrt(1.f / (track.beta() * track.beta()) - 1.f);
+              massTOF = track.tofExpMom() * massOverP;
               break;
             case 2:
-              massTOF = track.p() * std::sqrt(1.f / (track.beta() * track.beta()) - 1.f);
-              massTOFhe = heP * std::sqrt(1.f / (track.beta() * track.beta()) - 1.f);
-              massTOFantihe = antiheP * std::sqrt(1.f / (track.beta() * track.beta()) - 1.f);
+              massTOF = track.p() * massOverP;
+              massTOFhe = heP * massOverP;
+              massTOFantihe = antiheP * massOverP;
               break;
           }
           if (passDCAxyzCut && outFlagOptions.doTOFplots && outFlagOptions.enablePIDplot)
-            histos.fill(HIST("tracks/h2TPCsignVsBetaGamma"), (track.beta() * gamma) / (1.f * track.sign()), track.tpcSignal());
+            fillCost.fill(histos, HIST("tracks/h2TPCsignVsBetaGamma"), (track.beta() * gamma) / (1.f * track.sign()), track.tpcSignal());
         } else {
           massTOF = -99.f;
           massTOFhe = -99.f;
@@ -5015,16 +5023,16 @@ struct lfNucleiBATask {
 
         if (passDCAxyzCut) {
           if (outFlagOptions.enablePIDplot)
-            histos.fill(HIST("tracks/h2TOFmassVsPt"), massTOF, track.pt());
+            fillCost.fill(histos, HIST("tracks/h2TOFmassVsPt"), massTOF, track.pt());
           if (filterOptions.enableEvTimeSplitting) {
             if (track.isEvTimeTOF() && track.isEvTimeT0AC()) {
-              evtimeHistos.fill(HIST("tracks/evtime/ft0tof/h2TOFmassVsPt"), massTOF, track.pt());
+              fillCost.fill(evtimeHistos, HIST("tracks/evtime/ft0tof/h2TOFmassVsPt"), massTOF, track.pt());
             } else if (track.isEvTimeT0AC()) {
-              evtimeHistos.fill(HIST("tracks/evtime/ft0/h2TOFmassVsPt"), massTOF, track.pt());
+              fillCost.fill(evtimeHistos, HIST("tracks/evtime/ft0/h2TOFmassVsPt"), massTOF, track.pt());
             } else if (track.isEvTimeTOF()) {
-              evtimeHistos.fill(HIST("tracks/evtime/tof/h2TOFmassVsPt"), massTOF, track.pt());
+              fillCost.fill(evtimeHistos, HIST("tracks/evtime/tof/h2TOFmassVsPt"), massTOF, track.pt());
             } else {
-              evtimeHistos.fill(HIST("tracks/evtime/fill/h2TOFmassVsPt"), massTOF, track.pt());
+              fillCost.fill(evtimeHistos, HIST("tracks/evtime/fill/h2TOFmassVsPt"), massTOF, track.pt());
             }
           }
 
@@ -5032,46 +5040,46 @@ struct lfNucleiBATask {
             if ((std::abs(track.tpcNSigmaPr()) < nsigmaTPCvar.nsigmaTPCPr) && prRapCut) {
               if (track.sign() > 0) {
                 if (outFlagOptions.enableEffPlots)
-                  histos.fill(HIST("tracks/eff/proton/hPtPrTOF"), track.pt());
-                histos.fill(HIST("tracks/proton/h2TOFmassProtonVsPt"), massTOF, track.pt());
-                histos.fill(HIST("tracks/proton/h2TOFmass2ProtonVsPt"), massTOF * massTOF - MassProtonVal * MassProtonVal, track.pt());
+                  fillCost.fill(histos, HIST("tracks/eff/proton/hPtPrTOF"), track.pt());
+                fillCost.fill(histos, HIST("tracks/proton/h2TOFmassProtonVsPt"), massTOF, track.pt());
+                fillCost.fill(histos, HIST("tracks/proton/h2TOFmass2ProtonVsPt"), massTOF * massTOF - MassProtonVal * MassProtonVal, track.pt());
                 if (outFlagOptions.enableBetaCut && (track.beta() > cfgBetaCut)) {
-                  histos.fill(HIST("tracks/proton/h2TOFmassProtonVsPt_BetaCut"), massTOF, track.pt());
-                  histos.fill(HIST("tracks/proton/h2TOFmass2ProtonVsPt_BetaCut"), massTOF * massTOF - MassProtonVal * MassProtonVal, track.pt());
+                  fillCost.fill(histos, HIST("tracks/proton/h2TOFmassProtonVsPt_BetaCut"), massTOF, track.pt());
+                  fillCost.fill(histos, HIST("tracks/proton/h2TOFmass2ProtonVsPt_BetaCut"), massTOF * massTOF - MassProtonVal * MassProtonVal, track.pt());
                 }
                 if (outFlagOptions.enableExpSignalTOF)
-                  histos.fill(HIST("tracks/proton/h2ProtonTOFExpSignalDiffVsPtCut"), track.pt(), track.tofExpSignalDiffPr());
+                  fillCost.fill(histos, HIST("tracks/proton/h2ProtonTOFExpSignalDiffVsPtCut"), track.pt(), track.tofExpSignalDiffPr());
                 if (filterOptions.enableEvTimeSplitting) {
                   if (track.isEvTimeTOF() && track.isEvTimeT0AC()) {
-                    evtimeHistos.fill(HIST("tracks/evtime/ft0tof/proton/h2TOFmass2ProtonVsPt"), massTOF * massTOF - MassProtonVal * MassProtonVal, track.pt());
+                    fillCost.fill(evtimeHistos, HIST("tracks/evtime/ft0tof/proton/h2TOFmass2ProtonVsPt"), massTOF * massTOF - MassProtonVal * MassProtonVal, track.pt());
                   } else if (track.isEvTimeT0AC()) {
-                    evtimeHistos.fill(HIST("tracks/evtime/ft0/proton/h2TOFmass2ProtonVsPt"), massTOF * massTOF - MassProtonVal * MassProtonVal, track.pt());
+                    fillCost.fill(evtimeHistos, HIST("tracks/evtime/ft0/proton/h2TOFmass2ProtonVsPt"), massTOF * massTOF - MassProtonVal * MassProtonVal, track.pt());
                   } else if (track.isEvTimeTOF()) {
-                    evtimeHistos.fill(HIST("tracks/evtime/tof/proton/h2TOFmass2ProtonVsPt"), massTOF * massTOF - MassProtonVal * MassProtonVal, track.pt());
+                    fillCost.fill(evtimeHistos, HIST("tracks/evtime/tof/proton/h2TOFmass2ProtonVsPt"), massTOF * massTOF - MassProtonVal * MassProtonVal, track.pt());
                   } else {
-                    evtimeHistos.fill(HIST("tracks/evtime/fill/proton/h2TOFmass2ProtonVsPt"), massTOF * massTOF - MassProtonVal * MassProtonVal, track.pt());
+                    fillCost.fill(evtimeHistos, HIST("tracks/evtime/fill/proton/h2TOFmass2ProtonVsPt"), massTOF * massTOF - MassProtonVal * MassProtonVal, track.pt());
                   }
                 }
               } else {
                 if (outFlagOptions.enableEffPlots)
-                  histos.fill(HIST("tracks/eff/proton/hPtantiPrTOF"), track.pt());
-                histos.fill(HIST("tracks/proton/h2TOFmassantiProtonVsPt"), massTOF, track.pt());
-                histos.fill(HIST("tracks/proton/h2TOFmass2antiProtonVsPt"), massTOF * massTOF - MassProtonVal * MassProtonVal, track.pt());
+                  fillCost.fill(histos, HIST("tracks/eff/proton/hPtantiPrTOF"), track.pt());
+                fillCost.fill(histos, HIST("tracks/proton/h2TOFmassantiProtonVsPt"), massTOF, track.pt());
+                fillCost.fill(histos, HIST("tracks/proton/h2TOFmass2antiProtonVsPt"), massTOF * massTOF - MassProtonVal * MassProtonVal, track.pt());
                 if (outFlagOptions.enableBetaCut && (track.beta() > cfgBetaCut)) {
-                  histos.fill(HIST("tracks/proton/h2TOFmassantiProtonVsPt_BetaCut"), massTOF, track.pt());
-                  histos.fill(HIST("tracks/proton/h2TOFmass2antiProtonVsPt_BetaCut"), massTOF * massTOF - MassProtonVal * MassProtonVal, track.pt());
+                  fillCost.fill(histos, HIST("tracks/proton/h2TOFmassantiProtonVsPt_BetaCut"), massTOF, track.pt());
+                  fillCost.fill(histos, HIST("tracks/proton/h2TOFmass2antiProtonVsPt_BetaCut"), massTOF * massTOF - MassProtonVal * MassProtonVal, track.pt());
                 }
                 if (outFlagOptions.enableExpSignalTOF)
-                  histos.fill(HIST("tracks/proton/h2antiProtonTOFExpSignalDiffVsPtCut"), track.pt(), track.tofExpSignalDiffPr());
+                  fillCost.fill(histos, HIST("tracks/proton/h2antiProtonTOFExpSignalDiffVsPtCut"), track.pt(), track.tofExpSignalDiffPr());
                 if (filterOptions.enableEvTimeSplitting) {
                   if (track.isEvTimeTOF() && track.isEvTimeT0AC()) {
-                    evtimeHistos.fill(HIST("tracks/evtime/ft0tof/proton/h2TOFmass2antiProtonVsPt"), massTOF * massTOF - MassProtonVal * MassProtonVal, track.pt());
+                    fillCost.fill(evtimeHistos, HIST("tracks/evtime/ft0tof/proton/h2TOFmass2antiProtonVsPt"), massTOF * massTOF - MassProtonVal * MassProtonVal, track.pt());
                   } else if (track.isEvTimeT0AC()) {
-                    evtimeHistos.fill(HIST("tracks/evtime/ft0/proton/h2TOFmass2antiProtonVsPt"), massTOF * massTOF - MassProtonVal * MassProtonVal, track.pt());
+                    fillCost.fill(evtimeHistos, HIST("tracks/evtime/ft0/proton/h2TOFmass2antiProtonVsPt"), massTOF * massTOF - MassProtonVal * MassProtonVal, track.pt());
                   } else if (track.isEvTimeTOF()) {
-                    evtimeHistos.fill(HIST("tracks/evtime/tof/proton/h2TOFmass2antiProtonVsPt"), massTOF * massTOF - MassProtonVal * MassProtonVal, track.pt());
+                    fillCost.fill(evtimeHistos, HIST("tracks/evtime/tof/proton/h2TOFmass2antiProtonVsPt"), massTOF * massTOF - MassProtonVal * MassProtonVal, track.pt());
                   } else {
-                    evtimeHistos.fill(HIST("tracks/evtime/fill/proton/h2TOFmass2antiProtonVsPt"), massTOF * massTOF - MassProtonVal * MassProtonVal, track.pt());
+                    fillCost.fill(evtimeHistos, HIST("tracks/evtime/fill/proton/h2TOFmass2antiProtonVsPt"), massTOF * massTOF - MassProtonVal * MassProtonVal, track.pt());
                   }
                 }
               }
@@ -5082,21 +5090,21 @@ struct lfNucleiBATask {
             const float m2diff = massTOF * massTOF - MassTritonVal * MassTritonVal;
             if (track.sign() > 0) {
               if (outFlagOptions.enableEffPlots)
-                histos.fill(HIST("tracks/eff/triton/hPtTrTOF"), track.pt());
-              histos.fill(HIST("tracks/triton/h2TOFmassTritonVsPt"), massTOF, track.pt());
-              histos.fill(HIST("tracks/triton/h2TOFmass2TritonVsPt"), m2diff, track.pt());
+                fillCost.fill(histos, HIST("tracks/eff/triton/hPtTrTOF"), track.pt());
+              fillCost.fill(histos, HIST("tracks/triton/h2TOFmassTritonVsPt"), massTOF, track.pt());
+              fillCost.fill(histos, HIST("tracks/triton/h2TOFmass2TritonVsPt"), m2diff, track.pt());
               if (outFlagOptions.enableBetaCut && (track.beta() > cfgBetaCut)) {
-                histos.fill(HIST("tracks/triton/h2TOFmassTritonVsPt_BetaCut"), massTOF, track.pt());
-                histos.fill(HIST("tracks/triton/h2TOFmass2TritonVsPt_BetaCut"), m2diff, track.pt());
+                fillCost.fill(histos, HIST("tracks/triton/h2TOFmassTritonVsPt_BetaCut"), massTOF, track.pt());
+                fillCost.fill(histos, HIST("tracks/triton/h2TOFmass2TritonVsPt_BetaCut"), m2diff, track.pt());
               }
             } else {
               if (outFlagOptions.enableEffPlots)
-                histos.fill(HIST("tracks/eff/triton/hPtantiTrTOF"), track.pt());
-              histos.fill(HIST("tracks/triton/h2TOFmassantiTritonVsPt"), massTOF, track.pt());
-              histos.fill(HIST("tracks/triton/h2TOFmass2antiTritonVsPt"), m2diff, track.pt());
+                fillCost.fill(histos, HIST("tracks/eff/triton/hPtantiTrTOF"), track.pt());
+              fillCost.fill(histos, HIST("tracks/triton/h2TOFmassantiTritonVsPt"), massTOF, track.pt());
+              fillCost.fill(histos, HIST("tracks/triton/h2TOFmass2antiTritonVsPt"), m2diff, track.pt());
               if (outFlagOptions.enableBetaCut && (track.beta() > cfgBetaCut)) {
-                histos.fill(HIST("tracks/triton/h2TOFmassantiTritonVsPt_BetaCut"), massTOF, track.pt());
-                histos.fill(HIST("tracks/triton/h2TOFmass2antiTritonVsPt_BetaCut"), m2diff, track.pt());
+                fillCost.fill(histos, HIST("tracks/triton/h2TOFmassantiTritonVsPt_BetaCut"), massTOF, track.pt());
+                fillCost.fill(histos, HIST("tracks/triton/h2TOFmass2antiTritonVsPt_BetaCut"), m2diff, track.pt());
               }
             }
           }
@@ -5104,86 +5112,86 @@ struct lfNucleiBATask {
 
         if (isDeWTPCpid) {
           if (outFlagOptions.enableEffPlots)
-            histos.fill(HIST("tracks/eff/deuteron/hPtDeTOF"), DPt);
-          histos.fill(HIST("tracks/deuteron/h2TOFmassDeuteronVsPt"), massTOF, DPt);
+            fillCost.fill(histos, HIST("tracks/eff/deuteron/hPtDeTOF"), DPt);
+          fillCost.fill(histos, HIST("tracks/deuteron/h2TOFmassDeuteronVsPt"), massTOF, DPt);
           if (enableCentrality)
-            histos.fill(HIST("tracks/deuteron/h3TOFmass2DeuteronVsPtVsMult"), massTOF * massTOF - MassDeuteronVal * MassDeuteronVal, DPt, centFT0M);
+            fillCost.fill(histos, HIST("tracks/deuteron/h3TOFmass2DeuteronVsPtVsMult"), massTOF * massTOF - MassDeuteronVal * MassDeuteronVal, DPt, centFT0M);
           else
-            histos.fill(HIST("tracks/deuteron/h2TOFmass2DeuteronVsPt"), massTOF * massTOF - MassDeuteronVal * MassDeuteronVal, DPt);
+            fillCost.fill(histos, HIST("tracks/deuteron/h2TOFmass2DeuteronVsPt"), massTOF * massTOF - MassDeuteronVal * MassDeuteronVal, DPt);
           if (outFlagOptions.enableBetaCut && (track.beta() > cfgBetaCut)) {
-            histos.fill(HIST("tracks/deuteron/h2TOFmassDeuteronVsPt_BetaCut"), massTOF, DPt);
-            histos.fill(HIST("tracks/deuteron/h2TOFmass2DeuteronVsPt_BetaCut"), massTOF * massTOF - MassDeuteronVal * MassDeuteronVal, DPt);
+            fillCost.fill(histos, HIST("tracks/deuteron/h2TOFmassDeuteronVsPt_BetaCut"), massTOF, DPt);
+            fillCost.fill(histos, HIST("tracks/deuteron/h2TOFmass2DeuteronVsPt_BetaCut"), massTOF * massTOF - MassDeuteronVal * MassDeuteronVal, DPt);
           }
           if (outFlagOptions.enableExpSignalTOF)
-            histos.fill(HIST("tracks/deuteron/h2DeuteronTOFExpSignalDiffVsPtCut"), DPt, track.tofExpSignalDiffDe());
+            fillCost.fill(histos, HIST("tracks/deuteron/h2DeuteronTOFExpSignalDiffVsPtCut"), DPt, track.tofExpSignalDiffDe());
           if (filterOptions.enableEvTimeSplitting) {
             if (track.isEvTimeTOF() && track.isEvTimeT0AC()) {
-              evtimeHistos.fill(HIST("tracks/evtime/ft0tof/deuteron/h2TOFmass2DeuteronVsPt"), massTOF * massTOF - MassDeuteronVal * MassDeuteronVal, DPt);
+              fillCost.fill(evtimeHistos, HIST("tracks/evtime/ft0tof/deuteron/h2TOFmass2DeuteronVsPt"), massTOF * massTOF - MassDeuteronVal * MassDeuteronVal, DPt);
             } else if (track.isEvTimeT0AC()) {
-              evtimeHistos.fill(HIST("tracks/evtime/ft0/deuteron/h2TOFmass2DeuteronVsPt"), massTOF * massTOF - MassDeuteronVal * MassDeuteronVal, DPt);
+              fillCost.fill(evtimeHistos, HIST("tracks/evtime/ft0/deuteron/h2TOFmass2DeuteronVsPt"), massTOF * massTOF - MassDeuteronVal * MassDeuteronVal, DPt);
             } else if (track.isEvTimeTOF()) {
-              evtimeHistos.fill(HIST("tracks/evtime/tof/deuteron/h2TOFmass2DeuteronVsPt"), massTOF * massTOF - MassDeuteronVal * MassDeuteronVal, DPt);
+              fillCost.fill(evtimeHistos, HIST("tracks/evtime/tof/deuteron/h2TOFmass2DeuteronVsPt"), massTOF * massTOF - MassDeuteronVal * MassDeuteronVal, DPt);
             } else {
-              evtimeHistos.fill(HIST("tracks/evtime/fill/deuteron/h2TOFmass2DeuteronVsPt"), massTOF * massTOF - MassDeuteronVal * MassDeuteronVal, DPt);
+              fillCost.fill(evtimeHistos, HIST("tracks/evtime/fill/deuteron/h2TOFmass2DeuteronVsPt"), massTOF * massTOF - MassDeuteronVal * MassDeuteronVal, DPt);
             }
           }
         }
         if (isAntiDeWTPCpid) {
           if (outFlagOptions.enableEffPlots)
-            histos.fill(HIST("tracks/eff/deuteron/hPtantiDeTOF"), antiDPt);
-          histos.fill(HIST("tracks/deuteron/h2TOFmassantiDeuteronVsPt"), massTOF, antiDPt);
+            fillCost.fill(histos, HIST("tracks/eff/deuteron/hPtantiDeTOF"), antiDPt);
+          fillCost.fill(histos, HIST("tracks/deuteron/h2TOFmassantiDeuteronVsPt"), massTOF, antiDPt);
           if (enableCentrality)
-            histos.fill(HIST("tracks/deuteron/h3TOFmass2antiDeuteronVsPtVsMult"), massTOF * massTOF - MassDeuteronVal * MassDeuteronVal, antiDPt, centFT0M);
+            fillCost.fill(histos, HIST("tracks/deuteron/h3TOFmass2antiDeuteronVsPtVsMult"), massTOF * massTOF - MassDeuteronVal * MassDeuteronVal, antiDPt, centFT0M);
           else
-            histos.fill(HIST("tracks/deuteron/h2TOFmass2antiDeuteronVsPt"), massTOF * massTOF - MassDeuteronVal * MassDeuteronVal, antiDPt);
+            fillCost.fill(histos, HIST("tracks/deuteron/h2TOFmass2antiDeuteronVsPt"), massTOF * massTOF - MassDeuteronVal * MassDeuteronVal, antiDPt);
           if (outFlagOptions.enableBetaCut && (track.beta() > cfgBetaCut)) {
-            histos.fill(HIST("tracks/deuteron/h2TOFmassantiDeuteronVsPt_BetaCut"), massTOF, antiDPt);
-            histos.fill(HIST("tracks/deuteron/h2TOFmass2antiDeuteronVsPt_BetaCut"), massTOF * massTOF - MassDeuteronVal * MassDeuteronVal, antiDPt);
+            fillCost.fill(histos, HIST("tracks/deuteron/h2TOFmassantiDeuteronVsPt_BetaCut"), massTOF, antiDPt);
+            fillCost.fill(histos, HIST("tracks/deuteron/h2TOFmass2antiDeuteronVsPt_BetaCut"), massTOF * massTOF - MassDeuteronVal * MassDeuteronVal, antiDPt);
           }
           if (outFlagOptions.enableExpSignalTOF)
-            histos.fill(HIST("tracks/deuteron/h2antiDeuteronTOFExpSignalDiffVsPtCut"), antiDPt, track.tofExpSignalDiffDe());
+            fillCost.fill(histos, HIST("tracks/deuteron/h2antiDeuteronTOFExpSignalDiffVsPtCut"), antiDPt, track.tofExpSignalDiffDe());
           if (filterOptions.enableEvTimeSplitting) {
             if (track.isEvTimeTOF() && track.isEvTimeT0AC()) {
-              evtimeHistos.fill(HIST("tracks/evtime/ft0tof/deuteron/h2TOFmass2antiDeuteronVsPt"), massTOF * massTOF - MassDeuteronVal * MassDeuteronVal, antiDPt);
+              fillCost.fill(evtimeHistos, HIST("tracks/evtime/ft0tof/deuteron/h2TOFmass2antiDeuteronVsPt"), massTOF * massTOF - MassDeuteronVal * MassDeuteronVal, antiDPt);
             } else if (track.isEvTimeT0AC()) {
-              evtimeHistos.fill(HIST("tracks/evtime/ft0/deuteron/h2TOFmass2antiDeuteronVsPt"), massTOF * massTOF - MassDeuteronVal * MassDeuteronVal, antiDPt);
+              fillCost.fill(evtimeHistos, HIST("tracks/evtime/ft0/deuteron/h2TOFmass2antiDeuteronVsPt"), massTOF * massTOF - MassDeuteronVal * MassDeuteronVal, antiDPt);
             } else if (track.isEvTimeTOF()) {
-              evtimeHistos.fill(HIST("tracks/evtime/tof/deuteron/h2TOFmass2antiDeuteronVsPt"), massTOF * massTOF - MassDeuteronVal * MassDeuteronVal, antiDPt);
+              fillCost.fill(evtimeHistos, HIST("tracks/evtime/tof/deuteron/h2TOFmass2antiDeuteronVsPt"), massTOF * massTOF - MassDeuteronVal * MassDeuteronVal, antiDPt);
             } else {
-              evtimeHistos.fill(HIST("tracks/evtime/fill/deuteron/h2TOFmass2antiDeuteronVsPt"), massTOF * massTOF - MassDeuteronVal * MassDeuteronVal, antiDPt);
+              fillCost.fill(evtimeHistos, HIST("tracks/evtime/fill/deuteron/h2TOFmass2antiDeuteronVsPt"), massTOF * massTOF - MassDeuteronVal * MassDeuteronVal, antiDPt);
             }
           }
         }
 
         if (isHeWTPCpid) {
           if (outFlagOptions.enableEffPlots)
-            histos.fill(HIST("tracks/eff/helium/hPtHeTOF"), 2 * hePt);
-          histos.fill(HIST("tracks/helium/h2TOFmassHeliumVsPt"), 2.f * massTOFhe, hePt);
-          histos.fill(HIST("tracks/helium/h2TOFmassDeltaHeliumVsPt"), 2.f * massTOFhe - MassHeliumVal, hePt);
-          histos.fill(HIST("tracks/helium/h2TOFmass2HeliumVsPt"), 2.f * massTOFhe * 2.f * massTOFhe - MassHeliumVal * MassHeliumVal, hePt);
+            fillCost.fill(histos, HIST("tracks/eff/helium/hPtHeTOF"), 2 * hePt);
+          fillCost.fill(histos, HIST("tracks/helium/h2TOFmassHeliumVsPt"), 2.f * massTOFhe, hePt);
+          fillCost.fill(histos, HIST("tracks/helium/h2TOFmassDeltaHeliumVsPt"), 2.f * massTOFhe - MassHeliumVal, hePt);
+          fillCost.fill(histos, HIST("tracks/helium/h2TOFmass2HeliumVsPt"), 2.f * massTOFhe * 2.f * massTOFhe - MassHeliumVal * MassHeliumVal, hePt);
           if (enableCentrality)
-            histos.fill(HIST("tracks/helium/h3TOFmass2HeliumVsPtVsMult"), 2.f * massTOFantihe * 2.f * massTOFantihe - MassHeliumVal * MassHeliumVal, hePt, centFT0M);
+            fillCost.fill(histos, HIST("tracks/helium/h3TOFmass2HeliumVsPtVsMult"), 2.f * massTOFantihe * 2.f * massTOFantihe - MassHeliumVal * MassHeliumVal, hePt, centFT0M);
           if (outFlagOptions.enableBetaCut && (track.beta() > cfgBetaCut)) {
-            histos.fill(HIST("tracks/helium/h2TOFmassHeliumVsPt_BetaCut"), 2.f * massTOFhe, hePt);
-            histos.fill(HIST("tracks/helium/h2TOFmass2HeliumVsPt_BetaCut"), 2.f * massTOFhe * 2.f * massTOFhe - MassHeliumVal * MassHeliumVal, hePt);
+            fillCost.fill(histos, HIST("tracks/helium/h2TOFmassHeliumVsPt_BetaCut"), 2.f * massTOFhe, hePt);
+            fillCost.fill(histos, HIST("tracks/helium/h2TOFmass2HeliumVsPt_BetaCut"), 2.f * massTOFhe * 2.f * massTOFhe - MassHeliumVal * MassHeliumVal, hePt);
           }
           if (outFlagOptions.enableExpSignalTOF)
-            histos.fill(HIST("tracks/helium/h2HeliumTOFExpSignalDiffVsPtCut"), hePt, track.tofExpSignalDiffHe());
+            fillCost.fill(histos, HIST("tracks/helium/h2HeliumTOFExpSignalDiffVsPtCut"), hePt, track.tofExpSignalDiffHe());
         }
         if (isAntiHeWTPCpid) {
           if (outFlagOptions.enableEffPlots)
-            histos.fill(HIST("tracks/eff/helium/hPtantiHeTOF"), 2 * antihePt);
-          histos.fill(HIST("tracks/helium/h2TOFmassantiHeliumVsPt"), 2.f * massTOFantihe, antihePt);
-          histos.fill(HIST("tracks/helium/h2TOFmassDeltaantiHeliumVsPt"), 2.f * massTOFantihe - MassHeliumVal, antihePt);
-          histos.fill(HIST("tracks/helium/h2TOFmass2antiHeliumVsPt"), 2.f * massTOFantihe * 2.f * massTOFantihe - MassHeliumVal * MassHeliumVal, antihePt);
+            fillCost.fill(histos, HIST("tracks/eff/helium/hPtantiHeTOF"), 2 * antihePt);
+          fillCost.fill(histos, HIST("tracks/helium/h2TOFmassantiHeliumVsPt"), 2.f * massTOFantihe, antihePt);
+          fillCost.fill(histos, HIST("tracks/helium/h2TOFmassDeltaantiHeliumVsPt"), 2.f * massTOFantihe - MassHeliumVal, antihePt);
+          fillCost.fill(histos, HIST("tracks/helium/h2TOFmass2antiHeliumVsPt"), 2.f * massTOFantihe * 2.f * massTOFantihe - MassHeliumVal * MassHeliumVal, antihePt);
           if (enableCentrality)
-            histos.fill(HIST("tracks/helium/h3TOFmass2antiHeliumVsPtVsMult"), 2.f * massTOFantihe * 2.f * massTOFantihe - MassHeliumVal * MassHeliumVal, antihePt, centFT0M);
+            fillCost.fill(histos, HIST("tracks/helium/h3TOFmass2antiHeliumVsPtVsMult"), 2.f * massTOFantihe * 2.f * massTOFantihe - MassHeliumVal * MassHeliumVal, antihePt, centFT0M);
           if (outFlagOptions.enableBetaCut && (track.beta() > cfgBetaCut)) {
-            histos.fill(HIST("tracks/helium/h2TOFmassantiHeliumVsPt_BetaCut"), 2.f * massTOFantihe, antihePt);
-            histos.fill(HIST("tracks/helium/h2TOFmass2antiHeliumVsPt_BetaCut"), 2.f * massTOFantihe * 2.f * massTOFantihe - MassHeliumVal * MassHeliumVal, antihePt);
+            fillCost.fill(histos, HIST("tracks/helium/h2TOFmassantiHeliumVsPt_BetaCut"), 2.f * massTOFantihe, antihePt);
+            fillCost.fill(histos, HIST("tracks/helium/h2TOFmass2antiHeliumVsPt_BetaCut"), 2.f * massTOFantihe * 2.f * massTOFantihe - MassHeliumVal * MassHeliumVal, antihePt);
           }
           if (outFlagOptions.enableExpSignalTOF)
-            histos.fill(HIST("tracks/helium/h2antiHeliumTOFExpSignalDiffVsPtCut"), antihePt, track.tofExpSignalDiffHe());
+            fillCost.fill(histos, HIST("tracks/helium/h2antiHeliumTOFExpSignalDiffVsPtCut"), antihePt, track.tofExpSignalDiffHe());
         }
       }
 
@@ -5240,86 +5248,86 @@ struct lfNucleiBATask {
         if (passDCAxyzCut) {
           if ((track.sign() > 0) && enableTrackingEff) {
             if (isItsPassed) {
-              debugHistos.fill(HIST("tracks/trackingEff/h1_its"), track.pt());
+              fillCost.fill(debugHistos, HIST("tracks/trackingEff/h1_its"), track.pt());
               if (isGoodHit) {
-                debugHistos.fill(HIST("tracks/trackingEff/h1GoodHit_its"), track.pt());
+                fillCost.fill(debugHistos, HIST("tracks/trackingEff/h1GoodHit_its"), track.pt());
               }
             }
 
             if (isTpcPassed) {
-              debugHistos.fill(HIST("tracks/trackingEff/h1_tpc"), track.pt());
+              fillCost.fill(debugHistos, HIST("tracks/trackingEff/h1_tpc"), track.pt());
               if (isGoodHit) {
-                debugHistos.fill(HIST("tracks/trackingEff/h1GoodHit_tpc"), track.pt());
+                fillCost.fill(debugHistos, HIST("tracks/trackingEff/h1GoodHit_tpc"), track.pt());
               }
             }
 
             if (isItsPassed && isTpcPassed) {
-              debugHistos.fill(HIST("tracks/trackingEff/h1_its_tpc"), track.pt());
+              fillCost.fill(debugHistos, HIST("tracks/trackingEff/h1_its_tpc"), track.pt());
               if (isGoodHit) {
-                debugHistos.fill(HIST("tracks/trackingEff/h1GoodHit_its_tpc"), track.pt());
+                fillCost.fill(debugHistos, HIST("tracks/trackingEff/h1GoodHit_its_tpc"), track.pt());
               }
             }
 
             if (isItsPassed && isTpcPassed && track.hasTOF()) {
-              debugHistos.fill(HIST("tracks/trackingEff/h1_its_tpc_tof"), track.pt());
+              fillCost.fill(debugHistos, HIST("tracks/trackingEff/h1_its_tpc_tof"), track.pt());
               if (isGoodHit) {
-                debugHistos.fill(HIST("tracks/trackingEff/h1GoodHit_its_tpc_tof"), track.pt());
+                fillCost.fill(debugHistos, HIST("tracks/trackingEff/h1GoodHit_its_tpc_tof"), track.pt());
               }
             }
 
             if (isItsPassed && isTpcPassed && track.hasTRD()) {
-              debugHistos.fill(HIST("tracks/trackingEff/h1_its_tpc_trd"), track.pt());
+              fillCost.fill(debugHistos, HIST("tracks/trackingEff/h1_its_tpc_trd"), track.pt());
               if (isGoodHit) {
-                debugHistos.fill(HIST("tracks/trackingEff/h1GoodHit_its_tpc_trd"), track.pt());
+                fillCost.fill(debugHistos, HIST("tracks/trackingEff/h1GoodHit_its_tpc_trd"), track.pt());
               }
             }
 
             if (isItsPassed && isTpcPassed && track.hasTOF() && track.hasTRD()) {
-              debugHistos.fill(HIST("tracks/trackingEff/h1_its_tpc_trd_tof"), track.pt());
+              fillCost.fill(debugHistos, HIST("tracks/trackingEff/h1_its_tpc_trd_tof"), track.pt());
               if (isGoodHit) {
-                debugHistos.fill(HIST("tracks/trackingEff/h1GoodHit_its_tpc_trd_tof"), track.pt());
+                fillCost.fill(debugHistos, HIST("tracks/trackingEff/h1GoodHit_its_tpc_trd_tof"), track.pt());
               }
             }
           } else if ((track.sign() < 0) && enableTrackingEff) {
             if (isItsPassed) {
-              debugHistos.fill(HIST("tracks/trackingEff/h1anti_its"), track.pt());
+              fillCost.fill(debugHistos, HIST("tracks/trackingEff/h1anti_its"), track.pt());
               if (isGoodHit) {
-                debugHistos.fill(HIST("tracks/trackingEff/h1antiGoodHit_its"), track.pt());
+                fillCost.fill(debugHistos, HIST("tracks/trackingEff/h1antiGoodHit_its"), track.pt());
               }
             }
 
             if (isTpcPassed) {
-              debugHistos.fill(HIST("tracks/trackingEff/h1anti_tpc"), track.pt());
+              fillCost.fill(debugHistos, HIST("tracks/trackingEff/h1anti_tpc"), track.pt());
               if (isGoodHit) {
-                debugHistos.fill(HIST("tracks/trackingEff/h1antiGoodHit_tpc"), track.pt());
+                fillCost.fill(debugHistos, HIST("tracks/trackingEff/h1antiGoodHit_tpc"), track.pt());
               }
             }
 
             if (isItsPassed && isTpcPassed) {
-              debugHistos.fill(HIST("tracks/trackingEff/h1anti_its_tpc"), track.pt());
+              fillCost.fill(debugHistos, HIST("tracks/trackingEff/h1anti_its_tpc"), track.pt());
               if (isGoodHit) {
-                debugHistos.fill(HIST("tracks/trackingEff/h1antiGoodHit_its_tpc"), track.pt());
+                fillCost.fill(debugHistos, HIST("tracks/trackingEff/h1antiGoodHit_its_tpc"), track.pt());
               }
             }
 
             if (isItsPassed && isTpcPassed && track.hasTOF()) {
-              debugHistos.fill(HIST("tracks/trackingEff/h1anti_its_tpc_tof"), track.pt());
+              fillCost.fill(debugHistos, HIST("tracks/trackingEff/h1anti_its_tpc_tof"), track.pt());
               if (isGoodHit) {
-                debugHistos.fill(HIST("tracks/trackingEff/h1antiGoodHit_its_tpc_tof"), track.pt());
+                fillCost.fill(debugHistos, HIST("tracks/trackingEff/h1antiGoodHit_its_tpc_tof"), track.pt());
               }
             }
 
             if (isItsPassed && isTpcPassed && track.hasTRD()) {
-              debugHistos.fill(HIST("tracks/trackingEff/h1anti_its_tpc_trd"), track.pt());
+              fillCost.fill(debugHistos, HIST("tracks/trackingEff/h1anti_its_tpc_trd"), track.pt());
               if (isGoodHit) {
-                debugHistos.fill(HIST("tracks/trackingEff/h1antiGoodHit_its_tpc_trd"), track.pt());
+                fillCost.fill(debugHistos, HIST("tracks/trackingEff/h1antiGoodHit_its_tpc_trd"), track.pt());
               }
             }
 
             if (isItsPassed && isTpcPassed && track.hasTOF() && track.hasTRD()) {
-              debugHistos.fill(HIST("tracks/trackingEff/h1anti_its_tpc_trd_tof"), track.pt());
+              fillCost.fill(debugHistos, HIST("tracks/trackingEff/h1anti_its_tpc_trd_tof"), track.pt());
               if (isGoodHit) {
-                debugHistos.fill(HIST("tracks/trackingEff/h1antiGoodHit_its_tpc_trd_tof"), track.pt());
+                fillCost.fill(debugHistos, HIST("tracks/trackingEff/h1antiGoodHit_its_tpc_trd_tof"), track.pt());
               }
             }
           }
@@ -5327,61 +5335,61 @@ struct lfNucleiBATask {
         switch (pdgCode) {
           case PDGProton:
             if (enablePr && prRapCut && passDCAxyzCut) {
-              histos.fill(HIST("tracks/proton/h1ProtonSpectraTrue"), track.pt());
+              fillCost.fill(histos, HIST("tracks/proton/h1ProtonSpectraTrue"), track.pt());
               if (outFlagOptions.makeDCAAfterCutPlots) {
-                histos.fill(HIST("tracks/proton/dca/after/hDCAxyVsPtProtonTrue"), track.pt(), track.dcaXY());
-                histos.fill(HIST("tracks/proton/dca/after/hDCAzVsPtProtonTrue"), track.pt(), track.dcaZ());
+                fillCost.fill(histos, HIST("tracks/proton/dca/after/hDCAxyVsPtProtonTrue"), track.pt(), track.dcaXY());
+                fillCost.fill(histos, HIST("tracks/proton/dca/after/hDCAzVsPtProtonTrue"), track.pt(), track.dcaZ());
               }
               if (std::abs(track.tpcNSigmaPr()) < nsigmaTPCvar.nsigmaTPCPr) {
-                histos.fill(HIST("tracks/proton/h1ProtonSpectraTrueWPID"), track.pt());
+                fillCost.fill(histos, HIST("tracks/proton/h1ProtonSpectraTrueWPID"), track.pt());
               }
               if (isPhysPrim) {
-                histos.fill(HIST("tracks/proton/h1ProtonSpectraTruePrim"), track.pt());
+                fillCost.fill(histos, HIST("tracks/proton/h1ProtonSpectraTruePrim"), track.pt());
                 if (outFlagOptions.makeDCAAfterCutPlots) {
-                  histos.fill(HIST("tracks/proton/dca/after/hDCAxyVsPtProtonTruePrim"), track.pt(), track.dcaXY());
-                  histos.fill(HIST("tracks/proton/dca/after/hDCAzVsPtProtonTruePrim"), track.pt(), track.dcaZ());
+                  fillCost.fill(histos, HIST("tracks/proton/dca/after/hDCAxyVsPtProtonTruePrim"), track.pt(), track.dcaXY());
+                  fillCost.fill(histos, HIST("tracks/proton/dca/after/hDCAzVsPtProtonTruePrim"), track.pt(), track.dcaZ());
                 }
 
                 if (enableTrackingEff) {
                   if (isItsPassed) {
-                    debugHistos.fill(HIST("tracks/proton/trackingEff/h1ProtonSpectra_its"), track.pt());
+                    fillCost.fill(debugHistos, HIST("tracks/proton/trackingEff/h1ProtonSpectra_its"), track.pt());
                     if (isGoodHit) {
-                      debugHistos.fill(HIST("tracks/proton/trackingEff/h1ProtonSpectraGoodHit_its"), track.pt());
+                      fillCost.fill(debugHistos, HIST("tracks/proton/trackingEff/h1ProtonSpectraGoodHit_its"), track.pt());
                     }
                   }
 
                   if (isTpcPassed) {
-                    debugHistos.fill(HIST("tracks/proton/trackingEff/h1ProtonSpectra_tpc"), track.pt());
+                    fillCost.fill(debugHistos, HIST("tracks/proton/trackingEff/h1ProtonSpectra_tpc"), track.pt());
                     if (isGoodHit) {
-                      debugHistos.fill(HIST("tracks/proton/trackingEff/h1ProtonSpectraGoodHit_tpc"), track.pt());
+                      fillCost.fill(debugHistos, HIST("tracks/proton/trackingEff/h1ProtonSpectraGoodHit_tpc"), track.pt());
                     }
                   }
 
                   if (isItsPassed && isTpcPassed) {
-                    debugHistos.fill(HIST("tracks/proton/trackingEff/h1ProtonSpectra_its_tpc"), track.pt());
+                    fillCost.fill(debugHistos, HIST("tracks/proton/trackingEff/h1ProtonSpectra_its_tpc"), track.pt());
                     if (isGoodHit) {
-                      debugHistos.fill(HIST("tracks/proton/trackingEff/h1ProtonSpectraGoodHit_its_tpc"), track.pt());
+                      fillCost.fill(debugHistos, HIST("tracks/proton/trackingEff/h1ProtonSpectraGoodHit_its_tpc"), track.pt());
                     }
                   }
 
                   if (isItsPassed && isTpcPassed && track.hasTOF()) {
-                    debugHistos.fill(HIST("tracks/proton/trackingEff/h1ProtonSpectra_its_tpc_tof"), track.pt());
+                    fillCost.fill(debugHistos, HIST("tracks/proton/trackingEff/h1ProtonSpectra_its_tpc_tof"), track.pt());
                     if (isGoodHit) {
-                      debugHistos.fill(HIST("tracks/proton/trackingEff/h1ProtonSpectraGoodHit_its_tpc_tof"), track.pt());
+                      fillCost.fill(debugHistos, HIST("tracks/proton/trackingEff/h1ProtonSpectraGoodHit_its_tpc_tof"), track.pt());
                     }
                   }
 
                   if (isItsPassed && isTpcPassed && track.hasTRD()) {
-                    debugHistos.fill(HIST("tracks/proton/trackingEff/h1ProtonSpectra_its_tpc_trd"), track.pt());
+                    fillCost.fill(debugHistos, HIST("tracks/proton/trackingEff/h1ProtonSpectra_its_tpc_trd"), track.pt());
                     if (isGoodHit) {
-                      debugHistos.fill(HIST("tracks/proton/trackingEff/h1ProtonSpectraGoodHit_its_tpc_trd"), track.pt());
+                      fillCost.fill(debugHistos, HIST("tracks/proton/trackingEff/h1ProtonSpectraGoodHit_its_tpc_trd"), track.pt());
                     }
                   }
 
                   if (isItsPassed && isTpcPassed && track.hasTOF() && track.hasTRD()) {
-                    debugHistos.fill(HIST("tracks/proton/trackingEff/h1ProtonSpectra_its_tpc_trd_tof"), track.pt());
+                    fillCost.fill(debugHistos, HIST("tracks/proton/trackingEff/h1ProtonSpectra_its_tpc_trd_tof"), track.pt());
                     if (isGoodHit) {
-                      debugHistos.fill(HIST("tracks/proton/trackingEff/h1ProtonSpectraGoodHit_its_tpc_trd_tof"), track.pt());
+                      fillCost.fill(debugHistos, HIST("tracks/proton/trackingEff/h1ProtonSpectraGoodHit_its_tpc_trd_tof"), track.pt());
                     }
                   }
                 }
@@ -5389,60 +5397,60 @@ struct lfNucleiBATask {
                 if (std::abs(track.tpcNSigmaPr()) < nsigmaTPCvar.nsigmaTPCPr) {
                   if (enableTrackingEff) {
                     if (isItsPassed) {
-                      debugHistos.fill(HIST("tracks/proton/trackingEffPID/h1ProtonSpectraPIDTruePrim_its"), track.pt());
+                      fillCost.fill(debugHistos, HIST("tracks/proton/trackingEffPID/h1ProtonSpectraPIDTruePrim_its"), track.pt());
                       if (isGoodHit) {
-                        debugHistos.fill(HIST("tracks/proton/trackingEffPID/h1ProtonSpectraPIDTruePrimGoodHit_its"), track.pt());
+                        fillCost.fill(debugHistos, HIST("tracks/proton/trackingEffPID/h1ProtonSpectraPIDTruePrimGoodHit_its"), track.pt());
                       }
                     }
 
                     if (isTpcPassed) {
-                      debugHistos.fill(HIST("tracks/proton/trackingEffPID/h1ProtonSpectraPIDTruePrim_tpc"), track.pt());
+                      fillCost.fill(debugHistos, HIST("tracks/proton/trackingEffPID/h1ProtonSpectraPIDTruePrim_tpc"), track.pt());
                       if (isGoodHit) {
-                        debugHistos.fill(HIST("tracks/proton/trackingEffPID/h1ProtonSpectraPIDTruePrimGoodHit_tpc"), track.pt());
+                        fillCost.fill(debugHistos, HIST("tracks/proton/trackingEffPID/h1ProtonSpectraPIDTruePrimGoodHit_tpc"), track.pt());
                       }
                     }
 
                     if (isItsPassed && isTpcPassed) {
-                      debugHistos.fill(HIST("tracks/proton/trackingEffPID/h1ProtonSpectraPIDTruePrim_its_tpc"), track.pt());
+                      fillCost.fill(debugHistos, HIST("tracks/proton/trackingEffPID/h1ProtonSpectraPIDTruePrim_its_tpc"), track.pt());
                       if (isGoodHit) {
-                        debugHistos.fill(HIST("tracks/proton/trackingEffPID/h1ProtonSpectraPIDTruePrimGoodHit_its_tpc"), track.pt());
+                        fillCost.fill(debugHistos, HIST("tracks/proton/trackingEffPID/h1ProtonSpectraPIDTruePrimGoodHit_its_tpc"), track.pt());
                       }
                     }
 
                     if (isItsPassed && isTpcPassed && track.hasTOF()) {
-                      debugHistos.fill(HIST("tracks/proton/trackingEffPID/h1ProtonSpectraPIDTruePrim_its_tpc_tof"), track.pt());
+                      fillCost.fill(debugHistos, HIST("tracks/proton/trackingEffPID/h1ProtonSpectraPIDTruePrim_its_tpc_tof"), track.pt());
                       if (isGoodHit) {
-                        debugHistos.fill(HIST("tracks/proton/trackingEffPID/h1ProtonSpectraPIDTruePrimGoodHit_its_tpc_tof"), track.pt());
+                        fillCost.fill(debugHistos, HIST("tracks/proton/trackingEffPID/h1ProtonSpectraPIDTruePrimGoodHit_its_tpc_tof"), track.pt());
                       }
                     }
 
                     if (isItsPassed && isTpcPassed && track.hasTRD()) {
-                      debugHistos.fill(HIST("tracks/proton/trackingEffPID/h1ProtonSpectraPIDTruePrim_its_tpc_trd"), track.pt());
+                      fillCost.fill(debugHistos, HIST("tracks/proton/trackingEffPID/h1ProtonSpectraPIDTruePrim_its_tpc_trd"), track.pt());
                       if (isGoodHit) {
-                        debugHistos.fill(HIST("tracks/proton/trackingEffPID/h1ProtonSpectraPIDTruePrimGoodHit_its_tpc_trd"), track.pt());
+                        fillCost.fill(debugHistos, HIST("tracks/proton/trackingEffPID/h1ProtonSpectraPIDTruePrimGoodHit_its_tpc_trd"), track.pt());
                       }
                     }
 
                     if (isItsPassed && isTpcPassed && track.hasTOF() && track.hasTRD()) {
-                      debugHistos.fill(HIST("tracks/proton/trackingEffPID/h1ProtonSpectraPIDTruePrim_its_tpc_trd_tof"), track.pt());
+                      fillCost.fill(debugHistos, HIST("tracks/proton/trackingEffPID/h1ProtonSpectraPIDTruePrim_its_tpc_trd_tof"), track.pt());
                       if (isGoodHit) {
-                        debugHistos.fill(HIST("tracks/proton/trackingEffPID/h1ProtonSpectraPIDTruePrimGoodHit_its_tpc_trd_tof"), track.pt());
+                        fillCost.fill(debugHistos, HIST("tracks/proton/trackingEffPID/h1ProtonSpectraPIDTruePrimGoodHit_its_tpc_trd_tof"), track.pt());
                       }
                     }
                   }
                 }
               }
               if (!isPhysPrim && !isProdByGen) {
-                histos.fill(HIST("tracks/proton/h1ProtonSpectraTrueTransport"), track.pt());
+                fillCost.fill(histos, HIST("tracks/proton/h1ProtonSpectraTrueTransport"), track.pt());
                 if (outFlagOptions.makeDCAAfterCutPlots) {
-                  histos.fill(HIST("tracks/proton/dca/after/hDCAxyVsPtProtonTrueTransport"), track.pt(), track.dcaXY());
-                  histos.fill(HIST("tracks/proton/dca/after/hDCAzVsPtProtonTrueTransport"), track.pt(), track.dcaZ());
+                  fillCost.fill(histos, HIST("tracks/proton/dca/after/hDCAxyVsPtProtonTrueTransport"), track.pt(), track.dcaXY());
+                  fillCost.fill(histos, HIST("tracks/proton/dca/after/hDCAzVsPtProtonTrueTransport"), track.pt(), track.dcaZ());
                 }
                 if (isWeakDecay) {
-                  histos.fill(HIST("tracks/proton/h1ProtonSpectraTrueSec"), track.pt());
+                  fillCost.fill(histos, HIST("tracks/proton/h1ProtonSpectraTrueSec"), track.pt());
                   if (outFlagOptions.makeDCAAfterCutPlots) {
-                    histos.fill(HIST("tracks/proton/dca/after/hDCAxyVsPtProtonTrueSec"), track.pt(), track.dcaXY());
-                    histos.fill(HIST("tracks/proton/dca/after/hDCAzVsPtProtonTrueSec"), track.pt(), track.dcaZ());
+                    fillCost.fill(histos, HIST("tracks/proton/dca/after/hDCAxyVsPtProtonTrueSec"), track.pt(), track.dcaXY());
+                    fillCost.fill(histos, HIST("tracks/proton/dca/after/hDCAzVsPtProtonTrueSec"), track.pt(), track.dcaZ());
                   }
                 }
               }
@@ -5450,61 +5458,61 @@ struct lfNucleiBATask {
             break;
           case -PDGProton:
             if (enablePr && prRapCut && passDCAxyzCut) {
-              histos.fill(HIST("tracks/proton/h1antiProtonSpectraTrue"), track.pt());
+              fillCost.fill(histos, HIST("tracks/proton/h1antiProtonSpectraTrue"), track.pt());
               if (outFlagOptions.makeDCAAfterCutPlots) {
-                histos.fill(HIST("tracks/proton/dca/after/hDCAxyVsPtantiProtonTrue"), track.pt(), track.dcaXY());
-                histos.fill(HIST("tracks/proton/dca/after/hDCAzVsPtantiProtonTrue"), track.pt(), track.dcaZ());
+                fillCost.fill(histos, HIST("tracks/proton/dca/after/hDCAxyVsPtantiProtonTrue"), track.pt(), track.dcaXY());
+                fillCost.fill(histos, HIST("tracks/proton/dca/after/hDCAzVsPtantiProtonTrue"), track.pt(), track.dcaZ());
               }
               if (std::abs(track.tpcNSigmaPr()) < nsigmaTPCvar.nsigmaTPCPr) {
-                histos.fill(HIST("tracks/proton/h1antiProtonSpectraTrueWPID"), track.pt());
+                fillCost.fill(histos, HIST("tracks/proton/h1antiProtonSpectraTrueWPID"), track.pt());
               }
               if (isPhysPrim) {
-                histos.fill(HIST("tracks/proton/h1antiProtonSpectraTruePrim"), track.pt());
+                fillCost.fill(histos, HIST("tracks/proton/h1antiProtonSpectraTruePrim"), track.pt());
                 if (outFlagOptions.makeDCAAfterCutPlots) {
-                  histos.fill(HIST("tracks/proton/dca/after/hDCAxyVsPtantiProtonTruePrim"), track.pt(), track.dcaXY());
-                  histos.fill(HIST("tracks/proton/dca/after/hDCAzVsPtantiProtonTruePrim"), track.pt(), track.dcaZ());
+                  fillCost.fill(histos, HIST("tracks/proton/dca/after/hDCAxyVsPtantiProtonTruePrim"), track.pt(), track.dcaXY());
+                  fillCost.fill(histos, HIST("tracks/proton/dca/after/hDCAzVsPtantiProtonTruePrim"), track.pt(), track.dcaZ());
                 }
 
                 if (enableTrackingEff) {
                   if (isItsPassed) {
-                    debugHistos.fill(HIST("tracks/proton/trackingEff/h1antiProtonSpectra_its"), track.pt());
+                    fillCost.fill(debugHistos, HIST("tracks/proton/trackingEff/h1antiProtonSpectra_its"), track.pt());
                     if (isGoodHit) {
-                      debugHistos.fill(HIST("tracks/proton/trackingEff/h1antiProtonSpectraGoodHit_its"), track.pt());
+                      fillCost.fill(debugHistos, HIST("tracks/proton/trackingEff/h1antiProtonSpectraGoodHit_its"), track.pt());
                     }
                   }
 
                   if (isTpcPassed) {
-                    debugHistos.fill(HIST("tracks/proton/trackingEff/h1antiProtonSpectra_tpc"), track.pt());
+                    fillCost.fill(debugHistos, HIST("tracks/proton/trackingEff/h1antiProtonSpectra_tpc"), track.pt());
                     if (isGoodHit) {
-                      debugHistos.fill(HIST("tracks/proton/trackingEff/h1antiProtonSpectraGoodHit_tpc"), track.pt());
+                      fillCost.fill(debugHistos, HIST("tracks/proton/trackingEff/h1antiProtonSpectraGoodHit_tpc"), track.pt());
                     }
                   }
 
                   if (isItsPassed && isTpcPassed) {
-                    debugHistos.fill(HIST("tracks/proton/trackingEff/h1antiProtonSpectra_its_tpc"), track.pt());
+                    fillCost.fill(debugHistos, HIST("tracks/proton/trackingEff/h1antiProtonSpectra_its_tpc"), track.pt());
                     if (isGoodHit) {
-                      debugHistos.fill(HIST("tracks/proton/trackingEff/h1antiProtonSpectraGoodHit_its_tpc"), track.pt());
+                      fillCost.fill(debugHistos, HIST("tracks/proton/trackingEff/h1antiProtonSpectraGoodHit_its_tpc"), track.pt());
                     }
                   }
 
                   if (isItsPassed && isTpcPassed && track.hasTOF()) {
-                    debugHistos.fill(HIST("tracks/proton/trackingEff/h1antiProtonSpectra_its_tpc_tof"), track.pt());
+                    fillCost.fill(debugHistos, HIST("tracks/proton/trackingEff/h1antiProtonSpectra_its_tpc_tof"), track.pt());
                     if (isGoodHit) {
-                      debugHistos.fill(HIST("tracks/proton/trackingEff/h1antiProtonSpectraGoodHit_its_tpc_tof"), track.pt());
+                      fillCost.fill(debugHistos, HIST("tracks/proton/trackingEff/h1antiProtonSpectraGoodHit_its_tpc_tof"), track.pt());
                     }
                   }
 
                   if (isItsPassed && isTpcPassed && track.hasTRD()) {
-                    debugHistos.fill(HIST("tracks/proton/trackingEff/h1antiProtonSpectra_its_tpc_trd"), track.pt());
+                    fillCost.fill(debugHistos, HIST("tracks/proton/trackingEff/h1antiProtonSpectra_its_tpc_trd"), track.pt());
                     if (isGoodHit) {
-                      debugHistos.fill(HIST("tracks/proton/trackingEff/h1antiProtonSpectraGoodHit_its_tpc_trd"), track.pt());
+                      fillCost.fill(debugHistos, HIST("tracks/proton/trackingEff/h1antiProtonSpectraGoodHit_its_tpc_trd"), track.pt());
                     }
                   }
 
                   if (isItsPassed && isTpcPassed && track.hasTOF() && track.hasTRD()) {
-                    debugHistos.fill(HIST("tracks/proton/trackingEff/h1antiProtonSpectra_its_tpc_trd_tof"), track.pt());
+                    fillCost.fill(debugHistos, HIST("tracks/proton/trackingEff/h1antiProtonSpectra_its_tpc_trd_tof"), track.pt());
                     if (isGoodHit) {
-                      debugHistos.fill(HIST("tracks/proton/trackingEff/h1antiProtonSpectraGoodHit_its_tpc_trd_tof"), track.pt());
+                      fillCost.fill(debugHistos, HIST("tracks/proton/trackingEff/h1antiProtonSpectraGoodHit_its_tpc_trd_tof"), track.pt());
                     }
                   }
                 }
@@ -5512,44 +5520,44 @@ struct lfNucleiBATask {
                 if (std::abs(track.tpcNSigmaPr()) < nsigmaTPCvar.nsigmaTPCPr) {
                   if (enableTrackingEff) {
                     if (isItsPassed) {
-                      debugHistos.fill(HIST("tracks/proton/trackingEffPID/h1antiProtonSpectraPIDTruePrim_its"), track.pt());
+                      fillCost.fill(debugHistos, HIST("tracks/proton/trackingEffPID/h1antiProtonSpectraPIDTruePrim_its"), track.pt());
                       if (isGoodHit) {
-                        debugHistos.fill(HIST("tracks/proton/trackingEffPID/h1antiProtonSpectraPIDTruePrimGoodHit_its"), track.pt());
+                        fillCost.fill(debugHistos, HIST("tracks/proton/trackingEffPID/h1antiProtonSpectraPIDTruePrimGoodHit_its"), track.pt());
                       }
                     }
 
                     if (isTpcPassed) {
-                      debugHistos.fill(HIST("tracks/proton/trackingEffPID/h1antiProtonSpectraPIDTruePrim_tpc"), track.pt());
+                      fillCost.fill(debugHistos, HIST("tracks/proton/trackingEffPID/h1antiProtonSpectraPIDTruePrim_tpc"), track.pt());
                       if (isGoodHit) {
-                        debugHistos.fill(HIST("tracks/proton/trackingEffPID/h1antiProtonSpectraPIDTruePrimGoodHit_tpc"), track.pt());
+                        fillCost.fill(debugHistos, HIST("tracks/proton/trackingEffPID/h1antiProtonSpectraPIDTruePrimGoodHit_tpc"), track.pt());
                       }
                     }
 
                     if (isItsPassed && isTpcPassed) {
-                      debugHistos.fill(HIST("tracks/proton/trackingEffPID/h1antiProtonSpectraPIDTruePrim_its_tpc"), track.pt());
+                      fillCost.fill(debugHistos, HIST("tracks/proton/trackingEffPID/h1antiProtonSpectraPIDTruePrim_its_tpc"), track.pt());
                       if (isGoodHit) {
-                        debugHistos.fill(HIST("tracks/proton/trackingEffPID/h1antiProtonSpectraPIDTruePrimGoodHit_its_tpc"), track.pt());
+                        fillCost.fill(debugHistos, HIST("tracks/proton/trackingEffPID/h1antiProtonSpectraPIDTruePrimGoodHit_its_tpc"), track.pt());
                       }
                     }
 
                     if (isItsPassed && isTpcPassed && track.hasTOF()) {
-                      debugHistos.fill(HIST("tracks/proton/trackingEffPID/h1antiProtonSpectraPIDTruePrim_its_tpc_tof"), track.pt());
+                      fillCost.fill(debugHistos, HIST("tracks/proton/trackingEffPID/h1antiProtonSpectraPIDTruePrim_its_tpc_tof"), track.pt());
                       if (isGoodHit) {
-                        debugHistos.fill(HIST("tracks/proton/trackingEffPID/h1antiProtonSpectraPIDTruePrimGoodHit_its_tpc_tof"), track.pt());
+                        fillCost.fill(debugHistos, HIST("tracks/proton/trackingEffPID/h1antiProtonSpectraPIDTruePrimGoodHit_its_tpc_tof"), track.pt());
                       }
                     }
 
                     if (isItsPassed && isTpcPassed && track.hasTRD()) {
-                      debugHistos.fill(HIST("tracks/proton/trackingEffPID/h1antiProtonSpectraPIDTruePrim_its_tpc_trd"), track.pt());
+                      fillCost.fill(debugHistos, HIST("tracks/proton/trackingEffPID/h1antiProtonSpectraPIDTruePrim_its_tpc_trd"), track.pt());
                       if (isGoodHit) {
-                        debugHistos.fill(HIST("tracks/proton/trackingEffPID/h1antiProtonSpectraPIDTruePrimGoodHit_its_tpc_trd"), track.pt());
+                        fillCost.fill(debugHistos, HIST("tracks/proton/trackingEffPID/h1antiProtonSpectraPIDTruePrimGoodHit_its_tpc_trd"), track.pt());
                       }
                     }
 
                     if (isItsPassed && isTpcPassed && track.hasTOF() && track.hasTRD()) {
-                      debugHistos.fill(HIST("tracks/proton/trackingEffPID/h1antiProtonSpectraPIDTruePrim_its_tpc_trd_tof"), track.pt());
+                      fillCost.fill(debugHistos, HIST("tracks/proton/trackingEffPID/h1antiProtonSpectraPIDTruePrim_its_tpc_trd_tof"), track.pt());
                       if (isGoodHit) {
-                        debugHistos.fill(HIST("tracks/proton/trackingEffPID/h1antiProtonSpectraPIDTruePrimGoodHit_its_tpc_trd_tof"), track.pt());
+                        fillCost.fill(debugHistos, HIST("tracks/proton/trackingEffPID/h1antiProtonSpectraPIDTruePrimGoodHit_its_tpc_trd_tof"), track.pt());
                       }
                     }
                   }
@@ -5557,16 +5565,16 @@ struct lfNucleiBATask {
               }
 
               if (!isPhysPrim && !isProdByGen) {
-                histos.fill(HIST("tracks/proton/h1antiProtonSpectraTrueTransport"), track.pt());
+                fillCost.fill(histos, HIST("tracks/proton/h1antiProtonSpectraTrueTransport"), track.pt());
                 if (outFlagOptions.makeDCAAfterCutPlots) {
-                  histos.fill(HIST("tracks/proton/dca/after/hDCAxyVsPtantiProtonTrueTransport"), track.pt(), track.dcaXY());
-                  histos.fill(HIST("tracks/proton/dca/after/hDCAzVsPtantiProtonTrueTransport"), track.pt(), track.dcaZ());
+                  fillCost.fill(histos, HIST("tracks/proton/dca/after/hDCAxyVsPtantiProtonTrueTransport"), track.pt(), track.dcaXY());
+                  fillCost.fill(histos, HIST("tracks/proton/dca/after/hDCAzVsPtantiProtonTrueTransport"), track.pt(), track.dcaZ());
                 }
                 if (isWeakDecay) {
-                  histos.fill(HIST("tracks/proton/h1antiProtonSpectraTrueSec"), track.pt());
+                  fillCost.fill(histos, HIST("tracks/proton/h1antiProtonSpectraTrueSec"), track.pt());
                   if (outFlagOptions.makeDCAAfterCutPlots) {
-                    histos.fill(HIST("tracks/proton/dca/after/hDCAxyVsPtantiProtonTrueSec"), track.pt(), track.dcaXY());
-                    histos.fill(HIST("tracks/proton/dca/after/hDCAzVsPtantiProtonTrueSec"), track.pt(), track.dcaZ());
+                    fillCost.fill(histos, HIST("tracks/proton/dca/after/hDCAxyVsPtantiProtonTrueSec"), track.pt(), track.dcaXY());
+                    fillCost.fill(histos, HIST("tracks/proton/dca/after/hDCAzVsPtantiProtonTrueSec"), track.pt(), track.dcaZ());
                   }
                 }
               }
@@ -5574,135 +5582,135 @@ struct lfNucleiBATask {
             break;
           case PDGDeuteron:
             if (isDeuteron && passDCAzCutDe && passDCAxyCutDe) {
-              histos.fill(HIST("tracks/deuteron/h1DeuteronSpectraTrue"), DPt);
+              fillCost.fill(histos, HIST("tracks/deuteron/h1DeuteronSpectraTrue"), DPt);
               if (outFlagOptions.makeDCAAfterCutPlots) {
-                histos.fill(HIST("tracks/deuteron/dca/after/hDCAxyVsPtDeuteronTrue"), DPt, track.dcaXY());
-                histos.fill(HIST("tracks/deuteron/dca/after/hDCAzVsPtDeuteronTrue"), DPt, track.dcaZ());
+                fillCost.fill(histos, HIST("tracks/deuteron/dca/after/hDCAxyVsPtDeuteronTrue"), DPt, track.dcaXY());
+                fillCost.fill(histos, HIST("tracks/deuteron/dca/after/hDCAzVsPtDeuteronTrue"), DPt, track.dcaZ());
               }
-              if (std::abs(track.tpcNSigmaDe()) < nsigmaTPCvar.nsigmaTPCDe) {
-                histos.fill(HIST("tracks/deuteron/h1DeuteronSpectraTrueWPID"), DPt);
+              if (passTPCDe) {
+                fillCost.fill(histos, HIST("tracks/deuteron/h1DeuteronSpectraTrueWPID"), DPt);
                 if (track.hasTOF() && outFlagOptions.doTOFplots) {
-                  histos.fill(HIST("tracks/deuteron/hPtDeuteronTOFTrue"), DPt);
+                  fillCost.fill(histos, HIST("tracks/deuteron/hPtDeuteronTOFTrue"), DPt);
                 }
               }
               if (isPhysPrim) {
-                histos.fill(HIST("tracks/deuteron/h2DeuteronVspTNSigmaTPCTruePrim"), DPt, track.tpcNSigmaDe());
-                histos.fill(HIST("tracks/deuteron/h1DeuteronSpectraTruePrim"), DPt);
+                fillCost.fill(histos, HIST("tracks/deuteron/h2DeuteronVspTNSigmaTPCTruePrim"), DPt, track.tpcNSigmaDe());
+                fillCost.fill(histos, HIST("tracks/deuteron/h1DeuteronSpectraTruePrim"), DPt);
                 if (outFlagOptions.makeDCAAfterCutPlots) {
-                  histos.fill(HIST("tracks/deuteron/dca/after/hDCAxyVsPtDeuteronTruePrim"), DPt, track.dcaXY());
-                  histos.fill(HIST("tracks/deuteron/dca/after/hDCAzVsPtDeuteronTruePrim"), DPt, track.dcaZ());
+                  fillCost.fill(histos, HIST("tracks/deuteron/dca/after/hDCAxyVsPtDeuteronTruePrim"), DPt, track.dcaXY());
+                  fillCost.fill(histos, HIST("tracks/deuteron/dca/after/hDCAzVsPtDeuteronTruePrim"), DPt, track.dcaZ());
                 }
 
                 if (enableTrackingEff) {
                   if (isItsPassed) {
-                    debugHistos.fill(HIST("tracks/deuteron/trackingEff/h1DeuteronSpectra_its"), DPt);
+                    fillCost.fill(debugHistos, HIST("tracks/deuteron/trackingEff/h1DeuteronSpectra_its"), DPt);
                     if (isGoodHit) {
-                      debugHistos.fill(HIST("tracks/deuteron/trackingEff/h1DeuteronSpectraGoodHit_its"), DPt);
+                      fillCost.fill(debugHistos, HIST("tracks/deuteron/trackingEff/h1DeuteronSpectraGoodHit_its"), DPt);
                     }
                   }
 
                   if (isTpcPassed) {
-                    debugHistos.fill(HIST("tracks/deuteron/trackingEff/h1DeuteronSpectra_tpc"), DPt);
+                    fillCost.fill(debugHistos, HIST("tracks/deuteron/trackingEff/h1DeuteronSpectra_tpc"), DPt);
                     if (isGoodHit) {
-                      debugHistos.fill(HIST("tracks/deuteron/trackingEff/h1DeuteronSpectraGoodHit_tpc"), DPt);
+                      fillCost.fill(debugHistos, HIST("tracks/deuteron/trackingEff/h1DeuteronSpectraGoodHit_tpc"), DPt);
                     }
                   }
 
                   if (isItsPassed && isTpcPassed) {
-                    debugHistos.fill(HIST("tracks/deuteron/trackingEff/h1DeuteronSpectra_its_tpc"), DPt);
+                    fillCost.fill(debugHistos, HIST("tracks/deuteron/trackingEff/h1DeuteronSpectra_its_tpc"), DPt);
                     if (isGoodHit) {
-                      debugHistos.fill(HIST("tracks/deuteron/trackingEff/h1DeuteronSpectraGoodHit_its_tpc"), DPt);
+                      fillCost.fill(debugHistos, HIST("tracks/deuteron/trackingEff/h1DeuteronSpectraGoodHit_its_tpc"), DPt);
                     }
                   }
 
                   if (isItsPassed && isTpcPassed && track.hasTOF()) {
-                    debugHistos.fill(HIST("tracks/deuteron/trackingEff/h1DeuteronSpectra_its_tpc_tof"), DPt);
+                    fillCost.fill(debugHistos, HIST("tracks/deuteron/trackingEff/h1DeuteronSpectra_its_tpc_tof"), DPt);
                     if (isGoodHit) {
-                      debugHistos.fill(HIST("tracks/deuteron/trackingEff/h1DeuteronSpectraGoodHit_its_tpc_tof"), DPt);
+                      fillCost.fill(debugHistos, HIST("tracks/deuteron/trackingEff/h1DeuteronSpectraGoodHit_its_tpc_tof"), DPt);
                     }
                   }
 
                   if (isItsPassed && isTpcPassed && track.hasTRD()) {
-                    debugHistos.fill(HIST("tracks/deuteron/trackingEff/h1DeuteronSpectra_its_tpc_trd"), DPt);
+                    fillCost.fill(debugHistos, HIST("tracks/deuteron/trackingEff/h1DeuteronSpectra_its_tpc_trd"), DPt);
                     if (isGoodHit) {
-                      debugHistos.fill(HIST("tracks/deuteron/trackingEff/h1DeuteronSpectraGoodHit_its_tpc_trd"), DPt);
+                      fillCost.fill(debugHistos, HIST("tracks/deuteron/trackingEff/h1DeuteronSpectraGoodHit_its_tpc_trd"), DPt);
                     }
                   }
 
                   if (isItsPassed && isTpcPassed && track.hasTOF() && track.hasTRD()) {
-                    debugHistos.fill(HIST("tracks/deuteron/trackingEff/h1DeuteronSpectra_its_tpc_trd_tof"), DPt);
+                    fillCost.fill(debugHistos, HIST("tracks/deuteron/trackingEff/h1DeuteronSpectra_its_tpc_trd_tof"), DPt);
                     if (isGoodHit) {
-                      debugHistos.fill(HIST("tracks/deuteron/trackingEff/h1DeuteronSpectraGoodHit_its_tpc_trd_tof"), DPt);
+                      fillCost.fill(debugHistos, HIST("tracks/deuteron/trackingEff/h1DeuteronSpectraGoodHit_its_tpc_trd_tof"), DPt);
                     }
                   }
                 }
 
-                if (std::abs(track.tpcNSigmaDe()) < nsigmaTPCvar.nsigmaTPCDe) {
-                  histos.fill(HIST("tracks/deuteron/h1DeuteronSpectraTrueWPIDPrim"), DPt);
+                if (passTPCDe) {
+                  fillCost.fill(histos, HIST("tracks/deuteron/h1DeuteronSpectraTrueWPIDPrim"), DPt);
                   if (outFlagOptions.makeDCAAfterCutPlots) {
-                    histos.fill(HIST("tracks/deuteron/dca/after/hDCAxyVsPtDeuteronTrueWPIDPrim"), DPt, track.dcaXY());
-                    histos.fill(HIST("tracks/deuteron/dca/after/hDCAzVsPtDeuteronTrueWPIDPrim"), DPt, track.dcaZ());
+                    fillCost.fill(histos, HIST("tracks/deuteron/dca/after/hDCAxyVsPtDeuteronTrueWPIDPrim"), DPt, track.dcaXY());
+                    fillCost.fill(histos, HIST("tracks/deuteron/dca/after/hDCAzVsPtDeuteronTrueWPIDPrim"), DPt, track.dcaZ());
                   }
                   if (track.hasTOF() && outFlagOptions.doTOFplots) {
-                    histos.fill(HIST("tracks/deuteron/hPtDeuteronTOFTrueWPIDPrim"), DPt);
+                    fillCost.fill(histos, HIST("tracks/deuteron/hPtDeuteronTOFTrueWPIDPrim"), DPt);
                   }
 
                   if (enableTrackingEff) {
                     if (isItsPassed) {
-                      debugHistos.fill(HIST("tracks/deuteron/trackingEffPID/h1DeuteronSpectraPIDTruePrim_its"), DPt);
+                      fillCost.fill(debugHistos, HIST("tracks/deuteron/trackingEffPID/h1DeuteronSpectraPIDTruePrim_its"), DPt);
                       if (isGoodHit) {
-                        debugHistos.fill(HIST("tracks/deuteron/trackingEffPID/h1DeuteronSpectraPIDTruePrimGoodHit_its"), DPt);
+                        fillCost.fill(debugHistos, HIST("tracks/deuteron/trackingEffPID/h1DeuteronSpectraPIDTruePrimGoodHit_its"), DPt);
                       }
                     }
 
                     if (isTpcPassed) {
-                      debugHistos.fill(HIST("tracks/deuteron/trackingEffPID/h1DeuteronSpectraPIDTruePrim_tpc"), DPt);
+                      fillCost.fill(debugHistos, HIST("tracks/deuteron/trackingEffPID/h1DeuteronSpectraPIDTruePrim_tpc"), DPt);
                       if (isGoodHit) {
-                        debugHistos.fill(HIST("tracks/deuteron/trackingEffPID/h1DeuteronSpectraPIDTruePrimGoodHit_tpc"), DPt);
+                        fillCost.fill(debugHistos, HIST("tracks/deuteron/trackingEffPID/h1DeuteronSpectraPIDTruePrimGoodHit_tpc"), DPt);
                       }
                     }
 
                     if (isItsPassed && isTpcPassed) {
-                      debugHistos.fill(HIST("tracks/deuteron/trackingEffPID/h1DeuteronSpectraPIDTruePrim_its_tpc"), DPt);
+                      fillCost.fill(debugHistos, HIST("tracks/deuteron/trackingEffPID/h1DeuteronSpectraPIDTruePrim_its_tpc"), DPt);
                       if (isGoodHit) {
-                        debugHistos.fill(HIST("tracks/deuteron/trackingEffPID/h1DeuteronSpectraPIDTruePrimGoodHit_its_tpc"), DPt);
+                        fillCost.fill(debugHistos, HIST("tracks/deuteron/trackingEffPID/h1DeuteronSpectraPIDTruePrimGoodHit_its_tpc"), DPt);
                       }
                     }
 
                     if (isItsPassed && isTpcPassed && track.hasTOF()) {
-                      debugHistos.fill(HIST("tracks/deuteron/trackingEffPID/h1DeuteronSpectraPIDTruePrim_its_tpc_tof"), DPt);
+                      fillCost.fill(debugHistos, HIST("tracks/deuteron/trackingEffPID/h1DeuteronSpectraPIDTruePrim_its_tpc_tof"), DPt);
                       if (isGoodHit) {
-                        debugHistos.fill(HIST("tracks/deuteron/trackingEffPID/h1DeuteronSpectraPIDTruePrimGoodHit_its_tpc_tof"), DPt);
+                        fillCost.fill(debugHistos, HIST("tracks/deuteron/trackingEffPID/h1DeuteronSpectraPIDTruePrimGoodHit_its_tpc_tof"), DPt);
                       }
                     }
 
                     if (isItsPassed && isTpcPassed && track.hasTRD()) {
-                      debugHistos.fill(HIST("tracks/deuteron/trackingEffPID/h1DeuteronSpectraPIDTruePrim_its_tpc_trd"), DPt);
+                      fillCost.fill(debugHistos, HIST("tracks/deuteron/trackingEffPID/h1DeuteronSpectraPIDTruePrim_its_tpc_trd"), DPt);
                       if (isGoodHit) {
-                        debugHistos.fill(HIST("tracks/deuteron/trackingEffPID/h1DeuteronSpectraPIDTruePrimGoodHit_its_tpc_trd"), DPt);
+                        fillCost.fill(debugHistos, HIST("tracks/deuteron/trackingEffPID/h1DeuteronSpectraPIDTruePrimGoodHit_its_tpc_trd"), DPt);
                       }
                     }
 
                     if (isItsPassed && isTpcPassed && track.hasTOF() && track.hasTRD()) {
-                      debugHistos.fill(HIST("tracks/deuteron/trackingEffPID/h1DeuteronSpectraPIDTruePrim_its_tpc_trd_tof"), DPt);
+                      fillCost.fill(debugHistos, HIST("tracks/deuteron/trackingEffPID/h1DeuteronSpectraPIDTruePrim_its_tpc_trd_tof"), DPt);
                       if (isGoodHit) {
-                        debugHistos.fill(HIST("tracks/deuteron/trackingEffPID/h1DeuteronSpectraPIDTruePrimGoodHit_its_tpc_trd_tof"), DPt);
+                        fillCost.fill(debugHistos, HIST("tracks/deuteron/trackingEffPID/h1DeuteronSpectraPIDTruePrimGoodHit_its_tpc_trd_tof"), DPt);
                       }
                     }
                   }
                 }
               }
               if (!isPhysPrim && !isProdByGen) {
-                histos.fill(HIST("tracks/deuteron/h1DeuteronSpectraTrueTransport"), DPt);
+                fillCost.fill(histos, HIST("tracks/deuteron/h1DeuteronSpectraTrueTransport"), DPt);
                 if (outFlagOptions.makeDCAAfterCutPlots) {
-                  histos.fill(HIST("tracks/deuteron/dca/after/hDCAxyVsPtDeuteronTrueTransport"), DPt, track.dcaXY());
-                  histos.fill(HIST("tracks/deuteron/dca/after/hDCAzVsPtDeuteronTrueTransport"), DPt, track.dcaZ());
+                  fillCost.fill(histos, HIST("tracks/deuteron/dca/after/hDCAxyVsPtDeuteronTrueTransport"), DPt, track.dcaXY());
+                  fillCost.fill(histos, HIST("tracks/deuteron/dca/after/hDCAzVsPtDeuteronTrueTransport"), DPt, track.dcaZ());
                 }
                 if (isWeakDecay) {
-                  histos.fill(HIST("tracks/deuteron/h1DeuteronSpectraTrueSec"), DPt);
+                  fillCost.fill(histos, HIST("tracks/deuteron/h1DeuteronSpectraTrueSec"), DPt);
                   if (outFlagOptions.makeDCAAfterCutPlots) {
-                    histos.fill(HIST("tracks/deuteron/dca/after/hDCAxyVsPtDeuteronTrueSec"), DPt, track.dcaXY());
-                    histos.fill(HIST("tracks/deuteron/dca/after/hDCAzVsPtDeuteronTrueSec"), DPt, track.dcaZ());
+                    fillCost.fill(histos, HIST("tracks/deuteron/dca/after/hDCAxyVsPtDeuteronTrueSec"), DPt, track.dcaXY());
+                    fillCost.fill(histos, HIST("tracks/deuteron/dca/after/hDCAzVsPtDeuteronTrueSec"), DPt, track.dcaZ());
                   }
                 }
               }
@@ -5710,135 +5718,135 @@ struct lfNucleiBATask {
             break;
           case -PDGDeuteron:
             if (isDeuteron && passDCAzCutAntiDe && passDCAxyCutAntiDe) {
-              histos.fill(HIST("tracks/deuteron/h1antiDeuteronSpectraTrue"), antiDPt);
+              fillCost.fill(histos, HIST("tracks/deuteron/h1antiDeuteronSpectraTrue"), antiDPt);
               if (outFlagOptions.makeDCAAfterCutPlots) {
-                histos.fill(HIST("tracks/deuteron/dca/after/hDCAxyVsPtantiDeuteronTrue"), antiDPt, track.dcaXY());
-                histos.fill(HIST("tracks/deuteron/dca/after/hDCAzVsPtantiDeuteronTrue"), antiDPt, track.dcaZ());
+                fillCost.fill(histos, HIST("tracks/deuteron/dca/after/hDCAxyVsPtantiDeuteronTrue"), antiDPt, track.dcaXY());
+                fillCost.fill(histos, HIST("tracks/deuteron/dca/after/hDCAzVsPtantiDeuteronTrue"), antiDPt, track.dcaZ());
               }
-              if (std::abs(track.tpcNSigmaDe()) < nsigmaTPCvar.nsigmaTPCDe) {
-                histos.fill(HIST("tracks/deuteron/h1antiDeuteronSpectraTrueWPID"), antiDPt);
+              if (passTPCDe) {
+                fillCost.fill(histos, HIST("tracks/deuteron/h1antiDeuteronSpectraTrueWPID"), antiDPt);
                 if (track.hasTOF() && outFlagOptions.doTOFplots) {
-                  histos.fill(HIST("tracks/deuteron/hPtantiDeuteronTOFTrue"), antiDPt);
+                  fillCost.fill(histos, HIST("tracks/deuteron/hPtantiDeuteronTOFTrue"), antiDPt);
                 }
               }
               if (isPhysPrim) {
-                histos.fill(HIST("tracks/deuteron/h2antiDeuteronVspTNSigmaTPCTruePrim"), antiDPt, track.tpcNSigmaDe());
-                histos.fill(HIST("tracks/deuteron/h1antiDeuteronSpectraTruePrim"), antiDPt);
+                fillCost.fill(histos, HIST("tracks/deuteron/h2antiDeuteronVspTNSigmaTPCTruePrim"), antiDPt, track.tpcNSigmaDe());
+                fillCost.fill(histos, HIST("tracks/deuteron/h1antiDeuteronSpectraTruePrim"), antiDPt);
                 if (outFlagOptions.makeDCAAfterCutPlots) {
-                  histos.fill(HIST("tracks/deuteron/dca/after/hDCAxyVsPtantiDeuteronTruePrim"), antiDPt, track.dcaXY());
-                  histos.fill(HIST("tracks/deuteron/dca/after/hDCAzVsPtantiDeuteronTruePrim"), antiDPt, track.dcaZ());
+                  fillCost.fill(histos, HIST("tracks/deuteron/dca/after/hDCAxyVsPtantiDeuteronTruePrim"), antiDPt, track.dcaXY());
+                  fillCost.fill(histos, HIST("tracks/deuteron/dca/after/hDCAzVsPtantiDeuteronTruePrim"), antiDPt, track.dcaZ());
                 }
 
                 if (enableTrackingEff) {
                   if (isItsPassed) {
-                    debugHistos.fill(HIST("tracks/deuteron/trackingEff/h1antiDeuteronSpectra_its"), antiDPt);
+                    fillCost.fill(debugHistos, HIST("tracks/deuteron/trackingEff/h1antiDeuteronSpectra_its"), antiDPt);
                     if (isGoodHit) {
-                      debugHistos.fill(HIST("tracks/deuteron/trackingEff/h1antiDeuteronSpectraGoodHit_its"), antiDPt);
+                      fillCost.fill(debugHistos, HIST("tracks/deuteron/trackingEff/h1antiDeuteronSpectraGoodHit_its"), antiDPt);
                     }
                   }
 
                   if (isTpcPassed) {
-                    debugHistos.fill(HIST("tracks/deuteron/trackingEff/h1antiDeuteronSpectra_tpc"), antiDPt);
+                    fillCost.fill(debugHistos, HIST("tracks/deuteron/trackingEff/h1antiDeuteronSpectra_tpc"), antiDPt);
                     if (isGoodHit) {
-                      debugHistos.fill(HIST("tracks/deuteron/trackingEff/h1antiDeuteronSpectraGoodHit_tpc"), antiDPt);
+                      fillCost.fill(debugHistos, HIST("tracks/deuteron/trackingEff/h1antiDeuteronSpectraGoodHit_tpc"), antiDPt);
                     }
                   }
 
                   if (isItsPassed && isTpcPassed) {
-                    debugHistos.fill(HIST("tracks/deuteron/trackingEff/h1antiDeuteronSpectra_its_tpc"), antiDPt);
+                    fillCost.fill(debugHistos, HIST("tracks/deuteron/trackingEff/h1antiDeuteronSpectra_its_tpc"), antiDPt);
                     if (isGoodHit) {
-                      debugHistos.fill(HIST("tracks/deuteron/trackingEff/h1antiDeuteronSpectraGoodHit_its_tpc"), antiDPt);
+                      fillCost.fill(debugHistos, HIST("tracks/deuteron/trackingEff/h1antiDeuteronSpectraGoodHit_its_tpc"), antiDPt);
                     }
                   }
 
                   if (isItsPassed && isTpcPassed && track.hasTOF()) {
-                    debugHistos.fill(HIST("tracks/deuteron/trackingEff/h1antiDeuteronSpectra_its_tpc_tof"), antiDPt);
+                    fillCost.fill(debugHistos, HIST("tracks/deuteron/trackingEff/h1antiDeuteronSpectra_its_tpc_tof"), antiDPt);
                     if (isGoodHit) {
-                      debugHistos.fill(HIST("tracks/deuteron/trackingEff/h1antiDeuteronSpectraGoodHit_its_tpc_tof"), antiDPt);
+                      fillCost.fill(debugHistos, HIST("tracks/deuteron/trackingEff/h1antiDeuteronSpectraGoodHit_its_tpc_tof"), antiDPt);
                     }
                   }
 
                   if (isItsPassed && isTpcPassed && track.hasTRD()) {
-                    debugHistos.fill(HIST("tracks/deuteron/trackingEff/h1antiDeuteronSpectra_its_tpc_trd"), antiDPt);
+                    fillCost.fill(debugHistos, HIST("tracks/deuteron/trackingEff/h1antiDeuteronSpectra_its_tpc_trd"), antiDPt);
                     if (isGoodHit) {
-                      debugHistos.fill(HIST("tracks/deuteron/trackingEff/h1antiDeuteronSpectraGoodHit_its_tpc_trd"), antiDPt);
+                      fillCost.fill(debugHistos, HIST("tracks/deuteron/trackingEff/h1antiDeuteronSpectraGoodHit_its_tpc_trd"), antiDPt);
                     }
                   }
 
                   if (isItsPassed && isTpcPassed && track.hasTOF() && track.hasTRD()) {
-                    debugHistos.fill(HIST("tracks/deuteron/trackingEff/h1antiDeuteronSpectra_its_tpc_trd_tof"), antiDPt);
+                    fillCost.fill(debugHistos, HIST("tracks/deuteron/trackingEff/h1antiDeuteronSpectra_its_tpc_trd_tof"), antiDPt);
                     if (isGoodHit) {
-                      debugHistos.fill(HIST("tracks/deuteron/trackingEff/h1antiDeuteronSpectraGoodHit_its_tpc_trd_tof"), antiDPt);
+                      fillCost.fill(debugHistos, HIST("tracks/deuteron/trackingEff/h1antiDeuteronSpectraGoodHit_its_tpc_trd_tof"), antiDPt);
                     }
                   }
                 }
 
-                if (std::abs(track.tpcNSigmaDe()) < nsigmaTPCvar.nsigmaTPCDe) {
-                  histos.fill(HIST("tracks/deuteron/h1antiDeuteronSpectraTrueWPIDPrim"), antiDPt);
+                if (passTPCDe) {
+                  fillCost.fill(histos, HIST("tracks/deuteron/h1antiDeuteronSpectraTrueWPIDPrim"), antiDPt);
                   if (outFlagOptions.makeDCAAfterCutPlots) {
-                    histos.fill(HIST("tracks/deuteron/dca/after/hDCAxyVsPtantiDeuteronTrueWPIDPrim"), antiDPt, track.dcaXY());
-                    histos.fill(HIST("tracks/deuteron/dca/after/hDCAzVsPtantiDeuteronTrueWPIDPrim"), antiDPt, track.dcaZ());
+                    fillCost.fill(histos, HIST("tracks/deuteron/dca/after/hDCAxyVsPtantiDeuteronTrueWPIDPrim"), antiDPt, track.dcaXY());
+                    fillCost.fill(histos, HIST("tracks/deuteron/dca/after/hDCAzVsPtantiDeuteronTrueWPIDPrim"), antiDPt, track.dcaZ());
                   }
                   if (track.hasTOF() && outFlagOptions.doTOFplots) {
-                    histos.fill(HIST("tracks/deuteron/hPtantiDeuteronTOFTrueWPIDPrim"), antiDPt);
+                    fillCost.fill(histos, HIST("tracks/deuteron/hPtantiDeuteronTOFTrueWPIDPrim"), antiDPt);
                   }
 
                   if (enableTrackingEff) {
                     if (isItsPassed) {
-                      debugHistos.fill(HIST("tracks/deuteron/trackingEffPID/h1antiDeuteronSpectraPIDTruePrim_its"), antiDPt);
+                      fillCost.fill(debugHistos, HIST("tracks/deuteron/trackingEffPID/h1antiDeuteronSpectraPIDTruePrim_its"), antiDPt);
                       if (isGoodHit) {
-                        debugHistos.fill(HIST("tracks/deuteron/trackingEffPID/h1antiDeuteronSpectraPIDTruePrimGoodHit_its"), antiDPt);
+                        fillCost.fill(debugHistos, HIST("tracks/deuteron/trackingEffPID/h1antiDeuteronSpectraPIDTruePrimGoodHit_its"), antiDPt);
                       }
                     }
 
                     if (isTpcPassed) {
-                      debugHistos.fill(HIST("tracks/deuteron/trackingEffPID/h1antiDeuteronSpectraPIDTruePrim_tpc"), antiDPt);
+                      fillCost.fill(debugHistos, HIST("tracks/deuteron/trackingEffPID/h1antiDeuteronSpectraPIDTruePrim_tpc"), antiDPt);
                       if (isGoodHit) {
-                        debugHistos.fill(HIST("tracks/deuteron/trackingEffPID/h1antiDeuteronSpectraPIDTruePrimGoodHit_tpc"), antiDPt);
+                        fillCost.fill(debugHistos, HIST("tracks/deuteron/trackingEffPID/h1antiDeuteronSpectraPIDTruePrimGoodHit_tpc"), antiDPt);
                       }
                     }
 
                     if (isItsPassed && isTpcPassed) {
-                      debugHistos.fill(HIST("tracks/deuteron/trackingEffPID/h1antiDeuteronSpectraPIDTruePrim_its_tpc"), antiDPt);
+                      fillCost.fill(debugHistos, HIST("tracks/deuteron/trackingEffPID/h1antiDeuteronSpectraPIDTruePrim_its_tpc"), antiDPt);
                       if (isGoodHit) {
-                        debugHistos.fill(HIST("tracks/deuteron/trackingEffPID/h1antiDeuteronSpectraPIDTruePrimGoodHit_its_tpc"), antiDPt);
+                        fillCost.fill(debugHistos, HIST("tracks/deuteron/trackingEffPID/h1antiDeuteronSpectraPIDTruePrimGoodHit_its_tpc"), antiDPt);
                       }
                     }
 
                     if (isItsPassed && isTpcPassed && track.hasTOF()) {
-                      debugHistos.fill(HIST("tracks/deuteron/trackingEffPID/h1antiDeuteronSpectraPIDTruePrim_its_tpc_tof"), antiDPt);
+                      fillCost.fill(debugHistos, HIST("tracks/deuteron/trackingEffPID/h1antiDeuteronSpectraPIDTruePrim_its_tpc_tof"), antiDPt);
                       if (isGoodHit) {
-                        debugHistos.fill(HIST("tracks/deuteron/trackingEffPID/h1antiDeuteronSpectraPIDTruePrimGoodHit_its_tpc_tof"), antiDPt);
+                        fillCost.fill(debugHistos, HIST("tracks/deuteron/trackingEffPID/h1antiDeuteronSpectraPIDTruePrimGoodHit_its_tpc_tof"), antiDPt);
                       }
                     }
 
                     if (isItsPassed && isTpcPassed && track.hasTRD()) {
-                      debugHistos.fill(HIST("tracks/deuteron/trackingEffPID/h1antiDeuteronSpectraPIDTruePrim_its_tpc_trd"), antiDPt);
+                      fillCost.fill(debugHistos, HIST("tracks/deuteron/trackingEffPID/h1antiDeuteronSpectraPIDTruePrim_its_tpc_trd"), antiDPt);
                       if (isGoodHit) {
-                        debugHistos.fill(HIST("tracks/deuteron/trackingEffPID/h1antiDeuteronSpectraPIDTruePrimGoodHit_its_tpc_trd"), antiDPt);
+                        fillCost.fill(debugHistos, HIST("tracks/deuteron/trackingEffPID/h1antiDeuteronSpectraPIDTruePrimGoodHit_its_tpc_trd"), antiDPt);
                       }
                     }
 
                     if (isItsPassed && isTpcPassed && track.hasTOF() && track.hasTRD()) {
-                      debugHistos.fill(HIST("tracks/deuteron/trackingEffPID/h1antiDeuteronSpectraPIDTruePrim_its_tpc_trd_tof"), antiDPt);
+                      fillCost.fill(debugHistos, HIST("tracks/deuteron/trackingEffPID/h1antiDeuteronSpectraPIDTruePrim_its_tpc_trd_tof"), antiDPt);
                       if (isGoodHit) {
-                        debugHistos.fill(HIST("tracks/deuteron/trackingEffPID/h1antiDeuteronSpectraPIDTruePrimGoodHit_its_tpc_trd_tof"), antiDPt);
+                        fillCost.fill(debugHistos, HIST("tracks/deuteron/trackingEffPID/h1antiDeuteronSpectraPIDTruePrimGoodHit_its_tpc_trd_tof"), antiDPt);
                       }
                     }
                   }
                 }
               }
               if (!isPhysPrim && !isProdByGen) {
-                histos.fill(HIST("tracks/deuteron/h1antiDeuteronSpectraTrueTransport"), antiDPt);
+                fillCost.fill(histos, HIST("tracks/deuteron/h1antiDeuteronSpectraTrueTransport"), antiDPt);
                 if (outFlagOptions.makeDCAAfterCutPlots) {
-                  histos.fill(HIST("tracks/deuteron/dca/after/hDCAxyVsPtantiDeuteronTrueTransport"), antiDPt, track.dcaXY());
-                  histos.fill(HIST("tracks/deuteron/dca/after/hDCAzVsPtantiDeuteronTrueTransport"), antiDPt, track.dcaZ());
+                  fillCost.fill(histos, HIST("tracks/deuteron/dca/after/hDCAxyVsPtantiDeuteronTrueTransport"), antiDPt, track.dcaXY());
+                  fillCost.fill(histos, HIST("tracks/deuteron/dca/after/hDCAzVsPtantiDeuteronTrueTransport"), antiDPt, track.dcaZ());
                 }
                 if (isWeakDecay) {
-                  histos.fill(HIST("tracks/deuteron/h1antiDeuteronSpectraTrueSec"), antiDPt);
+                  fillCost.fill(histos, HIST("tracks/deuteron/h1antiDeuteronSpectraTrueSec"), antiDPt);
                   if (outFlagOptions.makeDCAAfterCutPlots) {
-                    histos.fill(HIST("tracks/deuteron/dca/after/hDCAxyVsPtantiDeuteronTrueSec"), antiDPt, track.dcaXY());
-                    histos.fill(HIST("tracks/deuteron/dca/after/hDCAzVsPtantiDeuteronTrueSec"), antiDPt, track.dcaZ());
+                    fillCost.fill(histos, HIST("tracks/deuteron/dca/after/hDCAxyVsPtantiDeuteronTrueSec"), antiDPt, track.dcaXY());
+                    fillCost.fill(histos, HIST("tracks/deuteron/dca/after/hDCAzVsPtantiDeuteronTrueSec"), antiDPt, track.dcaZ());
                   }
                 }
               }
@@ -5846,29 +5854,29 @@ struct lfNucleiBATask {
             break;
           case PDGTriton:
             if (enableTr && trRapCut && passDCAxyzCut) {
-              histos.fill(HIST("tracks/triton/h1TritonSpectraTrue"), track.pt());
+              fillCost.fill(histos, HIST("tracks/triton/h1TritonSpectraTrue"), track.pt());
               if (outFlagOptions.makeDCAAfterCutPlots) {
-                histos.fill(HIST("tracks/triton/dca/after/hDCAxyVsPtTritonTrue"), track.pt(), track.dcaXY());
-                histos.fill(HIST("tracks/triton/dca/after/hDCAzVsPtTritonTrue"), track.pt(), track.dcaZ());
+                fillCost.fill(histos, HIST("tracks/triton/dca/after/hDCAxyVsPtTritonTrue"), track.pt(), track.dcaXY());
+                fillCost.fill(histos, HIST("tracks/triton/dca/after/hDCAzVsPtTritonTrue"), track.pt(), track.dcaZ());
               }
               if (isPhysPrim) {
-                histos.fill(HIST("tracks/triton/h1TritonSpectraTruePrim"), track.pt());
+                fillCost.fill(histos, HIST("tracks/triton/h1TritonSpectraTruePrim"), track.pt());
                 if (outFlagOptions.makeDCAAfterCutPlots) {
-                  histos.fill(HIST("tracks/triton/dca/after/hDCAxyVsPtTritonTruePrim"), track.pt(), track.dcaXY());
-                  histos.fill(HIST("tracks/triton/dca/after/hDCAzVsPtTritonTruePrim"), track.pt(), track.dcaZ());
+                  fillCost.fill(histos, HIST("tracks/triton/dca/after/hDCAxyVsPtTritonTruePrim"), track.pt(), track.dcaXY());
+                  fillCost.fill(histos, HIST("tracks/triton/dca/after/hDCAzVsPtTritonTruePrim"), track.pt(), track.dcaZ());
                 }
               }
               if (!isPhysPrim && !isProdByGen) {
-                histos.fill(HIST("tracks/triton/h1TritonSpectraTrueTransport"), track.pt());
+                fillCost.fill(histos, HIST("tracks/triton/h1TritonSpectraTrueTransport"), track.pt());
                 if (outFlagOptions.makeDCAAfterCutPlots) {
-                  histos.fill(HIST("tracks/triton/dca/after/hDCAxyVsPtTritonTrueTransport"), track.pt(), track.dcaXY());
-                  histos.fill(HIST("tracks/triton/dca/after/hDCAzVsPtTritonTrueTransport"), track.pt(), track.dcaZ());
+                  fillCost.fill(histos, HIST("tracks/triton/dca/after/hDCAxyVsPtTritonTrueTransport"), track.pt(), track.dcaXY());
+                  fillCost.fill(histos, HIST("tracks/triton/dca/after/hDCAzVsPtTritonTrueTransport"), track.pt(), track.dcaZ());
                 }
                 if (isWeakDecay) {
-                  histos.fill(HIST("tracks/triton/h1TritonSpectraTrueSec"), track.pt());
+                  fillCost.fill(histos, HIST("tracks/triton/h1TritonSpectraTrueSec"), track.pt());
                   if (outFlagOptions.makeDCAAfterCutPlots) {
-                    histos.fill(HIST("tracks/triton/dca/after/hDCAxyVsPtTritonTrueSec"), track.pt(), track.dcaXY());
-                    histos.fill(HIST("tracks/triton/dca/after/hDCAzVsPtTritonTrueSec"), track.pt(), track.dcaZ());
+                    fillCost.fill(histos, HIST("tracks/triton/dca/after/hDCAxyVsPtTritonTrueSec"), track.pt(), track.dcaXY());
+                    fillCost.fill(histos, HIST("tracks/triton/dca/after/hDCAzVsPtTritonTrueSec"), track.pt(), track.dcaZ());
                   }
                 }
               }
@@ -5876,29 +5884,29 @@ struct lfNucleiBATask {
             break;
           case -PDGTriton:
             if (enableTr && trRapCut && passDCAxyzCut) {
-              histos.fill(HIST("tracks/triton/h1antiTritonSpectraTrue"), track.pt());
+              fillCost.fill(histos, HIST("tracks/triton/h1antiTritonSpectraTrue"), track.pt());
               if (outFlagOptions.makeDCAAfterCutPlots) {
-                histos.fill(HIST("tracks/triton/dca/after/hDCAxyVsPtantiTritonTrue"), track.pt(), track.dcaXY());
-                histos.fill(HIST("tracks/triton/dca/after/hDCAzVsPtantiTritonTrue"), track.pt(), track.dcaZ());
+                fillCost.fill(histos, HIST("tracks/triton/dca/after/hDCAxyVsPtantiTritonTrue"), track.pt(), track.dcaXY());
+                fillCost.fill(histos, HIST("tracks/triton/dca/after/hDCAzVsPtantiTritonTrue"), track.pt(), track.dcaZ());
               }
               if (isPhysPrim) {
-                histos.fill(HIST("tracks/triton/h1antiTritonSpectraTruePrim"), track.pt());
+                fillCost.fill(histos, HIST("tracks/triton/h1antiTritonSpectraTruePrim"), track.pt());
                 if (outFlagOptions.makeDCAAfterCutPlots) {
-                  histos.fill(HIST("tracks/triton/dca/after/hDCAxyVsPtantiTritonTruePrim"), track.pt(), track.dcaXY());
-                  histos.fill(HIST("tracks/triton/dca/after/hDCAzVsPtantiTritonTruePrim"), track.pt(), track.dcaZ());
+                  fillCost.fill(histos, HIST("tracks/triton/dca/after/hDCAxyVsPtantiTritonTruePrim"), track.pt(), track.dcaXY());
+                  fillCost.fill(histos, HIST("tracks/triton/dca/after/hDCAzVsPtantiTritonTruePrim"), track.pt(), track.dcaZ());
                 }
               }
               if (!isPhysPrim && !isProdByGen) {
-                histos.fill(HIST("tracks/triton/h1antiTritonSpectraTrueTransport"), track.pt());
+                fillCost.fill(histos, HIST("tracks/triton/h1antiTritonSpectraTrueTransport"), track.pt());
                 if (outFlagOptions.makeDCAAfterCutPlots) {
-                  histos.fill(HIST("tracks/triton/dca/after/hDCAxyVsPtantiTritonTrueTransport"), track.pt(), track.dcaXY());
-                  histos.fill(HIST("tracks/triton/dca/after/hDCAzVsPtantiTritonTrueTransport"), track.pt(), track.dcaZ());
+                  fillCost.fill(histos, HIST("tracks/triton/dca/after/hDCAxyVsPtantiTritonTrueTransport"), track.pt(), track.dcaXY());
+                  fillCost.fill(histos, HIST("tracks/triton/dca/after/hDCAzVsPtantiTritonTrueTransport"), track.pt(), track.dcaZ());
                 }
                 if (isWeakDecay) {
-                  histos.fill(HIST("tracks/triton/h1antiTritonSpectraTrueSec"), track.pt());
+                  fillCost.fill(histos, HIST("tracks/triton/h1antiTritonSpectraTrueSec"), track.pt());
                   if (outFlagOptions.makeDCAAfterCutPlots) {
-                    histos.fill(HIST("tracks/triton/dca/after/hDCAxyVsPtantiTritonTrueSec"), track.pt(), track.dcaXY());
-                    histos.fill(HIST("tracks/triton/dca/after/hDCAzVsPtantiTritonTrueSec"), track.pt(), track.dcaZ());
+                    fillCost.fill(histos, HIST("tracks/triton/dca/after/hDCAxyVsPtantiTritonTrueSec"), track.pt(), track.dcaXY());
+                    fillCost.fill(histos, HIST("tracks/triton/dca/after/hDCAzVsPtantiTritonTrueSec"), track.pt(), track.dcaZ());
                   }
                 }
               }
@@ -5906,81 +5914,81 @@ struct lfNucleiBATask {
             break;
           case PDGHelium:
             if (isHelium && passDCAzCutHe && passDCAxyCutHe) {
-              histos.fill(HIST("tracks/helium/h1HeliumSpectraTrue_Z2"), 2 * hePt);
+              fillCost.fill(histos, HIST("tracks/helium/h1HeliumSpectraTrue_Z2"), 2 * hePt);
               if (enableCentrality)
-                histos.fill(HIST("tracks/helium/h2HeliumSpectraTrueVsMult_Z2"), 2 * hePt, centFT0M);
+                fillCost.fill(histos, HIST("tracks/helium/h2HeliumSpectraTrueVsMult_Z2"), 2 * hePt, centFT0M);
 
               if (outFlagOptions.makeDCAAfterCutPlots) {
-                histos.fill(HIST("tracks/helium/dca/after/hDCAxyVsPtHeliumTrue"), hePt, track.dcaXY());
-                histos.fill(HIST("tracks/helium/dca/after/hDCAzVsPtHeliumTrue"), hePt, track.dcaZ());
+                fillCost.fill(histos, HIST("tracks/helium/dca/after/hDCAxyVsPtHeliumTrue"), hePt, track.dcaXY());
+                fillCost.fill(histos, HIST("tracks/helium/dca/after/hDCAzVsPtHeliumTrue"), hePt, track.dcaZ());
 
                 if (track.hasTOF() && outFlagOptions.doTOFplots) {
-                  histos.fill(HIST("tracks/helium/dca/after/TOF/hDCAxyVsPtHeliumTrue"), hePt, track.dcaXY());
-                  histos.fill(HIST("tracks/helium/dca/after/TOF/hDCAzVsPtHeliumTrue"), hePt, track.dcaZ());
+                  fillCost.fill(histos, HIST("tracks/helium/dca/after/TOF/hDCAxyVsPtHeliumTrue"), hePt, track.dcaXY());
+                  fillCost.fill(histos, HIST("tracks/helium/dca/after/TOF/hDCAzVsPtHeliumTrue"), hePt, track.dcaZ());
                 }
               }
-              if (std::abs(track.tpcNSigmaHe()) < nsigmaTPCvar.nsigmaTPCHe) {
-                histos.fill(HIST("tracks/helium/h1HeliumSpectraTrueWPID_Z2"), 2 * hePt);
+              if (passTPCHe) {
+                fillCost.fill(histos, HIST("tracks/helium/h1HeliumSpectraTrueWPID_Z2"), 2 * hePt);
                 if (enableCentrality) {
-                  histos.fill(HIST("tracks/helium/h2HeliumSpectraTrueWPIDVsMult_Z2"), 2 * hePt, centFT0M);
+                  fillCost.fill(histos, HIST("tracks/helium/h2HeliumSpectraTrueWPIDVsMult_Z2"), 2 * hePt, centFT0M);
                   if (track.hasTOF() && outFlagOptions.doTOFplots) {
-                    histos.fill(HIST("tracks/helium/TOF/h2HeliumSpectraTrueWPIDVsMult_Z2"), 2 * hePt, centFT0M);
+                    fillCost.fill(histos, HIST("tracks/helium/TOF/h2HeliumSpectraTrueWPIDVsMult_Z2"), 2 * hePt, centFT0M);
                   }
                 }
                 if (outFlagOptions.enableEffPlots) {
-                  histos.fill(HIST("tracks/eff/helium/hPtHeTrue_Z2"), 2 * hePt);
+                  fillCost.fill(histos, HIST("tracks/eff/helium/hPtHeTrue_Z2"), 2 * hePt);
                   if (track.hasTOF() && outFlagOptions.doTOFplots) {
-                    histos.fill(HIST("tracks/eff/helium/hPtHeTOFTrue_Z2"), 2 * hePt);
+                    fillCost.fill(histos, HIST("tracks/eff/helium/hPtHeTOFTrue_Z2"), 2 * hePt);
                   }
                 }
               }
               if (isPhysPrim) {
-                histos.fill(HIST("tracks/helium/h1HeliumSpectraTruePrim_Z2"), 2 * hePt);
+                fillCost.fill(histos, HIST("tracks/helium/h1HeliumSpectraTruePrim_Z2"), 2 * hePt);
                 if (enableCentrality) {
-                  histos.fill(HIST("tracks/helium/h2HeliumSpectraTruePrimVsMult_Z2"), 2 * hePt, centFT0M);
+                  fillCost.fill(histos, HIST("tracks/helium/h2HeliumSpectraTruePrimVsMult_Z2"), 2 * hePt, centFT0M);
                   if constexpr (!IsFilteredData)
-                    histos.fill(HIST("tracks/helium/h2HeliumSpectraTruePrimGenVsMult_Z2"), track.mcParticle().pt(), centFT0M);
+                    fillCost.fill(histos, HIST("tracks/helium/h2HeliumSpectraTruePrimGenVsMult_Z2"), track.mcParticle().pt(), centFT0M);
                 }
-                if (std::abs(track.tpcNSigmaHe()) < nsigmaTPCvar.nsigmaTPCHe) {
+                if (passTPCHe) {
                   if (track.hasTOF() && outFlagOptions.doTOFplots) {
-                    histos.fill(HIST("tracks/helium/TOF/h1HeliumSpectraTruePrim_Z2"), 2 * hePt);
+                    fillCost.fill(histos, HIST("tracks/helium/TOF/h1HeliumSpectraTruePrim_Z2"), 2 * hePt);
                     if (enableCentrality) {
-                      histos.fill(HIST("tracks/helium/TOF/h2HeliumSpectraTruePrimVsMult_Z2"), 2 * hePt, centFT0M);
+                      fillCost.fill(histos, HIST("tracks/helium/TOF/h2HeliumSpectraTruePrimVsMult_Z2"), 2 * hePt, centFT0M);
                       if constexpr (!IsFilteredData)
-                        histos.fill(HIST("tracks/helium/TOF/h2HeliumSpectraTruePrimGenVsMult_Z2"), track.mcParticle().pt(), centFT0M);
+                        fillCost.fill(histos, HIST("tracks/helium/TOF/h2HeliumSpectraTruePrimGenVsMult_Z2"), track.mcParticle().pt(), centFT0M);
                     }
                   }
                 }
 
                 if (outFlagOptions.makeDCAAfterCutPlots) {
-                  histos.fill(HIST("tracks/helium/dca/after/hDCAxyVsPtHeliumTruePrim"), hePt, track.dcaXY());
-                  histos.fill(HIST("tracks/helium/dca/after/hDCAzVsPtHeliumTruePrim"), hePt, track.dcaZ());
+                  fillCost.fill(histos, HIST("tracks/helium/dca/after/hDCAxyVsPtHeliumTruePrim"), hePt, track.dcaXY());
+                  fillCost.fill(histos, HIST("tracks/helium/dca/after/hDCAzVsPtHeliumTruePrim"), hePt, track.dcaZ());
                   if (track.hasTOF() && outFlagOptions.doTOFplots) {
-                    histos.fill(HIST("tracks/helium/dca/after/TOF/hDCAxyVsPtHeliumTruePrim"), hePt, track.dcaXY());
-                    histos.fill(HIST("tracks/helium/dca/after/TOF/hDCAzVsPtHeliumTruePrim"), hePt, track.dcaZ());
+                    fillCost.fill(histos, HIST("tracks/helium/dca/after/TOF/hDCAxyVsPtHeliumTruePrim"), hePt, track.dcaXY());
+                    fillCost.fill(histos, HIST("tracks/helium/dca/after/TOF/hDCAzVsPtHeliumTruePrim"), hePt, track.dcaZ());
                   }
                 }
               }
               if (!isPhysPrim && !isProdByGen) {
-                histos.fill(HIST("tracks/helium/h1HeliumSpectraTrueTransport_Z2"), 2 * hePt);
+                fillCost.fill(histos, HIST("tracks/helium/h1HeliumSpectraTrueTransport_Z2"), 2 * hePt);
                 if (outFlagOptions.makeDCAAfterCutPlots) {
-                  histos.fill(HIST("tracks/helium/dca/after/hDCAxyVsPtHeliumTrueTransport"), hePt, track.dcaXY());
-                  histos.fill(HIST("tracks/helium/dca/after/hDCAzVsPtHeliumTrueTransport"), hePt, track.dcaZ());
+                  fillCost.fill(histos, HIST("tracks/helium/dca/after/hDCAxyVsPtHeliumTrueTransport"), hePt, track.dcaXY());
+                  fillCost.fill(histos, HIST("tracks/helium/dca/after/hDCAzVsPtHeliumTrueTransport"), hePt, track.dcaZ());
                   if (track.hasTOF() && outFlagOptions.doTOFplots) {
-                    histos.fill(HIST("tracks/helium/dca/after/TOF/hDCAxyVsPtHeliumTrueTransport"), hePt, track.dcaXY());
-                    histos.fill(HIST("tracks/helium/dca/after/TOF/hDCAzVsPtHeliumTrueTransport"), hePt, track.dcaZ());
+                    fillCost.fill(histos, HIST("tracks/helium/dca/after/TOF/hDCAxyVsPtHeliumTrueTransport"), hePt, track.dcaXY());
+                    fillCost.fill(histos, HIST("tracks/helium/dca/after/TOF/hDCAzVsPtHeliumTrueTransport"), hePt, track.dcaZ());
                   }
                 }
                 if (isWeakDecay) {
-                  histos.fill(HIST("tracks/helium/h1HeliumSpectraTrueSec_Z2"), 2 * hePt);
+                  fillCost.fill(histos, HIST("tracks/helium/h1HeliumSpectraTrueSec_Z2"), 2 * hePt);
                   if (enableCentrality)
-                    histos.fill(HIST("tracks/helium/h2HeliumSpectraTrueSecVsMult_Z2"), 2 * hePt, centFT0M);
+                    fillCost.fill(histos, HIST("tracks/helium/h2HeliumSpectraTrueSecVsMult_Z2"), 2 * hePt, centFT0M);
                   if (outFlagOptions.makeDCAAfterCutPlots) {
-                    histos.fill(HIST("tracks/helium/dca/after/hDCAxyVsPtHeliumTrueSec"), hePt, track.dcaXY());
-                    histos.fill(HIST("tracks/helium/dca/after/hDCAzVsPtHeliumTrueSec"), hePt, track.dcaZ());
+                    fillCost.fill(histos, HIST("tracks/helium/dca/after/hDCAxyVsPtHeliumTrueSec"), hePt, track.dcaXY());
+                    fillCost.fill(histos, HIST("tracks/helium/dca/after/hDCAzVsPtHeliumTrueSec"), hePt, track.dcaZ());
                     if (track.hasTOF() && outFlagOptions.doTOFplots) {
-                      histos.fill(HIST("tracks/helium/dca/after/TOF/hDCAxyVsPtHeliumTrueSec"), hePt, track.dcaXY());
-                      histos.fill(HIST("tracks/helium/dca/after/TOF/hDCAzVsPtHeliumTrueSec"), hePt, track.dcaZ());
+                      fillCost.fill(histos, HIST("tracks/helium/dca/after/TOF/hDCAxyVsPtHeliumTrueSec"), hePt, track.dcaXY());
+                      fillCost.fill(histos, HIST("tracks/helium/dca/after/TOF/hDCAzVsPtHeliumTrueSec"), hePt, track.dcaZ());
                     }
                   }
                 }
@@ -5989,81 +5997,81 @@ struct lfNucleiBATask {
             break;
           case -PDGHelium:
             if (isHelium && passDCAzCutAntiHe && passDCAxyCutAntiHe) {
-              histos.fill(HIST("tracks/helium/h1antiHeliumSpectraTrue_Z2"), 2 * antihePt);
+              fillCost.fill(histos, HIST("tracks/helium/h1antiHeliumSpectraTrue_Z2"), 2 * antihePt);
               if (enableCentrality) {
-                histos.fill(HIST("tracks/helium/h2antiHeliumSpectraTrueVsMult_Z2"), 2 * antihePt, centFT0M);
+                fillCost.fill(histos, HIST("tracks/helium/h2antiHeliumSpectraTrueVsMult_Z2"), 2 * antihePt, centFT0M);
                 if (track.hasTOF() && outFlagOptions.doTOFplots) {
-                  histos.fill(HIST("tracks/helium/TOF/h2antiHeliumSpectraTrueWPIDVsMult_Z2"), 2 * antihePt, centFT0M);
+                  fillCost.fill(histos, HIST("tracks/helium/TOF/h2antiHeliumSpectraTrueWPIDVsMult_Z2"), 2 * antihePt, centFT0M);
                 }
               }
               if (outFlagOptions.makeDCAAfterCutPlots) {
-                histos.fill(HIST("tracks/helium/dca/after/hDCAxyVsPtantiHeliumTrue"), antihePt, track.dcaXY());
-                histos.fill(HIST("tracks/helium/dca/after/hDCAzVsPtantiHeliumTrue"), antihePt, track.dcaZ());
+                fillCost.fill(histos, HIST("tracks/helium/dca/after/hDCAxyVsPtantiHeliumTrue"), antihePt, track.dcaXY());
+                fillCost.fill(histos, HIST("tracks/helium/dca/after/hDCAzVsPtantiHeliumTrue"), antihePt, track.dcaZ());
                 if (track.hasTOF() && outFlagOptions.doTOFplots) {
-                  histos.fill(HIST("tracks/helium/dca/after/TOF/hDCAxyVsPtantiHeliumTrue"), antihePt, track.dcaXY());
-                  histos.fill(HIST("tracks/helium/dca/after/TOF/hDCAzVsPtantiHeliumTrue"), antihePt, track.dcaZ());
+                  fillCost.fill(histos, HIST("tracks/helium/dca/after/TOF/hDCAxyVsPtantiHeliumTrue"), antihePt, track.dcaXY());
+                  fillCost.fill(histos, HIST("tracks/helium/dca/after/TOF/hDCAzVsPtantiHeliumTrue"), antihePt, track.dcaZ());
                 }
               }
-              if (std::abs(track.tpcNSigmaHe()) < nsigmaTPCvar.nsigmaTPCHe) {
-                histos.fill(HIST("tracks/helium/h1antiHeliumSpectraTrueWPID_Z2"), 2 * antihePt);
+              if (passTPCHe) {
+                fillCost.fill(histos, HIST("tracks/helium/h1antiHeliumSpectraTrueWPID_Z2"), 2 * antihePt);
                 if (enableCentrality)
-                  histos.fill(HIST("tracks/helium/h2antiHeliumSpectraTrueWPIDVsMult_Z2"), 2 * antihePt, centFT0M);
+                  fillCost.fill(histos, HIST("tracks/helium/h2antiHeliumSpectraTrueWPIDVsMult_Z2"), 2 * antihePt, centFT0M);
                 if (outFlagOptions.enableEffPlots) {
-                  histos.fill(HIST("tracks/eff/helium/hPtantiHeTrue_Z2"), 2 * antihePt);
+                  fillCost.fill(histos, HIST("tracks/eff/helium/hPtantiHeTrue_Z2"), 2 * antihePt);
                   if (track.hasTOF() && outFlagOptions.doTOFplots) {
-                    histos.fill(HIST("tracks/eff/helium/hPtantiHeTOFTrue_Z2"), 2 * antihePt);
+                    fillCost.fill(histos, HIST("tracks/eff/helium/hPtantiHeTOFTrue_Z2"), 2 * antihePt);
                   }
                 }
               }
               if (isPhysPrim) {
-                histos.fill(HIST("tracks/helium/h1antiHeliumSpectraTruePrim_Z2"), 2 * antihePt);
+                fillCost.fill(histos, HIST("tracks/helium/h1antiHeliumSpectraTruePrim_Z2"), 2 * antihePt);
                 if (enableCentrality) {
-                  histos.fill(HIST("tracks/helium/h2antiHeliumSpectraTruePrimVsMult_Z2"), 2 * antihePt, centFT0M);
+                  fillCost.fill(histos, HIST("tracks/helium/h2antiHeliumSpectraTruePrimVsMult_Z2"), 2 * antihePt, centFT0M);
                   if constexpr (!IsFilteredData)
-                    histos.fill(HIST("tracks/helium/h2antiHeliumSpectraTruePrimGenVsMult_Z2"), track.mcParticle().pt(), centFT0M);
+                    fillCost.fill(histos, HIST("tracks/helium/h2antiHeliumSpectraTruePrimGenVsMult_Z2"), track.mcParticle().pt(), centFT0M);
                 }
 
-                if (std::abs(track.tpcNSigmaHe()) < nsigmaTPCvar.nsigmaTPCHe) {
+                if (passTPCHe) {
                   if (track.hasTOF() && outFlagOptions.doTOFplots) {
-                    histos.fill(HIST("tracks/helium/TOF/h1antiHeliumSpectraTruePrim_Z2"), 2 * antihePt);
+                    fillCost.fill(histos, HIST("tracks/helium/TOF/h1antiHeliumSpectraTruePrim_Z2"), 2 * antihePt);
                     if (enableCentrality) {
-                      histos.fill(HIST("tracks/helium/TOF/h2antiHeliumSpectraTruePrimVsMult_Z2"), 2 * antihePt, centFT0M);
+                      fillCost.fill(histos, HIST("tracks/helium/TOF/h2antiHeliumSpectraTruePrimVsMult_Z2"), 2 * antihePt, centFT0M);
                       if constexpr (!IsFilteredData)
-                        histos.fill(HIST("tracks/helium/TOF/h2antiHeliumSpectraTruePrimGenVsMult_Z2"), track.mcParticle().pt(), centFT0M);
+                        fillCost.fill(histos, HIST("tracks/helium/TOF/h2antiHeliumSpectraTruePrimGenVsMult_Z2"), track.mcParticle().pt(), centFT0M);
                     }
                   }
                 }
 
                 if (outFlagOptions.makeDCAAfterCutPlots) {
-                  histos.fill(HIST("tracks/helium/dca/after/hDCAxyVsPtantiHeliumTruePrim"), antihePt, track.dcaXY());
-                  histos.fill(HIST("tracks/helium/dca/after/hDCAzVsPtantiHeliumTruePrim"), antihePt, track.dcaZ());
+                  fillCost.fill(histos, HIST("tracks/helium/dca/after/hDCAxyVsPtantiHeliumTruePrim"), antihePt, track.dcaXY());
+                  fillCost.fill(histos, HIST("tracks/helium/dca/after/hDCAzVsPtantiHeliumTruePrim"), antihePt, track.dcaZ());
                   if (track.hasTOF() && outFlagOptions.doTOFplots) {
-                    histos.fill(HIST("tracks/helium/dca/after/TOF/hDCAxyVsPtantiHeliumTruePrim"), antihePt, track.dcaXY());
-                    histos.fill(HIST("tracks/helium/dca/after/TOF/hDCAzVsPtantiHeliumTruePrim"), antihePt, track.dcaZ());
+                    fillCost.fill(histos, HIST("tracks/helium/dca/after/TOF/hDCAxyVsPtantiHeliumTruePrim"), antihePt, track.dcaXY());
+                    fillCost.fill(histos, HIST("tracks/helium/dca/after/TOF/hDCAzVsPtantiHeliumTruePrim"), antihePt, track.dcaZ());
                   }
                 }
               }
               if (!isPhysPrim && !isProdByGen) {
-                histos.fill(HIST("tracks/helium/h1antiHeliumSpectraTrueTransport_Z2"), 2 * antihePt);
+                fillCost.fill(histos, HIST("tracks/helium/h1antiHeliumSpectraTrueTransport_Z2"), 2 * antihePt);
                 if (outFlagOptions.makeDCAAfterCutPlots) {
-                  histos.fill(HIST("tracks/helium/dca/after/hDCAxyVsPtantiHeliumTrueTransport"), antihePt, track.dcaXY());
-                  histos.fill(HIST("tracks/helium/dca/after/hDCAzVsPtantiHeliumTrueTransport"), antihePt, track.dcaZ());
+                  fillCost.fill(histos, HIST("tracks/helium/dca/after/hDCAxyVsPtantiHeliumTrueTransport"), antihePt, track.dcaXY());
+                  fillCost.fill(histos, HIST("tracks/helium/dca/after/hDCAzVsPtantiHeliumTrueTransport"), antihePt, track.dcaZ());
                   if (track.hasTOF() && outFlagOptions.doTOFplots) {
-                    histos.fill(HIST("tracks/helium/dca/after/TOF/hDCAxyVsPtantiHeliumTrueTransport"), antihePt, track.dcaXY());
-                    histos.fill(HIST("tracks/helium/dca/after/TOF/hDCAzVsPtantiHeliumTrueTransport"), antihePt, track.dcaZ());
+                    fillCost.fill(histos, HIST("tracks/helium/dca/after/TOF/hDCAxyVsPtantiHeliumTrueTransport"), antihePt, track.dcaXY());
+                    fillCost.fill(histos, HIST("tracks/helium/dca/after/TOF/hDCAzVsPtantiHeliumTrueTransport"), antihePt, track.dcaZ());
                   }
                 }
 
                 if (isWeakDecay) {
-                  histos.fill(HIST("tracks/helium/h1antiHeliumSpectraTrueSec_Z2"), 2 * antihePt);
+                  fillCost.fill(histos, HIST("tracks/helium/h1antiHeliumSpectraTrueSec_Z2"), 2 * antihePt);
                   if (enableCentrality)
-                    histos.fill(HIST("tracks/helium/h2antiHeliumSpectraTrueSecVsMult_Z2"), 2 * antihePt, centFT0M);
+                    fillCost.fill(histos, HIST("tracks/helium/h2antiHeliumSpectraTrueSecVsMult_Z2"), 2 * antihePt, centFT0M);
                   if (outFlagOptions.makeDCAAfterCutPlots) {
-                    histos.fill(HIST("tracks/helium/dca/after/hDCAxyVsPtantiHeliumTrueSec"), antihePt, track.dcaXY());
-                    histos.fill(HIST("tracks/helium/dca/after/hDCAzVsPtantiHeliumTrueSec"), antihePt, track.dcaZ());
+                    fillCost.fill(histos, HIST("tracks/helium/dca/after/hDCAxyVsPtantiHeliumTrueSec"), antihePt, track.dcaXY());
+                    fillCost.fill(histos, HIST("tracks/helium/dca/after/hDCAzVsPtantiHeliumTrueSec"), antihePt, track.dcaZ());
                     if (track.hasTOF() && outFlagOptions.doTOFplots) {
-                      histos.fill(HIST("tracks/helium/dca/after/TOF/hDCAxyVsPtantiHeliumTrueSec"), antihePt, track.dcaXY());
-                      histos.fill(HIST("tracks/helium/dca/after/TOF/hDCAzVsPtantiHeliumTrueSec"), antihePt, track.dcaZ());
+                      fillCost.fill(histos, HIST("tracks/helium/dca/after/TOF/hDCAxyVsPtantiHeliumTrueSec"), antihePt, track.dcaXY());
+                      fillCost.fill(histos, HIST("tracks/helium/dca/after/TOF/hDCAzVsPtantiHeliumTrueSec"), antihePt, track.dcaZ());
                     }
                   }
                 }
@@ -6072,30 +6080,30 @@ struct lfNucleiBATask {
             break;
           case PDGAlpha:
             if (enableAl && alRapCut && passDCAxyzCut) {
-              histos.fill(HIST("tracks/alpha/h1AlphaSpectraTrue"), track.pt());
+              fillCost.fill(histos, HIST("tracks/alpha/h1AlphaSpectraTrue"), track.pt());
               if (outFlagOptions.makeDCAAfterCutPlots) {
-                histos.fill(HIST("tracks/alpha/dca/after/hDCAxyVsPtAlphaTrue"), track.pt(), track.dcaXY());
-                histos.fill(HIST("tracks/alpha/dca/after/hDCAzVsPtAlphaTrue"), track.pt(), track.dcaZ());
+                fillCost.fill(histos, HIST("tracks/alpha/dca/after/hDCAxyVsPtAlphaTrue"), track.pt(), track.dcaXY());
+                fillCost.fill(histos, HIST("tracks/alpha/dca/after/hDCAzVsPtAlphaTrue"), track.pt(), track.dcaZ());
               }
               if (isPhysPrim) {
-                histos.fill(HIST("tracks/alpha/h1AlphaSpectraTruePrim"), track.pt());
+                fillCost.fill(histos, HIST("tracks/alpha/h1AlphaSpectraTruePrim"), track.pt());
                 if (outFlagOptions.makeDCAAfterCutPlots) {
-                  histos.fill(HIST("tracks/alpha/dca/after/hDCAxyVsPtAlphaTruePrim"), track.pt(), track.dcaXY());
-                  histos.fill(HIST("tracks/alpha/dca/after/hDCAzVsPtAlphaTruePrim"), track.pt(), track.dcaZ());
+                  fillCost.fill(histos, HIST("tracks/alpha/dca/after/hDCAxyVsPtAlphaTruePrim"), track.pt(), track.dcaXY());
+                  fillCost.fill(histos, HIST("tracks/alpha/dca/after/hDCAzVsPtAlphaTruePrim"), track.pt(), track.dcaZ());
                 }
               }
               if (!isPhysPrim && !isProdByGen) {
-                histos.fill(HIST("tracks/alpha/h1AlphaSpectraTrueTransport"), track.pt());
+                fillCost.fill(histos, HIST("tracks/alpha/h1AlphaSpectraTrueTransport"), track.pt());
                 if (outFlagOptions.makeDCAAfterCutPlots) {
-                  histos.fill(HIST("tracks/alpha/dca/after/hDCAxyVsPtAlphaTrueTransport"), track.pt(), track.dcaXY());
-                  histos.fill(HIST("tracks/alpha/dca/after/hDCAzVsPtAlphaTrueTransport"), track.pt(), track.dcaZ());
+                  fillCost.fill(histos, HIST("tracks/alpha/dca/after/hDCAxyVsPtAlphaTrueTransport"), track.pt(), track.dcaXY());
+                  fillCost.fill(histos, HIST("tracks/alpha/dca/after/hDCAzVsPtAlphaTrueTransport"), track.pt(), track.dcaZ());
                 }
 
                 if (isWeakDecay) {
-                  histos.fill(HIST("tracks/alpha/h1AlphaSpectraTrueSec"), track.pt());
+                  fillCost.fill(histos, HIST("tracks/alpha/h1AlphaSpectraTrueSec"), track.pt());
                   if (outFlagOptions.makeDCAAfterCutPlots) {
-                    histos.fill(HIST("tracks/alpha/dca/after/hDCAxyVsPtAlphaTrueSec"), track.pt(), track.dcaXY());
-                    histos.fill(HIST("tracks/alpha/dca/after/hDCAzVsPtAlphaTrueSec"), track.pt(), track.dcaZ());
+                    fillCost.fill(histos, HIST("tracks/alpha/dca/after/hDCAxyVsPtAlphaTrueSec"), track.pt(), track.dcaXY());
+                    fillCost.fill(histos, HIST("tracks/alpha/dca/after/hDCAzVsPtAlphaTrueSec"), track.pt(), track.dcaZ());
                   }
                 }
               }
@@ -6103,29 +6111,29 @@ struct lfNucleiBATask {
             break;
           case -PDGAlpha:
             if (enableAl && alRapCut && passDCAxyzCut) {
-              histos.fill(HIST("tracks/alpha/h1antiAlphaSpectraTrue"), track.pt());
+              fillCost.fill(histos, HIST("tracks/alpha/h1antiAlphaSpectraTrue"), track.pt());
               if (outFlagOptions.makeDCAAfterCutPlots) {
-                histos.fill(HIST("tracks/alpha/dca/after/hDCAxyVsPtantiAlphaTrue"), track.pt(), track.dcaXY());
-                histos.fill(HIST("tracks/alpha/dca/after/hDCAzVsPtantiAlphaTrue"), track.pt(), track.dcaZ());
+                fillCost.fill(histos, HIST("tracks/alpha/dca/after/hDCAxyVsPtantiAlphaTrue"), track.pt(), track.dcaXY());
+                fillCost.fill(histos, HIST("tracks/alpha/dca/after/hDCAzVsPtantiAlphaTrue"), track.pt(), track.dcaZ());
               }
               if (isPhysPrim) {
-                histos.fill(HIST("tracks/alpha/h1antiAlphaSpectraTruePrim"), track.pt());
+                fillCost.fill(histos, HIST("tracks/alpha/h1antiAlphaSpectraTruePrim"), track.pt());
                 if (outFlagOptions.makeDCAAfterCutPlots) {
-                  histos.fill(HIST("tracks/alpha/dca/after/hDCAxyVsPtantiAlphaTruePrim"), track.pt(), track.dcaXY());
-                  histos.fill(HIST("tracks/alpha/dca/after/hDCAzVsPtantiAlphaTruePrim"), track.pt(), track.dcaZ());
+                  fillCost.fill(histos, HIST("tracks/alpha/dca/after/hDCAxyVsPtantiAlphaTruePrim"), track.pt(), track.dcaXY());
+                  fillCost.fill(histos, HIST("tracks/alpha/dca/after/hDCAzVsPtantiAlphaTruePrim"), track.pt(), track.dcaZ());
                 }
               }
               if (!isPhysPrim && !isProdByGen) {
-                histos.fill(HIST("tracks/alpha/h1antiAlphaSpectraTrueTransport"), track.pt());
+                fillCost.fill(histos, HIST("tracks/alpha/h1antiAlphaSpectraTrueTransport"), track.pt());
                 if (outFlagOptions.makeDCAAfterCutPlots) {
-                  histos.fill(HIST("tracks/alpha/dca/after/hDCAxyVsPtantiAlphaTrueTransport"), track.pt(), track.dcaXY());
-                  histos.fill(HIST("tracks/alpha/dca/after/hDCAzVsPtantiAlphaTrueTransport"), track.pt(), track.dcaZ());
+                  fillCost.fill(histos, HIST("tracks/alpha/dca/after/hDCAxyVsPtantiAlphaTrueTransport"), track.pt(), track.dcaXY());
+                  fillCost.fill(histos, HIST("tracks/alpha/dca/after/hDCAzVsPtantiAlphaTrueTransport"), track.pt(), track.dcaZ());
                 }
                 if (isWeakDecay) {
-                  histos.fill(HIST("tracks/alpha/h1antiAlphaSpectraTrueSec"), track.pt());
+                  fillCost.fill(histos, HIST("tracks/alpha/h1antiAlphaSpectraTrueSec"), track.pt());
                   if (outFlagOptions.makeDCAAfterCutPlots) {
-                    histos.fill(HIST("tracks/alpha/dca/after/hDCAxyVsPtantiAlphaTrueSec"), track.pt(), track.dcaXY());
-                    histos.fill(HIST("tracks/alpha/dca/after/hDCAzVsPtantiAlphaTrueSec"), track.pt(), track.dcaZ());
+                    fillCost.fill(histos, HIST("tracks/alpha/dca/after/hDCAxyVsPtantiAlphaTrueSec"), track.pt(), track.dcaXY());
+                    fillCost.fill(histos, HIST("tracks/alpha/dca/after/hDCAzVsPtantiAlphaTrueSec"), track.pt(), track.dcaZ());
                   }
                 }
               }
@@ -6175,6 +6183,7 @@ struct lfNucleiBATask {
                    TrackCandidates const& tracks,
                    o2::aod::BCsWithTimestamps const&)
   {
+    auto processCost = fillCost.measure("processData");
     fillHistograms<false /*MC*/, false /*Filtered*/>(event, tracks, true /*dummy*/, event.centFT0M());
   }
   PROCESS_SWITCH(lfNucleiBATask, processData, "process data", true);
@@ -6184,6 +6193,7 @@ struct lfNucleiBATask {
                         TrackCandidatesLfPid const& tracks,
                         o2::aod::BCsWithTimestamps const&)
   {
+    auto processCost = fillCost.measure("processDataLfPid");
     fillHistograms<false /*MC*/, false /*Filtered*/>(event, tracks, true /*dummy*/, event.centFT0M());
   }
   PROCESS_SWITCH(lfNucleiBATask, processDataLfPid, "process data with LF PID", false);
@@ -6193,6 +6203,7 @@ struct lfNucleiBATask {
                            o2::aod::LfCandNucleusFull const& tracks,
                            o2::aod::BCsWithTimestamps const&)
   {
+    auto processCost = fillCost.measure("processDataFiltered");
     // Runs on data filtered on the fly with LF Tree creator nuclei task
     // Takes as input full AO2Ds
     fillHistograms<false /*MC*/, true /*Filtered*/>(event, tracks, true /*dummy*/, event.centFT0M());
@@ -6203,6 +6214,7 @@ struct lfNucleiBATask {
                         o2::aod::LfCandNucleusDummy const& tracks,
                         o2::aod::BCsWithTimestamps const&)
   {
+    auto processCost = fillCost.measure("processDataLight");
     // Runs on derived tables produced with LF Tree creator nuclei task
     // Takes as input derived trees
     fillHistograms<false /*MC*/, true /*Filtered*/>(event, tracks, true /*dummy*/, event.centFT0M());
@@ -6223,6 +6235,7 @@ struct lfNucleiBATask {
                      aod::McParticles const& mcParticles,
                      o2::aod::BCsWithTimestamps const&)
   {
+    auto processCost = fillCost.measure("processMCReco");
     bool doRecoSep = true;
 
     const bool hasTVX = event.selection_bit(aod::evsel::kIsTriggerTVX);
@@ -6264,6 +6277,7 @@ struct lfNucleiBATask {
                           aod::McParticles const& mcParticles,
                           o2::aod::BCsWithTimestamps const&)
   {
+    auto processCost = fillCost.measure("processMCRecoLfPid");
     bool doRecoSep = true;
 
     const bool hasTVX = event.selection_bit(aod::evsel::kIsTriggerTVX);
@@ -6304,6 +6318,7 @@ struct lfNucleiBATask {
                             aod::McParticles const& mcParticles,
                             aod::McCollisions const&)
   {
+    auto processCost = fillCost.measure("processMCRecoLfPidEv");
     for (const auto& collision : collisions) {
       if (!collision.has_mcCollision())
         continue;
@@ -6325,84 +6340,84 @@ struct lfNucleiBATask {
         bool isPhysPrim = mcParticle.isPhysicalPrimary();
 
         // No cut
-        spectraGen.fill(HIST("LfEv/pT_nocut"), pt);
+        fillCost.fill(spectraGen, HIST("LfEv/pT_nocut"), pt);
         if (pdg == PDGHelium) {
-          spectraGen.fill(HIST("LfEv/helium/pT_nocut_He"), pt);
+          fillCost.fill(spectraGen, HIST("LfEv/helium/pT_nocut_He"), pt);
           if (isPhysPrim)
-            spectraGen.fill(HIST("LfEv/helium/prim/pT_nocut_He"), pt);
+            fillCost.fill(spectraGen, HIST("LfEv/helium/prim/pT_nocut_He"), pt);
         }
         if (pdg == -PDGHelium) {
-          spectraGen.fill(HIST("LfEv/helium/pT_nocut_antiHe"), pt);
+          fillCost.fill(spectraGen, HIST("LfEv/helium/pT_nocut_antiHe"), pt);
           if (isPhysPrim)
-            spectraGen.fill(HIST("LfEv/helium/prim/pT_nocut_antiHe"), pt);
+            fillCost.fill(spectraGen, HIST("LfEv/helium/prim/pT_nocut_antiHe"), pt);
         }
         // Trigger TVX
         if (hasTVX) {
-          spectraGen.fill(HIST("LfEv/pT_TVXtrigger"), pt);
+          fillCost.fill(spectraGen, HIST("LfEv/pT_TVXtrigger"), pt);
           if (pdg == PDGHelium) {
-            spectraGen.fill(HIST("LfEv/helium/pT_TVXtrigger_He"), pt);
+            fillCost.fill(spectraGen, HIST("LfEv/helium/pT_TVXtrigger_He"), pt);
             if (isPhysPrim)
-              spectraGen.fill(HIST("LfEv/helium/prim/pT_TVXtrigger_He"), pt);
+              fillCost.fill(spectraGen, HIST("LfEv/helium/prim/pT_TVXtrigger_He"), pt);
           }
           if (pdg == -PDGHelium) {
-            spectraGen.fill(HIST("LfEv/helium/pT_TVXtrigger_antiHe"), pt);
+            fillCost.fill(spectraGen, HIST("LfEv/helium/pT_TVXtrigger_antiHe"), pt);
             if (isPhysPrim)
-              spectraGen.fill(HIST("LfEv/helium/prim/pT_TVXtrigger_antiHe"), pt);
+              fillCost.fill(spectraGen, HIST("LfEv/helium/prim/pT_TVXtrigger_antiHe"), pt);
           }
         }
         // No Time Frame Border
         if (hasNoTFB) {
-          spectraGen.fill(HIST("LfEv/pT_TFrameBorder"), pt);
+          fillCost.fill(spectraGen, HIST("LfEv/pT_TFrameBorder"), pt);
           if (pdg == PDGHelium) {
-            spectraGen.fill(HIST("LfEv/helium/pT_TFrameBorder_He"), pt);
+            fillCost.fill(spectraGen, HIST("LfEv/helium/pT_TFrameBorder_He"), pt);
             if (isPhysPrim)
-              spectraGen.fill(HIST("LfEv/helium/prim/pT_TFrameBorder_He"), pt);
+              fillCost.fill(spectraGen, HIST("LfEv/helium/prim/pT_TFrameBorder_He"), pt);
           }
           if (pdg == -PDGHelium) {
-            spectraGen.fill(HIST("LfEv/helium/pT_TFrameBorder_antiHe"), pt);
+            fillCost.fill(spectraGen, HIST("LfEv/helium/pT_TFrameBorder_antiHe"), pt);
             if (isPhysPrim)
-              spectraGen.fill(HIST("LfEv/helium/prim/pT_TFrameBorder_antiHe"), pt);
+              fillCost.fill(spectraGen, HIST("LfEv/helium/prim/pT_TFrameBorder_antiHe"), pt);
           }
         }
         // No ITS ROF Frame Border
         if (hasNoItsRofFB) {
-          spectraGen.fill(HIST("LfEv/pT_ITSROFBorder"), pt);
+          fillCost.fill(spectraGen, HIST("LfEv/pT_ITSROFBorder"), pt);
           if (pdg == PDGHelium) {
-            spectraGen.fill(HIST("LfEv/helium/pT_ITSROFBorder_He"), pt);
+            fillCost.fill(spectraGen, HIST("LfEv/helium/pT_ITSROFBorder_He"), pt);
             if (isPhysPrim)
-              spectraGen.fill(HIST("LfEv/helium/prim/pT_ITSROFBorder_He"), pt);
+              fillCost.fill(spectraGen, HIST("LfEv/helium/prim/pT_ITSROFBorder_He"), pt);
           }
           if (pdg == -PDGHelium) {
-            spectraGen.fill(HIST("LfEv/helium/pT_ITSROFBorder_antiHe"), pt);
+            fillCost.fill(spectraGen, HIST("LfEv/helium/pT_ITSROFBorder_antiHe"), pt);
             if (isPhysPrim)
-              spectraGen.fill(HIST("LfEv/helium/prim/pT_ITSROFBorder_antiHe"), pt);
+              fillCost.fill(spectraGen, HIST("LfEv/helium/prim/pT_ITSROFBorder_antiHe"), pt);
           }
         }
         // Sel8 MC
         if (hasTVX && hasNoTFB) {
-          spectraGen.fill(HIST("LfEv/pT_MCsel8"), pt);
+          fillCost.fill(spectraGen, HIST("LfEv/pT_MCsel8"), pt);
           if (pdg == PDGHelium) {
-            spectraGen.fill(HIST("LfEv/helium/pT_MCsel8_He"), pt);
+            fillCost.fill(spectraGen, HIST("LfEv/helium/pT_MCsel8_He"), pt);
             if (isPhysPrim)
-              spectraGen.fill(HIST("LfEv/helium/prim/pT_MCsel8_He"), pt);
+              fillCost.fill(spectraGen, HIST("LfEv/helium/prim/pT_MCsel8_He"), pt);
           }
           if (pdg == -PDGHelium) {
-            spectraGen.fill(HIST("LfEv/helium/pT_MCsel8_antiHe"), pt);
+            fillCost.fill(spectraGen, HIST("LfEv/helium/pT_MCsel8_antiHe"), pt);
             if (isPhysPrim)
-              spectraGen.fill(HIST("LfEv/helium/prim/pT_MCsel8_antiHe"), pt);
+              fillCost.fill(spectraGen, HIST("LfEv/helium/prim/pT_MCsel8_antiHe"), pt);
           }
         }
         // Sel8 tag
         if (hasSel8) {
-          spectraGen.fill(HIST("LfEv/pT_sel8"), pt);
+          fillCost.fill(spectraGen, HIST("LfEv/pT_sel8"), pt);
           if (pdg == PDGHelium)
-            spectraGen.fill(HIST("LfEv/helium/pT_sel8_He"), pt);
+            fillCost.fill(spectraGen, HIST("LfEv/helium/pT_sel8_He"), pt);
           if (isPhysPrim)
-            spectraGen.fill(HIST("LfEv/helium/prim/pT_sel8_He"), pt);
+            fillCost.fill(spectraGen, HIST("LfEv/helium/prim/pT_sel8_He"), pt);
           if (pdg == -PDGHelium)
-            spectraGen.fill(HIST("LfEv/helium/pT_sel8_antiHe"), pt);
+            fillCost.fill(spectraGen, HIST("LfEv/helium/pT_sel8_antiHe"), pt);
           if (isPhysPrim)
-            spectraGen.fill(HIST("LfEv/helium/prim/pT_sel8_antiHe"), pt);
+            fillCost.fill(spectraGen, HIST("LfEv/helium/prim/pT_sel8_antiHe"), pt);
         }
       }
     }
@@ -6415,6 +6430,7 @@ struct lfNucleiBATask {
                              soa::Join<o2::aod::LfCandNucleusFull, o2::aod::LfCandNucleusMC> const& tracks,
                              o2::aod::BCsWithTimestamps const&)
   {
+    auto processCost = fillCost.measure("processMCRecoFiltered");
     fillHistograms<true /*MC*/, true /*Filtered*/>(event, tracks, true /*dummy*/, event.centFT0M());
   } // CLOSING PROCESS MC RECO ON FILTERED DATA
   PROCESS_SWITCH(lfNucleiBATask, processMCRecoFiltered, "process mc reco on the filtered data", false);
@@ -6423,6 +6439,7 @@ struct lfNucleiBATask {
                                   soa::Join<o2::aod::LfCandNucleusDummy, o2::aod::LfCandNucleusMC> const& tracks,
                                   o2::aod::BCsWithTimestamps const&)
   {
+    auto processCost = fillCost.measure("processMCRecoFilteredLight");
     fillHistograms<true /*MC*/, true /*Filtered*/>(event, tracks, true /*dummy*/, event.centFT0M());
   } // CLOSING PROCESS MC RECO ON FILTERED DATA
   PROCESS_SWITCH(lfNucleiBATask, processMCRecoFilteredLight, "process mc reco on the derived trees", false);
@@ -6435,6 +6452,7 @@ struct lfNucleiBATask {
   void processMCGen(soa::Join<aod::McCollisions, aod::McCentFT0Ms>::iterator const& mcCollision,
                     aod::McParticles const& mcParticles)
   {
+    auto processCost = fillCost.measure("processMCGen");
     // Only events that are reconstructed
     const int mcIdx = mcCollision.globalIndex();
     if (enableEffEvtSet) {
@@ -6453,9 +6471,9 @@ struct lfNucleiBATask {
     }
 
     if (enableCentrality)
-      spectraGen.fill(HIST("histGenVetxZ"), mcCollision.posZ(), mcCollision.centFT0M());
+      fillCost.fill(spectraGen, HIST("histGenVetxZ"), mcCollision.posZ(), mcCollision.centFT0M());
     else
-      spectraGen.fill(HIST("histGenVetxZ"), mcCollision.posZ());
+      fillCost.fill(spectraGen, HIST("histGenVetxZ"), mcCollision.posZ());
 
     // const auto& particlesInCollision = mcParticles.sliceByCached(aod::mcparticle::mcCollisionId, mcIdx, cache);
     // const auto particlesInCollision = mcParticles.sliceBy(perMCCol, mcIdx);
@@ -6474,162 +6492,162 @@ struct lfNucleiBATask {
       bool isWeakDecay = (mcParticleGen.getProcess() == TMCProcess::kPDecay);
 
       if (pdgCode == PDGPion) {
-        spectraGen.fill(HIST("pion/histGenPtPion"), ptMC);
+        fillCost.fill(spectraGen, HIST("pion/histGenPtPion"), ptMC);
         if (isPhysPrim)
-          spectraGen.fill(HIST("pion/histGenPtPionPrim"), ptMC);
+          fillCost.fill(spectraGen, HIST("pion/histGenPtPionPrim"), ptMC);
         if (!isPhysPrim && isProdByGen) {
           //
         }
         if (!isPhysPrim && !isProdByGen) {
-          spectraGen.fill(HIST("pion/histSecTransportPtPion"), ptMC);
+          fillCost.fill(spectraGen, HIST("pion/histSecTransportPtPion"), ptMC);
           if (isWeakDecay) {
-            spectraGen.fill(HIST("pion/histGenPtPionSec"), ptMC);
+            fillCost.fill(spectraGen, HIST("pion/histGenPtPionSec"), ptMC);
           }
         }
       }
       if (pdgCode == -PDGPion) {
-        spectraGen.fill(HIST("pion/histGenPtantiPion"), ptMC);
+        fillCost.fill(spectraGen, HIST("pion/histGenPtantiPion"), ptMC);
         if (isPhysPrim)
-          spectraGen.fill(HIST("pion/histGenPtantiPionPrim"), ptMC);
+          fillCost.fill(spectraGen, HIST("pion/histGenPtantiPionPrim"), ptMC);
         if (!isPhysPrim && isProdByGen) {
           //
         }
         if (!isPhysPrim && !isProdByGen) {
-          spectraGen.fill(HIST("pion/histSecTransportPtantiPion"), ptMC);
+          fillCost.fill(spectraGen, HIST("pion/histSecTransportPtantiPion"), ptMC);
           if (isWeakDecay) {
-            spectraGen.fill(HIST("pion/histGenPtantiPionSec"), ptMC);
+            fillCost.fill(spectraGen, HIST("pion/histGenPtantiPionSec"), ptMC);
           }
         }
       }
       if (pdgCode == PDGKaon) {
-        spectraGen.fill(HIST("kaon/histGenPtKaon"), ptMC);
+        fillCost.fill(spectraGen, HIST("kaon/histGenPtKaon"), ptMC);
         if (isPhysPrim)
-          spectraGen.fill(HIST("kaon/histGenPtKaonPrim"), ptMC);
+          fillCost.fill(spectraGen, HIST("kaon/histGenPtKaonPrim"), ptMC);
         if (!isPhysPrim && isProdByGen) {
           //
         }
         if (!isPhysPrim && !isProdByGen) {
-          spectraGen.fill(HIST("kaon/histSecTransportPtKaon"), ptMC);
+          fillCost.fill(spectraGen, HIST("kaon/histSecTransportPtKaon"), ptMC);
           if (isWeakDecay) {
-            spectraGen.fill(HIST("kaon/histGenPtKaonSec"), ptMC);
+            fillCost.fill(spectraGen, HIST("kaon/histGenPtKaonSec"), ptMC);
           }
         }
       }
       if (pdgCode == -PDGKaon) {
-        spectraGen.fill(HIST("kaon/histGenPtantiKaon"), ptMC);
+        fillCost.fill(spectraGen, HIST("kaon/histGenPtantiKaon"), ptMC);
         if (isPhysPrim)
-          spectraGen.fill(HIST("kaon/histGenPtantiKaonPrim"), ptMC);
+          fillCost.fill(spectraGen, HIST("kaon/histGenPtantiKaonPrim"), ptMC);
         if (!isPhysPrim && isProdByGen) {
           //
         }
         if (!isPhysPrim && !isProdByGen) {
-          spectraGen.fill(HIST("kaon/histSecTransportPtantiKaon"), ptMC);
+          fillCost.fill(spectraGen, HIST("kaon/histSecTransportPtantiKaon"), ptMC);
           if (isWeakDecay) {
-            spectraGen.fill(HIST("kaon/histGenPtantiKaonSec"), ptMC);
+            fillCost.fill(spectraGen, HIST("kaon/histGenPtantiKaonSec"), ptMC);
           }
         }
       }
       if (enablePr) {
         if (pdgCode == PDGProton) {
-          spectraGen.fill(HIST("proton/histGenPtProton"), ptMC);
+          fillCost.fill(spectraGen, HIST("proton/histGenPtProton"), ptMC);
           if (isPhysPrim) {
-            spectraGen.fill(HIST("proton/histGenPtProtonPrim"), ptMC);
-            spectraGen.fill(HIST("proton/histGenPtProtonPrim_Y"), mcParticleGen.y(), ptMC);
+            fillCost.fill(spectraGen, HIST("proton/histGenPtProtonPrim"), ptMC);
+            fillCost.fill(spectraGen, HIST("proton/histGenPtProtonPrim_Y"), mcParticleGen.y(), ptMC);
           }
           if (!isPhysPrim && isProdByGen) {
             //
           }
           if (!isPhysPrim && !isProdByGen) {
-            spectraGen.fill(HIST("proton/histSecTransportPtProton"), ptMC);
+            fillCost.fill(spectraGen, HIST("proton/histSecTransportPtProton"), ptMC);
             if (isWeakDecay) {
-              spectraGen.fill(HIST("proton/histGenPtProtonSec"), ptMC);
+              fillCost.fill(spectraGen, HIST("proton/histGenPtProtonSec"), ptMC);
             }
           }
         }
         if (pdgCode == -PDGProton) {
-          spectraGen.fill(HIST("proton/histGenPtantiProton"), ptMC);
+          fillCost.fill(spectraGen, HIST("proton/histGenPtantiProton"), ptMC);
           if (isPhysPrim) {
-            spectraGen.fill(HIST("proton/histGenPtantiProtonPrim"), ptMC);
-            spectraGen.fill(HIST("proton/histGenPtantiProtonPrim_Y"), mcParticleGen.y(), ptMC);
+            fillCost.fill(spectraGen, HIST("proton/histGenPtantiProtonPrim"), ptMC);
+            fillCost.fill(spectraGen, HIST("proton/histGenPtantiProtonPrim_Y"), mcParticleGen.y(), ptMC);
           }
           if (!isPhysPrim && isProdByGen) {
             //
           }
           if (!isPhysPrim && !isProdByGen) {
-            spectraGen.fill(HIST("proton/histSecTransportPtantiProton"), ptMC);
+            fillCost.fill(spectraGen, HIST("proton/histSecTransportPtantiProton"), ptMC);
             if (isWeakDecay) {
-              spectraGen.fill(HIST("proton/histGenPtantiProtonSec"), ptMC);
+              fillCost.fill(spectraGen, HIST("proton/histGenPtantiProtonSec"), ptMC);
             }
           }
         }
       }
       if (enableDe) {
         if (pdgCode == PDGDeuteron) {
-          spectraGen.fill(HIST("deuteron/histGenPtD"), ptMC);
+          fillCost.fill(spectraGen, HIST("deuteron/histGenPtD"), ptMC);
           if (isPhysPrim)
-            spectraGen.fill(HIST("deuteron/histGenPtDPrim"), ptMC);
+            fillCost.fill(spectraGen, HIST("deuteron/histGenPtDPrim"), ptMC);
           if (!isPhysPrim && isProdByGen) {
             //
           }
           if (!isPhysPrim && !isProdByGen) {
-            spectraGen.fill(HIST("deuteron/histSecTransportPtD"), ptMC);
+            fillCost.fill(spectraGen, HIST("deuteron/histSecTransportPtD"), ptMC);
             if (isWeakDecay) {
-              spectraGen.fill(HIST("deuteron/histGenPtDSec"), ptMC);
+              fillCost.fill(spectraGen, HIST("deuteron/histGenPtDSec"), ptMC);
             }
           }
         }
         if (pdgCode == -PDGDeuteron) {
-          spectraGen.fill(HIST("deuteron/histGenPtantiD"), ptMC);
+          fillCost.fill(spectraGen, HIST("deuteron/histGenPtantiD"), ptMC);
           if (isPhysPrim)
-            spectraGen.fill(HIST("deuteron/histGenPtantiDPrim"), ptMC);
+            fillCost.fill(spectraGen, HIST("deuteron/histGenPtantiDPrim"), ptMC);
           if (!isPhysPrim && isProdByGen) {
             //
           }
           if (!isPhysPrim && !isProdByGen) {
-            spectraGen.fill(HIST("deuteron/histSecTransportPtantiD"), ptMC);
+            fillCost.fill(spectraGen, HIST("deuteron/histSecTransportPtantiD"), ptMC);
             if (isWeakDecay) {
-              spectraGen.fill(HIST("deuteron/histGenPtantiDSec"), ptMC);
+              fillCost.fill(spectraGen, HIST("deuteron/histGenPtantiDSec"), ptMC);
             }
           }
         }
       }
       if (enableTr) {
         if (pdgCode == PDGTriton) {
-          spectraGen.fill(HIST("triton/histGenPtT"), ptMC);
+          fillCost.fill(spectraGen, HIST("triton/histGenPtT"), ptMC);
           if (isPhysPrim)
-            spectraGen.fill(HIST("triton/histGenPtTPrim"), ptMC);
+            fillCost.fill(spectraGen, HIST("triton/histGenPtTPrim"), ptMC);
           if (!isPhysPrim && isProdByGen) {
             //
           }
           if (!isPhysPrim && !isProdByGen) {
-            spectraGen.fill(HIST("triton/histSecTransportPtT"), ptMC);
+            fillCost.fill(spectraGen, HIST("triton/histSecTransportPtT"), ptMC);
             if (isWeakDecay) {
-              spectraGen.fill(HIST("triton/histGenPtTSec"), ptMC);
+              fillCost.fill(spectraGen, HIST("triton/histGenPtTSec"), ptMC);
             }
           }
         }
         if (pdgCode == -PDGTriton) {
-          spectraGen.fill(HIST("triton/histGenPtantiT"), ptMC);
+          fillCost.fill(spectraGen, HIST("triton/histGenPtantiT"), ptMC);
           if (isPhysPrim)
-            spectraGen.fill(HIST("triton/histGenPtantiTPrim"), ptMC);
+            fillCost.fill(spectraGen, HIST("triton/histGenPtantiTPrim"), ptMC);
           if (!isPhysPrim && isProdByGen) {
             //
           }
           if (!isPhysPrim && !isProdByGen) {
-            spectraGen.fill(HIST("triton/histSecTransportPtantiT"), ptMC);
+            fillCost.fill(spectraGen, HIST("triton/histSecTransportPtantiT"), ptMC);
             if (isWeakDecay) {
-              spectraGen.fill(HIST("triton/histGenPtantiTSec"), ptMC);
+              fillCost.fill(spectraGen, HIST("triton/histGenPtantiTSec"), ptMC);
             }
           }
         }
       }
       if (enableHe) {
         if (pdgCode == PDGHelium) {
-          spectraGen.fill(HIST("helium/histGenPtHe"), ptMC);
+          fillCost.fill(spectraGen, HIST("helium/histGenPtHe"), ptMC);
           if (isPhysPrim) {
-            spectraGen.fill(HIST("helium/histGenPtHePrim"), ptMC);
+            fillCost.fill(spectraGen, HIST("helium/histGenPtHePrim"), ptMC);
             if (enableCentrality)
-              spectraGen.fill(HIST("helium/histGenPtHePrimVsMult"), ptMC, mcCollision.centFT0M());
+              fillCost.fill(spectraGen, HIST("helium/histGenPtHePrimVsMult"), ptMC, mcCollision.centFT0M());
           }
           if (!isPhysPrim && isProdByGen) {
             {
@@ -6637,18 +6655,18 @@ struct lfNucleiBATask {
             }
           }
           if (!isPhysPrim && !isProdByGen) {
-            spectraGen.fill(HIST("helium/histSecTransportPtHe"), ptMC);
+            fillCost.fill(spectraGen, HIST("helium/histSecTransportPtHe"), ptMC);
             if (isWeakDecay) {
-              spectraGen.fill(HIST("helium/histGenPtHeSec"), ptMC);
+              fillCost.fill(spectraGen, HIST("helium/histGenPtHeSec"), ptMC);
             }
           }
         }
         if (pdgCode == -PDGHelium) {
-          spectraGen.fill(HIST("helium/histGenPtantiHe"), ptMC);
+          fillCost.fill(spectraGen, HIST("helium/histGenPtantiHe"), ptMC);
           if (isPhysPrim) {
-            spectraGen.fill(HIST("helium/histGenPtantiHePrim"), ptMC);
+            fillCost.fill(spectraGen, HIST("helium/histGenPtantiHePrim"), ptMC);
             if (enableCentrality)
-              spectraGen.fill(HIST("helium/histGenPtantiHePrimVsMult"), ptMC, mcCollision.centFT0M());
+              fillCost.fill(spectraGen, HIST("helium/histGenPtantiHePrimVsMult"), ptMC, mcCollision.centFT0M());
           }
           if (!isPhysPrim && isProdByGen) {
             {
@@ -6656,39 +6674,39 @@ struct lfNucleiBATask {
             }
           }
           if (!isPhysPrim && !isProdByGen) {
-            spectraGen.fill(HIST("helium/histSecTransportPtantiHe"), ptMC);
+            fillCost.fill(spectraGen, HIST("helium/histSecTransportPtantiHe"), ptMC);
             if (isWeakDecay) {
-              spectraGen.fill(HIST("helium/histGenPtantiHeSec"), ptMC);
+              fillCost.fill(spectraGen, HIST("helium/histGenPtantiHeSec"), ptMC);
             }
           }
         }
       }
       if (enableAl) {
         if (pdgCode == PDGAlpha) {
-          spectraGen.fill(HIST("alpha/histGenPtAl"), ptMC);
+          fillCost.fill(spectraGen, HIST("alpha/histGenPtAl"), ptMC);
           if (isPhysPrim)
-            spectraGen.fill(HIST("alpha/histGenPtAlPrim"), ptMC);
+            fillCost.fill(spectraGen, HIST("alpha/histGenPtAlPrim"), ptMC);
           if (!isPhysPrim && isProdByGen) {
             //
           }
           if (!isPhysPrim && !isProdByGen) {
-            spectraGen.fill(HIST("alpha/histSecTransportPtAl"), ptMC);
+            fillCost.fill(spectraGen, HIST("alpha/histSecTransportPtAl"), ptMC);
             if (isWeakDecay) {
-              spectraGen.fill(HIST("alpha/histGenPtAlSec"), ptMC);
+              fillCost.fill(spectraGen, HIST("alpha/histGenPtAlSec"), ptMC);
             }
           }
         }
         if (pdgCode == -PDGAlpha) {
-          spectraGen.fill(HIST("alpha/histGenPtantiAl"), ptMC);
+          fillCost.fill(spectraGen, HIST("alpha/histGenPtantiAl"), ptMC);
           if (isPhysPrim)
-            spectraGen.fill(HIST("alpha/histGenPtantiAlPrim"), ptMC);
+            fillCost.fill(spectraGen, HIST("alpha/histGenPtantiAlPrim"), ptMC);
           if (!isPhysPrim && isProdByGen) {
             //
           }
           if (!isPhysPrim && !isProdByGen) {
-            spectraGen.fill(HIST("alpha/histSecTransportPtantiAl"), ptMC);
+            fillCost.fill(spectraGen, HIST("alpha/histSecTransportPtantiAl"), ptMC);
             if (isWeakDecay) {
-              spectraGen.fill(HIST("alpha/histGenPtantiAlSec"), ptMC);
+              fillCost.fill(spectraGen, HIST("alpha/histGenPtantiAlSec"), ptMC);
             }
           }
         }
@@ -6701,8 +6719,9 @@ struct lfNucleiBATask {
                          aod::McParticles const& mcParticles,
                          const soa::SmallGroups<EventCandidatesMC>& recoColls)
   {
+    auto processCost = fillCost.measure("processEvSgLossMC");
     if (std::abs(mcCollision.posZ()) < cfgVzCutHigh)
-      evLossHistos.fill(HIST("evLoss/hEvent"), 0.5);
+      fillCost.fill(evLossHistos, HIST("evLoss/hEvent"), 0.5);
 
     bool isSel8Event = false;
     bool isTvxEvent = false;
@@ -6727,11 +6746,11 @@ struct lfNucleiBATask {
       isMCSel8Event = true;
 
     if (isTvxEvent)
-      evLossHistos.fill(HIST("evLoss/hEvent"), 1.5);
+      fillCost.fill(evLossHistos, HIST("evLoss/hEvent"), 1.5);
     if (isMCSel8Event)
-      evLossHistos.fill(HIST("evLoss/hEvent"), 2.5);
+      fillCost.fill(evLossHistos, HIST("evLoss/hEvent"), 2.5);
     if (isSel8Event)
-      evLossHistos.fill(HIST("evLoss/hEvent"), 3.5);
+      fillCost.fill(evLossHistos, HIST("evLoss/hEvent"), 3.5);
 
     // Loop over all the Generated level particles
     for (const auto& mcPart : mcParticles) {
@@ -6744,40 +6763,40 @@ struct lfNucleiBATask {
       const int pdg = mcPart.pdgCode();
 
       if (pdg == PDGDeuteron) {
-        evLossHistos.fill(HIST("evLoss/pt/hDeuteronGen"), pt);
+        fillCost.fill(evLossHistos, HIST("evLoss/pt/hDeuteronGen"), pt);
         if (isTvxEvent)
-          evLossHistos.fill(HIST("evLoss/pt/hDeuteronTriggeredTVX"), pt);
+          fillCost.fill(evLossHistos, HIST("evLoss/pt/hDeuteronTriggeredTVX"), pt);
         if (isSel8Event)
-          evLossHistos.fill(HIST("evLoss/pt/hDeuteronTriggeredSel8"), pt);
+          fillCost.fill(evLossHistos, HIST("evLoss/pt/hDeuteronTriggeredSel8"), pt);
         if (isMCSel8Event)
-          evLossHistos.fill(HIST("evLoss/pt/hDeuteronTriggeredMCSel8"), pt);
+          fillCost.fill(evLossHistos, HIST("evLoss/pt/hDeuteronTriggeredMCSel8"), pt);
       }
       if (pdg == -PDGDeuteron) {
-        evLossHistos.fill(HIST("evLoss/pt/hAntiDeuteronGen"), pt);
+        fillCost.fill(evLossHistos, HIST("evLoss/pt/hAntiDeuteronGen"), pt);
         if (isTvxEvent)
-          evLossHistos.fill(HIST("evLoss/pt/hAntiDeuteronTriggeredTVX"), pt);
+          fillCost.fill(evLossHistos, HIST("evLoss/pt/hAntiDeuteronTriggeredTVX"), pt);
         if (isSel8Event)
-          evLossHistos.fill(HIST("evLoss/pt/hAntiDeuteronTriggeredSel8"), pt);
+          fillCost.fill(evLossHistos, HIST("evLoss/pt/hAntiDeuteronTriggeredSel8"), pt);
         if (isMCSel8Event)
-          evLossHistos.fill(HIST("evLoss/pt/hAntiDeuteronTriggeredMCSel8"), pt);
+          fillCost.fill(evLossHistos, HIST("evLoss/pt/hAntiDeuteronTriggeredMCSel8"), pt);
       }
       if (pdg == PDGHelium) {
-        evLossHistos.fill(HIST("evLoss/pt/hHeliumGen"), pt);
+        fillCost.fill(evLossHistos, HIST("evLoss/pt/hHeliumGen"), pt);
         if (isTvxEvent)
-          evLossHistos.fill(HIST("evLoss/pt/hHeliumTriggeredTVX"), pt);
+          fillCost.fill(evLossHistos, HIST("evLoss/pt/hHeliumTriggeredTVX"), pt);
         if (isSel8Event)
-          evLossHistos.fill(HIST("evLoss/pt/hHeliumTriggeredSel8"), pt);
+          fillCost.fill(evLossHistos, HIST("evLoss/pt/hHeliumTriggeredSel8"), pt);
         if (isMCSel8Event)
-          evLossHistos.fill(HIST("evLoss/pt/hHeliumTriggeredMCSel8"), pt);
+          fillCost.fill(evLossHistos, HIST("evLoss/pt/hHeliumTriggeredMCSel8"), pt);
       }
       if (pdg == -PDGHelium) {
-        evLossHistos.fill(HIST("evLoss/pt/hAntiHeliumGen"), pt);
+        fillCost.fill(evLossHistos, HIST("evLoss/pt/hAntiHeliumGen"), pt);
         if (isTvxEvent)
-          evLossHistos.fill(HIST("evLoss/pt/hAntiHeliumTriggeredTVX"), pt);
+          fillCost.fill(evLossHistos, HIST("evLoss/pt/hAntiHeliumTriggeredTVX"), pt);
         if (isSel8Event)
-          evLossHistos.fill(HIST("evLoss/pt/hAntiHeliumTriggeredSel8"), pt);
+          fillCost.fill(evLossHistos, HIST("evLoss/pt/hAntiHeliumTriggeredSel8"), pt);
         if (isMCSel8Event)
-          evLossHistos.fill(HIST("evLoss/pt/hAntiHeliumTriggeredMCSel8"), pt);
+          fillCost.fill(evLossHistos, HIST("evLoss/pt/hAntiHeliumTriggeredMCSel8"), pt);
       }
     }
   }
@@ -6789,27 +6808,28 @@ struct lfNucleiBATask {
     const soa::SmallGroups<soa::Join<EventCandidatesMC, o2::aod::PVMults>>& collisions,
     aod::McParticles const& mcParticles)
   {
+    auto processCost = fillCost.measure("processMCGenLosses");
     bool isINELgt0true = pwglf::isINELgtNmc(mcParticles, 0, pdgDB);
 
     // EVENT LOSS DENOMINATOR
     // No cuts
-    histoGen.fill(HIST("events/hMCGen"), 0.5);
+    fillCost.fill(histoGen, HIST("events/hMCGen"), 0.5);
     if (enableCentrality)
-      histoGen.fill(HIST("events/hMCGenVsMult"), 0.5, mcCollision.centFT0M());
+      fillCost.fill(histoGen, HIST("events/hMCGenVsMult"), 0.5, mcCollision.centFT0M());
 
     // Vtz cut
     if (mcCollision.posZ() < cfgVzCutLow || mcCollision.posZ() > cfgVzCutHigh)
       return;
 
-    histoGen.fill(HIST("events/hMCGen"), 1.5);
+    fillCost.fill(histoGen, HIST("events/hMCGen"), 1.5);
     if (enableCentrality)
-      histoGen.fill(HIST("events/hMCGenVsMult"), 1.5, mcCollision.centFT0M());
+      fillCost.fill(histoGen, HIST("events/hMCGenVsMult"), 1.5, mcCollision.centFT0M());
 
     // INEL > 0
     if (isINELgt0true) {
-      histoGen.fill(HIST("events/hMCGen"), 2.5);
+      fillCost.fill(histoGen, HIST("events/hMCGen"), 2.5);
       if (enableCentrality)
-        histoGen.fill(HIST("events/hMCGenVsMult"), 2.5, mcCollision.centFT0M());
+        fillCost.fill(histoGen, HIST("events/hMCGenVsMult"), 2.5, mcCollision.centFT0M());
     }
 
     // SIGNAL LOSS DENOMINATOR
@@ -6823,26 +6843,26 @@ struct lfNucleiBATask {
 
       if (enableHe && isPhysPrim && (std::abs(pdg) == PDGHelium)) {
         if (pdg > 0) {
-          histoGen.fill(HIST("helium/MCGen/h2HeliumYvsPt"), mcParticle.y(), pt);
-          histoGen.fill(HIST("helium/MCGen/ptGen_INEL_Prim_He"), pt);
+          fillCost.fill(histoGen, HIST("helium/MCGen/h2HeliumYvsPt"), mcParticle.y(), pt);
+          fillCost.fill(histoGen, HIST("helium/MCGen/ptGen_INEL_Prim_He"), pt);
           if (enableCentrality)
-            histoGen.fill(HIST("helium/MCGen/ptGenVsMult_INEL_Prim_He"), pt, mcCollision.centFT0M());
+            fillCost.fill(histoGen, HIST("helium/MCGen/ptGenVsMult_INEL_Prim_He"), pt, mcCollision.centFT0M());
         } else {
-          histoGen.fill(HIST("helium/MCGen/h2antiHeliumYvsPt"), mcParticle.y(), pt);
-          histoGen.fill(HIST("helium/MCGen/ptGen_INEL_Prim_antiHe"), pt);
+          fillCost.fill(histoGen, HIST("helium/MCGen/h2antiHeliumYvsPt"), mcParticle.y(), pt);
+          fillCost.fill(histoGen, HIST("helium/MCGen/ptGen_INEL_Prim_antiHe"), pt);
           if (enableCentrality)
-            histoGen.fill(HIST("helium/MCGen/ptGenVsMult_INEL_Prim_antiHe"), pt, mcCollision.centFT0M());
+            fillCost.fill(histoGen, HIST("helium/MCGen/ptGenVsMult_INEL_Prim_antiHe"), pt, mcCollision.centFT0M());
         }
 
         if (isINELgt0true) {
           if (pdg > 0) {
-            histoGen.fill(HIST("helium/MCGen/ptGen_INELgt0_Prim_He"), pt);
+            fillCost.fill(histoGen, HIST("helium/MCGen/ptGen_INELgt0_Prim_He"), pt);
             if (enableCentrality)
-              histoGen.fill(HIST("helium/MCGen/ptGenVsMult_INELgt0_Prim_He"), pt, mcCollision.centFT0M());
+              fillCost.fill(histoGen, HIST("helium/MCGen/ptGenVsMult_INELgt0_Prim_He"), pt, mcCollision.centFT0M());
           } else {
-            histoGen.fill(HIST("helium/MCGen/ptGen_INELgt0_Prim_antiHe"), pt);
+            fillCost.fill(histoGen, HIST("helium/MCGen/ptGen_INELgt0_Prim_antiHe"), pt);
             if (enableCentrality)
-              histoGen.fill(HIST("helium/MCGen/ptGenVsMult_INELgt0_Prim_antiHe"), pt, mcCollision.centFT0M());
+              fillCost.fill(histoGen, HIST("helium/MCGen/ptGenVsMult_INELgt0_Prim_antiHe"), pt, mcCollision.centFT0M());
           }
         }
       }
@@ -6859,9 +6879,9 @@ struct lfNucleiBATask {
       bool hasNoTFB = collision.selection_bit(aod::evsel::kNoTimeFrameBorder);
       bool hasNoItsRofFB = collision.selection_bit(aod::evsel::kNoITSROFrameBorder);
 
-      histoGen.fill(HIST("events/hMCReco"), 0.5);
+      fillCost.fill(histoGen, HIST("events/hMCReco"), 0.5);
       if (enableCentrality)
-        histoGen.fill(HIST("events/hMCRecoVsMult"), 0.5, mcCollision.centFT0M());
+        fillCost.fill(histoGen, HIST("events/hMCRecoVsMult"), 0.5, mcCollision.centFT0M());
 
       // Event selection cuts
       if (evselOptions.useSel8 && !isSel8Event)
@@ -6878,18 +6898,18 @@ struct lfNucleiBATask {
         continue;
 
       // EVENT SPLITTING DENOMINATOR
-      histoGen.fill(HIST("events/hMCReco"), 1.5);
+      fillCost.fill(histoGen, HIST("events/hMCReco"), 1.5);
       if (enableCentrality)
-        histoGen.fill(HIST("events/hMCRecoVsMult"), 1.5, mcCollision.centFT0M());
+        fillCost.fill(histoGen, HIST("events/hMCRecoVsMult"), 1.5, mcCollision.centFT0M());
 
       recoIdxINEL++;
       atLeastOneINEL = true;
 
       if (collision.isInelGt0() && isINELgt0true) {
         // EVENT SPLITTING DENOMINATOR
-        histoGen.fill(HIST("events/hMCReco"), 2.5);
+        fillCost.fill(histoGen, HIST("events/hMCReco"), 2.5);
         if (enableCentrality)
-          histoGen.fill(HIST("events/hMCRecoVsMult"), 2.5, mcCollision.centFT0M());
+          fillCost.fill(histoGen, HIST("events/hMCRecoVsMult"), 2.5, mcCollision.centFT0M());
 
         recoIdxINELgt0++;
         atLeastOneINELgt0 = true;
@@ -6905,49 +6925,49 @@ struct lfNucleiBATask {
 
         if (enableHe && isPhysPrim && (std::abs(pdg) == PDGHelium)) {
           if (pdg > 0) {
-            histoGen.fill(HIST("helium/MCReco/ptGen_INEL_Prim_He"), pt);
+            fillCost.fill(histoGen, HIST("helium/MCReco/ptGen_INEL_Prim_He"), pt);
             if (enableCentrality)
-              histoGen.fill(HIST("helium/MCReco/ptGenVsMult_INEL_Prim_He"), pt, mcCollision.centFT0M());
+              fillCost.fill(histoGen, HIST("helium/MCReco/ptGenVsMult_INEL_Prim_He"), pt, mcCollision.centFT0M());
           } else {
-            histoGen.fill(HIST("helium/MCReco/ptGen_INEL_Prim_antiHe"), pt);
+            fillCost.fill(histoGen, HIST("helium/MCReco/ptGen_INEL_Prim_antiHe"), pt);
             if (enableCentrality)
-              histoGen.fill(HIST("helium/MCReco/ptGenVsMult_INEL_Prim_antiHe"), pt, mcCollision.centFT0M());
+              fillCost.fill(histoGen, HIST("helium/MCReco/ptGenVsMult_INEL_Prim_antiHe"), pt, mcCollision.centFT0M());
           }
 
           if (atLeastOneINELgt0) {
             if (pdg > 0) {
-              histoGen.fill(HIST("helium/MCReco/ptGen_INELgt0_Prim_He"), pt);
+              fillCost.fill(histoGen, HIST("helium/MCReco/ptGen_INELgt0_Prim_He"), pt);
               if (enableCentrality)
-                histoGen.fill(HIST("helium/MCReco/ptGenVsMult_INELgt0_Prim_He"), pt, mcCollision.centFT0M());
+                fillCost.fill(histoGen, HIST("helium/MCReco/ptGenVsMult_INELgt0_Prim_He"), pt, mcCollision.centFT0M());
             } else {
-              histoGen.fill(HIST("helium/MCReco/ptGen_INELgt0_Prim_antiHe"), pt);
+              fillCost.fill(histoGen, HIST("helium/MCReco/ptGen_INELgt0_Prim_antiHe"), pt);
               if (enableCentrality)
-                histoGen.fill(HIST("helium/MCReco/ptGenVsMult_INELgt0_Prim_antiHe"), pt, mcCollision.centFT0M());
+                fillCost.fill(histoGen, HIST("helium/MCReco/ptGenVsMult_INELgt0_Prim_antiHe"), pt, mcCollision.centFT0M());
             }
           }
         }
       }
     }
 
-    histoGen.fill(HIST("events/hNRecoCollPerMCColl_INEL"), recoIdxINEL);
-    histoGen.fill(HIST("events/hNRecoCollPerMCColl_INELgt0"), recoIdxINELgt0);
+    fillCost.fill(histoGen, HIST("events/hNRecoCollPerMCColl_INEL"), recoIdxINEL);
+    fillCost.fill(histoGen, HIST("events/hNRecoCollPerMCColl_INELgt0"), recoIdxINELgt0);
     if (enableCentrality) {
-      histoGen.fill(HIST("events/hNRecoCollPerMCCollVsMult_INEL"), recoIdxINEL, mcCollision.centFT0M());
-      histoGen.fill(HIST("events/hNRecoCollPerMCCollVsMult_INELgt0"), recoIdxINELgt0, mcCollision.centFT0M());
+      fillCost.fill(histoGen, HIST("events/hNRecoCollPerMCCollVsMult_INEL"), recoIdxINEL, mcCollision.centFT0M());
+      fillCost.fill(histoGen, HIST("events/hNRecoCollPerMCCollVsMult_INELgt0"), recoIdxINELgt0, mcCollision.centFT0M());
     }
 
     if (!atLeastOneINEL)
       return;
 
     // EVENT LOSS NUMERATOR & EVENT SPLITTING NUMERATOR
-    histoGen.fill(HIST("events/hMCGenReco"), 0.5);
+    fillCost.fill(histoGen, HIST("events/hMCGenReco"), 0.5);
     if (enableCentrality)
-      histoGen.fill(HIST("events/hMCGenRecoVsMult"), 0.5, mcCollision.centFT0M());
+      fillCost.fill(histoGen, HIST("events/hMCGenRecoVsMult"), 0.5, mcCollision.centFT0M());
 
     if (atLeastOneINELgt0) {
-      histoGen.fill(HIST("events/hMCGenReco"), 1.5);
+      fillCost.fill(histoGen, HIST("events/hMCGenReco"), 1.5);
       if (enableCentrality)
-        histoGen.fill(HIST("events/hMCGenRecoVsMult"), 1.5, mcCollision.centFT0M());
+        fillCost.fill(histoGen, HIST("events/hMCGenRecoVsMult"), 1.5, mcCollision.centFT0M());
     }
 
     // SIGNAL LOSS NUMERATOR
@@ -6961,26 +6981,26 @@ struct lfNucleiBATask {
 
       if (enableHe && isPhysPrim && (std::abs(pdg) == PDGHelium)) {
         if (pdg > 0) {
-          histoGen.fill(HIST("helium/MCGenReco/h2HeliumYvsPt"), mcParticle.y(), pt);
-          histoGen.fill(HIST("helium/MCGenReco/ptGen_INEL_Prim_He"), pt);
+          fillCost.fill(histoGen, HIST("helium/MCGenReco/h2HeliumYvsPt"), mcParticle.y(), pt);
+          fillCost.fill(histoGen, HIST("helium/MCGenReco/ptGen_INEL_Prim_He"), pt);
           if (enableCentrality)
-            histoGen.fill(HIST("helium/MCGenReco/ptGenVsMult_INEL_Prim_He"), pt, mcCollision.centFT0M());
+            fillCost.fill(histoGen, HIST("helium/MCGenReco/ptGenVsMult_INEL_Prim_He"), pt, mcCollision.centFT0M());
         } else {
-          histoGen.fill(HIST("helium/MCGenReco/h2antiHeliumYvsPt"), mcParticle.y(), pt);
-          histoGen.fill(HIST("helium/MCGenReco/ptGen_INEL_Prim_antiHe"), pt);
+          fillCost.fill(histoGen, HIST("helium/MCGenReco/h2antiHeliumYvsPt"), mcParticle.y(), pt);
+          fillCost.fill(histoGen, HIST("helium/MCGenReco/ptGen_INEL_Prim_antiHe"), pt);
           if (enableCentrality)
-            histoGen.fill(HIST("helium/MCGenReco/ptGenVsMult_INEL_Prim_antiHe"), pt, mcCollision.centFT0M());
+            fillCost.fill(histoGen, HIST("helium/MCGenReco/ptGenVsMult_INEL_Prim_antiHe"), pt, mcCollision.centFT0M());
         }
 
         if (atLeastOneINELgt0) {
           if (pdg > 0) {
-            histoGen.fill(HIST("helium/MCGenReco/ptGen_INELgt0_Prim_He"), pt);
+            fillCost.fill(histoGen, HIST("helium/MCGenReco/ptGen_INELgt0_Prim_He"), pt);
             if (enableCentrality)
-              histoGen.fill(HIST("helium/MCGenReco/ptGenVsMult_INELgt0_Prim_He"), pt, mcCollision.centFT0M());
+              fillCost.fill(histoGen, HIST("helium/MCGenReco/ptGenVsMult_INELgt0_Prim_He"), pt, mcCollision.centFT0M());
           } else {
-            histoGen.fill(HIST("helium/MCGenReco/ptGen_INELgt0_Prim_antiHe"), pt);
+            fillCost.fill(histoGen, HIST("helium/MCGenReco/ptGen_INELgt0_Prim_antiHe"), pt);
             if (enableCentrality)
-              histoGen.fill(HIST("helium/MCGenReco/ptGenVsMult_INELgt0_Prim_antiHe"), pt, mcCollision.centFT0M());
+              fillCost.fill(histoGen, HIST("helium/MCGenReco/ptGenVsMult_INELgt0_Prim_antiHe"), pt, mcCollision.centFT0M());
           }
         }
       }
@@ -250,6 +250,13 @@ struct tofSpectra {
     if (doprocessLfFullAl) {
       LOG(info) << "Enabling process function processLfFullAl";
     }
+    // Pi, Ka and Pr in one track loop
+    if (doprocessFullPiKaPr) {
+      LOG(info) << "Enabling process function processFullPiKaPr";
+    }
+    if (doprocessLfFullPiKaPr) {
+      LOG(info) << "Enabling process function processLfFullPiKaPr";
+    }
 
     LOG(info) << "\tKaonIsPvContrib=" << kaonIsPvContrib.value;
 
@@ -665,19 +672,19 @@ struct tofSpectra {
           break;
         case 2:
         case Np + 2:
-          if (doprocessFullPi == false && doprocessLfFullPi == false && doprocessDerived == false) {
+          if (doprocessFullPi == false && doprocessLfFullPi == false && doprocessFullPiKaPr == false && doprocessLfFullPiKaPr == false && doprocessDerived == false) {
             continue;
           }
           break;
         case 3:
         case Np + 3:
-          if (doprocessFullKa == false && doprocessLfFullKa == false && doprocessDerived == false) {
+          if (doprocessFullKa == false && doprocessLfFullKa == false && doprocessFullPiKaPr == false && doprocessLfFullPiKaPr == false && doprocessDerived == false) {
             continue;
           }
           break;
         case 4:
         case Np + 4:
-          if (doprocessFullPr == false && doprocessLfFullPr == false && doprocessDerived == false) {
+          if (doprocessFullPr == false && doprocessLfFullPr == false && doprocessFullPiKaPr == false && doprocessLfFullPiKaPr == false && doprocessDerived == false) {
             continue;
           }
           break;
@@ -897,8 +904,9 @@ struct tofSpectra {
   } // end of the process function
   PROCESS_SWITCH(tofSpectra, processBC, "Processor of BCs for the FT0 calibration", true);
 
-  template <bool fillFullInfo, PID::ID id, typename T, typename C>
-  void fillParticleHistos(const T& track, const C& collision)
+  // the multiplicity of the collision is computed once per collision by the caller, see getMultiplicity
+  template <bool fillFullInfo, PID::ID id, typename T>
+  void fillParticleHistos(const T& track, const float multiplicity)
   {
     if (std::abs(track.rapidity(PID::getMass(id))) > trkselOptions.cfgCutY) {
       return;
@@ -912,7 +920,6 @@ struct tofSpectra {
     const auto& nsigmaTPC = o2::aod::pidutils::tpcNSigma<id>(track);
 
     // const auto id = track.sign() > 0 ? id : id + Np;
-    const float multiplicity = getMultiplicity(collision);
     if (multiplicityEstimator == MultCodes::kNoMultiplicity) {
       if (track.sign() > 0) {
         histos.fill(HIST(hnsigmatpc[id]), track.pt(), nsigmaTPC);
@@ -1770,13 +1777,14 @@ struct tofSpectra {
         return;
       }
       const auto& tracksInCollision = tracks.sliceByCached(aod::spectra::collisionId, collision.globalIndex(), cacheTrk);
+      const float multiplicity = getMultiplicity(collision);
       for (const auto& track : tracksInCollision) {
         if (!isTrackSelected<true>(track, collision)) {
           continue;
         }
-        fillParticleHistos<false, PID::Pion>(track, collision);
-        fillParticleHistos<false, PID::Kaon>(track, collision);
-        fillParticleHistos<false, PID::Proton>(track, collision);
+        fillParticleHistos<false, PID::Pion>(track, multiplicity);
+        fillParticleHistos<false, PID::Kaon>(track, multiplicity);
+        fillParticleHistos<false, PID::Proton>(track, multiplicity);
       }
     }
   } // end of the process function
@@ -1791,15 +1799,43 @@ struct tofSpectra {
     if (!isEventSelected<false, false>(collision)) {                                           \
       return;                                                                                  \
     }                                                                                          \
+    const float multiplicity = getMultiplicity(collision);                                     \
     for (const auto& track : tracks) {                                                         \
       if (!isTrackSelected<false>(track, collision)) {                                         \
         continue;                                                                              \
       }                                                                                        \
-      fillParticleHistos<isFull, PID::particleId>(track, collision);                           \
+      fillParticleHistos<isFull, PID::particleId>(track, multiplicity);                        \
     }                                                                                          \
   }                                                                                            \
   PROCESS_SWITCH(tofSpectra, process##processorName##inputPid, Form("Process for the %s hypothesis from %s tables", #particleId, #processorName), false);
 
+// Pions, kaons and protons in a single loop over the tracks: the event and track selections and the multiplicity are
+// evaluated once per track instead of once per species, to be used instead of the three single species processors
+#define MAKE_PROCESS_FUNCTION_PIKAPR(processorName, tofTable, tpcTable)                                                                \
+  void process##processorName##PiKaPr(CollisionCandidates::iterator const& collision,                                                  \
+                                      soa::Join<TrackCandidates,                                                                       \
+                                                aod::pid##tofTable##Pi, aod::pid##tofTable##Ka, aod::pid##tofTable##Pr,                \
+                                                aod::pid##tpcTable##Pi, aod::pid##tpcTable##Ka, aod::pid##tpcTable##Pr> const& tracks) \
+  {                                                                                                                                    \
+    if (!isEventSelected<false, false>(collision)) {                                                                                   \
+      return;                                                                                                                          \
+    }                                                                                                                                  \
+    const float multiplicity = getMultiplicity(collision);                                                                             \
+    for (const auto& track : tracks) {                                                                                                 \
+      if (!isTrackSelected<false>(track, collision)) {                                                                                 \
+        continue;                                                                                                                      \
+      }                                                                                                                                \
+      fillParticleHistos<true, PID::Pion>(track, multiplicity);                                                                        \
+      fillParticleHistos<true, PID::Kaon>(track, multiplicity);                                                                        \
+      fillParticleHistos<true, PID::Proton>(track, multiplicity);                                                                      \
+    }                                                                                                                                  \
+  }                                                                                                                                    \
+  PROCESS_SWITCH(tofSpectra, process##processorName##PiKaPr, Form("Process for the Pion, Kaon and Proton hypotheses in one track loop from %s tables", #processorName), false);
+
+  MAKE_PROCESS_FUNCTION_PIKAPR(Full, TOFFull, TPCFull);
+  MAKE_PROCESS_FUNCTION_PIKAPR(LfFull, TOFFull, TPCLfFull);
+#undef MAKE_PROCESS_FUNCTION_PIKAPR
+
 // Full tables
 #define MAKE_PROCESS_FUNCTION_FULL(inputPid, particleId) MAKE_PROCESS_FUNCTION(Full, inputPid, particleId, true, TOFFull, TPCFull)
 
@@ -1914,15 +1950,15 @@ struct tofSpectra {
         return true;
       }
     } else if constexpr (id == PID::Pion || id == Np + PID::Pion) {
-      if (doprocessFullPi == true || doprocessLfFullPi == true) {
+      if (doprocessFullPi == true || doprocessLfFullPi == true || doprocessFullPiKaPr == true || doprocessLfFullPiKaPr == true) {
         return true;
       }
     } else if constexpr (id == PID::Kaon || id == Np + PID::Kaon) {
-      if (doprocessFullKa == true || doprocessLfFullKa == true) {
+      if (doprocessFullKa == true || doprocessLfFullKa == true || doprocessFullPiKaPr == true || doprocessLfFullPiKaPr == true) {
         return true;
       }
     } else if constexpr (id == PID::Proton || id == Np + PID::Proton) {
-      if (doprocessFullPr == true || doprocessLfFullPr == true) {
+      if (doprocessFullPr == true || doprocessLfFullPr == true || doprocessFullPiKaPr == true || doprocessLfFullPiKaPr == true) {
         return true;
       }
     } else if constexpr (id == PID::Deuteron || id == Np + PID::Deuteron) {
@@ -256,7 +256,7 @@ struct v0assoqa {
     if (!initCCDB(bcs, collisions))
       return;
 
-    std::vector<o2::pwglf::V0group> v0tableGrouped = o2::pwglf::groupDuplicates(V0s);
+    o2::pwglf::V0groupTable v0tableGrouped = o2::pwglf::groupDuplicates(V0s);
 
     // determine map of McCollisions -> Collisions
     std::vector<std::vector<int>> mcCollToColl(mcCollisions.size());
@@ -66,6 +66,7 @@
 
 #include <Rtypes.h>
 
+#include <array>
 #include <cmath>
 #include <cstddef>
 #include <cstdint>
@@ -391,6 +392,7 @@ struct HStrangeCorrelation {
 
   static constexpr float MinRadiusTPC = 0.8;
   static constexpr float MaxRadiusTPC = 2.5;
+  static constexpr int NRadiiDeltaPhiStar = 34; // radii sampled between MinRadiusTPC and MaxRadiusTPC, in steps of 5 cm
 
   static constexpr float Neutral = 0.0;
 
@@ -711,20 +713,29 @@ struct HStrangeCorrelation {
       return false;
     return true;
   }
-  double calculateAverageDeltaPhiStar(double* trigg, double* assoc, double B)
+  // phi of a track and its bending asin(-0.3 B q r / 2 pT) at the sampled radii, computed once per track
+  struct DeltaPhiStarTrack {
+    double phi = 0;
+    std::array<double, NRadiiDeltaPhiStar> bending{};
+  };
+  DeltaPhiStarTrack computeDeltaPhiStarTrack(double phi, double pt, double sign, double B)
+  {
+    DeltaPhiStarTrack track;
+    track.phi = phi;
+    double phase = (-0.3 * B * sign) / (2 * pt);
+    int iRadius = 0;
+    for (double r = MinRadiusTPC; r <= MaxRadiusTPC && iRadius < NRadiiDeltaPhiStar; r += 0.05) {
+      track.bending[iRadius++] = std::asin(phase * r);
+    }
+    return track;
+  }
+  double calculateAverageDeltaPhiStar(DeltaPhiStarTrack const& trigg, DeltaPhiStarTrack const& assoc)
   {
-    double dPhiStar = 0;
     double dPhiStarMean = 0;
-
-    double dPhi = assoc[0] - trigg[0];
-    double phaseProton = (-0.3 * B * assoc[2]) / (2 * assoc[1]);
-    double phaseTrack = (-0.3 * B * trigg[2]) / (2 * trigg[1]);
-
-    for (double r = MinRadiusTPC; r <= MaxRadiusTPC; r += 0.05) {
-      dPhiStar = dPhi + std::asin(phaseProton * r) - std::asin(phaseTrack * r);
-      dPhiStarMean += (dPhiStar / 34);
+    double dPhi = assoc.phi - trigg.phi;
+    for (int iRadius = 0; iRadius < NRadiiDeltaPhiStar; iRadius++) {
+      dPhiStarMean += ((dPhi + assoc.bending[iRadius] - trigg.bending[iRadius]) / NRadiiDeltaPhiStar);
     }
-
     return dPhiStarMean;
   }
   void fillTriggerHistogram(std::shared_ptr<TH2> hist, double pt, double mult, float eff, float effUncert, float purity, float purityErr)
@@ -803,7 +814,10 @@ struct HStrangeCorrelation {
       }
 
       double triggSign = trigg.sign();
-      double triggForDeltaPhiStar[] = {trigg.phi(), trigg.pt(), triggSign};
+      DeltaPhiStarTrack triggForDeltaPhiStar;
+      if (doDeltaPhiStarCheck && !mixing) {
+        triggForDeltaPhiStar = computeDeltaPhiStarTrack(trigg.phi(), trigg.pt(), triggSign, bField);
+      }
 
       if (mixingInBf) {
         currentCollision.addValidParticle(trigg.eta(), trigg.phi(), trigg.pt(), -1, efficiencyTrigg, efficiencyTriggError, -1);
@@ -896,8 +910,12 @@ struct HStrangeCorrelation {
           ptProton = negtrack.pt();
           signProton = negtrack.sign();
         }
-        double assocForDeltaPhiStar[] = {phiProton, ptProton, signProton};
-        double assocForDeltaPhiStarPion[] = {phiPion, ptPion, -1};
+        DeltaPhiStarTrack assocForDeltaPhiStar;
+        DeltaPhiStarTrack assocForDeltaPhiStarPion;
+        if (doDeltaPhiStarCheck && !mixing) {
+          assocForDeltaPhiStar = computeDeltaPhiStarTrack(phiProton, ptProton, signProton, bField);
+          assocForDeltaPhiStarPion = computeDeltaPhiStarTrack(phiPion, ptPion, -1, bField);
+        }
 
         static_for<0, 2>([&](auto i) {
           constexpr int Index = i.value;
@@ -931,8 +949,8 @@ struct HStrangeCorrelation {
             if (assocCandidate.compatible(Index, trackSelection.dEdxCompatibility) && (!masterConfigurations.doMCassociation || assocCandidate.mcTrue(Index)) && (!doAssocPhysicalPrimary || assocCandidate.mcPhysicalPrimary()) && !mixing && -massWindowConfigurations.maxBgNSigma < assocCandidate.invMassNSigma(Index) && assocCandidate.invMassNSigma(Index) < -massWindowConfigurations.minBgNSigma && !masterConfigurations.fillCorrelationHistWithMass) {
               fillCorrelationHistogram(histos.get<THn>(HIST("sameEvent/LeftBg/") + HIST(V0names[Index])), binFillThn, etaWeight, efficiency * efficiencyTrigg, totalEffUncert, purityTrigg, purityTriggErr);
               if (doDeltaPhiStarCheck) {
-                double deltaPhiStar = calculateAverageDeltaPhiStar(triggForDeltaPhiStar, assocForDeltaPhiStar, bField);
-                double deltaPhiStarPion = calculateAverageDeltaPhiStar(triggForDeltaPhiStar, assocForDeltaPhiStarPion, bField);
+                double deltaPhiStar = calculateAverageDeltaPhiStar(triggForDeltaPhiStar, assocForDeltaPhiStar);
+                double deltaPhiStarPion = calculateAverageDeltaPhiStar(triggForDeltaPhiStar, assocForDeltaPhiStarPion);
                 if ((Index == IndexK0 && triggSign > Neutral) || (Index == IndexLambda && triggSign > Neutral) || (Index == IndexAntiLambda && triggSign < Neutral)) {
                   histos.fill(HIST("sameEvent/LeftBg/") + HIST(V0names[Index]) + HIST("DeltaPhiStar"), deltaPhiStar, trigg.eta() - etaProton, 0.5);
                   if (Index == IndexK0) {
@@ -972,8 +990,8 @@ struct HStrangeCorrelation {
                 histos.fill(HIST("hITSClusters") + HIST(V0names[Index]) + HIST("PositiveDaughterTransverse"), ptassoc, postrack.itsNCls(), assoc.v0radius());
               }
               if (doDeltaPhiStarCheck) {
-                double deltaPhiStar = calculateAverageDeltaPhiStar(triggForDeltaPhiStar, assocForDeltaPhiStar, bField);
-                double deltaPhiStarPion = calculateAverageDeltaPhiStar(triggForDeltaPhiStar, assocForDeltaPhiStarPion, bField);
+                double deltaPhiStar = calculateAverageDeltaPhiStar(triggForDeltaPhiStar, assocForDeltaPhiStar);
+                double deltaPhiStarPion = calculateAverageDeltaPhiStar(triggForDeltaPhiStar, assocForDeltaPhiStarPion);
                 if ((Index == IndexK0 && triggSign > Neutral) || (Index == IndexLambda && triggSign > Neutral) || (Index == IndexAntiLambda && triggSign < Neutral)) {
                   histos.fill(HIST("sameEvent/Signal/") + HIST(V0names[Index]) + HIST("DeltaPhiStar"), deltaPhiStar, trigg.eta() - etaProton, 0.5);
                   if (Index == IndexK0) {
@@ -990,8 +1008,8 @@ struct HStrangeCorrelation {
             if (assocCandidate.compatible(Index, trackSelection.dEdxCompatibility) && (!masterConfigurations.doMCassociation || assocCandidate.mcTrue(Index)) && (!doAssocPhysicalPrimary || assocCandidate.mcPhysicalPrimary()) && !mixing && +massWindowConfigurations.minBgNSigma < assocCandidate.invMassNSigma(Index) && assocCandidate.invMassNSigma(Index) < +massWindowConfigurations.maxBgNSigma && !masterConfigurations.fillCorrelationHistWithMass) {
               fillCorrelationHistogram(histos.get<THn>(HIST("sameEvent/RightBg/") + HIST(V0names[Index])), binFillThn, etaWeight, efficiency * efficiencyTrigg, totalEffUncert, purityTrigg, purityTriggErr);
               if (doDeltaPhiStarCheck) {
-                double deltaPhiStar = calculateAverageDeltaPhiStar(triggForDeltaPhiStar, assocForDeltaPhiStar, bField);
-                double deltaPhiStarPion = calculateAverageDeltaPhiStar(triggForDeltaPhiStar, assocForDeltaPhiStarPion, bField);
+                double deltaPhiStar = calculateAverageDeltaPhiStar(triggForDeltaPhiStar, assocForDeltaPhiStar);
+                double deltaPhiStarPion = calculateAverageDeltaPhiStar(triggForDeltaPhiStar, assocForDeltaPhiStarPion);
                 if ((Index == IndexK0 && triggSign > Neutral) || (Index == IndexLambda && triggSign > Neutral) || (Index == IndexAntiLambda && triggSign < Neutral)) {
                   histos.fill(HIST("sameEvent/RightBg/") + HIST(V0names[Index]) + HIST("DeltaPhiStar"), deltaPhiStar, trigg.eta() - etaProton, 0.5);
                   if (Index == IndexK0) {
@@ -1152,7 +1170,10 @@ struct HStrangeCorrelation {
         fillTriggerHistogram(histos.get<TH2>(HIST("sameEvent/TriggerParticlesCascade")), trigg.pt(), mult, efficiencyTrigg, efficiencyTriggError, purityTrigg, purityTriggErr);
       }
       double triggSign = trigg.sign();
-      double triggForDeltaPhiStar[] = {trigg.phi(), trigg.pt(), triggSign};
+      DeltaPhiStarTrack triggForDeltaPhiStar;
+      if (doDeltaPhiStarCheck && !mixing) {
+        triggForDeltaPhiStar = computeDeltaPhiStarTrack(trigg.phi(), trigg.pt(), triggSign, bField);
+      }
 
       if (mixingInBf) {
         currentCollision.addValidParticle(trigg.eta(), trigg.phi(), trigg.pt(), -1, efficiencyTrigg, efficiencyTriggError, -1);
@@ -1207,7 +1228,10 @@ struct HStrangeCorrelation {
           ptProton = negtrack.pt();
           signProton = negtrack.sign();
         }
-        double assocForDeltaPhiStar[] = {phiProton, ptProton, signProton};
+        DeltaPhiStarTrack assocForDeltaPhiStar;
+        if (doDeltaPhiStarCheck && !mixing) {
+          assocForDeltaPhiStar = computeDeltaPhiStarTrack(phiProton, ptProton, signProton, bField);
+        }
         //---] track quality check [---
         if (postrack.tpcNClsCrossedRows() < trackSelection.minTPCNCrossedRowsAssociated || negtrack.tpcNClsCrossedRows() < trackSelection.minTPCNCrossedRowsAssociated || bachtrack.tpcNClsCrossedRows() < trackSelection.minTPCNCrossedRowsAssociated)
           continue;
@@ -1290,7 +1314,7 @@ struct HStrangeCorrelation {
             if (assocCandidate.compatible(Index, trackSelection.dEdxCompatibility) && (!masterConfigurations.doMCassociation || assocCandidate.mcTrue(Index)) && (!doAssocPhysicalPrimary || assocCandidate.mcPhysicalPrimary()) && !mixing && -massWindowConfigurations.maxBgNSigma < assocCandidate.invMassNSigma(Index) && assocCandidate.invMassNSigma(Index) < -massWindowConfigurations.minBgNSigma) {
               fillCorrelationHistogram(histos.get<THn>(HIST("sameEvent/LeftBg/") + HIST(Cascadenames[Index])), binFillThn, etaWeight, efficiency * efficiencyTrigg, totalEffUncert, purityTrigg, purityTriggErr);
               if (doDeltaPhiStarCheck) {
-                double deltaPhiStar = calculateAverageDeltaPhiStar(triggForDeltaPhiStar, assocForDeltaPhiStar, bField);
+                double deltaPhiStar = calculateAverageDeltaPhiStar(triggForDeltaPhiStar, assocForDeltaPhiStar);
                 if ((Index == IndexXiMinus && triggSign > Neutral) || (Index == IndexXiPlus && triggSign < Neutral) || (Index == IndexOmegaMinus && triggSign > Neutral) || (Index == IndexOmegaPlus && triggSign < 0))
                   histos.fill(HIST("sameEvent/LeftBg/") + HIST(Cascadenames[Index]) + HIST("DeltaPhiStar"), deltaPhiStar, trigg.eta() - etaProton, 0.5);
                 else
@@ -1300,7 +1324,7 @@ struct HStrangeCorrelation {
             if (assocCandidate.compatible(Index, trackSelection.dEdxCompatibility) && (!masterConfigurations.doMCassociation || assocCandidate.mcTrue(Index)) && (!doAssocPhysicalPrimary || assocCandidate.mcPhysicalPrimary()) && !mixing && -massWindowConfigurations.maxPeakNSigma < assocCandidate.invMassNSigma(Index) && assocCandidate.invMassNSigma(Index) < +massWindowConfigurations.maxPeakNSigma) {
               fillCorrelationHistogram(histos.get<THn>(HIST("sameEvent/Signal/") + HIST(Cascadenames[Index])), binFillThn, etaWeight, efficiency * efficiencyTrigg, totalEffUncert, purityTrigg, purityTriggErr);
               if (doDeltaPhiStarCheck) {
-                double deltaPhiStar = calculateAverageDeltaPhiStar(triggForDeltaPhiStar, assocForDeltaPhiStar, bField);
+                double deltaPhiStar = calculateAverageDeltaPhiStar(triggForDeltaPhiStar, assocForDeltaPhiStar);
                 if ((Index == IndexXiMinus && triggSign > Neutral) || (Index == IndexXiPlus && triggSign < Neutral) || (Index == IndexOmegaMinus && triggSign > Neutral) || (Index == IndexOmegaPlus && triggSign < 0))
                   histos.fill(HIST("sameEvent/Signal/") + HIST(Cascadenames[Index]) + HIST("DeltaPhiStar"), deltaPhiStar, trigg.eta() - etaProton, 0.5);
                 else
@@ -1310,7 +1334,7 @@ struct HStrangeCorrelation {
             if (assocCandidate.compatible(Index, trackSelection.dEdxCompatibility) && (!masterConfigurations.doMCassociation || assocCandidate.mcTrue(Index)) && (!doAssocPhysicalPrimary || assocCandidate.mcPhysicalPrimary()) && !mixing && +massWindowConfigurations.minBgNSigma < assocCandidate.invMassNSigma(Index) && assocCandidate.invMassNSigma(Index) < +massWindowConfigurations.maxBgNSigma) {
               fillCorrelationHistogram(histos.get<THn>(HIST("sameEvent/RightBg/") + HIST(Cascadenames[Index])), binFillThn, etaWeight, efficiency * efficiencyTrigg, totalEffUncert, purityTrigg, purityTriggErr);
               if (doDeltaPhiStarCheck) {
-                double deltaPhiStar = calculateAverageDeltaPhiStar(triggForDeltaPhiStar, assocForDeltaPhiStar, bField);
+                double deltaPhiStar = calculateAverageDeltaPhiStar(triggForDeltaPhiStar, assocForDeltaPhiStar);
                 if ((Index == IndexXiMinus && triggSign > Neutral) || (Index == IndexXiPlus && triggSign < Neutral) || (Index == IndexOmegaMinus && triggSign > Neutral) || (Index == IndexOmegaPlus && triggSign < 0))
                   histos.fill(HIST("sameEvent/RightBg/") + HIST(Cascadenames[Index]) + HIST("DeltaPhiStar"), deltaPhiStar, trigg.eta() - etaProton, 0.5);
                 else
@@ -1443,7 +1467,10 @@ struct HStrangeCorrelation {
           fillTriggerHistogram(histos.get<TH2>(HIST("sameEvent/TriggerParticlesHadron")), trigg.pt(), mult, efficiencyTrigger, efficiencyTriggerError, purityTrigger, purityTriggerError);
       }
       double triggSign = trigg.sign();
-      double triggForDeltaPhiStar[] = {trigg.phi(), trigg.pt(), triggSign};
+      DeltaPhiStarTrack triggForDeltaPhiStar;
+      if (doDeltaPhiStarCheck && !mixing) {
+        triggForDeltaPhiStar = computeDeltaPhiStarTrack(trigg.phi(), trigg.pt(), triggSign, bField);
+      }
       for (auto const& assocTrack : assocs) {
         auto assoc = assocTrack.template track_as<TracksComplete>();
 
@@ -1469,7 +1496,6 @@ struct HStrangeCorrelation {
         float pttrigger = trigg.pt();
 
         double assocSign = assoc.sign();
-        double assocForDeltaPhiStar[] = {assoc.phi(), assoc.pt(), assocSign};
 
         float etaWeight = 1.;
         if (checks.doOnTheFlyFlattening) {
@@ -1533,7 +1559,10 @@ struct HStrangeCorrelation {
           deltaeta = std::abs(deltaeta);
         }
         double binFillThn[6] = {deltaphi, deltaeta, ptassoc, pttrigger, pvz, mult};
-        double deltaPhiStar = calculateAverageDeltaPhiStar(triggForDeltaPhiStar, assocForDeltaPhiStar, bField);
+        double deltaPhiStar = 0;
+        if (doDeltaPhiStarCheck && !mixing) {
+          deltaPhiStar = calculateAverageDeltaPhiStar(triggForDeltaPhiStar, computeDeltaPhiStarTrack(assoc.phi(), assoc.pt(), assocSign, bField));
+        }
         if (!mixing) {
           if constexpr (requires { assocTrack.nSigmaTPCPi(); }) {
             fillCorrelationHistogram(histos.get<THn>(HIST("sameEvent/Signal/Pion")), binFillThn, etaWeight, efficiency * efficiencyTrigger, totalEffUncert, purity * purityTrigger, totalPurityUncert);
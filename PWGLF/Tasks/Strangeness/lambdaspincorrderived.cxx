@@ -1080,6 +1080,25 @@ struct lambdaspincorrderived {
   ROOT::Math::PtEtaPhiMVector lambda, proton;
   ROOT::Math::PtEtaPhiMVector lambda2, proton2;
 
+  // selected candidate of the collision, selected and with its four-momenta built once for the same-event pairing
+  struct LambdaCandidate {
+    int status;
+    int protonIndex;
+    int pionIndex;
+    float phi;
+    ROOT::Math::PtEtaPhiMVector lambda;
+    ROOT::Math::PtEtaPhiMVector proton;
+  };
+  std::vector<LambdaCandidate> selectedCandidates;
+
+  static inline bool hasSharedDaughters(const LambdaCandidate& a, const LambdaCandidate& b)
+  {
+    return (a.protonIndex == b.protonIndex) ||
+           (a.pionIndex == b.pionIndex) ||
+           (a.protonIndex == b.pionIndex) ||
+           (a.pionIndex == b.protonIndex);
+  }
+
   Filter centralityFilter = (nabs(aod::lambdaevent::cent) < centMax && nabs(aod::lambdaevent::cent) > centMin);
 
   using EventCandidates = soa::Filtered<aod::LambdaEvents>;
@@ -1088,6 +1107,7 @@ struct lambdaspincorrderived {
   void processData(EventCandidates::iterator const& collision, AllTrackCandidates const& V0s)
   {
     auto centrality = collision.cent();
+    selectedCandidates.clear();
     for (const auto& v0 : V0s) {
       if (!selectionV0(v0)) {
         continue;
@@ -1111,32 +1131,30 @@ struct lambdaspincorrderived {
       } else {
         histos.fill(HIST("hEtaPhiAntiLambdaRaw"), phi, eta, getNUAWeight(1, v0.lambdaPhi(), v0.lambdaEta()));
       }
-      for (const auto& v02 : V0s) {
-        if (v02.index() <= v0.index()) {
-          continue;
-        }
-        if (!selectionV0(v02)) {
-          continue;
-        }
-        if (hasSharedDaughters(v0, v02))
+      selectedCandidates.push_back({v0.v0Status(), v0.protonIndex(), v0.pionIndex(), v0.lambdaPhi(), lambda, proton});
+    }
+
+    for (size_t i = 0; i < selectedCandidates.size(); ++i) {
+      const auto& cand1 = selectedCandidates[i];
+      for (size_t j = i + 1; j < selectedCandidates.size(); ++j) {
+        const auto& cand2 = selectedCandidates[j];
+        if (hasSharedDaughters(cand1, cand2))
           continue;
-        proton2 = ROOT::Math::PtEtaPhiMVector(v02.protonPt(), v02.protonEta(), v02.protonPhi(), o2::constants::physics::MassProton);
-        lambda2 = ROOT::Math::PtEtaPhiMVector(v02.lambdaPt(), v02.lambdaEta(), v02.lambdaPhi(), v02.lambdaMass());
-        if ((v0.v0Status() == 0 && v02.v0Status() == 1) || (v0.v0Status() == 1 && v02.v0Status() == 0))
+        if ((cand1.status == 0 && cand2.status == 1) || (cand1.status == 1 && cand2.status == 0))
           if (fillBasicQAHistos)
-            histos.fill(HIST("deltaPhiSame"), RecoDecay::constrainAngle(v0.lambdaPhi() - v02.lambdaPhi(), -TMath::Pi(), harmonicDphi));
-        // const int ptype = pairTypeCode(v0.v0Status(), v02.v0Status());
-        if (v0.v0Status() == 0 && v02.v0Status() == 0) {
-          fillHistograms(0, 0, lambda, lambda2, proton, proton2, 0, 1.0);
+            histos.fill(HIST("deltaPhiSame"), RecoDecay::constrainAngle(cand1.phi - cand2.phi, -TMath::Pi(), harmonicDphi));
+        // const int ptype = pairTypeCode(cand1.status, cand2.status);
+        if (cand1.status == 0 && cand2.status == 0) {
+          fillHistograms(0, 0, cand1.lambda, cand2.lambda, cand1.proton, cand2.proton, 0, 1.0);
         }
-        if (v0.v0Status() == 0 && v02.v0Status() == 1) {
-          fillHistograms(0, 1, lambda, lambda2, proton, proton2, 0, 1.0);
+        if (cand1.status == 0 && cand2.status == 1) {
+          fillHistograms(0, 1, cand1.lambda, cand2.lambda, cand1.proton, cand2.proton, 0, 1.0);
         }
-        if (v0.v0Status() == 1 && v02.v0Status() == 0) {
-          fillHistograms(0, 1, lambda2, lambda, proton2, proton, 0, 1.0);
+        if (cand1.status == 1 && cand2.status == 0) {
+          fillHistograms(0, 1, cand2.lambda, cand1.lambda, cand2.proton, cand1.proton, 0, 1.0);
         }
-        if (v0.v0Status() == 1 && v02.v0Status() == 1) {
-          fillHistograms(1, 1, lambda, lambda2, proton, proton2, 0, 1.0);
+        if (cand1.status == 1 && cand2.status == 1) {
+          fillHistograms(1, 1, cand1.lambda, cand2.lambda, cand1.proton, cand2.proton, 0, 1.0);
         }
       }
     }
@@ -1722,6 +1740,7 @@ struct lambdaspincorrderived {
   void processMC(EventCandidatesMC::iterator const& collision, AllTrackCandidatesMC const& V0sMC)
   {
     const float centrality = mcacc::cent(collision);
+    selectedCandidates.clear();
 
     for (const auto& v0 : V0sMC) {
       if (!selectionV0MC(v0)) {
@@ -1746,36 +1765,31 @@ struct lambdaspincorrderived {
       } else {
         histos.fill(HIST("hEtaPhiAntiLambdaRaw"), lambda.Phi(), lambda.Eta(), getNUAWeight(1, lambda.Phi(), lambda.Eta()));
       }
+      selectedCandidates.push_back({mcacc::v0Status(v0), v0.protonIndexmc(), v0.pionIndexmc(), mcacc::lamPhi(v0), lambda, proton});
+    }
 
-      for (const auto& v02 : V0sMC) {
-        if (v02.index() <= v0.index()) {
-          continue;
-        }
-        if (!selectionV0MC(v02)) {
-          continue;
-        }
-        if (hasSharedDaughtersMC(v0, v02))
+    for (size_t i = 0; i < selectedCandidates.size(); ++i) {
+      const auto& cand1 = selectedCandidates[i];
+      for (size_t j = i + 1; j < selectedCandidates.size(); ++j) {
+        const auto& cand2 = selectedCandidates[j];
+        if (hasSharedDaughters(cand1, cand2))
           continue;
-        proton2 = ROOT::Math::PtEtaPhiMVector(mcacc::prPt(v02), mcacc::prEta(v02), mcacc::prPhi(v02),
-                                              o2::constants::physics::MassProton);
-        lambda2 = ROOT::Math::PtEtaPhiMVector(mcacc::lamPt(v02), mcacc::lamEta(v02), mcacc::lamPhi(v02),
-                                              mcacc::lamMass(v02));
 
         histos.fill(HIST("deltaPhiSame"),
-                    RecoDecay::constrainAngle(mcacc::lamPhi(v0) - mcacc::lamPhi(v02),
+                    RecoDecay::constrainAngle(cand1.phi - cand2.phi,
                                               -TMath::Pi(), harmonicDphi));
 
-        const int s1 = mcacc::v0Status(v0);
-        const int s2 = mcacc::v0Status(v02);
+        const int s1 = cand1.status;
+        const int s2 = cand2.status;
 
         if (s1 == 0 && s2 == 0) {
-          fillHistograms(0, 0, lambda, lambda2, proton, proton2, 0, 1.0f);
+          fillHistograms(0, 0, cand1.lambda, cand2.lambda, cand1.proton, cand2.proton, 0, 1.0f);
         } else if (s1 == 0 && s2 == 1) {
-          fillHistograms(0, 1, lambda, lambda2, proton, proton2, 0, 1.0f);
+          fillHistograms(0, 1, cand1.lambda, cand2.lambda, cand1.proton, cand2.proton, 0, 1.0f);
         } else if (s1 == 1 && s2 == 0) {
-          fillHistograms(0, 1, lambda2, lambda, proton2, proton, 0, 1.0f);
+          fillHistograms(0, 1, cand2.lambda, cand1.lambda, cand2.proton, cand1.proton, 0, 1.0f);
         } else if (s1 == 1 && s2 == 1) {
-          fillHistograms(1, 1, lambda, lambda2, proton, proton2, 0, 1.0f);
+          fillHistograms(1, 1, cand1.lambda, cand2.lambda, cand1.proton, cand2.proton, 0, 1.0f);
         }
       }
     }
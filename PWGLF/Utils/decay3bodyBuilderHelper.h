@@ -156,6 +156,7 @@ class decay3bodyBuilderHelper
     float maxPt;
     float minMass;
     float maxMass;
+    float massMarginAtIU = -1.f; // margin on the mass window for the prefilter with the momenta at IU, < 0: disabled
     float minCtau;
     float maxCtau;
     float minCosPA;
@@ -176,6 +177,89 @@ class decay3bodyBuilderHelper
     float maxDCAZ3Body;
   } svertexerselections;
 
+  //_______________________________________________________________________
+  // cheap selections on the daughter tracks, no propagation nor vertex fit involved.
+  // Applied at the beginning of buildDecay3BodyCandidate, can be used to prefilter the candidates
+  template <typename TTrack>
+  bool preselectDecay3BodyCandidate(TTrack const& trackProton,
+                                    TTrack const& trackPion,
+                                    TTrack const& trackDeuteron,
+                                    double tofNsigmaDeuteron,
+                                    bool useTPCforPion = false,
+                                    bool acceptTPCOnly = false,
+                                    bool askOnlyITSMatch = true)
+  {
+    // proton track quality
+    if (trackProton.tpcNClsFound() < decay3bodyselections.minTPCNClProton) {
+      return false;
+    }
+    // pion track quality
+    if (useTPCforPion) {
+      if (trackPion.tpcNClsFound() < decay3bodyselections.minTPCNClPion) {
+        return false;
+      }
+    }
+    // deuteron track quality
+    if (trackDeuteron.tpcNClsFound() < decay3bodyselections.minTPCNClDeuteron) {
+      return false;
+    }
+
+    // track eta
+    if (std::fabs(trackProton.eta()) > decay3bodyselections.maxEtaDaughters) {
+      return false;
+    }
+    if (std::fabs(trackPion.eta()) > decay3bodyselections.maxEtaDaughters) {
+      return false;
+    }
+    if (std::fabs(trackDeuteron.eta()) > decay3bodyselections.maxEtaDaughters) {
+      return false;
+    }
+
+    // TPC only
+    if (!acceptTPCOnly) {
+      if (askOnlyITSMatch) {
+        if (!trackProton.hasITS() || !trackPion.hasITS() || !trackDeuteron.hasITS()) {
+          return false;
+        }
+      } else {
+        bool isProtonTPCOnly = !trackProton.hasITS() && !trackProton.hasTOF() && !trackProton.hasTRD();
+        bool isPionTPCOnly = !trackPion.hasITS() && !trackPion.hasTOF() && !trackPion.hasTRD();
+        bool isDeuteronTPCOnly = !trackDeuteron.hasITS() && !trackDeuteron.hasTOF() && !trackDeuteron.hasTRD();
+        if (isProtonTPCOnly || isPionTPCOnly || isDeuteronTPCOnly) {
+          return false;
+        }
+      }
+    }
+
+    // daughter TPC PID
+    if (std::fabs(trackProton.tpcNSigmaPr()) > decay3bodyselections.maxTPCnSigma) {
+      return false;
+    }
+    if (useTPCforPion && std::fabs(trackPion.tpcNSigmaPi()) > decay3bodyselections.maxTPCnSigma) {
+      return false;
+    }
+    if (std::fabs(trackDeuteron.tpcNSigmaDe()) > decay3bodyselections.maxTPCnSigma) {
+      return false;
+    }
+
+    // deuteron TOF PID
+    if ((tofNsigmaDeuteron < decay3bodyselections.minTOFnSigmaDeuteron || tofNsigmaDeuteron > decay3bodyselections.maxTOFnSigmaDeuteron) && trackDeuteron.p() > decay3bodyselections.minPDeuteronUseTOF) {
+      return false;
+    }
+
+    // rough mass window with the momenta at IU
+    if (decay3bodyselections.massMarginAtIU >= 0.f) {
+      float massAtIU = RecoDecay::m(std::array{std::array{trackProton.px(), trackProton.py(), trackProton.pz()},
+                                               std::array{trackPion.px(), trackPion.py(), trackPion.pz()},
+                                               std::array{trackDeuteron.px(), trackDeuteron.py(), trackDeuteron.pz()}},
+                                    std::array{o2::constants::physics::MassProton, o2::constants::physics::MassPionCharged, o2::constants::physics::MassDeuteron});
+      if (massAtIU < decay3bodyselections.minMass - decay3bodyselections.massMarginAtIU || massAtIU > decay3bodyselections.maxMass + decay3bodyselections.massMarginAtIU) {
+        return false;
+      }
+    }
+    return true;
+  }
+
   //_______________________________________________________________________
   // build Decay3body from three tracks, including V0 building.
   template <typename TCollision, typename TTrack>
@@ -214,77 +298,10 @@ class decay3bodyBuilderHelper
 
     //_______________________________________________________________________
     // track selections
-    if (useSelections) {
-      // proton track quality
-      if (trackProton.tpcNClsFound() < decay3bodyselections.minTPCNClProton) {
-        decay3body = {};
-        return false;
-      }
-      // pion track quality
-      if (useTPCforPion) {
-        if (trackPion.tpcNClsFound() < decay3bodyselections.minTPCNClPion) {
-          decay3body = {};
-          return false;
-        }
-      }
-      // deuteron track quality
-      if (trackDeuteron.tpcNClsFound() < decay3bodyselections.minTPCNClDeuteron) {
-        decay3body = {};
-        return false;
-      }
-
-      // track eta
-      if (std::fabs(trackProton.eta()) > decay3bodyselections.maxEtaDaughters) {
-        decay3body = {};
-        return false;
-      }
-      if (std::fabs(trackPion.eta()) > decay3bodyselections.maxEtaDaughters) {
-        decay3body = {};
-        return false;
-      }
-      if (std::fabs(trackDeuteron.eta()) > decay3bodyselections.maxEtaDaughters) {
-        decay3body = {};
-        return false;
-      }
-
-      // TPC only
-      if (!acceptTPCOnly) {
-        if (askOnlyITSMatch) {
-          if (!trackProton.hasITS() || !trackPion.hasITS() || !trackDeuteron.hasITS()) {
-            decay3body = {};
-            return false;
-          }
-        } else {
-          bool isProtonTPCOnly = !trackProton.hasITS() && !trackProton.hasTOF() && !trackProton.hasTRD();
-          bool isPionTPCOnly = !trackPion.hasITS() && !trackPion.hasTOF() && !trackPion.hasTRD();
-          bool isDeuteronTPCOnly = !trackDeuteron.hasITS() && !trackDeuteron.hasTOF() && !trackDeuteron.hasTRD();
-          if (isProtonTPCOnly || isPionTPCOnly || isDeuteronTPCOnly) {
-            decay3body = {};
-            return false;
-          }
-        }
-      }
-
-      // daughter TPC PID
-      if (std::fabs(trackProton.tpcNSigmaPr()) > decay3bodyselections.maxTPCnSigma) {
-        decay3body = {};
-        return false;
-      }
-      if (useTPCforPion && std::fabs(trackPion.tpcNSigmaPi()) > decay3bodyselections.maxTPCnSigma) {
-        decay3body = {};
-        return false;
-      }
-      if (std::fabs(trackDeuteron.tpcNSigmaDe()) > decay3bodyselections.maxTPCnSigma) {
-        decay3body = {};
-        return false;
-      }
-
-      // deuteron TOF PID
-      if ((tofNsigmaDeuteron < decay3bodyselections.minTOFnSigmaDeuteron || tofNsigmaDeuteron > decay3bodyselections.maxTOFnSigmaDeuteron) && trackDeuteron.p() > decay3bodyselections.minPDeuteronUseTOF) {
-        decay3body = {};
-        return false;
-      }
-    } // end of selections
+    if (useSelections && !preselectDecay3BodyCandidate(trackProton, trackPion, trackDeuteron, tofNsigmaDeuteron, useTPCforPion, acceptTPCOnly, askOnlyITSMatch)) {
+      decay3body = {};
+      return false;
+    }
 
     //_______________________________________________________________________
     // daughter track DCA to PV associated with decay3body --> computed with KFParticle
@@ -38,6 +38,7 @@
 #include <cmath>
 #include <cstdint>
 #include <cstdlib>
+#include <span>
 #include <stdexcept>
 #include <vector>
 
@@ -47,35 +48,85 @@ namespace pwglf
 {
 //__________________________________________
 // V0 group: abstraction to deal with duplicates
-// in an intuitive manner
+// in an intuitive manner. This is a view on one
+// entry of a V0groupTable, valid as long as the table
 struct V0group {
-  std::vector<int> V0Ids;        // index list to original aod::V0s
-  std::vector<int> collisionIds; // coll indices
+  std::span<const int> V0Ids;        // index list to original aod::V0s
+  std::span<const int> collisionIds; // coll indices
   int posTrackId;
   int negTrackId;
   uint8_t v0Type;
 };
 
-//_______________________________________________________________________
-template <typename T>
-std::vector<std::size_t> sort_indices_posTrack(const std::vector<T>& v)
-{
-  std::vector<std::size_t> idx(v.size());
-  std::iota(idx.begin(), idx.end(), 0);
-  std::stable_sort(idx.begin(), idx.end(),
-                   [&v](std::size_t i1, std::size_t i2) { return v[i1].posTrackId < v[i2].posTrackId; });
-  return idx;
-}
+//__________________________________________
+// all groups of a data frame, stored in compressed rows:
+// group i owns entries [offsets[i], offsets[i + 1]) of the flat
+// V0Ids and collisionIds arrays. The buffers are kept when the
+// table is refilled, so reusing the same table avoids reallocations
+struct V0groupTable {
+  std::vector<int> offsets;      // nGroups + 1 entries
+  std::vector<int> V0Ids;        // index list to original aod::V0s, grouped
+  std::vector<int> collisionIds; // coll indices, grouped
+  std::vector<int> posTrackIds;  // per group
+  std::vector<int> negTrackIds;  // per group
+  std::vector<uint8_t> v0Types;  // per group, type of the last V0 in the group
+
+  // sorting scratch
+  std::vector<uint64_t> keys;
+  std::vector<uint64_t> keysBuffer;
+  std::vector<int> order;
+  std::vector<int> orderBuffer;
+
+  std::size_t size() const { return posTrackIds.size(); }
+  bool empty() const { return posTrackIds.empty(); }
+
+  V0group operator[](std::size_t iGroup) const
+  {
+    const std::size_t first = offsets[iGroup];
+    const std::size_t count = offsets[iGroup + 1] - offsets[iGroup];
+    return V0group{std::span<const int>(V0Ids.data() + first, count),
+                   std::span<const int>(collisionIds.data() + first, count),
+                   posTrackIds[iGroup], negTrackIds[iGroup], v0Types[iGroup]};
+  }
+};
 
 //_______________________________________________________________________
-template <typename T>
-std::vector<std::size_t> sort_indices_negTrack(const std::vector<T>& v)
+// stable LSD radix sort of the (key, index) pairs, one byte at a time.
+// Bytes which are the same for all keys (e.g. the high bytes of the
+// track indices) are skipped
+inline void radixSortKeys(std::vector<uint64_t>& keys, std::vector<int>& order,
+                          std::vector<uint64_t>& keysBuffer, std::vector<int>& orderBuffer)
 {
-  std::vector<std::size_t> idx(v.size());
-  std::iota(idx.begin(), idx.end(), 0);
-  std::stable_sort(idx.begin(), idx.end(),
-                   [&v](std::size_t i1, std::size_t i2) { return v[i1].negTrackId < v[i2].negTrackId; });
-  return idx;
+  constexpr int NBytes = 8;
+  constexpr int NBins = 256;
+  const std::size_t nKeys = keys.size();
+  std::array<std::array<std::size_t, NBins>, NBytes> counts{};
+  for (const auto key : keys) {
+    for (int iByte = 0; iByte < NBytes; iByte++) {
+      counts[iByte][(key >> (8 * iByte)) & 0xff]++;
+    }
+  }
+  keysBuffer.resize(nKeys);
+  orderBuffer.resize(nKeys);
+  for (int iByte = 0; iByte < NBytes; iByte++) {
+    auto& count = counts[iByte];
+    if (count[(keys[0] >> (8 * iByte)) & 0xff] == nKeys) {
+      continue; // all keys share this byte
+    }
+    std::size_t position = 0;
+    for (auto& bin : count) {
+      const std::size_t nInBin = bin;
+      bin = position;
+      position += nInBin;
+    }
+    for (std::size_t iKey = 0; iKey < nKeys; iKey++) {
+      const std::size_t target = count[(keys[iKey] >> (8 * iByte)) & 0xff]++;
+      keysBuffer[target] = keys[iKey];
+      orderBuffer[target] = order[iKey];
+    }
+    keys.swap(keysBuffer);
+    order.swap(orderBuffer);
+  }
 }
 
 //_______________________________________________________________________
@@ -84,62 +135,59 @@ std::vector<std::size_t> sort_indices_negTrack(const std::vector<T>& v)
 // of type pwglf::V0group, each entry having the same neg/pos tracks
 // but an array of compatible collisions. The original V0 indices
 // are preserved in the resulting structure to allow for easy referencing
-// back afterwards. Algorithmically, full N^2 loops and/or multiple
-// find calls are avoided via sorting.
+// back afterwards. Algorithmically, N^2 loops are avoided by a single
+// radix sort on the packed (posTrackId, negTrackId) key; groups are
+// ordered by that key and keep the original V0 order inside
 template <typename T>
-std::vector<V0group> groupDuplicates(const T& V0s)
+void groupDuplicates(const T& V0s, V0groupTable& v0tableGrouped)
 {
-  std::vector<V0group> v0table;
+  v0tableGrouped.offsets.clear();
+  v0tableGrouped.V0Ids.clear();
+  v0tableGrouped.collisionIds.clear();
+  v0tableGrouped.posTrackIds.clear();
+  v0tableGrouped.negTrackIds.clear();
+  v0tableGrouped.v0Types.clear();
+  v0tableGrouped.keys.clear();
+  v0tableGrouped.order.clear();
   if (V0s.size() == 0) {
-    return v0table;
+    return;
   }
-  V0group thisV0;
-  thisV0.V0Ids.push_back(-1);        // create one single element
-  thisV0.collisionIds.push_back(-1); // create one single element
+
+  auto& keys = v0tableGrouped.keys;
+  auto& order = v0tableGrouped.order;
+  keys.reserve(V0s.size());
+  order.reserve(V0s.size());
   for (auto const& V0 : V0s) {
-    thisV0.V0Ids[0] = V0.globalIndex();
-    thisV0.collisionIds[0] = V0.collisionId();
-    thisV0.posTrackId = V0.posTrackId();
-    thisV0.negTrackId = V0.negTrackId();
-    thisV0.v0Type = V0.v0Type();
-    v0table.push_back(thisV0);
+    keys.push_back((static_cast<uint64_t>(static_cast<uint32_t>(V0.posTrackId())) << 32) | static_cast<uint32_t>(V0.negTrackId()));
+    order.push_back(order.size());
   }
-
-  // sort tracks according to positive track index to avoid excessive N^2 searches
-  auto posTrackSort = sort_indices_posTrack(v0table);
-
-  // create a proper list of V0s including duplicates: collisionIds is now a vector
-  int atPosTrackId = v0table[posTrackSort[0]].posTrackId;
-  std::vector<V0group> v0tableFixedPositive; // small list with fixed positive id
-  std::vector<V0group> v0tableGrouped;       // final list with proper grouping
-  for (size_t iV0 = 0; iV0 < posTrackSort.size(); iV0++) {
-    if (atPosTrackId != v0table[posTrackSort[iV0]].posTrackId) {
-      // switched pos track id. Process chunk of V0s
-      auto negTrackSort = sort_indices_negTrack(v0tableFixedPositive);
-      thisV0.collisionIds.clear();
-      thisV0.V0Ids.clear();
-      thisV0.negTrackId = v0tableFixedPositive[negTrackSort[0]].negTrackId;
-      for (size_t iPV0 = 0; iPV0 < v0tableFixedPositive.size(); iPV0++) {
-        if (thisV0.negTrackId != v0tableFixedPositive[negTrackSort[iPV0]].negTrackId) {
-          v0tableGrouped.push_back(thisV0);
-          thisV0.collisionIds.clear(); // clean collision Ids
-          thisV0.V0Ids.clear();        // clean aod::V0s Ids
-        }
-        thisV0.V0Ids.push_back(v0tableFixedPositive[negTrackSort[iPV0]].V0Ids[0]);
-        thisV0.collisionIds.push_back(v0tableFixedPositive[negTrackSort[iPV0]].collisionIds[0]);
-        thisV0.posTrackId = v0tableFixedPositive[negTrackSort[iPV0]].posTrackId;
-        thisV0.negTrackId = v0tableFixedPositive[negTrackSort[iPV0]].negTrackId;
-        thisV0.v0Type = v0tableFixedPositive[negTrackSort[iPV0]].v0Type;
-      }
-      v0tableGrouped.push_back(thisV0); // publish last
-      v0tableFixedPositive.clear();
-      atPosTrackId = v0table[posTrackSort[iV0]].posTrackId; // move to the next pos index
-    }
-    v0tableFixedPositive.push_back(v0table[posTrackSort[iV0]]);
+  radixSortKeys(keys, order, v0tableGrouped.keysBuffer, v0tableGrouped.orderBuffer);
+
+  v0tableGrouped.V0Ids.reserve(keys.size());
+  v0tableGrouped.collisionIds.reserve(keys.size());
+  for (std::size_t iV0 = 0; iV0 < keys.size(); iV0++) {
+    auto const V0 = V0s.rawIteratorAt(order[iV0]);
+    if (iV0 == 0 || keys[iV0] != keys[iV0 - 1]) {
+      // new (p,n) pair, open a group
+      v0tableGrouped.offsets.push_back(v0tableGrouped.V0Ids.size());
+      v0tableGrouped.posTrackIds.push_back(V0.posTrackId());
+      v0tableGrouped.negTrackIds.push_back(V0.negTrackId());
+      v0tableGrouped.v0Types.push_back(V0.v0Type());
+    }
+    v0tableGrouped.V0Ids.push_back(V0.globalIndex());
+    v0tableGrouped.collisionIds.push_back(V0.collisionId());
+    v0tableGrouped.v0Types.back() = V0.v0Type();
   }
-  v0tableGrouped.push_back(thisV0); // publish last
+  v0tableGrouped.offsets.push_back(v0tableGrouped.V0Ids.size());
 
   LOGF(debug, "Duplicate V0s grouped. aod::V0s counted: %i, unique index pairs: %i", V0s.size(), v0tableGrouped.size());
+}
+
+template <typename T>
+V0groupTable groupDuplicates(const T& V0s)
+{
+  V0groupTable v0tableGrouped;
+  groupDuplicates(V0s, v0tableGrouped);
   return v0tableGrouped;
 }
 
@@ -181,6 +229,44 @@ struct v0candidate {
   float momentumCovariance[6];
 };
 
+//__________________________________________
+// compact copy of a V0, holding only what the cascade
+// fit from an already built V0 needs. Used to buffer
+// the V0s of cascades at a fraction of the memory
+struct v0candidateForCascade {
+  std::array<float, 3> positiveMomentum = {0.0f, 0.0f, 0.0f};
+  std::array<float, 3> negativeMomentum = {0.0f, 0.0f, 0.0f};
+  std::array<float, 3> position = {0.0f, 0.0f, 0.0f};
+  float positiveTrackX = 0.0f;
+  float negativeTrackX = 0.0f;
+  float positiveDCAxy = 0.0f;
+  float negativeDCAxy = 0.0f;
+  float daughterDCA = 1000.0f;
+  float massLambda = 0.0f;
+  float massAntiLambda = 0.0f;
+  std::array<float, 6> positionCovariance = {0.0f};
+  std::array<float, 6> momentumCovariance = {0.0f};
+
+  v0candidateForCascade() = default;
+  explicit v0candidateForCascade(v0candidate const& v0)
+    : positiveMomentum(v0.positiveMomentum),
+      negativeMomentum(v0.negativeMomentum),
+      position(v0.position),
+      positiveTrackX(v0.positiveTrackX),
+      negativeTrackX(v0.negativeTrackX),
+      positiveDCAxy(v0.positiveDCAxy),
+      negativeDCAxy(v0.negativeDCAxy),
+      daughterDCA(v0.daughterDCA),
+      massLambda(v0.massLambda),
+      massAntiLambda(v0.massAntiLambda)
+  {
+    for (int i = 0; i < 6; i++) {
+      positionCovariance[i] = v0.positionCovariance[i];
+      momentumCovariance[i] = v0.momentumCovariance[i];
+    }
+  }
+};
+
 //__________________________________________
 // Cascade information storage
 struct cascadeCandidate {
@@ -689,10 +775,12 @@ class strangenessBuilderHelper
   // Populates ::cascade object.
   // ::cascade will be initialized to defaults if build fails
   // cascade builder creating a cascade from plain tracks
-  template <typename TTrack>
+  // v0input: a v0candidate or its compact v0candidateForCascade copy
+  template <typename TV0, typename TTrack>
+    requires requires(TV0 const& v0) { v0.daughterDCA; v0.positionCovariance; }
   bool buildCascadeCandidate(int collisionIndex,
                              float pvX, float pvY, float pvZ,
-                             v0candidate const& v0input,
+                             TV0 const& v0input,
                              TTrack const& positiveTrack,
                              TTrack const& negativeTrack,
                              TTrack const& bachelorTrack,
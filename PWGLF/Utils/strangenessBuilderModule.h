@@ -319,6 +319,8 @@ struct coreConfigurables : o2::framework::ConfigurableGroup {
   // V0 buffer for V0s used in cascades: master switch
   // exchanges CPU (generate V0s again) with memory (save pre-generated V0s)
   o2::framework::Configurable<bool> useV0BufferForCascades{"useV0BufferForCascades", false, "store array of V0s for cascades or not. False (default): save RAM, use more CPU; true: save CPU, use more RAM"};
+  // store only the V0 quantities needed by the cascade fit (about a third of the full V0 candidate)
+  o2::framework::Configurable<bool> compactV0BufferForCascades{"compactV0BufferForCascades", false, "if useV0BufferForCascades: buffer only the V0 quantities used by the cascade fit, to reduce the memory footprint"};
 
   o2::framework::Configurable<int> mc_findableMode{"mc_findableMode", 0, "0: disabled; 1: add findable-but-not-found to existing V0s from AO2D; 2: reset V0s and generate only findable-but-not-found"};
 
@@ -545,11 +547,13 @@ class BuilderModule
 
   std::vector<v0Entry> v0List;
   std::vector<cascadeEntry> cascadeList;
+  o2::pwglf::V0groupTable v0tableGrouped; // (p,n) groups of duplicated V0s, buffers kept across data frames
   std::vector<std::size_t> sorted_v0;
   std::vector<std::size_t> sorted_cascade;
 
   // for tagging V0s used in cascades
   std::vector<o2::pwglf::v0candidate> v0sFromCascades; // Vector of v0 candidates used in cascades
+  std::vector<o2::pwglf::v0candidateForCascade> compactV0sFromCascades; // same, compact version
   std::vector<int> ao2dV0toV0List;                     // index to relate v0s -> v0List
   std::vector<int> v0Map;                              // index to relate v0List -> v0sFromCascades
 
@@ -917,7 +921,7 @@ class BuilderModule
         // handle duplicates explicitly: group V0s according to (p,n) indices
         // will provide a list of collisionIds (in V0group), allowing for
         // easy de-duplication when passing to the v0List
-        std::vector<o2::pwglf::V0group> v0tableGrouped = o2::pwglf::groupDuplicates(v0s);
+        o2::pwglf::groupDuplicates(v0s, v0tableGrouped);
         histos.fill(HIST("hDeduplicationStatistics"), 0.0, v0s.size());
         histos.fill(HIST("hDeduplicationStatistics"), 1.0, v0tableGrouped.size());
 
@@ -1356,6 +1360,7 @@ class BuilderModule
   {
     int v0sUsedInCascades = 0;
     v0sFromCascades.clear();
+    compactV0sFromCascades.clear();
     v0Map.clear();
     v0Map.resize(v0List.size(), -2); // marks not used
     if (baseOpts.useV0BufferForCascades.value == false) {
@@ -1568,8 +1573,13 @@ class BuilderModule
         }
       }
       if (v0Map[iv0] == -1 && baseOpts.useV0BufferForCascades) {
-        v0Map[iv0] = v0sFromCascades.size(); // provide actual valid index in buffer
-        v0sFromCascades.push_back(straHelper.v0);
+        if (baseOpts.compactV0BufferForCascades) {
+          v0Map[iv0] = compactV0sFromCascades.size(); // provide actual valid index in buffer
+          compactV0sFromCascades.emplace_back(straHelper.v0);
+        } else {
+          v0Map[iv0] = v0sFromCascades.size(); // provide actual valid index in buffer
+          v0sFromCascades.push_back(straHelper.v0);
+        }
       }
       // fill requested cursors only if type is not 0
       if (v0.v0Type == 1 || (v0.v0Type > 1 && v0BuilderOpts.generatePhotonCandidates)) {
@@ -1874,7 +1884,7 @@ class BuilderModule
       } // end V0MCCores filling in case of MC
     } // end constexpr requires mcParticles
 
-    LOGF(debug, "V0s in DF: %i, V0s built: %i, V0s built and buffered for cascades: %i.", v0s.size(), nV0s, v0sFromCascades.size());
+    LOGF(debug, "V0s in DF: %i, V0s built: %i, V0s built and buffered for cascades: %i.", v0s.size(), nV0s, v0sFromCascades.size() + compactV0sFromCascades.size());
   }
 
   //__________________________________________________
@@ -2069,14 +2079,19 @@ class BuilderModule
           continue; // didn't work out, skip
         }
 
-        if (!straHelper.buildCascadeCandidate(cascade.collisionId, pvX, pvY, pvZ,
-                                              v0sFromCascades[v0Map[cascade.v0Id]],
-                                              posTrack,
-                                              negTrack,
-                                              bachTrack,
-                                              baseOpts.mEnabledTables[kCascBBs],
-                                              cascadeBuilderOpts.useCascadeMomentumAtPrimVtx,
-                                              baseOpts.mEnabledTables[kCascCovs])) {
+        auto buildFromBuffer = [&](auto const& v0input) {
+          return straHelper.buildCascadeCandidate(cascade.collisionId, pvX, pvY, pvZ,
+                                                  v0input,
+                                                  posTrack,
+                                                  negTrack,
+                                                  bachTrack,
+                                                  baseOpts.mEnabledTables[kCascBBs],
+                                                  cascadeBuilderOpts.useCascadeMomentumAtPrimVtx,
+                                                  baseOpts.mEnabledTables[kCascCovs]);
+        };
+        bool built = baseOpts.compactV0BufferForCascades ? buildFromBuffer(compactV0sFromCascades[v0Map[cascade.v0Id]])
+                                                         : buildFromBuffer(v0sFromCascades[v0Map[cascade.v0Id]]);
+        if (!built) {
           products.cascdataLink(-1);
           interlinks.cascadeToCascCores.push_back(-1);
           continue; // didn't work out, skip
@@ -2686,6 +2701,11 @@ class BuilderModule
     if (!initCCDB(ccdb, bcs, collisions))
       return;
 
+    if (v0BuilderOpts.generatePhotonCandidates.value && v0BuilderOpts.moveTPCOnlyTracks.value) {
+      // TPC-only tracks of several photon candidates are moved once per collision
+      mVDriftMgr.cacheDataFrame<TBCs>(collisions);
+    }
+
     // reset vectors for cascade interlinks
     resetInterlinks();
 
@@ -21,10 +21,12 @@
 
 #include <Rtypes.h>
 
+#include <algorithm>
 #include <array>
 #include <cmath>
 #include <cstdint>
 #include <cstdlib>
+#include <span>
 #include <unordered_map>
 #include <utility>
 #include <vector>
@@ -32,6 +34,7 @@
 using CollBracket = o2::math_utils::Bracket<int>;
 
 constexpr uint64_t bOffsetMax = 241; // track compatibility can never go beyond 6 mus (ITS)
+constexpr uint64_t bcBucketWidth = bOffsetMax; // collisions compatible with a track lie in at most 3 consecutive buckets
 
 struct TrackCand {
   int Idxtr;
@@ -66,24 +69,40 @@ class svPoolCreator
     }
     tmap.clear();
     svCandPool.clear();
-    bc2Coll.clear();
+    collsByBC.clear();
+    bcBuckets.clear();
+    ambiTrackBC.clear();
+    ambiTrackBCFilled = false;
   }
 
   void setTimeMargin(float timeMargin) { timeMarginNS = timeMargin; }
   void setFitter(const o2::vertexing::DCAFitterN<2>& fitter) { this->fitter = fitter; }
   void setSkipAmbiTracks() { skipAmbiTracks = true; }
   o2::vertexing::DCAFitterN<2>* getFitter() { return &fitter; }
-  std::array<std::vector<TrackCand>, 4> getTrackCandPool() { return trackCandPool; }
+  const std::array<std::vector<TrackCand>, 4>& getTrackCandPool() const { return trackCandPool; }
+  std::span<const TrackCand> getTrackCandPool(int poolIndex) const { return trackCandPool[poolIndex]; }
 
+  /// builds the BC-bucketed index of the collisions, to be called once per data frame after clearPools()
   template <typename C, typename BC>
   void fillBC2Coll(const C& collisions, BC const&)
   {
+    collsByBC.reserve(collisions.size());
     for (unsigned i = 0; i < collisions.size(); i++) {
       auto collision = collisions.rawIteratorAt(i);
       if (!collision.has_bc()) {
         continue;
       }
-      bc2Coll[collision.template bc_as<BC>().globalBC()] = i;
+      collsByBC.emplace_back(collision.template bc_as<BC>().globalBC(), static_cast<int>(i));
+    }
+    // collisions come sorted in BC in the AO2Ds, then this is a no-op
+    if (!std::is_sorted(collsByBC.begin(), collsByBC.end())) {
+      std::sort(collsByBC.begin(), collsByBC.end());
+    }
+    for (unsigned i = 0; i < collsByBC.size(); i++) {
+      auto [it, isNew] = bcBuckets.try_emplace(collsByBC[i].first / bcBucketWidth, i, i + 1);
+      if (!isNew) {
+        it->second.second = i + 1;
+      }
     }
   }
 
@@ -102,64 +121,73 @@ class svPoolCreator
         globalBC = trackCand.template collision_as<C>().template bc_as<BC>().globalBC();
       }
     } else if (!skipAmbiTracks) {
-      for (const auto& ambTrack : ambiTracks) {
-        if (ambTrack.trackId() != trackCand.globalIndex()) {
-          continue;
-        }
-        if (!ambTrack.has_bc() || ambTrack.template bc_as<BC>().size() == 0) {
-          globalBC = BcInvalid;
-          break;
+      if (!ambiTrackBCFilled) {
+        // index the BC of the ambiguous tracks once per data frame instead of scanning them for every track
+        for (const auto& ambTrack : ambiTracks) {
+          if (ambTrack.trackId() < 0) {
+            continue;
+          }
+          if (static_cast<size_t>(ambTrack.trackId()) >= ambiTrackBC.size()) {
+            ambiTrackBC.resize(ambTrack.trackId() + 1, BcInvalid);
+          }
+          if (ambTrack.has_bc() && ambTrack.template bc_as<BC>().size() != 0) {
+            ambiTrackBC[ambTrack.trackId()] = ambTrack.template bc_as<BC>().begin().globalBC();
+          }
         }
-        globalBC = ambTrack.template bc_as<BC>().begin().globalBC();
-        break;
+        ambiTrackBCFilled = true;
+      }
+      if (static_cast<size_t>(trackCand.globalIndex()) < ambiTrackBC.size()) {
+        globalBC = ambiTrackBC[trackCand.globalIndex()];
       }
-    } else {
-      globalBC = BcInvalid;
     }
 
     if (globalBC == BcInvalid) {
       return;
     }
 
+    // the compatible collisions are in the buckets around the one of the track, contiguous in collsByBC
     uint64_t firstBC = globalBC < bOffsetMax ? 0 : globalBC - bOffsetMax;
     uint64_t lastBC = globalBC + bOffsetMax;
-    int firstCollIdx = -1;
-    while (firstBC < lastBC) {
-      if (bc2Coll.find(firstBC) != bc2Coll.end()) {
-        firstCollIdx = bc2Coll[firstBC];
-        break;
+    int firstEntry = -1;
+    int lastEntry = -1;
+    for (uint64_t bucket = firstBC / bcBucketWidth; bucket <= lastBC / bcBucketWidth; bucket++) {
+      const auto& range = bcBuckets.find(bucket);
+      if (range == bcBuckets.end()) {
+        continue;
+      }
+      if (firstEntry < 0) {
+        firstEntry = range->second.first;
       }
-      firstBC++;
+      lastEntry = range->second.second;
     }
-    if (firstCollIdx == -1) {
+    if (firstEntry < 0) {
       return;
     }
 
-    // now loop over all the collisions to make the pool
-    for (int collIdx = firstCollIdx; collIdx < collisions.size(); collIdx++) {
+    float trackTime{0.};
+    float trackTimeRes{0.};
+    if (trackCand.isPVContributor()) {
+      trackTime = trackCand.template collision_as<C>().collisionTime(); // if PV contributor, we assume the time to be the one of the collision
+      trackTimeRes = o2::constants::lhc::LHCBunchSpacingNS;             // 1 BC
+    } else {
+      trackTime = trackCand.trackTime();
+      trackTimeRes = trackCand.trackTimeRes();
+    }
+    const bool isTimeResRange = TESTBIT(trackCand.flags(), o2::aod::track::TrackTimeResIsRange);
+
+    // now loop over the candidate collisions to make the pool
+    for (int iEntry = firstEntry; iEntry < lastEntry; iEntry++) {
+      const auto [collBC, collIdx] = collsByBC[iEntry];
+      if (collBC < firstBC) {
+        continue;
+      }
+      if (collBC > lastBC) {
+        break;
+      }
       const auto& collision = collisions.rawIteratorAt(collIdx);
       float collTime = collision.collisionTime();
       float collTimeRes2 = collision.collisionTimeRes() * collision.collisionTimeRes();
-      uint64_t collBC = collision.template bc_as<BC>().globalBC();
-      // int collIdx = collision.globalIndex();
       int64_t bcOffset = globalBC - static_cast<int64_t>(collBC);
-      if (static_cast<uint64_t>(std::abs(bcOffset)) > bOffsetMax) {
-        if (bcOffset < 0) {
-          break;
-        } else if (bcOffset > 0) {
-          continue;
-        }
-      }
-
-      float trackTime{0.};
-      float trackTimeRes{0.};
-      if (trackCand.isPVContributor()) {
-        trackTime = trackCand.template collision_as<C>().collisionTime(); // if PV contributor, we assume the time to be the one of the collision
-        trackTimeRes = o2::constants::lhc::LHCBunchSpacingNS;             // 1 BC
-      } else {
-        trackTime = trackCand.trackTime();
-        trackTimeRes = trackCand.trackTimeRes();
-      }
 
       const float deltaTime = trackTime - collTime + bcOffset * o2::constants::lhc::LHCBunchSpacingNS;
       float sigmaTimeRes2 = collTimeRes2 + trackTimeRes * trackTimeRes;
@@ -167,7 +195,7 @@ class svPoolCreator
       float thresholdTime = 0.;
       if (trackCand.isPVContributor()) {
         thresholdTime = trackTimeRes;
-      } else if (TESTBIT(trackCand.flags(), o2::aod::track::TrackTimeResIsRange)) {
+      } else if (isTimeResRange) {
         thresholdTime = std::sqrt(sigmaTimeRes2);
         thresholdTime += timeMarginNS;
       } else {
@@ -182,19 +210,19 @@ class svPoolCreator
       const auto& tref = tmap.find(trackCand.globalIndex());
       if (tref != tmap.end()) {
         LOG(debug) << "Track: " << trackCand.globalIndex() << " already processed with other vertex";
-        trackCandPool[tref->second.second][tref->second.first].collBracket.setMax(static_cast<int>(collIdx)); // this track was already processed with other vertex, account the latter
+        auto& bracket = trackCandPool[tref->second.second][tref->second.first].collBracket;
+        bracket.setMin(std::min(bracket.getMin(), collIdx)); // this track was already processed with other vertex, account the latter
+        bracket.setMax(std::max(bracket.getMax(), collIdx));
         continue;
       }
 
       int poolIndex = (1 - isDau0) * 2 + (trackCand.sign() < 0);
       trForpool.Idxtr = trackCand.globalIndex();
-      trForpool.collBracket = {static_cast<int>(collIdx), static_cast<int>(collIdx)};
+      trForpool.collBracket = {collIdx, collIdx};
       // LOG(info) << "Adding track to pool: " << trForpool.Idxtr << " with bracket: " << trForpool.collBracket.getMin() << " " << trForpool.collBracket.getMax() << " and pool index: " << poolIndex;
       trackCandPool[poolIndex].emplace_back(trForpool);
       tmap[trackCand.globalIndex()] = {trackCandPool[poolIndex].size() - 1, poolIndex};
     }
-
-    // is Sorting Needed ? TBD
   }
 
   template <typename C>
@@ -202,7 +230,16 @@ class svPoolCreator
   {
     gsl::span<std::vector<TrackCand>> track0Pool{trackCandPool.data(), 2};
     gsl::span<std::vector<TrackCand>> track1Pool{trackCandPool.data() + 2, 2};
-    std::array<std::vector<int>, 2> mVtxTrack0{}; // 1st pos. and neg. track of the kink pool for each vertex
+
+    // the pair search below relies on the pools being ordered in collision index,
+    // which also makes it walk through the collisions (i.e. the BC buckets) in order
+    auto byFirstColl = [](const TrackCand& a, const TrackCand& b) { return a.collBracket.getMin() < b.collBracket.getMin(); };
+    for (auto& pool : trackCandPool) {
+      if (!std::is_sorted(pool.begin(), pool.end(), byFirstColl)) {
+        std::stable_sort(pool.begin(), pool.end(), byFirstColl);
+      }
+    }
+    tmap.clear(); // pool positions are not valid anymore
 
     for (int i = 0; i < 2; i++) {
       mVtxTrack0[i].clear();
@@ -264,7 +301,11 @@ class svPoolCreator
   float timeMarginNS = 600.;
   bool skipAmbiTracks = false;
   std::unordered_map<int, std::pair<int, int>> tmap;
-  std::unordered_map<uint64_t, int> bc2Coll;
+  std::vector<std::pair<uint64_t, int>> collsByBC;            // (global BC, collision index), sorted in BC
+  std::unordered_map<uint64_t, std::pair<int, int>> bcBuckets; // BC bucket -> [first, last) entries in collsByBC
+  std::vector<uint64_t> ambiTrackBC;                           // global BC of the ambiguous tracks, by track index
+  bool ambiTrackBCFilled = false;
+  std::array<std::vector<int>, 2> mVtxTrack0{}; // 1st pos. and neg. track of the pool for each vertex
 
   std::array<std::vector<TrackCand>, 4> trackCandPool; // Sorting: dau0 pos, dau0 neg, dau1 pos, dau1 neg
   std::vector<SVCand> svCandPool;                      // index of the two tracks in the track table
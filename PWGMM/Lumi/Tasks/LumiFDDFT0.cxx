@@ -12,6 +12,7 @@
 
 #include "Common/Core/trackUtilities.h"
 #include "Common/DataModel/EventSelection.h"
+#include "Common/DataModel/FwdDetBcSummary.h"
 
 #include <CCDB/BasicCCDBManager.h>
 #include <CommonUtils/ConfigurableParam.h>
@@ -387,23 +388,13 @@ struct LumiFDDFT0 {
 
       auto SideA = fdd.chargeA();
       auto SideC = fdd.chargeC();
-      std::vector<int> channelA;
-      std::vector<int> channelC;
       for (auto i = 0; i < 8; i++) {
-        if (SideA[i] > 0) {
-          channelA.push_back(i);
-        }
-
-        if (SideC[i] > 0) {
-          channelC.push_back(i);
-        }
-
         chargeaFDD += SideA[i];
         chargecFDD += SideC[i];
       }
 
-      bool isCoinA = checkAnyCoincidence(channelA);
-      bool isCoinC = checkAnyCoincidence(channelC);
+      bool isCoinA = o2::aod::fwdbcsummary::hasFDDCoincidence(SideA);
+      bool isCoinC = o2::aod::fwdbcsummary::hasFDDCoincidence(SideC);
 
       rowEventInfofdd(relTS, globalBC, bc.inputMask(), fdd.triggerMask(), fdd.timeA(), fdd.timeC(), isCoinA, isCoinC, chargeaFDD, chargecFDD);
     } // end of fdd table
@@ -446,18 +437,6 @@ struct LumiFDDFT0 {
     } // end of fv0 table
   };
   PROCESS_SWITCH(LumiFDDFT0, processLite, "Process FDD and FT0 info", false);
-
-  bool checkAnyCoincidence(const std::vector<int>& channels)
-  {
-    std::map<int, int> channelPairs = {{0, 4}, {1, 5}, {2, 6}, {3, 7}};
-    for (const auto& pair : channelPairs) {
-      if (std::find(channels.begin(), channels.end(), pair.first) != channels.end() &&
-          std::find(channels.begin(), channels.end(), pair.second) != channels.end()) {
-        return true;
-      }
-    }
-    return false;
-  }
 };
 
 WorkflowSpec defineDataProcessing(ConfigContext const& cfgc)
@@ -11,6 +11,8 @@
 
 // author: arvind.khuntia@cern.ch
 
+#include "Common/DataModel/FwdDetBcSummary.h"
+
 #include <CommonConstants/LHCConstants.h>
 #include <DataFormatsFDD/Digit.h>
 #include <Framework/AnalysisDataModel.h>
@@ -121,18 +123,6 @@ struct VdMAO2D {
 
   PROCESS_SWITCH(VdMAO2D, processFT0, "Process FT0 trigger rates for VdM", true);
 
-  bool checkAnyCoincidence(const std::vector<int>& channels)
-  {
-    std::map<int, int> channelPairs = {{0, 4}, {1, 5}, {2, 6}, {3, 7}};
-    for (const auto& pair : channelPairs) {
-      if (std::find(channels.begin(), channels.end(), pair.first) != channels.end() &&
-          std::find(channels.begin(), channels.end(), pair.second) != channels.end()) {
-        return true;
-      }
-    }
-    return false;
-  }
-
   void processFDD(aod::FDDs const& fdds, aod::BCsWithTimestamps const&)
   {
     for (auto const& fdd : fdds) {
@@ -145,22 +135,8 @@ struct VdMAO2D {
       auto pos = std::find(collBCArray->begin(), collBCArray->end(), localBC);
       bool vertex = fddTriggers[o2::fdd::Triggers::bitVertex];
       auto tsInSecond = ((bc.timestamp() * 1.e-3) - startTimeInS); // convert ts from ms to second
-      auto SideA = fdd.chargeA();
-      auto SideC = fdd.chargeC();
-      std::vector<int> channelA;
-      std::vector<int> channelC;
-      for (auto i = 0; i < 8; i++) {
-        if (SideA[i] > 0) {
-          channelA.push_back(i);
-        }
-
-        if (SideC[i] > 0) {
-          channelC.push_back(i);
-        }
-      }
-
-      bool isCoinA = checkAnyCoincidence(channelA);
-      bool isCoinC = checkAnyCoincidence(channelC);
+      bool isCoinA = o2::aod::fwdbcsummary::hasFDDCoincidence(fdd.chargeA());
+      bool isCoinC = o2::aod::fwdbcsummary::hasFDDCoincidence(fdd.chargeC());
 
       if (vertex) {
         registry.get<TH1>(HIST("FDD/VtxTrig"))->Fill(tsInSecond);
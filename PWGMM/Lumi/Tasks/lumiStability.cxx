@@ -16,6 +16,7 @@
 
 #include "Common/CCDB/EventSelectionParams.h"
 #include "Common/CCDB/ctpRateFetcher.h"
+#include "Common/DataModel/FwdDetBcSummary.h"
 
 #include <CCDB/BasicCCDBManager.h>
 #include <CommonConstants/LHCConstants.h>
@@ -249,23 +250,6 @@ struct LumiStabilityTask {
     histos.add("FV0/hTimeForRateLeadingBCCTP", "Counts by time in FV0;t (in seconds) in FV0; counts", kTH1F, {axisTimeRate});
   }
 
-  bool checkAnyCoincidence(const std::vector<int>& channels)
-  {
-    constexpr std::pair<int, int> kPair0 = {0, 4};
-    constexpr std::pair<int, int> kPair1 = {1, 5};
-    constexpr std::pair<int, int> kPair2 = {2, 6};
-    constexpr std::pair<int, int> kPair3 = {3, 7};
-    constexpr std::array<std::pair<int, int>, 4> kChannelPairs = {kPair0, kPair1, kPair2, kPair3};
-    // std::map<int, int> kChannelPairs = {{0, 4}, {1, 5}, {2, 6}, {3, 7}};
-    for (const auto& pair : kChannelPairs) {
-      if (std::find(channels.begin(), channels.end(), pair.first) != channels.end() &&
-          std::find(channels.begin(), channels.end(), pair.second) != channels.end()) {
-        return true;
-      }
-    }
-    return false;
-  }
-
   float getTimeSinceSOF(const auto& bc)
   {
     return (bc.timestamp() - grplhcif->getFillNumberTime()) / 1e3 / 60; // Convert to minutes
@@ -448,23 +432,8 @@ struct LumiStabilityTask {
       bool scentral = fddTriggers[o2::fdd::Triggers::bitSCen];
       bool central = fddTriggers[o2::fdd::Triggers::bitCen];
 
-      auto sideA = fdd.chargeA();
-      auto sideC = fdd.chargeC();
-      std::vector<int> channelA;
-      std::vector<int> channelC;
-      int minLimit = 0;
-      int maxNChanels = 8;
-      for (auto i = 0; i < maxNChanels; i++) {
-        if (sideA[i] > minLimit) {
-          channelA.push_back(i);
-        }
-        if (sideC[i] > minLimit) {
-          channelC.push_back(i);
-        }
-      }
-
-      bool isCoinA = checkAnyCoincidence(channelA);
-      bool isCoinC = checkAnyCoincidence(channelC);
+      bool isCoinA = o2::aod::fwdbcsummary::hasFDDCoincidence(fdd.chargeA());
+      bool isCoinC = o2::aod::fwdbcsummary::hasFDDCoincidence(fdd.chargeC());
 
       histos.fill(HIST("FDD/hCounts"), 0);
       if (vertex) {
@@ -624,22 +593,8 @@ struct LumiStabilityTask {
               bool vertexPast = fddTriggersPast[o2::fdd::Triggers::bitVertex];
               bool triggerAPast = fddTriggersPast[o2::fdd::Triggers::bitA];
               bool triggerCPast = fddTriggersPast[o2::fdd::Triggers::bitC];
-              auto sideAPast = fddPast.chargeA();
-              auto sideCPast = fddPast.chargeC();
-              std::vector<int> channelAPast;
-              std::vector<int> channelCPast;
-              int maxNChanels = 8;
-              for (auto i = 0; i < maxNChanels; i++) {
-                if (sideAPast[i] > 0) {
-                  channelAPast.push_back(i);
-                }
-                if (sideCPast[i] > 0) {
-                  channelCPast.push_back(i);
-                }
-              }
-
-              bool isCoinAPast = checkAnyCoincidence(channelAPast);
-              bool isCoinCPast = checkAnyCoincidence(channelCPast);
+              bool isCoinAPast = o2::aod::fwdbcsummary::hasFDDCoincidence(fddPast.chargeA());
+              bool isCoinCPast = o2::aod::fwdbcsummary::hasFDDCoincidence(fddPast.chargeC());
               pastActivityFDDVertexCoincidences |= (vertexPast & isCoinAPast & isCoinCPast);
               pastActivityFDDTriggerACoincidenceA |= (triggerAPast & isCoinAPast);
               pastActivityFDDTriggerCCoincidenceC |= (triggerCPast & isCoinCPast);
@@ -0,0 +1,186 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#ifndef PWGMM_MULT_CORE_INCLUDE_FILLPLAN_H_
+#define PWGMM_MULT_CORE_INCLUDE_FILLPLAN_H_
+
+#include <TH1.h>
+#include <TH2.h>
+#include <TH3.h>
+#include <THnBase.h>
+
+#include <array>
+#include <cstdint>
+#include <initializer_list>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+namespace pwgmm::mult
+{
+// Fill plan for registry histograms filled with the same values for every track of an event.
+// During the track loop only the NTrack per track values and a selection bit mask are stored,
+// the NEvent per event values (e.g. vertex, centrality, occupancy) are set once per event.
+// At the end of the event each histogram of the plan is filled from the buffer with the entries
+// that have all the bits of its mask set. The histograms which are switched off are simply not
+// added to the plan. The fills are the same as the ones of HistogramRegistry::fill with the
+// same arguments, including a weight given as the last value.
+template <int NTrack, int NEvent>
+class FillPlan
+{
+ public:
+  static constexpr int NValues = NTrack + NEvent;
+  static constexpr int MaxAxes = 8;
+
+  // hist is filled with the values at the positions axes (per track values first, then the per event
+  // values), weighted with the value at the position weight if it is not negative
+  template <typename H>
+  void add(std::shared_ptr<H> const& hist, std::initializer_list<int> axes, uint32_t mask = 0, int weight = -1)
+  {
+    Target target;
+    if constexpr (std::is_base_of_v<THnBase, H>) {
+      target.hn = hist;
+      target.kind = Kind::THn;
+    } else {
+      target.h = hist;
+      if constexpr (std::is_base_of_v<TH3, H>) {
+        target.kind = Kind::TH3;
+      } else if constexpr (std::is_base_of_v<TH2, H>) {
+        target.kind = Kind::TH2;
+      } else {
+        target.kind = Kind::TH1;
+      }
+    }
+    for (auto axis : axes) {
+      target.axes[target.nAxes++] = axis;
+    }
+    target.mask = mask;
+    target.weight = weight;
+    mTargets.push_back(target);
+  }
+
+  bool empty() const { return mTargets.empty(); }
+
+  void clear()
+  {
+    mTargets.clear();
+    mEntries.clear();
+  }
+
+  template <typename... Ts>
+  void setEvent(Ts... values)
+  {
+    static_assert(sizeof...(Ts) == NEvent, "Wrong number of per event values");
+    mEvent = {static_cast<float>(values)...};
+  }
+
+  template <typename... Ts>
+  void push(uint32_t mask, Ts... values)
+  {
+    static_assert(sizeof...(Ts) == NTrack, "Wrong number of per track values");
+    mEntries.push_back({mask, {static_cast<float>(values)...}});
+  }
+
+  // fills all the histograms of the plan and clears the buffer
+  void fill()
+  {
+    std::array<float, NValues> x{};
+    std::array<double, MaxAxes> coordinates{};
+    for (int i = 0; i < NEvent; ++i) {
+      x[NTrack + i] = mEvent[i];
+    }
+    for (auto const& target : mTargets) {
+      for (auto const& entry : mEntries) {
+        if ((entry.mask & target.mask) != target.mask) {
+          continue;
+        }
+        for (int i = 0; i < NTrack; ++i) {
+          x[i] = entry.values[i];
+        }
+        for (int i = 0; i < target.nAxes; ++i) {
+          coordinates[i] = x[target.axes[i]];
+        }
+        if (target.weight < 0) {
+          fill(target, coordinates);
+        } else {
+          fill(target, coordinates, x[target.weight]);
+        }
+      }
+    }
+    mEntries.clear();
+  }
+
+ private:
+  enum class Kind : uint8_t {
+    TH1,
+    TH2,
+    TH3,
+    THn
+  };
+
+  struct Target {
+    std::shared_ptr<TH1> h;
+    std::shared_ptr<THnBase> hn;
+    Kind kind = Kind::TH1;
+    int nAxes = 0;
+    std::array<int, MaxAxes> axes{};
+    uint32_t mask = 0;
+    int weight = -1;
+  };
+
+  struct Entry {
+    uint32_t mask;
+    std::array<float, NTrack> values;
+  };
+
+  static void fill(Target const& target, std::array<double, MaxAxes> const& c)
+  {
+    switch (target.kind) {
+      case Kind::TH1:
+        target.h->Fill(c[0]);
+        break;
+      case Kind::TH2:
+        static_cast<TH2*>(target.h.get())->Fill(c[0], c[1]);
+        break;
+      case Kind::TH3:
+        static_cast<TH3*>(target.h.get())->Fill(c[0], c[1], c[2]);
+        break;
+      case Kind::THn:
+        target.hn->Fill(c.data());
+        break;
+    }
+  }
+
+  static void fill(Target const& target, std::array<double, MaxAxes> const& c, double w)
+  {
+    switch (target.kind) {
+      case Kind::TH1:
+        target.h->Fill(c[0], w);
+        break;
+      case Kind::TH2:
+        static_cast<TH2*>(target.h.get())->Fill(c[0], c[1], w);
+        break;
+      case Kind::TH3:
+        static_cast<TH3*>(target.h.get())->Fill(c[0], c[1], c[2], w);
+        break;
+      case Kind::THn:
+        target.hn->Fill(c.data(), w);
+        break;
+    }
+  }
+
+  std::vector<Target> mTargets;
+  std::vector<Entry> mEntries;
+  std::array<float, NEvent> mEvent{};
+};
+} // namespace pwgmm::mult
+
+#endif // PWGMM_MULT_CORE_INCLUDE_FILLPLAN_H_
@@ -299,6 +299,11 @@ struct AmbiguousTrackPropagation {
       auto bestCol = track.has_collision() ? track.collisionId() : -1;
 
       o2::track::TrackParCovFwd trackPar = o2::aod::fwdtrackutils::getTrackParCovFwdShift(track, mZShift);
+      // only the track parameters are propagated to the compatible collisions,
+      // the covariance matrix is propagated to the best collision only
+      o2::track::TrackParFwd trackParam = trackPar;
+      bool hasBestZ = false;
+      double bestZ = 0.;
 
       int degree = 0; // degree of ambiguity of the track
 
@@ -310,10 +315,10 @@ struct AmbiguousTrackPropagation {
         auto collisions = bc.collisions();
         for (auto const& collision : collisions) {
           degree++;
-          trackPar.propagateToZhelix(collision.posZ(), bZ); // track parameters propagation to the position of the z vertex
+          trackParam.propagateParamToZhelix(collision.posZ(), bZ); // track parameters propagation to the position of the z vertex
 
-          const auto dcaX(trackPar.getX() - collision.posX());
-          const auto dcaY(trackPar.getY() - collision.posY());
+          const auto dcaX(trackParam.getX() - collision.posX());
+          const auto dcaY(trackParam.getY() - collision.posY());
           dcaInfo = std::sqrt(dcaX * dcaX + dcaY * dcaY);
 
           if ((dcaInfo < bestDCA)) {
@@ -321,7 +326,8 @@ struct AmbiguousTrackPropagation {
             bestDCA = dcaInfo;
             bestDCAx = dcaX;
             bestDCAy = dcaY;
-            bestTrackPar = trackPar;
+            hasBestZ = true;
+            bestZ = collision.posZ();
           }
 
           if (produceHistos) {
@@ -347,6 +353,10 @@ struct AmbiguousTrackPropagation {
 
       fwdtracksBestCollisions(-1, degree, bestCol, bestDCA, bestDCAx, bestDCAy);
       if (produceExtra) {
+        if (hasBestZ) {
+          trackPar.propagateToZhelix(bestZ, bZ);
+          bestTrackPar = trackPar;
+        }
         fwdtracksBestCollExtra(bestTrackPar.getX(),
                                bestTrackPar.getY(), bestTrackPar.getZ(),
                                bestTrackPar.getTgl(), bestTrackPar.getInvQPt(), bestTrackPar.getPt(),
@@ -389,13 +399,18 @@ struct AmbiguousTrackPropagation {
       auto compatibleColls = track.compatibleColl();
 
       o2::track::TrackParCovFwd trackPar = o2::aod::fwdtrackutils::getTrackParCovFwdShift(track, mZShift);
+      // only the track parameters are propagated to the compatible collisions,
+      // the covariance matrix is propagated to the best collision only
+      o2::track::TrackParFwd trackParam = trackPar;
+      bool hasBestZ = false;
+      double bestZ = 0.;
 
       for (auto const& collision : compatibleColls) {
 
-        trackPar.propagateToZhelix(collision.posZ(), bZ); // track parameters propagation to the position of the z vertex
+        trackParam.propagateParamToZhelix(collision.posZ(), bZ); // track parameters propagation to the position of the z vertex
 
-        const auto dcaX(trackPar.getX() - collision.posX());
-        const auto dcaY(trackPar.getY() - collision.posY());
+        const auto dcaX(trackParam.getX() - collision.posX());
+        const auto dcaY(trackParam.getY() - collision.posY());
         dcaInfo = std::sqrt(dcaX * dcaX + dcaY * dcaY);
 
         if ((dcaInfo < bestDCA)) {
@@ -403,7 +418,8 @@ struct AmbiguousTrackPropagation {
           bestDCA = dcaInfo;
           bestDCAx = dcaX;
           bestDCAy = dcaY;
-          bestTrackPar = trackPar;
+          hasBestZ = true;
+          bestZ = collision.posZ();
         }
         if ((track.collisionId() != collision.globalIndex()) && produceHistos) {
           registry.fill(HIST("DeltaZ"), track.collision().posZ() - collision.posZ()); // deltaZ between the 1st coll zvtx and the other compatible ones
@@ -431,6 +447,10 @@ struct AmbiguousTrackPropagation {
 
       fwdtracksBestCollisions(track.globalIndex(), compatibleColls.size(), bestCol, bestDCA, bestDCAx, bestDCAy);
       if (produceExtra) {
+        if (hasBestZ) {
+          trackPar.propagateToZhelix(bestZ, bZ);
+          bestTrackPar = trackPar;
+        }
         fwdtracksBestCollExtra(bestTrackPar.getX(),
                                bestTrackPar.getY(), bestTrackPar.getZ(),
                                bestTrackPar.getTgl(), bestTrackPar.getInvQPt(), bestTrackPar.getPt(),
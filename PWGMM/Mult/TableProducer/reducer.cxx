@@ -92,6 +92,16 @@ struct Reducer {
 
   std::vector<int> binned;
 
+  // data frame mode: selected reconstructed collisions, their reduced BC and MC collision indices and binned tracks
+  struct ReducedCollision {
+    int64_t collisionId;
+    int64_t bcId;
+    int64_t mcLabel;
+  };
+  std::vector<ReducedCollision> reducedCollisions;
+  std::vector<int64_t> reducedPosition;
+  std::vector<int> binnedPerCollision;
+
   double NormalizedDoubleNBD(double x)
   {
     // <n> = (p[2,4]^2)
@@ -201,6 +211,26 @@ struct Reducer {
 
   PROCESS_SWITCH(Reducer, processLite, "Process without HepMC", true);
 
+  void processFullDF(BCs const& bcs,
+                     MCCollisions const& mccollisions,
+                     Collisions const& collisions,
+                     Tracks const& tracks)
+  {
+    processDF(bcs, mccollisions, collisions, tracks);
+  }
+
+  PROCESS_SWITCH(Reducer, processFullDF, "Full process with HepMC, whole data frame at once", false);
+
+  void processLiteDF(BCs const& bcs,
+                     MCCollisionsNoHepMC const& mccollisions,
+                     Collisions const& collisions,
+                     Tracks const& tracks)
+  {
+    processDF(bcs, mccollisions, collisions, tracks);
+  }
+
+  PROCESS_SWITCH(Reducer, processLiteDF, "Process without HepMC, whole data frame at once", false);
+
   template <typename TBCI, typename TMCC, typename TC, typename TT>
   void processGeneric(TBCI const& bc,
                       TMCC const& mccollisions,
@@ -277,6 +307,119 @@ struct Reducer {
       rmcl(usedLabels[std::distance(usedMCCs.begin(), pos)]);
     }
   }
+
+  // Same reduction as processGeneric for all the BCs of the data frame. The MC collisions and the
+  // collisions are sorted by BC, they are grouped by one sweep over both. The tracks are binned
+  // in one sweep over the track table, for the selected collisions only.
+  template <typename TBC, typename TMCC, typename TC, typename TT>
+  void processDF(TBC const& bcs,
+                 TMCC const& mccollisions,
+                 TC const& collisions,
+                 TT const& tracks)
+  {
+    if (mccollisions.size() == 0) {
+      return;
+    }
+    checkSampling(mccollisions);
+    auto nKept = std::count_if(weights.begin(), weights.end(), [](auto const& x) { return x >= 0; });
+    if (nKept == 0) {
+      return;
+    }
+    rbcs.reserve(nKept);
+    rmcc.reserve(nKept);
+
+    reducedCollisions.clear();
+    int64_t iC = 0;
+    const int64_t nMCC = mccollisions.size();
+    const int64_t nC = collisions.size();
+    for (int64_t iMCC = 0; iMCC < nMCC;) {
+      // MC collisions [iMCC, lastMCC) and collisions [firstC, lastC) of the BC
+      const auto bcIndex = mccollisions.iteratorAt(iMCC).bcId();
+      auto lastMCC = iMCC;
+      while (lastMCC < nMCC && mccollisions.iteratorAt(lastMCC).bcId() == bcIndex) {
+        ++lastMCC;
+      }
+      while (iC < nC && collisions.iteratorAt(iC).bcId() < bcIndex) {
+        ++iC;
+      }
+      const auto firstC = iC;
+      while (iC < nC && collisions.iteratorAt(iC).bcId() == bcIndex) {
+        ++iC;
+      }
+      const auto lastC = iC;
+
+      // if all events are discarded, skip the BC
+      if (std::all_of(weights.begin() + iMCC, weights.begin() + lastMCC, [](auto const& x) { return x < 0; })) {
+        iMCC = lastMCC;
+        continue;
+      }
+      // keep the BC
+      rbcs(bcs.iteratorAt(bcIndex).runNumber());
+      auto bcId = rbcs.lastIndex();
+      bool pass = !useEvSel;
+      for (auto j = firstC; j < lastC && !pass; ++j) {
+        pass = isCollisionSelected(collisions.iteratorAt(j));
+      }
+      usedMCCs.clear();
+      usedLabels.clear();
+      for (; iMCC < lastMCC; ++iMCC) {
+        if (weights[iMCC] < 0 || !pass) {
+          continue;
+        }
+        auto mcc = mccollisions.iteratorAt(iMCC);
+        rmcc(bcId, weights[iMCC], mcc.posX(), mcc.posY(), mcc.posZ(), mcc.impactParameter(), mcc.multMCFT0A(), mcc.multMCFT0C(), mcc.multMCNParticlesEta05(), mcc.multMCNParticlesEta10());
+        if constexpr (requires {mcc.processId(); mcc.pdf1(); }) {
+          rhepmci(rmcc.lastIndex(), mcc.xsectGen(), mcc.ptHard(), mcc.nMPI(), mcc.processId(), mcc.id1(), mcc.id2(), mcc.pdfId1(), mcc.pdfId2(), mcc.x1(), mcc.x2(), mcc.scalePdf(), mcc.pdf1(), mcc.pdf2());
+        }
+        usedMCCs.push_back(mcc.globalIndex());
+        usedLabels.push_back(rmcc.lastIndex());
+      }
+      for (auto j = firstC; j < lastC; ++j) {
+        auto c = collisions.iteratorAt(j);
+        if (!c.has_mcCollision()) {
+          continue;
+        }
+        auto pos = std::find(usedMCCs.begin(), usedMCCs.end(), c.mcCollisionId());
+        if (pos == usedMCCs.end()) {
+          continue;
+        }
+        if (useEvSel && !isCollisionSelected(c)) {
+          continue;
+        }
+        reducedCollisions.push_back({c.globalIndex(), bcId, usedLabels[std::distance(usedMCCs.begin(), pos)]});
+      }
+    }
+
+    // bin the tracks of the selected collisions
+    const auto nBins = static_cast<int64_t>(binned.size());
+    reducedPosition.assign(nC, -1);
+    for (auto k = 0u; k < reducedCollisions.size(); ++k) {
+      reducedPosition[reducedCollisions[k].collisionId] = k;
+    }
+    binnedPerCollision.assign(reducedCollisions.size() * nBins, 0);
+    for (auto& track : tracks) {
+      if (track.collisionId() < 0) {
+        continue;
+      }
+      auto k = reducedPosition[track.collisionId()];
+      if (k < 0) {
+        continue;
+      }
+      auto bin = findBin(track.eta(), track.phi());
+      if (bin >= 0) {
+        binnedPerCollision[k * nBins + bin] += 1;
+      }
+    }
+
+    rc.reserve(reducedCollisions.size());
+    rmcl.reserve(reducedCollisions.size());
+    for (auto k = 0u; k < reducedCollisions.size(); ++k) {
+      auto c = collisions.iteratorAt(reducedCollisions[k].collisionId);
+      std::copy(binnedPerCollision.begin() + k * nBins, binnedPerCollision.begin() + (k + 1) * nBins, binned.begin());
+      rc(reducedCollisions[k].bcId, c.posX(), c.posY(), c.posZ(), c.collisionTimeRes(), c.multFT0A(), c.multFT0C(), c.multFDDA(), c.multFDDC(), c.multZNA(), c.multZNC(), c.multNTracksPV(), c.multNTracksPVeta1(), c.multNTracksPVetaHalf(), binned);
+      rmcl(reducedCollisions[k].mcLabel);
+    }
+  }
 };
 
 struct ReducerTest {
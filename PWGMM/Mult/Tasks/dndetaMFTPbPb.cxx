@@ -15,6 +15,7 @@
 /// \author Gyula Bencedi, gyula.bencedi@cern.ch
 /// \since  Nov 2024
 
+#include "PWGMM/Mult/Core/include/FillPlan.h"
 #include "PWGMM/Mult/Core/include/Functions.h"
 #include "PWGMM/Mult/DataModel/Index.h"
 #include "PWGMM/Mult/DataModel/bestCollisionTable.h"
@@ -367,6 +368,8 @@ struct DndetaMFTPbPb {
     Configurable<bool> cfgUseTrackParExtra{"cfgUseTrackParExtra", false, "Use table with refitted track parameters"};
     Configurable<bool> cfgUseInelgt0{"cfgUseInelgt0", false, "Use INEL > 0 condition"};
     Configurable<bool> cfgUseInelgt0wMFT{"cfgUseInelgt0wMFT", false, "Use INEL > 0 condition with MFT acceptance"};
+    Configurable<bool> cfgUseFillPlan{"cfgUseFillPlan", false, "Fill the per track histograms of the track counting once per event from a buffer"};
+    Configurable<bool> cfgFillPlanQA{"cfgFillPlanQA", true, "Fill the per track QA histograms with the fill plan"};
     Configurable<std::string> grpmagPath{"grpmagPath", "GLO/Config/GRPMagField", "CCDB path of the GRPMagField object"};
     Configurable<uint> cfgDCAtype{"cfgDCAtype", 2, "DCA coordinate type [0: DCA-X, 1: DCA-Y, 2: DCA-XY]"};
   } gConf;
@@ -470,6 +473,20 @@ struct DndetaMFTPbPb {
   std::vector<int> ambiguousTrkIdsMC;
   std::vector<int> reassignedTrkIdsMC;
 
+  // per track values of the track counting fill plan, then the per event values
+  enum TrackFillValue { kFillChi2,
+                        kFillEta,
+                        kFillNClusters,
+                        kFillPhi,
+                        kFillTgl,
+                        kFillInvQPt,
+                        kFillZvtx,
+                        kFillCent,
+                        kFillOcc };
+  static constexpr uint32_t FillSelected = 1u; // selected track inside the azimuthal range
+  FillPlan<6, 3> trackFillPlan;
+  FillPlan<6, 3> trackFillPlanCent;
+
   /// @brief init function, definition of histograms
   void init(InitContext&)
   {
@@ -671,6 +688,21 @@ struct DndetaMFTPbPb {
       qaregistry.add({"Tracks/Eta", "; #eta; centrality; occupancy", {HistType::kTH2F, {etaAxis, occupancyAxis}}});
       qaregistry.add({"Tracks/Phi", "; #varphi; centrality; occupancy", {HistType::kTH2F, {phiAxis, occupancyAxis}}});
 
+      if (gConf.cfgUseFillPlan) {
+        trackFillPlan.add(registry.get<THnSparse>(HIST("Tracks/EtaZvtx")), {kFillEta, kFillZvtx, kFillOcc}, FillSelected);
+        trackFillPlan.add(registry.get<THnSparse>(HIST("Tracks/PhiEta")), {kFillPhi, kFillEta, kFillOcc}, FillSelected);
+        if (gConf.cfgFillPlanQA) {
+          trackFillPlan.add(qaregistry.get<THnSparse>(HIST("Tracks/Chi2Eta")), {kFillChi2, kFillEta, kFillOcc});
+          trackFillPlan.add(qaregistry.get<TH2>(HIST("Tracks/Chi2")), {kFillChi2, kFillOcc});
+          trackFillPlan.add(qaregistry.get<THnSparse>(HIST("Tracks/NclustersEta")), {kFillNClusters, kFillEta, kFillOcc});
+          // same arguments as the direct fills: (value, centrality) weighted with the occupancy
+          trackFillPlan.add(qaregistry.get<TH2>(HIST("Tracks/TanLambda")), {kFillTgl, kFillCent}, FillSelected, kFillOcc);
+          trackFillPlan.add(qaregistry.get<TH2>(HIST("Tracks/InvQPt")), {kFillInvQPt, kFillCent}, FillSelected, kFillOcc);
+          trackFillPlan.add(qaregistry.get<TH2>(HIST("Tracks/Eta")), {kFillEta, kFillCent}, FillSelected, kFillOcc);
+          trackFillPlan.add(qaregistry.get<TH2>(HIST("Tracks/Phi")), {kFillPhi, kFillCent}, FillSelected, kFillOcc);
+        }
+      }
+
       if (doprocessDatawBestTracksInclusive) {
         registry.add(
           {"Events/NtrkZvtxBest",
@@ -795,6 +827,20 @@ struct DndetaMFTPbPb {
       qaregistry.add({"Tracks/Centrality/Eta", "; #eta; centrality; occupancy", {HistType::kTHnSparseF, {etaAxis, centralityAxis, occupancyAxis}}});
       qaregistry.add({"Tracks/Centrality/Phi", "; #varphi; centrality; occupancy", {HistType::kTHnSparseF, {phiAxis, centralityAxis, occupancyAxis}}});
 
+      if (gConf.cfgUseFillPlan) {
+        trackFillPlanCent.add(registry.get<THnSparse>(HIST("Tracks/Centrality/EtaZvtx")), {kFillEta, kFillZvtx, kFillCent, kFillOcc}, FillSelected);
+        trackFillPlanCent.add(registry.get<THnSparse>(HIST("Tracks/Centrality/PhiEta")), {kFillPhi, kFillEta, kFillCent, kFillOcc}, FillSelected);
+        if (gConf.cfgFillPlanQA) {
+          trackFillPlanCent.add(qaregistry.get<THnSparse>(HIST("Tracks/Centrality/Chi2Eta")), {kFillChi2, kFillEta, kFillCent, kFillOcc});
+          trackFillPlanCent.add(qaregistry.get<THnSparse>(HIST("Tracks/Centrality/Chi2")), {kFillChi2, kFillCent, kFillOcc});
+          trackFillPlanCent.add(qaregistry.get<THnSparse>(HIST("Tracks/Centrality/NclustersEta")), {kFillNClusters, kFillEta, kFillCent, kFillOcc});
+          trackFillPlanCent.add(qaregistry.get<THnSparse>(HIST("Tracks/Centrality/TanLambda")), {kFillTgl, kFillCent, kFillOcc}, FillSelected);
+          trackFillPlanCent.add(qaregistry.get<THnSparse>(HIST("Tracks/Centrality/InvQPt")), {kFillInvQPt, kFillCent, kFillOcc}, FillSelected);
+          trackFillPlanCent.add(qaregistry.get<THnSparse>(HIST("Tracks/Centrality/Eta")), {kFillEta, kFillCent, kFillOcc}, FillSelected);
+          trackFillPlanCent.add(qaregistry.get<THnSparse>(HIST("Tracks/Centrality/Phi")), {kFillPhi, kFillCent, kFillOcc}, FillSelected);
+        }
+      }
+
       if (doprocessDatawBestTracksCentFT0C ||
           doprocessDatawBestTracksCentFT0CVariant1 ||
           doprocessDatawBestTracksCentFT0M ||
@@ -1901,7 +1947,22 @@ struct DndetaMFTPbPb {
   int countTracks(T const& tracks, float z, float c, float occ)
   {
     auto nTrk = 0;
+    auto& fillPlan = has_reco_cent<C> ? trackFillPlanCent : trackFillPlan;
+    const bool useFillPlan = fillHis && gConf.cfgUseFillPlan;
+    if (useFillPlan) {
+      fillPlan.setEvent(z, c, occ);
+    }
     for (auto const& track : tracks) {
+      if (useFillPlan) {
+        float phi = track.phi();
+        o2::math_utils::bringTo02Pi(phi);
+        const bool selected = isTrackSelected(track) && !(phi < Czero || TwoPI < phi);
+        fillPlan.push(selected ? FillSelected : 0u, track.chi2(), track.eta(), track.nClusters(), phi, track.tgl(), track.signed1Pt());
+        if (selected) {
+          ++nTrk;
+        }
+        continue;
+      }
       if (fillHis) {
         if constexpr (has_reco_cent<C>) {
           qaregistry.fill(HIST("Tracks/Centrality/Chi2Eta"), track.chi2(), track.eta(), c, occ);
@@ -1940,6 +2001,9 @@ struct DndetaMFTPbPb {
       }
       ++nTrk;
     }
+    if (useFillPlan) {
+      fillPlan.fill();
+    }
     if (fillHis) {
       if constexpr (has_reco_cent<C>) {
         qaregistry.fill(HIST("Tracks/Centrality/NchSel"), nTrk, c, occ);
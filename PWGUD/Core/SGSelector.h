@@ -56,6 +56,9 @@ class SGSelector
  public:
   SGSelector() : myRCTChecker{"CBT"}, myRCTCheckerHadron{"CBT_hadronPID"}, myRCTCheckerZDC{"CBT", true}, myRCTCheckerHadronZDC{"CBT_hadronPID", true} {}
 
+  // BC index of the BCs table the bcRange are sliced from, nullptr to loop over the BCs
+  void setBCIndex(udhelpers::BCIndex const* bcIndex) { mBCIndex = bcIndex; }
+
   template <typename CC, typename BCs, typename TCs, typename FWs>
   int Print(SGCutParHolder const& /*diffCuts*/, CC const& collision, BCs const& /*bcRange*/, TCs const& /*tracks*/, FWs const& /*fwdtracks*/)
   {
@@ -82,22 +85,38 @@ class SGSelector
     float ampc = 0;
     float ampa = 0;
     bool gA = true, gC = true;
-    for (auto const& bc : bcRange) {
-      if (!udhelpers::cleanFITA(bc, diffCuts.maxFITtime(), diffCuts.FITAmpLimits())) {
-        if (gA)
-          newbc = bc;
-        if (!gA && std::abs(static_cast<int64_t>(bc.globalBC() - oldbc.globalBC())) < std::abs(static_cast<int64_t>(newbc.globalBC() - oldbc.globalBC())))
-          newbc = bc;
-        gA = false;
-      }
-      if (!udhelpers::cleanFITC(bc, diffCuts.maxFITtime(), diffCuts.FITAmpLimits())) {
-        if (gC)
-          newbc = bc;
-        if (!gC && std::abs(static_cast<int64_t>(bc.globalBC() - oldbc.globalBC())) < std::abs(static_cast<int64_t>(newbc.globalBC() - oldbc.globalBC())))
-          newbc = bc;
-        gC = false;
+    const auto lims = diffCuts.FITAmpLimits();
+    // with a BC index holding the clean FIT flags of these cuts the gaps are found from the prefix sums,
+    // the BCs are only looped to find the closest active BC of a single gap
+    bool loopBCs = true;
+    if (mBCIndex && bcRange.size() > 0 && mBCIndex->hasCleanFIT(diffCuts.maxFITtime(), lims)) {
+      const int64_t first = bcRange.begin().globalIndex();
+      const int64_t last = first + bcRange.size();
+      if (last <= mBCIndex->size()) {
+        loopBCs = mBCIndex->isCleanFITA(first, last) != mBCIndex->isCleanFITC(first, last);
+        if (!loopBCs) {
+          gA = gC = mBCIndex->isCleanFITA(first, last);
+        }
       }
-    } // end of loop over bc range
+    }
+    if (loopBCs) {
+      for (auto const& bc : bcRange) {
+        if (!udhelpers::cleanFITA(bc, diffCuts.maxFITtime(), lims)) {
+          if (gA)
+            newbc = bc;
+          if (!gA && std::abs(static_cast<int64_t>(bc.globalBC() - oldbc.globalBC())) < std::abs(static_cast<int64_t>(newbc.globalBC() - oldbc.globalBC())))
+            newbc = bc;
+          gA = false;
+        }
+        if (!udhelpers::cleanFITC(bc, diffCuts.maxFITtime(), lims)) {
+          if (gC)
+            newbc = bc;
+          if (!gC && std::abs(static_cast<int64_t>(bc.globalBC() - oldbc.globalBC())) < std::abs(static_cast<int64_t>(newbc.globalBC() - oldbc.globalBC())))
+            newbc = bc;
+          gC = false;
+        }
+      } // end of loop over bc range
+    }
     if (!gA && !gC) {
       result.value = o2::aod::sgselector::NoUpc; // gap = 3
       result.bc = std::make_shared<BC>(oldbc);
@@ -107,13 +126,13 @@ class SGSelector
     if (amplitudesFV0 && amplitudesFT0A && amplitudesFDDA && gA) {
       for (auto const& bc : bcRange) {
         if (bc.has_foundFV0()) {
-          amplitudesFV0->push_back(udhelpers::FV0AmplitudeA(bc.foundFV0()));
+          amplitudesFV0->push_back(udhelpers::bcAmplitudeFV0A(bc));
         }
         if (bc.has_foundFT0()) {
-          amplitudesFT0A->push_back(udhelpers::FT0AmplitudeA(bc.foundFT0()));
+          amplitudesFT0A->push_back(udhelpers::bcAmplitudeFT0A(bc));
         }
         if (bc.has_foundFDD()) {
-          amplitudesFDDA->push_back(udhelpers::FDDAmplitudeA(bc.foundFDD()));
+          amplitudesFDDA->push_back(udhelpers::bcAmplitudeFDDA(bc));
         }
       }
     }
@@ -121,10 +140,10 @@ class SGSelector
     if (amplitudesFT0C && amplitudesFDDC && gC) {
       for (auto const& bc : bcRange) {
         if (bc.has_foundFT0()) {
-          amplitudesFT0C->push_back(udhelpers::FT0AmplitudeC(bc.foundFT0()));
+          amplitudesFT0C->push_back(udhelpers::bcAmplitudeFT0C(bc));
         }
         if (bc.has_foundFDD()) {
-          amplitudesFDDC->push_back(udhelpers::FDDAmplitudeC(bc.foundFDD()));
+          amplitudesFDDC->push_back(udhelpers::bcAmplitudeFDDC(bc));
         }
       }
     }
@@ -132,8 +151,8 @@ class SGSelector
     if (gA && gC) { // loop once again for so-called DG events to get the most active FT0 BC
       for (auto const& bc : bcRange) {
         if (bc.has_foundFT0()) {
-          tempampa = udhelpers::FT0AmplitudeA(bc.foundFT0());
-          tempampc = udhelpers::FT0AmplitudeC(bc.foundFT0());
+          tempampa = udhelpers::bcAmplitudeFT0A(bc);
+          tempampc = udhelpers::bcAmplitudeFT0C(bc);
           if (tempampa > ampa) {
             ampa = tempampa;
             newdgabc = bc;
@@ -242,6 +261,7 @@ class SGSelector
   o2::aod::rctsel::RCTFlagsChecker myRCTCheckerHadron;
   o2::aod::rctsel::RCTFlagsChecker myRCTCheckerZDC;
   o2::aod::rctsel::RCTFlagsChecker myRCTCheckerHadronZDC;
+  udhelpers::BCIndex const* mBCIndex = nullptr;
 };
 
 #endif // PWGUD_CORE_SGSELECTOR_H_
@@ -17,6 +17,7 @@
 
 #include <algorithm>
 #include <cctype>
+#include <cstdint>
 #include <fstream>
 #include <string>
 #include <vector>
@@ -81,14 +82,33 @@ bool UDFSParser::readFS(const char* filename)
   }
 
   // fill fP2BCsE
+  fillBCTypeBits();
   for (int bcnum = 0; bcnum < o2::constants::lhc::LHCMaxBunches; bcnum++) {
     if (!isP2BCA(bcnum) && !isP2BCC(bcnum) && !isP2BCBB(bcnum)) {
       fP2BCsE.push_back(bcnum);
     }
   }
+  fillBCTypeBits();
   return true;
 }
 
+// -----------------------------------------------------------------------------
+void UDFSParser::fillBCTypeBits()
+{
+  fBCTypeBits.assign(o2::constants::lhc::LHCMaxBunches, 0);
+  auto setBits = [this](std::vector<int> const& bcs, uint8_t bit) {
+    for (auto bcnum : bcs) {
+      if (bcnum >= 0 && bcnum < o2::constants::lhc::LHCMaxBunches) {
+        fBCTypeBits[bcnum] |= bit;
+      }
+    }
+  };
+  setBits(fP2BCsE, kBitE);
+  setBits(fP2BCsA, kBitA);
+  setBits(fP2BCsC, kBitC);
+  setBits(fP2BCsBB, kBitBB);
+}
+
 // -----------------------------------------------------------------------------
 std::string UDFSParser::patternString(int ibeam)
 {
@@ -173,28 +193,38 @@ bool UDFSParser::isInVector(int num, std::vector<int> vec)
   return !fisActive || find(vec.begin(), vec.end(), num) != vec.end();
 }
 
+// -----------------------------------------------------------------------------
+// same as isInVector with the vector of the given type, but with a single lookup
+bool UDFSParser::hasBCType(int bcnum, uint8_t bit)
+{
+  if (!fisActive) {
+    return true;
+  }
+  return bcnum >= 0 && bcnum < static_cast<int>(fBCTypeBits.size()) && (fBCTypeBits[bcnum] & bit);
+}
+
 // -----------------------------------------------------------------------------
 bool UDFSParser::isP2BCE(int bcnum)
 {
-  return isInVector(bcnum, fP2BCsE);
+  return hasBCType(bcnum, kBitE);
 }
 
 // -----------------------------------------------------------------------------
 bool UDFSParser::isP2BCA(int bcnum)
 {
-  return isInVector(bcnum, fP2BCsA);
+  return hasBCType(bcnum, kBitA);
 }
 
 // -----------------------------------------------------------------------------
 bool UDFSParser::isP2BCC(int bcnum)
 {
-  return isInVector(bcnum, fP2BCsC);
+  return hasBCType(bcnum, kBitC);
 }
 
 // -----------------------------------------------------------------------------
 bool UDFSParser::isP2BCBB(int bcnum)
 {
-  return isInVector(bcnum, fP2BCsBB);
+  return hasBCType(bcnum, kBitBB);
 }
 
 // -----------------------------------------------------------------------------
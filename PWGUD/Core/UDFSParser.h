@@ -12,6 +12,7 @@
 #ifndef PWGUD_CORE_UDFSPARSER_H_
 #define PWGUD_CORE_UDFSPARSER_H_
 
+#include <cstdint>
 #include <string>
 #include <vector>
 
@@ -58,6 +59,17 @@ class UDFSParser
   std::vector<int> fP2BCsC;  // C-side
   std::vector<int> fP2BCsBB; // BB
 
+  // per BC bits of the vectors above (1: E, 2: A, 4: C, 8: BB), filled by readFS to avoid searching the vectors per event
+  enum BCTypeBits : uint8_t {
+    kBitE = 1,
+    kBitA = 2,
+    kBitC = 4,
+    kBitBB = 8
+  };
+  std::vector<uint8_t> fBCTypeBits;
+  void fillBCTypeBits();
+  bool hasBCType(int bcnum, uint8_t bit);
+
   // helper functions for string parsing
   bool isNumber(std::string s);
   std::string trim(std::string str, std::string whitespace);
@@ -38,6 +38,7 @@
 #include <cstdint>
 #include <numeric>
 #include <type_traits>
+#include <utility>
 #include <vector>
 
 // namespace with helpers for UD framework
@@ -335,13 +336,128 @@ float FDDAmplitudeC(TFDD fdd)
   return std::accumulate(ampsC.begin(), ampsC.end(), 0);
 }
 
+// -----------------------------------------------------------------------------
+// Summed amplitudes, times and trigger masks of the FIT detectors found for a BC.
+// They are read from the UDBcFITs table if it is joined to the BCs table, otherwise
+// they are computed from the FV0As, FT0s and FDDs entries of the BC. Only valid if
+// the BC has the corresponding foundFV0, foundFT0 or foundFDD.
+template <typename T>
+float bcAmplitudeFV0A(T const& bc)
+{
+  if constexpr (requires { bc.bcAmpFV0A(); }) {
+    return bc.bcAmpFV0A();
+  } else {
+    return FV0AmplitudeA(bc.foundFV0());
+  }
+}
+
+template <typename T>
+float bcAmplitudeFT0A(T const& bc)
+{
+  if constexpr (requires { bc.bcAmpFT0A(); }) {
+    return bc.bcAmpFT0A();
+  } else {
+    return FT0AmplitudeA(bc.foundFT0());
+  }
+}
+
+template <typename T>
+float bcAmplitudeFT0C(T const& bc)
+{
+  if constexpr (requires { bc.bcAmpFT0C(); }) {
+    return bc.bcAmpFT0C();
+  } else {
+    return FT0AmplitudeC(bc.foundFT0());
+  }
+}
+
+template <typename T>
+float bcAmplitudeFDDA(T const& bc)
+{
+  if constexpr (requires { bc.bcAmpFDDA(); }) {
+    return bc.bcAmpFDDA();
+  } else {
+    return FDDAmplitudeA(bc.foundFDD());
+  }
+}
+
+template <typename T>
+float bcAmplitudeFDDC(T const& bc)
+{
+  if constexpr (requires { bc.bcAmpFDDC(); }) {
+    return bc.bcAmpFDDC();
+  } else {
+    return FDDAmplitudeC(bc.foundFDD());
+  }
+}
+
+template <typename T>
+float bcTimeFV0A(T const& bc)
+{
+  if constexpr (requires { bc.bcTimeFV0A(); }) {
+    return bc.bcTimeFV0A();
+  } else {
+    return bc.foundFV0().time();
+  }
+}
+
+template <typename T>
+float bcTimeFT0A(T const& bc)
+{
+  if constexpr (requires { bc.bcTimeFT0A(); }) {
+    return bc.bcTimeFT0A();
+  } else {
+    return bc.foundFT0().timeA();
+  }
+}
+
+template <typename T>
+float bcTimeFT0C(T const& bc)
+{
+  if constexpr (requires { bc.bcTimeFT0C(); }) {
+    return bc.bcTimeFT0C();
+  } else {
+    return bc.foundFT0().timeC();
+  }
+}
+
+template <typename T>
+float bcTimeFDDA(T const& bc)
+{
+  if constexpr (requires { bc.bcTimeFDDA(); }) {
+    return bc.bcTimeFDDA();
+  } else {
+    return bc.foundFDD().timeA();
+  }
+}
+
+template <typename T>
+float bcTimeFDDC(T const& bc)
+{
+  if constexpr (requires { bc.bcTimeFDDC(); }) {
+    return bc.bcTimeFDDC();
+  } else {
+    return bc.foundFDD().timeC();
+  }
+}
+
+template <typename T>
+uint8_t bcTriggerMaskFT0(T const& bc)
+{
+  if constexpr (requires { bc.bcTriggerMaskFT0(); }) {
+    return bc.bcTriggerMaskFT0();
+  } else {
+    return bc.foundFT0().triggerMask();
+  }
+}
+
 // -----------------------------------------------------------------------------
 template <typename T>
 bool cleanFV0(T& bc, float maxFITtime, float limitA)
 {
   if (bc.has_foundFV0() && limitA >= 0.) {
-    bool ota = std::abs(bc.foundFV0().time()) <= maxFITtime;
-    bool oma = FV0AmplitudeA(bc.foundFV0()) <= limitA;
+    bool ota = std::abs(bcTimeFV0A(bc)) <= maxFITtime;
+    bool oma = bcAmplitudeFV0A(bc) <= limitA;
     return ota && oma;
   } else {
     return true;
@@ -353,8 +469,8 @@ template <typename T>
 bool cleanFT0A(T& bc, float maxFITtime, float limitA)
 {
   if (bc.has_foundFT0() && limitA >= 0.) {
-    bool ota = std::abs(bc.foundFT0().timeA()) <= maxFITtime;
-    bool oma = FT0AmplitudeA(bc.foundFT0()) <= limitA;
+    bool ota = std::abs(bcTimeFT0A(bc)) <= maxFITtime;
+    bool oma = bcAmplitudeFT0A(bc) <= limitA;
     return ota && oma;
   } else {
     return true;
@@ -366,8 +482,8 @@ template <typename T>
 bool cleanFT0C(T& bc, float maxFITtime, float limitC)
 {
   if (bc.has_foundFT0() && limitC >= 0.) {
-    bool otc = std::abs(bc.foundFT0().timeC()) <= maxFITtime;
-    bool omc = FT0AmplitudeC(bc.foundFT0()) <= limitC;
+    bool otc = std::abs(bcTimeFT0C(bc)) <= maxFITtime;
+    bool omc = bcAmplitudeFT0C(bc) <= limitC;
     return otc && omc;
   } else {
     return true;
@@ -379,8 +495,8 @@ template <typename T>
 bool cleanFDDA(T& bc, float maxFITtime, float limitA)
 {
   if (bc.has_foundFDD() && limitA >= 0.) {
-    bool ota = std::abs(bc.foundFDD().timeA()) <= maxFITtime;
-    bool oma = FDDAmplitudeA(bc.foundFDD()) <= limitA;
+    bool ota = std::abs(bcTimeFDDA(bc)) <= maxFITtime;
+    bool oma = bcAmplitudeFDDA(bc) <= limitA;
     return ota && oma;
   } else {
     return true;
@@ -392,8 +508,8 @@ template <typename T>
 bool cleanFDDC(T& bc, float maxFITtime, float limitC)
 {
   if (bc.has_foundFDD() && limitC >= 0.) {
-    bool otc = std::abs(bc.foundFDD().timeC()) <= maxFITtime;
-    bool omc = FDDAmplitudeC(bc.foundFDD()) <= limitC;
+    bool otc = std::abs(bcTimeFDDC(bc)) <= maxFITtime;
+    bool omc = bcAmplitudeFDDC(bc) <= limitC;
     return otc && omc;
   } else {
     return true;
@@ -425,14 +541,14 @@ bool cleanFDD(T& bc, float maxFITtime, float limitA, float limitC)
 //  lims[4]: FDDC
 
 template <typename T>
-bool cleanFIT(T& bc, float maxFITtime, std::vector<float> lims)
+bool cleanFIT(T& bc, float maxFITtime, std::vector<float> const& lims)
 {
   return cleanFV0(bc, maxFITtime, lims[0]) &&
          cleanFT0(bc, maxFITtime, lims[1], lims[2]) &&
          cleanFDD(bc, maxFITtime, lims[3], lims[4]);
 }
 template <typename T>
-bool cleanFITCollision(T& col, float maxFITtime, std::vector<float> lims)
+bool cleanFITCollision(T& col, float maxFITtime, std::vector<float> const& lims)
 {
   bool isCleanFV0 = true;
   if (col.has_foundFV0()) {
@@ -453,7 +569,7 @@ bool cleanFITCollision(T& col, float maxFITtime, std::vector<float> lims)
 
 // -----------------------------------------------------------------------------
 template <typename T>
-bool cleanFITA(T& bc, float maxFITtime, std::vector<float> lims)
+bool cleanFITA(T& bc, float maxFITtime, std::vector<float> const& lims)
 {
   return cleanFV0(bc, maxFITtime, lims[0]) &&
          cleanFT0A(bc, maxFITtime, lims[1]) &&
@@ -462,20 +578,135 @@ bool cleanFITA(T& bc, float maxFITtime, std::vector<float> lims)
 
 // -----------------------------------------------------------------------------
 template <typename T>
-bool cleanFITC(T& bc, float maxFITtime, std::vector<float> lims)
+bool cleanFITC(T& bc, float maxFITtime, std::vector<float> const& lims)
 {
   return cleanFT0C(bc, maxFITtime, lims[2]) &&
          cleanFDDC(bc, maxFITtime, lims[4]);
 }
 
+// -----------------------------------------------------------------------------
+// Index of the BCs table of a data frame, for the many compatibleBCs queries of a DF.
+// The globalBCs of the table are copied into a flat array, so that a BC range is found
+// with a binary search instead of walking the table. Optionally the cleanFITA and cleanFITC
+// flags of all BCs are evaluated once and stored as prefix sums of the not clean BCs, then
+// the gap of a BC range is the difference of two counters.
+class BCIndex
+{
+ public:
+  // rebuilds the index if it was made for another BCs table, returns true if rebuilt
+  template <typename T>
+  bool update(T const& bcs)
+  {
+    if (isValid(bcs)) {
+      return false;
+    }
+    mGlobalBCs.clear();
+    mGlobalBCs.reserve(bcs.size());
+    for (auto const& bc : bcs) {
+      mGlobalBCs.push_back(bc.globalBC());
+    }
+    mNotCleanA.clear();
+    mNotCleanC.clear();
+    return true;
+  }
+
+  // same as update, and fills the clean FIT flags for the given cuts
+  template <typename T>
+  void updateCleanFIT(T const& bcs, float maxFITtime, std::vector<float> const& lims)
+  {
+    if (!update(bcs) && hasCleanFIT(maxFITtime, lims)) {
+      return;
+    }
+    mMaxFITtime = maxFITtime;
+    mFITAmpLimits = lims;
+    mNotCleanA.assign(1, 0);
+    mNotCleanC.assign(1, 0);
+    mNotCleanA.reserve(mGlobalBCs.size() + 1);
+    mNotCleanC.reserve(mGlobalBCs.size() + 1);
+    for (auto const& bc : bcs) {
+      mNotCleanA.push_back(mNotCleanA.back() + !cleanFITA(bc, maxFITtime, lims));
+      mNotCleanC.push_back(mNotCleanC.back() + !cleanFITC(bc, maxFITtime, lims));
+    }
+  }
+
+  int64_t size() const { return mGlobalBCs.size(); }
+
+  // rows [first, last) of the BCs with globalBC in meanBC +- deltaBC
+  std::pair<int64_t, int64_t> rows(uint64_t meanBC, int deltaBC) const
+  {
+    uint64_t minBC = static_cast<uint64_t>(deltaBC) < meanBC ? meanBC - static_cast<uint64_t>(deltaBC) : 0;
+    uint64_t maxBC = meanBC + static_cast<uint64_t>(deltaBC);
+    auto first = std::lower_bound(mGlobalBCs.begin(), mGlobalBCs.end(), minBC);
+    auto last = std::upper_bound(first, mGlobalBCs.end(), maxBC);
+    return {first - mGlobalBCs.begin(), last - mGlobalBCs.begin()};
+  }
+
+  bool hasCleanFIT(float maxFITtime, std::vector<float> const& lims) const
+  {
+    return mNotCleanA.size() == mGlobalBCs.size() + 1 && maxFITtime == mMaxFITtime && lims == mFITAmpLimits;
+  }
+
+  // clean FIT A (C) side in all BCs of the rows [first, last)
+  bool isCleanFITA(int64_t first, int64_t last) const { return mNotCleanA[last] == mNotCleanA[first]; }
+  bool isCleanFITC(int64_t first, int64_t last) const { return mNotCleanC[last] == mNotCleanC[first]; }
+
+ private:
+  // the table is identified by its size and its first and last globalBC
+  template <typename T>
+  bool isValid(T const& bcs) const
+  {
+    if (static_cast<int64_t>(bcs.size()) != size()) {
+      return false;
+    }
+    return mGlobalBCs.empty() || (bcs.iteratorAt(0).globalBC() == mGlobalBCs.front() && bcs.iteratorAt(bcs.size() - 1).globalBC() == mGlobalBCs.back());
+  }
+
+  std::vector<uint64_t> mGlobalBCs;
+  std::vector<int32_t> mNotCleanA; // number of not clean BCs before each row, size + 1 entries
+  std::vector<int32_t> mNotCleanC;
+  float mMaxFITtime = 0.;
+  std::vector<float> mFITAmpLimits;
+};
+
+// In this variant of compatibleBCs the range of compatible BCs is defined by meanBC +- deltaBC
+// and found with the index of the BCs table bcs.
+template <typename T>
+T compatibleBCs(BCIndex const& index, uint64_t const& meanBC, int const& deltaBC, T const& bcs)
+{
+  auto [first, last] = index.rows(meanBC, deltaBC);
+  if (first == last) {
+    LOGF(debug, "<compatibleBCs> No BC in [%d, %d]", meanBC - deltaBC, meanBC + deltaBC);
+    return bcs.emptySlice();
+  }
+  auto bcslice = bcs.rawSlice(first, last - first);
+  bcs.copyIndexBindings(bcslice);
+  LOGF(debug, "  size of slice %d", bcslice.size());
+  return bcslice;
+}
+
+// Same as compatibleBCs(collision, ndt, bcs, nMinBCs) with the index of the BCs table bcs.
+template <typename C, typename T>
+T compatibleBCs(BCIndex const& index, C const& collision, int ndt, T const& bcs, int nMinBCs = 7)
+{
+  if (!collision.has_foundBC() || ndt < 0) {
+    return bcs.emptySlice();
+  }
+  auto bcIter = collision.template foundBC_as<T>();
+  uint64_t meanBC = bcIter.globalBC() + std::lround(collision.collisionTime() / o2::constants::lhc::LHCBunchSpacingNS);
+  int deltaBC = std::ceil(collision.collisionTimeRes() / o2::constants::lhc::LHCBunchSpacingNS * ndt);
+  if (deltaBC < nMinBCs) {
+    deltaBC = nMinBCs;
+  }
+  return compatibleBCs(index, meanBC, deltaBC, bcs);
+}
+
 // -----------------------------------------------------------------------------
 template <typename T>
 bool TVX(T& bc)
 {
   bool tvx = false;
   if (bc.has_foundFT0()) {
-    auto ft0 = bc.foundFT0();
-    tvx = TESTBIT(ft0.triggerMask(), o2::fit::Triggers::bitVertex);
+    tvx = TESTBIT(bcTriggerMaskFT0(bc), o2::fit::Triggers::bitVertex);
   }
   return tvx;
 }
@@ -486,8 +717,7 @@ bool TSC(T& bc)
 {
   bool tsc = false;
   if (bc.has_foundFT0()) {
-    auto ft0 = bc.foundFT0();
-    tsc = TESTBIT(ft0.triggerMask(), o2::fit::Triggers::bitSCen);
+    tsc = TESTBIT(bcTriggerMaskFT0(bc), o2::fit::Triggers::bitSCen);
   }
   return tsc;
 }
@@ -498,8 +728,7 @@ bool TCE(T& bc)
 {
   bool tce = false;
   if (bc.has_foundFT0()) {
-    auto ft0 = bc.foundFT0();
-    tce = TESTBIT(ft0.triggerMask(), o2::fit::Triggers::bitCen);
+    tce = TESTBIT(bcTriggerMaskFT0(bc), o2::fit::Triggers::bitCen);
   }
   return tce;
 }
@@ -833,9 +1062,9 @@ void fillBGBBFlags(upchelpers::FITInfo& info, uint64_t const& minbc, BCR const&
 }
 
 // -----------------------------------------------------------------------------
-// extract FIT information
-template <typename BC, typename BCS>
-void getFITinfo(upchelpers::FITInfo& info, BC& bc, BCS const& bcs, o2::aod::FT0s const& ft0s, o2::aod::FV0As const& fv0as, o2::aod::FDDs const& fdds)
+// amplitudes, times and trigger masks of the FIT detectors found for bc
+template <typename BC>
+void fillFITinfo(upchelpers::FITInfo& info, BC const& bc, o2::aod::FT0s const& ft0s, o2::aod::FV0As const& fv0as, o2::aod::FDDs const& fdds)
 {
   // FV0A
   if (bc.has_foundFV0()) {
@@ -864,6 +1093,31 @@ void getFITinfo(upchelpers::FITInfo& info, BC& bc, BCS const& bcs, o2::aod::FT0s
     info.ampFDDC = FDDAmplitudeC(fdd);
     info.triggerMaskFDD = fdd.triggerMask();
   }
+}
+
+// -----------------------------------------------------------------------------
+// extract FIT information
+template <typename BC, typename BCS>
+void getFITinfo(upchelpers::FITInfo& info, BC& bc, BCS const& bcs, o2::aod::FT0s const& ft0s, o2::aod::FV0As const& fv0as, o2::aod::FDDs const& fdds)
+{
+  // FV0A, FT0 and FDD from the UDBcFITs table if joined to the BCs table
+  if constexpr (requires { bc.bcAmpFV0A(); }) {
+    info.timeFV0A = bc.bcTimeFV0A();
+    info.ampFV0A = bc.bcAmpFV0A();
+    info.triggerMaskFV0A = bc.bcTriggerMaskFV0A();
+    info.timeFT0A = bc.bcTimeFT0A();
+    info.timeFT0C = bc.bcTimeFT0C();
+    info.ampFT0A = bc.bcAmpFT0A();
+    info.ampFT0C = bc.bcAmpFT0C();
+    info.triggerMaskFT0 = bc.bcTriggerMaskFT0();
+    info.timeFDDA = bc.bcTimeFDDA();
+    info.timeFDDC = bc.bcTimeFDDC();
+    info.ampFDDA = bc.bcAmpFDDA();
+    info.ampFDDC = bc.bcAmpFDDC();
+    info.triggerMaskFDD = bc.bcTriggerMaskFDD();
+  } else {
+    fillFITinfo(info, bc, ft0s, fv0as, fdds);
+  }
 
   // fill BG and BB flags
   auto bcnum = bc.globalBC();
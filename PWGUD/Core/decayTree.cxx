@@ -907,14 +907,21 @@ void decayTree::updateParents()
   // reset parents
   for (const auto& res : fResonances) {
     res->clearParents();
+    res->clearDaughterResonances();
   }
 
+  // the daughters and the finals are also resolved here once, the combinatorics use the pointers
   for (const auto& res : fResonances) {
     for (const auto& daughName : res->getDaughters()) {
       auto daugh = getResonance(daughName);
       daugh->addParent(res->name());
+      res->addDaughterResonance(daugh);
     }
   }
+  fFinalsByCounter.clear();
+  for (auto ind = 0; ind < fnFinals; ind++) {
+    fFinalsByCounter.push_back(getFinal(ind));
+  }
 }
 
 void decayTree::reset()
@@ -1067,7 +1074,7 @@ void decayTree::updateChargeState()
 
   // loop over all finals
   for (auto ind = 0; ind < fnFinals; ind++) {
-    fChargeState += (getFinal(ind)->charge() > 0) * std::pow(2, ind);
+    fChargeState += (fFinalsByCounter[ind]->charge() > 0) * std::pow(2, ind);
   }
 }
 
@@ -197,8 +197,8 @@ class reconstructedParticle
   ~reconstructedParticle() {}
 
   std::string name() { return fName; }
-  TLorentzVector lv() { return fIVM; }
-  std::vector<int> comb() { return fComb; }
+  TLorentzVector const& lv() const { return fIVM; }
+  std::vector<int> const& comb() const { return fComb; }
 
  private:
   std::string fName;
@@ -257,6 +257,8 @@ class resonance
   void clearParents() { fParents.clear(); }
   void addParent(std::string parent) { fParents.push_back(parent); }
   void setDaughters(std::vector<std::string>& daughters) { fDaughters = daughters; }
+  void clearDaughterResonances() { fDaughterResonances.clear(); }
+  void addDaughterResonance(resonance* daughter) { fDaughterResonances.push_back(daughter); }
   void setIVM(TLorentzVector ivm)
   {
     fIVM = ivm;
@@ -323,6 +325,7 @@ class resonance
   std::vector<int> detectorHits() { return fdetectorHits; }
   std::vector<std::string> getParents() { return fParents; }
   std::vector<std::string> getDaughters() { return fDaughters; }
+  std::vector<resonance*> const& getDaughterResonances() { return fDaughterResonances; }
   double massMin() { return fmassMin; }
   double massMax() { return fmassMax; }
   double ptMin() { return fptMin; }
@@ -419,6 +422,7 @@ class resonance
   // name of parents and daughters
   std::vector<std::string> fParents;
   std::vector<std::string> fDaughters;
+  std::vector<resonance*> fDaughterResonances; // the daughters resolved by name once, see decayTree::updateParents
   void updateParents();
 
   // mass, pT, , eta range
@@ -518,7 +522,20 @@ class decayTree
       }
 
       // loop over resonances and compute
+      // the finals first, a combination with a rejected final can not be accepted
       reset();
+      bool finalsAccepted = true;
+      for (auto res : fFinalsByCounter) {
+        computeResonance(res, tracks, comb);
+        if (res->status() < 3) {
+          finalsAccepted = false;
+          break;
+        }
+      }
+      if (!finalsAccepted) {
+        LOGF(debug, "    A final is rejected!");
+        continue;
+      }
       for (auto res : fResonances) {
         computeResonance(res, tracks, comb);
       }
@@ -551,7 +568,7 @@ class decayTree
 
 #define getHist(type, name) std::get<std::shared_ptr<type>>(fhistPointers[name])
   template <typename TTs>
-  void fillHistograms(decayTreeResType results, TTs const& tracks)
+  void fillHistograms(decayTreeResType& results, TTs const& tracks)
   {
     // fill the histograms
     std::string base;
@@ -561,12 +578,12 @@ class decayTree
     // results["LS"] contains the LS results
     for (const auto& cc : fccs) {
       // result is a std::vector<std::map<std::string, reconstructedParticle>>
-      for (auto result : results[cc]) {
+      for (auto& result : results[cc]) {
 
         // loop over the reconstructed particles
         //  rec.first:  name of the reconstructed particle
         //  rec.second: reconstructed particle
-        for (auto rec : result) {
+        for (auto const& rec : result) {
           auto lv = rec.second.lv();
           base = cc;
           base.append("/").append(rec.first).append("/");
@@ -760,6 +777,7 @@ class decayTree
 
   // number of finals
   int fnFinals;
+  std::vector<resonance*> fFinalsByCounter; // the finals ordered by counter, see updateParents
   std::vector<std::vector<int>> fPermutations;
 
   // histogram registry
@@ -819,8 +837,7 @@ class decayTree
     } else {
       // is a resonance
       // loop over daughters
-      for (const auto& daughName : res->getDaughters()) {
-        auto daugh = getResonance(daughName);
+      for (const auto& daugh : res->getDaughterResonances()) {
         computeResonance(daugh, tracks, comb);
         ivm += daugh->IVM();
         charge += daugh->charge();
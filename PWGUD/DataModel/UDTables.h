@@ -433,6 +433,31 @@ DECLARE_SOA_TABLE(UDCollisionFITBits, "AOD", "UDCOLLFITBITS",
                   udcollfitbits::Thr2W3  /// 2 MIP thresholds for FT0C ch 97 - 112 & FV0 0 - 47
 );
 
+namespace udbcfit
+{
+DECLARE_SOA_COLUMN(BcAmpFV0A, bcAmpFV0A, float);                   //! summed FV0A amplitude, -1 if no FV0A
+DECLARE_SOA_COLUMN(BcAmpFT0A, bcAmpFT0A, float);                   //! summed FT0A amplitude, -1 if no FT0
+DECLARE_SOA_COLUMN(BcAmpFT0C, bcAmpFT0C, float);                   //! summed FT0C amplitude, -1 if no FT0
+DECLARE_SOA_COLUMN(BcAmpFDDA, bcAmpFDDA, float);                   //! summed FDDA charge, -1 if no FDD
+DECLARE_SOA_COLUMN(BcAmpFDDC, bcAmpFDDC, float);                   //! summed FDDC charge, -1 if no FDD
+DECLARE_SOA_COLUMN(BcTimeFV0A, bcTimeFV0A, float);                 //! FV0A time, -999 if no FV0A
+DECLARE_SOA_COLUMN(BcTimeFT0A, bcTimeFT0A, float);                 //! FT0A time, -999 if no FT0
+DECLARE_SOA_COLUMN(BcTimeFT0C, bcTimeFT0C, float);                 //! FT0C time, -999 if no FT0
+DECLARE_SOA_COLUMN(BcTimeFDDA, bcTimeFDDA, float);                 //! FDDA time, -999 if no FDD
+DECLARE_SOA_COLUMN(BcTimeFDDC, bcTimeFDDC, float);                 //! FDDC time, -999 if no FDD
+DECLARE_SOA_COLUMN(BcTriggerMaskFV0A, bcTriggerMaskFV0A, uint8_t); //! FV0A trigger mask
+DECLARE_SOA_COLUMN(BcTriggerMaskFT0, bcTriggerMaskFT0, uint8_t);   //! FT0 trigger mask
+DECLARE_SOA_COLUMN(BcTriggerMaskFDD, bcTriggerMaskFDD, uint8_t);   //! FDD trigger mask
+} // namespace udbcfit
+
+// FIT summary of the BCs, joinable with the BCs table
+DECLARE_SOA_TABLE(UDBcFITs, "AOD", "UDBCFIT", //!
+                  udbcfit::BcAmpFV0A, udbcfit::BcAmpFT0A, udbcfit::BcAmpFT0C, udbcfit::BcAmpFDDA, udbcfit::BcAmpFDDC,
+                  udbcfit::BcTimeFV0A, udbcfit::BcTimeFT0A, udbcfit::BcTimeFT0C, udbcfit::BcTimeFDDA, udbcfit::BcTimeFDDC,
+                  udbcfit::BcTriggerMaskFV0A, udbcfit::BcTriggerMaskFT0, udbcfit::BcTriggerMaskFDD);
+
+using UDBcFIT = UDBcFITs::iterator;
+
 using UDTrack = UDTracks::iterator;
 using UDTrackCov = UDTracksCov::iterator;
 using UDTrackExtra = UDTracksExtra::iterator;
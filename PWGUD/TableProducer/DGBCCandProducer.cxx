@@ -285,8 +285,11 @@ struct DGBCCandProducer {
   DGCutparHolder diffCuts = DGCutparHolder();
   Configurable<DGCutparHolder> DGCuts{"DGCuts", {}, "DG event cuts"};
 
+  Configurable<bool> useBCIndex{"useBCIndex", false, "Find the compatible BCs with a per data frame index of the BCs table"};
+
   // DG selector
   DGSelector dgSelector;
+  udhelpers::BCIndex bcIndex;
 
   HistogramRegistry registry{
     "registry",
@@ -408,6 +411,10 @@ struct DGBCCandProducer {
                      TCs const& tracks, aod::FwdTracks const& fwdtracks, FTIBCs const& ftibcs,
                      aod::Zdcs const& /*zdcs*/, aod::FT0s const& ft0s, aod::FV0As const& fv0as, aod::FDDs const& fdds)
   {
+    if (useBCIndex) {
+      bcIndex.update(bcs);
+    }
+
     // fill FITInfo
     auto bcnum = tibc.bcnum();
     upchelpers::FITInfo fitInfo{};
@@ -438,7 +445,7 @@ struct DGBCCandProducer {
 
         auto colTracks = tracks.sliceByCached(aod::track::collisionId, col.globalIndex(), cache);
         auto colFwdTracks = fwdtracks.sliceByCached(aod::fwdtrack::collisionId, col.globalIndex(), cache);
-        auto bcRange = udhelpers::compatibleBCs(col, diffCuts.NDtcoll(), bcs, diffCuts.minNBCs());
+        auto bcRange = useBCIndex ? udhelpers::compatibleBCs(bcIndex, col, diffCuts.NDtcoll(), bcs, diffCuts.minNBCs()) : udhelpers::compatibleBCs(col, diffCuts.NDtcoll(), bcs, diffCuts.minNBCs());
         isDG = dgSelector.IsSelected(diffCuts, col, bcRange, colTracks, colFwdTracks);
 
         // update UDTables, case 1.
@@ -456,7 +463,7 @@ struct DGBCCandProducer {
       } else {
         LOGF(debug, "  2. BC has NO collision");
         auto tracksArray = tibc.track_as<TCs>();
-        auto bcRange = udhelpers::compatibleBCs(bc, bc.globalBC(), diffCuts.minNBCs(), bcs);
+        auto bcRange = useBCIndex ? udhelpers::compatibleBCs(bcIndex, bc.globalBC(), diffCuts.minNBCs(), bcs) : udhelpers::compatibleBCs(bc, bc.globalBC(), diffCuts.minNBCs(), bcs);
 
         // does BC have fwdTracks?
         if (ftibcs.size() > 0) {
@@ -502,7 +509,7 @@ struct DGBCCandProducer {
 
       // the BC is not contained in the BCs table
       auto tracksArray = tibc.track_as<TCs>();
-      auto bcRange = udhelpers::compatibleBCs(bcnum, diffCuts.minNBCs(), bcs);
+      auto bcRange = useBCIndex ? udhelpers::compatibleBCs(bcIndex, bcnum, diffCuts.minNBCs(), bcs) : udhelpers::compatibleBCs(bcnum, diffCuts.minNBCs(), bcs);
 
       // does BC have fwdTracks?
       if (ftibcs.size() > 0) {
@@ -568,6 +575,9 @@ struct DGBCCandProducer {
     if (bcs.size() <= 0) {
       return;
     }
+    if (useBCIndex) {
+      bcIndex.update(bcs);
+    }
 
     // run over all BC in bcs and tibcs
     // int64_t lastCollision = 0;
@@ -633,7 +643,7 @@ struct DGBCCandProducer {
           // lastCollision = col.globalIndex();
 
           ntr1 = col.numContrib();
-          auto bcRange = udhelpers::compatibleBCs(bc, bcnum, diffCuts.minNBCs(), bcs);
+          auto bcRange = useBCIndex ? udhelpers::compatibleBCs(bcIndex, bcnum, diffCuts.minNBCs(), bcs) : udhelpers::compatibleBCs(bc, bcnum, diffCuts.minNBCs(), bcs);
           auto colTracks = tracks.sliceByCached(aod::track::collisionId, col.globalIndex(), cache);
           auto colFwdTracks = fwdtracks.sliceByCached(aod::fwdtrack::collisionId, col.globalIndex(), cache);
           isDG1 = dgSelector.IsSelected(diffCuts, col, bcRange, colTracks, colFwdTracks);
@@ -671,7 +681,7 @@ struct DGBCCandProducer {
         if (tibc.bcnum() == bcnum) {
           SETBIT(bcFlag, 4);
 
-          auto bcRange = udhelpers::compatibleBCs(bc, bcnum, diffCuts.minNBCs(), bcs);
+          auto bcRange = useBCIndex ? udhelpers::compatibleBCs(bcIndex, bcnum, diffCuts.minNBCs(), bcs) : udhelpers::compatibleBCs(bc, bcnum, diffCuts.minNBCs(), bcs);
           auto tracksArray = tibc.track_as<TCs>();
           ntr2 = tracksArray.size();
 
@@ -73,6 +73,7 @@ struct SGCandProducer {
   using CC = CCs::iterator;
   using BCs = soa::Join<aod::BCsWithTimestamps, aod::BcSels, aod::Run3MatchedToBCSparse>;
   using BC = BCs::iterator;
+  using BCsWithFIT = soa::Join<aod::BCsWithTimestamps, aod::BcSels, aod::Run3MatchedToBCSparse, aod::UDBcFITs>;
   using TCs = soa::Join<aod::Tracks, /*aod::TracksCov,*/ aod::TracksExtra, aod::TracksDCA, aod::TrackSelection,
                         aod::pidTPCFullEl, aod::pidTPCFullMu, aod::pidTPCFullPi, aod::pidTPCFullKa, aod::pidTPCFullPr,
                         aod::pidTPCFullDe, aod::pidTPCFullTr, aod::pidTPCFullHe, aod::pidTPCFullAl,
@@ -109,9 +110,11 @@ struct SGCandProducer {
   // Configurables to decide which tables are filled
   Configurable<bool> fillTrackTables{"fillTrackTables", true, "Fill track tables"};
   Configurable<bool> fillFwdTrackTables{"fillFwdTrackTables", true, "Fill forward track tables"};
+  Configurable<bool> useBCIndex{"useBCIndex", false, "Find the compatible BCs and the FIT gaps with a per data frame index of the BCs table"};
 
   // SG selector
   SGSelector sgSelector;
+  udhelpers::BCIndex bcIndex;
   ctpRateFetcher mRateFetcher;
 
   // initialize RCT flag checker
@@ -223,8 +226,8 @@ struct SGCandProducer {
   }
 
   // function to process reconstructed data
-  template <typename TCol>
-  void processReco(std::string histdir, TCol const& collision, BCs const& bcs,
+  template <typename TCol, typename TBCs>
+  void processReco(std::string histdir, TCol const& collision, TBCs const& bcs,
                    TCs const& tracks, FWs const& fwdtracks,
                    aod::FV0As const& fv0as, aod::FT0s const& ft0s, aod::FDDs const& fdds)
   {
@@ -281,7 +284,7 @@ struct SGCandProducer {
     const int sbp = collision.selection_bit(o2::aod::evsel::kNoSameBunchPileup) ? 1 : 0;
     const int zVtxFT0vPv = collision.selection_bit(o2::aod::evsel::kIsGoodZvtxFT0vsPV) ? 1 : 0;
     const int vtxITSTPC = collision.selection_bit(o2::aod::evsel::kIsVertexITSTPC) ? 1 : 0;
-    auto bc = collision.template foundBC_as<BCs>();
+    auto bc = collision.template foundBC_as<TBCs>();
     double ir = 0.;
     const uint64_t ts = bc.timestamp();
     const int runnumber = bc.runNumber();
@@ -291,7 +294,10 @@ struct SGCandProducer {
     auto newbc = bc;
 
     // obtain slice of compatible BCs
-    auto bcRange = udhelpers::compatibleBCs(collision, sameCuts.NDtcoll(), bcs, sameCuts.minNBCs());
+    if (useBCIndex) {
+      bcIndex.updateCleanFIT(bcs, sameCuts.maxFITtime(), sameCuts.FITAmpLimits());
+    }
+    auto bcRange = useBCIndex ? udhelpers::compatibleBCs(bcIndex, collision, sameCuts.NDtcoll(), bcs, sameCuts.minNBCs()) : udhelpers::compatibleBCs(collision, sameCuts.NDtcoll(), bcs, sameCuts.minNBCs());
     auto isSGEvent = sgSelector.IsSelected(sameCuts, collision, bcRange, bc);
     // auto isSGEvent = sgSelector.IsSelected(sameCuts, collision, bcRange, tracks);
     int issgevent = isSGEvent.value;
@@ -396,7 +402,7 @@ struct SGCandProducer {
 
     // add histograms for the different process functions
     histPointers.clear();
-    if (context.mOptions.get<bool>("processData")) {
+    if (context.mOptions.get<bool>("processData") || context.mOptions.get<bool>("processDataWithFITSummary")) {
       histPointers.insert({"reco/Stat", registry.add("reco/Stat", "Cut statistics; Selection criterion; Collisions", {HistType::kTH1F, {{14, -0.5, 13.5}}})});
 
       const AxisSpec axisCountersTrg{10, 0.5, 10.5, ""};
@@ -422,6 +428,9 @@ struct SGCandProducer {
     if (isGoodRCTZdc) {
       myRCTChecker.init("CBT", true);
     }
+    if (useBCIndex) {
+      sgSelector.setBCIndex(&bcIndex);
+    }
   }
 
   // process function for reconstructed data
@@ -432,6 +441,14 @@ struct SGCandProducer {
   }
   PROCESS_SWITCH(SGCandProducer, processData, "Produce UD table with data", true);
 
+  // same as processData with the FIT information of the BCs from the UDBcFITs table (ud-bc-fit-producer)
+  void processDataWithFITSummary(CC const& collision, BCsWithFIT const& bcs, TCs const& tracks, FWs const& fwdtracks,
+                                 aod::Zdcs const& /*zdcs*/, aod::FV0As const& fv0as, aod::FT0s const& ft0s, aod::FDDs const& fdds)
+  {
+    processReco(std::string("reco"), collision, bcs, tracks, fwdtracks, fv0as, ft0s, fdds);
+  }
+  PROCESS_SWITCH(SGCandProducer, processDataWithFITSummary, "Produce UD table with data and the FIT summary of the BCs", false);
+
   // process function for reconstructed MC data
   void processMcData(MCCC const& collision, aod::McCollisions const& /*mccollisions*/, BCs const& bcs,
                      TCs const& tracks, FWs const& fwdtracks, aod::Zdcs const& /*zdcs*/, aod::FV0As const& fv0as,
@@ -481,6 +498,24 @@ struct McSGCandProducer {
     "registry",
     {}};
 
+  // dense old to new index maps of the data frame, -1 if not saved
+  std::vector<int64_t> mcColIsSaved;
+  std::vector<int64_t> mcPartIsSaved;
+  std::vector<int64_t> mcPartNewId; // UDMcParticles index of the particles of the McCollision being saved
+  std::vector<int32_t> newmids;
+
+  void resetIndexMaps(aod::McCollisions const& mccols, aod::McParticles const& mcparts)
+  {
+    mcColIsSaved.assign(mccols.size(), -1);
+    mcPartIsSaved.assign(mcparts.size(), -1);
+    mcPartNewId.assign(mcparts.size(), -1);
+  }
+
+  static int64_t newIndex(std::vector<int64_t> const& oldnew, int64_t oldId)
+  {
+    return oldId >= 0 && oldId < static_cast<int64_t>(oldnew.size()) ? oldnew[oldId] : -1;
+  }
+
   template <typename TMcCollision>
   void updateUDMcCollisions(TMcCollision const& mccol, uint64_t globBC)
   {
@@ -496,16 +531,16 @@ struct McSGCandProducer {
   }
 
   template <typename TMcParticle>
-  void updateUDMcParticle(TMcParticle const& McPart, int64_t McCollisionId, std::map<int64_t, int64_t>& mcPartIsSaved)
+  void updateUDMcParticle(TMcParticle const& McPart, int64_t McCollisionId)
   {
     // save McPart
     // mother and daughter indices are set to -1
     // ATTENTION: this can be improved to also include mother and daughter indices
-    std::vector<int32_t> newmids;
+    newmids.clear();
     int32_t newdids[2] = {-1, -1};
 
     // update UDMcParticles
-    if (mcPartIsSaved.find(McPart.globalIndex()) == mcPartIsSaved.end()) {
+    if (mcPartIsSaved[McPart.globalIndex()] < 0) {
       outputMcParticles(McCollisionId,
                         McPart.pdgCode(),
                         McPart.statusCode(),
@@ -522,55 +557,36 @@ struct McSGCandProducer {
   }
 
   template <typename TMcParticles>
-  void updateUDMcParticles(TMcParticles const& McParts, int64_t McCollisionId, std::map<int64_t, int64_t>& mcPartIsSaved)
+  void updateUDMcParticles(TMcParticles const& McParts, int64_t McCollisionId)
   {
     // save McParts
     // new mother and daughter ids
-    std::vector<int32_t> newmids;
     int32_t newdids[2] = {-1, -1};
-    int64_t newval = -1;
 
     // Determine the particle indices within the UDMcParticles table
     // before filling the table
     // This is needed to be able to assign the new daughter indices
-    std::map<int64_t, int64_t> oldnew;
     auto lastId = outputMcParticles.lastIndex();
     for (const auto& mcpart : McParts) {
       auto oldId = mcpart.globalIndex();
-      if (mcPartIsSaved.find(oldId) != mcPartIsSaved.end()) {
-        oldnew[oldId] = mcPartIsSaved[oldId];
-      } else {
-        lastId++;
-        oldnew[oldId] = lastId;
-      }
+      mcPartNewId[oldId] = mcPartIsSaved[oldId] >= 0 ? mcPartIsSaved[oldId] : ++lastId;
     }
 
     // all particles of the McCollision are saved
     for (const auto& mcpart : McParts) {
-      if (mcPartIsSaved.find(mcpart.globalIndex()) == mcPartIsSaved.end()) {
-        // mothers
+      if (mcPartIsSaved[mcpart.globalIndex()] < 0) {
+        // mothers, only those which are saved already
         newmids.clear();
         auto oldmids = mcpart.mothersIds();
         for (const auto& oldmid : oldmids) {
-          auto m = McParts.rawIteratorAt(oldmid);
           if (verboseInfoMC)
-            LOGF(debug, "m %d", m.globalIndex());
-          if (mcPartIsSaved.find(oldmid) != mcPartIsSaved.end()) {
-            newval = mcPartIsSaved[oldmid];
-          } else {
-            newval = -1;
-          }
-          newmids.push_back(newval);
+            LOGF(debug, "m %d", McParts.rawIteratorAt(oldmid).globalIndex());
+          newmids.push_back(newIndex(mcPartIsSaved, oldmid));
         }
-        // daughters
+        // daughters, those of this McCollision
         auto olddids = mcpart.daughtersIds();
         for (uint ii = 0; ii < olddids.size(); ii++) {
-          if (oldnew.find(olddids[ii]) != oldnew.end()) {
-            newval = oldnew[olddids[ii]];
-          } else {
-            newval = -1;
-          }
-          newdids[ii] = newval;
+          newdids[ii] = newIndex(mcPartNewId, olddids[ii]);
         }
         if (verboseInfoMC)
           LOGF(debug, " ms %i ds %i", oldmids.size(), olddids.size());
@@ -590,10 +606,15 @@ struct McSGCandProducer {
         mcPartIsSaved[mcpart.globalIndex()] = outputMcParticles.lastIndex();
       }
     }
+
+    // reset the new indices for the next McCollision
+    for (const auto& mcpart : McParts) {
+      mcPartNewId[mcpart.globalIndex()] = -1;
+    }
   }
 
   template <typename TTrack>
-  void updateUDMcTrackLabel(TTrack const& udtrack, std::map<int64_t, int64_t>& mcPartIsSaved)
+  void updateUDMcTrackLabel(TTrack const& udtrack)
   {
     // udtrack (UDTCs) -> track (TCs) -> mcTrack (McParticles) -> udMcTrack (UDMcParticles)
     auto trackId = udtrack.trackId();
@@ -601,11 +622,7 @@ struct McSGCandProducer {
       auto track = udtrack.template track_as<TCs>();
       auto mcTrackId = track.mcParticleId();
       if (mcTrackId >= 0) {
-        if (mcPartIsSaved.find(mcTrackId) != mcPartIsSaved.end()) {
-          outputMcTrackLabels(mcPartIsSaved[mcTrackId], track.mcMask());
-        } else {
-          outputMcTrackLabels(-1, track.mcMask());
-        }
+        outputMcTrackLabels(mcPartIsSaved[mcTrackId], track.mcMask());
       } else {
         outputMcTrackLabels(-1, track.mcMask());
       }
@@ -615,7 +632,7 @@ struct McSGCandProducer {
   }
 
   template <typename TTrack>
-  void updateUDMcTrackLabels(TTrack const& udtracks, std::map<int64_t, int64_t>& mcPartIsSaved)
+  void updateUDMcTrackLabels(TTrack const& udtracks)
   {
     // loop over all tracks
     for (const auto& udtrack : udtracks) {
@@ -625,11 +642,7 @@ struct McSGCandProducer {
         auto track = udtrack.template track_as<TCs>();
         auto mcTrackId = track.mcParticleId();
         if (mcTrackId >= 0) {
-          if (mcPartIsSaved.find(mcTrackId) != mcPartIsSaved.end()) {
-            outputMcTrackLabels(mcPartIsSaved[mcTrackId], track.mcMask());
-          } else {
-            outputMcTrackLabels(-1, track.mcMask());
-          }
+          outputMcTrackLabels(mcPartIsSaved[mcTrackId], track.mcMask());
         } else {
           outputMcTrackLabels(-1, track.mcMask());
         }
@@ -643,12 +656,11 @@ struct McSGCandProducer {
   void procWithSgCand(aod::McCollisions const& mccols, aod::McParticles const& mcparts,
                       UDCCs const& sgcands, UDTCs const& udtracks)
   {
-    // use a hash table to keep track of the McCollisions which have been added to the UDMcCollision table
-    // {McCollisionId : udMcCollisionId}
+    // keep track of the McCollisions which have been added to the UDMcCollision table
+    // {McCollisionId : udMcCollisionId}, -1 if not saved
     // similar for the McParticles which have been added to the UDMcParticle table
     // {McParticleId : udMcParticleId}
-    std::map<int64_t, int64_t> mcColIsSaved;
-    std::map<int64_t, int64_t> mcPartIsSaved;
+    resetIndexMaps(mccols, mcparts);
 
     // loop over McCollisions and UDCCs simultaneously
     auto mccol = mccols.iteratorAt(0);
@@ -701,7 +713,7 @@ struct McSGCandProducer {
         // McParticles are saved
         // but only consider generated events of interest
         if (mcsgId >= 0 && mcOfInterest) {
-          if (mcColIsSaved.find(mcsgId) == mcColIsSaved.end()) {
+          if (mcColIsSaved[mcsgId] < 0) {
             if (verboseInfoMC)
               LOGF(info, "Saving McCollision %d", mcsgId);
             // update UDMcCollisions
@@ -715,10 +727,10 @@ struct McSGCandProducer {
 
           // update UDMcParticles
           auto mcPartsSlice = mcparts.sliceBy(mcPartsPerMcCollision, mcsgId);
-          updateUDMcParticles(mcPartsSlice, mcColIsSaved[mcsgId], mcPartIsSaved);
+          updateUDMcParticles(mcPartsSlice, mcColIsSaved[mcsgId]);
 
           // update UDMcTrackLabels (for each UDTrack -> UDMcParticles)
-          updateUDMcTrackLabels(sgTracks, mcPartIsSaved);
+          updateUDMcTrackLabels(sgTracks);
 
         } else {
           // If the sgcand has no associated McCollision then only the McParticles which are associated
@@ -737,12 +749,12 @@ struct McSGCandProducer {
               if (track.has_mcParticle()) {
                 auto mcPart = track.mcParticle();
                 auto mcCol = mcPart.mcCollision();
-                if (mcColIsSaved.find(mcCol.globalIndex()) == mcColIsSaved.end()) {
+                if (mcColIsSaved[mcCol.globalIndex()] < 0) {
                   updateUDMcCollisions(mcCol, globBC);
                   mcColIsSaved[mcCol.globalIndex()] = outputMcCollisions.lastIndex();
                 }
-                updateUDMcParticle(mcPart, mcColIsSaved[mcCol.globalIndex()], mcPartIsSaved);
-                updateUDMcTrackLabel(sgtrack, mcPartIsSaved);
+                updateUDMcParticle(mcPart, mcColIsSaved[mcCol.globalIndex()]);
+                updateUDMcTrackLabel(sgtrack);
               } else {
                 outputMcTrackLabels(-1, track.mcMask());
               }
@@ -764,7 +776,7 @@ struct McSGCandProducer {
 
         // update UDMcCollisions and UDMcParticles
         // but only consider generated events of interest
-        if (mcOfInterest && mcColIsSaved.find(mccolId) == mcColIsSaved.end()) {
+        if (mcOfInterest && mcColIsSaved[mccolId] < 0) {
           if (verboseInfoMC)
             LOGF(info, "Saving McCollision %d", mccolId);
           // update UDMcCollisions
@@ -773,7 +785,7 @@ struct McSGCandProducer {
 
           // update UDMcParticles
           auto mcPartsSlice = mcparts.sliceBy(mcPartsPerMcCollision, mccolId);
-          updateUDMcParticles(mcPartsSlice, mcColIsSaved[mccolId], mcPartIsSaved);
+          updateUDMcParticles(mcPartsSlice, mcColIsSaved[mccolId]);
         }
 
         // advance mccol
@@ -795,12 +807,15 @@ struct McSGCandProducer {
   // updating McTruth data only
   void procWithoutSgCand(aod::McCollisions const& mccols, aod::McParticles const& mcparts)
   {
-    // use a hash table to keep track of the McCollisions which have been added to the UDMcCollision table
-    // {McCollisionId : udMcCollisionId}
+    // keep track of the McCollisions which have been added to the UDMcCollision table
+    // {McCollisionId : udMcCollisionId}, -1 if not saved
     // similar for the McParticles which have been added to the UDMcParticle table
     // {McParticleId : udMcParticleId}
-    std::map<int64_t, int64_t> mcColIsSaved;
-    std::map<int64_t, int64_t> mcPartIsSaved;
+    resetIndexMaps(mccols, mcparts);
+
+    // all McCollisions and their McParticles are saved
+    outputMcCollisions.reserve(mccols.size());
+    outputMcParticles.reserve(mcparts.size());
 
     // loop over McCollisions
     for (auto const& mccol : mccols) {
@@ -808,7 +823,7 @@ struct McSGCandProducer {
       uint64_t globBC = mccol.bc_as<BCs>().globalBC();
 
       // update UDMcCollisions and UDMcParticles
-      if (mcColIsSaved.find(mccolId) == mcColIsSaved.end()) {
+      if (mcColIsSaved[mccolId] < 0) {
         if (verboseInfoMC)
           LOGF(info, "Saving McCollision %d", mccolId);
 
@@ -818,7 +833,7 @@ struct McSGCandProducer {
 
         // update UDMcParticles
         auto mcPartsSlice = mcparts.sliceBy(mcPartsPerMcCollision, mccolId);
-        updateUDMcParticles(mcPartsSlice, mcColIsSaved[mccolId], mcPartIsSaved);
+        updateUDMcParticles(mcPartsSlice, mcColIsSaved[mccolId]);
       }
     }
   }
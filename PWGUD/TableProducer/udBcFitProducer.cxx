@@ -0,0 +1,57 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file udBcFitProducer.cxx
+/// \brief Summed amplitudes, times and trigger masks of FV0, FT0 and FDD per BC, joinable with the BCs table
+///
+/// The UD selectors and candidate producers read the FIT information of the compatible BCs of
+/// every collision. With aod::UDBcFITs joined to their BCs table it is computed once per BC
+/// instead of once per BC and collision, see udhelpers::bcAmplitudeFV0A and the following.
+
+#include "PWGUD/Core/UDHelpers.h"
+#include "PWGUD/Core/UPCHelpers.h"
+#include "PWGUD/DataModel/UDTables.h"
+
+#include "Common/DataModel/EventSelection.h"
+
+#include <Framework/ASoA.h>
+#include <Framework/AnalysisDataModel.h>
+#include <Framework/AnalysisHelpers.h>
+#include <Framework/AnalysisTask.h>
+#include <Framework/runDataProcessing.h>
+
+using namespace o2;
+using namespace o2::framework;
+
+struct UdBcFitProducer {
+  Produces<aod::UDBcFITs> bcFITs;
+
+  using BCs = soa::Join<aod::BCs, aod::BcSels>;
+
+  void process(BCs const& bcs, aod::FT0s const& ft0s, aod::FV0As const& fv0as, aod::FDDs const& fdds)
+  {
+    bcFITs.reserve(bcs.size());
+    for (auto const& bc : bcs) {
+      upchelpers::FITInfo info{};
+      udhelpers::fillFITinfo(info, bc, ft0s, fv0as, fdds);
+      bcFITs(info.ampFV0A, info.ampFT0A, info.ampFT0C, info.ampFDDA, info.ampFDDC,
+             info.timeFV0A, info.timeFT0A, info.timeFT0C, info.timeFDDA, info.timeFDDC,
+             info.triggerMaskFV0A, info.triggerMaskFT0, info.triggerMaskFDD);
+    }
+  }
+};
+
+WorkflowSpec defineDataProcessing(ConfigContext const& cfgc)
+{
+  return WorkflowSpec{
+    adaptAnalysisTask<UdBcFitProducer>(cfgc),
+  };
+}
@@ -40,8 +40,10 @@
 #include <array>
 #include <cmath>
 #include <cstdint>
+#include <cstddef>
 #include <stdexcept>
 #include <utility>
+#include <vector>
 
 constexpr float ArbitrarySmallNumber{1e-8f};
 constexpr float ArbitraryHugeNumber{1e8f};
@@ -119,6 +121,44 @@ KFPTrack createKFPTrackFromTrackParCov(const o2::track::TrackParametrizationWith
   return kfpTrack;
 }
 
+/// @brief KFPTracks of the tracks of a table, indexed by the track global index.
+/// A track is usually a daughter of many candidates. The conversion to the global frame
+/// (position, momentum and covariance matrix) is done once per track, the first time it is requested,
+/// and the same KFPTrack is used for all the candidates of the DF. It does not depend on the magnetic field.
+class KFPTrackCache
+{
+ public:
+  /// @brief Clears the cache, to be called for every DF
+  /// @param nTracks size of the track table
+  void reset(std::size_t nTracks)
+  {
+    mTracks.resize(nTracks);
+    mIsCached.assign(nTracks, false);
+  }
+
+  /// @brief KFPTrack of the track, same as createKFPTrackFromTrack
+  /// @tparam T
+  /// @param track Track from aod::Tracks, aod::TracksExtra, aod::TracksCov
+  /// @return KFPTrack
+  template <typename T>
+  KFPTrack get(const T& track)
+  {
+    const auto index = static_cast<std::size_t>(track.globalIndex());
+    if (index >= mIsCached.size()) {
+      return createKFPTrackFromTrack(track);
+    }
+    if (!mIsCached[index]) {
+      mTracks[index] = createKFPTrackFromTrack(track);
+      mIsCached[index] = true;
+    }
+    return mTracks[index];
+  }
+
+ private:
+  std::vector<KFPTrack> mTracks;
+  std::vector<bool> mIsCached;
+};
+
 /// @brief Function to create a KFParticle from a o2::track::TrackParametrizationWithError track
 /// @tparam T
 /// @param trackparCov TrackParCov
@@ -23,10 +23,14 @@
 #include <Framework/Array2D.h>
 #include <Framework/Logger.h>
 
+#include <algorithm>
 #include <cstddef>
 #include <cstdint>
+#include <future>
 #include <map>
+#include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
 namespace o2
@@ -71,6 +75,7 @@ class MlResponse
     mNModels = binsLimits.size() - 1;
     mModels = std::vector<o2::ml::OnnxModel>(mNModels);
     mPaths = std::vector<std::string>(mNModels);
+    mSessionKeys = std::vector<std::string>(mNModels);
   }
 
   /// Configure class instance (import configurables)
@@ -96,6 +101,7 @@ class MlResponse
     mNModels = mNVar1Bins * mNVar2Bins;
     mModels = std::vector<o2::ml::OnnxModel>(mNModels);
     mPaths = std::vector<std::string>(mNModels);
+    mSessionKeys = std::vector<std::string>(mNModels);
 
     mUse2DBinning = true;
   }
@@ -124,11 +130,40 @@ class MlResponse
       }
     }
 
+    // the models are downloaded concurrently, each one with its own CCDB API since the API is not thread safe;
+    // a model listed for several bins is downloaded once
+    std::vector<int> firstFile(mNModels);
+    std::vector<std::unique_ptr<o2::ccdb::CcdbApi>> apis;
     for (auto iFile{0}; iFile < mNModels; ++iFile) {
-      std::map<std::string, std::string> metadata;
-      bool retrieveSuccess = ccdbApi.retrieveBlob(pathsCCDB[iFile], ".", metadata, timestampCCDB, false, onnxFiles[iFile]);
+      firstFile[iFile] = std::find(pathsCCDB.begin(), pathsCCDB.begin() + iFile, pathsCCDB[iFile]) - pathsCCDB.begin();
+      if (firstFile[iFile] == iFile && mNModels > 1) {
+        apis.push_back(std::make_unique<o2::ccdb::CcdbApi>());
+        apis.back()->init(ccdbApi.getURL());
+      }
+    }
+    std::vector<std::future<bool>> downloads(mNModels);
+    for (auto iFile{0}, iApi{0}; iFile < mNModels; ++iFile) {
+      if (firstFile[iFile] != iFile) {
+        continue;
+      }
+      const o2::ccdb::CcdbApi* api = mNModels > 1 ? apis[iApi++].get() : &ccdbApi;
+      downloads[iFile] = std::async(mNModels > 1 ? std::launch::async : std::launch::deferred, [api, &pathsCCDB, &onnxFiles, timestampCCDB, iFile]() {
+        std::map<std::string, std::string> metadata;
+        return api->retrieveBlob(pathsCCDB[iFile], ".", metadata, timestampCCDB, false, onnxFiles[iFile]);
+      });
+    }
+    std::vector<bool> retrieved(mNModels);
+    for (auto iFile{0}; iFile < mNModels; ++iFile) {
+      if (firstFile[iFile] == iFile) {
+        retrieved[iFile] = downloads[iFile].get();
+      }
+    }
+
+    for (auto iFile{0}; iFile < mNModels; ++iFile) {
+      bool retrieveSuccess = retrieved[firstFile[iFile]];
       if (retrieveSuccess) {
         mPaths[iFile] = onnxFiles[iFile];
+        mSessionKeys[iFile] = pathsCCDB[iFile] + "/" + onnxFiles[iFile] + "@" + std::to_string(timestampCCDB);
       } else {
         LOG(fatal) << "Error encountered while accessing the ML model from " << pathsCCDB[iFile] << "! Maybe the ML model doesn't exist yet for this run number or timestamp?";
       }
@@ -143,18 +178,28 @@ class MlResponse
       LOG(fatal) << "Number of expected models (" << mNModels << ") different from the one set (" << onnxFiles.size() << ")! Please check your configurables.";
     }
     mPaths = onnxFiles;
+    mSessionKeys = onnxFiles;
   }
 
   /// Initialize class instance (initialize OnnxModels)
   /// \param enableOptimizations is a switch to enable optimizations
   /// \param threads is the number of active threads
-  void init(bool enableOptimizations = false, int threads = 0)
+  /// \param shareSessions is a switch to share the ONNX sessions (and one thread pool) with all the models of the process loaded from the same CCDB object or file
+  void init(bool enableOptimizations = false, int threads = 0, bool shareSessions = false)
   {
     uint8_t counterModel{0};
     for (const auto& path : mPaths) {
-      mModels[counterModel].initModel(path, enableOptimizations, threads);
+      if (shareSessions) {
+        mModels[counterModel].initModelShared(path, mSessionKeys[counterModel], enableOptimizations, threads);
+      } else {
+        mModels[counterModel].initModel(path, enableOptimizations, threads);
+      }
       ++counterModel;
     }
+    if (shareSessions) {
+      // sessions of models replaced by this initialisation (e.g. from the previous run) are not needed anymore
+      o2::ml::OnnxSessionRegistry::instance().releaseUnused();
+    }
   }
 
   /// Method to translate configurable input-feature strings into integers
@@ -202,20 +247,7 @@ class MlResponse
   {
     int nModel = findBin(candVar);
     auto output = getModelOutput(input, nModel);
-    uint8_t iClass{0};
-    for (const auto& outputValue : output) {
-      uint8_t dir = mCutDir.at(iClass);
-      if (dir != o2::cuts_ml::CutDirection::CutNot) {
-        if (dir == o2::cuts_ml::CutDirection::CutGreater && outputValue > mCuts.get(nModel, iClass)) {
-          return false;
-        }
-        if (dir == o2::cuts_ml::CutDirection::CutSmaller && outputValue < mCuts.get(nModel, iClass)) {
-          return false;
-        }
-      }
-      ++iClass;
-    }
-    return true;
+    return isPassingCuts(output, nModel);
   }
 
   /// ML selections
@@ -228,22 +260,105 @@ class MlResponse
   {
     int nModel = findBin(candVar);
     output = getModelOutput(input, nModel);
-    uint8_t iClass{0};
-    for (const auto& outputValue : output) {
-      uint8_t dir = mCutDir.at(iClass);
-      if (dir != o2::cuts_ml::CutDirection::CutNot) {
-        if (dir == o2::cuts_ml::CutDirection::CutGreater && outputValue > mCuts.get(nModel, iClass)) {
-          return false;
-        }
-        if (dir == o2::cuts_ml::CutDirection::CutSmaller && outputValue < mCuts.get(nModel, iClass)) {
-          return false;
+    return isPassingCuts(output, nModel);
+  }
+
+  /// Add a candidate to the batch of candidates evaluated together by evaluateBatch()
+  /// \param input is the input features
+  /// \param candVar is the variable value (e.g. pT) used to select which model to use
+  /// \return index of the candidate in the batch, to be passed to isSelectedMlBatch
+  /// \note Running one inference for all the candidates of a model avoids the overhead of one inference call per candidate
+  template <typename T1, typename T2>
+  int addToBatch(const T1& input, const T2& candVar)
+  {
+    return addToBatchModel(input, findBin(candVar));
+  }
+
+  /// Add a candidate to the batch of candidates evaluated together by evaluateBatch()
+  /// \param input is the input features
+  /// \param candVar1 is the first variable value (e.g. pT) used to select which model to use
+  /// \param candVar2 is the second variable value (e.g. multiplicity) used to select which model to use
+  /// \return index of the candidate in the batch, to be passed to isSelectedMlBatch
+  template <typename T1, typename T2, typename T3>
+  int addToBatch(const T1& input, const T2& candVar1, const T3& candVar2)
+  {
+    if (!mUse2DBinning) {
+      LOG(fatal) << "2D ML selection called on a class not configured for 2D bins";
+    }
+    return addToBatchModel(input, findBin2D(candVar1, candVar2));
+  }
+
+  /// Add a candidate to the batch of the given model, for callers which find the model bin themselves
+  /// \param input is the input features
+  /// \param nModel is the model index
+  /// \return index of the candidate in the batch, to be passed to isSelectedMlBatch
+  template <typename T1>
+  int addToBatchInModel(const T1& input, int nModel)
+  {
+    return addToBatchModel(input, nModel);
+  }
+
+  /// Evaluate the models on all the candidates added to the batch, with one inference per model
+  void evaluateBatch()
+  {
+    mBatchScores.resize(mNModels);
+    for (auto iModel{0}; iModel < static_cast<int>(mBatchInputs.size()); ++iModel) {
+      auto& inputs = mBatchInputs[iModel];
+      auto& outputs = mBatchScores[iModel];
+      const std::size_t nInputFeatures = mModels[iModel].getNumInputNodes();
+      const std::size_t nCandidates = inputs.size() / nInputFeatures;
+      outputs.resize(nCandidates * mNClasses);
+      if (nCandidates == 0) {
+        continue;
+      }
+      if (mModels[iModel].hasDynamicBatchSize()) {
+        TypeOutputScore* outputPtr = mModels[iModel].template evalModel<TypeOutputScore>(inputs);
+        std::copy(outputPtr, outputPtr + nCandidates * mNClasses, outputs.begin());
+      } else {
+        // models exported with a fixed number of entries are evaluated one candidate at a time
+        std::vector<TypeOutputScore> input(nInputFeatures);
+        for (std::size_t iCand{0}; iCand < nCandidates; ++iCand) {
+          std::copy(inputs.begin() + iCand * nInputFeatures, inputs.begin() + (iCand + 1) * nInputFeatures, input.begin());
+          TypeOutputScore* outputPtr = mModels[iModel].template evalModel<TypeOutputScore>(input);
+          std::copy(outputPtr, outputPtr + mNClasses, outputs.begin() + iCand * mNClasses);
         }
       }
-      ++iClass;
     }
-    return true;
   }
 
+  /// ML selections for a candidate of the evaluated batch
+  /// \param iCandidate is the index of the candidate returned by addToBatch
+  /// \param output is a container to be filled with model output
+  /// \return boolean telling if model predictions pass the cuts
+  bool isSelectedMlBatch(int iCandidate, std::vector<TypeOutputScore>& output) const
+  {
+    const auto& [nModel, iCandInModel] = mBatchCandidates.at(iCandidate);
+    const auto* outputPtr = mBatchScores.at(nModel).data() + iCandInModel * mNClasses;
+    output.assign(outputPtr, outputPtr + mNClasses);
+    return isPassingCuts(output, nModel);
+  }
+
+  /// ML selections for a candidate of the evaluated batch
+  /// \param iCandidate is the index of the candidate returned by addToBatch
+  /// \return boolean telling if model predictions pass the cuts
+  bool isSelectedMlBatch(int iCandidate) const
+  {
+    std::vector<TypeOutputScore> output;
+    return isSelectedMlBatch(iCandidate, output);
+  }
+
+  /// Remove all the candidates from the batch (the allocated memory is kept)
+  void clearBatch()
+  {
+    for (auto& inputs : mBatchInputs) {
+      inputs.clear();
+    }
+    mBatchCandidates.clear();
+  }
+
+  /// \return number of candidates in the batch
+  int getBatchSize() const { return mBatchCandidates.size(); }
+
   /// ML selections
   /// \param input is the input features
   /// \param candVar1 is the first variable value (e.g. pT) used to select which model to use
@@ -258,20 +373,7 @@ class MlResponse
     }
     int nModel = findBin2D(candVar1, candVar2);
     output = getModelOutput(input, nModel);
-    uint8_t iClass{0};
-    for (const auto& outputValue : output) {
-      uint8_t dir = mCutDir.at(iClass);
-      if (dir != o2::cuts_ml::CutDirection::CutNot) {
-        if (dir == o2::cuts_ml::CutDirection::CutGreater && outputValue > mCuts.get(nModel, iClass)) {
-          return false;
-        }
-        if (dir == o2::cuts_ml::CutDirection::CutSmaller && outputValue < mCuts.get(nModel, iClass)) {
-          return false;
-        }
-      }
-      ++iClass;
-    }
-    return true;
+    return isPassingCuts(output, nModel);
   }
 
  protected:
@@ -281,6 +383,7 @@ class MlResponse
   std::vector<double> mBinsLimits = {};                   // bin limits of the variable (e.g. pT) used to select which model to use
   std::vector<double> mBinsLimitsVar2 = {};               // bin limits of a second variable (e.g. multiplicity) used to select which model to use (not used in this base class)
   std::vector<std::string> mPaths = {""};                 // paths to the models, one for each bin
+  std::vector<std::string> mSessionKeys = {""};           // keys identifying the models in the shared session registry, one for each bin
   std::vector<int> mCutDir = {};                          // direction of the cuts on the model scores (no cut is also supported)
   o2::framework::LabeledArray<double> mCuts = {};         // array of cut values to apply on the model scores
   std::map<std::string, uint8_t> mAvailableInputFeatures; // map of available input features
@@ -288,10 +391,56 @@ class MlResponse
   uint8_t mNVar1Bins = 1;                                 // number of bins of the first variable (e.g. pT) used to select which model to use
   uint8_t mNVar2Bins = 1;                                 // number of bins of the second variable (e.g. multiplicity) used to select which model to use
   bool mUse2DBinning = false;                             // switch to enable/disable 2D binning
+  std::vector<std::vector<TypeOutputScore>> mBatchInputs; // input features of the candidates in the batch, one flat vector per model
+  std::vector<std::vector<TypeOutputScore>> mBatchScores; // model outputs of the candidates in the batch, one flat vector per model
+  std::vector<std::pair<int, int>> mBatchCandidates;      // model index and position within that model for each candidate in the batch
 
   virtual void setAvailableInputFeatures() { return; } // method to fill the map of available input features
 
  private:
+  /// Checks the model output against the cuts
+  /// \param output is the model prediction for each class
+  /// \param nModel is the model index
+  /// \return boolean telling if model predictions pass the cuts
+  bool isPassingCuts(const std::vector<TypeOutputScore>& output, int nModel) const
+  {
+    uint8_t iClass{0};
+    for (const auto& outputValue : output) {
+      uint8_t dir = mCutDir.at(iClass);
+      if (dir != o2::cuts_ml::CutDirection::CutNot) {
+        if (dir == o2::cuts_ml::CutDirection::CutGreater && outputValue > mCuts.get(nModel, iClass)) {
+          return false;
+        }
+        if (dir == o2::cuts_ml::CutDirection::CutSmaller && outputValue < mCuts.get(nModel, iClass)) {
+          return false;
+        }
+      }
+      ++iClass;
+    }
+    return true;
+  }
+
+  /// Adds a candidate to the batch of a given model
+  /// \param input is the input features
+  /// \param nModel is the model index
+  /// \return index of the candidate in the batch
+  template <typename T1>
+  int addToBatchModel(const T1& input, int nModel)
+  {
+    if (nModel < 0 || static_cast<std::size_t>(nModel) >= mModels.size()) {
+      LOG(fatal) << "Model index " << nModel << " is out of range! The number of initialised models is " << mModels.size() << ". Please check your configurables.";
+    }
+    if (mModels[nModel].getNumInputNodes() != static_cast<int>(input.size())) {
+      LOG(fatal) << "Number of input nodes in the model " << mPaths[nModel] << " is different from the number of input features to be tested (" << mModels[nModel].getNumInputNodes() << " vs " << input.size() << ")";
+    }
+    mBatchInputs.resize(mNModels);
+    auto& inputs = mBatchInputs[nModel];
+    int iCandInModel = inputs.size() / input.size();
+    inputs.insert(inputs.end(), input.begin(), input.end());
+    mBatchCandidates.emplace_back(nModel, iCandInModel);
+    return mBatchCandidates.size() - 1;
+  }
+
   /// Finds matching bin in mBinsLimits
   /// \param value e.g. pT
   /// \return index of the matching bin, used to access mModels
@@ -30,6 +30,7 @@
 #include <cstddef>
 #include <cstdint>
 #include <memory>
+#include <mutex>
 #include <sstream>
 #include <string>
 #include <vector>
@@ -88,9 +89,39 @@ void OnnxModel::initModel(const std::string& localPath, const bool enableOptimiz
     sessionOptions.SetGraphOptimizationLevel(GraphOptimizationLevel::ORT_ENABLE_EXTENDED);
   }
 
+  mIoBinding.reset();
   mEnv = std::make_shared<Ort::Env>(ORT_LOGGING_LEVEL_WARNING, "onnx-model");
   mSession = std::make_shared<Ort::Session>(*mEnv, modelPath.c_str(), sessionOptions);
 
+  readModelSpecifications(from, until);
+}
+
+void OnnxModel::initModelShared(const std::string& localPath, const std::string& key, const bool enableOptimizations, const int threads, const uint64_t from, const uint64_t until)
+{
+
+  assert(from <= until);
+
+  LOG(info) << "--- ONNX-ML model (shared session " << key << ") ---";
+  modelPath = localPath;
+  activeThreads = threads;
+
+  /// Running on Hyperloop (the number of threads is set to 1)
+  checkHyperloop(true);
+
+  mIoBinding.reset();
+  mEnv = OnnxSessionRegistry::instance().getEnv(activeThreads);
+  mSession = OnnxSessionRegistry::instance().getSession(key, modelPath, enableOptimizations, activeThreads);
+
+  readModelSpecifications(from, until);
+}
+
+void OnnxModel::readModelSpecifications(const uint64_t from, const uint64_t until)
+{
+  mInputNames.clear();
+  mInputShapes.clear();
+  mOutputNames.clear();
+  mOutputShapes.clear();
+
   Ort::AllocatorWithDefaultOptions const tmpAllocator;
   for (std::size_t i = 0; i < mSession->GetInputCount(); ++i) {
     mInputNames.push_back(mSession->GetInputNameAllocated(i, tmpAllocator).get());
@@ -122,6 +153,59 @@ void OnnxModel::initModel(const std::string& localPath, const bool enableOptimiz
   LOG(info) << "--- Model initialized! ---";
 }
 
+OnnxSessionRegistry& OnnxSessionRegistry::instance()
+{
+  static OnnxSessionRegistry registry;
+  return registry;
+}
+
+std::shared_ptr<Ort::Env> OnnxSessionRegistry::getEnv(const int threads)
+{
+  std::lock_guard<std::mutex> const lock(mMutex);
+  if (!mEnv) {
+    Ort::ThreadingOptions threadingOptions;
+    threadingOptions.SetGlobalIntraOpNumThreads(threads);
+    threadingOptions.SetGlobalInterOpNumThreads(1);
+    mEnv = std::make_shared<Ort::Env>(threadingOptions, ORT_LOGGING_LEVEL_WARNING, "onnx-model-shared");
+    LOGP(info, "Created ONNX environment with a global thread pool of {} threads (0 = default)", threads);
+  }
+  return mEnv;
+}
+
+std::shared_ptr<Ort::Session> OnnxSessionRegistry::getSession(const std::string& key, const std::string& modelPath, const bool enableOptimizations, const int threads)
+{
+  auto env = getEnv(threads);
+  std::lock_guard<std::mutex> const lock(mMutex);
+  const std::string fullKey = key + (enableOptimizations ? "#opt" : "");
+  auto session = mSessions.find(fullKey);
+  if (session != mSessions.end()) {
+    LOGP(info, "Reusing ONNX session {} ({} users)", fullKey, session->second.use_count());
+    return session->second;
+  }
+  Ort::SessionOptions sessionOptions;
+  sessionOptions.DisablePerSessionThreads(); // use the thread pool of the environment
+  if (enableOptimizations) {
+    sessionOptions.SetGraphOptimizationLevel(GraphOptimizationLevel::ORT_ENABLE_EXTENDED);
+  }
+  auto newSession = std::make_shared<Ort::Session>(*env, modelPath.c_str(), sessionOptions);
+  mSessions[fullKey] = newSession;
+  LOGP(info, "Created ONNX session {} from {}", fullKey, modelPath);
+  return newSession;
+}
+
+void OnnxSessionRegistry::releaseUnused()
+{
+  std::lock_guard<std::mutex> const lock(mMutex);
+  for (auto session = mSessions.begin(); session != mSessions.end();) {
+    if (session->second.use_count() == 1) {
+      LOGP(info, "Releasing unused ONNX session {}", session->first);
+      session = mSessions.erase(session);
+    } else {
+      ++session;
+    }
+  }
+}
+
 void OnnxModel::setActiveThreads(const int threads)
 {
   activeThreads = threads;
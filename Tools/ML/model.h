@@ -26,11 +26,14 @@
 #include <onnxruntime_cxx_api.h>
 
 #include <algorithm>
+#include <array>
 #include <cassert>
 #include <cstddef>
 #include <cstdint>
 #include <iterator>
+#include <map>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
 
@@ -40,6 +43,31 @@ namespace o2
 namespace ml
 {
 
+/// Process-wide registry of ONNX sessions, to share one session between all models loaded from the same file
+/// (e.g. the same CCDB object used by several tasks of a workflow) and one intra-op thread pool between all sessions.
+/// Sessions are reference counted: releaseUnused() drops the ones which are not used by any model anymore (e.g. after a run change)
+/// \note Sharing is within one process; devices of a workflow running as separate processes still have one session each
+class OnnxSessionRegistry
+{
+ public:
+  static OnnxSessionRegistry& instance();
+
+  /// Get the environment with the global thread pool; the number of threads is fixed by the first call
+  std::shared_ptr<Ort::Env> getEnv(const int threads);
+  /// Get the session for a model, creating it if no session exists yet for this key
+  /// \param key identifies the model (e.g. CCDB path and timestamp), together with the optimisation level
+  std::shared_ptr<Ort::Session> getSession(const std::string& key, const std::string& modelPath, const bool enableOptimizations, const int threads);
+  /// Drop the sessions which are not used by any model
+  void releaseUnused();
+  int getNSessions() const { return mSessions.size(); }
+
+ private:
+  OnnxSessionRegistry() = default;
+  std::mutex mMutex;
+  std::shared_ptr<Ort::Env> mEnv = nullptr;
+  std::map<std::string, std::shared_ptr<Ort::Session>> mSessions;
+};
+
 class OnnxModel
 {
 
@@ -49,6 +77,8 @@ class OnnxModel
 
   // Inferencing
   void initModel(const std::string&, const bool = false, const int = 0, const uint64_t = 0, const uint64_t = 0);
+  // Same as initModel, but the session is taken from OnnxSessionRegistry and shared with all the models with the same key
+  void initModelShared(const std::string&, const std::string&, const bool = false, const int = 0, const uint64_t = 0, const uint64_t = 0);
 
   // template methods -- best to define them in header
   template <typename T>
@@ -66,7 +96,9 @@ class OnnxModel
       std::vector<const char*> outputNamesChar(mOutputNames.size(), nullptr);
       std::transform(std::begin(mOutputNames), std::end(mOutputNames), std::begin(outputNamesChar),
                      [&](const std::string& str) { return str.c_str(); });
-      auto outputTensors = mSession->Run(runOptions, inputNamesChar.data(), input.data(), input.size(), outputNamesChar.data(), outputNamesChar.size());
+      // the output tensors are kept until the next evaluation, such that the returned pointer stays valid
+      mOutputTensors = std::make_shared<std::vector<Ort::Value>>(mSession->Run(runOptions, inputNamesChar.data(), input.data(), input.size(), outputNamesChar.data(), outputNamesChar.size()));
+      auto& outputTensors = *mOutputTensors;
       LOG(debug) << "Number of output tensors: " << outputTensors.size();
       if (outputTensors.size() != mOutputNames.size()) {
         LOG(fatal) << "Number of output tensors: " << outputTensors.size() << " does not agree with the model specified size: " << mOutputNames.size();
@@ -126,9 +158,52 @@ class OnnxModel
     return evalModel<T>(inputTensors);
   }
 
+  // Evaluate nRows input rows stored contiguously in input and write the last output tensor (nRows x number of output nodes) into output.
+  // The IO binding is kept between evaluations and only rebound to the given buffers, so no input or output tensor is allocated by the runtime
+  template <typename T>
+  bool evalModelBound(T* input, const int64_t nRows, T* output)
+  {
+    if (mInputNames.size() != 1) {
+      LOG(error) << "Bound evaluation is only available for models with a single input, this model has " << mInputNames.size();
+      return false;
+    }
+    if (!hasDynamicBatchSize() && nRows != mInputShapes[0][0]) {
+      LOG(error) << "The model expects " << mInputShapes[0][0] << " input rows, got " << nRows;
+      return false;
+    }
+
+    try {
+      if (!mIoBinding) {
+        mIoBinding = std::make_shared<Ort::IoBinding>(*mSession);
+      }
+      Ort::MemoryInfo memInfo = Ort::MemoryInfo::CreateCpu(OrtAllocatorType::OrtArenaAllocator, OrtMemType::OrtMemTypeDefault);
+      const int64_t inputNodes = mInputShapes[0][1];
+      const int64_t outputNodes = mOutputShapes.back()[1];
+      const std::array<int64_t, 2> inputShape{nRows, inputNodes};
+      const std::array<int64_t, 2> outputShape{nRows, outputNodes};
+      Ort::Value inputTensor = Ort::Value::CreateTensor<T>(memInfo, input, nRows * inputNodes, inputShape.data(), inputShape.size());
+      Ort::Value outputTensor = Ort::Value::CreateTensor<T>(memInfo, output, nRows * outputNodes, outputShape.data(), outputShape.size());
+      mIoBinding->ClearBoundInputs();
+      mIoBinding->ClearBoundOutputs();
+      mIoBinding->BindInput(mInputNames[0].c_str(), inputTensor);
+      // only the last output is returned, the other ones are allocated by the runtime
+      for (std::size_t i = 0; i + 1 < mOutputNames.size(); i++) {
+        mIoBinding->BindOutput(mOutputNames[i].c_str(), memInfo);
+      }
+      mIoBinding->BindOutput(mOutputNames.back().c_str(), outputTensor);
+      const Ort::RunOptions runOptions;
+      mSession->Run(runOptions, *mIoBinding);
+      return true;
+    } catch (const Ort::Exception& exception) {
+      LOG(error) << "Error running model inference: " << exception.what();
+    }
+    return false;
+  }
+
   // Reset session
   void resetSession()
   {
+    mIoBinding.reset();
     mSession.reset(new Ort::Session{*mEnv, modelPath.c_str(), sessionOptions});
   }
 
@@ -141,6 +216,8 @@ class OnnxModel
   int getNumInputNodes() const { return mInputShapes[0][1]; }
   std::vector<std::vector<int64_t>> getInputShapes() const { return mInputShapes; }
   int getNumOutputNodes() const { return mOutputShapes[0][1]; }
+  // The model accepts inputs with several entries (first dimension of the input not fixed)
+  bool hasDynamicBatchSize() const { return !mInputShapes.empty() && mInputShapes[0][0] == -1 && !mOutputShapes.empty() && mOutputShapes.back()[0] == -1; }
   uint64_t getValidityFrom() const { return validFrom; }
   uint64_t getValidityUntil() const { return validUntil; }
   void setActiveThreads(const int);
@@ -157,6 +234,11 @@ class OnnxModel
   std::vector<std::string> mOutputNames;
   std::vector<std::vector<int64_t>> mOutputShapes;
 
+  // Output of the last evaluation (shared pointer, since Ort::Value is not copyable)
+  std::shared_ptr<std::vector<Ort::Value>> mOutputTensors = nullptr;
+  // IO binding used by evalModelBound, dropped whenever the session changes
+  std::shared_ptr<Ort::IoBinding> mIoBinding = nullptr;
+
   // Environment settings
   std::string modelPath;
   int activeThreads = 0;
@@ -165,6 +247,8 @@ class OnnxModel
 
   // Internal function for printing the shape of tensors
   std::string printShape(const std::vector<int64_t>&);
+  // Internal function to read the input and output specifications from the session
+  void readModelSpecifications(const uint64_t, const uint64_t);
   bool checkHyperloop(const bool = true);
 };
 
@@ -104,6 +104,7 @@ struct PidMlBatchEffAndPurProducer {
                                             aod::pidTPCFullPi, aod::pidTPCFullKa, aod::pidTPCFullPr, aod::pidTPCFullEl, aod::pidTPCFullMu,
                                             aod::pidTOFFullPi, aod::pidTOFFullKa, aod::pidTOFFullPr, aod::pidTOFFullEl, aod::pidTOFFullMu>>;
   std::vector<PidONNXModel<BigTracks>> models;
+  std::vector<std::vector<float>> mlCertainties; // per pid, certainties of all the tracks of the DF
 
   void initHistos()
   {
@@ -240,14 +241,22 @@ struct PidMlBatchEffAndPurProducer {
       }
     }
 
+    // the models are evaluated once per pid for all the tracks, in batches
+    mlCertainties.resize(pdgPids.value.size());
+    for (size_t i = 0; i < pdgPids.value.size(); ++i) {
+      models[i].applyModelBatch(tracks, mlCertainties[i]);
+    }
+
+    size_t row = 0;
     for (const auto& track : tracks) {
+      const size_t trackRow = row++;
       if (track.has_mcParticle()) {
         auto mcPart = track.mcParticle();
         if (mcPart.isPhysicalPrimary()) {
           fillTrackedHist(mcPart.pdgCode(), track.pt());
 
           for (size_t i = 0; i < pdgPids.value.size(); ++i) {
-            float mlCertainty = models[i].applyModel(track);
+            float mlCertainty = mlCertainties[i][trackRow];
             nSigma_t nSigma = getNSigma(track, pdgPids.value[i]);
             bool isMCPid = mcPart.pdgCode() == pdgPids.value[i];
 
@@ -141,6 +141,39 @@ struct PidONNXModel {
     return getModelOutput(track) >= mMinCertainty;
   }
 
+  // Certainties of all the tracks of the table, in the order of iteration.
+  // The tracks are grouped by the detectors used (TOF and TRD below their momentum limits are replaced by NaNs),
+  // so that all the rows of a batch have the same NaN pattern, and each group is evaluated with one model run.
+  void applyModelBatch(const T& tracks, std::vector<float>& certainties)
+  {
+    certainties.assign(tracks.size(), 0.f);
+    for (auto& group : mBatchRows) {
+      group.clear();
+    }
+    for (auto& group : mBatchValues) {
+      group.clear();
+    }
+
+    size_t row = 0;
+    for (const auto& track : tracks) {
+      const int group = getDetectorGroup(track);
+      mBatchRows[group].push_back(row++);
+      fillValues(track, mBatchValues[group]);
+    }
+
+    for (int group = 0; group < NDetectorGroups; ++group) {
+      if (mBatchRows[group].empty()) {
+        continue;
+      }
+      const auto batchSize = static_cast<int64_t>(mBatchRows[group].size());
+      mBatchOutput.clear();
+      runModel(mBatchValues[group], batchSize, mBatchOutput);
+      for (int64_t i = 0; i < batchSize && i < static_cast<int64_t>(mBatchOutput.size()); ++i) {
+        certainties[mBatchRows[group][i]] = mBatchOutput[i];
+      }
+    }
+  }
+
   int mPid{0};
   double mMinCertainty{0};
 
@@ -214,20 +247,43 @@ struct PidONNXModel {
     return (value - scalingParams.first) / scalingParams.second;
   }
 
+  static constexpr int NDetectorGroups = 4; // with or without TOF, with or without TRD
+
+  bool useTOF(const typename T::iterator& track) const
+  {
+    return !pidml::pidutils::tofMissing(track) && pidml::pidutils::inPLimit(track, mPLimits[kTPCTOF]);
+  }
+
+  bool useTRD(const typename T::iterator& track) const
+  {
+    return !pidml::pidutils::trdMissing(track) && pidml::pidutils::inPLimit(track, mPLimits[kTPCTOFTRD]);
+  }
+
+  int getDetectorGroup(const typename T::iterator& track) const
+  {
+    return (useTOF(track) ? 1 : 0) | (useTRD(track) ? 2 : 0);
+  }
+
   std::vector<float> getValues(const typename T::iterator& track)
   {
     std::vector<float> output;
     output.reserve(mTrainColumns.size());
+    fillValues(track, output);
+    return output;
+  }
 
-    bool useTOF = !pidml::pidutils::tofMissing(track) && pidml::pidutils::inPLimit(track, mPLimits[kTPCTOF]);
-    bool useTRD = !pidml::pidutils::trdMissing(track) && pidml::pidutils::inPLimit(track, mPLimits[kTPCTOFTRD]);
+  // appends the scaled input values of the track to output
+  void fillValues(const typename T::iterator& track, std::vector<float>& output)
+  {
+    const bool withTOF = useTOF(track);
+    const bool withTRD = useTRD(track);
 
     for (uint32_t i = 0; i < mTrainColumns.size(); ++i) {
       auto& columnLabel = mTrainColumns[i];
 
       if (
-        ((columnLabel == "fTRDSignal" || columnLabel == "fTRDPattern") && !useTRD) ||
-        ((columnLabel == "fTOFSignal" || columnLabel == "fBeta") && !useTOF)) {
+        ((columnLabel == "fTRDSignal" || columnLabel == "fTRDPattern") && !withTRD) ||
+        ((columnLabel == "fTOFSignal" || columnLabel == "fBeta") && !withTOF)) {
         output.push_back(std::numeric_limits<float>::quiet_NaN());
         continue;
       }
@@ -247,21 +303,25 @@ struct PidONNXModel {
 
       output.push_back(value);
     }
-
-    return output;
   }
 
   float getModelOutput(const typename T::iterator& track)
   {
     // First rank of the expected model input is -1 which means that it is dynamic axis.
-    // Axis is exported as dynamic to make it possible to run model inference with the batch of
-    // tracks at once in the future (batch would need to have the same amount of quiet_NaNs in each row).
-    // For now we hardcode 1.
+    // A single track is evaluated here, see applyModelBatch for the batches of tracks.
     static constexpr int64_t BatchSize = 1;
+    std::vector<float> inputTensorValues = getValues(track);
+    std::vector<float> outputValues;
+    runModel(inputTensorValues, BatchSize, outputValues);
+    return outputValues.empty() ? false : outputValues[0];
+  }
+
+  // runs the model on batchSize rows of input values and appends the certainty of each row to outputValues
+  void runModel(std::vector<float>& inputTensorValues, int64_t batchSize, std::vector<float>& outputValues)
+  {
     auto inputShape = mInputShapes[0];
-    inputShape[0] = BatchSize;
+    inputShape[0] = batchSize;
 
-    std::vector<float> inputTensorValues = getValues(track);
     std::vector<Ort::Value> inputTensors;
 
     Ort::MemoryInfo memInfo = Ort::MemoryInfo::CreateCpu(OrtAllocatorType::OrtArenaAllocator, OrtMemType::OrtMemTypeDefault);
@@ -288,13 +348,16 @@ struct PidONNXModel {
       assert(outputTensors.size() == mOutputNames.size() && outputTensors[0].IsTensor());
       LOG(debug) << "output tensor shape: " << printShape(outputTensors[0].GetTensorTypeAndShapeInfo().GetShape());
 
+      // one or more values per row, the certainty is the first one
       const float* outputValue = outputTensors[0].GetTensorData<float>();
-      float certainty = *outputValue;
-      return certainty;
+      const size_t nOutputValues = outputTensors[0].GetTensorTypeAndShapeInfo().GetElementCount();
+      const size_t stride = nOutputValues / batchSize;
+      for (int64_t i = 0; i < batchSize; ++i) {
+        outputValues.push_back(outputValue[i * stride]);
+      }
     } catch (const Ort::Exception& exception) {
       LOG(error) << "Error running model inference: " << exception.what();
     }
-    return false; // unreachable code
   }
 
   // Pretty prints a shape dimension vector
@@ -320,6 +383,11 @@ struct PidONNXModel {
   std::vector<std::vector<int64_t>> mInputShapes;
   std::vector<std::string> mOutputNames;
   std::vector<std::vector<int64_t>> mOutputShapes;
+
+  // buffers of applyModelBatch, per detector group
+  std::array<std::vector<size_t>, NDetectorGroups> mBatchRows;
+  std::array<std::vector<float>, NDetectorGroups> mBatchValues;
+  std::vector<float> mBatchOutput;
 };
 
 #endif // TOOLS_PIDML_PIDONNXMODEL_H_